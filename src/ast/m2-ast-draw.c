@@ -32,8 +32,11 @@
  * You should have received a copy of the GNU Lesser General Public License
  * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
  */
-
 #include "m2-ast-draw.h"
+#include "m2-ast-walk.h"
+#include "m2-outsink.h"
+
+#include <stddef.h>
 
 
 /* --------------------------------------------------------------------------
@@ -41,15 +44,25 @@
  * ----------------------------------------------------------------------- */
 
 #define HAS_QUOTABLE_LEAF_VALUES(_nodetype) \
-  ((_nodetype == AST_QUOTEDVAL) || \
-   (_nodetype == AST_FILENAME) || (_nodetype == AST_OPTIONS))
+  (m2c_ast_print_class_for_nodetype(_nodetype) == M2C_AST_PRINT_QUOTED)
+
+static void draw_leaf_with_quoted_value
+  (m2c_outsink_t sink, m2c_string_t value, uint_t id);
 
-static void draw_leaf_with_quoted_value (m2c_string_t value, uint_t id);
+static void draw_leaf_with_unquoted_value
+  (m2c_outsink_t sink, m2c_string_t value, uint_t id);
 
-static void draw_leaf_with_unquoted_value (m2c_string_t value, uint_t id);
+typedef struct {
+  /* sink */ m2c_outsink_t sink;
+  /* next_free_id */ uint_t next_free_id;
+} draw_context_s;
 
-static void draw_subtree
-  (m2c_astnode_t node, uint_t parent_id, uint_t *node_id);
+static bool draw_enter (m2c_ast_visit_t *visit, void *context);
+
+static void draw_edges
+  (m2c_outsink_t sink, uint_t node_id, uint_t first_id, uint_t count);
+
+static void draw_node_id (m2c_outsink_t sink, uint_t id);
 
 
 /* --------------------------------------------------------------------------
@@ -59,96 +72,124 @@ static void draw_subtree
  * ----------------------------------------------------------------------- */
 
 void m2c_ast_draw_node (m2c_astnode_t node, const char *title) {
-  uint_t node_id, subnode_id;
-    
-  printf("digraph %s {\n", title);
+  draw_context_s context;
+  m2c_outsink_t sink;
   
-  printf(" graph [fontname=helvetica,fontsize=10];\n");
-  printf(" node [style=solid,shape=box,fontsize=8];\n");
-  printf(" edge [style=solid,arrowsize=0.75];\n\n");
+  sink = m2c_outsink_open_console(NULL);
+  
+  if (sink == NULL) {
+    return;
+  } /* end if */
+  
+  m2c_outsink_write_str(sink, "digraph ");
+  m2c_outsink_write_str(sink, title);
+  m2c_outsink_write_str(sink, " {\n");
+  
+  m2c_outsink_write_str(sink, " graph [fontname=helvetica,fontsize=10];\n");
+  m2c_outsink_write_str(sink, " node [style=solid,shape=box,fontsize=8];\n");
+  m2c_outsink_write_str(sink, " edge [style=solid,arrowsize=0.75];\n\n");
   
   if ((title != NULL) && (title[0] != 0)) {
-    printf(" labelloc=\"t\"; labeljust=\"l\";\n");
-    printf(" label=\"%s\n\";\n\n");
+    m2c_outsink_write_str(sink, " labelloc=\"t\"; labeljust=\"l\";\n");
+    m2c_outsink_write_str(sink, " label=\"");
+    m2c_outsink_write_escaped(sink, title);
+    m2c_outsink_write_str(sink, "\n\";\n\n");
   } /* end if */
   
-  node_id = 0; subnode_id = node_id + 1;
-  draw_subtree(node, node_id, &subnode_id);
+  /* the root node has node_id 0 */
+  context.sink = sink;
+  context.next_free_id = 1;
+  m2c_ast_walk(node, draw_enter, NULL, &context);
+  
+  m2c_outsink_write_str(sink, "} /* end ");
+  m2c_outsink_write_str(sink, title);
+  m2c_outsink_write_str(sink, " */\n");
   
-  printf("} /* end %s */\n", title);
+  m2c_outsink_close(&sink);
 } /* end m2c_ast_draw_node */
 
 
 /* --------------------------------------------------------------------------
- * private function draw_subtree(node, node_id, first_subnode_id)
+ * private function draw_enter(visit, context)
+ * --------------------------------------------------------------------------
+ * Enter visitor, draws the visited node, its edges and any leafs.  The ids
+ * of the subnodes of a node are reserved when its edges are drawn, the
+ * first is kept in the tag of the visit.
  * ----------------------------------------------------------------------- */
 
-static void draw_subtree
-  (m2c_astnode_t node, uint_t node_id, uint_t first_subnode_id) {
+static bool draw_enter (m2c_ast_visit_t *visit, void *context) {
   
-  uint_t index, subnode_id, subnode_count, next_free_id, subsubnode_count;
-  m2c_astnode_type_t node_type;
-  const char *node_name;
+  draw_context_s *draw = (draw_context_s *) context;
+  uint_t index, node_id, subnode_count;
+  m2c_ast_nodetype_t node_type;
   m2c_string_t value;
-    
-  node_type = m2c_ast_nodetype(node);
-  node_name = m2c_name_for_nodetype(node_type);
-  subnode_count = m2c_ast_subnode_count(node);
   
-  printf(" node%u [label=\"%s\"];\n", node_id, node_name);
+  if (visit->depth == 0) {
+    node_id = 0;
+  }
+  else {
+    node_id = visit->parent_tag + visit->index;
+  } /* end if */
   
-  if (m2c_ast_is_nonterminal(node_type)) {
+  node_type = m2c_ast_nodetype(visit->node);
+  subnode_count = m2c_ast_subnode_count(visit->node);
   
-    /* connections to all subnodes */
-    printf(" node%u -> {", node_id);
-    for (index = 0; index < subnode_count; index++) {
-      subnode_id = first_subnode_id + index;
-      printf(" node%u", subnode_id);
-    } /* end for */
-    printf(" };\n\n");
-    
-    /* subtrees of all subnodes */
-    next_free_id = first_subnode_id + subnode_count + 1;
-    for (index = 0; index < subnode_count; index++) {
-      subnode = m2c_ast_subnode_for_index(node, index);
-      subnode_id = first_subnode_id + index;
-      draw_subtree(subnode, subnode_id, next_free_id);
-      subsubnode_count = m2c_ast_subnode_count(subnode);
-      next_free_id = next_free_id + subsubnode_count + 1;
-    } /* end for */
-  }
-  else /* terminal node */ {
-    
-    /* connections to all leafs */
-    printf(" node%u -> {", node_id);
-    for (index = 0; index < subnode_count; index++) {
-      subnode_id = first_subnode_id + index + 1;
-      printf(" node%u", subnode_id);
-    } /* end for */
-    printf(" };\n\n");
+  m2c_outsink_write_char(draw->sink, ' ');
+  draw_node_id(draw->sink, node_id);
+  m2c_outsink_write_str(draw->sink, " [label=\"");
+  m2c_outsink_write_str(draw->sink, m2c_name_for_nodetype(node_type));
+  m2c_outsink_write_str(draw->sink, "\"];\n");
+  
+  /* connections to all subnodes or leafs, reserve their ids */
+  visit->tag = draw->next_free_id;
+  draw->next_free_id = draw->next_free_id + subnode_count;
+  draw_edges(draw->sink, node_id, visit->tag, subnode_count);
+  
+  /* subtrees of subnodes are drawn by the traversal */
+  if (!m2c_ast_is_nonterminal_nodetype(node_type)) {
     
     /* draw leafs */
     for (index = 0; index < subnode_count; index++) {
-      subnode = m2c_ast_subnode_for_index(node, index);
-      subnode_id = first_subnode_id + index + 1;
-      value = m2c_ast_value_for_index(node, index);
+      value = m2c_ast_value_for_index(visit->node, index);
       if (HAS_QUOTABLE_LEAF_VALUES(node_type)) {
-        draw_leaf_with_quoted_value(value, subnode_id);
+        draw_leaf_with_quoted_value(draw->sink, value, visit->tag + index);
       }
       else {
-        draw_leaf_with_unquoted_value(value, subnode_id);
+        draw_leaf_with_unquoted_value(draw->sink, value, visit->tag + index);
       } /* end if */
     } /* end for */
-    printf("\n");
+    m2c_outsink_write_char(draw->sink, '\n');
   } /* end if */
-} /* end draw_subtree */
+  
+  return true;
+} /* end draw_enter */
+
+
+/* --------------------------------------------------------------------------
+ * private function draw_edges(sink, node_id, first_id, count)
+ * ----------------------------------------------------------------------- */
+
+static void draw_edges
+  (m2c_outsink_t sink, uint_t node_id, uint_t first_id, uint_t count) {
+  uint_t index;
+  
+  m2c_outsink_write_char(sink, ' ');
+  draw_node_id(sink, node_id);
+  m2c_outsink_write_str(sink, " -> {");
+  for (index = 0; index < count; index++) {
+    m2c_outsink_write_char(sink, ' ');
+    draw_node_id(sink, first_id + index);
+  } /* end for */
+  m2c_outsink_write_str(sink, " };\n\n");
+} /* end draw_edges */
 
 
 /* --------------------------------------------------------------------------
- * private function draw_leaf_with_quoted_value(node, id)
+ * private function draw_leaf_with_quoted_value(sink, value, id)
  * ----------------------------------------------------------------------- */
 
-static void draw_leaf_with_quoted_value (m2c_string_t value, uint_t id) {
+static void draw_leaf_with_quoted_value
+  (m2c_outsink_t sink, m2c_string_t value, uint_t id) {
   const char *lexstr;
   uint_t length, index;
   bool contains_double_quote;
@@ -156,6 +197,7 @@ static void draw_leaf_with_quoted_value (m2c_string_t value, uint_t id) {
   length = m2c_string_length(value);
   lexstr = m2c_string_char_ptr(value);
   
+  contains_double_quote = false;
   for (index = 0; index < length; index++) {
     contains_double_quote = (lexstr[index] == '"');
     if (contains_double_quote) {
@@ -163,22 +205,43 @@ static void draw_leaf_with_quoted_value (m2c_string_t value, uint_t id) {
     } /* end if */
   } /* end for */
   
+  m2c_outsink_write_char(sink, ' ');
+  draw_node_id(sink, id);
+  
   if (contains_double_quote) {
-    printf(" node%u [label=\"'%s'\",style=filled];\n", id, lexstr);
+    m2c_outsink_write_str(sink, " [label=\"'");
+    m2c_outsink_write_escaped(sink, lexstr);
+    m2c_outsink_write_str(sink, "'\",style=filled];\n");
   }
   else {
-    printf(" node%u [label=\"\"%s\"\",style=filled];\n", id, lexstr);
+    m2c_outsink_write_str(sink, " [label=\"\\\"");
+    m2c_outsink_write_escaped(sink, lexstr);
+    m2c_outsink_write_str(sink, "\\\"\",style=filled];\n");
   } /* end if */
 } /* end draw_leaf_with_quoted_value */
 
 
 /* --------------------------------------------------------------------------
- * private function draw_leaf_with_unquoted_value(node, id)
+ * private function draw_leaf_with_unquoted_value(sink, value, id)
  * ----------------------------------------------------------------------- */
 
-static void draw_leaf_with_unquoted_value (m2c_string_t value, uint_t id) {
-  const char *lexstr = m2c_string_char_ptr(value);
-  printf(" node%u [label=\"%s\",style=filled];\n", id, lexstr);
+static void draw_leaf_with_unquoted_value
+  (m2c_outsink_t sink, m2c_string_t value, uint_t id) {
+  m2c_outsink_write_char(sink, ' ');
+  draw_node_id(sink, id);
+  m2c_outsink_write_str(sink, " [label=\"");
+  m2c_outsink_write_escaped(sink, m2c_string_char_ptr(value));
+  m2c_outsink_write_str(sink, "\",style=filled];\n");
 } /* end draw_leaf_with_unquoted_value */
 
-/* END OF FILE */
\ No newline at end of file
+
+/* --------------------------------------------------------------------------
+ * private function draw_node_id(sink, id)
+ * ----------------------------------------------------------------------- */
+
+static void draw_node_id (m2c_outsink_t sink, uint_t id) {
+  m2c_outsink_write_chars(sink, "node", 4);
+  m2c_outsink_write_uint(sink, id);
+} /* end draw_node_id */
+
+/* END OF FILE */
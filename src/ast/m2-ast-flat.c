@@ -0,0 +1,647 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015, 2016 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * m2-ast-flat.c
+ *
+ * Implementation of the M2C flat abstract syntax tree.
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute and/or modify it under the
+ * terms of the GNU Lesser General Public License (LGPL) either version 2.1
+ * or at your choice version 3 as published by the Free Software Foundation.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#include "m2-ast-flat.h"
+#include "m2-ast-walk.h"
+
+#include <stddef.h>
+#include <stdlib.h>
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_astflat_struct_t
+ * --------------------------------------------------------------------------
+ * record type representing a flat AST object.  Field handle holds the
+ * handle table, allocated on first use, each entry pointing back to the
+ * flat AST itself.
+ * ----------------------------------------------------------------------- */
+
+struct m2c_astflat_struct_t {
+  /* node_count */ uint32_t node_count;
+  /* link_count */ uint32_t link_count;
+  /* string_count */ uint32_t string_count;
+  /* tag */ uint8_t *tag;
+  /* first_link */ uint32_t *first_link;
+  /* link */ uint32_t *link;
+  /* string */ m2c_string_t *string;
+  /* handle */ m2c_astflat_t *handle;
+};
+
+typedef struct m2c_astflat_struct_t m2c_astflat_struct_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type flat_builder_s
+ * --------------------------------------------------------------------------
+ * record type representing the state of a flat AST under construction.
+ * Table map is an open addressing hash table with the string ID plus one
+ * of each distinct value, indexed by the value's address, zero indicating
+ * an empty slot.
+ * ----------------------------------------------------------------------- */
+
+#define FLAT_INITIAL_CAPACITY 1024
+
+typedef struct {
+  /* flat */ m2c_astflat_t flat;
+  /* node_capacity */ uint32_t node_capacity;
+  /* link_capacity */ uint32_t link_capacity;
+  /* map_capacity */ uint32_t map_capacity;
+  /* map */ uint32_t *map;
+  /* failed */ bool failed;
+} flat_builder_s;
+
+
+/* --------------------------------------------------------------------------
+ * Forward declarations
+ * ----------------------------------------------------------------------- */
+
+static bool add_visited_node (m2c_ast_visit_t *visit, void *context);
+
+static uint32_t add_node
+  (flat_builder_s *builder, m2c_ast_nodetype_t node_type, uint_t count);
+
+static uint32_t add_string (flat_builder_s *builder, m2c_string_t value);
+
+static bool grow_string_map (flat_builder_s *builder);
+
+static void *shrink_table (void *table, size_t size);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astflat_new(root)
+ * --------------------------------------------------------------------------
+ * Allocates a new flat AST, populates it with the tree of root in a single
+ * traversal and returns it, or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2c_astflat_t m2c_astflat_new (m2c_astnode_t root) {
+  
+  flat_builder_s builder;
+  m2c_astflat_t flat;
+  
+  flat = malloc(sizeof(m2c_astflat_struct_t));
+  
+  if (flat == NULL) {
+    return NULL;
+  } /* end if */
+  
+  flat->node_count = 0;
+  flat->link_count = 0;
+  flat->string_count = 0;
+  flat->handle = NULL;
+  
+  builder.flat = flat;
+  builder.node_capacity = FLAT_INITIAL_CAPACITY;
+  builder.link_capacity = FLAT_INITIAL_CAPACITY;
+  builder.map_capacity = FLAT_INITIAL_CAPACITY;
+  builder.failed = false;
+  
+  flat->tag = malloc(builder.node_capacity * sizeof(uint8_t));
+  flat->first_link =
+    malloc((builder.node_capacity + 1) * sizeof(uint32_t));
+  flat->link = malloc(builder.link_capacity * sizeof(uint32_t));
+  flat->string =
+    malloc((builder.map_capacity / 2) * sizeof(m2c_string_t));
+  builder.map = calloc(builder.map_capacity, sizeof(uint32_t));
+  
+  if ((flat->tag == NULL) || (flat->first_link == NULL) ||
+      (flat->link == NULL) || (flat->string == NULL) ||
+      (builder.map == NULL)) {
+    free(builder.map);
+    m2c_astflat_release(flat);
+    return NULL;
+  } /* end if */
+  
+  /* populate arrays in a single traversal */
+  if (!m2c_ast_walk(root, add_visited_node, NULL, &builder)) {
+    builder.failed = true;
+  } /* end if */
+  
+  free(builder.map);
+  
+  if (builder.failed) {
+    m2c_astflat_release(flat);
+    return NULL;
+  } /* end if */
+  
+  /* terminate link offsets */
+  flat->first_link[flat->node_count] = flat->link_count;
+  
+  /* release unused capacity */
+  flat->tag = shrink_table(flat->tag, flat->node_count * sizeof(uint8_t));
+  flat->first_link = shrink_table
+    (flat->first_link, (flat->node_count + 1) * sizeof(uint32_t));
+  flat->link =
+    shrink_table(flat->link, flat->link_count * sizeof(uint32_t));
+  flat->string =
+    shrink_table(flat->string, flat->string_count * sizeof(m2c_string_t));
+  
+  return flat;
+} /* end m2c_astflat_new */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astflat_node_count(flat)
+ * --------------------------------------------------------------------------
+ * Returns the number of nodes in flat, or zero if flat is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_astflat_node_count (m2c_astflat_t flat) {
+  
+  if (flat == NULL) {
+    return 0;
+  } /* end if */
+  
+  return flat->node_count;
+} /* end m2c_astflat_node_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astflat_link_count(flat)
+ * --------------------------------------------------------------------------
+ * Returns the total number of links in flat, or zero if flat is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_astflat_link_count (m2c_astflat_t flat) {
+  
+  if (flat == NULL) {
+    return 0;
+  } /* end if */
+  
+  return flat->link_count;
+} /* end m2c_astflat_link_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astflat_string_count(flat)
+ * --------------------------------------------------------------------------
+ * Returns the number of distinct values in flat, or zero if flat is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_astflat_string_count (m2c_astflat_t flat) {
+  
+  if (flat == NULL) {
+    return 0;
+  } /* end if */
+  
+  return flat->string_count;
+} /* end m2c_astflat_string_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astflat_nodetype(flat, node)
+ * --------------------------------------------------------------------------
+ * Returns the node type of the node with index node in flat, or
+ * AST_INVALID if flat is NULL or node is not a valid node index.
+ * ----------------------------------------------------------------------- */
+
+m2c_ast_nodetype_t m2c_astflat_nodetype (m2c_astflat_t flat, uint_t node) {
+  
+  if ((flat == NULL) || (node >= flat->node_count)) {
+    return AST_INVALID;
+  } /* end if */
+  
+  return (m2c_ast_nodetype_t) flat->tag[node];
+} /* end m2c_astflat_nodetype */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astflat_subnode_count(flat, node)
+ * --------------------------------------------------------------------------
+ * Returns the number of subnodes or values of the node with index node in
+ * flat, or zero if flat is NULL or node is not a valid node index.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_astflat_subnode_count (m2c_astflat_t flat, uint_t node) {
+  
+  if ((flat == NULL) || (node >= flat->node_count)) {
+    return 0;
+  } /* end if */
+  
+  return flat->first_link[node + 1] - flat->first_link[node];
+} /* end m2c_astflat_subnode_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astflat_subnode_for_index(flat, node, index)
+ * --------------------------------------------------------------------------
+ * Returns the node index of the subnode with the given index of the
+ * nonterminal node with index node in flat, or M2C_ASTFLAT_INVALID_NODE
+ * if the node does not have a subnode with the given index.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_astflat_subnode_for_index
+  (m2c_astflat_t flat, uint_t node, uint_t index) {
+  
+  if ((index >= m2c_astflat_subnode_count(flat, node)) ||
+      (NOT(m2c_ast_is_nonterminal_nodetype(flat->tag[node])))) {
+    return M2C_ASTFLAT_INVALID_NODE;
+  } /* end if */
+  
+  return flat->link[flat->first_link[node] + index];
+} /* end m2c_astflat_subnode_for_index */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astflat_value_id_for_index(flat, node, index)
+ * --------------------------------------------------------------------------
+ * Returns the string ID of the value stored at the given index in the
+ * terminal node with index node in flat, or M2C_ASTFLAT_INVALID_NODE if
+ * the node does not store any value at the given index.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_astflat_value_id_for_index
+  (m2c_astflat_t flat, uint_t node, uint_t index) {
+  
+  if ((index >= m2c_astflat_subnode_count(flat, node)) ||
+      (m2c_ast_is_nonterminal_nodetype(flat->tag[node]))) {
+    return M2C_ASTFLAT_INVALID_NODE;
+  } /* end if */
+  
+  return flat->link[flat->first_link[node] + index];
+} /* end m2c_astflat_value_id_for_index */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astflat_string_for_id(flat, id)
+ * --------------------------------------------------------------------------
+ * Returns the value with string ID id in flat, or NULL if there is none.
+ * ----------------------------------------------------------------------- */
+
+m2c_string_t m2c_astflat_string_for_id (m2c_astflat_t flat, uint_t id) {
+  
+  if ((flat == NULL) || (id >= flat->string_count)) {
+    return NULL;
+  } /* end if */
+  
+  return flat->string[id];
+} /* end m2c_astflat_string_for_id */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astflat_value_for_index(flat, node, index)
+ * --------------------------------------------------------------------------
+ * Returns the value stored at the given index in the terminal node with
+ * index node in flat, or NULL if the node does not store any value at the
+ * given index.
+ * ----------------------------------------------------------------------- */
+
+m2c_string_t m2c_astflat_value_for_index
+  (m2c_astflat_t flat, uint_t node, uint_t index) {
+  
+  return m2c_astflat_string_for_id
+    (flat, m2c_astflat_value_id_for_index(flat, node, index));
+} /* end m2c_astflat_value_for_index */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astflat_node(flat, node)
+ * --------------------------------------------------------------------------
+ * Returns a handle for the node with index node in flat that may be passed
+ * to the accessor functions of m2-ast.h, or NULL if node is not a valid
+ * node index or allocation fails.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_astflat_node (m2c_astflat_t flat, uint_t node) {
+  
+  uint32_t index;
+  
+  if ((flat == NULL) || (node >= flat->node_count)) {
+    return NULL;
+  } /* end if */
+  
+  /* allocate handle table on first use */
+  if (flat->handle == NULL) {
+    flat->handle = malloc(flat->node_count * sizeof(m2c_astflat_t));
+  
+    if (flat->handle == NULL) {
+      return NULL;
+    } /* end if */
+  
+    for (index = 0; index < flat->node_count; index++) {
+      flat->handle[index] = flat;
+    } /* end for */
+  } /* end if */
+  
+  /* entries are pointer aligned, the odd address marks a handle */
+  return (m2c_astnode_t) ((char *) &flat->handle[node] + 1);
+} /* end m2c_astflat_node */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astflat_for_handle(handle, node)
+ * --------------------------------------------------------------------------
+ * Returns the flat AST of handle and passes the node index of handle back
+ * in node.
+ * ----------------------------------------------------------------------- */
+
+m2c_astflat_t m2c_astflat_for_handle (m2c_astnode_t handle, uint_t *node) {
+  
+  m2c_astflat_t *entry;
+  
+  entry = (m2c_astflat_t *) ((char *) handle - 1);
+  
+  WRITE_OUTPARAM(node, (uint_t) (entry - (*entry)->handle));
+  
+  return *entry;
+} /* end m2c_astflat_for_handle */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_astflat_release(flat)
+ * --------------------------------------------------------------------------
+ * Deallocates flat and its handle table.  Values are not deallocated.
+ * ----------------------------------------------------------------------- */
+
+void m2c_astflat_release (m2c_astflat_t flat) {
+  
+  if (flat == NULL) {
+    return;
+  } /* end if */
+  
+  free(flat->tag);
+  free(flat->first_link);
+  free(flat->link);
+  free(flat->string);
+  free(flat->handle);
+  free(flat);
+} /* end m2c_astflat_release */
+
+
+/* *********************************************************************** *
+ * Private Functions                                                       *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private function add_visited_node(visit, context)
+ * --------------------------------------------------------------------------
+ * Enter visitor, adds the visited node to the builder passed in context.
+ * As nodes are entered in depth first pre-order, the index of each node is
+ * its pre-order number.  The links of a node are reserved when it is added
+ * and the offset of the first is kept in the tag of the visit.  Each node
+ * stores its index in the reserved link of its parent, a terminal node
+ * stores the string IDs of its values in its own links.  Returns false and
+ * sets the failed flag of builder on failure.
+ * ----------------------------------------------------------------------- */
+
+static bool add_visited_node (m2c_ast_visit_t *visit, void *context) {
+  
+  flat_builder_s *builder = (flat_builder_s *) context;
+  m2c_ast_nodetype_t node_type;
+  uint32_t node_index, first, link;
+  uint_t index, count;
+  
+  node_type = m2c_ast_nodetype(visit->node);
+  count = m2c_ast_subnode_count(visit->node);
+  
+  node_index = add_node(builder, node_type, count);
+  
+  if (builder->failed) {
+    return false;
+  } /* end if */
+  
+  if (visit->depth > 0) {
+    builder->flat->link[visit->parent_tag + visit->index] = node_index;
+  } /* end if */
+  
+  /* links of this node are reserved, subnodes are appended after them */
+  first = builder->flat->first_link[node_index];
+  visit->tag = first;
+  
+  if (m2c_ast_is_nonterminal_nodetype(node_type)) {
+    return true;
+  } /* end if */
+  
+  for (index = 0; index < count; index++) {
+    link = add_string(builder, m2c_ast_value_for_index(visit->node, index));
+  
+    if (builder->failed) {
+      return false;
+    } /* end if */
+  
+    builder->flat->link[first + index] = link;
+  } /* end for */
+  
+  return true;
+} /* end add_visited_node */
+
+
+/* --------------------------------------------------------------------------
+ * private function add_node(builder, node_type, count)
+ * --------------------------------------------------------------------------
+ * Appends a node of node_type, reserves count links for it and returns its
+ * index.  Sets the failed flag of builder on failure.
+ * ----------------------------------------------------------------------- */
+
+static uint32_t add_node
+  (flat_builder_s *builder, m2c_ast_nodetype_t node_type, uint_t count) {
+  
+  m2c_astflat_t flat = builder->flat;
+  uint32_t new_capacity;
+  void *new_table;
+  
+  if ((node_type >= AST_INVALID) || (node_type > UINT8_MAX)) {
+    builder->failed = true;
+    return M2C_ASTFLAT_INVALID_NODE;
+  } /* end if */
+  
+  /* grow node tables */
+  if (flat->node_count == builder->node_capacity) {
+    new_capacity = 2 * builder->node_capacity;
+  
+    new_table = realloc(flat->tag, new_capacity * sizeof(uint8_t));
+    if (new_table == NULL) {
+      builder->failed = true;
+      return M2C_ASTFLAT_INVALID_NODE;
+    } /* end if */
+    flat->tag = new_table;
+  
+    new_table =
+      realloc(flat->first_link, (new_capacity + 1) * sizeof(uint32_t));
+    if (new_table == NULL) {
+      builder->failed = true;
+      return M2C_ASTFLAT_INVALID_NODE;
+    } /* end if */
+    flat->first_link = new_table;
+  
+    builder->node_capacity = new_capacity;
+  } /* end if */
+  
+  /* grow link table */
+  if (flat->link_count + count > builder->link_capacity) {
+    new_capacity = 2 * builder->link_capacity;
+    while (flat->link_count + count > new_capacity) {
+      new_capacity = 2 * new_capacity;
+    } /* end while */
+  
+    new_table = realloc(flat->link, new_capacity * sizeof(uint32_t));
+    if (new_table == NULL) {
+      builder->failed = true;
+      return M2C_ASTFLAT_INVALID_NODE;
+    } /* end if */
+    flat->link = new_table;
+  
+    builder->link_capacity = new_capacity;
+  } /* end if */
+  
+  flat->tag[flat->node_count] = (uint8_t) node_type;
+  flat->first_link[flat->node_count] = flat->link_count;
+  flat->link_count = flat->link_count + count;
+  
+  flat->node_count++;
+  return flat->node_count - 1;
+} /* end add_node */
+
+
+/* --------------------------------------------------------------------------
+ * private function add_string(builder, value)
+ * --------------------------------------------------------------------------
+ * Returns the string ID of value, adding value to the string table if it
+ * is not already present.  Since values are unique strings, they are
+ * identified by address.  Sets the failed flag of builder on failure.
+ * ----------------------------------------------------------------------- */
+
+static uint32_t add_string (flat_builder_s *builder, m2c_string_t value) {
+  
+  m2c_astflat_t flat = builder->flat;
+  uint32_t slot, mask;
+  
+  if (value == NULL) {
+    builder->failed = true;
+    return M2C_ASTFLAT_INVALID_NODE;
+  } /* end if */
+  
+  mask = builder->map_capacity - 1;
+  slot = (uint32_t) (((uintptr_t) value >> 3) * 2654435761u) & mask;
+  
+  /* linear probing */
+  while (builder->map[slot] != 0) {
+    if (flat->string[builder->map[slot] - 1] == value) {
+      return builder->map[slot] - 1;
+    } /* end if */
+    slot = (slot + 1) & mask;
+  } /* end while */
+  
+  /* not present, add it */
+  flat->string[flat->string_count] = value;
+  builder->map[slot] = flat->string_count + 1;
+  flat->string_count++;
+  
+  /* keep load factor at or below one half */
+  if ((2 * flat->string_count >= builder->map_capacity) &&
+      (NOT(grow_string_map(builder)))) {
+    builder->failed = true;
+    return M2C_ASTFLAT_INVALID_NODE;
+  } /* end if */
+  
+  return flat->string_count - 1;
+} /* end add_string */
+
+
+/* --------------------------------------------------------------------------
+ * private function grow_string_map(builder)
+ * --------------------------------------------------------------------------
+ * Doubles the capacity of the string table and hash map of builder and
+ * rehashes all entries.  Returns true on success.
+ * ----------------------------------------------------------------------- */
+
+static bool grow_string_map (flat_builder_s *builder) {
+  
+  m2c_astflat_t flat = builder->flat;
+  uint32_t new_capacity, mask, slot, index;
+  m2c_string_t *new_string;
+  uint32_t *new_map;
+  
+  new_capacity = 2 * builder->map_capacity;
+  
+  new_string =
+    realloc(flat->string, (new_capacity / 2) * sizeof(m2c_string_t));
+  
+  if (new_string == NULL) {
+    return false;
+  } /* end if */
+  
+  flat->string = new_string;
+  new_map = calloc(new_capacity, sizeof(uint32_t));
+  
+  if (new_map == NULL) {
+    return false;
+  } /* end if */
+  
+  mask = new_capacity - 1;
+  
+  for (index = 0; index < flat->string_count; index++) {
+    slot = (uint32_t)
+      (((uintptr_t) flat->string[index] >> 3) * 2654435761u) & mask;
+    while (new_map[slot] != 0) {
+      slot = (slot + 1) & mask;
+    } /* end while */
+    new_map[slot] = index + 1;
+  } /* end for */
+  
+  free(builder->map);
+  builder->map = new_map;
+  builder->map_capacity = new_capacity;
+  
+  return true;
+} /* end grow_string_map */
+
+
+/* --------------------------------------------------------------------------
+ * private function shrink_table(table, size)
+ * --------------------------------------------------------------------------
+ * Reallocates table to size bytes and returns it.  Returns table unchanged
+ * if size is zero or reallocation fails.
+ * ----------------------------------------------------------------------- */
+
+static void *shrink_table (void *table, size_t size) {
+  
+  void *new_table;
+  
+  if (size == 0) {
+    return table;
+  } /* end if */
+  
+  new_table = realloc(table, size);
+  
+  if (new_table == NULL) {
+    return table;
+  } /* end if */
+  
+  return new_table;
+} /* end shrink_table */
+
+
+/* END OF FILE */
@@ -0,0 +1,232 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015, 2016 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * m2-ast-flat.h
+ *
+ * Public interface for the M2C flat abstract syntax tree.
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute and/or modify it under the
+ * terms of the GNU Lesser General Public License (LGPL) either version 2.1
+ * or at your choice version 3 as published by the Free Software Foundation.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#ifndef M2C_AST_FLAT_H
+#define M2C_AST_FLAT_H
+
+#include "m2-common.h"
+#include "m2-ast.h"
+
+#include <stdint.h>
+
+
+/* --------------------------------------------------------------------------
+ * Flat AST representation
+ * --------------------------------------------------------------------------
+ * A flat AST stores all nodes of a tree in contiguous arrays, numbered in
+ * depth first pre-order with the root node at index 0:
+ *
+ *   uint8_t tag[node_count];            node types
+ *   uint32_t first_link[node_count+1];  offsets of links per node
+ *   uint32_t link[link_count];          subnode indices or string IDs
+ *   m2c_string_t string[string_count];  distinct values by string ID
+ *
+ * The links of node i are link[first_link[i]] to link[first_link[i+1]-1].
+ * For a nonterminal node they are subnode indices, for a terminal node
+ * they are string IDs.  A flat AST is immutable.
+ * ----------------------------------------------------------------------- */
+
+#define M2C_ASTFLAT_INVALID_NODE 0xffffffff
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2c_astflat_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing a flat AST object.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_astflat_struct_t *m2c_astflat_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astflat_new(root)
+ * --------------------------------------------------------------------------
+ * Allocates a new flat AST, populates it with the tree of root in a single
+ * traversal and returns it, or NULL on failure.
+ *
+ * pre-conditions:
+ * o  root must be a valid AST node
+ *
+ * post-conditions:
+ * o  a flat AST holding the tree of root is returned
+ *
+ * error-conditions:
+ * o  if allocation fails, NULL is returned
+ * o  if the tree contains an invalid node, NULL is returned
+ * ----------------------------------------------------------------------- */
+
+m2c_astflat_t m2c_astflat_new (m2c_astnode_t root);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astflat_node_count(flat)
+ * --------------------------------------------------------------------------
+ * Returns the number of nodes in flat, or zero if flat is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_astflat_node_count (m2c_astflat_t flat);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astflat_link_count(flat)
+ * --------------------------------------------------------------------------
+ * Returns the total number of links in flat, or zero if flat is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_astflat_link_count (m2c_astflat_t flat);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astflat_string_count(flat)
+ * --------------------------------------------------------------------------
+ * Returns the number of distinct values in flat, or zero if flat is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_astflat_string_count (m2c_astflat_t flat);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astflat_nodetype(flat, node)
+ * --------------------------------------------------------------------------
+ * Returns the node type of the node with index node in flat, or
+ * AST_INVALID if flat is NULL or node is not a valid node index.
+ * ----------------------------------------------------------------------- */
+
+m2c_ast_nodetype_t m2c_astflat_nodetype (m2c_astflat_t flat, uint_t node);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astflat_subnode_count(flat, node)
+ * --------------------------------------------------------------------------
+ * Returns the number of subnodes or values of the node with index node in
+ * flat, or zero if flat is NULL or node is not a valid node index.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_astflat_subnode_count (m2c_astflat_t flat, uint_t node);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astflat_subnode_for_index(flat, node, index)
+ * --------------------------------------------------------------------------
+ * Returns the node index of the subnode with the given index of the
+ * nonterminal node with index node in flat, or M2C_ASTFLAT_INVALID_NODE
+ * if the node does not have a subnode with the given index.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_astflat_subnode_for_index
+  (m2c_astflat_t flat, uint_t node, uint_t index);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astflat_value_id_for_index(flat, node, index)
+ * --------------------------------------------------------------------------
+ * Returns the string ID of the value stored at the given index in the
+ * terminal node with index node in flat, or M2C_ASTFLAT_INVALID_NODE if
+ * the node does not store any value at the given index.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_astflat_value_id_for_index
+  (m2c_astflat_t flat, uint_t node, uint_t index);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astflat_string_for_id(flat, id)
+ * --------------------------------------------------------------------------
+ * Returns the value with string ID id in flat, or NULL if there is none.
+ * ----------------------------------------------------------------------- */
+
+m2c_string_t m2c_astflat_string_for_id (m2c_astflat_t flat, uint_t id);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astflat_value_for_index(flat, node, index)
+ * --------------------------------------------------------------------------
+ * Returns the value stored at the given index in the terminal node with
+ * index node in flat, or NULL if the node does not store any value at the
+ * given index.
+ * ----------------------------------------------------------------------- */
+
+m2c_string_t m2c_astflat_value_for_index
+  (m2c_astflat_t flat, uint_t node, uint_t index);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astflat_node(flat, node)
+ * --------------------------------------------------------------------------
+ * Returns a handle for the node with index node in flat that may be passed
+ * to the accessor functions of m2-ast.h, or NULL if node is not a valid
+ * node index or allocation fails.  Handles of subnodes are obtained from
+ * m2c_ast_subnode_for_index().  The handle table is allocated on first use
+ * at a cost of one pointer per node, the arrays of flat are not affected.
+ * Handles must not be passed to m2c_ast_replace_subnode() and
+ * m2c_ast_replace_value(), they remain valid until flat is released.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_astflat_node (m2c_astflat_t flat, uint_t node);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astflat_is_handle(node)
+ * --------------------------------------------------------------------------
+ * Returns true if node is a handle obtained from a flat AST, otherwise
+ * false.  Handles are odd-valued, which node pointers never are.
+ * ----------------------------------------------------------------------- */
+
+#define m2c_astflat_is_handle(_node) \
+  ((((uintptr_t) (_node)) & 1) != 0)
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astflat_for_handle(handle, node)
+ * --------------------------------------------------------------------------
+ * Returns the flat AST of handle and passes the node index of handle back
+ * in node.  Called by the accessor functions of m2-ast.h.
+ * ----------------------------------------------------------------------- */
+
+m2c_astflat_t m2c_astflat_for_handle (m2c_astnode_t handle, uint_t *node);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_astflat_release(flat)
+ * --------------------------------------------------------------------------
+ * Deallocates flat and its handle table.  Values are not deallocated.
+ * ----------------------------------------------------------------------- */
+
+void m2c_astflat_release (m2c_astflat_t flat);
+
+
+#endif /* M2C_AST_FLAT_H */
+
+/* END OF FILE */
@@ -0,0 +1,170 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015, 2016 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * m2-ast-nodetype-inits.h
+ *
+ * Node type table for M2C abstract syntax trees.
+ *
+ * This file is the single definition of all AST node types.  It is included
+ * by m2-ast-nodetype.h to define the node type enumeration and by
+ * m2-ast-nodetype.c to define the node info table and the name pool.  Each
+ * includer defines macro AST_NODETYPE before including and undefines it
+ * afterwards.  The file is therefore not protected by an include guard.
+ *
+ * Columns: node type, human readable name, arity, kind, print class.
+ * For list kinds, the arity is the minimum number of subnodes or values.
+ * The print class determines how the values of a terminal node are written.
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute and/or modify it under the
+ * terms of the GNU Lesser General Public License (LGPL) either version 2.1
+ * or at your choice version 3 as published by the Free Software Foundation.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+/* Empty Node Type */
+
+AST_NODETYPE(EMPTY,        "EMPTY",        0, NONTERMINAL,      NONE)
+
+/* Root Node Type */
+
+AST_NODETYPE(ROOT,         "AST",          3, NONTERMINAL,      NONE)
+
+/* Definition Module Non-Terminal Node Types */
+
+AST_NODETYPE(DEFMOD,       "DEFMOD",       3, NONTERMINAL,      NONE)
+AST_NODETYPE(IMPLIST,      "IMPLIST",      1, NONTERMINAL_LIST, NONE)
+AST_NODETYPE(IMPORT,       "IMPORT",       1, NONTERMINAL,      NONE)
+AST_NODETYPE(UNQIMP,       "UNQIMP",       2, NONTERMINAL,      NONE)
+AST_NODETYPE(DEFLIST,      "DEFLIST",      1, NONTERMINAL_LIST, NONE)
+AST_NODETYPE(CONSTDEF,     "CONSTDEF",     2, NONTERMINAL,      NONE)
+AST_NODETYPE(TYPEDEF,      "TYPEDEF",      2, NONTERMINAL,      NONE)
+AST_NODETYPE(PROCDEF,      "PROCDEF",      3, NONTERMINAL,      NONE)
+AST_NODETYPE(SUBR,         "SUBR",         3, NONTERMINAL,      NONE)
+AST_NODETYPE(ENUM,         "ENUM",         1, NONTERMINAL,      NONE)
+AST_NODETYPE(SET,          "SET",          1, NONTERMINAL,      NONE)
+AST_NODETYPE(ARRAY,        "ARRAY",        2, NONTERMINAL,      NONE)
+AST_NODETYPE(RECORD,       "RECORD",       1, NONTERMINAL,      NONE)
+AST_NODETYPE(POINTER,      "POINTER",      1, NONTERMINAL,      NONE)
+AST_NODETYPE(PROCTYPE,     "PROCTYPE",     2, NONTERMINAL,      NONE)
+AST_NODETYPE(EXTREC,       "EXTREC",       2, NONTERMINAL,      NONE)
+AST_NODETYPE(VRNTREC,      "VRNTREC",      1, NONTERMINAL,      NONE)
+AST_NODETYPE(INDEXLIST,    "INDEXLIST",    1, NONTERMINAL_LIST, NONE)
+AST_NODETYPE(FIELDLISTSEQ, "FIELDLISTSEQ", 1, NONTERMINAL_LIST, NONE)
+AST_NODETYPE(FIELDLIST,    "FIELDLIST",    2, NONTERMINAL,      NONE)
+AST_NODETYPE(VFLISTSEQ,    "VFLISTSEQ",    1, NONTERMINAL_LIST, NONE)
+AST_NODETYPE(VFLIST,       "VFLIST",       4, NONTERMINAL,      NONE)
+AST_NODETYPE(VARIANTLIST,  "VARIANTLIST",  1, NONTERMINAL_LIST, NONE)
+AST_NODETYPE(VARIANT,      "VARIANT",      2, NONTERMINAL,      NONE)
+AST_NODETYPE(CLABELLIST,   "CLABELLIST",   1, NONTERMINAL_LIST, NONE)
+AST_NODETYPE(CLABELS,      "CLABELS",      2, NONTERMINAL,      NONE)
+AST_NODETYPE(FTYPELIST,    "FTYPELIST",    1, NONTERMINAL_LIST, NONE)
+AST_NODETYPE(ARGLIST,      "ARGLIST",      1, NONTERMINAL_LIST, NONE)
+AST_NODETYPE(OPENARRAY,    "OPENARRAY",    1, NONTERMINAL,      NONE)
+AST_NODETYPE(CONSTP,       "CONSTP",       1, NONTERMINAL,      NONE)
+AST_NODETYPE(VARP,         "VARP",         1, NONTERMINAL,      NONE)
+AST_NODETYPE(FPARAMLIST,   "FPARAMLIST",   1, NONTERMINAL_LIST, NONE)
+AST_NODETYPE(FPARAMS,      "FPARAMS",      2, NONTERMINAL,      NONE)
+
+/* Implementation/Program Module AST Node Types */
+
+AST_NODETYPE(IMPMOD,       "IMPMOD",       4, NONTERMINAL,      NONE)
+AST_NODETYPE(BLOCK,        "BLOCK",        2, NONTERMINAL,      NONE)
+AST_NODETYPE(DECLLIST,     "DECLLIST",     1, NONTERMINAL_LIST, NONE)
+AST_NODETYPE(TYPEDECL,     "TYPEDECL",     2, NONTERMINAL,      NONE)
+AST_NODETYPE(VARDECL,      "VARDECL",      2, NONTERMINAL,      NONE)
+AST_NODETYPE(PROC,         "PROC",         4, NONTERMINAL,      NONE)
+AST_NODETYPE(MODDECL,      "MODDECL",      5, NONTERMINAL,      NONE)
+AST_NODETYPE(VSREC,        "VSREC",        2, NONTERMINAL,      NONE)
+AST_NODETYPE(VSFIELD,      "VSFIELD",      3, NONTERMINAL,      NONE)
+AST_NODETYPE(EXPORT,       "EXPORT",       1, NONTERMINAL,      NONE)
+AST_NODETYPE(QUALEXP,      "QUALEXP",      1, NONTERMINAL,      NONE)
+AST_NODETYPE(STMTSEQ,      "STMTSEQ",      1, NONTERMINAL_LIST, NONE)
+AST_NODETYPE(ASSIGN,       "ASSIGN",       2, NONTERMINAL,      NONE)
+AST_NODETYPE(PCALL,        "PCALL",        2, NONTERMINAL,      NONE)
+AST_NODETYPE(RETURN,       "RETURN",       1, NONTERMINAL,      NONE)
+AST_NODETYPE(WITH,         "WITH",         2, NONTERMINAL,      NONE)
+AST_NODETYPE(IF,           "IF",           4, NONTERMINAL,      NONE)
+AST_NODETYPE(SWITCH,       "SWITCH",       3, NONTERMINAL,      NONE)
+AST_NODETYPE(LOOP,         "LOOP",         1, NONTERMINAL,      NONE)
+AST_NODETYPE(WHILE,        "WHILE",        2, NONTERMINAL,      NONE)
+AST_NODETYPE(REPEAT,       "REPEAT",       2, NONTERMINAL,      NONE)
+AST_NODETYPE(FORTO,        "FORTO",        5, NONTERMINAL,      NONE)
+AST_NODETYPE(EXIT,         "EXIT",         0, NONTERMINAL,      NONE)
+AST_NODETYPE(ARGS,         "ARGS",         1, NONTERMINAL_LIST, NONE)
+AST_NODETYPE(ELSIFSEQ,     "ELSIFSEQ",     1, NONTERMINAL_LIST, NONE)
+AST_NODETYPE(ELSIF,        "ELSIF",        2, NONTERMINAL,      NONE)
+AST_NODETYPE(CASELIST,     "CASELIST",     1, NONTERMINAL_LIST, NONE)
+AST_NODETYPE(CASE,         "CASE",         2, NONTERMINAL,      NONE)
+AST_NODETYPE(ELEMLIST,     "ELEMLIST",     1, NONTERMINAL_LIST, NONE)
+AST_NODETYPE(RANGE,        "RANGE",        2, NONTERMINAL,      NONE)
+
+/* Designator Subnode Types */
+
+AST_NODETYPE(FIELD,        "FIELD",        1, NONTERMINAL,      NONE)
+AST_NODETYPE(INDEX,        "INDEX",        1, NONTERMINAL_LIST, NONE)
+
+/* Expression Node Types */
+
+AST_NODETYPE(DESIG,        "DESIG",        2, NONTERMINAL,      NONE)
+AST_NODETYPE(DEREF,        "DEREF",        1, NONTERMINAL,      NONE)
+AST_NODETYPE(NEG,          "NEG",          1, NONTERMINAL,      NONE)
+AST_NODETYPE(NOT,          "NOT",          1, NONTERMINAL,      NONE)
+AST_NODETYPE(EQ,           "EQ",           2, NONTERMINAL,      NONE)
+AST_NODETYPE(NEQ,          "NEQ",          2, NONTERMINAL,      NONE)
+AST_NODETYPE(LT,           "<",            2, NONTERMINAL,      NONE)
+AST_NODETYPE(LTEQ,         "<=",           2, NONTERMINAL,      NONE)
+AST_NODETYPE(GT,           ">",            2, NONTERMINAL,      NONE)
+AST_NODETYPE(GTEQ,         ">=",           2, NONTERMINAL,      NONE)
+AST_NODETYPE(IN,           "IN",           2, NONTERMINAL,      NONE)
+AST_NODETYPE(PLUS,         "+",            2, NONTERMINAL,      NONE)
+AST_NODETYPE(MINUS,        "-",            2, NONTERMINAL,      NONE)
+AST_NODETYPE(OR,           "OR",           2, NONTERMINAL,      NONE)
+AST_NODETYPE(ASTERISK,     "*",            2, NONTERMINAL,      NONE)
+AST_NODETYPE(SOLIDUS,      "/",            2, NONTERMINAL,      NONE)
+AST_NODETYPE(DIV,          "DIV",          2, NONTERMINAL,      NONE)
+AST_NODETYPE(MOD,          "MOD",          2, NONTERMINAL,      NONE)
+AST_NODETYPE(AND,          "AND",          2, NONTERMINAL,      NONE)
+AST_NODETYPE(FCALL,        "FCALL",        2, NONTERMINAL,      NONE)
+AST_NODETYPE(SETVAL,       "SETVAL",       2, NONTERMINAL,      NONE)
+
+/* Identifier Node Types */
+
+AST_NODETYPE(IDENT,        "IDENT",        1, TERMINAL,         UNQUOTED)
+AST_NODETYPE(QUALIDENT,    "QUALIDENT",    2, TERMINAL_LIST,    UNQUOTED)
+
+/* Literal Value Node Types */
+
+AST_NODETYPE(INTVAL,       "INTVAL",       1, TERMINAL,         INTEGER)
+AST_NODETYPE(REALVAL,      "REALVAL",      1, TERMINAL,         UNQUOTED)
+AST_NODETYPE(CHRVAL,       "CHRVAL",       1, TERMINAL,         CHAR)
+AST_NODETYPE(QUOTEDVAL,    "QUOTEDVAL",    1, TERMINAL,         QUOTED)
+AST_NODETYPE(IDENTLIST,    "IDENTLIST",    1, TERMINAL_LIST,    UNQUOTED)
+
+/* Compilation Parameter Node Types */
+
+AST_NODETYPE(FILENAME,     "FILENAME",     1, TERMINAL,         QUOTED)
+AST_NODETYPE(OPTIONS,      "OPTIONS",      1, TERMINAL_LIST,    QUOTED)
+
+/* END OF FILE */
@@ -36,220 +36,91 @@
 #include "m2-ast-nodetype.h"
 
 
+#include <stddef.h>
+
+
+/* --------------------------------------------------------------------------
+ * external definitions of inline functions
+ * ----------------------------------------------------------------------- */
+
+extern inline bool m2c_ast_is_valid_nodetype (m2c_ast_nodetype_t node_type);
+
+extern inline bool m2c_ast_is_nonterminal_nodetype
+  (m2c_ast_nodetype_t node_type);
+
+extern inline bool m2c_ast_is_terminal_nodetype (m2c_ast_nodetype_t node_type);
+
+extern inline bool m2c_ast_is_list_nodetype (m2c_ast_nodetype_t node_type);
+
+extern inline bool m2c_ast_is_legal_subnode_count
+  (m2c_ast_nodetype_t node_type, uint_t subnode_count);
+
+extern inline m2c_ast_print_class_t m2c_ast_print_class_for_nodetype
+  (m2c_ast_nodetype_t node_type);
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_ast_name_pool_t
+ * --------------------------------------------------------------------------
+ * Record type with one character array per node type, holding its NUL
+ * terminated name.  The arrays are laid out back to back without padding,
+ * the offset of a member is therefore the offset of the name in the pool.
+ * ----------------------------------------------------------------------- */
+
+#define AST_NODETYPE(_id, _name, _arity, _kind, _print_class) \
+  char _id[sizeof(_name)];
+
+typedef struct {
+#include "m2-ast-nodetype-inits.h"
+} m2c_ast_name_pool_t;
+
+#undef AST_NODETYPE
+
+
 /* --------------------------------------------------------------------------
- * array m2c_ast_nodetype_name_table
+ * private variable m2c_ast_name_pool
  * --------------------------------------------------------------------------
  * Human readable names for node types.
  * ----------------------------------------------------------------------- */
 
-static const char *m2c_ast_nodetype_name_table[] {
-  "EMPTY\0",
-  "AST\0",
-  "DEFMOD\0",
-  "IMPLIST\0",
-  "IMPORT\0",
-  "UNQIMP\0",
-  "DEFLIST\0",
-  "CONSTDEF\0",
-  "TYPEDEF\0",
-  "PROCDEF\0",
-  "SUBR\0",
-  "ENUM\0",
-  "SET\0",
-  "ARRAY\0",
-  "RECORD\0",
-  "POINTER\0",
-  "PROCTYPE\0",
-  "EXTREC\0",
-  "VRNTREC\0",
-  "INDEXLIST\0",
-  "INDEXTYPE\0",
-  "FIELDLISTSEQ\0",
-  "FIELDLIST\0",
-  "VFLISTSEQ\0",
-  "VFLIST\0",
-  "VARIANTLIST\0",
-  "VARIANT\0",
-  "CLABELLIST\0",
-  "CLABELS\0",
-  "FTYPELIST\0",
-  "ARGLIST\0",
-  "OPENARRAY\0",
-  "CONSTP\0",
-  "VARP\0",
-  "FPARAMLIST\0",
-  "FPARAMS\0",
-  "IMPMOD\0",
-  "BLOCK\0",
-  "DECLLIST\0",
-  "TYPEDECL\0",
-  "VARDECL\0",
-  "PROC\0",
-  "MODDECL\0",
-  "VSREC\0",
-  "VSFIELD\0",
-  "EXPORT\0",
-  "QUALEXP\0",
-  "STMTSEQ\0",
-  "ASSIGN\0",
-  "PCALL\0",
-  "RETURN\0",
-  "WITH\0",
-  "IF\0",
-  "SWITCH\0",
-  "LOOP\0",
-  "WHILE\0",
-  "REPEAT\0",
-  "FORTO\0",
-  "EXIT\0",
-  "ARGS\0",
-  "ELSIFSEQ\0",
-  "ELSIF\0",
-  "CASELIST\0",
-  "CASE\0",
-  "ELEMLIST\0",
-  "RANGE\0",
-  "FIELD\0",
-  "INDEX\0",
-  "DESIG\0",
-  "DEREF\0",
-  "NEG\0",
-  "NOT\0",
-  "EQ\0",
-  "NEQ\0",
-  "<\0",
-  "<=\0",
-  ">\0",
-  ">=\0",
-  "IN\0",
-  "+\0",
-  "-\0",
-  "OR\0",
-  "*\0",
-  "/\0",
-  "DIV\0",
-  "MOD\0",
-  "AND\0",
-  "FCALL\0",
-  "SETVAL\0",
-  "IDENT\0",
-  "QUALIDENT\0",
-  "INTVAL\0",
-  "REALVAL\0",
-  "CHRVAL\0",
-  "QUOTEDVAL\0",
-  "IDENTLIST\0",
-  "FILENAME\0",
-  "OPTIONS\0",
-}; /* end m2c_ast_nodetype_name_table */
+#define AST_NODETYPE(_id, _name, _arity, _kind, _print_class) _name,
+
+static const m2c_ast_name_pool_t m2c_ast_name_pool = {
+#include "m2-ast-nodetype-inits.h"
+}; /* end m2c_ast_name_pool */
+
+#undef AST_NODETYPE
 
 
 /* --------------------------------------------------------------------------
- * array m2c_ast_nodetype_arity_table
+ * array m2c_ast_nodeinfo_table
  * --------------------------------------------------------------------------
- * Arity values for node types.
+ * Metadata for all valid node types, indexed by node type.
  * ----------------------------------------------------------------------- */
 
-static const int8_t m2c_ast_nodetype_arity_table[] {
-  /* AST_EMPTY */         0,
-  /* AST_ROOT */          3,
-  /* AST_DEFMOD */        3,
-  /* AST_IMPLIST */      -1, /* variadic, arity >= 1 */
-  /* AST_IMPORT */        1,
-  /* AST_UNQIMP */        2,
-  /* AST_DEFLIST */      -1, /* variadic, arity >= 1 */
-  /* AST_CONSTDEF */      2,
-  /* AST_TYPEDEF */       2,
-  /* AST_PROCDEF */       3,
-  /* AST_SUBR */          3,
-  /* AST_ENUM */          1,
-  /* AST_SET */           1,
-  /* AST_ARRAY */         2,
-  /* AST_RECORD */        1,
-  /* AST_POINTER */       1,
-  /* AST_PROCTYPE */      2,
-  /* AST_EXTREC */        2,
-  /* AST_VRNTREC */       1,
-  /* AST_INDEXLIST */    -1, /* variadic, arity >= 1 */
-  /* AST_INDEXTYPE */     1,
-  /* AST_FIELDLISTSEQ */ -1, /* variadic, arity >= 1 */
-  /* AST_FIELDLIST */     2,
-  /* AST_VFLISTSEQ */    -1, /* variadic, arity >= 1 */
-  /* AST_VFLIST */        4,
-  /* AST_VARIANTLIST */  -1, /* variadic, arity >= 1 */
-  /* AST_VARIANT */       2,
-  /* AST_CLABELLIST */   -1, /* variadic, arity >= 1 */
-  /* AST_CLABELS */       2,
-  /* AST_FTYPELIST */    -1, /* variadic, arity >= 1 */
-  /* AST_ARGLIST */      -1, /* variadic, arity >= 1 */
-  /* AST_OPENARRAY */     1,
-  /* AST_CONSTP */        1,
-  /* AST_VARP */          1,
-  /* AST_FPARAMLIST */   -1, /* variadic, arity >= 1 */
-  /* AST_FPARAMS */       2,
-  /* AST_IMPMOD */        4,
-  /* AST_BLOCK */         2,
-  /* AST_DECLLIST */     -1, /* variadic, arity >= 1 */
-  /* AST_TYPEDECL */      2,
-  /* AST_VARDECL */       2,
-  /* AST_PROC */          4,
-  /* AST_MODDECL */       5,
-  /* AST_VSREC */         2,
-  /* AST_VSFIELD */       3,
-  /* AST_EXPORT */        1,
-  /* AST_QUALEXP */       1,
-  /* AST_STMTSEQ */      -1, /* variadic, arity >= 1 */
-  /* AST_ASSIGN */        2,
-  /* AST_PCALL */         2,
-  /* AST_RETURN */        1,
-  /* AST_WITH */          2,
-  /* AST_IF */            4,
-  /* AST_SWITCH */        3,
-  /* AST_LOOP */          1,
-  /* AST_WHILE */         2,
-  /* AST_REPEAT */        2,
-  /* AST_FORTO */         5,
-  /* AST_EXIT */          0,
-  /* AST_ARGS */         -1, /* variadic, arity >= 1 */
-  /* AST_ELSIFSEQ */     -1, /* variadic, arity >= 1 */
-  /* AST_ELSIF */         2,
-  /* AST_CASELIST */     -1, /* variadic, arity >= 1 */
-  /* AST_CASE */          2,
-  /* AST_ELEMLIST */     -1, /* variadic, arity >= 1 */
-  /* AST_RANGE */         2,
-  /* AST_FIELD */         1,
-  /* AST_INDEX */        -1, /* variadic, arity >= 1 */
-  /* AST_DESIG */         2,
-  /* AST_DEREF */         1,
-  /* AST_NEG */           1,
-  /* AST_NOT */           1,
-  /* AST_EQ */            2,
-  /* AST_NEQ */           2,
-  /* AST_LT */            2,
-  /* AST_LTEQ */          2,
-  /* AST_GT */            2,
-  /* AST_GTEQ */          2,
-  /* AST_IN */            2,
-  /* AST_PLUS */          2,
-  /* AST_MINUS */         2,
-  /* AST_OR */            2,
-  /* AST_ASTERISK */      2,
-  /* AST_SOLIDUS */       2,
-  /* AST_DIV */           2,
-  /* AST_MOD */           2,
-  /* AST_AND */           2,
-  /* AST_FCALL */         2,  
-  /* AST_SETVAL */        2,
-  /* AST_IDENT */         1,
-  /* AST_QUALIDENT */    -2, /* variadic, arity >= 2 */
-  /* AST_INTVAL */        1,
-  /* AST_REALVAL */       1,
-  /* AST_CHRVAL */        1,
-  /* AST_QUOTEDVAL */     1
-  /* AST_IDENTLIST */    -1, /* variadic, arity >= 1 */
-  /* AST_FILENAME */      1,
-  /* AST_OPTIONS */      -1, /* variadic, arity >= 1 */
-}; /* end m2c_ast_nodetype_arity_table */
+#define NODEINFO_KIND_NONTERMINAL \
+  (M2C_AST_NODEINFO_NONTERMINAL)
+
+#define NODEINFO_KIND_NONTERMINAL_LIST \
+  (M2C_AST_NODEINFO_NONTERMINAL | M2C_AST_NODEINFO_LIST)
+
+#define NODEINFO_KIND_TERMINAL \
+  (M2C_AST_NODEINFO_TERMINAL)
+
+#define NODEINFO_KIND_TERMINAL_LIST \
+  (M2C_AST_NODEINFO_TERMINAL | M2C_AST_NODEINFO_LIST)
+
+#define AST_NODETYPE(_id, _name, _arity, _kind, _print_class) \
+  { /* arity */ _arity, \
+    /* flags */ NODEINFO_KIND_##_kind | \
+      (M2C_AST_PRINT_##_print_class << M2C_AST_NODEINFO_PRINT_CLASS_SHIFT), \
+    /* name_offset */ offsetof(m2c_ast_name_pool_t, _id) },
+
+const m2c_ast_nodeinfo_t m2c_ast_nodeinfo_table[AST_INVALID] = {
+#include "m2-ast-nodetype-inits.h"
+}; /* end m2c_ast_nodeinfo_table */
+
+#undef AST_NODETYPE
 
 
 /* --------------------------------------------------------------------------
@@ -271,7 +142,7 @@ static const int8_t m2c_ast_nodetype_arity_table[] {
    (_nodetype == AST_VARDECL))
 
 #define IS_TYPE(_nodetype) \
-  (((IS_IDENT_OR_QUALIDENT(_nodetype)) || \
+  ((IS_IDENT_OR_QUALIDENT(_nodetype)) || \
    ((_nodetype >= AST_FIRST_TYPEDEFN_NODETYPE) && \
     (_nodetype <= AST_LAST_TYPEDEFN_NODETYPE)))
 
@@ -279,11 +150,11 @@ static const int8_t m2c_ast_nodetype_arity_table[] {
   ((IS_TYPE(_nodetype)) || (_nodetype == AST_EMPTY))
 
 #define IS_FIELDTYPE(_nodetype) \
-  (((IS_IDENT_OR_QUALIDENT(_nodetype)) || \
+  ((IS_IDENT_OR_QUALIDENT(_nodetype)) || \
    ((_nodetype >= AST_FIRST_FIELDTYPE_NODETYPE) && \
     (_nodetype <= AST_LAST_FIELDTYPE_NODETYPE)))
 
-#defie IS_QUALIDENT_OR_EMPTY(_nodetype) \
+#define IS_QUALIDENT_OR_EMPTY(_nodetype) \
   ((_nodetype == AST_QUALIDENT) || (_nodetype == AST_EMPTY))
 
 #define IS_COUNTABLE_TYPE(_nodetype) \
@@ -315,8 +186,8 @@ static const int8_t m2c_ast_nodetype_arity_table[] {
    (_nodetype == AST_ARGLIST) || (_nodetype == AST_OPENARRAY))
   
 #define IS_FORMAL_TYPE(_nodetype) \
-  (IS_SIMPLE_FORMAL_TYPE(_nodetype) ||
-   (_nodetype == AST_CONST) || (_nodetype == AST_VAR));
+  (IS_SIMPLE_FORMAL_TYPE(_nodetype) || \
+   (_nodetype == AST_CONSTP) || (_nodetype == AST_VARP))
 
 #define IS_FPARAMLIST_OR_EMPTY(_nodetype) \
   ((_nodetype == AST_FPARAMLIST) || (_nodetype == AST_EMPTY))
@@ -356,7 +227,7 @@ static const int8_t m2c_ast_nodetype_arity_table[] {
   ((IS_IDENT_OR_QUALIDENT(_nodetype)) || (_nodetype == AST_DEREF))
 
 #define IS_DESIG_TAIL(_nodetype) \
-  ((_nodetype == AST_FIELD) || \ (_nodetype == AST_INDEX))
+  ((_nodetype == AST_FIELD) || (_nodetype == AST_INDEX))
 
 #define IS_STMT(_nodetype) \
   ((_nodetype >= AST_FIRST_STATEMENT_NODETYPE) && \
@@ -376,53 +247,6 @@ static const int8_t m2c_ast_nodetype_arity_table[] {
   ((_nodetype == AST_ELEMLIST) || (_nodetype == AST_EMPTY))
 
 
-/* --------------------------------------------------------------------------
- * function m2c_ast_is_list_nodetype(node_type)
- * --------------------------------------------------------------------------
- * Returns true if node_type is a list node type, otherwise false.
- * ----------------------------------------------------------------------- */
-
-bool m2c_ast_is_list_nodetype (m2c_ast_nodetype_t node_type) {
-  int arity;
-  
-  if (!m2c_ast_is_valid_nodetype(node_type)) {
-    return false;
-  } /* end if */
-  
-  arity = m2c_ast_nodetype_arity_table[node_type];
-  
-  return (arity < 0);
-} /* end m2c_ast_is_list_nodetype */
-
-
-/* --------------------------------------------------------------------------
- * function m2c_ast_is_legal_subnode_count(node_type, subnode_count)
- * --------------------------------------------------------------------------
- * Returns true if the given subnode count is a legal value for the given
- * node type, otherwise false.
- * ----------------------------------------------------------------------- */
-
-bool m2c_ast_is_legal_subnode_count
-  (m2c_ast_nodetype_t node_type, uint_t subnode_count) {
-  int arity;
-  
-  if (!m2c_ast_is_valid_nodetype(node_type)) {
-    return false;
-  } /* end if */
-  
-  arity = m2c_ast_nodetype_arity_table[node_type];
-  
-  if (arity >= 0) {
-    return (subnode_count == (uint_t) arity);
-  }
-  else /* variadic */ {
-    arity = (-1) * arity;
-    return (subnode_count >= (uint_t) arity);
-  } /* end if */
-  
-} /* end m2c_ast_is_legal_subnode_count */
-
-
 /* --------------------------------------------------------------------------
  * function m2c_ast_is_legal_subnode_type(node_type, subnode_type, index)
  * --------------------------------------------------------------------------
@@ -480,7 +304,7 @@ bool m2c_ast_is_legal_subnode_type
       } /* end switch */
     
     /* Definition List */
-    case DEFLIST :
+    case AST_DEFLIST :
       return (IS_DEFINITION(subnode_type));
     
     /* Const Definition */
@@ -634,7 +458,7 @@ bool m2c_ast_is_legal_subnode_type
     case AST_OPENARRAY :
       return
         ((subnode_index == 0) &&
-         (IS_IDENT_OR_QUALIDENT(subnode_type));
+         (IS_IDENT_OR_QUALIDENT(subnode_type)));
     
     /* CONST and VAR Parameters */
     case AST_CONSTP :
@@ -742,12 +566,6 @@ bool m2c_ast_is_legal_subnode_type
          ((subnode_index == 0) &&
           (subnode_type == AST_IDENTLIST));
     
-    /* Statement Sequence */
-    case AST_STMTSEQ :
-       return
-         ((subnode_index == 0) &&
-          (IS_STMT(subnode_type)));
-    
     /* Assignment */
     case AST_ASSIGN :
       switch (subnode_index) {
@@ -868,6 +686,7 @@ bool m2c_ast_is_legal_subnode_type
     
     /* Expression Range */
     case AST_RANGE :
+       return
          (((subnode_index == 0) || (subnode_index == 1)) &&
           (IS_EXPR(subnode_type)));
     
@@ -879,9 +698,7 @@ bool m2c_ast_is_legal_subnode_type
     
     /* Array Subscript */
     case AST_INDEX :
-       return
-         ((subnode_index == 0) &&
-          (IS_EXPR(subnode_type)));
+       return (IS_EXPR(subnode_type));
     
     /* Designator */
     case AST_DESIG :
@@ -915,9 +732,9 @@ bool m2c_ast_is_legal_subnode_type
     case AST_PLUS :
     case AST_MINUS :
     case AST_OR :
-    case AST_MUL :
-    case AST_RDIV :
-    case AST_EDIV :
+    case AST_ASTERISK :
+    case AST_SOLIDUS :
+    case AST_DIV :
     case AST_MOD :
     case AST_AND :
       return
@@ -962,7 +779,9 @@ const char *m2c_name_for_nodetype (m2c_ast_nodetype_t node_type) {
     return NULL;
   } /* end if */
   
-  return m2c_ast_nodetype_name_table[node_type];
+  return
+    ((const char *) &m2c_ast_name_pool) +
+    m2c_ast_nodeinfo_table[node_type].name_offset;
   
 } /* end m2c_name_for_nodetype */
 
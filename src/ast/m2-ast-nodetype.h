@@ -39,155 +39,20 @@
 #include "m2-common.h"
 
 #include <stdbool.h>
+#include <stdint.h>
 
 
 /* --------------------------------------------------------------------------
- * type m2c_astnode_type_t
+ * type m2c_ast_nodetype_t
  * --------------------------------------------------------------------------
- * Enumerated values representing AST node types.
+ * Enumerated values representing AST node types.  The node types are
+ * defined in m2-ast-nodetype-inits.h, all values have prefix AST_.
  * ----------------------------------------------------------------------- */
 
-typedef enum {
-  /* Empty Node Type */
-  
-  AST_EMPTY,
-  
-  /* Root Node Type */
-  
-  AST_ROOT,
-  
-  /* Definition Module Non-Terminal Node Types */
+#define AST_NODETYPE(_id, _name, _arity, _kind, _print_class) AST_##_id,
 
-  AST_DEFMOD,             /* definition module node type */
-  AST_IMPLIST,            /* qualified import list node type */
-  AST_IMPORT,             /* qualified import list node type */
-  AST_UNQIMP,             /* unqualified import list node type */
-  AST_DEFLIST,            /* definition list node type */
-  
-  AST_CONSTDEF,           /* constant definition node type */
-  AST_TYPEDEF,            /* type definition node type */
-  AST_PROCDEF,            /* procedure definition node type */
-  
-  AST_SUBR,               /* subrange type node type */
-  AST_ENUM,               /* enumeration type node type */
-  AST_SET,                /* set type node type */
-  AST_ARRAY,              /* array type node type */
-  AST_RECORD,             /* simple record type node type */
-  AST_POINTER,            /* pointer type node type */
-  AST_PROCTYPE,           /* procedure type node type */
-  
-  AST_EXTREC,             /* extensible record type node type */
-  AST_VRNTREC,            /* variant record type node type */
-  
-  AST_INDEXLIST,          /* array index type list node type */
-  
-  AST_FIELDLISTSEQ,       /* field list sequence node type */
-  AST_FIELDLIST,          /* field list node type */
-  AST_VFLISTSEQ,          /* variant field list sequence node type */
-  AST_VFLIST,             /* variant field list node type */
-  AST_VARIANTLIST,        /* variant list node type */
-  AST_VARIANT,            /* variant node type */
-  AST_CLABELLIST,         /* case label list node type */
-  AST_CLABELS,            /* case labels node type */
-  
-  AST_FTYPELIST,          /* formal type list node type */
-  AST_ARGLIST,            /* variadic parameter list formal type node type */
-  AST_OPENARRAY,          /* open array formal type node type */
-  AST_CONSTP,             /* CONST formal type node type */
-  AST_VARP,               /* VAR formal type node type */
-  AST_FPARAMLIST,         /* formal parameter list node type */
-  AST_FPARAMS,            /* formal parameters node type */
-
-  /* Implementation/Program Module AST Node Types */
-
-  AST_IMPMOD,             /* implementation/program module node type */
-  AST_BLOCK,              /* block node type */
-  AST_DECLLIST,           /* declaration list node type */
-  
-  AST_TYPEDECL,           /* type declaration node type */
-  AST_VARDECL,            /* variable declaration node type */
-  AST_PROC,               /* procedure declaration node type */
-  AST_MODDECL,            /* local module declaration node type */
-  
-  AST_VSREC,              /* variable size record type node type */
-  AST_VSFIELD,            /* variable size field node type */
-  
-  AST_EXPORT,             /* unqualified export list node type */
-  AST_QUALEXP,            /* qualified export list node type */
-  
-  AST_STMTSEQ,            /* statement sequence node type */
-  
-  AST_ASSIGN,             /* assignment node type */
-  AST_PCALL,              /* procedure call node type */
-  AST_RETURN,             /* RETURN statement node type */
-  AST_WITH,               /* WITH statement node type */
-  AST_IF,                 /* IF statement node type */
-  AST_SWITCH,             /* CASE statement node type */
-  AST_LOOP,               /* LOOP statement node type */
-  AST_WHILE,              /* WHILE statement node type */
-  AST_REPEAT,             /* REPEAT statement node type */
-  AST_FORTO,              /* FOR TO statement node type */
-  AST_EXIT,               /* EXIT statement node type */
-  
-  AST_ARGS,               /* actual parameter list node type */
-  
-  AST_ELSIFSEQ,           /* ELSIF branch sequence node type */
-  AST_ELSIF,              /* ELSIF branch node type */
-  AST_CASELIST,           /* case list node type */
-  AST_CASE,               /* case branch node type */
-  AST_ELEMLIST,           /* element list node type */
-  AST_RANGE,              /* expression range node type */
-  
-  /* Designator Subnode Types */
-  
-  AST_FIELD,              /* record field selector node type */
-  AST_INDEX,              /* array subscript node type */
-  
-  /* Expression Node Types */
-  
-  AST_DESIG,              /* designator node type */
-  AST_DEREF,              /* pointer dereference node type */
-  
-  AST_NEG,                /* arithmetic negation sub-expression node */
-  AST_NOT,                /* logical negation sub-expression node */
-  
-  AST_EQ,                 /* equality sub-expression node */
-  AST_NEQ,                /* inequality sub-expression node */
-  AST_LT,                 /* less-than sub-expression node */
-  AST_LTEQ,               /* less-than-or-equal sub-expression node */
-  AST_GT,                 /* greater-than sub-expression node */
-  AST_GTEQ,               /* greater-than-or-equal sub-expression node */
-  AST_IN,                 /* set membership sub-expression node */
-  AST_PLUS,               /* plus sub-expression node */
-  AST_MINUS,              /* minus sub-expression node */
-  AST_OR,                 /* logical disjunction sub-expression node */
-  AST_ASTERISK,           /* asterisk sub-expression node */
-  AST_SOLIDUS,            /* solidus sub-expression node */
-  AST_DIV,                /* euclidean division sub-expression node */
-  AST_MOD,                /* modulus sub-expression node */
-  AST_AND,                /* logical conjunction expression node */
-  
-  AST_FCALL,              /* function call node */
-  AST_SETVAL,             /* set value node */
-  
-  /* Identifier Node Types */
-  
-  AST_IDENT,              /* identifier node type */
-  AST_QUALIDENT,          /* qualified identifier node type */
-  
-  /* Literal Value Node Types */
-  
-  AST_INTVAL,             /* whole number value node */
-  AST_REALVAL,            /* real number value node */
-  AST_CHRVAL,             /* character code value node */
-  AST_QUOTEDVAL,          /* quoted literal value node */
-  
-  AST_IDENTLIST,          /* identifier list node type */
-  
-  /* Compilation Parameter Node Types */
-  
-  AST_FILENAME,           /* filename node type */
-  AST_OPTIONS,            /* compiler option list node type */
+typedef enum {
+#include "m2-ast-nodetype-inits.h"
   
   /* Invalid Node Type */
   
@@ -196,7 +61,9 @@ typedef enum {
   /* Enumeration Terminator */
   
   AST_END_MARK /* marks the end of this enumeration */
-} m2c_astnode_type_t;
+} m2c_ast_nodetype_t;
+
+#undef AST_NODETYPE
 
 
 /* --------------------------------------------------------------------------
@@ -204,12 +71,12 @@ typedef enum {
  * ----------------------------------------------------------------------- */
 
 #define AST_FIRST_VALID_NODETYPE AST_EMPTY
-#define AST_LAST_VALID_NODETYPE AST_QUOTEDVAL
+#define AST_LAST_VALID_NODETYPE AST_OPTIONS
 
 #define AST_FIRST_NONTERMINAL_NODETYPE AST_EMPTY
 #define AST_LAST_NONTERMINAL_NODETYPE AST_SETVAL
 
-#define AST_FIRST_TERMINAL_NODETYPE AST_INTVAL
+#define AST_FIRST_TERMINAL_NODETYPE AST_IDENT
 #define AST_LAST_TERMINAL_NODETYPE AST_OPTIONS
 
 #define AST_FIRST_DEFINITION_NODETYPE AST_CONSTDEF
@@ -234,6 +101,73 @@ typedef enum {
 #define AST_LAST_LITERAL_NODETYPE AST_QUOTEDVAL
 
 
+/* --------------------------------------------------------------------------
+ * Build parameter M2C_AST_VALIDATE
+ * --------------------------------------------------------------------------
+ * If non-zero, AST node constructors verify the number and the node types
+ * of the subnodes passed in against the node type.  Validation is enabled
+ * by default and disabled in release builds which define NDEBUG.
+ * ----------------------------------------------------------------------- */
+
+#ifndef M2C_AST_VALIDATE
+#ifdef NDEBUG
+#define M2C_AST_VALIDATE 0
+#else
+#define M2C_AST_VALIDATE 1
+#endif
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_ast_print_class_t
+ * --------------------------------------------------------------------------
+ * Enumerated values representing the format in which the values of terminal
+ * nodes are written.  Nonterminal nodes have print class M2C_AST_PRINT_NONE.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_AST_PRINT_NONE,      /* no values */
+  M2C_AST_PRINT_UNQUOTED,  /* values written as is */
+  M2C_AST_PRINT_INTEGER,   /* whole number literals */
+  M2C_AST_PRINT_CHAR,      /* character code literals */
+  M2C_AST_PRINT_QUOTED     /* values written as quoted strings */
+} m2c_ast_print_class_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_ast_nodeinfo_t
+ * --------------------------------------------------------------------------
+ * Record type representing the metadata of a node type.  Entries are packed
+ * into four bytes, sixteen node types share a 64 byte cache line.
+ *
+ * arity       : number of subnodes or values, the minimum for list kinds
+ * flags       : kind bits in bits 0 and 1, print class in bits 4 to 6
+ * name_offset : offset of the human readable name within the name pool
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* arity */ uint8_t arity;
+  /* flags */ uint8_t flags;
+  /* name_offset */ uint16_t name_offset;
+} m2c_ast_nodeinfo_t;
+
+#define M2C_AST_NODEINFO_TERMINAL 0x01
+#define M2C_AST_NODEINFO_LIST 0x02
+#define M2C_AST_NODEINFO_NONTERMINAL 0x00
+
+#define M2C_AST_NODEINFO_PRINT_CLASS_SHIFT 4
+#define M2C_AST_NODEINFO_PRINT_CLASS_MASK 0x70
+
+
+/* --------------------------------------------------------------------------
+ * array m2c_ast_nodeinfo_table
+ * --------------------------------------------------------------------------
+ * Metadata for all valid node types, indexed by node type.
+ * ----------------------------------------------------------------------- */
+
+extern const m2c_ast_nodeinfo_t m2c_ast_nodeinfo_table[AST_INVALID];
+
+
 /* --------------------------------------------------------------------------
  * function m2c_ast_is_valid_nodetype(node_type)
  * --------------------------------------------------------------------------
@@ -242,9 +176,7 @@ typedef enum {
  * ----------------------------------------------------------------------- */
 
 inline bool m2c_ast_is_valid_nodetype (m2c_ast_nodetype_t node_type) {
-  return
-    ((node_type >= AST_FIRST_VALID_NODETYPE) &&
-     (node_type <= AST_LAST_VALID_NODETYPE));
+  return ((uint_t) node_type < (uint_t) AST_INVALID);
 } /* end m2c_ast_is_valid_nodetype */
 
 
@@ -256,8 +188,9 @@ inline bool m2c_ast_is_valid_nodetype (m2c_ast_nodetype_t node_type) {
 
 inline bool m2c_ast_is_nonterminal_nodetype (m2c_ast_nodetype_t node_type) {
   return
-    ((node_type >= AST_FIRST_NONTERMINAL_NODETYPE) &&
-     (node_type <= AST_LAST_NONTERMINAL_NODETYPE));
+    ((m2c_ast_is_valid_nodetype(node_type)) &&
+     ((m2c_ast_nodeinfo_table[node_type].flags &
+       M2C_AST_NODEINFO_TERMINAL) == 0));
 } /* end m2c_ast_is_nonterminal_nodetype */
 
 
@@ -269,8 +202,9 @@ inline bool m2c_ast_is_nonterminal_nodetype (m2c_ast_nodetype_t node_type) {
 
 inline bool m2c_ast_is_terminal_nodetype (m2c_ast_nodetype_t node_type) {
   return
-    ((node_type >= AST_FIRST_TERMINAL_NODETYPE) &&
-     (node_type <= AST_LAST_TERMINAL_NODETYPE));
+    ((m2c_ast_is_valid_nodetype(node_type)) &&
+     ((m2c_ast_nodeinfo_table[node_type].flags &
+       M2C_AST_NODEINFO_TERMINAL) != 0));
 } /* end m2c_ast_is_terminal_nodetype */
 
 
@@ -280,7 +214,12 @@ inline bool m2c_ast_is_terminal_nodetype (m2c_ast_nodetype_t node_type) {
  * Returns true if node_type is a list node type, otherwise false.
  * ----------------------------------------------------------------------- */
 
-bool m2c_ast_is_list_nodetype (m2c_ast_nodetype_t node_type);
+inline bool m2c_ast_is_list_nodetype (m2c_ast_nodetype_t node_type) {
+  return
+    ((m2c_ast_is_valid_nodetype(node_type)) &&
+     ((m2c_ast_nodeinfo_table[node_type].flags &
+       M2C_AST_NODEINFO_LIST) != 0));
+} /* end m2c_ast_is_list_nodetype */
 
 
 /* --------------------------------------------------------------------------
@@ -290,8 +229,46 @@ bool m2c_ast_is_list_nodetype (m2c_ast_nodetype_t node_type);
  * node type, otherwise false.
  * ----------------------------------------------------------------------- */
 
-bool m2c_ast_is_legal_subnode_count
-  (m2c_ast_nodetype_t node_type, uint_t subnode_count);
+inline bool m2c_ast_is_legal_subnode_count
+  (m2c_ast_nodetype_t node_type, uint_t subnode_count) {
+  
+  m2c_ast_nodeinfo_t info;
+  
+  if (!m2c_ast_is_valid_nodetype(node_type)) {
+    return false;
+  } /* end if */
+  
+  info = m2c_ast_nodeinfo_table[node_type];
+  
+  if ((info.flags & M2C_AST_NODEINFO_LIST) != 0) {
+    return (subnode_count >= info.arity);
+  }
+  else {
+    return (subnode_count == info.arity);
+  } /* end if */
+} /* end m2c_ast_is_legal_subnode_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_print_class_for_nodetype(node_type)
+ * --------------------------------------------------------------------------
+ * Returns the print class of node_type, or M2C_AST_PRINT_NONE if node_type
+ * is invalid or a nonterminal node type.
+ * ----------------------------------------------------------------------- */
+
+inline m2c_ast_print_class_t m2c_ast_print_class_for_nodetype
+  (m2c_ast_nodetype_t node_type) {
+  
+  if (!m2c_ast_is_valid_nodetype(node_type)) {
+    return M2C_AST_PRINT_NONE;
+  } /* end if */
+  
+  return
+    (m2c_ast_print_class_t)
+      ((m2c_ast_nodeinfo_table[node_type].flags &
+        M2C_AST_NODEINFO_PRINT_CLASS_MASK) >>
+       M2C_AST_NODEINFO_PRINT_CLASS_SHIFT);
+} /* end m2c_ast_print_class_for_nodetype */
 
 
 /* --------------------------------------------------------------------------
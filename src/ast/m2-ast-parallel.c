@@ -0,0 +1,306 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015, 2016 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * m2-ast-parallel.c
+ *
+ * Implementation of M2C parallel AST serialisation.
+ *
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute and/or modify it under the
+ * terms of the GNU Lesser General Public License (LGPL) either version 2.1
+ * or at your choice version 3 as published by the Free Software Foundation.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+
+#include "m2-ast-parallel.h"
+#include "m2-workpool.h"
+
+#include <stddef.h>
+#include <stdlib.h>
+
+
+/* --------------------------------------------------------------------------
+ * hidden type part_s
+ * --------------------------------------------------------------------------
+ * record type representing a part of the items of a list.  Fields sink and
+ * completed are written by the worker serialising the part.  Field queued
+ * is false if the part could not be submitted to the pool.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* first */ uint_t first;
+  /* count */ uint_t count;
+  /* queued */ bool queued;
+  /* sink */ m2c_outsink_t sink;
+  /* completed */ bool completed;
+} part_s;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type run_s
+ * --------------------------------------------------------------------------
+ * record type representing the context shared by all parts of a run.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* list */ m2c_astnode_t list;
+  /* writer */ m2c_ast_part_writer_t writer;
+  /* context */ void *context;
+} run_s;
+
+
+/* --------------------------------------------------------------------------
+ * Worker count setting
+ * ----------------------------------------------------------------------- */
+
+static uint_t parallel_worker_count = 0;
+
+
+/* --------------------------------------------------------------------------
+ * Forward declarations
+ * ----------------------------------------------------------------------- */
+
+static uint_t resolved_worker_count (void);
+
+static void write_part_job
+  (m2c_workpool_t pool, uint_t worker, void *job, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_ast_parallel_set_worker_count(worker_count)
+ * --------------------------------------------------------------------------
+ * Sets the number of workers used for parallel serialisation.
+ * ----------------------------------------------------------------------- */
+
+void m2c_ast_parallel_set_worker_count (uint_t worker_count) {
+  
+  parallel_worker_count = worker_count;
+  
+} /* end m2c_ast_parallel_set_worker_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_parallel_list(root)
+ * --------------------------------------------------------------------------
+ * Returns the top-level definition or declaration list of the module in
+ * the tree of root if its items are to be serialised in parallel, or NULL.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_ast_parallel_list (m2c_astnode_t root) {
+  
+  m2c_astnode_t module, block, list;
+  
+  if ((root == NULL) || (m2c_ast_nodetype(root) != AST_ROOT) ||
+      (resolved_worker_count() < 2)) {
+    return NULL;
+  } /* end if */
+  
+  /* (ROOT ident options module) */
+  module = m2c_ast_subnode_for_index(root, 2);
+  list = NULL;
+  
+  switch (m2c_ast_nodetype(module)) {
+    /* (DEFMOD ident implist deflist) */
+    case AST_DEFMOD :
+      list = m2c_ast_subnode_for_index(module, 2);
+      break;
+      
+    /* (IMPMOD ident prio implist (BLOCK decllist stmtseq)) */
+    case AST_IMPMOD :
+      block = m2c_ast_subnode_for_index(module, 3);
+      if (m2c_ast_nodetype(block) == AST_BLOCK) {
+        list = m2c_ast_subnode_for_index(block, 0);
+      } /* end if */
+      break;
+      
+    default :
+      break;
+  } /* end switch */
+  
+  if ((list == NULL) ||
+      ((m2c_ast_nodetype(list) != AST_DEFLIST) &&
+       (m2c_ast_nodetype(list) != AST_DECLLIST)) ||
+      (m2c_ast_subnode_count(list) < M2C_AST_PARALLEL_MIN_ITEMS)) {
+    return NULL;
+  } /* end if */
+  
+  return list;
+} /* end m2c_ast_parallel_list */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_parallel_write(sink, list, writer, context)
+ * --------------------------------------------------------------------------
+ * Serialises the items of list in parts on a pool of workers and writes
+ * the output of all parts to sink in item order.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_ast_parallel_write
+  (m2c_outsink_t sink, m2c_astnode_t list, m2c_ast_part_writer_t writer,
+   void *context) {
+  
+  uint_t item_count, part_count, worker_count, index, first;
+  m2c_workpool_status_t pool_status;
+  m2c_workpool_t pool;
+  part_s *part;
+  bool completed;
+  run_s run;
+  
+  item_count = m2c_ast_subnode_count(list);
+  worker_count = resolved_worker_count();
+  
+  /* determine number of parts */
+  part_count = worker_count * M2C_AST_PARALLEL_PARTS_PER_WORKER;
+  
+  if (part_count > M2C_AST_PARALLEL_MAX_PARTS) {
+    part_count = M2C_AST_PARALLEL_MAX_PARTS;
+  } /* end if */
+  
+  if (part_count > item_count) {
+    part_count = item_count;
+  } /* end if */
+  
+  part = NULL;
+  pool = NULL;
+  
+  if (part_count > 1) {
+    part = malloc(part_count * sizeof(part_s));
+  } /* end if */
+  
+  run.list = list;
+  run.writer = writer;
+  run.context = context;
+  
+  if (part != NULL) {
+    pool = m2c_new_workpool
+      (worker_count, write_part_job, &run, &pool_status);
+  } /* end if */
+  
+  /* fall back to serialising all items in sequence */
+  if (pool == NULL) {
+    free(part);
+    return writer(sink, list, 0, item_count, context);
+  } /* end if */
+  
+  /* divide items evenly, the first parts take any remainder */
+  first = 0;
+  for (index = 0; index < part_count; index++) {
+    part[index].first = first;
+    part[index].count = item_count / part_count;
+    
+    if (index < item_count % part_count) {
+      part[index].count++;
+    } /* end if */
+    
+    part[index].sink = NULL;
+    part[index].completed = false;
+    first = first + part[index].count;
+    
+    m2c_workpool_submit(pool, index, &part[index], &pool_status);
+    part[index].queued = (pool_status == M2C_WORKPOOL_STATUS_SUCCESS);
+  } /* end for */
+  
+  m2c_workpool_run(pool, &pool_status);
+  m2c_release_workpool(pool);
+  
+  /* write the output of all parts in order */
+  completed = true;
+  for (index = 0; index < part_count; index++) {
+    /* parts that could not be submitted are written here */
+    if (NOT(part[index].queued)) {
+      if (NOT(writer(sink,
+          list, part[index].first, part[index].count, context))) {
+        completed = false;
+      } /* end if */
+    }
+    else if (part[index].completed) {
+      m2c_outsink_write_sink(sink, part[index].sink);
+    }
+    else {
+      completed = false;
+    } /* end if */
+    
+    if (part[index].sink != NULL) {
+      m2c_outsink_close(&part[index].sink);
+    } /* end if */
+  } /* end for */
+  
+  free(part);
+  
+  return (completed) &&
+    (m2c_outsink_status(sink) == M2C_FILEIO_STATUS_SUCCESS);
+} /* end m2c_ast_parallel_write */
+
+
+/* *********************************************************************** *
+ * Private Functions                                                       *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private function resolved_worker_count()
+ * --------------------------------------------------------------------------
+ * Returns the number of workers to use for parallel serialisation.
+ * ----------------------------------------------------------------------- */
+
+static uint_t resolved_worker_count (void) {
+  
+  if (parallel_worker_count == 0) {
+    return m2c_workpool_default_worker_count();
+  } /* end if */
+  
+  return parallel_worker_count;
+} /* end resolved_worker_count */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_part_job(pool, worker, job, context)
+ * --------------------------------------------------------------------------
+ * Job handler, serialises the part passed in job to a memory sink of its
+ * own, using the writer of the run passed in context.
+ * ----------------------------------------------------------------------- */
+
+static void write_part_job
+  (m2c_workpool_t pool, uint_t worker, void *job, void *context) {
+  
+  part_s *this_part = job;
+  run_s *run = context;
+  
+  (void) pool;
+  (void) worker;
+  
+  this_part->sink = m2c_outsink_open_memory(NULL);
+  
+  if (this_part->sink == NULL) {
+    return;
+  } /* end if */
+  
+  this_part->completed = run->writer(this_part->sink,
+    run->list, this_part->first, this_part->count, run->context);
+  
+} /* end write_part_job */
+
+
+/* END OF FILE */
@@ -0,0 +1,132 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015, 2016 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * m2-ast-parallel.h
+ *
+ * Public interface for M2C parallel AST serialisation.
+ *
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute and/or modify it under the
+ * terms of the GNU Lesser General Public License (LGPL) either version 2.1
+ * or at your choice version 3 as published by the Free Software Foundation.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+
+#ifndef M2C_AST_PARALLEL_H
+#define M2C_AST_PARALLEL_H
+
+#include "m2-common.h"
+#include "m2-ast.h"
+#include "m2-outsink.h"
+
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * Minimum number of top-level items to serialise in parallel
+ * ----------------------------------------------------------------------- */
+
+#define M2C_AST_PARALLEL_MIN_ITEMS 16
+
+
+/* --------------------------------------------------------------------------
+ * Maximum number of parts per worker
+ * --------------------------------------------------------------------------
+ * Items are divided into up to this many parts per worker so that workers
+ * finishing early can steal the remaining parts of others.
+ * ----------------------------------------------------------------------- */
+
+#define M2C_AST_PARALLEL_PARTS_PER_WORKER 4
+
+
+/* --------------------------------------------------------------------------
+ * Maximum number of parts
+ * --------------------------------------------------------------------------
+ * Each part is collected in a memory sink of its own until all parts are
+ * done, this bounds the number of sink buffers held at once.
+ * ----------------------------------------------------------------------- */
+
+#define M2C_AST_PARALLEL_MAX_PARTS 64
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_ast_part_writer_t
+ * --------------------------------------------------------------------------
+ * function pointer type for part writers.  A part writer is called with a
+ * sink, a list node, the index of the first item of the part, the number
+ * of items in the part and the context passed to m2c_ast_parallel_write().
+ * It serialises the items of the part to the sink and returns true on
+ * success, otherwise false.  Part writers are called concurrently, they
+ * may only read the tree and context.
+ * ----------------------------------------------------------------------- */
+
+typedef bool (*m2c_ast_part_writer_t)
+  (m2c_outsink_t sink, m2c_astnode_t list, uint_t first, uint_t count,
+   void *context);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_ast_parallel_set_worker_count(worker_count)
+ * --------------------------------------------------------------------------
+ * Sets the number of workers used for parallel serialisation.  A count of
+ * zero selects the default worker count, a count of one disables parallel
+ * serialisation.  The initial setting is zero.  Serialisation of ASTs that
+ * already takes place on several threads should set a count of one.
+ * ----------------------------------------------------------------------- */
+
+void m2c_ast_parallel_set_worker_count (uint_t worker_count);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_parallel_list(root)
+ * --------------------------------------------------------------------------
+ * Returns the top-level definition or declaration list of the module in
+ * the tree of root if its items are to be serialised in parallel, or NULL
+ * if the list has fewer than M2C_AST_PARALLEL_MIN_ITEMS items, the tree
+ * has no such list or parallel serialisation is disabled.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_ast_parallel_list (m2c_astnode_t root);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_parallel_write(sink, list, writer, context)
+ * --------------------------------------------------------------------------
+ * Divides the items of list into contiguous parts, calls writer for each
+ * part on a pool of workers, each with a memory sink of its own, and then
+ * writes the output of all parts to sink in item order.  If no workers can
+ * be started, writer is called once for all items with sink.  Returns true
+ * if all parts have been written successfully, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_ast_parallel_write
+  (m2c_outsink_t sink, m2c_astnode_t list, m2c_ast_part_writer_t writer,
+   void *context);
+
+
+#endif /* M2C_AST_PARALLEL_H */
+
+/* END OF FILE */
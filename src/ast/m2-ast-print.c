@@ -34,6 +34,30 @@
  */
 
 #include "m2-ast-print.h"
+#include "m2-ast-walk.h"
+#include "m2-outsink.h"
+
+#include <stddef.h>
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static void print_unformatted_value (m2c_outsink_t sink, m2c_string_t lexeme);
+
+static void print_int_value (m2c_outsink_t sink, m2c_string_t lexeme);
+
+static void print_chr_value (m2c_outsink_t sink, m2c_string_t lexeme);
+
+static void print_quoted_value (m2c_outsink_t sink, m2c_string_t lexeme);
+
+static bool print_enter (m2c_ast_visit_t *visit, void *context);
+
+static bool print_leave (m2c_ast_visit_t *visit, void *context);
+
+static void print_value
+  (void (*print)(m2c_outsink_t, m2c_string_t), m2c_string_t lexeme);
 
 
 /* --------------------------------------------------------------------------
@@ -43,8 +67,7 @@
  * ----------------------------------------------------------------------- */
 
 void m2c_ast_print_unformatted_value (m2c_string_t lexeme) {
-  const char *lexstr = m2c_string_char_ptr(lexeme);
-  printf("%s", lexstr);
+  print_value(print_unformatted_value, lexeme);
 } /* end m2c_ast_print_unformatted_value */
 
 
@@ -55,6 +78,89 @@ void m2c_ast_print_unformatted_value (m2c_string_t lexeme) {
  * ----------------------------------------------------------------------- */
 
 void m2c_ast_print_int_value (m2c_string_t lexeme) {
+  print_value(print_int_value, lexeme);
+} /* end m2c_ast_print_int_value */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_print_chr_value(lexeme)
+ * --------------------------------------------------------------------------
+ * Prints the value of a CHRVAL node to the console. 
+ * ----------------------------------------------------------------------- */
+
+void m2c_ast_print_chr_value (m2c_string_t lexeme) {
+  print_value(print_chr_value, lexeme);
+} /* end m2c_ast_print_chr_value */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_print_quoted_value(lexeme)
+ * --------------------------------------------------------------------------
+ * Prints the value of a QUOTEDVAL node to the console. 
+ * ----------------------------------------------------------------------- */
+
+void m2c_ast_print_quoted_value (m2c_string_t lexeme) {
+  print_value(print_quoted_value, lexeme);
+} /* end m2c_ast_print_quoted_value */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_print_node(node)
+ * --------------------------------------------------------------------------
+ * Prints node as an S-expression to the console.  Output is collected in a
+ * console sink and written when the entire tree has been printed.
+ * ----------------------------------------------------------------------- */
+
+void m2c_ast_print_node (m2c_astnode_t node) {
+  m2c_outsink_t sink;
+  
+  sink = m2c_outsink_open_console(NULL);
+  
+  if (sink != NULL) {
+    m2c_ast_walk(node, print_enter, print_leave, sink);
+    m2c_outsink_close(&sink);
+  } /* end if */
+} /* end m2c_ast_print_node */
+
+
+/* *********************************************************************** *
+ * Private Functions                                                       *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private function print_value(print, lexeme)
+ * --------------------------------------------------------------------------
+ * Prints lexeme to the console using the given sink based print function.
+ * ----------------------------------------------------------------------- */
+
+static void print_value
+  (void (*print)(m2c_outsink_t, m2c_string_t), m2c_string_t lexeme) {
+  m2c_outsink_t sink;
+  
+  sink = m2c_outsink_open_console(NULL);
+  
+  if (sink != NULL) {
+    print(sink, lexeme);
+    m2c_outsink_close(&sink);
+  } /* end if */
+} /* end print_value */
+
+
+/* --------------------------------------------------------------------------
+ * private function print_unformatted_value(sink, lexeme)
+ * ----------------------------------------------------------------------- */
+
+static void print_unformatted_value (m2c_outsink_t sink, m2c_string_t lexeme) {
+  m2c_outsink_write_chars(sink,
+    m2c_string_char_ptr(lexeme), m2c_string_length(lexeme));
+} /* end print_unformatted_value */
+
+
+/* --------------------------------------------------------------------------
+ * private function print_int_value(sink, lexeme)
+ * ----------------------------------------------------------------------- */
+
+static void print_int_value (m2c_outsink_t sink, m2c_string_t lexeme) {
   uint_t length;
   const char *lexstr;
   
@@ -62,24 +168,21 @@ void m2c_ast_print_int_value (m2c_string_t lexeme) {
   lexstr = m2c_string_char_ptr(lexeme);
   
   if (lexstr[1] == 'x') {
-    printf("#%s", lexstr);
+    m2c_outsink_write_char(sink, '#');
   }
   else if ((lexstr[length-1] == 'H') || (lexstr[length-1] == 'B')) {
-    printf("?%s", lexstr);
-  }
-  else {
-    printf("%s", lexstr);
+    m2c_outsink_write_char(sink, '?');
   } /* end if */
-} /* end m2c_ast_print_int_value */
+  
+  m2c_outsink_write_chars(sink, lexstr, length);
+} /* end print_int_value */
 
 
 /* --------------------------------------------------------------------------
- * function m2c_ast_print_chr_value(lexeme)
- * --------------------------------------------------------------------------
- * Prints the value of a CHRVAL node to the console. 
+ * private function print_chr_value(sink, lexeme)
  * ----------------------------------------------------------------------- */
 
-void m2c_ast_print_chr_value (m2c_string_t lexeme) {
+static void print_chr_value (m2c_outsink_t sink, m2c_string_t lexeme) {
   uint_t length;
   const char *lexstr;
   
@@ -87,119 +190,107 @@ void m2c_ast_print_chr_value (m2c_string_t lexeme) {
   lexstr = m2c_string_char_ptr(lexeme);
   
   if (lexstr[1] == 'u') {
-    printf("#%s", lexstr);
+    m2c_outsink_write_char(sink, '#');
   }
   else if (lexstr[length-1] == 'C') {
-    printf("?%s", lexstr);
-  }
-  else {
-    printf("%s", lexstr);
+    m2c_outsink_write_char(sink, '?');
   } /* end if */
-} /* end m2c_ast_print_chr_value */
+  
+  m2c_outsink_write_chars(sink, lexstr, length);
+} /* end print_chr_value */
 
 
 /* --------------------------------------------------------------------------
- * function m2c_ast_print_quoted_value(lexeme)
- * --------------------------------------------------------------------------
- * Prints the value of a QUOTEDVAL node to the console. 
+ * private function print_quoted_value(sink, lexeme)
  * ----------------------------------------------------------------------- */
 
-void m2c_ast_print_quoted_value (m2c_string_t lexeme) {
-  uint_t length;
+static void print_quoted_value (m2c_outsink_t sink, m2c_string_t lexeme) {
+  uint_t length, index;
   const char *lexstr;
-  bool contains_double_quote;
+  char delimiter;
   
   length = m2c_string_length(lexeme);
   lexstr = m2c_string_char_ptr(lexeme);
   
+  delimiter = '"';
   for (index = 0; index < length; index++) {
-    contains_double_quote = (lexstr[index] == '"');
-    if (contains_double_quote) {
+    if (lexstr[index] == '"') {
+      delimiter = '\'';
       break;
     } /* end if */
   } /* end for */
   
-  if (contains_double_quote) {
-    printf("'%s'", lexstr);
-  }
-  else {
-    printf("\"%s\"", lexstr);
-  } /* end if */
-} /* end m2c_ast_print_quoted_value */
+  m2c_outsink_write_char(sink, delimiter);
+  m2c_outsink_write_chars(sink, lexstr, length);
+  m2c_outsink_write_char(sink, delimiter);
+} /* end print_quoted_value */
 
 
 /* --------------------------------------------------------------------------
- * function m2c_ast_print_node(node)
+ * private function print_enter(visit, context)
  * --------------------------------------------------------------------------
- * Prints node as an S-expression to the console. 
+ * Enter visitor, prints opening delimiter, stem and any values of the
+ * visited node to the sink passed in context. 
  * ----------------------------------------------------------------------- */
 
-void m2c_ast_print_node (m2c_astnode_t node) {
-  m2c_astnode_type_t node_type;
+static bool print_enter (m2c_ast_visit_t *visit, void *context) {
+  m2c_outsink_t sink = (m2c_outsink_t) context;
+  m2c_ast_nodetype_t node_type;
   uint_t index, subnode_count;
-  const char *node_name;
   m2c_string_t value;
   
-  node_type = m2c_ast_nodetype(node);
-  node_name = m2c_name_for_nodetype(node_type);
-  subnode_count = m2c_ast_subnode_count(node);
+  node_type = m2c_ast_nodetype(visit->node);
   
-  printf("(%s", node_name);
+  if (visit->depth > 0) {
+    m2c_outsink_write_char(sink, ' ');
+  } /* end if */
   
-  if (m2c_ast_is_nonterminal(node_type)) {
-    for (index = 0; index < subnode_count; index++) {
-      subnode = m2c_ast_subnode_for_index(node, index);
-      printf(" "); m2c_ast_print_node(subnode);
-    } /* end for */
-  }
-  else /* terminal node */ {
-    value = m2c_ast_value_for_index(node, 0);
+  m2c_outsink_write_char(sink, '(');
+  m2c_outsink_write_str(sink, m2c_name_for_nodetype(node_type));
+  
+  /* subnodes are printed by the traversal */
+  if (m2c_ast_is_nonterminal_nodetype(node_type)) {
+    return true;
+  } /* end if */
+  
+  subnode_count = m2c_ast_subnode_count(visit->node);
+  
+  for (index = 0; index < subnode_count; index++) {
+    value = m2c_ast_value_for_index(visit->node, index);
+    m2c_outsink_write_char(sink, ' ');
     
-    switch (node_type) {
-      case AST_IDENT :
-        printf(" "); m2c_ast_print_unformatted_value(value);
-        break;
-      
-      case AST_QUALIDENT :
-      case AST_IDENTLIST :
-        printf(" "); m2c_ast_print_unformatted_value(value);
-        for (index = 1; index < subnode_count; index++) {
-          value = m2c_ast_value_for_index(node, index);
-          printf(" "); m2c_ast_print_unformatted_value(value);
-        } /* end for */
-        break;
-      
-      case AST_INTVAL :
-        printf(" "); m2c_ast_print_int_value(value);
+    switch (m2c_ast_print_class_for_nodetype(node_type)) {
+      case M2C_AST_PRINT_INTEGER :
+        print_int_value(sink, value);
         break;
       
-      case AST_REALVAL :
-        printf(" "); m2c_ast_print_unformatted_value(value);
+      case M2C_AST_PRINT_CHAR :
+        print_chr_value(sink, value);
         break;
       
-      case AST_CHRVAL :
-        printf(" "); m2c_ast_print_chr_value(value);
+      case M2C_AST_PRINT_QUOTED :
+        print_quoted_value(sink, value);
         break;
       
-      case AST_QUOTEDVAL :
-        printf(" "); m2c_ast_print_quoted_value(value);
-        break;
-      
-      case AST_FILENAME :
-        printf(" "); m2c_ast_print_quoted_value(value);
-        break;
-    
-      case AST_OPTIONS :
-        printf(" "); m2c_ast_print_quoted_value(value);
-        for (index = 1; index < subnode_count; index++) {
-          value = m2c_ast_value_for_index(node, index);
-          printf(" "); m2c_ast_print_quoted_value(value);
-        } /* end for */
+      default : /* M2C_AST_PRINT_UNQUOTED */
+        print_unformatted_value(sink, value);
         break;
     } /* end switch */
-  } /* end if */
+  } /* end for */
   
-  printf(")");
-} /* end m2c_ast_print_node */
+  return true;
+} /* end print_enter */
+
+
+/* --------------------------------------------------------------------------
+ * private function print_leave(visit, context)
+ * --------------------------------------------------------------------------
+ * Leave visitor, prints the closing delimiter of the visited node. 
+ * ----------------------------------------------------------------------- */
+
+static bool print_leave (m2c_ast_visit_t *visit, void *context) {
+  m2c_outsink_write_char((m2c_outsink_t) context, ')');
+  return true;
+} /* end print_leave */
 
-/* END OF FILE */
\ No newline at end of file
+/* END OF FILE */
@@ -0,0 +1,504 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015, 2016 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * m2-ast-view.c
+ *
+ * Implementation of M2C copy-on-write AST views.
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute and/or modify it under the
+ * terms of the GNU Lesser General Public License (LGPL) either version 2.1
+ * or at your choice version 3 as published by the Free Software Foundation.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#include "m2-ast-view.h"
+#include "m2-ast-walk.h"
+#include "m2-alloc-stats.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* --------------------------------------------------------------------------
+ * Initial capacity and maximum load of the origin table of a view
+ * ----------------------------------------------------------------------- */
+
+#define M2C_AST_VIEW_ORIGIN_INIT_CAPACITY 64
+
+#define M2C_AST_VIEW_ORIGIN_MAX_LOAD_PERCENT 75
+
+
+/* --------------------------------------------------------------------------
+ * private type origin_entry_s
+ * --------------------------------------------------------------------------
+ * record type representing a slot of the origin table of a view.  Field
+ * copy holds a node copied by a rewrite, field base the node of the base
+ * tree it was copied from.  A slot is empty if its copy is NULL.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* copy */ m2c_astnode_t copy;
+  /* base */ m2c_astnode_t base;
+} origin_entry_s;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_ast_view_struct_t
+ * --------------------------------------------------------------------------
+ * record type representing a copy-on-write AST view.  Field root holds the
+ * root of the tree presented, field arena the arena all nodes owned by the
+ * view are allocated from and copy_count the number of nodes copied.  The
+ * origin table is an open addressing table with linear probing, keyed by
+ * copy, whose capacity is a power of two.  It is allocated on first copy,
+ * field origin_capacity is zero until then.  Field origin_used holds the
+ * number of occupied slots.
+ * ----------------------------------------------------------------------- */
+
+struct m2c_ast_view_struct_t {
+  /* root */ m2c_astnode_t root;
+  /* arena */ m2c_ast_arena_t arena;
+  /* copy_count */ uint_t copy_count;
+  /* origin_capacity */ uint_t origin_capacity;
+  /* origin_used */ uint_t origin_used;
+  /* origin */ origin_entry_s *origin;
+};
+
+typedef struct m2c_ast_view_struct_t m2c_ast_view_struct_t;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type rewrite_s
+ * --------------------------------------------------------------------------
+ * record type representing the state of a rewrite.  The results of nodes
+ * that have been left are held on a stack until their parent is left.
+ * Results are held in array local until it is full, then in a heap
+ * allocated array.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* view */ m2c_ast_view_t view;
+  /* rewriter */ m2c_ast_rewriter_t rewriter;
+  /* context */ void *context;
+  /* result */ m2c_astnode_t *result;
+  /* top */ uint_t top;
+  /* capacity */ uint_t capacity;
+  /* local */ m2c_astnode_t local[M2C_AST_VIEW_LOCAL_RESULTS];
+} rewrite_s;
+
+
+/* --------------------------------------------------------------------------
+ * Forward declarations
+ * ----------------------------------------------------------------------- */
+
+static bool rewrite_visited_node (m2c_ast_visit_t *visit, void *context);
+
+static bool push_result (rewrite_s *rewrite, m2c_astnode_t node);
+
+static inline uint_t home_slot (m2c_astnode_t copy, uint_t mask);
+
+static uint_t origin_probe (m2c_ast_view_t view, m2c_astnode_t copy);
+
+static bool add_origin
+  (m2c_ast_view_t view, m2c_astnode_t copy, m2c_astnode_t base);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_new_view(root)
+ * --------------------------------------------------------------------------
+ * Allocates and returns a new view of the tree of root, or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2c_ast_view_t m2c_ast_new_view (m2c_astnode_t root) {
+  
+  m2c_ast_view_t new_view;
+  
+  if (root == NULL) {
+    return NULL;
+  } /* end if */
+  
+  new_view = m2c_alloc(M2C_ALLOC_AST, sizeof(m2c_ast_view_struct_t));
+  
+  if (new_view == NULL) {
+    return NULL;
+  } /* end if */
+  
+  new_view->arena = m2c_ast_new_arena();
+  
+  if (new_view->arena == NULL) {
+    m2c_dealloc(M2C_ALLOC_AST, new_view, sizeof(m2c_ast_view_struct_t));
+    return NULL;
+  } /* end if */
+  
+  /* all nodes are shared until rewritten */
+  new_view->root = root;
+  new_view->copy_count = 0;
+  new_view->origin_capacity = 0;
+  new_view->origin_used = 0;
+  new_view->origin = NULL;
+  
+  return new_view;
+} /* end m2c_ast_new_view */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_view_root(view)
+ * --------------------------------------------------------------------------
+ * Returns the root of the tree presented by view, or NULL if view is NULL.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_ast_view_root (m2c_ast_view_t view) {
+  
+  if (view == NULL) {
+    return NULL;
+  } /* end if */
+  
+  return view->root;
+} /* end m2c_ast_view_root */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_view_rewrite(view, rewriter, context)
+ * --------------------------------------------------------------------------
+ * Rewrites the tree presented by view bottom-up, calling rewriter for each
+ * node in post-order.  Nodes are copied only where subnodes are replaced.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_ast_view_rewrite
+  (m2c_ast_view_t view, m2c_ast_rewriter_t rewriter, void *context) {
+  
+  m2c_ast_arena_t prev_arena;
+  rewrite_s rewrite;
+  bool completed;
+  
+  if ((view == NULL) || (rewriter == NULL)) {
+    return false;
+  } /* end if */
+  
+  rewrite.view = view;
+  rewrite.rewriter = rewriter;
+  rewrite.context = context;
+  rewrite.result = rewrite.local;
+  rewrite.top = 0;
+  rewrite.capacity = M2C_AST_VIEW_LOCAL_RESULTS;
+  
+  /* copies and new nodes are allocated from the arena of the view */
+  prev_arena = m2c_ast_current_arena();
+  m2c_ast_set_arena(view->arena);
+  
+  completed =
+    m2c_ast_walk(view->root, NULL, rewrite_visited_node, &rewrite);
+  
+  m2c_ast_set_arena(prev_arena);
+  
+  /* the result of the root is all that remains on the stack */
+  if (completed) {
+    view->root = rewrite.result[0];
+  } /* end if */
+  
+  if (rewrite.result != rewrite.local) {
+    free(rewrite.result);
+  } /* end if */
+  
+  return completed;
+} /* end m2c_ast_view_rewrite */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_view_copy_count(view)
+ * --------------------------------------------------------------------------
+ * Returns the number of nodes copied by rewrites of view, or zero if view
+ * is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_ast_view_copy_count (m2c_ast_view_t view) {
+  
+  if (view == NULL) {
+    return 0;
+  } /* end if */
+  
+  return view->copy_count;
+} /* end m2c_ast_view_copy_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_view_origin(view, node)
+ * --------------------------------------------------------------------------
+ * Returns the node of the base tree that node was copied from if node is a
+ * copy made by a rewrite of view, otherwise node itself.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_ast_view_origin (m2c_ast_view_t view, m2c_astnode_t node) {
+  
+  uint_t slot;
+  
+  if ((view == NULL) || (node == NULL) || (view->origin_used == 0)) {
+    return node;
+  } /* end if */
+  
+  slot = origin_probe(view, node);
+  
+  if (view->origin[slot].copy == NULL) {
+    return node;
+  } /* end if */
+  
+  return view->origin[slot].base;
+} /* end m2c_ast_view_origin */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_ast_release_view(view)
+ * --------------------------------------------------------------------------
+ * Deallocates view together with all nodes it owns.
+ * ----------------------------------------------------------------------- */
+
+void m2c_ast_release_view (m2c_ast_view_t view) {
+  
+  if (view == NULL) {
+    return;
+  } /* end if */
+  
+  /* copies and new nodes are released all at once */
+  m2c_ast_release_arena(view->arena);
+  free(view->origin);
+  m2c_dealloc(M2C_ALLOC_AST, view, sizeof(m2c_ast_view_struct_t));
+} /* end m2c_ast_release_view */
+
+
+/* *********************************************************************** *
+ * Private Functions                                                       *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private function rewrite_visited_node(visit, context)
+ * --------------------------------------------------------------------------
+ * Leave visitor of a rewrite.  Pops the results of the subnodes of the
+ * visited node, copies the node if any result differs from its subnode,
+ * passes the node or its copy to the rewriter and pushes the node returned.
+ * Returns false if the node cannot be copied or the rewriter fails.
+ * ----------------------------------------------------------------------- */
+
+static bool rewrite_visited_node (m2c_ast_visit_t *visit, void *context) {
+  
+  rewrite_s *rewrite = context;
+  m2c_astnode_t node, result;
+  uint_t count, first, index;
+  
+  /* values of terminal nodes are not visited */
+  if (m2c_ast_is_nonterminal_nodetype(m2c_ast_nodetype(visit->node))) {
+    count = m2c_ast_subnode_count(visit->node);
+  }
+  else {
+    count = 0;
+  } /* end if */
+  
+  /* the results of the subnodes are on top of the stack */
+  first = rewrite->top - count;
+  node = visit->node;
+  
+  for (index = 0; index < count; index++) {
+    result = rewrite->result[first + index];
+  
+    if (result != m2c_ast_subnode_for_index(visit->node, index)) {
+  
+      /* copy on first replacement, the node may be shared */
+      if (node == visit->node) {
+        node = m2c_ast_copy_node(visit->node);
+  
+        if (node == NULL) {
+          return false;
+        } /* end if */
+  
+        /* a copy of a copy has the origin of the node copied */
+        if (NOT(add_origin(rewrite->view, node,
+            m2c_ast_view_origin(rewrite->view, visit->node)))) {
+          return false;
+        } /* end if */
+  
+        rewrite->view->copy_count++;
+      } /* end if */
+  
+      if (m2c_ast_replace_subnode(node, index, result) == NULL) {
+        return false;
+      } /* end if */
+    } /* end if */
+  } /* end for */
+  
+  rewrite->top = first;
+  
+  result = rewrite->rewriter(node, rewrite->context);
+  
+  if (result == NULL) {
+    return false;
+  } /* end if */
+  
+  return push_result(rewrite, result);
+} /* end rewrite_visited_node */
+
+
+/* --------------------------------------------------------------------------
+ * private function push_result(rewrite, node)
+ * --------------------------------------------------------------------------
+ * Pushes node onto the result stack of rewrite.  Returns true on success,
+ * or false if the stack could not be grown.
+ * ----------------------------------------------------------------------- */
+
+static bool push_result (rewrite_s *rewrite, m2c_astnode_t node) {
+  
+  m2c_astnode_t *new_array;
+  uint_t new_capacity;
+  
+  /* move to the heap or grow when full */
+  if (rewrite->top == rewrite->capacity) {
+    new_capacity = 2 * rewrite->capacity;
+  
+    if (rewrite->result == rewrite->local) {
+      new_array = malloc(new_capacity * sizeof(m2c_astnode_t));
+      if (new_array != NULL) {
+        memcpy(new_array, rewrite->local, sizeof(rewrite->local));
+      } /* end if */
+    }
+    else {
+      new_array =
+        realloc(rewrite->result, new_capacity * sizeof(m2c_astnode_t));
+    } /* end if */
+  
+    if (new_array == NULL) {
+      return false;
+    } /* end if */
+  
+    rewrite->result = new_array;
+    rewrite->capacity = new_capacity;
+  } /* end if */
+  
+  rewrite->result[rewrite->top] = node;
+  rewrite->top++;
+  
+  return true;
+} /* end push_result */
+
+
+/* --------------------------------------------------------------------------
+ * private function home_slot(copy, mask)
+ * --------------------------------------------------------------------------
+ * Returns the home slot of copy for an origin table with capacity mask + 1.
+ * ----------------------------------------------------------------------- */
+
+static inline uint_t home_slot (m2c_astnode_t copy, uint_t mask) {
+  
+  uint64_t key;
+  
+  key = ((uint64_t) (uintptr_t) copy) * 0x9E3779B97F4A7C15ULL;
+  
+  return ((uint_t) (key >> 32)) & mask;
+} /* end home_slot */
+
+
+/* --------------------------------------------------------------------------
+ * private function origin_probe(view, copy)
+ * --------------------------------------------------------------------------
+ * Returns the slot of copy in the origin table of view, or the empty slot
+ * where copy would be stored if copy is not present.  The origin table of
+ * view must have been allocated.
+ * ----------------------------------------------------------------------- */
+
+static uint_t origin_probe (m2c_ast_view_t view, m2c_astnode_t copy) {
+  
+  uint_t slot, mask;
+  
+  mask = view->origin_capacity - 1;
+  slot = home_slot(copy, mask);
+  
+  while ((view->origin[slot].copy != NULL) &&
+         (view->origin[slot].copy != copy)) {
+    slot = (slot + 1) & mask;
+  } /* end while */
+  
+  return slot;
+} /* end origin_probe */
+
+
+/* --------------------------------------------------------------------------
+ * private function add_origin(view, copy, base)
+ * --------------------------------------------------------------------------
+ * Records base as the origin of copy in the origin table of view, growing
+ * the table if its maximum load would otherwise be exceeded.  Returns true
+ * on success, or false if the table could not be allocated or grown.
+ * ----------------------------------------------------------------------- */
+
+static bool add_origin
+  (m2c_ast_view_t view, m2c_astnode_t copy, m2c_astnode_t base) {
+  
+  origin_entry_s *old_origin;
+  uint_t old_capacity, new_capacity, slot, new_slot;
+  
+  /* allocate on first copy, double when full */
+  if (((view->origin_used + 1) * 100) >
+      (view->origin_capacity * M2C_AST_VIEW_ORIGIN_MAX_LOAD_PERCENT)) {
+    old_origin = view->origin;
+    old_capacity = view->origin_capacity;
+  
+    if (old_capacity == 0) {
+      new_capacity = M2C_AST_VIEW_ORIGIN_INIT_CAPACITY;
+    }
+    else {
+      new_capacity = 2 * old_capacity;
+    } /* end if */
+  
+    view->origin = calloc(new_capacity, sizeof(origin_entry_s));
+  
+    if (view->origin == NULL) {
+      view->origin = old_origin;
+      return false;
+    } /* end if */
+  
+    view->origin_capacity = new_capacity;
+  
+    /* rehash occupied slots */
+    for (slot = 0; slot < old_capacity; slot++) {
+      if (old_origin[slot].copy != NULL) {
+        new_slot = origin_probe(view, old_origin[slot].copy);
+        view->origin[new_slot] = old_origin[slot];
+      } /* end if */
+    } /* end for */
+  
+    free(old_origin);
+  } /* end if */
+  
+  slot = origin_probe(view, copy);
+  
+  if (view->origin[slot].copy == NULL) {
+    view->origin[slot].copy = copy;
+    view->origin_used++;
+  } /* end if */
+  
+  view->origin[slot].base = base;
+  
+  return true;
+} /* end add_origin */
+
+
+/* END OF FILE */
@@ -0,0 +1,184 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015, 2016 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * m2-ast-view.h
+ *
+ * Public interface for M2C copy-on-write AST views.
+ *
+ * A view presents the tree of a base root as rewritten by one client, such
+ * as a backend applying its own lowerings.  Rewriting a node makes private
+ * copies of that node and of the nodes on its path to the root only, all
+ * other nodes remain shared with the base tree and with any other views of
+ * it.  The base tree is never modified.  Several views of the same base
+ * tree may therefore be rewritten and read concurrently, each on a thread
+ * of its own, while memory use stays close to that of a single tree.
+ *
+ * Side tables keyed by node, such as the source spans by which the M2R10
+ * writer copies unchanged source text and the comments attached to nodes,
+ * hold entries for the nodes of the base tree only.  A view records the
+ * base node each of its copies was made from, a backend resolves lookups
+ * in such tables through m2c_ast_view_origin() and so finds the entries
+ * of copied nodes too.  Nodes built by a rewriter have no origin.
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute and/or modify it under the
+ * terms of the GNU Lesser General Public License (LGPL) either version 2.1
+ * or at your choice version 3 as published by the Free Software Foundation.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+
+#ifndef M2C_AST_VIEW_H
+#define M2C_AST_VIEW_H
+
+#include "m2-common.h"
+#include "m2-ast.h"
+
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * Number of rewrite results held on the C stack
+ * --------------------------------------------------------------------------
+ * Rewrites with more pending results than this move them to the heap.
+ * ----------------------------------------------------------------------- */
+
+#define M2C_AST_VIEW_LOCAL_RESULTS 256
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2c_ast_view_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing a copy-on-write view of an AST.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_ast_view_struct_t *m2c_ast_view_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_ast_rewriter_t
+ * --------------------------------------------------------------------------
+ * function pointer type for rewriters.  A rewriter is called with a node
+ * whose subnodes have already been rewritten and the context passed to
+ * m2c_ast_view_rewrite().  It returns the node to take its place, which is
+ * the node itself to keep it, or NULL to end the rewrite.  The node passed
+ * may be shared with other views and must not be modified, a rewriter
+ * builds any replacement from new nodes instead.
+ * ----------------------------------------------------------------------- */
+
+typedef m2c_astnode_t (*m2c_ast_rewriter_t)
+  (m2c_astnode_t node, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_new_view(root)
+ * --------------------------------------------------------------------------
+ * Allocates and returns a new view of the tree of root, or NULL on failure.
+ * The view initially presents the tree of root unchanged.  The tree of root
+ * must remain valid and unmodified until the view has been released.
+ * ----------------------------------------------------------------------- */
+
+m2c_ast_view_t m2c_ast_new_view (m2c_astnode_t root);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_view_root(view)
+ * --------------------------------------------------------------------------
+ * Returns the root of the tree presented by view, or NULL if view is NULL.
+ * The tree may be passed to any function that reads an AST.  Its nodes
+ * belong to the view or to the base tree, they must not be released by
+ * calling m2c_ast_release_node() or m2c_ast_release_tree().
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_ast_view_root (m2c_ast_view_t view);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_view_rewrite(view, rewriter, context)
+ * --------------------------------------------------------------------------
+ * Rewrites the tree presented by view bottom-up, calling rewriter for each
+ * node in post-order.  Where the subnodes of a node have been replaced, a
+ * private copy of the node holding the replacements is passed to rewriter
+ * in its place.  Nodes created while rewriting, including those created by
+ * rewriter, are allocated from an arena owned by the view.  Nodes with no
+ * replaced subnodes that rewriter keeps are not copied and remain shared.
+ *
+ * pre-conditions:
+ * o  view and rewriter must not be NULL
+ * o  view must not be rewritten or read by another thread at the same time
+ *
+ * post-conditions:
+ * o  the root of view is the result of rewriting its previous root
+ * o  the arena selected by the calling thread is unchanged
+ * o  true is returned
+ *
+ * error-conditions:
+ * o  if rewriter returns NULL or a node cannot be copied or its origin
+ *    cannot be recorded, the rewrite ends, the root of view is unchanged
+ *    and false is returned
+ * ----------------------------------------------------------------------- */
+
+bool m2c_ast_view_rewrite
+  (m2c_ast_view_t view, m2c_ast_rewriter_t rewriter, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_view_copy_count(view)
+ * --------------------------------------------------------------------------
+ * Returns the number of nodes copied by rewrites of view, or zero if view
+ * is NULL.  Nodes created by rewriters are not counted.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_ast_view_copy_count (m2c_ast_view_t view);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_view_origin(view, node)
+ * --------------------------------------------------------------------------
+ * Returns the node of the base tree that node was copied from if node is a
+ * copy made by a rewrite of view, otherwise node itself.  A copy of a node
+ * that was itself copied by an earlier rewrite has the origin of the node
+ * copied.  Returns node if view is NULL.  Lookups in side tables keyed by
+ * the nodes of the base tree are made with the node returned.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_ast_view_origin (m2c_ast_view_t view, m2c_astnode_t node);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_ast_release_view(view)
+ * --------------------------------------------------------------------------
+ * Deallocates view together with all nodes it owns.  The base tree is not
+ * affected.  Nodes obtained from the view become invalid.
+ *
+ * error-conditions:
+ * o  if view is NULL, no operation is carried out
+ * ----------------------------------------------------------------------- */
+
+void m2c_ast_release_view (m2c_ast_view_t view);
+
+
+#endif /* M2C_AST_VIEW_H */
+
+/* END OF FILE */
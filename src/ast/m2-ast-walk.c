@@ -0,0 +1,225 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015, 2016 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * m2-ast-walk.c
+ *
+ * Implementation of M2C abstract syntax tree traversal.
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute and/or modify it under the
+ * terms of the GNU Lesser General Public License (LGPL) either version 2.1
+ * or at your choice version 3 as published by the Free Software Foundation.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+
+#include "m2-ast-walk.h"
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* --------------------------------------------------------------------------
+ * hidden type walk_frame_s
+ * --------------------------------------------------------------------------
+ * record type representing a traversal stack frame.  Field next holds the
+ * index of the next subnode to visit, field count the number of subnodes
+ * to visit, which is zero for terminal nodes.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* visit */ m2c_ast_visit_t visit;
+  /* next */ uint_t next;
+  /* count */ uint_t count;
+} walk_frame_s;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type walk_stack_s
+ * --------------------------------------------------------------------------
+ * record type representing a traversal stack.  Frames are held in array
+ * local until it is full, then in a heap allocated array.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* frame */ walk_frame_s *frame;
+  /* top */ uint_t top;
+  /* capacity */ uint_t capacity;
+  /* local */ walk_frame_s local[M2C_AST_WALK_LOCAL_DEPTH];
+} walk_stack_s;
+
+
+/* --------------------------------------------------------------------------
+ * Forward declarations
+ * ----------------------------------------------------------------------- */
+
+static walk_frame_s *push_frame
+  (walk_stack_s *stack, m2c_astnode_t node, uint_t index);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_walk(root, enter, leave, context)
+ * --------------------------------------------------------------------------
+ * Traverses the tree of root depth first, without recursion.  Calls enter
+ * for each node in pre-order and leave for each node in post-order.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_ast_walk
+  (m2c_astnode_t root, m2c_ast_visitor_t enter, m2c_ast_visitor_t leave,
+   void *context) {
+  
+  walk_stack_s stack;
+  walk_frame_s *frame;
+  m2c_astnode_t subnode;
+  bool completed;
+  
+  stack.frame = stack.local;
+  stack.top = 0;
+  stack.capacity = M2C_AST_WALK_LOCAL_DEPTH;
+  
+  completed = true;
+  frame = push_frame(&stack, root, 0);
+  
+  if ((enter != NULL) && (NOT(enter(&frame->visit, context)))) {
+    return false;
+  } /* end if */
+  
+  if (frame->visit.skip) {
+    frame->next = frame->count;
+  } /* end if */
+  
+  while (stack.top > 0) {
+    frame = &stack.frame[stack.top - 1];
+    
+    /* descend into the next subnode */
+    if (frame->next < frame->count) {
+      subnode = m2c_ast_subnode_for_index(frame->visit.node, frame->next);
+      frame->next++;
+      
+      frame = push_frame(&stack, subnode, frame->next - 1);
+      
+      if ((frame == NULL) ||
+          ((enter != NULL) && (NOT(enter(&frame->visit, context))))) {
+        completed = false;
+        break;
+      } /* end if */
+      
+      /* the enter visitor may skip the subnodes */
+      if (frame->visit.skip) {
+        frame->next = frame->count;
+      } /* end if */
+    }
+    /* all subnodes visited, ascend */
+    else {
+      stack.top--;
+      
+      if ((leave != NULL) && (NOT(leave(&frame->visit, context)))) {
+        completed = false;
+        break;
+      } /* end if */
+    } /* end if */
+  } /* end while */
+  
+  if (stack.frame != stack.local) {
+    free(stack.frame);
+  } /* end if */
+  
+  return completed;
+} /* end m2c_ast_walk */
+
+
+/* *********************************************************************** *
+ * Private Functions                                                       *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private function push_frame(stack, node, index)
+ * --------------------------------------------------------------------------
+ * Pushes a frame for the visit of node at index within the node of the top
+ * frame and returns it, or NULL if the stack could not be grown.  The tag
+ * of the top frame is passed on as the parent tag.  Pointers to frames
+ * obtained earlier become invalid when the stack grows.
+ * ----------------------------------------------------------------------- */
+
+static walk_frame_s *push_frame
+  (walk_stack_s *stack, m2c_astnode_t node, uint_t index) {
+  
+  walk_frame_s *new_frame, *new_array;
+  uint_t new_capacity;
+  
+  /* move to the heap or grow when full */
+  if (stack->top == stack->capacity) {
+    new_capacity = 2 * stack->capacity;
+    
+    if (stack->frame == stack->local) {
+      new_array = malloc(new_capacity * sizeof(walk_frame_s));
+      if (new_array != NULL) {
+        memcpy(new_array, stack->local, sizeof(stack->local));
+      } /* end if */
+    }
+    else {
+      new_array =
+        realloc(stack->frame, new_capacity * sizeof(walk_frame_s));
+    } /* end if */
+    
+    if (new_array == NULL) {
+      return NULL;
+    } /* end if */
+    
+    stack->frame = new_array;
+    stack->capacity = new_capacity;
+  } /* end if */
+  
+  new_frame = &stack->frame[stack->top];
+  
+  new_frame->visit.node = node;
+  new_frame->visit.index = index;
+  new_frame->visit.depth = stack->top;
+  new_frame->visit.tag = 0;
+  new_frame->visit.skip = false;
+  
+  if (stack->top > 0) {
+    new_frame->visit.parent_tag = stack->frame[stack->top - 1].visit.tag;
+  }
+  else {
+    new_frame->visit.parent_tag = 0;
+  } /* end if */
+  
+  /* values of terminal nodes are not visited */
+  new_frame->next = 0;
+  if (m2c_ast_is_nonterminal_nodetype(m2c_ast_nodetype(node))) {
+    new_frame->count = m2c_ast_subnode_count(node);
+  }
+  else {
+    new_frame->count = 0;
+  } /* end if */
+  
+  stack->top++;
+  
+  return new_frame;
+} /* end push_frame */
+
+
+/* END OF FILE */
@@ -0,0 +1,111 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015, 2016 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * m2-ast-walk.h
+ *
+ * Public interface for M2C abstract syntax tree traversal.
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute and/or modify it under the
+ * terms of the GNU Lesser General Public License (LGPL) either version 2.1
+ * or at your choice version 3 as published by the Free Software Foundation.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+
+#ifndef M2C_AST_WALK_H
+#define M2C_AST_WALK_H
+
+#include "m2-common.h"
+#include "m2-ast.h"
+
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * Number of traversal stack frames held on the C stack
+ * --------------------------------------------------------------------------
+ * Trees deeper than this move the traversal stack to the heap.
+ * ----------------------------------------------------------------------- */
+
+#define M2C_AST_WALK_LOCAL_DEPTH 64
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_ast_visit_t
+ * --------------------------------------------------------------------------
+ * record type representing the visit of a node during a traversal.  Field
+ * index holds the index of node within its parent, field depth its
+ * distance from the root, both are zero for the root.  Field tag is free
+ * for use by visitors, it is zero on entry, retains any value set by the
+ * enter visitor until the node is left and is passed to the visits of all
+ * subnodes in field parent_tag.  Field skip is false on entry, the enter
+ * visitor may set it to skip the subnodes of the node, which is then left
+ * without visiting them.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* node */ m2c_astnode_t node;
+  /* index */ uint_t index;
+  /* depth */ uint_t depth;
+  /* tag */ uint_t tag;
+  /* parent_tag */ uint_t parent_tag;
+  /* skip */ bool skip;
+} m2c_ast_visit_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_ast_visitor_t
+ * --------------------------------------------------------------------------
+ * function pointer type for traversal visitors.  A visitor is called with
+ * the visit of a node and the context passed to m2c_ast_walk().  It returns
+ * true to continue the traversal and false to end it.
+ * ----------------------------------------------------------------------- */
+
+typedef bool (*m2c_ast_visitor_t) (m2c_ast_visit_t *visit, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_walk(root, enter, leave, context)
+ * --------------------------------------------------------------------------
+ * Traverses the tree of root depth first, without recursion.  Visitor
+ * enter is called for each node before its subnodes are visited, in
+ * pre-order, visitor leave after its subnodes have been visited, in
+ * post-order.  Either visitor may be NULL.  The subnodes of a node are
+ * obtained after enter has returned and the node itself is not accessed
+ * after leave has returned, leave may therefore release the node.  Values
+ * of terminal nodes are not visited.  Returns true if the entire tree has
+ * been traversed, false if a visitor ended the traversal or the traversal
+ * stack could not be grown.  If the traversal ends early, nodes that have
+ * been entered are not left.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_ast_walk
+  (m2c_astnode_t root, m2c_ast_visitor_t enter, m2c_ast_visitor_t leave,
+   void *context);
+
+
+#endif /* M2C_AST_WALK_H */
+
+/* END OF FILE */
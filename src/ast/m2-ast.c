@@ -34,11 +34,29 @@
  */
 
 #include "m2-ast.h"
+#include "m2-ast-flat.h"
+#include "m2-ast-walk.h"
+#include "m2-alloc-stats.h"
 
+#include <stdarg.h>
 #include <stddef.h>
 #include <stdlib.h>
 
 
+/* --------------------------------------------------------------------------
+ * hidden type m2c_astnode_variant
+ * --------------------------------------------------------------------------
+ * union type representing a subnode or value stored in an AST node.
+ * ----------------------------------------------------------------------- */
+
+union m2c_astnode_variant {
+  m2c_string_t terminal;
+  m2c_astnode_t non_terminal;
+};
+
+typedef union m2c_astnode_variant m2c_astnode_variant;
+
+
 /* --------------------------------------------------------------------------
  * hidden type m2c_astnode_struct_t
  * --------------------------------------------------------------------------
@@ -53,12 +71,92 @@ struct m2c_astnode_struct_t {
 
 typedef struct m2c_astnode_struct_t m2c_astnode_struct_t;
 
-union m2c_astnode_variant {
-  m2c_string_t terminal;
-  m2c_astnode_t non_terminal;
+
+/* --------------------------------------------------------------------------
+ * Arena chunk sizes
+ * --------------------------------------------------------------------------
+ * The first chunk of an arena has M2C_AST_ARENA_INITIAL_CHUNK_SIZE bytes.
+ * Each further chunk is twice the size of its predecessor, until the size
+ * reaches M2C_AST_ARENA_MAX_CHUNK_SIZE.  A node too large for the chunk
+ * size gets a chunk of its own.
+ * ----------------------------------------------------------------------- */
+
+#define M2C_AST_ARENA_INITIAL_CHUNK_SIZE (64 * 1024)
+
+#define M2C_AST_ARENA_MAX_CHUNK_SIZE (4 * 1024 * 1024)
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_ast_arena_chunk_s
+ * --------------------------------------------------------------------------
+ * record type representing a chunk of memory nodes are carved from.
+ * ----------------------------------------------------------------------- */
+
+typedef union {
+  /* ptr */ void *ptr;
+  /* uint */ uint_t uint;
+  /* lint */ long int lint;
+} m2c_ast_arena_align_t;
+
+typedef struct m2c_ast_arena_chunk_s m2c_ast_arena_chunk_s;
+
+struct m2c_ast_arena_chunk_s {
+  /* next */ m2c_ast_arena_chunk_s *next;
+  /* size */ size_t size;
+  /* used */ size_t used;
+  /* data */ m2c_ast_arena_align_t data[];
 };
 
-typedef union m2c_astnode_variant m2c_astnode_variant;
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_ast_arena_struct_t
+ * --------------------------------------------------------------------------
+ * record type representing an AST node arena.  Nodes are allocated from
+ * the head chunk by advancing its used count.  Field next_size holds the
+ * size of the next chunk to allocate.
+ * ----------------------------------------------------------------------- */
+
+struct m2c_ast_arena_struct_t {
+  /* head */ m2c_ast_arena_chunk_s *head;
+  /* next_size */ size_t next_size;
+};
+
+typedef struct m2c_ast_arena_struct_t m2c_ast_arena_struct_t;
+
+
+/* --------------------------------------------------------------------------
+ * Thread local storage class specifier
+ * ----------------------------------------------------------------------- */
+
+#if (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_THREADS__)
+#define M2C_THREAD_LOCAL _Thread_local
+#elif defined(__GNUC__)
+#define M2C_THREAD_LOCAL __thread
+#elif defined(_MSC_VER)
+#define M2C_THREAD_LOCAL __declspec(thread)
+#else
+#define M2C_THREAD_LOCAL /* host without threads */
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * Arena selected by the current thread
+ * ----------------------------------------------------------------------- */
+
+static M2C_THREAD_LOCAL m2c_ast_arena_t current_arena = NULL;
+
+
+/* --------------------------------------------------------------------------
+ * Forward declarations
+ * ----------------------------------------------------------------------- */
+
+static m2c_astnode_t allocate_node (uint_t subnode_count);
+
+static bool arena_owns_node (m2c_ast_arena_t arena, m2c_astnode_t node);
+
+static void arena_take_back_node (m2c_ast_arena_t arena, m2c_astnode_t node);
+
+static bool release_visited_node (m2c_ast_visit_t *visit, void *context);
 
 
 /* --------------------------------------------------------------------------
@@ -70,6 +168,80 @@ static const m2c_astnode_struct_t m2c_ast_empty_node_struct = {
 };
 
 
+/* --------------------------------------------------------------------------
+ * function m2c_ast_new_arena()
+ * --------------------------------------------------------------------------
+ * Allocates and returns a new empty AST node arena, or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2c_ast_arena_t m2c_ast_new_arena (void) {
+  
+  m2c_ast_arena_t new_arena;
+  
+  new_arena = m2c_alloc(M2C_ALLOC_AST, sizeof(m2c_ast_arena_struct_t));
+  
+  if (new_arena == NULL) {
+    return NULL;
+  } /* end if */
+  
+  /* chunks are allocated on demand */
+  new_arena->head = NULL;
+  new_arena->next_size = M2C_AST_ARENA_INITIAL_CHUNK_SIZE;
+  
+  return new_arena;
+} /* end m2c_ast_new_arena */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_ast_set_arena(arena)
+ * --------------------------------------------------------------------------
+ * Selects arena as the allocator for AST nodes subsequently created by the
+ * calling thread.  Passing NULL selects individual allocation of nodes.
+ * ----------------------------------------------------------------------- */
+
+void m2c_ast_set_arena (m2c_ast_arena_t arena) {
+  current_arena = arena;
+} /* end m2c_ast_set_arena */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_current_arena()
+ * --------------------------------------------------------------------------
+ * Returns the arena selected by the calling thread, or NULL if none.
+ * ----------------------------------------------------------------------- */
+
+m2c_ast_arena_t m2c_ast_current_arena (void) {
+  return current_arena;
+} /* end m2c_ast_current_arena */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_ast_release_arena(arena)
+ * --------------------------------------------------------------------------
+ * Deallocates arena and all AST nodes allocated from it in one operation.
+ * ----------------------------------------------------------------------- */
+
+void m2c_ast_release_arena (m2c_ast_arena_t arena) {
+  
+  m2c_ast_arena_chunk_s *this_chunk, *next_chunk;
+  
+  if (arena == NULL) {
+    return;
+  } /* end if */
+  
+  this_chunk = arena->head;
+  
+  while (this_chunk != NULL) {
+    next_chunk = this_chunk->next;
+    m2c_dealloc(M2C_ALLOC_AST, this_chunk,
+      sizeof(m2c_ast_arena_chunk_s) + this_chunk->size);
+    this_chunk = next_chunk;
+  } /* end while */
+  
+  m2c_dealloc(M2C_ALLOC_AST, arena, sizeof(m2c_ast_arena_struct_t));
+} /* end m2c_ast_release_arena */
+
+
 /* --------------------------------------------------------------------------
  * function m2c_ast_empty_node()
  * --------------------------------------------------------------------------
@@ -119,26 +291,36 @@ m2c_astnode_t m2c_ast_new_node
   va_start(subnode_list, node_type);
   this_subnode = va_arg(subnode_list, m2c_astnode_t);
   while (this_subnode != NULL) {
-    if (!m2c_ast_is_legal_subnode
-          (m2c_ast_nodetype(this_subnode), subnode_count)) {
+#if (M2C_AST_VALIDATE)
+    if (!m2c_ast_is_legal_subnode_type
+          (node_type, m2c_ast_nodetype(this_subnode), subnode_count)) {
+      va_end(subnode_list);
       return NULL;
     } /* end if */
+#endif
     subnode_count++;
     this_subnode = va_arg(subnode_list, m2c_astnode_t);
   } /* end while */
   
+  va_end(subnode_list);
+  
+#if (M2C_AST_VALIDATE)
   /* verify subnode count */
   if (!m2c_ast_is_legal_subnode_count(node_type, subnode_count)) {
     return NULL;
   } /* end if */
+#endif
   
   if (node_type == AST_EMPTY) {
     return (m2c_astnode_t) &m2c_ast_empty_node_struct;
   } /* end if */
   
   /* allocate node */
-  new_node = malloc
-    (sizeof(m2c_astnode_struct_t) + subnode_count * sizeof(m2c_astnode_t));
+  new_node = allocate_node(subnode_count);
+  
+  if (new_node == NULL) {
+    return NULL;
+  } /* end if */
   
   /* initialise fields */
   new_node->node_type = node_type;
@@ -185,8 +367,11 @@ m2c_astnode_t m2c_ast_new_list_node
   subnode_count = m2c_fifo_entry_count(list);
   
   /* allocate node */
-  new_node = malloc
-    (sizeof(m2c_astnode_struct_t) + subnode_count * sizeof(m2c_astnode_t));
+  new_node = allocate_node(subnode_count);
+  
+  if (new_node == NULL) {
+    return NULL;
+  } /* end if */
   
   /* initialise fields */
   new_node->node_type = node_type;
@@ -201,6 +386,53 @@ m2c_astnode_t m2c_ast_new_list_node
 } /* end m2c_ast_new_list_node */
 
 
+/* --------------------------------------------------------------------------
+ * function m2c_ast_new_list_node_from_slice(node_type, count, slice)
+ * --------------------------------------------------------------------------
+ * Allocates a new branch node of the given node type, stores the count
+ * subnodes of array slice in the node and returns the node, or NULL on
+ * failure.  The slice is not modified and remains owned by the caller.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_ast_new_list_node_from_slice
+  (m2c_ast_nodetype_t node_type,
+   uint_t count, const m2c_fifo_value_t *slice) {
+  
+  m2c_astnode_t new_node;
+  uint_t index;
+  
+  if (!m2c_ast_is_nonterminal_nodetype(node_type)) {
+    return NULL;
+  } /* end if */
+  
+  if (!m2c_ast_is_list_nodetype(node_type)) {
+    return NULL;
+  } /* end if */
+  
+  if ((slice == NULL) && (count > 0)) {
+    return NULL;
+  } /* end if */
+  
+  /* allocate node */
+  new_node = allocate_node(count);
+  
+  if (new_node == NULL) {
+    return NULL;
+  } /* end if */
+  
+  /* initialise fields */
+  new_node->node_type = node_type;
+  new_node->subnode_count = count;
+  
+  /* store subnodes in table */
+  for (index = 0; index < count; index++) {
+    new_node->subnode_table[index].non_terminal = slice[index];
+  } /* end for */
+  
+  return new_node;
+} /* end m2c_ast_new_list_node_from_slice */
+
+
 /* --------------------------------------------------------------------------
  * function m2c_ast_new_terminal_node(node_type, value)
  * --------------------------------------------------------------------------
@@ -209,7 +441,7 @@ m2c_astnode_t m2c_ast_new_list_node
  * ----------------------------------------------------------------------- */
 
 m2c_astnode_t m2c_ast_new_terminal_node
-  (m2c_ast_nodetype_t type, m2c_string_t value) {
+  (m2c_ast_nodetype_t node_type, m2c_string_t value) {
   
   m2c_astnode_t new_node;
   
@@ -217,14 +449,19 @@ m2c_astnode_t m2c_ast_new_terminal_node
     return NULL;
   } /* end if */
   
+#if (M2C_AST_VALIDATE)
   /* verify subnode count */
   if (!m2c_ast_is_legal_subnode_count(node_type, 1)) {
     return NULL;
   } /* end if */
+#endif
   
   /* allocate node */
-  new_node = malloc
-    (sizeof(m2c_astnode_struct_t) + sizeof(m2c_astnode_t));
+  new_node = allocate_node(1);
+  
+  if (new_node == NULL) {
+    return NULL;
+  } /* end if */
   
   /* initialise fields */
   new_node->node_type = node_type;
@@ -245,7 +482,7 @@ m2c_astnode_t m2c_ast_new_terminal_node
  * ----------------------------------------------------------------------- */
 
 m2c_astnode_t m2c_ast_new_terminal_list_node
-  (m2c_ast_nodetype_t node_type, m2c_fifo_t list)
+  (m2c_ast_nodetype_t node_type, m2c_fifo_t list) {
   
   m2c_astnode_t new_node;
   uint_t subnode_count, index;
@@ -265,8 +502,11 @@ m2c_astnode_t m2c_ast_new_terminal_list_node
   subnode_count = m2c_fifo_entry_count(list);
   
   /* allocate node */
-  new_node = malloc
-    (sizeof(m2c_astnode_struct_t) + subnode_count * sizeof(m2c_astnode_t));
+  new_node = allocate_node(subnode_count);
+  
+  if (new_node == NULL) {
+    return NULL;
+  } /* end if */
   
   /* initialise fields */
   new_node->node_type = node_type;
@@ -281,6 +521,107 @@ m2c_astnode_t m2c_ast_new_terminal_list_node
 } /* end m2c_ast_new_terminal_list_node */
 
 
+/* --------------------------------------------------------------------------
+ * function m2c_ast_new_terminal_list_node_from_slice(node_type, count, slice)
+ * --------------------------------------------------------------------------
+ * Allocates a new terminal node of the given node type, stores the count
+ * values of array slice in the node and returns the node, or NULL on
+ * failure.  The slice is not modified and remains owned by the caller.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_ast_new_terminal_list_node_from_slice
+  (m2c_ast_nodetype_t node_type,
+   uint_t count, const m2c_fifo_value_t *slice) {
+  
+  m2c_astnode_t new_node;
+  uint_t index;
+  
+  if (!m2c_ast_is_terminal_nodetype(node_type)) {
+    return NULL;
+  } /* end if */
+  
+  if (!m2c_ast_is_list_nodetype(node_type)) {
+    return NULL;
+  } /* end if */
+  
+  if ((slice == NULL) && (count > 0)) {
+    return NULL;
+  } /* end if */
+  
+  /* allocate node */
+  new_node = allocate_node(count);
+  
+  if (new_node == NULL) {
+    return NULL;
+  } /* end if */
+  
+  /* initialise fields */
+  new_node->node_type = node_type;
+  new_node->subnode_count = count;
+  
+  /* store values in table */
+  for (index = 0; index < count; index++) {
+    new_node->subnode_table[index].terminal = slice[index];
+  } /* end for */
+  
+  return new_node;
+} /* end m2c_ast_new_terminal_list_node_from_slice */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_copy_node(node)
+ * --------------------------------------------------------------------------
+ * Allocates a new node of the same node type as node, stores the subnodes
+ * or values of node in the new node and returns it, or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_ast_copy_node (m2c_astnode_t node) {
+  
+  m2c_ast_nodetype_t node_type;
+  m2c_astnode_t new_node;
+  uint_t count, index;
+  
+  node_type = m2c_ast_nodetype(node);
+  
+  if (node_type == AST_INVALID) {
+    return NULL;
+  } /* end if */
+  
+  if (node_type == AST_EMPTY) {
+    return (m2c_astnode_t) &m2c_ast_empty_node_struct;
+  } /* end if */
+  
+  count = m2c_ast_subnode_count(node);
+  
+  /* allocate node */
+  new_node = allocate_node(count);
+  
+  if (new_node == NULL) {
+    return NULL;
+  } /* end if */
+  
+  /* initialise fields */
+  new_node->node_type = node_type;
+  new_node->subnode_count = count;
+  
+  /* copy table, using the accessors since node may be a flat tree handle */
+  if (m2c_ast_is_nonterminal_nodetype(node_type)) {
+    for (index = 0; index < count; index++) {
+      new_node->subnode_table[index].non_terminal =
+        m2c_ast_subnode_for_index(node, index);
+    } /* end for */
+  }
+  else /* terminal */ {
+    for (index = 0; index < count; index++) {
+      new_node->subnode_table[index].terminal =
+        m2c_ast_value_for_index(node, index);
+    } /* end for */
+  } /* end if */
+  
+  return new_node;
+} /* end m2c_ast_copy_node */
+
+
 /* --------------------------------------------------------------------------
  * function m2c_ast_nodetype(node)
  * --------------------------------------------------------------------------
@@ -288,7 +629,15 @@ m2c_astnode_t m2c_ast_new_terminal_list_node
  * ----------------------------------------------------------------------- */
 
 m2c_ast_nodetype_t m2c_ast_nodetype (m2c_astnode_t node) {
-
+  
+  m2c_astflat_t flat;
+  uint_t index;
+  
+  if (m2c_astflat_is_handle(node)) {
+    flat = m2c_astflat_for_handle(node, &index);
+    return m2c_astflat_nodetype(flat, index);
+  } /* end if */
+  
   if ((node == NULL) || (!m2c_ast_is_valid_nodetype(node->node_type))) {
     return AST_INVALID;
   } /* end if */
@@ -304,7 +653,15 @@ m2c_ast_nodetype_t m2c_ast_nodetype (m2c_astnode_t node) {
  * ----------------------------------------------------------------------- */
 
 uint_t m2c_ast_subnode_count (m2c_astnode_t node) {
-
+  
+  m2c_astflat_t flat;
+  uint_t index;
+  
+  if (m2c_astflat_is_handle(node)) {
+    flat = m2c_astflat_for_handle(node, &index);
+    return m2c_astflat_subnode_count(flat, index);
+  } /* end if */
+  
   if (node == NULL) {
     return 0;
   } /* end if */
@@ -322,6 +679,15 @@ uint_t m2c_ast_subnode_count (m2c_astnode_t node) {
 
 m2c_astnode_t m2c_ast_subnode_for_index (m2c_astnode_t node, uint_t index) {
   
+  m2c_astflat_t flat;
+  uint_t flat_index;
+  
+  if (m2c_astflat_is_handle(node)) {
+    flat = m2c_astflat_for_handle(node, &flat_index);
+    return m2c_astflat_node
+      (flat, m2c_astflat_subnode_for_index(flat, flat_index, index));
+  } /* end if */
+  
   if ((node == NULL) || (index >= node->subnode_count)) {
     return NULL;
   } /* end if */
@@ -339,6 +705,14 @@ m2c_astnode_t m2c_ast_subnode_for_index (m2c_astnode_t node, uint_t index) {
 
 m2c_string_t m2c_ast_value_for_index (m2c_astnode_t node, uint_t index) {
   
+  m2c_astflat_t flat;
+  uint_t flat_index;
+  
+  if (m2c_astflat_is_handle(node)) {
+    flat = m2c_astflat_for_handle(node, &flat_index);
+    return m2c_astflat_value_for_index(flat, flat_index, index);
+  } /* end if */
+  
   if ((node == NULL) || (!m2c_ast_is_terminal_nodetype(node->node_type))) {
     return NULL;
   } /* end if */
@@ -357,15 +731,23 @@ m2c_astnode_t m2c_ast_replace_subnode
   (m2c_astnode_t in_node, uint_t at_index, m2c_astnode_t with_subnode) {
   
   m2c_astnode_t replaced_node;
-
-  if ((in_node == NULL) ||
+  
+  /* flat trees are immutable */
+  if ((in_node == NULL) || (m2c_astflat_is_handle(in_node)) ||
       (!m2c_ast_is_nonterminal_nodetype(in_node->node_type))) {
     return NULL;
   } /* end if */
   
-  if (!m2c_ast_is_legal_subnode(m2c_ast_nodetype(with_subnode), at_index)) {
+  if (at_index >= in_node->subnode_count) {
+    return NULL;
+  } /* end if */
+  
+#if (M2C_AST_VALIDATE)
+  if (!m2c_ast_is_legal_subnode_type
+        (in_node->node_type, m2c_ast_nodetype(with_subnode), at_index)) {
     return NULL;
   } /* end if */
+#endif
   
   replaced_node = in_node->subnode_table[at_index].non_terminal;
   in_node->subnode_table[at_index].non_terminal = with_subnode;
@@ -384,8 +766,10 @@ m2c_string_t m2c_ast_replace_value
   (m2c_astnode_t in_node, uint_t at_index, m2c_string_t with_value) {
   
   m2c_string_t replaced_value;
-
-  if ((in_node == NULL) || (at_index >= in_node->subnode_count) ||
+  
+  /* flat trees are immutable */
+  if ((in_node == NULL) || (m2c_astflat_is_handle(in_node)) ||
+      (at_index >= in_node->subnode_count) ||
       (!m2c_ast_is_terminal_nodetype(in_node->node_type))) {
     return NULL;
   } /* end if */
@@ -400,17 +784,186 @@ m2c_string_t m2c_ast_replace_value
 /* --------------------------------------------------------------------------
  * function m2c_ast_release_node(node)
  * --------------------------------------------------------------------------
- * Deallocates node. 
+ * Deallocates node, unless it was allocated from the arena selected by the
+ * calling thread, in which case it is released together with the arena.
+ * If it is the node most recently allocated from the arena, its memory is
+ * taken back by the arena immediately.
  * ----------------------------------------------------------------------- */
 
 void m2c_ast_release_node (m2c_astnode_t node) {
   
-  if (node == NULL) {
+  /* handles are released with their flat tree */
+  if ((node == NULL) || (m2c_astflat_is_handle(node)) ||
+      (node == (m2c_astnode_t) &m2c_ast_empty_node_struct)) {
     return;
   } /* end if */
   
-  free(node);
+  /* arena nodes are released with their arena */
+  if (arena_owns_node(current_arena, node)) {
+    arena_take_back_node(current_arena, node);
+    return;
+  } /* end if */
+  
+  m2c_dealloc(M2C_ALLOC_AST, node, sizeof(m2c_astnode_struct_t) +
+    node->subnode_count * sizeof(m2c_astnode_variant));
 } /* end m2c_ast_release_node */
 
 
+/* --------------------------------------------------------------------------
+ * procedure m2c_ast_release_tree(node)
+ * --------------------------------------------------------------------------
+ * Deallocates node and its subtree in post-order. 
+ * ----------------------------------------------------------------------- */
+
+void m2c_ast_release_tree (m2c_astnode_t node) {
+  
+  /* flat trees are released as a whole */
+  if ((node == NULL) || (m2c_astflat_is_handle(node))) {
+    return;
+  } /* end if */
+  
+  m2c_ast_walk(node, NULL, release_visited_node, NULL);
+} /* end m2c_ast_release_tree */
+
+
+/* *********************************************************************** *
+ * Private Functions                                                       *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private function allocate_node(subnode_count)
+ * --------------------------------------------------------------------------
+ * Allocates a node with room for subnode_count subnodes or values from the
+ * arena selected by the calling thread, or individually if none is
+ * selected.  Returns the node, or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+static m2c_astnode_t allocate_node (uint_t subnode_count) {
+  
+  m2c_ast_arena_chunk_s *new_chunk;
+  size_t size, chunk_size;
+  m2c_astnode_t new_node;
+  
+  size = sizeof(m2c_astnode_struct_t) +
+    subnode_count * sizeof(m2c_astnode_variant);
+  
+  if (current_arena == NULL) {
+    return m2c_alloc(M2C_ALLOC_AST, size);
+  } /* end if */
+  
+  /* round up to keep subsequent nodes aligned */
+  size = (size + sizeof(m2c_ast_arena_align_t) - 1) &
+    ~(sizeof(m2c_ast_arena_align_t) - 1);
+  
+  /* start a new chunk if the head chunk is exhausted */
+  if ((current_arena->head == NULL) ||
+      (current_arena->head->size - current_arena->head->used < size)) {
+    
+    chunk_size = current_arena->next_size;
+    if (chunk_size < size) {
+      chunk_size = size;
+    } /* end if */
+    
+    new_chunk =
+      m2c_alloc(M2C_ALLOC_AST, sizeof(m2c_ast_arena_chunk_s) + chunk_size);
+    
+    if (new_chunk == NULL) {
+      return NULL;
+    } /* end if */
+    
+    new_chunk->next = current_arena->head;
+    new_chunk->size = chunk_size;
+    new_chunk->used = 0;
+    current_arena->head = new_chunk;
+    
+    if (current_arena->next_size < M2C_AST_ARENA_MAX_CHUNK_SIZE) {
+      current_arena->next_size = 2 * current_arena->next_size;
+    } /* end if */
+  } /* end if */
+  
+  /* bump allocate */
+  new_node = (m2c_astnode_t)
+    ((char *) current_arena->head->data + current_arena->head->used);
+  current_arena->head->used = current_arena->head->used + size;
+  
+  return new_node;
+} /* end allocate_node */
+
+
+/* --------------------------------------------------------------------------
+ * private function arena_owns_node(arena, node)
+ * --------------------------------------------------------------------------
+ * Returns true if node lies within a chunk of arena, otherwise false.
+ * As chunk sizes grow geometrically, the number of chunks is logarithmic
+ * in the size of the arena.
+ * ----------------------------------------------------------------------- */
+
+static bool arena_owns_node (m2c_ast_arena_t arena, m2c_astnode_t node) {
+  
+  m2c_ast_arena_chunk_s *this_chunk;
+  const char *addr;
+  
+  if (arena == NULL) {
+    return false;
+  } /* end if */
+  
+  addr = (const char *) node;
+  this_chunk = arena->head;
+  
+  while (this_chunk != NULL) {
+    if ((addr >= (const char *) this_chunk->data) &&
+        (addr < (const char *) this_chunk->data + this_chunk->used)) {
+      return true;
+    } /* end if */
+    this_chunk = this_chunk->next;
+  } /* end while */
+  
+  return false;
+} /* end arena_owns_node */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure arena_take_back_node(arena, node)
+ * --------------------------------------------------------------------------
+ * Returns the memory of node to the head chunk of arena if node is the
+ * node most recently allocated from it, otherwise does nothing.  Nodes
+ * released in reverse order of allocation are thus all taken back.
+ * ----------------------------------------------------------------------- */
+
+static void arena_take_back_node (m2c_ast_arena_t arena, m2c_astnode_t node) {
+  
+  m2c_ast_arena_chunk_s *head;
+  size_t size;
+  
+  head = arena->head;
+  
+  /* same size as computed by allocate_node */
+  size = sizeof(m2c_astnode_struct_t) +
+    node->subnode_count * sizeof(m2c_astnode_variant);
+  size = (size + sizeof(m2c_ast_arena_align_t) - 1) &
+    ~(sizeof(m2c_ast_arena_align_t) - 1);
+  
+  if ((head != NULL) &&
+      ((char *) node + size == (char *) head->data + head->used)) {
+    head->used = head->used - size;
+  } /* end if */
+} /* end arena_take_back_node */
+
+
+/* --------------------------------------------------------------------------
+ * private function release_visited_node(visit, context)
+ * --------------------------------------------------------------------------
+ * Leave visitor for m2c_ast_release_tree(), releases the visited node.
+ * ----------------------------------------------------------------------- */
+
+static bool release_visited_node (m2c_ast_visit_t *visit, void *context) {
+  
+  (void) context;
+  
+  m2c_ast_release_node(visit->node);
+  
+  return true;
+} /* end release_visited_node */
+
+
 /* END OF FILE */
\ No newline at end of file
@@ -48,6 +48,63 @@
 typedef struct m2c_astnode_struct_t *m2c_astnode_t;
 
 
+/* --------------------------------------------------------------------------
+ * opaque type m2c_ast_arena_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing an AST node arena.  An arena holds the
+ * nodes of one compilation unit and releases them all at once.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_ast_arena_struct_t *m2c_ast_arena_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_new_arena()
+ * --------------------------------------------------------------------------
+ * Allocates and returns a new empty AST node arena, or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2c_ast_arena_t m2c_ast_new_arena (void);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_ast_set_arena(arena)
+ * --------------------------------------------------------------------------
+ * Selects arena as the allocator for AST nodes subsequently created by the
+ * calling thread.  Passing NULL selects individual allocation of nodes.
+ * Each thread has its own selection, initially NULL.
+ * ----------------------------------------------------------------------- */
+
+void m2c_ast_set_arena (m2c_ast_arena_t arena);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_current_arena()
+ * --------------------------------------------------------------------------
+ * Returns the arena selected by the calling thread, or NULL if none.
+ * ----------------------------------------------------------------------- */
+
+m2c_ast_arena_t m2c_ast_current_arena (void);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_ast_release_arena(arena)
+ * --------------------------------------------------------------------------
+ * Deallocates arena and all AST nodes allocated from it in one operation.
+ *
+ * pre-conditions:
+ * o  arena must not be selected by any thread
+ *
+ * post-conditions:
+ * o  arena and all nodes allocated from it are deallocated
+ *
+ * error-conditions:
+ * o  if arena is NULL, no operation is carried out
+ * ----------------------------------------------------------------------- */
+
+void m2c_ast_release_arena (m2c_ast_arena_t arena);
+
+
 /* --------------------------------------------------------------------------
  * function m2c_ast_empty_node()
  * --------------------------------------------------------------------------
@@ -93,6 +150,19 @@ m2c_astnode_t m2c_ast_new_list_node
   (m2c_ast_nodetype_t node_type, m2c_fifo_t list);
 
 
+/* --------------------------------------------------------------------------
+ * function m2c_ast_new_list_node_from_slice(node_type, count, slice)
+ * --------------------------------------------------------------------------
+ * Allocates a new branch node of the given node type, stores the count
+ * subnodes of array slice in the node and returns the node, or NULL on
+ * failure.  The slice is not modified and remains owned by the caller.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_ast_new_list_node_from_slice
+  (m2c_ast_nodetype_t node_type,
+   uint_t count, const m2c_fifo_value_t *slice);
+
+
 /* --------------------------------------------------------------------------
  * function m2c_ast_new_terminal_node(node_type, value)
  * --------------------------------------------------------------------------
@@ -115,6 +185,31 @@ m2c_astnode_t m2c_ast_new_terminal_list_node
   (m2c_ast_nodetype_t node_type, m2c_fifo_t list);
 
 
+/* --------------------------------------------------------------------------
+ * function m2c_ast_new_terminal_list_node_from_slice(node_type, count, slice)
+ * --------------------------------------------------------------------------
+ * Allocates a new terminal node of the given node type, stores the count
+ * values of array slice in the node and returns the node, or NULL on
+ * failure.  The slice is not modified and remains owned by the caller.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_ast_new_terminal_list_node_from_slice
+  (m2c_ast_nodetype_t node_type,
+   uint_t count, const m2c_fifo_value_t *slice);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_copy_node(node)
+ * --------------------------------------------------------------------------
+ * Allocates a new node of the same node type as node, stores the subnodes
+ * or values of node in the new node and returns it, or NULL on failure.
+ * The subnodes are shared, not copied.  Node may be a node of a flat tree,
+ * the copy is not.  The copy of the empty node is the empty node singleton.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_ast_copy_node (m2c_astnode_t node);
+
+
 /* --------------------------------------------------------------------------
  * function m2c_ast_nodetype(node)
  * --------------------------------------------------------------------------
@@ -187,12 +282,26 @@ m2c_string_t m2c_ast_replace_value
 /* --------------------------------------------------------------------------
  * function m2c_ast_release_node(node)
  * --------------------------------------------------------------------------
- * Deallocates node. 
+ * Deallocates node, unless it was allocated from the arena selected by the
+ * calling thread, in which case it is released together with the arena.
+ * If it is the node most recently allocated from the arena, its memory is
+ * taken back by the arena immediately.
  * ----------------------------------------------------------------------- */
 
 void m2c_ast_release_node (m2c_astnode_t node);
 
 
+/* --------------------------------------------------------------------------
+ * procedure m2c_ast_release_tree(node)
+ * --------------------------------------------------------------------------
+ * Deallocates node and all nodes of its subtree as m2c_ast_release_node()
+ * does.  The tree is traversed without recursion, its depth is therefore
+ * not limited by the size of the C stack.
+ * ----------------------------------------------------------------------- */
+
+void m2c_ast_release_tree (m2c_astnode_t node);
+
+
 #endif /* M2C_AST_H */
 
 /* END OF FILE */
\ No newline at end of file
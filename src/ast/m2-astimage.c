@@ -0,0 +1,503 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015, 2016 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * m2-astimage.c
+ *
+ * Implementation of M2C binary AST images.
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute and/or modify it under the
+ * terms of the GNU Lesser General Public License (LGPL) either version 2.1
+ * or at your choice version 3 as published by the Free Software Foundation.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#include "m2-astimage.h"
+#include "fileutils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_astimage_struct_t
+ * --------------------------------------------------------------------------
+ * record type representing a loaded binary AST image.  Fields first_link,
+ * link, string_offset, node_type and strings point into the image data.
+ * The data is released with the image only if field owned is set.
+ * ----------------------------------------------------------------------- */
+
+struct m2c_astimage_struct_t {
+  /* data */ const char *data;
+  /* size */ size_t size;
+  /* owned */ bool owned;
+  /* mapped */ bool mapped;
+  /* node_count */ uint32_t node_count;
+  /* link_count */ uint32_t link_count;
+  /* string_count */ uint32_t string_count;
+  /* string_bytes */ uint32_t string_bytes;
+  /* first_link */ const uint32_t *first_link;
+  /* link */ const uint32_t *link;
+  /* string_offset */ const uint32_t *string_offset;
+  /* node_type */ const uint16_t *node_type;
+  /* strings */ const char *strings;
+};
+
+typedef struct m2c_astimage_struct_t m2c_astimage_struct_t;
+
+
+/* --------------------------------------------------------------------------
+ * Forward declarations
+ * ----------------------------------------------------------------------- */
+
+static const char *read_image_file
+  (const char *path, size_t *size, m2c_fileio_status_t *status);
+
+static bool set_image_layout (m2c_astimage_t image);
+
+static bool image_is_valid (m2c_astimage_t image);
+
+static uint32_t value_link
+  (m2c_astimage_t image, uint_t node, uint_t index);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astimage_load(path, status)
+ * --------------------------------------------------------------------------
+ * Loads the binary AST image stored in the file at path and returns it.
+ * ----------------------------------------------------------------------- */
+
+m2c_astimage_t m2c_astimage_load
+  (const char *path, m2c_fileio_status_t *status) {
+  
+  m2c_astimage_t image;
+  m2c_fileio_status_t read_status;
+  
+  if ((path == NULL) || (NOT(is_regular_file(path)))) {
+    SET_STATUS(status, M2C_FILEIO_STATUS_FOPEN_FAILED);
+    return NULL;
+  } /* end if */
+  
+  image = malloc(sizeof(m2c_astimage_struct_t));
+  
+  if (image == NULL) {
+    SET_STATUS(status, M2C_FILEIO_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  image->owned = true;
+  
+  /* map image, fall back to reading it into memory */
+  if (map_file(path, &image->data, &image->size)) {
+    image->mapped = true;
+  }
+  else {
+    image->mapped = false;
+    image->data = read_image_file(path, &image->size, &read_status);
+  
+    if (image->data == NULL) {
+      free(image);
+      SET_STATUS(status, read_status);
+      return NULL;
+    } /* end if */
+  } /* end if */
+  
+  if ((NOT(set_image_layout(image))) || (NOT(image_is_valid(image)))) {
+    m2c_astimage_release(image);
+    SET_STATUS(status, M2C_FILEIO_STATUS_INVALID_FORMAT);
+    return NULL;
+  } /* end if */
+  
+  SET_STATUS(status, M2C_FILEIO_STATUS_SUCCESS);
+  return image;
+} /* end m2c_astimage_load */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astimage_for_data(data, size, status)
+ * --------------------------------------------------------------------------
+ * Returns an image for the binary AST image of the given size at data.
+ * ----------------------------------------------------------------------- */
+
+m2c_astimage_t m2c_astimage_for_data
+  (const char *data, size_t size, m2c_fileio_status_t *status) {
+  
+  m2c_astimage_t image;
+  
+  if (data == NULL) {
+    SET_STATUS(status, M2C_FILEIO_STATUS_INVALID_FORMAT);
+    return NULL;
+  } /* end if */
+  
+  image = malloc(sizeof(m2c_astimage_struct_t));
+  
+  if (image == NULL) {
+    SET_STATUS(status, M2C_FILEIO_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  image->data = data;
+  image->size = size;
+  image->owned = false;
+  image->mapped = false;
+  
+  if ((NOT(set_image_layout(image))) || (NOT(image_is_valid(image)))) {
+    free(image);
+    SET_STATUS(status, M2C_FILEIO_STATUS_INVALID_FORMAT);
+    return NULL;
+  } /* end if */
+  
+  SET_STATUS(status, M2C_FILEIO_STATUS_SUCCESS);
+  return image;
+} /* end m2c_astimage_for_data */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astimage_node_count(image)
+ * --------------------------------------------------------------------------
+ * Returns the number of nodes in image, or zero if image is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_astimage_node_count (m2c_astimage_t image) {
+  
+  if (image == NULL) {
+    return 0;
+  } /* end if */
+  
+  return image->node_count;
+} /* end m2c_astimage_node_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astimage_nodetype(image, node)
+ * --------------------------------------------------------------------------
+ * Returns the node type of the node with index node in image, or
+ * AST_INVALID if image is NULL or node is not a valid node index.
+ * ----------------------------------------------------------------------- */
+
+m2c_ast_nodetype_t m2c_astimage_nodetype (m2c_astimage_t image, uint_t node) {
+  
+  if ((image == NULL) || (node >= image->node_count)) {
+    return AST_INVALID;
+  } /* end if */
+  
+  return (m2c_ast_nodetype_t) image->node_type[node];
+} /* end m2c_astimage_nodetype */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astimage_subnode_count(image, node)
+ * --------------------------------------------------------------------------
+ * Returns the number of subnodes or values of the node with index node in
+ * image, or zero if image is NULL or node is not a valid node index.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_astimage_subnode_count (m2c_astimage_t image, uint_t node) {
+  
+  if ((image == NULL) || (node >= image->node_count)) {
+    return 0;
+  } /* end if */
+  
+  return image->first_link[node + 1] - image->first_link[node];
+} /* end m2c_astimage_subnode_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astimage_subnode_for_index(image, node, index)
+ * --------------------------------------------------------------------------
+ * Returns the node index of the subnode with the given index of the
+ * nonterminal node with index node in image, or M2C_ASTIMAGE_INVALID_NODE
+ * if the node does not have a subnode with the given index.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_astimage_subnode_for_index
+  (m2c_astimage_t image, uint_t node, uint_t index) {
+  
+  if ((index >= m2c_astimage_subnode_count(image, node)) ||
+      (NOT(m2c_ast_is_nonterminal_nodetype(image->node_type[node])))) {
+    return M2C_ASTIMAGE_INVALID_NODE;
+  } /* end if */
+  
+  return image->link[image->first_link[node] + index];
+} /* end m2c_astimage_subnode_for_index */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astimage_value_for_index(image, node, index)
+ * --------------------------------------------------------------------------
+ * Returns an immutable pointer to the NUL terminated value stored at the
+ * given index in the terminal node with index node in image, or NULL if
+ * the node does not store any value at the given index.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_astimage_value_for_index
+  (m2c_astimage_t image, uint_t node, uint_t index) {
+  
+  uint32_t string;
+  
+  string = value_link(image, node, index);
+  
+  if (string == M2C_ASTIMAGE_INVALID_NODE) {
+    return NULL;
+  } /* end if */
+  
+  return image->strings + image->string_offset[string];
+} /* end m2c_astimage_value_for_index */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astimage_value_length(image, node, index)
+ * --------------------------------------------------------------------------
+ * Returns the length of the value stored at the given index in the terminal
+ * node with index node in image, or zero if there is no such value.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_astimage_value_length
+  (m2c_astimage_t image, uint_t node, uint_t index) {
+  
+  uint32_t string;
+  
+  string = value_link(image, node, index);
+  
+  if (string == M2C_ASTIMAGE_INVALID_NODE) {
+    return 0;
+  } /* end if */
+  
+  /* exclude NUL terminator */
+  return
+    image->string_offset[string + 1] - image->string_offset[string] - 1;
+} /* end m2c_astimage_value_length */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_astimage_release(image)
+ * --------------------------------------------------------------------------
+ * Releases image.  Pointers obtained from image become invalid.
+ * ----------------------------------------------------------------------- */
+
+void m2c_astimage_release (m2c_astimage_t image) {
+  
+  if (image == NULL) {
+    return;
+  } /* end if */
+  
+  /* data of an embedded image belongs to the caller */
+  if (image->owned) {
+    if (image->mapped) {
+      unmap_file(image->data, image->size);
+    }
+    else {
+      free((void *) image->data);
+    } /* end if */
+  } /* end if */
+  
+  free(image);
+} /* end m2c_astimage_release */
+
+
+/* *********************************************************************** *
+ * Private Functions                                                       *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private function read_image_file(path, size, status)
+ * --------------------------------------------------------------------------
+ * Reads the file at path into a newly allocated buffer, passes its size
+ * back in size and returns the buffer.  Returns NULL on failure and passes
+ * the cause back in status.
+ * ----------------------------------------------------------------------- */
+
+static const char *read_image_file
+  (const char *path, size_t *size, m2c_fileio_status_t *status) {
+  
+  char *buffer;
+  long length;
+  FILE *file;
+  
+  file = fopen(path, "rb");
+  
+  if (file == NULL) {
+    *status = M2C_FILEIO_STATUS_FOPEN_FAILED;
+    return NULL;
+  } /* end if */
+  
+  if ((fseek(file, 0, SEEK_END) != 0) || ((length = ftell(file)) <= 0) ||
+      (fseek(file, 0, SEEK_SET) != 0)) {
+    fclose(file);
+    *status = M2C_FILEIO_STATUS_READ_FAILED;
+    return NULL;
+  } /* end if */
+  
+  buffer = malloc(length);
+  
+  if (buffer == NULL) {
+    *status = M2C_FILEIO_STATUS_ALLOCATION_FAILED;
+  }
+  else if (fread(buffer, 1, length, file) != (size_t) length) {
+    free(buffer);
+    buffer = NULL;
+    *status = M2C_FILEIO_STATUS_READ_FAILED;
+  } /* end if */
+  
+  fclose(file);
+  
+  *size = length;
+  return buffer;
+} /* end read_image_file */
+
+
+/* --------------------------------------------------------------------------
+ * private function set_image_layout(image)
+ * --------------------------------------------------------------------------
+ * Checks the header of image and its size, then sets the array pointers of
+ * image.  Returns true if the header is valid and the size of the image
+ * matches the array sizes of the header, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+static bool set_image_layout (m2c_astimage_t image) {
+  
+  const m2c_astimage_header_t *header;
+  uint64_t expected_size;
+  
+  if (image->size < sizeof(m2c_astimage_header_t)) {
+    return false;
+  } /* end if */
+  
+  header = (const m2c_astimage_header_t *) image->data;
+  
+  if ((memcmp(header->magic, M2C_ASTIMAGE_MAGIC, 4) != 0) ||
+      (header->version != M2C_ASTIMAGE_VERSION) ||
+      (header->byte_order != M2C_ASTIMAGE_BYTE_ORDER) ||
+      (header->node_count == 0)) {
+    return false;
+  } /* end if */
+  
+  expected_size = sizeof(m2c_astimage_header_t) +
+    ((uint64_t) header->node_count + 1) * sizeof(uint32_t) +
+    (uint64_t) header->link_count * sizeof(uint32_t) +
+    ((uint64_t) header->string_count + 1) * sizeof(uint32_t) +
+    (uint64_t) header->node_count * sizeof(uint16_t) +
+    (uint64_t) header->string_bytes;
+  
+  if (expected_size != (uint64_t) image->size) {
+    return false;
+  } /* end if */
+  
+  image->node_count = header->node_count;
+  image->link_count = header->link_count;
+  image->string_count = header->string_count;
+  image->string_bytes = header->string_bytes;
+  
+  image->first_link =
+    (const uint32_t *) (image->data + sizeof(m2c_astimage_header_t));
+  image->link = image->first_link + image->node_count + 1;
+  image->string_offset = image->link + image->link_count;
+  image->node_type = (const uint16_t *)
+    (image->string_offset + image->string_count + 1);
+  image->strings = (const char *) (image->node_type + image->node_count);
+  
+  return true;
+} /* end set_image_layout */
+
+
+/* --------------------------------------------------------------------------
+ * private function image_is_valid(image)
+ * --------------------------------------------------------------------------
+ * Returns true if all indices and offsets in image are within bounds, all
+ * subnode links point forward and all strings are NUL terminated, so that
+ * accessors and traversals of image cannot fail, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+static bool image_is_valid (m2c_astimage_t image) {
+  
+  uint32_t node, string, index, limit;
+  
+  /* verify string table */
+  if ((image->string_offset[0] != 0) ||
+      (image->string_offset[image->string_count] != image->string_bytes)) {
+    return false;
+  } /* end if */
+  
+  for (string = 0; string < image->string_count; string++) {
+    if ((image->string_offset[string + 1] <=
+         image->string_offset[string]) ||
+        (image->strings[image->string_offset[string + 1] - 1] !=
+         ASCII_NUL)) {
+      return false;
+    } /* end if */
+  } /* end for */
+  
+  /* verify link table */
+  if ((image->first_link[0] != 0) ||
+      (image->first_link[image->node_count] != image->link_count)) {
+    return false;
+  } /* end if */
+  
+  for (node = 0; node < image->node_count; node++) {
+    if ((image->node_type[node] >= AST_INVALID) ||
+        (image->first_link[node + 1] < image->first_link[node])) {
+      return false;
+    } /* end if */
+  
+    limit = image->first_link[node + 1];
+  
+    for (index = image->first_link[node]; index < limit; index++) {
+      if (m2c_ast_is_nonterminal_nodetype(image->node_type[node])) {
+        if ((image->link[index] <= node) ||
+            (image->link[index] >= image->node_count)) {
+          return false;
+        } /* end if */
+      }
+      else if (image->link[index] >= image->string_count) {
+        return false;
+      } /* end if */
+    } /* end for */
+  } /* end for */
+  
+  return true;
+} /* end image_is_valid */
+
+
+/* --------------------------------------------------------------------------
+ * private function value_link(image, node, index)
+ * --------------------------------------------------------------------------
+ * Returns the string index of the value with the given index in the
+ * terminal node with index node, or M2C_ASTIMAGE_INVALID_NODE if there is
+ * no such value.
+ * ----------------------------------------------------------------------- */
+
+static uint32_t value_link
+  (m2c_astimage_t image, uint_t node, uint_t index) {
+  
+  if ((index >= m2c_astimage_subnode_count(image, node)) ||
+      (m2c_ast_is_nonterminal_nodetype(image->node_type[node]))) {
+    return M2C_ASTIMAGE_INVALID_NODE;
+  } /* end if */
+  
+  return image->link[image->first_link[node] + index];
+} /* end value_link */
+
+
+/* END OF FILE */
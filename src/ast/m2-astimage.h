@@ -0,0 +1,233 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015, 2016 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * m2-astimage.h
+ *
+ * Public interface for M2C binary AST images.
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute and/or modify it under the
+ * terms of the GNU Lesser General Public License (LGPL) either version 2.1
+ * or at your choice version 3 as published by the Free Software Foundation.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#ifndef M2C_ASTIMAGE_H
+#define M2C_ASTIMAGE_H
+
+#include "m2-common.h"
+#include "m2-fileio-status.h"
+#include "m2-ast-nodetype.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+/* --------------------------------------------------------------------------
+ * Binary AST image format
+ * --------------------------------------------------------------------------
+ * A binary AST image is written by function m2c_ast_write_binary() and
+ * consists of a header followed by five arrays, all in host byte order:
+ *
+ *   uint32_t first_link[node_count + 1];
+ *   uint32_t link[link_count];
+ *   uint32_t string_offset[string_count + 1];
+ *   uint16_t node_type[node_count];
+ *   char strings[string_bytes];
+ *
+ * Nodes are numbered in depth first pre-order, the root node has index 0.
+ * The links of node i are link[first_link[i]] to link[first_link[i+1]-1].
+ * For a nonterminal node, links are indices of its subnodes, which are
+ * always greater than the index of the node itself.  For a terminal node,
+ * links are indices into the string table.  String i starts at offset
+ * string_offset[i] in strings and is NUL terminated.  Each distinct value
+ * is stored only once.  The layout keeps all arrays naturally aligned, an
+ * image can therefore be used in place, without any decoding.
+ * ----------------------------------------------------------------------- */
+
+#define M2C_ASTIMAGE_MAGIC "M2AB"
+
+#define M2C_ASTIMAGE_VERSION 1
+
+#define M2C_ASTIMAGE_BYTE_ORDER 0x0102
+
+#define M2C_ASTIMAGE_INVALID_NODE 0xffffffff
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_astimage_header_t
+ * --------------------------------------------------------------------------
+ * record type representing the header of a binary AST image.  Field
+ * byte_order holds M2C_ASTIMAGE_BYTE_ORDER in the byte order of the host
+ * that wrote the image.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* magic */ char magic[4];
+  /* version */ uint16_t version;
+  /* byte_order */ uint16_t byte_order;
+  /* node_count */ uint32_t node_count;
+  /* link_count */ uint32_t link_count;
+  /* string_count */ uint32_t string_count;
+  /* string_bytes */ uint32_t string_bytes;
+} m2c_astimage_header_t;
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2c_astimage_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing a loaded binary AST image.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_astimage_struct_t *m2c_astimage_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astimage_load(path, status)
+ * --------------------------------------------------------------------------
+ * Loads the binary AST image stored in the file at path and returns it.
+ * The file is memory mapped where the host supports it, otherwise it is
+ * read into memory.  The image is validated but not otherwise decoded.
+ *
+ * pre-conditions:
+ * o  path must be the pathname of an existing binary AST image file
+ *
+ * post-conditions:
+ * o  the loaded image is returned
+ * o  M2C_FILEIO_STATUS_SUCCESS is passed back in status, unless NULL
+ *
+ * error-conditions:
+ * o  if the file cannot be opened, NULL is returned and
+ *    M2C_FILEIO_STATUS_FOPEN_FAILED is passed back in status, unless NULL
+ * o  if the file cannot be read, NULL is returned and
+ *    M2C_FILEIO_STATUS_READ_FAILED is passed back in status, unless NULL
+ * o  if allocation fails, NULL is returned and
+ *    M2C_FILEIO_STATUS_ALLOCATION_FAILED is passed back in status,
+ *    unless NULL
+ * o  if the file is not a valid image, NULL is returned and
+ *    M2C_FILEIO_STATUS_INVALID_FORMAT is passed back in status, unless NULL
+ * ----------------------------------------------------------------------- */
+
+m2c_astimage_t m2c_astimage_load
+  (const char *path, m2c_fileio_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astimage_for_data(data, size, status)
+ * --------------------------------------------------------------------------
+ * Returns an image for the binary AST image of the given size at data, as
+ * embedded in a symbol file.  The image is validated but not copied, data
+ * must remain valid until the image is released and is not released with
+ * the image.  Data must be aligned to a multiple of four bytes.
+ *
+ * error-conditions:
+ * o  if allocation fails, NULL is returned and
+ *    M2C_FILEIO_STATUS_ALLOCATION_FAILED is passed back in status,
+ *    unless NULL
+ * o  if data is NULL or not a valid image, NULL is returned and
+ *    M2C_FILEIO_STATUS_INVALID_FORMAT is passed back in status, unless NULL
+ * ----------------------------------------------------------------------- */
+
+m2c_astimage_t m2c_astimage_for_data
+  (const char *data, size_t size, m2c_fileio_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astimage_node_count(image)
+ * --------------------------------------------------------------------------
+ * Returns the number of nodes in image, or zero if image is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_astimage_node_count (m2c_astimage_t image);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astimage_nodetype(image, node)
+ * --------------------------------------------------------------------------
+ * Returns the node type of the node with index node in image, or
+ * AST_INVALID if image is NULL or node is not a valid node index.
+ * ----------------------------------------------------------------------- */
+
+m2c_ast_nodetype_t m2c_astimage_nodetype (m2c_astimage_t image, uint_t node);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astimage_subnode_count(image, node)
+ * --------------------------------------------------------------------------
+ * Returns the number of subnodes or values of the node with index node in
+ * image, or zero if image is NULL or node is not a valid node index.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_astimage_subnode_count (m2c_astimage_t image, uint_t node);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astimage_subnode_for_index(image, node, index)
+ * --------------------------------------------------------------------------
+ * Returns the node index of the subnode with the given index of the
+ * nonterminal node with index node in image, or M2C_ASTIMAGE_INVALID_NODE
+ * if the node does not have a subnode with the given index.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_astimage_subnode_for_index
+  (m2c_astimage_t image, uint_t node, uint_t index);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astimage_value_for_index(image, node, index)
+ * --------------------------------------------------------------------------
+ * Returns an immutable pointer to the NUL terminated value stored at the
+ * given index in the terminal node with index node in image, or NULL if
+ * the node does not store any value at the given index.  The pointer
+ * remains valid until the image is released.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_astimage_value_for_index
+  (m2c_astimage_t image, uint_t node, uint_t index);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_astimage_value_length(image, node, index)
+ * --------------------------------------------------------------------------
+ * Returns the length of the value stored at the given index in the terminal
+ * node with index node in image, or zero if there is no such value.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_astimage_value_length
+  (m2c_astimage_t image, uint_t node, uint_t index);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_astimage_release(image)
+ * --------------------------------------------------------------------------
+ * Releases image.  Pointers obtained from image become invalid.  The data
+ * of an image obtained from m2c_astimage_for_data() is not released.
+ * ----------------------------------------------------------------------- */
+
+void m2c_astimage_release (m2c_astimage_t image);
+
+
+#endif /* M2C_ASTIMAGE_H */
+
+/* END OF FILE */
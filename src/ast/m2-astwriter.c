@@ -34,53 +34,80 @@
  */
 
 #include "m2-astwriter.h"
+#include "m2-astimage.h"
+#include "m2-ast-flat.h"
+#include "m2-ast-walk.h"
+#include "m2-ast-parallel.h"
+#include "m2-outsink.h"
 #include "cstring.h"
+#include "m2-trace-probes.h"
 
 #include <stdio.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
 
 /* --------------------------------------------------------------------------
- * AST target file context
+ * hidden type ast_writer_s
+ * --------------------------------------------------------------------------
+ * record type representing the context of the traversal visitors.  Field
+ * nested is true once the outermost node has been opened.  Field split
+ * holds the list node whose items are written in parallel, if any.
  * ----------------------------------------------------------------------- */
 
-typedef struct astfile_s *astfile_t;
+typedef struct {
+  /* sink */ m2c_outsink_t sink;
+  /* nested */ bool nested;
+  /* split */ m2c_astnode_t split;
+} ast_writer_s;
 
-struct astfile_s {
-  FILE *fptr;
-  uint_t chars_written;
-  m2c_fileio_status_t status;
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_ast_stream_struct_t
+ * --------------------------------------------------------------------------
+ * record type representing an AST output stream.
+ * ----------------------------------------------------------------------- */
+
+struct m2c_ast_stream_struct_t {
+  /* writer */ ast_writer_s writer;
+  /* completed */ bool completed;
 };
 
-typedef struct astfile_s astfile_s;
+typedef struct m2c_ast_stream_struct_t m2c_ast_stream_struct_t;
 
 
 /* --------------------------------------------------------------------------
  * Forward declarations
  * ----------------------------------------------------------------------- */
 
-static void ast_write_lf (m2c_astfile_t astfile);
+static bool ast_write_enter (m2c_ast_visit_t *visit, void *context);
 
-static void ast_write_subtree (m2c_astfile_t astfile, m2c_astnode_t node);
+static bool ast_write_leave (m2c_ast_visit_t *visit, void *context);
 
-static void ast_write_branches (m2c_astfile_t astfile, m2c_astnode_t node);
+static bool ast_write_part
+  (m2c_outsink_t sink, m2c_astnode_t list, uint_t first, uint_t count,
+   void *context);
 
 static void ast_write_leaves
-  (m2c_astfile_t astfile, m2c_astnode_t node, m2c_astnode_type_t node_type);
+  (m2c_outsink_t sink, m2c_astnode_t node, m2c_ast_nodetype_t node_type);
 
 static void ast_write_single_value
-  (m2c_astfile_t astfile, m2c_astnode_t node, m2c_astnode_type_t node_type);
+  (m2c_outsink_t sink, m2c_astnode_t node, m2c_ast_nodetype_t node_type);
 
 static void ast_write_value_list
-  (m2c_astfile_t astfile, m2c_astnode_t node, m2c_astnode_type_t node_type);
+  (m2c_outsink_t sink, m2c_astnode_t node, m2c_ast_nodetype_t node_type);
+
+static void ast_write_unformatted_value
+  (m2c_outsink_t sink, m2c_string_t lexeme);
 
-static int ast_write_unformatted_value (FILE *fptr, m2c_string_t lexeme);
+static void ast_write_int_value (m2c_outsink_t sink, m2c_string_t lexeme);
 
-static int ast_write_int_value (FILE *fptr, m2c_string_t lexeme);
+static void ast_write_chr_value (m2c_outsink_t sink, m2c_string_t lexeme);
 
-static int ast_write_chr_value (FILE *fptr, m2c_string_t lexeme);
+static void ast_write_quoted_value (m2c_outsink_t sink, m2c_string_t lexeme);
 
-static int ast_write_quoted_value (FILE *fptr, m2c_string_t lexeme);
+static bool ast_write_image (m2c_astflat_t flat, FILE *fptr);
 
 
 /* --------------------------------------------------------------------------
@@ -94,169 +121,394 @@ static int ast_write_quoted_value (FILE *fptr, m2c_string_t lexeme);
 m2c_fileio_status_t m2c_ast_write
   (const char *path, m2c_astnode_t ast, uint_t *chars_written) {
   
-  astfile_s astfile;
+  m2c_fileio_status_t status;
+  ast_writer_s writer;
+  bool completed;
+  uint_t count;
   
   if ((file_exists(path)) && (NOT(is_regular_file(path)))) {
     WRITE_OUTPARAM(chars_written, 0);
     return M2C_FILEIO_STATUS_INVALID_FILE;
   } /* end if */
   
-  astfile.fptr = fopen(path, "w");
+  writer.sink = m2c_outsink_open(path, &status);
   
-  if (astfile.fptr == NULL) {
+  if (writer.sink == NULL) {
     WRITE_OUTPARAM(chars_written, 0);
-    return M2C_FILEIO_STATUS_FOPEN_FAILED;
+    return status;
   } /* end if */
   
-  astfile.chars_written = 0;
-  astfile.status = 0;
+  M2C_TRACE_WRITE_START("ast", path);
   
-  ast_write_subtree(&astfile, ast);
+  /* top-level items of large modules are written in parallel */
+  writer.nested = false;
+  writer.split = m2c_ast_parallel_list(ast);
   
-  if (astfile.status == M2C_FILEIO_STATUS_SUCCESS) {
-    ast_write_lf(&astfile);
+  completed =
+    m2c_ast_walk(ast, ast_write_enter, ast_write_leave, &writer);
+  m2c_outsink_write_char(writer.sink, '\n');
+  
+  count = m2c_outsink_chars_written(writer.sink);
+  status = m2c_outsink_close(&writer.sink);
+  
+  /* traversal stack could not be grown */
+  if ((NOT(completed)) && (status == M2C_FILEIO_STATUS_SUCCESS)) {
+    status = M2C_FILEIO_STATUS_ALLOCATION_FAILED;
   } /* end if */
-      
-  fclose(astfile.fptr);
   
-  WRITE_OUTPARAM(chars_written, astfile.chars_written);
+  WRITE_OUTPARAM(chars_written, count);
   
-  return astfile.status;
+  M2C_TRACE_WRITE_END("ast", path, status);
+  
+  return status;
 } /* end m2c_ast_write */
 
 
-/* *********************************************************************** *
- * Private Functions                                                       *
- * *********************************************************************** */
+/* --------------------------------------------------------------------------
+ * function m2c_ast_stream_new(path, status)
+ * --------------------------------------------------------------------------
+ * Creates or truncates the output file at the given path and returns a new
+ * AST output stream that writes to it, or NULL on failure.
+ * ----------------------------------------------------------------------- */
 
-#define ADD_TO(_target,_source) { _target = _target + _source }
+m2c_ast_stream_t m2c_ast_stream_new
+  (const char *path, m2c_fileio_status_t *status) {
+  
+  m2c_ast_stream_t new_stream;
+  m2c_outsink_t sink;
+  
+  if ((file_exists(path)) && (NOT(is_regular_file(path)))) {
+    SET_STATUS(status, M2C_FILEIO_STATUS_INVALID_FILE);
+    return NULL;
+  } /* end if */
+  
+  new_stream = malloc(sizeof(m2c_ast_stream_struct_t));
+  
+  if (new_stream == NULL) {
+    SET_STATUS(status, M2C_FILEIO_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  sink = m2c_outsink_open(path, status);
+  
+  if (sink == NULL) {
+    free(new_stream);
+    return NULL;
+  } /* end if */
+  
+  new_stream->writer.sink = sink;
+  new_stream->writer.nested = false;
+  new_stream->writer.split = NULL;
+  new_stream->completed = true;
+  
+  SET_STATUS(status, M2C_FILEIO_STATUS_SUCCESS);
+  return new_stream;
+} /* end m2c_ast_stream_new */
 
 
 /* --------------------------------------------------------------------------
- * private function ast_write_lf(astfile)
+ * procedure m2c_ast_stream_open_node(stream, node_type)
  * --------------------------------------------------------------------------
- * Writes linefeed to astfile.  Records chars_written, status.
+ * Writes the opening delimiter and stem of a node of node_type to stream.
  * ----------------------------------------------------------------------- */
 
-static void ast_write_lf (m2c_astfile_t astfile) {
-  
-  int write_count;
+void m2c_ast_stream_open_node
+  (m2c_ast_stream_t stream, m2c_ast_nodetype_t node_type) {
   
-  write_count = fprintf(astfile->fptr, "\n");
+  if (stream == NULL) {
+    return;
+  } /* end if */
   
-  if (write_count >= 0) {
-    ADD_TO(astfile->chars_written, write_count);
+  if (stream->writer.nested) {
+    m2c_outsink_write_chars(stream->writer.sink, " (", 2);
   }
   else {
-    astfile->status = M2C_FILEIO_STATUS_WRITE_FAILED;
+    m2c_outsink_write_char(stream->writer.sink, '(');
+    stream->writer.nested = true;
   } /* end if */
   
+  m2c_outsink_write_str
+    (stream->writer.sink, m2c_name_for_nodetype(node_type));
+  
   return;
-} /* end ast_write_lf */
+} /* end m2c_ast_stream_open_node */
 
 
 /* --------------------------------------------------------------------------
- * private function ast_write_subtree(astfile, node)
+ * procedure m2c_ast_stream_write_node(stream, node)
  * --------------------------------------------------------------------------
- * Writes node to astfile.  Records chars_written, status.
+ * Writes the complete subtree of node to stream.
  * ----------------------------------------------------------------------- */
 
-static void ast_write_subtree (m2c_astfile_t astfile, m2c_astnode_t node) {
+void m2c_ast_stream_write_node (m2c_ast_stream_t stream, m2c_astnode_t node) {
   
-  int write_count;
-  const char *node_name;
-  m2c_ast_nodetype_t node_type;
-  
-  node_type = m2c_ast_nodetype(node);
-  node_name = m2c_name_for_nodetype(node_type);
+  if ((stream == NULL) || (node == NULL)) {
+    return;
+  } /* end if */
   
-  /* write opening delimiter and stem */
-  if (astfile->chars_written == 0) {
-    write_count = fprintf(astfile->fptr, "(%s", node_name);
-  }
-  else {
-    write_count = fprintf(astfile->fptr, " (%s", node_name);
+  if (NOT(m2c_ast_walk(node,
+      ast_write_enter, ast_write_leave, &stream->writer))) {
+    stream->completed = false;
   } /* end if */
   
-  if (write_count >= 0) {
-    ADD_TO(astfile->chars_written, write_count);
-  }
-  else {
-    astfile->status = M2C_FILEIO_STATUS_WRITE_FAILED;
+  return;
+} /* end m2c_ast_stream_write_node */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_ast_stream_close_node(stream)
+ * --------------------------------------------------------------------------
+ * Writes the closing delimiter of the innermost open node to stream.
+ * ----------------------------------------------------------------------- */
+
+void m2c_ast_stream_close_node (m2c_ast_stream_t stream) {
+  
+  if (stream == NULL) {
     return;
   } /* end if */
   
-  /* write all branches and leaves */
-  if (m2c_ast_is_nonterminal(node_type)) {
-    ast_write_branches(astfile, node);
-  }
-  else {
-    ast_write_leaves(astfile, node, node_type);
+  m2c_outsink_write_char(stream->writer.sink, ')');
+  
+  return;
+} /* end m2c_ast_stream_close_node */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_stream_release(streamptr, chars_written)
+ * --------------------------------------------------------------------------
+ * Terminates the output of the stream passed in streamptr, closes its file,
+ * deallocates the stream and returns a status code.
+ * ----------------------------------------------------------------------- */
+
+m2c_fileio_status_t m2c_ast_stream_release
+  (m2c_ast_stream_t *streamptr, uint_t *chars_written) {
+  
+  m2c_fileio_status_t status;
+  m2c_ast_stream_t stream;
+  uint_t count;
+  
+  if ((streamptr == NULL) || (*streamptr == NULL)) {
+    WRITE_OUTPARAM(chars_written, 0);
+    return M2C_FILEIO_STATUS_INVALID_FILE;
   } /* end if */
   
-  if (astfile->status != M2C_FILEIO_STATUS_SUCCESS) {
-    return;
+  stream = *streamptr;
+  m2c_outsink_write_char(stream->writer.sink, '\n');
+  
+  count = m2c_outsink_chars_written(stream->writer.sink);
+  status = m2c_outsink_close(&stream->writer.sink);
+  
+  /* traversal stack could not be grown */
+  if ((NOT(stream->completed)) && (status == M2C_FILEIO_STATUS_SUCCESS)) {
+    status = M2C_FILEIO_STATUS_ALLOCATION_FAILED;
+  } /* end if */
+  
+  free(stream);
+  *streamptr = NULL;
+  
+  WRITE_OUTPARAM(chars_written, count);
+  
+  return status;
+} /* end m2c_ast_stream_release */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_write_binary(path, ast, bytes_written)
+ * --------------------------------------------------------------------------
+ * Writes the given abstract syntax tree as a binary AST image to the given
+ * output file at the given path and returns a status code.  Passes the
+ * number of bytes written back in out-parameter bytes_written.
+ * ----------------------------------------------------------------------- */
+
+m2c_fileio_status_t m2c_ast_write_binary
+  (const char *path, m2c_astnode_t ast, uint_t *bytes_written) {
+  
+  m2c_fileio_status_t status;
+  m2c_astflat_t flat;
+  long size;
+  FILE *fptr;
+  
+  WRITE_OUTPARAM(bytes_written, 0);
+  
+  if ((file_exists(path)) && (NOT(is_regular_file(path)))) {
+    return M2C_FILEIO_STATUS_INVALID_FILE;
+  } /* end if */
+  
+  /* the image is a serialised flat AST */
+  flat = m2c_astflat_new(ast);
+  
+  if (flat == NULL) {
+    return M2C_FILEIO_STATUS_ALLOCATION_FAILED;
+  } /* end if */
+  
+  fptr = fopen(path, "wb");
+  
+  if (fptr == NULL) {
+    m2c_astflat_release(flat);
+    return M2C_FILEIO_STATUS_FOPEN_FAILED;
+  } /* end if */
+  
+  M2C_TRACE_WRITE_START("ast-image", path);
+  
+  status = M2C_FILEIO_STATUS_SUCCESS;
+  
+  if (NOT(ast_write_image(flat, fptr))) {
+    status = M2C_FILEIO_STATUS_WRITE_FAILED;
+  } /* end if */
+  
+  size = ftell(fptr);
+  
+  if (fclose(fptr) != 0) {
+    status = M2C_FILEIO_STATUS_WRITE_FAILED;
+  } /* end if */
+  
+  if ((status == M2C_FILEIO_STATUS_SUCCESS) && (size > 0)) {
+    WRITE_OUTPARAM(bytes_written, (uint_t) size);
   } /* end if */
   
-  /* write closing delimiter */
-  write_count = fprintf(astfile->fptr, ")");
+  m2c_astflat_release(flat);
+  
+  M2C_TRACE_WRITE_END("ast-image", path, status);
+  
+  return status;
+} /* end m2c_ast_write_binary */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_write_image(flat, fptr)
+ * --------------------------------------------------------------------------
+ * Writes a binary AST image of the given flat AST at the current position
+ * of the open output file fptr.  Returns true on success, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_ast_write_image (m2c_astflat_t flat, FILE *fptr) {
+  
+  if ((flat == NULL) || (fptr == NULL)) {
+    return false;
+  } /* end if */
   
-  if (write_count >= 0) {
-    ADD_TO(astfile->chars_written, write_count);
+  return ast_write_image(flat, fptr);
+} /* end m2c_ast_write_image */
+
+
+/* *********************************************************************** *
+ * Private Functions                                                       *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private function ast_write_enter(visit, context)
+ * --------------------------------------------------------------------------
+ * Enter visitor, writes opening delimiter, stem and any leaf values of the
+ * visited node to the writer passed in context.  The items of the split
+ * list are written in parallel and skipped by the traversal.  Returns false
+ * on failure.
+ * ----------------------------------------------------------------------- */
+
+static bool ast_write_enter (m2c_ast_visit_t *visit, void *context) {
+  
+  ast_writer_s *writer = (ast_writer_s *) context;
+  m2c_outsink_t sink = writer->sink;
+  m2c_ast_nodetype_t node_type;
+  
+  node_type = m2c_ast_nodetype(visit->node);
+  
+  /* write opening delimiter and stem */
+  if (writer->nested) {
+    m2c_outsink_write_chars(sink, " (", 2);
   }
   else {
-    astfile->status = M2C_FILEIO_STATUS_WRITE_FAILED;
+    m2c_outsink_write_char(sink, '(');
+    writer->nested = true;
   } /* end if */
   
-  return;
-} /* end ast_write_subtree */
+  m2c_outsink_write_str(sink, m2c_name_for_nodetype(node_type));
+  
+  /* branches are visited by the traversal, leaves are written here */
+  if (NOT(m2c_ast_is_nonterminal_nodetype(node_type))) {
+    ast_write_leaves(sink, visit->node, node_type);
+  }
+  else if (visit->node == writer->split) {
+    visit->skip = true;
+    
+    if (NOT(m2c_ast_parallel_write(sink,
+        visit->node, ast_write_part, NULL))) {
+      return false;
+    } /* end if */
+  } /* end if */
+  
+  return (m2c_outsink_status(sink) == M2C_FILEIO_STATUS_SUCCESS);
+} /* end ast_write_enter */
 
 
 /* --------------------------------------------------------------------------
- * private function ast_write_branches(astfile, node)
+ * private function ast_write_leave(visit, context)
  * --------------------------------------------------------------------------
- * Writes branch nodes of node to astfile.  Records chars_written, status.
+ * Leave visitor, writes the closing delimiter of the visited node to the
+ * writer passed in context.  Returns false on failure.
  * ----------------------------------------------------------------------- */
 
-static void ast_write_branches (m2c_astfile_t astfile, m2c_astnode_t node) {
+static bool ast_write_leave (m2c_ast_visit_t *visit, void *context) {
   
-  m2c_astnode_t branch_node;
-  uint_t index, branch_count;
+  ast_writer_s *writer = (ast_writer_s *) context;
   
-  branch_count = m2c_ast_subnode_count(node);
+  (void) visit;
   
-  for (index = 0; index < branch_count; index++) {
-    branch_node = m2c_ast_subnode_for_index(node, index);
-    ast_write_subtree(astfile, branch_node);
-    
-    /* exit loop on write failure */
-    if (astfile->status != M2C_FILEIO_STATUS_SUCCESS)
-      break;
+  m2c_outsink_write_char(writer->sink, ')');
+  
+  return (m2c_outsink_status(writer->sink) == M2C_FILEIO_STATUS_SUCCESS);
+} /* end ast_write_leave */
+
+
+/* --------------------------------------------------------------------------
+ * private function ast_write_part(sink, list, first, count, context)
+ * --------------------------------------------------------------------------
+ * Part writer, writes count items of list starting at index first to sink.
+ * The items are subnodes, their outermost nodes are therefore nested.
+ * Returns false on failure.
+ * ----------------------------------------------------------------------- */
+
+static bool ast_write_part
+  (m2c_outsink_t sink, m2c_astnode_t list, uint_t first, uint_t count,
+   void *context) {
+  
+  ast_writer_s writer;
+  uint_t index;
+  
+  (void) context;
+  
+  writer.sink = sink;
+  writer.nested = true;
+  writer.split = NULL;
+  
+  for (index = first; index < first + count; index++) {
+    if (NOT(m2c_ast_walk(m2c_ast_subnode_for_index(list, index),
+        ast_write_enter, ast_write_leave, &writer))) {
+      return false;
     } /* end if */
   } /* end for */
   
-  return;
-} /* end ast_write_branches */
+  return true;
+} /* end ast_write_part */
 
 
 /* --------------------------------------------------------------------------
- * private function ast_write_leaves(astfile, node, node_type)
+ * private function ast_write_leaves(sink, node, node_type)
  * --------------------------------------------------------------------------
- * Writes leaf values of node to astfile.  Records chars_written, status.
+ * Writes leaf values of node to sink.
  * ----------------------------------------------------------------------- */
 
 static void ast_write_leaves
-  (m2c_astfile_t astfile, m2c_astnode_t node, m2c_astnode_type_t node_type) {
+  (m2c_outsink_t sink, m2c_astnode_t node, m2c_ast_nodetype_t node_type) {
   
   uint_t value_count;
   
   value_count = m2c_ast_subnode_count(node);
   
   if (value_count == 1) {
-    ast_write_single_value(astfile, node, node_type);
+    ast_write_single_value(sink, node, node_type);
   }
   else /* multi-leaf node */ {
-    ast_write_value_list(astfile, node, node_type);
+    ast_write_value_list(sink, node, node_type);
   } /* end if */
     
   return;
@@ -264,87 +516,67 @@ static void ast_write_leaves
 
 
 /* --------------------------------------------------------------------------
- * private function ast_write_single_value(astfile, node, node_type)
+ * private function ast_write_single_value(sink, node, node_type)
  * --------------------------------------------------------------------------
- * Writes sole leaf value of node to astfile.  Records chars_written, status.
+ * Writes sole leaf value of node to sink.
  * ----------------------------------------------------------------------- */
 
 static void ast_write_single_value
-  (m2c_astfile_t astfile, m2c_astnode_t node, m2c_astnode_type_t node_type) {
+  (m2c_outsink_t sink, m2c_astnode_t node, m2c_ast_nodetype_t node_type) {
   
   m2c_string_t value;
-  int write_count;
-    
-  switch (node_type) {
-    case AST_IDENT :
-      value = m2c_ast_value_for_index(node, 0);
-      write_count = ast_write_unformatted_value(astfile->fptr, value);
+  
+  value = m2c_ast_value_for_index(node, 0);
+  
+  switch (m2c_ast_print_class_for_nodetype(node_type)) {
+    case M2C_AST_PRINT_UNQUOTED :
+      ast_write_unformatted_value(sink, value);
       break;
       
-    case AST_INTVAL :
-      value = m2c_ast_value_for_index(node, 0);
-      write_count = ast_write_int_value(astfile->fptr, value);
+    case M2C_AST_PRINT_INTEGER :
+      ast_write_int_value(sink, value);
       break;
-
-    case AST_REALVAL :
-      value = m2c_ast_value_for_index(node, 0);
-      write_count = ast_write_unformatted_value(astfile->fptr, value);
+  
+    case M2C_AST_PRINT_CHAR :
+      ast_write_chr_value(sink, value);
       break;
-
-    case AST_CHRVAL :
-      value = m2c_ast_value_for_index(node, 0);
-      write_count = ast_write_chr_value(astfile->fptr, value);
+  
+    case M2C_AST_PRINT_QUOTED :
+      ast_write_quoted_value(sink, value);
       break;
-
-    case AST_QUOTEDVAL :
-    case AST_FILENAME :
-      value = m2c_ast_value_for_index(node, 0);
-      write_count = ast_write_quoted_value(astfile->fptr, value);
+      
+    default :
       break;
   } /* end switch */
   
-  if (write_count >= 0) {
-    ADD_TO(astfile->chars_written, write_count);
-  }
-  else {
-    astfile->status = M2C_FILEIO_STATUS_WRITE_FAILED;
-  } /* end if */
-  
   return;
 } /* end ast_write_single_value */
 
 
 /* --------------------------------------------------------------------------
- * private function ast_write_value_list(astfile, node, node_type)
+ * private function ast_write_value_list(sink, node, node_type)
  * --------------------------------------------------------------------------
- * Writes all leaf values of node to astfile.  Records chars_written, status.
+ * Writes all leaf values of node to sink.
  * ----------------------------------------------------------------------- */
  
 static void ast_write_value_list
-  (m2c_astfile_t astfile, m2c_astnode_t node, m2c_astnode_type_t node_type) {
+  (m2c_outsink_t sink, m2c_astnode_t node, m2c_ast_nodetype_t node_type) {
   
   m2c_string_t value;
-  int write_count;
   uint_t index, value_count;
+  m2c_ast_print_class_t print_class;
   
   value_count = m2c_ast_subnode_count(node);
+  print_class = m2c_ast_print_class_for_nodetype(node_type);
   
   for (index = 0; index < value_count; index++) {
     value = m2c_ast_value_for_index(node, index);
     
-    if ((node_type == AST_QUALIDENT) || (node_type == AST_IDENTLIST)) {
-        write_count = ast_write_unformatted_value(astfile->fptr, value);
+    if (print_class == M2C_AST_PRINT_UNQUOTED) {
+      ast_write_unformatted_value(sink, value);
     }
-    else if (node_type == AST_OPTIONS) {
-        write_count = ast_write_quoted_value(astfile->fptr, value);
-    } /* end switch */
-      
-    if (write_count >= 0) {
-      ADD_TO(astfile->chars_written, write_count);
-    }
-    else {
-      astfile->status = M2C_FILEIO_STATUS_WRITE_FAILED;
-      break;
+    else if (print_class == M2C_AST_PRINT_QUOTED) {
+      ast_write_quoted_value(sink, value);
     } /* end if */
   } /* end for */
   
@@ -353,28 +585,28 @@ static void ast_write_value_list
 
 
 /* --------------------------------------------------------------------------
- * private function ast_write_unformatted_value(fptr, lexeme)
+ * private function ast_write_unformatted_value(sink, lexeme)
  * --------------------------------------------------------------------------
- * Writes an unformatted leaf value to astfile.  Returns write count.
+ * Writes an unformatted leaf value to sink.
  * ----------------------------------------------------------------------- */
 
-static int ast_write_unformatted_value (FILE *fptr, m2c_string_t lexeme) {
+static void ast_write_unformatted_value
+  (m2c_outsink_t sink, m2c_string_t lexeme) {
   
-  const char *lexstr;
-  
-  lexstr = m2c_string_char_ptr(lexeme);
+  m2c_outsink_write_char(sink, ' ');
+  m2c_outsink_write_chars(sink,
+    m2c_string_char_ptr(lexeme), m2c_string_length(lexeme));
   
-  return = fprintf(fptr, " %s", lexstr);
 } /* end ast_write_unformatted_value */
 
 
 /* --------------------------------------------------------------------------
- * private function ast_write_int_value(fptr, lexeme)
+ * private function ast_write_int_value(sink, lexeme)
  * --------------------------------------------------------------------------
- * Writes the value of an INTVAL leaf node to astfile.  Returns write count.
+ * Writes the value of an INTVAL leaf node to sink.
  * ----------------------------------------------------------------------- */
 
-static int ast_write_int_value (FILE *fptr, m2c_string_t lexeme) {
+static void ast_write_int_value (m2c_outsink_t sink, m2c_string_t lexeme) {
   
   uint_t length;
   const char *lexstr;
@@ -383,24 +615,27 @@ static int ast_write_int_value (FILE *fptr, m2c_string_t lexeme) {
   lexstr = m2c_string_char_ptr(lexeme);
   
   if (lexstr[1] == 'x') {
-    return fprintf(fptr, " #%s", lexstr);
+    m2c_outsink_write_chars(sink, " #", 2);
   }
   else if ((lexstr[length-1] == 'H') || (lexstr[length-1] == 'B')) {
-    return fprintf(fptr, " ?%s", lexstr);
+    m2c_outsink_write_chars(sink, " ?", 2);
   }
   else {
-    return fprintf(fptr, " %s", lexstr);
+    m2c_outsink_write_char(sink, ' ');
   } /* end if */
+  
+  m2c_outsink_write_chars(sink, lexstr, length);
+  
 } /* end ast_write_int_value */
 
 
 /* --------------------------------------------------------------------------
- * private function ast_write_chr_value(fptr, lexeme)
+ * private function ast_write_chr_value(sink, lexeme)
  * --------------------------------------------------------------------------
- * Writes the value of a CHRVAL leaf node to astfile.  Returns write count.
+ * Writes the value of a CHRVAL leaf node to sink.
  * ----------------------------------------------------------------------- */
 
-static int ast_write_chr_value (FILE *fptr, m2c_string_t lexeme) {
+static void ast_write_chr_value (m2c_outsink_t sink, m2c_string_t lexeme) {
   
   uint_t length;
   const char *lexstr;
@@ -409,36 +644,146 @@ static int ast_write_chr_value (FILE *fptr, m2c_string_t lexeme) {
   lexstr = m2c_string_char_ptr(lexeme);
   
   if (lexstr[1] == 'u') {
-    return fprintf(fptr, " #%s", lexstr);
+    m2c_outsink_write_chars(sink, " #", 2);
   }
   else if (lexstr[length-1] == 'C') {
-    return fprintf(fptr, " ?%s", lexstr);
+    m2c_outsink_write_chars(sink, " ?", 2);
   }
   else {
-    return fprintf(fptr, " %s", lexstr);
+    m2c_outsink_write_char(sink, ' ');
   } /* end if */
+  
+  m2c_outsink_write_chars(sink, lexstr, length);
+  
 } /* end ast_write_chr_value */
 
 
 /* --------------------------------------------------------------------------
- * private function ast_write_quoted_value(fptr, lexeme)
+ * private function ast_write_quoted_value(sink, lexeme)
  * --------------------------------------------------------------------------
- * Writes the value of a QUOTEDVAL leaf node to astfile. Returns write count.
+ * Writes the value of a QUOTEDVAL leaf node to sink.
  * ----------------------------------------------------------------------- */
 
-static int ast_write_quoted_value (FILE *fptr, m2c_string_t lexeme) {
+static void ast_write_quoted_value (m2c_outsink_t sink, m2c_string_t lexeme) {
   
-  const char *lexstr;
+  cstr_view_t lexstr;
+  char delimiter;
   
-  lexstr = m2c_string_char_ptr(lexeme);
+  /* interned strings know their length, no need to scan for it */
+  lexstr = cstr_view_w_len
+    (m2c_string_char_ptr(lexeme), m2c_string_length(lexeme));
   
-  if (cstr_contains_char(lexstr, '"')) {
-    return fprintf(fptr, " '%s'", lexstr);
+  if (cstr_view_contains_char(lexstr, '"')) {
+    delimiter = '\'';
   }
   else {
-    return fprintf(fptr, " \"%s\"", lexstr);
+    delimiter = '"';
   } /* end if */
+  
+  m2c_outsink_write_char(sink, ' ');
+  m2c_outsink_write_char(sink, delimiter);
+  m2c_outsink_write_chars(sink, lexstr.ptr, lexstr.len);
+  m2c_outsink_write_char(sink, delimiter);
+  
 } /* end ast_write_quoted_value */
 
 
+/* --------------------------------------------------------------------------
+ * private function ast_write_image(flat, fptr)
+ * --------------------------------------------------------------------------
+ * Writes header and arrays of a binary AST image of flat to fptr.  Returns
+ * true on success.
+ * ----------------------------------------------------------------------- */
+
+#define WRITE_ENTRY(_entry,_fptr) \
+  (fwrite(&(_entry), sizeof(_entry), 1, (_fptr)) == 1)
+
+static bool ast_write_image (m2c_astflat_t flat, FILE *fptr) {
+  
+  m2c_astimage_header_t header;
+  uint32_t node, id, index, count, entry;
+  uint32_t node_count, string_count;
+  m2c_string_t value;
+  uint16_t node_type;
+  size_t length;
+  
+  node_count = m2c_astflat_node_count(flat);
+  string_count = m2c_astflat_string_count(flat);
+  
+  /* string bytes include NUL terminators */
+  entry = 0;
+  for (id = 0; id < string_count; id++) {
+    entry = entry + m2c_string_length(m2c_astflat_string_for_id(flat, id)) + 1;
+  } /* end for */
+  
+  memcpy(header.magic, M2C_ASTIMAGE_MAGIC, 4);
+  header.version = M2C_ASTIMAGE_VERSION;
+  header.byte_order = M2C_ASTIMAGE_BYTE_ORDER;
+  header.node_count = node_count;
+  header.link_count = m2c_astflat_link_count(flat);
+  header.string_count = string_count;
+  header.string_bytes = entry;
+  
+  if (NOT(WRITE_ENTRY(header, fptr))) {
+    return false;
+  } /* end if */
+  
+  /* link offsets */
+  entry = 0;
+  for (node = 0; node <= node_count; node++) {
+    if (NOT(WRITE_ENTRY(entry, fptr))) {
+      return false;
+    } /* end if */
+    entry = entry + m2c_astflat_subnode_count(flat, node);
+  } /* end for */
+  
+  /* links, subnode indices and string IDs are the same in the image */
+  for (node = 0; node < node_count; node++) {
+    count = m2c_astflat_subnode_count(flat, node);
+    for (index = 0; index < count; index++) {
+      if (m2c_ast_is_nonterminal_nodetype(m2c_astflat_nodetype(flat, node))) {
+        entry = m2c_astflat_subnode_for_index(flat, node, index);
+      }
+      else {
+        entry = m2c_astflat_value_id_for_index(flat, node, index);
+      } /* end if */
+      if (NOT(WRITE_ENTRY(entry, fptr))) {
+        return false;
+      } /* end if */
+    } /* end for */
+  } /* end for */
+  
+  /* string offsets */
+  entry = 0;
+  for (id = 0; id <= string_count; id++) {
+    if (NOT(WRITE_ENTRY(entry, fptr))) {
+      return false;
+    } /* end if */
+    if (id < string_count) {
+      value = m2c_astflat_string_for_id(flat, id);
+      entry = entry + m2c_string_length(value) + 1;
+    } /* end if */
+  } /* end for */
+  
+  /* node types */
+  for (node = 0; node < node_count; node++) {
+    node_type = (uint16_t) m2c_astflat_nodetype(flat, node);
+    if (NOT(WRITE_ENTRY(node_type, fptr))) {
+      return false;
+    } /* end if */
+  } /* end for */
+  
+  /* strings including their NUL terminators */
+  for (id = 0; id < string_count; id++) {
+    value = m2c_astflat_string_for_id(flat, id);
+    length = m2c_string_length(value) + 1;
+    if (fwrite(m2c_string_char_ptr(value), 1, length, fptr) != length) {
+      return false;
+    } /* end if */
+  } /* end for */
+  
+  return true;
+} /* end ast_write_image */
+
+
 /* END OF FILE */
\ No newline at end of file
@@ -39,6 +39,9 @@
 #include "m2-common.h"
 #include "m2-fileio-status.h"
 #include "m2-ast.h"
+#include "m2-ast-flat.h"
+
+#include <stdio.h>
 
 
 /* --------------------------------------------------------------------------
@@ -53,6 +56,99 @@ m2c_fileio_status_t m2c_ast_write
   (const char *path, m2c_astnode_t ast, uint_t *chars_written);
 
 
+/* --------------------------------------------------------------------------
+ * opaque type m2c_ast_stream_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing an S-expression AST output stream.  A
+ * stream writes a tree incrementally, from the opening and closing of its
+ * outer nodes and from subtrees that are passed in as they are completed.
+ * The output is identical to that of m2c_ast_write() for the same tree.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_ast_stream_struct_t *m2c_ast_stream_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_stream_new(path, status)
+ * --------------------------------------------------------------------------
+ * Creates or truncates the output file at the given path and returns a new
+ * AST output stream that writes to it, or NULL on failure.  Passes a status
+ * code back in status, unless NULL.
+ * ----------------------------------------------------------------------- */
+
+m2c_ast_stream_t m2c_ast_stream_new
+  (const char *path, m2c_fileio_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_ast_stream_open_node(stream, node_type)
+ * --------------------------------------------------------------------------
+ * Writes the opening delimiter and stem of a node of node_type to stream.
+ * Its subnodes are written by subsequent calls, the node is then closed
+ * by a matching call to m2c_ast_stream_close_node().
+ * ----------------------------------------------------------------------- */
+
+void m2c_ast_stream_open_node
+  (m2c_ast_stream_t stream, m2c_ast_nodetype_t node_type);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_ast_stream_write_node(stream, node)
+ * --------------------------------------------------------------------------
+ * Writes the complete subtree of node to stream, as the next subnode of the
+ * innermost open node.  The subtree may be released when this returns.
+ * ----------------------------------------------------------------------- */
+
+void m2c_ast_stream_write_node (m2c_ast_stream_t stream, m2c_astnode_t node);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_ast_stream_close_node(stream)
+ * --------------------------------------------------------------------------
+ * Writes the closing delimiter of the innermost open node to stream.
+ * ----------------------------------------------------------------------- */
+
+void m2c_ast_stream_close_node (m2c_ast_stream_t stream);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_stream_release(streamptr, chars_written)
+ * --------------------------------------------------------------------------
+ * Terminates the output of the stream passed in streamptr, closes its file,
+ * deallocates the stream and returns a status code.  Passes the number of
+ * characters written back in out-parameter chars_written and NULL back in
+ * streamptr.
+ * ----------------------------------------------------------------------- */
+
+m2c_fileio_status_t m2c_ast_stream_release
+  (m2c_ast_stream_t *streamptr, uint_t *chars_written);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_write_binary(path, ast, bytes_written)
+ * --------------------------------------------------------------------------
+ * Writes the given abstract syntax tree as a binary AST image to the given
+ * output file at the given path and returns a status code.  Passes the
+ * number of bytes written back in out-parameter bytes_written.  The image
+ * format is described in m2-astimage.h, images are loaded with function
+ * m2c_astimage_load().
+ * ----------------------------------------------------------------------- */
+
+m2c_fileio_status_t m2c_ast_write_binary
+  (const char *path, m2c_astnode_t ast, uint_t *bytes_written);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_write_image(flat, fptr)
+ * --------------------------------------------------------------------------
+ * Writes a binary AST image of the given flat AST at the current position
+ * of the open output file fptr.  Returns true on success, otherwise false.
+ * Used to embed images in other files, such as symbol files.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_ast_write_image (m2c_astflat_t flat, FILE *fptr);
+
+
 #endif /* M2C_ASTWRITER_H */
 
 /* END OF FILE */
\ No newline at end of file
@@ -0,0 +1,5539 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015-2016 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * m2-c99writer.c
+ *
+ * Implementation of M2C C99 code generation.
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute and/or modify it under the
+ * terms of the GNU Lesser General Public License (LGPL) either version 2.1
+ * or at your choice version 3 as published by the Free Software Foundation.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+
+#include "m2-c99writer.h"
+#include "m2-astimage.h"
+#include "m2-outsink.h"
+#include "m2-unique-string.h"
+#include "m2-fifo.h"
+#include "m2t-constfold.h"
+#include "m2t-labelset.h"
+#include "fileutils.h"
+#include "m2-trace-probes.h"
+
+#include <limits.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* --------------------------------------------------------------------------
+ * Initial capacity of the symbol table, must be a power of two
+ * ----------------------------------------------------------------------- */
+
+#define C99_INITIAL_SYMBOL_CAPACITY 256
+
+
+/* --------------------------------------------------------------------------
+ * Maximum nesting of procedures and WITH statements
+ * ----------------------------------------------------------------------- */
+
+#define C99_MAX_SCOPE_DEPTH 32
+
+#define C99_MAX_WITH_DEPTH 16
+
+
+/* --------------------------------------------------------------------------
+ * Size of the chunks of the name pool
+ * ----------------------------------------------------------------------- */
+
+#define C99_NAME_CHUNK_SIZE 4096
+
+
+/* --------------------------------------------------------------------------
+ * Maximum length of a chain of type identifiers that is followed
+ * ----------------------------------------------------------------------- */
+
+#define C99_MAX_TYPE_CHAIN 32
+
+
+/* --------------------------------------------------------------------------
+ * Parameter modes
+ * --------------------------------------------------------------------------
+ * The formal parameters of a procedure are summarised as a string with one
+ * mode character per parameter.  A VAR parameter is passed by address, an
+ * open array parameter with its hidden HIGH value.
+ * ----------------------------------------------------------------------- */
+
+#define C99_MODE_VALUE 'v'
+
+#define C99_MODE_VAR 'r'
+
+#define C99_MODE_OPEN 'o'
+
+
+/* --------------------------------------------------------------------------
+ * hidden type c99_symkind_t
+ * --------------------------------------------------------------------------
+ * Enumerated type representing the kinds of symbols of the C99 writer.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  C99_SYM_MODULE,     /* imported module, accessed by qualification */
+  C99_SYM_SYSTEM,     /* pseudo-module SYSTEM */
+  C99_SYM_CONST,      /* constant or enumerated value */
+  C99_SYM_TYPE,       /* type */
+  C99_SYM_VAR,        /* variable or value parameter */
+  C99_SYM_PROC,       /* procedure */
+  C99_SYM_VAR_PARAM,  /* VAR parameter, accessed through a pointer */
+  C99_SYM_OPEN_PARAM, /* open array parameter with a hidden HIGH value */
+  C99_SYM_BUILTIN,    /* pervasive procedure or function */
+  C99_SYM_OTHER       /* declared elsewhere, kind unknown */
+} c99_symkind_t;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type c99_builtin_t
+ * --------------------------------------------------------------------------
+ * Enumerated type representing pervasive procedures and functions.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  C99_NO_BUILTIN,
+  C99_ABS,
+  C99_ADR,
+  C99_CAP,
+  C99_CHR,
+  C99_DEC,
+  C99_DISPOSE,
+  C99_EXCL,
+  C99_FLOAT,
+  C99_HALT,
+  C99_HIGH,
+  C99_INC,
+  C99_INCL,
+  C99_MAX,
+  C99_MIN,
+  C99_NEW,
+  C99_ODD,
+  C99_ORD,
+  C99_SIZE,
+  C99_TRUNC,
+  C99_VAL
+} c99_builtin_t;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type c99_pervasive_s
+ * --------------------------------------------------------------------------
+ * record type representing a pervasive identifier and its translation.
+ * Field ctext holds the C text of a type or constant, fields min and max
+ * hold the C text of the bounds of an ordinal type and field size holds
+ * the number of values of a type that may be used as an index type.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* ident */ const char *ident;
+  /* kind */ c99_symkind_t kind;
+  /* builtin */ c99_builtin_t builtin;
+  /* ctext */ const char *ctext;
+  /* min */ const char *min;
+  /* max */ const char *max;
+  /* size */ const char *size;
+} c99_pervasive_s;
+
+
+/* --------------------------------------------------------------------------
+ * Pervasive identifiers
+ * ----------------------------------------------------------------------- */
+
+static const c99_pervasive_s pervasive_ident[] = {
+  { "ABS", C99_SYM_BUILTIN, C99_ABS, NULL, NULL, NULL, NULL },
+  { "BITSET", C99_SYM_TYPE, C99_NO_BUILTIN, "unsigned",
+    NULL, NULL, NULL },
+  { "BOOLEAN", C99_SYM_TYPE, C99_NO_BUILTIN, "bool",
+    "false", "true", "2" },
+  { "CAP", C99_SYM_BUILTIN, C99_CAP, NULL, NULL, NULL, NULL },
+  { "CARDINAL", C99_SYM_TYPE, C99_NO_BUILTIN, "unsigned",
+    "0u", "UINT_MAX", NULL },
+  { "CHAR", C99_SYM_TYPE, C99_NO_BUILTIN, "char",
+    "((char) 0)", "((char) 255)", "256" },
+  { "CHR", C99_SYM_BUILTIN, C99_CHR, NULL, NULL, NULL, NULL },
+  { "DEC", C99_SYM_BUILTIN, C99_DEC, NULL, NULL, NULL, NULL },
+  { "DISPOSE", C99_SYM_BUILTIN, C99_DISPOSE, NULL, NULL, NULL, NULL },
+  { "EXCL", C99_SYM_BUILTIN, C99_EXCL, NULL, NULL, NULL, NULL },
+  { "FALSE", C99_SYM_CONST, C99_NO_BUILTIN, "false", NULL, NULL, NULL },
+  { "FLOAT", C99_SYM_BUILTIN, C99_FLOAT, NULL, NULL, NULL, NULL },
+  { "HALT", C99_SYM_BUILTIN, C99_HALT, NULL, NULL, NULL, NULL },
+  { "HIGH", C99_SYM_BUILTIN, C99_HIGH, NULL, NULL, NULL, NULL },
+  { "INC", C99_SYM_BUILTIN, C99_INC, NULL, NULL, NULL, NULL },
+  { "INCL", C99_SYM_BUILTIN, C99_INCL, NULL, NULL, NULL, NULL },
+  { "INTEGER", C99_SYM_TYPE, C99_NO_BUILTIN, "int",
+    "INT_MIN", "INT_MAX", NULL },
+  { "LONGINT", C99_SYM_TYPE, C99_NO_BUILTIN, "long",
+    "LONG_MIN", "LONG_MAX", NULL },
+  { "LONGREAL", C99_SYM_TYPE, C99_NO_BUILTIN, "double",
+    "(-DBL_MAX)", "DBL_MAX", NULL },
+  { "MAX", C99_SYM_BUILTIN, C99_MAX, NULL, NULL, NULL, NULL },
+  { "MIN", C99_SYM_BUILTIN, C99_MIN, NULL, NULL, NULL, NULL },
+  { "NEW", C99_SYM_BUILTIN, C99_NEW, NULL, NULL, NULL, NULL },
+  { "NIL", C99_SYM_CONST, C99_NO_BUILTIN, "NULL", NULL, NULL, NULL },
+  { "ODD", C99_SYM_BUILTIN, C99_ODD, NULL, NULL, NULL, NULL },
+  { "ORD", C99_SYM_BUILTIN, C99_ORD, NULL, NULL, NULL, NULL },
+  { "PROC", C99_SYM_TYPE, C99_NO_BUILTIN, "M2__PROC", NULL, NULL, NULL },
+  { "REAL", C99_SYM_TYPE, C99_NO_BUILTIN, "float",
+    "(-FLT_MAX)", "FLT_MAX", NULL },
+  { "SIZE", C99_SYM_BUILTIN, C99_SIZE, NULL, NULL, NULL, NULL },
+  { "TRUE", C99_SYM_CONST, C99_NO_BUILTIN, "true", NULL, NULL, NULL },
+  { "TRUNC", C99_SYM_BUILTIN, C99_TRUNC, NULL, NULL, NULL, NULL },
+  { "VAL", C99_SYM_BUILTIN, C99_VAL, NULL, NULL, NULL, NULL },
+  { NULL, C99_SYM_OTHER, C99_NO_BUILTIN, NULL, NULL, NULL, NULL }
+};
+
+
+/* --------------------------------------------------------------------------
+ * Identifiers exported by pseudo-module SYSTEM
+ * ----------------------------------------------------------------------- */
+
+static const c99_pervasive_s system_ident[] = {
+  { "ADDRESS", C99_SYM_TYPE, C99_NO_BUILTIN, "void *", NULL, NULL, NULL },
+  { "ADR", C99_SYM_BUILTIN, C99_ADR, NULL, NULL, NULL, NULL },
+  { "BYTE", C99_SYM_TYPE, C99_NO_BUILTIN, "unsigned char",
+    "0", "UCHAR_MAX", "256" },
+  { "TSIZE", C99_SYM_BUILTIN, C99_SIZE, NULL, NULL, NULL, NULL },
+  { "WORD", C99_SYM_TYPE, C99_NO_BUILTIN, "unsigned", NULL, NULL, NULL },
+  { NULL, C99_SYM_OTHER, C99_NO_BUILTIN, NULL, NULL, NULL, NULL }
+};
+
+
+/* --------------------------------------------------------------------------
+ * Identifiers that may not be used as C names of local entities
+ * --------------------------------------------------------------------------
+ * C keywords, macros of the standard headers included by the prelude and
+ * library functions the prelude macros expand to.  Sorted, for bsearch().
+ * ----------------------------------------------------------------------- */
+
+static const char *const reserved_word[] = {
+  "DBL_MAX", "EOF", "EXIT_FAILURE", "EXIT_SUCCESS", "FLT_MAX", "INT_MAX",
+  "INT_MIN", "LONG_MAX", "LONG_MIN", "NULL", "UCHAR_MAX", "UINT_MAX",
+  "abort", "assert", "auto", "bool", "break", "case", "char", "const",
+  "continue", "default", "do", "double", "else", "enum", "errno", "exit",
+  "extern", "false", "float", "for", "free", "goto", "if", "inline", "int",
+  "long", "main", "malloc", "memcpy", "register", "restrict", "return",
+  "short", "signed", "sizeof", "static", "strncpy", "struct", "switch",
+  "true", "typedef", "union", "unsigned", "void", "volatile", "while"
+};
+
+#define RESERVED_WORD_COUNT (sizeof(reserved_word) / sizeof(char *))
+
+
+/* --------------------------------------------------------------------------
+ * Prelude of every translation
+ * --------------------------------------------------------------------------
+ * Runtime support shared by all translated modules.  Named M2__ and m2__
+ * since a Modula-2 identifier never contains two consecutive lowlines.
+ * Functions m2__div and m2__mod round the quotient towards negative
+ * infinity as DIV and MOD require, where C division truncates.
+ * ----------------------------------------------------------------------- */
+
+static const char prelude[] =
+  "#ifndef M2__PRELUDE\n"
+  "#define M2__PRELUDE\n"
+  "\n"
+  "#include <float.h>\n"
+  "#include <limits.h>\n"
+  "#include <stdbool.h>\n"
+  "#include <stddef.h>\n"
+  "#include <stdlib.h>\n"
+  "#include <string.h>\n"
+  "\n"
+  "typedef void (*M2__PROC) (void);\n"
+  "\n"
+  "#define M2__BIT(x) (1u << (x))\n"
+  "#define M2__RANGE(lo, hi) ((~0u >> (31 - (hi))) & (~0u << (lo)))\n"
+  "#define M2__IN(x, s) ((((s) >> (x)) & 1u) != 0)\n"
+  "#define M2__HIGH(a) (sizeof (a) / sizeof (a)[0] - 1)\n"
+  "#define M2__ABS(x) ((x) < 0 ? -(x) : (x))\n"
+  "#define M2__CAP(c) \\\n"
+  "  ((c) >= 'a' && (c) <= 'z' ? (char) ((c) - 'a' + 'A') : (c))\n"
+  "#define M2__ODD(x) (((x) & 1) != 0)\n"
+  "#define M2__NEW(p) ((p) = malloc(sizeof *(p)))\n"
+  "#define M2__DISPOSE(p) (free(p), (p) = NULL)\n"
+  "#define M2__STRCPY(d, s) ((void) strncpy((d), (s), sizeof (d)))\n"
+  "#define M2__COPY(d, s) ((void) memcpy(&(d), &(s), sizeof (d)))\n"
+  "#define M2__CASE_FAIL() abort()\n"
+  "\n"
+  "static inline long long m2__div (long long a, long long b) {\n"
+  "  return a / b - ((a % b != 0) && ((a < 0) != (b < 0)));\n"
+  "}\n"
+  "\n"
+  "static inline long long m2__mod (long long a, long long b) {\n"
+  "  return a % b + (((a % b != 0) && ((a < 0) != (b < 0))) ? b : 0);\n"
+  "}\n"
+  "\n"
+  "#endif /* M2__PRELUDE */\n"
+  "\n";
+
+
+/* --------------------------------------------------------------------------
+ * Scope keys of pervasive identifiers and of identifiers of SYSTEM
+ * --------------------------------------------------------------------------
+ * Symbols are keyed by scope and identifier.  The scope of a module is its
+ * interned identifier, that of a procedure the C name of the procedure.
+ * ----------------------------------------------------------------------- */
+
+static const char pervasive_scope[] = "pervasive";
+
+static const char system_scope[] = "SYSTEM";
+
+static const char import_scope[] = "import";
+
+
+/* --------------------------------------------------------------------------
+ * hidden type c99_symbol_s
+ * --------------------------------------------------------------------------
+ * record type representing an entry of the symbol table.  Field cname holds
+ * the C name of the symbol, it is mangled once when the symbol is entered.
+ * Field node holds the type of a variable, parameter or type, or the
+ * heading of a procedure.  Field modes holds the parameter modes of a
+ * procedure, NULL if they are unknown.  Field forward is set for a record
+ * type whose struct has already been declared and for an imported module
+ * whose initialisation has already been called.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* scope */ const void *scope;
+  /* ident */ m2c_string_t ident;
+  /* cname */ const char *cname;
+  /* kind */ c99_symkind_t kind;
+  /* forward */ bool forward;
+  /* modes */ const char *modes;
+  /* node */ m2c_astnode_t node;
+  /* info */ const c99_pervasive_s *info;
+  /* symfile */ m2c_symfile_t symfile;
+} c99_symbol_s;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type c99_chunk_s
+ * --------------------------------------------------------------------------
+ * record type representing a chunk of the pool that holds C names.
+ * ----------------------------------------------------------------------- */
+
+typedef struct c99_chunk_s *c99_chunk_t;
+
+struct c99_chunk_s {
+  /* next */ c99_chunk_t next;
+  /* used */ uint_t used;
+  /* size */ uint_t size;
+  /* text */ char text[];
+};
+
+
+/* --------------------------------------------------------------------------
+ * hidden type c99_writer_s
+ * --------------------------------------------------------------------------
+ * record type representing the state of a translation.  The translation is
+ * collected in three memory sinks, head for the prelude and includes, decls
+ * for declarations at file scope and procs for function definitions.  They
+ * are written to the output file one after the other when translation has
+ * completed.  Field out is the sink currently written to.  Field comments
+ * holds the comments of the source, or NULL if comments are not preserved.
+ * Field view holds the view the AST written is presented by, or NULL, the
+ * comments of its copies are found by the base nodes they were copied from.
+ * Fields folder and labels serve the dispatch of CASE statements, folder
+ * binds the constants of the module declaration list held in field consts.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* out */ m2c_outsink_t out;
+  /* head */ m2c_outsink_t head;
+  /* decls */ m2c_outsink_t decls;
+  /* procs */ m2c_outsink_t procs;
+  /* module */ m2c_string_t module;
+  /* defmod */ bool defmod;
+  /* own */ m2c_symfile_t own;
+  /* load_import */ m2c_c99_import_loader_f load_import;
+  /* context */ void *context;
+  /* comments */ m2t_comment_table_t comments;
+  /* view */ m2c_ast_view_t view;
+  /* folder */ m2t_const_folder_t folder;
+  /* labels */ m2t_label_set_t labels;
+  /* consts */ m2c_astnode_t consts;
+  /* loaded */ m2c_fifo_t loaded;
+  /* symbol */ c99_symbol_s *symbol;
+  /* capacity */ uint_t capacity;
+  /* count */ uint_t count;
+  /* chunk */ c99_chunk_t chunk;
+  /* depth */ uint_t depth;
+  /* scope */ const void *scope[C99_MAX_SCOPE_DEPTH];
+  /* prefix */ const char *prefix[C99_MAX_SCOPE_DEPTH];
+  /* with_depth */ uint_t with_depth;
+  /* with */ m2c_astnode_t with[C99_MAX_WITH_DEPTH];
+  /* indent */ uint_t indent;
+  /* label */ uint_t label;
+  /* exit_label */ uint_t exit_label;
+  /* exit_used */ bool exit_used;
+  /* failed */ bool failed;
+} c99_writer_s;
+
+
+/* --------------------------------------------------------------------------
+ * Forward declarations
+ * ----------------------------------------------------------------------- */
+
+static m2c_fileio_status_t write_translation
+  (const char *path, m2c_astnode_t ast, m2c_ast_view_t view,
+   m2t_comment_table_t comments, m2c_c99_import_loader_f load_import,
+   void *context, uint_t *chars_written);
+
+static bool init_writer
+  (c99_writer_s *w, m2c_c99_import_loader_f load_import, void *context);
+
+static void enter_pervasives
+  (c99_writer_s *w, const void *scope, const c99_pervasive_s *table);
+
+static void release_writer (c99_writer_s *w);
+
+static void write_defmod (c99_writer_s *w, m2c_astnode_t defmod);
+
+static void write_impmod (c99_writer_s *w, m2c_astnode_t impmod);
+
+static void begin_module (c99_writer_s *w, m2c_astnode_t id);
+
+static void write_imports (c99_writer_s *w, m2c_astnode_t implist);
+
+static void write_include_break (c99_writer_s *w, m2c_astnode_t implist);
+
+static void write_import_inits (c99_writer_s *w, m2c_astnode_t implist);
+
+static void write_import_init (c99_writer_s *w, m2c_string_t module);
+
+static c99_symbol_s *import_module (c99_writer_s *w, m2c_string_t module);
+
+static m2c_symfile_t load_symfile (c99_writer_s *w, m2c_string_t module);
+
+static bool is_system (m2c_string_t module);
+
+static c99_symbol_s *qualified_symbol
+  (c99_writer_s *w, const c99_symbol_s *modsym, m2c_string_t ident);
+
+static void copy_symbol
+  (c99_writer_s *w, const void *scope, m2c_string_t ident,
+   const c99_symbol_s *symbol);
+
+static void write_opaque_targets (c99_writer_s *w, m2c_astnode_t decllist);
+
+static bool is_own_opaque_type (c99_writer_s *w, m2c_string_t ident);
+
+static bool is_exported (c99_writer_s *w, m2c_string_t ident);
+
+static void predeclare (c99_writer_s *w, m2c_astnode_t list);
+
+static void write_declaration (c99_writer_s *w, m2c_astnode_t decl);
+
+static void write_const (c99_writer_s *w, m2c_astnode_t constdef);
+
+static void write_type_decl (c99_writer_s *w, m2c_astnode_t typedecl);
+
+static void write_bound_macro
+  (c99_writer_s *w, const char *cname, const char *suffix,
+   const char *text, m2c_astnode_t expr);
+
+static void write_alias_bounds
+  (c99_writer_s *w, const char *cname, m2c_astnode_t type);
+
+static void write_var_decl (c99_writer_s *w, m2c_astnode_t vardecl);
+
+static void write_proc (c99_writer_s *w, m2c_astnode_t proc);
+
+static void shadow_locals (c99_writer_s *w, m2c_astnode_t decllist);
+
+static void shadow_enums (c99_writer_s *w, m2c_astnode_t type);
+
+static void write_proc_heading
+  (c99_writer_s *w, m2c_astnode_t procdef, const char *storage, bool enter);
+
+static void enter_param
+  (c99_writer_s *w, m2c_string_t ident, const char *cname, char mode,
+   m2c_astnode_t type);
+
+static char mode_for_formal_type
+  (m2c_ast_nodetype_t ftype, m2c_ast_nodetype_t inner);
+
+static const char *modes_for_procdef (c99_writer_s *w, m2c_astnode_t procdef);
+
+static const char *modes_for_image
+  (c99_writer_s *w, m2c_astimage_t image, uint_t procdef);
+
+static void write_declarator
+  (c99_writer_s *w, m2c_astnode_t type, const char *cname);
+
+static bool write_type_prefix (c99_writer_s *w, m2c_astnode_t type);
+
+static void write_type_suffix (c99_writer_s *w, m2c_astnode_t type);
+
+static void write_index_size (c99_writer_s *w, m2c_astnode_t idxtype);
+
+static void write_enum (c99_writer_s *w, m2c_astnode_t enumtype);
+
+static void write_record_body (c99_writer_s *w, m2c_astnode_t rectype);
+
+static void write_field_list_seq (c99_writer_s *w, m2c_astnode_t flseq);
+
+static void write_field_list (c99_writer_s *w, m2c_astnode_t fieldlist);
+
+static bool is_record_type (m2c_astnode_t type);
+
+static bool is_plain_type (m2c_astnode_t type);
+
+static c99_symbol_s *type_symbol (c99_writer_s *w, m2c_astnode_t type);
+
+static m2c_astnode_t base_type (c99_writer_s *w, m2c_astnode_t type);
+
+static m2c_astnode_t field_type
+  (c99_writer_s *w, m2c_astnode_t rectype, m2c_string_t ident);
+
+static m2c_astnode_t field_type_in_seq
+  (c99_writer_s *w, m2c_astnode_t flseq, m2c_string_t ident);
+
+static m2c_astnode_t type_of_designator
+  (c99_writer_s *w, m2c_astnode_t desig);
+
+static bool is_set_expr (c99_writer_s *w, m2c_astnode_t expr);
+
+static bool is_nonnegative_expr (c99_writer_s *w, m2c_astnode_t expr);
+
+static bool is_array_designator (c99_writer_s *w, m2c_astnode_t expr);
+
+static m2c_astnode_t subnode (m2c_astnode_t node, uint_t index);
+
+static uint_t list_count (m2c_astnode_t list);
+
+static void emit_str (c99_writer_s *w, const char *str);
+
+static void emit_char (c99_writer_s *w, char ch);
+
+static void emit_uint (c99_writer_s *w, uint_t value);
+
+static void emit_long (c99_writer_s *w, int64_t value);
+
+static void emit_indent (c99_writer_s *w);
+
+static void emit_line (c99_writer_s *w, const char *str);
+
+static void write_comments (c99_writer_s *w, m2c_astnode_t node);
+
+static char *new_name (c99_writer_s *w, uint_t length);
+
+static int compare_words (const void *key, const void *word);
+
+static const char *local_name (c99_writer_s *w, m2c_string_t ident);
+
+static const char *prefixed_name
+  (c99_writer_s *w, const char *prefix, m2c_string_t ident);
+
+static uint_t symbol_hash (const void *scope, m2c_string_t ident);
+
+static c99_symbol_s *lookup_symbol
+  (c99_writer_s *w, const void *scope, m2c_string_t ident);
+
+static c99_symbol_s *enter_symbol
+  (c99_writer_s *w, const void *scope, m2c_string_t ident,
+   c99_symkind_t kind, const char *cname);
+
+static bool grow_symbol_table (c99_writer_s *w);
+
+static c99_symbol_s *declare_value
+  (c99_writer_s *w, m2c_string_t ident, c99_symkind_t kind, bool hoisted);
+
+static c99_symbol_s *declare_ident
+  (c99_writer_s *w, m2c_astnode_t id, c99_symkind_t kind, bool hoisted);
+
+static c99_symbol_s *resolve_ident (c99_writer_s *w, m2c_string_t ident);
+
+static c99_symbol_s *resolve_qualident
+  (c99_writer_s *w, m2c_astnode_t qualident, uint_t *used);
+
+static const char *cname_for_ident (c99_writer_s *w, m2c_string_t ident);
+
+static void write_statement_seq (c99_writer_s *w, m2c_astnode_t stmtseq);
+
+static void write_statement (c99_writer_s *w, m2c_astnode_t stmt);
+
+static void write_block (c99_writer_s *w, m2c_astnode_t stmtseq);
+
+static void write_assignment
+  (c99_writer_s *w, m2c_astnode_t desig, m2c_astnode_t expr);
+
+static void write_with (c99_writer_s *w, m2c_astnode_t with);
+
+static void write_if (c99_writer_s *w, m2c_astnode_t ifstmt);
+
+static void write_case (c99_writer_s *w, m2c_astnode_t casestmt);
+
+static m2t_label_set_class_t collect_case_labels
+  (c99_writer_s *w, m2c_astnode_t caselist, uint_t mark);
+
+static bool case_label_bounds
+  (c99_writer_s *w, m2c_astnode_t labels, int64_t *lower, int64_t *upper);
+
+static bool case_label_value
+  (c99_writer_s *w, m2c_astnode_t expr, int64_t *value);
+
+static void write_case_chain
+  (c99_writer_s *w, m2c_astnode_t casestmt, uint_t label);
+
+static void write_case_switch
+  (c99_writer_s *w, m2c_astnode_t casestmt, uint_t label);
+
+static void write_case_search
+  (c99_writer_s *w, m2c_astnode_t casestmt, uint_t label, uint_t mark);
+
+static void write_search_tree
+  (c99_writer_s *w, uint_t label, uint_t first, uint_t last);
+
+static void write_case_default (c99_writer_s *w, m2c_astnode_t elseseq);
+
+static void write_case_labels
+  (c99_writer_s *w, m2c_astnode_t cllist, uint_t label);
+
+static void write_loop (c99_writer_s *w, m2c_astnode_t loop);
+
+static void write_for (c99_writer_s *w, m2c_astnode_t forstmt);
+
+static void write_expr (c99_writer_s *w, m2c_astnode_t expr);
+
+static void write_operand (c99_writer_s *w, m2c_astnode_t expr);
+
+static void write_binary (c99_writer_s *w, m2c_astnode_t expr);
+
+static void write_set_value (c99_writer_s *w, m2c_astnode_t elemlist);
+
+static bool with_field (c99_writer_s *w, m2c_string_t ident, uint_t *level);
+
+static void write_ident (c99_writer_s *w, m2c_string_t ident);
+
+static void write_qualident (c99_writer_s *w, m2c_astnode_t qualident);
+
+static void write_name (c99_writer_s *w, m2c_astnode_t name);
+
+static c99_symbol_s *callee_symbol (c99_writer_s *w, m2c_astnode_t desig);
+
+static void write_call
+  (c99_writer_s *w, m2c_astnode_t desig, m2c_astnode_t args);
+
+static void write_arg (c99_writer_s *w, m2c_astnode_t arg, char mode);
+
+static void write_builtin
+  (c99_writer_s *w, c99_builtin_t builtin, m2c_astnode_t args);
+
+static void write_macro_call
+  (c99_writer_s *w, const char *head, m2c_astnode_t arg);
+
+static void write_cast (c99_writer_s *w, const char *ctype, m2c_astnode_t arg);
+
+static void write_int_literal (c99_writer_s *w, m2c_string_t lexeme);
+
+static void write_char_code (c99_writer_s *w, m2c_string_t lexeme);
+
+static void write_string (c99_writer_s *w, m2c_string_t string);
+
+static void write_char_literal (c99_writer_s *w, m2c_string_t string);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_c99_write(path, ast, load_import, context, chars_written)
+ * --------------------------------------------------------------------------
+ * Translates the given abstract syntax tree to C99 and writes the result
+ * to the given output file at the given path like m2c_c99_write_w_comments()
+ * but without comments.
+ * ----------------------------------------------------------------------- */
+
+m2c_fileio_status_t m2c_c99_write
+  (const char *path, m2c_astnode_t ast,
+   m2c_c99_import_loader_f load_import, void *context,
+   uint_t *chars_written) {
+  
+  return m2c_c99_write_w_comments
+    (path, ast, NULL, load_import, context, chars_written);
+  
+} /* end m2c_c99_write */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_c99_write_w_comments(path, ast, comments, load_import, ...)
+ * --------------------------------------------------------------------------
+ * Translates the given abstract syntax tree to C99 and writes the result
+ * to the given output file at the given path.  Returns a status code and
+ * passes the number of characters written back in chars_written.  If
+ * comments is not NULL, the comments attached to the nodes of the module,
+ * its declarations and definitions are written as C comments preceding
+ * their translation.
+ * ----------------------------------------------------------------------- */
+
+m2c_fileio_status_t m2c_c99_write_w_comments
+  (const char *path, m2c_astnode_t ast, m2t_comment_table_t comments,
+   m2c_c99_import_loader_f load_import, void *context,
+   uint_t *chars_written) {
+  
+  m2c_fileio_status_t status;
+  
+  M2C_TRACE_WRITE_START("c99", path);
+  
+  status = write_translation
+    (path, ast, NULL, comments, load_import, context, chars_written);
+  
+  M2C_TRACE_WRITE_END("c99", path, status);
+  
+  return status;
+} /* end m2c_c99_write_w_comments */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_c99_write_view(path, view, comments, load_import, ...)
+ * --------------------------------------------------------------------------
+ * Translates the tree presented by view to C99 like m2c_c99_write_w_comments
+ * and finds the comments of nodes copied by view through their origins.
+ * ----------------------------------------------------------------------- */
+
+m2c_fileio_status_t m2c_c99_write_view
+  (const char *path, m2c_ast_view_t view, m2t_comment_table_t comments,
+   m2c_c99_import_loader_f load_import, void *context,
+   uint_t *chars_written) {
+  
+  m2c_fileio_status_t status;
+  
+  if (view == NULL) {
+    WRITE_OUTPARAM(chars_written, 0);
+    return M2C_FILEIO_STATUS_INVALID_FORMAT;
+  } /* end if */
+  
+  M2C_TRACE_WRITE_START("c99", path);
+  
+  status = write_translation(path, m2c_ast_view_root(view), view,
+    comments, load_import, context, chars_written);
+  
+  M2C_TRACE_WRITE_END("c99", path, status);
+  
+  return status;
+} /* end m2c_c99_write_view */
+
+
+/* *********************************************************************** *
+ * Private Functions                                                       *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private function write_translation(path, ast, view, comments, ...)
+ * --------------------------------------------------------------------------
+ * Translates ast to C99 and writes the result to the file at path for
+ * functions m2c_c99_write_w_comments() and m2c_c99_write_view().  If view
+ * is not NULL, ast is the root of view.
+ * ----------------------------------------------------------------------- */
+
+static m2c_fileio_status_t write_translation
+  (const char *path, m2c_astnode_t ast, m2c_ast_view_t view,
+   m2t_comment_table_t comments, m2c_c99_import_loader_f load_import,
+   void *context, uint_t *chars_written) {
+  
+  m2c_fileio_status_t status;
+  m2c_ast_nodetype_t node_type;
+  m2c_outsink_t sink;
+  c99_writer_s writer;
+  uint_t count;
+  
+  WRITE_OUTPARAM(chars_written, 0);
+  
+  if ((file_exists(path)) && (NOT(is_regular_file(path)))) {
+    return M2C_FILEIO_STATUS_INVALID_FILE;
+  } /* end if */
+  
+  /* skip the root node */
+  if (m2c_ast_nodetype(ast) == AST_ROOT) {
+    ast = subnode(ast, 2);
+  } /* end if */
+  
+  node_type = m2c_ast_nodetype(ast);
+  
+  if ((node_type != AST_DEFMOD) && (node_type != AST_IMPMOD)) {
+    return M2C_FILEIO_STATUS_INVALID_FORMAT;
+  } /* end if */
+  
+  if (NOT(init_writer(&writer, load_import, context))) {
+    release_writer(&writer);
+    return M2C_FILEIO_STATUS_ALLOCATION_FAILED;
+  } /* end if */
+  
+  writer.comments = comments;
+  writer.view = view;
+  
+  /* translate into memory */
+  if (node_type == AST_DEFMOD) {
+    write_defmod(&writer, ast);
+  }
+  else {
+    write_impmod(&writer, ast);
+  } /* end if */
+  
+  status = m2c_outsink_status(writer.head);
+  
+  if (status == M2C_FILEIO_STATUS_SUCCESS) {
+    status = m2c_outsink_status(writer.decls);
+  } /* end if */
+  
+  if (status == M2C_FILEIO_STATUS_SUCCESS) {
+    status = m2c_outsink_status(writer.procs);
+  } /* end if */
+  
+  if ((status == M2C_FILEIO_STATUS_SUCCESS) && (writer.failed)) {
+    status = M2C_FILEIO_STATUS_ALLOCATION_FAILED;
+  } /* end if */
+  
+  if (status != M2C_FILEIO_STATUS_SUCCESS) {
+    release_writer(&writer);
+    return status;
+  } /* end if */
+  
+  /* write the translation to file */
+  sink = m2c_outsink_open(path, &status);
+  
+  if (sink == NULL) {
+    release_writer(&writer);
+    return status;
+  } /* end if */
+  
+  m2c_outsink_write_sink(sink, writer.head);
+  m2c_outsink_write_sink(sink, writer.decls);
+  m2c_outsink_write_sink(sink, writer.procs);
+  
+  count = m2c_outsink_chars_written(sink);
+  status = m2c_outsink_close(&sink);
+  release_writer(&writer);
+  
+  WRITE_OUTPARAM(chars_written, count);
+  
+  return status;
+} /* end write_translation */
+
+
+/* --------------------------------------------------------------------------
+ * private function init_writer(w, load_import, context)
+ * --------------------------------------------------------------------------
+ * Initialises writer w, allocates its sinks and symbol table and enters
+ * the pervasive identifiers and those of SYSTEM.  Returns true on success,
+ * false if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static bool init_writer
+  (c99_writer_s *w, m2c_c99_import_loader_f load_import, void *context) {
+  
+  memset(w, 0, sizeof(c99_writer_s));
+  w->load_import = load_import;
+  w->context = context;
+  
+  w->head = m2c_outsink_open_memory(NULL);
+  w->decls = m2c_outsink_open_memory(NULL);
+  w->procs = m2c_outsink_open_memory(NULL);
+  w->symbol =
+    calloc(C99_INITIAL_SYMBOL_CAPACITY, sizeof(c99_symbol_s));
+  w->folder = m2t_new_const_folder();
+  w->labels = m2t_new_label_set();
+  
+  if ((w->head == NULL) || (w->decls == NULL) ||
+      (w->procs == NULL) || (w->symbol == NULL) ||
+      (w->folder == NULL) || (w->labels == NULL)) {
+    return false;
+  } /* end if */
+  
+  w->capacity = C99_INITIAL_SYMBOL_CAPACITY;
+  w->out = w->decls;
+  
+  enter_pervasives(w, pervasive_scope, pervasive_ident);
+  enter_pervasives(w, system_scope, system_ident);
+  
+  return NOT(w->failed);
+} /* end init_writer */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure enter_pervasives(w, scope, table)
+ * --------------------------------------------------------------------------
+ * Enters the identifiers of table into the given scope of writer w.
+ * ----------------------------------------------------------------------- */
+
+static void enter_pervasives
+  (c99_writer_s *w, const void *scope, const c99_pervasive_s *table) {
+  
+  c99_symbol_s *symbol;
+  m2c_string_t ident;
+  
+  while (table->ident != NULL) {
+    ident = m2c_get_string((char *) table->ident, NULL);
+  
+    if (ident == NULL) {
+      w->failed = true;
+      return;
+    } /* end if */
+  
+    symbol = enter_symbol(w, scope, ident, table->kind, table->ctext);
+  
+    if (symbol != NULL) {
+      symbol->info = table;
+    } /* end if */
+  
+    table++;
+  } /* end while */
+} /* end enter_pervasives */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure release_writer(w)
+ * --------------------------------------------------------------------------
+ * Releases the sinks, symbol table, name pool, symbol files, constant
+ * folder and label set of w.
+ * ----------------------------------------------------------------------- */
+
+static void release_writer (c99_writer_s *w) {
+  m2c_symfile_t symfile;
+  c99_chunk_t next;
+  
+  if (w->head != NULL) {
+    m2c_outsink_close(&w->head);
+  } /* end if */
+  
+  if (w->decls != NULL) {
+    m2c_outsink_close(&w->decls);
+  } /* end if */
+  
+  if (w->procs != NULL) {
+    m2c_outsink_close(&w->procs);
+  } /* end if */
+  
+  if (w->loaded != NULL) {
+    while ((symfile = m2c_fifo_dequeue(w->loaded)) != NULL) {
+      m2c_symfile_release(symfile);
+    } /* end while */
+    m2c_fifo_release_queue(w->loaded);
+  } /* end if */
+  
+  while (w->chunk != NULL) {
+    next = w->chunk->next;
+    free(w->chunk);
+    w->chunk = next;
+  } /* end while */
+  
+  m2t_release_const_folder(&w->folder);
+  m2t_release_label_set(&w->labels);
+  
+  free(w->symbol);
+  w->symbol = NULL;
+} /* end release_writer */
+
+
+/* *********************************************************************** *
+ * Compilation Units                                                       *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private procedure write_defmod(w, defmod)
+ * --------------------------------------------------------------------------
+ * Translates definition module defmod to a C header.  The variables of the
+ * module are declared extern, except within its implementation, which
+ * defines Module__IMPLEMENTATION before it includes the header.
+ * ----------------------------------------------------------------------- */
+
+static void write_defmod (c99_writer_s *w, m2c_astnode_t defmod) {
+  m2c_astnode_t deflist;
+  const char *modname;
+  uint_t index, count;
+  
+  begin_module(w, subnode(defmod, 0));
+  modname = w->prefix[0];
+  w->defmod = true;
+  
+  /* comments of the module, include guard, prelude and storage class */
+  w->out = w->head;
+  write_comments(w, defmod);
+  emit_str(w, "/* generated by m2c from definition module ");
+  emit_str(w, modname);
+  emit_str(w, " */\n\n#ifndef ");
+  emit_str(w, modname);
+  emit_str(w, "__H\n#define ");
+  emit_str(w, modname);
+  emit_str(w, "__H\n\n");
+  emit_str(w, prelude);
+  
+  emit_str(w, "#ifdef ");
+  emit_str(w, modname);
+  emit_str(w, "__IMPLEMENTATION\n#define ");
+  emit_str(w, modname);
+  emit_str(w, "__VAR\n#else\n#define ");
+  emit_str(w, modname);
+  emit_str(w, "__VAR extern\n#endif\n\n");
+  
+  write_imports(w, subnode(defmod, 1));
+  write_include_break(w, subnode(defmod, 1));
+  
+  /* definitions */
+  w->out = w->decls;
+  deflist = subnode(defmod, 2);
+  predeclare(w, deflist);
+  
+  count = list_count(deflist);
+  for (index = 0; index < count; index++) {
+    write_declaration(w, subnode(deflist, index));
+  } /* end for */
+  
+  /* module initialisation and end of include guard */
+  w->out = w->procs;
+  emit_str(w, "void ");
+  emit_str(w, modname);
+  emit_str(w, "__init (void);\n\n#endif /* ");
+  emit_str(w, modname);
+  emit_str(w, "__H */\n");
+} /* end write_defmod */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_impmod(w, impmod)
+ * --------------------------------------------------------------------------
+ * Translates program or implementation module impmod to a C source file.
+ * The module body becomes function Module__init, which first initialises
+ * the imported modules.  A program module also gets a main function.
+ * ----------------------------------------------------------------------- */
+
+static void write_impmod (c99_writer_s *w, m2c_astnode_t impmod) {
+  m2c_astnode_t implist, block, decllist;
+  const char *modname;
+  uint_t index, count;
+  bool program;
+  
+  begin_module(w, subnode(impmod, 0));
+  modname = w->prefix[0];
+  
+  /* a module without its own symbol file is a program module */
+  w->own = load_symfile(w, w->module);
+  program = (w->own == NULL);
+  
+  implist = subnode(impmod, 2);
+  block = subnode(impmod, 3);
+  decllist = subnode(block, 0);
+  
+  w->out = w->head;
+  write_comments(w, impmod);
+  emit_str(w, "/* generated by m2c from ");
+  emit_str(w, (program) ? "program module " : "implementation module ");
+  emit_str(w, modname);
+  emit_str(w, " */\n\n");
+  
+  if (program) {
+    emit_str(w, prelude);
+  }
+  else {
+    emit_str(w, "#define ");
+    emit_str(w, modname);
+    emit_str(w, "__IMPLEMENTATION\n\n");
+  
+    /* imports must be known before opaque types are resolved */
+    write_imports(w, implist);
+    write_opaque_targets(w, decllist);
+  
+    emit_str(w, "#include \"");
+    emit_str(w, modname);
+    emit_str(w, ".h\"\n\n");
+  } /* end if */
+  
+  if (program) {
+    write_imports(w, implist);
+    write_include_break(w, implist);
+  } /* end if */
+  
+  /* declarations */
+  w->out = w->decls;
+  predeclare(w, decllist);
+  
+  /* constants of the module are folded for the dispatch of CASE */
+  w->consts = decllist;
+  m2t_const_folder_bind_defs(w->folder, decllist);
+  
+  count = list_count(decllist);
+  for (index = 0; index < count; index++) {
+    write_declaration(w, subnode(decllist, index));
+  } /* end for */
+  
+  /* module body */
+  w->out = w->procs;
+  emit_str(w, (program) ? "static void " : "void ");
+  emit_str(w, modname);
+  emit_str(w, "__init (void) {\n");
+  
+  w->indent = 1;
+  emit_line(w, "static bool m2__done = false;");
+  emit_line(w, "if (m2__done) {");
+  emit_line(w, "  return;");
+  emit_line(w, "} /* end if */");
+  emit_line(w, "m2__done = true;");
+  write_import_inits(w, implist);
+  write_statement_seq(w, subnode(block, 1));
+  w->indent = 0;
+  
+  emit_str(w, "} /* end ");
+  emit_str(w, modname);
+  emit_str(w, "__init */\n");
+  
+  if (program) {
+    emit_str(w, "\nint main (void) {\n  ");
+    emit_str(w, modname);
+    emit_str(w, "__init();\n  return EXIT_SUCCESS;\n} /* end main */\n");
+  } /* end if */
+} /* end write_impmod */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure begin_module(w, id)
+ * --------------------------------------------------------------------------
+ * Sets up the module scope of writer w for the module with identifier id.
+ * ----------------------------------------------------------------------- */
+
+static void begin_module (c99_writer_s *w, m2c_astnode_t id) {
+  
+  w->module = m2c_ast_value(id);
+  w->depth = 0;
+  w->scope[0] = w->module;
+  w->prefix[0] = m2c_string_char_ptr(w->module);
+} /* end begin_module */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_imports(w, implist)
+ * --------------------------------------------------------------------------
+ * Enters the identifiers imported by implist and writes an include
+ * directive for the header of each imported module other than SYSTEM.
+ * ----------------------------------------------------------------------- */
+
+static void write_imports (c99_writer_s *w, m2c_astnode_t implist) {
+  m2c_astnode_t import, idlist;
+  c99_symbol_s *modsym, *symbol;
+  c99_symbol_s copy;
+  m2c_string_t module, ident;
+  uint_t index, count, id_index, id_count;
+  
+  count = list_count(implist);
+  for (index = 0; index < count; index++) {
+    import = subnode(implist, index);
+  
+    /* IMPORT module, ... */
+    if (m2c_ast_nodetype(import) == AST_IMPORT) {
+      idlist = subnode(import, 0);
+      id_count = m2c_ast_subnode_count(idlist);
+  
+      for (id_index = 0; id_index < id_count; id_index++) {
+        module = m2c_ast_value_for_index(idlist, id_index);
+        modsym = import_module(w, module);
+  
+        if ((modsym != NULL) && (modsym->kind == C99_SYM_MODULE)) {
+          copy = *modsym;
+          symbol = enter_symbol(w, w->module, module, copy.kind, NULL);
+          if (symbol != NULL) {
+            symbol->symfile = copy.symfile;
+          } /* end if */
+        }
+        else if (modsym != NULL) {
+          enter_symbol(w, w->module, module, C99_SYM_SYSTEM, NULL);
+        } /* end if */
+      } /* end for */
+    }
+    /* FROM module IMPORT ident, ... */
+    else if (m2c_ast_nodetype(import) == AST_UNQIMP) {
+      module = m2c_ast_value(subnode(import, 0));
+      idlist = subnode(import, 1);
+      id_count = m2c_ast_subnode_count(idlist);
+      modsym = import_module(w, module);
+  
+      if (modsym == NULL) {
+        continue;
+      } /* end if */
+  
+      copy = *modsym;
+      for (id_index = 0; id_index < id_count; id_index++) {
+        ident = m2c_ast_value_for_index(idlist, id_index);
+        symbol = qualified_symbol(w, &copy, ident);
+  
+        if (symbol != NULL) {
+          copy_symbol(w, w->module, ident, symbol);
+        } /* end if */
+      } /* end for */
+    } /* end if */
+  } /* end for */
+} /* end write_imports */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_include_break(w, implist)
+ * --------------------------------------------------------------------------
+ * Separates the include directives written for implist from the text that
+ * follows them.
+ * ----------------------------------------------------------------------- */
+
+static void write_include_break (c99_writer_s *w, m2c_astnode_t implist) {
+  
+  if (list_count(implist) > 0) {
+    emit_char(w, '\n');
+  } /* end if */
+} /* end write_include_break */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_import_inits(w, implist)
+ * --------------------------------------------------------------------------
+ * Writes a call to the initialisation function of each module imported by
+ * implist, other than SYSTEM.
+ * ----------------------------------------------------------------------- */
+
+static void write_import_inits (c99_writer_s *w, m2c_astnode_t implist) {
+  m2c_astnode_t import, idlist;
+  uint_t index, count, id_index, id_count;
+  
+  count = list_count(implist);
+  for (index = 0; index < count; index++) {
+    import = subnode(implist, index);
+  
+    if (m2c_ast_nodetype(import) == AST_IMPORT) {
+      idlist = subnode(import, 0);
+      id_count = m2c_ast_subnode_count(idlist);
+  
+      for (id_index = 0; id_index < id_count; id_index++) {
+        write_import_init(w, m2c_ast_value_for_index(idlist, id_index));
+      } /* end for */
+    }
+    else if (m2c_ast_nodetype(import) == AST_UNQIMP) {
+      write_import_init(w,
+        m2c_ast_value(subnode(import, 0)));
+    } /* end if */
+  } /* end for */
+} /* end write_import_inits */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_import_init(w, module)
+ * --------------------------------------------------------------------------
+ * Writes a call to the initialisation function of module, unless module
+ * is SYSTEM or the call has already been written.
+ * ----------------------------------------------------------------------- */
+
+static void write_import_init (c99_writer_s *w, m2c_string_t module) {
+  c99_symbol_s *symbol;
+  
+  symbol = lookup_symbol(w, import_scope, module);
+  
+  if ((is_system(module)) || ((symbol != NULL) && (symbol->forward))) {
+    return;
+  } /* end if */
+  
+  if (symbol != NULL) {
+    symbol->forward = true;
+  } /* end if */
+  
+  emit_indent(w);
+  emit_str(w, m2c_string_char_ptr(module));
+  emit_str(w, "__init();\n");
+} /* end write_import_init */
+
+
+/* --------------------------------------------------------------------------
+ * private function import_module(w, module)
+ * --------------------------------------------------------------------------
+ * Returns the import symbol of module, loading its symbol file and writing
+ * an include directive for its header when it is first imported.  The
+ * symbol is of kind C99_SYM_SYSTEM for SYSTEM.  Returns NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+static c99_symbol_s *import_module (c99_writer_s *w, m2c_string_t module) {
+  c99_symbol_s *symbol;
+  m2c_symfile_t symfile;
+  
+  symbol = lookup_symbol(w, import_scope, module);
+  
+  if (symbol != NULL) {
+    return symbol;
+  } /* end if */
+  
+  if (is_system(module)) {
+    return enter_symbol(w, import_scope, module, C99_SYM_SYSTEM, NULL);
+  } /* end if */
+  
+  emit_str(w, "#include \"");
+  emit_str(w, m2c_string_char_ptr(module));
+  emit_str(w, ".h\"\n");
+  
+  symfile = load_symfile(w, module);
+  symbol = enter_symbol(w, import_scope, module, C99_SYM_MODULE, NULL);
+  
+  if (symbol != NULL) {
+    symbol->symfile = symfile;
+  } /* end if */
+  
+  return symbol;
+} /* end import_module */
+
+
+/* --------------------------------------------------------------------------
+ * private function load_symfile(w, module)
+ * --------------------------------------------------------------------------
+ * Returns the symbol file of module obtained from the import loader of w,
+ * or NULL if there is no loader or no symbol file.  Loaded symbol files
+ * are released with the writer.
+ * ----------------------------------------------------------------------- */
+
+static m2c_symfile_t load_symfile (c99_writer_s *w, m2c_string_t module) {
+  m2c_symfile_t symfile;
+  
+  if (w->load_import == NULL) {
+    return NULL;
+  } /* end if */
+  
+  symfile = w->load_import(m2c_string_char_ptr(module), w->context);
+  
+  if (symfile == NULL) {
+    return NULL;
+  } /* end if */
+  
+  if (w->loaded == NULL) {
+    w->loaded = m2c_fifo_new_queue(symfile);
+  }
+  else if (m2c_fifo_enqueue(w->loaded, symfile) == NULL) {
+    w->failed = true;
+  } /* end if */
+  
+  if (w->loaded == NULL) {
+    m2c_symfile_release(symfile);
+    w->failed = true;
+    return NULL;
+  } /* end if */
+  
+  return symfile;
+} /* end load_symfile */
+
+
+/* --------------------------------------------------------------------------
+ * private function is_system(module)
+ * --------------------------------------------------------------------------
+ * Returns true if module is the pseudo-module SYSTEM, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+static bool is_system (m2c_string_t module) {
+  return (strcmp(m2c_string_char_ptr(module), "SYSTEM") == 0);
+} /* end is_system */
+
+
+/* --------------------------------------------------------------------------
+ * private function qualified_symbol(w, modsym, ident)
+ * --------------------------------------------------------------------------
+ * Returns the symbol for ident exported by the module of import symbol
+ * modsym and enters it if it has not been used before.  The kind and the
+ * parameter modes of an exported symbol are taken from the symbol file of
+ * the module, if available.  Returns NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+static c99_symbol_s *qualified_symbol
+  (c99_writer_s *w, const c99_symbol_s *modsym, m2c_string_t ident) {
+  
+  c99_symbol_s *symbol;
+  m2c_symfile_t symfile;
+  c99_symkind_t kind;
+  const char *cname;
+  const char *modes;
+  uint_t index;
+  
+  if (modsym->kind == C99_SYM_SYSTEM) {
+    return lookup_symbol(w, system_scope, ident);
+  } /* end if */
+  
+  symbol = lookup_symbol(w, modsym->ident, ident);
+  
+  if (symbol != NULL) {
+    return symbol;
+  } /* end if */
+  
+  kind = C99_SYM_OTHER;
+  modes = NULL;
+  symfile = modsym->symfile;
+  
+  if (symfile != NULL) {
+    index = m2c_symfile_lookup_string(symfile, ident);
+  
+    if (index != M2C_SYMFILE_NOT_FOUND) {
+      switch (m2c_symfile_kind_for_index(symfile, index)) {
+        case M2C_SYMTYPE_CONST :
+          kind = C99_SYM_CONST;
+          break;
+  
+        case M2C_SYMTYPE_TYPE :
+          kind = C99_SYM_TYPE;
+          break;
+  
+        case M2C_SYMTYPE_VAR :
+          kind = C99_SYM_VAR;
+          break;
+  
+        case M2C_SYMTYPE_PROC :
+          kind = C99_SYM_PROC;
+          modes = modes_for_image(w, m2c_symfile_image(symfile),
+            m2c_symfile_node_for_index(symfile, index));
+          break;
+  
+        default :
+          break;
+      } /* end switch */
+    } /* end if */
+  } /* end if */
+  
+  cname = prefixed_name(w, m2c_string_char_ptr(modsym->ident), ident);
+  symbol = enter_symbol(w, modsym->ident, ident, kind, cname);
+  
+  if (symbol != NULL) {
+    symbol->modes = modes;
+  } /* end if */
+  
+  return symbol;
+} /* end qualified_symbol */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure copy_symbol(w, scope, ident, symbol)
+ * --------------------------------------------------------------------------
+ * Enters a copy of symbol for ident into scope.
+ * ----------------------------------------------------------------------- */
+
+static void copy_symbol
+  (c99_writer_s *w, const void *scope, m2c_string_t ident,
+   const c99_symbol_s *symbol) {
+  
+  c99_symbol_s copy;
+  c99_symbol_s *new_symbol;
+  
+  copy = *symbol;
+  new_symbol = enter_symbol(w, scope, ident, copy.kind, copy.cname);
+  
+  if (new_symbol != NULL) {
+    copy.scope = new_symbol->scope;
+    copy.ident = new_symbol->ident;
+    *new_symbol = copy;
+  } /* end if */
+} /* end copy_symbol */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_opaque_targets(w, decllist)
+ * --------------------------------------------------------------------------
+ * Writes a macro for each opaque type of the definition module that
+ * decllist implements as a pointer to a record type.  The macro names the
+ * struct tag of the record type, the header declares the opaque type as a
+ * pointer to a struct with that tag.  Marks the opaque types as declared.
+ * ----------------------------------------------------------------------- */
+
+static void write_opaque_targets (c99_writer_s *w, m2c_astnode_t decllist) {
+  m2c_astnode_t decl, type, target;
+  m2c_string_t ident;
+  c99_symbol_s *symbol;
+  const char *cname;
+  uint_t index, count;
+  
+  count = list_count(decllist);
+  for (index = 0; index < count; index++) {
+    decl = subnode(decllist, index);
+  
+    if (m2c_ast_nodetype(decl) != AST_TYPEDECL) {
+      continue;
+    } /* end if */
+  
+    ident = m2c_ast_value(subnode(decl, 0));
+  
+    if (NOT(is_own_opaque_type(w, ident))) {
+      continue;
+    } /* end if */
+  
+    cname = prefixed_name(w, w->prefix[0], ident);
+    symbol = enter_symbol(w, w->module, ident, C99_SYM_TYPE, cname);
+  
+    if (symbol == NULL) {
+      continue;
+    } /* end if */
+  
+    type = subnode(decl, 1);
+    symbol->node = type;
+    symbol->forward = true;
+  
+    if (m2c_ast_nodetype(type) != AST_POINTER) {
+      continue;
+    } /* end if */
+  
+    target = subnode(type, 0);
+  
+    if (m2c_ast_nodetype(target) == AST_IDENT) {
+      emit_str(w, "#define ");
+      emit_str(w, cname);
+      emit_str(w, "__opaque ");
+      emit_str(w, cname_for_ident(w, m2c_ast_value(target)));
+      emit_str(w, "\n\n");
+    } /* end if */
+  } /* end for */
+} /* end write_opaque_targets */
+
+
+/* --------------------------------------------------------------------------
+ * private function is_own_opaque_type(w, ident)
+ * --------------------------------------------------------------------------
+ * Returns true if ident is an opaque type of the definition module of the
+ * module being translated, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+static bool is_own_opaque_type (c99_writer_s *w, m2c_string_t ident) {
+  m2c_astimage_t image;
+  uint_t index, node, type;
+  
+  if (w->own == NULL) {
+    return false;
+  } /* end if */
+  
+  index = m2c_symfile_lookup_string(w->own, ident);
+  
+  if ((index == M2C_SYMFILE_NOT_FOUND) ||
+      (m2c_symfile_kind_for_index(w->own, index) != M2C_SYMTYPE_TYPE)) {
+    return false;
+  } /* end if */
+  
+  image = m2c_symfile_image(w->own);
+  node = m2c_symfile_node_for_index(w->own, index);
+  type = m2c_astimage_subnode_for_index(image, node, 1);
+  
+  return (m2c_astimage_nodetype(image, type) == AST_EMPTY);
+} /* end is_own_opaque_type */
+
+
+/* --------------------------------------------------------------------------
+ * private function is_exported(w, ident)
+ * --------------------------------------------------------------------------
+ * Returns true if ident is declared at module level and exported by the
+ * definition module of the module being translated, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+static bool is_exported (c99_writer_s *w, m2c_string_t ident) {
+  
+  if ((w->own == NULL) || (w->depth > 0)) {
+    return false;
+  } /* end if */
+  
+  return (m2c_symfile_lookup_string(w->own, ident) !=
+    M2C_SYMFILE_NOT_FOUND);
+} /* end is_exported */
+
+
+/* *********************************************************************** *
+ * Declarations                                                            *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private procedure predeclare(w, list)
+ * --------------------------------------------------------------------------
+ * Enters the procedures declared or defined in list into the current scope
+ * together with their parameter modes, so that calls preceding their
+ * declaration pass arguments correctly.  Writes a forward declaration of
+ * the struct of each record type declared in list, so that pointer types
+ * may refer to record types declared after them.
+ * ----------------------------------------------------------------------- */
+
+static void predeclare (c99_writer_s *w, m2c_astnode_t list) {
+  m2c_astnode_t decl, procdef, type;
+  m2c_ast_nodetype_t node_type;
+  c99_symbol_s *symbol;
+  const char *cname;
+  const char *modes;
+  uint_t index, count;
+  
+  count = list_count(list);
+  for (index = 0; index < count; index++) {
+    decl = subnode(list, index);
+    node_type = m2c_ast_nodetype(decl);
+  
+    if ((node_type == AST_PROC) || (node_type == AST_PROCDEF)) {
+      procdef = (node_type == AST_PROC) ?
+        subnode(decl, 0) : decl;
+      modes = modes_for_procdef(w, procdef);
+      symbol = declare_ident(w,
+        subnode(procdef, 0), C99_SYM_PROC, true);
+  
+      if (symbol != NULL) {
+        symbol->node = procdef;
+        symbol->modes = modes;
+      } /* end if */
+    }
+    else if ((node_type == AST_TYPEDEF) || (node_type == AST_TYPEDECL)) {
+      type = subnode(decl, 1);
+  
+      if (NOT(is_record_type(type))) {
+        continue;
+      } /* end if */
+  
+      symbol = declare_ident(w,
+        subnode(decl, 0), C99_SYM_TYPE, true);
+  
+      if ((symbol == NULL) || (symbol->forward)) {
+        continue;
+      } /* end if */
+  
+      symbol->node = type;
+      symbol->forward = true;
+      cname = symbol->cname;
+  
+      emit_str(w, "typedef struct ");
+      emit_str(w, cname);
+      emit_char(w, ' ');
+      emit_str(w, cname);
+      emit_str(w, ";\n\n");
+    } /* end if */
+  } /* end for */
+} /* end predeclare */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_declaration(w, decl)
+ * --------------------------------------------------------------------------
+ * Translates definition or declaration decl at module level.
+ * ----------------------------------------------------------------------- */
+
+static void write_declaration (c99_writer_s *w, m2c_astnode_t decl) {
+  
+  /* comments of procedures precede their definition */
+  if (m2c_ast_nodetype(decl) != AST_PROC) {
+    write_comments(w, decl);
+  } /* end if */
+  
+  switch (m2c_ast_nodetype(decl)) {
+    case AST_CONSTDEF :
+      write_const(w, decl);
+      break;
+  
+    case AST_TYPEDEF :
+    case AST_TYPEDECL :
+      write_type_decl(w, decl);
+      break;
+  
+    case AST_VARDECL :
+      write_var_decl(w, decl);
+      break;
+  
+    case AST_PROCDEF :
+      write_proc_heading(w, decl, "", false);
+      emit_str(w, ";\n\n");
+      break;
+  
+    case AST_PROC :
+      write_proc(w, decl);
+      break;
+  
+    case AST_MODDECL :
+      emit_str(w, "/* local module ");
+      emit_str(w, m2c_string_char_ptr(
+        m2c_ast_value(subnode(decl, 0))));
+      emit_str(w, " not translated */\n\n");
+      break;
+  
+    default :
+      break;
+  } /* end switch */
+} /* end write_declaration */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_const(w, constdef)
+ * --------------------------------------------------------------------------
+ * Translates constant definition constdef to a macro at file scope.
+ * ----------------------------------------------------------------------- */
+
+static void write_const (c99_writer_s *w, m2c_astnode_t constdef) {
+  c99_symbol_s *symbol;
+  m2c_outsink_t sink;
+  const char *cname;
+  
+  symbol = declare_ident(w,
+    subnode(constdef, 0), C99_SYM_CONST, true);
+  
+  if (symbol == NULL) {
+    return;
+  } /* end if */
+  
+  symbol->node = subnode(constdef, 1);
+  cname = symbol->cname;
+  sink = w->out;
+  w->out = w->decls;
+  
+  emit_str(w, "#define ");
+  emit_str(w, cname);
+  emit_str(w, " (");
+  write_expr(w, subnode(constdef, 1));
+  emit_str(w, ")\n\n");
+  
+  w->out = sink;
+} /* end write_const */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_type_decl(w, typedecl)
+ * --------------------------------------------------------------------------
+ * Translates type definition or declaration typedecl to a typedef at file
+ * scope.  The bounds of an ordinal type are written as macros, named by
+ * the C name of the type with suffixes __MIN and __MAX.  An opaque type is
+ * a pointer to a struct whose tag is provided by its implementation.
+ * ----------------------------------------------------------------------- */
+
+static void write_type_decl (c99_writer_s *w, m2c_astnode_t typedecl) {
+  m2c_astnode_t type, first, last;
+  c99_symbol_s *symbol;
+  m2c_outsink_t sink;
+  const char *cname;
+  bool forward;
+  uint_t count;
+  
+  type = subnode(typedecl, 1);
+  
+  /* opaque types implemented here are declared by the header */
+  symbol = lookup_symbol(w, w->scope[w->depth],
+    m2c_ast_value(subnode(typedecl, 0)));
+  
+  if ((symbol != NULL) && (symbol->kind == C99_SYM_TYPE) &&
+      (symbol->forward) && (NOT(is_record_type(type)))) {
+    return;
+  } /* end if */
+  
+  symbol = declare_ident(w,
+    subnode(typedecl, 0), C99_SYM_TYPE, true);
+  
+  if (symbol == NULL) {
+    return;
+  } /* end if */
+  
+  symbol->node = type;
+  forward = symbol->forward;
+  cname = symbol->cname;
+  
+  sink = w->out;
+  w->out = w->decls;
+  
+  switch (m2c_ast_nodetype(type)) {
+    case AST_EMPTY :
+      emit_str(w, "typedef struct ");
+      emit_str(w, cname);
+      emit_str(w, "__opaque *");
+      emit_str(w, cname);
+      emit_str(w, ";\n\n");
+      break;
+  
+    case AST_RECORD :
+    case AST_EXTREC :
+    case AST_VRNTREC :
+    case AST_VSREC :
+      if (NOT(forward)) {
+        emit_str(w, "typedef struct ");
+        emit_str(w, cname);
+        emit_char(w, ' ');
+        emit_str(w, cname);
+        emit_str(w, ";\n\n");
+      } /* end if */
+  
+      emit_str(w, "struct ");
+      emit_str(w, cname);
+      emit_char(w, ' ');
+      write_record_body(w, type);
+      emit_str(w, ";\n\n");
+      break;
+  
+    case AST_ENUM :
+      emit_str(w, "typedef ");
+      write_type_prefix(w, type);
+      emit_char(w, ' ');
+      emit_str(w, cname);
+      emit_str(w, ";\n");
+  
+      first = subnode(type, 0);
+      count = m2c_ast_subnode_count(first);
+      write_bound_macro(w, cname, "__MIN",
+        cname_for_ident(w, m2c_ast_value_for_index(first, 0)), NULL);
+      write_bound_macro(w, cname, "__MAX",
+        cname_for_ident(w, m2c_ast_value_for_index(first, count - 1)),
+        NULL);
+      emit_char(w, '\n');
+      break;
+  
+    case AST_SUBR :
+      emit_str(w, "typedef ");
+      write_type_prefix(w, type);
+      emit_char(w, ' ');
+      emit_str(w, cname);
+      emit_str(w, ";\n");
+  
+      first = subnode(type, 0);
+      last = subnode(type, 1);
+      write_bound_macro(w, cname, "__MIN", NULL, first);
+      write_bound_macro(w, cname, "__MAX", NULL, last);
+      emit_char(w, '\n');
+      break;
+  
+    case AST_IDENT :
+    case AST_QUALIDENT :
+      emit_str(w, "typedef ");
+      write_type_prefix(w, type);
+      emit_char(w, ' ');
+      emit_str(w, cname);
+      emit_str(w, ";\n");
+      write_alias_bounds(w, cname, type);
+      emit_char(w, '\n');
+      break;
+  
+    default :
+      emit_str(w, "typedef ");
+      write_declarator(w, type, cname);
+      emit_str(w, ";\n\n");
+      break;
+  } /* end switch */
+  
+  w->out = sink;
+} /* end write_type_decl */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_bound_macro(w, cname, suffix, text, expr)
+ * --------------------------------------------------------------------------
+ * Writes a macro named by cname and suffix that expands to text, or to
+ * expression expr if text is NULL.
+ * ----------------------------------------------------------------------- */
+
+static void write_bound_macro
+  (c99_writer_s *w, const char *cname, const char *suffix,
+   const char *text, m2c_astnode_t expr) {
+  
+  emit_str(w, "#define ");
+  emit_str(w, cname);
+  emit_str(w, suffix);
+  emit_str(w, " (");
+  
+  if (text != NULL) {
+    emit_str(w, text);
+  }
+  else {
+    write_expr(w, expr);
+  } /* end if */
+  
+  emit_str(w, ")\n");
+} /* end write_bound_macro */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_alias_bounds(w, cname, type)
+ * --------------------------------------------------------------------------
+ * Writes the bound macros of type alias cname of type identifier type.  The
+ * macros of an alias of a type without bounds are never expanded.
+ * ----------------------------------------------------------------------- */
+
+static void write_alias_bounds
+  (c99_writer_s *w, const char *cname, m2c_astnode_t type) {
+  
+  c99_symbol_s *symbol;
+  const char *target;
+  
+  symbol = type_symbol(w, type);
+  
+  if ((symbol != NULL) && (symbol->info != NULL)) {
+    if (symbol->info->min != NULL) {
+      write_bound_macro(w, cname, "__MIN", symbol->info->min, NULL);
+      write_bound_macro(w, cname, "__MAX", symbol->info->max, NULL);
+    } /* end if */
+    return;
+  } /* end if */
+  
+  target = (symbol != NULL) ? symbol->cname : NULL;
+  
+  if (target == NULL) {
+    return;
+  } /* end if */
+  
+  emit_str(w, "#define ");
+  emit_str(w, cname);
+  emit_str(w, "__MIN ");
+  emit_str(w, target);
+  emit_str(w, "__MIN\n#define ");
+  emit_str(w, cname);
+  emit_str(w, "__MAX ");
+  emit_str(w, target);
+  emit_str(w, "__MAX\n");
+} /* end write_alias_bounds */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_var_decl(w, vardecl)
+ * --------------------------------------------------------------------------
+ * Translates variable declaration vardecl.  Variables of a definition
+ * module are defined by its implementation and declared extern elsewhere,
+ * other variables at module level are static, those of a procedure local.
+ * ----------------------------------------------------------------------- */
+
+static void write_var_decl (c99_writer_s *w, m2c_astnode_t vardecl) {
+  m2c_astnode_t idlist, type;
+  c99_symbol_s *symbol;
+  const char *cname;
+  uint_t index, count;
+  bool shared;
+  
+  idlist = subnode(vardecl, 0);
+  type = subnode(vardecl, 1);
+  count = m2c_ast_subnode_count(idlist);
+  
+  /* variables of an anonymous type share a single declaration */
+  shared = is_plain_type(type);
+  
+  for (index = 0; index < count; index++) {
+    symbol = declare_value(w,
+      m2c_ast_value_for_index(idlist, index), C99_SYM_VAR, (w->depth == 0));
+  
+    if (symbol == NULL) {
+      return;
+    } /* end if */
+  
+    symbol->node = type;
+    cname = symbol->cname;
+  
+    if ((index == 0) || (NOT(shared))) {
+      if (w->depth > 0) {
+        emit_indent(w);
+      }
+      else if (w->defmod) {
+        emit_str(w, w->prefix[0]);
+        emit_str(w, "__VAR ");
+      }
+      else {
+        emit_str(w, "static ");
+      } /* end if */
+    } /* end if */
+  
+    if (NOT(shared)) {
+      write_declarator(w, type, cname);
+      emit_str(w, ";\n");
+    }
+    else {
+      if (index == 0) {
+        write_type_prefix(w, type);
+        emit_char(w, ' ');
+      }
+      else {
+        emit_str(w, ", ");
+      } /* end if */
+  
+      emit_str(w, cname);
+  
+      if (index == count - 1) {
+        emit_str(w, ";\n");
+      } /* end if */
+    } /* end if */
+  } /* end for */
+  
+  if (w->depth == 0) {
+    emit_char(w, '\n');
+  } /* end if */
+} /* end write_var_decl */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_proc(w, proc)
+ * --------------------------------------------------------------------------
+ * Translates procedure declaration proc.  The prototype is written to the
+ * declarations, the definition to the function definitions.  Constants,
+ * types and procedures declared within the procedure are moved to file
+ * scope, their C names are prefixed with the C name of the procedure.
+ * Procedures not exported by the definition module are static.
+ * ----------------------------------------------------------------------- */
+
+static void write_proc (c99_writer_s *w, m2c_astnode_t proc) {
+  m2c_astnode_t procdef, block, decllist, decl;
+  c99_symbol_s *symbol;
+  m2c_outsink_t sink;
+  const char *storage;
+  const char *cname;
+  uint_t index, count, exit_label;
+  bool exit_used;
+  
+  procdef = subnode(proc, 0);
+  block = subnode(proc, 1);
+  decllist = subnode(block, 0);
+  
+  symbol = declare_ident(w,
+    subnode(procdef, 0), C99_SYM_PROC, true);
+  
+  if (symbol == NULL) {
+    return;
+  } /* end if */
+  
+  if (symbol->modes == NULL) {
+    symbol->node = procdef;
+    symbol->modes = modes_for_procdef(w, procdef);
+  } /* end if */
+  
+  cname = symbol->cname;
+  storage = (is_exported(w,
+    m2c_ast_value(subnode(procdef, 0)))) ? "" : "static ";
+  
+  /* prototype */
+  sink = w->out;
+  w->out = w->decls;
+  write_proc_heading(w, procdef, storage, false);
+  emit_str(w, ";\n\n");
+  
+  if (w->depth + 1 >= C99_MAX_SCOPE_DEPTH) {
+    w->out = sink;
+    w->failed = true;
+    return;
+  } /* end if */
+  
+  /* the C name of the procedure is the key of its scope */
+  w->depth++;
+  w->scope[w->depth] = cname;
+  w->prefix[w->depth] = cname;
+  
+  /* local constants are not folded, they may shadow those of the module */
+  shadow_locals(w, decllist);
+  
+  /* local constants, types and procedures go first */
+  predeclare(w, decllist);
+  count = list_count(decllist);
+  for (index = 0; index < count; index++) {
+    decl = subnode(decllist, index);
+  
+    if (m2c_ast_nodetype(decl) != AST_VARDECL) {
+      write_declaration(w, decl);
+    } /* end if */
+  } /* end for */
+  
+  /* the definition */
+  w->out = w->procs;
+  write_comments(w, proc);
+  write_proc_heading(w, procdef, storage, true);
+  emit_str(w, " {\n");
+  w->indent++;
+  
+  for (index = 0; index < count; index++) {
+    decl = subnode(decllist, index);
+  
+    if (m2c_ast_nodetype(decl) == AST_VARDECL) {
+      write_var_decl(w, decl);
+    } /* end if */
+  } /* end for */
+  
+  exit_label = w->exit_label;
+  exit_used = w->exit_used;
+  w->exit_label = 0;
+  
+  write_statement_seq(w, subnode(block, 1));
+  
+  w->exit_label = exit_label;
+  w->exit_used = exit_used;
+  w->indent--;
+  
+  emit_str(w, "} /* end ");
+  emit_str(w, cname);
+  emit_str(w, " */\n\n");
+  
+  w->depth--;
+  w->out = sink;
+  
+  /* shadowed constants of the module are folded again */
+  if (w->depth == 0) {
+    m2t_const_folder_bind_defs(w->folder, w->consts);
+  } /* end if */
+} /* end write_proc */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure shadow_locals(w, decllist)
+ * --------------------------------------------------------------------------
+ * Binds the identifier of every constant and enumerated value declared in
+ * declaration list decllist to an empty node in the constant folder of w,
+ * so that labels referring to them are not folded.
+ * ----------------------------------------------------------------------- */
+
+static void shadow_locals (c99_writer_s *w, m2c_astnode_t decllist) {
+  m2c_astnode_t decl;
+  uint_t index, count;
+  
+  count = list_count(decllist);
+  for (index = 0; index < count; index++) {
+    decl = subnode(decllist, index);
+  
+    switch (m2c_ast_nodetype(decl)) {
+      case AST_CONSTDEF :
+        m2t_const_folder_bind(w->folder,
+          m2c_ast_value(subnode(decl, 0)), m2c_ast_empty_node());
+        break;
+  
+      case AST_TYPEDEF :
+      case AST_VARDECL :
+        shadow_enums(w, subnode(decl, 1));
+        break;
+  
+      default :
+        break;
+    } /* end switch */
+  } /* end for */
+} /* end shadow_locals */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure shadow_enums(w, type)
+ * --------------------------------------------------------------------------
+ * Binds the values of every enumeration type within type constructor type
+ * to an empty node in the constant folder of w.
+ * ----------------------------------------------------------------------- */
+
+static void shadow_enums (c99_writer_s *w, m2c_astnode_t type) {
+  m2c_astnode_t idlist;
+  uint_t index, count;
+  
+  if ((type == NULL) ||
+      (m2c_ast_is_terminal_nodetype(m2c_ast_nodetype(type)))) {
+    return;
+  } /* end if */
+  
+  if (m2c_ast_nodetype(type) == AST_ENUM) {
+    idlist = subnode(type, 0);
+    count = m2c_ast_subnode_count(idlist);
+    for (index = 0; index < count; index++) {
+      m2t_const_folder_bind(w->folder,
+        m2c_ast_value_for_index(idlist, index), m2c_ast_empty_node());
+    } /* end for */
+    return;
+  } /* end if */
+  
+  count = m2c_ast_subnode_count(type);
+  for (index = 0; index < count; index++) {
+    shadow_enums(w, subnode(type, index));
+  } /* end for */
+} /* end shadow_enums */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_proc_heading(w, procdef, storage, enter)
+ * --------------------------------------------------------------------------
+ * Writes the C function heading of procedure heading procdef, preceded by
+ * storage.  A VAR parameter is passed as a pointer, an open array as a
+ * pointer to its first element followed by its HIGH value.  If enter is
+ * true, the parameters are entered into the current scope.
+ * ----------------------------------------------------------------------- */
+
+static void write_proc_heading
+  (c99_writer_s *w, m2c_astnode_t procdef, const char *storage, bool enter) {
+  
+  m2c_astnode_t fplist, fparams, idlist, ftype, rtype;
+  m2c_string_t ident;
+  const char *cname;
+  uint_t index, count, id_index, id_count;
+  char mode;
+  bool first;
+  
+  rtype = subnode(procdef, 2);
+  
+  emit_str(w, storage);
+  
+  if (m2c_ast_nodetype(rtype) == AST_EMPTY) {
+    emit_str(w, "void");
+  }
+  else {
+    write_type_prefix(w, rtype);
+  } /* end if */
+  
+  emit_char(w, ' ');
+  emit_str(w, cname_for_ident(w,
+    m2c_ast_value(subnode(procdef, 0))));
+  emit_str(w, " (");
+  
+  fplist = subnode(procdef, 1);
+  count = list_count(fplist);
+  first = true;
+  
+  for (index = 0; index < count; index++) {
+    fparams = subnode(fplist, index);
+    idlist = subnode(fparams, 0);
+    ftype = subnode(fparams, 1);
+    mode = mode_for_formal_type(m2c_ast_nodetype(ftype),
+      m2c_ast_nodetype(subnode(ftype, 0)));
+  
+    /* the type of the parameter or the element type of an open array */
+    if ((m2c_ast_nodetype(ftype) == AST_VARP) ||
+        (m2c_ast_nodetype(ftype) == AST_CONSTP)) {
+      ftype = subnode(ftype, 0);
+    } /* end if */
+  
+    if (m2c_ast_nodetype(ftype) == AST_OPENARRAY) {
+      ftype = subnode(ftype, 0);
+    } /* end if */
+  
+    id_count = m2c_ast_subnode_count(idlist);
+    for (id_index = 0; id_index < id_count; id_index++) {
+      ident = m2c_ast_value_for_index(idlist, id_index);
+  
+      if (NOT(first)) {
+        emit_str(w, ", ");
+      } /* end if */
+  
+      first = false;
+      cname = local_name(w, ident);
+  
+      write_type_prefix(w, ftype);
+  
+      if (mode == C99_MODE_VALUE) {
+        emit_char(w, ' ');
+      }
+      else {
+        emit_str(w, " *");
+      } /* end if */
+  
+      emit_str(w, cname);
+  
+      if (mode == C99_MODE_OPEN) {
+        emit_str(w, ", unsigned ");
+        emit_str(w, cname);
+        emit_str(w, "__high");
+      } /* end if */
+  
+      if (enter) {
+        enter_param(w, ident, cname, mode, ftype);
+      } /* end if */
+    } /* end for */
+  } /* end for */
+  
+  if (first) {
+    emit_str(w, "void");
+  } /* end if */
+  
+  emit_char(w, ')');
+} /* end write_proc_heading */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure enter_param(w, ident, cname, mode, type)
+ * --------------------------------------------------------------------------
+ * Enters formal parameter ident with C name cname, parameter mode mode and
+ * type or open array element type type into the current scope.
+ * ----------------------------------------------------------------------- */
+
+static void enter_param
+  (c99_writer_s *w, m2c_string_t ident, const char *cname, char mode,
+   m2c_astnode_t type) {
+  
+  c99_symbol_s *symbol;
+  c99_symkind_t kind;
+  
+  if (mode == C99_MODE_VAR) {
+    kind = C99_SYM_VAR_PARAM;
+  }
+  else if (mode == C99_MODE_OPEN) {
+    kind = C99_SYM_OPEN_PARAM;
+  }
+  else {
+    kind = C99_SYM_VAR;
+  } /* end if */
+  
+  symbol = enter_symbol(w, w->scope[w->depth], ident, kind, cname);
+  
+  if (symbol != NULL) {
+    symbol->node = type;
+  } /* end if */
+} /* end enter_param */
+
+
+/* --------------------------------------------------------------------------
+ * private function mode_for_formal_type(ftype, inner)
+ * --------------------------------------------------------------------------
+ * Returns the parameter mode of a formal type with node type ftype, whose
+ * first subnode has node type inner.
+ * ----------------------------------------------------------------------- */
+
+static char mode_for_formal_type
+  (m2c_ast_nodetype_t ftype, m2c_ast_nodetype_t inner) {
+  
+  switch (ftype) {
+    case AST_OPENARRAY :
+      return C99_MODE_OPEN;
+  
+    case AST_VARP :
+      return (inner == AST_OPENARRAY) ? C99_MODE_OPEN : C99_MODE_VAR;
+  
+    case AST_CONSTP :
+      return (inner == AST_OPENARRAY) ? C99_MODE_OPEN : C99_MODE_VALUE;
+  
+    default :
+      return C99_MODE_VALUE;
+  } /* end switch */
+} /* end mode_for_formal_type */
+
+
+/* --------------------------------------------------------------------------
+ * private function modes_for_procdef(w, procdef)
+ * --------------------------------------------------------------------------
+ * Returns the parameter modes of procedure heading procdef.
+ * ----------------------------------------------------------------------- */
+
+static const char *modes_for_procdef (c99_writer_s *w, m2c_astnode_t procdef) {
+  m2c_astnode_t fplist, fparams, ftype;
+  uint_t index, count, id_index, id_count, length;
+  char *modes;
+  char mode;
+  
+  fplist = subnode(procdef, 1);
+  count = list_count(fplist);
+  
+  length = 0;
+  for (index = 0; index < count; index++) {
+    fparams = subnode(fplist, index);
+    length += m2c_ast_subnode_count(subnode(fparams, 0));
+  } /* end for */
+  
+  modes = new_name(w, length);
+  
+  if (modes == NULL) {
+    return NULL;
+  } /* end if */
+  
+  length = 0;
+  for (index = 0; index < count; index++) {
+    fparams = subnode(fplist, index);
+    ftype = subnode(fparams, 1);
+    mode = mode_for_formal_type(m2c_ast_nodetype(ftype),
+      m2c_ast_nodetype(subnode(ftype, 0)));
+  
+    id_count = m2c_ast_subnode_count(subnode(fparams, 0));
+    for (id_index = 0; id_index < id_count; id_index++) {
+      modes[length] = mode;
+      length++;
+    } /* end for */
+  } /* end for */
+  
+  modes[length] = ASCII_NUL;
+  return modes;
+} /* end modes_for_procdef */
+
+
+/* --------------------------------------------------------------------------
+ * private function modes_for_image(w, image, procdef)
+ * --------------------------------------------------------------------------
+ * Returns the parameter modes of the procedure heading with node index
+ * procdef in binary AST image image, as stored in a symbol file.
+ * ----------------------------------------------------------------------- */
+
+static const char *modes_for_image
+  (c99_writer_s *w, m2c_astimage_t image, uint_t procdef) {
+  
+  uint_t fplist, fparams, ftype, inner;
+  uint_t index, count, id_index, id_count, length;
+  char *modes;
+  char mode;
+  
+  fplist = m2c_astimage_subnode_for_index(image, procdef, 1);
+  
+  if (m2c_astimage_nodetype(image, fplist) != AST_FPARAMLIST) {
+    return "";
+  } /* end if */
+  
+  count = m2c_astimage_subnode_count(image, fplist);
+  
+  length = 0;
+  for (index = 0; index < count; index++) {
+    fparams = m2c_astimage_subnode_for_index(image, fplist, index);
+    length += m2c_astimage_subnode_count(image,
+      m2c_astimage_subnode_for_index(image, fparams, 0));
+  } /* end for */
+  
+  modes = new_name(w, length);
+  
+  if (modes == NULL) {
+    return NULL;
+  } /* end if */
+  
+  length = 0;
+  for (index = 0; index < count; index++) {
+    fparams = m2c_astimage_subnode_for_index(image, fplist, index);
+    ftype = m2c_astimage_subnode_for_index(image, fparams, 1);
+    inner = m2c_astimage_subnode_for_index(image, ftype, 0);
+    mode = mode_for_formal_type(m2c_astimage_nodetype(image, ftype),
+      m2c_astimage_nodetype(image, inner));
+  
+    id_count = m2c_astimage_subnode_count(image,
+      m2c_astimage_subnode_for_index(image, fparams, 0));
+    for (id_index = 0; id_index < id_count; id_index++) {
+      modes[length] = mode;
+      length++;
+    } /* end for */
+  } /* end for */
+  
+  modes[length] = ASCII_NUL;
+  return modes;
+} /* end modes_for_image */
+
+
+/* *********************************************************************** *
+ * Types                                                                   *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private procedure write_declarator(w, type, cname)
+ * --------------------------------------------------------------------------
+ * Writes a C declaration of cname with the given type, without storage
+ * class and terminator.  If cname is NULL, an abstract declarator is
+ * written, as used in casts.
+ * ----------------------------------------------------------------------- */
+
+static void write_declarator
+  (c99_writer_s *w, m2c_astnode_t type, const char *cname) {
+  
+  bool space;
+  
+  space = write_type_prefix(w, type);
+  
+  if (cname != NULL) {
+    if (space) {
+      emit_char(w, ' ');
+    } /* end if */
+  
+    emit_str(w, cname);
+  } /* end if */
+  
+  write_type_suffix(w, type);
+} /* end write_declarator */
+
+
+/* --------------------------------------------------------------------------
+ * private function write_type_prefix(w, type)
+ * --------------------------------------------------------------------------
+ * Writes the part of a C declarator of the given type that precedes the
+ * declared name.  Returns true if a space is needed before the name.
+ * Enumerated values of an enumeration type are entered into the current
+ * scope.
+ * ----------------------------------------------------------------------- */
+
+static bool write_type_prefix (c99_writer_s *w, m2c_astnode_t type) {
+  m2c_astnode_t target, lower;
+  m2c_ast_nodetype_t target_type;
+  bool space;
+  
+  switch (m2c_ast_nodetype(type)) {
+    case AST_IDENT :
+    case AST_QUALIDENT :
+      write_name(w, type);
+      return true;
+  
+    case AST_SUBR :
+      if (m2c_ast_nodetype(subnode(type, 2)) != AST_EMPTY) {
+        return write_type_prefix(w, subnode(type, 2));
+      } /* end if */
+  
+      lower = subnode(type, 0);
+  
+      if ((m2c_ast_nodetype(lower) == AST_CHRVAL) ||
+          (m2c_ast_nodetype(lower) == AST_QUOTEDVAL)) {
+        emit_str(w, "char");
+      }
+      else {
+        emit_str(w, "int");
+      } /* end if */
+      return true;
+  
+    case AST_ENUM :
+      write_enum(w, type);
+      return true;
+  
+    case AST_SET :
+      emit_str(w, "unsigned");
+      return true;
+  
+    case AST_ARRAY :
+      return write_type_prefix(w, subnode(type, 1));
+  
+    case AST_RECORD :
+    case AST_EXTREC :
+    case AST_VRNTREC :
+    case AST_VSREC :
+      emit_str(w, "struct ");
+      write_record_body(w, type);
+      return true;
+  
+    case AST_POINTER :
+      target = subnode(type, 0);
+      target_type = m2c_ast_nodetype(target);
+      space = write_type_prefix(w, target);
+  
+      if (space) {
+        emit_char(w, ' ');
+      } /* end if */
+  
+      if ((target_type == AST_ARRAY) || (target_type == AST_PROCTYPE)) {
+        emit_str(w, "(*");
+      }
+      else {
+        emit_char(w, '*');
+      } /* end if */
+      return false;
+  
+    case AST_PROCTYPE :
+      if (m2c_ast_nodetype(subnode(type, 1)) == AST_EMPTY) {
+        emit_str(w, "void");
+      }
+      else {
+        write_type_prefix(w, subnode(type, 1));
+      } /* end if */
+  
+      emit_str(w, " (*");
+      return false;
+  
+    default :
+      emit_str(w, "int");
+      return true;
+  } /* end switch */
+} /* end write_type_prefix */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_type_suffix(w, type)
+ * --------------------------------------------------------------------------
+ * Writes the part of a C declarator of the given type that follows the
+ * declared name.  Arrays are not rebased, an array is given one element
+ * more than the upper bound of its index type.
+ * ----------------------------------------------------------------------- */
+
+static void write_type_suffix (c99_writer_s *w, m2c_astnode_t type) {
+  m2c_astnode_t idxlist, target, ftlist, ftype;
+  m2c_ast_nodetype_t target_type;
+  uint_t index, count;
+  char mode;
+  
+  switch (m2c_ast_nodetype(type)) {
+    case AST_ARRAY :
+      idxlist = subnode(type, 0);
+      count = list_count(idxlist);
+  
+      for (index = 0; index < count; index++) {
+        emit_char(w, '[');
+        write_index_size(w, subnode(idxlist, index));
+        emit_char(w, ']');
+      } /* end for */
+  
+      write_type_suffix(w, subnode(type, 1));
+      break;
+  
+    case AST_POINTER :
+      target = subnode(type, 0);
+      target_type = m2c_ast_nodetype(target);
+  
+      if ((target_type == AST_ARRAY) || (target_type == AST_PROCTYPE)) {
+        emit_char(w, ')');
+      } /* end if */
+  
+      write_type_suffix(w, target);
+      break;
+  
+    case AST_PROCTYPE :
+      emit_str(w, ") (");
+      ftlist = subnode(type, 0);
+      count = list_count(ftlist);
+  
+      for (index = 0; index < count; index++) {
+        ftype = subnode(ftlist, index);
+        mode = mode_for_formal_type(m2c_ast_nodetype(ftype),
+          m2c_ast_nodetype(subnode(ftype, 0)));
+  
+        if (index > 0) {
+          emit_str(w, ", ");
+        } /* end if */
+  
+        if ((m2c_ast_nodetype(ftype) == AST_VARP) ||
+            (m2c_ast_nodetype(ftype) == AST_CONSTP)) {
+          ftype = subnode(ftype, 0);
+        } /* end if */
+  
+        if (m2c_ast_nodetype(ftype) == AST_OPENARRAY) {
+          ftype = subnode(ftype, 0);
+        } /* end if */
+  
+        write_type_prefix(w, ftype);
+  
+        if (mode != C99_MODE_VALUE) {
+          emit_str(w, " *");
+        } /* end if */
+  
+        if (mode == C99_MODE_OPEN) {
+          emit_str(w, ", unsigned");
+        } /* end if */
+      } /* end for */
+  
+      if (count == 0) {
+        emit_str(w, "void");
+      } /* end if */
+  
+      emit_char(w, ')');
+      break;
+  
+    default :
+      break;
+  } /* end switch */
+} /* end write_type_suffix */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_index_size(w, idxtype)
+ * --------------------------------------------------------------------------
+ * Writes the number of elements of an array with index type idxtype.
+ * ----------------------------------------------------------------------- */
+
+static void write_index_size (c99_writer_s *w, m2c_astnode_t idxtype) {
+  c99_symbol_s *symbol;
+  
+  switch (m2c_ast_nodetype(idxtype)) {
+    case AST_SUBR :
+      emit_char(w, '(');
+      write_expr(w, subnode(idxtype, 1));
+      emit_str(w, ") + 1");
+      break;
+  
+    case AST_ENUM :
+      emit_uint(w, m2c_ast_subnode_count(subnode(idxtype, 0)));
+      break;
+  
+    case AST_IDENT :
+    case AST_QUALIDENT :
+      symbol = type_symbol(w, idxtype);
+  
+      if ((symbol != NULL) && (symbol->info != NULL)) {
+        emit_str(w, (symbol->info->size != NULL) ?
+          symbol->info->size : "1");
+      }
+      else {
+        write_name(w, idxtype);
+        emit_str(w, "__MAX + 1");
+      } /* end if */
+      break;
+  
+    default :
+      emit_char(w, '1');
+      break;
+  } /* end switch */
+} /* end write_index_size */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_enum(w, enumtype)
+ * --------------------------------------------------------------------------
+ * Writes C enumeration type enumtype and enters its enumerated values into
+ * the current scope.  At module level they are prefixed like any other
+ * identifier declared there, within a procedure like hoisted identifiers.
+ * ----------------------------------------------------------------------- */
+
+static void write_enum (c99_writer_s *w, m2c_astnode_t enumtype) {
+  m2c_astnode_t idlist;
+  c99_symbol_s *symbol;
+  uint_t index, count;
+  
+  idlist = subnode(enumtype, 0);
+  count = m2c_ast_subnode_count(idlist);
+  
+  emit_str(w, "enum { ");
+  
+  for (index = 0; index < count; index++) {
+    symbol = declare_value(w,
+      m2c_ast_value_for_index(idlist, index), C99_SYM_CONST, true);
+  
+    if (index > 0) {
+      emit_str(w, ", ");
+    } /* end if */
+  
+    if (symbol != NULL) {
+      emit_str(w, symbol->cname);
+    } /* end if */
+  } /* end for */
+  
+  emit_str(w, " }");
+} /* end write_enum */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_record_body(w, rectype)
+ * --------------------------------------------------------------------------
+ * Writes the member declarations of record type rectype in braces.  Field
+ * names are not prefixed.  The variants of a variant record are laid out
+ * one after the other rather than overlaid.  The base type of an extended
+ * record is its first member, m2__base.  The variable size field of a
+ * variable size record is a flexible array member.
+ * ----------------------------------------------------------------------- */
+
+static void write_record_body (c99_writer_s *w, m2c_astnode_t rectype) {
+  m2c_astnode_t vsfield;
+  
+  emit_str(w, "{\n");
+  w->indent++;
+  
+  switch (m2c_ast_nodetype(rectype)) {
+    case AST_RECORD :
+      write_field_list_seq(w, subnode(rectype, 0));
+      break;
+  
+    case AST_EXTREC :
+      emit_indent(w);
+      write_declarator(w, subnode(rectype, 0), "m2__base");
+      emit_str(w, ";\n");
+      write_field_list_seq(w, subnode(rectype, 1));
+      break;
+  
+    case AST_VRNTREC :
+      write_field_list_seq(w, subnode(rectype, 0));
+      break;
+  
+    case AST_VSREC :
+      write_field_list_seq(w, subnode(rectype, 0));
+      vsfield = subnode(rectype, 1);
+  
+      emit_indent(w);
+      write_type_prefix(w, subnode(vsfield, 2));
+      emit_char(w, ' ');
+      emit_str(w, local_name(w, m2c_ast_value(subnode(vsfield, 0))));
+      emit_str(w, "[];\n");
+      break;
+  
+    default :
+      break;
+  } /* end switch */
+  
+  w->indent--;
+  emit_indent(w);
+  emit_char(w, '}');
+} /* end write_record_body */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_field_list_seq(w, flseq)
+ * --------------------------------------------------------------------------
+ * Writes the member declarations of field list sequence or variant field
+ * list sequence flseq.
+ * ----------------------------------------------------------------------- */
+
+static void write_field_list_seq (c99_writer_s *w, m2c_astnode_t flseq) {
+  m2c_astnode_t item, caseid, vlist;
+  uint_t index, count, v_index, v_count;
+  
+  count = list_count(flseq);
+  for (index = 0; index < count; index++) {
+    item = subnode(flseq, index);
+  
+    switch (m2c_ast_nodetype(item)) {
+      case AST_FIELDLIST :
+        write_field_list(w, item);
+        break;
+  
+      case AST_VFLIST :
+        /* tag field */
+        caseid = subnode(item, 0);
+  
+        if (m2c_ast_nodetype(caseid) == AST_IDENT) {
+          emit_indent(w);
+          write_type_prefix(w, subnode(item, 1));
+          emit_char(w, ' ');
+          emit_str(w, local_name(w, m2c_ast_value(caseid)));
+          emit_str(w, ";\n");
+        } /* end if */
+  
+        /* variants, then the ELSE part */
+        vlist = subnode(item, 2);
+        v_count = list_count(vlist);
+  
+        for (v_index = 0; v_index < v_count; v_index++) {
+          write_field_list_seq(w, subnode(subnode(vlist, v_index), 1));
+        } /* end for */
+  
+        write_field_list_seq(w, subnode(item, 3));
+        break;
+  
+      default :
+        break;
+    } /* end switch */
+  } /* end for */
+} /* end write_field_list_seq */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_field_list(w, fieldlist)
+ * --------------------------------------------------------------------------
+ * Writes a member declaration for each field of field list fieldlist.
+ * ----------------------------------------------------------------------- */
+
+static void write_field_list (c99_writer_s *w, m2c_astnode_t fieldlist) {
+  m2c_astnode_t idlist, type;
+  uint_t index, count;
+  
+  idlist = subnode(fieldlist, 0);
+  type = subnode(fieldlist, 1);
+  count = m2c_ast_subnode_count(idlist);
+  
+  for (index = 0; index < count; index++) {
+    emit_indent(w);
+    write_declarator(w, type,
+      local_name(w, m2c_ast_value_for_index(idlist, index)));
+    emit_str(w, ";\n");
+  } /* end for */
+} /* end write_field_list */
+
+
+/* --------------------------------------------------------------------------
+ * private function is_record_type(type)
+ * --------------------------------------------------------------------------
+ * Returns true if type is a record type constructor, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+static bool is_record_type (m2c_astnode_t type) {
+  
+  switch (m2c_ast_nodetype(type)) {
+    case AST_RECORD :
+    case AST_EXTREC :
+    case AST_VRNTREC :
+    case AST_VSREC :
+      return true;
+  
+    default :
+      return false;
+  } /* end switch */
+} /* end is_record_type */
+
+
+/* --------------------------------------------------------------------------
+ * private function is_plain_type(type)
+ * --------------------------------------------------------------------------
+ * Returns true if the C declarator of type has no parts other than a type
+ * specifier, so that several names may share its declaration.
+ * ----------------------------------------------------------------------- */
+
+static bool is_plain_type (m2c_astnode_t type) {
+  
+  switch (m2c_ast_nodetype(type)) {
+    case AST_POINTER :
+    case AST_ARRAY :
+    case AST_PROCTYPE :
+      return false;
+  
+    default :
+      return true;
+  } /* end switch */
+} /* end is_plain_type */
+
+
+/* --------------------------------------------------------------------------
+ * private function type_symbol(w, type)
+ * --------------------------------------------------------------------------
+ * Returns the symbol of type identifier type, or NULL if type is not a type
+ * identifier or is not known.
+ * ----------------------------------------------------------------------- */
+
+static c99_symbol_s *type_symbol (c99_writer_s *w, m2c_astnode_t type) {
+  c99_symbol_s *symbol;
+  uint_t used;
+  
+  switch (m2c_ast_nodetype(type)) {
+    case AST_IDENT :
+      return resolve_ident(w, m2c_ast_value(type));
+  
+    case AST_QUALIDENT :
+      symbol = resolve_qualident(w, type, &used);
+  
+      if (used != m2c_ast_subnode_count(type)) {
+        return NULL;
+      } /* end if */
+      return symbol;
+  
+    default :
+      return NULL;
+  } /* end switch */
+} /* end type_symbol */
+
+
+/* --------------------------------------------------------------------------
+ * private function base_type(w, type)
+ * --------------------------------------------------------------------------
+ * Returns the type constructor that type identifier type stands for, or
+ * type itself if it is not a type identifier.  Returns NULL if the type is
+ * pervasive or its declaration is not available.
+ * ----------------------------------------------------------------------- */
+
+static m2c_astnode_t base_type (c99_writer_s *w, m2c_astnode_t type) {
+  c99_symbol_s *symbol;
+  uint_t steps;
+  
+  steps = 0;
+  while ((type != NULL) && (steps < C99_MAX_TYPE_CHAIN) &&
+         ((m2c_ast_nodetype(type) == AST_IDENT) ||
+          (m2c_ast_nodetype(type) == AST_QUALIDENT))) {
+    symbol = type_symbol(w, type);
+  
+    if ((symbol == NULL) || (symbol->kind != C99_SYM_TYPE)) {
+      return NULL;
+    } /* end if */
+  
+    type = symbol->node;
+    steps++;
+  } /* end while */
+  
+  if (steps == C99_MAX_TYPE_CHAIN) {
+    return NULL;
+  } /* end if */
+  
+  return type;
+} /* end base_type */
+
+
+/* --------------------------------------------------------------------------
+ * private function field_type(w, rectype, ident)
+ * --------------------------------------------------------------------------
+ * Returns the type of field ident of the record type that rectype stands
+ * for, or NULL if there is no such field or it is not known.
+ * ----------------------------------------------------------------------- */
+
+static m2c_astnode_t field_type
+  (c99_writer_s *w, m2c_astnode_t rectype, m2c_string_t ident) {
+  
+  m2c_astnode_t type, vsfield;
+  
+  rectype = base_type(w, rectype);
+  
+  switch (m2c_ast_nodetype(rectype)) {
+    case AST_RECORD :
+    case AST_VRNTREC :
+      return field_type_in_seq(w, subnode(rectype, 0), ident);
+  
+    case AST_EXTREC :
+      type = field_type_in_seq(w, subnode(rectype, 1), ident);
+  
+      if (type == NULL) {
+        type = field_type(w, subnode(rectype, 0), ident);
+      } /* end if */
+      return type;
+  
+    case AST_VSREC :
+      vsfield = subnode(rectype, 1);
+  
+      if (m2c_ast_value(subnode(vsfield, 0)) == ident) {
+        return subnode(vsfield, 2);
+      } /* end if */
+      return field_type_in_seq(w, subnode(rectype, 0), ident);
+  
+    default :
+      return NULL;
+  } /* end switch */
+} /* end field_type */
+
+
+/* --------------------------------------------------------------------------
+ * private function field_type_in_seq(w, flseq, ident)
+ * --------------------------------------------------------------------------
+ * Returns the type of field ident in field list sequence flseq, or NULL if
+ * there is no such field.
+ * ----------------------------------------------------------------------- */
+
+static m2c_astnode_t field_type_in_seq
+  (c99_writer_s *w, m2c_astnode_t flseq, m2c_string_t ident) {
+  
+  m2c_astnode_t item, idlist, vlist, type;
+  uint_t index, count, id_index, v_index, v_count;
+  
+  count = list_count(flseq);
+  for (index = 0; index < count; index++) {
+    item = subnode(flseq, index);
+  
+    if (m2c_ast_nodetype(item) == AST_FIELDLIST) {
+      idlist = subnode(item, 0);
+  
+      for (id_index = 0;
+           id_index < m2c_ast_subnode_count(idlist); id_index++) {
+        if (m2c_ast_value_for_index(idlist, id_index) == ident) {
+          return subnode(item, 1);
+        } /* end if */
+      } /* end for */
+    }
+    else if (m2c_ast_nodetype(item) == AST_VFLIST) {
+      if (m2c_ast_value(subnode(item, 0)) == ident) {
+        return subnode(item, 1);
+      } /* end if */
+  
+      vlist = subnode(item, 2);
+      v_count = list_count(vlist);
+  
+      for (v_index = 0; v_index < v_count; v_index++) {
+        type = field_type_in_seq(w,
+          subnode(subnode(vlist, v_index), 1), ident);
+  
+        if (type != NULL) {
+          return type;
+        } /* end if */
+      } /* end for */
+  
+      type = field_type_in_seq(w, subnode(item, 3), ident);
+  
+      if (type != NULL) {
+        return type;
+      } /* end if */
+    } /* end if */
+  } /* end for */
+  
+  return NULL;
+} /* end field_type_in_seq */
+
+
+/* --------------------------------------------------------------------------
+ * private function type_of_designator(w, desig)
+ * --------------------------------------------------------------------------
+ * Returns the type of designator desig, or NULL if it is not known.
+ * ----------------------------------------------------------------------- */
+
+static m2c_astnode_t type_of_designator
+  (c99_writer_s *w, m2c_astnode_t desig) {
+  
+  m2c_astnode_t type, tail, idxlist;
+  c99_symbol_s *symbol;
+  uint_t index, count, used;
+  
+  switch (m2c_ast_nodetype(desig)) {
+    case AST_IDENT :
+      symbol = resolve_ident(w, m2c_ast_value(desig));
+  
+      if ((symbol == NULL) || ((symbol->kind != C99_SYM_VAR) &&
+          (symbol->kind != C99_SYM_VAR_PARAM))) {
+        return NULL;
+      } /* end if */
+      return symbol->node;
+  
+    case AST_QUALIDENT :
+      symbol = resolve_qualident(w, desig, &used);
+  
+      if ((symbol == NULL) || ((symbol->kind != C99_SYM_VAR) &&
+          (symbol->kind != C99_SYM_VAR_PARAM))) {
+        return NULL;
+      } /* end if */
+  
+      type = symbol->node;
+      count = m2c_ast_subnode_count(desig);
+  
+      for (index = used; (index < count) && (type != NULL); index++) {
+        type = field_type(w, type, m2c_ast_value_for_index(desig, index));
+      } /* end for */
+      return type;
+  
+    case AST_DEREF :
+      type = base_type(w, type_of_designator(w, subnode(desig, 0)));
+  
+      if (m2c_ast_nodetype(type) != AST_POINTER) {
+        return NULL;
+      } /* end if */
+      return subnode(type, 0);
+  
+    case AST_DESIG :
+      type = type_of_designator(w, subnode(desig, 0));
+      tail = subnode(desig, 1);
+  
+      if (m2c_ast_nodetype(tail) == AST_FIELD) {
+        return field_type(w, type, m2c_ast_value(subnode(tail, 0)));
+      } /* end if */
+  
+      /* each index selects along one index type of an array */
+      count = list_count(tail);
+      used = 0;
+  
+      for (index = 0; index < count; index++) {
+        type = base_type(w, type);
+  
+        if (m2c_ast_nodetype(type) != AST_ARRAY) {
+          return NULL;
+        } /* end if */
+  
+        idxlist = subnode(type, 0);
+        used++;
+  
+        if (used == list_count(idxlist)) {
+          type = subnode(type, 1);
+          used = 0;
+        } /* end if */
+      } /* end for */
+  
+      return (used == 0) ? type : NULL;
+  
+    default :
+      return NULL;
+  } /* end switch */
+} /* end type_of_designator */
+
+
+/* --------------------------------------------------------------------------
+ * private function is_set_expr(w, expr)
+ * --------------------------------------------------------------------------
+ * Returns true if expression expr is known to be of a set type.
+ * ----------------------------------------------------------------------- */
+
+static bool is_set_expr (c99_writer_s *w, m2c_astnode_t expr) {
+  m2c_astnode_t type;
+  c99_symbol_s *symbol;
+  
+  switch (m2c_ast_nodetype(expr)) {
+    case AST_SETVAL :
+      return true;
+  
+    case AST_PLUS :
+    case AST_MINUS :
+    case AST_ASTERISK :
+    case AST_SOLIDUS :
+      return ((is_set_expr(w, subnode(expr, 0))) ||
+              (is_set_expr(w, subnode(expr, 1))));
+  
+    case AST_IDENT :
+    case AST_QUALIDENT :
+    case AST_DESIG :
+    case AST_DEREF :
+      /* a constant is a set if it is defined by a set value */
+      symbol = type_symbol(w, expr);
+  
+      if ((symbol != NULL) && (symbol->kind == C99_SYM_CONST)) {
+        return (m2c_ast_nodetype(symbol->node) == AST_SETVAL);
+      } /* end if */
+  
+      type = type_of_designator(w, expr);
+  
+      /* BITSET is pervasive */
+      symbol = type_symbol(w, type);
+  
+      if ((symbol != NULL) && (symbol->info != NULL)) {
+        return (strcmp(symbol->info->ident, "BITSET") == 0);
+      } /* end if */
+  
+      return (m2c_ast_nodetype(base_type(w, type)) == AST_SET);
+  
+    default :
+      return false;
+  } /* end switch */
+} /* end is_set_expr */
+
+
+/* --------------------------------------------------------------------------
+ * private function is_nonnegative_expr(w, expr)
+ * --------------------------------------------------------------------------
+ * Returns true if expression expr is known to be a whole number literal or
+ * to be of type CARDINAL, its value can then never be negative.
+ * ----------------------------------------------------------------------- */
+
+static bool is_nonnegative_expr (c99_writer_s *w, m2c_astnode_t expr) {
+  m2c_astnode_t type;
+  c99_symbol_s *symbol;
+  
+  switch (m2c_ast_nodetype(expr)) {
+    case AST_INTVAL :
+      return true;
+  
+    case AST_PLUS :
+    case AST_ASTERISK :
+    case AST_DIV :
+    case AST_MOD :
+      return ((is_nonnegative_expr(w, subnode(expr, 0))) &&
+              (is_nonnegative_expr(w, subnode(expr, 1))));
+  
+    case AST_IDENT :
+    case AST_QUALIDENT :
+    case AST_DESIG :
+    case AST_DEREF :
+      /* a constant is known if it is defined by a whole number literal */
+      symbol = type_symbol(w, expr);
+  
+      if ((symbol != NULL) && (symbol->kind == C99_SYM_CONST)) {
+        return (m2c_ast_nodetype(symbol->node) == AST_INTVAL);
+      } /* end if */
+  
+      type = type_of_designator(w, expr);
+  
+      /* CARDINAL is pervasive */
+      symbol = type_symbol(w, type);
+  
+      if ((symbol != NULL) && (symbol->info != NULL)) {
+        return (strcmp(symbol->info->ident, "CARDINAL") == 0);
+      } /* end if */
+  
+      return false;
+  
+    default :
+      return false;
+  } /* end switch */
+} /* end is_nonnegative_expr */
+
+
+/* --------------------------------------------------------------------------
+ * private function is_array_designator(w, expr)
+ * --------------------------------------------------------------------------
+ * Returns true if expression expr is a designator known to be of an array
+ * type, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+static bool is_array_designator (c99_writer_s *w, m2c_astnode_t expr) {
+  
+  return (m2c_ast_nodetype(
+    base_type(w, type_of_designator(w, expr))) == AST_ARRAY);
+} /* end is_array_designator */
+
+
+/* *********************************************************************** *
+ * Names and Symbols                                                       *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private function subnode(node, index)
+ * --------------------------------------------------------------------------
+ * Returns the subnode of node with the given index, or NULL if node is a
+ * terminal node or has no subnode with the given index.
+ * ----------------------------------------------------------------------- */
+
+static m2c_astnode_t subnode (m2c_astnode_t node, uint_t index) {
+  
+  if (NOT(m2c_ast_is_nonterminal_nodetype(m2c_ast_nodetype(node)))) {
+    return NULL;
+  } /* end if */
+  
+  return m2c_ast_subnode_for_index(node, index);
+} /* end subnode */
+
+
+/* --------------------------------------------------------------------------
+ * private function list_count(list)
+ * --------------------------------------------------------------------------
+ * Returns the number of subnodes of list node list, zero if list is empty.
+ * ----------------------------------------------------------------------- */
+
+static uint_t list_count (m2c_astnode_t list) {
+  
+  if (NOT(m2c_ast_is_nonterminal_nodetype(m2c_ast_nodetype(list)))) {
+    return 0;
+  } /* end if */
+  
+  return m2c_ast_subnode_count(list);
+} /* end list_count */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure emit_str(w, str)
+ * --------------------------------------------------------------------------
+ * Writes NUL terminated string str to the current sink of w.
+ * ----------------------------------------------------------------------- */
+
+static void emit_str (c99_writer_s *w, const char *str) {
+  m2c_outsink_write_str(w->out, str);
+} /* end emit_str */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure emit_char(w, ch)
+ * --------------------------------------------------------------------------
+ * Writes character ch to the current sink of w.
+ * ----------------------------------------------------------------------- */
+
+static void emit_char (c99_writer_s *w, char ch) {
+  m2c_outsink_write_char(w->out, ch);
+} /* end emit_char */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure emit_uint(w, value)
+ * --------------------------------------------------------------------------
+ * Writes the decimal representation of value to the current sink of w.
+ * ----------------------------------------------------------------------- */
+
+static void emit_uint (c99_writer_s *w, uint_t value) {
+  m2c_outsink_write_uint(w->out, value);
+} /* end emit_uint */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure emit_long(w, value)
+ * --------------------------------------------------------------------------
+ * Writes the decimal representation of signed value to the current sink
+ * of w.
+ * ----------------------------------------------------------------------- */
+
+static void emit_long (c99_writer_s *w, int64_t value) {
+  char digits[20];
+  uint64_t magnitude;
+  uint_t index;
+  
+  if (value < 0) {
+    emit_char(w, '-');
+    magnitude = (uint64_t) 0 - (uint64_t) value;
+  }
+  else {
+    magnitude = (uint64_t) value;
+  } /* end if */
+  
+  index = sizeof(digits);
+  do {
+    index--;
+    digits[index] = (char) ('0' + (magnitude % 10));
+    magnitude = magnitude / 10;
+  } while (magnitude > 0);
+  
+  m2c_outsink_write_chars(w->out, &digits[index], sizeof(digits) - index);
+} /* end emit_long */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure emit_indent(w)
+ * --------------------------------------------------------------------------
+ * Writes two spaces per indentation level of w to the current sink of w.
+ * ----------------------------------------------------------------------- */
+
+static void emit_indent (c99_writer_s *w) {
+  uint_t level;
+  
+  for (level = 0; level < w->indent; level++) {
+    m2c_outsink_write_chars(w->out, "  ", 2);
+  } /* end for */
+} /* end emit_indent */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure emit_line(w, str)
+ * --------------------------------------------------------------------------
+ * Writes an indented line with text str to the current sink of w.
+ * ----------------------------------------------------------------------- */
+
+static void emit_line (c99_writer_s *w, const char *str) {
+  
+  emit_indent(w);
+  m2c_outsink_write_str(w->out, str);
+  m2c_outsink_write_char(w->out, '\n');
+} /* end emit_line */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_comments(w, node)
+ * --------------------------------------------------------------------------
+ * Writes the comments attached to node, if comments are preserved, each as
+ * an indented C comment on a line of its own.  The Modula-2 delimiters are
+ * replaced by C delimiters, character sequences within the comment text
+ * that would start or end a C comment are broken up by a space.
+ * ----------------------------------------------------------------------- */
+
+static void write_comments (c99_writer_s *w, m2c_astnode_t node) {
+  
+  uint_t first, count, index, length, pos;
+  const char *text;
+  
+  if (NOT(m2t_comment_table_find(w->comments,
+      m2c_ast_view_origin(w->view, node), &first, &count))) {
+    return;
+  } /* end if */
+  
+  for (index = first; index < first + count; index++) {
+    text = m2t_comment_table_text(w->comments, index, &length);
+  
+    if (text == NULL) {
+      continue;
+    } /* end if */
+  
+    /* strip the delimiters of line and block comments */
+    if (text[0] == '!') {
+      text++;
+      length--;
+    }
+    else if (length >= 4) {
+      text = text + 2;
+      length = length - 4;
+    } /* end if */
+  
+    emit_indent(w);
+    emit_str(w, "/*");
+  
+    for (pos = 0; pos < length; pos++) {
+      if (text[pos] == ASCII_CR) {
+        continue;
+      } /* end if */
+  
+      emit_char(w, text[pos]);
+  
+      if ((pos + 1 < length) &&
+          (((text[pos] == '*') && (text[pos + 1] == '/')) ||
+           ((text[pos] == '/') && (text[pos + 1] == '*')))) {
+        emit_char(w, ' ');
+      } /* end if */
+    } /* end for */
+  
+    /* a trailing slash would start a nested comment */
+    if ((length > 0) && (text[length - 1] == '/')) {
+      emit_char(w, ' ');
+    } /* end if */
+  
+    emit_str(w, "*/\n");
+  } /* end for */
+} /* end write_comments */
+
+
+/* --------------------------------------------------------------------------
+ * private function new_name(w, length)
+ * --------------------------------------------------------------------------
+ * Allocates a name of the given length plus NUL terminator from the name
+ * pool of w.  Names are released together with the writer.  Returns NULL
+ * and sets the failed flag if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static char *new_name (c99_writer_s *w, uint_t length) {
+  c99_chunk_t chunk;
+  uint_t size;
+  char *name;
+  
+  chunk = w->chunk;
+  
+  if ((chunk == NULL) || (chunk->size - chunk->used < length + 1)) {
+    size = (length + 1 > C99_NAME_CHUNK_SIZE) ?
+      length + 1 : C99_NAME_CHUNK_SIZE;
+    chunk = malloc(sizeof(struct c99_chunk_s) + size);
+  
+    if (chunk == NULL) {
+      w->failed = true;
+      return NULL;
+    } /* end if */
+  
+    chunk->next = w->chunk;
+    chunk->used = 0;
+    chunk->size = size;
+    w->chunk = chunk;
+  } /* end if */
+  
+  name = chunk->text + chunk->used;
+  chunk->used = chunk->used + length + 1;
+  
+  return name;
+} /* end new_name */
+
+
+/* --------------------------------------------------------------------------
+ * private function compare_words(key, word)
+ * --------------------------------------------------------------------------
+ * Compares a string with an entry of the reserved word table, for bsearch.
+ * ----------------------------------------------------------------------- */
+
+static int compare_words (const void *key, const void *word) {
+  return strcmp((const char *) key, *(const char *const *) word);
+} /* end compare_words */
+
+
+/* --------------------------------------------------------------------------
+ * private function local_name(w, ident)
+ * --------------------------------------------------------------------------
+ * Returns the C name of a local variable, parameter or field ident.  It is
+ * the identifier itself, with suffix __ if it is reserved in C.
+ * ----------------------------------------------------------------------- */
+
+static const char *local_name (c99_writer_s *w, m2c_string_t ident) {
+  const char *chars;
+  uint_t length;
+  char *name;
+  
+  chars = m2c_string_char_ptr(ident);
+  
+  if ((chars == NULL) || (bsearch(chars, reserved_word,
+      RESERVED_WORD_COUNT, sizeof(char *), compare_words) == NULL)) {
+    return chars;
+  } /* end if */
+  
+  length = m2c_string_length(ident);
+  name = new_name(w, length + 2);
+  
+  if (name == NULL) {
+    return chars;
+  } /* end if */
+  
+  memcpy(name, chars, length);
+  memcpy(name + length, "__", 3);
+  
+  return name;
+} /* end local_name */
+
+
+/* --------------------------------------------------------------------------
+ * private function prefixed_name(w, prefix, ident)
+ * --------------------------------------------------------------------------
+ * Returns C name prefix__ident.  Prefixed names never clash with C.
+ * ----------------------------------------------------------------------- */
+
+static const char *prefixed_name
+  (c99_writer_s *w, const char *prefix, m2c_string_t ident) {
+  
+  uint_t prefix_length, length;
+  char *name;
+  
+  prefix_length = strlen(prefix);
+  length = m2c_string_length(ident);
+  name = new_name(w, prefix_length + 2 + length);
+  
+  if (name == NULL) {
+    return m2c_string_char_ptr(ident);
+  } /* end if */
+  
+  memcpy(name, prefix, prefix_length);
+  memcpy(name + prefix_length, "__", 2);
+  memcpy(name + prefix_length + 2, m2c_string_char_ptr(ident), length + 1);
+  
+  return name;
+} /* end prefixed_name */
+
+
+/* --------------------------------------------------------------------------
+ * private function symbol_hash(scope, ident)
+ * --------------------------------------------------------------------------
+ * Returns the hash value of the pair of scope key and interned identifier.
+ * ----------------------------------------------------------------------- */
+
+static uint_t symbol_hash (const void *scope, m2c_string_t ident) {
+  uintptr_t hash;
+  
+  hash = (((uintptr_t) scope) >> 3) * 31 + (((uintptr_t) ident) >> 3);
+  hash = (hash ^ (hash >> 16)) * 0x45d9f3b;
+  hash = hash ^ (hash >> 16);
+  
+  return (uint_t) hash;
+} /* end symbol_hash */
+
+
+/* --------------------------------------------------------------------------
+ * private function lookup_symbol(w, scope, ident)
+ * --------------------------------------------------------------------------
+ * Returns the symbol for ident in the given scope, or NULL if there is none.
+ * ----------------------------------------------------------------------- */
+
+static c99_symbol_s *lookup_symbol
+  (c99_writer_s *w, const void *scope, m2c_string_t ident) {
+  
+  c99_symbol_s *symbol;
+  uint_t index, mask;
+  
+  mask = w->capacity - 1;
+  index = symbol_hash(scope, ident) & mask;
+  symbol = &w->symbol[index];
+  
+  while (symbol->ident != NULL) {
+    if ((symbol->ident == ident) && (symbol->scope == scope)) {
+      return symbol;
+    } /* end if */
+  
+    index = (index + 1) & mask;
+    symbol = &w->symbol[index];
+  } /* end while */
+  
+  return NULL;
+} /* end lookup_symbol */
+
+
+/* --------------------------------------------------------------------------
+ * private function enter_symbol(w, scope, ident, kind, cname)
+ * --------------------------------------------------------------------------
+ * Enters a symbol for ident with the given kind and C name into the given
+ * scope, replacing any symbol for ident already in that scope.  Returns the
+ * symbol, or NULL if allocation failed.  The symbol is valid until the next
+ * symbol is entered.
+ * ----------------------------------------------------------------------- */
+
+static c99_symbol_s *enter_symbol
+  (c99_writer_s *w, const void *scope, m2c_string_t ident,
+   c99_symkind_t kind, const char *cname) {
+  
+  c99_symbol_s *symbol;
+  uint_t index, mask;
+  
+  if ((ident == NULL) || (w->symbol == NULL)) {
+    return NULL;
+  } /* end if */
+  
+  symbol = lookup_symbol(w, scope, ident);
+  
+  if (symbol == NULL) {
+    /* keep the load factor of the table at or below one half */
+    if ((w->count + 1) * 2 > w->capacity) {
+      if (NOT(grow_symbol_table(w))) {
+        w->failed = true;
+        return NULL;
+      } /* end if */
+    } /* end if */
+  
+    mask = w->capacity - 1;
+    index = symbol_hash(scope, ident) & mask;
+  
+    while (w->symbol[index].ident != NULL) {
+      index = (index + 1) & mask;
+    } /* end while */
+  
+    symbol = &w->symbol[index];
+    w->count++;
+  } /* end if */
+  
+  memset(symbol, 0, sizeof(c99_symbol_s));
+  symbol->scope = scope;
+  symbol->ident = ident;
+  symbol->kind = kind;
+  symbol->cname = cname;
+  
+  return symbol;
+} /* end enter_symbol */
+
+
+/* --------------------------------------------------------------------------
+ * private function grow_symbol_table(w)
+ * --------------------------------------------------------------------------
+ * Doubles the capacity of the symbol table of w.  Returns true on success,
+ * false if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static bool grow_symbol_table (c99_writer_s *w) {
+  c99_symbol_s *old_table, *new_table;
+  uint_t old_capacity, index, new_index, mask;
+  
+  old_table = w->symbol;
+  old_capacity = w->capacity;
+  new_table = calloc(old_capacity * 2, sizeof(c99_symbol_s));
+  
+  if (new_table == NULL) {
+    return false;
+  } /* end if */
+  
+  mask = old_capacity * 2 - 1;
+  for (index = 0; index < old_capacity; index++) {
+    if (old_table[index].ident != NULL) {
+      new_index =
+        symbol_hash(old_table[index].scope, old_table[index].ident) & mask;
+  
+      while (new_table[new_index].ident != NULL) {
+        new_index = (new_index + 1) & mask;
+      } /* end while */
+  
+      new_table[new_index] = old_table[index];
+    } /* end if */
+  } /* end for */
+  
+  free(old_table);
+  w->symbol = new_table;
+  w->capacity = old_capacity * 2;
+  
+  return true;
+} /* end grow_symbol_table */
+
+
+/* --------------------------------------------------------------------------
+ * private function declare_value(w, ident, kind, hoisted)
+ * --------------------------------------------------------------------------
+ * Declares ident with the given kind in the current scope and returns its
+ * symbol.  A symbol already declared with the same kind is reused, so that
+ * each identifier is mangled only once.  Identifiers at module level and
+ * hoisted identifiers are prefixed with the C name of the enclosing module
+ * or procedure, others are local names.  Returns NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+static c99_symbol_s *declare_value
+  (c99_writer_s *w, m2c_string_t ident, c99_symkind_t kind, bool hoisted) {
+  
+  c99_symbol_s *symbol;
+  const char *cname;
+  
+  if (ident == NULL) {
+    return NULL;
+  } /* end if */
+  
+  symbol = lookup_symbol(w, w->scope[w->depth], ident);
+  
+  if ((symbol != NULL) && (symbol->kind == kind)) {
+    return symbol;
+  } /* end if */
+  
+  /* an identifier used before its declaration keeps its C name */
+  if ((symbol != NULL) && (symbol->kind == C99_SYM_OTHER)) {
+    cname = symbol->cname;
+  }
+  else if ((hoisted) || (w->depth == 0)) {
+    cname = prefixed_name(w, w->prefix[w->depth], ident);
+  }
+  else {
+    cname = local_name(w, ident);
+  } /* end if */
+  
+  return enter_symbol(w, w->scope[w->depth], ident, kind, cname);
+} /* end declare_value */
+
+
+/* --------------------------------------------------------------------------
+ * private function declare_ident(w, id, kind, hoisted)
+ * --------------------------------------------------------------------------
+ * Declares the identifier of terminal node id, see declare_value.
+ * ----------------------------------------------------------------------- */
+
+static c99_symbol_s *declare_ident
+  (c99_writer_s *w, m2c_astnode_t id, c99_symkind_t kind, bool hoisted) {
+  
+  return declare_value(w, m2c_ast_value(id), kind, hoisted);
+} /* end declare_ident */
+
+
+/* --------------------------------------------------------------------------
+ * private function resolve_ident(w, ident)
+ * --------------------------------------------------------------------------
+ * Returns the symbol that ident denotes in the current scope, searching the
+ * enclosing scopes outwards and then the pervasive identifiers.  Returns
+ * NULL if ident is not known.
+ * ----------------------------------------------------------------------- */
+
+static c99_symbol_s *resolve_ident (c99_writer_s *w, m2c_string_t ident) {
+  c99_symbol_s *symbol;
+  uint_t level;
+  
+  if (ident == NULL) {
+    return NULL;
+  } /* end if */
+  
+  level = w->depth + 1;
+  while (level > 0) {
+    level--;
+    symbol = lookup_symbol(w, w->scope[level], ident);
+  
+    if (symbol != NULL) {
+      return symbol;
+    } /* end if */
+  } /* end while */
+  
+  return lookup_symbol(w, pervasive_scope, ident);
+} /* end resolve_ident */
+
+
+/* --------------------------------------------------------------------------
+ * private function resolve_qualident(w, qualident, used)
+ * --------------------------------------------------------------------------
+ * Returns the symbol that the leading identifiers of qualified identifier
+ * qualident denote.  If the first identifier denotes an imported module,
+ * the symbol is that of the second identifier within the module, otherwise
+ * that of the first identifier.  Passes the number of identifiers used back
+ * in used.  Returns NULL if the symbol is not known.
+ * ----------------------------------------------------------------------- */
+
+static c99_symbol_s *resolve_qualident
+  (c99_writer_s *w, m2c_astnode_t qualident, uint_t *used) {
+  
+  c99_symbol_s *symbol;
+  c99_symbol_s modsym;
+  
+  WRITE_OUTPARAM(used, 1);
+  symbol = resolve_ident(w, m2c_ast_value_for_index(qualident, 0));
+  
+  if ((symbol == NULL) || (m2c_ast_subnode_count(qualident) < 2) ||
+      ((symbol->kind != C99_SYM_MODULE) &&
+       (symbol->kind != C99_SYM_SYSTEM))) {
+    return symbol;
+  } /* end if */
+  
+  /* the symbol of the module may move when a new symbol is entered */
+  modsym = *symbol;
+  WRITE_OUTPARAM(used, 2);
+  
+  return qualified_symbol(w, &modsym,
+    m2c_ast_value_for_index(qualident, 1));
+} /* end resolve_qualident */
+
+
+/* --------------------------------------------------------------------------
+ * private function cname_for_ident(w, ident)
+ * --------------------------------------------------------------------------
+ * Returns the C name of the entity that ident denotes in the current scope.
+ * An identifier that is not known is assumed to be declared at module
+ * level later on, or by the definition module of the module translated.
+ * ----------------------------------------------------------------------- */
+
+static const char *cname_for_ident (c99_writer_s *w, m2c_string_t ident) {
+  c99_symbol_s *symbol;
+  
+  symbol = resolve_ident(w, ident);
+  
+  if (symbol == NULL) {
+    symbol = enter_symbol(w, w->scope[0], ident, C99_SYM_OTHER,
+      prefixed_name(w, w->prefix[0], ident));
+  } /* end if */
+  
+  if ((symbol == NULL) || (symbol->cname == NULL)) {
+    return m2c_string_char_ptr(ident);
+  } /* end if */
+  
+  return symbol->cname;
+} /* end cname_for_ident */
+
+
+/* *********************************************************************** *
+ * Statements                                                              *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private procedure write_statement_seq(w, stmtseq)
+ * --------------------------------------------------------------------------
+ * Translates the statements of statement sequence stmtseq.
+ * ----------------------------------------------------------------------- */
+
+static void write_statement_seq (c99_writer_s *w, m2c_astnode_t stmtseq) {
+  uint_t index, count;
+  
+  count = list_count(stmtseq);
+  for (index = 0; index < count; index++) {
+    write_statement(w, subnode(stmtseq, index));
+  } /* end for */
+} /* end write_statement_seq */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_statement(w, stmt)
+ * --------------------------------------------------------------------------
+ * Translates statement stmt.
+ * ----------------------------------------------------------------------- */
+
+static void write_statement (c99_writer_s *w, m2c_astnode_t stmt) {
+  
+  switch (m2c_ast_nodetype(stmt)) {
+    case AST_ASSIGN :
+      write_assignment(w, subnode(stmt, 0), subnode(stmt, 1));
+      break;
+  
+    case AST_PCALL :
+      emit_indent(w);
+      write_call(w, subnode(stmt, 0), subnode(stmt, 1));
+      emit_str(w, ";\n");
+      break;
+  
+    /* procedure call without parameter list */
+    case AST_IDENT :
+    case AST_QUALIDENT :
+    case AST_DESIG :
+    case AST_DEREF :
+      emit_indent(w);
+      write_call(w, stmt, NULL);
+      emit_str(w, ";\n");
+      break;
+  
+    case AST_RETURN :
+      emit_indent(w);
+  
+      if (m2c_ast_nodetype(subnode(stmt, 0)) == AST_EMPTY) {
+        emit_str(w, "return;\n");
+      }
+      else {
+        emit_str(w, "return ");
+        write_expr(w, subnode(stmt, 0));
+        emit_str(w, ";\n");
+      } /* end if */
+      break;
+  
+    case AST_WITH :
+      write_with(w, stmt);
+      break;
+  
+    case AST_IF :
+      write_if(w, stmt);
+      break;
+  
+    case AST_SWITCH :
+      write_case(w, stmt);
+      break;
+  
+    case AST_LOOP :
+      write_loop(w, stmt);
+      break;
+  
+    case AST_WHILE :
+      emit_indent(w);
+      emit_str(w, "while (");
+      write_expr(w, subnode(stmt, 0));
+      emit_str(w, ") {\n");
+      write_block(w, subnode(stmt, 1));
+      emit_line(w, "} /* end while */");
+      break;
+  
+    case AST_REPEAT :
+      emit_line(w, "do {");
+      write_block(w, subnode(stmt, 0));
+      emit_indent(w);
+      emit_str(w, "} while (!");
+      write_operand(w, subnode(stmt, 1));
+      emit_str(w, "); /* end repeat */\n");
+      break;
+  
+    case AST_FORTO :
+      write_for(w, stmt);
+      break;
+  
+    case AST_EXIT :
+      emit_indent(w);
+  
+      if (w->exit_label == 0) {
+        emit_str(w, "break;\n");
+      }
+      else {
+        w->exit_used = true;
+        emit_str(w, "goto m2__exit_");
+        emit_uint(w, w->exit_label);
+        emit_str(w, ";\n");
+      } /* end if */
+      break;
+  
+    case AST_EMPTY :
+    case AST_INVALID :
+      break;
+  
+    default :
+      emit_line(w, "/* statement not translated */");
+      break;
+  } /* end switch */
+} /* end write_statement */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_block(w, stmtseq)
+ * --------------------------------------------------------------------------
+ * Translates statement sequence stmtseq one indentation level deeper.
+ * ----------------------------------------------------------------------- */
+
+static void write_block (c99_writer_s *w, m2c_astnode_t stmtseq) {
+  
+  w->indent++;
+  write_statement_seq(w, stmtseq);
+  w->indent--;
+} /* end write_block */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_assignment(w, desig, expr)
+ * --------------------------------------------------------------------------
+ * Translates the assignment of expression expr to designator desig.  Strings
+ * are copied with M2__STRCPY, arrays with M2__COPY.
+ * ----------------------------------------------------------------------- */
+
+static void write_assignment
+  (c99_writer_s *w, m2c_astnode_t desig, m2c_astnode_t expr) {
+  
+  m2c_ast_nodetype_t expr_type;
+  bool is_string, is_array;
+  
+  expr_type = m2c_ast_nodetype(expr);
+  is_string = (expr_type == AST_QUOTEDVAL);
+  is_array = is_array_designator(w, desig);
+  
+  emit_indent(w);
+  
+  if ((is_string) &&
+      ((is_array) || (m2c_string_length(m2c_ast_value(expr)) != 1))) {
+    emit_str(w, "M2__STRCPY(");
+    write_expr(w, desig);
+    emit_str(w, ", ");
+    write_string(w, m2c_ast_value(expr));
+    emit_str(w, ");\n");
+  }
+  else if ((is_array) && (is_array_designator(w, expr))) {
+    emit_str(w, "M2__COPY(");
+    write_expr(w, desig);
+    emit_str(w, ", ");
+    write_expr(w, expr);
+    emit_str(w, ");\n");
+  }
+  else {
+    write_expr(w, desig);
+    emit_str(w, " = ");
+    write_expr(w, expr);
+    emit_str(w, ";\n");
+  } /* end if */
+} /* end write_assignment */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_with(w, with)
+ * --------------------------------------------------------------------------
+ * Translates WITH statement with.  Its designator is recorded so that the
+ * identifiers of the fields of the record it designates are translated to
+ * member accesses.  The designator is evaluated at each such access.
+ * ----------------------------------------------------------------------- */
+
+static void write_with (c99_writer_s *w, m2c_astnode_t with) {
+  
+  if (w->with_depth >= C99_MAX_WITH_DEPTH) {
+    w->failed = true;
+    return;
+  } /* end if */
+  
+  w->with[w->with_depth] = subnode(with, 0);
+  w->with_depth++;
+  
+  emit_line(w, "{ /* with */");
+  write_block(w, subnode(with, 1));
+  emit_line(w, "} /* end with */");
+  
+  w->with_depth--;
+} /* end write_with */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_if(w, ifstmt)
+ * --------------------------------------------------------------------------
+ * Translates IF statement ifstmt.
+ * ----------------------------------------------------------------------- */
+
+static void write_if (c99_writer_s *w, m2c_astnode_t ifstmt) {
+  m2c_astnode_t elsifseq, elsif, elseseq;
+  uint_t index, count;
+  
+  emit_indent(w);
+  emit_str(w, "if (");
+  write_expr(w, subnode(ifstmt, 0));
+  emit_str(w, ") {\n");
+  write_block(w, subnode(ifstmt, 1));
+  
+  elsifseq = subnode(ifstmt, 2);
+  count = list_count(elsifseq);
+  
+  for (index = 0; index < count; index++) {
+    elsif = subnode(elsifseq, index);
+  
+    emit_line(w, "}");
+    emit_indent(w);
+    emit_str(w, "else if (");
+    write_expr(w, subnode(elsif, 0));
+    emit_str(w, ") {\n");
+    write_block(w, subnode(elsif, 1));
+  } /* end for */
+  
+  elseseq = subnode(ifstmt, 3);
+  
+  if (list_count(elseseq) > 0) {
+    emit_line(w, "}");
+    emit_line(w, "else {");
+    write_block(w, elseseq);
+  } /* end if */
+  
+  emit_line(w, "} /* end if */");
+} /* end write_if */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_case(w, casestmt)
+ * --------------------------------------------------------------------------
+ * Translates CASE statement casestmt on a copy of the case selector.  If
+ * all labels fold to distinct values, the statement is dispatched by a C
+ * switch statement, either directly on the selector if the labels are
+ * dense, or on the branch found by binary search if they are sparse.
+ * Otherwise it is translated to a chain of IF statements.  Without an ELSE
+ * part, a selector that matches no label aborts.
+ * ----------------------------------------------------------------------- */
+
+static void write_case (c99_writer_s *w, m2c_astnode_t casestmt) {
+  m2t_label_set_class_t dispatch;
+  uint_t label, mark;
+  
+  w->label++;
+  label = w->label;
+  
+  emit_line(w, "{ /* case */");
+  w->indent++;
+  emit_indent(w);
+  emit_str(w, "long m2__case_");
+  emit_uint(w, label);
+  emit_str(w, " = (long) ");
+  write_operand(w, subnode(casestmt, 0));
+  emit_str(w, ";\n");
+  
+  /* the labels of the statement are collected above mark */
+  mark = m2t_label_set_mark(w->labels);
+  dispatch = collect_case_labels(w, subnode(casestmt, 1), mark);
+  
+  switch (dispatch) {
+    case M2T_LABEL_SET_DENSE :
+      m2t_label_set_reset(w->labels, mark);
+      write_case_switch(w, casestmt, label);
+      break;
+    
+    case M2T_LABEL_SET_SPARSE :
+      write_case_search(w, casestmt, label, mark);
+      break;
+    
+    default :
+      m2t_label_set_reset(w->labels, mark);
+      write_case_chain(w, casestmt, label);
+  } /* end switch */
+  
+  w->indent--;
+  emit_line(w, "} /* end case */");
+} /* end write_case */
+
+
+/* --------------------------------------------------------------------------
+ * private function collect_case_labels(w, caselist, mark)
+ * --------------------------------------------------------------------------
+ * Folds the labels of the branches of case list caselist, adds them to the
+ * label set of w above mark, sorts and classifies them.  Each label is
+ * recorded with the index of its branch in caselist.  Returns the class
+ * of the labels, or M2T_LABEL_SET_EMPTY if any label cannot be folded or
+ * if any two labels share a value.
+ * ----------------------------------------------------------------------- */
+
+static m2t_label_set_class_t collect_case_labels
+  (c99_writer_s *w, m2c_astnode_t caselist, uint_t mark) {
+  
+  m2c_astnode_t variant, cllist;
+  uint_t index, count, lindex, lcount, order;
+  int64_t lower, upper;
+  
+  order = 0;
+  count = list_count(caselist);
+  
+  for (index = 0; index < count; index++) {
+    variant = subnode(caselist, index);
+  
+    if (m2c_ast_nodetype(variant) != AST_CASE) {
+      continue;
+    } /* end if */
+  
+    cllist = subnode(variant, 0);
+  
+    if (m2c_ast_nodetype(cllist) != AST_CLABELLIST) {
+      return M2T_LABEL_SET_EMPTY;
+    } /* end if */
+  
+    lcount = list_count(cllist);
+    for (lindex = 0; lindex < lcount; lindex++) {
+      if ((NOT(case_label_bounds(w,
+            subnode(cllist, lindex), &lower, &upper))) ||
+          (NOT(m2t_label_set_add(w->labels, lower, upper, index, order)))) {
+        return M2T_LABEL_SET_EMPTY;
+      } /* end if */
+  
+      order++;
+    } /* end for */
+  } /* end for */
+  
+  if (m2t_label_set_sort(w->labels, mark) > 0) {
+    return M2T_LABEL_SET_EMPTY;
+  } /* end if */
+  
+  return m2t_label_set_classify(w->labels, mark);
+} /* end collect_case_labels */
+
+
+/* --------------------------------------------------------------------------
+ * private function case_label_bounds(w, labels, lower, upper)
+ * --------------------------------------------------------------------------
+ * Folds the bounds of case labels labels and passes them back in lower and
+ * upper.  A label that is a single value is passed back in both.  Returns
+ * true on success, or false if a bound cannot be folded.
+ * ----------------------------------------------------------------------- */
+
+static bool case_label_bounds
+  (c99_writer_s *w, m2c_astnode_t labels, int64_t *lower, int64_t *upper) {
+  
+  m2c_astnode_t high;
+  
+  /* the parser may pass on the label expression without CLABELS node */
+  if (m2c_ast_nodetype(labels) == AST_CLABELS) {
+    high = subnode(labels, 1);
+    labels = subnode(labels, 0);
+  }
+  else {
+    high = NULL;
+  } /* end if */
+  
+  if (NOT(case_label_value(w, labels, lower))) {
+    return false;
+  } /* end if */
+  
+  if ((high == NULL) || (m2c_ast_nodetype(high) == AST_EMPTY)) {
+    *upper = *lower;
+    return true;
+  } /* end if */
+  
+  return case_label_value(w, high, upper);
+} /* end case_label_bounds */
+
+
+/* --------------------------------------------------------------------------
+ * private function case_label_value(w, expr, value)
+ * --------------------------------------------------------------------------
+ * Folds label expression expr and passes its value back in value.  Returns
+ * true on success, or false if expr does not fold to an ordinal value that
+ * compares equal to its translation when converted to long.  Characters
+ * beyond ASCII are not folded since the signedness of char is unknown.
+ * ----------------------------------------------------------------------- */
+
+static bool case_label_value
+  (c99_writer_s *w, m2c_astnode_t expr, int64_t *value) {
+  
+  m2t_const_value_t folded;
+  
+  if ((expr == NULL) || (NOT(m2t_const_fold(w->folder, expr, &folded)))) {
+    return false;
+  } /* end if */
+  
+  switch (folded.kind) {
+    case M2T_CONST_WHOLE :
+      if ((folded.value.whole < -LONG_MAX) ||
+          (folded.value.whole > LONG_MAX)) {
+        return false;
+      } /* end if */
+      *value = folded.value.whole;
+      return true;
+    
+    case M2T_CONST_CHAR :
+      if ((folded.value.whole < 0) || (folded.value.whole > 127)) {
+        return false;
+      } /* end if */
+      *value = folded.value.whole;
+      return true;
+    
+    case M2T_CONST_BOOLEAN :
+      *value = (folded.value.boolean) ? 1 : 0;
+      return true;
+    
+    default :
+      return false;
+  } /* end switch */
+} /* end case_label_value */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_case_chain(w, casestmt, label)
+ * --------------------------------------------------------------------------
+ * Writes the branches of CASE statement casestmt as a chain of IF
+ * statements on the case selector numbered label.
+ * ----------------------------------------------------------------------- */
+
+static void write_case_chain
+  (c99_writer_s *w, m2c_astnode_t casestmt, uint_t label) {
+  
+  m2c_astnode_t caselist, variant;
+  uint_t index, count;
+  bool first;
+  
+  caselist = subnode(casestmt, 1);
+  count = list_count(caselist);
+  first = true;
+  
+  for (index = 0; index < count; index++) {
+    variant = subnode(caselist, index);
+  
+    if (m2c_ast_nodetype(variant) != AST_CASE) {
+      continue;
+    } /* end if */
+  
+    if (NOT(first)) {
+      emit_line(w, "}");
+      emit_indent(w);
+      emit_str(w, "else if (");
+    }
+    else {
+      emit_indent(w);
+      emit_str(w, "if (");
+    } /* end if */
+  
+    first = false;
+    write_case_labels(w, subnode(variant, 0), label);
+    emit_str(w, ") {\n");
+    write_block(w, subnode(variant, 1));
+  } /* end for */
+  
+  if (NOT(first)) {
+    emit_line(w, "}");
+    emit_line(w, "else {");
+  }
+  else {
+    emit_line(w, "{");
+  } /* end if */
+  
+  write_case_default(w, subnode(casestmt, 2));
+  emit_line(w, "} /* end if */");
+} /* end write_case_chain */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_case_switch(w, casestmt, label)
+ * --------------------------------------------------------------------------
+ * Writes the branches of CASE statement casestmt as a switch statement on
+ * the case selector numbered label, with one case label per value.  The
+ * labels of casestmt must have been classified as dense.
+ * ----------------------------------------------------------------------- */
+
+static void write_case_switch
+  (c99_writer_s *w, m2c_astnode_t casestmt, uint_t label) {
+  
+  m2c_astnode_t caselist, variant, cllist;
+  uint_t index, count, lindex, lcount;
+  int64_t lower, upper;
+  uint64_t step;
+  
+  emit_indent(w);
+  emit_str(w, "switch (m2__case_");
+  emit_uint(w, label);
+  emit_str(w, ") {\n");
+  w->indent++;
+  
+  caselist = subnode(casestmt, 1);
+  count = list_count(caselist);
+  
+  for (index = 0; index < count; index++) {
+    variant = subnode(caselist, index);
+  
+    if (m2c_ast_nodetype(variant) != AST_CASE) {
+      continue;
+    } /* end if */
+  
+    /* bounds have been folded before, they are memoized */
+    cllist = subnode(variant, 0);
+    lcount = list_count(cllist);
+    for (lindex = 0; lindex < lcount; lindex++) {
+      case_label_bounds(w, subnode(cllist, lindex), &lower, &upper);
+  
+      /* counted by step, upper may be the largest value of long */
+      for (step = 0; step <= (uint64_t) (upper - lower); step++) {
+        emit_indent(w);
+        emit_str(w, "case ");
+        emit_long(w, lower + (int64_t) step);
+        emit_str(w, " :\n");
+      } /* end for */
+    } /* end for */
+  
+    write_block(w, subnode(variant, 1));
+    w->indent++;
+    emit_line(w, "break;");
+    w->indent--;
+  } /* end for */
+  
+  emit_line(w, "default :");
+  write_case_default(w, subnode(casestmt, 2));
+  w->indent--;
+  emit_line(w, "} /* end switch */");
+} /* end write_case_switch */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_case_search(w, casestmt, label, mark)
+ * --------------------------------------------------------------------------
+ * Writes the branches of CASE statement casestmt as a switch statement on
+ * the index of the branch whose labels match the case selector numbered
+ * label.  The index is found by a binary search over the sorted labels of
+ * casestmt, held in the label set of w above mark, which are released.
+ * ----------------------------------------------------------------------- */
+
+static void write_case_search
+  (c99_writer_s *w, m2c_astnode_t casestmt, uint_t label, uint_t mark) {
+  
+  m2c_astnode_t caselist, variant;
+  uint_t index, count;
+  
+  emit_indent(w);
+  emit_str(w, "int m2__branch_");
+  emit_uint(w, label);
+  emit_str(w, " = -1;\n");
+  
+  write_search_tree(w, label, mark, m2t_label_set_count(w->labels));
+  m2t_label_set_reset(w->labels, mark);
+  
+  emit_indent(w);
+  emit_str(w, "switch (m2__branch_");
+  emit_uint(w, label);
+  emit_str(w, ") {\n");
+  w->indent++;
+  
+  caselist = subnode(casestmt, 1);
+  count = list_count(caselist);
+  
+  for (index = 0; index < count; index++) {
+    variant = subnode(caselist, index);
+  
+    if (m2c_ast_nodetype(variant) != AST_CASE) {
+      continue;
+    } /* end if */
+  
+    emit_indent(w);
+    emit_str(w, "case ");
+    emit_uint(w, index);
+    emit_str(w, " :\n");
+    write_block(w, subnode(variant, 1));
+    w->indent++;
+    emit_line(w, "break;");
+    w->indent--;
+  } /* end for */
+  
+  emit_line(w, "default :");
+  write_case_default(w, subnode(casestmt, 2));
+  w->indent--;
+  emit_line(w, "} /* end switch */");
+} /* end write_case_search */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_search_tree(w, label, first, last)
+ * --------------------------------------------------------------------------
+ * Writes a binary search over the labels from index first up to but not
+ * including index last in the label set of w, which assigns the branch of
+ * the label that matches the case selector numbered label to the branch
+ * variable of the selector.  The labels must be sorted and must not
+ * overlap.
+ * ----------------------------------------------------------------------- */
+
+static void write_search_tree
+  (c99_writer_s *w, uint_t label, uint_t first, uint_t last) {
+  
+  const m2t_label_interval_t *interval;
+  uint_t middle;
+  
+  if (last - first > 1) {
+    middle = first + (last - first) / 2;
+    interval = m2t_label_set_interval(w->labels, middle);
+  
+    emit_indent(w);
+    emit_str(w, "if (m2__case_");
+    emit_uint(w, label);
+    emit_str(w, " < ");
+    emit_long(w, interval->lower);
+    emit_str(w, ") {\n");
+    w->indent++;
+    write_search_tree(w, label, first, middle);
+    w->indent--;
+    emit_line(w, "}");
+    emit_line(w, "else {");
+    w->indent++;
+    write_search_tree(w, label, middle, last);
+    w->indent--;
+    emit_line(w, "} /* end if */");
+    return;
+  } /* end if */
+  
+  interval = m2t_label_set_interval(w->labels, first);
+  
+  emit_indent(w);
+  emit_str(w, "if (m2__case_");
+  emit_uint(w, label);
+  
+  if (interval->lower == interval->upper) {
+    emit_str(w, " == ");
+    emit_long(w, interval->lower);
+  }
+  else {
+    emit_str(w, " >= ");
+    emit_long(w, interval->lower);
+    emit_str(w, " && m2__case_");
+    emit_uint(w, label);
+    emit_str(w, " <= ");
+    emit_long(w, interval->upper);
+  } /* end if */
+  
+  emit_str(w, ") {\n");
+  w->indent++;
+  emit_indent(w);
+  emit_str(w, "m2__branch_");
+  emit_uint(w, label);
+  emit_str(w, " = ");
+  emit_uint(w, interval->branch);
+  emit_str(w, ";\n");
+  w->indent--;
+  emit_line(w, "} /* end if */");
+} /* end write_search_tree */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_case_default(w, elseseq)
+ * --------------------------------------------------------------------------
+ * Writes the ELSE part elseseq of a CASE statement as a block, or an abort
+ * if it is empty.
+ * ----------------------------------------------------------------------- */
+
+static void write_case_default (c99_writer_s *w, m2c_astnode_t elseseq) {
+  
+  if (list_count(elseseq) > 0) {
+    write_block(w, elseseq);
+  }
+  else {
+    w->indent++;
+    emit_line(w, "M2__CASE_FAIL();");
+    w->indent--;
+  } /* end if */
+} /* end write_case_default */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_case_labels(w, cllist, label)
+ * --------------------------------------------------------------------------
+ * Writes the condition that the case selector numbered label matches one
+ * of the labels of case label list cllist.
+ * ----------------------------------------------------------------------- */
+
+static void write_case_labels
+  (c99_writer_s *w, m2c_astnode_t cllist, uint_t label) {
+  
+  m2c_astnode_t labels, upper;
+  uint_t index, count;
+  
+  count = list_count(cllist);
+  
+  if ((m2c_ast_nodetype(cllist) != AST_CLABELLIST) || (count == 0)) {
+    emit_str(w, "false");
+    return;
+  } /* end if */
+  
+  for (index = 0; index < count; index++) {
+    labels = subnode(cllist, index);
+  
+    if (index > 0) {
+      emit_str(w, " || ");
+    } /* end if */
+  
+    /* the parser may pass on the label expression without CLABELS node */
+    if (m2c_ast_nodetype(labels) == AST_CLABELS) {
+      upper = subnode(labels, 1);
+      labels = subnode(labels, 0);
+    }
+    else {
+      upper = NULL;
+    } /* end if */
+  
+    if (count > 1) {
+      emit_char(w, '(');
+    } /* end if */
+  
+    emit_str(w, "m2__case_");
+    emit_uint(w, label);
+  
+    if ((upper == NULL) || (m2c_ast_nodetype(upper) == AST_EMPTY)) {
+      emit_str(w, " == ");
+      write_operand(w, labels);
+    }
+    else {
+      emit_str(w, " >= ");
+      write_operand(w, labels);
+      emit_str(w, " && m2__case_");
+      emit_uint(w, label);
+      emit_str(w, " <= ");
+      write_operand(w, upper);
+    } /* end if */
+  
+    if (count > 1) {
+      emit_char(w, ')');
+    } /* end if */
+  } /* end for */
+} /* end write_case_labels */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_loop(w, loop)
+ * --------------------------------------------------------------------------
+ * Translates LOOP statement loop to an endless for statement.  An EXIT
+ * within the loop jumps to a label following the for statement, which is
+ * only written if it is used.
+ * ----------------------------------------------------------------------- */
+
+static void write_loop (c99_writer_s *w, m2c_astnode_t loop) {
+  uint_t exit_label;
+  bool exit_used;
+  
+  exit_label = w->exit_label;
+  exit_used = w->exit_used;
+  
+  w->label++;
+  w->exit_label = w->label;
+  w->exit_used = false;
+  
+  emit_line(w, "for (;;) {");
+  write_block(w, subnode(loop, 0));
+  emit_line(w, "} /* end loop */");
+  
+  if (w->exit_used) {
+    emit_indent(w);
+    emit_str(w, "m2__exit_");
+    emit_uint(w, w->exit_label);
+    emit_str(w, ": ;\n");
+  } /* end if */
+  
+  w->exit_label = exit_label;
+  w->exit_used = exit_used;
+} /* end write_loop */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_for(w, forstmt)
+ * --------------------------------------------------------------------------
+ * Translates FOR statement forstmt.  The loop counts down if the step value
+ * is negated, otherwise up.
+ * ----------------------------------------------------------------------- */
+
+static void write_for (c99_writer_s *w, m2c_astnode_t forstmt) {
+  m2c_astnode_t id, step;
+  bool down;
+  
+  id = subnode(forstmt, 0);
+  step = subnode(forstmt, 3);
+  down = (m2c_ast_nodetype(step) == AST_NEG);
+  
+  emit_indent(w);
+  emit_str(w, "for (");
+  write_expr(w, id);
+  emit_str(w, " = ");
+  write_expr(w, subnode(forstmt, 1));
+  emit_str(w, "; ");
+  write_expr(w, id);
+  emit_str(w, (down) ? " >= " : " <= ");
+  write_operand(w, subnode(forstmt, 2));
+  emit_str(w, "; ");
+  write_expr(w, id);
+  
+  if ((step == NULL) || (m2c_ast_nodetype(step) == AST_EMPTY)) {
+    emit_str(w, "++");
+  }
+  else {
+    emit_str(w, " += ");
+    write_operand(w, step);
+  } /* end if */
+  
+  emit_str(w, ") {\n");
+  write_block(w, subnode(forstmt, 4));
+  emit_line(w, "} /* end for */");
+} /* end write_for */
+
+
+/* *********************************************************************** *
+ * Expressions                                                             *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private procedure write_expr(w, expr)
+ * --------------------------------------------------------------------------
+ * Translates expression or designator expr.  Operands of operators are
+ * parenthesised unless they are simple, the expression itself is not.
+ * ----------------------------------------------------------------------- */
+
+static void write_expr (c99_writer_s *w, m2c_astnode_t expr) {
+  m2c_ast_nodetype_t node_type;
+  m2c_astnode_t tail;
+  uint_t index, count;
+  
+  node_type = m2c_ast_nodetype(expr);
+  
+  switch (node_type) {
+    case AST_INTVAL :
+      write_int_literal(w, m2c_ast_value(expr));
+      break;
+  
+    case AST_REALVAL :
+      emit_str(w, m2c_string_char_ptr(m2c_ast_value(expr)));
+      break;
+  
+    case AST_CHRVAL :
+      write_char_code(w, m2c_ast_value(expr));
+      break;
+  
+    case AST_QUOTEDVAL :
+      if (m2c_string_length(m2c_ast_value(expr)) == 1) {
+        write_char_literal(w, m2c_ast_value(expr));
+      }
+      else {
+        write_string(w, m2c_ast_value(expr));
+      } /* end if */
+      break;
+  
+    case AST_IDENT :
+      write_ident(w, m2c_ast_value(expr));
+      break;
+  
+    case AST_QUALIDENT :
+      write_qualident(w, expr);
+      break;
+  
+    case AST_DESIG :
+      write_expr(w, subnode(expr, 0));
+      tail = subnode(expr, 1);
+  
+      if (m2c_ast_nodetype(tail) == AST_FIELD) {
+        emit_char(w, '.');
+        emit_str(w, local_name(w, m2c_ast_value(subnode(tail, 0))));
+      }
+      else {
+        count = list_count(tail);
+  
+        for (index = 0; index < count; index++) {
+          emit_char(w, '[');
+          write_expr(w, subnode(tail, index));
+          emit_char(w, ']');
+        } /* end for */
+      } /* end if */
+      break;
+  
+    case AST_DEREF :
+      emit_str(w, "(*");
+      write_expr(w, subnode(expr, 0));
+      emit_char(w, ')');
+      break;
+  
+    case AST_FCALL :
+      write_call(w, subnode(expr, 0), subnode(expr, 1));
+      break;
+  
+    case AST_SETVAL :
+      write_set_value(w, subnode(expr, 1));
+      break;
+  
+    case AST_NEG :
+      emit_char(w, '-');
+      write_operand(w, subnode(expr, 0));
+      break;
+  
+    case AST_NOT :
+      emit_char(w, '!');
+      write_operand(w, subnode(expr, 0));
+      break;
+  
+    case AST_IN :
+      emit_str(w, "M2__IN(");
+      write_expr(w, subnode(expr, 0));
+      emit_str(w, ", ");
+      write_expr(w, subnode(expr, 1));
+      emit_char(w, ')');
+      break;
+  
+    case AST_EQ :
+    case AST_NEQ :
+    case AST_LT :
+    case AST_LTEQ :
+    case AST_GT :
+    case AST_GTEQ :
+    case AST_PLUS :
+    case AST_MINUS :
+    case AST_OR :
+    case AST_ASTERISK :
+    case AST_SOLIDUS :
+    case AST_DIV :
+    case AST_MOD :
+    case AST_AND :
+      write_binary(w, expr);
+      break;
+  
+    case AST_EMPTY :
+      break;
+  
+    default :
+      emit_str(w, "0 /* expression not translated */");
+      break;
+  } /* end switch */
+} /* end write_expr */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_operand(w, expr)
+ * --------------------------------------------------------------------------
+ * Translates expression expr as an operand, parenthesised unless simple.
+ * ----------------------------------------------------------------------- */
+
+static void write_operand (c99_writer_s *w, m2c_astnode_t expr) {
+  
+  switch (m2c_ast_nodetype(expr)) {
+    case AST_NEG :
+    case AST_NOT :
+    case AST_EQ :
+    case AST_NEQ :
+    case AST_LT :
+    case AST_LTEQ :
+    case AST_GT :
+    case AST_GTEQ :
+    case AST_PLUS :
+    case AST_MINUS :
+    case AST_OR :
+    case AST_ASTERISK :
+    case AST_SOLIDUS :
+    case AST_DIV :
+    case AST_MOD :
+    case AST_AND :
+      emit_char(w, '(');
+      write_expr(w, expr);
+      emit_char(w, ')');
+      break;
+  
+    default :
+      write_expr(w, expr);
+      break;
+  } /* end switch */
+} /* end write_operand */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_binary(w, expr)
+ * --------------------------------------------------------------------------
+ * Translates binary expression expr.  Arithmetic operators applied to sets
+ * are translated to bitwise operators, inclusion to mask tests.  DIV and
+ * MOD are translated to C division and remainder only if both operands are
+ * known to be non-negative, otherwise to calls of m2__div and m2__mod.
+ * ----------------------------------------------------------------------- */
+
+static void write_binary (c99_writer_s *w, m2c_astnode_t expr) {
+  m2c_astnode_t left, right;
+  const char *operator;
+  
+  left = subnode(expr, 0);
+  right = subnode(expr, 1);
+  
+  if ((is_set_expr(w, left)) || (is_set_expr(w, right))) {
+    switch (m2c_ast_nodetype(expr)) {
+      case AST_PLUS :
+        operator = " | ";
+        break;
+  
+      case AST_MINUS :
+        operator = " & ~";
+        break;
+  
+      case AST_ASTERISK :
+        operator = " & ";
+        break;
+  
+      case AST_SOLIDUS :
+        operator = " ^ ";
+        break;
+  
+      /* inclusion */
+      case AST_GTEQ :
+        right = left;
+        left = subnode(expr, 1);
+        /* fall through */
+  
+      case AST_LTEQ :
+        emit_char(w, '(');
+        write_operand(w, left);
+        emit_str(w, " & ~");
+        write_operand(w, right);
+        emit_str(w, ") == 0");
+        return;
+  
+      default :
+        operator = NULL;
+        break;
+    } /* end switch */
+  
+    if (operator != NULL) {
+      write_operand(w, left);
+      emit_str(w, operator);
+      write_operand(w, right);
+      return;
+    } /* end if */
+  } /* end if */
+  
+  /* C division truncates, DIV and MOD round towards negative infinity */
+  if (((m2c_ast_nodetype(expr) == AST_DIV) ||
+       (m2c_ast_nodetype(expr) == AST_MOD)) &&
+      ((NOT(is_nonnegative_expr(w, left))) ||
+       (NOT(is_nonnegative_expr(w, right))))) {
+    if (m2c_ast_nodetype(expr) == AST_DIV) {
+      emit_str(w, "m2__div(");
+    }
+    else {
+      emit_str(w, "m2__mod(");
+    } /* end if */
+  
+    write_expr(w, left);
+    emit_str(w, ", ");
+    write_expr(w, right);
+    emit_char(w, ')');
+    return;
+  } /* end if */
+  
+  switch (m2c_ast_nodetype(expr)) {
+    case AST_EQ :
+      operator = " == ";
+      break;
+  
+    case AST_NEQ :
+      operator = " != ";
+      break;
+  
+    case AST_LT :
+      operator = " < ";
+      break;
+  
+    case AST_LTEQ :
+      operator = " <= ";
+      break;
+  
+    case AST_GT :
+      operator = " > ";
+      break;
+  
+    case AST_GTEQ :
+      operator = " >= ";
+      break;
+  
+    case AST_PLUS :
+      operator = " + ";
+      break;
+  
+    case AST_MINUS :
+      operator = " - ";
+      break;
+  
+    case AST_OR :
+      operator = " || ";
+      break;
+  
+    case AST_ASTERISK :
+      operator = " * ";
+      break;
+  
+    case AST_SOLIDUS :
+    case AST_DIV :
+      operator = " / ";
+      break;
+  
+    case AST_MOD :
+      operator = " % ";
+      break;
+  
+    default : /* AST_AND */
+      operator = " && ";
+      break;
+  } /* end switch */
+  
+  write_operand(w, left);
+  emit_str(w, operator);
+  write_operand(w, right);
+} /* end write_binary */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_set_value(w, elemlist)
+ * --------------------------------------------------------------------------
+ * Translates the set value with element list elemlist to a bit mask.
+ * ----------------------------------------------------------------------- */
+
+static void write_set_value (c99_writer_s *w, m2c_astnode_t elemlist) {
+  m2c_astnode_t elem;
+  uint_t index, count;
+  
+  emit_str(w, "(0u");
+  
+  count = list_count(elemlist);
+  for (index = 0; index < count; index++) {
+    elem = subnode(elemlist, index);
+  
+    if (m2c_ast_nodetype(elem) == AST_RANGE) {
+      emit_str(w, " | M2__RANGE(");
+      write_expr(w, subnode(elem, 0));
+      emit_str(w, ", ");
+      write_expr(w, subnode(elem, 1));
+    }
+    else {
+      emit_str(w, " | M2__BIT(");
+      write_expr(w, elem);
+    } /* end if */
+  
+    emit_char(w, ')');
+  } /* end for */
+  
+  emit_char(w, ')');
+} /* end write_set_value */
+
+
+/* --------------------------------------------------------------------------
+ * private function with_field(w, ident, level)
+ * --------------------------------------------------------------------------
+ * Returns true if ident denotes a field of the record designated by one of
+ * the enclosing WITH statements and passes the index of the innermost such
+ * WITH statement back in level.  If the type of the innermost record is not
+ * known, ident is taken to be one of its fields unless it is declared.
+ * ----------------------------------------------------------------------- */
+
+static bool with_field (c99_writer_s *w, m2c_string_t ident, uint_t *level) {
+  c99_symbol_s *symbol;
+  m2c_astnode_t rectype;
+  uint_t depth, index;
+  bool found;
+  
+  depth = w->with_depth;
+  found = false;
+  index = depth;
+  
+  /* a WITH designator is resolved within the enclosing WITH statements */
+  while ((NOT(found)) && (index > 0)) {
+    index--;
+    w->with_depth = index;
+    rectype = base_type(w, type_of_designator(w, w->with[index]));
+  
+    if (rectype == NULL) {
+      if (index == depth - 1) {
+        symbol = resolve_ident(w, ident);
+        found = ((symbol == NULL) || (symbol->kind == C99_SYM_OTHER));
+      } /* end if */
+    }
+    else {
+      found = (field_type(w, rectype, ident) != NULL);
+    } /* end if */
+  } /* end while */
+  
+  w->with_depth = depth;
+  WRITE_OUTPARAM(level, index);
+  
+  return found;
+} /* end with_field */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_ident(w, ident)
+ * --------------------------------------------------------------------------
+ * Translates identifier ident used in an expression or designator.
+ * ----------------------------------------------------------------------- */
+
+static void write_ident (c99_writer_s *w, m2c_string_t ident) {
+  c99_symbol_s *symbol;
+  uint_t level, depth;
+  
+  if ((w->with_depth > 0) && (with_field(w, ident, &level))) {
+    depth = w->with_depth;
+    w->with_depth = level;
+    write_expr(w, w->with[level]);
+    w->with_depth = depth;
+  
+    emit_char(w, '.');
+    emit_str(w, local_name(w, ident));
+    return;
+  } /* end if */
+  
+  symbol = resolve_ident(w, ident);
+  
+  if ((symbol != NULL) && (symbol->kind == C99_SYM_VAR_PARAM)) {
+    emit_str(w, "(*");
+    emit_str(w, symbol->cname);
+    emit_char(w, ')');
+  }
+  else {
+    emit_str(w, cname_for_ident(w, ident));
+  } /* end if */
+} /* end write_ident */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_qualident(w, qualident)
+ * --------------------------------------------------------------------------
+ * Translates qualified identifier qualident used in an expression or
+ * designator.  Identifiers that follow a module qualification or a record
+ * variable are field selectors.
+ * ----------------------------------------------------------------------- */
+
+static void write_qualident (c99_writer_s *w, m2c_astnode_t qualident) {
+  c99_symbol_s *symbol;
+  uint_t index, count, used;
+  
+  count = m2c_ast_subnode_count(qualident);
+  symbol = resolve_qualident(w, qualident, &used);
+  
+  if (used == 2) {
+    emit_str(w, ((symbol != NULL) && (symbol->cname != NULL)) ?
+      symbol->cname :
+      m2c_string_char_ptr(m2c_ast_value_for_index(qualident, 1)));
+  }
+  else {
+    write_ident(w, m2c_ast_value_for_index(qualident, 0));
+  } /* end if */
+  
+  for (index = used; index < count; index++) {
+    emit_char(w, '.');
+    emit_str(w,
+      local_name(w, m2c_ast_value_for_index(qualident, index)));
+  } /* end for */
+} /* end write_qualident */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_name(w, name)
+ * --------------------------------------------------------------------------
+ * Writes the C name of the entity that identifier or qualified identifier
+ * name denotes, such as a type.  Fields of WITH statements are not taken
+ * into account.
+ * ----------------------------------------------------------------------- */
+
+static void write_name (c99_writer_s *w, m2c_astnode_t name) {
+  c99_symbol_s *symbol;
+  uint_t used;
+  
+  if (m2c_ast_nodetype(name) == AST_IDENT) {
+    emit_str(w, cname_for_ident(w, m2c_ast_value(name)));
+    return;
+  } /* end if */
+  
+  symbol = resolve_qualident(w, name, &used);
+  
+  if ((used == 2) && (symbol != NULL) && (symbol->cname != NULL)) {
+    emit_str(w, symbol->cname);
+  }
+  else {
+    write_qualident(w, name);
+  } /* end if */
+} /* end write_name */
+
+
+/* --------------------------------------------------------------------------
+ * private function callee_symbol(w, desig)
+ * --------------------------------------------------------------------------
+ * Returns the symbol of the procedure that designator desig calls, or NULL
+ * if it is not a known procedure or pervasive.
+ * ----------------------------------------------------------------------- */
+
+static c99_symbol_s *callee_symbol (c99_writer_s *w, m2c_astnode_t desig) {
+  c99_symbol_s *symbol;
+  uint_t used;
+  
+  switch (m2c_ast_nodetype(desig)) {
+    case AST_IDENT :
+      if ((w->with_depth > 0) &&
+          (with_field(w, m2c_ast_value(desig), NULL))) {
+        return NULL;
+      } /* end if */
+  
+      symbol = resolve_ident(w, m2c_ast_value(desig));
+      break;
+  
+    case AST_QUALIDENT :
+      symbol = resolve_qualident(w, desig, &used);
+  
+      if (used != m2c_ast_subnode_count(desig)) {
+        return NULL;
+      } /* end if */
+      break;
+  
+    default :
+      return NULL;
+  } /* end switch */
+  
+  if ((symbol == NULL) || ((symbol->kind != C99_SYM_PROC) &&
+      (symbol->kind != C99_SYM_BUILTIN))) {
+    return NULL;
+  } /* end if */
+  
+  return symbol;
+} /* end callee_symbol */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_call(w, desig, args)
+ * --------------------------------------------------------------------------
+ * Translates a call of the procedure designated by desig with actual
+ * parameters args, which may be NULL or empty.  Arguments are passed in
+ * accordance with the parameter modes of the procedure, if known.
+ * ----------------------------------------------------------------------- */
+
+static void write_call
+  (c99_writer_s *w, m2c_astnode_t desig, m2c_astnode_t args) {
+  
+  c99_symbol_s *symbol;
+  const char *modes;
+  uint_t index, count, mode_count;
+  
+  symbol = callee_symbol(w, desig);
+  
+  if ((symbol != NULL) && (symbol->kind == C99_SYM_BUILTIN)) {
+    write_builtin(w, symbol->info->builtin, args);
+    return;
+  } /* end if */
+  
+  modes = (symbol != NULL) ? symbol->modes : NULL;
+  mode_count = (modes != NULL) ? strlen(modes) : 0;
+  
+  write_expr(w, desig);
+  emit_char(w, '(');
+  
+  count = list_count(args);
+  for (index = 0; index < count; index++) {
+    if (index > 0) {
+      emit_str(w, ", ");
+    } /* end if */
+  
+    write_arg(w, subnode(args, index),
+      (index < mode_count) ? modes[index] : C99_MODE_VALUE);
+  } /* end for */
+  
+  emit_char(w, ')');
+} /* end write_call */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_arg(w, arg, mode)
+ * --------------------------------------------------------------------------
+ * Translates actual parameter arg passed with parameter mode mode.  A VAR
+ * parameter is passed by address, an open array parameter is followed by
+ * its HIGH value.
+ * ----------------------------------------------------------------------- */
+
+static void write_arg (c99_writer_s *w, m2c_astnode_t arg, char mode) {
+  c99_symbol_s *symbol;
+  uint_t length;
+  
+  symbol = NULL;
+  
+  if ((m2c_ast_nodetype(arg) == AST_IDENT) &&
+      (NOT((w->with_depth > 0) &&
+           (with_field(w, m2c_ast_value(arg), NULL))))) {
+    symbol = resolve_ident(w, m2c_ast_value(arg));
+  } /* end if */
+  
+  switch (mode) {
+    case C99_MODE_VAR :
+      /* a VAR parameter already is a pointer */
+      if ((symbol != NULL) && (symbol->kind == C99_SYM_VAR_PARAM)) {
+        emit_str(w, symbol->cname);
+      }
+      else {
+        emit_str(w, "&");
+        write_operand(w, arg);
+      } /* end if */
+      break;
+  
+    case C99_MODE_OPEN :
+      if (m2c_ast_nodetype(arg) == AST_QUOTEDVAL) {
+        length = m2c_string_length(m2c_ast_value(arg));
+        write_string(w, m2c_ast_value(arg));
+        emit_str(w, ", ");
+        emit_uint(w, length);
+      }
+      else if ((symbol != NULL) && (symbol->kind == C99_SYM_OPEN_PARAM)) {
+        emit_str(w, symbol->cname);
+        emit_str(w, ", ");
+        emit_str(w, symbol->cname);
+        emit_str(w, "__high");
+      }
+      else {
+        write_expr(w, arg);
+        emit_str(w, ", M2__HIGH(");
+        write_expr(w, arg);
+        emit_char(w, ')');
+      } /* end if */
+      break;
+  
+    default :
+      write_expr(w, arg);
+      break;
+  } /* end switch */
+} /* end write_arg */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_builtin(w, builtin, args)
+ * --------------------------------------------------------------------------
+ * Translates a call of pervasive procedure or function builtin with actual
+ * parameters args.
+ * ----------------------------------------------------------------------- */
+
+static void write_builtin
+  (c99_writer_s *w, c99_builtin_t builtin, m2c_astnode_t args) {
+  
+  m2c_astnode_t first, second;
+  c99_symbol_s *symbol;
+  
+  first = subnode(args, 0);
+  second = subnode(args, 1);
+  
+  switch (builtin) {
+    case C99_ABS :
+      write_macro_call(w, "M2__ABS(", first);
+      break;
+  
+    case C99_ADR :
+      emit_str(w, "((void *) &");
+      write_operand(w, first);
+      emit_char(w, ')');
+      break;
+  
+    case C99_CAP :
+      write_macro_call(w, "M2__CAP(", first);
+      break;
+  
+    case C99_CHR :
+      write_cast(w, "char", first);
+      break;
+  
+    /* proper procedures, only called as statements */
+    case C99_DEC :
+    case C99_INC :
+      write_expr(w, first);
+  
+      if (second == NULL) {
+        emit_str(w, (builtin == C99_INC) ? "++" : "--");
+      }
+      else {
+        emit_str(w, (builtin == C99_INC) ? " += " : " -= ");
+        write_operand(w, second);
+      } /* end if */
+      break;
+  
+    case C99_DISPOSE :
+      write_macro_call(w, "M2__DISPOSE(", first);
+      break;
+  
+    case C99_EXCL :
+    case C99_INCL :
+      write_expr(w, first);
+      emit_str(w, (builtin == C99_INCL) ? " |= M2__BIT(" : " &= ~M2__BIT(");
+      write_expr(w, second);
+      emit_char(w, ')');
+      break;
+  
+    case C99_FLOAT :
+      write_cast(w, "float", first);
+      break;
+  
+    case C99_HALT :
+      emit_str(w, "exit(EXIT_SUCCESS)");
+      break;
+  
+    case C99_HIGH :
+      symbol = (m2c_ast_nodetype(first) == AST_IDENT) ?
+        resolve_ident(w, m2c_ast_value(first)) : NULL;
+  
+      if ((symbol != NULL) && (symbol->kind == C99_SYM_OPEN_PARAM)) {
+        emit_str(w, symbol->cname);
+        emit_str(w, "__high");
+      }
+      else {
+        write_macro_call(w, "M2__HIGH(", first);
+      } /* end if */
+      break;
+  
+    case C99_MAX :
+    case C99_MIN :
+      symbol = type_symbol(w, first);
+  
+      if ((symbol != NULL) && (symbol->info != NULL) &&
+          (symbol->info->min != NULL)) {
+        emit_str(w, (builtin == C99_MAX) ?
+          symbol->info->max : symbol->info->min);
+      }
+      else {
+        write_name(w, first);
+        emit_str(w, (builtin == C99_MAX) ? "__MAX" : "__MIN");
+      } /* end if */
+      break;
+  
+    case C99_NEW :
+      write_macro_call(w, "M2__NEW(", first);
+      break;
+  
+    case C99_ODD :
+      write_macro_call(w, "M2__ODD(", first);
+      break;
+  
+    case C99_ORD :
+    case C99_TRUNC :
+      write_cast(w, "unsigned", first);
+      break;
+  
+    case C99_SIZE :
+      symbol = type_symbol(w, first);
+      emit_str(w, "((unsigned) sizeof (");
+  
+      if ((symbol != NULL) && (symbol->kind == C99_SYM_TYPE)) {
+        write_name(w, first);
+      }
+      else {
+        write_expr(w, first);
+      } /* end if */
+  
+      emit_str(w, "))");
+      break;
+  
+    case C99_VAL :
+      emit_str(w, "((");
+      write_type_prefix(w, first);
+      emit_str(w, ") ");
+      write_operand(w, second);
+      emit_char(w, ')');
+      break;
+  
+    default :
+      emit_str(w, "0 /* call not translated */");
+      break;
+  } /* end switch */
+} /* end write_builtin */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_macro_call(w, head, arg)
+ * --------------------------------------------------------------------------
+ * Writes head, which ends in an opening parenthesis, expression arg and a
+ * closing parenthesis.
+ * ----------------------------------------------------------------------- */
+
+static void write_macro_call
+  (c99_writer_s *w, const char *head, m2c_astnode_t arg) {
+  
+  emit_str(w, head);
+  write_expr(w, arg);
+  emit_char(w, ')');
+} /* end write_macro_call */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_cast(w, ctype, arg)
+ * --------------------------------------------------------------------------
+ * Writes a conversion of expression arg to C type ctype.
+ * ----------------------------------------------------------------------- */
+
+static void write_cast (c99_writer_s *w, const char *ctype, m2c_astnode_t arg) {
+  
+  emit_str(w, "((");
+  emit_str(w, ctype);
+  emit_str(w, ") ");
+  write_operand(w, arg);
+  emit_char(w, ')');
+} /* end write_cast */
+
+
+/* *********************************************************************** *
+ * Literals                                                                *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private procedure write_int_literal(w, lexeme)
+ * --------------------------------------------------------------------------
+ * Translates whole number literal lexeme.  Suffixed base-16 and base-8
+ * literals are rewritten with C prefixes, leading zeroes of decimal
+ * literals are removed, since C would read them as base-8 literals.
+ * ----------------------------------------------------------------------- */
+
+static void write_int_literal (c99_writer_s *w, m2c_string_t lexeme) {
+  const char *chars;
+  uint_t length;
+  
+  chars = m2c_string_char_ptr(lexeme);
+  length = m2c_string_length(lexeme);
+  
+  if (length == 0) {
+    emit_char(w, '0');
+  }
+  else if ((length > 1) && (chars[0] == '0') && (chars[1] == 'x')) {
+    emit_str(w, chars);
+  }
+  else if (chars[length - 1] == 'H') {
+    emit_str(w, "0x");
+    m2c_outsink_write_chars(w->out, chars, length - 1);
+  }
+  else if (chars[length - 1] == 'B') {
+    emit_char(w, '0');
+    m2c_outsink_write_chars(w->out, chars, length - 1);
+  }
+  else {
+    while ((length > 1) && (chars[0] == '0')) {
+      chars++;
+      length--;
+    } /* end while */
+  
+    emit_str(w, chars);
+  } /* end if */
+} /* end write_int_literal */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_char_code(w, lexeme)
+ * --------------------------------------------------------------------------
+ * Translates character code literal lexeme, either prefixed base-16 0uHH
+ * or suffixed base-8 NNNC, to a char conversion of a C integer literal.
+ * ----------------------------------------------------------------------- */
+
+static void write_char_code (c99_writer_s *w, m2c_string_t lexeme) {
+  const char *chars;
+  uint_t length;
+  
+  chars = m2c_string_char_ptr(lexeme);
+  length = m2c_string_length(lexeme);
+  
+  emit_str(w, "((char) 0");
+  
+  if ((length > 1) && (chars[0] == '0') && (chars[1] == 'u')) {
+    emit_char(w, 'x');
+    emit_str(w, chars + 2);
+  }
+  else if (length > 0) {
+    m2c_outsink_write_chars(w->out, chars, length - 1);
+  } /* end if */
+  
+  emit_char(w, ')');
+} /* end write_char_code */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_string(w, string)
+ * --------------------------------------------------------------------------
+ * Writes quoted literal string as a C string literal.  Question marks are
+ * escaped so that they cannot form trigraphs.
+ * ----------------------------------------------------------------------- */
+
+static void write_string (c99_writer_s *w, m2c_string_t string) {
+  const char *chars;
+  
+  chars = m2c_string_char_ptr(string);
+  emit_char(w, '"');
+  
+  while ((chars != NULL) && (*chars != ASCII_NUL)) {
+    if ((*chars == '"') || (*chars == '\\') || (*chars == '?')) {
+      emit_char(w, '\\');
+    } /* end if */
+  
+    emit_char(w, *chars);
+    chars++;
+  } /* end while */
+  
+  emit_char(w, '"');
+} /* end write_string */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_char_literal(w, string)
+ * --------------------------------------------------------------------------
+ * Writes single character quoted literal string as a C character constant.
+ * ----------------------------------------------------------------------- */
+
+static void write_char_literal (c99_writer_s *w, m2c_string_t string) {
+  const char *chars;
+  
+  chars = m2c_string_char_ptr(string);
+  emit_char(w, '\'');
+  
+  if ((chars[0] == '\'') || (chars[0] == '\\')) {
+    emit_char(w, '\\');
+  } /* end if */
+  
+  emit_char(w, chars[0]);
+  emit_char(w, '\'');
+} /* end write_char_literal */
+
+
+/* END OF FILE */
@@ -0,0 +1,134 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015, 2016 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * m2-c99writer.h
+ *
+ * Public interface for M2C C99 code generation.
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute and/or modify it under the
+ * terms of the GNU Lesser General Public License (LGPL) either version 2.1
+ * or at your choice version 3 as published by the Free Software Foundation.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+
+#ifndef M2C_C99WRITER_H
+#define M2C_C99WRITER_H
+
+#include "m2-common.h"
+#include "m2-fileio-status.h"
+#include "m2-ast.h"
+#include "m2-ast-view.h"
+#include "m2-symfile.h"
+#include "m2t-comments.h"
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_c99_import_loader_f
+ * --------------------------------------------------------------------------
+ * function pointer type for a procedure that returns the symbol file of the
+ * definition module of module, or NULL if none is available.  The context
+ * passed to m2c_c99_write() is passed on in context.  The C99 writer
+ * releases any symbol file returned when it has finished.
+ * ----------------------------------------------------------------------- */
+
+typedef m2c_symfile_t (*m2c_c99_import_loader_f)
+  (const char *module, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_c99_write(path, ast, load_import, context, chars_written)
+ * --------------------------------------------------------------------------
+ * Translates the given abstract syntax tree to C99 and writes the result
+ * to the given output file at the given path.  Returns a status code and
+ * passes the number of characters written back in chars_written.
+ *
+ * The translation of a definition module is a C header, that of a program
+ * or implementation module a C source file.  Identifiers are prefixed with
+ * the name of the module that declares them, as in Module__ident.  If
+ * load_import is not NULL, it is called once for the module itself and
+ * once for each imported module.  Symbol files of imported modules provide
+ * the parameter modes of imported procedures.  A module whose own symbol
+ * file is available is translated as an implementation module, otherwise
+ * as a program module.
+ *
+ * The C text is collected in memory and written to the file only when the
+ * translation is complete, the file is not created if translation fails.
+ *
+ * error-conditions:
+ * o  if ast is not the AST of a compilation unit, no file is written and
+ *    M2C_FILEIO_STATUS_INVALID_FORMAT is returned
+ * o  if path is not a regular file, M2C_FILEIO_STATUS_INVALID_FILE is
+ *    returned
+ * o  if allocation fails, M2C_FILEIO_STATUS_ALLOCATION_FAILED is returned
+ * o  if the file cannot be opened, M2C_FILEIO_STATUS_FOPEN_FAILED is
+ *    returned, if it cannot be written, M2C_FILEIO_STATUS_WRITE_FAILED
+ * ----------------------------------------------------------------------- */
+
+m2c_fileio_status_t m2c_c99_write
+  (const char *path, m2c_astnode_t ast,
+   m2c_c99_import_loader_f load_import, void *context,
+   uint_t *chars_written);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_c99_write_w_comments(path, ast, comments, load_import, ...)
+ * --------------------------------------------------------------------------
+ * Translates the given abstract syntax tree to C99 like m2c_c99_write() and
+ * additionally preserves the comments recorded in comments.  The comments
+ * attached to the module are written at the top of the output, those
+ * attached to a definition or declaration precede its translation, those
+ * of a procedure precede its function definition.  Each comment becomes a
+ * C comment on a line of its own, comment text is taken directly from the
+ * source held by comments.  Passing NULL for comments is equivalent to
+ * calling m2c_c99_write().
+ * ----------------------------------------------------------------------- */
+
+m2c_fileio_status_t m2c_c99_write_w_comments
+  (const char *path, m2c_astnode_t ast, m2t_comment_table_t comments,
+   m2c_c99_import_loader_f load_import, void *context,
+   uint_t *chars_written);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_c99_write_view(path, view, comments, load_import, ...)
+ * --------------------------------------------------------------------------
+ * Translates the tree presented by view to C99 like m2c_c99_write_w_comments
+ * and writes the result to the given output file at the given path.  The
+ * comments of nodes the view has copied are those recorded for the base
+ * nodes they were copied from, as returned by m2c_ast_view_origin().  The
+ * view must not be rewritten while it is being written.  Returns status
+ * M2C_FILEIO_STATUS_INVALID_FORMAT if view is NULL.
+ * ----------------------------------------------------------------------- */
+
+m2c_fileio_status_t m2c_c99_write_view
+  (const char *path, m2c_ast_view_t view, m2t_comment_table_t comments,
+   m2c_c99_import_loader_f load_import, void *context,
+   uint_t *chars_written);
+
+
+#endif /* M2C_C99WRITER_H */
+
+/* END OF FILE */
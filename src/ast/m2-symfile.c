@@ -0,0 +1,1276 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015, 2016 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * m2-symfile.c
+ *
+ * Implementation of M2C symbol files.
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute and/or modify it under the
+ * terms of the GNU Lesser General Public License (LGPL) either version 2.1
+ * or at your choice version 3 as published by the Free Software Foundation.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#include "m2-symfile.h"
+#include "m2-ast-flat.h"
+#include "m2-astwriter.h"
+#include "fileutils.h"
+#include "m2-trace-probes.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* --------------------------------------------------------------------------
+ * Image alignment
+ * --------------------------------------------------------------------------
+ * The embedded image starts at an offset that is a multiple of the given
+ * alignment, so that its arrays are naturally aligned when used in place.
+ * ----------------------------------------------------------------------- */
+
+#define M2C_SYMFILE_IMAGE_ALIGNMENT 8
+
+
+/* --------------------------------------------------------------------------
+ * Fingerprint hash constants
+ * --------------------------------------------------------------------------
+ * The interface fingerprint is a 64-bit FNV-1a hash.
+ * ----------------------------------------------------------------------- */
+
+#define M2C_SYMFILE_HASH_OFFSET 14695981039346656037ULL
+
+#define M2C_SYMFILE_HASH_PRIME 1099511628211ULL
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_symfile_struct_t
+ * --------------------------------------------------------------------------
+ * record type representing a loaded symbol file.  Fields header, symbol,
+ * slot and names point into the file data, field image refers to the image
+ * embedded in the file data.  Field refcount holds the number of
+ * references to the symbol file.
+ * ----------------------------------------------------------------------- */
+
+struct m2c_symfile_struct_t {
+  /* data */ const char *data;
+  /* size */ size_t size;
+  /* mapped */ bool mapped;
+  /* header */ const m2c_symfile_header_t *header;
+  /* symbol */ const m2c_symfile_entry_t *symbol;
+  /* slot */ const m2c_symfile_slot_t *slot;
+  /* names */ const char *names;
+  /* image */ m2c_astimage_t image;
+  /* refcount */ uint_t refcount;
+};
+
+typedef struct m2c_symfile_struct_t m2c_symfile_struct_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type symbol_s
+ * --------------------------------------------------------------------------
+ * record type representing a symbol collected for writing.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* name */ m2c_string_t name;
+  /* node */ uint32_t node;
+  /* kind */ uint16_t kind;
+} symbol_s;
+
+
+/* --------------------------------------------------------------------------
+ * Forward declarations
+ * ----------------------------------------------------------------------- */
+
+static uint_t collect_symbols
+  (m2c_astflat_t flat, uint_t deflist, symbol_s *symbol);
+
+static uint_t add_symbols_for_list (m2c_astflat_t flat, uint_t list,
+  uint_t node, m2c_symtype_t kind, symbol_s *symbol, uint_t count);
+
+static int compare_symbols (const void *sym1, const void *sym2);
+
+static m2c_symfile_slot_t *new_export_table
+  (const symbol_s *symbol, uint_t count, uint_t *slot_count);
+
+static uint_t lookup_slot (m2c_symfile_t symfile, const char *ident,
+  uint_t length, m2c_string_hash_t hash);
+
+static m2c_string_hash_t name_hash (const char *name, uint_t length);
+
+static uint64_t interface_fingerprint (m2c_astflat_t flat, uint_t defmod,
+  const symbol_s *symbol, uint_t count);
+
+static uint64_t hash_definition
+  (m2c_astflat_t flat, uint_t defn, uint64_t hash);
+
+static uint64_t hash_subtree (m2c_astflat_t flat, uint_t node, uint64_t hash);
+
+static uint64_t hash_value (uint64_t hash, uint64_t value);
+
+static uint64_t hash_string (uint64_t hash, m2c_string_t str);
+
+static bool write_symbol_file (FILE *fptr, m2c_astflat_t flat,
+  m2c_string_t module, symbol_s *symbol, uint_t count,
+  m2c_symfile_header_t *header);
+
+static const char *read_symbol_file
+  (const char *path, size_t *size, m2c_fileio_status_t *status);
+
+static bool symfile_is_valid (m2c_symfile_t symfile);
+
+static bool export_table_is_valid (m2c_symfile_t symfile);
+
+static size_t image_offset (const m2c_symfile_header_t *header);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_write(path, srcpath, ast, bytes_written)
+ * --------------------------------------------------------------------------
+ * Writes a symbol file for the definition module at srcpath with the given
+ * abstract syntax tree to the file at path and returns a status code.
+ * ----------------------------------------------------------------------- */
+
+m2c_fileio_status_t m2c_symfile_write
+  (const char *path, const char *srcpath,
+   m2c_astnode_t ast, uint_t *bytes_written) {
+  
+  return m2c_symfile_write_w_fingerprint
+    (path, srcpath, ast, bytes_written, NULL);
+} /* end m2c_symfile_write */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_write_w_fingerprint(path, srcpath, ast, ...)
+ * --------------------------------------------------------------------------
+ * Writes a symbol file like m2c_symfile_write() and passes the interface
+ * fingerprint recorded in it back in out-parameter fingerprint.
+ * ----------------------------------------------------------------------- */
+
+m2c_fileio_status_t m2c_symfile_write_w_fingerprint
+  (const char *path, const char *srcpath,
+   m2c_astnode_t ast, uint_t *bytes_written, uint64_t *fingerprint) {
+  
+  m2c_symfile_header_t header;
+  m2c_fileio_status_t status;
+  long int source_time, source_size;
+  uint_t defmod, count;
+  m2c_astflat_t flat;
+  symbol_s *symbol;
+  long size;
+  FILE *fptr;
+  
+  WRITE_OUTPARAM(bytes_written, 0);
+  WRITE_OUTPARAM(fingerprint, 0);
+  
+  if ((file_exists(path)) && (NOT(is_regular_file(path)))) {
+    return M2C_FILEIO_STATUS_INVALID_FILE;
+  } /* end if */
+  
+  if ((NOT(get_filetime(srcpath, &source_time))) ||
+      (NOT(get_filesize(srcpath, &source_size)))) {
+    return M2C_FILEIO_STATUS_INVALID_FILE;
+  } /* end if */
+  
+  /* symbols are numbered by their position in the flat AST */
+  flat = m2c_astflat_new(ast);
+  
+  if (flat == NULL) {
+    return M2C_FILEIO_STATUS_ALLOCATION_FAILED;
+  } /* end if */
+  
+  /* find the definition module node */
+  defmod = 0;
+  if (m2c_astflat_nodetype(flat, defmod) == AST_ROOT) {
+    defmod = m2c_astflat_subnode_for_index(flat, 0, 2);
+  } /* end if */
+  
+  if (m2c_astflat_nodetype(flat, defmod) != AST_DEFMOD) {
+    m2c_astflat_release(flat);
+    return M2C_FILEIO_STATUS_INVALID_FORMAT;
+  } /* end if */
+  
+  /* every symbol name is a value, there are at most as many as links */
+  symbol = malloc((m2c_astflat_link_count(flat) + 1) * sizeof(symbol_s));
+  
+  if (symbol == NULL) {
+    m2c_astflat_release(flat);
+    return M2C_FILEIO_STATUS_ALLOCATION_FAILED;
+  } /* end if */
+  
+  count = collect_symbols(flat,
+    m2c_astflat_subnode_for_index(flat, defmod, 2), symbol);
+  
+  fptr = fopen(path, "wb");
+  
+  if (fptr == NULL) {
+    free(symbol);
+    m2c_astflat_release(flat);
+    return M2C_FILEIO_STATUS_FOPEN_FAILED;
+  } /* end if */
+  
+  M2C_TRACE_WRITE_START("symfile", path);
+  
+  header.source_time = (int64_t) source_time;
+  header.source_size = (int64_t) source_size;
+  header.fingerprint = interface_fingerprint(flat, defmod, symbol, count);
+  
+  status = M2C_FILEIO_STATUS_SUCCESS;
+  
+  if (NOT(write_symbol_file(fptr, flat,
+      m2c_astflat_value_for_index(flat,
+        m2c_astflat_subnode_for_index(flat, defmod, 0), 0),
+      symbol, count, &header))) {
+    status = M2C_FILEIO_STATUS_WRITE_FAILED;
+  } /* end if */
+  
+  size = ftell(fptr);
+  
+  if (fclose(fptr) != 0) {
+    status = M2C_FILEIO_STATUS_WRITE_FAILED;
+  } /* end if */
+  
+  if ((status == M2C_FILEIO_STATUS_SUCCESS) && (size > 0)) {
+    WRITE_OUTPARAM(bytes_written, (uint_t) size);
+    WRITE_OUTPARAM(fingerprint, header.fingerprint);
+  } /* end if */
+  
+  free(symbol);
+  m2c_astflat_release(flat);
+  
+  M2C_TRACE_WRITE_END("symfile", path, status);
+  
+  return status;
+} /* end m2c_symfile_write_w_fingerprint */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_load(path, status)
+ * --------------------------------------------------------------------------
+ * Loads the symbol file at path and returns it.
+ * ----------------------------------------------------------------------- */
+
+m2c_symfile_t m2c_symfile_load
+  (const char *path, m2c_fileio_status_t *status) {
+  
+  m2c_symfile_t symfile;
+  m2c_fileio_status_t read_status;
+  
+  if ((path == NULL) || (NOT(is_regular_file(path)))) {
+    SET_STATUS(status, M2C_FILEIO_STATUS_FOPEN_FAILED);
+    return NULL;
+  } /* end if */
+  
+  symfile = malloc(sizeof(m2c_symfile_struct_t));
+  
+  if (symfile == NULL) {
+    SET_STATUS(status, M2C_FILEIO_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  symfile->image = NULL;
+  symfile->refcount = 1;
+  
+  /* map file, fall back to reading it into memory */
+  if (map_file(path, &symfile->data, &symfile->size)) {
+    symfile->mapped = true;
+  }
+  else {
+    symfile->mapped = false;
+    symfile->data = read_symbol_file(path, &symfile->size, &read_status);
+    
+    if (symfile->data == NULL) {
+      free(symfile);
+      SET_STATUS(status, read_status);
+      return NULL;
+    } /* end if */
+  } /* end if */
+  
+  if (NOT(symfile_is_valid(symfile))) {
+    m2c_symfile_release(symfile);
+    SET_STATUS(status, M2C_FILEIO_STATUS_INVALID_FORMAT);
+    return NULL;
+  } /* end if */
+  
+  SET_STATUS(status, M2C_FILEIO_STATUS_SUCCESS);
+  return symfile;
+} /* end m2c_symfile_load */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_is_current(symfile, srcpath)
+ * --------------------------------------------------------------------------
+ * Returns true if symfile was written for the current version of the
+ * definition module at srcpath, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_symfile_is_current (m2c_symfile_t symfile, const char *srcpath) {
+  
+  long int source_time, source_size;
+  
+  if ((symfile == NULL) || (srcpath == NULL)) {
+    return false;
+  } /* end if */
+  
+  if ((NOT(get_filetime(srcpath, &source_time))) ||
+      (NOT(get_filesize(srcpath, &source_size)))) {
+    return false;
+  } /* end if */
+  
+  return ((symfile->header->source_time == (int64_t) source_time) &&
+    (symfile->header->source_size == (int64_t) source_size));
+} /* end m2c_symfile_is_current */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_module_name(symfile)
+ * --------------------------------------------------------------------------
+ * Returns the name of the module of symfile, or NULL if symfile is NULL.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_symfile_module_name (m2c_symfile_t symfile) {
+  
+  if (symfile == NULL) {
+    return NULL;
+  } /* end if */
+  
+  return symfile->names + symfile->header->module_name;
+} /* end m2c_symfile_module_name */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_symbol_count(symfile)
+ * --------------------------------------------------------------------------
+ * Returns the number of symbols in symfile, or zero if symfile is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_symfile_symbol_count (m2c_symfile_t symfile) {
+  
+  if (symfile == NULL) {
+    return 0;
+  } /* end if */
+  
+  return symfile->header->symbol_count;
+} /* end m2c_symfile_symbol_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_fingerprint(symfile)
+ * --------------------------------------------------------------------------
+ * Returns the interface fingerprint of the module of symfile, or zero if
+ * symfile is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint64_t m2c_symfile_fingerprint (m2c_symfile_t symfile) {
+  
+  if (symfile == NULL) {
+    return 0;
+  } /* end if */
+  
+  return symfile->header->fingerprint;
+} /* end m2c_symfile_fingerprint */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_lookup(symfile, ident)
+ * --------------------------------------------------------------------------
+ * Returns the index of the symbol with name ident in symfile in constant
+ * expected time, or M2C_SYMFILE_NOT_FOUND if there is no such symbol.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_symfile_lookup (m2c_symfile_t symfile, const char *ident) {
+  
+  uint_t length;
+  
+  if ((symfile == NULL) || (ident == NULL)) {
+    return M2C_SYMFILE_NOT_FOUND;
+  } /* end if */
+  
+  length = strlen(ident);
+  
+  return lookup_slot(symfile, ident, length, name_hash(ident, length));
+} /* end m2c_symfile_lookup */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_lookup_string(symfile, ident)
+ * --------------------------------------------------------------------------
+ * Returns the index of the symbol with interned name ident in symfile like
+ * function m2c_symfile_lookup(), without measuring the length of ident.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_symfile_lookup_string (m2c_symfile_t symfile, m2c_string_t ident) {
+  
+  const char *chars;
+  uint_t length;
+  
+  if ((symfile == NULL) || (ident == NULL)) {
+    return M2C_SYMFILE_NOT_FOUND;
+  } /* end if */
+  
+  chars = m2c_string_char_ptr(ident);
+  length = m2c_string_length(ident);
+  
+  return lookup_slot(symfile, chars, length, name_hash(chars, length));
+} /* end m2c_symfile_lookup_string */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_name_for_index(symfile, index)
+ * --------------------------------------------------------------------------
+ * Returns the name of the symbol with the given index in symfile, or NULL
+ * if index is not a valid symbol index.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_symfile_name_for_index (m2c_symfile_t symfile, uint_t index) {
+  
+  if ((symfile == NULL) || (index >= symfile->header->symbol_count)) {
+    return NULL;
+  } /* end if */
+  
+  return symfile->names + symfile->symbol[index].name;
+} /* end m2c_symfile_name_for_index */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_kind_for_index(symfile, index)
+ * --------------------------------------------------------------------------
+ * Returns the kind of the symbol with the given index in symfile.
+ * ----------------------------------------------------------------------- */
+
+m2c_symtype_t m2c_symfile_kind_for_index (m2c_symfile_t symfile, uint_t index) {
+  
+  if ((symfile == NULL) || (index >= symfile->header->symbol_count)) {
+    return M2C_SYMTYPE_MODULE;
+  } /* end if */
+  
+  return (m2c_symtype_t) symfile->symbol[index].kind;
+} /* end m2c_symfile_kind_for_index */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_node_for_index(symfile, index)
+ * --------------------------------------------------------------------------
+ * Returns the index of the definition node of the symbol with the given
+ * index in the image of symfile, or M2C_ASTIMAGE_INVALID_NODE if index is
+ * not a valid symbol index.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_symfile_node_for_index (m2c_symfile_t symfile, uint_t index) {
+  
+  if ((symfile == NULL) || (index >= symfile->header->symbol_count)) {
+    return M2C_ASTIMAGE_INVALID_NODE;
+  } /* end if */
+  
+  return symfile->symbol[index].node;
+} /* end m2c_symfile_node_for_index */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_image(symfile)
+ * --------------------------------------------------------------------------
+ * Returns the binary AST image of the definition module of symfile, or
+ * NULL if symfile is NULL.
+ * ----------------------------------------------------------------------- */
+
+m2c_astimage_t m2c_symfile_image (m2c_symfile_t symfile) {
+  
+  if (symfile == NULL) {
+    return NULL;
+  } /* end if */
+  
+  return symfile->image;
+} /* end m2c_symfile_image */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_retain(symfile)
+ * --------------------------------------------------------------------------
+ * Adds a reference to symfile and returns it, so that symfile may be kept
+ * by a cache while it is released by its users.  Each retain must be
+ * balanced by a call to m2c_symfile_release().  References are not
+ * counted atomically, symfile must not be retained or released by more
+ * than one thread at a time.
+ * ----------------------------------------------------------------------- */
+
+m2c_symfile_t m2c_symfile_retain (m2c_symfile_t symfile) {
+  
+  if (symfile == NULL) {
+    return NULL;
+  } /* end if */
+  
+  symfile->refcount++;
+  
+  return symfile;
+} /* end m2c_symfile_retain */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_symfile_release(symfile)
+ * --------------------------------------------------------------------------
+ * Releases a reference to symfile.  When its last reference is released,
+ * symfile and its image are deallocated and pointers obtained from symfile
+ * become invalid.
+ * ----------------------------------------------------------------------- */
+
+void m2c_symfile_release (m2c_symfile_t symfile) {
+  
+  if (symfile == NULL) {
+    return;
+  } /* end if */
+  
+  if (symfile->refcount > 1) {
+    symfile->refcount--;
+    return;
+  } /* end if */
+  
+  /* the image refers to the file data, release it first */
+  m2c_astimage_release(symfile->image);
+  
+  if (symfile->mapped) {
+    unmap_file(symfile->data, symfile->size);
+  }
+  else {
+    free((void *) symfile->data);
+  } /* end if */
+  
+  free(symfile);
+} /* end m2c_symfile_release */
+
+
+/* *********************************************************************** *
+ * Private Functions                                                       *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private function collect_symbols(flat, deflist, symbol)
+ * --------------------------------------------------------------------------
+ * Collects the symbols defined by the definitions of deflist in flat into
+ * array symbol, sorts them by name, drops duplicates and returns their
+ * number.  Enumerated values of enumeration types are collected as
+ * constants, they are exported together with their type.
+ * ----------------------------------------------------------------------- */
+
+static uint_t collect_symbols
+  (m2c_astflat_t flat, uint_t deflist, symbol_s *symbol) {
+  
+  uint_t index, def_count, defn, type, count, unique;
+  m2c_ast_nodetype_t node_type;
+  
+  count = 0;
+  def_count = m2c_astflat_subnode_count(flat, deflist);
+  
+  for (index = 0; index < def_count; index++) {
+    defn = m2c_astflat_subnode_for_index(flat, deflist, index);
+    node_type = m2c_astflat_nodetype(flat, defn);
+    
+    switch (node_type) {
+      case AST_CONSTDEF :
+        count = add_symbols_for_list(flat,
+          m2c_astflat_subnode_for_index(flat, defn, 0),
+          defn, M2C_SYMTYPE_CONST, symbol, count);
+        break;
+      
+      case AST_TYPEDEF :
+        count = add_symbols_for_list(flat,
+          m2c_astflat_subnode_for_index(flat, defn, 0),
+          defn, M2C_SYMTYPE_TYPE, symbol, count);
+        
+        /* enumerated values of an enumeration type */
+        type = m2c_astflat_subnode_for_index(flat, defn, 1);
+        if (m2c_astflat_nodetype(flat, type) == AST_ENUM) {
+          count = add_symbols_for_list(flat,
+            m2c_astflat_subnode_for_index(flat, type, 0),
+            type, M2C_SYMTYPE_CONST, symbol, count);
+        } /* end if */
+        break;
+      
+      case AST_VARDECL :
+        count = add_symbols_for_list(flat,
+          m2c_astflat_subnode_for_index(flat, defn, 0),
+          defn, M2C_SYMTYPE_VAR, symbol, count);
+        break;
+      
+      case AST_PROCDEF :
+        count = add_symbols_for_list(flat,
+          m2c_astflat_subnode_for_index(flat, defn, 0),
+          defn, M2C_SYMTYPE_PROC, symbol, count);
+        break;
+      
+      default :
+        /* not a definition */
+        break;
+    } /* end switch */
+  } /* end for */
+  
+  if (count == 0) {
+    return 0;
+  } /* end if */
+  
+  /* sort by name, the first definition of a duplicate comes first */
+  qsort(symbol, count, sizeof(symbol_s), compare_symbols);
+  
+  /* drop duplicates, names are interned */
+  unique = 1;
+  for (index = 1; index < count; index++) {
+    if (symbol[index].name != symbol[unique - 1].name) {
+      symbol[unique] = symbol[index];
+      unique++;
+    } /* end if */
+  } /* end for */
+  
+  return unique;
+} /* end collect_symbols */
+
+
+/* --------------------------------------------------------------------------
+ * private function add_symbols_for_list(flat, list, node, kind, symbol, n)
+ * --------------------------------------------------------------------------
+ * Adds a symbol of the given kind with definition node for each value of
+ * the terminal node list in flat to array symbol, starting at index n, and
+ * returns the new number of symbols.  List may be an AST_IDENT node or an
+ * AST_IDENTLIST node.
+ * ----------------------------------------------------------------------- */
+
+static uint_t add_symbols_for_list (m2c_astflat_t flat, uint_t list,
+  uint_t node, m2c_symtype_t kind, symbol_s *symbol, uint_t count) {
+  
+  uint_t index, value_count;
+  m2c_string_t name;
+  
+  value_count = m2c_astflat_subnode_count(flat, list);
+  
+  for (index = 0; index < value_count; index++) {
+    name = m2c_astflat_value_for_index(flat, list, index);
+    
+    if (name != NULL) {
+      symbol[count].name = name;
+      symbol[count].node = node;
+      symbol[count].kind = (uint16_t) kind;
+      count++;
+    } /* end if */
+  } /* end for */
+  
+  return count;
+} /* end add_symbols_for_list */
+
+
+/* --------------------------------------------------------------------------
+ * private function compare_symbols(sym1, sym2)
+ * --------------------------------------------------------------------------
+ * Compares two symbols by name and then by node for use with qsort().
+ * ----------------------------------------------------------------------- */
+
+static int compare_symbols (const void *sym1, const void *sym2) {
+  
+  const symbol_s *symbol1 = sym1, *symbol2 = sym2;
+  int order;
+  
+  order = strcmp(m2c_string_char_ptr(symbol1->name),
+    m2c_string_char_ptr(symbol2->name));
+  
+  if (order != 0) {
+    return order;
+  } /* end if */
+  
+  return (symbol1->node > symbol2->node) - (symbol1->node < symbol2->node);
+} /* end compare_symbols */
+
+
+/* --------------------------------------------------------------------------
+ * private function new_export_table(symbol, count, slot_count)
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated export table for count symbols of array symbol
+ * and passes its number of slots back in slot_count.  The slot count is the
+ * smallest power of two greater than twice the symbol count, so that at
+ * most half the slots are occupied.  Returns NULL if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static m2c_symfile_slot_t *new_export_table
+  (const symbol_s *symbol, uint_t count, uint_t *slot_count) {
+  
+  m2c_symfile_slot_t *slot;
+  m2c_string_hash_t hash;
+  uint_t index, capacity, mask, probe;
+  
+  capacity = 1;
+  while (capacity <= 2 * count) {
+    capacity = 2 * capacity;
+  } /* end while */
+  
+  slot = malloc(capacity * sizeof(m2c_symfile_slot_t));
+  
+  if (slot == NULL) {
+    return NULL;
+  } /* end if */
+  
+  for (index = 0; index < capacity; index++) {
+    slot[index].hash = 0;
+    slot[index].symbol = M2C_SYMFILE_NOT_FOUND;
+  } /* end for */
+  
+  /* names are unique, linear probing from the home slot */
+  mask = capacity - 1;
+  for (index = 0; index < count; index++) {
+    hash = name_hash(m2c_string_char_ptr(symbol[index].name),
+      m2c_string_length(symbol[index].name));
+    
+    probe = hash & mask;
+    while (slot[probe].symbol != M2C_SYMFILE_NOT_FOUND) {
+      probe = (probe + 1) & mask;
+    } /* end while */
+    
+    slot[probe].hash = hash;
+    slot[probe].symbol = index;
+  } /* end for */
+  
+  *slot_count = capacity;
+  return slot;
+} /* end new_export_table */
+
+
+/* --------------------------------------------------------------------------
+ * private function lookup_slot(symfile, ident, length, hash)
+ * --------------------------------------------------------------------------
+ * Probes the export table of symfile for name ident of the given length
+ * and hash.  Returns the index of its symbol, or M2C_SYMFILE_NOT_FOUND.
+ * ----------------------------------------------------------------------- */
+
+static uint_t lookup_slot (m2c_symfile_t symfile, const char *ident,
+  uint_t length, m2c_string_hash_t hash) {
+  
+  const m2c_symfile_slot_t *slot;
+  const char *name;
+  uint_t mask, probe;
+  
+  slot = symfile->slot;
+  mask = symfile->header->slot_count - 1;
+  probe = hash & mask;
+  
+  /* there is always an empty slot, the probe sequence terminates */
+  while (slot[probe].symbol != M2C_SYMFILE_NOT_FOUND) {
+    if (slot[probe].hash == hash) {
+      name = symfile->names + symfile->symbol[slot[probe].symbol].name;
+      if ((strncmp(ident, name, length) == 0) &&
+          (name[length] == ASCII_NUL)) {
+        return slot[probe].symbol;
+      } /* end if */
+    } /* end if */
+    probe = (probe + 1) & mask;
+  } /* end while */
+  
+  return M2C_SYMFILE_NOT_FOUND;
+} /* end lookup_slot */
+
+
+/* --------------------------------------------------------------------------
+ * private function name_hash(name, length)
+ * --------------------------------------------------------------------------
+ * Returns the hash value of name with length as calculated by the string
+ * repository's hasher.  The value does not depend on the process, it may
+ * therefore be stored in a symbol file.
+ * ----------------------------------------------------------------------- */
+
+static m2c_string_hash_t name_hash (const char *name, uint_t length) {
+  
+  m2c_string_hasher_t hasher;
+  
+  m2c_string_hasher_init(&hasher);
+  m2c_string_hasher_add_chars(&hasher, name, length);
+  
+  return m2c_string_hasher_value(&hasher);
+} /* end name_hash */
+
+
+/* --------------------------------------------------------------------------
+ * private function interface_fingerprint(flat, defmod, symbol, count)
+ * --------------------------------------------------------------------------
+ * Returns the interface fingerprint of definition module node defmod of
+ * flat with the count exported symbols of array symbol, which must be
+ * sorted by name.  The fingerprint covers the module identifier, the
+ * import lists and the name, kind and definition of each symbol.  Returns
+ * one in place of a hash value of zero.
+ * ----------------------------------------------------------------------- */
+
+static uint64_t interface_fingerprint (m2c_astflat_t flat, uint_t defmod,
+  const symbol_s *symbol, uint_t count) {
+  
+  uint64_t hash;
+  uint_t index;
+  
+  hash = M2C_SYMFILE_HASH_OFFSET;
+  hash = hash_subtree(flat, m2c_astflat_subnode_for_index(flat, defmod, 0),
+    hash);
+  hash = hash_subtree(flat, m2c_astflat_subnode_for_index(flat, defmod, 1),
+    hash);
+  
+  /* symbols are sorted by name, the order of definitions is irrelevant */
+  for (index = 0; index < count; index++) {
+    hash = hash_string(hash, symbol[index].name);
+    hash = hash_value(hash, symbol[index].kind);
+    hash = hash_definition(flat, symbol[index].node, hash);
+  } /* end for */
+  
+  if (hash == 0) {
+    return 1;
+  } /* end if */
+  
+  return hash;
+} /* end interface_fingerprint */
+
+
+/* --------------------------------------------------------------------------
+ * private function hash_definition(flat, defn, hash)
+ * --------------------------------------------------------------------------
+ * Adds definition node defn of flat to hash and returns the result.  The
+ * identifiers defined, held by the first subnode of a definition, are not
+ * included, so that a definition shared by several identifiers yields the
+ * same hash as separate definitions.  An enumeration, the definition of
+ * its values, is included as a whole since their order is significant.
+ * ----------------------------------------------------------------------- */
+
+static uint64_t hash_definition
+  (m2c_astflat_t flat, uint_t defn, uint64_t hash) {
+  
+  uint_t index, count;
+  
+  if (m2c_astflat_nodetype(flat, defn) == AST_ENUM) {
+    return hash_subtree(flat, defn, hash);
+  } /* end if */
+  
+  hash = hash_value(hash, m2c_astflat_nodetype(flat, defn));
+  count = m2c_astflat_subnode_count(flat, defn);
+  
+  for (index = 1; index < count; index++) {
+    hash = hash_subtree(flat,
+      m2c_astflat_subnode_for_index(flat, defn, index), hash);
+  } /* end for */
+  
+  return hash;
+} /* end hash_definition */
+
+
+/* --------------------------------------------------------------------------
+ * private function hash_subtree(flat, node, hash)
+ * --------------------------------------------------------------------------
+ * Adds the subtree of flat rooted at node to hash and returns the result.
+ * Since nodes are numbered in pre-order, the subtree occupies consecutive
+ * node indices starting at node.  It is hashed in a single pass by node
+ * type and subnode count of each nonterminal node and by node type and
+ * values of each terminal node, which determines the subtree uniquely.
+ * ----------------------------------------------------------------------- */
+
+static uint64_t hash_subtree (m2c_astflat_t flat, uint_t node, uint64_t hash) {
+  
+  m2c_ast_nodetype_t node_type;
+  uint_t pending, index, count;
+  
+  if (node == M2C_ASTFLAT_INVALID_NODE) {
+    return hash_value(hash, M2C_ASTFLAT_INVALID_NODE);
+  } /* end if */
+  
+  pending = 1;
+  while (pending > 0) {
+    node_type = m2c_astflat_nodetype(flat, node);
+    count = m2c_astflat_subnode_count(flat, node);
+    
+    hash = hash_value(hash, node_type);
+    hash = hash_value(hash, count);
+    pending--;
+    
+    if (m2c_ast_is_nonterminal_nodetype(node_type)) {
+      pending = pending + count;
+    }
+    else /* terminal */ {
+      for (index = 0; index < count; index++) {
+        hash = hash_string(hash,
+          m2c_astflat_value_for_index(flat, node, index));
+      } /* end for */
+    } /* end if */
+    
+    node++;
+  } /* end while */
+  
+  return hash;
+} /* end hash_subtree */
+
+
+/* --------------------------------------------------------------------------
+ * private function hash_value(hash, value)
+ * --------------------------------------------------------------------------
+ * Adds the eight bytes of value to hash and returns the result.
+ * ----------------------------------------------------------------------- */
+
+static uint64_t hash_value (uint64_t hash, uint64_t value) {
+  
+  uint_t index;
+  
+  for (index = 0; index < 8; index++) {
+    hash = (hash ^ (value & 0xff)) * M2C_SYMFILE_HASH_PRIME;
+    value = value >> 8;
+  } /* end for */
+  
+  return hash;
+} /* end hash_value */
+
+
+/* --------------------------------------------------------------------------
+ * private function hash_string(hash, str)
+ * --------------------------------------------------------------------------
+ * Adds the length and characters of str to hash and returns the result.
+ * Strings are hashed by their characters since the addresses of interned
+ * strings differ from one translation to the next.
+ * ----------------------------------------------------------------------- */
+
+static uint64_t hash_string (uint64_t hash, m2c_string_t str) {
+  
+  const char *chars;
+  uint_t index, length;
+  
+  if (str == NULL) {
+    return hash_value(hash, M2C_ASTFLAT_INVALID_NODE);
+  } /* end if */
+  
+  length = m2c_string_length(str);
+  chars = m2c_string_char_ptr(str);
+  hash = hash_value(hash, length);
+  
+  for (index = 0; index < length; index++) {
+    hash = (hash ^ (unsigned char) chars[index]) * M2C_SYMFILE_HASH_PRIME;
+  } /* end for */
+  
+  return hash;
+} /* end hash_string */
+
+
+/* --------------------------------------------------------------------------
+ * private function write_symbol_file(fptr, flat, module, symbol, count,
+ *                                    header)
+ * --------------------------------------------------------------------------
+ * Writes a symbol file for module with count symbols of array symbol and
+ * an image of flat to fptr.  Header must hold the source time and size, the
+ * remaining fields are filled in.  Returns true on success.
+ * ----------------------------------------------------------------------- */
+
+#define WRITE_ENTRY(_entry,_fptr) \
+  (fwrite(&(_entry), sizeof(_entry), 1, (_fptr)) == 1)
+
+static bool write_symbol_file (FILE *fptr, m2c_astflat_t flat,
+  m2c_string_t module, symbol_s *symbol, uint_t count,
+  m2c_symfile_header_t *header) {
+  
+  static const char padding[M2C_SYMFILE_IMAGE_ALIGNMENT] = { 0 };
+  m2c_symfile_entry_t entry;
+  m2c_symfile_slot_t *slot;
+  uint_t index, slot_count;
+  uint32_t offset;
+  size_t length;
+  long start;
+  bool written;
+  
+  /* the module name comes first in the name table */
+  offset = m2c_string_length(module) + 1;
+  for (index = 0; index < count; index++) {
+    offset = offset + m2c_string_length(symbol[index].name) + 1;
+  } /* end for */
+  
+  memcpy(header->magic, M2C_SYMFILE_MAGIC, 4);
+  header->version = M2C_SYMFILE_VERSION;
+  header->byte_order = M2C_SYMFILE_BYTE_ORDER;
+  header->symbol_count = count;
+  header->name_bytes = offset;
+  header->module_name = 0;
+  header->image_size = 0;
+  header->slot_count = 0;
+  header->reserved = 0;
+  
+  /* the image size is filled in when the image has been written */
+  if (NOT(WRITE_ENTRY(*header, fptr))) {
+    return false;
+  } /* end if */
+  
+  /* symbol table */
+  offset = m2c_string_length(module) + 1;
+  entry.reserved = 0;
+  for (index = 0; index < count; index++) {
+    entry.name = offset;
+    entry.node = symbol[index].node;
+    entry.kind = symbol[index].kind;
+    if (NOT(WRITE_ENTRY(entry, fptr))) {
+      return false;
+    } /* end if */
+    offset = offset + m2c_string_length(symbol[index].name) + 1;
+  } /* end for */
+  
+  /* export table, symbols are referenced by their index */
+  slot = new_export_table(symbol, count, &slot_count);
+  
+  if (slot == NULL) {
+    return false;
+  } /* end if */
+  
+  header->slot_count = slot_count;
+  written = (fwrite(slot, sizeof(m2c_symfile_slot_t), slot_count, fptr)
+    == slot_count);
+  free(slot);
+  
+  if (NOT(written)) {
+    return false;
+  } /* end if */
+  
+  /* name table including NUL terminators */
+  length = m2c_string_length(module) + 1;
+  if (fwrite(m2c_string_char_ptr(module), 1, length, fptr) != length) {
+    return false;
+  } /* end if */
+  
+  for (index = 0; index < count; index++) {
+    length = m2c_string_length(symbol[index].name) + 1;
+    if (fwrite(m2c_string_char_ptr(symbol[index].name), 1, length, fptr)
+        != length) {
+      return false;
+    } /* end if */
+  } /* end for */
+  
+  /* padding and image */
+  length = image_offset(header) - (size_t) ftell(fptr);
+  if (fwrite(padding, 1, length, fptr) != length) {
+    return false;
+  } /* end if */
+  
+  start = ftell(fptr);
+  if (NOT(m2c_ast_write_image(flat, fptr))) {
+    return false;
+  } /* end if */
+  
+  /* complete header */
+  header->image_size = (uint32_t) (ftell(fptr) - start);
+  
+  if ((fseek(fptr, 0, SEEK_SET) != 0) || (NOT(WRITE_ENTRY(*header, fptr))) ||
+      (fseek(fptr, 0, SEEK_END) != 0)) {
+    return false;
+  } /* end if */
+  
+  return true;
+} /* end write_symbol_file */
+
+
+/* --------------------------------------------------------------------------
+ * private function read_symbol_file(path, size, status)
+ * --------------------------------------------------------------------------
+ * Reads the file at path into a newly allocated buffer, passes its size
+ * back in size and returns the buffer.  Returns NULL on failure and passes
+ * the cause back in status.
+ * ----------------------------------------------------------------------- */
+
+static const char *read_symbol_file
+  (const char *path, size_t *size, m2c_fileio_status_t *status) {
+  
+  char *buffer;
+  long length;
+  FILE *file;
+  
+  file = fopen(path, "rb");
+  
+  if (file == NULL) {
+    *status = M2C_FILEIO_STATUS_FOPEN_FAILED;
+    return NULL;
+  } /* end if */
+  
+  if ((fseek(file, 0, SEEK_END) != 0) || ((length = ftell(file)) <= 0) ||
+      (fseek(file, 0, SEEK_SET) != 0)) {
+    fclose(file);
+    *status = M2C_FILEIO_STATUS_READ_FAILED;
+    return NULL;
+  } /* end if */
+  
+  buffer = malloc(length);
+  
+  if (buffer == NULL) {
+    *status = M2C_FILEIO_STATUS_ALLOCATION_FAILED;
+  }
+  else if (fread(buffer, 1, length, file) != (size_t) length) {
+    free(buffer);
+    buffer = NULL;
+    *status = M2C_FILEIO_STATUS_READ_FAILED;
+  } /* end if */
+  
+  fclose(file);
+  
+  *size = length;
+  return buffer;
+} /* end read_symbol_file */
+
+
+/* --------------------------------------------------------------------------
+ * private function symfile_is_valid(symfile)
+ * --------------------------------------------------------------------------
+ * Checks the header of symfile and its size, sets the table pointers and
+ * the image of symfile.  Returns true if the size of the file matches its
+ * header, all names are within bounds and NUL terminated, symbols are
+ * sorted by name, their nodes are within bounds, the export table is well
+ * formed and the image is valid, so that lookups and accessors of symfile
+ * cannot fail, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+static bool symfile_is_valid (m2c_symfile_t symfile) {
+  
+  const m2c_symfile_header_t *header;
+  const m2c_symfile_entry_t *symbol;
+  uint_t index, node_count;
+  size_t offset;
+  
+  if (symfile->size < sizeof(m2c_symfile_header_t)) {
+    return false;
+  } /* end if */
+  
+  header = (const m2c_symfile_header_t *) symfile->data;
+  
+  if ((memcmp(header->magic, M2C_SYMFILE_MAGIC, 4) != 0) ||
+      (header->version != M2C_SYMFILE_VERSION) ||
+      (header->byte_order != M2C_SYMFILE_BYTE_ORDER) ||
+      (header->name_bytes == 0) ||
+      (header->module_name >= header->name_bytes) ||
+      (header->fingerprint == 0) ||
+      (header->slot_count <= header->symbol_count) ||
+      ((header->slot_count & (header->slot_count - 1)) != 0)) {
+    return false;
+  } /* end if */
+  
+  offset = image_offset(header);
+  
+  if ((offset > symfile->size) ||
+      ((uint64_t) offset + header->image_size != symfile->size)) {
+    return false;
+  } /* end if */
+  
+  symfile->header = header;
+  symfile->symbol = (const m2c_symfile_entry_t *)
+    (symfile->data + sizeof(m2c_symfile_header_t));
+  symfile->slot =
+    (const m2c_symfile_slot_t *) (symfile->symbol + header->symbol_count);
+  symfile->names = (const char *) (symfile->slot + header->slot_count);
+  
+  if (symfile->names[header->name_bytes - 1] != ASCII_NUL) {
+    return false;
+  } /* end if */
+  
+  /* the embedded image is validated when it is set up */
+  symfile->image = m2c_astimage_for_data
+    (symfile->data + offset, header->image_size, NULL);
+  
+  if (symfile->image == NULL) {
+    return false;
+  } /* end if */
+  
+  /* verify symbol table */
+  node_count = m2c_astimage_node_count(symfile->image);
+  symbol = symfile->symbol;
+  
+  for (index = 0; index < header->symbol_count; index++) {
+    if ((symbol[index].name >= header->name_bytes) ||
+        (symbol[index].node >= node_count) ||
+        (symbol[index].kind > M2C_SYMTYPE_CONST_PARAM)) {
+      return false;
+    } /* end if */
+    
+    if ((index > 0) && (strcmp(symfile->names + symbol[index - 1].name,
+        symfile->names + symbol[index].name) >= 0)) {
+      return false;
+    } /* end if */
+  } /* end for */
+  
+  return export_table_is_valid(symfile);
+} /* end symfile_is_valid */
+
+
+/* --------------------------------------------------------------------------
+ * private function export_table_is_valid(symfile)
+ * --------------------------------------------------------------------------
+ * Returns true if every symbol of symfile occupies exactly one slot of its
+ * export table, otherwise false.  Since the slot count exceeds the symbol
+ * count, there is then at least one empty slot to terminate any probe.
+ * ----------------------------------------------------------------------- */
+
+static bool export_table_is_valid (m2c_symfile_t symfile) {
+  
+  const m2c_symfile_slot_t *slot;
+  uint_t index, occupied, count, length;
+  const char *name;
+  
+  slot = symfile->slot;
+  count = symfile->header->symbol_count;
+  occupied = 0;
+  
+  for (index = 0; index < symfile->header->slot_count; index++) {
+    if (slot[index].symbol != M2C_SYMFILE_NOT_FOUND) {
+      if (slot[index].symbol >= count) {
+        return false;
+      } /* end if */
+      occupied++;
+    } /* end if */
+  } /* end for */
+  
+  if (occupied != count) {
+    return false;
+  } /* end if */
+  
+  /* each symbol must be found through its own slot */
+  for (index = 0; index < count; index++) {
+    name = symfile->names + symfile->symbol[index].name;
+    length = strlen(name);
+    if (lookup_slot(symfile, name, length, name_hash(name, length))
+        != index) {
+      return false;
+    } /* end if */
+  } /* end for */
+  
+  return true;
+} /* end export_table_is_valid */
+
+
+/* --------------------------------------------------------------------------
+ * private function image_offset(header)
+ * --------------------------------------------------------------------------
+ * Returns the offset of the embedded image in a symbol file with header.
+ * ----------------------------------------------------------------------- */
+
+static size_t image_offset (const m2c_symfile_header_t *header) {
+  
+  size_t offset;
+  
+  offset = sizeof(m2c_symfile_header_t) +
+    (size_t) header->symbol_count * sizeof(m2c_symfile_entry_t) +
+    (size_t) header->slot_count * sizeof(m2c_symfile_slot_t) +
+    header->name_bytes;
+  
+  return (offset + M2C_SYMFILE_IMAGE_ALIGNMENT - 1) &
+    ~((size_t) M2C_SYMFILE_IMAGE_ALIGNMENT - 1);
+} /* end image_offset */
+
+
+/* END OF FILE */
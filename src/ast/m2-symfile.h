@@ -0,0 +1,337 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015, 2016 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * m2-symfile.h
+ *
+ * Public interface for M2C symbol files.
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute and/or modify it under the
+ * terms of the GNU Lesser General Public License (LGPL) either version 2.1
+ * or at your choice version 3 as published by the Free Software Foundation.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#ifndef M2C_SYMFILE_H
+#define M2C_SYMFILE_H
+
+#include "m2-common.h"
+#include "m2-fileio-status.h"
+#include "m2-ast.h"
+#include "m2-astimage.h"
+#include "m2-symtab.h"
+
+#include <stdint.h>
+
+
+/* --------------------------------------------------------------------------
+ * Symbol file format
+ * --------------------------------------------------------------------------
+ * A symbol file is written by function m2c_symfile_write() after parsing a
+ * definition module.  It allows an importing module to obtain the symbols
+ * and definitions of the module without lexing and parsing it again.  It
+ * consists of a header followed by a symbol table, an export table, a name
+ * table and a binary AST image of the definition module, all in host byte
+ * order:
+ *
+ *   m2c_symfile_entry_t symbol[symbol_count];
+ *   m2c_symfile_slot_t slot[slot_count];
+ *   char names[name_bytes];
+ *   padding to a multiple of eight bytes;
+ *   binary AST image of image_size bytes, as described in m2-astimage.h
+ *
+ * Symbols are sorted by name, the name of symbol i is the NUL terminated
+ * string at offset symbol[i].name in names.  The module name is at offset
+ * module_name.  Field node of a symbol is the index of its definition in
+ * the image, for an enumerated value it is the index of its enumeration.
+ * Field source_time holds the modification time of the definition module,
+ * source_size its size.  Like an AST image, a symbol file is used in place.
+ *
+ * The export table is an open addressing hash table with linear probing
+ * that maps names to symbols, so that an imported identifier is resolved in
+ * constant time regardless of the number of symbols.  Its slot count is a
+ * power of two of at least twice the symbol count.  A slot holds the hash
+ * of a name as calculated by the string repository's hasher and the index
+ * of its symbol, an empty slot holds M2C_SYMFILE_NOT_FOUND as its index.
+ * The home slot of a name is its hash modulo the slot count.
+ *
+ * Field fingerprint holds a 64-bit hash of the interface of the module: its
+ * import lists and, in order of their names, the name, kind and definition
+ * of each exported symbol.  Definitions are hashed by the shape and values
+ * of their subtrees, excluding the defined identifiers, so that comments,
+ * layout and the order of definitions do not affect the fingerprint.  The
+ * fingerprint is never zero.  A client need not be translated again if the
+ * fingerprints of the modules it imports are unchanged.
+ * ----------------------------------------------------------------------- */
+
+#define M2C_SYMFILE_MAGIC "M2SY"
+
+#define M2C_SYMFILE_VERSION 3
+
+#define M2C_SYMFILE_BYTE_ORDER 0x0102
+
+#define M2C_SYMFILE_NOT_FOUND 0xffffffff
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_symfile_header_t
+ * --------------------------------------------------------------------------
+ * record type representing the header of a symbol file.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* magic */ char magic[4];
+  /* version */ uint16_t version;
+  /* byte_order */ uint16_t byte_order;
+  /* source_time */ int64_t source_time;
+  /* source_size */ int64_t source_size;
+  /* symbol_count */ uint32_t symbol_count;
+  /* name_bytes */ uint32_t name_bytes;
+  /* module_name */ uint32_t module_name;
+  /* image_size */ uint32_t image_size;
+  /* slot_count */ uint32_t slot_count;
+  /* reserved */ uint32_t reserved;
+  /* fingerprint */ uint64_t fingerprint;
+} m2c_symfile_header_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_symfile_entry_t
+ * --------------------------------------------------------------------------
+ * record type representing a symbol file entry.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* name */ uint32_t name;
+  /* node */ uint32_t node;
+  /* kind */ uint16_t kind;
+  /* reserved */ uint16_t reserved;
+} m2c_symfile_entry_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_symfile_slot_t
+ * --------------------------------------------------------------------------
+ * record type representing a slot of the export table of a symbol file.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* hash */ uint32_t hash;
+  /* symbol */ uint32_t symbol;
+} m2c_symfile_slot_t;
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2c_symfile_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing a loaded symbol file.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_symfile_struct_t *m2c_symfile_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_write(path, srcpath, ast, bytes_written)
+ * --------------------------------------------------------------------------
+ * Writes a symbol file for the definition module at srcpath with the given
+ * abstract syntax tree to the file at path and returns a status code.
+ * Passes the number of bytes written back in out-parameter bytes_written.
+ *
+ * pre-conditions:
+ * o  ast must be the AST of a definition module, with or without its
+ *    AST_ROOT node
+ *
+ * post-conditions:
+ * o  a symbol file is written to path
+ * o  M2C_FILEIO_STATUS_SUCCESS is returned
+ *
+ * error-conditions:
+ * o  if ast is not the AST of a definition module, no file is written and
+ *    M2C_FILEIO_STATUS_INVALID_FORMAT is returned
+ * o  if srcpath is not an existing file, no file is written and
+ *    M2C_FILEIO_STATUS_INVALID_FILE is returned
+ * o  if allocation fails, M2C_FILEIO_STATUS_ALLOCATION_FAILED is returned
+ * o  if the file cannot be opened, M2C_FILEIO_STATUS_FOPEN_FAILED is
+ *    returned, if it cannot be written, M2C_FILEIO_STATUS_WRITE_FAILED
+ * ----------------------------------------------------------------------- */
+
+m2c_fileio_status_t m2c_symfile_write
+  (const char *path, const char *srcpath,
+   m2c_astnode_t ast, uint_t *bytes_written);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_write_w_fingerprint(path, srcpath, ast, ...)
+ * --------------------------------------------------------------------------
+ * Writes a symbol file like m2c_symfile_write() and passes the interface
+ * fingerprint recorded in it back in out-parameter fingerprint, the same
+ * value m2c_symfile_fingerprint() returns for the file once loaded.  The
+ * fingerprint passed back is zero if the file could not be written.
+ * ----------------------------------------------------------------------- */
+
+m2c_fileio_status_t m2c_symfile_write_w_fingerprint
+  (const char *path, const char *srcpath,
+   m2c_astnode_t ast, uint_t *bytes_written, uint64_t *fingerprint);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_load(path, status)
+ * --------------------------------------------------------------------------
+ * Loads the symbol file at path and returns it.  The file is memory mapped
+ * where the host supports it, otherwise it is read into memory.  The file
+ * is validated but not otherwise decoded.  Passes the same status codes
+ * back in status as function m2c_astimage_load().
+ * ----------------------------------------------------------------------- */
+
+m2c_symfile_t m2c_symfile_load
+  (const char *path, m2c_fileio_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_is_current(symfile, srcpath)
+ * --------------------------------------------------------------------------
+ * Returns true if symfile was written for the current version of the
+ * definition module at srcpath, otherwise false.  An importing module
+ * should parse the definition module instead of using a stale symbol file.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_symfile_is_current (m2c_symfile_t symfile, const char *srcpath);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_module_name(symfile)
+ * --------------------------------------------------------------------------
+ * Returns the name of the module of symfile, or NULL if symfile is NULL.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_symfile_module_name (m2c_symfile_t symfile);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_symbol_count(symfile)
+ * --------------------------------------------------------------------------
+ * Returns the number of symbols in symfile, or zero if symfile is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_symfile_symbol_count (m2c_symfile_t symfile);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_fingerprint(symfile)
+ * --------------------------------------------------------------------------
+ * Returns the interface fingerprint of the module of symfile, or zero if
+ * symfile is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint64_t m2c_symfile_fingerprint (m2c_symfile_t symfile);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_lookup(symfile, ident)
+ * --------------------------------------------------------------------------
+ * Returns the index of the symbol with name ident in symfile in constant
+ * expected time, or M2C_SYMFILE_NOT_FOUND if there is no such symbol.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_symfile_lookup (m2c_symfile_t symfile, const char *ident);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_lookup_string(symfile, ident)
+ * --------------------------------------------------------------------------
+ * Returns the index of the symbol with interned name ident in symfile like
+ * function m2c_symfile_lookup(), without measuring the length of ident.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_symfile_lookup_string (m2c_symfile_t symfile, m2c_string_t ident);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_name_for_index(symfile, index)
+ * --------------------------------------------------------------------------
+ * Returns the name of the symbol with the given index in symfile, or NULL
+ * if index is not a valid symbol index.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_symfile_name_for_index (m2c_symfile_t symfile, uint_t index);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_kind_for_index(symfile, index)
+ * --------------------------------------------------------------------------
+ * Returns the kind of the symbol with the given index in symfile.  The
+ * result is undefined if index is not a valid symbol index.
+ * ----------------------------------------------------------------------- */
+
+m2c_symtype_t m2c_symfile_kind_for_index (m2c_symfile_t symfile, uint_t index);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_node_for_index(symfile, index)
+ * --------------------------------------------------------------------------
+ * Returns the index of the definition node of the symbol with the given
+ * index in the image of symfile, or M2C_ASTIMAGE_INVALID_NODE if index is
+ * not a valid symbol index.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_symfile_node_for_index (m2c_symfile_t symfile, uint_t index);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_image(symfile)
+ * --------------------------------------------------------------------------
+ * Returns the binary AST image of the definition module of symfile, or
+ * NULL if symfile is NULL.  The image is released with symfile.
+ * ----------------------------------------------------------------------- */
+
+m2c_astimage_t m2c_symfile_image (m2c_symfile_t symfile);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_retain(symfile)
+ * --------------------------------------------------------------------------
+ * Adds a reference to symfile and returns it, so that symfile may be kept
+ * by a cache while it is released by its users.  Each retain must be
+ * balanced by a call to m2c_symfile_release().  References are not
+ * counted atomically, symfile must not be retained or released by more
+ * than one thread at a time.
+ * ----------------------------------------------------------------------- */
+
+m2c_symfile_t m2c_symfile_retain (m2c_symfile_t symfile);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_symfile_release(symfile)
+ * --------------------------------------------------------------------------
+ * Releases a reference to symfile.  When its last reference is released,
+ * symfile and its image are deallocated and pointers obtained from symfile
+ * become invalid.
+ * ----------------------------------------------------------------------- */
+
+void m2c_symfile_release (m2c_symfile_t symfile);
+
+
+#endif /* M2C_SYMFILE_H */
+
+/* END OF FILE */
@@ -0,0 +1,411 @@
+/* M2T -- Sorce to Source Modula-2 Translator
+ *
+ * Copyright (c) 2016-2023 Benjamin Kowarsch
+ *
+ * Author & Maintainer: Benjamin Kowarsch <org.m2sf>
+ *
+ * @synopsis
+ *
+ * M2T is a multi-dialect Modula-2 source-to-source translator. It translates
+ * source files  written in the  classic dialects  to semantically equivalent
+ * source files in  Modula-2 Revision 2010 (M2R10).  It supports  the classic
+ * Modula-2 dialects  described in  the 2nd, 3rd and 4th editions  of Niklaus
+ * Wirth's book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * For more details please visit: https://github.com/trijezdci/m2t/wiki
+ *
+ * @repository
+ *
+ * https://github.com/trijezdci/m2t
+ *
+ * @file
+ *
+ * m2t-bench.c
+ *
+ * Front-end benchmark driver for M2T.
+ *
+ * @license
+ *
+ * M2T is free software:  You can redistribute and modify it  under the terms
+ * of the  GNU Lesser General Public License (LGPL) either version 2.1  or at
+ * your choice version 3, both as published by the Free Software Foundation.
+ *
+ * M2T is distributed  in the hope  that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even  the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received  a copy of the  GNU Lesser General Public License
+ * along with M2T.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+
+/* --------------------------------------------------------------------------
+ * Usage
+ * --------------------------------------------------------------------------
+ * This tool measures the stages of the front end separately for each
+ * source file given on the command line:
+ *
+ *   open   creating a lexer, which opens and reads the input file
+ *   lex    reading all symbols with m2t_consume_sym() up to end of file
+ *   parse  m2t_parse_file(), including lexing and building the AST
+ *   ast    writing the AST in S-expression format with m2c_ast_write()
+ *   dot    writing the AST in Graphviz DOT format with m2c_dot_write()
+ *
+ *   m2t-bench [-n repeat] file ...
+ *
+ * Each stage is repeated and the fastest run is reported, together with
+ * throughput in MB/s of source text and tokens/s, and with the number of
+ * allocations of the fastest run.  Peak resident set size is reported once
+ * at the end.  Source files for benchmarking may be generated with the
+ * corpus generator in bench/m2t-gen-corpus.c.
+ *
+ * Allocations are counted when the tool is built with -DM2T_BENCH_COUNT_ALLOCS
+ * and linked with -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc, otherwise
+ * they are reported as n/a.
+ * ----------------------------------------------------------------------- */
+
+#include "m2t-common.h"
+#include "m2t-lexer.h"
+#include "m2t-parser.h"
+#include "m2-ast.h"
+#include "m2-astwriter.h"
+#include "m2-dotwriter.h"
+#include "m2t-option-flags.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <sys/resource.h>
+
+
+/* --------------------------------------------------------------------------
+ * Benchmark parameters
+ * ----------------------------------------------------------------------- */
+
+#define DEFAULT_REPEAT 5
+
+#define AST_OUTPUT_PATH "m2t-bench.ast"
+
+#define DOT_OUTPUT_PATH "m2t-bench.dot"
+
+
+/* --------------------------------------------------------------------------
+ * private type stage_t
+ * --------------------------------------------------------------------------
+ * Enumerated benchmark stages.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  STAGE_OPEN,
+  STAGE_LEX,
+  STAGE_PARSE,
+  STAGE_AST,
+  STAGE_DOT,
+  STAGE_COUNT
+} stage_t;
+
+static const char *stage_name[STAGE_COUNT] = {
+  "open", "lex", "parse", "ast", "dot"
+}; /* end stage_name */
+
+
+/* --------------------------------------------------------------------------
+ * private type result_t
+ * --------------------------------------------------------------------------
+ * Record type holding the fastest run of a stage.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* nanoseconds */ uint64_t nanoseconds;
+  /* allocations */ uint64_t allocations;
+  /* done */ bool done;
+} result_t;
+
+
+/* --------------------------------------------------------------------------
+ * Allocation counting
+ * --------------------------------------------------------------------------
+ * Wrappers for the allocator functions, used in place of the originals
+ * when linked with --wrap.  Function free is not wrapped.
+ * ----------------------------------------------------------------------- */
+
+static uint64_t allocation_count = 0;
+
+#if defined(M2T_BENCH_COUNT_ALLOCS)
+
+void *__real_malloc (size_t size);
+
+void *__real_calloc (size_t count, size_t size);
+
+void *__real_realloc (void *ptr, size_t size);
+
+void *__wrap_malloc (size_t size) {
+  allocation_count++;
+  return __real_malloc(size);
+} /* end __wrap_malloc */
+
+void *__wrap_calloc (size_t count, size_t size) {
+  allocation_count++;
+  return __real_calloc(count, size);
+} /* end __wrap_calloc */
+
+void *__wrap_realloc (void *ptr, size_t size) {
+  allocation_count++;
+  return __real_realloc(ptr, size);
+} /* end __wrap_realloc */
+
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * Forward declarations
+ * ----------------------------------------------------------------------- */
+
+static void bench_file (const char *path, uint_t repeat);
+
+
+/* --------------------------------------------------------------------------
+ * function main(argc, argv)
+ * --------------------------------------------------------------------------
+ * Runs the benchmark for each file given on the command line.
+ * ----------------------------------------------------------------------- */
+
+int main (int argc, char *argv[]) {
+  
+  struct rusage usage;
+  uint_t repeat;
+  int index;
+  
+  repeat = DEFAULT_REPEAT;
+  index = 1;
+  
+  if ((argc > 2) && (strcmp(argv[1], "-n") == 0)) {
+    repeat = (uint_t) strtoul(argv[2], NULL, 10);
+    if (repeat == 0) {
+      repeat = 1;
+    } /* end if */
+    index = 3;
+  } /* end if */
+  
+  if (index >= argc) {
+    fprintf(stderr, "usage: m2t-bench [-n repeat] file ...\n");
+    return EXIT_FAILURE;
+  } /* end if */
+  
+  printf("%-32s %-6s %10s %10s %12s %12s\n",
+    "file", "stage", "ms", "MB/s", "tokens/s", "allocs");
+  
+  while (index < argc) {
+    bench_file(argv[index], repeat);
+    index++;
+  } /* end while */
+  
+  remove(AST_OUTPUT_PATH);
+  remove(DOT_OUTPUT_PATH);
+  
+  /* ru_maxrss is in kilobytes on Linux and the BSDs, bytes on macOS */
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(__APPLE__)
+    printf("peak RSS: %ld KB\n", (long) usage.ru_maxrss / 1024);
+#else
+    printf("peak RSS: %ld KB\n", (long) usage.ru_maxrss);
+#endif
+  } /* end if */
+  
+  return EXIT_SUCCESS;
+} /* end main */
+
+
+/* --------------------------------------------------------------------------
+ * Private Functions
+ * ----------------------------------------------------------------------- */
+
+/* --------------------------------------------------------------------------
+ * private function now()
+ * --------------------------------------------------------------------------
+ * Returns the value of a monotonic clock in nanoseconds.
+ * ----------------------------------------------------------------------- */
+
+static uint64_t now (void) {
+  struct timespec time;
+  
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return (uint64_t) time.tv_sec * 1000000000u + (uint64_t) time.tv_nsec;
+} /* end now */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure record(result, start, allocations)
+ * --------------------------------------------------------------------------
+ * Records a run that started at start, keeping the fastest run.
+ * ----------------------------------------------------------------------- */
+
+static void record (result_t *result, uint64_t start, uint64_t allocations) {
+  uint64_t elapsed;
+  
+  elapsed = now() - start;
+  
+  if ((!result->done) || (elapsed < result->nanoseconds)) {
+    result->nanoseconds = elapsed;
+    result->allocations = allocation_count - allocations;
+    result->done = true;
+  } /* end if */
+} /* end record */
+
+
+/* --------------------------------------------------------------------------
+ * private function file_size(path)
+ * --------------------------------------------------------------------------
+ * Returns the size of the file at path in bytes, or zero on failure.
+ * ----------------------------------------------------------------------- */
+
+static long file_size (const char *path) {
+  FILE *file;
+  long size;
+  
+  file = fopen(path, "rb");
+  if (file == NULL) {
+    return 0;
+  } /* end if */
+  
+  fseek(file, 0, SEEK_END);
+  size = ftell(file);
+  fclose(file);
+  
+  return (size > 0) ? size : 0;
+} /* end file_size */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure print_result(path, stage, result, bytes, tokens)
+ * --------------------------------------------------------------------------
+ * Prints the fastest run of stage with throughput figures.
+ * ----------------------------------------------------------------------- */
+
+static void print_result
+  (const char *path, stage_t stage, result_t *result,
+   long bytes, uint64_t tokens) {
+  
+  double seconds;
+  
+  if (!result->done) {
+    printf("%-32s %-6s %10s\n", path, stage_name[stage], "failed");
+    return;
+  } /* end if */
+  
+  seconds = (double) result->nanoseconds / 1e9;
+  if (seconds <= 0.0) {
+    seconds = 1e-9;
+  } /* end if */
+  
+  printf("%-32s %-6s %10.3f %10.2f ", path, stage_name[stage],
+    seconds * 1e3, (double) bytes / (1024.0 * 1024.0) / seconds);
+  
+  if ((stage == STAGE_LEX) || (stage == STAGE_PARSE)) {
+    printf("%12.0f ", (double) tokens / seconds);
+  }
+  else {
+    printf("%12s ", "-");
+  } /* end if */
+  
+#if defined(M2T_BENCH_COUNT_ALLOCS)
+  printf("%12llu\n", (unsigned long long) result->allocations);
+#else
+  printf("%12s\n", "n/a");
+#endif
+} /* end print_result */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure bench_file(path, repeat)
+ * --------------------------------------------------------------------------
+ * Runs each stage for the file at path repeat times and prints results.
+ * ----------------------------------------------------------------------- */
+
+static void bench_file (const char *path, uint_t repeat) {
+  
+  result_t result[STAGE_COUNT];
+  m2t_parser_status_t parser_status;
+  m2t_lexer_status_t lexer_status;
+  m2c_ast_arena_t arena;
+  m2t_lexer_t lexer;
+  m2t_stats_t stats;
+  m2t_ast_t ast;
+  m2t_token_t token;
+  uint64_t start, allocations, tokens;
+  uint_t run, chars;
+  stage_t stage;
+  long bytes;
+  
+  memset(result, 0, sizeof(result));
+  bytes = file_size(path);
+  tokens = 0;
+  
+  run = 0;
+  while (run < repeat) {
+    /* open */
+    lexer = NULL;
+    allocations = allocation_count;
+    start = now();
+    m2t_new_lexer(&lexer, m2t_get_string((char *) path, NULL), &lexer_status);
+    if (lexer == NULL) {
+      fprintf(stderr, "m2t-bench: cannot open %s\n", path);
+      return;
+    } /* end if */
+    record(&result[STAGE_OPEN], start, allocations);
+  
+    /* lex */
+    tokens = 0;
+    allocations = allocation_count;
+    start = now();
+    token = m2t_next_sym(lexer);
+    while (token != TOKEN_END_OF_FILE) {
+      token = m2t_consume_sym(lexer);
+      tokens++;
+    } /* end while */
+    record(&result[STAGE_LEX], start, allocations);
+    m2t_release_lexer(&lexer, NULL);
+  
+    /* parse, into a per-run arena */
+    arena = m2c_ast_new_arena();
+    m2c_ast_set_arena(arena);
+    ast = NULL;
+    allocations = allocation_count;
+    start = now();
+    m2t_parse_file(M2T_ANY_SOURCE, path, &ast, &stats, &parser_status);
+    record(&result[STAGE_PARSE], start, allocations);
+  
+    if ((parser_status == M2T_PARSER_STATUS_SUCCESS) && (ast != NULL)) {
+      /* ast */
+      allocations = allocation_count;
+      start = now();
+      if (m2c_ast_write(AST_OUTPUT_PATH, ast, &chars) ==
+          M2C_FILEIO_STATUS_SUCCESS) {
+        record(&result[STAGE_AST], start, allocations);
+      } /* end if */
+  
+      /* dot */
+      allocations = allocation_count;
+      start = now();
+      if (m2c_dot_write(DOT_OUTPUT_PATH, ast, &chars) ==
+          M2C_FILEIO_STATUS_SUCCESS) {
+        record(&result[STAGE_DOT], start, allocations);
+      } /* end if */
+    } /* end if */
+  
+    m2c_ast_set_arena(NULL);
+    m2c_ast_release_arena(arena);
+    run++;
+  } /* end while */
+  
+  stage = 0;
+  while (stage < STAGE_COUNT) {
+    print_result(path, stage, &result[stage], bytes, tokens);
+    stage++;
+  } /* end while */
+} /* end bench_file */
+
+
+/* END OF FILE */
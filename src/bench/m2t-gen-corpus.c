@@ -0,0 +1,630 @@
+/* M2T -- Sorce to Source Modula-2 Translator
+ *
+ * Copyright (c) 2016-2023 Benjamin Kowarsch
+ *
+ * Author & Maintainer: Benjamin Kowarsch <org.m2sf>
+ *
+ * @synopsis
+ *
+ * M2T is a multi-dialect Modula-2 source-to-source translator. It translates
+ * source files  written in the  classic dialects  to semantically equivalent
+ * source files in  Modula-2 Revision 2010 (M2R10).  It supports  the classic
+ * Modula-2 dialects  described in  the 2nd, 3rd and 4th editions  of Niklaus
+ * Wirth's book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * For more details please visit: https://github.com/trijezdci/m2t/wiki
+ *
+ * @repository
+ *
+ * https://github.com/trijezdci/m2t
+ *
+ * @file
+ *
+ * m2t-gen-corpus.c
+ *
+ * Synthetic Modula-2 corpus generator for the M2T benchmark suite.
+ *
+ * @license
+ *
+ * M2T is free software:  You can redistribute and modify it  under the terms
+ * of the  GNU Lesser General Public License (LGPL) either version 2.1  or at
+ * your choice version 3, both as published by the Free Software Foundation.
+ *
+ * M2T is distributed  in the hope  that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even  the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received  a copy of the  GNU Lesser General Public License
+ * along with M2T.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+
+/* --------------------------------------------------------------------------
+ * Usage
+ * --------------------------------------------------------------------------
+ * This tool writes a synthetic Modula-2 compilation unit to stdout for use
+ * with m2t-bench.  The output depends only on its arguments, the same seed
+ * always yields the same source on every host.
+ *
+ *   m2t-gen-corpus kind size seed > file.mod
+ *
+ * Kinds of workload:
+ *
+ *   random    random program derived from the grammar tables, size limits
+ *             the derivation depth beyond which shortest rules are chosen
+ *   nesting   statements and expressions nested size levels deep
+ *   identlist VAR and import lists of size identifiers each
+ *   case      CASE statement with size labelled branches
+ *   comments  size statements interleaved with nested block comments
+ *
+ * Random programs are derived from the LL(1) tables in m2t-ll1-tables.h,
+ * which are generated from grammar/m2-grammar.gll, using the PIM3/4
+ * dialect.  They are syntactically valid but meaningless.
+ *
+ * Building the tool, from within directory src:
+ *
+ *   cc -I. -o m2t-gen-corpus bench/m2t-gen-corpus.c \
+ *     imp/m2t-token.c imp/m2t-tokenset.c
+ * ----------------------------------------------------------------------- */
+
+#include "m2t-common.h"
+#include "m2t-token.h"
+#include "m2t-tokenset.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "m2t-ll1-tables.h"
+
+
+/* --------------------------------------------------------------------------
+ * Output parameters
+ * ----------------------------------------------------------------------- */
+
+#define MAX_LINE_LENGTH 72
+
+#define IDENT_POOL_SIZE 64
+
+#define MAX_RULES_PER_NONTERMINAL 16
+
+#define RANDOM_DIALECT 1
+
+#define IS_NONTERMINAL(_sym) ((_sym) >= M2T_LL1_NONTERMINAL_BASE)
+
+#define UNKNOWN_COST 0xffffffffu
+
+
+/* --------------------------------------------------------------------------
+ * private variables
+ * ----------------------------------------------------------------------- */
+
+static uint64_t random_state;
+
+static uint_t column;
+
+static uint_t indent;
+
+static uint_t rule_count[M2T_LL1_NONTERMINAL_COUNT];
+
+static uint_t rule_list[M2T_LL1_NONTERMINAL_COUNT][MAX_RULES_PER_NONTERMINAL];
+
+static uint_t shortest_rule[M2T_LL1_NONTERMINAL_COUNT];
+
+
+/* --------------------------------------------------------------------------
+ * Forward declarations
+ * ----------------------------------------------------------------------- */
+
+static void gen_random (uint_t depth_limit);
+
+static void gen_nesting (uint_t depth);
+
+static void gen_identlist (uint_t count);
+
+static void gen_case (uint_t count);
+
+static void gen_comments (uint_t count);
+
+
+/* --------------------------------------------------------------------------
+ * function main(argc, argv)
+ * --------------------------------------------------------------------------
+ * Writes a synthetic compilation unit of the kind, size and seed given on
+ * the command line to stdout.
+ * ----------------------------------------------------------------------- */
+
+int main (int argc, char *argv[]) {
+  
+  const char *kind;
+  uint_t size;
+  
+  if (argc != 4) {
+    fprintf(stderr, "usage: m2t-gen-corpus kind size seed\n"
+      "kinds: random, nesting, identlist, case, comments\n");
+    return EXIT_FAILURE;
+  } /* end if */
+  
+  kind = argv[1];
+  size = (uint_t) strtoul(argv[2], NULL, 10);
+  random_state = (uint64_t) strtoull(argv[3], NULL, 10);
+  
+  /* avoid the all zero state */
+  random_state = random_state * 2654435761u + 0x9E3779B97F4A7C15u;
+  
+  if (strcmp(kind, "random") == 0) {
+    gen_random(size);
+  }
+  else if (strcmp(kind, "nesting") == 0) {
+    gen_nesting(size);
+  }
+  else if (strcmp(kind, "identlist") == 0) {
+    gen_identlist(size);
+  }
+  else if (strcmp(kind, "case") == 0) {
+    gen_case(size);
+  }
+  else if (strcmp(kind, "comments") == 0) {
+    gen_comments(size);
+  }
+  else {
+    fprintf(stderr, "m2t-gen-corpus: unknown kind %s\n", kind);
+    return EXIT_FAILURE;
+  } /* end if */
+  
+  return EXIT_SUCCESS;
+} /* end main */
+
+
+/* --------------------------------------------------------------------------
+ * Private Functions
+ * ----------------------------------------------------------------------- */
+
+/* --------------------------------------------------------------------------
+ * private function random_below(limit)
+ * --------------------------------------------------------------------------
+ * Returns a pseudo-random number below limit, using xorshift64.
+ * ----------------------------------------------------------------------- */
+
+static uint_t random_below (uint_t limit) {
+  random_state ^= random_state << 13;
+  random_state ^= random_state >> 7;
+  random_state ^= random_state << 17;
+  return (uint_t) (random_state % limit);
+} /* end random_below */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure emit(text)
+ * --------------------------------------------------------------------------
+ * Writes text preceded by a space, breaking lines at MAX_LINE_LENGTH.
+ * ----------------------------------------------------------------------- */
+
+static void emit (const char *text) {
+  uint_t length;
+  
+  length = strlen(text);
+  
+  if ((column > indent) && (column + length + 1 > MAX_LINE_LENGTH)) {
+    printf("\n%*s", indent, "");
+    column = indent;
+  }
+  else if (column > indent) {
+    printf(" ");
+    column++;
+  } /* end if */
+  
+  printf("%s", text);
+  column = column + length;
+} /* end emit */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure newline()
+ * --------------------------------------------------------------------------
+ * Ends the current line and indents the next.
+ * ----------------------------------------------------------------------- */
+
+static void newline (void) {
+  printf("\n%*s", indent, "");
+  column = indent;
+} /* end newline */
+
+
+/* --------------------------------------------------------------------------
+ * private function ident()
+ * --------------------------------------------------------------------------
+ * Returns a pseudo-random identifier from a fixed pool of mixed lengths.
+ * ----------------------------------------------------------------------- */
+
+static const char *ident (void) {
+  static char pool[IDENT_POOL_SIZE][24];
+  static bool initialised = false;
+  uint_t index, length, pos;
+  
+  if (!initialised) {
+    index = 0;
+    while (index < IDENT_POOL_SIZE) {
+      length = 1 + (index * 7) % 20;
+      pool[index][0] = (char) ('a' + index % 26);
+      pos = 1;
+      while (pos < length) {
+        pool[index][pos] = "abcdefghijklmnopqrstuvwxyz0123456789"
+          [(index * 31 + pos * 17) % 36];
+        pos++;
+      } /* end while */
+      sprintf(&pool[index][pos], "%u", index);
+      index++;
+    } /* end while */
+    initialised = true;
+  } /* end if */
+  
+  return pool[random_below(IDENT_POOL_SIZE)];
+} /* end ident */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure emit_terminal(token)
+ * --------------------------------------------------------------------------
+ * Writes a lexeme for token.
+ * ----------------------------------------------------------------------- */
+
+static void emit_terminal (m2t_token_t token) {
+  char number[24];
+  
+  switch (token) {
+    case TOKEN_IDENTIFIER :
+      emit(ident());
+      break;
+  
+    case TOKEN_INTEGER :
+      sprintf(number, "%u", random_below(100000));
+      emit(number);
+      break;
+  
+    case TOKEN_REAL :
+      sprintf(number, "%u.%uE%u",
+        random_below(1000), random_below(1000), random_below(10));
+      emit(number);
+      break;
+  
+    case TOKEN_CHAR :
+      sprintf(number, "%oC", 32 + random_below(95));
+      emit(number);
+      break;
+  
+    case TOKEN_STRING :
+      emit("\"lorem ipsum\"");
+      break;
+  
+    default :
+      if (m2t_is_resword_token(token)) {
+        emit(m2t_lexeme_for_resword(token));
+      }
+      else {
+        emit(m2t_lexeme_for_special_symbol(token));
+      } /* end if */
+  
+      if ((token == TOKEN_SEMICOLON) || (token == TOKEN_BEGIN)) {
+        newline();
+      } /* end if */
+  } /* end switch */
+} /* end emit_terminal */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure collect_rules()
+ * --------------------------------------------------------------------------
+ * Collects the rules of each nonterminal from the predict table and
+ * determines the rule with the shortest derivation for each.
+ * ----------------------------------------------------------------------- */
+
+static void collect_rules (void) {
+  uint_t cost[M2T_LL1_NONTERMINAL_COUNT];
+  uint_t nt, token, rule, index, sum, symbol, callee;
+  bool changed, known;
+  
+  nt = 0;
+  while (nt < M2T_LL1_NONTERMINAL_COUNT) {
+    token = 0;
+    while (token < TOKEN_END_MARK) {
+      rule = m2t_ll1_predict[nt][token];
+      if (rule != 0) {
+        known = false;
+        index = 0;
+        while (index < rule_count[nt]) {
+          known = known || (rule_list[nt][index] == rule - 1);
+          index++;
+        } /* end while */
+        if ((!known) && (rule_count[nt] < MAX_RULES_PER_NONTERMINAL)) {
+          rule_list[nt][rule_count[nt]] = rule - 1;
+          rule_count[nt]++;
+        } /* end if */
+      } /* end if */
+      token++;
+    } /* end while */
+    cost[nt] = UNKNOWN_COST;
+    nt++;
+  } /* end while */
+  
+  /* shortest derivations by fixpoint iteration */
+  do {
+    changed = false;
+    nt = 0;
+    while (nt < M2T_LL1_NONTERMINAL_COUNT) {
+      index = 0;
+      while (index < rule_count[nt]) {
+        rule = rule_list[nt][index];
+        sum = 1;
+        symbol = m2t_ll1_rhs_start[rule];
+        while ((symbol < m2t_ll1_rhs_start[rule + 1]) &&
+               (sum != UNKNOWN_COST)) {
+          if (IS_NONTERMINAL(m2t_ll1_rhs[symbol])) {
+            callee = m2t_ll1_dialect_nonterminal[RANDOM_DIALECT]
+              [m2t_ll1_rhs[symbol] - M2T_LL1_NONTERMINAL_BASE];
+            if (cost[callee] == UNKNOWN_COST) {
+              sum = UNKNOWN_COST;
+            }
+            else {
+              sum = sum + cost[callee];
+            } /* end if */
+          }
+          else {
+            sum++;
+          } /* end if */
+          symbol++;
+        } /* end while */
+        if (sum < cost[nt]) {
+          cost[nt] = sum;
+          shortest_rule[nt] = rule;
+          changed = true;
+        } /* end if */
+        index++;
+      } /* end while */
+      nt++;
+    } /* end while */
+  } while (changed);
+} /* end collect_rules */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure gen_random(depth_limit)
+ * --------------------------------------------------------------------------
+ * Writes a program module derived from the grammar tables.  Rules are
+ * chosen at random up to depth_limit, shortest rules beyond.
+ * ----------------------------------------------------------------------- */
+
+static void gen_random (uint_t depth_limit) {
+  uint16_t *stack, *depth;
+  uint_t top, capacity, symbol, level, nt, rule, index;
+  
+  collect_rules();
+  
+  capacity = 4096;
+  stack = malloc(capacity * sizeof(uint16_t));
+  depth = malloc(capacity * sizeof(uint16_t));
+  
+  if ((stack == NULL) || (depth == NULL)) {
+    fprintf(stderr, "m2t-gen-corpus: allocation failed\n");
+    exit(EXIT_FAILURE);
+  } /* end if */
+  
+  stack[0] = M2T_LL1_START_PROGRAM_MODULE;
+  depth[0] = 0;
+  top = 1;
+  
+  while (top > 0) {
+    top--;
+    symbol = stack[top];
+    level = depth[top];
+  
+    if (!IS_NONTERMINAL(symbol)) {
+      emit_terminal(symbol);
+      continue;
+    } /* end if */
+  
+    nt = m2t_ll1_dialect_nonterminal
+      [RANDOM_DIALECT][symbol - M2T_LL1_NONTERMINAL_BASE];
+  
+    if (level < depth_limit) {
+      rule = rule_list[nt][random_below(rule_count[nt])];
+    }
+    else {
+      rule = shortest_rule[nt];
+    } /* end if */
+  
+    if (top + m2t_ll1_rhs_start[rule + 1] - m2t_ll1_rhs_start[rule]
+        > capacity) {
+      capacity = 2 * capacity;
+      stack = realloc(stack, capacity * sizeof(uint16_t));
+      depth = realloc(depth, capacity * sizeof(uint16_t));
+      if ((stack == NULL) || (depth == NULL)) {
+        fprintf(stderr, "m2t-gen-corpus: allocation failed\n");
+        exit(EXIT_FAILURE);
+      } /* end if */
+    } /* end if */
+  
+    /* right hand sides are stored in reverse order */
+    index = m2t_ll1_rhs_start[rule];
+    while (index < m2t_ll1_rhs_start[rule + 1]) {
+      stack[top] = m2t_ll1_rhs[index];
+      depth[top] = (uint16_t) (level + 1);
+      top++;
+      index++;
+    } /* end while */
+  } /* end while */
+  
+  printf("\n");
+  free(stack);
+  free(depth);
+} /* end gen_random */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure gen_nesting(depth)
+ * --------------------------------------------------------------------------
+ * Writes a program with statements and expressions nested depth levels.
+ * ----------------------------------------------------------------------- */
+
+static void gen_nesting (uint_t depth) {
+  uint_t level;
+  
+  printf("MODULE Nesting;\n\nVAR i, j : INTEGER;\n\nBEGIN\n");
+  indent = 2;
+  newline();
+  
+  level = 0;
+  while (level < depth) {
+    switch (level % 4) {
+      case 0 :
+        emit("IF"); emit(ident()); emit("<"); emit(ident()); emit("THEN");
+        break;
+      case 1 :
+        emit("WHILE"); emit(ident()); emit(">"); emit("0"); emit("DO");
+        break;
+      case 2 :
+        emit("FOR"); emit("i"); emit(":="); emit("1"); emit("TO");
+        emit("10"); emit("DO");
+        break;
+      default :
+        emit("REPEAT");
+    } /* end switch */
+    indent = indent + 2;
+    newline();
+    level++;
+  } /* end while */
+  
+  /* deeply nested expression */
+  emit("j"); emit(":=");
+  level = 0;
+  while (level < depth) {
+    emit("(");
+    emit(ident());
+    emit((level % 2 == 0) ? "+" : "*");
+    level++;
+  } /* end while */
+  emit("1");
+  level = 0;
+  while (level < depth) {
+    emit(")");
+    level++;
+  } /* end while */
+  
+  while (level > 0) {
+    level--;
+    indent = indent - 2;
+    newline();
+    if (level % 4 == 3) {
+      emit("UNTIL"); emit(ident()); emit("=");  emit("0");
+    }
+    else {
+      emit("END");
+    } /* end if */
+  } /* end while */
+  
+  printf("\nEND Nesting.\n");
+} /* end gen_nesting */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure gen_identlist(count)
+ * --------------------------------------------------------------------------
+ * Writes a program with an import list and a VAR list of count identifiers.
+ * ----------------------------------------------------------------------- */
+
+static void gen_identlist (uint_t count) {
+  char name[24];
+  uint_t index;
+  
+  printf("MODULE IdentList;\n\n");
+  indent = 2;
+  
+  printf("FROM Library IMPORT");
+  column = 19;
+  index = 0;
+  while (index < count) {
+    sprintf(name, "p%u%s", index, (index + 1 < count) ? "," : ";");
+    emit(name);
+    index++;
+  } /* end while */
+  
+  printf("\n\nVAR");
+  column = 3;
+  index = 0;
+  while (index < count) {
+    sprintf(name, "v%u%s", index, (index + 1 < count) ? "," : "");
+    emit(name);
+    index++;
+  } /* end while */
+  emit(":"); emit("INTEGER;");
+  
+  printf("\n\nBEGIN\n  v0 := 0\nEND IdentList.\n");
+} /* end gen_identlist */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure gen_case(count)
+ * --------------------------------------------------------------------------
+ * Writes a program with a CASE statement of count labelled branches.
+ * ----------------------------------------------------------------------- */
+
+static void gen_case (uint_t count) {
+  uint_t index;
+  
+  printf("MODULE Case;\n\nVAR i, j : INTEGER;\n\nBEGIN\n");
+  printf("  CASE i OF\n");
+  
+  index = 0;
+  while (index < count) {
+    if (index % 3 == 0) {
+      printf("    %u .. %u : j := %s\n", 4 * index, 4 * index + 2, ident());
+    }
+    else {
+      printf("    %u, %u : j := j + %u\n", 4 * index, 4 * index + 1, index);
+    } /* end if */
+    if (index + 1 < count) {
+      printf("  | ");
+    } /* end if */
+    index++;
+  } /* end while */
+  
+  printf("  ELSE\n    j := 0\n  END\nEND Case.\n");
+} /* end gen_case */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure gen_comments(count)
+ * --------------------------------------------------------------------------
+ * Writes a program with count statements, each preceded by a comment.
+ * ----------------------------------------------------------------------- */
+
+static void gen_comments (uint_t count) {
+  uint_t index, lines;
+  
+  printf("(* Comment heavy module, generated by m2t-gen-corpus *)\n\n");
+  printf("MODULE Comments;\n\nVAR i : INTEGER;\n\nBEGIN\n");
+  
+  index = 0;
+  while (index < count) {
+    if (index % 5 == 0) {
+      printf("  (* block comment %u (* nested comment *)\n", index);
+      lines = random_below(4);
+      while (lines > 0) {
+        printf("     Lorem ipsum dolor sit amet, consectetur adipiscing.\n");
+        lines--;
+      } /* end while */
+      printf("   *)\n");
+    }
+    else {
+      printf("  (* short comment %u *)\n", index);
+    } /* end if */
+    printf("  i := i + %u%s\n", index, (index + 1 < count) ? ";" : "");
+    index++;
+  } /* end while */
+  
+  printf("END Comments.\n");
+} /* end gen_comments */
+
+
+/* END OF FILE */
@@ -0,0 +1,347 @@
+/* M2T -- Sorce to Source Modula-2 Translator
+ *
+ * Copyright (c) 2016-2023 Benjamin Kowarsch
+ *
+ * Author & Maintainer: Benjamin Kowarsch <org.m2sf>
+ *
+ * @synopsis
+ *
+ * M2T is a multi-dialect Modula-2 source-to-source translator. It translates
+ * source files  written in the  classic dialects  to semantically equivalent
+ * source files in  Modula-2 Revision 2010 (M2R10).  It supports  the classic
+ * Modula-2 dialects  described in  the 2nd, 3rd and 4th editions  of Niklaus
+ * Wirth's book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * For more details please visit: https://github.com/trijezdci/m2t/wiki
+ *
+ * @repository
+ *
+ * https://github.com/trijezdci/m2t
+ *
+ * @file
+ *
+ * m2t-startup.c
+ *
+ * Process startup benchmark for M2T.
+ *
+ * @license
+ *
+ * M2T is free software:  You can redistribute and modify it  under the terms
+ * of the  GNU Lesser General Public License (LGPL) either version 2.1  or at
+ * your choice version 3, both as published by the Free Software Foundation.
+ *
+ * M2T is distributed  in the hope  that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even  the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received  a copy of the  GNU Lesser General Public License
+ * along with M2T.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+
+/* --------------------------------------------------------------------------
+ * Usage
+ * --------------------------------------------------------------------------
+ * This tool measures the cost of translating a tiny source file, where
+ * process startup dominates, as it is met by editor and IDE integrations.
+ * It writes a ten line program module to STARTUP_SOURCE_PATH, then runs
+ * the given translator on it repeatedly, passing the path of the module as
+ * the first argument, followed by any given options:
+ *
+ *   m2t-startup [-n repeat] translator [option ...]
+ *
+ * For each run, the wall clock time and the processor time of the child
+ * process are measured.  The fastest and the median run are reported.
+ * Processor time is user plus system time and includes loading, dynamic
+ * linking and static initialisation of the translator.
+ *
+ * Building the tool, from within directory src:
+ *
+ *   cc -o m2t-startup bench/m2t-startup.c
+ * ----------------------------------------------------------------------- */
+
+/* clock_gettime() and CLOCK_MONOTONIC are not part of ISO C99 */
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+#include <fcntl.h>
+#include <spawn.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+
+
+/* --------------------------------------------------------------------------
+ * Benchmark parameters
+ * ----------------------------------------------------------------------- */
+
+#define DEFAULT_REPEAT 50
+
+#define MAX_REPEAT 10000
+
+#define STARTUP_SOURCE_PATH "Startup.mod"
+
+
+/* --------------------------------------------------------------------------
+ * private variable startup_source
+ * --------------------------------------------------------------------------
+ * Ten line program module passed to the translator.
+ * ----------------------------------------------------------------------- */
+
+static const char *startup_source =
+  "MODULE Startup;\n"
+  "\n"
+  "VAR i, sum : CARDINAL;\n"
+  "\n"
+  "BEGIN\n"
+  "  sum := 0;\n"
+  "  FOR i := 1 TO 10 DO\n"
+  "    sum := sum + i\n"
+  "  END\n"
+  "END Startup.\n";
+
+
+/* --------------------------------------------------------------------------
+ * private type sample_t
+ * --------------------------------------------------------------------------
+ * Record type holding wall clock and processor time of a run.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* wall */ uint64_t wall;
+  /* cpu */ uint64_t cpu;
+} sample_t;
+
+
+/* --------------------------------------------------------------------------
+ * Forward declarations
+ * ----------------------------------------------------------------------- */
+
+extern char **environ;
+
+static bool write_source (const char *path);
+
+static bool run_once (char *argv[], sample_t *sample);
+
+static int compare_samples (const void *sample1, const void *sample2);
+
+static void print_sample (const char *label, const sample_t *sample);
+
+
+/* --------------------------------------------------------------------------
+ * function main(argc, argv)
+ * --------------------------------------------------------------------------
+ * Runs the translator given on the command line repeatedly on the startup
+ * module and prints the fastest and the median run.
+ * ----------------------------------------------------------------------- */
+
+int main (int argc, char *argv[]) {
+  
+  sample_t *sample;
+  char **child_argv;
+  unsigned long repeat, run;
+  int index, arg;
+  
+  repeat = DEFAULT_REPEAT;
+  index = 1;
+  
+  if ((argc > 2) && (strcmp(argv[1], "-n") == 0)) {
+    repeat = strtoul(argv[2], NULL, 10);
+    if (repeat == 0) {
+      repeat = 1;
+    }
+    else if (repeat > MAX_REPEAT) {
+      repeat = MAX_REPEAT;
+    } /* end if */
+    index = 3;
+  } /* end if */
+  
+  if (index >= argc) {
+    fprintf(stderr, "usage: m2t-startup [-n repeat] translator [option ...]\n");
+    return EXIT_FAILURE;
+  } /* end if */
+  
+  if (!write_source(STARTUP_SOURCE_PATH)) {
+    fprintf(stderr, "m2t-startup: cannot write %s\n", STARTUP_SOURCE_PATH);
+    return EXIT_FAILURE;
+  } /* end if */
+  
+  /* translator, source path, options and terminating NULL */
+  child_argv = malloc((size_t) (argc - index + 2) * sizeof(char *));
+  sample = malloc(repeat * sizeof(sample_t));
+  
+  if ((child_argv == NULL) || (sample == NULL)) {
+    fprintf(stderr, "m2t-startup: out of memory\n");
+    return EXIT_FAILURE;
+  } /* end if */
+  
+  child_argv[0] = argv[index];
+  child_argv[1] = STARTUP_SOURCE_PATH;
+  arg = 2;
+  for (index = index + 1; index < argc; index++) {
+    child_argv[arg] = argv[index];
+    arg++;
+  } /* end for */
+  child_argv[arg] = NULL;
+  
+  for (run = 0; run < repeat; run++) {
+    if (!run_once(child_argv, &sample[run])) {
+      fprintf(stderr, "m2t-startup: run %lu of %s failed\n",
+        run + 1, child_argv[0]);
+      remove(STARTUP_SOURCE_PATH);
+      return EXIT_FAILURE;
+    } /* end if */
+  } /* end for */
+  
+  remove(STARTUP_SOURCE_PATH);
+  
+  /* samples are ordered by processor time */
+  qsort(sample, repeat, sizeof(sample_t), compare_samples);
+  
+  printf("%-8s %10s %10s\n", "run", "wall ms", "cpu ms");
+  print_sample("fastest", &sample[0]);
+  print_sample("median", &sample[repeat / 2]);
+  
+  free(sample);
+  free(child_argv);
+  
+  return EXIT_SUCCESS;
+} /* end main */
+
+
+/* --------------------------------------------------------------------------
+ * Private Functions
+ * ----------------------------------------------------------------------- */
+
+/* --------------------------------------------------------------------------
+ * private function now()
+ * --------------------------------------------------------------------------
+ * Returns the value of a monotonic clock in nanoseconds.
+ * ----------------------------------------------------------------------- */
+
+static uint64_t now (void) {
+  struct timespec time;
+  
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return (uint64_t) time.tv_sec * 1000000000u + (uint64_t) time.tv_nsec;
+} /* end now */
+
+
+/* --------------------------------------------------------------------------
+ * private function children_cpu_time()
+ * --------------------------------------------------------------------------
+ * Returns the user plus system time of all terminated and waited for child
+ * processes in nanoseconds.
+ * ----------------------------------------------------------------------- */
+
+static uint64_t children_cpu_time (void) {
+  struct rusage usage;
+  
+  if (getrusage(RUSAGE_CHILDREN, &usage) != 0) {
+    return 0;
+  } /* end if */
+  
+  return
+    ((uint64_t) usage.ru_utime.tv_sec + (uint64_t) usage.ru_stime.tv_sec) *
+      1000000000u +
+    ((uint64_t) usage.ru_utime.tv_usec + (uint64_t) usage.ru_stime.tv_usec) *
+      1000u;
+} /* end children_cpu_time */
+
+
+/* --------------------------------------------------------------------------
+ * private function write_source(path)
+ * --------------------------------------------------------------------------
+ * Writes the startup module to the file at path.  Returns true on success.
+ * ----------------------------------------------------------------------- */
+
+static bool write_source (const char *path) {
+  FILE *file;
+  bool written;
+  
+  file = fopen(path, "w");
+  if (file == NULL) {
+    return false;
+  } /* end if */
+  
+  written = (fputs(startup_source, file) >= 0);
+  written = (fclose(file) == 0) && written;
+  
+  return written;
+} /* end write_source */
+
+
+/* --------------------------------------------------------------------------
+ * private function run_once(argv, sample)
+ * --------------------------------------------------------------------------
+ * Runs argv[0] with arguments argv and its output discarded, waits for it
+ * and passes its times back in sample.  Returns true if the child process
+ * was started and exited with status zero, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+static bool run_once (char *argv[], sample_t *sample) {
+  
+  posix_spawn_file_actions_t actions;
+  uint64_t start, cpu;
+  pid_t pid;
+  int status, result;
+  
+  if (posix_spawn_file_actions_init(&actions) != 0) {
+    return false;
+  } /* end if */
+  
+  /* output is discarded, writing it would be measured too */
+  posix_spawn_file_actions_addopen
+    (&actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+  posix_spawn_file_actions_addopen
+    (&actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+  
+  cpu = children_cpu_time();
+  start = now();
+  
+  result = posix_spawnp(&pid, argv[0], &actions, NULL, argv, environ);
+  posix_spawn_file_actions_destroy(&actions);
+  
+  if ((result != 0) || (waitpid(pid, &status, 0) != pid)) {
+    return false;
+  } /* end if */
+  
+  sample->wall = now() - start;
+  sample->cpu = children_cpu_time() - cpu;
+  
+  return (WIFEXITED(status)) && (WEXITSTATUS(status) == 0);
+} /* end run_once */
+
+
+/* --------------------------------------------------------------------------
+ * private function compare_samples(sample1, sample2)
+ * --------------------------------------------------------------------------
+ * Compares two samples by processor time for use with qsort().
+ * ----------------------------------------------------------------------- */
+
+static int compare_samples (const void *sample1, const void *sample2) {
+  const sample_t *s1 = sample1, *s2 = sample2;
+  
+  return (s1->cpu > s2->cpu) - (s1->cpu < s2->cpu);
+} /* end compare_samples */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure print_sample(label, sample)
+ * --------------------------------------------------------------------------
+ * Prints the wall clock and processor time of sample in milliseconds.
+ * ----------------------------------------------------------------------- */
+
+static void print_sample (const char *label, const sample_t *sample) {
+  
+  printf("%-8s %10.3f %10.3f\n", label,
+    (double) sample->wall / 1e6, (double) sample->cpu / 1e6);
+} /* end print_sample */
+
+
+/* END OF FILE */
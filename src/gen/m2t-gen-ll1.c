@@ -0,0 +1,1562 @@
+/* M2T -- Sorce to Source Modula-2 Translator
+ *
+ * Copyright (c) 2016-2023 Benjamin Kowarsch
+ *
+ * Author & Maintainer: Benjamin Kowarsch <org.m2sf>
+ *
+ * @synopsis
+ *
+ * M2T is a multi-dialect Modula-2 source-to-source translator. It translates
+ * source files  written in the  classic dialects  to semantically equivalent
+ * source files in  Modula-2 Revision 2010 (M2R10).  It supports  the classic
+ * Modula-2 dialects  described in  the 2nd, 3rd and 4th editions  of Niklaus
+ * Wirth's book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * For more details please visit: https://github.com/trijezdci/m2t/wiki
+ *
+ * @repository
+ *
+ * https://github.com/trijezdci/m2t
+ *
+ * @file
+ *
+ * m2t-gen-ll1.c
+ *
+ * Build-time generator for the M2T table driven LL(1) parser tables.
+ *
+ * @license
+ *
+ * M2T is free software:  You can redistribute and modify it  under the terms
+ * of the  GNU Lesser General Public License (LGPL) either version 2.1  or at
+ * your choice version 3, both as published by the Free Software Foundation.
+ *
+ * M2T is distributed  in the hope  that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even  the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received  a copy of the  GNU Lesser General Public License
+ * along with M2T.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+
+/* --------------------------------------------------------------------------
+ * Usage
+ * --------------------------------------------------------------------------
+ * This build-time tool reads the grammar in grammar/m2-grammar.gll and
+ * emits the tables of the table driven LL(1) parser in m2t-ll1-parser.c.
+ *
+ * The EBNF rules reachable from compilationUnit are rewritten as plain BNF.
+ * Each optional, repeated or parenthesised part becomes a synthesised
+ * nonterminal named after its rule, such as definition/2.  The tool then
+ * computes FIRST and FOLLOW sets and builds the predict table.  Terminals
+ * that the lexer cannot produce make their alternative unmatchable, so that
+ * alternative is dropped, such as FOREIGN in FOREIGN?.
+ *
+ * A nonterminal that is defined more than once has one definition per
+ * dialect.  Dialect n uses the n-th definition, or the last where there
+ * are fewer.  Conflicts between an empty and a non-empty alternative are
+ * resolved in favour of the non-empty one, like a dangling ELSE.  Any other
+ * conflict is reported and the earlier alternative is used.
+ *
+ * Building the tool, from within directory src:
+ *
+ *   cc -I. -o m2t-gen-ll1 gen/m2t-gen-ll1.c \
+ *     imp/m2t-tokenset.c imp/m2t-token.c
+ *
+ * Regenerating the tables after a change to the grammar:
+ *
+ *   ./m2t-gen-ll1 ../grammar/m2-grammar.gll > m2t-ll1-tables.h
+ * ----------------------------------------------------------------------- */
+
+#include "m2t-common.h"
+#include "m2t-token.h"
+#include "m2t-tokenset.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+
+/* --------------------------------------------------------------------------
+ * Table limits
+ * ----------------------------------------------------------------------- */
+
+#define MAX_LEXEME_LENGTH 80
+
+#define MAX_DEFINITIONS 256
+
+#define MAX_ALIASES 64
+
+#define MAX_RESERVED 64
+
+#define MAX_NONTERMINALS 1024
+
+#define MAX_RULES 2048
+
+#define MAX_RHS_SYMBOLS 8192
+
+#define MAX_SEQUENCE_LENGTH 64
+
+#define MAX_DIALECTS 4
+
+
+/* --------------------------------------------------------------------------
+ * Symbol encoding
+ * --------------------------------------------------------------------------
+ * Terminals are encoded as their token value, nonterminal n is encoded
+ * as NONTERMINAL_BASE + n.  Must match M2T_LL1_NONTERMINAL_BASE.
+ * ----------------------------------------------------------------------- */
+
+#define NONTERMINAL_BASE 128
+
+#define IS_NONTERMINAL(_sym) ((_sym) >= NONTERMINAL_BASE)
+
+#define NT_INDEX(_sym) ((_sym) - NONTERMINAL_BASE)
+
+
+/* --------------------------------------------------------------------------
+ * private type gll_token_t
+ * --------------------------------------------------------------------------
+ * Enumerated tokens of the grammar notation.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  GLL_EOF,
+  GLL_NAME,
+  GLL_NUMBER,
+  GLL_QUOTED,
+  GLL_DEFINE,
+  GLL_BAR,
+  GLL_LPAREN,
+  GLL_RPAREN,
+  GLL_OPTION,
+  GLL_STAR,
+  GLL_PLUS,
+  GLL_SEMICOLON,
+  GLL_COMMA,
+  GLL_EQUAL,
+  GLL_PERIOD,
+  GLL_RANGE,
+  GLL_INVALID
+} gll_token_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type expr_t
+ * --------------------------------------------------------------------------
+ * Pointer type for nodes of parsed EBNF expressions.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  EXPR_ALT,
+  EXPR_SEQ,
+  EXPR_NAME,
+  EXPR_QUOTED,
+  EXPR_OPTION,
+  EXPR_STAR,
+  EXPR_PLUS,
+  EXPR_OTHER
+} expr_kind_t;
+
+typedef struct expr_s *expr_t;
+
+struct expr_s {
+  /* kind */ expr_kind_t kind;
+  /* text */ char *text;
+  /* line */ uint_t line;
+  /* count */ uint_t count;
+  /* item */ expr_t *item;
+};
+
+
+/* --------------------------------------------------------------------------
+ * private variables for the grammar reader
+ * ----------------------------------------------------------------------- */
+
+static const char *gll_path;
+
+static char *gll_text;
+
+static uint_t gll_pos, gll_line;
+
+static gll_token_t lookahead;
+
+static char lexeme[MAX_LEXEME_LENGTH + 1];
+
+static uint_t lexeme_line;
+
+
+/* --------------------------------------------------------------------------
+ * private variables for the parsed grammar
+ * ----------------------------------------------------------------------- */
+
+static struct {
+  /* name */ char *name;
+  /* expr */ expr_t expr;
+  /* line */ uint_t line;
+} definition[MAX_DEFINITIONS];
+
+static uint_t definition_count;
+
+static struct {
+  /* name */ char *name;
+  /* target */ char *target;
+} alias[MAX_ALIASES];
+
+static uint_t alias_count;
+
+static char *reserved[MAX_RESERVED];
+
+static uint_t reserved_count;
+
+
+/* --------------------------------------------------------------------------
+ * private variables for the BNF grammar
+ * ----------------------------------------------------------------------- */
+
+static char *nt_name[MAX_NONTERMINALS];
+
+static expr_t nt_expr[MAX_NONTERMINALS];
+
+static uint_t nt_variant[MAX_NONTERMINALS][MAX_DIALECTS];
+
+static uint_t nt_variant_count[MAX_NONTERMINALS];
+
+static uint_t nt_origin[MAX_NONTERMINALS];
+
+static uint_t nt_synth_count[MAX_NONTERMINALS];
+
+static uint_t nt_count, nt_lowered;
+
+static uint_t rule_lhs[MAX_RULES];
+
+static uint_t rule_start[MAX_RULES + 1];
+
+static uint_t rhs[MAX_RHS_SYMBOLS];
+
+static uint_t rule_count, rhs_count, dialect_count;
+
+
+/* --------------------------------------------------------------------------
+ * private variables for the LL(1) analysis
+ * ----------------------------------------------------------------------- */
+
+static bool nullable[MAX_NONTERMINALS];
+
+static m2t_tokenset_t first[MAX_NONTERMINALS];
+
+static m2t_tokenset_t follow[MAX_NONTERMINALS];
+
+static uint_t predict[MAX_NONTERMINALS][TOKEN_END_MARK];
+
+static bool by_follow[MAX_NONTERMINALS][TOKEN_END_MARK];
+
+static uint_t conflict_count;
+
+
+/* --------------------------------------------------------------------------
+ * private variable start_symbol
+ * --------------------------------------------------------------------------
+ * Rules for which start symbol macros are emitted.
+ * ----------------------------------------------------------------------- */
+
+static const char *start_symbol[] = {
+  "compilationUnit", "definitionModule",
+  "implementationModule", "programModule", NULL
+}; /* end start_symbol */
+
+
+/* --------------------------------------------------------------------------
+ * Forward declarations
+ * ----------------------------------------------------------------------- */
+
+static void read_grammar (const char *path);
+
+static void lower_grammar (void);
+
+static void analyse_grammar (void);
+
+static void build_predict_table (void);
+
+static void emit_tables (void);
+
+
+/* --------------------------------------------------------------------------
+ * function main(argc, argv)
+ * --------------------------------------------------------------------------
+ * Reads the grammar file given on the command line and emits the parser
+ * tables to stdout.
+ * ----------------------------------------------------------------------- */
+
+int main (int argc, char *argv[]) {
+  
+  if (argc != 2) {
+    fprintf(stderr, "usage: m2t-gen-ll1 grammar-file\n");
+    return EXIT_FAILURE;
+  } /* end if */
+  
+  read_grammar(argv[1]);
+  lower_grammar();
+  analyse_grammar();
+  build_predict_table();
+  emit_tables();
+  
+  fprintf(stderr, "m2t-gen-ll1: %u nonterminals, %u rules, %u conflicts\n",
+    nt_count, rule_count, conflict_count);
+  
+  return EXIT_SUCCESS;
+} /* end main */
+
+
+/* --------------------------------------------------------------------------
+ * Private Functions
+ * ----------------------------------------------------------------------- */
+
+/* --------------------------------------------------------------------------
+ * private procedure fatal(line, message, detail)
+ * --------------------------------------------------------------------------
+ * Reports an error in the grammar file and exits.
+ * ----------------------------------------------------------------------- */
+
+static void fatal (uint_t line, const char *message, const char *detail) {
+  fprintf(stderr, "m2t-gen-ll1: %s:%u: %s %s\n",
+    gll_path, line, message, (detail != NULL) ? detail : "");
+  exit(EXIT_FAILURE);
+} /* end fatal */
+
+
+/* --------------------------------------------------------------------------
+ * private function new_string(chars)
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated copy of chars.
+ * ----------------------------------------------------------------------- */
+
+static char *new_string (const char *chars) {
+  char *copy;
+  
+  copy = malloc(strlen(chars) + 1);
+  if (copy == NULL) {
+    fatal(0, "allocation failed", NULL);
+  } /* end if */
+  
+  strcpy(copy, chars);
+  return copy;
+} /* end new_string */
+
+
+/* --------------------------------------------------------------------------
+ * private function next_token()
+ * --------------------------------------------------------------------------
+ * Reads the next token of the grammar file into lookahead and lexeme.
+ * ----------------------------------------------------------------------- */
+
+static gll_token_t next_token (void) {
+  uint_t length;
+  char ch, delimiter;
+  
+  /* skip whitespace and comments */
+  while (true) {
+    ch = gll_text[gll_pos];
+    if (ch == '\n') {
+      gll_line++;
+      gll_pos++;
+    }
+    else if (isspace((unsigned char) ch)) {
+      gll_pos++;
+    }
+    else if ((ch == '/') && (gll_text[gll_pos + 1] == '*')) {
+      gll_pos = gll_pos + 2;
+      while ((gll_text[gll_pos] != ASCII_NUL) &&
+             ((gll_text[gll_pos] != '*') || (gll_text[gll_pos + 1] != '/'))) {
+        if (gll_text[gll_pos] == '\n') {
+          gll_line++;
+        } /* end if */
+        gll_pos++;
+      } /* end while */
+      if (gll_text[gll_pos] != ASCII_NUL) {
+        gll_pos = gll_pos + 2;
+      } /* end if */
+    }
+    else {
+      break;
+    } /* end if */
+  } /* end while */
+  
+  lexeme_line = gll_line;
+  lexeme[0] = ASCII_NUL;
+  length = 0;
+  ch = gll_text[gll_pos];
+  
+  if (ch == ASCII_NUL) {
+    lookahead = GLL_EOF;
+  }
+  else if (isalnum((unsigned char) ch)) {
+    lookahead = isalpha((unsigned char) ch) ? GLL_NAME : GLL_NUMBER;
+    while ((isalnum((unsigned char) gll_text[gll_pos])) &&
+           (length < MAX_LEXEME_LENGTH)) {
+      lexeme[length] = gll_text[gll_pos];
+      length++;
+      gll_pos++;
+    } /* end while */
+    lexeme[length] = ASCII_NUL;
+  }
+  else if ((ch == '\'') || (ch == '"')) {
+    delimiter = ch;
+    gll_pos++;
+    while ((gll_text[gll_pos] != delimiter) &&
+           (gll_text[gll_pos] != '\n') && (gll_text[gll_pos] != ASCII_NUL) &&
+           (length < MAX_LEXEME_LENGTH)) {
+      lexeme[length] = gll_text[gll_pos];
+      length++;
+      gll_pos++;
+    } /* end while */
+    lexeme[length] = ASCII_NUL;
+    if (gll_text[gll_pos] != delimiter) {
+      fatal(lexeme_line, "unterminated literal", lexeme);
+    } /* end if */
+    gll_pos++;
+    lookahead = GLL_QUOTED;
+  }
+  else {
+    gll_pos++;
+    switch (ch) {
+      case ':' :
+        if (gll_text[gll_pos] == '=') {
+          gll_pos++;
+          lookahead = GLL_DEFINE;
+        }
+        else {
+          lookahead = GLL_INVALID;
+        } /* end if */
+        break;
+  
+      case '.' :
+        if (gll_text[gll_pos] == '.') {
+          gll_pos++;
+          lookahead = GLL_RANGE;
+        }
+        else {
+          lookahead = GLL_PERIOD;
+        } /* end if */
+        break;
+  
+      case '|' : lookahead = GLL_BAR; break;
+      case '(' : lookahead = GLL_LPAREN; break;
+      case ')' : lookahead = GLL_RPAREN; break;
+      case '?' : lookahead = GLL_OPTION; break;
+      case '*' : lookahead = GLL_STAR; break;
+      case '+' : lookahead = GLL_PLUS; break;
+      case ';' : lookahead = GLL_SEMICOLON; break;
+      case ',' : lookahead = GLL_COMMA; break;
+      case '=' : lookahead = GLL_EQUAL; break;
+      default : lookahead = GLL_INVALID;
+    } /* end switch */
+  } /* end if */
+  
+  return lookahead;
+} /* end next_token */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure expect(token, description)
+ * --------------------------------------------------------------------------
+ * Consumes token if it is the lookahead, otherwise reports an error.
+ * ----------------------------------------------------------------------- */
+
+static void expect (gll_token_t token, const char *description) {
+  if (lookahead != token) {
+    fatal(lexeme_line, "expected", description);
+  } /* end if */
+  next_token();
+} /* end expect */
+
+
+/* --------------------------------------------------------------------------
+ * private function new_expr(kind, text)
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated expression node without items.
+ * ----------------------------------------------------------------------- */
+
+static expr_t new_expr (expr_kind_t kind, const char *text) {
+  expr_t expr;
+  
+  expr = malloc(sizeof(struct expr_s));
+  if (expr == NULL) {
+    fatal(0, "allocation failed", NULL);
+  } /* end if */
+  
+  expr->kind = kind;
+  expr->text = (text != NULL) ? new_string(text) : NULL;
+  expr->line = lexeme_line;
+  expr->count = 0;
+  expr->item = NULL;
+  
+  return expr;
+} /* end new_expr */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure add_item(expr, item)
+ * --------------------------------------------------------------------------
+ * Appends item to the items of expr.
+ * ----------------------------------------------------------------------- */
+
+static void add_item (expr_t expr, expr_t item) {
+  expr->item = realloc(expr->item, (expr->count + 1) * sizeof(expr_t));
+  if (expr->item == NULL) {
+    fatal(0, "allocation failed", NULL);
+  } /* end if */
+  
+  expr->item[expr->count] = item;
+  expr->count++;
+} /* end add_item */
+
+
+/* --------------------------------------------------------------------------
+ * private functions for parsing EBNF expressions
+ * --------------------------------------------------------------------------
+ * alternatives := sequence ( '|' sequence )* ;
+ * sequence := item* ;
+ * item := primary ( '..' primary )? ( '?' | '*' | '+' )? ;
+ * primary := Name | Number | Quoted | '(' alternatives ')' ;
+ * ----------------------------------------------------------------------- */
+
+static expr_t parse_alternatives (void);
+
+static expr_t parse_primary (void) {
+  expr_t expr;
+  
+  switch (lookahead) {
+    case GLL_NAME :
+      expr = new_expr(EXPR_NAME, lexeme);
+      next_token();
+      break;
+  
+    case GLL_QUOTED :
+      expr = new_expr(EXPR_QUOTED, lexeme);
+      next_token();
+      break;
+  
+    case GLL_NUMBER :
+      expr = new_expr(EXPR_OTHER, lexeme);
+      next_token();
+      break;
+  
+    case GLL_LPAREN :
+      next_token();
+      expr = parse_alternatives();
+      expect(GLL_RPAREN, "')'");
+      break;
+  
+    default :
+      fatal(lexeme_line, "expected expression, found", lexeme);
+      expr = NULL;
+  } /* end switch */
+  
+  return expr;
+} /* end parse_primary */
+
+
+static expr_t parse_item (void) {
+  expr_t expr, range, repeat;
+  
+  expr = parse_primary();
+  
+  if (lookahead == GLL_RANGE) {
+    range = new_expr(EXPR_OTHER, "..");
+    next_token();
+    add_item(range, expr);
+    add_item(range, parse_primary());
+    expr = range;
+  } /* end if */
+  
+  if ((lookahead == GLL_OPTION) ||
+      (lookahead == GLL_STAR) || (lookahead == GLL_PLUS)) {
+    if (lookahead == GLL_OPTION) {
+      repeat = new_expr(EXPR_OPTION, NULL);
+    }
+    else if (lookahead == GLL_STAR) {
+      repeat = new_expr(EXPR_STAR, NULL);
+    }
+    else /* GLL_PLUS */ {
+      repeat = new_expr(EXPR_PLUS, NULL);
+    } /* end if */
+    next_token();
+    add_item(repeat, expr);
+    expr = repeat;
+  } /* end if */
+  
+  return expr;
+} /* end parse_item */
+
+
+static expr_t parse_sequence (void) {
+  expr_t seq;
+  
+  seq = new_expr(EXPR_SEQ, NULL);
+  
+  while ((lookahead == GLL_NAME) || (lookahead == GLL_QUOTED) ||
+         (lookahead == GLL_NUMBER) || (lookahead == GLL_LPAREN)) {
+    add_item(seq, parse_item());
+  } /* end while */
+  
+  return seq;
+} /* end parse_sequence */
+
+
+static expr_t parse_alternatives (void) {
+  expr_t seq, alt;
+  
+  seq = parse_sequence();
+  
+  if (lookahead != GLL_BAR) {
+    return seq;
+  } /* end if */
+  
+  alt = new_expr(EXPR_ALT, NULL);
+  add_item(alt, seq);
+  
+  while (lookahead == GLL_BAR) {
+    next_token();
+    add_item(alt, parse_sequence());
+  } /* end while */
+  
+  return alt;
+} /* end parse_alternatives */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure read_grammar(path)
+ * --------------------------------------------------------------------------
+ * Reads and parses the grammar file at path.
+ *
+ * grammar := 'grammar' Name ';' statement* 'endg' Name '.' ;
+ * statement := reserved | alias | rule ;
+ * reserved := 'reserved' Name ( ',' Name )* ';' ;
+ * alias := 'alias' Name ( ',' Name )* '=' Name ';' ;
+ * rule := '.'? Name ':=' alternatives ';' ;
+ * ----------------------------------------------------------------------- */
+
+static void read_grammar (const char *path) {
+  FILE *file;
+  long size;
+  char *names[MAX_ALIASES];
+  uint_t name_count, index;
+  
+  gll_path = path;
+  
+  file = fopen(path, "rb");
+  if (file == NULL) {
+    fatal(0, "cannot open file", NULL);
+  } /* end if */
+  
+  fseek(file, 0, SEEK_END);
+  size = ftell(file);
+  fseek(file, 0, SEEK_SET);
+  
+  gll_text = malloc((size_t) size + 1);
+  if ((gll_text == NULL) ||
+      (fread(gll_text, 1, (size_t) size, file) != (size_t) size)) {
+    fatal(0, "cannot read file", NULL);
+  } /* end if */
+  
+  gll_text[size] = ASCII_NUL;
+  fclose(file);
+  
+  gll_pos = 0;
+  gll_line = 1;
+  next_token();
+  
+  /* grammar header */
+  if ((lookahead != GLL_NAME) || (strcmp(lexeme, "grammar") != 0)) {
+    fatal(lexeme_line, "expected", "grammar");
+  } /* end if */
+  next_token();
+  expect(GLL_NAME, "grammar name");
+  expect(GLL_SEMICOLON, "';'");
+  
+  while (true) {
+    if (lookahead == GLL_PERIOD) {
+      /* fragment rules are treated like any other rule */
+      next_token();
+    } /* end if */
+  
+    if (lookahead != GLL_NAME) {
+      fatal(lexeme_line, "expected statement, found", lexeme);
+    } /* end if */
+  
+    if (strcmp(lexeme, "endg") == 0) {
+      break;
+    }
+    else if (strcmp(lexeme, "reserved") == 0) {
+      do {
+        next_token();
+        if ((lookahead != GLL_NAME) || (reserved_count == MAX_RESERVED)) {
+          fatal(lexeme_line, "invalid reserved word list", NULL);
+        } /* end if */
+        reserved[reserved_count] = new_string(lexeme);
+        reserved_count++;
+        next_token();
+      } while (lookahead == GLL_COMMA);
+      expect(GLL_SEMICOLON, "';'");
+    }
+    else if (strcmp(lexeme, "alias") == 0) {
+      name_count = 0;
+      do {
+        next_token();
+        if ((lookahead != GLL_NAME) || (name_count == MAX_ALIASES)) {
+          fatal(lexeme_line, "invalid alias list", NULL);
+        } /* end if */
+        names[name_count] = new_string(lexeme);
+        name_count++;
+        next_token();
+      } while (lookahead == GLL_COMMA);
+      expect(GLL_EQUAL, "'='");
+      if (lookahead != GLL_NAME) {
+        fatal(lexeme_line, "expected alias target", NULL);
+      } /* end if */
+      index = 0;
+      while (index < name_count) {
+        if (alias_count == MAX_ALIASES) {
+          fatal(lexeme_line, "too many aliases", NULL);
+        } /* end if */
+        alias[alias_count].name = names[index];
+        alias[alias_count].target = new_string(lexeme);
+        alias_count++;
+        index++;
+      } /* end while */
+      next_token();
+      expect(GLL_SEMICOLON, "';'");
+    }
+    else /* rule */ {
+      if (definition_count == MAX_DEFINITIONS) {
+        fatal(lexeme_line, "too many rules", NULL);
+      } /* end if */
+      definition[definition_count].name = new_string(lexeme);
+      definition[definition_count].line = lexeme_line;
+      next_token();
+      expect(GLL_DEFINE, "':='");
+      definition[definition_count].expr = parse_alternatives();
+      definition_count++;
+      expect(GLL_SEMICOLON, "';'");
+    } /* end if */
+  } /* end while */
+} /* end read_grammar */
+
+
+/* --------------------------------------------------------------------------
+ * private function resolve_alias(name)
+ * --------------------------------------------------------------------------
+ * Returns the name that name is an alias of, or name if it is no alias.
+ * ----------------------------------------------------------------------- */
+
+static const char *resolve_alias (const char *name) {
+  uint_t index, depth;
+  
+  depth = 0;
+  index = 0;
+  while (index < alias_count) {
+    if (strcmp(alias[index].name, name) == 0) {
+      name = alias[index].target;
+      depth++;
+      if (depth > MAX_ALIASES) {
+        fatal(0, "circular alias", name);
+      } /* end if */
+      index = 0;
+    }
+    else {
+      index++;
+    } /* end if */
+  } /* end while */
+  
+  return name;
+} /* end resolve_alias */
+
+
+/* --------------------------------------------------------------------------
+ * private function new_nonterminal(name, expr)
+ * --------------------------------------------------------------------------
+ * Allocates a nonterminal with name that is defined by expr, or by rules
+ * added later if expr is NULL.  Returns its encoded symbol.
+ * ----------------------------------------------------------------------- */
+
+static uint_t new_nonterminal (const char *name, expr_t expr) {
+  uint_t nt;
+  
+  if (nt_count == MAX_NONTERMINALS) {
+    fatal(0, "too many nonterminals", NULL);
+  } /* end if */
+  
+  nt = nt_count;
+  nt_name[nt] = new_string(name);
+  nt_expr[nt] = expr;
+  nt_variant[nt][0] = nt;
+  nt_variant_count[nt] = 1;
+  nt_origin[nt] = nt;
+  nt_synth_count[nt] = 0;
+  nt_count++;
+  
+  return NONTERMINAL_BASE + nt;
+} /* end new_nonterminal */
+
+
+/* --------------------------------------------------------------------------
+ * private function synthesised_nonterminal(lhs)
+ * --------------------------------------------------------------------------
+ * Allocates a synthesised nonterminal for a part of the rule of lhs.
+ * ----------------------------------------------------------------------- */
+
+static uint_t synthesised_nonterminal (uint_t lhs) {
+  char name[MAX_LEXEME_LENGTH + 16];
+  uint_t base;
+  
+  /* synthesised names are numbered per rule of the original grammar */
+  base = nt_origin[NT_INDEX(lhs)];
+  nt_synth_count[base]++;
+  sprintf(name, "%s/%u", nt_name[base], nt_synth_count[base]);
+  
+  lhs = new_nonterminal(name, NULL);
+  nt_origin[NT_INDEX(lhs)] = base;
+  
+  return lhs;
+} /* end synthesised_nonterminal */
+
+
+/* --------------------------------------------------------------------------
+ * private function symbol_for_name(name, line, symbol)
+ * --------------------------------------------------------------------------
+ * Passes the symbol for name back in symbol and returns true, or returns
+ * false if name is a terminal the lexer cannot produce.
+ * ----------------------------------------------------------------------- */
+
+static bool symbol_for_name (const char *name, uint_t line, uint_t *symbol) {
+  uint_t index, nt, number;
+  char variant_name[MAX_LEXEME_LENGTH + 16];
+  m2t_token_t token;
+  
+  name = resolve_alias(name);
+  
+  /* named terminals */
+  if (strcmp(name, "Ident") == 0) {
+    *symbol = TOKEN_IDENTIFIER;
+    return true;
+  } /* end if */
+  
+  /* reserved words */
+  index = 0;
+  while (index < reserved_count) {
+    if (strcmp(reserved[index], name) == 0) {
+      token = m2t_token_for_resword(name, strlen(name));
+      if (token == TOKEN_UNKNOWN) {
+        fprintf(stderr, "m2t-gen-ll1: %s:%u: note: no token for %s, "
+          "alternative dropped\n", gll_path, line, name);
+        return false;
+      } /* end if */
+      *symbol = token;
+      return true;
+    } /* end if */
+    index++;
+  } /* end while */
+  
+  /* known nonterminals, including literal classes */
+  nt = 0;
+  while (nt < nt_count) {
+    if (strcmp(nt_name[nt], name) == 0) {
+      *symbol = NONTERMINAL_BASE + nt;
+      return true;
+    } /* end if */
+    nt++;
+  } /* end while */
+  
+  /* literal classes */
+  if (strcmp(name, "NumberLiteral") == 0) {
+    *symbol = new_nonterminal(name, NULL);
+    nt = NT_INDEX(*symbol);
+    rule_lhs[rule_count] = nt; rule_start[rule_count] = rhs_count;
+    rhs[rhs_count++] = TOKEN_INTEGER; rule_count++;
+    rule_lhs[rule_count] = nt; rule_start[rule_count] = rhs_count;
+    rhs[rhs_count++] = TOKEN_REAL; rule_count++;
+    rule_lhs[rule_count] = nt; rule_start[rule_count] = rhs_count;
+    rhs[rhs_count++] = TOKEN_CHAR; rule_count++;
+    rule_start[rule_count] = rhs_count;
+    return true;
+  }
+  else if (strcmp(name, "StringLiteral") == 0) {
+    *symbol = TOKEN_STRING;
+    return true;
+  } /* end if */
+  
+  /* rules, one nonterminal per definition */
+  nt = 0;
+  number = 0;
+  index = 0;
+  while (index < definition_count) {
+    if (strcmp(definition[index].name, name) == 0) {
+      if (number == 0) {
+        *symbol = new_nonterminal(name, definition[index].expr);
+        nt = NT_INDEX(*symbol);
+      }
+      else if (number < MAX_DIALECTS - 1) {
+        sprintf(variant_name, "%s~%u", name, number + 1);
+        nt_variant[nt][number] =
+          NT_INDEX(new_nonterminal(variant_name, definition[index].expr));
+        nt_variant_count[nt]++;
+      }
+      else {
+        fatal(definition[index].line, "too many definitions of", name);
+      } /* end if */
+      number++;
+    } /* end if */
+    index++;
+  } /* end while */
+  
+  if (number == 0) {
+    fatal(line, "undefined symbol", name);
+  } /* end if */
+  
+  if (nt_variant_count[nt] > dialect_count) {
+    dialect_count = nt_variant_count[nt];
+  } /* end if */
+  
+  return true;
+} /* end symbol_for_name */
+
+
+/* --------------------------------------------------------------------------
+ * private function symbol_for_literal(literal, line)
+ * --------------------------------------------------------------------------
+ * Returns the token for the quoted literal, or reports an error.
+ * ----------------------------------------------------------------------- */
+
+static uint_t symbol_for_literal (const char *literal, uint_t line) {
+  m2t_token_t token;
+  
+  token = FIRST_SPECIAL_SYMBOL_TOKEN;
+  while (token <= LAST_SPECIAL_SYMBOL_TOKEN) {
+    if (strcmp(m2t_lexeme_for_special_symbol(token), literal) == 0) {
+      return token;
+    } /* end if */
+    token++;
+  } /* end while */
+  
+  fatal(line, "no token for literal", literal);
+  return TOKEN_UNKNOWN;
+} /* end symbol_for_literal */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure add_rule(lhs, sequence, length)
+ * --------------------------------------------------------------------------
+ * Adds the rule lhs := sequence to the BNF grammar.
+ * ----------------------------------------------------------------------- */
+
+static void add_rule (uint_t lhs, const uint_t *sequence, uint_t length) {
+  uint_t index;
+  
+  if ((rule_count == MAX_RULES) ||
+      (rhs_count + length > MAX_RHS_SYMBOLS)) {
+    fatal(0, "grammar too large", NULL);
+  } /* end if */
+  
+  rule_lhs[rule_count] = NT_INDEX(lhs);
+  rule_start[rule_count] = rhs_count;
+  
+  index = 0;
+  while (index < length) {
+    rhs[rhs_count] = sequence[index];
+    rhs_count++;
+    index++;
+  } /* end while */
+  
+  rule_count++;
+  rule_start[rule_count] = rhs_count;
+} /* end add_rule */
+
+
+/* --------------------------------------------------------------------------
+ * private functions for lowering EBNF to BNF
+ * --------------------------------------------------------------------------
+ * Function lower_alternatives adds one rule for lhs for each alternative
+ * of expr, each followed by symbol tail unless tail is zero.  Function
+ * lower_item passes back a single symbol for an item of a sequence.  Both
+ * return false if nothing can be matched.
+ * ----------------------------------------------------------------------- */
+
+static bool lower_alternatives (expr_t expr, uint_t lhs, uint_t tail);
+
+static bool lower_item (expr_t item, uint_t lhs, uint_t *symbol) {
+  uint_t nt, loop;
+  
+  switch (item->kind) {
+    case EXPR_NAME :
+      return symbol_for_name(item->text, item->line, symbol);
+  
+    case EXPR_QUOTED :
+      *symbol = symbol_for_literal(item->text, item->line);
+      return true;
+  
+    case EXPR_OPTION :
+      /* nt := item | empty */
+      nt = synthesised_nonterminal(lhs);
+      lower_alternatives(item->item[0], nt, 0);
+      add_rule(nt, NULL, 0);
+      *symbol = nt;
+      return true;
+  
+    case EXPR_STAR :
+      /* nt := item nt | empty */
+      nt = synthesised_nonterminal(lhs);
+      lower_alternatives(item->item[0], nt, nt);
+      add_rule(nt, NULL, 0);
+      *symbol = nt;
+      return true;
+  
+    case EXPR_PLUS :
+      /* nt := item loop ; loop := item loop | empty */
+      nt = synthesised_nonterminal(lhs);
+      loop = synthesised_nonterminal(lhs);
+      if (!lower_alternatives(item->item[0], nt, loop)) {
+        return false;
+      } /* end if */
+      lower_alternatives(item->item[0], loop, loop);
+      add_rule(loop, NULL, 0);
+      *symbol = nt;
+      return true;
+  
+    case EXPR_ALT :
+    case EXPR_SEQ :
+      /* parenthesised group */
+      if ((item->kind == EXPR_SEQ) && (item->count == 1)) {
+        return lower_item(item->item[0], lhs, symbol);
+      } /* end if */
+      nt = synthesised_nonterminal(lhs);
+      if (!lower_alternatives(item, nt, 0)) {
+        return false;
+      } /* end if */
+      *symbol = nt;
+      return true;
+  
+    default :
+      fatal(item->line, "unsupported construct in parser rule", item->text);
+  } /* end switch */
+  
+  return false;
+} /* end lower_item */
+
+
+static bool lower_sequence (expr_t seq, uint_t lhs, uint_t tail) {
+  uint_t sequence[MAX_SEQUENCE_LENGTH];
+  uint_t length, index, count;
+  expr_t *item;
+  
+  if (seq->kind == EXPR_SEQ) {
+    item = seq->item;
+    count = seq->count;
+  }
+  else /* single item */ {
+    item = &seq;
+    count = 1;
+  } /* end if */
+  
+  length = 0;
+  index = 0;
+  while (index < count) {
+    if (length + 1 >= MAX_SEQUENCE_LENGTH) {
+      fatal(seq->line, "sequence too long", NULL);
+    } /* end if */
+    if (!lower_item(item[index], lhs, &sequence[length])) {
+      return false;
+    } /* end if */
+    length++;
+    index++;
+  } /* end while */
+  
+  if (tail != 0) {
+    sequence[length] = tail;
+    length++;
+  } /* end if */
+  
+  add_rule(lhs, sequence, length);
+  return true;
+} /* end lower_sequence */
+
+
+static bool lower_alternatives (expr_t expr, uint_t lhs, uint_t tail) {
+  uint_t index;
+  bool live;
+  
+  if (expr->kind != EXPR_ALT) {
+    return lower_sequence(expr, lhs, tail);
+  } /* end if */
+  
+  live = false;
+  index = 0;
+  while (index < expr->count) {
+    if (lower_sequence(expr->item[index], lhs, tail)) {
+      live = true;
+    } /* end if */
+    index++;
+  } /* end while */
+  
+  return live;
+} /* end lower_alternatives */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure lower_grammar()
+ * --------------------------------------------------------------------------
+ * Rewrites all rules reachable from the start symbols as BNF rules.
+ * ----------------------------------------------------------------------- */
+
+static void lower_grammar (void) {
+  uint_t index, symbol;
+  
+  rule_start[0] = 0;
+  
+  index = 0;
+  while (start_symbol[index] != NULL) {
+    symbol_for_name(start_symbol[index], 0, &symbol);
+    index++;
+  } /* end while */
+  
+  /* nonterminals allocated while lowering are lowered in turn */
+  while (nt_lowered < nt_count) {
+    if (nt_expr[nt_lowered] != NULL) {
+      if (!lower_alternatives(nt_expr[nt_lowered],
+          NONTERMINAL_BASE + nt_lowered, 0)) {
+        fatal(0, "no alternative can be matched for", nt_name[nt_lowered]);
+      } /* end if */
+    } /* end if */
+    nt_lowered++;
+  } /* end while */
+} /* end lower_grammar */
+
+
+/* --------------------------------------------------------------------------
+ * private function first_of_sequence(sequence, length, is_nullable)
+ * --------------------------------------------------------------------------
+ * Returns the FIRST set of sequence and passes back whether it is nullable.
+ * All definitions of a nonterminal with dialect variants contribute.
+ * ----------------------------------------------------------------------- */
+
+static m2t_tokenset_t first_of_sequence
+  (const uint_t *sequence, uint_t length, bool *is_nullable) {
+  m2t_tokenset_t set;
+  uint_t index, variant, nt;
+  bool symbol_nullable;
+  
+  set = m2t_tokenset_from_list(0);
+  
+  index = 0;
+  while (index < length) {
+    if (!IS_NONTERMINAL(sequence[index])) {
+      set = m2t_tokenset_union
+        (set, m2t_tokenset_from_list(sequence[index], 0));
+      *is_nullable = false;
+      return set;
+    } /* end if */
+  
+    nt = NT_INDEX(sequence[index]);
+    symbol_nullable = false;
+    variant = 0;
+    while (variant < nt_variant_count[nt]) {
+      set = m2t_tokenset_union(set, first[nt_variant[nt][variant]]);
+      symbol_nullable =
+        symbol_nullable || nullable[nt_variant[nt][variant]];
+      variant++;
+    } /* end while */
+  
+    if (!symbol_nullable) {
+      *is_nullable = false;
+      return set;
+    } /* end if */
+    index++;
+  } /* end while */
+  
+  *is_nullable = true;
+  return set;
+} /* end first_of_sequence */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure analyse_grammar()
+ * --------------------------------------------------------------------------
+ * Computes nullable, FIRST and FOLLOW for all nonterminals.
+ * ----------------------------------------------------------------------- */
+
+static void analyse_grammar (void) {
+  uint_t rule, index, length, nt, variant, target;
+  m2t_tokenset_t set, eof;
+  bool changed, is_nullable;
+  
+  /* nullable and FIRST */
+  do {
+    changed = false;
+    rule = 0;
+    while (rule < rule_count) {
+      nt = rule_lhs[rule];
+      length = rule_start[rule + 1] - rule_start[rule];
+      set = first_of_sequence(&rhs[rule_start[rule]], length, &is_nullable);
+      if (!m2t_tokenset_subset(first[nt], set)) {
+        first[nt] = m2t_tokenset_union(first[nt], set);
+        changed = true;
+      } /* end if */
+      if ((is_nullable) && (!nullable[nt])) {
+        nullable[nt] = true;
+        changed = true;
+      } /* end if */
+      rule++;
+    } /* end while */
+  } while (changed);
+  
+  /* end of file follows every start symbol */
+  eof = m2t_tokenset_from_list(TOKEN_END_OF_FILE, 0);
+  index = 0;
+  while (start_symbol[index] != NULL) {
+    symbol_for_name(start_symbol[index], 0, &nt);
+    nt = NT_INDEX(nt);
+    variant = 0;
+    while (variant < nt_variant_count[nt]) {
+      target = nt_variant[nt][variant];
+      follow[target] = m2t_tokenset_union(follow[target], eof);
+      variant++;
+    } /* end while */
+    index++;
+  } /* end while */
+  
+  /* FOLLOW */
+  do {
+    changed = false;
+    rule = 0;
+    while (rule < rule_count) {
+      length = rule_start[rule + 1] - rule_start[rule];
+      index = 0;
+      while (index < length) {
+        if (IS_NONTERMINAL(rhs[rule_start[rule] + index])) {
+          set = first_of_sequence(&rhs[rule_start[rule] + index + 1],
+            length - index - 1, &is_nullable);
+          if (is_nullable) {
+            set = m2t_tokenset_union(set, follow[rule_lhs[rule]]);
+          } /* end if */
+          nt = NT_INDEX(rhs[rule_start[rule] + index]);
+          variant = 0;
+          while (variant < nt_variant_count[nt]) {
+            target = nt_variant[nt][variant];
+            if (!m2t_tokenset_subset(follow[target], set)) {
+              follow[target] = m2t_tokenset_union(follow[target], set);
+              changed = true;
+            } /* end if */
+            variant++;
+          } /* end while */
+        } /* end if */
+        index++;
+      } /* end while */
+      rule++;
+    } /* end while */
+  } while (changed);
+} /* end analyse_grammar */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure print_rule(file, rule, indent)
+ * --------------------------------------------------------------------------
+ * Prints rule in BNF notation to file, wrapped at 79 columns.  Continuation
+ * lines are indented by indent columns.
+ * ----------------------------------------------------------------------- */
+
+static void print_rule (FILE *file, uint_t rule, uint_t indent) {
+  uint_t index, symbol, column;
+  char item[MAX_LEXEME_LENGTH + 4];
+  
+  fprintf(file, "%s :=", nt_name[rule_lhs[rule]]);
+  column = indent + strlen(nt_name[rule_lhs[rule]]) + 3;
+  
+  if (rule_start[rule] == rule_start[rule + 1]) {
+    fprintf(file, " (empty)");
+  } /* end if */
+  
+  index = rule_start[rule];
+  while (index < rule_start[rule + 1]) {
+    symbol = rhs[index];
+    if (IS_NONTERMINAL(symbol)) {
+      sprintf(item, "%s", nt_name[NT_INDEX(symbol)]);
+    }
+    else if (m2t_is_special_symbol_token(symbol)) {
+      sprintf(item, "'%s'", m2t_lexeme_for_special_symbol(symbol));
+    }
+    else if (m2t_is_resword_token(symbol)) {
+      sprintf(item, "%s", m2t_lexeme_for_resword(symbol));
+    }
+    else {
+      sprintf(item, "%s", m2t_name_for_token(symbol));
+    } /* end if */
+  
+    /* leave room for a closing comment delimiter */
+    if (column + strlen(item) + 4 > 79) {
+      fprintf(file, "\n%*s", indent, "");
+      column = indent - 1;
+    } /* end if */
+    fprintf(file, " %s", item);
+    column = column + strlen(item) + 1;
+    index++;
+  } /* end while */
+} /* end print_rule */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure set_entry(nt, token, rule, from_follow)
+ * --------------------------------------------------------------------------
+ * Enters rule into the predict table, resolving conflicts.
+ * ----------------------------------------------------------------------- */
+
+static void set_entry
+  (uint_t nt, m2t_token_t token, uint_t rule, bool from_follow) {
+  uint_t other;
+  
+  if (predict[nt][token] == 0) {
+    predict[nt][token] = rule + 1;
+    by_follow[nt][token] = from_follow;
+    return;
+  } /* end if */
+  
+  other = predict[nt][token] - 1;
+  if (other == rule) {
+    return;
+  } /* end if */
+  
+  if ((by_follow[nt][token]) && (!from_follow)) {
+    /* prefer the non-empty alternative */
+    predict[nt][token] = rule + 1;
+    by_follow[nt][token] = false;
+  }
+  else if ((!by_follow[nt][token]) && (from_follow)) {
+    /* keep the non-empty alternative */
+  }
+  else {
+    fprintf(stderr, "m2t-gen-ll1: conflict on %s between\n  ",
+      m2t_name_for_token(token));
+    print_rule(stderr, other, 4);
+    fprintf(stderr, "\n  ");
+    print_rule(stderr, rule, 4);
+    fprintf(stderr, "\n");
+    conflict_count++;
+  } /* end if */
+} /* end set_entry */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure build_predict_table()
+ * --------------------------------------------------------------------------
+ * Builds the predict table from the FIRST and FOLLOW sets.
+ * ----------------------------------------------------------------------- */
+
+static void build_predict_table (void) {
+  uint_t rule, nt, length;
+  m2t_tokenset_t set;
+  m2t_token_t token;
+  bool is_nullable;
+  
+  rule = 0;
+  while (rule < rule_count) {
+    nt = rule_lhs[rule];
+    length = rule_start[rule + 1] - rule_start[rule];
+    set = first_of_sequence(&rhs[rule_start[rule]], length, &is_nullable);
+  
+    token = 0;
+    while (token < TOKEN_END_MARK) {
+      if (m2t_tokenset_element(set, token)) {
+        set_entry(nt, token, rule, false);
+      } /* end if */
+      if ((is_nullable) && (m2t_tokenset_element(follow[nt], token))) {
+        set_entry(nt, token, rule, true);
+      } /* end if */
+      token++;
+    } /* end while */
+    rule++;
+  } /* end while */
+} /* end build_predict_table */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure emit_number_list(numbers, count, indent)
+ * --------------------------------------------------------------------------
+ * Emits a comma separated list of numbers, wrapped at 79 columns.
+ * ----------------------------------------------------------------------- */
+
+static void emit_number_list
+  (const uint_t *numbers, uint_t count, uint_t indent) {
+  uint_t index, column;
+  char item[16];
+  
+  printf("%*s", indent, "");
+  column = indent;
+  
+  index = 0;
+  while (index < count) {
+    sprintf(item, "%u%s", numbers[index], (index + 1 < count) ? "," : "");
+    if (column + strlen(item) + 1 > 79) {
+      printf("\n%*s", indent, "");
+      column = indent;
+    }
+    else if (index > 0) {
+      printf(" ");
+      column++;
+    } /* end if */
+    printf("%s", item);
+    column = column + strlen(item);
+    index++;
+  } /* end while */
+} /* end emit_number_list */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure emit_macro_name(prefix, name)
+ * --------------------------------------------------------------------------
+ * Emits prefix followed by name converted from camel case to upper case.
+ * ----------------------------------------------------------------------- */
+
+static void emit_macro_name (const char *prefix, const char *name) {
+  printf("%s", prefix);
+  while (*name != ASCII_NUL) {
+    if (isupper((unsigned char) *name)) {
+      printf("_");
+    } /* end if */
+    printf("%c", toupper((unsigned char) *name));
+    name++;
+  } /* end while */
+} /* end emit_macro_name */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure emit_tables()
+ * --------------------------------------------------------------------------
+ * Emits a header file with all parser tables to stdout.
+ * ----------------------------------------------------------------------- */
+
+static void emit_tables (void) {
+  uint_t nt, rule, index, dialect, symbol;
+  uint_t row[MAX_NONTERMINALS];
+  m2t_tokenset_t set;
+  
+  printf("/* M2T -- Sorce to Source Modula-2 Translator\n *\n");
+  printf(" * @file\n *\n * m2t-ll1-tables.h\n *\n");
+  printf(" * Generated by m2t-gen-ll1 from m2-grammar.gll, do not edit.\n");
+  printf(" * Change the grammar and regenerate instead.\n */\n\n");
+  printf("#ifndef M2T_LL1_TABLES_H\n#define M2T_LL1_TABLES_H\n\n");
+  
+  printf("#define M2T_LL1_NONTERMINAL_BASE %u\n\n", NONTERMINAL_BASE);
+  printf("#define M2T_LL1_NONTERMINAL_COUNT %u\n\n", nt_count);
+  printf("#define M2T_LL1_RULE_COUNT %u\n\n", rule_count);
+  printf("#define M2T_LL1_DIALECT_COUNT %u\n\n", dialect_count);
+  
+  index = 0;
+  while (start_symbol[index] != NULL) {
+    symbol_for_name(start_symbol[index], 0, &symbol);
+    emit_macro_name("#define M2T_LL1_START_", start_symbol[index]);
+    printf(" %u\n\n", symbol);
+    index++;
+  } /* end while */
+  printf("\n");
+  
+  /* nonterminal names */
+  printf("static const char *const m2t_ll1_nonterminal_name[] = {\n");
+  nt = 0;
+  while (nt < nt_count) {
+    printf("  \"%s\"%s\n", nt_name[nt], (nt + 1 < nt_count) ? "," : "");
+    nt++;
+  } /* end while */
+  printf("}; /* end m2t_ll1_nonterminal_name */\n\n");
+  
+  /* rules, right hand sides are stored in reverse for pushing */
+  printf("static const uint16_t m2t_ll1_rhs_start[] = {\n");
+  emit_number_list(rule_start, rule_count + 1, 2);
+  printf("\n}; /* end m2t_ll1_rhs_start */\n\n");
+  
+  printf("static const uint16_t m2t_ll1_rhs[] = {\n");
+  rule = 0;
+  while (rule < rule_count) {
+    printf("  /* ");
+    print_rule(stdout, rule, 5);
+    printf(" */\n");
+    if (rule_start[rule + 1] > rule_start[rule]) {
+      index = 0;
+      while (rule_start[rule + 1] - index > rule_start[rule]) {
+        row[index] = rhs[rule_start[rule + 1] - index - 1];
+        index++;
+      } /* end while */
+      emit_number_list(row, index, 2);
+      printf(",\n");
+    } /* end if */
+    rule++;
+  } /* end while */
+  printf("  0 /* sentinel */\n}; /* end m2t_ll1_rhs */\n\n");
+  
+  /* dialect variants */
+  printf("static const uint16_t m2t_ll1_dialect_nonterminal\n"
+    "  [M2T_LL1_DIALECT_COUNT][M2T_LL1_NONTERMINAL_COUNT] = {\n");
+  dialect = 0;
+  while (dialect < dialect_count) {
+    nt = 0;
+    while (nt < nt_count) {
+      if (nt_origin[nt] == nt) {
+        index = (dialect < nt_variant_count[nt]) ?
+          dialect : nt_variant_count[nt] - 1;
+        row[nt] = nt_variant[nt][index];
+      }
+      else {
+        row[nt] = nt;
+      } /* end if */
+      nt++;
+    } /* end while */
+    printf("  /* dialect %u */\n  {\n", dialect);
+    emit_number_list(row, nt_count, 4);
+    printf("\n  }%s\n", (dialect + 1 < dialect_count) ? "," : "");
+    dialect++;
+  } /* end while */
+  printf("}; /* end m2t_ll1_dialect_nonterminal */\n\n");
+  
+  /* predict table */
+  printf("static const uint16_t m2t_ll1_predict\n"
+    "  [M2T_LL1_NONTERMINAL_COUNT][TOKEN_END_MARK] = {\n");
+  nt = 0;
+  while (nt < nt_count) {
+    printf("  /* %s */\n  {\n", nt_name[nt]);
+    emit_number_list(predict[nt], TOKEN_END_MARK, 4);
+    printf("\n  }%s\n", (nt + 1 < nt_count) ? "," : "");
+    nt++;
+  } /* end while */
+  printf("}; /* end m2t_ll1_predict */\n\n");
+  
+  /* expected sets for error messages */
+  printf("static const m2t_tokenset_t m2t_ll1_expected_set[] = {\n");
+  nt = 0;
+  while (nt < nt_count) {
+    set = first[nt];
+    if (nullable[nt]) {
+      set = m2t_tokenset_union(set, follow[nt]);
+    } /* end if */
+    printf("  /* %s */\n  ", nt_name[nt]);
+    m2t_tokenset_print_literal(set);
+    printf("%s\n", (nt + 1 < nt_count) ? "," : "");
+    nt++;
+  } /* end while */
+  printf("}; /* end m2t_ll1_expected_set */\n\n");
+  
+  /* resync sets for error recovery */
+  printf("static const m2t_tokenset_t m2t_ll1_resync_set[] = {\n");
+  nt = 0;
+  while (nt < nt_count) {
+    set = m2t_tokenset_union
+      (follow[nt], m2t_tokenset_from_list(TOKEN_END_OF_FILE, 0));
+    printf("  /* %s */\n  ", nt_name[nt]);
+    m2t_tokenset_print_literal(set);
+    printf("%s\n", (nt + 1 < nt_count) ? "," : "");
+    nt++;
+  } /* end while */
+  printf("}; /* end m2t_ll1_resync_set */\n\n");
+  
+  printf("#endif /* M2T_LL1_TABLES_H */\n\n/* END OF FILE */\n");
+} /* end emit_tables */
+
+/* END OF FILE */
@@ -0,0 +1,546 @@
+/* M2T -- Sorce to Source Modula-2 Translator
+ *
+ * Copyright (c) 2016-2023 Benjamin Kowarsch
+ *
+ * Author & Maintainer: Benjamin Kowarsch <org.m2sf>
+ *
+ * @synopsis
+ *
+ * M2T is a multi-dialect Modula-2 source-to-source translator. It translates
+ * source files  written in the  classic dialects  to semantically equivalent
+ * source files in  Modula-2 Revision 2010 (M2R10).  It supports  the classic
+ * Modula-2 dialects  described in  the 2nd, 3rd and 4th editions  of Niklaus
+ * Wirth's book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * For more details please visit: https://github.com/trijezdci/m2t/wiki
+ *
+ * @repository
+ *
+ * https://github.com/trijezdci/m2t
+ *
+ * @file
+ *
+ * m2t-gen-tokensets.c
+ *
+ * Build-time generator for M2T FIRST, FOLLOW and resync set tables.
+ *
+ * @license
+ *
+ * M2T is free software:  You can redistribute and modify it  under the terms
+ * of the  GNU Lesser General Public License (LGPL) either version 2.1  or at
+ * your choice version 3, both as published by the Free Software Foundation.
+ *
+ * M2T is distributed  in the hope  that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even  the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received  a copy of the  GNU Lesser General Public License
+ * along with M2T.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+
+/* --------------------------------------------------------------------------
+ * Usage
+ * --------------------------------------------------------------------------
+ * This build-time tool defines the FIRST, FOLLOW and resync sets of the
+ * parser as lists of tokens and emits each group of sets as a table of
+ * static const tokenset literals.  The generated headers are included by
+ * m2t-production.c and m2t-resync-sets.c.  Sets are thereby placed in
+ * read-only data, shared by all parser instances and threads, and parser
+ * startup does not need to construct any of them.
+ *
+ * Building the tool, from within directory src:
+ *
+ *   cc -I. -o m2t-gen-tokensets gen/m2t-gen-tokensets.c \
+ *     imp/m2t-tokenset.c imp/m2t-token.c
+ *
+ * Regenerating the tables after a change to any definition below:
+ *
+ *   ./m2t-gen-tokensets first > m2t-first-set-table.h
+ *   ./m2t-gen-tokensets follow > m2t-follow-set-table.h
+ *   ./m2t-gen-tokensets resync > m2t-resync-set-table.h
+ * ----------------------------------------------------------------------- */
+
+#include "m2t-common.h"
+#include "m2t-token.h"
+#include "m2t-tokenset.h"
+#include "m2t-production.h"
+#include "m2t-resync-sets.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* --------------------------------------------------------------------------
+ * function macro DEF(set, token_list)
+ * --------------------------------------------------------------------------
+ * Defines the tokenset for table index set as the tokens in token_list.
+ * ----------------------------------------------------------------------- */
+
+#define DEF(_set, ...) \
+  case _set : *name = #_set; \
+    return m2t_tokenset_from_list(__VA_ARGS__, 0)
+
+
+/* --------------------------------------------------------------------------
+ * function macro ALT(p)
+ * --------------------------------------------------------------------------
+ * Returns the table index of the alternative set of production p.
+ * ----------------------------------------------------------------------- */
+
+#define ALT(_p) ((_p) + M2T_ALTERNATE_SET_OFFSET)
+
+
+/* --------------------------------------------------------------------------
+ * private type set_func_t
+ * --------------------------------------------------------------------------
+ * Type of functions returning the set definition for a table index.
+ * ----------------------------------------------------------------------- */
+
+typedef m2t_tokenset_t (*set_func_t) (uint_t index, const char **name);
+
+
+/* --------------------------------------------------------------------------
+ * private type table_desc_t
+ * --------------------------------------------------------------------------
+ * Record type describing a table to be generated.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* mode */ const char *mode;
+  /* filename */ const char *filename;
+  /* guard */ const char *guard;
+  /* table */ const char *table;
+  /* count */ uint_t count;
+  /* set_for_index */ set_func_t set_for_index;
+} table_desc_t;
+
+
+/* --------------------------------------------------------------------------
+ * Forward declarations
+ * ----------------------------------------------------------------------- */
+
+static m2t_tokenset_t first_set (uint_t index, const char **name);
+
+static m2t_tokenset_t follow_set (uint_t index, const char **name);
+
+static m2t_tokenset_t resync_set (uint_t index, const char **name);
+
+static int emit_table (const table_desc_t *desc);
+
+
+/* --------------------------------------------------------------------------
+ * private variable table
+ * --------------------------------------------------------------------------
+ * Table of descriptors of all generated tables.
+ * ----------------------------------------------------------------------- */
+
+static const table_desc_t table[] = {
+  { "first", "m2t-first-set-table.h", "M2T_FIRST_SET_TABLE_H",
+    "m2t_first_set", M2T_PRODUCTION_SET_COUNT, first_set },
+  { "follow", "m2t-follow-set-table.h", "M2T_FOLLOW_SET_TABLE_H",
+    "m2t_follow_set", M2T_PRODUCTION_SET_COUNT, follow_set },
+  { "resync", "m2t-resync-set-table.h", "M2T_RESYNC_SET_TABLE_H",
+    "m2t_resync_set", M2T_RESYNC_SET_COUNT, resync_set }
+}; /* end table */
+
+#define TABLE_COUNT (sizeof(table) / sizeof(table_desc_t))
+
+
+/* --------------------------------------------------------------------------
+ * function main(argc, argv)
+ * --------------------------------------------------------------------------
+ * Emits the table selected by the command line argument to stdout.
+ * ----------------------------------------------------------------------- */
+
+int main (int argc, char *argv[]) {
+  uint_t index;
+  
+  if (argc == 2) {
+    index = 0;
+    while (index < TABLE_COUNT) {
+      if (strcmp(argv[1], table[index].mode) == 0) {
+        return emit_table(&table[index]);
+      } /* end if */
+      index++;
+    } /* end while */
+  } /* end if */
+  
+  fprintf(stderr, "usage: m2t-gen-tokensets (first | follow | resync)\n");
+  return EXIT_FAILURE;
+} /* end main */
+
+
+/* --------------------------------------------------------------------------
+ * Private Functions
+ * ----------------------------------------------------------------------- */
+
+/* --------------------------------------------------------------------------
+ * private function emit_table(desc)
+ * --------------------------------------------------------------------------
+ * Emits a header file with the table described by desc to stdout.  Fails
+ * without emitting anything if a set of the table is not defined.
+ * ----------------------------------------------------------------------- */
+
+static int emit_table (const table_desc_t *desc) {
+  uint_t index;
+  const char *name;
+  m2t_tokenset_t set;
+  
+  /* check that every index has a definition */
+  index = 0;
+  while (index < desc->count) {
+    name = NULL;
+    desc->set_for_index(index, &name);
+    if (name == NULL) {
+      fprintf(stderr, "m2t-gen-tokensets: %s: no set for index %u\n",
+        desc->mode, index);
+      return EXIT_FAILURE;
+    } /* end if */
+    index++;
+  } /* end while */
+  
+  printf("/* M2T -- Sorce to Source Modula-2 Translator\n *\n");
+  printf(" * @file\n *\n * %s\n *\n", desc->filename);
+  printf(" * Generated by m2t-gen-tokensets %s, do not edit.\n", desc->mode);
+  printf(" * Change gen/m2t-gen-tokensets.c and regenerate instead.\n */\n\n");
+  
+  printf("#ifndef %s\n#define %s\n\n", desc->guard, desc->guard);
+  printf("static const m2t_tokenset_t %s[] = {\n", desc->table);
+  
+  index = 0;
+  while (index < desc->count) {
+    set = desc->set_for_index(index, &name);
+    printf("  /* %s */\n  ", name);
+    m2t_tokenset_print_literal(set);
+    printf("%s /* %u */\n", (index + 1 < desc->count) ? "," : "",
+      m2t_tokenset_element_count(set));
+    index++;
+  } /* end while */
+  
+  printf("}; /* end %s */\n\n", desc->table);
+  printf("#endif /* %s */\n\n/* END OF FILE */\n", desc->guard);
+  
+  return EXIT_SUCCESS;
+} /* end emit_table */
+
+
+/* --------------------------------------------------------------------------
+ * private function first_set(index, name)
+ * --------------------------------------------------------------------------
+ * Returns the FIRST set for table index and passes its name back in name.
+ * ----------------------------------------------------------------------- */
+
+static m2t_tokenset_t first_set (uint_t index, const char **name) {
+  switch (index) {
+  DEF(DEFINITION_MODULE, TOKEN_DEFINITION);
+  DEF(IMPORT, TOKEN_FROM, TOKEN_IMPORT);
+  DEF(QUALIFIED_IMPORT, TOKEN_IMPORT);
+  DEF(UNQUALIFIED_IMPORT, TOKEN_FROM);
+  DEF(IDENT_LIST, TOKEN_IDENTIFIER);
+  DEF(DEFINITION, TOKEN_CONST, TOKEN_PROCEDURE, TOKEN_TYPE, TOKEN_VAR);
+  DEF(CONST_DEFINITION, TOKEN_IDENTIFIER);
+  DEF(TYPE_DEFINITION, TOKEN_IDENTIFIER);
+  DEF(TYPE, TOKEN_ARRAY, TOKEN_POINTER, TOKEN_PROCEDURE, TOKEN_RECORD,
+    TOKEN_SET, TOKEN_IDENTIFIER, TOKEN_LEFT_PAREN, TOKEN_LEFT_BRACKET);
+  DEF(DERIVED_OR_SUBRANGE_TYPE, TOKEN_IDENTIFIER, TOKEN_LEFT_BRACKET);
+  DEF(QUALIDENT, TOKEN_IDENTIFIER);
+  DEF(RANGE, TOKEN_LEFT_BRACKET);
+  DEF(ENUM_TYPE, TOKEN_LEFT_PAREN);
+  DEF(SET_TYPE, TOKEN_SET);
+  DEF(COUNTABLE_TYPE, TOKEN_IDENTIFIER, TOKEN_LEFT_PAREN, TOKEN_LEFT_BRACKET);
+  DEF(ARRAY_TYPE, TOKEN_ARRAY);
+  DEF(EXTENSIBLE_RECORD_TYPE, TOKEN_RECORD);
+  DEF(FIELD_LIST_SEQUENCE, TOKEN_IDENTIFIER);
+  DEF(VARIANT_RECORD_TYPE, TOKEN_RECORD);
+  DEF(VARIANT_FIELD_LIST_SEQ, TOKEN_CASE, TOKEN_IDENTIFIER);
+  DEF(VARIANT_FIELD_LIST, TOKEN_CASE, TOKEN_IDENTIFIER);
+  DEF(VARIANT_FIELDS, TOKEN_CASE);
+  DEF(VARIANT, TOKEN_NOT, TOKEN_IDENTIFIER, TOKEN_STRING, TOKEN_INTEGER,
+    TOKEN_REAL, TOKEN_CHAR, TOKEN_PLUS, TOKEN_MINUS, TOKEN_LEFT_PAREN,
+    TOKEN_LEFT_BRACE);
+  DEF(CASE_LABEL_LIST, TOKEN_NOT, TOKEN_IDENTIFIER, TOKEN_STRING,
+    TOKEN_INTEGER, TOKEN_REAL, TOKEN_CHAR, TOKEN_PLUS, TOKEN_MINUS,
+    TOKEN_LEFT_PAREN, TOKEN_LEFT_BRACE);
+  DEF(CASE_LABELS, TOKEN_NOT, TOKEN_IDENTIFIER, TOKEN_STRING, TOKEN_INTEGER,
+    TOKEN_REAL, TOKEN_CHAR, TOKEN_PLUS, TOKEN_MINUS, TOKEN_LEFT_PAREN,
+    TOKEN_LEFT_BRACE);
+  DEF(POINTER_TYPE, TOKEN_POINTER);
+  DEF(PROCEDURE_TYPE, TOKEN_PROCEDURE);
+  DEF(SIMPLE_FORMAL_TYPE, TOKEN_ARRAY, TOKEN_IDENTIFIER);
+  DEF(PROCEDURE_HEADER, TOKEN_PROCEDURE);
+  DEF(PROCEDURE_SIGNATURE, TOKEN_IDENTIFIER);
+  DEF(SIMPLE_FORMAL_PARAMS, TOKEN_IDENTIFIER);
+  DEF(IMPLEMENTATION_MODULE, TOKEN_IMPLEMENTATION);
+  DEF(PROGRAM_MODULE, TOKEN_MODULE);
+  DEF(MODULE_PRIORITY, TOKEN_LEFT_BRACKET);
+  DEF(BLOCK, TOKEN_BEGIN, TOKEN_CONST, TOKEN_END, TOKEN_MODULE,
+    TOKEN_PROCEDURE, TOKEN_TYPE, TOKEN_VAR);
+  DEF(DECLARATION, TOKEN_CONST, TOKEN_MODULE, TOKEN_PROCEDURE, TOKEN_TYPE,
+    TOKEN_VAR);
+  DEF(TYPE_DECLARATION, TOKEN_IDENTIFIER);
+  DEF(VAR_SIZE_RECORD_TYPE, TOKEN_VAR);
+  DEF(VARIABLE_DECLARATION, TOKEN_IDENTIFIER);
+  DEF(PROCEDURE_DECLARATION, TOKEN_PROCEDURE);
+  DEF(MODULE_DECLARATION, TOKEN_MODULE);
+  DEF(EXPORT, TOKEN_EXPORT);
+  DEF(STATEMENT_SEQUENCE, TOKEN_CASE, TOKEN_EXIT, TOKEN_FOR, TOKEN_IF,
+    TOKEN_LOOP, TOKEN_REPEAT, TOKEN_RETURN, TOKEN_WHILE, TOKEN_WITH,
+    TOKEN_IDENTIFIER);
+  DEF(STATEMENT, TOKEN_CASE, TOKEN_EXIT, TOKEN_FOR, TOKEN_IF, TOKEN_LOOP,
+    TOKEN_REPEAT, TOKEN_RETURN, TOKEN_WHILE, TOKEN_WITH, TOKEN_IDENTIFIER);
+  DEF(ASSIGNMENT_OR_PROC_CALL, TOKEN_IDENTIFIER);
+  DEF(ACTUAL_PARAMETERS, TOKEN_LEFT_PAREN);
+  DEF(EXPRESSION_LIST, TOKEN_NOT, TOKEN_IDENTIFIER, TOKEN_STRING,
+    TOKEN_INTEGER, TOKEN_REAL, TOKEN_CHAR, TOKEN_PLUS, TOKEN_MINUS,
+    TOKEN_LEFT_PAREN, TOKEN_LEFT_BRACE);
+  DEF(RETURN_STATEMENT, TOKEN_RETURN);
+  DEF(WITH_STATEMENT, TOKEN_WITH);
+  DEF(IF_STATEMENT, TOKEN_IF);
+  DEF(CASE_STATEMENT, TOKEN_CASE);
+  DEF(CASE, TOKEN_NOT, TOKEN_IDENTIFIER, TOKEN_STRING, TOKEN_INTEGER,
+    TOKEN_REAL, TOKEN_CHAR, TOKEN_PLUS, TOKEN_MINUS, TOKEN_LEFT_PAREN,
+    TOKEN_LEFT_BRACE);
+  DEF(LOOP_STATEMENT, TOKEN_LOOP);
+  DEF(WHILE_STATEMENT, TOKEN_WHILE);
+  DEF(REPEAT_STATEMENT, TOKEN_REPEAT);
+  DEF(FOR_STATEMENT, TOKEN_FOR);
+  DEF(DESIGNATOR, TOKEN_IDENTIFIER);
+  DEF(SELECTOR, TOKEN_PERIOD, TOKEN_DEREF, TOKEN_LEFT_BRACKET);
+  DEF(EXPRESSION, TOKEN_NOT, TOKEN_IDENTIFIER, TOKEN_STRING, TOKEN_INTEGER,
+    TOKEN_REAL, TOKEN_CHAR, TOKEN_PLUS, TOKEN_MINUS, TOKEN_LEFT_PAREN,
+    TOKEN_LEFT_BRACE);
+  DEF(SIMPLE_EXPRESSION, TOKEN_NOT, TOKEN_IDENTIFIER, TOKEN_STRING,
+    TOKEN_INTEGER, TOKEN_REAL, TOKEN_CHAR, TOKEN_PLUS, TOKEN_MINUS,
+    TOKEN_LEFT_PAREN, TOKEN_LEFT_BRACE);
+  DEF(TERM, TOKEN_NOT, TOKEN_IDENTIFIER, TOKEN_STRING, TOKEN_INTEGER,
+    TOKEN_REAL, TOKEN_CHAR, TOKEN_LEFT_PAREN, TOKEN_LEFT_BRACE);
+  DEF(SIMPLE_TERM, TOKEN_NOT, TOKEN_IDENTIFIER, TOKEN_STRING, TOKEN_INTEGER,
+    TOKEN_REAL, TOKEN_CHAR, TOKEN_LEFT_PAREN, TOKEN_LEFT_BRACE);
+  DEF(FACTOR, TOKEN_IDENTIFIER, TOKEN_STRING, TOKEN_INTEGER, TOKEN_REAL,
+    TOKEN_CHAR, TOKEN_LEFT_PAREN, TOKEN_LEFT_BRACE);
+  DEF(DESIGNATOR_OR_FUNC_CALL, TOKEN_IDENTIFIER);
+  DEF(SET_VALUE, TOKEN_LEFT_BRACE);
+  DEF(ELEMENT, TOKEN_NOT, TOKEN_IDENTIFIER, TOKEN_STRING, TOKEN_INTEGER,
+    TOKEN_REAL, TOKEN_CHAR, TOKEN_PLUS, TOKEN_MINUS, TOKEN_LEFT_PAREN,
+    TOKEN_LEFT_BRACE);
+  DEF(FORMAL_TYPE, TOKEN_ARRAY, TOKEN_VAR, TOKEN_IDENTIFIER);
+  DEF(ATTRIBUTED_FORMAL_TYPE, TOKEN_VAR);
+  DEF(FORMAL_PARAM_LIST, TOKEN_VAR, TOKEN_IDENTIFIER);
+  DEF(FORMAL_PARAMS, TOKEN_VAR, TOKEN_IDENTIFIER);
+  DEF(ATTRIB_FORMAL_PARAMS, TOKEN_VAR);
+  DEF(TYPE_DECLARATION_TAIL, TOKEN_ARRAY, TOKEN_POINTER, TOKEN_PROCEDURE,
+    TOKEN_RECORD, TOKEN_SET, TOKEN_VAR, TOKEN_IDENTIFIER, TOKEN_LEFT_PAREN,
+    TOKEN_LEFT_BRACKET);
+  DEF(ALT(TYPE_DECLARATION_TAIL), TOKEN_ARRAY, TOKEN_POINTER, TOKEN_PROCEDURE,
+    TOKEN_RECORD, TOKEN_SET, TOKEN_IDENTIFIER, TOKEN_LEFT_PAREN,
+    TOKEN_LEFT_BRACKET);
+  } /* end switch */
+  
+  return m2t_tokenset_from_list(0);
+} /* end first_set */
+
+
+/* --------------------------------------------------------------------------
+ * private function follow_set(index, name)
+ * --------------------------------------------------------------------------
+ * Returns the FOLLOW set for table index and passes its name back in name.
+ * ----------------------------------------------------------------------- */
+
+static m2t_tokenset_t follow_set (uint_t index, const char **name) {
+  switch (index) {
+  DEF(DEFINITION_MODULE, TOKEN_END_OF_FILE);
+  DEF(IMPORT, TOKEN_BEGIN, TOKEN_CONST, TOKEN_DEFINITION, TOKEN_END,
+    TOKEN_EXPORT, TOKEN_MODULE, TOKEN_PROCEDURE, TOKEN_TYPE, TOKEN_VAR);
+  DEF(QUALIFIED_IMPORT, TOKEN_SEMICOLON);
+  DEF(UNQUALIFIED_IMPORT, TOKEN_SEMICOLON);
+  DEF(IDENT_LIST, TOKEN_COLON, TOKEN_SEMICOLON, TOKEN_RIGHT_PAREN);
+  DEF(DEFINITION, TOKEN_END);
+  DEF(CONST_DEFINITION, TOKEN_SEMICOLON);
+  DEF(TYPE_DEFINITION, TOKEN_SEMICOLON);
+  DEF(TYPE, TOKEN_SEMICOLON);
+  DEF(DERIVED_OR_SUBRANGE_TYPE, TOKEN_SEMICOLON);
+  DEF(QUALIDENT, TOKEN_AND, TOKEN_BY, TOKEN_DIV, TOKEN_DO, TOKEN_ELSE,
+    TOKEN_ELSIF, TOKEN_END, TOKEN_IN, TOKEN_MOD, TOKEN_OF, TOKEN_OR,
+    TOKEN_THEN, TOKEN_TO, TOKEN_UNTIL, TOKEN_PLUS, TOKEN_MINUS, TOKEN_EQUAL,
+    TOKEN_NOTEQUAL, TOKEN_LESS, TOKEN_LESS_EQUAL, TOKEN_GREATER,
+    TOKEN_GREATER_EQUAL, TOKEN_ASTERISK, TOKEN_SOLIDUS, TOKEN_ASSIGN,
+    TOKEN_COMMA, TOKEN_SEMICOLON, TOKEN_RANGE, TOKEN_BAR, TOKEN_LEFT_PAREN,
+    TOKEN_RIGHT_PAREN, TOKEN_LEFT_BRACKET, TOKEN_LEFT_BRACE,
+    TOKEN_RIGHT_BRACE);
+  DEF(RANGE, TOKEN_OF, TOKEN_COMMA, TOKEN_SEMICOLON);
+  DEF(ENUM_TYPE, TOKEN_OF, TOKEN_COMMA, TOKEN_SEMICOLON);
+  DEF(SET_TYPE, TOKEN_SEMICOLON);
+  DEF(COUNTABLE_TYPE, TOKEN_OF, TOKEN_COMMA, TOKEN_SEMICOLON);
+  DEF(ARRAY_TYPE, TOKEN_SEMICOLON);
+  DEF(EXTENSIBLE_RECORD_TYPE, TOKEN_SEMICOLON);
+  DEF(FIELD_LIST_SEQUENCE, TOKEN_END, TOKEN_VAR);
+  DEF(VARIANT_RECORD_TYPE, TOKEN_SEMICOLON);
+  DEF(VARIANT_FIELD_LIST_SEQ, TOKEN_ELSE, TOKEN_END, TOKEN_BAR);
+  DEF(VARIANT_FIELD_LIST, TOKEN_ELSE, TOKEN_END, TOKEN_SEMICOLON, TOKEN_BAR);
+  DEF(VARIANT_FIELDS, TOKEN_ELSE, TOKEN_END, TOKEN_SEMICOLON, TOKEN_BAR);
+  DEF(VARIANT, TOKEN_ELSE, TOKEN_END, TOKEN_BAR);
+  DEF(CASE_LABEL_LIST, TOKEN_COLON);
+  DEF(CASE_LABELS, TOKEN_COMMA, TOKEN_COLON);
+  DEF(POINTER_TYPE, TOKEN_SEMICOLON);
+  DEF(PROCEDURE_TYPE, TOKEN_SEMICOLON);
+  DEF(SIMPLE_FORMAL_TYPE, TOKEN_COMMA, TOKEN_RIGHT_PAREN);
+  DEF(PROCEDURE_HEADER, TOKEN_SEMICOLON);
+  DEF(PROCEDURE_SIGNATURE, TOKEN_SEMICOLON);
+  DEF(SIMPLE_FORMAL_PARAMS, TOKEN_SEMICOLON, TOKEN_RIGHT_PAREN);
+  DEF(IMPLEMENTATION_MODULE, TOKEN_END_OF_FILE);
+  DEF(PROGRAM_MODULE, TOKEN_END_OF_FILE);
+  DEF(MODULE_PRIORITY, TOKEN_SEMICOLON);
+  DEF(BLOCK, TOKEN_IDENTIFIER);
+  DEF(DECLARATION, TOKEN_BEGIN, TOKEN_END);
+  DEF(TYPE_DECLARATION, TOKEN_SEMICOLON);
+  DEF(VAR_SIZE_RECORD_TYPE, TOKEN_SEMICOLON);
+  DEF(VARIABLE_DECLARATION, TOKEN_SEMICOLON);
+  DEF(PROCEDURE_DECLARATION, TOKEN_SEMICOLON);
+  DEF(MODULE_DECLARATION, TOKEN_SEMICOLON);
+  DEF(EXPORT, TOKEN_BEGIN, TOKEN_CONST, TOKEN_END, TOKEN_MODULE,
+    TOKEN_PROCEDURE, TOKEN_TYPE, TOKEN_VAR);
+  DEF(STATEMENT_SEQUENCE, TOKEN_ELSE, TOKEN_ELSIF, TOKEN_END, TOKEN_UNTIL,
+    TOKEN_BAR);
+  DEF(STATEMENT, TOKEN_ELSE, TOKEN_ELSIF, TOKEN_END, TOKEN_UNTIL,
+    TOKEN_SEMICOLON, TOKEN_BAR);
+  DEF(ASSIGNMENT_OR_PROC_CALL, TOKEN_ELSE, TOKEN_ELSIF, TOKEN_END, TOKEN_UNTIL,
+    TOKEN_SEMICOLON, TOKEN_BAR);
+  DEF(ACTUAL_PARAMETERS, TOKEN_ELSE, TOKEN_ELSIF, TOKEN_END, TOKEN_UNTIL,
+    TOKEN_SEMICOLON, TOKEN_BAR);
+  DEF(EXPRESSION_LIST, TOKEN_RIGHT_PAREN);
+  DEF(RETURN_STATEMENT, TOKEN_ELSE, TOKEN_ELSIF, TOKEN_END, TOKEN_UNTIL,
+    TOKEN_SEMICOLON, TOKEN_BAR);
+  DEF(WITH_STATEMENT, TOKEN_ELSE, TOKEN_ELSIF, TOKEN_END, TOKEN_UNTIL,
+    TOKEN_SEMICOLON, TOKEN_BAR);
+  DEF(IF_STATEMENT, TOKEN_ELSE, TOKEN_ELSIF, TOKEN_END, TOKEN_UNTIL,
+    TOKEN_SEMICOLON, TOKEN_BAR);
+  DEF(CASE_STATEMENT, TOKEN_ELSE, TOKEN_ELSIF, TOKEN_END, TOKEN_UNTIL,
+    TOKEN_SEMICOLON, TOKEN_BAR);
+  DEF(CASE, TOKEN_ELSE, TOKEN_END, TOKEN_BAR);
+  DEF(LOOP_STATEMENT, TOKEN_ELSE, TOKEN_ELSIF, TOKEN_END, TOKEN_UNTIL,
+    TOKEN_SEMICOLON, TOKEN_BAR);
+  DEF(WHILE_STATEMENT, TOKEN_ELSE, TOKEN_ELSIF, TOKEN_END, TOKEN_UNTIL,
+    TOKEN_SEMICOLON, TOKEN_BAR);
+  DEF(REPEAT_STATEMENT, TOKEN_ELSE, TOKEN_ELSIF, TOKEN_END, TOKEN_UNTIL,
+    TOKEN_SEMICOLON, TOKEN_BAR);
+  DEF(FOR_STATEMENT, TOKEN_ELSE, TOKEN_ELSIF, TOKEN_END, TOKEN_UNTIL,
+    TOKEN_SEMICOLON, TOKEN_BAR);
+  DEF(DESIGNATOR, TOKEN_AND, TOKEN_BY, TOKEN_DIV, TOKEN_DO, TOKEN_ELSE,
+    TOKEN_ELSIF, TOKEN_END, TOKEN_IN, TOKEN_MOD, TOKEN_OF, TOKEN_OR,
+    TOKEN_THEN, TOKEN_TO, TOKEN_UNTIL, TOKEN_PLUS, TOKEN_MINUS, TOKEN_EQUAL,
+    TOKEN_NOTEQUAL, TOKEN_LESS, TOKEN_LESS_EQUAL, TOKEN_GREATER,
+    TOKEN_GREATER_EQUAL, TOKEN_ASTERISK, TOKEN_SOLIDUS, TOKEN_ASSIGN,
+    TOKEN_COMMA, TOKEN_SEMICOLON, TOKEN_RANGE, TOKEN_BAR, TOKEN_LEFT_PAREN,
+    TOKEN_RIGHT_PAREN, TOKEN_LEFT_BRACE, TOKEN_RIGHT_BRACE);
+  DEF(SELECTOR, TOKEN_AND, TOKEN_BY, TOKEN_DIV, TOKEN_DO, TOKEN_ELSE,
+    TOKEN_ELSIF, TOKEN_END, TOKEN_IN, TOKEN_MOD, TOKEN_OF, TOKEN_OR,
+    TOKEN_THEN, TOKEN_TO, TOKEN_UNTIL, TOKEN_IDENTIFIER, TOKEN_PLUS,
+    TOKEN_MINUS, TOKEN_EQUAL, TOKEN_NOTEQUAL, TOKEN_LESS, TOKEN_LESS_EQUAL,
+    TOKEN_GREATER, TOKEN_GREATER_EQUAL, TOKEN_ASTERISK, TOKEN_SOLIDUS,
+    TOKEN_ASSIGN, TOKEN_COMMA, TOKEN_SEMICOLON, TOKEN_RANGE, TOKEN_BAR,
+    TOKEN_LEFT_PAREN, TOKEN_RIGHT_PAREN, TOKEN_LEFT_BRACE, TOKEN_RIGHT_BRACE);
+  DEF(EXPRESSION, TOKEN_BY, TOKEN_DO, TOKEN_ELSE, TOKEN_ELSIF, TOKEN_END,
+    TOKEN_OF, TOKEN_THEN, TOKEN_TO, TOKEN_UNTIL, TOKEN_COMMA, TOKEN_SEMICOLON,
+    TOKEN_RANGE, TOKEN_BAR, TOKEN_RIGHT_PAREN, TOKEN_RIGHT_BRACE);
+  DEF(SIMPLE_EXPRESSION, TOKEN_BY, TOKEN_DO, TOKEN_ELSE, TOKEN_ELSIF,
+    TOKEN_END, TOKEN_IN, TOKEN_OF, TOKEN_THEN, TOKEN_TO, TOKEN_UNTIL,
+    TOKEN_EQUAL, TOKEN_NOTEQUAL, TOKEN_LESS, TOKEN_LESS_EQUAL, TOKEN_GREATER,
+    TOKEN_GREATER_EQUAL, TOKEN_COMMA, TOKEN_SEMICOLON, TOKEN_RANGE, TOKEN_BAR,
+    TOKEN_RIGHT_PAREN, TOKEN_RIGHT_BRACE);
+  DEF(TERM, TOKEN_BY, TOKEN_DO, TOKEN_ELSE, TOKEN_ELSIF, TOKEN_END, TOKEN_IN,
+    TOKEN_OF, TOKEN_OR, TOKEN_THEN, TOKEN_TO, TOKEN_UNTIL, TOKEN_PLUS,
+    TOKEN_MINUS, TOKEN_EQUAL, TOKEN_NOTEQUAL, TOKEN_LESS, TOKEN_LESS_EQUAL,
+    TOKEN_GREATER, TOKEN_GREATER_EQUAL, TOKEN_COMMA, TOKEN_SEMICOLON,
+    TOKEN_RANGE, TOKEN_BAR, TOKEN_RIGHT_PAREN, TOKEN_RIGHT_BRACE);
+  DEF(SIMPLE_TERM, TOKEN_AND, TOKEN_BY, TOKEN_DIV, TOKEN_DO, TOKEN_ELSE,
+    TOKEN_ELSIF, TOKEN_END, TOKEN_IN, TOKEN_MOD, TOKEN_OF, TOKEN_OR,
+    TOKEN_THEN, TOKEN_TO, TOKEN_UNTIL, TOKEN_PLUS, TOKEN_MINUS, TOKEN_EQUAL,
+    TOKEN_NOTEQUAL, TOKEN_LESS, TOKEN_LESS_EQUAL, TOKEN_GREATER,
+    TOKEN_GREATER_EQUAL, TOKEN_ASTERISK, TOKEN_SOLIDUS, TOKEN_COMMA,
+    TOKEN_SEMICOLON, TOKEN_RANGE, TOKEN_BAR, TOKEN_RIGHT_PAREN,
+    TOKEN_RIGHT_BRACE);
+  DEF(FACTOR, TOKEN_AND, TOKEN_BY, TOKEN_DIV, TOKEN_DO, TOKEN_ELSE,
+    TOKEN_ELSIF, TOKEN_END, TOKEN_IN, TOKEN_MOD, TOKEN_OF, TOKEN_OR,
+    TOKEN_THEN, TOKEN_TO, TOKEN_UNTIL, TOKEN_PLUS, TOKEN_MINUS, TOKEN_EQUAL,
+    TOKEN_NOTEQUAL, TOKEN_LESS, TOKEN_LESS_EQUAL, TOKEN_GREATER,
+    TOKEN_GREATER_EQUAL, TOKEN_ASTERISK, TOKEN_SOLIDUS, TOKEN_COMMA,
+    TOKEN_SEMICOLON, TOKEN_RANGE, TOKEN_BAR, TOKEN_RIGHT_PAREN,
+    TOKEN_RIGHT_BRACE);
+  DEF(DESIGNATOR_OR_FUNC_CALL, TOKEN_AND, TOKEN_BY, TOKEN_DIV, TOKEN_DO,
+    TOKEN_ELSE, TOKEN_ELSIF, TOKEN_END, TOKEN_IN, TOKEN_MOD, TOKEN_OF,
+    TOKEN_OR, TOKEN_THEN, TOKEN_TO, TOKEN_UNTIL, TOKEN_PLUS, TOKEN_MINUS,
+    TOKEN_EQUAL, TOKEN_NOTEQUAL, TOKEN_LESS, TOKEN_LESS_EQUAL, TOKEN_GREATER,
+    TOKEN_GREATER_EQUAL, TOKEN_ASTERISK, TOKEN_SOLIDUS, TOKEN_COMMA,
+    TOKEN_SEMICOLON, TOKEN_RANGE, TOKEN_BAR, TOKEN_RIGHT_PAREN,
+    TOKEN_RIGHT_BRACE);
+  DEF(SET_VALUE, TOKEN_AND, TOKEN_BY, TOKEN_DIV, TOKEN_DO, TOKEN_ELSE,
+    TOKEN_ELSIF, TOKEN_END, TOKEN_IN, TOKEN_MOD, TOKEN_OF, TOKEN_OR,
+    TOKEN_THEN, TOKEN_TO, TOKEN_UNTIL, TOKEN_PLUS, TOKEN_MINUS, TOKEN_EQUAL,
+    TOKEN_NOTEQUAL, TOKEN_LESS, TOKEN_LESS_EQUAL, TOKEN_GREATER,
+    TOKEN_GREATER_EQUAL, TOKEN_ASTERISK, TOKEN_SOLIDUS, TOKEN_COMMA,
+    TOKEN_SEMICOLON, TOKEN_RANGE, TOKEN_BAR, TOKEN_RIGHT_PAREN,
+    TOKEN_RIGHT_BRACE);
+  DEF(ELEMENT, TOKEN_COMMA, TOKEN_RIGHT_BRACE);
+  DEF(FORMAL_TYPE, TOKEN_COMMA, TOKEN_RIGHT_PAREN);
+  DEF(ATTRIBUTED_FORMAL_TYPE, TOKEN_COMMA, TOKEN_RIGHT_PAREN);
+  DEF(FORMAL_PARAM_LIST, TOKEN_RIGHT_PAREN);
+  DEF(FORMAL_PARAMS, TOKEN_SEMICOLON, TOKEN_RIGHT_PAREN);
+  DEF(ATTRIB_FORMAL_PARAMS, TOKEN_SEMICOLON, TOKEN_RIGHT_PAREN);
+  DEF(TYPE_DECLARATION_TAIL, TOKEN_SEMICOLON);
+  DEF(ALT(TYPE_DECLARATION_TAIL), TOKEN_SEMICOLON);
+  } /* end switch */
+  
+  return m2t_tokenset_from_list(0);
+} /* end follow_set */
+
+
+/* --------------------------------------------------------------------------
+ * private function resync_set(index, name)
+ * --------------------------------------------------------------------------
+ * Returns the resync set for table index and passes its name back in name.
+ * ----------------------------------------------------------------------- */
+
+static m2t_tokenset_t resync_set (uint_t index, const char **name) {
+  switch (index) {
+  DEF(IMPORT_OR_DEFINITON_OR_END, TOKEN_CONST, TOKEN_END, TOKEN_FROM,
+    TOKEN_IMPORT, TOKEN_PROCEDURE, TOKEN_TYPE, TOKEN_VAR, TOKEN_END_OF_FILE);
+  DEF(IMPORT_OR_IDENT_OR_SEMICOLON, TOKEN_IMPORT, TOKEN_IDENTIFIER,
+    TOKEN_SEMICOLON, TOKEN_END_OF_FILE);
+  DEF(IDENT_OR_SEMICOLON, TOKEN_IDENTIFIER, TOKEN_SEMICOLON,
+    TOKEN_END_OF_FILE);
+  DEF(COMMA_OR_SEMICOLON, TOKEN_COMMA, TOKEN_SEMICOLON, TOKEN_END_OF_FILE);
+  DEF(DEFINITION_OR_IDENT_OR_SEMICOLON, TOKEN_CONST, TOKEN_PROCEDURE,
+    TOKEN_TYPE, TOKEN_VAR, TOKEN_IDENTIFIER, TOKEN_SEMICOLON,
+    TOKEN_END_OF_FILE);
+  DEF(DEFINITION_OR_SEMICOLON, TOKEN_CONST, TOKEN_PROCEDURE, TOKEN_TYPE,
+    TOKEN_VAR, TOKEN_SEMICOLON, TOKEN_END_OF_FILE);
+  DEF(TYPE_OR_COMMA_OR_OF, TOKEN_ARRAY, TOKEN_OF, TOKEN_POINTER,
+    TOKEN_PROCEDURE, TOKEN_RECORD, TOKEN_SET, TOKEN_IDENTIFIER, TOKEN_COMMA,
+    TOKEN_LEFT_PAREN, TOKEN_LEFT_BRACKET, TOKEN_END_OF_FILE);
+  DEF(SEMICOLON_OR_END, TOKEN_END, TOKEN_SEMICOLON, TOKEN_END_OF_FILE);
+  DEF(ELSE_OR_END, TOKEN_ELSE, TOKEN_END, TOKEN_END_OF_FILE);
+  DEF(COMMA_OR_RIGHT_PAREN, TOKEN_COMMA, TOKEN_RIGHT_PAREN, TOKEN_END_OF_FILE);
+  DEF(COLON_OR_SEMICOLON, TOKEN_COLON, TOKEN_SEMICOLON, TOKEN_END_OF_FILE);
+  DEF(IMPORT_OR_BLOCK, TOKEN_BEGIN, TOKEN_CONST, TOKEN_END, TOKEN_FROM,
+    TOKEN_IMPORT, TOKEN_MODULE, TOKEN_PROCEDURE, TOKEN_TYPE, TOKEN_VAR,
+    TOKEN_END_OF_FILE);
+  DEF(DECLARATION_OR_IDENT_OR_SEMICOLON, TOKEN_CONST, TOKEN_MODULE,
+    TOKEN_PROCEDURE, TOKEN_TYPE, TOKEN_VAR, TOKEN_IDENTIFIER, TOKEN_SEMICOLON,
+    TOKEN_END_OF_FILE);
+  DEF(DECLARATION_OR_SEMICOLON, TOKEN_CONST, TOKEN_MODULE, TOKEN_PROCEDURE,
+    TOKEN_TYPE, TOKEN_VAR, TOKEN_SEMICOLON, TOKEN_END_OF_FILE);
+  DEF(FIRST_OR_FOLLOW_OF_STATEMENT, TOKEN_CASE, TOKEN_ELSE, TOKEN_ELSIF,
+    TOKEN_END, TOKEN_EXIT, TOKEN_FOR, TOKEN_IF, TOKEN_LOOP, TOKEN_REPEAT,
+    TOKEN_RETURN, TOKEN_UNTIL, TOKEN_WHILE, TOKEN_WITH, TOKEN_IDENTIFIER,
+    TOKEN_SEMICOLON, TOKEN_BAR, TOKEN_END_OF_FILE);
+  DEF(ELSIF_OR_ELSE_OR_END, TOKEN_ELSE, TOKEN_ELSIF, TOKEN_END,
+    TOKEN_END_OF_FILE);
+  DEF(FOR_LOOP_BODY, TOKEN_DO, TOKEN_END_OF_FILE);
+  } /* end switch */
+  
+  return m2t_tokenset_from_list(0);
+} /* end resync_set */
+
+/* END OF FILE */
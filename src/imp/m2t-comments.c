@@ -0,0 +1,592 @@
+/* M2T -- Sorce to Source Modula-2 Translator
+ *
+ * Copyright (c) 2016-2023 Benjamin Kowarsch
+ *
+ * Author & Maintainer: Benjamin Kowarsch <org.m2sf>
+ *
+ * @synopsis
+ *
+ * M2T is a multi-dialect Modula-2 source-to-source translator. It translates
+ * source files  written in the  classic dialects  to semantically equivalent
+ * source files in  Modula-2 Revision 2010 (M2R10).  It supports  the classic
+ * Modula-2 dialects  described in  the 2nd, 3rd and 4th editions  of Niklaus
+ * Wirth's book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * For more details please visit: https://github.com/trijezdci/m2t/wiki
+ *
+ * @repository
+ *
+ * https://github.com/trijezdci/m2t
+ *
+ * @file
+ *
+ * m2t-comments.c
+ *
+ * Implementation of M2T comment tables.
+ *
+ * @license
+ *
+ * M2T is free software:  You can redistribute and modify it  under the terms
+ * of the  GNU Lesser General Public License (LGPL) either version 2.1  or at
+ * your choice version 3, both as published by the Free Software Foundation.
+ *
+ * M2T is distributed  in the hope  that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even  the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received  a copy of the  GNU Lesser General Public License
+ * along with M2T.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#include "m2t-comments.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+
+/* --------------------------------------------------------------------------
+ * Initial capacities and maximum load of the node map of a comment table
+ * ----------------------------------------------------------------------- */
+
+#define M2T_COMMENT_TABLE_INIT_CAPACITY 64
+
+#define M2T_COMMENT_MAP_INIT_CAPACITY 64
+
+#define M2T_COMMENT_MAP_MAX_LOAD_PERCENT 75
+
+
+/* --------------------------------------------------------------------------
+ * private type m2t_comment_entry_s
+ * --------------------------------------------------------------------------
+ * record type representing a comment of a comment table.  Field anchor
+ * holds the offset of the symbol that follows the comment.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* offset */ uint32_t offset;
+  /* length */ uint32_t length;
+  /* anchor */ uint32_t anchor;
+  /* node */ m2t_astnode_t node;
+} m2t_comment_entry_s;
+
+
+/* --------------------------------------------------------------------------
+ * private type m2t_comment_slot_s
+ * --------------------------------------------------------------------------
+ * record type representing a slot of the node map of a comment table.  A
+ * slot is empty if its node is NULL.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* node */ m2t_astnode_t node;
+  /* first */ uint_t first;
+  /* count */ uint_t count;
+} m2t_comment_slot_s;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2t_comment_table_s
+ * --------------------------------------------------------------------------
+ * record type representing a comment table.  Comments are held in source
+ * order.  Field anchored holds the number of comments whose anchor has been
+ * recorded, anchors are therefore ascending.  The node map is an open
+ * addressing table with linear probing keyed by node that maps each node
+ * to the range of comments attached to it.  It is allocated on first use.
+ * ----------------------------------------------------------------------- */
+
+struct m2t_comment_table_s {
+  /* source */ const char *source;
+  /* source_length */ size_t source_length;
+  /* owned */ bool owned;
+  /* count */ uint_t count;
+  /* anchored */ uint_t anchored;
+  /* capacity */ uint_t capacity;
+  /* entry */ m2t_comment_entry_s *entry;
+  /* map_used */ uint_t map_used;
+  /* map_capacity */ uint_t map_capacity;
+  /* slot */ m2t_comment_slot_s *slot;
+};
+
+typedef struct m2t_comment_table_s m2t_comment_table_s;
+
+
+/* --------------------------------------------------------------------------
+ * Forward declarations
+ * ----------------------------------------------------------------------- */
+
+static inline uint_t home_slot (m2t_astnode_t node, uint_t mask);
+
+static uint_t map_probe (m2t_comment_table_t table, m2t_astnode_t node);
+
+static bool map_reserve (m2t_comment_table_t table);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_new_comment_table()
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated empty comment table, or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2t_comment_table_t m2t_new_comment_table (void) {
+  
+  m2t_comment_table_t new_table;
+  
+  new_table = malloc(sizeof(m2t_comment_table_s));
+  
+  if (new_table == NULL) {
+    return NULL;
+  } /* end if */
+  
+  new_table->entry =
+    malloc(M2T_COMMENT_TABLE_INIT_CAPACITY * sizeof(m2t_comment_entry_s));
+  
+  if (new_table->entry == NULL) {
+    free(new_table);
+    return NULL;
+  } /* end if */
+  
+  new_table->source = NULL;
+  new_table->source_length = 0;
+  new_table->owned = false;
+  new_table->count = 0;
+  new_table->anchored = 0;
+  new_table->capacity = M2T_COMMENT_TABLE_INIT_CAPACITY;
+  new_table->map_used = 0;
+  new_table->map_capacity = 0;
+  new_table->slot = NULL;
+  
+  return new_table;
+} /* end m2t_new_comment_table */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_comment_table_set_source(table, source, length, owned)
+ * --------------------------------------------------------------------------
+ * Sets the source text of length bytes that the comments of table refer
+ * to.  If owned is true, source passes to table and is released when table
+ * is released, otherwise it must remain valid for as long as comment text
+ * is obtained from table.  Any source previously owned by table is
+ * released.  Does nothing if table is NULL.
+ * ----------------------------------------------------------------------- */
+
+void m2t_comment_table_set_source
+  (m2t_comment_table_t table, const char *source, size_t length, bool owned) {
+  
+  if (table == NULL) {
+    return;
+  } /* end if */
+  
+  if ((table->owned) && (table->source != source)) {
+    free((void *) table->source);
+  } /* end if */
+  
+  table->source = source;
+  table->source_length = length;
+  table->owned = owned;
+} /* end m2t_comment_table_set_source */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_comment_table_add(table, offset, length)
+ * --------------------------------------------------------------------------
+ * Appends a comment of length bytes at byte offset to table.  Comments must
+ * be appended in the order in which they occur in the source.  Returns true
+ * on success, or false if table is NULL, if offset precedes the end of the
+ * last comment or if the table could not be grown.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_comment_table_add
+  (m2t_comment_table_t table, uint32_t offset, uint32_t length) {
+  
+  m2t_comment_entry_s *new_entry, *last;
+  uint_t new_capacity;
+  
+  if (table == NULL) {
+    return false;
+  } /* end if */
+  
+  if (table->count > 0) {
+    last = &table->entry[table->count - 1];
+    
+    if (offset < last->offset + last->length) {
+      return false;
+    } /* end if */
+  } /* end if */
+  
+  /* grow table if full */
+  if (table->count == table->capacity) {
+    new_capacity = 2 * table->capacity;
+    new_entry =
+      realloc(table->entry, new_capacity * sizeof(m2t_comment_entry_s));
+    
+    if (new_entry == NULL) {
+      return false;
+    } /* end if */
+    
+    table->entry = new_entry;
+    table->capacity = new_capacity;
+  } /* end if */
+  
+  table->entry[table->count].offset = offset;
+  table->entry[table->count].length = length;
+  table->entry[table->count].anchor = 0;
+  table->entry[table->count].node = NULL;
+  table->count++;
+  
+  return true;
+} /* end m2t_comment_table_add */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_comment_table_anchor(table, offset)
+ * --------------------------------------------------------------------------
+ * Records offset as the offset of the symbol that follows the comments of
+ * table appended since the last call.  Called by the lexer for each symbol.
+ * Does nothing if table is NULL.
+ * ----------------------------------------------------------------------- */
+
+void m2t_comment_table_anchor (m2t_comment_table_t table, uint32_t offset) {
+  
+  if (table == NULL) {
+    return;
+  } /* end if */
+  
+  while (table->anchored < table->count) {
+    table->entry[table->anchored].anchor = offset;
+    table->anchored++;
+  } /* end while */
+} /* end m2t_comment_table_anchor */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_comment_table_attach(table, first, last, node)
+ * --------------------------------------------------------------------------
+ * Attaches the comments of table that are followed by a symbol at an offset
+ * from first up to and including last to node, replacing any node they
+ * were attached to.  Does nothing if table or node is NULL.
+ * ----------------------------------------------------------------------- */
+
+void m2t_comment_table_attach
+  (m2t_comment_table_t table, uint32_t first, uint32_t last,
+   m2t_astnode_t node) {
+  
+  uint_t lower, upper, middle, index, slot;
+  
+  if ((table == NULL) || (node == NULL)) {
+    return;
+  } /* end if */
+  
+  /* find first anchored comment followed by a symbol at or after first */
+  lower = 0;
+  upper = table->anchored;
+  while (lower < upper) {
+    middle = lower + (upper - lower) / 2;
+    
+    if (table->entry[middle].anchor < first) {
+      lower = middle + 1;
+    }
+    else {
+      upper = middle;
+    } /* end if */
+  } /* end while */
+  
+  /* attach comments followed by a symbol up to last */
+  index = lower;
+  while ((index < table->anchored) && (table->entry[index].anchor <= last)) {
+    table->entry[index].node = node;
+    index++;
+  } /* end while */
+  
+  if ((index == lower) || (NOT(map_reserve(table)))) {
+    return;
+  } /* end if */
+  
+  /* map node to its comments */
+  slot = map_probe(table, node);
+  
+  if (table->slot[slot].node == NULL) {
+    table->slot[slot].node = node;
+    table->map_used++;
+  } /* end if */
+  
+  table->slot[slot].first = lower;
+  table->slot[slot].count = index - lower;
+} /* end m2t_comment_table_attach */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_comment_table_count(table)
+ * --------------------------------------------------------------------------
+ * Returns the number of comments in table, or zero if table is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2t_comment_table_count (m2t_comment_table_t table) {
+  
+  if (table == NULL) {
+    return 0;
+  } /* end if */
+  
+  return table->count;
+} /* end m2t_comment_table_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_comment_table_entry(table, index, comment)
+ * --------------------------------------------------------------------------
+ * Passes the comment at index in table back in comment and returns true.
+ * Returns false and leaves comment unmodified if table is NULL or if index
+ * is out of range.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_comment_table_entry
+  (m2t_comment_table_t table, uint_t index, m2t_comment_t *comment) {
+  
+  if ((table == NULL) || (index >= table->count)) {
+    return false;
+  } /* end if */
+  
+  if (comment != NULL) {
+    comment->offset = table->entry[index].offset;
+    comment->length = table->entry[index].length;
+    comment->node = table->entry[index].node;
+  } /* end if */
+  
+  return true;
+} /* end m2t_comment_table_entry */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_comment_table_index_for_offset(table, offset)
+ * --------------------------------------------------------------------------
+ * Returns the index of the first comment in table that starts at or after
+ * byte offset, or the number of comments if there is none.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2t_comment_table_index_for_offset
+  (m2t_comment_table_t table, uint32_t offset) {
+  
+  uint_t lower, upper, middle;
+  
+  if (table == NULL) {
+    return 0;
+  } /* end if */
+  
+  lower = 0;
+  upper = table->count;
+  while (lower < upper) {
+    middle = lower + (upper - lower) / 2;
+    
+    if (table->entry[middle].offset < offset) {
+      lower = middle + 1;
+    }
+    else {
+      upper = middle;
+    } /* end if */
+  } /* end while */
+  
+  return lower;
+} /* end m2t_comment_table_index_for_offset */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_comment_table_find(table, node, first, count)
+ * --------------------------------------------------------------------------
+ * Passes the index of the first comment attached to node in table back in
+ * first and the number of comments attached to node back in count and
+ * returns true.  Comments attached to the same node are adjacent.  Returns
+ * false and leaves first and count unmodified if no comment is attached to
+ * node or if table is NULL.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_comment_table_find
+  (m2t_comment_table_t table, m2t_astnode_t node,
+   uint_t *first, uint_t *count) {
+  
+  uint_t slot, index, end;
+  
+  if ((table == NULL) || (node == NULL) || (table->slot == NULL)) {
+    return false;
+  } /* end if */
+  
+  slot = map_probe(table, node);
+  
+  if (table->slot[slot].node == NULL) {
+    return false;
+  } /* end if */
+  
+  /* comments since attached to another node are no longer counted */
+  index = table->slot[slot].first;
+  end = index + table->slot[slot].count;
+  while ((index < end) && (table->entry[index].node == node)) {
+    index++;
+  } /* end while */
+  
+  if (index == table->slot[slot].first) {
+    return false;
+  } /* end if */
+  
+  WRITE_OUTPARAM(first, table->slot[slot].first);
+  WRITE_OUTPARAM(count, index - table->slot[slot].first);
+  
+  return true;
+} /* end m2t_comment_table_find */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_comment_table_text(table, index, length)
+ * --------------------------------------------------------------------------
+ * Returns a pointer to the text of the comment at index in table within
+ * the source of table and passes its length back in length.  The text
+ * includes the delimiters and is NOT NUL terminated.  Returns NULL and
+ * leaves length unmodified if table is NULL, if index is out of range or
+ * if the comment does not lie within the source of table.
+ * ----------------------------------------------------------------------- */
+
+const char *m2t_comment_table_text
+  (m2t_comment_table_t table, uint_t index, uint_t *length) {
+  
+  m2t_comment_entry_s *entry;
+  
+  if ((table == NULL) || (index >= table->count) ||
+      (table->source == NULL)) {
+    return NULL;
+  } /* end if */
+  
+  entry = &table->entry[index];
+  
+  if ((size_t) entry->offset + entry->length > table->source_length) {
+    return NULL;
+  } /* end if */
+  
+  WRITE_OUTPARAM(length, entry->length);
+  
+  return table->source + entry->offset;
+} /* end m2t_comment_table_text */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_release_comment_table(table)
+ * --------------------------------------------------------------------------
+ * Releases the comment table passed in table and any source it owns and
+ * passes back NULL in table.  The nodes recorded in the table are not
+ * released.
+ * ----------------------------------------------------------------------- */
+
+void m2t_release_comment_table (m2t_comment_table_t *table) {
+  
+  if ((table == NULL) || (*table == NULL)) {
+    return;
+  } /* end if */
+  
+  if ((*table)->owned) {
+    free((void *) (*table)->source);
+  } /* end if */
+  
+  free((*table)->slot);
+  free((*table)->entry);
+  free(*table);
+  *table = NULL;
+} /* end m2t_release_comment_table */
+
+
+/* ************************************************************************ *
+ * Private Functions                                                        *
+ * ************************************************************************ */
+
+/* --------------------------------------------------------------------------
+ * private function home_slot(node, mask)
+ * --------------------------------------------------------------------------
+ * Returns the home slot of node for a map with capacity mask + 1.
+ * ----------------------------------------------------------------------- */
+
+static inline uint_t home_slot (m2t_astnode_t node, uint_t mask) {
+  
+  uint64_t key;
+  
+  key = ((uint64_t) (uintptr_t) node) * 0x9E3779B97F4A7C15ULL;
+  
+  return ((uint_t) (key >> 32)) & mask;
+} /* end home_slot */
+
+
+/* --------------------------------------------------------------------------
+ * private function map_probe(table, node)
+ * --------------------------------------------------------------------------
+ * Returns the slot of node in the node map of table, or the empty slot
+ * where node would be stored if node is not present.
+ * ----------------------------------------------------------------------- */
+
+static uint_t map_probe (m2t_comment_table_t table, m2t_astnode_t node) {
+  
+  uint_t slot, mask;
+  
+  mask = table->map_capacity - 1;
+  slot = home_slot(node, mask);
+  
+  while ((table->slot[slot].node != NULL) &&
+         (table->slot[slot].node != node)) {
+    slot = (slot + 1) & mask;
+  } /* end while */
+  
+  return slot;
+} /* end map_probe */
+
+
+/* --------------------------------------------------------------------------
+ * private function map_reserve(table)
+ * --------------------------------------------------------------------------
+ * Makes room for one more node in the node map of table, allocating the
+ * map if it has not been allocated yet and doubling its capacity if the
+ * maximum load would otherwise be exceeded.  Returns false if the map
+ * needed to be allocated or grown but could not be.
+ * ----------------------------------------------------------------------- */
+
+static bool map_reserve (m2t_comment_table_t table) {
+  
+  m2t_comment_slot_s *old_slot;
+  uint_t old_capacity, slot, new_slot;
+  
+  if (table->slot == NULL) {
+    table->slot =
+      calloc(M2T_COMMENT_MAP_INIT_CAPACITY, sizeof(m2t_comment_slot_s));
+    
+    if (table->slot == NULL) {
+      return false;
+    } /* end if */
+    
+    table->map_capacity = M2T_COMMENT_MAP_INIT_CAPACITY;
+    return true;
+  } /* end if */
+  
+  if (((table->map_used + 1) * 100) <=
+      (table->map_capacity * M2T_COMMENT_MAP_MAX_LOAD_PERCENT)) {
+    return true;
+  } /* end if */
+  
+  old_slot = table->slot;
+  old_capacity = table->map_capacity;
+  
+  table->slot = calloc(2 * old_capacity, sizeof(m2t_comment_slot_s));
+  
+  if (table->slot == NULL) {
+    table->slot = old_slot;
+    return false;
+  } /* end if */
+  
+  table->map_capacity = 2 * old_capacity;
+  
+  /* rehash occupied slots */
+  for (slot = 0; slot < old_capacity; slot++) {
+    if (old_slot[slot].node != NULL) {
+      new_slot = map_probe(table, old_slot[slot].node);
+      table->slot[new_slot] = old_slot[slot];
+    } /* end if */
+  } /* end for */
+  
+  free(old_slot);
+  
+  return true;
+} /* end map_reserve */
+
+
+/* END OF FILE */
@@ -0,0 +1,990 @@
+/* M2T -- Sorce to Source Modula-2 Translator
+ *
+ * Copyright (c) 2016-2023 Benjamin Kowarsch
+ *
+ * Author & Maintainer: Benjamin Kowarsch <org.m2sf>
+ *
+ * @synopsis
+ *
+ * M2T is a multi-dialect Modula-2 source-to-source translator. It translates
+ * source files  written in the  classic dialects  to semantically equivalent
+ * source files in  Modula-2 Revision 2010 (M2R10).  It supports  the classic
+ * Modula-2 dialects  described in  the 2nd, 3rd and 4th editions  of Niklaus
+ * Wirth's book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * For more details please visit: https://github.com/trijezdci/m2t/wiki
+ *
+ * @repository
+ *
+ * https://github.com/trijezdci/m2t
+ *
+ * @file
+ *
+ * m2t-constfold.c
+ *
+ * Implementation of M2T constant expression folding.
+ *
+ * @license
+ *
+ * M2T is free software:  You can redistribute and modify it  under the terms
+ * of the  GNU Lesser General Public License (LGPL) either version 2.1  or at
+ * your choice version 3, both as published by the Free Software Foundation.
+ *
+ * M2T is distributed  in the hope  that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even  the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received  a copy of the  GNU Lesser General Public License
+ * along with M2T.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#include "m2t-constfold.h"
+#include "m2t-literals.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* --------------------------------------------------------------------------
+ * Initial capacity and maximum load of folder tables
+ * ----------------------------------------------------------------------- */
+
+#define M2T_FOLD_TABLE_INIT_CAPACITY 256
+
+#define M2T_FOLD_TABLE_MAX_LOAD_PERCENT 75
+
+
+/* --------------------------------------------------------------------------
+ * private type m2t_fold_state_t
+ * --------------------------------------------------------------------------
+ * Enumerated states of a memoized node.  A node is in state FOLDING while
+ * its subexpressions are evaluated, meeting it again means a cycle.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  FOLD_STATE_FOLDING,
+  FOLD_STATE_FOLDED
+} m2t_fold_state_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type m2t_fold_entry_s
+ * --------------------------------------------------------------------------
+ * record type representing a slot of a folder table.  A slot is empty if
+ * its key is NULL.  Slots of the memo table are keyed by node and hold a
+ * state and value, slots of the binding table are keyed by identifier and
+ * hold an expression.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* key */ const void *key;
+  /* expr */ m2t_astnode_t expr;
+  /* state */ m2t_fold_state_t state;
+  /* value */ m2t_const_value_t value;
+} m2t_fold_entry_s;
+
+
+/* --------------------------------------------------------------------------
+ * private type m2t_fold_table_s
+ * --------------------------------------------------------------------------
+ * record type representing a folder table.  The table is an open addressing
+ * table with linear probing.  The capacity is a power of two.  Entries are
+ * never removed, the table is released as a whole.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* capacity */ uint_t capacity;
+  /* used */ uint_t used;
+  /* slot */ m2t_fold_entry_s *slot;
+} m2t_fold_table_s;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2t_const_folder_s
+ * --------------------------------------------------------------------------
+ * record type representing a constant folder.
+ * ----------------------------------------------------------------------- */
+
+struct m2t_const_folder_s {
+  /* memo */ m2t_fold_table_s memo;
+  /* bindings */ m2t_fold_table_s bindings;
+};
+
+typedef struct m2t_const_folder_s m2t_const_folder_s;
+
+
+/* --------------------------------------------------------------------------
+ * Forward declarations
+ * ----------------------------------------------------------------------- */
+
+static bool table_init (m2t_fold_table_s *table);
+
+static inline uint_t home_slot (const void *key, uint_t mask);
+
+static uint_t table_probe (m2t_fold_table_s *table, const void *key);
+
+static m2t_fold_entry_s *table_enter
+  (m2t_fold_table_s *table, const void *key);
+
+static bool table_reserve (m2t_fold_table_s *table);
+
+static m2t_const_value_t fold_node
+  (m2t_const_folder_t folder, m2t_astnode_t node);
+
+static m2t_const_value_t evaluate
+  (m2t_const_folder_t folder, m2t_astnode_t node);
+
+static m2t_const_value_t evaluate_literal
+  (m2t_astnode_t node, m2t_const_kind_t kind);
+
+static m2t_const_value_t evaluate_ident
+  (m2t_const_folder_t folder, m2t_astnode_t node);
+
+static m2t_const_value_t evaluate_char_string (m2t_astnode_t node);
+
+static m2t_const_value_t evaluate_unary
+  (m2t_ast_nodetype_t op, m2t_const_value_t operand);
+
+static m2t_const_value_t evaluate_binary
+  (m2t_ast_nodetype_t op, m2t_const_value_t left, m2t_const_value_t right);
+
+static m2t_const_value_t evaluate_whole
+  (m2t_ast_nodetype_t op, int64_t left, int64_t right);
+
+static m2t_const_value_t evaluate_real
+  (m2t_ast_nodetype_t op, double left, double right);
+
+static m2t_const_value_t evaluate_compare
+  (m2t_ast_nodetype_t op, m2t_const_value_t left, m2t_const_value_t right);
+
+static bool product_overflows (int64_t left, int64_t right);
+
+static m2t_const_value_t whole_value (int64_t value);
+
+static m2t_const_value_t boolean_value (bool value);
+
+
+/* --------------------------------------------------------------------------
+ * Unknown value
+ * ----------------------------------------------------------------------- */
+
+static const m2t_const_value_t unknown_value = { M2T_CONST_UNKNOWN, { 0 } };
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_new_const_folder()
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated constant folder without bindings, or NULL on
+ * failure.
+ * ----------------------------------------------------------------------- */
+
+m2t_const_folder_t m2t_new_const_folder (void) {
+  
+  m2t_const_folder_t new_folder;
+  
+  new_folder = malloc(sizeof(m2t_const_folder_s));
+  
+  if (new_folder == NULL) {
+    return NULL;
+  } /* end if */
+  
+  if (NOT(table_init(&new_folder->memo))) {
+    free(new_folder);
+    return NULL;
+  } /* end if */
+  
+  if (NOT(table_init(&new_folder->bindings))) {
+    free(new_folder->memo.slot);
+    free(new_folder);
+    return NULL;
+  } /* end if */
+  
+  return new_folder;
+} /* end m2t_new_const_folder */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_const_folder_bind(folder, ident, expr)
+ * --------------------------------------------------------------------------
+ * Binds constant identifier ident to expression expr in folder, replacing
+ * any previous binding of ident.  Returns true on success, or false if
+ * folder, ident or expr is NULL or if the folder could not be grown.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_const_folder_bind
+  (m2t_const_folder_t folder, m2t_string_t ident, m2t_astnode_t expr) {
+  
+  m2t_fold_entry_s *entry;
+  
+  if ((folder == NULL) || (ident == NULL) || (expr == NULL)) {
+    return false;
+  } /* end if */
+  
+  entry = table_enter(&folder->bindings, ident);
+  
+  if (entry == NULL) {
+    return false;
+  } /* end if */
+  
+  entry->expr = expr;
+  
+  return true;
+} /* end m2t_const_folder_bind */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_const_folder_bind_defs(folder, list)
+ * --------------------------------------------------------------------------
+ * Binds the identifier of every constant definition (CONSTDEF) found among
+ * the subnodes of definition or declaration list list to its expression.
+ * Returns the number of bindings made.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2t_const_folder_bind_defs
+  (m2t_const_folder_t folder, m2t_astnode_t list) {
+  
+  m2t_astnode_t def, id;
+  uint_t index, count, bound;
+  
+  if ((folder == NULL) || (list == NULL)) {
+    return 0;
+  } /* end if */
+  
+  bound = 0;
+  count = m2t_ast_subnode_count(list);
+  
+  for (index = 0; index < count; index++) {
+    def = m2t_ast_subnode_for_index(list, index);
+    
+    if ((def != NULL) && (m2t_ast_nodetype(def) == AST_CONSTDEF)) {
+      id = m2t_ast_subnode_for_index(def, 0);
+      
+      if (m2t_const_folder_bind(folder,
+          m2t_ast_value(id), m2t_ast_subnode_for_index(def, 1))) {
+        bound++;
+      } /* end if */
+    } /* end if */
+  } /* end for */
+  
+  return bound;
+} /* end m2t_const_folder_bind_defs */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_const_fold(folder, expr, value)
+ * --------------------------------------------------------------------------
+ * Evaluates constant expression expr, memoizing the values of expr and of
+ * its subexpressions in folder.  Passes the value back in value, unless
+ * NULL is passed in, and returns true.  Returns false and passes back a
+ * value of kind M2T_CONST_UNKNOWN if expr is not constant, if its value
+ * cannot be determined or if it depends on its own definition.  Whole
+ * number literals are taken from the literal repository.  DIV and MOD are
+ * only folded for non-negative dividends and positive divisors.  Arithmetic
+ * that overflows 64 bits is not folded.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_const_fold
+  (m2t_const_folder_t folder, m2t_astnode_t expr, m2t_const_value_t *value) {
+  
+  m2t_const_value_t result;
+  
+  if ((folder == NULL) || (expr == NULL)) {
+    result = unknown_value;
+  }
+  else {
+    result = fold_node(folder, expr);
+  } /* end if */
+  
+  WRITE_OUTPARAM(value, result);
+  
+  return (result.kind != M2T_CONST_UNKNOWN);
+} /* end m2t_const_fold */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_const_folder_count(folder)
+ * --------------------------------------------------------------------------
+ * Returns the number of nodes memoized in folder, or zero if folder is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2t_const_folder_count (m2t_const_folder_t folder) {
+  
+  if (folder == NULL) {
+    return 0;
+  } /* end if */
+  
+  return folder->memo.used;
+} /* end m2t_const_folder_count */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_release_const_folder(folder)
+ * --------------------------------------------------------------------------
+ * Releases the constant folder passed in folder and passes back NULL in
+ * folder.  No nodes are released.
+ * ----------------------------------------------------------------------- */
+
+void m2t_release_const_folder (m2t_const_folder_t *folder) {
+  
+  if ((folder == NULL) || (*folder == NULL)) {
+    return;
+  } /* end if */
+  
+  free((*folder)->memo.slot);
+  free((*folder)->bindings.slot);
+  free(*folder);
+  *folder = NULL;
+} /* end m2t_release_const_folder */
+
+
+/* ************************************************************************ *
+ * Private Functions                                                        *
+ * ************************************************************************ */
+
+/* --------------------------------------------------------------------------
+ * private function table_init(table)
+ * --------------------------------------------------------------------------
+ * Allocates the slots of an empty table.  Returns false on failure.
+ * ----------------------------------------------------------------------- */
+
+static bool table_init (m2t_fold_table_s *table) {
+  
+  table->slot =
+    calloc(M2T_FOLD_TABLE_INIT_CAPACITY, sizeof(m2t_fold_entry_s));
+  
+  if (table->slot == NULL) {
+    return false;
+  } /* end if */
+  
+  table->capacity = M2T_FOLD_TABLE_INIT_CAPACITY;
+  table->used = 0;
+  
+  return true;
+} /* end table_init */
+
+
+/* --------------------------------------------------------------------------
+ * private function home_slot(key, mask)
+ * --------------------------------------------------------------------------
+ * Returns the home slot of key for a table with capacity mask + 1.
+ * ----------------------------------------------------------------------- */
+
+static inline uint_t home_slot (const void *key, uint_t mask) {
+  
+  uint64_t hash;
+  
+  hash = ((uint64_t) (uintptr_t) key) * 0x9E3779B97F4A7C15ULL;
+  
+  return ((uint_t) (hash >> 32)) & mask;
+} /* end home_slot */
+
+
+/* --------------------------------------------------------------------------
+ * private function table_probe(table, key)
+ * --------------------------------------------------------------------------
+ * Returns the slot of key in table, or the empty slot where key would be
+ * stored if key is not present.
+ * ----------------------------------------------------------------------- */
+
+static uint_t table_probe (m2t_fold_table_s *table, const void *key) {
+  
+  uint_t slot, mask;
+  
+  mask = table->capacity - 1;
+  slot = home_slot(key, mask);
+  
+  while ((table->slot[slot].key != NULL) &&
+         (table->slot[slot].key != key)) {
+    slot = (slot + 1) & mask;
+  } /* end while */
+  
+  return slot;
+} /* end table_probe */
+
+
+/* --------------------------------------------------------------------------
+ * private function table_enter(table, key)
+ * --------------------------------------------------------------------------
+ * Returns the entry for key in table, entering key if it is not present.
+ * Returns NULL if the table needed to grow but could not be grown.  The
+ * entry is only valid until the next entry is made.
+ * ----------------------------------------------------------------------- */
+
+static m2t_fold_entry_s *table_enter
+  (m2t_fold_table_s *table, const void *key) {
+  
+  uint_t slot;
+  
+  if (NOT(table_reserve(table))) {
+    return NULL;
+  } /* end if */
+  
+  slot = table_probe(table, key);
+  
+  if (table->slot[slot].key == NULL) {
+    table->slot[slot].key = key;
+    table->used++;
+  } /* end if */
+  
+  return &table->slot[slot];
+} /* end table_enter */
+
+
+/* --------------------------------------------------------------------------
+ * private function table_reserve(table)
+ * --------------------------------------------------------------------------
+ * Makes room for one more key in table, doubling its capacity if the
+ * maximum load would otherwise be exceeded.  Returns false if the table
+ * needed to grow but could not be grown.
+ * ----------------------------------------------------------------------- */
+
+static bool table_reserve (m2t_fold_table_s *table) {
+  
+  m2t_fold_entry_s *old_slot;
+  uint_t old_capacity, slot, new_slot;
+  
+  if (((table->used + 1) * 100) <=
+      (table->capacity * M2T_FOLD_TABLE_MAX_LOAD_PERCENT)) {
+    return true;
+  } /* end if */
+  
+  old_slot = table->slot;
+  old_capacity = table->capacity;
+  
+  table->slot = calloc(2 * old_capacity, sizeof(m2t_fold_entry_s));
+  
+  if (table->slot == NULL) {
+    table->slot = old_slot;
+    return false;
+  } /* end if */
+  
+  table->capacity = 2 * old_capacity;
+  
+  /* rehash occupied slots */
+  for (slot = 0; slot < old_capacity; slot++) {
+    if (old_slot[slot].key != NULL) {
+      new_slot = table_probe(table, old_slot[slot].key);
+      table->slot[new_slot] = old_slot[slot];
+    } /* end if */
+  } /* end for */
+  
+  free(old_slot);
+  
+  return true;
+} /* end table_reserve */
+
+
+/* --------------------------------------------------------------------------
+ * private function fold_node(folder, node)
+ * --------------------------------------------------------------------------
+ * Returns the memoized value of node, evaluating and memoizing it first if
+ * it has not been evaluated before.  A node met while it is being evaluated
+ * is part of a cycle and its value is unknown.
+ * ----------------------------------------------------------------------- */
+
+static m2t_const_value_t fold_node
+  (m2t_const_folder_t folder, m2t_astnode_t node) {
+  
+  m2t_fold_entry_s *entry;
+  m2t_const_value_t result;
+  uint_t slot;
+  
+  slot = table_probe(&folder->memo, node);
+  
+  if /* memoized */ (folder->memo.slot[slot].key != NULL) {
+    if (folder->memo.slot[slot].state == FOLD_STATE_FOLDING) {
+      return unknown_value;
+    } /* end if */
+    
+    return folder->memo.slot[slot].value;
+  } /* end if */
+  
+  entry = table_enter(&folder->memo, node);
+  
+  if (entry == NULL) {
+    /* not memoized, fold without cycle detection */
+    return unknown_value;
+  } /* end if */
+  
+  entry->state = FOLD_STATE_FOLDING;
+  
+  result = evaluate(folder, node);
+  
+  /* the table may have grown while evaluating */
+  slot = table_probe(&folder->memo, node);
+  folder->memo.slot[slot].state = FOLD_STATE_FOLDED;
+  folder->memo.slot[slot].value = result;
+  
+  return result;
+} /* end fold_node */
+
+
+/* --------------------------------------------------------------------------
+ * private function evaluate(folder, node)
+ * --------------------------------------------------------------------------
+ * Evaluates node, folding its subexpressions through the memo table.
+ * ----------------------------------------------------------------------- */
+
+static m2t_const_value_t evaluate
+  (m2t_const_folder_t folder, m2t_astnode_t node) {
+  
+  m2t_ast_nodetype_t nodetype;
+  m2t_const_value_t left, right;
+  
+  nodetype = m2t_ast_nodetype(node);
+  
+  switch (nodetype) {
+    case AST_INTVAL :
+      return evaluate_literal(node, M2T_CONST_WHOLE);
+    
+    case AST_REALVAL :
+      return evaluate_literal(node, M2T_CONST_REAL);
+    
+    case AST_CHRVAL :
+      return evaluate_literal(node, M2T_CONST_CHAR);
+    
+    case AST_QUOTEDVAL :
+      return evaluate_char_string(node);
+    
+    case AST_IDENT :
+      return evaluate_ident(folder, node);
+    
+    case AST_NEG :
+    case AST_NOT :
+      left = fold_node(folder, m2t_ast_subnode_for_index(node, 0));
+      return evaluate_unary(nodetype, left);
+    
+    case AST_PLUS :
+    case AST_MINUS :
+    case AST_ASTERISK :
+    case AST_SOLIDUS :
+    case AST_DIV :
+    case AST_MOD :
+    case AST_AND :
+    case AST_OR :
+    case AST_EQ :
+    case AST_NEQ :
+    case AST_LT :
+    case AST_LTEQ :
+    case AST_GT :
+    case AST_GTEQ :
+      left = fold_node(folder, m2t_ast_subnode_for_index(node, 0));
+      
+      if (left.kind == M2T_CONST_UNKNOWN) {
+        return unknown_value;
+      } /* end if */
+      
+      right = fold_node(folder, m2t_ast_subnode_for_index(node, 1));
+      return evaluate_binary(nodetype, left, right);
+    
+    default :
+      /* sets, designators and function calls are not folded */
+      return unknown_value;
+  } /* end switch */
+} /* end evaluate */
+
+
+/* --------------------------------------------------------------------------
+ * private function evaluate_literal(node, kind)
+ * --------------------------------------------------------------------------
+ * Returns the value of literal node as kind, taken from the literal
+ * repository.  The value is unknown if it has not been recorded.
+ * ----------------------------------------------------------------------- */
+
+static m2t_const_value_t evaluate_literal
+  (m2t_astnode_t node, m2t_const_kind_t kind) {
+  
+  m2t_const_value_t result;
+  m2t_literal_t literal;
+  
+  if (NOT(m2t_literal_lookup(m2t_ast_value(node), &literal))) {
+    return unknown_value;
+  } /* end if */
+  
+  if (kind == M2T_CONST_REAL) {
+    if (literal.kind != M2T_LITERAL_REAL) {
+      return unknown_value;
+    } /* end if */
+    
+    result.kind = M2T_CONST_REAL;
+    result.value.real = literal.value.real;
+    return result;
+  } /* end if */
+  
+  if ((literal.kind != M2T_LITERAL_WHOLE) ||
+      (literal.value.whole > (uint64_t) INT64_MAX)) {
+    return unknown_value;
+  } /* end if */
+  
+  result.kind = kind;
+  result.value.whole = (int64_t) literal.value.whole;
+  
+  return result;
+} /* end evaluate_literal */
+
+
+/* --------------------------------------------------------------------------
+ * private function evaluate_ident(folder, node)
+ * --------------------------------------------------------------------------
+ * Returns the value of identifier node, folded through its binding.  The
+ * pervasive identifiers TRUE and FALSE have their Boolean values unless
+ * they are bound.
+ * ----------------------------------------------------------------------- */
+
+static m2t_const_value_t evaluate_ident
+  (m2t_const_folder_t folder, m2t_astnode_t node) {
+  
+  m2t_string_t ident;
+  const char *name;
+  uint_t slot;
+  
+  ident = m2t_ast_value(node);
+  
+  if (ident == NULL) {
+    return unknown_value;
+  } /* end if */
+  
+  slot = table_probe(&folder->bindings, ident);
+  
+  if (folder->bindings.slot[slot].key != NULL) {
+    return fold_node(folder, folder->bindings.slot[slot].expr);
+  } /* end if */
+  
+  name = m2t_string_char_ptr(ident);
+  
+  if (strcmp(name, "TRUE") == 0) {
+    return boolean_value(true);
+  }
+  else if (strcmp(name, "FALSE") == 0) {
+    return boolean_value(false);
+  } /* end if */
+  
+  return unknown_value;
+} /* end evaluate_ident */
+
+
+/* --------------------------------------------------------------------------
+ * private function evaluate_char_string(node)
+ * --------------------------------------------------------------------------
+ * Returns the character code of quoted literal node if it holds a single
+ * character.  The value of any other string is unknown.
+ * ----------------------------------------------------------------------- */
+
+static m2t_const_value_t evaluate_char_string (m2t_astnode_t node) {
+  
+  m2t_const_value_t result;
+  m2t_string_t string;
+  
+  string = m2t_ast_value(node);
+  
+  if ((string == NULL) || (m2t_string_length(string) != 1)) {
+    return unknown_value;
+  } /* end if */
+  
+  result.kind = M2T_CONST_CHAR;
+  result.value.whole = (unsigned char) m2t_string_char_ptr(string)[0];
+  
+  return result;
+} /* end evaluate_char_string */
+
+
+/* --------------------------------------------------------------------------
+ * private function evaluate_unary(op, operand)
+ * --------------------------------------------------------------------------
+ * Returns the value of applying unary operator op to operand.
+ * ----------------------------------------------------------------------- */
+
+static m2t_const_value_t evaluate_unary
+  (m2t_ast_nodetype_t op, m2t_const_value_t operand) {
+  
+  m2t_const_value_t result;
+  
+  if ((op == AST_NOT) && (operand.kind == M2T_CONST_BOOLEAN)) {
+    return boolean_value(NOT(operand.value.boolean));
+  } /* end if */
+  
+  if (op != AST_NEG) {
+    return unknown_value;
+  } /* end if */
+  
+  if ((operand.kind == M2T_CONST_WHOLE) &&
+      (operand.value.whole != INT64_MIN)) {
+    return whole_value(-operand.value.whole);
+  }
+  else if (operand.kind == M2T_CONST_REAL) {
+    result.kind = M2T_CONST_REAL;
+    result.value.real = -operand.value.real;
+    return result;
+  } /* end if */
+  
+  return unknown_value;
+} /* end evaluate_unary */
+
+
+/* --------------------------------------------------------------------------
+ * private function evaluate_binary(op, left, right)
+ * --------------------------------------------------------------------------
+ * Returns the value of applying binary operator op to left and right.
+ * Operands of different kinds are not folded.
+ * ----------------------------------------------------------------------- */
+
+static m2t_const_value_t evaluate_binary
+  (m2t_ast_nodetype_t op, m2t_const_value_t left, m2t_const_value_t right) {
+  
+  if ((left.kind == M2T_CONST_UNKNOWN) || (left.kind != right.kind)) {
+    return unknown_value;
+  } /* end if */
+  
+  switch (op) {
+    case AST_EQ :
+    case AST_NEQ :
+    case AST_LT :
+    case AST_LTEQ :
+    case AST_GT :
+    case AST_GTEQ :
+      return evaluate_compare(op, left, right);
+    
+    case AST_AND :
+      if (left.kind != M2T_CONST_BOOLEAN) {
+        return unknown_value;
+      } /* end if */
+      
+      return boolean_value(left.value.boolean && right.value.boolean);
+    
+    case AST_OR :
+      if (left.kind != M2T_CONST_BOOLEAN) {
+        return unknown_value;
+      } /* end if */
+      
+      return boolean_value(left.value.boolean || right.value.boolean);
+    
+    default :
+      break;
+  } /* end switch */
+  
+  if (left.kind == M2T_CONST_WHOLE) {
+    return evaluate_whole(op, left.value.whole, right.value.whole);
+  }
+  else if (left.kind == M2T_CONST_REAL) {
+    return evaluate_real(op, left.value.real, right.value.real);
+  } /* end if */
+  
+  return unknown_value;
+} /* end evaluate_binary */
+
+
+/* --------------------------------------------------------------------------
+ * private function evaluate_whole(op, left, right)
+ * --------------------------------------------------------------------------
+ * Returns the value of applying arithmetic operator op to whole numbers
+ * left and right.  The value is unknown if the operation overflows, if it
+ * divides by zero or if DIV or MOD are applied to negative operands.
+ * ----------------------------------------------------------------------- */
+
+static m2t_const_value_t evaluate_whole
+  (m2t_ast_nodetype_t op, int64_t left, int64_t right) {
+  
+  switch (op) {
+    case AST_PLUS :
+      if (((right > 0) && (left > INT64_MAX - right)) ||
+          ((right < 0) && (left < INT64_MIN - right))) {
+        return unknown_value;
+      } /* end if */
+      
+      return whole_value(left + right);
+    
+    case AST_MINUS :
+      if (((right < 0) && (left > INT64_MAX + right)) ||
+          ((right > 0) && (left < INT64_MIN + right))) {
+        return unknown_value;
+      } /* end if */
+      
+      return whole_value(left - right);
+    
+    case AST_ASTERISK :
+      if (product_overflows(left, right)) {
+        return unknown_value;
+      } /* end if */
+      
+      return whole_value(left * right);
+    
+    case AST_DIV :
+    case AST_MOD :
+      if ((left < 0) || (right <= 0)) {
+        return unknown_value;
+      } /* end if */
+      
+      return whole_value((op == AST_DIV) ? left / right : left % right);
+    
+    default :
+      return unknown_value;
+  } /* end switch */
+} /* end evaluate_whole */
+
+
+/* --------------------------------------------------------------------------
+ * private function evaluate_real(op, left, right)
+ * --------------------------------------------------------------------------
+ * Returns the value of applying arithmetic operator op to real numbers
+ * left and right.  The value is unknown if the operation divides by zero.
+ * ----------------------------------------------------------------------- */
+
+static m2t_const_value_t evaluate_real
+  (m2t_ast_nodetype_t op, double left, double right) {
+  
+  m2t_const_value_t result;
+  
+  result.kind = M2T_CONST_REAL;
+  
+  switch (op) {
+    case AST_PLUS :
+      result.value.real = left + right;
+      break;
+    
+    case AST_MINUS :
+      result.value.real = left - right;
+      break;
+    
+    case AST_ASTERISK :
+      result.value.real = left * right;
+      break;
+    
+    case AST_SOLIDUS :
+      if (right == 0.0) {
+        return unknown_value;
+      } /* end if */
+      
+      result.value.real = left / right;
+      break;
+    
+    default :
+      return unknown_value;
+  } /* end switch */
+  
+  return result;
+} /* end evaluate_real */
+
+
+/* --------------------------------------------------------------------------
+ * private function evaluate_compare(op, left, right)
+ * --------------------------------------------------------------------------
+ * Returns the Boolean value of applying relational operator op to left and
+ * right, which are of the same kind.  Boolean values are only compared for
+ * equality and inequality.
+ * ----------------------------------------------------------------------- */
+
+static m2t_const_value_t evaluate_compare
+  (m2t_ast_nodetype_t op, m2t_const_value_t left, m2t_const_value_t right) {
+  
+  int order;
+  
+  switch (left.kind) {
+    case M2T_CONST_WHOLE :
+    case M2T_CONST_CHAR :
+      order = (left.value.whole > right.value.whole) -
+        (left.value.whole < right.value.whole);
+      break;
+    
+    case M2T_CONST_REAL :
+      order = (left.value.real > right.value.real) -
+        (left.value.real < right.value.real);
+      break;
+    
+    case M2T_CONST_BOOLEAN :
+      if ((op != AST_EQ) && (op != AST_NEQ)) {
+        return unknown_value;
+      } /* end if */
+      
+      order = (left.value.boolean != right.value.boolean);
+      break;
+    
+    default :
+      return unknown_value;
+  } /* end switch */
+  
+  switch (op) {
+    case AST_EQ :
+      return boolean_value(order == 0);
+    
+    case AST_NEQ :
+      return boolean_value(order != 0);
+    
+    case AST_LT :
+      return boolean_value(order < 0);
+    
+    case AST_LTEQ :
+      return boolean_value(order <= 0);
+    
+    case AST_GT :
+      return boolean_value(order > 0);
+    
+    default : /* AST_GTEQ */
+      return boolean_value(order >= 0);
+  } /* end switch */
+} /* end evaluate_compare */
+
+
+/* --------------------------------------------------------------------------
+ * private function product_overflows(left, right)
+ * --------------------------------------------------------------------------
+ * Returns true if the product of left and right does not fit 64 bits.
+ * ----------------------------------------------------------------------- */
+
+static bool product_overflows (int64_t left, int64_t right) {
+  
+  if ((left == 0) || (right == 0)) {
+    return false;
+  } /* end if */
+  
+  if (left > 0) {
+    if (right > 0) {
+      return (left > INT64_MAX / right);
+    } /* end if */
+    
+    return (right < INT64_MIN / left);
+  } /* end if */
+  
+  if (right > 0) {
+    return (left < INT64_MIN / right);
+  } /* end if */
+  
+  return (right < INT64_MAX / left);
+} /* end product_overflows */
+
+
+/* --------------------------------------------------------------------------
+ * private function whole_value(value)
+ * --------------------------------------------------------------------------
+ * Returns a folded whole number value.
+ * ----------------------------------------------------------------------- */
+
+static m2t_const_value_t whole_value (int64_t value) {
+  
+  m2t_const_value_t result;
+  
+  result.kind = M2T_CONST_WHOLE;
+  result.value.whole = value;
+  
+  return result;
+} /* end whole_value */
+
+
+/* --------------------------------------------------------------------------
+ * private function boolean_value(value)
+ * --------------------------------------------------------------------------
+ * Returns a folded Boolean value.
+ * ----------------------------------------------------------------------- */
+
+static m2t_const_value_t boolean_value (bool value) {
+  
+  m2t_const_value_t result;
+  
+  result.kind = M2T_CONST_BOOLEAN;
+  result.value.boolean = value;
+  
+  return result;
+} /* end boolean_value */
+
+
+/* END OF FILE */
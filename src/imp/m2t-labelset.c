@@ -0,0 +1,359 @@
+/* M2T -- Sorce to Source Modula-2 Translator
+ *
+ * Copyright (c) 2016-2023 Benjamin Kowarsch
+ *
+ * Author & Maintainer: Benjamin Kowarsch <org.m2sf>
+ *
+ * @synopsis
+ *
+ * M2T is a multi-dialect Modula-2 source-to-source translator. It translates
+ * source files  written in the  classic dialects  to semantically equivalent
+ * source files in  Modula-2 Revision 2010 (M2R10).  It supports  the classic
+ * Modula-2 dialects  described in  the 2nd, 3rd and 4th editions  of Niklaus
+ * Wirth's book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * For more details please visit: https://github.com/trijezdci/m2t/wiki
+ *
+ * @repository
+ *
+ * https://github.com/trijezdci/m2t
+ *
+ * @file
+ *
+ * m2t-labelset.c
+ *
+ * Implementation of M2T case label sets.
+ *
+ * @license
+ *
+ * M2T is free software:  You can redistribute and modify it  under the terms
+ * of the  GNU Lesser General Public License (LGPL) either version 2.1  or at
+ * your choice version 3, both as published by the Free Software Foundation.
+ *
+ * M2T is distributed  in the hope  that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even  the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received  a copy of the  GNU Lesser General Public License
+ * along with M2T.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+
+#include "m2t-labelset.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+
+/* --------------------------------------------------------------------------
+ * Initial capacity of a label set
+ * ----------------------------------------------------------------------- */
+
+#define M2T_LABEL_SET_INIT_CAPACITY 64
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2t_label_set_s
+ * --------------------------------------------------------------------------
+ * record type representing a label set.  Labels are held in the order in
+ * which they were added until they are sorted.
+ * ----------------------------------------------------------------------- */
+
+struct m2t_label_set_s {
+  /* count */ uint_t count;
+  /* capacity */ uint_t capacity;
+  /* label */ m2t_label_interval_t *label;
+};
+
+typedef struct m2t_label_set_s m2t_label_set_s;
+
+
+/* --------------------------------------------------------------------------
+ * Forward declarations
+ * ----------------------------------------------------------------------- */
+
+static int compare_labels (const void *left, const void *right);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_new_label_set()
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated empty label set, or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2t_label_set_t m2t_new_label_set (void) {
+  
+  m2t_label_set_t new_set;
+  
+  new_set = malloc(sizeof(m2t_label_set_s));
+  
+  if (new_set == NULL) {
+    return NULL;
+  } /* end if */
+  
+  new_set->label =
+    malloc(M2T_LABEL_SET_INIT_CAPACITY * sizeof(m2t_label_interval_t));
+  
+  if (new_set->label == NULL) {
+    free(new_set);
+    return NULL;
+  } /* end if */
+  
+  new_set->count = 0;
+  new_set->capacity = M2T_LABEL_SET_INIT_CAPACITY;
+  
+  return new_set;
+} /* end m2t_new_label_set */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_label_set_mark(set)
+ * --------------------------------------------------------------------------
+ * Returns a mark for the labels presently in set, or zero if set is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2t_label_set_mark (m2t_label_set_t set) {
+  
+  if (set == NULL) {
+    return 0;
+  } /* end if */
+  
+  return set->count;
+} /* end m2t_label_set_mark */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_label_set_add(set, lower, upper, branch, offset)
+ * --------------------------------------------------------------------------
+ * Adds a label with bounds lower and upper that selects branch and occurs
+ * at source offset to set.  Returns true on success, or false if set is
+ * NULL, if lower is greater than upper or if set could not be grown.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_label_set_add
+  (m2t_label_set_t set,
+   int64_t lower, int64_t upper, uint_t branch, uint32_t offset) {
+  
+  m2t_label_interval_t *new_label;
+  uint_t new_capacity;
+  
+  if ((set == NULL) || (lower > upper)) {
+    return false;
+  } /* end if */
+  
+  /* grow set if full */
+  if (set->count == set->capacity) {
+    new_capacity = 2 * set->capacity;
+    new_label =
+      realloc(set->label, new_capacity * sizeof(m2t_label_interval_t));
+    
+    if (new_label == NULL) {
+      return false;
+    } /* end if */
+    
+    set->label = new_label;
+    set->capacity = new_capacity;
+  } /* end if */
+  
+  set->label[set->count].lower = lower;
+  set->label[set->count].upper = upper;
+  set->label[set->count].branch = branch;
+  set->label[set->count].offset = offset;
+  set->label[set->count].overlaps = false;
+  set->count++;
+  
+  return true;
+} /* end m2t_label_set_add */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_label_set_sort(set, mark)
+ * --------------------------------------------------------------------------
+ * Sorts the labels added to set since mark by their lower bounds.  Of any
+ * two labels found to share a value, the one that occurs later in the
+ * source is marked as overlapping.  Returns the number of labels marked,
+ * or zero if set is NULL.
+ * --------------------------------------------------------------------------
+ * Once sorted, a label overlaps a preceding label if and only if its lower
+ * bound does not exceed the greatest upper bound of the preceding labels.
+ * A single pass that tracks the label with the greatest upper bound thus
+ * finds every label involved in an overlap.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2t_label_set_sort (m2t_label_set_t set, uint_t mark) {
+  
+  m2t_label_interval_t *label, *reach, *later;
+  uint_t index, count, conflicts;
+  
+  if ((set == NULL) || (mark >= set->count)) {
+    return 0;
+  } /* end if */
+  
+  label = &set->label[mark];
+  count = set->count - mark;
+  
+  qsort(label, count, sizeof(m2t_label_interval_t), compare_labels);
+  
+  conflicts = 0;
+  reach = &label[0];
+  for (index = 1; index < count; index++) {
+    if (label[index].lower <= reach->upper) {
+      
+      /* mark whichever of the two occurs later in the source */
+      if (label[index].offset > reach->offset) {
+        later = &label[index];
+      }
+      else {
+        later = reach;
+      } /* end if */
+      
+      if (NOT(later->overlaps)) {
+        later->overlaps = true;
+        conflicts++;
+      } /* end if */
+    } /* end if */
+    
+    if (label[index].upper > reach->upper) {
+      reach = &label[index];
+    } /* end if */
+  } /* end for */
+  
+  return conflicts;
+} /* end m2t_label_set_sort */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_label_set_classify(set, mark)
+ * --------------------------------------------------------------------------
+ * Returns the classification of the labels added to set since mark.  The
+ * labels must have been sorted and must not overlap.
+ * ----------------------------------------------------------------------- */
+
+m2t_label_set_class_t m2t_label_set_classify
+  (m2t_label_set_t set, uint_t mark) {
+  
+  uint64_t span, covered;
+  uint_t index;
+  
+  if ((set == NULL) || (mark >= set->count)) {
+    return M2T_LABEL_SET_EMPTY;
+  } /* end if */
+  
+  span = (uint64_t) set->label[set->count - 1].upper -
+    (uint64_t) set->label[mark].lower;
+  
+  if (span >= M2T_LABEL_SET_MAX_TABLE_SIZE) {
+    return M2T_LABEL_SET_SPARSE;
+  } /* end if */
+  
+  span++;
+  covered = 0;
+  for (index = mark; index < set->count; index++) {
+    covered = covered +
+      (uint64_t) (set->label[index].upper - set->label[index].lower) + 1;
+  } /* end for */
+  
+  if ((covered * 100) >= (span * M2T_LABEL_SET_MIN_DENSITY_PERCENT)) {
+    return M2T_LABEL_SET_DENSE;
+  }
+  else {
+    return M2T_LABEL_SET_SPARSE;
+  } /* end if */
+} /* end m2t_label_set_classify */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_label_set_count(set)
+ * --------------------------------------------------------------------------
+ * Returns the number of labels in set, or zero if set is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2t_label_set_count (m2t_label_set_t set) {
+  
+  if (set == NULL) {
+    return 0;
+  } /* end if */
+  
+  return set->count;
+} /* end m2t_label_set_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_label_set_interval(set, index)
+ * --------------------------------------------------------------------------
+ * Returns a pointer to the label at index in set, or NULL if set is NULL or
+ * if index is out of range.  The pointer is valid until labels are added.
+ * ----------------------------------------------------------------------- */
+
+const m2t_label_interval_t *m2t_label_set_interval
+  (m2t_label_set_t set, uint_t index) {
+  
+  if ((set == NULL) || (index >= set->count)) {
+    return NULL;
+  } /* end if */
+  
+  return &set->label[index];
+} /* end m2t_label_set_interval */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_label_set_reset(set, mark)
+ * --------------------------------------------------------------------------
+ * Removes the labels added to set since mark.  Does nothing if set is NULL.
+ * ----------------------------------------------------------------------- */
+
+void m2t_label_set_reset (m2t_label_set_t set, uint_t mark) {
+  
+  if ((set == NULL) || (mark >= set->count)) {
+    return;
+  } /* end if */
+  
+  set->count = mark;
+} /* end m2t_label_set_reset */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_release_label_set(set)
+ * --------------------------------------------------------------------------
+ * Releases the label set passed in set and passes back NULL in set.
+ * ----------------------------------------------------------------------- */
+
+void m2t_release_label_set (m2t_label_set_t *set) {
+  
+  if ((set == NULL) || (*set == NULL)) {
+    return;
+  } /* end if */
+  
+  free((*set)->label);
+  free(*set);
+  *set = NULL;
+} /* end m2t_release_label_set */
+
+
+/* ************************************************************************ *
+ * Private Functions                                                        *
+ * ************************************************************************ */
+
+/* --------------------------------------------------------------------------
+ * private function compare_labels(left, right)
+ * --------------------------------------------------------------------------
+ * Compares two labels by lower bound and then by source offset for qsort.
+ * ----------------------------------------------------------------------- */
+
+static int compare_labels (const void *left, const void *right) {
+  
+  const m2t_label_interval_t *l = left, *r = right;
+  
+  if (l->lower != r->lower) {
+    return (l->lower < r->lower) ? -1 : 1;
+  } /* end if */
+  
+  if (l->offset != r->offset) {
+    return (l->offset < r->offset) ? -1 : 1;
+  } /* end if */
+  
+  return 0;
+} /* end compare_labels */
+
+
+/* END OF FILE */
@@ -41,7 +41,12 @@
 #include "m2t-lexer.h"
 #include "m2t-error.h"
 #include "m2t-filereader.h"
+#include "m2t-literals.h"
 #include "m2t-option-flags.h"
+#include "m2t-profiler.h"
+#include "m2t-fifo.h"
+#include "m2t-comments.h"
+#include "m2-thread.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -49,16 +54,29 @@
 #include <stdbool.h>
 
 
+/* --------------------------------------------------------------------------
+ * Lexer threads
+ * --------------------------------------------------------------------------
+ * Hosts without a supported thread API cannot lex on a separate thread, a
+ * request to start a pipeline is then ignored and symbols are lexed on
+ * demand.
+ * ----------------------------------------------------------------------- */
+
+#define M2T_LEXER_THREADS (M2C_THREADS_AVAILABLE)
+
+
 /* --------------------------------------------------------------------------
  * private type m2t_symbol_struct_t
  * --------------------------------------------------------------------------
- * record type holding symbol details.
+ * record type holding symbol details.  The position of a symbol is held as
+ * the byte offset of its first character.  Line and column are decoded from
+ * the offset through the line table of the input only when they are asked
+ * for, which is rare compared to the number of symbols lexed.
  * ----------------------------------------------------------------------- */
 
 typedef struct {
   /* token */ m2t_token_t token;
-  /* line */ uint_t line;
-  /* column */ uint_t column;
+  /* offset */ uint32_t offset;
   /* lexeme */ m2t_string_t lexeme;
 } m2t_symbol_struct_t;
 
@@ -69,12 +87,164 @@ typedef struct {
 
 static const m2t_symbol_struct_t null_symbol = {
   /* token */ TOKEN_UNKNOWN,
-  /* line */ 0,
-  /* column */ 0,
+  /* offset */ 0,
   /* lexeme */ NULL
 }; /* null_symbol */
 
 
+/* --------------------------------------------------------------------------
+ * Character classes
+ * --------------------------------------------------------------------------
+ * Bits of the character class table.  A character may belong to several
+ * classes.  The table is indexed by the unsigned value of a character,
+ * characters with codes of 128 and above belong to no class.
+ * ----------------------------------------------------------------------- */
+
+#define CC_IDENT_START (1 << 0)  /* letters */
+#define CC_IDENT_CHAR (1 << 1)   /* letters and digits */
+#define CC_UPPER (1 << 2)        /* uppercase letters */
+#define CC_DIGIT (1 << 3)        /* digits 0 to 9 */
+#define CC_OCTAL_DIGIT (1 << 4)  /* digits 0 to 7 */
+#define CC_HEX_DIGIT (1 << 5)    /* digits 0 to 9 and letters A to F */
+#define CC_WHITESPACE (1 << 6)   /* space and tab */
+#define CC_NEWLINE (1 << 7)      /* line feed */
+#define CC_OPERATOR (1 << 8)     /* first characters of punctuation */
+#define CC_QUOTE (1 << 9)        /* string delimiters */
+
+
+/* --------------------------------------------------------------------------
+ * Character class table
+ * ----------------------------------------------------------------------- */
+
+#define NC 0
+#define WS CC_WHITESPACE
+#define NL CC_NEWLINE
+#define OP CC_OPERATOR
+#define QT CC_QUOTE
+#define OD (CC_IDENT_CHAR | CC_DIGIT | CC_OCTAL_DIGIT | CC_HEX_DIGIT)
+#define DD (CC_IDENT_CHAR | CC_DIGIT | CC_HEX_DIGIT)
+#define UH (CC_IDENT_START | CC_IDENT_CHAR | CC_UPPER | CC_HEX_DIGIT)
+#define UL (CC_IDENT_START | CC_IDENT_CHAR | CC_UPPER)
+#define LL (CC_IDENT_START | CC_IDENT_CHAR)
+
+static const uint16_t char_class[256] = {
+  /* 00 */ NC, NC, NC, NC, NC, NC, NC, NC, NC, WS, NL, NC, NC, NC, NC, NC,
+  /* 10 */ NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC,
+  /* 20 */ WS, OP, QT, OP, NC, NC, OP, QT, OP, OP, OP, OP, OP, OP, OP, OP,
+  /* 30 */ OD, OD, OD, OD, OD, OD, OD, OD, DD, DD, OP, OP, OP, OP, OP, OP,
+  /* 40 */ NC, UH, UH, UH, UH, UH, UH, UL, UL, UL, UL, UL, UL, UL, UL, UL,
+  /* 50 */ UL, UL, UL, UL, UL, UL, UL, UL, UL, UL, UL, OP, NC, OP, OP, NC,
+  /* 60 */ NC, LL, LL, LL, LL, LL, LL, LL, LL, LL, LL, LL, LL, LL, LL, LL,
+  /* 70 */ LL, LL, LL, LL, LL, LL, LL, LL, LL, LL, LL, OP, OP, OP, OP, NC,
+  /* 80 */ NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC,
+  /* 90 */ NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC,
+  /* A0 */ NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC,
+  /* B0 */ NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC,
+  /* C0 */ NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC,
+  /* D0 */ NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC,
+  /* E0 */ NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC,
+  /* F0 */ NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC, NC
+}; /* char_class */
+
+#undef NC
+#undef WS
+#undef NL
+#undef OP
+#undef QT
+#undef OD
+#undef DD
+#undef UH
+#undef UL
+#undef LL
+
+
+/* --------------------------------------------------------------------------
+ * Character class test
+ * ----------------------------------------------------------------------- */
+
+#define CHAR_CLASS(_ch) \
+  (char_class[(unsigned char) (_ch)])
+
+#define CHAR_IN_CLASS(_ch,_class) \
+  ((CHAR_CLASS(_ch) & (_class)) != 0)
+
+
+/* --------------------------------------------------------------------------
+ * Initial capacity of token stream
+ * ----------------------------------------------------------------------- */
+
+#define M2T_TOKEN_STREAM_INITIAL_SIZE 1024
+
+
+/* --------------------------------------------------------------------------
+ * private type m2t_token_stream_t
+ * --------------------------------------------------------------------------
+ * record type holding a pre-tokenized symbol stream in structure-of-arrays
+ * layout.  Entry 0 holds the symbol that was current when the stream was
+ * built.  The stream owns the lexemes of its entries.  If the stream could
+ * not be grown while it was built, the symbol that did not fit is held in
+ * field pending and the remainder of the input is lexed on demand.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* count */ uint_t count;
+  /* size */ uint_t size;
+  /* token */ m2t_token_t *token;
+  /* offset */ uint32_t *offset;
+  /* lexeme */ m2t_string_t *lexeme;
+  /* has_pending */ bool has_pending;
+  /* pending */ m2t_symbol_struct_t pending;
+} m2t_token_stream_t;
+
+
+/* --------------------------------------------------------------------------
+ * Symbols per pipeline block and number of blocks per pipeline
+ * ----------------------------------------------------------------------- */
+
+#define M2T_PIPELINE_BLOCK_SIZE 512
+
+#define M2T_PIPELINE_BLOCK_COUNT 8
+
+
+/* --------------------------------------------------------------------------
+ * private type m2t_symbol_block_t
+ * --------------------------------------------------------------------------
+ * record type holding a block of symbols passed from the lexer thread of a
+ * pipeline to the parser.  The block owns the lexemes of its symbols until
+ * they are taken by the parser.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* count */ uint_t count;
+  /* symbol */ m2t_symbol_struct_t symbol[M2T_PIPELINE_BLOCK_SIZE];
+} m2t_symbol_block_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type m2t_lexer_pipeline_t
+ * --------------------------------------------------------------------------
+ * record type holding the state of a pipelined lexer.  The lexer thread
+ * lexes into a scanner of its own, fills blocks and passes them to the
+ * parser through queue full.  The parser passes drained blocks back
+ * through queue empty for reuse.  Both queues are single-producer/single-
+ * consumer queues and need no lock.  The lock is held by the lexer thread
+ * while it fills a block and by the parser while it accesses the shared
+ * input, it also protects field stop.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* scanner */ m2t_lexer_t scanner;
+  /* full */ m2t_fifo_spsc_t full;
+  /* empty */ m2t_fifo_spsc_t empty;
+  /* block */ m2t_symbol_block_t *block;
+  /* index */ uint_t index;
+  /* block_count */ uint_t block_count;
+  /* stop */ bool stop;
+  /* lock */ m2c_lock_t lock;
+  /* thread */ m2c_thread_t thread;
+} m2t_lexer_pipeline_t;
+
+
 /* --------------------------------------------------------------------------
  * private type m2t_number_literal_lexer_f
  * --------------------------------------------------------------------------
@@ -85,6 +255,25 @@ typedef char (*m2t_number_literal_lexer_f)
   (m2t_lexer_t lexer, m2t_token_t *token);
 
 
+/* --------------------------------------------------------------------------
+ * private type m2t_ident_lexer_f
+ * --------------------------------------------------------------------------
+ * function pointer type for function to lex an identifier.
+ * ----------------------------------------------------------------------- */
+
+typedef char (*m2t_ident_lexer_f) (m2t_lexer_t lexer);
+
+
+/* --------------------------------------------------------------------------
+ * private type m2t_symbol_lexer_f
+ * --------------------------------------------------------------------------
+ * function pointer type for function to lex an identifier, reserved word
+ * or string literal and pass back its token.
+ * ----------------------------------------------------------------------- */
+
+typedef char (*m2t_symbol_lexer_f) (m2t_lexer_t lexer, m2t_token_t *token);
+
+
 /* --------------------------------------------------------------------------
  * hidden type m2t_lexer_struct_t
  * --------------------------------------------------------------------------
@@ -93,11 +282,27 @@ typedef char (*m2t_number_literal_lexer_f)
 
 struct m2t_lexer_struct_t {
   /* infile */ m2t_infile_t infile;
+  /* validated */ bool validated;
   /* current */ m2t_symbol_struct_t current;
   /* lookahead */ m2t_symbol_struct_t lookahead;
   /* status */ m2t_lexer_status_t status;
   /* error_count */ uint_t error_count;
+  /* token_count */ uint_t token_count;
+  /* base_offset */ uint32_t base_offset;
+  /* base_line */ uint_t base_line;
+  /* base_column */ uint_t base_column;
+  /* options */ m2t_option_set_t options;
   /* get_number_literal */ m2t_number_literal_lexer_f get_number_literal;
+  /* get_ident */ m2t_ident_lexer_f get_ident;
+  /* get_ident_or_resword */ m2t_symbol_lexer_f get_ident_or_resword;
+  /* get_string_literal */ m2t_symbol_lexer_f get_string_literal;
+  /* stream */ m2t_token_stream_t *stream;
+  /* stream_pos */ uint_t stream_pos;
+  /* pipeline */ m2t_lexer_pipeline_t *pipeline;
+  /* skip_set */ const m2t_tokenset_t *skip_set;
+  /* current_shared */ bool current_shared;
+  /* lookahead_shared */ bool lookahead_shared;
+  /* comments */ m2t_comment_table_t comments;
 };
 
 typedef struct m2t_lexer_struct_t m2t_lexer_struct_t;
@@ -107,22 +312,79 @@ typedef struct m2t_lexer_struct_t m2t_lexer_struct_t;
  * Forward declarations
  * ----------------------------------------------------------------------- */
 
+static void init_lexer
+  (m2t_lexer_t lexer, m2t_infile_t infile, m2t_option_set_t options,
+   m2t_comment_table_t comments);
+
+static void init_base_position
+  (m2t_lexer_t lexer, const char *buffer, size_t start);
+
+static uint_t infile_line (m2t_lexer_t lexer);
+
+static uint_t infile_column (m2t_lexer_t lexer);
+
 static void get_new_lookahead_sym (m2t_lexer_t lexer);
 
+static char get_operator
+  (m2t_lexer_t lexer, uint32_t offset, m2t_token_t *token);
+
+static void report_error_w_char_at_offset
+  (m2t_error_t error,
+   m2t_lexer_t lexer, uint32_t offset, char offending_char);
+
+static void position_for_offset
+  (m2t_lexer_t lexer, uint32_t offset, uint_t *line, uint_t *column);
+
+static void next_lookahead_sym (m2t_lexer_t lexer);
+
+static bool append_to_stream
+  (m2t_token_stream_t *stream, m2t_symbol_struct_t *symbol);
+
+static void release_stream (m2t_token_stream_t *stream);
+
+static void next_piped_sym (m2t_lexer_t lexer);
+
+static void pipeline_loop (m2t_lexer_pipeline_t *pipeline);
+
+static m2t_symbol_block_t *obtain_block (m2t_lexer_pipeline_t *pipeline);
+
+static void release_pipeline (m2t_lexer_pipeline_t *pipeline);
+
+static void release_block (m2t_symbol_block_t *block, uint_t index);
+
+#if (M2T_LEXER_THREADS)
+static void pipeline_main (void *arg);
+#endif
+
+static char consume_char_run
+  (m2t_lexer_t lexer, m2t_infile_run_t run, char delimiter);
+
 static char skip_code_section (m2t_lexer_t lexer);
 
 static char skip_line_comment (m2t_lexer_t lexer);
 
 static char skip_block_comment (m2t_lexer_t lexer);
 
+static void record_comment (m2t_lexer_t lexer, uint32_t offset);
+
+static void get_lexeme (m2t_lexer_t lexer, m2t_token_t token);
+
 static char get_pragma(m2t_lexer_t lexer);
 
 static char get_ident (m2t_lexer_t lexer);
 
+static char get_ident_w_lowline (m2t_lexer_t lexer);
+
 static char get_ident_or_resword (m2t_lexer_t lexer, m2t_token_t *token);
 
+static char get_ident_or_resword_w_lowline
+  (m2t_lexer_t lexer, m2t_token_t *token);
+
 static char get_string_literal (m2t_lexer_t lexer, m2t_token_t *token);
 
+static char get_string_literal_w_escapes
+  (m2t_lexer_t lexer, m2t_token_t *token);
+
 static char get_prefixed_number_literal
   (m2t_lexer_t lexer, m2t_token_t *token);
 
@@ -132,6 +394,9 @@ static char get_suffixed_number_literal
 static char get_number_literal_fractional_part
   (m2t_lexer_t lexer, m2t_token_t *token);
 
+static void enter_literal
+  (m2t_lexer_t lexer, m2t_token_t token, const m2t_literal_t *literal);
+
 
 /* --------------------------------------------------------------------------
  * procedure m2t_new_lexer(lexer, filename, status)
@@ -160,6 +425,27 @@ static char get_number_literal_fractional_part
 
 void m2t_new_lexer
   (m2t_lexer_t *lexer, m2t_string_t filename, m2t_lexer_status_t *status) {
+  
+  /* recognise the dialect selected on the command line */
+  m2t_new_lexer_w_options(lexer, filename, m2t_option_dialect(), status);
+  return;
+} /* end m2t_new_lexer */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_new_lexer_w_options(lexer, filename, options, status)
+ * --------------------------------------------------------------------------
+ * Allocates a new object of type m2t_lexer_t like m2t_new_lexer() but the
+ * newly created lexer object recognises the dialect given by option set
+ * options instead of the dialect selected on the command line.
+ * ----------------------------------------------------------------------- */
+
+void m2t_new_lexer_w_options
+  (m2t_lexer_t *lexer,
+   m2t_string_t filename,
+   m2t_option_set_t options,
+   m2t_lexer_status_t *status) {
+  
    
    m2t_infile_t infile;
    m2t_lexer_t new_lexer;
@@ -187,27 +473,210 @@ void m2t_new_lexer
      return;
    } /* end if */
    
-   /* initialise lexer object */
-   new_lexer->infile = infile;
-   new_lexer->current = null_symbol;
-   new_lexer->lookahead = null_symbol;
-   new_lexer->error_count = 0;
+   /* initialise lexer object and read first symbol */
+   init_base_position(new_lexer, NULL, 0);
+   init_lexer(new_lexer, infile, options, NULL);
+   
+   *lexer = new_lexer;
+   SET_STATUS(status, M2T_LEXER_STATUS_SUCCESS);
+   return;
+} /* end m2t_new_lexer_w_options */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_new_lexer_from_buffer(lexer, name, buffer, length, status)
+ * --------------------------------------------------------------------------
+ * Allocates a new object of type m2t_lexer_t and associates the caller owned
+ * source text in buffer with the newly created lexer object.  The buffer is
+ * NOT copied.  It must remain valid and unmodified until the lexer has been
+ * released.  Parameter name is reported in place of a filename.
+ *
+ * pre-conditions:
+ * o  parameter lexer must not be NULL upon entry
+ * o  parameters name and buffer must not be NULL upon entry
+ * o  parameter status may be NULL
+ *
+ * post-conditions:
+ * o  pointer to newly allocated lexer is passed back in lexer
+ * o  M2T_LEXER_STATUS_SUCCESS is passed back in status, unless NULL
+ *
+ * error-conditions:
+ * o  if lexer, name or buffer is NULL upon entry, no operation is carried
+ *    out and status M2T_LEXER_STATUS_INVALID_REFERENCE is returned
+ * o  if buffer is empty or no lexer object could be allocated
+ *    status M2T_LEXER_STATUS_ALLOCATION_FAILED is returned
+ * ----------------------------------------------------------------------- */
+
+void m2t_new_lexer_from_buffer
+  (m2t_lexer_t *lexer,
+   m2t_string_t name,
+   const char *buffer,
+   size_t length,
+   m2t_lexer_status_t *status) {
+   
+   m2t_infile_t infile;
+   m2t_lexer_t new_lexer;
+   m2t_infile_status_t infile_status;
+   
+   /* check pre-conditions */
+   if ((lexer == NULL) || (name == NULL) || (buffer == NULL)) {
+     SET_STATUS(status, M2T_LEXER_STATUS_INVALID_REFERENCE);
+     return;
+   } /* end if */
+   
+   new_lexer = malloc(sizeof(m2t_lexer_struct_t));
+   
+   if (new_lexer == NULL) {
+     SET_STATUS(status, M2T_LEXER_STATUS_ALLOCATION_FAILED);
+     return;
+   } /* end if */
+   
+   /* borrow source buffer */
+   infile = m2t_open_infile_from_buffer(name, buffer, length, &infile_status);
+   
+   if (infile == NULL) {
+     SET_STATUS(status, M2T_LEXER_STATUS_ALLOCATION_FAILED);
+     free(new_lexer);
+     return;
+   } /* end if */
+   
+   /* initialise lexer object and read first symbol */
+   init_base_position(new_lexer, NULL, 0);
+   init_lexer(new_lexer, infile, m2t_option_dialect(), NULL);
+   
+   *lexer = new_lexer;
+   SET_STATUS(status, M2T_LEXER_STATUS_SUCCESS);
+   return;
+} /* end m2t_new_lexer_from_buffer */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_new_lexer_for_range(lexer, name, buffer, start, end, status)
+ * --------------------------------------------------------------------------
+ * Allocates a new object of type m2t_lexer_t like m2t_new_lexer_from_buffer()
+ * but associates only the range of buffer from byte offset start up to but
+ * not including byte offset end with the newly created lexer object.  The
+ * end of the range is reported as the end of the input.  Offsets, lines and
+ * columns of symbols and diagnostics are relative to the start of buffer,
+ * not to the start of the range.
+ *
+ * error-conditions:
+ * o  if lexer, name or buffer is NULL upon entry, no operation is carried
+ *    out and status M2T_LEXER_STATUS_INVALID_REFERENCE is returned
+ * o  if the range is empty or no lexer object could be allocated
+ *    status M2T_LEXER_STATUS_ALLOCATION_FAILED is returned
+ * ----------------------------------------------------------------------- */
+
+void m2t_new_lexer_for_range
+  (m2t_lexer_t *lexer,
+   m2t_string_t name,
+   const char *buffer,
+   size_t start,
+   size_t end,
+   m2t_lexer_status_t *status) {
+   
+   m2t_infile_t infile;
+   m2t_lexer_t new_lexer;
+   m2t_infile_status_t infile_status;
+   
+   /* check pre-conditions */
+   if ((lexer == NULL) || (name == NULL) || (buffer == NULL)) {
+     SET_STATUS(status, M2T_LEXER_STATUS_INVALID_REFERENCE);
+     return;
+   } /* end if */
+   
+   if (start >= end) {
+     SET_STATUS(status, M2T_LEXER_STATUS_ALLOCATION_FAILED);
+     return;
+   } /* end if */
+   
+   new_lexer = malloc(sizeof(m2t_lexer_struct_t));
+   
+   if (new_lexer == NULL) {
+     SET_STATUS(status, M2T_LEXER_STATUS_ALLOCATION_FAILED);
+     return;
+   } /* end if */
+   
+   /* borrow the range of the source buffer */
+   infile = m2t_open_infile_from_buffer
+     (name, buffer + start, end - start, &infile_status);
    
-   if (m2t_option_prefix_literals()) {
-     /* install function to lex prefix number literals */
-     new_lexer->get_number_literal = get_prefixed_number_literal;
-   }
-   else /* suffix literals */ {
-     /* install function to lex suffix number literals */
-     new_lexer->get_number_literal = get_suffixed_number_literal;
+   if (infile == NULL) {
+     SET_STATUS(status, M2T_LEXER_STATUS_ALLOCATION_FAILED);
+     free(new_lexer);
+     return;
    } /* end if */
    
-   /* read first symbol */
-   get_new_lookahead_sym(new_lexer);
+   /* initialise lexer object and read first symbol */
+   init_base_position(new_lexer, buffer, start);
+   init_lexer(new_lexer, infile, m2t_option_dialect(), NULL);
    
    *lexer = new_lexer;
+   SET_STATUS(status, M2T_LEXER_STATUS_SUCCESS);
    return;
-} /* end m2t_new_lexer */
+} /* end m2t_new_lexer_for_range */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_new_lexer_w_comments(lexer, name, buffer, length, ...)
+ * --------------------------------------------------------------------------
+ * Allocates a new object of type m2t_lexer_t like m2t_new_lexer_from_buffer()
+ * but the newly created lexer object records the offset and length of each
+ * comment it skips in comment table comments, and the offset of the symbol
+ * that follows.  Comments are recorded from the start of buffer, including
+ * those that precede the first symbol.  The comment table is NOT owned by
+ * the lexer.  It must remain valid until the lexer has been released.
+ *
+ * error-conditions:
+ * o  if lexer, name, buffer or comments is NULL upon entry, no operation is
+ *    carried out and status M2T_LEXER_STATUS_INVALID_REFERENCE is returned
+ * o  if buffer is empty or no lexer object could be allocated
+ *    status M2T_LEXER_STATUS_ALLOCATION_FAILED is returned
+ * ----------------------------------------------------------------------- */
+
+void m2t_new_lexer_w_comments
+  (m2t_lexer_t *lexer,
+   m2t_string_t name,
+   const char *buffer,
+   size_t length,
+   m2t_comment_table_t comments,
+   m2t_lexer_status_t *status) {
+   
+   m2t_infile_t infile;
+   m2t_lexer_t new_lexer;
+   m2t_infile_status_t infile_status;
+   
+   /* check pre-conditions */
+   if ((lexer == NULL) || (name == NULL) ||
+       (buffer == NULL) || (comments == NULL)) {
+     SET_STATUS(status, M2T_LEXER_STATUS_INVALID_REFERENCE);
+     return;
+   } /* end if */
+   
+   new_lexer = malloc(sizeof(m2t_lexer_struct_t));
+   
+   if (new_lexer == NULL) {
+     SET_STATUS(status, M2T_LEXER_STATUS_ALLOCATION_FAILED);
+     return;
+   } /* end if */
+   
+   /* borrow source buffer */
+   infile = m2t_open_infile_from_buffer(name, buffer, length, &infile_status);
+   
+   if (infile == NULL) {
+     SET_STATUS(status, M2T_LEXER_STATUS_ALLOCATION_FAILED);
+     free(new_lexer);
+     return;
+   } /* end if */
+   
+   /* initialise lexer object and read first symbol */
+   init_base_position(new_lexer, NULL, 0);
+   init_lexer(new_lexer, infile, m2t_option_dialect(), comments);
+   
+   *lexer = new_lexer;
+   SET_STATUS(status, M2T_LEXER_STATUS_SUCCESS);
+   return;
+} /* end m2t_new_lexer_w_comments */
 
 
 /* --------------------------------------------------------------------------
@@ -232,14 +701,23 @@ void m2t_new_lexer
 
 m2t_token_t m2t_read_sym (m2t_lexer_t lexer) {
   
-  /* release the lexeme of the current symbol */
-  m2t_string_release(lexer->current.lexeme);
+  /* release the lexeme of the current symbol unless owned by stream */
+  if (lexer->current_shared == false) {
+    m2t_string_release(lexer->current.lexeme);
+  } /* end if */
+  
+  /* count consumed token, by token value if requested */
+  lexer->token_count++;
+  if (m2t_option_profile()) {
+    m2t_profiler_count_token(lexer->lookahead.token);
+  } /* end if */
   
   /* lookahead symbol becomes current symbol */
   lexer->current = lexer->lookahead;
+  lexer->current_shared = lexer->lookahead_shared;
   
   /* read new lookahead symbol */
-  get_new_lookahead_sym(lexer);
+  next_lookahead_sym(lexer);
   
   /* return current token */
   return lexer->current.token;
@@ -268,19 +746,72 @@ inline m2t_token_t m2t_next_sym (m2t_lexer_t lexer) {
 
 m2t_token_t m2t_consume_sym (m2t_lexer_t lexer) {
   
-  /* release the lexeme of the current symbol */
-  m2t_string_release(lexer->current.lexeme);
+  /* release the lexeme of the current symbol unless owned by stream */
+  if (lexer->current_shared == false) {
+    m2t_string_release(lexer->current.lexeme);
+  } /* end if */
+  
+  /* count consumed token, by token value if requested */
+  lexer->token_count++;
+  if (m2t_option_profile()) {
+    m2t_profiler_count_token(lexer->lookahead.token);
+  } /* end if */
   
   /* lookahead symbol becomes current symbol */
   lexer->current = lexer->lookahead;
+  lexer->current_shared = lexer->lookahead_shared;
   
   /* read new lookahead symbol and return it */
-  get_new_lookahead_sym(lexer);
+  next_lookahead_sym(lexer);
   return lexer->lookahead.token;
   
 } /* end m2t_consume_sym */
 
 
+/* --------------------------------------------------------------------------
+ * function m2t_lexer_skip_to_set(lexer, resync_set)
+ * --------------------------------------------------------------------------
+ * Consumes symbols until the lookahead symbol is an element of resync_set
+ * or the end of the input has been reached and returns the new lookahead
+ * symbol.  Skipped symbols are lexed without creating lexemes.
+ * ----------------------------------------------------------------------- */
+
+m2t_token_t m2t_lexer_skip_to_set
+  (m2t_lexer_t lexer, m2t_tokenset_t resync_set) {
+  
+  /* symbols of a stream or pipeline have already been lexed */
+  if ((lexer->stream != NULL) || (lexer->pipeline != NULL)) {
+    while ((lexer->lookahead.token != TOKEN_END_OF_FILE) &&
+           (!m2t_tokenset_element(resync_set, lexer->lookahead.token))) {
+      m2t_consume_sym(lexer);
+    } /* end while */
+    return lexer->lookahead.token;
+  } /* end if */
+  
+  /* lexemes are only created for symbols in resync_set */
+  lexer->skip_set = &resync_set;
+  
+  while ((lexer->lookahead.token != TOKEN_END_OF_FILE) &&
+         (!m2t_tokenset_element(resync_set, lexer->lookahead.token))) {
+    
+    m2t_string_release(lexer->current.lexeme);
+    
+    /* count skipped token, by token value if requested */
+    lexer->token_count++;
+    if (m2t_option_profile()) {
+      m2t_profiler_count_token(lexer->lookahead.token);
+    } /* end if */
+    
+    lexer->current = lexer->lookahead;
+    get_new_lookahead_sym(lexer);
+  } /* end while */
+  
+  lexer->skip_set = NULL;
+  
+  return lexer->lookahead.token;
+} /* end m2t_lexer_skip_to_set */
+
+
 /* --------------------------------------------------------------------------
  * function m2t_lexer_filename(lexer)
  * --------------------------------------------------------------------------
@@ -295,27 +826,81 @@ m2t_string_t m2t_lexer_filename (m2t_lexer_t lexer) {
 
 
 /* --------------------------------------------------------------------------
- * function m2t_lexer_status(lexer)
+ * function m2t_lexer_options(lexer)
  * --------------------------------------------------------------------------
- * Returns the status of the last operation on lexer.
+ * Returns the dialect option set captured by lexer when it was created.
  * ----------------------------------------------------------------------- */
 
-m2t_lexer_status_t m2t_lexer_status (m2t_lexer_t lexer) {
+m2t_option_set_t m2t_lexer_options (m2t_lexer_t lexer) {
   
-  return lexer->status;
+  return lexer->options;
   
-} /* end m2t_lexer_status */
+} /* end m2t_lexer_options */
 
 
 /* --------------------------------------------------------------------------
- * function m2t_lexer_lookahead_lexeme(lexer)
+ * function m2t_lexer_comment_table(lexer)
  * --------------------------------------------------------------------------
- * Returns the lexeme of the lookahead symbol.
+ * Returns the comment table in which lexer records comments, or NULL if
+ * lexer does not record comments.
  * ----------------------------------------------------------------------- */
 
-m2t_string_t m2t_lexer_lookahead_lexeme (m2t_lexer_t lexer) {
+m2t_comment_table_t m2t_lexer_comment_table (m2t_lexer_t lexer) {
   
-  m2t_string_retain(lexer->lookahead.lexeme);
+  return lexer->comments;
+  
+} /* end m2t_lexer_comment_table */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_lexer_token_count(lexer)
+ * --------------------------------------------------------------------------
+ * Returns the number of symbols consumed from lexer so far, including
+ * symbols skipped by m2t_lexer_skip_to_set().
+ * ----------------------------------------------------------------------- */
+
+uint_t m2t_lexer_token_count (m2t_lexer_t lexer) {
+  
+  return lexer->token_count;
+  
+} /* end m2t_lexer_token_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_lexer_error_count(lexer)
+ * --------------------------------------------------------------------------
+ * Returns the number of lexical errors reported by lexer so far.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2t_lexer_error_count (m2t_lexer_t lexer) {
+  
+  return lexer->error_count;
+  
+} /* end m2t_lexer_error_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_lexer_status(lexer)
+ * --------------------------------------------------------------------------
+ * Returns the status of the last operation on lexer.
+ * ----------------------------------------------------------------------- */
+
+m2t_lexer_status_t m2t_lexer_status (m2t_lexer_t lexer) {
+  
+  return lexer->status;
+  
+} /* end m2t_lexer_status */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_lexer_lookahead_lexeme(lexer)
+ * --------------------------------------------------------------------------
+ * Returns the lexeme of the lookahead symbol.
+ * ----------------------------------------------------------------------- */
+
+m2t_string_t m2t_lexer_lookahead_lexeme (m2t_lexer_t lexer) {
+  
+  m2t_string_retain(lexer->lookahead.lexeme);
   
   return lexer->lookahead.lexeme;
   
@@ -337,55 +922,122 @@ m2t_string_t m2t_lexer_current_lexeme (m2t_lexer_t lexer) {
 } /* end m2t_lexer_current_lexeme */
 
 
+/* --------------------------------------------------------------------------
+ * function m2t_lexer_lookahead_offset(lexer)
+ * --------------------------------------------------------------------------
+ * Returns the byte offset of the lookahead symbol.
+ * ----------------------------------------------------------------------- */
+
+uint32_t m2t_lexer_lookahead_offset (m2t_lexer_t lexer) {
+  
+  return lexer->base_offset + lexer->lookahead.offset;
+  
+} /* end m2t_lexer_lookahead_offset */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_lexer_current_offset(lexer)
+ * --------------------------------------------------------------------------
+ * Returns the byte offset of the most recently consumed symbol.
+ * ----------------------------------------------------------------------- */
+
+uint32_t m2t_lexer_current_offset (m2t_lexer_t lexer) {
+  
+  return lexer->base_offset + lexer->current.offset;
+  
+} /* end m2t_lexer_current_offset */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_lexer_position_for_offset(lexer, offset, line, column)
+ * --------------------------------------------------------------------------
+ * Decodes byte offset of the input associated with lexer to line and column
+ * and passes them back in line and column.  Passes back zero in both if
+ * offset lies beyond the end of the input.  Symbols only record their byte
+ * offsets, a client that stores positions should store offsets and decode
+ * them when a diagnostic or writer needs line and column.
+ * ----------------------------------------------------------------------- */
+
+void m2t_lexer_position_for_offset
+  (m2t_lexer_t lexer, uint32_t offset, uint_t *line, uint_t *column) {
+  
+  /* offsets before the range of a range lexer cannot be decoded */
+  if (offset < lexer->base_offset) {
+    *line = 0;
+    *column = 0;
+    return;
+  } /* end if */
+  
+  position_for_offset(lexer, offset - lexer->base_offset, line, column);
+  
+} /* end m2t_lexer_position_for_offset */
+
+
 /* --------------------------------------------------------------------------
  * function m2t_lexer_lookahead_line(lexer)
  * --------------------------------------------------------------------------
- * Returns the line counter of the lookahead symbol.
+ * Returns the line counter of the lookahead symbol,
+ * decoded from its byte offset.
  * ----------------------------------------------------------------------- */
 
 uint_t m2t_lexer_lookahead_line (m2t_lexer_t lexer) {
   
-  return lexer->lookahead.line;
+  uint_t line, column;
+  
+  position_for_offset(lexer, lexer->lookahead.offset, &line, &column);
   
+  return line;
 } /* end m2t_lexer_lookahead_line */
 
 
 /* --------------------------------------------------------------------------
  * function m2t_lexer_current_line(lexer)
  * --------------------------------------------------------------------------
- * Returns the line counter of the most recently consumed symbol.
+ * Returns the line counter of the most recently consumed symbol,
+ * decoded from its byte offset.
  * ----------------------------------------------------------------------- */
 
 uint_t m2t_lexer_current_line (m2t_lexer_t lexer) {
   
-  return lexer->current.line;
+  uint_t line, column;
+  
+  position_for_offset(lexer, lexer->current.offset, &line, &column);
   
+  return line;
 } /* end m2t_lexer_current_line */
 
 
 /* --------------------------------------------------------------------------
  * function m2t_lexer_lookahead_column(lexer)
  * --------------------------------------------------------------------------
- * Returns the column counter of the lookahead symbol.
+ * Returns the column counter of the lookahead symbol,
+ * decoded from its byte offset.
  * ----------------------------------------------------------------------- */
 
 uint_t m2t_lexer_lookahead_column (m2t_lexer_t lexer) {
   
-  return lexer->lookahead.column;
+  uint_t line, column;
+  
+  position_for_offset(lexer, lexer->lookahead.offset, &line, &column);
   
+  return column;
 } /* end m2t_lexer_lookahead_column */
 
 
 /* --------------------------------------------------------------------------
  * function m2t_lexer_current_column(lexer)
  * --------------------------------------------------------------------------
- * Returns the column counter of the most recently consumed symbol.
+ * Returns the column counter of the most recently consumed symbol,
+ * decoded from its byte offset.
  * ----------------------------------------------------------------------- */
 
 uint_t m2t_lexer_current_column (m2t_lexer_t lexer) {
   
-  return lexer->current.column;
+  uint_t line, column;
+  
+  position_for_offset(lexer, lexer->current.offset, &line, &column);
   
+  return column;
 } /* end m2t_lexer_current_column */
 
 
@@ -402,7 +1054,30 @@ void m2t_print_line_and_mark_column
   m2t_string_t source;
   uint_t n;
   
-  source = m2t_infile_source_for_line (lexer->infile, line);
+  /* the source line must follow the buffered diagnostic it belongs to */
+  m2t_flush_diagnostics();
+  
+  /* lines of a range lexer are counted from the start of its buffer */
+  if (line <= lexer->base_line) {
+    return;
+  } /* end if */
+  
+  line = line - lexer->base_line;
+  
+  if (line == 1) {
+    column = column - lexer->base_column;
+  } /* end if */
+  
+  /* the input is shared with the lexer thread of a pipeline */
+  if (lexer->pipeline != NULL) {
+    M2C_LOCK_ACQUIRE(&lexer->pipeline->lock);
+    source = m2t_infile_source_for_line (lexer->infile, line);
+    M2C_LOCK_RELEASE(&lexer->pipeline->lock);
+  }
+  else {
+    source = m2t_infile_source_for_line (lexer->infile, line);
+  } /* end if */
+  
   printf("\n%s\n", m2t_string_char_ptr(source));
   
   n = 1;
@@ -418,6 +1093,319 @@ void m2t_print_line_and_mark_column
 } /* end m2t_print_line_and_mark_column */
 
 
+/* --------------------------------------------------------------------------
+ * procedure m2t_lexer_pretokenize(lexer, status)
+ * --------------------------------------------------------------------------
+ * Tokenizes the remainder of the input associated with lexer in one pass
+ * and stores the symbols in a contiguous token stream.  Thereafter, symbols
+ * are served from the stream, which permits arbitrary lookahead by function
+ * m2t_lexer_peek_sym() and backtracking by procedure m2t_lexer_rewind().
+ *
+ * pre-conditions:
+ * o  parameter lexer must not be NULL upon entry
+ * o  lexer must not have been pre-tokenized before
+ * o  parameter status may be NULL
+ *
+ * post-conditions:
+ * o  all remaining symbols are stored in the token stream of lexer
+ * o  M2T_LEXER_STATUS_SUCCESS is passed back in status, unless NULL
+ *
+ * error-conditions:
+ * o  if lexer is NULL or has already been pre-tokenized upon entry, no
+ *    operation is carried out and M2T_LEXER_STATUS_INVALID_REFERENCE is
+ *    passed back in status, unless NULL
+ * o  if the stream cannot be allocated, no operation is carried out and
+ *    M2T_LEXER_STATUS_ALLOCATION_FAILED is passed back in status
+ * o  if the stream cannot be grown, the symbols that did not fit are lexed
+ *    on demand and M2T_LEXER_STATUS_ALLOCATION_FAILED is passed back
+ * ----------------------------------------------------------------------- */
+
+void m2t_lexer_pretokenize (m2t_lexer_t lexer, m2t_lexer_status_t *status) {
+  
+  m2t_token_stream_t *stream;
+  
+  /* check pre-conditions */
+  if ((lexer == NULL) || (lexer->stream != NULL) ||
+      (lexer->pipeline != NULL)) {
+    SET_STATUS(status, M2T_LEXER_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  /* allocate stream */
+  stream = malloc(sizeof(m2t_token_stream_t));
+  
+  if (stream == NULL) {
+    SET_STATUS(status, M2T_LEXER_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  stream->count = 0;
+  stream->size = 0;
+  stream->token = NULL;
+  stream->offset = NULL;
+  stream->lexeme = NULL;
+  stream->has_pending = false;
+  
+  /* entry 0 holds the current symbol */
+  if (append_to_stream(stream, &lexer->current) == false) {
+    free(stream);
+    SET_STATUS(status, M2T_LEXER_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  /* append all remaining symbols, including the end-of-file symbol */
+  while (true) {
+    if (append_to_stream(stream, &lexer->lookahead) == false) {
+      /* out of memory, keep symbol for on-demand lexing */
+      stream->pending = lexer->lookahead;
+      stream->has_pending = true;
+      break;
+    } /* end if */
+    
+    if (lexer->lookahead.token == TOKEN_END_OF_FILE) {
+      break;
+    } /* end if */
+    
+    get_new_lookahead_sym(lexer);
+  } /* end while */
+  
+  /* install stream and serve symbols from entry 1 onwards */
+  lexer->stream = stream;
+  lexer->stream_pos = 1;
+  lexer->current_shared = true;
+  
+  if (stream->count > 1) {
+    lexer->lookahead.token = stream->token[1];
+    lexer->lookahead.offset = stream->offset[1];
+    lexer->lookahead.lexeme = stream->lexeme[1];
+    lexer->lookahead_shared = true;
+  }
+  else /* nothing fitted, pending symbol becomes lookahead */ {
+    lexer->lookahead = stream->pending;
+    lexer->lookahead_shared = false;
+    stream->has_pending = false;
+  } /* end if */
+  
+  if (stream->has_pending) {
+    SET_STATUS(status, M2T_LEXER_STATUS_ALLOCATION_FAILED);
+  }
+  else {
+    SET_STATUS(status, M2T_LEXER_STATUS_SUCCESS);
+  } /* end if */
+  
+  return;
+} /* end m2t_lexer_pretokenize */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_lexer_peek_sym(lexer, n)
+ * --------------------------------------------------------------------------
+ * Returns the token of the n-th symbol following the lookahead symbol
+ * without consuming any symbols.  For n = 0 the lookahead token is returned.
+ * Returns TOKEN_UNKNOWN if lexer has not been pre-tokenized and n > 0, or
+ * if the n-th symbol has not been stored in the stream.  Returns
+ * TOKEN_END_OF_FILE if the n-th symbol lies beyond the end of the input.
+ * ----------------------------------------------------------------------- */
+
+m2t_token_t m2t_lexer_peek_sym (m2t_lexer_t lexer, uint_t n) {
+  
+  if (n == 0) {
+    return lexer->lookahead.token;
+  } /* end if */
+  
+  if ((lexer->stream == NULL) || (lexer->lookahead_shared == false)) {
+    return TOKEN_UNKNOWN;
+  } /* end if */
+  
+  if (lexer->stream_pos + n >= lexer->stream->count) {
+    if (lexer->stream->token[lexer->stream->count - 1] == TOKEN_END_OF_FILE) {
+      return TOKEN_END_OF_FILE;
+    }
+    else /* remainder is lexed on demand */ {
+      return TOKEN_UNKNOWN;
+    } /* end if */
+  } /* end if */
+  
+  return lexer->stream->token[lexer->stream_pos + n];
+} /* end m2t_lexer_peek_sym */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_lexer_position(lexer)
+ * --------------------------------------------------------------------------
+ * Returns the stream position of the lookahead symbol of a pre-tokenized
+ * lexer for use with procedure m2t_lexer_rewind().  Returns zero if lexer
+ * has not been pre-tokenized or the lookahead lies beyond the stream.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2t_lexer_position (m2t_lexer_t lexer) {
+  
+  if ((lexer->stream == NULL) || (lexer->lookahead_shared == false)) {
+    return 0;
+  } /* end if */
+  
+  return lexer->stream_pos;
+} /* end m2t_lexer_position */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_lexer_rewind(lexer, position, status)
+ * --------------------------------------------------------------------------
+ * Resets the lookahead symbol of a pre-tokenized lexer to the symbol at
+ * the given stream position, previously obtained by m2t_lexer_position().
+ *
+ * pre-conditions:
+ * o  lexer must have been pre-tokenized
+ * o  the current lookahead symbol must lie within the stream
+ * o  position must be a value obtained by function m2t_lexer_position()
+ *
+ * post-conditions:
+ * o  the lookahead symbol is the symbol at position
+ * o  M2T_LEXER_STATUS_SUCCESS is passed back in status, unless NULL
+ *
+ * error-conditions:
+ * o  if any pre-condition is not met, no operation is carried out and
+ *    M2T_LEXER_STATUS_INVALID_REFERENCE is passed back in status
+ * ----------------------------------------------------------------------- */
+
+void m2t_lexer_rewind
+  (m2t_lexer_t lexer, uint_t position, m2t_lexer_status_t *status) {
+  
+  m2t_token_stream_t *stream;
+  
+  /* check pre-conditions */
+  if ((lexer == NULL) || (lexer->stream == NULL) ||
+      (lexer->lookahead_shared == false) ||
+      (position == 0) || (position >= lexer->stream->count)) {
+    SET_STATUS(status, M2T_LEXER_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  stream = lexer->stream;
+  lexer->stream_pos = position;
+  
+  lexer->current.token = stream->token[position - 1];
+  lexer->current.offset = stream->offset[position - 1];
+  lexer->current.lexeme = stream->lexeme[position - 1];
+  lexer->current_shared = true;
+  
+  lexer->lookahead.token = stream->token[position];
+  lexer->lookahead.offset = stream->offset[position];
+  lexer->lookahead.lexeme = stream->lexeme[position];
+  lexer->lookahead_shared = true;
+  
+  SET_STATUS(status, M2T_LEXER_STATUS_SUCCESS);
+  return;
+} /* end m2t_lexer_rewind */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_lexer_start_pipeline(lexer, status)
+ * --------------------------------------------------------------------------
+ * Starts a thread that lexes the remainder of the input associated with
+ * lexer ahead of the parser.  Thereafter, symbols are served in blocks
+ * passed from that thread, together with their lines, columns and lexemes.
+ * Scanning thus overlaps with parsing.
+ *
+ * pre-conditions:
+ * o  parameter lexer must not be NULL upon entry
+ * o  lexer must neither have been pre-tokenized nor pipelined before
+ * o  the string repository must have been initialised in concurrent mode
+ * o  parameter status may be NULL
+ *
+ * post-conditions:
+ * o  the remainder of the input is lexed by a thread of its own
+ * o  M2T_LEXER_STATUS_SUCCESS is passed back in status, unless NULL
+ *
+ * error-conditions:
+ * o  if lexer is NULL or has already been pre-tokenized or pipelined upon
+ *    entry, no operation is carried out and status
+ *    M2T_LEXER_STATUS_INVALID_REFERENCE is passed back, unless NULL
+ * o  if the pipeline cannot be allocated or the thread cannot be started,
+ *    no operation is carried out and M2T_LEXER_STATUS_ALLOCATION_FAILED is
+ *    passed back in status, unless NULL.  Symbols are then lexed on demand.
+ * ----------------------------------------------------------------------- */
+
+void m2t_lexer_start_pipeline
+  (m2t_lexer_t lexer, m2t_lexer_status_t *status) {
+  
+#if (M2T_LEXER_THREADS)
+  m2t_lexer_pipeline_t *pipeline;
+  m2t_lexer_t scanner;
+  
+  /* check pre-conditions */
+  if ((lexer == NULL) || (lexer->stream != NULL) ||
+      (lexer->pipeline != NULL)) {
+    SET_STATUS(status, M2T_LEXER_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  /* nothing left to lex, or comments are recorded, lex on demand */
+  if ((lexer->lookahead.token == TOKEN_END_OF_FILE) ||
+      (lexer->comments != NULL)) {
+    SET_STATUS(status, M2T_LEXER_STATUS_SUCCESS);
+    return;
+  } /* end if */
+  
+  /* allocate pipeline and scanner */
+  pipeline = malloc(sizeof(m2t_lexer_pipeline_t));
+  scanner = malloc(sizeof(m2t_lexer_struct_t));
+  
+  if ((pipeline == NULL) || (scanner == NULL)) {
+    free(pipeline);
+    free(scanner);
+    SET_STATUS(status, M2T_LEXER_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  /* each queue can hold all blocks, enqueueing a block never fails */
+  pipeline->full = m2t_fifo_spsc_new_queue(M2T_PIPELINE_BLOCK_COUNT);
+  pipeline->empty = m2t_fifo_spsc_new_queue(M2T_PIPELINE_BLOCK_COUNT);
+  
+  if ((pipeline->full == NULL) || (pipeline->empty == NULL)) {
+    m2t_fifo_spsc_release_queue(pipeline->full);
+    m2t_fifo_spsc_release_queue(pipeline->empty);
+    free(pipeline);
+    free(scanner);
+    SET_STATUS(status, M2T_LEXER_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  /* the scanner continues from the input position of lexer */
+  *scanner = *lexer;
+  scanner->current = null_symbol;
+  scanner->lookahead = null_symbol;
+  scanner->error_count = 0;
+  
+  pipeline->scanner = scanner;
+  pipeline->block = NULL;
+  pipeline->index = 0;
+  pipeline->block_count = 0;
+  pipeline->stop = false;
+  M2C_LOCK_INIT(&pipeline->lock);
+  
+  if (NOT(m2c_thread_start(&pipeline->thread, pipeline_main, pipeline))) {
+    M2C_LOCK_DISPOSE(&pipeline->lock);
+    m2t_fifo_spsc_release_queue(pipeline->full);
+    m2t_fifo_spsc_release_queue(pipeline->empty);
+    free(pipeline);
+    free(scanner);
+    SET_STATUS(status, M2T_LEXER_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  lexer->pipeline = pipeline;
+  
+  SET_STATUS(status, M2T_LEXER_STATUS_SUCCESS);
+  return;
+  
+#else /* no threads, lex on demand */
+  SET_STATUS(status, M2T_LEXER_STATUS_SUCCESS);
+  return;
+#endif
+} /* end m2t_lexer_start_pipeline */
+
+
 /* --------------------------------------------------------------------------
  * procedure m2t_release_lexer(lexer, status)
  * --------------------------------------------------------------------------
@@ -450,9 +1438,26 @@ void m2t_release_lexer (m2t_lexer_t *lexptr, m2t_lexer_status_t *status) {
   
   lexer = *lexptr;
   
+  /* stop the lexer thread before the input is closed */
+  if (lexer->pipeline != NULL) {
+    lexer->error_count =
+      lexer->error_count + lexer->pipeline->scanner->error_count;
+    release_pipeline(lexer->pipeline);
+  } /* end if */
+  
   m2t_close_infile(&lexer->infile, NULL);
-  m2t_string_release(lexer->current.lexeme);
-  m2t_string_release(lexer->lookahead.lexeme);
+  
+  if (lexer->current_shared == false) {
+    m2t_string_release(lexer->current.lexeme);
+  } /* end if */
+  
+  if (lexer->lookahead_shared == false) {
+    m2t_string_release(lexer->lookahead.lexeme);
+  } /* end if */
+  
+  if (lexer->stream != NULL) {
+    release_stream(lexer->stream);
+  } /* end if */
   
   free(lexer);
   *lexptr = NULL;
@@ -461,6 +1466,71 @@ void m2t_release_lexer (m2t_lexer_t *lexptr, m2t_lexer_status_t *status) {
 } /* end m2t_release_lexer */
 
 
+/* --------------------------------------------------------------------------
+ * private procedure init_lexer(lexer, infile, options, comments)
+ * --------------------------------------------------------------------------
+ * Initialises a newly allocated lexer object, associates it with infile,
+ * captures option set options, installs the identifier, string literal and
+ * number literal lexers specialised for the dialect given by options and
+ * reads the first symbol.  Comments are recorded in comments unless NULL.
+ * ----------------------------------------------------------------------- */
+
+static void init_lexer
+  (m2t_lexer_t lexer, m2t_infile_t infile, m2t_option_set_t options,
+   m2t_comment_table_t comments) {
+  
+  lexer->infile = infile;
+  lexer->validated = m2t_infile_is_validated(infile);
+  lexer->current = null_symbol;
+  lexer->lookahead = null_symbol;
+  lexer->status = M2T_LEXER_STATUS_SUCCESS;
+  lexer->error_count = 0;
+  lexer->token_count = 0;
+  lexer->stream = NULL;
+  lexer->stream_pos = 0;
+  lexer->pipeline = NULL;
+  lexer->skip_set = NULL;
+  lexer->current_shared = false;
+  lexer->lookahead_shared = false;
+  lexer->comments = comments;
+  lexer->options = options;
+  
+  if (M2T_OPTION_IN_SET(options, M2T_OPTION_PREFIX_LITERALS)) {
+    /* install function to lex prefix number literals */
+    lexer->get_number_literal = get_prefixed_number_literal;
+  }
+  else /* suffix literals */ {
+    /* install function to lex suffix number literals */
+    lexer->get_number_literal = get_suffixed_number_literal;
+  } /* end if */
+  
+  if (M2T_OPTION_IN_SET(options, M2T_OPTION_LOWLINE_IDENTIFIERS)) {
+    /* install functions to lex identifiers with lowlines */
+    lexer->get_ident = get_ident_w_lowline;
+    lexer->get_ident_or_resword = get_ident_or_resword_w_lowline;
+  }
+  else /* plain identifiers */ {
+    /* install functions to lex identifiers without lowlines */
+    lexer->get_ident = get_ident;
+    lexer->get_ident_or_resword = get_ident_or_resword;
+  } /* end if */
+  
+  if (M2T_OPTION_IN_SET(options, M2T_OPTION_ESCAPE_TAB_AND_NEWLINE)) {
+    /* install function to lex string literals with escape sequences */
+    lexer->get_string_literal = get_string_literal_w_escapes;
+  }
+  else /* verbatim string literals */ {
+    /* install function to lex verbatim string literals */
+    lexer->get_string_literal = get_string_literal;
+  } /* end if */
+  
+  /* read first symbol */
+  get_new_lookahead_sym(lexer);
+  
+  return;
+} /* end init_lexer */
+
+
 /* --------------------------------------------------------------------------
  * procedure report_error_w_offending_pos(error, lexer, line, column)
  * ----------------------------------------------------------------------- */
@@ -501,394 +1571,865 @@ static void report_error_w_offending_char
   
 
 /* --------------------------------------------------------------------------
- * private procedure get_new_lookahead_sym(lexer)
+ * procedure report_error_w_char_at_offset(error, lexer, offset, char)
  * ----------------------------------------------------------------------- */
 
-static void get_new_lookahead_sym (m2t_lexer_t lexer) {
+static void report_error_w_char_at_offset
+  (m2t_error_t error,
+   m2t_lexer_t lexer, uint32_t offset, char offending_char) {
   
   uint_t line, column;
-  m2t_token_t token;
-  char next_char;
   
-  /* no token yet */
-  token = TOKEN_UNKNOWN;
+  position_for_offset(lexer, offset, &line, &column);
   
-  /* get the lookahead character */
-  next_char = m2t_next_char(lexer->infile);
+  report_error_w_offending_char
+    (error, lexer, line, column, offending_char);
+  
+  return;
+} /* end report_error_w_char_at_offset */
+
+
+/* --------------------------------------------------------------------------
+ * procedure position_for_offset(lexer, offset, line, column)
+ * --------------------------------------------------------------------------
+ * Decodes offset to line and column through the line table of the input.
+ * The input is shared with the lexer thread of a pipeline, whose line table
+ * grows while it lexes, the lock is thus held while decoding.  Offset is
+ * relative to the input, line and column are relative to the start of the
+ * buffer of a range lexer.
+ * ----------------------------------------------------------------------- */
+
+static void position_for_offset
+  (m2t_lexer_t lexer, uint32_t offset, uint_t *line, uint_t *column) {
+  
+  bool decoded;
+  
+  if (lexer->pipeline != NULL) {
+    M2C_LOCK_ACQUIRE(&lexer->pipeline->lock);
+    decoded = m2t_infile_position_for_offset
+      (lexer->infile, offset, line, column);
+    M2C_LOCK_RELEASE(&lexer->pipeline->lock);
+  }
+  else {
+    decoded = m2t_infile_position_for_offset
+      (lexer->infile, offset, line, column);
+  } /* end if */
+  
+  if (NOT(decoded)) {
+    *line = 0;
+    *column = 0;
+  }
+  else /* shift to the start of the buffer of a range lexer */ {
+    if (*line == 1) {
+      *column = *column + lexer->base_column;
+    } /* end if */
+    *line = *line + lexer->base_line;
+  } /* end if */
+  
+  return;
+} /* end position_for_offset */
+
+
+/* --------------------------------------------------------------------------
+ * procedure init_base_position(lexer, buffer, start)
+ * --------------------------------------------------------------------------
+ * Records the offset, the number of preceding lines and the column of byte
+ * offset start of buffer as the base position of lexer.  Buffer is NULL for
+ * lexers that are not associated with a range.
+ * ----------------------------------------------------------------------- */
+
+static void init_base_position
+  (m2t_lexer_t lexer, const char *buffer, size_t start) {
+  
+  size_t index, line_start;
+  
+  lexer->base_offset = (uint32_t) start;
+  lexer->base_line = 0;
+  lexer->base_column = 0;
+  
+  if (buffer == NULL) {
+    return;
+  } /* end if */
+  
+  /* count preceding lines, CR LF, CR and LF each end a line */
+  line_start = 0;
+  for (index = 0; index < start; index++) {
+    if ((buffer[index] == ASCII_LF) ||
+        ((buffer[index] == ASCII_CR) && (buffer[index + 1] != ASCII_LF))) {
+      lexer->base_line++;
+      line_start = index + 1;
+    } /* end if */
+  } /* end for */
+  
+  lexer->base_column = (uint_t) (start - line_start);
+  
+  return;
+} /* end init_base_position */
+
+
+/* --------------------------------------------------------------------------
+ * function infile_line(lexer)
+ * --------------------------------------------------------------------------
+ * Returns the line of the reading position of the input of lexer, relative
+ * to the start of the buffer of a range lexer.
+ * ----------------------------------------------------------------------- */
+
+static uint_t infile_line (m2t_lexer_t lexer) {
+  
+  return m2t_infile_current_line(lexer->infile) + lexer->base_line;
+  
+} /* end infile_line */
+
+
+/* --------------------------------------------------------------------------
+ * function infile_column(lexer)
+ * --------------------------------------------------------------------------
+ * Returns the column of the reading position of the input of lexer,
+ * relative to the start of the buffer of a range lexer.
+ * ----------------------------------------------------------------------- */
+
+static uint_t infile_column (m2t_lexer_t lexer) {
+  
+  uint_t column;
+  
+  column = m2t_infile_current_column(lexer->infile);
+  
+  if (m2t_infile_current_line(lexer->infile) == 1) {
+    column = column + lexer->base_column;
+  } /* end if */
+  
+  return column;
+} /* end infile_column */
+  
+
+/* --------------------------------------------------------------------------
+ * private procedure get_new_lookahead_sym(lexer)
+ * ----------------------------------------------------------------------- */
+
+static void get_new_lookahead_sym (m2t_lexer_t lexer) {
+  
+  uint_t line, column;
+  m2t_token_t token;
+  uint32_t offset;
+  uint_t cc;
+  char next_char;
+  
+  /* no token yet */
+  token = TOKEN_UNKNOWN;
+  
+  /* symbols without lexeme must not share the previous symbol's lexeme */
+  lexer->lookahead.lexeme = NULL;
+  
+  /* get the lookahead character */
+  next_char = m2t_next_char(lexer->infile);
   
   while (token == TOKEN_UNKNOWN) {
   
     /* skip all whitespace and line feeds */
-    while ((next_char == ASCII_SPACE) ||
-           (next_char == ASCII_TAB) ||
-           (next_char == ASCII_LF)) {
+    while (CHAR_IN_CLASS(next_char, CC_WHITESPACE | CC_NEWLINE)) {
       
       /* consume the character and get new lookahead */
       next_char = m2t_consume_char(lexer->infile);
     } /* end while */
     
-    /* get line and column of lookahead */
-    line = m2t_infile_current_line(lexer->infile);
-    column = m2t_infile_current_column(lexer->infile);
+    /* get offset of lookahead */
+    offset = (uint32_t) m2t_infile_current_offset(lexer->infile);
     
-    switch (next_char) {
-      
-      case ASCII_EOT :
-        /* End-of-File marker */        
-        if (m2t_infile_status(lexer->infile) ==
-            M2T_INFILE_STATUS_ATTEMPT_TO_READ_PAST_EOF) {
-          token = TOKEN_END_OF_FILE;
-        }
-        else /* invalid char */ {
-          report_error_w_offending_char
-            (M2T_ERROR_INVALID_INPUT_CHAR, lexer, line, column, next_char);
-          next_char = m2t_consume_char(lexer->infile);
-          token = TOKEN_UNKNOWN;
-        } /* end if */
-        break;
-        
-      case '!' :
-        /* line comment */        
-        if (m2t_option_line_comments()) {
-          next_char = skip_line_comment(lexer);
-        }
-        else /* invalid char */ {
-          report_error_w_offending_char
-            (M2T_ERROR_INVALID_INPUT_CHAR, lexer, line, column, next_char);
-          next_char = m2t_consume_char(lexer->infile);
-        } /* end if */
-        token = TOKEN_UNKNOWN;
-        break;
-        
-      case '\"' :
-        /* string literal */
-        next_char = get_string_literal(lexer, &token);
-        if (token == TOKEN_MALFORMED_STRING) {
-          m2t_emit_error_w_pos
-            (M2T_ERROR_MISSING_STRING_DELIMITER, line, column);
-          lexer->error_count++;
-        } /* end if */
-        break;
-        
-      case '#' :
-        /* not-equal operator */
-        next_char = m2t_consume_char(lexer->infile);
-        token = TOKEN_NOTEQUAL;
-        break;
-        
-      case '&' :
-        /* ampersand synonym */
-        if (m2t_option_synonyms()) {
-          next_char = m2t_consume_char(lexer->infile);
-          token = TOKEN_AND;
-        }
-        else /* invalid char */ {
-          report_error_w_offending_char
-            (M2T_ERROR_INVALID_INPUT_CHAR, lexer, line, column, next_char);
-          next_char = m2t_consume_char(lexer->infile);
-          token = TOKEN_UNKNOWN;
-        } /* end if */
-        break;
-        
-      case '\'' :
-        /* string literal */
-        next_char = get_string_literal(lexer, &token);
-        if (token == TOKEN_MALFORMED_STRING) {
-          m2t_emit_error_w_pos
-            (M2T_ERROR_MISSING_STRING_DELIMITER, line, column);
-          lexer->error_count++;
-        } /* end if */
-        break;
-        
-      case '(' :
-        /* left parenthesis */
-        if (m2t_la2_char(lexer->infile) != '*') {
-          next_char = m2t_consume_char(lexer->infile);
-          token = TOKEN_LEFT_PARENTHESIS;
-        }
-        else /* block comment */ {
-          next_char = skip_block_comment(lexer);
-          token = TOKEN_UNKNOWN;
-        } /* end if */
-        break;
-        
-      case ')' :
-        /* right parenthesis */
-        next_char = m2t_consume_char(lexer->infile);
-        token = TOKEN_RIGHT_PARENTHESIS;
-        break;
-        
-      case '*' :
-        /* asterisk operator */
-        next_char = m2t_consume_char(lexer->infile);
-        token = TOKEN_MULTIPLICATION;
-        break;
-        
-      case '+' :
-        /* plus operator */
-        next_char = m2t_consume_char(lexer->infile);
-        token = TOKEN_ADDITION;
-        break;
-        
-      case ',' :
-        /* comma */
-        next_char = m2t_consume_char(lexer->infile);
-        token = TOKEN_COMMA;
-        break;
-        
-      case '-' :
-        /* minus operator */
-        next_char = m2t_consume_char(lexer->infile);
-        token = TOKEN_SUBTRACTION;
-        break;
-        
-      case '.' :
-        /* range or period */
+    cc = CHAR_CLASS(next_char);
+    
+    if /* identifier or reserved word */ ((cc & CC_IDENT_START) != 0) {
+      if /* uppercase first letter */ ((cc & CC_UPPER) != 0) {
+        next_char = lexer->get_ident_or_resword(lexer, &token);
+      }
+      else /* identifier */ {
+        next_char = lexer->get_ident(lexer);
+        token = TOKEN_IDENTIFIER;
+      } /* end if */
+    }
+    else if /* number literal */ ((cc & CC_DIGIT) != 0) {
+      next_char = lexer->get_number_literal(lexer, &token);
+      if (token == TOKEN_MALFORMED_INTEGER) {
+        position_for_offset(lexer, offset, &line, &column);
+        m2t_emit_error_w_pos(M2T_ERROR_MISSING_SUFFIX, line, column);
+        lexer->error_count++;
+      }
+      else if (token == TOKEN_MALFORMED_REAL) {
+        position_for_offset(lexer, offset, &line, &column);
+        m2t_emit_error_w_pos(M2T_ERROR_MISSING_EXPONENT, line, column);
+        lexer->error_count++;
+      } /* end if */
+    }
+    else if /* string literal */ ((cc & CC_QUOTE) != 0) {
+      next_char = lexer->get_string_literal(lexer, &token);
+      if (token == TOKEN_MALFORMED_STRING) {
+        position_for_offset(lexer, offset, &line, &column);
+        m2t_emit_error_w_pos
+          (M2T_ERROR_MISSING_STRING_DELIMITER, line, column);
+        lexer->error_count++;
+      } /* end if */
+    }
+    else if /* punctuation or comment */ ((cc & CC_OPERATOR) != 0) {
+      next_char = get_operator(lexer, offset, &token);
+    }
+    else if /* End-of-File marker */
+      ((next_char == ASCII_EOT) &&
+       (m2t_infile_status(lexer->infile) ==
+        M2T_INFILE_STATUS_ATTEMPT_TO_READ_PAST_EOF)) {
+      token = TOKEN_END_OF_FILE;
+    }
+    else /* invalid character */ {
+      report_error_w_char_at_offset
+        (M2T_ERROR_INVALID_INPUT_CHAR, lexer, offset, next_char);
+      next_char = m2t_consume_char(lexer->infile);
+      token = TOKEN_UNKNOWN;
+    } /* end if */
+  } /* end while */
+  
+  /* update lexer's lookahead symbol */
+  lexer->lookahead.token = token;
+  lexer->lookahead.offset = offset;
+  
+#if (M2T_COMMENT_PRESRVN_IMPLEMENTED)
+  /* comments skipped since the last symbol precede this symbol */
+  m2t_comment_table_anchor(lexer->comments, lexer->base_offset + offset);
+#endif
+  
+  return;
+} /* end get_new_lookahead_sym */
+
+
+/* --------------------------------------------------------------------------
+ * private function get_operator(lexer, offset, token)
+ * --------------------------------------------------------------------------
+ * Lexes the punctuation or operator symbol, comment, pragma or disabled
+ * code section that starts with the lookahead character, which must belong
+ * to character class CC_OPERATOR.  Passes back the token, TOKEN_UNKNOWN for
+ * a comment, code section or invalid character, and returns the new
+ * lookahead character.
+ * ----------------------------------------------------------------------- */
+
+static char get_operator
+  (m2t_lexer_t lexer, uint32_t offset, m2t_token_t *token) {
+  
+  char next_char;
+  
+  next_char = m2t_next_char(lexer->infile);
+  
+  switch (next_char) {
+    
+    case '!' :
+      /* line comment */        
+      if (M2T_OPTION_IN_SET(lexer->options, M2T_OPTION_LINE_COMMENTS)) {
+        next_char = skip_line_comment(lexer);
+        record_comment(lexer, offset);
+      }
+      else /* invalid char */ {
+        report_error_w_char_at_offset
+          (M2T_ERROR_INVALID_INPUT_CHAR, lexer, offset, next_char);
         next_char = m2t_consume_char(lexer->infile);
-        if /* range */ (next_char == '.') {
-          next_char = m2t_consume_char(lexer->infile);
-          token = TOKEN_RANGE;
-        }
-        else /* period */ {
-          token = TOKEN_PERIOD;
-        } /* end if */
-        break;
-        
-      case '/' :
-        /* solidus operator */
+      } /* end if */
+      *token = TOKEN_UNKNOWN;
+      break;
+      
+    case '#' :
+      /* not-equal operator */
+      next_char = m2t_consume_char(lexer->infile);
+      *token = TOKEN_NOTEQUAL;
+      break;
+      
+    case '&' :
+      /* ampersand synonym */
+      if (M2T_OPTION_IN_SET(lexer->options, M2T_OPTION_SYNONYMS)) {
         next_char = m2t_consume_char(lexer->infile);
-        token = TOKEN_DIVISION;
-        break;
-        
-      case '0' :
-      case '1' :
-      case '2' :
-      case '3' :
-      case '4' :
-      case '5' :
-      case '6' :
-      case '7' :
-      case '8' :
-      case '9' :
-        /* number literal */
-        next_char = lexer->get_number_literal(lexer, &token);
-        if (token == TOKEN_MALFORMED_INTEGER) {
-          m2t_emit_error_w_pos(M2T_ERROR_MISSING_SUFFIX, line, column);
-          lexer->error_count++;
-        }
-        else if (token == TOKEN_MALFORMED_REAL) {
-          m2t_emit_error_w_pos(M2T_ERROR_MISSING_EXPONENT, line, column);
-          lexer->error_count++;
-        } /* end if */
-        break;
-        
-      case ':' :
-        /* assignment or colon*/
+        *token = TOKEN_AND;
+      }
+      else /* invalid char */ {
+        report_error_w_char_at_offset
+          (M2T_ERROR_INVALID_INPUT_CHAR, lexer, offset, next_char);
         next_char = m2t_consume_char(lexer->infile);
-        if /* assignment */ (next_char == '=') {
-          next_char = m2t_consume_char(lexer->infile);
-          token = TOKEN_ASSIGNMENT;
-        }
-        else /* colon */ {
-          token = TOKEN_COLON;
-        } /* end if */
-        break;
-        
-      case ';' :
-        /* semicolon */
+        *token = TOKEN_UNKNOWN;
+      } /* end if */
+      break;
+      
+    case '(' :
+      /* left parenthesis */
+      if (m2t_la2_char(lexer->infile) != '*') {
         next_char = m2t_consume_char(lexer->infile);
-        token = TOKEN_SEMICOLON;
-        break;
-        
-      case '<' :
-        /* pragma */
-        if (m2t_la2_char(lexer->infile) == '*') {
-          next_char = get_pragma(lexer);
-          token = TOKEN_PRAGMA;
-          break;
-        }
-        /* not-equal synonym, or less-or-equal or equal operator */
+        *token = TOKEN_LEFT_PARENTHESIS;
+      }
+      else /* block comment */ {
+        next_char = skip_block_comment(lexer);
+        record_comment(lexer, offset);
+        *token = TOKEN_UNKNOWN;
+      } /* end if */
+      break;
+      
+    case ')' :
+      /* right parenthesis */
+      next_char = m2t_consume_char(lexer->infile);
+      *token = TOKEN_RIGHT_PARENTHESIS;
+      break;
+      
+    case '*' :
+      /* asterisk operator */
+      next_char = m2t_consume_char(lexer->infile);
+      *token = TOKEN_MULTIPLICATION;
+      break;
+      
+    case '+' :
+      /* plus operator */
+      next_char = m2t_consume_char(lexer->infile);
+      *token = TOKEN_ADDITION;
+      break;
+      
+    case ',' :
+      /* comma */
+      next_char = m2t_consume_char(lexer->infile);
+      *token = TOKEN_COMMA;
+      break;
+      
+    case '-' :
+      /* minus operator */
+      next_char = m2t_consume_char(lexer->infile);
+      *token = TOKEN_SUBTRACTION;
+      break;
+      
+    case '.' :
+      /* range or period */
+      next_char = m2t_consume_char(lexer->infile);
+      if /* range */ (next_char == '.') {
         next_char = m2t_consume_char(lexer->infile);
-        
-        if /* diamond */ (next_char == '>') {
-          if (m2t_option_synonyms()) {
-            next_char = m2t_consume_char(lexer->infile);
-            token = TOKEN_NOTEQUAL;
-          }
-          else /* invalid char */ {
-            report_error_w_offending_char
-              (M2T_ERROR_INVALID_INPUT_CHAR, lexer, line, column, next_char);
-            next_char = m2t_consume_char(lexer->infile);
-            token = TOKEN_UNKNOWN;
-          } /* end if */
-        }
-        else if /* less-or-equal */ (next_char == '=') {
-          next_char = m2t_consume_char(lexer->infile);
-          token = TOKEN_LESS_THAN_OR_EQUAL;
-        }
-        else /* less */ {
-          token = TOKEN_LESS_THAN;
-        } /* end if */
-        break;
-        
-      case '=' :
-        /* equal operator */
+        *token = TOKEN_RANGE;
+      }
+      else /* period */ {
+        *token = TOKEN_PERIOD;
+      } /* end if */
+      break;
+      
+    case '/' :
+      /* solidus operator */
+      next_char = m2t_consume_char(lexer->infile);
+      *token = TOKEN_DIVISION;
+      break;
+      
+    case ':' :
+      /* assignment or colon*/
+      next_char = m2t_consume_char(lexer->infile);
+      if /* assignment */ (next_char == '=') {
         next_char = m2t_consume_char(lexer->infile);
-        token = TOKEN_EQUAL;
+        *token = TOKEN_ASSIGNMENT;
+      }
+      else /* colon */ {
+        *token = TOKEN_COLON;
+      } /* end if */
+      break;
+      
+    case ';' :
+      /* semicolon */
+      next_char = m2t_consume_char(lexer->infile);
+      *token = TOKEN_SEMICOLON;
+      break;
+      
+    case '<' :
+      /* pragma */
+      if (m2t_la2_char(lexer->infile) == '*') {
+        next_char = get_pragma(lexer);
+        *token = TOKEN_PRAGMA;
         break;
-        
-      case '>' :
-        /* greater-or-equal or equal operator */
-        next_char = m2t_consume_char(lexer->infile);
-        if /* greater-or-equal */ (next_char == '=') {
+      }
+      /* not-equal synonym, or less-or-equal or equal operator */
+      next_char = m2t_consume_char(lexer->infile);
+      
+      if /* diamond */ (next_char == '>') {
+        if (M2T_OPTION_IN_SET(lexer->options, M2T_OPTION_SYNONYMS)) {
           next_char = m2t_consume_char(lexer->infile);
-          token = TOKEN_GREATER_THAN_OR_EQUAL;
+          *token = TOKEN_NOTEQUAL;
         }
-        else /* greater */ {
-          token = TOKEN_GREATER_THAN;
-        } /* end if */
-        break;
-        
-      case '?' :
-        /* disabled code section */
-        if ((column == 1) && (m2t_la2_char(lexer->infile) == '<')) {
-          next_char = skip_code_section(lexer);
-        }
-        else /* invalid character */ {
-          report_error_w_offending_char
-            (M2T_ERROR_INVALID_INPUT_CHAR, lexer, line, column, next_char);
+        else /* invalid char */ {
+          report_error_w_char_at_offset
+            (M2T_ERROR_INVALID_INPUT_CHAR, lexer, offset, next_char);
           next_char = m2t_consume_char(lexer->infile);
+          *token = TOKEN_UNKNOWN;
         } /* end if */
-        token = TOKEN_UNKNOWN;
-        break;
-        
-      case 'A' :
-      case 'B' :
-      case 'C' :
-      case 'D' :
-      case 'E' :
-      case 'F' :
-      case 'G' :
-      case 'H' :
-      case 'I' :
-      case 'J' :
-      case 'K' :
-      case 'L' :
-      case 'M' :
-      case 'N' :
-      case 'O' :
-      case 'P' :
-      case 'Q' :
-      case 'R' :
-      case 'S' :
-      case 'T' :
-      case 'U' :
-      case 'V' :
-      case 'W' :
-      case 'X' :
-      case 'Y' :
-      case 'Z' :
-        /* identifier or reserved word */
-        next_char = get_ident_or_resword(lexer, &token);
-        break;
-        
-      case '[' :
-        /* left bracket */
-        next_char = m2t_consume_char(lexer->infile);
-        token = TOKEN_LEFT_BRACKET;
-        break;
-        
-      case ']' :
-        /* right bracket */
-        next_char = m2t_consume_char(lexer->infile);
-        token = TOKEN_RIGHT_BRACKET;
-        break;
-        
-      case '^' :
-        /* caret */
+      }
+      else if /* less-or-equal */ (next_char == '=') {
         next_char = m2t_consume_char(lexer->infile);
-        token = TOKEN_DEREF;
-        break;
-        
-      case 'a' :
-      case 'b' :
-      case 'c' :
-      case 'd' :
-      case 'e' :
-      case 'f' :
-      case 'g' :
-      case 'h' :
-      case 'i' :
-      case 'j' :
-      case 'k' :
-      case 'l' :
-      case 'm' :
-      case 'n' :
-      case 'o' :
-      case 'p' :
-      case 'q' :
-      case 'r' :
-      case 's' :
-      case 't' :
-      case 'u' :
-      case 'v' :
-      case 'w' :
-      case 'x' :
-      case 'y' :
-      case 'z' :
-        /* identifier */
-        next_char = get_ident(lexer);
-        token = TOKEN_IDENTIFIER;
-        break;
-        
-      case '{' :
-        /* left brace */
+        *token = TOKEN_LESS_THAN_OR_EQUAL;
+      }
+      else /* less */ {
+        *token = TOKEN_LESS_THAN;
+      } /* end if */
+      break;
+      
+    case '=' :
+      /* equal operator */
+      next_char = m2t_consume_char(lexer->infile);
+      *token = TOKEN_EQUAL;
+      break;
+      
+    case '>' :
+      /* greater-or-equal or equal operator */
+      next_char = m2t_consume_char(lexer->infile);
+      if /* greater-or-equal */ (next_char == '=') {
         next_char = m2t_consume_char(lexer->infile);
-        token = TOKEN_LEFT_BRACE;
-        break;
-        
-      case '|' :
-        /* vertical bar */
+        *token = TOKEN_GREATER_THAN_OR_EQUAL;
+      }
+      else /* greater */ {
+        *token = TOKEN_GREATER_THAN;
+      } /* end if */
+      break;
+      
+    case '?' :
+      /* disabled code section */
+      if ((infile_column(lexer) == 1) &&
+          (m2t_la2_char(lexer->infile) == '<')) {
+        next_char = skip_code_section(lexer);
+      }
+      else /* invalid character */ {
+        report_error_w_char_at_offset
+          (M2T_ERROR_INVALID_INPUT_CHAR, lexer, offset, next_char);
         next_char = m2t_consume_char(lexer->infile);
-        token = TOKEN_BAR;
-        break;
-        
-      case '}' :
-        /* right brace */
+      } /* end if */
+      *token = TOKEN_UNKNOWN;
+      break;
+      
+    case '[' :
+      /* left bracket */
+      next_char = m2t_consume_char(lexer->infile);
+      *token = TOKEN_LEFT_BRACKET;
+      break;
+      
+    case ']' :
+      /* right bracket */
+      next_char = m2t_consume_char(lexer->infile);
+      *token = TOKEN_RIGHT_BRACKET;
+      break;
+      
+    case '^' :
+      /* caret */
+      next_char = m2t_consume_char(lexer->infile);
+      *token = TOKEN_DEREF;
+      break;
+      
+    case '{' :
+      /* left brace */
+      next_char = m2t_consume_char(lexer->infile);
+      *token = TOKEN_LEFT_BRACE;
+      break;
+      
+    case '|' :
+      /* vertical bar */
+      next_char = m2t_consume_char(lexer->infile);
+      *token = TOKEN_BAR;
+      break;
+      
+    case '}' :
+      /* right brace */
+      next_char = m2t_consume_char(lexer->infile);
+      *token = TOKEN_RIGHT_BRACE;
+      break;
+      
+    case '~' :
+      /* tilde synonym */
+      if (M2T_OPTION_IN_SET(lexer->options, M2T_OPTION_SYNONYMS)) {
         next_char = m2t_consume_char(lexer->infile);
-        token = TOKEN_RIGHT_BRACE;
-        break;
-        
-      case '~' :
-        /* tilde synonym */
-        if (m2t_option_synonyms()) {
-          next_char = m2t_consume_char(lexer->infile);
-          token = TOKEN_NOT;
-        }
-        else /* invalid char */ {
-          report_error_w_offending_char
-            (M2T_ERROR_INVALID_INPUT_CHAR, lexer, line, column, next_char);
-          next_char = m2t_consume_char(lexer->infile);
-          token = TOKEN_UNKNOWN;
-        } /* end if */
-        break;
-                
-      default :
-        /* invalid character */
-        report_error_w_offending_char
-          (M2T_ERROR_INVALID_INPUT_CHAR, lexer, line, column, next_char);
+        *token = TOKEN_NOT;
+      }
+      else /* invalid char */ {
+        report_error_w_char_at_offset
+          (M2T_ERROR_INVALID_INPUT_CHAR, lexer, offset, next_char);
         next_char = m2t_consume_char(lexer->infile);
-        token = TOKEN_UNKNOWN;
-    } /* end switch */
+        *token = TOKEN_UNKNOWN;
+      } /* end if */
+      break;
+              
+    default :
+      /* invalid character */
+      report_error_w_char_at_offset
+        (M2T_ERROR_INVALID_INPUT_CHAR, lexer, offset, next_char);
+      next_char = m2t_consume_char(lexer->infile);
+      *token = TOKEN_UNKNOWN;
+  } /* end switch */
+  
+  return next_char;
+} /* end get_operator */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure next_lookahead_sym(lexer)
+ * --------------------------------------------------------------------------
+ * Makes the symbol following the lookahead symbol the new lookahead symbol,
+ * taking it from the token stream if lexer has been pre-tokenized and the
+ * stream is not exhausted, otherwise lexing it from the input.
+ * ----------------------------------------------------------------------- */
+
+static void next_lookahead_sym (m2t_lexer_t lexer) {
+  
+  m2t_token_stream_t *stream;
+  uint_t pos;
+  
+  /* pipelined */
+  if (lexer->pipeline != NULL) {
+    next_piped_sym(lexer);
+    return;
+  } /* end if */
+  
+  stream = lexer->stream;
+  
+  /* not pre-tokenized, or stream exhausted */
+  if ((stream == NULL) || (lexer->lookahead_shared == false)) {
+    get_new_lookahead_sym(lexer);
+    return;
+  } /* end if */
+  
+  pos = lexer->stream_pos + 1;
+  
+  if (pos < stream->count) {
+    lexer->stream_pos = pos;
+    lexer->lookahead.token = stream->token[pos];
+    lexer->lookahead.offset = stream->offset[pos];
+    lexer->lookahead.lexeme = stream->lexeme[pos];
+  }
+  else if (stream->has_pending) {
+    /* symbol that did not fit into the stream */
+    lexer->lookahead = stream->pending;
+    lexer->lookahead_shared = false;
+    stream->has_pending = false;
+  }
+  else if (stream->token[stream->count - 1] == TOKEN_END_OF_FILE) {
+    /* keep returning end-of-file */
+    lexer->lookahead.lexeme = NULL;
+  }
+  else /* continue on demand */ {
+    lexer->lookahead_shared = false;
+    get_new_lookahead_sym(lexer);
+  } /* end if */
+  
+  return;
+} /* end next_lookahead_sym */
+
+
+/* --------------------------------------------------------------------------
+ * private function append_to_stream(stream, symbol)
+ * --------------------------------------------------------------------------
+ * Appends symbol to stream, growing the stream if necessary.  Ownership of
+ * the symbol's lexeme passes to the stream.  Returns true on success, or
+ * false if the stream could not be grown.
+ * ----------------------------------------------------------------------- */
+
+static bool append_to_stream
+  (m2t_token_stream_t *stream, m2t_symbol_struct_t *symbol) {
+  
+  m2t_token_t *new_token;
+  uint32_t *new_offset;
+  uint_t new_size;
+  m2t_string_t *new_lexeme;
+  
+  /* grow arrays if full */
+  if (stream->count == stream->size) {
+    if (stream->size == 0) {
+      new_size = M2T_TOKEN_STREAM_INITIAL_SIZE;
+    }
+    else {
+      new_size = 2 * stream->size;
+    } /* end if */
+    
+    new_token = realloc(stream->token, new_size * sizeof(m2t_token_t));
+    if (new_token == NULL) {
+      return false;
+    } /* end if */
+    stream->token = new_token;
+    
+    new_offset = realloc(stream->offset, new_size * sizeof(uint32_t));
+    if (new_offset == NULL) {
+      return false;
+    } /* end if */
+    stream->offset = new_offset;
+    
+    new_lexeme = realloc(stream->lexeme, new_size * sizeof(m2t_string_t));
+    if (new_lexeme == NULL) {
+      return false;
+    } /* end if */
+    stream->lexeme = new_lexeme;
+    
+    stream->size = new_size;
+  } /* end if */
+  
+  stream->token[stream->count] = symbol->token;
+  stream->offset[stream->count] = symbol->offset;
+  stream->lexeme[stream->count] = symbol->lexeme;
+  stream->count++;
+  
+  return true;
+} /* end append_to_stream */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure release_stream(stream)
+ * --------------------------------------------------------------------------
+ * Releases all lexemes owned by stream and deallocates stream.
+ * ----------------------------------------------------------------------- */
+
+static void release_stream (m2t_token_stream_t *stream) {
+  
+  uint_t index;
+  
+  for (index = 0; index < stream->count; index++) {
+    m2t_string_release(stream->lexeme[index]);
+  } /* end for */
+  
+  if (stream->has_pending) {
+    m2t_string_release(stream->pending.lexeme);
+  } /* end if */
+  
+  free(stream->token);
+  free(stream->offset);
+  free(stream->lexeme);
+  free(stream);
+  
+  return;
+} /* end release_stream */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure next_piped_sym(lexer)
+ * --------------------------------------------------------------------------
+ * Makes the next symbol passed from the lexer thread of the pipeline of
+ * lexer the new lookahead symbol, waiting for the thread if necessary.
+ * Drained blocks are passed back to the lexer thread.
+ * ----------------------------------------------------------------------- */
+
+static void next_piped_sym (m2t_lexer_t lexer) {
+  
+  m2t_lexer_pipeline_t *pipeline;
+  m2t_symbol_block_t *block;
+  
+  /* keep returning end-of-file */
+  if (lexer->lookahead.token == TOKEN_END_OF_FILE) {
+    lexer->lookahead.lexeme = NULL;
+    return;
+  } /* end if */
+  
+  pipeline = lexer->pipeline;
+  block = pipeline->block;
+  
+  if ((block == NULL) || (pipeline->index == block->count)) {
+    
+    /* pass drained block back for reuse */
+    if (block != NULL) {
+      m2t_fifo_spsc_enqueue(pipeline->empty, block);
+    } /* end if */
+    
+    /* wait for the next block */
+    while ((block = m2t_fifo_spsc_dequeue(pipeline->full)) == NULL) {
+      M2C_THREAD_YIELD();
+    } /* end while */
+    
+    pipeline->block = block;
+    pipeline->index = 0;
+  } /* end if */
+  
+  /* ownership of the lexeme passes to lexer */
+  lexer->lookahead = block->symbol[pipeline->index];
+  lexer->lookahead_shared = false;
+  pipeline->index++;
+  
+  return;
+} /* end next_piped_sym */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure pipeline_loop(pipeline)
+ * --------------------------------------------------------------------------
+ * Body of the lexer thread of pipeline.  Fills blocks with symbols lexed
+ * by the scanner of pipeline and passes them on, until the end-of-file
+ * symbol has been passed on or the parser stops the pipeline.
+ * ----------------------------------------------------------------------- */
+
+static void pipeline_loop (m2t_lexer_pipeline_t *pipeline) {
+  
+  m2t_lexer_t scanner;
+  m2t_symbol_block_t *block;
+  bool done;
+  
+  scanner = pipeline->scanner;
+  done = false;
+  
+  while (done == false) {
+    block = obtain_block(pipeline);
+    
+    /* stopped by the parser */
+    if (block == NULL) {
+      return;
+    } /* end if */
+    
+    M2C_LOCK_ACQUIRE(&pipeline->lock);
+    
+    if (pipeline->stop) {
+      M2C_LOCK_RELEASE(&pipeline->lock);
+      free(block);
+      return;
+    } /* end if */
+    
+    /* fill block, the lookahead lexeme passes to the block */
+    block->count = 0;
+    while ((done == false) && (block->count < M2T_PIPELINE_BLOCK_SIZE)) {
+      get_new_lookahead_sym(scanner);
+      block->symbol[block->count] = scanner->lookahead;
+      block->count++;
+      done = (scanner->lookahead.token == TOKEN_END_OF_FILE);
+    } /* end while */
+    scanner->lookahead.lexeme = NULL;
+    
+    M2C_LOCK_RELEASE(&pipeline->lock);
+    
+    m2t_fifo_spsc_enqueue(pipeline->full, block);
   } /* end while */
   
-  /* update lexer's lookahead symbol */
-  lexer->lookahead.token = token;
-  lexer->lookahead.line = line;
-  lexer->lookahead.column = column;
+  return;
+} /* end pipeline_loop */
+
+
+/* --------------------------------------------------------------------------
+ * private function obtain_block(pipeline)
+ * --------------------------------------------------------------------------
+ * Returns a block passed back by the parser, or a newly allocated block if
+ * fewer than M2T_PIPELINE_BLOCK_COUNT blocks are in use, otherwise waits
+ * for the parser to pass back a block.  If allocation fails, it also waits
+ * and retries.  Returns NULL if the parser stops the pipeline while it is
+ * waiting.  Lexer thread only.
+ * ----------------------------------------------------------------------- */
+
+static m2t_symbol_block_t *obtain_block (m2t_lexer_pipeline_t *pipeline) {
+  
+  m2t_symbol_block_t *block;
+  bool stop;
+  
+  while (true) {
+    block = m2t_fifo_spsc_dequeue(pipeline->empty);
+    
+    if (block != NULL) {
+      return block;
+    } /* end if */
+    
+    if (pipeline->block_count < M2T_PIPELINE_BLOCK_COUNT) {
+      block = malloc(sizeof(m2t_symbol_block_t));
+      
+      if (block != NULL) {
+        pipeline->block_count++;
+        return block;
+      } /* end if */
+    } /* end if */
+    
+    M2C_LOCK_ACQUIRE(&pipeline->lock);
+    stop = pipeline->stop;
+    M2C_LOCK_RELEASE(&pipeline->lock);
+    
+    if (stop) {
+      return NULL;
+    } /* end if */
+    
+    M2C_THREAD_YIELD();
+  } /* end while */
+} /* end obtain_block */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure release_pipeline(pipeline)
+ * --------------------------------------------------------------------------
+ * Stops the lexer thread of pipeline, releases the lexemes of all symbols
+ * not yet taken by the parser and deallocates pipeline with its blocks.
+ * ----------------------------------------------------------------------- */
+
+static void release_pipeline (m2t_lexer_pipeline_t *pipeline) {
+  
+  m2t_symbol_block_t *block;
+  
+  M2C_LOCK_ACQUIRE(&pipeline->lock);
+  pipeline->stop = true;
+  M2C_LOCK_RELEASE(&pipeline->lock);
+  
+#if (M2T_LEXER_THREADS)
+  m2c_thread_join(&pipeline->thread);
+#endif
+  
+  /* block being drained by the parser */
+  if (pipeline->block != NULL) {
+    release_block(pipeline->block, pipeline->index);
+  } /* end if */
+  
+  /* blocks not yet taken by the parser */
+  while ((block = m2t_fifo_spsc_dequeue(pipeline->full)) != NULL) {
+    release_block(block, 0);
+  } /* end while */
+  
+  /* blocks passed back but not yet reused */
+  while ((block = m2t_fifo_spsc_dequeue(pipeline->empty)) != NULL) {
+    free(block);
+  } /* end while */
+  
+  m2t_fifo_spsc_release_queue(pipeline->full);
+  m2t_fifo_spsc_release_queue(pipeline->empty);
+  M2C_LOCK_DISPOSE(&pipeline->lock);
+  free(pipeline->scanner);
+  free(pipeline);
   
   return;
-} /* end get_new_lookahead_sym */
+} /* end release_pipeline */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure release_block(block, index)
+ * --------------------------------------------------------------------------
+ * Releases the lexemes of the symbols of block from index onwards and
+ * deallocates block.
+ * ----------------------------------------------------------------------- */
+
+static void release_block (m2t_symbol_block_t *block, uint_t index) {
+  
+  while (index < block->count) {
+    m2t_string_release(block->symbol[index].lexeme);
+    index++;
+  } /* end while */
+  
+  free(block);
+  
+  return;
+} /* end release_block */
+
+
+#if (M2T_LEXER_THREADS)
+/* --------------------------------------------------------------------------
+ * private procedure pipeline_main(arg)
+ * --------------------------------------------------------------------------
+ * Entry point of the lexer thread of the pipeline passed in arg.
+ * ----------------------------------------------------------------------- */
+
+static void pipeline_main (void *arg) {
+  
+  pipeline_loop(arg);
+} /* end pipeline_main */
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * private function consume_char_run(lexer, run, delimiter)
+ * --------------------------------------------------------------------------
+ * Consumes the lookahead character together with all following characters
+ * that belong to character class run and returns the new lookahead
+ * character.  The lookahead character is consumed even if it does not
+ * belong to run.
+ * ----------------------------------------------------------------------- */
+
+static char consume_char_run
+  (m2t_lexer_t lexer, m2t_infile_run_t run, char delimiter) {
+  
+  if (m2t_consume_run(lexer->infile, run, delimiter) == 0) {
+    return m2t_consume_char(lexer->infile);
+  } /* end if */
+  
+  return m2t_next_char(lexer->infile);
+} /* end consume_char_run */
 
 
 /* --------------------------------------------------------------------------
@@ -907,7 +2448,7 @@ static char skip_code_section (m2t_lexer_t lexer) {
   char next_char;
   
   /* remember line number for warning */
-  first_line = m2t_infile_current_line(lexer->infile);
+  first_line = infile_line(lexer);
   
   /* consume opening '?' and '<' */
   next_char = m2t_consume_char(lexer->infile);
@@ -917,7 +2458,7 @@ static char skip_code_section (m2t_lexer_t lexer) {
     
     /* check for closing delimiter */
     if ((next_char == '>') && (m2t_la2_char(lexer->infile) == '?') &&
-       /* first column */ (m2t_infile_current_column(lexer->infile) == 1)) {
+       /* first column */ (infile_column(lexer) == 1)) {
       
       /* closing delimiter */
       delimiter_found = true;
@@ -928,15 +2469,15 @@ static char skip_code_section (m2t_lexer_t lexer) {
       break;
     } /* end if */
     
-    /* check for illegal control characters */
-    if ((IS_CONTROL_CHAR(next_char)) &&
+    /* check for illegal control characters, unless input is validated */
+    if ((!lexer->validated) && (IS_CONTROL_CHAR(next_char)) &&
         (next_char != ASCII_TAB) &&
         (next_char != ASCII_LF)) {
       /* invalid input character */
       report_error_w_offending_char
         (M2T_ERROR_INVALID_INPUT_CHAR, lexer,
-         m2t_infile_current_line(lexer->infile),
-         m2t_infile_current_column(lexer->infile), next_char);
+         infile_line(lexer),
+         infile_column(lexer), next_char);
     } /* end if */
     
     next_char = m2t_consume_char(lexer->infile);
@@ -945,7 +2486,7 @@ static char skip_code_section (m2t_lexer_t lexer) {
   /* disabled code section warning */
   m2t_emit_warning_w_range
     (M2T_WARN_DISABLED_CODE_SECTION,
-     first_line, m2t_infile_current_line(lexer->infile));
+     first_line, infile_line(lexer));
   
   return next_char;
 } /* end skip_code_section */
@@ -964,16 +2505,18 @@ static char skip_line_comment(m2t_lexer_t lexer) {
   
   while ((next_char != ASCII_LF) && (!IS_EOF(lexer, next_char))) {
     
-    /* check for illegal characters */
-    if (IS_CONTROL_CHAR(next_char) && (next_char != ASCII_TAB)) {
+    /* check for illegal characters, unless input is validated */
+    if ((!lexer->validated) &&
+        IS_CONTROL_CHAR(next_char) && (next_char != ASCII_TAB)) {
       /* invalid input character */
       report_error_w_offending_char
         (M2T_ERROR_INVALID_INPUT_CHAR, lexer,
-         m2t_infile_current_line(lexer->infile),
-         m2t_infile_current_column(lexer->infile), next_char);
+         infile_line(lexer),
+         infile_column(lexer), next_char);
     } /* end if */
   
-    next_char = m2t_consume_char(lexer->infile);
+    next_char =
+      consume_char_run(lexer, M2T_INFILE_RUN_LINE_COMMENT, ASCII_NUL);
   } /* end while */
   
   return next_char;
@@ -1017,12 +2560,13 @@ static char skip_block_comment(m2t_lexer_t lexer) {
     else if ((!IS_CONTROL_CHAR(next_char)) ||
              (next_char == ASCII_TAB) ||
              (next_char == ASCII_LF)) {
-      next_char = m2t_consume_char(lexer->infile);
+      next_char =
+        consume_char_run(lexer, M2T_INFILE_RUN_COMMENT_TEXT, ASCII_NUL);
     }
     
     else /* error */ {
-      line = m2t_infile_current_line(lexer->infile);
-      column = m2t_infile_current_column(lexer->infile);
+      line = infile_line(lexer);
+      column = infile_column(lexer);
       
       /* end-of-file reached */
       if (IS_EOF(lexer, next_char)) {
@@ -1041,6 +2585,66 @@ static char skip_block_comment(m2t_lexer_t lexer) {
 } /* end skip_block_comment */
 
 
+/* --------------------------------------------------------------------------
+ * private procedure record_comment(lexer, offset)
+ * --------------------------------------------------------------------------
+ * Records the comment that started at offset and ends at the reading
+ * position of the input in the comment table of lexer, if any.  Offset is
+ * relative to the input.  The comment text itself is not copied.
+ * ----------------------------------------------------------------------- */
+
+static void record_comment (m2t_lexer_t lexer, uint32_t offset) {
+  
+#if (M2T_COMMENT_PRESRVN_IMPLEMENTED)
+  uint32_t end;
+  
+  if (lexer->comments == NULL) {
+    return;
+  } /* end if */
+  
+  end = (uint32_t) m2t_infile_current_offset(lexer->infile);
+  
+  m2t_comment_table_add
+    (lexer->comments, lexer->base_offset + offset, end - offset);
+#endif
+  
+  return;
+} /* end record_comment */
+
+
+/* --------------------------------------------------------------------------
+ * private function LEXEME_WANTED(lexer, token)
+ * --------------------------------------------------------------------------
+ * Returns true unless lexer skips to a resync set without element token.
+ * ----------------------------------------------------------------------- */
+
+#define LEXEME_WANTED(_lexer,_token) \
+  (((_lexer)->skip_set == NULL) || \
+   (m2t_tokenset_element(*(_lexer)->skip_set, (_token))))
+
+
+/* --------------------------------------------------------------------------
+ * private procedure get_lexeme(lexer, token)
+ * --------------------------------------------------------------------------
+ * Sets the lexeme of the lookahead symbol to the marked lexeme if it is
+ * wanted for token, otherwise discards the marked lexeme.
+ * ----------------------------------------------------------------------- */
+
+static void get_lexeme (m2t_lexer_t lexer, m2t_token_t token) {
+  
+  uint_t length;
+  
+  if (LEXEME_WANTED(lexer, token)) {
+    lexer->lookahead.lexeme = m2t_read_marked_lexeme(lexer->infile);
+  }
+  else {
+    m2t_skip_marked_lexeme(lexer->infile, &length);
+  } /* end if */
+  
+  return;
+} /* end get_lexeme */
+
+
 /* --------------------------------------------------------------------------
  * private function get_pragma(lexer)
  * ----------------------------------------------------------------------- */
@@ -1069,7 +2673,7 @@ static char get_pragma(m2t_lexer_t lexer) {
       next_char = m2t_consume_char(lexer->infile);
       
       /* get lexeme */
-      lexer->lookahead.lexeme = m2t_read_marked_lexeme(lexer->infile);
+      get_lexeme(lexer, TOKEN_PRAGMA);
     }
     
     /* other non-control characters */
@@ -1078,8 +2682,8 @@ static char get_pragma(m2t_lexer_t lexer) {
     }
     
     else /* error */ {
-      line = m2t_infile_current_line(lexer->infile);
-      column = m2t_infile_current_column(lexer->infile);
+      line = infile_line(lexer);
+      column = infile_column(lexer);
       
       /* end-of-file reached */
       if (IS_EOF(lexer, next_char)) {
@@ -1100,83 +2704,123 @@ static char get_pragma(m2t_lexer_t lexer) {
 
 
 /* --------------------------------------------------------------------------
- * private function get_ident(lexer)
+ * private function scan_ident(lexer, lowline)
+ * --------------------------------------------------------------------------
+ * Lexes an identifier, permitting lowlines within it if lowline is true.
+ * Only ever called with a constant for lowline, thus every caller obtains
+ * a copy specialised for its dialect without a run time option check.
  * ----------------------------------------------------------------------- */
 
-static char get_ident(m2t_lexer_t lexer) {
+static inline char scan_ident (m2t_lexer_t lexer, bool lowline) {
   
   char next_char;
-  char next_next_char;
   
   m2t_mark_lexeme(lexer->infile);
-  next_char = m2t_consume_char(lexer->infile);
-  next_next_char = m2t_la2_char(lexer->infile);
   
-  /* lowline enabled */
-  if (m2t_option_lowline_identifiers()) {
-    while (IS_ALPHANUMERIC(next_char) ||
-           (next_char == '_' && IS_ALPHANUMERIC(next_next_char))) {
-      next_char = m2t_consume_char(lexer->infile);
-      next_next_char = m2t_la2_char(lexer->infile);
-    } /* end while */
-  }
+  /* consume first character and all following letters and digits */
+  next_char = consume_char_run(lexer, M2T_INFILE_RUN_IDENT_CHARS, ASCII_NUL);
   
-  /* lowline disabled */
-  else {
-    while (IS_ALPHANUMERIC(next_char)) {
-      next_char = m2t_consume_char(lexer->infile);
+  /* lowline enabled */
+  if (lowline) {
+    while ((next_char == '_') &&
+           CHAR_IN_CLASS(m2t_la2_char(lexer->infile), CC_IDENT_CHAR)) {
+      
+      /* consume lowline and all following letters and digits */
+      m2t_consume_char(lexer->infile);
+      next_char =
+        consume_char_run(lexer, M2T_INFILE_RUN_IDENT_CHARS, ASCII_NUL);
     } /* end while */
   } /* end if */
   
   /* get lexeme */
-  lexer->lookahead.lexeme = m2t_read_marked_lexeme(lexer->infile);
+  get_lexeme(lexer, TOKEN_IDENTIFIER);
     
   return next_char;
+} /* end scan_ident */
+
+
+/* --------------------------------------------------------------------------
+ * private function get_ident(lexer)
+ * ----------------------------------------------------------------------- */
+
+static char get_ident (m2t_lexer_t lexer) {
+  return scan_ident(lexer, false);
 } /* end get_ident */
 
 
 /* --------------------------------------------------------------------------
- * private function get_ident_or_resword(lexer)
+ * private function get_ident_w_lowline(lexer)
  * ----------------------------------------------------------------------- */
 
-#define IS_NOT_UPPER(c) \
-  (((c) < 'A') || ((c) > 'Z'))
+static char get_ident_w_lowline (m2t_lexer_t lexer) {
+  return scan_ident(lexer, true);
+} /* end get_ident_w_lowline */
+
 
-static char get_ident_or_resword(m2t_lexer_t lexer, m2t_token_t *token) {
+/* --------------------------------------------------------------------------
+ * private function scan_ident_or_resword(lexer, token, lowline)
+ * --------------------------------------------------------------------------
+ * Lexes an identifier or reserved word, permitting lowlines within
+ * identifiers if lowline is true.  Only ever called with a constant for
+ * lowline, like scan_ident().
+ * ----------------------------------------------------------------------- */
+
+static inline char scan_ident_or_resword
+  (m2t_lexer_t lexer, m2t_token_t *token, bool lowline) {
   
   m2t_token_t intermediate_token;
   bool possibly_resword = true;
+  const char *char_ptr;
+  uint_t length;
   char next_char;
-  char next_next_char;
   
   m2t_mark_lexeme(lexer->infile);
+  
+  /* consume leading uppercase letters */
+  m2t_consume_run(lexer->infile, M2T_INFILE_RUN_UPPER_CHARS, ASCII_NUL);
+  
+  /* consume any following letters and digits */
+  if (m2t_consume_run
+       (lexer->infile, M2T_INFILE_RUN_IDENT_CHARS, ASCII_NUL) > 0) {
+    possibly_resword = false;
+  } /* end if */
+  
   next_char = m2t_next_char(lexer->infile);
-  next_next_char = m2t_la2_char(lexer->infile);
   
   /* lowline enabled */
-  if (m2t_option_lowline_identifiers()) {
-    while (IS_ALPHANUMERIC(next_char) ||
-           (next_char == '_' && IS_ALPHANUMERIC(next_next_char))) {
+  if (lowline) {
+    while ((next_char == '_') &&
+           CHAR_IN_CLASS(m2t_la2_char(lexer->infile), CC_IDENT_CHAR)) {
       
-      if (IS_NOT_UPPER(next_char)) {
-        possibly_resword = false;
-      } /* end if */
+      possibly_resword = false;
       
-      next_char = m2t_consume_char(lexer->infile);
-      next_next_char = m2t_la2_char(lexer->infile);
+      /* consume lowline and all following letters and digits */
+      m2t_consume_char(lexer->infile);
+      next_char =
+        consume_char_run(lexer, M2T_INFILE_RUN_IDENT_CHARS, ASCII_NUL);
     } /* end while */
-  }
+  } /* end if */
   
-  /* lowline disabled */
-  else {
-    while (IS_ALPHANUMERIC(next_char)) {
-      
-      if (IS_NOT_UPPER(next_char)) {
-        possibly_resword = false;
+  /* skipping identifiers, recognise reserved words without lexeme */
+  if (!LEXEME_WANTED(lexer, TOKEN_IDENTIFIER)) {
+    char_ptr = m2t_skip_marked_lexeme(lexer->infile, &length);
+    intermediate_token = TOKEN_IDENTIFIER;
+    
+    if (possibly_resword && (char_ptr != NULL)) {
+      intermediate_token = m2t_token_for_resword(char_ptr, length);
+      if (intermediate_token == TOKEN_UNKNOWN) {
+        intermediate_token = TOKEN_IDENTIFIER;
       } /* end if */
-      
-      next_char = m2t_consume_char(lexer->infile);
-    } /* end while */
+    } /* end if */
+    
+    /* create the lexeme if the symbol ends the skip */
+    if ((char_ptr != NULL) && LEXEME_WANTED(lexer, intermediate_token)) {
+      lexer->lookahead.lexeme =
+        m2t_get_string_for_slice(char_ptr, 0, length, NULL);
+    } /* end if */
+    
+    *token = intermediate_token;
+    return next_char;
   } /* end if */
   
   /* get lexeme */
@@ -1200,13 +2844,37 @@ static char get_ident_or_resword(m2t_lexer_t lexer, m2t_token_t *token) {
   } /* end if */
   
   return next_char;
+} /* end scan_ident_or_resword */
+
+
+/* --------------------------------------------------------------------------
+ * private function get_ident_or_resword(lexer, token)
+ * ----------------------------------------------------------------------- */
+
+static char get_ident_or_resword (m2t_lexer_t lexer, m2t_token_t *token) {
+  return scan_ident_or_resword(lexer, token, false);
 } /* end get_ident_or_resword */
 
+
+/* --------------------------------------------------------------------------
+ * private function get_ident_or_resword_w_lowline(lexer, token)
+ * ----------------------------------------------------------------------- */
+
+static char get_ident_or_resword_w_lowline
+  (m2t_lexer_t lexer, m2t_token_t *token) {
+  return scan_ident_or_resword(lexer, token, true);
+} /* end get_ident_or_resword_w_lowline */
+
+
 /* --------------------------------------------------------------------------
- * private function get_string_literal(lexer)
+ * private function scan_string_literal(lexer, token, escapes)
+ * --------------------------------------------------------------------------
+ * Lexes a string literal, interpreting escape sequences if escapes is true.
+ * Only ever called with a constant for escapes, like scan_ident().
  * ----------------------------------------------------------------------- */
 
-static char get_string_literal(m2t_lexer_t lexer, m2t_token_t *token) {
+static inline char scan_string_literal
+  (m2t_lexer_t lexer, m2t_token_t *token, bool escapes) {
   
   uint_t line, column;
   m2t_token_t intermediate_token;
@@ -1224,8 +2892,8 @@ static char get_string_literal(m2t_lexer_t lexer, m2t_token_t *token) {
     
     /* check for control character */
     if (IS_CONTROL_CHAR(next_char)) {
-      line = m2t_infile_current_line(lexer->infile);
-      column = m2t_infile_current_column(lexer->infile);
+      line = infile_line(lexer);
+      column = infile_column(lexer);
       
       intermediate_token = TOKEN_MALFORMED_STRING;
       
@@ -1248,9 +2916,9 @@ static char get_string_literal(m2t_lexer_t lexer, m2t_token_t *token) {
       } /* end if */
     } /* end if */
     
-    if (m2t_option_escape_tab_and_newline() && (next_char == '\\')) {
-      line = m2t_infile_current_line(lexer->infile);
-      column = m2t_infile_current_column(lexer->infile);
+    if (escapes && (next_char == '\\')) {
+      line = infile_line(lexer);
+      column = infile_column(lexer);
       next_char = m2t_consume_char(lexer->infile);
       
       if ((next_char != 'n') && (next_char != 't') && (next_char != '\\')) {
@@ -1261,11 +2929,12 @@ static char get_string_literal(m2t_lexer_t lexer, m2t_token_t *token) {
       } /* end if */
     } /* end if */
     
-    next_char = m2t_consume_char(lexer->infile);
+    next_char =
+      consume_char_run(lexer, M2T_INFILE_RUN_QUOTED_TEXT, string_delimiter);
   } /* end while */
   
   /* get lexeme */
-  lexer->lookahead.lexeme = m2t_read_marked_lexeme(lexer->infile);
+  get_lexeme(lexer, intermediate_token);
   
   /* consume closing delimiter */
   if (next_char == string_delimiter) {
@@ -1276,26 +2945,56 @@ static char get_string_literal(m2t_lexer_t lexer, m2t_token_t *token) {
   *token = intermediate_token;
   
   return next_char;
+} /* end scan_string_literal */
+
+
+/* --------------------------------------------------------------------------
+ * private function get_string_literal(lexer, token)
+ * ----------------------------------------------------------------------- */
+
+static char get_string_literal (m2t_lexer_t lexer, m2t_token_t *token) {
+  return scan_string_literal(lexer, token, false);
 } /* end get_string_literal */
 
 
+/* --------------------------------------------------------------------------
+ * private function get_string_literal_w_escapes(lexer, token)
+ * ----------------------------------------------------------------------- */
+
+static char get_string_literal_w_escapes
+  (m2t_lexer_t lexer, m2t_token_t *token) {
+  return scan_string_literal(lexer, token, true);
+} /* end get_string_literal_w_escapes */
+
+
 /* --------------------------------------------------------------------------
  * private function get_prefixed_number_literal(lexer, token)
+ * --------------------------------------------------------------------------
+ * Lexes a number literal in prefix notation.  Digits are consumed as runs
+ * by the file reader and whole number values are converted from the
+ * marked characters before the lexeme is interned.
  * ----------------------------------------------------------------------- */
 
 static char get_prefixed_number_literal
   (m2t_lexer_t lexer, m2t_token_t *token) {
   
   m2t_token_t intermediate_token;
+  m2t_literal_t literal;
+  const char *digits;
+  bool converted;
+  uint_t length;
   char next_char, la2_char;
   
+  converted = false;
+  literal.kind = M2T_LITERAL_WHOLE;
+  
   m2t_mark_lexeme(lexer->infile);
   next_char = m2t_next_char(lexer->infile);
   la2_char = m2t_la2_char(lexer->infile);
   
   if /* prefix for base-16 integer or character code found */
-    ((next_char == 0) && ((la2_char == 'x') || (la2_char == 'u'))) {
-
+    ((next_char == '0') && ((la2_char == 'x') || (la2_char == 'u'))) {
+  
     /* consume '0' */
     next_char = m2t_consume_char(lexer->infile);
     
@@ -1307,19 +3006,23 @@ static char get_prefixed_number_literal
     } /* end if */
    
     /* consume prefix */
-    next_char = m2t_consume_char(lexer->infile);
+    m2t_consume_char(lexer->infile);
     
     /* consume all digits */
-    while (IS_DIGIT(next_char) || IS_A_TO_F(next_char)) {
-      next_char = m2t_consume_char(lexer->infile);
-    } /* end while */
+    m2t_consume_run(lexer->infile, M2T_INFILE_RUN_HEX_DIGITS, ASCII_NUL);
+    next_char = m2t_next_char(lexer->infile);
+    
+    digits = m2t_marked_chars(lexer->infile, &length);
+    if ((digits != NULL) && (length > 2)) {
+      converted =
+        m2t_hex_value(digits + 2, length - 2, &literal.value.whole);
+    } /* end if */
   }
   else /* decimal integer or real number */ {
     
     /* consume all digits */
-    while (IS_DIGIT(next_char)) {
-      next_char = m2t_consume_char(lexer->infile);
-    } /* end while */
+    m2t_consume_run(lexer->infile, M2T_INFILE_RUN_DECIMAL_DIGITS, ASCII_NUL);
+    next_char = m2t_next_char(lexer->infile);
     
     if /* real number literal found */ 
       ((next_char == '.') && (m2t_la2_char(lexer->infile) != '.')) {
@@ -1329,11 +3032,19 @@ static char get_prefixed_number_literal
     }
     else {
       intermediate_token = TOKEN_INTEGER;
+      
+      digits = m2t_marked_chars(lexer->infile, &length);
+      if (digits != NULL) {
+        converted = m2t_decimal_value(digits, length, &literal.value.whole);
+      } /* end if */
     } /* end if */
   } /* end if */
   
   /* get lexeme */
-  lexer->lookahead.lexeme = m2t_read_marked_lexeme(lexer->infile);
+  get_lexeme(lexer, intermediate_token);
+  
+  /* record value */
+  enter_literal(lexer, intermediate_token, (converted) ? &literal : NULL);
   
   /* pass back token */
   *token = intermediate_token;
@@ -1344,44 +3055,51 @@ static char get_prefixed_number_literal
 
 /* --------------------------------------------------------------------------
  * private function get_suffixed_number_literal(lexer, token)
+ * --------------------------------------------------------------------------
+ * Lexes a number literal in suffix notation.  The leading run of digits
+ * and letters 'A' to 'F' is consumed by the file reader and classified
+ * eight characters at a time to determine the base of the literal.  Whole
+ * number values are converted from the marked characters before the
+ * lexeme is interned.  A literal too long to remain in the file reader's
+ * window cannot be classified and is reported as malformed.
  * ----------------------------------------------------------------------- */
 
 static char get_suffixed_number_literal
   (m2t_lexer_t lexer, m2t_token_t *token) {
   
   m2t_token_t intermediate_token;
-  uint_t char_count_0_to_7 = 0;
-  uint_t char_count_8_to_9 = 0;
-  uint_t char_count_A_to_F = 0;
+  m2t_literal_t literal;
+  const char *digits;
+  uint_t length, classes;
+  bool converted;
   char next_char, last_char;
   
+  converted = false;
+  literal.kind = M2T_LITERAL_WHOLE;
+  
   m2t_mark_lexeme(lexer->infile);
-  next_char = m2t_next_char(lexer->infile);
   
   /* consume any characters '0' to '9' and 'A' to 'F' */
-  while (IS_DIGIT(next_char) || IS_A_TO_F(next_char)) {
+  m2t_consume_run(lexer->infile, M2T_INFILE_RUN_HEX_DIGITS, ASCII_NUL);
+  next_char = m2t_next_char(lexer->infile);
+  
+  digits = m2t_marked_chars(lexer->infile, &length);
+  
+  if /* digits evicted */ ((digits == NULL) || (length == 0)) {
+    intermediate_token = TOKEN_MALFORMED_INTEGER;
     
-    if ((next_char >= '0') && (next_char <= '7')) {
-      char_count_0_to_7++;
-    }
-    else if ((next_char == '8') || (next_char == '9')) {
-      char_count_8_to_9++;
-    }
-    else {
-      char_count_A_to_F++;
+    if (next_char == 'H') {
+      next_char = m2t_consume_char(lexer->infile);
     } /* end if */
-    
-    last_char = next_char;
-    next_char = m2t_consume_char(lexer->infile);
-  } /* end while */
-  
-  if /* base-16 integer found */ (next_char == 'H') {
+  }
+  else if /* base-16 integer found */ (next_char == 'H') {
     
     next_char = m2t_consume_char(lexer->infile);
     intermediate_token = TOKEN_INTEGER;
+    converted = m2t_hex_value(digits, length, &literal.value.whole);
   }
   else if /* base-10 integer or real number found */
-    (char_count_A_to_F == 0) {
+    ((m2t_digit_classes(digits, length) & M2T_DIGITS_HAVE_A_TO_F) == 0) {
     
     if /* real number literal found */ 
       ((next_char == '.') && (m2t_la2_char(lexer->infile) != '.')) {
@@ -1391,26 +3109,37 @@ static char get_suffixed_number_literal
     }
     else /* decimal integer found */ {
       intermediate_token = TOKEN_INTEGER;
+      converted = m2t_decimal_value(digits, length, &literal.value.whole);
     } /* end if */
   }
-  else if /* base-8 integer found */
-    (m2t_option_octal_literals() &&
-     (char_count_8_to_9 == 0) && (char_count_A_to_F == 1) && 
-     ((last_char == 'B') || (last_char == 'C'))) {
+  else {
+    last_char = digits[length - 1];
+    classes = m2t_digit_classes(digits, length - 1);
     
-    if (last_char == 'B') {
-      intermediate_token = TOKEN_INTEGER;
+    if /* base-8 integer found */
+      (M2T_OPTION_IN_SET(lexer->options, M2T_OPTION_OCTAL_LITERALS) &&
+       (classes == 0) && ((last_char == 'B') || (last_char == 'C'))) {
+      
+      if (last_char == 'B') {
+        intermediate_token = TOKEN_INTEGER;
+      }
+      else /* last_char == 'C' */ {
+        intermediate_token = TOKEN_CHAR;
+      } /* end if */
+      
+      converted =
+        m2t_octal_value(digits, length - 1, &literal.value.whole);
     }
-    else /* last_char == 'C' */ {
-      intermediate_token = TOKEN_CHAR;
-    } /* end if */    
-  }
-  else /* malformed base-16 integer */ {
-    intermediate_token = TOKEN_MALFORMED_INTEGER;
+    else /* malformed base-16 integer */ {
+      intermediate_token = TOKEN_MALFORMED_INTEGER;
+    } /* end if */
   } /* end if */
   
   /* get lexeme */
-  lexer->lookahead.lexeme = m2t_read_marked_lexeme(lexer->infile);
+  get_lexeme(lexer, intermediate_token);
+  
+  /* record value */
+  enter_literal(lexer, intermediate_token, (converted) ? &literal : NULL);
   
   /* pass back token */
   *token = intermediate_token;
@@ -1430,12 +3159,11 @@ static char get_number_literal_fractional_part
   char next_char;
     
   /* consume the decimal point */
-  next_char = m2t_consume_char(lexer->infile);
+  m2t_consume_char(lexer->infile);
   
   /* consume any fractional digits */
-  while (IS_DIGIT(next_char)) {
-    next_char = m2t_consume_char(lexer->infile);
-  } /* end if */
+  m2t_consume_run(lexer->infile, M2T_INFILE_RUN_DECIMAL_DIGITS, ASCII_NUL);
+  next_char = m2t_next_char(lexer->infile);
   
   if /* exponent prefix found */ (next_char == 'E') {
   
@@ -1449,12 +3177,12 @@ static char get_number_literal_fractional_part
       next_char = m2t_consume_char(lexer->infile);
     } /* end if */
     
-    if /* exponent digits found */ (IS_DIGIT(next_char)) {
+    if /* exponent digits found */ (CHAR_IN_CLASS(next_char, CC_DIGIT)) {
     
       /* consume exponent digits */
-      while (IS_DIGIT(next_char)) {
-        next_char = m2t_consume_char(lexer->infile);
-      } /* end while */
+      m2t_consume_run
+        (lexer->infile, M2T_INFILE_RUN_DECIMAL_DIGITS, ASCII_NUL);
+      next_char = m2t_next_char(lexer->infile);
     }
     else /* exponent digits missing */ {
       intermediate_token = TOKEN_MALFORMED_REAL;
@@ -1468,4 +3196,37 @@ static char get_number_literal_fractional_part
 } /* end get_number_literal_fractional_part */
 
 
+/* --------------------------------------------------------------------------
+ * private procedure enter_literal(lexer, token, literal)
+ * --------------------------------------------------------------------------
+ * Records the value of the number literal just lexed in the literal
+ * repository, keyed by the lookahead lexeme.  Parameter literal holds the
+ * converted value of a whole number literal, or NULL if it could not be
+ * converted.  Real number values are converted from the lexeme.  Nothing
+ * is recorded if the lexeme has not been interned.
+ * ----------------------------------------------------------------------- */
+
+static void enter_literal
+  (m2t_lexer_t lexer, m2t_token_t token, const m2t_literal_t *literal) {
+  
+  m2t_literal_t real_literal;
+  
+  if (lexer->lookahead.lexeme == NULL) {
+    return;
+  } /* end if */
+  
+  if (token == TOKEN_REAL) {
+    real_literal.kind = M2T_LITERAL_REAL;
+    real_literal.value.real =
+      strtod(m2t_string_char_ptr(lexer->lookahead.lexeme), NULL);
+    m2t_literal_enter(lexer->lookahead.lexeme, &real_literal);
+  }
+  else if (literal != NULL) {
+    m2t_literal_enter(lexer->lookahead.lexeme, literal);
+  } /* end if */
+  
+  return;
+} /* end enter_literal */
+
+
 /* END OF FILE */
@@ -0,0 +1,552 @@
+/* M2T -- Sorce to Source Modula-2 Translator
+ *
+ * Copyright (c) 2016-2023 Benjamin Kowarsch
+ *
+ * Author & Maintainer: Benjamin Kowarsch <org.m2sf>
+ *
+ * @synopsis
+ *
+ * M2T is a multi-dialect Modula-2 source-to-source translator. It translates
+ * source files  written in the  classic dialects  to semantically equivalent
+ * source files in  Modula-2 Revision 2010 (M2R10).  It supports  the classic
+ * Modula-2 dialects  described in  the 2nd, 3rd and 4th editions  of Niklaus
+ * Wirth's book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * For more details please visit: https://github.com/trijezdci/m2t/wiki
+ *
+ * @repository
+ *
+ * https://github.com/trijezdci/m2t
+ *
+ * @file
+ *
+ * m2t-literals.c
+ *
+ * Implementation of M2T number literal values.
+ *
+ * @license
+ *
+ * M2T is free software:  You can redistribute and modify it  under the terms
+ * of the  GNU Lesser General Public License (LGPL) either version 2.1  or at
+ * your choice version 3, both as published by the Free Software Foundation.
+ *
+ * M2T is distributed  in the hope  that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even  the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received  a copy of the  GNU Lesser General Public License
+ * along with M2T.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+
+#include "m2t-literals.h"
+#include "m2-thread.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* --------------------------------------------------------------------------
+ * Initial capacity and maximum load of the literal repository
+ * ----------------------------------------------------------------------- */
+
+#define M2T_LITERAL_REPO_INIT_CAPACITY 256
+
+#define M2T_LITERAL_REPO_MAX_LOAD_PERCENT 75
+
+
+/* --------------------------------------------------------------------------
+ * Word constants for eight characters at a time
+ * ----------------------------------------------------------------------- */
+
+#define REPEAT_BYTE(_byte) (0x0101010101010101ULL * (_byte))
+
+#define LOW_NIBBLES REPEAT_BYTE(0x0F)
+
+
+/* --------------------------------------------------------------------------
+ * private type m2t_literal_entry_s
+ * --------------------------------------------------------------------------
+ * record type representing a slot of the literal repository.  A slot is
+ * empty if its lexeme is NULL.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* lexeme */ m2t_string_t lexeme;
+  /* literal */ m2t_literal_t literal;
+} m2t_literal_entry_s;
+
+
+/* --------------------------------------------------------------------------
+ * private type m2t_literal_repo_s
+ * --------------------------------------------------------------------------
+ * record type representing the literal repository.  The repository is an
+ * open addressing table with linear probing, keyed by interned lexeme.
+ * The capacity is a power of two.  Values are never removed.  The lock
+ * is taken because pipelined lexers record values from their own threads.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* lock */ m2c_lock_t lock;
+  /* capacity */ uint_t capacity;
+  /* used */ uint_t used;
+  /* slot */ m2t_literal_entry_s *slot;
+} m2t_literal_repo_s;
+
+
+/* --------------------------------------------------------------------------
+ * Literal repository
+ * ----------------------------------------------------------------------- */
+
+static m2t_literal_repo_s *repository = NULL;
+
+
+/* --------------------------------------------------------------------------
+ * Forward declarations
+ * ----------------------------------------------------------------------- */
+
+static inline uint_t home_slot (m2t_string_t lexeme, uint_t mask);
+
+static uint_t repo_probe (m2t_string_t lexeme);
+
+static bool repo_reserve (void);
+
+static inline uint64_t load_word (const char *chars, uint_t length);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_init_literal_repository()
+ * --------------------------------------------------------------------------
+ * Allocates and initialises the global literal repository.  Returns true
+ * on success or if the repository is already initialised, false if it
+ * could not be allocated.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_init_literal_repository (void) {
+  
+  m2t_literal_repo_s *new_repo;
+  
+  if (repository != NULL) {
+    return true;
+  } /* end if */
+  
+  new_repo = malloc(sizeof(m2t_literal_repo_s));
+  
+  if (new_repo == NULL) {
+    return false;
+  } /* end if */
+  
+  new_repo->slot =
+    calloc(M2T_LITERAL_REPO_INIT_CAPACITY, sizeof(m2t_literal_entry_s));
+  
+  if (new_repo->slot == NULL) {
+    free(new_repo);
+    return false;
+  } /* end if */
+  
+  M2C_LOCK_INIT(&new_repo->lock);
+  new_repo->capacity = M2T_LITERAL_REPO_INIT_CAPACITY;
+  new_repo->used = 0;
+  
+  repository = new_repo;
+  
+  return true;
+} /* end m2t_init_literal_repository */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_literal_enter(lexeme, literal)
+ * --------------------------------------------------------------------------
+ * Records literal as the value of lexeme, retaining lexeme.  Returns true
+ * on success, or false if the repository is not initialised, if lexeme or
+ * literal is NULL or if the repository could not be grown.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_literal_enter (m2t_string_t lexeme, const m2t_literal_t *literal) {
+  
+  uint_t slot;
+  
+  if ((repository == NULL) || (lexeme == NULL) || (literal == NULL)) {
+    return false;
+  } /* end if */
+  
+  M2C_LOCK_ACQUIRE(&repository->lock);
+  
+  if (NOT(repo_reserve())) {
+    M2C_LOCK_RELEASE(&repository->lock);
+    return false;
+  } /* end if */
+  
+  slot = repo_probe(lexeme);
+  
+  /* the value of an interned lexeme never changes */
+  if (repository->slot[slot].lexeme == NULL) {
+    m2t_string_retain(lexeme);
+    repository->slot[slot].lexeme = lexeme;
+    repository->slot[slot].literal = *literal;
+    repository->used++;
+  } /* end if */
+  
+  M2C_LOCK_RELEASE(&repository->lock);
+  
+  return true;
+} /* end m2t_literal_enter */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_literal_lookup(lexeme, literal)
+ * --------------------------------------------------------------------------
+ * Passes the value recorded for lexeme back in literal and returns true.
+ * Returns false and leaves literal unmodified if no value is recorded for
+ * lexeme or if the repository is not initialised.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_literal_lookup (m2t_string_t lexeme, m2t_literal_t *literal) {
+  
+  bool found;
+  uint_t slot;
+  
+  if ((repository == NULL) || (lexeme == NULL)) {
+    return false;
+  } /* end if */
+  
+  M2C_LOCK_ACQUIRE(&repository->lock);
+  
+  slot = repo_probe(lexeme);
+  found = (repository->slot[slot].lexeme != NULL);
+  
+  if ((found) && (literal != NULL)) {
+    *literal = repository->slot[slot].literal;
+  } /* end if */
+  
+  M2C_LOCK_RELEASE(&repository->lock);
+  
+  return found;
+} /* end m2t_literal_lookup */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_literal_count()
+ * --------------------------------------------------------------------------
+ * Returns the number of values recorded in the literal repository.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2t_literal_count (void) {
+  
+  if (repository == NULL) {
+    return 0;
+  } /* end if */
+  
+  return repository->used;
+} /* end m2t_literal_count */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_dispose_literal_repository()
+ * --------------------------------------------------------------------------
+ * Deallocates the global literal repository and releases its lexemes.
+ * ----------------------------------------------------------------------- */
+
+void m2t_dispose_literal_repository (void) {
+  
+  uint_t slot;
+  
+  if (repository == NULL) {
+    return;
+  } /* end if */
+  
+  for (slot = 0; slot < repository->capacity; slot++) {
+    if (repository->slot[slot].lexeme != NULL) {
+      m2t_string_release(repository->slot[slot].lexeme);
+    } /* end if */
+  } /* end for */
+  
+  M2C_LOCK_DISPOSE(&repository->lock);
+  free(repository->slot);
+  free(repository);
+  repository = NULL;
+  
+  return;
+} /* end m2t_dispose_literal_repository */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_digit_classes(digits, length)
+ * --------------------------------------------------------------------------
+ * Returns the set of digit classes found in the sequence of the given
+ * length at digits.  Among characters '0' to '9' and 'A' to 'F', only the
+ * letters have bit 6 set and only digits '8' and '9' have bit 3 set, thus
+ * eight characters are classified by two masks at a time.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2t_digit_classes (const char *digits, uint_t length) {
+  
+  uint64_t bits, word;
+  uint_t count, classes;
+  
+  bits = 0;
+  
+  while (length > 0) {
+    count = (length < sizeof(uint64_t)) ? length : sizeof(uint64_t);
+    word = load_word(digits, count);
+    bits = bits | word;
+    digits = digits + count;
+    length = length - count;
+  } /* end while */
+  
+  classes = 0;
+  
+  if ((bits & REPEAT_BYTE(0x08)) != 0) {
+    classes = classes | M2T_DIGITS_HAVE_8_OR_9;
+  } /* end if */
+  
+  if ((bits & REPEAT_BYTE(0x40)) != 0) {
+    classes = classes | M2T_DIGITS_HAVE_A_TO_F;
+  } /* end if */
+  
+  return classes;
+} /* end m2t_digit_classes */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_decimal_value(digits, length, value)
+ * --------------------------------------------------------------------------
+ * Converts the sequence of decimal digits of the given length at digits
+ * and passes the result back in value.  Eight digits are converted at a
+ * time by combining adjacent digits, pairs and quads of digits within a
+ * word.  Returns false if the result does not fit 64 bits.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_decimal_value (const char *digits, uint_t length, uint64_t *value) {
+  
+  uint64_t result, chunk, scale;
+  uint_t count, index;
+  
+  result = 0;
+  
+  while (length > 0) {
+    
+    if (length >= sizeof(uint64_t)) {
+      count = sizeof(uint64_t);
+      chunk = load_word(digits, count) - REPEAT_BYTE('0');
+      chunk = ((chunk * 10) + (chunk >> 8)) & 0x00FF00FF00FF00FFULL;
+      chunk = ((chunk * 100) + (chunk >> 16)) & 0x0000FFFF0000FFFFULL;
+      chunk = ((chunk * 10000) + (chunk >> 32)) & 0x00000000FFFFFFFFULL;
+      scale = 100000000;
+    }
+    else /* fewer than eight digits left */ {
+      count = length;
+      chunk = 0;
+      scale = 1;
+      for (index = 0; index < count; index++) {
+        chunk = (chunk * 10) + (uint64_t) (digits[index] - '0');
+        scale = scale * 10;
+      } /* end for */
+    } /* end if */
+    
+    if (result > ((UINT64_MAX - chunk) / scale)) {
+      return false;
+    } /* end if */
+    
+    result = (result * scale) + chunk;
+    digits = digits + count;
+    length = length - count;
+  } /* end while */
+  
+  *value = result;
+  
+  return true;
+} /* end m2t_decimal_value */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_octal_value(digits, length, value)
+ * --------------------------------------------------------------------------
+ * Converts the sequence of octal digits of the given length at digits and
+ * passes the result back in value.  Returns false if the result does not
+ * fit 64 bits.  Octal literals are rare, they are converted digit by digit.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_octal_value (const char *digits, uint_t length, uint64_t *value) {
+  
+  uint64_t result;
+  uint_t index;
+  
+  result = 0;
+  
+  for (index = 0; index < length; index++) {
+    if ((result >> 61) != 0) {
+      return false;
+    } /* end if */
+    
+    result = (result << 3) | (uint64_t) (digits[index] - '0');
+  } /* end for */
+  
+  *value = result;
+  
+  return true;
+} /* end m2t_octal_value */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_hex_value(digits, length, value)
+ * --------------------------------------------------------------------------
+ * Converts the sequence of hexadecimal digits of the given length at digits
+ * and passes the result back in value.  Eight digits are converted at a
+ * time, each character is mapped to its nibble, then adjacent nibbles,
+ * bytes and halfwords are packed within a word.  Returns false if the
+ * result does not fit 64 bits.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_hex_value (const char *digits, uint_t length, uint64_t *value) {
+  
+  uint64_t result, word;
+  uint_t count;
+  
+  result = 0;
+  
+  while (length > 0) {
+    count = (length < sizeof(uint64_t)) ? length : sizeof(uint64_t);
+    word = load_word(digits, count);
+    
+    /* map characters to nibbles, letters 'A' to 'F' have bit 6 set */
+    word = (word & LOW_NIBBLES) + (((word & REPEAT_BYTE(0x40)) >> 6) * 9);
+    
+    /* pack nibbles, the first character is the most significant */
+    word = ((word & 0x000F000F000F000FULL) << 4) |
+      ((word >> 8) & 0x000F000F000F000FULL);
+    word = ((word & 0x000000FF000000FFULL) << 8) |
+      ((word >> 16) & 0x000000FF000000FFULL);
+    word = ((word & 0x000000000000FFFFULL) << 16) |
+      ((word >> 32) & 0x000000000000FFFFULL);
+    
+    /* discard the nibbles of padding */
+    word = word >> (4 * (sizeof(uint64_t) - count));
+    
+    if ((result >> (64 - (4 * count))) != 0) {
+      return false;
+    } /* end if */
+    
+    result = (result << (4 * count)) | word;
+    digits = digits + count;
+    length = length - count;
+  } /* end while */
+  
+  *value = result;
+  
+  return true;
+} /* end m2t_hex_value */
+
+
+/* ************************************************************************ *
+ * Private Functions                                                        *
+ * ************************************************************************ */
+
+/* --------------------------------------------------------------------------
+ * private function home_slot(lexeme, mask)
+ * --------------------------------------------------------------------------
+ * Returns the home slot of lexeme for a table with capacity mask + 1.
+ * ----------------------------------------------------------------------- */
+
+static inline uint_t home_slot (m2t_string_t lexeme, uint_t mask) {
+  
+  uint64_t key;
+  
+  key = ((uint64_t) (uintptr_t) lexeme) * 0x9E3779B97F4A7C15ULL;
+  
+  return ((uint_t) (key >> 32)) & mask;
+} /* end home_slot */
+
+
+/* --------------------------------------------------------------------------
+ * private function repo_probe(lexeme)
+ * --------------------------------------------------------------------------
+ * Returns the slot of lexeme in the repository, or the empty slot where
+ * lexeme would be stored if lexeme is not present.
+ * ----------------------------------------------------------------------- */
+
+static uint_t repo_probe (m2t_string_t lexeme) {
+  
+  uint_t slot, mask;
+  
+  mask = repository->capacity - 1;
+  slot = home_slot(lexeme, mask);
+  
+  while ((repository->slot[slot].lexeme != NULL) &&
+         (repository->slot[slot].lexeme != lexeme)) {
+    slot = (slot + 1) & mask;
+  } /* end while */
+  
+  return slot;
+} /* end repo_probe */
+
+
+/* --------------------------------------------------------------------------
+ * private function repo_reserve()
+ * --------------------------------------------------------------------------
+ * Makes room for one more lexeme in the repository, doubling its capacity
+ * if the maximum load would otherwise be exceeded.  Returns false if the
+ * repository needed to grow but could not be grown.
+ * ----------------------------------------------------------------------- */
+
+static bool repo_reserve (void) {
+  
+  m2t_literal_entry_s *old_slot;
+  uint_t old_capacity, slot, new_slot;
+  
+  if (((repository->used + 1) * 100) <=
+      (repository->capacity * M2T_LITERAL_REPO_MAX_LOAD_PERCENT)) {
+    return true;
+  } /* end if */
+  
+  old_slot = repository->slot;
+  old_capacity = repository->capacity;
+  
+  repository->slot = calloc(2 * old_capacity, sizeof(m2t_literal_entry_s));
+  
+  if (repository->slot == NULL) {
+    repository->slot = old_slot;
+    return false;
+  } /* end if */
+  
+  repository->capacity = 2 * old_capacity;
+  
+  /* rehash occupied slots */
+  for (slot = 0; slot < old_capacity; slot++) {
+    if (old_slot[slot].lexeme != NULL) {
+      new_slot = repo_probe(old_slot[slot].lexeme);
+      repository->slot[new_slot] = old_slot[slot];
+    } /* end if */
+  } /* end for */
+  
+  free(old_slot);
+  
+  return true;
+} /* end repo_reserve */
+
+
+/* --------------------------------------------------------------------------
+ * private function load_word(chars, length)
+ * --------------------------------------------------------------------------
+ * Returns a word holding the length characters at chars, at most eight,
+ * with the first character in the least significant byte.  Bytes beyond
+ * length are zero.
+ * ----------------------------------------------------------------------- */
+
+static inline uint64_t load_word (const char *chars, uint_t length) {
+  
+  uint64_t word;
+  
+  word = 0;
+  memcpy(&word, chars, length);
+  
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+  word = __builtin_bswap64(word);
+#endif
+  
+  return word;
+} /* end load_word */
+
+
+/* END OF FILE */
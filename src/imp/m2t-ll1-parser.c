@@ -0,0 +1,292 @@
+/* M2T -- Sorce to Source Modula-2 Translator
+ *
+ * Copyright (c) 2016-2023 Benjamin Kowarsch
+ *
+ * Author & Maintainer: Benjamin Kowarsch <org.m2sf>
+ *
+ * @synopsis
+ *
+ * M2T is a multi-dialect Modula-2 source-to-source translator. It translates
+ * source files  written in the  classic dialects  to semantically equivalent
+ * source files in  Modula-2 Revision 2010 (M2R10).  It supports  the classic
+ * Modula-2 dialects  described in  the 2nd, 3rd and 4th editions  of Niklaus
+ * Wirth's book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * For more details please visit: https://github.com/trijezdci/m2t/wiki
+ *
+ * @repository
+ *
+ * https://github.com/trijezdci/m2t
+ *
+ * @file
+ *
+ * m2t-ll1-parser.c
+ *
+ * Implementation of M2T table driven LL(1) parser engine.
+ *
+ * @license
+ *
+ * M2T is free software:  You can redistribute and modify it  under the terms
+ * of the  GNU Lesser General Public License (LGPL) either version 2.1  or at
+ * your choice version 3, both as published by the Free Software Foundation.
+ *
+ * M2T is distributed  in the hope  that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even  the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received  a copy of the  GNU Lesser General Public License
+ * along with M2T.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#include "m2t-ll1-parser.h"
+
+#include "m2t-error.h"
+#include "m2t-tokenset.h"
+#include "m2t-option-flags.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+
+/* --------------------------------------------------------------------------
+ * private variables for parser tables
+ * --------------------------------------------------------------------------
+ * Tables generated by gen/m2t-gen-ll1.c from grammar/m2-grammar.gll
+ * ----------------------------------------------------------------------- */
+
+#include "m2t-ll1-tables.h"
+
+
+/* --------------------------------------------------------------------------
+ * Parser stack
+ * --------------------------------------------------------------------------
+ * The parser stack holds grammar symbols, terminals are encoded by their
+ * token value and nonterminals by M2T_LL1_NONTERMINAL_BASE plus their
+ * index.  The stack grows as needed, starting at the initial capacity.
+ * ----------------------------------------------------------------------- */
+
+#define M2T_LL1_INITIAL_STACK_CAPACITY 256
+
+#define IS_NONTERMINAL(_sym) ((_sym) >= M2T_LL1_NONTERMINAL_BASE)
+
+
+/* --------------------------------------------------------------------------
+ * Forward declarations
+ * ----------------------------------------------------------------------- */
+
+static void report_mismatch
+  (m2t_lexer_t lexer, m2t_token_t lookahead, m2t_token_t expected_token);
+
+static void report_no_alternative
+  (m2t_lexer_t lexer, m2t_token_t lookahead, m2t_tokenset_t expected_set);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_ll1_parse(srctype, lexer, status)
+ * --------------------------------------------------------------------------
+ * Parses the source read by lexer with the table driven LL(1) parser engine
+ * and returns the number of syntax errors found.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2t_ll1_parse
+  (m2t_sourcetype_t srctype,
+   m2t_lexer_t lexer,
+   m2t_parser_status_t *status) {
+  
+  uint16_t *stack, *new_stack;
+  uint_t top, capacity, dialect, nt, rule, length, index;
+  uint_t symbol, error_count;
+  m2t_token_t lookahead;
+  
+  /* dialect 0 is PIM2 with export lists, dialect 1 is PIM3/4 */
+  if (M2T_OPTION_IN_SET(m2t_lexer_options(lexer), M2T_OPTION_EXPORT_LISTS)) {
+    dialect = 0;
+  }
+  else {
+    dialect = 1;
+  } /* end if */
+  
+  lookahead = m2t_next_sym(lexer);
+  
+  /* select start symbol */
+  switch (srctype) {
+    case M2T_DEF_SOURCE :
+      symbol = M2T_LL1_START_DEFINITION_MODULE;
+      break;
+  
+    case M2T_MOD_SOURCE :
+      if (lookahead == TOKEN_IMPLEMENTATION) {
+        symbol = M2T_LL1_START_IMPLEMENTATION_MODULE;
+      }
+      else {
+        symbol = M2T_LL1_START_PROGRAM_MODULE;
+      } /* end if */
+      break;
+  
+    default :
+      symbol = M2T_LL1_START_COMPILATION_UNIT;
+  } /* end switch */
+  
+  /* set up parser stack */
+  capacity = M2T_LL1_INITIAL_STACK_CAPACITY;
+  stack = malloc(capacity * sizeof(uint16_t));
+  
+  if (stack == NULL) {
+    SET_STATUS(status, M2T_PARSER_STATUS_ALLOCATION_FAILED);
+    return 0;
+  } /* end if */
+  
+  stack[0] = (uint16_t) symbol;
+  top = 1;
+  error_count = 0;
+  
+  while (top > 0) {
+    top--;
+    symbol = stack[top];
+  
+    /* terminal symbol */
+    if (!IS_NONTERMINAL(symbol)) {
+      if (lookahead == symbol) {
+        lookahead = m2t_consume_sym(lexer);
+      }
+      else /* mismatch */ {
+        /* report and assume the missing symbol was inserted */
+        report_mismatch(lexer, lookahead, symbol);
+        error_count++;
+  
+        /* abandon the source once the error limit has been reached */
+        if (m2t_error_limit_reached()) {
+          top = 0;
+        } /* end if */
+      } /* end if */
+      continue;
+    } /* end if */
+  
+    /* nonterminal symbol, select dialect definition and predict rule */
+    nt = symbol - M2T_LL1_NONTERMINAL_BASE;
+    nt = m2t_ll1_dialect_nonterminal[dialect][nt];
+    rule = m2t_ll1_predict[nt][lookahead];
+  
+    if (m2t_option_parser_debug()) {
+      printf("*** %s ***\n  @ line: %u, column: %u, lookahead: %s\n",
+        m2t_ll1_nonterminal_name[nt],
+        m2t_lexer_lookahead_line(lexer),
+        m2t_lexer_lookahead_column(lexer),
+        m2t_name_for_token(lookahead));
+    } /* end if */
+  
+    if (rule == 0) {
+      report_no_alternative(lexer, lookahead, m2t_ll1_expected_set[nt]);
+      error_count++;
+  
+      /* abandon the source once the error limit has been reached */
+      if (m2t_error_limit_reached()) {
+        top = 0;
+        continue;
+      } /* end if */
+  
+      /* skip symbols until lookahead can start or follow nt */
+      lookahead = m2t_lexer_skip_to_set(lexer,
+        m2t_tokenset_union(m2t_ll1_expected_set[nt], m2t_ll1_resync_set[nt]));
+  
+      /* retry if nt can now be predicted, otherwise abandon it */
+      if (m2t_ll1_predict[nt][lookahead] != 0) {
+        top++;
+      } /* end if */
+      continue;
+    } /* end if */
+  
+    /* replace nt by the right hand side of its rule */
+    rule--;
+    length = m2t_ll1_rhs_start[rule + 1] - m2t_ll1_rhs_start[rule];
+  
+    if (top + length > capacity) {
+      new_stack = realloc(stack, 2 * capacity * sizeof(uint16_t));
+      if (new_stack == NULL) {
+        free(stack);
+        SET_STATUS(status, M2T_PARSER_STATUS_ALLOCATION_FAILED);
+        return error_count;
+      } /* end if */
+      stack = new_stack;
+      capacity = 2 * capacity;
+    } /* end if */
+  
+    /* right hand sides are stored in reverse order */
+    index = m2t_ll1_rhs_start[rule];
+    while (length > 0) {
+      stack[top] = m2t_ll1_rhs[index];
+      top++;
+      index++;
+      length--;
+    } /* end while */
+  } /* end while */
+  
+  /* extra symbols after end of compilation unit */
+  if (lookahead != TOKEN_END_OF_FILE) {
+    report_mismatch(lexer, lookahead, TOKEN_END_OF_FILE);
+    error_count++;
+  } /* end if */
+  
+  free(stack);
+  SET_STATUS(status, M2T_PARSER_STATUS_SUCCESS);
+  return error_count;
+} /* end m2t_ll1_parse */
+
+
+/* --------------------------------------------------------------------------
+ * Private Functions
+ * ----------------------------------------------------------------------- */
+
+/* --------------------------------------------------------------------------
+ * private procedure report_mismatch(lexer, lookahead, expected_token)
+ * --------------------------------------------------------------------------
+ * Reports a syntax error for lookahead where expected_token was expected.
+ * ----------------------------------------------------------------------- */
+
+static void report_mismatch
+  (m2t_lexer_t lexer, m2t_token_t lookahead, m2t_token_t expected_token) {
+  
+  uint_t line, column;
+  const char *lexstr;
+  
+  line = m2t_lexer_lookahead_line(lexer);
+  column = m2t_lexer_lookahead_column(lexer);
+  lexstr = m2t_string_char_ptr(m2t_lexer_lookahead_lexeme(lexer));
+  
+  m2t_emit_syntax_error_w_token
+    (line, column, lookahead, lexstr, expected_token);
+  
+  if (m2t_option_verbose()) {
+    m2t_print_line_and_mark_column(lexer, line, column);
+  } /* end if */
+} /* end report_mismatch */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure report_no_alternative(lexer, lookahead, expected_set)
+ * --------------------------------------------------------------------------
+ * Reports a syntax error for lookahead where a symbol in expected_set was
+ * expected.
+ * ----------------------------------------------------------------------- */
+
+static void report_no_alternative
+  (m2t_lexer_t lexer, m2t_token_t lookahead, m2t_tokenset_t expected_set) {
+  
+  uint_t line, column;
+  const char *lexstr;
+  
+  line = m2t_lexer_lookahead_line(lexer);
+  column = m2t_lexer_lookahead_column(lexer);
+  lexstr = m2t_string_char_ptr(m2t_lexer_lookahead_lexeme(lexer));
+  
+  m2t_emit_syntax_error_w_set
+    (line, column, lookahead, lexstr, expected_set);
+  
+  if (m2t_option_verbose()) {
+    m2t_print_line_and_mark_column(lexer, line, column);
+  } /* end if */
+} /* end report_no_alternative */
+
+
+/* END OF FILE */
@@ -38,10 +38,11 @@
  * along with M2T.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
  */
 
-#include "m2t-options-flags.h"
+#include "m2t-option-flags.h"
 
 #include "m2t-common.h"
 #include "m2t-error.h"
+#include "m2-alloc-stats.h"
 
 #include <stdio.h>
 
@@ -67,8 +68,22 @@ typedef struct {
   bool coroutines;
   bool variant_records;
   bool local_modules;
+  bool lowline_identifiers;
+  bool line_comments;
+  bool prefix_literals;
   bool lexer_debug;
   bool parser_debug;
+  bool pretokenize;
+  bool ll1_parser;
+  bool profile;
+  bool pipeline;
+  bool machine_diagnostics;
+  bool stream_ast;
+  bool stats;
+  bool timing;
+  bool server;
+  bool parallel_parse;
+  bool r10_output;
 } m2t_compiler_options_struct_t;
 
 
@@ -91,8 +106,22 @@ typedef struct {
   /* coroutines  */ false, \
   /* variant-records */ false, \
   /* local-modules */ false, \
+  /* lowline-identifiers */ false, \
+  /* line-comments */ false, \
+  /* prefix-literals */ false, \
   /* lexer-debug */ false, \
-  /* parser-debug */ false \
+  /* parser-debug */ false, \
+  /* pretokenize */ false, \
+  /* ll1-parser */ false, \
+  /* profile */ false, \
+  /* pipeline */ false, \
+  /* machine-diagnostics */ false, \
+  /* stream-ast */ false, \
+  /* stats */ false, \
+  /* timing */ false, \
+  /* server */ false, \
+  /* parallel-parse */ false, \
+  /* r10-output */ false \
 } /* default_options */
 
 #define M2T_PIM2_OPTIONS { \
@@ -110,8 +139,23 @@ typedef struct {
   /* coroutines  */ true, \
   /* variant-records */ true, \
   /* local-modules */ true, \
+  /* lowline-identifiers */ false, \
+  /* line-comments */ false, \
+  /* prefix-literals */ false, \
   /* lexer-debug */ false, \
-  /* parser-debug */ false \
+  /* parser-debug */ false, \
+  /* pretokenize */ false, \
+  /* ll1-parser */ false, \
+  /* profile */ false, \
+  /* pipeline */ false, \
+  /* machine-diagnostics */ false, \
+  /* stream-ast */ false, \
+  /* stats */ false, \
+  /* timing */ false, \
+  /* server */ false, \
+  /* parallel-parse */ false, \
+  /* r10-output */ false \
+} /* pim2_options */
 
 #define M2T_PIM3_OPTIONS { \
   /* verbose */ false, \
@@ -128,8 +172,22 @@ typedef struct {
   /* coroutines  */ true, \
   /* variant-records */ true, \
   /* local-modules */ true, \
+  /* lowline-identifiers */ false, \
+  /* line-comments */ false, \
+  /* prefix-literals */ false, \
   /* lexer-debug */ false, \
-  /* parser-debug */ false \
+  /* parser-debug */ false, \
+  /* pretokenize */ false, \
+  /* ll1-parser */ false, \
+  /* profile */ false, \
+  /* pipeline */ false, \
+  /* machine-diagnostics */ false, \
+  /* stream-ast */ false, \
+  /* stats */ false, \
+  /* timing */ false, \
+  /* server */ false, \
+  /* parallel-parse */ false, \
+  /* r10-output */ false \
 } /* default_options */
 
 #define M2T_PIM4_OPTIONS { \
@@ -147,8 +205,22 @@ typedef struct {
   /* coroutines  */ true, \
   /* variant-records */ true, \
   /* local-modules */ true, \
+  /* lowline-identifiers */ false, \
+  /* line-comments */ false, \
+  /* prefix-literals */ false, \
   /* lexer-debug */ false, \
-  /* parser-debug */ false \
+  /* parser-debug */ false, \
+  /* pretokenize */ false, \
+  /* ll1-parser */ false, \
+  /* profile */ false, \
+  /* pipeline */ false, \
+  /* machine-diagnostics */ false, \
+  /* stream-ast */ false, \
+  /* stats */ false, \
+  /* timing */ false, \
+  /* server */ false, \
+  /* parallel-parse */ false, \
+  /* r10-output */ false \
 } /* default_options */
 
 
@@ -167,6 +239,13 @@ static m2t_compiler_options_struct_t pim3_options = M2T_PIM3_OPTIONS;
 static m2t_compiler_options_struct_t pim4_options = M2T_PIM4_OPTIONS;
 
 
+/* --------------------------------------------------------------------------
+ * Maximum number of errors, zero means no limit, not affected by dialects
+ * ----------------------------------------------------------------------- */
+
+static uint_t max_errors = 0;
+
+
 /* --------------------------------------------------------------------------
  * forward declarations
  * ----------------------------------------------------------------------- */
@@ -177,6 +256,8 @@ static bool opt_match (const char* str1, const char* str2);
 
 static void report_invalid_option (const char *optstr);
 
+static bool get_count (const char *str, uint_t *count);
+
 
 /* --------------------------------------------------------------------------
  * function m2t_get_cli_args(argc, argv, status)
@@ -270,6 +351,77 @@ const char *m2t_get_cli_args
         pim3_options.parser_debug = true;
         pim4_options.parser_debug = true;
       }
+      else if (opt_match(optstr, "--pretokenize")) {
+        options.pretokenize = true;
+        pim2_options.pretokenize = true;
+        pim3_options.pretokenize = true;
+        pim4_options.pretokenize = true;
+      }
+      else if (opt_match(optstr, "--ll1-parser")) {
+        options.ll1_parser = true;
+        pim2_options.ll1_parser = true;
+        pim3_options.ll1_parser = true;
+        pim4_options.ll1_parser = true;
+      }
+      else if (opt_match(optstr, "--profile")) {
+        options.profile = true;
+        pim2_options.profile = true;
+        pim3_options.profile = true;
+        pim4_options.profile = true;
+      }
+      else if (opt_match(optstr, "--stats")) {
+        options.stats = true;
+        pim2_options.stats = true;
+        pim3_options.stats = true;
+        pim4_options.stats = true;
+        m2c_alloc_stats_enable(true);
+      }
+      else if (opt_match(optstr, "--timing")) {
+        options.timing = true;
+        pim2_options.timing = true;
+        pim3_options.timing = true;
+        pim4_options.timing = true;
+      }
+      else if (opt_match(optstr, "--server")) {
+        options.server = true;
+        pim2_options.server = true;
+        pim3_options.server = true;
+        pim4_options.server = true;
+      }
+      else if (opt_match(optstr, "--parallel-parse")) {
+        options.parallel_parse = true;
+        pim2_options.parallel_parse = true;
+        pim3_options.parallel_parse = true;
+        pim4_options.parallel_parse = true;
+      }
+      else if (opt_match(optstr, "--pipeline")) {
+        options.pipeline = true;
+        pim2_options.pipeline = true;
+        pim3_options.pipeline = true;
+        pim4_options.pipeline = true;
+      }
+      else if (opt_match(optstr, "--machine-diagnostics")) {
+        options.machine_diagnostics = true;
+        pim2_options.machine_diagnostics = true;
+        pim3_options.machine_diagnostics = true;
+        pim4_options.machine_diagnostics = true;
+      }
+      else if ((opt_match(optstr, "--max-errors")) && (index + 1 < argc) &&
+               (get_count(argv[index + 1], &max_errors))) {
+        index++;
+      }
+      else if (opt_match(optstr, "--stream-ast")) {
+        options.stream_ast = true;
+        pim2_options.stream_ast = true;
+        pim3_options.stream_ast = true;
+        pim4_options.stream_ast = true;
+      }
+      else if (opt_match(optstr, "--r10-output")) {
+        options.r10_output = true;
+        pim2_options.r10_output = true;
+        pim3_options.r10_output = true;
+        pim4_options.r10_output = true;
+      }
       else if ((permit_pim_option) && (opt_match(optstr, "--pim2"))) {
         options = pim2_options;
         no_dialect_set = false;
@@ -360,6 +512,24 @@ const char *m2t_get_cli_args
       else if (opt_match(optstr, "--no-local-modules")) {
         options.local_modules = false;
       }
+      else if (opt_match(optstr, "--lowline-identifiers")) {
+        options.lowline_identifiers = true;
+      }
+      else if (opt_match(optstr, "--no-lowline-identifiers")) {
+        options.lowline_identifiers = false;
+      }
+      else if (opt_match(optstr, "--line-comments")) {
+        options.line_comments = true;
+      }
+      else if (opt_match(optstr, "--no-line-comments")) {
+        options.line_comments = false;
+      }
+      else if (opt_match(optstr, "--prefix-literals")) {
+        options.prefix_literals = true;
+      }
+      else if (opt_match(optstr, "--suffix-literals")) {
+        options.prefix_literals = false;
+      }
       else {
         report_invalid_option(optstr);
         error_count++;
@@ -415,8 +585,37 @@ void m2t_print_options(void) {
     print_bool(options.variant_records); printf("\n");
   printf(" local-modules: ");
     print_bool(options.local_modules); printf("\n");
+  printf(" lowline-identifiers: ");
+    print_bool(options.lowline_identifiers); printf("\n");
+  printf(" line-comments: ");
+    print_bool(options.line_comments); printf("\n");
+  printf(" prefix-literals: ");
+    print_bool(options.prefix_literals); printf("\n");
   printf(" parser-debug: ");
     print_bool(options.parser_debug); printf("\n");
+  printf(" r10-output: ");
+    print_bool(options.r10_output); printf("\n");
+  printf(" stream-ast: ");
+    print_bool(options.stream_ast); printf("\n");
+  printf(" machine-diagnostics: ");
+    print_bool(options.machine_diagnostics); printf("\n");
+  printf(" pipeline: ");
+    print_bool(options.pipeline); printf("\n");
+  printf(" pretokenize: ");
+    print_bool(options.pretokenize); printf("\n");
+  printf(" ll1-parser: ");
+    print_bool(options.ll1_parser); printf("\n");
+  printf(" profile: ");
+    print_bool(options.profile); printf("\n");
+  printf(" stats: ");
+    print_bool(options.stats); printf("\n");
+  printf(" timing: ");
+    print_bool(options.timing); printf("\n");
+  printf(" server: ");
+    print_bool(options.server); printf("\n");
+  printf(" parallel-parse: ");
+    print_bool(options.parallel_parse); printf("\n");
+  printf(" max-errors: %u\n", max_errors);
 } /* end m2t_print_options */
 
 
@@ -436,6 +635,30 @@ void m2t_print_option_help(void) {
   printf(" enable verbose diagnostics\n");
   printf("--errant-semicolon or --no-errant-semicolon\n");
   printf(" treat semicolon after statement sequence as warning or error\n");
+  printf("--pretokenize\n");
+  printf(" tokenize each source file in full before parsing\n");
+  printf("--ll1-parser\n");
+  printf(" parse with table driven LL(1) engine, syntax check only\n");
+  printf("--profile\n");
+  printf(" count and time productions, write m2t-profile.json\n");
+  printf("--stats\n");
+  printf(" count allocations per subsystem, print them after each parse\n");
+  printf("--timing\n");
+  printf(" time each phase, append a JSON line per file to m2c-timing.jsonl\n");
+  printf("--server\n");
+  printf(" serve translation requests on a socket named by the source path\n");
+  printf("--parallel-parse\n");
+  printf(" parse top-level procedures of a large module on worker threads\n");
+  printf("--pipeline\n");
+  printf(" lex on a thread of its own, overlapping scanning with parsing\n");
+  printf("--machine-diagnostics\n");
+  printf(" emit one diagnostic per line as line:column:kind:code:message\n");
+  printf("--max-errors n\n");
+  printf(" stop parsing after n errors, zero means no limit\n");
+  printf("--stream-ast\n");
+  printf(" write the AST while parsing, skips DOT and symbol output\n");
+  printf("--r10-output\n");
+  printf(" also write an M2R10 translation with suffix .def.r10 or .mod.r10\n");
   printf("--pim2, --pim3 and --pim4\n");
   printf(" strictly follow PIM second, third or fourth edition\n");
   printf(" mutually exclusive with each other and all options below\n");
@@ -463,6 +686,12 @@ void m2t_print_option_help(void) {
   printf(" enable or disable variant record support\n");
   printf("--local-modules and --no-local-modules\n");
   printf(" enable or disable local module support\n");
+  printf("--lowline-identifiers and --no-lowline-identifiers\n");
+  printf(" allow or disallow lowlines within identifiers\n");
+  printf("--line-comments and --no-line-comments\n");
+  printf(" allow or disallow line comments starting with !\n");
+  printf("--prefix-literals and --suffix-literals\n");
+  printf(" number literals with base prefix 0x and 0u or base suffix\n");
 } /* end m2t_print_option_help */
 
 
@@ -620,6 +849,39 @@ bool m2t_option_local_modules (void) {
 } /* end m2t_option_local_modules */
 
 
+/* --------------------------------------------------------------------------
+ * function m2t_option_lowline_identifiers()
+ * --------------------------------------------------------------------------
+ * Returns true if option flag lowline_identifiers is set, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_option_lowline_identifiers (void) {
+  return options.lowline_identifiers;
+} /* end m2t_option_lowline_identifiers */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_option_line_comments()
+ * --------------------------------------------------------------------------
+ * Returns true if option flag line_comments is set, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_option_line_comments (void) {
+  return options.line_comments;
+} /* end m2t_option_line_comments */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_option_prefix_literals()
+ * --------------------------------------------------------------------------
+ * Returns true if option flag prefix_literals is set, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_option_prefix_literals (void) {
+  return options.prefix_literals;
+} /* end m2t_option_prefix_literals */
+
+
 /* --------------------------------------------------------------------------
  * function m2t_option_lexer_debug()
  * --------------------------------------------------------------------------
@@ -641,6 +903,178 @@ bool m2t_option_parser_debug (void) {
   return options.parser_debug;
 } /* end m2t_option_parser_debug */
 
+/* --------------------------------------------------------------------------
+ * function m2t_option_r10_output()
+ * --------------------------------------------------------------------------
+ * Returns true if option flag r10_output is set, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_option_r10_output (void) {
+  return options.r10_output;
+} /* end m2t_option_r10_output */
+
+/* --------------------------------------------------------------------------
+ * function m2t_option_stream_ast()
+ * --------------------------------------------------------------------------
+ * Returns true if option flag stream_ast is set, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_option_stream_ast (void) {
+  return options.stream_ast;
+} /* end m2t_option_stream_ast */
+
+/* --------------------------------------------------------------------------
+ * function m2t_option_machine_diagnostics()
+ * --------------------------------------------------------------------------
+ * Returns true if option flag machine_diagnostics is set, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_option_machine_diagnostics (void) {
+  return options.machine_diagnostics;
+} /* end m2t_option_machine_diagnostics */
+
+/* --------------------------------------------------------------------------
+ * function m2t_option_pipeline()
+ * --------------------------------------------------------------------------
+ * Returns true if option flag pipeline is set, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_option_pipeline (void) {
+  return options.pipeline;
+} /* end m2t_option_pipeline */
+
+/* --------------------------------------------------------------------------
+ * function m2t_option_pretokenize()
+ * --------------------------------------------------------------------------
+ * Returns true if option flag pretokenize is set, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_option_pretokenize (void) {
+  return options.pretokenize;
+} /* end m2t_option_pretokenize */
+
+/* --------------------------------------------------------------------------
+ * function m2t_option_ll1_parser()
+ * --------------------------------------------------------------------------
+ * Returns true if option flag ll1_parser is set, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_option_ll1_parser (void) {
+  return options.ll1_parser;
+} /* end m2t_option_ll1_parser */
+
+/* --------------------------------------------------------------------------
+ * function m2t_option_profile()
+ * --------------------------------------------------------------------------
+ * Returns true if option flag profile is set, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_option_profile (void) {
+  return options.profile;
+} /* end m2t_option_profile */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_option_stats()
+ * --------------------------------------------------------------------------
+ * Returns true if option flag stats is set, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_option_stats (void) {
+  return options.stats;
+} /* end m2t_option_stats */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_option_timing()
+ * --------------------------------------------------------------------------
+ * Returns true if option flag timing is set, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_option_timing (void) {
+  return options.timing;
+} /* end m2t_option_timing */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_option_server()
+ * --------------------------------------------------------------------------
+ * Returns true if option flag server is set, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_option_server (void) {
+  return options.server;
+} /* end m2t_option_server */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_option_parallel_parse()
+ * --------------------------------------------------------------------------
+ * Returns true if option flag parallel-parse is set, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_option_parallel_parse (void) {
+  return options.parallel_parse;
+} /* end m2t_option_parallel_parse */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_option_max_errors()
+ * --------------------------------------------------------------------------
+ * Returns the maximum number of errors, zero if there is no limit.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2t_option_max_errors (void) {
+  return max_errors;
+} /* end m2t_option_max_errors */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_option_dialect()
+ * --------------------------------------------------------------------------
+ * Returns the option set of the dialect selected on the command line.
+ * Flags that only affect diagnostics or internal strategy, such as verbose,
+ * lexer-debug, parser-debug, pretokenize, pipeline, ll1-parser, profile,
+ * stats, timing, server, parallel-parse, machine-diagnostics and
+ * max-errors, are not represented.
+ * ----------------------------------------------------------------------- */
+
+m2t_option_set_t m2t_option_dialect (void) {
+  
+  return
+    (options.synonyms ? M2T_OPTION_SYNONYMS : 0) |
+    (options.octal_literals ? M2T_OPTION_OCTAL_LITERALS : 0) |
+    (options.escape_tab_and_newline ?
+      M2T_OPTION_ESCAPE_TAB_AND_NEWLINE : 0) |
+    (options.export_lists ? M2T_OPTION_EXPORT_LISTS : 0) |
+    (options.subtype_cardinals ? M2T_OPTION_SUBTYPE_CARDINALS : 0) |
+    (options.safe_string_termination ?
+      M2T_OPTION_SAFE_STRING_TERMINATION : 0) |
+    (options.errant_semicolon ? M2T_OPTION_ERRANT_SEMICOLON : 0) |
+    (options.type_byte ? M2T_OPTION_TYPE_BYTE : 0) |
+    (options.type_longcard ? M2T_OPTION_TYPE_LONGCARD : 0) |
+    (options.unified_cast ? M2T_OPTION_UNIFIED_CAST : 0) |
+    (options.coroutines ? M2T_OPTION_COROUTINES : 0) |
+    (options.variant_records ? M2T_OPTION_VARIANT_RECORDS : 0) |
+    (options.local_modules ? M2T_OPTION_LOCAL_MODULES : 0) |
+    (options.lowline_identifiers ? M2T_OPTION_LOWLINE_IDENTIFIERS : 0) |
+    (options.line_comments ? M2T_OPTION_LINE_COMMENTS : 0) |
+    (options.prefix_literals ? M2T_OPTION_PREFIX_LITERALS : 0);
+} /* end m2t_option_dialect */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_option_fingerprint()
+ * --------------------------------------------------------------------------
+ * Returns a bit set with one bit for each option flag that affects the
+ * output of a translation.  The fingerprint is the dialect option set,
+ * thus its bit positions are stable across versions.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2t_option_fingerprint (void) {
+  return m2t_option_dialect();
+} /* end m2t_option_fingerprint */
+
 
 /* --------------------------------------------------------------------------
  * private procedure print_bool(expr)
@@ -696,4 +1130,31 @@ static void report_invalid_option(const char *optstr) {
   } /* end if */
 } /* end report_invalid_option */
 
+
+/* --------------------------------------------------------------------------
+ * private function get_count(str, count)
+ * --------------------------------------------------------------------------
+ * Passes the value of decimal number str back in count and returns true if
+ * str consists of one to nine digits only, otherwise returns false.
+ * ----------------------------------------------------------------------- */
+
+static bool get_count(const char *str, uint_t *count) {
+  uint_t index = 0, value = 0;
+  
+  while ((str[index] >= '0') && (str[index] <= '9')) {
+    if (index == 9) {
+      return false;
+    } /* end if */
+    value = 10 * value + (uint_t) (str[index] - '0');
+    index++;
+  } /* end while */
+  
+  if ((index == 0) || (str[index] != '\0')) {
+    return false;
+  } /* end if */
+  
+  *count = value;
+  return true;
+} /* end get_count */
+
 /* END OF FILE */
\ No newline at end of file
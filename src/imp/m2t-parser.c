@@ -46,7 +46,15 @@
 #include "m2t-fileutils.h"
 #include "m2t-production.h"
 #include "m2t-resync-sets.h"
+#include "m2t-ll1-parser.h"
+#include "m2t-profiler.h"
 #include "m2t-option-flags.h"
+#include "m2t-constfold.h"
+#include "m2t-labelset.h"
+#include "m2-alloc-stats.h"
+#include "m2-phase-timing.h"
+#include "m2-trace-probes.h"
+#include "m2-workpool.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -59,6 +67,69 @@
         m2t_lexer_lookahead_column(p->lexer), \
         m2t_string_char_ptr(m2t_lexer_lookahead_lexeme(p->lexer))); }
 
+#define PARSER_PROFILE_ENTER(_p) \
+  { if (m2t_option_profile()) m2t_profiler_enter(_p); }
+
+#define PARSER_PROFILE_EXIT(_p) \
+  { if (m2t_option_profile()) m2t_profiler_exit(_p); }
+
+
+/* --------------------------------------------------------------------------
+ * Source span recording
+ * --------------------------------------------------------------------------
+ * SPAN_BEGIN records the position of the lookahead symbol as the start of
+ * a span, SPAN_END the position of the lookahead symbol as its end and
+ * enters the span for a node.  Both do nothing unless spans are recorded.
+ * ----------------------------------------------------------------------- */
+
+#define SPAN_BEGIN(_p, _span) \
+  { if ((_p)->spans != NULL) { \
+      (_span).first_line = m2t_lexer_lookahead_line((_p)->lexer); \
+      (_span).first_column = m2t_lexer_lookahead_column((_p)->lexer); } }
+
+#define SPAN_END(_p, _span, _node) \
+  { if ((_p)->spans != NULL) { \
+      (_span).end_line = m2t_lexer_lookahead_line((_p)->lexer); \
+      (_span).end_column = m2t_lexer_lookahead_column((_p)->lexer); \
+      m2t_span_table_add((_p)->spans, (_node), &(_span)); } }
+
+
+/* --------------------------------------------------------------------------
+ * Type subtree interning
+ * --------------------------------------------------------------------------
+ * TYPE_INTERN replaces the type subtree in p->ast by its shared subtree in
+ * the type pool of p.  It does nothing unless a type pool is used.
+ * ----------------------------------------------------------------------- */
+
+#define TYPE_INTERN(_p) \
+  { if ((_p)->types != NULL) { \
+      (_p)->ast = m2t_type_pool_intern((_p)->types, (_p)->ast); } }
+
+
+/* --------------------------------------------------------------------------
+ * Comment attachment
+ * --------------------------------------------------------------------------
+ * COMMENT_MARK records the offset of the lookahead symbol as the start of
+ * a range of symbols.  COMMENT_ATTACH attaches the comments that precede
+ * the symbols from that start up to and including the current symbol to a
+ * node, COMMENT_LEAD only those that precede the start symbol itself.  All
+ * do nothing unless comments are recorded.
+ * ----------------------------------------------------------------------- */
+
+#define COMMENT_MARK(_p, _offset) \
+  { if ((_p)->comments != NULL) { \
+      (_offset) = m2t_lexer_lookahead_offset((_p)->lexer); } }
+
+#define COMMENT_ATTACH(_p, _first, _node) \
+  { if ((_p)->comments != NULL) { \
+      m2t_comment_table_attach((_p)->comments, (_first), \
+        m2t_lexer_current_offset((_p)->lexer), (_node)); } }
+
+#define COMMENT_LEAD(_p, _first, _node) \
+  { if ((_p)->comments != NULL) { \
+      m2t_comment_table_attach((_p)->comments, (_first), (_first), \
+        (_node)); } }
+
 
 /* --------------------------------------------------------------------------
  * private type m2t_parser_context_t
@@ -78,6 +149,103 @@ typedef struct m2t_parser_context_s *m2t_parser_context_t;
 typedef m2t_token_t (m2t_nonterminal_f) (m2t_parser_context_t);
 
 
+/* --------------------------------------------------------------------------
+ * Maximum depth of the spine of a streamed AST
+ * --------------------------------------------------------------------------
+ * The spine consists of the root, module, block and list nodes.
+ * ----------------------------------------------------------------------- */
+
+#define M2T_STREAM_MAX_DEPTH 4
+
+
+/* --------------------------------------------------------------------------
+ * Initial capacity of the scratch list stack
+ * ----------------------------------------------------------------------- */
+
+#define M2T_SCRATCH_INITIAL_CAPACITY 256
+
+
+/* --------------------------------------------------------------------------
+ * private type m2t_scratch_stack_t
+ * --------------------------------------------------------------------------
+ * Record type representing a stack of list entries shared by all list
+ * productions of a parser context.  A list production marks the top of the
+ * stack, pushes its entries, builds its list node from the entries above
+ * its mark and then releases them.  Nested list productions push above the
+ * entries of their callers, thus entries are always released in LIFO order
+ * and the stack only allocates when it grows.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* entry */    m2t_fifo_value_t *entry;
+  /* top */      uint_t top;
+  /* capacity */ uint_t capacity;
+} m2t_scratch_stack_t;
+
+
+/* --------------------------------------------------------------------------
+ * Minimum number of top-level procedures to parse on workers
+ * ----------------------------------------------------------------------- */
+
+#define M2T_PARALLEL_MIN_PROCS 8
+
+
+/* --------------------------------------------------------------------------
+ * Initial capacity of the table of prescanned procedures
+ * ----------------------------------------------------------------------- */
+
+#define M2T_PARALLEL_INITIAL_CAPACITY 64
+
+
+/* --------------------------------------------------------------------------
+ * private type m2t_region_counts_t
+ * --------------------------------------------------------------------------
+ * Record type representing the counts of diagnostics emitted while parsing
+ * a region and the number of lines the region spans.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* warning_count */ uint_t warning_count;
+  /* error_count */   uint_t error_count;
+  /* line_count */    uint_t line_count;
+} m2t_region_counts_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type m2t_parsed_proc_t
+ * --------------------------------------------------------------------------
+ * Record type representing a top-level procedure declaration found by the
+ * prescan.  Field end_pos holds the stream position of the symbol that
+ * follows the declaration, field node the subtree built for it on a
+ * worker, or NULL if it could not be parsed on its own.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* region */  m2t_region_t region;
+  /* end_pos */ uint_t end_pos;
+  /* node */    m2t_astnode_t node;
+  /* counts */  m2t_region_counts_t counts;
+} m2t_parsed_proc_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type m2t_proc_table_t
+ * --------------------------------------------------------------------------
+ * Record type representing the top-level procedure declarations of a
+ * module in source order, the name and source they were found in, and the
+ * index of the next entry that the parser has not yet reached.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* name */     const char *name;
+  /* source */   const char *source;
+  /* count */    uint_t count;
+  /* capacity */ uint_t capacity;
+  /* next */     uint_t next;
+  /* entry */    m2t_parsed_proc_t *entry;
+} m2t_proc_table_t;
+
+
 /* --------------------------------------------------------------------------
  * forward declarations of alternative parsing functions.
  * ----------------------------------------------------------------------- */
@@ -88,6 +256,11 @@ m2t_token_t variant_record_type (m2t_parser_context_t p);
 /* for use with compiler option --no-variant-records */
 m2t_token_t extensible_record_type (m2t_parser_context_t p);
 
+/* for use when reparsing a single top-level definition or declaration */
+m2t_token_t definition (m2t_parser_context_t p);
+
+m2t_token_t declaration (m2t_parser_context_t p);
+
 
 /* --------------------------------------------------------------------------
  * private type m2t_parser_context_s
@@ -102,7 +275,25 @@ struct m2t_parser_context_s {
   /* warning_count */ uint_t warning_count;
   /* error_count */   uint_t error_count;
   /* status */        m2t_parser_status_t status;
+  /* options */       m2t_option_set_t options;
   /* record_type */   m2t_nonterminal_f *record_type;
+  /* stream */        m2t_parse_handler_t stream;
+  /* stream_context */ void *stream_context;
+  /* stream_spine */  bool stream_spine;
+  /* stream_depth */  uint_t stream_depth;
+  /* stream_open */   m2t_ast_nodetype_t stream_open[M2T_STREAM_MAX_DEPTH];
+  /* list_open */     bool list_open;
+  /* spans */         m2t_span_table_t spans;
+  /* types */         m2t_type_pool_t types;
+  /* regions */       m2t_region_table_t regions;
+  /* comments */      m2t_comment_table_t comments;
+  /* procs */         m2t_proc_table_t *procs;
+  /* top_level */     bool top_level;
+  /* block_depth */   uint_t block_depth;
+  /* folder */        m2t_const_folder_t folder;
+  /* labels */        m2t_label_set_t labels;
+  /* branch */        uint_t branch;
+  /* scratch */       m2t_scratch_stack_t scratch;
 };
 
 typedef struct m2t_parser_context_s m2t_parser_context_s;
@@ -118,6 +309,51 @@ typedef struct m2t_parser_context_s m2t_parser_context_s;
 
 static void parse_start_symbol
   (m2t_sourcetype_t srctype, m2t_parser_context_t p);
+
+static m2t_parser_context_t new_parser_context
+  (const char *filename, m2t_lexer_t lexer);
+
+static void release_parser_context (m2t_parser_context_t p);
+
+static m2t_astnode_t top_level_list (m2t_ast_t ast, bool *definitions);
+
+static m2t_astnode_t parse_region
+  (bool definitions,
+   const char *name,
+   const char *buffer,
+   const m2t_region_t *region,
+   m2t_region_counts_t *counts);
+
+static char *new_source_from_file (const char *srcpath, size_t *length);
+
+static m2t_proc_table_t *prescan_procedures
+  (const char *name, const char *source, m2t_lexer_t lexer);
+
+static bool skip_to_procedure_end (m2t_lexer_t lexer, m2t_string_t ident);
+
+static void parse_procedures (m2t_proc_table_t *procs);
+
+static void parse_procedure_job
+  (m2c_workpool_t pool, uint_t worker, void *job, void *context);
+
+static bool take_parsed_procedure (m2t_parser_context_t p);
+
+static void release_proc_table (m2t_proc_table_t *procs);
+
+static void parse_with_lexer
+  (m2t_sourcetype_t srctype,
+   const char *filename,
+   m2t_lexer_t lexer,
+   const char *source,
+   m2t_parse_handler_t handler,
+   void *context,
+   m2t_span_table_t spans,
+   m2t_type_pool_t types,
+   m2t_region_table_t regions,
+   m2c_phase_timing_t *timing,
+   m2t_ast_t *ast,
+   m2t_stats_t *stats,
+   m2t_parser_status_t *status);
  
 void m2t_parse_file
   (m2t_sourcetype_t srctype,
@@ -126,9 +362,9 @@ void m2t_parse_file
    m2t_stats_t *stats,
    m2t_parser_status_t *status) {
   
-  const char *filename;
-  m2t_parser_context_t p;
-  uint_t line_count;
+  m2t_lexer_t lexer;
+  char *source;
+  size_t length;
   
   if ((srctype < M2T_FIRST_SOURCETYPE) || (srctype > M2T_LAST_SOURCETYPE)) {
     SET_STATUS(status, M2T_PARSER_STATUS_INVALID_SOURCETYPE);
@@ -140,179 +376,1939 @@ void m2t_parse_file
     return;
   } /* end if */
   
-  /* set up parser context */
-  p = malloc(sizeof(m2t_parser_context_s));
+  /* procedures are parsed on workers from a copy of the source in memory */
+  source = NULL;
+  if (m2t_option_parallel_parse()) {
+    source = new_source_from_file(srcpath, &length);
+  } /* end if */
   
-  if (p == NULL) {
+  /* create lexer object */
+  lexer = NULL;
+  if (source != NULL) {
+    m2t_new_lexer_from_buffer
+      (&lexer, m2t_get_string((char *) srcpath, NULL), source, length, NULL);
+  }
+  else /* read from file */ {
+    m2t_new_lexer(&lexer, srcpath, NULL);
+  } /* end if */
+  
+  if (lexer == NULL) {
+    free(source);
     SET_STATUS(status, M2T_PARSER_STATUS_ALLOCATION_FAILED);
     return;
   } /* end if */
   
+  parse_with_lexer
+    (srctype, srcpath, lexer, source, NULL, NULL, NULL, NULL, NULL, NULL,
+     ast, stats, status);
+  
+  free(source);
+  return;
+} /* end m2t_parse_file */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_parse_file_w_handler(srctype, srcpath, handler, ...)
+ * --------------------------------------------------------------------------
+ * Parses a Modula-2 source file represented by srcpath and returns status.
+ * Passes the abstract syntax tree to handler as it is built.  Collects
+ * simple statistics and passes them back in stats.
+ * ----------------------------------------------------------------------- */
+
+void m2t_parse_file_w_handler
+  (m2t_sourcetype_t srctype,
+   const char *srcpath,
+   m2t_parse_handler_t handler,
+   void *context,
+   m2t_stats_t *stats,
+   m2t_parser_status_t *status) {
+  
+  m2t_lexer_t lexer;
+  m2t_ast_t ast;
+  
+  if ((srctype < M2T_FIRST_SOURCETYPE) || (srctype > M2T_LAST_SOURCETYPE)) {
+    SET_STATUS(status, M2T_PARSER_STATUS_INVALID_SOURCETYPE);
+    return;
+  } /* end if */
+  
+  if ((srcpath == NULL) || (srcpath[0] == ASCII_NUL) || (handler == NULL)) {
+    SET_STATUS(status, M2T_PARSER_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
   /* create lexer object */
-  m2t_new_lexer(&(p->lexer), srcpath, NULL);
+  lexer = NULL;
+  m2t_new_lexer(&lexer, srcpath, NULL);
   
-  if (p->lexer == NULL) {
+  if (lexer == NULL) {
     SET_STATUS(status, M2T_PARSER_STATUS_ALLOCATION_FAILED);
-    free(p);
     return;
   } /* end if */
   
-  /* init context */
-  p->filename = filename;
-  p->ast = NULL;
-  p->warning_count = 0;
-  p->error_count = 0;
-  p->status = 0;
+  /* the tree is passed to handler, none is passed back */
+  parse_with_lexer
+    (srctype, srcpath, lexer, NULL, handler, context,
+     NULL, NULL, NULL, NULL, &ast, stats, status);
+  return;
+} /* end m2t_parse_file_w_handler */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_parse_file_w_spans(srctype, srcpath, ast, spans, ...)
+ * --------------------------------------------------------------------------
+ * Parses a Modula-2 source file represented by srcpath and returns status
+ * like m2t_parse_file() and additionally records source spans in spans.
+ * ----------------------------------------------------------------------- */
+
+void m2t_parse_file_w_spans
+  (m2t_sourcetype_t srctype,
+   const char *srcpath,
+   m2t_ast_t *ast,
+   m2t_span_table_t spans,
+   m2t_stats_t *stats,
+   m2t_parser_status_t *status) {
   
-  if (m2t_option_variant_records()) {
-    /* install function to parse variant records */
-    p->record_type = variant_record_type;
-  }
-  else /* extensible records */ {
-    /* install function to parse extensible records */
-    p->record_type = extensible_record_type;
+  m2t_lexer_t lexer;
+  
+  if ((srctype < M2T_FIRST_SOURCETYPE) || (srctype > M2T_LAST_SOURCETYPE)) {
+    SET_STATUS(status, M2T_PARSER_STATUS_INVALID_SOURCETYPE);
+    return;
   } /* end if */
   
-  /* parse and build AST */
-  parse_start_symbol(srctype, p);
-  line_count = m2t_lexer_lookahead_line(p->lexer);
+  if ((srcpath == NULL) || (srcpath[0] == ASCII_NUL) || (spans == NULL)) {
+    SET_STATUS(status, M2T_PARSER_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
   
-  /* pass back AST, statistics and return status */
-  *ast = p->ast;
-  *stats = m2t_stats_new(p->warning_count, p->error_count, line_count);
-  SET_STATUS(status, p->status);
+  /* create lexer object */
+  lexer = NULL;
+  m2t_new_lexer(&lexer, srcpath, NULL);
   
-  /* clean up and return */
-  m2t_release_lexer(p->lexer, NULL);
-  free(p);
+  if (lexer == NULL) {
+    SET_STATUS(status, M2T_PARSER_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  parse_with_lexer
+    (srctype, srcpath, lexer, NULL, NULL, NULL, spans, NULL, NULL, NULL,
+     ast, stats, status);
   return;
-} /* end m2t_parse_file */
+} /* end m2t_parse_file_w_spans */
 
 
 /* --------------------------------------------------------------------------
- * private function match_token(p, expected_token, resync_set)
+ * function m2t_parse_file_w_comments(srctype, srcpath, ast, spans, ...)
  * --------------------------------------------------------------------------
- * Matches the lookahead symbol to expected_token and returns true if they
- * match.  If they don't match, a syntax error is reported, the error count
- * is incremented, symbols are consumed until the lookahead symbol matches
- * one of the symbols in resync_set and false is returned.
+ * Parses a Modula-2 source file represented by srcpath and returns status
+ * like m2t_parse_file_w_spans() and additionally records the comments of
+ * the source in comments.  Each comment is recorded as the byte offset and
+ * length of its text within the source, which is loaded once and passed
+ * to comments, nothing is copied.  Comments preceding the module heading
+ * are attached to the module node, comments preceding or within a constant,
+ * type, variable or procedure heading definition or declaration up to its
+ * terminating semicolon are attached to its node, comments preceding a
+ * procedure or module declaration are attached to its node.  All other
+ * comments are recorded without a node.  If spans is NULL, no spans are
+ * recorded.  The caller allocates spans and comments and is responsible
+ * for releasing them.
  * ----------------------------------------------------------------------- */
 
-bool match_token
-  (m2t_parser_context_t p,
-   m2t_token_t expected_token,
-   m2t_tokenset_t resync_set) {
+void m2t_parse_file_w_comments
+  (m2t_sourcetype_t srctype,
+   const char *srcpath,
+   m2t_ast_t *ast,
+   m2t_span_table_t spans,
+   m2t_comment_table_t comments,
+   m2t_stats_t *stats,
+   m2t_parser_status_t *status) {
   
-  m2t_string_t lexeme;
-  const char *lexstr;
-  uint_t line, column;
-  m2t_token_t lookahead;
+  m2t_lexer_t lexer;
+  char *source;
+  size_t length;
   
-  lookahead = m2t_next_sym(p->lexer);
+  if ((srctype < M2T_FIRST_SOURCETYPE) || (srctype > M2T_LAST_SOURCETYPE)) {
+    SET_STATUS(status, M2T_PARSER_STATUS_INVALID_SOURCETYPE);
+    return;
+  } /* end if */
   
-  if (lookahead == expected_token) {
-    return true;
-  }
-  else /* no match */ {
-    /* get details for offending lookahead symbol */
-    line = m2t_lexer_lookahead_line(p->lexer);
-    column = m2t_lexer_lookahead_column(p->lexer);
-    lexeme = m2t_lexer_lookahead_lexeme(p->lexer);
-    lexstr = m2t_string_char_ptr(lexeme);
-    
-    /* report error */
-    m2t_emit_syntax_error_w_token
-      (line, column, lookahead, lexstr, expected_token);
-    
-    /* print source line */
-    if (m2t_option_verbose()) {
-      m2t_print_line_and_mark_column(p->lexer, line, column);
-    } /* end if */
-    
-    /* update error count */
-    p->error_count++;
-    
-    /* skip symbols until lookahead matches resync_set */
-    while (!m2t_tokenset_element(resync_set, lookahead)) {
-      lookahead = m2t_consume_sym(p->lexer);
-    } /* end while */
-    return false;
+  if ((srcpath == NULL) || (srcpath[0] == ASCII_NUL) || (comments == NULL)) {
+    SET_STATUS(status, M2T_PARSER_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  /* comments refer to the source in memory, it passes to comments */
+  source = new_source_from_file(srcpath, &length);
+  
+  if (source == NULL) {
+    SET_STATUS(status, M2T_PARSER_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  m2t_comment_table_set_source(comments, source, length, true);
+  
+  /* create lexer object recording comments */
+  lexer = NULL;
+  m2t_new_lexer_w_comments
+    (&lexer, m2t_get_string((char *) srcpath, NULL), source, length,
+     comments, NULL);
+  
+  if (lexer == NULL) {
+    SET_STATUS(status, M2T_PARSER_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  /* procedures are not parsed on workers when comments are recorded */
+  parse_with_lexer
+    (srctype, srcpath, lexer, NULL, NULL, NULL, spans, NULL, NULL, NULL,
+     ast, stats, status);
+  return;
+} /* end m2t_parse_file_w_comments */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_parse_file_w_type_pool(srctype, srcpath, ast, types, ...)
+ * --------------------------------------------------------------------------
+ * Parses a Modula-2 source file represented by srcpath and returns status
+ * like m2t_parse_file() and additionally interns type subtrees in types.
+ * ----------------------------------------------------------------------- */
+
+void m2t_parse_file_w_type_pool
+  (m2t_sourcetype_t srctype,
+   const char *srcpath,
+   m2t_ast_t *ast,
+   m2t_type_pool_t types,
+   m2t_stats_t *stats,
+   m2t_parser_status_t *status) {
+  
+  m2t_lexer_t lexer;
+  
+  if ((srctype < M2T_FIRST_SOURCETYPE) || (srctype > M2T_LAST_SOURCETYPE)) {
+    SET_STATUS(status, M2T_PARSER_STATUS_INVALID_SOURCETYPE);
+    return;
+  } /* end if */
+  
+  if ((srcpath == NULL) || (srcpath[0] == ASCII_NUL) || (types == NULL)) {
+    SET_STATUS(status, M2T_PARSER_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  /* create lexer object */
+  lexer = NULL;
+  m2t_new_lexer(&lexer, srcpath, NULL);
+  
+  if (lexer == NULL) {
+    SET_STATUS(status, M2T_PARSER_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  parse_with_lexer
+    (srctype, srcpath, lexer, NULL, NULL, NULL, NULL, types, NULL, NULL,
+     ast, stats, status);
+  return;
+} /* end m2t_parse_file_w_type_pool */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_parse_file_w_timing(srctype, srcpath, ast, timing, ...)
+ * --------------------------------------------------------------------------
+ * Parses a Modula-2 source file represented by srcpath and returns status
+ * like m2t_parse_file() and additionally adds the time spent loading,
+ * lexing and parsing to timing and the number of consumed tokens to the
+ * token count of timing.  The byte count of timing is left to the caller.
+ * Unless option pretokenize is set, lexing is interleaved with parsing and
+ * its time is included in the time of the parse phase.
+ * ----------------------------------------------------------------------- */
+
+void m2t_parse_file_w_timing
+  (m2t_sourcetype_t srctype,
+   const char *srcpath,
+   m2t_ast_t *ast,
+   m2c_phase_timing_t *timing,
+   m2t_stats_t *stats,
+   m2t_parser_status_t *status) {
+  
+  m2t_lexer_t lexer;
+  uint64_t start;
+  
+  if ((srctype < M2T_FIRST_SOURCETYPE) || (srctype > M2T_LAST_SOURCETYPE)) {
+    SET_STATUS(status, M2T_PARSER_STATUS_INVALID_SOURCETYPE);
+    return;
+  } /* end if */
+  
+  if ((srcpath == NULL) || (srcpath[0] == ASCII_NUL) || (timing == NULL)) {
+    SET_STATUS(status, M2T_PARSER_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  /* create lexer object, this loads the source */
+  start = m2c_phase_clock();
+  lexer = NULL;
+  m2t_new_lexer(&lexer, srcpath, NULL);
+  m2c_phase_timing_add(timing, M2C_PHASE_LOAD, start);
+  
+  if (lexer == NULL) {
+    SET_STATUS(status, M2T_PARSER_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  parse_with_lexer
+    (srctype, srcpath, lexer, NULL, NULL, NULL, NULL, NULL, NULL, timing,
+     ast, stats, status);
+  return;
+} /* end m2t_parse_file_w_timing */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_parse_buffer_w_timing(srctype, name, buffer, length, ...)
+ * --------------------------------------------------------------------------
+ * Parses Modula-2 source text held in a caller owned buffer and returns
+ * status like m2t_parse_buffer() and additionally adds the time spent
+ * lexing and parsing to timing and the number of consumed tokens to the
+ * token count of timing like m2t_parse_file_w_timing().  Since the source
+ * has already been loaded, only the setup of the lexer is added to the
+ * time of the load phase.
+ * ----------------------------------------------------------------------- */
+
+void m2t_parse_buffer_w_timing
+  (m2t_sourcetype_t srctype,
+   const char *name,
+   const char *buffer,
+   size_t length,
+   m2t_ast_t *ast,
+   m2c_phase_timing_t *timing,
+   m2t_stats_t *stats,
+   m2t_parser_status_t *status) {
+  
+  m2t_lexer_t lexer;
+  uint64_t start;
+  
+  if ((srctype < M2T_FIRST_SOURCETYPE) || (srctype > M2T_LAST_SOURCETYPE)) {
+    SET_STATUS(status, M2T_PARSER_STATUS_INVALID_SOURCETYPE);
+    return;
+  } /* end if */
+  
+  if ((name == NULL) || (name[0] == ASCII_NUL) ||
+      (buffer == NULL) || (timing == NULL)) {
+    SET_STATUS(status, M2T_PARSER_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  /* create lexer object on buffer */
+  start = m2c_phase_clock();
+  lexer = NULL;
+  m2t_new_lexer_from_buffer
+    (&lexer, m2t_get_string((char *) name, NULL), buffer, length, NULL);
+  m2c_phase_timing_add(timing, M2C_PHASE_LOAD, start);
+  
+  if (lexer == NULL) {
+    SET_STATUS(status, M2T_PARSER_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  parse_with_lexer
+    (srctype, name, lexer, buffer, NULL, NULL, NULL, NULL, NULL, timing,
+     ast, stats, status);
+  return;
+} /* end m2t_parse_buffer_w_timing */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_parse_buffer(srctype, name, buffer, length, ast, stats, status)
+ * --------------------------------------------------------------------------
+ * Parses Modula-2 source text held in a caller owned buffer of the given
+ * length and returns status.  The buffer is NOT copied.  It must remain
+ * valid and unmodified until the function returns.  Parameter name is
+ * reported in place of a filename.  Builds an abstract syntax tree and
+ * passes it back in ast, or NULL upon failure.  Collects simple statistics
+ * and passes them back in stats.
+ * ----------------------------------------------------------------------- */
+
+void m2t_parse_buffer
+  (m2t_sourcetype_t srctype,
+   const char *name,
+   const char *buffer,
+   size_t length,
+   m2t_ast_t *ast,
+   m2t_stats_t *stats,
+   m2t_parser_status_t *status) {
+  
+  m2t_lexer_t lexer;
+  
+  if ((srctype < M2T_FIRST_SOURCETYPE) || (srctype > M2T_LAST_SOURCETYPE)) {
+    SET_STATUS(status, M2T_PARSER_STATUS_INVALID_SOURCETYPE);
+    return;
+  } /* end if */
+  
+  if ((name == NULL) || (name[0] == ASCII_NUL) || (buffer == NULL)) {
+    SET_STATUS(status, M2T_PARSER_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  /* create lexer object on buffer */
+  lexer = NULL;
+  m2t_new_lexer_from_buffer
+    (&lexer, m2t_get_string((char *) name, NULL), buffer, length, NULL);
+  
+  if (lexer == NULL) {
+    SET_STATUS(status, M2T_PARSER_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  parse_with_lexer
+    (srctype, name, lexer, buffer, NULL, NULL, NULL, NULL, NULL, NULL,
+     ast, stats, status);
+  return;
+} /* end m2t_parse_buffer */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_parse_buffer_w_regions(srctype, name, buffer, length, ...)
+ * --------------------------------------------------------------------------
+ * Parses Modula-2 source text held in a caller owned buffer and returns
+ * status like m2t_parse_buffer() and additionally records the regions of
+ * the top-level definitions of a definition module, or of the top-level
+ * declarations of a program or implementation module, in regions.  Any
+ * regions previously held in regions are removed.  The caller allocates
+ * regions and is responsible for releasing it.  The AST and regions may be
+ * passed to m2t_reparse_buffer() after the buffer has been edited.
+ * ----------------------------------------------------------------------- */
+
+void m2t_parse_buffer_w_regions
+  (m2t_sourcetype_t srctype,
+   const char *name,
+   const char *buffer,
+   size_t length,
+   m2t_ast_t *ast,
+   m2t_region_table_t regions,
+   m2t_stats_t *stats,
+   m2t_parser_status_t *status) {
+  
+  m2t_lexer_t lexer;
+  
+  if ((srctype < M2T_FIRST_SOURCETYPE) || (srctype > M2T_LAST_SOURCETYPE)) {
+    SET_STATUS(status, M2T_PARSER_STATUS_INVALID_SOURCETYPE);
+    return;
+  } /* end if */
+  
+  if ((name == NULL) || (name[0] == ASCII_NUL) ||
+      (buffer == NULL) || (regions == NULL)) {
+    SET_STATUS(status, M2T_PARSER_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  /* create lexer object on buffer */
+  lexer = NULL;
+  m2t_new_lexer_from_buffer
+    (&lexer, m2t_get_string((char *) name, NULL), buffer, length, NULL);
+  
+  if (lexer == NULL) {
+    SET_STATUS(status, M2T_PARSER_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  parse_with_lexer
+    (srctype, name, lexer, NULL, NULL, NULL, NULL, NULL, regions, NULL,
+     ast, stats, status);
+  return;
+} /* end m2t_parse_buffer_w_regions */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_reparse_buffer(srctype, name, buffer, length, edit, ...)
+ * --------------------------------------------------------------------------
+ * Updates an AST and regions obtained from m2t_parse_buffer_w_regions() or
+ * from a prior call to this function after the source text they were
+ * obtained from has been changed by edit, and returns status.  Parameter
+ * buffer holds the edited source text of the given length.  If the bytes
+ * removed by edit lie within a single region and the edited text of that
+ * region still parses as a single definition or declaration, only that
+ * region is relexed and reparsed and its subtree is replaced in ast.  The
+ * statistics then pertain to the reparsed region only.  Otherwise, the
+ * AST passed in is released and the whole buffer is parsed anew.  In
+ * either case, the updated AST is passed back in ast and regions are
+ * updated to match the edited source text.
+ * ----------------------------------------------------------------------- */
+
+void m2t_reparse_buffer
+  (m2t_sourcetype_t srctype,
+   const char *name,
+   const char *buffer,
+   size_t length,
+   const m2t_text_edit_t *edit,
+   m2t_ast_t *ast,
+   m2t_region_table_t regions,
+   m2t_stats_t *stats,
+   m2t_parser_status_t *status) {
+  
+  m2t_region_counts_t counts;
+  m2t_astnode_t list, node;
+  m2t_region_t region;
+  bool definitions;
+  int32_t delta;
+  uint_t index;
+  
+  if ((srctype < M2T_FIRST_SOURCETYPE) || (srctype > M2T_LAST_SOURCETYPE)) {
+    SET_STATUS(status, M2T_PARSER_STATUS_INVALID_SOURCETYPE);
+    return;
+  } /* end if */
+  
+  if ((name == NULL) || (name[0] == ASCII_NUL) || (buffer == NULL) ||
+      (edit == NULL) || (ast == NULL) || (regions == NULL)) {
+    SET_STATUS(status, M2T_PARSER_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  delta = (int32_t) edit->inserted - (int32_t) edit->removed;
+  
+  /* regions must still match the entries of the top-level list */
+  definitions = false;
+  list = top_level_list(*ast, &definitions);
+  
+  if ((list != NULL) &&
+      (m2t_ast_subnode_count(list) == m2t_region_table_count(regions)) &&
+      (m2t_region_table_find
+        (regions, edit->offset, edit->removed, &index))) {
+    
+    /* the edited region must not have been emptied */
+    m2t_region_table_entry(regions, index, &region);
+    
+    if (((int64_t) region.end + delta > (int64_t) region.start) &&
+        ((int64_t) region.end + delta <= (int64_t) length)) {
+      region.end = region.end + delta;
+      node = parse_region(definitions, name, buffer, &region, &counts);
+    }
+    else /* empty region */ {
+      node = NULL;
+    } /* end if */
+    
+    if (node != NULL) {
+      m2t_ast_release_tree(m2t_ast_subnode_for_index(list, index));
+      m2t_ast_replace_subnode(list, index, node);
+      m2t_region_table_resize(regions, index, delta);
+      *stats = m2t_stats_new
+        (counts.warning_count, counts.error_count, counts.line_count);
+      SET_STATUS(status, M2T_PARSER_STATUS_SUCCESS);
+      return;
+    } /* end if */
+  } /* end if */
+  
+  /* edit is not confined to a single region, parse whole buffer anew */
+  m2t_ast_release_tree(*ast);
+  *ast = NULL;
+  
+  m2t_parse_buffer_w_regions
+    (srctype, name, buffer, length, ast, regions, stats, status);
+  return;
+} /* end m2t_reparse_buffer */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_parse_imports(srcpath, srctype, module_ident, imports, status)
+ * --------------------------------------------------------------------------
+ * Scans only the module header and import lists of the Modula-2 source file
+ * represented by srcpath and returns status.  Passes back the type of the
+ * compilation unit in srctype, its module identifier in module_ident and a
+ * newly allocated queue of imported module identifiers in imports.
+ * ----------------------------------------------------------------------- */
+
+static m2t_token_t skip_to_semicolon (m2t_lexer_t lexer);
+
+void m2t_parse_imports
+  (const char *srcpath,
+   m2t_sourcetype_t *srctype,
+   m2t_string_t *module_ident,
+   m2t_fifo_t *imports,
+   m2t_parser_status_t *status) {
+  
+  m2t_sourcetype_t unit_type;
+  m2t_string_t ident;
+  m2t_token_t lookahead;
+  m2t_lexer_t lexer;
+  m2t_fifo_t list;
+  
+  if ((srcpath == NULL) || (srcpath[0] == ASCII_NUL) ||
+      (srctype == NULL) || (module_ident == NULL) || (imports == NULL)) {
+    SET_STATUS(status, M2T_PARSER_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  /* create lexer object */
+  lexer = NULL;
+  m2t_new_lexer(&lexer, m2t_get_string((char *) srcpath, NULL), NULL);
+  
+  if (lexer == NULL) {
+    SET_STATUS(status, M2T_PARSER_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  list = m2t_fifo_new_indexed_queue(NULL);
+  
+  if (list == NULL) {
+    m2t_release_lexer(&lexer, NULL);
+    SET_STATUS(status, M2T_PARSER_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  /* ( DEFINITION | IMPLEMENTATION )? */
+  lookahead = m2t_next_sym(lexer);
+  
+  if (lookahead == TOKEN_DEFINITION) {
+    unit_type = M2T_DEF_SOURCE;
+    lookahead = m2t_consume_sym(lexer);
+  }
+  else {
+    unit_type = M2T_MOD_SOURCE;
+    if (lookahead == TOKEN_IMPLEMENTATION) {
+      lookahead = m2t_consume_sym(lexer);
+    } /* end if */
+  } /* end if */
+  
+  /* MODULE moduleIdent */
+  ident = NULL;
+  if (lookahead == TOKEN_MODULE) {
+    lookahead = m2t_consume_sym(lexer);
+    
+    if (lookahead == TOKEN_IDENTIFIER) {
+      lookahead = m2t_consume_sym(lexer);
+      ident = m2t_lexer_current_lexeme(lexer);
+    } /* end if */
+  } /* end if */
+  
+  /* priority? ';' */
+  lookahead = skip_to_semicolon(lexer);
+  
+  /* import* */
+  while ((lookahead == TOKEN_IMPORT) || (lookahead == TOKEN_FROM)) {
+    
+    /* FROM moduleIdent IMPORT identList ';' */
+    if (lookahead == TOKEN_FROM) {
+      lookahead = m2t_consume_sym(lexer);
+      
+      if (lookahead == TOKEN_IDENTIFIER) {
+        lookahead = m2t_consume_sym(lexer);
+        m2t_fifo_enqueue_unique(list, m2t_lexer_current_lexeme(lexer));
+      } /* end if */
+    }
+    
+    /* IMPORT moduleList ';' */
+    else {
+      lookahead = m2t_consume_sym(lexer);
+      
+      while (lookahead == TOKEN_IDENTIFIER) {
+        lookahead = m2t_consume_sym(lexer);
+        m2t_fifo_enqueue_unique(list, m2t_lexer_current_lexeme(lexer));
+        
+        if (lookahead == TOKEN_COMMA) {
+          lookahead = m2t_consume_sym(lexer);
+        } /* end if */
+      } /* end while */
+    } /* end if */
+    
+    lookahead = skip_to_semicolon(lexer);
+  } /* end while */
+  
+  m2t_release_lexer(&lexer, NULL);
+  
+  /* pass back results */
+  *srctype = unit_type;
+  *module_ident = ident;
+  *imports = list;
+  
+  SET_STATUS(status, M2T_PARSER_STATUS_SUCCESS);
+  return;
+} /* end m2t_parse_imports */
+
+
+/* --------------------------------------------------------------------------
+ * private function skip_to_semicolon(lexer)
+ * --------------------------------------------------------------------------
+ * Consumes symbols up to and including the next semicolon or until the end
+ * of the input is reached.  Returns the new lookahead symbol.
+ * ----------------------------------------------------------------------- */
+
+static m2t_token_t skip_to_semicolon (m2t_lexer_t lexer) {
+  m2t_token_t lookahead;
+  
+  lookahead = m2t_next_sym(lexer);
+  
+  while ((lookahead != TOKEN_SEMICOLON) &&
+         (lookahead != TOKEN_END_OF_FILE)) {
+    lookahead = m2t_consume_sym(lexer);
+  } /* end while */
+  
+  if (lookahead == TOKEN_SEMICOLON) {
+    lookahead = m2t_consume_sym(lexer);
+  } /* end if */
+  
+  return lookahead;
+} /* end skip_to_semicolon */
+
+
+/* --------------------------------------------------------------------------
+ * private function parse_with_lexer(srctype, filename, lexer, source, ...)
+ * --------------------------------------------------------------------------
+ * Sets up a parser context for lexer, parses the source, passes back AST,
+ * statistics and status, then releases lexer and context.  If handler is
+ * not NULL, the AST is passed to handler as it is built instead.  If spans
+ * is not NULL, source spans are recorded in spans.  If types is not NULL,
+ * type subtrees are interned in types.  If regions is not NULL, it is
+ * cleared and the regions of top-level definitions or declarations are
+ * recorded in it.  If timing is not NULL, the time spent lexing and parsing
+ * and the consumed tokens are added to timing.  If source is not NULL, it
+ * holds the source text that lexer reads and the top-level procedures of
+ * the source are parsed on workers if option parallel-parse is set.
+ * ----------------------------------------------------------------------- */
+
+static void parse_with_lexer
+  (m2t_sourcetype_t srctype,
+   const char *filename,
+   m2t_lexer_t lexer,
+   const char *source,
+   m2t_parse_handler_t handler,
+   void *context,
+   m2t_span_table_t spans,
+   m2t_type_pool_t types,
+   m2t_region_table_t regions,
+   m2c_phase_timing_t *timing,
+   m2t_ast_t *ast,
+   m2t_stats_t *stats,
+   m2t_parser_status_t *status) {
+  
+  m2t_lexer_status_t lexer_status;
+  m2t_parser_context_t p;
+  uint_t line_count;
+  uint64_t start;
+  bool parallel;
+  
+  /* set up parser context */
+  p = new_parser_context(filename, lexer);
+  
+  if (p == NULL) {
+    m2t_release_lexer(&lexer, NULL);
+    SET_STATUS(status, M2T_PARSER_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  p->stream = handler;
+  p->stream_context = context;
+  p->stream_spine = (handler != NULL);
+  p->spans = spans;
+  p->types = types;
+  p->regions = regions;
+  
+  m2t_region_table_clear(regions);
+  
+  M2C_TRACE_PARSE_START(filename);
+  
+  /* tokenize whole source up front, or lex on a thread, if requested,
+   * unless tokenized up front, lexing is timed as part of parsing */
+  parallel = (source != NULL) && (m2t_option_parallel_parse()) &&
+    (handler == NULL) && (spans == NULL) && (types == NULL) &&
+    (NOT(m2t_option_ll1_parser())) && (NOT(m2t_option_profile()));
+  
+  start = m2c_phase_clock();
+  if ((m2t_option_pretokenize()) || (parallel)) {
+    m2t_lexer_pretokenize(p->lexer, &lexer_status);
+    start = m2c_phase_timing_add(timing, M2C_PHASE_LEX, start);
+    
+    /* parse top-level procedures on workers, unless lexing failed */
+    if ((parallel) && (lexer_status == M2T_LEXER_STATUS_SUCCESS) &&
+        (m2t_lexer_error_count(p->lexer) == 0)) {
+      p->procs = prescan_procedures(filename, source, p->lexer);
+      parse_procedures(p->procs);
+    } /* end if */
+  }
+  else if (m2t_option_pipeline()) {
+    m2t_lexer_start_pipeline(p->lexer, NULL);
+  } /* end if */
+  
+  if (m2t_option_ll1_parser()) {
+    /* check syntax only, using the table driven engine */
+    p->error_count = m2t_ll1_parse(srctype, p->lexer, &(p->status));
+  }
+  else /* recursive descent */ {
+    /* parse and build AST */
+    parse_start_symbol(srctype, p);
+  } /* end if */
+  
+  m2c_phase_timing_add(timing, M2C_PHASE_PARSE, start);
+  
+  M2C_TRACE_PARSE_END(filename, p->error_count);
+  
+  line_count = m2t_lexer_lookahead_line(p->lexer);
+  
+  if (timing != NULL) {
+    timing->tokens += m2t_lexer_token_count(p->lexer);
+  } /* end if */
+  
+  /* write cumulative profile if requested */
+  if (m2t_option_profile()) {
+    m2t_profiler_write(M2T_PROFILER_OUTPUT_FILE, NULL);
+  } /* end if */
+  
+  /* pass back AST, statistics and return status */
+  *ast = p->ast;
+  *stats = m2t_stats_new(p->warning_count, p->error_count, line_count);
+  SET_STATUS(status, p->status);
+  
+  /* clean up and return */
+  release_parser_context(p);
+  
+  /* print allocation counters if requested, live bytes are those retained */
+  if (m2t_option_stats()) {
+    m2c_alloc_stats_write(stdout);
+  } /* end if */
+  
+  return;
+} /* end parse_with_lexer */
+
+
+/* --------------------------------------------------------------------------
+ * private function new_parser_context(filename, lexer)
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated parser context for lexer that builds an AST
+ * and records neither spans nor regions, or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+static m2t_parser_context_t new_parser_context
+  (const char *filename, m2t_lexer_t lexer) {
+  
+  m2t_parser_context_t p;
+  
+  p = malloc(sizeof(m2t_parser_context_s));
+  
+  if (p == NULL) {
+    return NULL;
+  } /* end if */
+  
+  /* init context */
+  p->filename = filename;
+  p->lexer = lexer;
+  p->ast = NULL;
+  p->warning_count = 0;
+  p->error_count = 0;
+  p->status = 0;
+  p->options = m2t_lexer_options(lexer);
+  p->stream = NULL;
+  p->stream_context = NULL;
+  p->stream_spine = false;
+  p->stream_depth = 0;
+  p->list_open = false;
+  p->spans = NULL;
+  p->types = NULL;
+  p->regions = NULL;
+  p->comments = m2t_lexer_comment_table(lexer);
+  p->procs = NULL;
+  p->top_level = true;
+  p->block_depth = 0;
+  
+  /* constant folder and label set are allocated on first use */
+  p->folder = NULL;
+  p->labels = NULL;
+  p->branch = 0;
+  
+  /* scratch stack is allocated on first use */
+  p->scratch.entry = NULL;
+  p->scratch.top = 0;
+  p->scratch.capacity = 0;
+  
+  if (M2T_OPTION_IN_SET(p->options, M2T_OPTION_VARIANT_RECORDS)) {
+    /* install function to parse variant records */
+    p->record_type = variant_record_type;
+  }
+  else /* extensible records */ {
+    /* install function to parse extensible records */
+    p->record_type = extensible_record_type;
+  } /* end if */
+  
+  return p;
+} /* end new_parser_context */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure release_parser_context(p)
+ * --------------------------------------------------------------------------
+ * Releases parser context p, its lexer and any procedures parsed ahead
+ * that have not been taken into the AST.  The AST is not released.
+ * ----------------------------------------------------------------------- */
+
+static void release_parser_context (m2t_parser_context_t p) {
+  
+  m2t_release_lexer(&(p->lexer), NULL);
+  release_proc_table(p->procs);
+  m2t_release_const_folder(&(p->folder));
+  m2t_release_label_set(&(p->labels));
+  free(p->scratch.entry);
+  free(p);
+  
+  return;
+} /* end release_parser_context */
+
+
+/* --------------------------------------------------------------------------
+ * private function top_level_list(ast, definitions)
+ * --------------------------------------------------------------------------
+ * Returns the definition list of the definition module or the declaration
+ * list of the program or implementation module in ast, or NULL if ast
+ * holds no such list.  Passes back true in definitions if a definition
+ * list is returned, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+static m2t_astnode_t top_level_list (m2t_ast_t ast, bool *definitions) {
+  
+  m2t_astnode_t module, body, list;
+  
+  if ((ast == NULL) || (m2t_ast_nodetype(ast) != AST_ROOT)) {
+    return NULL;
+  } /* end if */
+  
+  module = m2t_ast_subnode_for_index(ast, 2);
+  
+  if (module == NULL) {
+    return NULL;
+  } /* end if */
+  
+  if (m2t_ast_nodetype(module) == AST_DEFMOD) {
+    list = m2t_ast_subnode_for_index(module, 2);
+    
+    if ((list != NULL) && (m2t_ast_nodetype(list) == AST_DEFLIST)) {
+      *definitions = true;
+      return list;
+    } /* end if */
+  }
+  else if (m2t_ast_nodetype(module) == AST_IMPMOD) {
+    body = m2t_ast_subnode_for_index(module, 3);
+    
+    if ((body != NULL) && (m2t_ast_nodetype(body) == AST_BLOCK)) {
+      list = m2t_ast_subnode_for_index(body, 0);
+      
+      if ((list != NULL) && (m2t_ast_nodetype(list) == AST_DECLLIST)) {
+        *definitions = false;
+        return list;
+      } /* end if */
+    } /* end if */
+  } /* end if */
+  
+  return NULL;
+} /* end top_level_list */
+
+
+/* --------------------------------------------------------------------------
+ * private function parse_region(definitions, name, buffer, region, counts)
+ * --------------------------------------------------------------------------
+ * Relexes and reparses the text of buffer within region as a definition if
+ * definitions is true, or as a declaration otherwise.  Returns the subtree
+ * of the definition or declaration and passes back the counts for region
+ * in counts if the text holds exactly one definition or declaration.
+ * Returns NULL otherwise.  Diagnostics are reported at their positions
+ * relative to the start of buffer.
+ * ----------------------------------------------------------------------- */
+
+static m2t_astnode_t parse_region
+  (bool definitions,
+   const char *name,
+   const char *buffer,
+   const m2t_region_t *region,
+   m2t_region_counts_t *counts) {
+  
+  m2t_parser_context_t p;
+  m2t_lexer_t lexer;
+  m2t_token_t lookahead;
+  m2t_astnode_t node;
+  uint_t first_line;
+  
+  /* create lexer object on region */
+  lexer = NULL;
+  m2t_new_lexer_for_range(&lexer, m2t_get_string((char *) name, NULL),
+    buffer, region->start, region->end, NULL);
+  
+  if (lexer == NULL) {
+    return NULL;
+  } /* end if */
+  
+  p = new_parser_context(name, lexer);
+  
+  if (p == NULL) {
+    m2t_release_lexer(&lexer, NULL);
+    return NULL;
+  } /* end if */
+  
+  /* the definition or declaration lies within the module's block */
+  p->block_depth = 1;
+  
+  /* region must start with a definition or declaration */
+  lookahead = m2t_next_sym(p->lexer);
+  first_line = m2t_lexer_lookahead_line(p->lexer);
+  
+  if ((lookahead == TOKEN_CONST) ||
+      (lookahead == TOKEN_TYPE) ||
+      (lookahead == TOKEN_VAR) ||
+      (lookahead == TOKEN_PROCEDURE)) {
+    
+    if (definitions) {
+      lookahead = definition(p);
+    }
+    else /* declarations */ {
+      lookahead = declaration(p);
+    } /* end if */
+  }
+  else if ((lookahead == TOKEN_MODULE) && (NOT(definitions))) {
+    lookahead = declaration(p);
+  }
+  else /* no definition or declaration */ {
+    release_parser_context(p);
+    return NULL;
+  } /* end if */
+  
+  /* region must not hold anything past its definition or declaration */
+  if (lookahead != TOKEN_END_OF_FILE) {
+    m2t_ast_release_tree(p->ast);
+    release_parser_context(p);
+    return NULL;
+  } /* end if */
+  
+  /* pass back counts for region */
+  counts->warning_count = p->warning_count;
+  counts->error_count = p->error_count;
+  counts->line_count = m2t_lexer_lookahead_line(p->lexer) - first_line + 1;
+  
+  node = p->ast;
+  release_parser_context(p);
+  
+  return node;
+} /* end parse_region */
+
+
+/* --------------------------------------------------------------------------
+ * private function new_source_from_file(srcpath, length)
+ * --------------------------------------------------------------------------
+ * Reads the file at srcpath into a newly allocated buffer, passes its
+ * length back in length and returns the buffer.  Returns NULL if the file
+ * could not be read, is empty or if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static char *new_source_from_file (const char *srcpath, size_t *length) {
+  
+  char *source;
+  long size;
+  FILE *file;
+  
+  file = fopen(srcpath, "rb");
+  
+  if (file == NULL) {
+    return NULL;
+  } /* end if */
+  
+  source = NULL;
+  if ((fseek(file, 0, SEEK_END) == 0) &&
+      ((size = ftell(file)) > 0) && (fseek(file, 0, SEEK_SET) == 0)) {
+    source = malloc((size_t) size);
+  } /* end if */
+  
+  if ((source != NULL) &&
+      (fread(source, 1, (size_t) size, file) != (size_t) size)) {
+    free(source);
+    source = NULL;
+  } /* end if */
+  
+  fclose(file);
+  
+  if (source != NULL) {
+    *length = (size_t) size;
+  } /* end if */
+  
+  return source;
+} /* end new_source_from_file */
+
+
+/* --------------------------------------------------------------------------
+ * private function prescan_procedures(name, source, lexer)
+ * --------------------------------------------------------------------------
+ * Scans the symbols of pre-tokenized lexer for top-level procedure
+ * declarations and returns a newly allocated table of their regions and
+ * end positions in source order, then rewinds lexer to the symbol it was
+ * at.  A procedure declaration starts with a PROCEDURE that follows a
+ * semicolon, which rules out procedure types, and ends with the first
+ * occurrence of END, its identifier and a semicolon thereafter.  The
+ * symbols of a procedure declaration are not scanned for further
+ * declarations.  Returns NULL if fewer than M2T_PARALLEL_MIN_PROCS
+ * procedure declarations are found or if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static m2t_proc_table_t *prescan_procedures
+  (const char *name, const char *source, m2t_lexer_t lexer) {
+  
+  m2t_parsed_proc_t *entry, *new_entry;
+  m2t_proc_table_t *procs;
+  m2t_token_t lookahead;
+  m2t_string_t ident;
+  uint_t start_pos;
+  uint32_t start;
+  bool after_semicolon;
+  
+  start_pos = m2t_lexer_position(lexer);
+  
+  if (start_pos == 0) {
+    return NULL;
+  } /* end if */
+  
+  procs = malloc(sizeof(m2t_proc_table_t));
+  
+  if (procs == NULL) {
+    return NULL;
+  } /* end if */
+  
+  procs->name = name;
+  procs->source = source;
+  procs->count = 0;
+  procs->capacity = 0;
+  procs->next = 0;
+  procs->entry = NULL;
+  
+  after_semicolon = false;
+  lookahead = m2t_next_sym(lexer);
+  
+  while (lookahead != TOKEN_END_OF_FILE) {
+    
+    if ((lookahead == TOKEN_PROCEDURE) && (after_semicolon)) {
+      start = m2t_lexer_lookahead_offset(lexer);
+      lookahead = m2t_consume_sym(lexer);
+      after_semicolon = false;
+      
+      if (lookahead != TOKEN_IDENTIFIER) {
+        continue;
+      } /* end if */
+      
+      ident = m2t_lexer_lookahead_lexeme(lexer);
+      
+      if (NOT(skip_to_procedure_end(lexer, ident))) {
+        break;
+      } /* end if */
+      
+      /* grow table if full */
+      if (procs->count == procs->capacity) {
+        new_entry = realloc(procs->entry,
+          (procs->capacity + M2T_PARALLEL_INITIAL_CAPACITY) *
+          sizeof(m2t_parsed_proc_t));
+        
+        if (new_entry == NULL) {
+          break;
+        } /* end if */
+        
+        procs->entry = new_entry;
+        procs->capacity = procs->capacity + M2T_PARALLEL_INITIAL_CAPACITY;
+      } /* end if */
+      
+      entry = &(procs->entry[procs->count]);
+      entry->region.start = start;
+      entry->region.end = m2t_lexer_lookahead_offset(lexer);
+      entry->end_pos = m2t_lexer_position(lexer);
+      entry->node = NULL;
+      
+      if (entry->end_pos != 0) {
+        procs->count++;
+      } /* end if */
+      
+      /* the declaration ended with a semicolon */
+      lookahead = m2t_next_sym(lexer);
+      after_semicolon = true;
+    }
+    else /* any other symbol */ {
+      after_semicolon = (lookahead == TOKEN_SEMICOLON);
+      lookahead = m2t_consume_sym(lexer);
+    } /* end if */
+  } /* end while */
+  
+  /* parsing starts over at the symbol the prescan started from */
+  m2t_lexer_rewind(lexer, start_pos, NULL);
+  
+  if (procs->count < M2T_PARALLEL_MIN_PROCS) {
+    release_proc_table(procs);
+    return NULL;
+  } /* end if */
+  
+  return procs;
+} /* end prescan_procedures */
+
+
+/* --------------------------------------------------------------------------
+ * private function skip_to_procedure_end(lexer, ident)
+ * --------------------------------------------------------------------------
+ * Consumes symbols up to and including the sequence of END, ident and a
+ * semicolon.  Returns true if the sequence was found, or false if the end
+ * of the input was reached.  The lookahead symbol of lexer must be ident.
+ * ----------------------------------------------------------------------- */
+
+static bool skip_to_procedure_end (m2t_lexer_t lexer, m2t_string_t ident) {
+  
+  m2t_token_t lookahead;
+  
+  lookahead = m2t_consume_sym(lexer);
+  
+  while (lookahead != TOKEN_END_OF_FILE) {
+    
+    if (lookahead == TOKEN_END) {
+      lookahead = m2t_consume_sym(lexer);
+      
+      if ((lookahead == TOKEN_IDENTIFIER) &&
+          (m2t_lexer_lookahead_lexeme(lexer) == ident)) {
+        lookahead = m2t_consume_sym(lexer);
+        
+        if (lookahead == TOKEN_SEMICOLON) {
+          m2t_consume_sym(lexer);
+          return true;
+        } /* end if */
+      } /* end if */
+    }
+    else /* any other symbol */ {
+      lookahead = m2t_consume_sym(lexer);
+    } /* end if */
+  } /* end while */
+  
+  return false;
+} /* end skip_to_procedure_end */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure parse_procedures(procs)
+ * --------------------------------------------------------------------------
+ * Parses the procedure declarations in procs on a pool of workers, each
+ * with a lexer and parser context of its own, and stores their subtrees
+ * in procs.  Does nothing if procs is NULL.  If no workers can be started,
+ * no subtrees are stored and the parser parses all declarations itself.
+ * ----------------------------------------------------------------------- */
+
+static void parse_procedures (m2t_proc_table_t *procs) {
+  
+  m2c_workpool_status_t pool_status;
+  m2c_workpool_t pool;
+  uint_t index;
+  
+  if (procs == NULL) {
+    return;
+  } /* end if */
+  
+  pool = m2c_new_workpool(m2c_workpool_default_worker_count(),
+    parse_procedure_job, procs, &pool_status);
+  
+  if (pool == NULL) {
+    return;
+  } /* end if */
+  
+  /* declarations that could not be submitted are parsed by the parser */
+  for (index = 0; index < procs->count; index++) {
+    m2c_workpool_submit(pool, index, &(procs->entry[index]), &pool_status);
+  } /* end for */
+  
+  m2c_workpool_run(pool, &pool_status);
+  m2c_release_workpool(pool);
+  
+  return;
+} /* end parse_procedures */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure parse_procedure_job(pool, worker, job, context)
+ * --------------------------------------------------------------------------
+ * Job handler, parses the procedure declaration passed in job from the
+ * source of the procedure table passed in context.
+ * ----------------------------------------------------------------------- */
+
+static void parse_procedure_job
+  (m2c_workpool_t pool, uint_t worker, void *job, void *context) {
+  
+  m2t_parsed_proc_t *proc = job;
+  m2t_proc_table_t *procs = context;
+  
+  proc->node = parse_region
+    (false, procs->name, procs->source, &(proc->region), &(proc->counts));
+  
+} /* end parse_procedure_job */
+
+
+/* --------------------------------------------------------------------------
+ * private function take_parsed_procedure(p)
+ * --------------------------------------------------------------------------
+ * Passes back in p->ast the subtree of the procedure declaration that
+ * starts at the lookahead symbol of p if it has been parsed on a worker,
+ * adds its counts to those of p, moves the lookahead symbol past the
+ * declaration and returns true.  Returns false if the declaration has not
+ * been parsed in advance, it must then be parsed by the parser.
+ * ----------------------------------------------------------------------- */
+
+static bool take_parsed_procedure (m2t_parser_context_t p) {
+  
+  m2t_lexer_status_t lexer_status;
+  m2t_proc_table_t *procs;
+  m2t_parsed_proc_t *proc;
+  uint32_t offset;
+  
+  procs = p->procs;
+  
+  if (procs == NULL) {
+    return false;
+  } /* end if */
+  
+  offset = m2t_lexer_lookahead_offset(p->lexer);
+  
+  /* skip entries that lie within local modules */
+  while ((procs->next < procs->count) &&
+         (procs->entry[procs->next].region.start < offset)) {
+    procs->next++;
+  } /* end while */
+  
+  if ((procs->next == procs->count) ||
+      (procs->entry[procs->next].region.start != offset)) {
+    return false;
+  } /* end if */
+  
+  proc = &(procs->entry[procs->next]);
+  procs->next++;
+  
+  if (proc->node == NULL) {
+    return false;
+  } /* end if */
+  
+  /* resume at the symbol following the declaration */
+  m2t_lexer_rewind(p->lexer, proc->end_pos, &lexer_status);
+  
+  if (lexer_status != M2T_LEXER_STATUS_SUCCESS) {
+    return false;
+  } /* end if */
+  
+  p->ast = proc->node;
+  proc->node = NULL;
+  
+  p->warning_count = p->warning_count + proc->counts.warning_count;
+  p->error_count = p->error_count + proc->counts.error_count;
+  
+  return true;
+} /* end take_parsed_procedure */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure release_proc_table(procs)
+ * --------------------------------------------------------------------------
+ * Releases procs and the subtrees it holds.  Does nothing if procs is NULL.
+ * ----------------------------------------------------------------------- */
+
+static void release_proc_table (m2t_proc_table_t *procs) {
+  
+  uint_t index;
+  
+  if (procs == NULL) {
+    return;
+  } /* end if */
+  
+  for (index = 0; index < procs->count; index++) {
+    if (procs->entry[index].node != NULL) {
+      m2t_ast_release_tree(procs->entry[index].node);
+    } /* end if */
+  } /* end for */
+  
+  free(procs->entry);
+  free(procs);
+  
+  return;
+} /* end release_proc_table */
+
+
+/* --------------------------------------------------------------------------
+ * private function match_token(p, expected_token, resync_set)
+ * --------------------------------------------------------------------------
+ * Matches the lookahead symbol to expected_token and returns true if they
+ * match.  If they don't match, a syntax error is reported, the error count
+ * is incremented, symbols are consumed until the lookahead symbol matches
+ * one of the symbols in resync_set and false is returned.
+ * ----------------------------------------------------------------------- */
+
+bool match_token
+  (m2t_parser_context_t p,
+   m2t_token_t expected_token,
+   m2t_tokenset_t resync_set) {
+  
+  m2t_string_t lexeme;
+  const char *lexstr;
+  uint_t line, column;
+  m2t_token_t lookahead;
+  bool abandon;
+  
+  lookahead = m2t_next_sym(p->lexer);
+  
+  if (lookahead == expected_token) {
+    return true;
+  }
+  else /* no match */ {
+    /* get details for offending lookahead symbol */
+    line = m2t_lexer_lookahead_line(p->lexer);
+    column = m2t_lexer_lookahead_column(p->lexer);
+    lexeme = m2t_lexer_lookahead_lexeme(p->lexer);
+    lexstr = m2t_string_char_ptr(lexeme);
+    
+    /* abandon the source if the error limit has already been reached */
+    abandon = m2t_error_limit_reached();
+    
+    /* report error, suppressed beyond the error limit */
+    m2t_emit_syntax_error_w_token
+      (line, column, lookahead, lexstr, expected_token);
+    
+    /* print source line */
+    if ((m2t_option_verbose()) && (!abandon)) {
+      m2t_print_line_and_mark_column(p->lexer, line, column);
+    } /* end if */
+    
+    /* update error count */
+    p->error_count++;
+    
+    /* skip to the end of the input when abandoning the source */
+    if (abandon) {
+      resync_set = m2t_tokenset_from_list(TOKEN_END_OF_FILE, 0);
+    } /* end if */
+    
+    /* skip symbols until lookahead matches resync_set */
+    m2t_lexer_skip_to_set(p->lexer, resync_set);
+    return false;
+  } /* end if */
+} /* end match_token */
+
+
+/* --------------------------------------------------------------------------
+ * private function match_set(p, expected_set, resync_set)
+ * --------------------------------------------------------------------------
+ * Matches the lookahead symbol to set expected_set and returns true if it
+ * matches any of the tokens in the set.  If there is no match, a syntax
+ * error is reported, the error count is incremented, symbols are consumed
+ * until the lookahead symbol matches one of the symbols in resync_set and
+ * false is returned.
+ * ----------------------------------------------------------------------- */
+
+bool match_set
+  (m2t_parser_context_t p,
+   m2t_tokenset_t expected_set,
+   m2t_tokenset_t resync_set) {
+  
+  m2t_string_t lexeme;
+  const char *lexstr;
+  uint_t line, column;
+  m2t_token_t lookahead;
+  bool abandon;
+  
+  lookahead = m2t_next_sym(p->lexer);
+  
+  /* check if lookahead matches any token in expected_set */
+  if (m2t_tokenset_element(expected_set, lookahead)) {
+    return true;
+  }
+  else /* no match */ {
+    /* get details for offending lookahead symbol */
+    line = m2t_lexer_lookahead_line(p->lexer);
+    column = m2t_lexer_lookahead_column(p->lexer);
+    lexeme = m2t_lexer_lookahead_lexeme(p->lexer);
+    lexstr = m2t_string_char_ptr(lexeme);
+    
+    /* abandon the source if the error limit has already been reached */
+    abandon = m2t_error_limit_reached();
+    
+    M2C_TRACE_RESYNC(line, column);
+    
+    /* report error, suppressed beyond the error limit */
+    m2t_emit_syntax_error_w_set
+      (line, column, lookahead, lexstr, expected_set);
+    
+    /* print source line */
+    if ((m2t_option_verbose()) && (!abandon)) {
+      m2t_print_line_and_mark_column(p->lexer, line, column);
+    } /* end if */
+        
+    /* update error count */
+    p->error_count++;
+    
+    /* skip to the end of the input when abandoning the source */
+    if (abandon) {
+      resync_set = m2t_tokenset_from_list(TOKEN_END_OF_FILE, 0);
+    } /* end if */
+    
+    /* skip symbols until lookahead matches resync_set */
+    m2t_lexer_skip_to_set(p->lexer, resync_set);
+    return false;
+  } /* end if */
+} /* end match_set */
+
+
+/* --------------------------------------------------------------------------
+ * procedure report_error_w_offending_lexeme(error, lexeme, line, column)
+ * ----------------------------------------------------------------------- */
+
+static void report_error_w_offending_lexeme
+  (m2t_error_t error,
+   m2t_parser_context_t p,
+   m2t_string_t lexeme, uint_t line, uint_t column) {
+    
+  m2t_emit_error_w_lex(error, line, column, m2t_string_char_ptr(lexeme));
+  
+  if (m2t_option_verbose()) {
+    m2t_print_line_and_mark_column(p->lexer, line, column);
+  } /* end if */
+  
+  p->error_count++;
+  return;
+} /* end report_error_w_offending_lexeme */
+
+
+/* ************************************************************************ *
+ * AST Streaming                                                            *
+ * ************************************************************************ */
+
+/* --------------------------------------------------------------------------
+ * procedure stream_open_node(p, node_type)
+ * --------------------------------------------------------------------------
+ * Reports the opening of a spine node of node_type to the stream handler.
+ * ----------------------------------------------------------------------- */
+
+static void stream_open_node
+  (m2t_parser_context_t p, m2t_ast_nodetype_t node_type) {
+  
+  p->stream(M2T_PARSE_EVENT_OPEN, node_type, NULL, p->stream_context);
+  
+  p->stream_open[p->stream_depth] = node_type;
+  p->stream_depth++;
+  
+  return;
+} /* end stream_open_node */
+
+
+/* --------------------------------------------------------------------------
+ * procedure stream_node(p, node)
+ * --------------------------------------------------------------------------
+ * Reports the complete subtree of node to the stream handler, then
+ * releases it.
+ * ----------------------------------------------------------------------- */
+
+static void stream_node (m2t_parser_context_t p, m2t_astnode_t node) {
+  
+  p->stream(M2T_PARSE_EVENT_NODE,
+    m2t_ast_nodetype(node), node, p->stream_context);
+  
+  m2t_ast_release_tree(node);
+  
+  return;
+} /* end stream_node */
+
+
+/* --------------------------------------------------------------------------
+ * procedure stream_close_node(p)
+ * --------------------------------------------------------------------------
+ * Reports the closing of the innermost open spine node to the stream
+ * handler.
+ * ----------------------------------------------------------------------- */
+
+static void stream_close_node (m2t_parser_context_t p) {
+  
+  p->stream_depth--;
+  
+  p->stream(M2T_PARSE_EVENT_CLOSE,
+    p->stream_open[p->stream_depth], NULL, p->stream_context);
+  
+  return;
+} /* end stream_close_node */
+
+
+/* --------------------------------------------------------------------------
+ * procedure stream_list_item(p, list_type, node)
+ * --------------------------------------------------------------------------
+ * Reports node as an item of a spine list node of list_type, opening the
+ * list node when node is its first item.
+ * ----------------------------------------------------------------------- */
+
+static void stream_list_item
+  (m2t_parser_context_t p, m2t_ast_nodetype_t list_type, m2t_astnode_t node) {
+  
+  if (p->list_open == false) {
+    stream_open_node(p, list_type);
+    p->list_open = true;
+  } /* end if */
+  
+  stream_node(p, node);
+  
+  return;
+} /* end stream_list_item */
+
+
+/* --------------------------------------------------------------------------
+ * function stream_list_end(p)
+ * --------------------------------------------------------------------------
+ * Closes the spine list node opened by stream_list_item() and returns true,
+ * or returns false if the list had no items and was therefore not opened.
+ * ----------------------------------------------------------------------- */
+
+static bool stream_list_end (m2t_parser_context_t p) {
+  
+  if (p->list_open == false) {
+    return false;
+  } /* end if */
+  
+  stream_close_node(p);
+  p->list_open = false;
+  
+  return true;
+} /* end stream_list_end */
+
+
+/* ************************************************************************ *
+ * Scratch Lists                                                            *
+ * ************************************************************************ */
+
+/* --------------------------------------------------------------------------
+ * function scratch_mark(p)
+ * --------------------------------------------------------------------------
+ * Returns the current top of the scratch stack of p.  A list production
+ * obtains a mark before it pushes its first entry.
+ * ----------------------------------------------------------------------- */
+
+static uint_t scratch_mark (m2t_parser_context_t p) {
+  return p->scratch.top;
+} /* end scratch_mark */
+
+
+/* --------------------------------------------------------------------------
+ * procedure scratch_push(p, value)
+ * --------------------------------------------------------------------------
+ * Pushes value onto the scratch stack of p, growing the stack if its
+ * capacity is exhausted.  If growing fails, value is dropped and the
+ * parser status is set to M2T_PARSER_STATUS_ALLOCATION_FAILED.
+ * ----------------------------------------------------------------------- */
+
+static void scratch_push (m2t_parser_context_t p, m2t_fifo_value_t value) {
+  
+  m2t_fifo_value_t *new_entry;
+  uint_t new_capacity;
+  
+  if (p->scratch.top == p->scratch.capacity) {
+    if (p->scratch.capacity == 0) {
+      new_capacity = M2T_SCRATCH_INITIAL_CAPACITY;
+    }
+    else {
+      new_capacity = 2 * p->scratch.capacity;
+    } /* end if */
+    
+    new_entry = realloc(p->scratch.entry,
+      new_capacity * sizeof(m2t_fifo_value_t));
+    
+    if (new_entry == NULL) {
+      p->status = M2T_PARSER_STATUS_ALLOCATION_FAILED;
+      return;
+    } /* end if */
+    
+    p->scratch.entry = new_entry;
+    p->scratch.capacity = new_capacity;
+  } /* end if */
+  
+  p->scratch.entry[p->scratch.top] = value;
+  p->scratch.top++;
+  
+  return;
+} /* end scratch_push */
+
+
+/* --------------------------------------------------------------------------
+ * function scratch_count(p, mark)
+ * --------------------------------------------------------------------------
+ * Returns the number of entries pushed onto the scratch stack of p since
+ * mark was obtained.
+ * ----------------------------------------------------------------------- */
+
+static uint_t scratch_count (m2t_parser_context_t p, uint_t mark) {
+  return p->scratch.top - mark;
+} /* end scratch_count */
+
+
+/* --------------------------------------------------------------------------
+ * function scratch_slice(p, mark)
+ * --------------------------------------------------------------------------
+ * Returns a pointer to the first entry pushed onto the scratch stack of p
+ * since mark was obtained.  The pointer is invalidated by the next push.
+ * ----------------------------------------------------------------------- */
+
+static const m2t_fifo_value_t *scratch_slice
+  (m2t_parser_context_t p, uint_t mark) {
+  return p->scratch.entry + mark;
+} /* end scratch_slice */
+
+
+/* --------------------------------------------------------------------------
+ * function scratch_contains(p, mark, value)
+ * --------------------------------------------------------------------------
+ * Returns true if value has been pushed onto the scratch stack of p since
+ * mark was obtained, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+static bool scratch_contains
+  (m2t_parser_context_t p, uint_t mark, m2t_fifo_value_t value) {
+  
+  uint_t index;
+  
+  for (index = mark; index < p->scratch.top; index++) {
+    if (p->scratch.entry[index] == value) {
+      return true;
+    } /* end if */
+  } /* end for */
+  
+  return false;
+} /* end scratch_contains */
+
+
+/* --------------------------------------------------------------------------
+ * procedure scratch_release(p, mark)
+ * --------------------------------------------------------------------------
+ * Pops all entries pushed onto the scratch stack of p since mark was
+ * obtained.  The storage is retained for reuse.
+ * ----------------------------------------------------------------------- */
+
+static void scratch_release (m2t_parser_context_t p, uint_t mark) {
+  p->scratch.top = mark;
+  return;
+} /* end scratch_release */
+
+
+/* --------------------------------------------------------------------------
+ * function scratch_list_node(p, node_type, mark)
+ * --------------------------------------------------------------------------
+ * Returns a new list node of node_type holding the entries pushed onto the
+ * scratch stack of p since mark was obtained, then releases the entries.
+ * ----------------------------------------------------------------------- */
+
+static m2t_astnode_t scratch_list_node
+  (m2t_parser_context_t p, m2t_ast_nodetype_t node_type, uint_t mark) {
+  
+  m2t_astnode_t node;
+  
+  node = m2t_ast_new_list_node_from_slice
+    (node_type, scratch_count(p, mark), scratch_slice(p, mark));
+  
+  scratch_release(p, mark);
+  
+  return node;
+} /* end scratch_list_node */
+
+
+/* --------------------------------------------------------------------------
+ * function scratch_terminal_list_node(p, node_type, mark)
+ * --------------------------------------------------------------------------
+ * Returns a new terminal list node of node_type holding the values pushed
+ * onto the scratch stack of p since mark was obtained, then releases the
+ * values.
+ * ----------------------------------------------------------------------- */
+
+static m2t_astnode_t scratch_terminal_list_node
+  (m2t_parser_context_t p, m2t_ast_nodetype_t node_type, uint_t mark) {
+  
+  m2t_astnode_t node;
+  
+  node = m2t_ast_new_terminal_list_node_from_slice
+    (node_type, scratch_count(p, mark), scratch_slice(p, mark));
+  
+  scratch_release(p, mark);
+  
+  return node;
+} /* end scratch_terminal_list_node */
+
+
+/* ************************************************************************ *
+ * Case Labels                                                              *
+ * ************************************************************************ */
+
+/* --------------------------------------------------------------------------
+ * function const_folder(p)
+ * --------------------------------------------------------------------------
+ * Returns the constant folder of p, allocating it on first use.  Returns
+ * NULL if it could not be allocated.
+ * ----------------------------------------------------------------------- */
+
+static m2t_const_folder_t const_folder (m2t_parser_context_t p) {
+  
+  if (p->folder == NULL) {
+    p->folder = m2t_new_const_folder();
+  } /* end if */
+  
+  return p->folder;
+} /* end const_folder */
+
+
+/* --------------------------------------------------------------------------
+ * procedure bind_constant(p, ident, expr)
+ * --------------------------------------------------------------------------
+ * Binds constant identifier ident to expression expr for the folding of
+ * case labels.  A constant declared within a procedure or local module may
+ * shadow a constant of the same name only within its own scope.  Since the
+ * parser does not track scopes, ident is bound to an empty node instead,
+ * which folds to an unknown value.
+ * ----------------------------------------------------------------------- */
+
+static void bind_constant
+  (m2t_parser_context_t p, m2t_string_t ident, m2t_astnode_t expr) {
+  
+  if (p->block_depth > 1) {
+    expr = m2t_ast_empty_node();
+  } /* end if */
+  
+  m2t_const_folder_bind(const_folder(p), ident, expr);
+  
+  return;
+} /* end bind_constant */
+
+
+/* --------------------------------------------------------------------------
+ * procedure shadow_enum_values(p, idlist)
+ * --------------------------------------------------------------------------
+ * Binds the identifiers of identifier list idlist of an enumeration type
+ * declared within a procedure or local module to an empty node, since they
+ * may shadow constants of the same name.  Case labels that refer to them
+ * are thus not folded.
+ * ----------------------------------------------------------------------- */
+
+static void shadow_enum_values (m2t_parser_context_t p, m2t_astnode_t idlist) {
+  
+  uint_t index, count;
+  
+  if ((p->block_depth <= 1) || (idlist == NULL)) {
+    return;
+  } /* end if */
+  
+  count = m2t_ast_subnode_count(idlist);
+  for (index = 0; index < count; index++) {
+    m2t_const_folder_bind(const_folder(p),
+      m2t_ast_value_for_index(idlist, index), m2t_ast_empty_node());
+  } /* end for */
+  
+  return;
+} /* end shadow_enum_values */
+
+
+/* --------------------------------------------------------------------------
+ * function label_mark(p)
+ * --------------------------------------------------------------------------
+ * Returns a mark for the case labels recorded by p, allocating the label
+ * set of p on first use.  A CASE statement or variant field list obtains a
+ * mark before the labels of its first branch are recorded.
+ * ----------------------------------------------------------------------- */
+
+static uint_t label_mark (m2t_parser_context_t p) {
+  
+  if (p->labels == NULL) {
+    p->labels = m2t_new_label_set();
   } /* end if */
-} /* end match_token */
+  
+  return m2t_label_set_mark(p->labels);
+} /* end label_mark */
 
 
 /* --------------------------------------------------------------------------
- * private function match_set(p, expected_set, resync_set)
+ * procedure record_case_label(p, lower, upper, offset)
  * --------------------------------------------------------------------------
- * Matches the lookahead symbol to set expected_set and returns true if it
- * matches any of the tokens in the set.  If there is no match, a syntax
- * error is reported, the error count is incremented, symbols are consumed
- * until the lookahead symbol matches one of the symbols in resync_set and
- * false is returned.
+ * Folds the bounds lower and upper of the case label at source offset and
+ * records the label for the current branch of p.  If upper is an empty node
+ * the label denotes the single value lower.  Labels whose bounds are missing
+ * or cannot be folded to ordinal values are not recorded.
  * ----------------------------------------------------------------------- */
 
-bool match_set
+static bool ordinal_value
+  (m2t_parser_context_t p, m2t_astnode_t expr, int64_t *value);
+
+static void record_case_label
   (m2t_parser_context_t p,
-   m2t_tokenset_t expected_set,
-   m2t_tokenset_t resync_set) {
+   m2t_astnode_t lower, m2t_astnode_t upper, uint32_t offset) {
   
-  m2t_string_t lexeme;
-  const char *lexstr;
-  uint_t line, column;
-  m2t_token_t lookahead;
+  int64_t low, high;
   
-  lookahead = m2t_next_sym(p->lexer);
+  if ((p->labels == NULL) || (NOT(ordinal_value(p, lower, &low)))) {
+    return;
+  } /* end if */
   
-  /* check if lookahead matches any token in expected_set */
-  if (m2t_tokenset_element(expected_set, lookahead)) {
-    return true;
+  if ((upper != NULL) && (m2t_ast_nodetype(upper) == AST_EMPTY)) {
+    high = low;
   }
-  else /* no match */ {
-    /* get details for offending lookahead symbol */
-    line = m2t_lexer_lookahead_line(p->lexer);
-    column = m2t_lexer_lookahead_column(p->lexer);
-    lexeme = m2t_lexer_lookahead_lexeme(p->lexer);
-    lexstr = m2t_string_char_ptr(lexeme);
-    
-    /* report error */
-    m2t_emit_syntax_error_w_set
-      (line, column, lookahead, lexstr, expected_set);
-    
-    /* print source line */
-    if (m2t_option_verbose()) {
-      m2t_print_line_and_mark_column(p->lexer, line, column);
-    } /* end if */
-        
-    /* update error count */
-    p->error_count++;
-    
-    /* skip symbols until lookahead matches resync_set */
-    while (!m2t_tokenset_element(resync_set, lookahead)) {
-      lookahead = m2t_consume_sym(p->lexer);
-    } /* end while */
-    return false;
+  else if (NOT(ordinal_value(p, upper, &high))) {
+    return;
   } /* end if */
-} /* end match_set */
+  
+  m2t_label_set_add(p->labels, low, high, p->branch, offset);
+  
+  return;
+} /* end record_case_label */
 
 
 /* --------------------------------------------------------------------------
- * procedure report_error_w_offending_lexeme(error, lexeme, line, column)
+ * function ordinal_value(p, expr, value)
+ * --------------------------------------------------------------------------
+ * Folds expr and passes its value back in value if it is a whole number, a
+ * character code or a Boolean value.  Returns true on success, or false if
+ * expr could not be folded to an ordinal value.
  * ----------------------------------------------------------------------- */
 
-static void report_error_w_offending_lexeme
-  (m2t_error_t error,
-   m2t_parser_context_t p,
-   m2t_string_t lexeme, uint_t line, uint_t column) {
+static bool ordinal_value
+  (m2t_parser_context_t p, m2t_astnode_t expr, int64_t *value) {
+  
+  m2t_const_value_t folded;
+  
+  if ((expr == NULL) ||
+      (NOT(m2t_const_fold(const_folder(p), expr, &folded)))) {
+    return false;
+  } /* end if */
+  
+  switch (folded.kind) {
+    case M2T_CONST_WHOLE :
+    case M2T_CONST_CHAR :
+      *value = folded.value.whole;
+      return true;
     
-  m2t_emit_error_w_lex(error, line, column, m2t_string_char_ptr(lexeme));
+    case M2T_CONST_BOOLEAN :
+      *value = (folded.value.boolean) ? 1 : 0;
+      return true;
+    
+    default :
+      return false;
+  } /* end switch */
+} /* end ordinal_value */
+
+
+/* --------------------------------------------------------------------------
+ * procedure check_case_labels(p, mark)
+ * --------------------------------------------------------------------------
+ * Sorts the case labels recorded by p since mark, reports every label that
+ * duplicates or overlaps a preceding label and releases the labels.
+ * ----------------------------------------------------------------------- */
+
+static void check_case_labels (m2t_parser_context_t p, uint_t mark) {
   
-  if (m2t_option_verbose()) {
-    m2t_print_line_and_mark_column(p->lexer, line, column);
+  const m2t_label_interval_t *label;
+  uint_t index, count, line, column;
+  
+  if (m2t_label_set_sort(p->labels, mark) > 0) {
+    count = m2t_label_set_count(p->labels);
+    
+    for (index = mark; index < count; index++) {
+      label = m2t_label_set_interval(p->labels, index);
+      
+      if (label->overlaps) {
+        m2t_lexer_position_for_offset
+          (p->lexer, label->offset, &line, &column);
+        
+        m2t_emit_error_w_pos(M2T_ERROR_DUPLICATE_CASE_LABEL, line, column);
+        
+        /* print source line */
+        if (m2t_option_verbose()) {
+          m2t_print_line_and_mark_column(p->lexer, line, column);
+        } /* end if */
+        
+        p->error_count++;
+      } /* end if */
+    } /* end for */
   } /* end if */
   
-  p->error_count++;
+  m2t_label_set_reset(p->labels, mark);
+  
   return;
-} /* end report_error_w_offending_lexeme */
+} /* end check_case_labels */
 
 
 /* ************************************************************************ *
@@ -329,9 +2325,23 @@ static void parse_start_symbol
   m2t_astnode_t id, opt;
   m2t_string_t ident;
   m2t_token_t lookahead;
+  uint32_t first;
+  
+  ident = m2t_get_string(p->filename);
+  
+  /* a streamed root is opened before the compilation unit is parsed */
+  if (p->stream != NULL) {
+    stream_open_node(p, AST_ROOT);
+    stream_node(p, m2t_ast_new_terminal_node(AST_IDENT, ident));
+    stream_node(p, m2t_ast_empty_node()); /* TO DO : encode options */
+  } /* end if */
   
   lookahead = m2t_next_sym(p->lexer);
   
+  /* comments preceding the module heading are attached to the module */
+  first = 0;
+  COMMENT_MARK(p, first);
+  
   switch (srctype) {
     M2T_ANY_SOURCE :
       if ((lookahead == TOKEN_DEFINITION) ||
@@ -370,10 +2380,17 @@ static void parse_start_symbol
   } /* end switch */
   
   /* build AST node and pass it back in p->ast */
-  ident = m2t_get_string(p->filename);
-  id = m2t_ast_new_terminal_node(AST_IDENT, ident);
-  opt = m2t_ast_empty_node(); /* TO DO : encode options */
-  p->ast = m2t_ast_new_node(AST_ROOT, id, opt, p->ast, NULL);
+  if (p->stream != NULL) {
+    stream_close_node(p);
+    p->ast = NULL;
+  }
+  else {
+    COMMENT_LEAD(p, first, p->ast);
+    
+    id = m2t_ast_new_terminal_node(AST_IDENT, ident);
+    opt = m2t_ast_empty_node(); /* TO DO : encode options */
+    p->ast = m2t_ast_new_node(AST_ROOT, id, opt, p->ast, NULL);
+  } /* end if */
   
   if (lookahead != TOKEN_EOF) {
     /* TO DO: report error -- extra symbols after end of compilation unit */
@@ -447,10 +2464,12 @@ m2t_token_t definition (m2t_parser_context_t p);
 m2t_token_t definition_module (m2t_parser_context_t p) {
   m2t_astnode_t id, implist, deflist;
   m2t_string_t ident1, ident2;
-  m2t_fifo_t tmplist;
   m2t_token_t lookahead;
+  m2t_region_t region;
+  uint_t mark;
   
   PARSER_DEBUG_INFO("definitionModule");
+  PARSER_PROFILE_ENTER(DEFINITION_MODULE);
   
   /* DEFINITION */
   lookahead = m2t_consume_sym(p->lexer);
@@ -482,29 +2501,63 @@ m2t_token_t definition_module (m2t_parser_context_t p) {
     lookahead = m2t_next_sym(p->lexer);
   } /* end if */
   
-  tmplist = m2t_fifo_new_queue(NULL);
-
+  mark = scratch_mark(p);
+  
+  /* a streamed module is opened once its identifier is known */
+  if (p->stream != NULL) {
+    stream_open_node(p, AST_DEFMOD);
+    stream_node(p, m2t_ast_new_terminal_node(AST_IDENT, ident1));
+  } /* end if */
+  
   /* import* */
   while ((lookahead == TOKEN_IMPORT) ||
          (lookahead == TOKEN_FROM)) {
     lookahead = import(p);
-    m2t_fifo_enqueue(tmplist, p->ast);
+    
+    if (p->stream != NULL) {
+      stream_list_item(p, AST_IMPLIST, p->ast);
+    }
+    else {
+      scratch_push(p, p->ast);
+    } /* end if */
   } /* end while */
   
-  implist = m2t_ast_new_list_node(AST_IMPLIST, tmplist);
-  m2t_fifo_reset_queue(tmplist);
+  if ((p->stream != NULL) && (NOT(stream_list_end(p)))) {
+    stream_node(p, scratch_list_node(p, AST_IMPLIST, mark));
+  }
+  else if (p->stream == NULL) {
+    implist = scratch_list_node(p, AST_IMPLIST, mark);
+  } /* end if */
   
   /* definition* */
   while ((lookahead == TOKEN_CONST) ||
          (lookahead == TOKEN_TYPE) ||
          (lookahead == TOKEN_VAR) ||
          (lookahead == TOKEN_PROCEDURE)) {
+    
+    /* top-level definitions are recorded as regions if requested */
+    region.start = m2t_lexer_lookahead_offset(p->lexer);
     lookahead = definition(p);
-    m2t_fifo_enqueue(tmplist, p->ast);
+    
+    if (p->regions != NULL) {
+      region.end = m2t_lexer_lookahead_offset(p->lexer);
+      m2t_region_table_append(p->regions, &region);
+    } /* end if */
+    
+    if (p->stream != NULL) {
+      stream_list_item(p, AST_DEFLIST, p->ast);
+    }
+    else {
+      scratch_push(p, p->ast);
+    } /* end if */
   } /* end while */
   
-  deflist = m2t_ast_new_list_node(AST_DEFLIST, tmplist);
-  m2t_fifo_release_queue(tmplist);
+  if ((p->stream != NULL) && (NOT(stream_list_end(p)))) {
+    stream_node(p, scratch_list_node(p, AST_DEFLIST, mark));
+  }
+  else if (p->stream == NULL) {
+    deflist = scratch_list_node(p, AST_DEFLIST, mark);
+  } /* end if */
   
   /* END */
   if (match_token(p, TOKEN_END, FOLLOW(DEFINITION_MODULE))) {
@@ -527,8 +2580,16 @@ m2t_token_t definition_module (m2t_parser_context_t p) {
   } /* end if */
   
   /* build AST node and pass it back in p->ast */
-  id = m2t_ast_new_terminal_node(AST_IDENT, ident1);
-  p->ast = m2t_ast_new_node(AST_DEFMOD, id, implist, deflist, NULL);
+  if (p->stream != NULL) {
+    stream_close_node(p);
+    p->ast = NULL;
+  }
+  else {
+    id = m2t_ast_new_terminal_node(AST_IDENT, ident1);
+    p->ast = m2t_ast_new_node(AST_DEFMOD, id, implist, deflist, NULL);
+  } /* end if */
+  
+  PARSER_PROFILE_EXIT(DEFINITION_MODULE);
   
   return lookahead;
 } /* end definition_module */
@@ -551,6 +2612,7 @@ m2t_token_t import (m2t_parser_context_t p) {
   m2t_token_t lookahead = m2t_next_sym(p->lexer);
   
   PARSER_DEBUG_INFO("import");
+  PARSER_PROFILE_ENTER(IMPORT);
   
   lookahead = m2t_next_sym(p->lexer);
   
@@ -573,6 +2635,8 @@ m2t_token_t import (m2t_parser_context_t p) {
   
   /* AST node is passed through in p->ast */
   
+  PARSER_PROFILE_EXIT(IMPORT);
+  
   return lookahead;
 } /* end import */
 
@@ -596,6 +2660,7 @@ m2t_token_t qualified_import (m2t_parser_context_t p) {
   m2t_token_t lookahead;
   
   PARSER_DEBUG_INFO("qualifiedImport");
+  PARSER_PROFILE_ENTER(QUALIFIED_IMPORT);
   
   /* IMPORT */
   lookahead = m2t_consume_sym(p->lexer);
@@ -609,6 +2674,8 @@ m2t_token_t qualified_import (m2t_parser_context_t p) {
   /* build AST node and pass it back in p->ast */
   p->ast = m2t_ast_new_node(AST_IMPORT, idlist, NULL);
   
+  PARSER_PROFILE_EXIT(QUALIFIED_IMPORT);
+  
   return lookahead;
 } /* end qualified_import */
 
@@ -631,6 +2698,7 @@ m2t_token_t unqualified_import (m2t_parser_context_t p) {
   m2t_token_t lookahead;
   
   PARSER_DEBUG_INFO("unqualifiedImport");
+  PARSER_PROFILE_ENTER(UNQUALIFIED_IMPORT);
   
   /* FROM */
   lookahead = m2t_consume_sym(p->lexer);
@@ -657,6 +2725,8 @@ m2t_token_t unqualified_import (m2t_parser_context_t p) {
   id = m2t_ast_new_terminal_node(AST_IDENT, ident);
   p->ast = m2t_ast_new_node(AST_UNQIMP, id, idlist, NULL);
   
+  PARSER_PROFILE_EXIT(UNQUALIFIED_IMPORT);
+  
   return lookahead;
 } /* end unqualified_import */
 
@@ -673,18 +2743,19 @@ m2t_token_t unqualified_import (m2t_parser_context_t p) {
 
 m2t_token_t ident_list (m2t_parser_context_t p) {
   m2t_string_t ident;
-  m2t_fifo_t tmplist;
-  uint_t line, column;
+  uint_t line, column, mark;
   m2t_token_t lookahead;
   
   PARSER_DEBUG_INFO("identList");
+  PARSER_PROFILE_ENTER(IDENT_LIST);
   
   /* Ident */
   ident = m2t_lexer_lookahead_lexeme(p->lexer);
   lookahead = m2t_consume_sym(p->lexer);
   
-  /* add ident to temporary list */
-  tmplist = m2t_fifo_new_queue(ident);
+  /* add ident to scratch list */
+  mark = scratch_mark(p);
+  scratch_push(p, ident);
   
   /* ( ',' Ident )* */
   while (lookahead == TOKEN_COMMA) {
@@ -696,8 +2767,8 @@ m2t_token_t ident_list (m2t_parser_context_t p) {
       lookahead = m2t_consume_sym(p->lexer);
       ident = m2t_lexer_current_lexeme(p->lexer);
       
-      /* check for duplicate identifier */
-      if (m2t_fifo_entry_exists(id_list, ident)) {
+      /* check for duplicate identifier, lists are short */
+      if (scratch_contains(p, mark, ident)) {
         line = m2t_lexer_current_line(p->lexer);
         column = m2t_lexer_current_column(p->lexer);
         report_error_w_offending_lexeme
@@ -705,16 +2776,17 @@ m2t_token_t ident_list (m2t_parser_context_t p) {
            m2t_lexer_current_lexeme(p->lexer), line, column);
       }
       else /* not a duplicate */ {
-        /* add ident to temporary list */
-        m2t_fifo_enqueue(tmplist, ident);
+        /* add ident to scratch list */
+        scratch_push(p, ident);
       } /* end if */
     } /* end if */
   } /* end while */
   
   /* build AST node and pass it back in p->ast */
-  p->ast = m2t_ast_new_node(AST_IDENTLIST, tmplist);
-  m2t_fifo_release_queue(tmplist);
+  p->ast = scratch_terminal_list_node(p, AST_IDENTLIST, mark);
     
+  PARSER_PROFILE_EXIT(IDENT_LIST);
+  
   return lookahead;
 } /* end ident_list */
 
@@ -742,11 +2814,18 @@ m2t_token_t procedure_header (m2t_parser_context_t p);
 
 m2t_token_t definition (m2t_parser_context_t p) {
   m2t_token_t lookahead;
+  m2t_astnode_t node;
+  uint32_t first;
   
   PARSER_DEBUG_INFO("definition");
+  PARSER_PROFILE_ENTER(DEFINITION);
   
   lookahead = m2t_next_sym(p->lexer);
   
+  /* comments preceding the first item are attached to it */
+  first = 0;
+  COMMENT_MARK(p, first);
+  
   switch (lookahead) {
     
     /* CONST */
@@ -756,12 +2835,17 @@ m2t_token_t definition (m2t_parser_context_t p) {
       /* ( constDefinition ';' )* */
       while (lookahead == TOKEN_IDENTIFIER) {
         lookahead = const_definition(p); /* p->ast holds ast-node */
+        node = p->ast;
         
         /* ';' */
         if (match_token(p, TOKEN_SEMICOLON,
             RESYNC(DEFINITION_OR_IDENT_OR_SEMICOLON))) {
           lookahead = m2t_consume_sym(p->lexer);
         } /* end if */
+        
+        /* attach comments up to and including ';' */
+        COMMENT_ATTACH(p, first, node);
+        COMMENT_MARK(p, first);
       } /* end while */
       break;
       
@@ -772,12 +2856,17 @@ m2t_token_t definition (m2t_parser_context_t p) {
       /* ( typeDefinition ';' )* */
       while (lookahead == TOKEN_IDENTIFIER) {
         lookahead = type_definition(p); /* p->ast holds ast-node */
+        node = p->ast;
         
         /* ';' */
         if (match_token(p, TOKEN_SEMICOLON,
             RESYNC(DEFINITION_OR_IDENT_OR_SEMICOLON))) {
           lookahead = m2t_consume_sym(p->lexer);
         } /* end if */
+        
+        /* attach comments up to and including ';' */
+        COMMENT_ATTACH(p, first, node);
+        COMMENT_MARK(p, first);
       } /* end while */
       break;
       
@@ -788,24 +2877,33 @@ m2t_token_t definition (m2t_parser_context_t p) {
       /* ( varDefinition ';' )* */
       while (lookahead == TOKEN_IDENTIFIER) {
         lookahead = variable_declaration(p); /* p->ast holds ast-node */
+        node = p->ast;
         
         /* ';' */
         if (match_token(p, TOKEN_SEMICOLON,
             RESYNC(DEFINITION_OR_IDENT_OR_SEMICOLON))) {
           lookahead = m2t_consume_sym(p->lexer);
         } /* end if */
+        
+        /* attach comments up to and including ';' */
+        COMMENT_ATTACH(p, first, node);
+        COMMENT_MARK(p, first);
       } /* end while */
       break;
       
     /* | procedureHeader */
     case TOKEN_PROCEDURE :
       lookahead = procedure_header(p); /* p->ast holds ast-node */
+      node = p->ast;
       
       /* ';' */
       if (match_token(p, TOKEN_SEMICOLON,
           RESYNC(DEFINITION_OR_SEMICOLON))) {
         lookahead = m2t_consume_sym(p->lexer);
       } /* end if */
+      
+      /* attach comments up to and including ';' */
+      COMMENT_ATTACH(p, first, node);
       break;
       
     default : /* unreachable code */
@@ -815,6 +2913,8 @@ m2t_token_t definition (m2t_parser_context_t p) {
   
   /* AST node is passed through in p->ast */
   
+  PARSER_PROFILE_EXIT(DEFINITION);
+  
   return lookahead;
 } /* end definition */
 
@@ -837,6 +2937,7 @@ m2t_token_t const_definition (m2t_parser_context_t p) {
   m2t_token_t lookahead;
     
   PARSER_DEBUG_INFO("constDefinition");
+  PARSER_PROFILE_ENTER(CONST_DEFINITION);
   
   /* Ident */
   lookahead = m2t_consume_sym(p->lexer);
@@ -850,6 +2951,7 @@ m2t_token_t const_definition (m2t_parser_context_t p) {
     if (match_set(p, FIRST(EXPRESSION), FOLLOW(CONST_DEFINITION))) {
       lookahead = const_expression(p);
       expr = p->ast;
+      bind_constant(p, ident, expr);
     } /* end if */
   } /* end if */
   
@@ -857,6 +2959,8 @@ m2t_token_t const_definition (m2t_parser_context_t p) {
   id = m2t_ast_new_terminal_node(AST_IDENT, ident);
   p->ast = m2t_ast_new_node(AST_CONSTDEF, id, expr, NULL);
   
+  PARSER_PROFILE_EXIT(CONST_DEFINITION);
+  
   return lookahead;
 } /* end const_definition */
 
@@ -879,6 +2983,7 @@ m2t_token_t type_definition (m2t_parser_context_t p) {
   m2t_token_t lookahead;
     
   PARSER_DEBUG_INFO("typeDefinition");
+  PARSER_PROFILE_ENTER(TYPE_DEFINITION);
   
   /* Ident */
   lookahead = m2t_consume_sym(p->lexer);
@@ -902,6 +3007,8 @@ m2t_token_t type_definition (m2t_parser_context_t p) {
   id = m2t_ast_new_terminal_node(AST_IDENT, ident);
   p->ast = m2t_ast_new_node(AST_TYPEDEF, id, tc, NULL);
   
+  PARSER_PROFILE_EXIT(TYPE_DEFINITION);
+  
   return lookahead;
 } /* end type_definition */
 
@@ -928,10 +3035,13 @@ m2t_token_t pointer_type (m2t_parser_context_t p);
 m2t_token_t procedure_type (m2t_parser_context_t p);
 
 m2t_token_t type (m2t_parser_context_t p) {
+  m2t_source_span_t span;
   m2t_token_t lookahead;
   
   PARSER_DEBUG_INFO("type");
+  PARSER_PROFILE_ENTER(TYPE);
   
+  SPAN_BEGIN(p, span);
   lookahead = m2t_next_sym(p->lexer);
   
   switch (lookahead) {
@@ -978,6 +3088,10 @@ m2t_token_t type (m2t_parser_context_t p) {
     } /* end switch */
   
   /* AST node is passed through in p->ast */
+  TYPE_INTERN(p);
+  SPAN_END(p, span, p->ast);
+  
+  PARSER_PROFILE_EXIT(TYPE);
   
   return lookahead;
 } /* end type */
@@ -1002,6 +3116,7 @@ m2t_token_t derived_or_subrange_type (m2t_parser_context_t p) {
   m2t_token_t lookahead;
   
   PARSER_DEBUG_INFO("derivedOrSubrangeType");
+  PARSER_PROFILE_ENTER(DERIVED_OR_SUBRANGE_TYPE);
   
   lookahead = m2t_next_sym(p->lexer);
   
@@ -1036,6 +3151,8 @@ m2t_token_t derived_or_subrange_type (m2t_parser_context_t p) {
   
   /* AST node is passed through in p->ast */
   
+  PARSER_PROFILE_EXIT(DERIVED_OR_SUBRANGE_TYPE);
+  
   return lookahead;
 } /* end derived_or_subrange_type */
 
@@ -1052,17 +3169,19 @@ m2t_token_t derived_or_subrange_type (m2t_parser_context_t p) {
 
 m2t_token_t qualident (m2t_parser_context_t p) {
   m2t_string_t ident, qident;
-  m2t_fifo_t tmplist;
   m2t_token_t lookahead;
+  uint_t mark;
   
   PARSER_DEBUG_INFO("qualident");
+  PARSER_PROFILE_ENTER(QUALIDENT);
   
   /* Ident */
   lookahead = m2t_consume_sym(p->lexer);
   ident = m2t_lexer_current_lexeme(p->lexer);
   
-  /* add ident to temporary list */
-  tmplist = m2t_fifo_new_queue(ident);
+  /* add ident to scratch list */
+  mark = scratch_mark(p);
+  scratch_push(p, ident);
   
   /* ( '.' Ident )* */
   while (lookahead == TOKEN_PERIOD) {
@@ -1073,19 +3192,20 @@ m2t_token_t qualident (m2t_parser_context_t p) {
     if (match_token(p, TOKEN_IDENTIFIER, FOLLOW(QUALIDENT))) {
       lookahead = m2t_consume_sym(p->lexer);
       qident = m2t_lexer_current_lexeme(p->lexer);
-      m2t_fifo_enqueue(tmplist, qident);
+      scratch_push(p, qident);
     } /* end if */
   } /* end while */
   
   /* build AST node and pass it back in p->ast */
-  if (m2t_fifo_entry_count(tmplist) == 1) {
+  if (scratch_count(p, mark) == 1) {
+    scratch_release(p, mark);
     p->ast = m2t_ast_new_terminal_node(AST_IDENT, ident, NULL);
   }
   else {
-    p->ast = m2t_ast_new_terminal_list_node(AST_QUALIDENT, tmplist);
+    p->ast = scratch_terminal_list_node(p, AST_QUALIDENT, mark);
   } /* end if */
   
-  m2t_fifo_release(tmplist);
+  PARSER_PROFILE_EXIT(QUALIDENT);
   
   return lookahead;
 } /* end qualident */
@@ -1106,6 +3226,7 @@ m2t_token_t range (m2t_parser_context_t p) {
   m2t_token_t lookahead;
   
   PARSER_DEBUG_INFO("range");
+  PARSER_PROFILE_ENTER(RANGE);
   
   /* '[' */
   lookahead = m2t_consume_sym(p->lexer);
@@ -1136,6 +3257,8 @@ m2t_token_t range (m2t_parser_context_t p) {
   empty = m2t_ast_empty_node();
   p->ast = m2t_ast_new_node(AST_SUBR, lower, upper, empty, NULL);
   
+  PARSER_PROFILE_EXIT(RANGE);
+  
   return lookahead;
 } /* end range */
 
@@ -1155,6 +3278,7 @@ m2t_token_t enum_type (m2t_parser_context_t p) {
   m2t_token_t lookahead;
   
   PARSER_DEBUG_INFO("enumType");
+  PARSER_PROFILE_ENTER(ENUM_TYPE);
   
   /* '(' */
   lookahead = m2t_consume_sym(p->lexer);
@@ -1163,6 +3287,7 @@ m2t_token_t enum_type (m2t_parser_context_t p) {
   if (match_token(p, TOKEN_IDENTIFIER, FOLLOW(ENUM_TYPE))) {
     lookahead = ident_list(p);
     idlist = p->ast;
+    shadow_enum_values(p, idlist);
     
     /* ')' */
     if (match_token(p, TOKEN_RIGHT_PAREN, FOLLOW(ENUM_TYPE))) {
@@ -1173,6 +3298,8 @@ m2t_token_t enum_type (m2t_parser_context_t p) {
   /* build AST node and pass it back in p->ast */
   p->ast = m2t_ast_new_node(AST_ENUM, idlist, NULL);
   
+  PARSER_PROFILE_EXIT(ENUM_TYPE);
+  
   return lookahead;
 } /* end enum_type */
 
@@ -1194,6 +3321,7 @@ m2t_token_t set_type (m2t_parser_context_t p) {
   m2t_token_t lookahead;
   
   PARSER_DEBUG_INFO("setType");
+  PARSER_PROFILE_ENTER(SET_TYPE);
   
   /* SET */
   lookahead = m2t_consume_sym(p->lexer);
@@ -1212,6 +3340,8 @@ m2t_token_t set_type (m2t_parser_context_t p) {
   /* build AST node and pass it back in p->ast */
   p->ast = m2t_ast_new_node(AST_SET, tc, NULL);
   
+  PARSER_PROFILE_EXIT(SET_TYPE);
+  
   return lookahead;
 } /* end set_type */
 
@@ -1236,6 +3366,7 @@ m2t_token_t countable_type (m2t_parser_context_t p) {
   m2t_token_t lookahead;
   
   PARSER_DEBUG_INFO("countableType");
+  PARSER_PROFILE_ENTER(COUNTABLE_TYPE);
   
   lookahead = m2t_next_sym(p->lexer);
   
@@ -1274,6 +3405,8 @@ m2t_token_t countable_type (m2t_parser_context_t p) {
   
   /* AST node is passed through in p->ast */
   
+  PARSER_PROFILE_EXIT(COUNTABLE_TYPE);
+  
   return lookahead;
 } /* end countable_type */
 
@@ -1290,10 +3423,14 @@ m2t_token_t countable_type (m2t_parser_context_t p) {
 
 m2t_token_t array_type (m2t_parser_context_t p) {
   m2t_astnode_t idxlist, basetype;
-  m2t_fifo_t tmplist;
+  uint_t mark;
   m2t_token_t lookahead;
   
   PARSER_DEBUG_INFO("arrayType");
+  PARSER_PROFILE_ENTER(ARRAY_TYPE);
+  
+  /* list entries are pushed above mark */
+  mark = scratch_mark(p);
   
   /* ARRAY */
   lookahead = m2t_consume_sym(p->lexer);
@@ -1301,7 +3438,7 @@ m2t_token_t array_type (m2t_parser_context_t p) {
   /* countableType */
   if (match_set(p, FIRST(COUNTABLE_TYPE), FOLLOW(ARRAY_TYPE))) {
     lookahead = countable_type(p);
-    tmplist = m2t_fifo_new_queue(p->ast);
+    scratch_push(p, p->ast);
     
     /* ( ',' countableType )* */
     while (lookahead == TOKEN_COMMA) {
@@ -1310,7 +3447,7 @@ m2t_token_t array_type (m2t_parser_context_t p) {
       
       if (match_set(p, FIRST(COUNTABLE_TYPE), RESYNC(TYPE_OR_COMMA_OR_OF))) {
         lookahead = countable_type(p);
-        m2t_fifo_enqueue(tmplist, p->ast);
+        scratch_push(p, p->ast);
       }
       else /* resync */ {
         lookahead = m2t_next_sym(p->lexer);
@@ -1330,9 +3467,10 @@ m2t_token_t array_type (m2t_parser_context_t p) {
   } /* end if */
   
   /* build AST node and pass it back in p->ast */
-  idxlist = m2t_ast_new_list_node(AST_INDEXLIST, tmplist);
+  idxlist = scratch_list_node(p, AST_INDEXLIST, mark);
   p->ast = m2t_ast_new_node(AST_ARRAY, idxlist, basetype, NULL);
-  m2t_fifo_release_queue(tmplist);
+  
+  PARSER_PROFILE_EXIT(ARRAY_TYPE);
   
   return lookahead;
 } /* end array_type */
@@ -1362,6 +3500,7 @@ m2t_token_t extensible_record_type (m2t_parser_context_t p) {
   m2t_token_t lookahead;
   
   PARSER_DEBUG_INFO("recordType");
+  PARSER_PROFILE_ENTER(EXTENSIBLE_RECORD_TYPE);
   
   /* RECORD */
   lookahead = m2t_consume_sym(p->lexer);
@@ -1428,6 +3567,8 @@ m2t_token_t extensible_record_type (m2t_parser_context_t p) {
     p->ast = m2t_ast_new_node(AST_EXTREC, basetype, flseq, NULL);
   } /* end if */
   
+  PARSER_PROFILE_EXIT(EXTENSIBLE_RECORD_TYPE);
+  
   return lookahead;
 } /* end extensible_record_type */
 
@@ -1447,15 +3588,17 @@ m2t_token_t extensible_record_type (m2t_parser_context_t p) {
 m2t_token_t field_list (m2t_parser_context_t p);
 
 m2t_token_t field_list_sequence (m2t_parser_context_t p) {
-  m2t_fifo_t tmplist;
+  uint_t mark;
   m2t_token_t lookahead;
   uint_t line_of_semicolon, column_of_semicolon;
   
   PARSER_DEBUG_INFO("fieldListSequence");
+  PARSER_PROFILE_ENTER(FIELD_LIST_SEQUENCE);
   
   /* fieldList */
   lookahead = field_list(p);
-  tmplist = m2t_fifo_new_queue(p->ast);
+  mark = scratch_mark(p);
+  scratch_push(p, p->ast);
   
   /* ( ';' fieldList )* */
   while (lookahead == TOKEN_SEMICOLON) {
@@ -1467,7 +3610,7 @@ m2t_token_t field_list_sequence (m2t_parser_context_t p) {
     /* check if semicolon occurred at the end of a field list sequence */
     if (m2t_tokenset_element(FOLLOW(FIELD_LIST_SEQUENCE), lookahead)) {
     
-      if (m2t_option_errant_semicolon()) {
+      if (M2T_OPTION_IN_SET(p->options, M2T_OPTION_ERRANT_SEMICOLON)) {
         /* treat as warning */
         m2t_emit_warning_w_pos
           (M2T_SEMICOLON_AFTER_FIELD_LIST_SEQ,
@@ -1495,13 +3638,14 @@ m2t_token_t field_list_sequence (m2t_parser_context_t p) {
     if (match_set(p, FIRST(VARIABLE_DECLARATION),
         RESYNC(SEMICOLON_OR_END))) {
       lookahead = field_list(p);
-      m2t_fifo_enqueue(tmplist, p->ast);
+      scratch_push(p, p->ast);
     } /* end if */
   } /* end while */
   
   /* build AST node and pass it back in p->ast */
-  p->ast = m2t_ast_new_list_node(AST_FIELDLISTSEQ, tmplist);
-  m2t_fifo_release(tmplist);
+  p->ast = scratch_list_node(p, AST_FIELDLISTSEQ, mark);
+  
+  PARSER_PROFILE_EXIT(FIELD_LIST_SEQUENCE);
   
   return lookahead;
 } /* end field_list_sequence */
@@ -1568,6 +3712,7 @@ m2t_token_t variant_record_type (m2t_parser_context_t p) {
   m2t_token_t lookahead;
   
   PARSER_DEBUG_INFO("recordType");
+  PARSER_PROFILE_ENTER(VARIANT_RECORD_TYPE);
   
   /* RECORD */
   lookahead = m2t_consume_sym(p->lexer);
@@ -1605,6 +3750,8 @@ m2t_token_t variant_record_type (m2t_parser_context_t p) {
     p->ast = m2t_ast_new_node(AST_RECORD, flseq, NULL);
   } /* end if */
   
+  PARSER_PROFILE_EXIT(VARIANT_RECORD_TYPE);
+  
   return lookahead;
 } /* end variant_record_type */
 
@@ -1625,16 +3772,18 @@ m2t_token_t variant_record_type (m2t_parser_context_t p) {
 m2t_token_t variant_field_list (m2t_parser_context_t p);
 
 m2t_token_t variant_field_list_seq (m2t_parser_context_t p) {
-  m2t_fifo_t tmplist;
+  uint_t mark;
   m2t_token_t lookahead;
   uint_t line_of_semicolon, column_of_semicolon;
   bool variant_fieldlist_found = false;
   
   PARSER_DEBUG_INFO("variantFieldListSeq");
+  PARSER_PROFILE_ENTER(VARIANT_FIELD_LIST_SEQ);
   
   /* variantFieldList */
   lookahead = variant_field_list(p);
-  tmplist = m2t_fifo_new_queue(p->ast);
+  mark = scratch_mark(p);
+  scratch_push(p, p->ast);
   
   if (m2t_ast_nodetype(p->ast) == AST_VFLIST) {
     variant_fieldlist_found = true;
@@ -1650,7 +3799,7 @@ m2t_token_t variant_field_list_seq (m2t_parser_context_t p) {
     /* check if semicolon occurred at the end of a field list sequence */
     if (m2t_tokenset_element(FOLLOW(VARIANT_FIELD_LIST_SEQ), lookahead)) {
     
-      if (m2t_option_errant_semicolon()) {
+      if (M2T_OPTION_IN_SET(p->options, M2T_OPTION_ERRANT_SEMICOLON)) {
         /* treat as warning */
         m2t_emit_warning_w_pos
           (M2T_SEMICOLON_AFTER_FIELD_LIST_SEQ,
@@ -1678,7 +3827,7 @@ m2t_token_t variant_field_list_seq (m2t_parser_context_t p) {
     if (match_set(p, FIRST(VARIANT_FIELD_LIST),
         FOLLOW(VARIANT_FIELD_LIST))) {
       lookahead = variant_field_list(p);
-      m2t_fifo_enqueue(tmplist, p->ast);
+      scratch_push(p, p->ast);
       
       if (m2t_ast_nodetype(p->ast) == AST_VFLIST) {
         variant_fieldlist_found = true;
@@ -1688,13 +3837,13 @@ m2t_token_t variant_field_list_seq (m2t_parser_context_t p) {
   
   /* build AST node and pass it back in p->ast */
   if (variant_fieldlist_found) {
-    p->ast = m2t_ast_new_list_node(AST_VFLISTSEQ, tmplist);
+    p->ast = scratch_list_node(p, AST_VFLISTSEQ, mark);
   }
   else /* not variant field list */ {
-    p->ast = m2t_ast_new_list_node(AST_FIELDLISTSEQ, tmplist);
+    p->ast = scratch_list_node(p, AST_FIELDLISTSEQ, mark);
   } /* end if */
   
-  m2t_fifo_release(tmplist);
+  PARSER_PROFILE_EXIT(VARIANT_FIELD_LIST_SEQ);
   
   return lookahead;
 } /* end variant_field_list_seq */
@@ -1716,6 +3865,7 @@ m2t_token_t variant_field_list (m2t_parser_context_t p) {
   m2t_token_t lookahead;
   
   PARSER_DEBUG_INFO("variantFieldList");
+  PARSER_PROFILE_ENTER(VARIANT_FIELD_LIST);
   
   lookahead = m2t_next_sym(p->lexer);
   
@@ -1734,6 +3884,8 @@ m2t_token_t variant_field_list (m2t_parser_context_t p) {
   
   /* AST node is passed through in p->ast */
   
+  PARSER_PROFILE_EXIT(VARIANT_FIELD_LIST);
+  
   return lookahead;
 } /* end variant_field_list */
 
@@ -1758,11 +3910,20 @@ m2t_token_t variant (m2t_parser_context_t p);
 
 m2t_token_t variant_fields (m2t_parser_context_t p) {
   m2t_astnode_t caseid, typeid, vlist, flseq;
-  m2t_fifo_t tmplist;
+  uint_t mark, labels, outer_branch;
   m2t_string_t ident;
   m2t_token_t lookahead;
   
   PARSER_DEBUG_INFO("variantFields");
+  PARSER_PROFILE_ENTER(VARIANT_FIELDS);
+  
+  /* list entries are pushed above mark */
+  mark = scratch_mark(p);
+  
+  /* labels are recorded above labels, variants are counted from zero */
+  labels = label_mark(p);
+  outer_branch = p->branch;
+  p->branch = 0;
   
   /* CASE */
   lookahead = m2t_consume_sym(p->lexer);
@@ -1794,7 +3955,8 @@ m2t_token_t variant_fields (m2t_parser_context_t p) {
         /* variant */
         if (match_set(p, FIRST(VARIANT), RESYNC(ELSE_OR_END))) {
           lookahead = variant(p);
-          tmplist = m2t_fifo_new_queue(p->ast);
+          scratch_push(p, p->ast);
+          p->branch++;
         
           /* ( '|' variant )* */
           while (lookahead == TOKEN_BAR) {
@@ -1805,7 +3967,8 @@ m2t_token_t variant_fields (m2t_parser_context_t p) {
             /* variant */
             if (match_set(p, FIRST(VARIANT), RESYNC(ELSE_OR_END))) {
               lookahead = variant(p);
-              m2t_fifo_enqueue(tmplist, p->ast);
+              scratch_push(p, p->ast);
+              p->branch++;
             } /* end if */
           } /* end while */
         } /* end if */
@@ -1851,10 +4014,15 @@ m2t_token_t variant_fields (m2t_parser_context_t p) {
     lookahead = m2t_consume_sym(p->lexer);
   } /* end if */
   
+  /* report duplicate and overlapping labels */
+  check_case_labels(p, labels);
+  p->branch = outer_branch;
+  
   /* build AST node and pass it back in p->ast */
-  vlist = m2t_ast_new_list_node(AST_VARIANTLIST, tmplist);
+  vlist = scratch_list_node(p, AST_VARIANTLIST, mark);
   p->ast = m2t_ast_new_node(AST_VFLIST, caseid, typeid, vlist, flseq, NULL);
-  m2t_fifo_release(tmplist);
+  
+  PARSER_PROFILE_EXIT(VARIANT_FIELDS);
   
   return lookahead;
 } /* end variant_fields */
@@ -1879,6 +4047,7 @@ m2t_token_t variant (m2t_parser_context_t p) {
   m2t_token_t lookahead;
     
   PARSER_DEBUG_INFO("variant");
+  PARSER_PROFILE_ENTER(VARIANT);
   
   /* caseLabelList */
   lookahead = case_label_list(p);
@@ -1908,6 +4077,8 @@ m2t_token_t variant (m2t_parser_context_t p) {
   /* build AST node and pass it back in p->ast */
   p->ast = m2t_ast_new_node(AST_VARIANT, cllist, flseq, NULL);
   
+  PARSER_PROFILE_EXIT(VARIANT);
+  
   return lookahead;
 } /* end variant */
 
@@ -1925,14 +4096,16 @@ m2t_token_t variant (m2t_parser_context_t p) {
 m2t_token_t case_labels (m2t_parser_context_t p);
 
 m2t_token_t case_label_list (m2t_parser_context_t p) {
-  m2t_fifo_t tmplist;
+  uint_t mark;
   m2t_token_t lookahead;
   
   PARSER_DEBUG_INFO("caseLabelList");
+  PARSER_PROFILE_ENTER(CASE_LABEL_LIST);
   
   /* caseLabels */
   lookahead = case_labels(p);
-  tmplist = m2t_fifo_new_queue(p->ast);
+  mark = scratch_mark(p);
+  scratch_push(p, p->ast);
   
   /* ( ',' caseLabels )* */
   while (lookahead == TOKEN_COMMA) {
@@ -1942,13 +4115,14 @@ m2t_token_t case_label_list (m2t_parser_context_t p) {
     /* caseLabels */
     if (match_set(p, FIRST(CASE_LABELS), FOLLOW(CASE_LABEL_LIST))) {
       lookahead = case_labels(p);
-      m2t_fifo_enqueue(tmplist, p->ast);
+      scratch_push(p, p->ast);
     } /* end if */
   } /* end while */
   
   /* build AST node and pass it back in p->ast */
-  p->ast = m2t_ast_new_list_node(AST_CLABELLIST, tmplist);
-  m2t_fifo_release(tmplist);
+  p->ast = scratch_list_node(p, AST_CLABELLIST, mark);
+  
+  PARSER_PROFILE_EXIT(CASE_LABEL_LIST);
   
   return lookahead;
 } /* end case_label_list */
@@ -1966,9 +4140,13 @@ m2t_token_t case_label_list (m2t_parser_context_t p) {
 
 m2t_token_t case_labels (m2t_parser_context_t p) {
   m2t_astnode_t lower, upper;
+  uint32_t offset;
   m2t_token_t lookahead;
     
   PARSER_DEBUG_INFO("caseLabels");
+  PARSER_PROFILE_ENTER(CASE_LABELS);
+  
+  offset = m2t_lexer_lookahead_offset(p->lexer);
   
   /* constExpression */
   lookahead = const_expression(p);
@@ -1977,6 +4155,7 @@ m2t_token_t case_labels (m2t_parser_context_t p) {
   /* ( '..' constExpression )? */
   if (lookahead == TOKEN_RANGE) {
     lookahead = m2t_consume_sym(p->lexer);
+    upper = NULL;
     
     /* constExpression */
     if (match_set(p, FIRST(EXPRESSION), FOLLOW(CASE_LABELS))) {
@@ -1988,8 +4167,13 @@ m2t_token_t case_labels (m2t_parser_context_t p) {
     upper = m2t_ast_empty_node();
   } /* end if */
   
+  /* record label for duplicate and overlap check */
+  record_case_label(p, lower, upper, offset);
+  
   /* build AST node and pass it back in p->ast */
-  m2t_ast_new_node(AST_CLABELS, lower, upper, NULL);
+  p->ast = m2t_ast_new_node(AST_CLABELS, lower, upper, NULL);
+  
+  PARSER_PROFILE_EXIT(CASE_LABELS);
   
   return lookahead;
 } /* end case_labels */
@@ -2010,6 +4194,7 @@ m2t_token_t pointer_type (m2t_parser_context_t p) {
   m2t_token_t lookahead;
   
   PARSER_DEBUG_INFO("pointerType");
+  PARSER_PROFILE_ENTER(POINTER_TYPE);
   
   /* POINTER */
   lookahead = m2t_consume_sym(p->lexer);
@@ -2028,6 +4213,8 @@ m2t_token_t pointer_type (m2t_parser_context_t p) {
   /* build AST node and pass it back in p->ast */
   p->ast = m2t_ast_new_node(AST_POINTER, tc, NULL);
   
+  PARSER_PROFILE_EXIT(POINTER_TYPE);
+  
   return lookahead;
 } /* end pointer_type */
 
@@ -2049,15 +4236,17 @@ m2t_token_t formal_type (m2t_parser_context_t p);
 
 m2t_token_t procedure_type (m2t_parser_context_t p) {
   m2t_astnode_t ftlist, rtype;
-  m2t_fifo_t tmplist;
+  m2t_source_span_t span;
+  uint_t mark;
   m2t_token_t lookahead;
   
   PARSER_DEBUG_INFO("procedureType");
+  PARSER_PROFILE_ENTER(PROCEDURE_TYPE);
   
   /* PROCEDURE */
   lookahead = m2t_consume_sym(p->lexer);
   
-  tmplist = m2t_fifo_new_queue(NULL);
+  mark = scratch_mark(p);
   
   /* ( '(' ( formalType ( ',' formalType )* )? ')' )? */
   if (lookahead == TOKEN_LEFT_PAREN) {
@@ -2068,7 +4257,7 @@ m2t_token_t procedure_type (m2t_parser_context_t p) {
     if (lookahead != TOKEN_RIGHT_PAREN) {
       if (match_set(p, FIRST(FORMAL_TYPE), RESYNC(COMMA_OR_RIGHT_PAREN))) {
         lookahead = formal_type(p);
-        m2t_fifo_enqueue(tmplist, p->ast);
+        scratch_push(p, p->ast);
       }
       else /* resync */ {
         lookahead = m2t_next_sym(p->lexer);
@@ -2082,7 +4271,7 @@ m2t_token_t procedure_type (m2t_parser_context_t p) {
         /* formalType */
         if (match_set(p, FIRST(FORMAL_TYPE), RESYNC(COMMA_OR_RIGHT_PAREN))) {
           lookahead = formal_type(p);
-          m2t_fifo_enqueue(tmplist, p->ast);
+          scratch_push(p, p->ast);
         }
         else /* resync */ {
           lookahead = m2t_next_sym(p->lexer);
@@ -2106,8 +4295,10 @@ m2t_token_t procedure_type (m2t_parser_context_t p) {
     
     /* returnedType */
     if (match_token(p, TOKEN_IDENTIFIER, FOLLOW(PROCEDURE_TYPE))) {
+      SPAN_BEGIN(p, span);
       lookahead = qualident(p);
       rtype = p->ast;
+      SPAN_END(p, span, rtype);
     }
     else /* resync */ {
       lookahead = m2t_next_sym(p->lexer);
@@ -2118,18 +4309,18 @@ m2t_token_t procedure_type (m2t_parser_context_t p) {
   } /* end if */
   
   /* build formal type list node */
-  if (m2t_fifo_entry_count(tmplist) > 0) {
-    ftlist = m2t_ast_new_list_node(AST_FTYPELIST, tmplist);
+  if (scratch_count(p, mark) > 0) {
+    ftlist = scratch_list_node(p, AST_FTYPELIST, mark);
   }
   else /* no formal type list */ {
     ftlist = m2t_ast_empty_node();
   } /* end if */
   
-  m2t_fifo_release(tmplist);
-  
   /* build AST node and pass it back in p->ast */
   p->ast = m2t_ast_new_node(AST_PROCTYPE, ftlist, rtype, NULL);
   
+  PARSER_PROFILE_EXIT(PROCEDURE_TYPE);
+  
   return lookahead;
 } /* end procedure_type */
 
@@ -2147,10 +4338,13 @@ m2t_token_t simple_formal_type (m2t_parser_context_t p);
 m2t_token_t attributed_formal_type (m2t_parser_context_t p);
 
 m2t_token_t formal_type (m2t_parser_context_t p) {
+  m2t_source_span_t span;
   m2t_token_t lookahead;
   
   PARSER_DEBUG_INFO("formalType");
+  PARSER_PROFILE_ENTER(FORMAL_TYPE);
   
+  SPAN_BEGIN(p, span);
   lookahead = m2t_next_sym(p->lexer);
   
   /* simpleFormalType */
@@ -2167,6 +4361,10 @@ m2t_token_t formal_type (m2t_parser_context_t p) {
   } /* end if */
   
   /* AST node is passed through in p->ast */
+  TYPE_INTERN(p);
+  SPAN_END(p, span, p->ast);
+  
+  PARSER_PROFILE_EXIT(FORMAL_TYPE);
   
   return lookahead;
 } /* end formal_type */
@@ -2189,6 +4387,7 @@ m2t_token_t simple_formal_type (m2t_parser_context_t p) {
   bool open_array = false;
   
   PARSER_DEBUG_INFO("simpleFormalType");
+  PARSER_PROFILE_ENTER(SIMPLE_FORMAL_TYPE);
   
   lookahead = m2t_next_sym(p->lexer);
   
@@ -2220,6 +4419,8 @@ m2t_token_t simple_formal_type (m2t_parser_context_t p) {
     /* astnode: (OPENARRAY identNode) */
   } /* end if */
   
+  PARSER_PROFILE_EXIT(SIMPLE_FORMAL_TYPE);
+  
   return lookahead;
 } /* end simple_formal_type */
 
@@ -2240,6 +4441,7 @@ m2t_token_t attributed_formal_type (m2t_parser_context_t p) {
   bool const_attr = false;
   
   PARSER_DEBUG_INFO("attributedFormalType");
+  PARSER_PROFILE_ENTER(ATTRIBUTED_FORMAL_TYPE);
   
   lookahead = m2t_next_sym(p->lexer);
   
@@ -2272,6 +4474,8 @@ m2t_token_t attributed_formal_type (m2t_parser_context_t p) {
     p->ast = m2t_ast_new_node(AST_VARP, sftype, NULL);
   } /* end if */
   
+  PARSER_PROFILE_EXIT(ATTRIBUTED_FORMAL_TYPE);
+  
   return lookahead;
 } /* end attributed_formal_type */
 
@@ -2290,6 +4494,7 @@ m2t_token_t procedure_header (m2t_parser_context_t p) {
   m2t_token_t lookahead;
   
   PARSER_DEBUG_INFO("procedureHeader");
+  PARSER_PROFILE_ENTER(PROCEDURE_HEADER);
   
   /* PROCEDURE */
   lookahead = m2t_consume_sym(p->lexer);
@@ -2301,6 +4506,8 @@ m2t_token_t procedure_header (m2t_parser_context_t p) {
   
   /* AST node is passed through in p->ast */
   
+  PARSER_PROFILE_EXIT(PROCEDURE_HEADER);
+  
   return lookahead;
 } /* end procedure_header */
 
@@ -2319,10 +4526,12 @@ m2t_token_t formal_param_list (m2t_parser_context_t p);
 
 m2t_token_t procedure_signature (m2t_parser_context_t p) {
   m2t_astnode_t id, fplist, rtype;
+  m2t_source_span_t span;
   m2t_string_t ident;
   m2t_token_t lookahead;
   
   PARSER_DEBUG_INFO("procedureSignature");
+  PARSER_PROFILE_ENTER(PROCEDURE_SIGNATURE);
   
   /* Ident */
   lookahead = m2t_consume_sym(p->lexer);
@@ -2360,8 +4569,10 @@ m2t_token_t procedure_signature (m2t_parser_context_t p) {
     
       /* returnedType */
       if (match_token(p, TOKEN_IDENTIFIER, FOLLOW(PROCEDURE_TYPE))) {
+        SPAN_BEGIN(p, span);
         lookahead = qualident(p);
         rtype = p->ast;
+        SPAN_END(p, span, rtype);
       } /* end if */
     }
     else {
@@ -2372,6 +4583,8 @@ m2t_token_t procedure_signature (m2t_parser_context_t p) {
   /* build AST node and pass it back in p->ast */
   p->ast = m2t_ast_new_node(AST_PROCDEF, id, fplist, rtype, NULL);
   
+  PARSER_PROFILE_EXIT(PROCEDURE_SIGNATURE);
+  
   return lookahead;
 } /* end procedure_signature */
 
@@ -2389,15 +4602,17 @@ m2t_token_t procedure_signature (m2t_parser_context_t p) {
 m2t_token_t formal_params (m2t_parser_context_t p);
 
 m2t_token_t formal_param_list (m2t_parser_context_t p) {
-  m2t_fifo_t tmplist;
+  uint_t mark;
   m2t_token_t lookahead;
   uint_t line_of_semicolon, column_of_semicolon;
   
   PARSER_DEBUG_INFO("formalParamList");
+  PARSER_PROFILE_ENTER(FORMAL_PARAM_LIST);
   
   /* formalParams */
   lookahead = formal_params(p);
-  tmplist = m2t_fifo_new_queue(p->ast);
+  mark = scratch_mark(p);
+  scratch_push(p, p->ast);
   
   /* ( ';' formalParams )* */
   while (lookahead == TOKEN_SEMICOLON) {
@@ -2409,7 +4624,7 @@ m2t_token_t formal_param_list (m2t_parser_context_t p) {
     /* check if semicolon occurred at the end of a formal parameter list */
     if (lookahead == TOKEN_RIGHT_PAREN) {
     
-      if (m2t_option_errant_semicolon()) {
+      if (M2T_OPTION_IN_SET(p->options, M2T_OPTION_ERRANT_SEMICOLON)) {
         /* treat as warning */
         m2t_emit_warning_w_pos
           (M2T_SEMICOLON_AFTER_FORMAL_PARAM_LIST,
@@ -2436,13 +4651,14 @@ m2t_token_t formal_param_list (m2t_parser_context_t p) {
     /* formalParams */
     if (match_set(p, FIRST(FORMAL_PARAMS), FOLLOW(FORMAL_PARAMS))) {
       lookahead = formal_params(p);
-      m2t_fifo_enqueue(tmplist, p->ast);
+      scratch_push(p, p->ast);
     } /* end if */
   } /* end while */
   
   /* build AST node and pass it back in p->ast */
-  p->ast = m2t_ast_new_list_node(AST_FPARAMLIST, tmplist);
-  m2t_fifo_release(tmplist);
+  p->ast = scratch_list_node(p, AST_FPARAMLIST, mark);
+  
+  PARSER_PROFILE_EXIT(FORMAL_PARAM_LIST);
   
   return lookahead;
 } /* end formal_param_list */
@@ -2464,6 +4680,7 @@ m2t_token_t formal_params (m2t_parser_context_t p) {
   m2t_token_t lookahead;
   
   PARSER_DEBUG_INFO("formalParams");
+  PARSER_PROFILE_ENTER(FORMAL_PARAMS);
   
   lookahead = m2t_next_sym(p->lexer);
   
@@ -2482,6 +4699,8 @@ m2t_token_t formal_params (m2t_parser_context_t p) {
   
   /* AST node is passed through in p->ast */
   
+  PARSER_PROFILE_EXIT(FORMAL_PARAMS);
+  
   return lookahead;
 } /* end formal_params */
 
@@ -2501,6 +4720,7 @@ m2t_token_t simple_formal_params (m2t_parser_context_t p) {
   m2t_token_t lookahead;
     
   PARSER_DEBUG_INFO("simpleFormalParams");
+  PARSER_PROFILE_ENTER(SIMPLE_FORMAL_PARAMS);
   
   /* IdentList */
   lookahead = ident_list(p);
@@ -2520,6 +4740,8 @@ m2t_token_t simple_formal_params (m2t_parser_context_t p) {
   /* build AST node and pass it back in p->ast */
   p->ast = m2t_ast_new_node(AST_FPARAMS, idlist, sftype, NULL);
   
+  PARSER_PROFILE_EXIT(SIMPLE_FORMAL_PARAMS);
+  
   return lookahead;
 } /* end simple_formal_params */
 
@@ -2540,6 +4762,7 @@ m2t_token_t attrib_formal_params (m2t_parser_context_t p) {
   bool const_attr = false;
   
   PARSER_DEBUG_INFO("attribFormalParams");
+  PARSER_PROFILE_ENTER(ATTRIB_FORMAL_PARAMS);
   
   lookahead = m2t_next_sym(p->lexer);
   
@@ -2575,6 +4798,8 @@ m2t_token_t attrib_formal_params (m2t_parser_context_t p) {
   
   m2t_ast_replace_subnode(p->ast, 1, aftype);
   
+  PARSER_PROFILE_EXIT(ATTRIB_FORMAL_PARAMS);
+  
   return lookahead;
 } /* end attrib_formal_params */
 
@@ -2596,6 +4821,7 @@ m2t_token_t implementation_module (m2t_parser_context_t p) {
   m2t_token_t lookahead;
   
   PARSER_DEBUG_INFO("implementationModule");
+  PARSER_PROFILE_ENTER(IMPLEMENTATION_MODULE);
   
   /* IMPLEMENTATION */
   lookahead = m2t_consume_sym(p->lexer);
@@ -2607,6 +4833,8 @@ m2t_token_t implementation_module (m2t_parser_context_t p) {
   
   /* AST node is passed through in p->ast */
   
+  PARSER_PROFILE_EXIT(IMPLEMENTATION_MODULE);
+  
   return lookahead;
 } /* end implementation_module */
 
@@ -2631,9 +4859,11 @@ m2t_token_t block (m2t_parser_context_t p);
 m2t_token_t program_module (m2t_parser_context_t p) {
   m2t_astnode_t id, prio, implist, body;
   m2t_string_t ident1, ident2;
+  uint_t mark;
   m2t_token_t lookahead;
   
   PARSER_DEBUG_INFO("programModule");
+  PARSER_PROFILE_ENTER(PROGRAM_MODULE);
   
   /* MODULE */
   lookahead = m2t_consume_sym(p->lexer);
@@ -2664,25 +4894,42 @@ m2t_token_t program_module (m2t_parser_context_t p) {
     lookahead = m2t_next_sym(p->lexer);
   } /* end if */
   
-  tmplist = m2t_fifo_new_queue(NULL);
+  id = m2t_ast_new_terminal_node(AST_IDENT, ident1);
+  mark = scratch_mark(p);
+  
+  /* a streamed module is opened once its header is known */
+  if (p->stream != NULL) {
+    stream_open_node(p, AST_IMPMOD);
+    stream_node(p, id);
+    stream_node(p, prio);
+  } /* end if */
   
   /* import* */
   while ((lookahead == TOKEN_IMPORT) ||
          (lookahead == TOKEN_FROM)) {
     lookahead = import(p);
-    m2t_fifo_enqueue(tmplist, p->ast);
+    
+    if (p->stream != NULL) {
+      stream_list_item(p, AST_IMPLIST, p->ast);
+    }
+    else {
+      scratch_push(p, p->ast);
+    } /* end if */
   } /* end while */
   
-  if (m2t_fifo_entry_count(tmplist) > 0) {
-    implist = m2t_ast_new_list_node(AST_IMPLIST, tmplist);
+  if ((p->stream != NULL) && (NOT(stream_list_end(p)))) {
+    stream_node(p, m2t_ast_empty_node());
+  }
+  else if (scratch_count(p, mark) > 0) {
+    implist = scratch_list_node(p, AST_IMPLIST, mark);
   }
   else /* no import list */ {
     implist = m2t_ast_empty_node();
   } /* end if */
   
-  m2t_fifo_release(tmplist);
+  /* block, a streamed block is reported by block() itself */
+  body = m2t_ast_empty_node();
   
-  /* block */
   if (match_set(p, FIRST(BLOCK), FOLLOW(PROGRAM_MODULE))) {
     lookahead = block(p);
     body = p->ast;
@@ -2700,10 +4947,21 @@ m2t_token_t program_module (m2t_parser_context_t p) {
         lookahead = m2t_consume_sym(p->lexer);
       } /* end if */
     } /* end if */
-  } /* end if */  
+  }
+  else if (p->stream != NULL) {
+    stream_node(p, body);
+  } /* end if */
   
   /* build AST node and pass it back in p->ast */
-  p->ast = m2t_ast_new_node(AST_IMPMOD, id, prio, implist, body, NULL);
+  if (p->stream != NULL) {
+    stream_close_node(p);
+    p->ast = NULL;
+  }
+  else {
+    p->ast = m2t_ast_new_node(AST_IMPMOD, id, prio, implist, body, NULL);
+  } /* end if */
+  
+  PARSER_PROFILE_EXIT(PROGRAM_MODULE);
   
   return lookahead;
 } /* end program_module */
@@ -2721,6 +4979,7 @@ m2t_token_t module_priority (m2t_parser_context_t p) {
   m2t_token_t lookahead;
   
   PARSER_DEBUG_INFO("modulePriority");
+  PARSER_PROFILE_ENTER(MODULE_PRIORITY);
   
   /* '[' */
   lookahead = m2t_consume_sym(p->lexer);
@@ -2737,6 +4996,8 @@ m2t_token_t module_priority (m2t_parser_context_t p) {
   
   /* AST node is passed through in p->ast */
   
+  PARSER_PROFILE_EXIT(MODULE_PRIORITY);
+  
   return lookahead;
 } /* end module_priority */
 
@@ -2757,14 +5018,33 @@ m2t_token_t statement_sequence (m2t_parser_context_t p);
 
 m2t_token_t block (m2t_parser_context_t p) {
   m2t_astnode_t decllist, stmtseq;
-  m2t_fifo_t tmplist;
+  m2t_region_t region;
+  uint_t mark;
   m2t_token_t lookahead;
+  bool spine, top;
   
   PARSER_DEBUG_INFO("block");
+  PARSER_PROFILE_ENTER(BLOCK);
+  
+  /* only the module's block is streamed, nested blocks are built */
+  spine = ((p->stream != NULL) && (p->stream_spine));
+  p->stream_spine = false;
+  
+  /* only declarations of the module's block are recorded as regions
+   * or taken from procedures parsed ahead on workers */
+  top = p->top_level;
+  p->top_level = false;
+  
+  /* constants outside the module's block are not bound for folding */
+  p->block_depth++;
+  
+  if (spine) {
+    stream_open_node(p, AST_BLOCK);
+  } /* end if */
   
   lookahead = m2t_next_sym(p->lexer);
   
-  tmplist = m2t_fifo_new_queue(NULL);
+  mark = scratch_mark(p);
   
   /* declaration* */
   while ((lookahead == TOKEN_CONST) ||
@@ -2772,19 +5052,39 @@ m2t_token_t block (m2t_parser_context_t p) {
          (lookahead == TOKEN_VAR) ||
          (lookahead == TOKEN_PROCEDURE) ||
          (lookahead == TOKEN_MODULE)) {
-    lookahead = declaration(p);
-    m2t_fifo_enqueue(tmplist, p->ast);
+    region.start = m2t_lexer_lookahead_offset(p->lexer);
+    
+    if ((top) && (lookahead == TOKEN_PROCEDURE) &&
+        (take_parsed_procedure(p))) {
+      lookahead = m2t_next_sym(p->lexer);
+    }
+    else /* parse declaration */ {
+      lookahead = declaration(p);
+    } /* end if */
+    
+    if ((top) && (p->regions != NULL)) {
+      region.end = m2t_lexer_lookahead_offset(p->lexer);
+      m2t_region_table_append(p->regions, &region);
+    } /* end if */
+    
+    if (spine) {
+      stream_list_item(p, AST_DECLLIST, p->ast);
+    }
+    else {
+      scratch_push(p, p->ast);
+    } /* end if */
   } /* end while */
   
-  if (m2t_fifo_entry_count(tmplist) > 0) {
-    decllist = m2t_ast_new_list_node(AST_DECLLIST, tmplist);
+  if ((spine) && (NOT(stream_list_end(p)))) {
+    stream_node(p, m2t_ast_empty_node());
+  }
+  else if (scratch_count(p, mark) > 0) {
+    decllist = scratch_list_node(p, AST_DECLLIST, mark);
   }
   else /* no declarations */ {
     decllist = m2t_ast_empty_node();
   } /* end if */
   
-  m2t_fifo_release(tmplist);
-  
   /* ( BEGIN statementSequence )? */
   if (lookahead == TOKEN_BEGIN) {
     lookahead = m2t_consume_sym(p->lexer);
@@ -2798,6 +5098,7 @@ m2t_token_t block (m2t_parser_context_t p) {
            m2t_lexer_lookahead_line(p->lexer),
            m2t_lexer_lookahead_column(p->lexer));
         p->warning_count++;
+        stmtseq = m2t_ast_empty_node();
     }
     /* statementSequence */
     else if (match_set(p, FIRST(STATEMENT_SEQUENCE), FOLLOW(STATEMENT))) {
@@ -2806,6 +5107,7 @@ m2t_token_t block (m2t_parser_context_t p) {
     }
     else /* resync */ {
       lookahead = m2t_next_sym(p->lexer);
+      stmtseq = m2t_ast_empty_node();
     } /* end if */
   }
   else /* no statement sequence */ {
@@ -2818,7 +5120,18 @@ m2t_token_t block (m2t_parser_context_t p) {
   } /* end if */
   
   /* build AST node and pass it back in p->ast */
-  p->ast = m2t_ast_new_node(AST_BLOCK, decllist_node, stmtseq, NULL);
+  if (spine) {
+    stream_node(p, stmtseq);
+    stream_close_node(p);
+    p->ast = NULL;
+  }
+  else {
+    p->ast = m2t_ast_new_node(AST_BLOCK, decllist, stmtseq, NULL);
+  } /* end if */
+  
+  p->block_depth--;
+  
+  PARSER_PROFILE_EXIT(BLOCK);
   
   return lookahead;
 } /* end block */
@@ -2848,11 +5161,18 @@ m2t_token_t module_declaration (m2t_parser_context_t p);
 
 m2t_token_t declaration (m2t_parser_context_t p) {
   m2t_token_t lookahead;
+  m2t_astnode_t node;
+  uint32_t first;
   
   PARSER_DEBUG_INFO("declaration");
+  PARSER_PROFILE_ENTER(DECLARATION);
   
   lookahead = m2t_next_sym(p->lexer);
   
+  /* comments preceding the first item are attached to it */
+  first = 0;
+  COMMENT_MARK(p, first);
+  
   switch (lookahead) {
     
     /* CONST */
@@ -2862,12 +5182,17 @@ m2t_token_t declaration (m2t_parser_context_t p) {
       /* ( constDeclaration ';' )* */
       while (lookahead == TOKEN_IDENTIFIER) {
         lookahead = const_definition(p);
+        node = p->ast;
         
         /* ';' */
         if (match_token(p, TOKEN_SEMICOLON,
             RESYNC(DECLARATION_OR_IDENT_OR_SEMICOLON))) {
           lookahead = m2t_consume_sym(p->lexer);
         } /* end if */
+        
+        /* attach comments up to and including ';' */
+        COMMENT_ATTACH(p, first, node);
+        COMMENT_MARK(p, first);
       } /* end while */
       break;
       
@@ -2878,12 +5203,17 @@ m2t_token_t declaration (m2t_parser_context_t p) {
       /* ( typeDeclaration ';' )* */
       while (lookahead == TOKEN_IDENTIFIER) {
         lookahead = type_declaration(p);
+        node = p->ast;
         
         /* ';' */
         if (match_token(p, TOKEN_SEMICOLON,
             RESYNC(DECLARATION_OR_IDENT_OR_SEMICOLON))) {
           lookahead = m2t_consume_sym(p->lexer);
         } /* end if */
+        
+        /* attach comments up to and including ';' */
+        COMMENT_ATTACH(p, first, node);
+        COMMENT_MARK(p, first);
       } /* end while */
       break;
       
@@ -2894,12 +5224,17 @@ m2t_token_t declaration (m2t_parser_context_t p) {
       /* ( variableDeclaration ';' )* */
       while (lookahead == TOKEN_IDENTIFIER) {
         lookahead = variable_declaration(p);
+        node = p->ast;
         
         /* ';' */
         if (match_token(p, TOKEN_SEMICOLON,
             RESYNC(DECLARATION_OR_IDENT_OR_SEMICOLON))) {
           lookahead = m2t_consume_sym(p->lexer);
         } /* end if */
+        
+        /* attach comments up to and including ';' */
+        COMMENT_ATTACH(p, first, node);
+        COMMENT_MARK(p, first);
       } /* end while */
       break;
       
@@ -2907,6 +5242,9 @@ m2t_token_t declaration (m2t_parser_context_t p) {
     case TOKEN_PROCEDURE :
       lookahead = procedure_declaration(p);
       
+      /* attach leading comments only, the body has its own */
+      COMMENT_LEAD(p, first, p->ast);
+      
       /* ';' */
       if (match_token(p, TOKEN_SEMICOLON,
           RESYNC(DECLARATION_OR_SEMICOLON))) {
@@ -2918,6 +5256,9 @@ m2t_token_t declaration (m2t_parser_context_t p) {
     case TOKEN_MODULE :
       lookahead = module_declaration(p);
       
+      /* attach leading comments only, the body has its own */
+      COMMENT_LEAD(p, first, p->ast);
+      
       /* ';' */
       if (match_token(p, TOKEN_SEMICOLON,
           RESYNC(DECLARATION_OR_SEMICOLON))) {
@@ -2932,6 +5273,8 @@ m2t_token_t declaration (m2t_parser_context_t p) {
   
   /* AST node is passed through in p->ast */
   
+  PARSER_PROFILE_EXIT(DECLARATION);
+  
   return lookahead;
 } /* end declaration */
 
@@ -2954,6 +5297,7 @@ m2t_token_t type_declaration (m2t_parser_context_t p) {
   m2t_token_t lookahead;
     
   PARSER_DEBUG_INFO("typeDeclaration");
+  PARSER_PROFILE_ENTER(TYPE_DECLARATION);
   
   /* Ident */
   lookahead = m2t_consume_sym(p->lexer);
@@ -2984,6 +5328,8 @@ m2t_token_t type_declaration (m2t_parser_context_t p) {
   /* build AST node and pass it back in p->ast */
   p->ast = m2t_ast_new_node(AST_TYPEDECL, id, tc, NULL);
   
+  PARSER_PROFILE_EXIT(TYPE_DECLARATION);
+  
   return lookahead;
 } /* end type_declaration */
 
@@ -3008,6 +5354,7 @@ m2t_token_t var_size_record_type (m2t_parser_context_t p) {
   m2t_token_t lookahead;
     
   PARSER_DEBUG_INFO("varSizeRecordType");
+  PARSER_PROFILE_ENTER(VAR_SIZE_RECORD_TYPE);
   
   /* VAR */
   lookahead = m2t_consume_sym(p->lexer);
@@ -3087,7 +5434,8 @@ m2t_token_t var_size_record_type (m2t_parser_context_t p) {
                     column_of_semicolon =
                       m2t_lexer_lookahead_column(p->lexer);
                   
-                    if (m2t_option_errant_semicolon()) {
+                    if (M2T_OPTION_IN_SET
+                         (p->options, M2T_OPTION_ERRANT_SEMICOLON)) {
                       /* treat as warning */
                       m2t_emit_warning_w_pos
                         (M2T_SEMICOLON_AFTER_FIELD_LIST_SEQ,
@@ -3127,6 +5475,8 @@ m2t_token_t var_size_record_type (m2t_parser_context_t p) {
   vsfield = m2t_ast_new_node(AST_VSFIELD, vsfieldid, sizeid, typeid, NULL);
   p->ast = m2t_ast_new_node(AST_VSREC, flseq, vsfield, NULL);
   
+  PARSER_PROFILE_EXIT(VAR_SIZE_RECORD_TYPE);
+  
   return lookahead;
 } /* end var_size_record_type */
 
@@ -3146,6 +5496,7 @@ m2t_token_t variable_declaration (m2t_parser_context_t p) {
   m2t_token_t lookahead;
     
   PARSER_DEBUG_INFO("variableDeclaration");
+  PARSER_PROFILE_ENTER(VARIABLE_DECLARATION);
   
   /* IdentList */
   lookahead = ident_list(p);
@@ -3165,6 +5516,8 @@ m2t_token_t variable_declaration (m2t_parser_context_t p) {
   /* build AST node and pass it back in p->ast */
   p->ast = m2t_ast_new_node(AST_VARDECL, idlist, tc, NULL);
   
+  PARSER_PROFILE_EXIT(VARIABLE_DECLARATION);
+  
   return lookahead;
 } /* end variable_declaration */
 
@@ -3185,6 +5538,7 @@ m2t_token_t procedure_declaration (m2t_parser_context_t p) {
   m2t_token_t lookahead;
   
   PARSER_DEBUG_INFO("procedureDeclaration");
+  PARSER_PROFILE_ENTER(PROCEDURE_DECLARATION);
   
   /* procedureHeader */
   lookahead = procedure_header(p);
@@ -3212,6 +5566,8 @@ m2t_token_t procedure_declaration (m2t_parser_context_t p) {
   /* build AST node and pass it back in p->ast */
   p->ast = m2t_ast_new_node(AST_PROC, procdef, body, NULL);
   
+  PARSER_PROFILE_EXIT(PROCEDURE_DECLARATION);
+  
   return lookahead;
 } /* end procedure_declaration */
 
@@ -3232,11 +5588,12 @@ m2t_token_t export (m2t_parser_context_t p);
 
 m2t_token_t module_declaration (m2t_parser_context_t p) {
   m2t_astnode_t id, prio, implist, exp, body;
-  m2t_fifo_t tmplist;
+  uint_t mark;
   m2t_string_t ident1, ident2;
   m2t_token_t lookahead;
   
   PARSER_DEBUG_INFO("moduleDeclaration");
+  PARSER_PROFILE_ENTER(MODULE_DECLARATION);
   
   /* MODULE */
   lookahead = m2t_consume_sym(p->lexer);
@@ -3267,24 +5624,22 @@ m2t_token_t module_declaration (m2t_parser_context_t p) {
     lookahead = m2t_next_sym(p->lexer);
   } /* end if */
   
-  tmplist = m2t_fifo_new_queue(NULL);
+  mark = scratch_mark(p);
   
   /* import* */
   while ((lookahead == TOKEN_IMPORT) ||
          (lookahead == TOKEN_FROM)) {
     lookahead = import(p);
-    m2t_fifo_enqueue(tmplist, p->ast);
+    scratch_push(p, p->ast);
   } /* end while */
   
-  if (m2t_fifo_entry_count(tmplist) > 0) {
-    implist = m2t_ast_new_list_node(AST_IMPLIST, tmplist);
+  if (scratch_count(p, mark) > 0) {
+    implist = scratch_list_node(p, AST_IMPLIST, mark);
   }
   else /* no import list */ {
     implist = m2t_ast_empty_node();
   } /* end if */
   
-  m2t_fifo_release(tmplist);
-  
   /* export? */
   if (lookahead == TOKEN_EXPORT) {
     lookahead = export(p);
@@ -3313,6 +5668,8 @@ m2t_token_t module_declaration (m2t_parser_context_t p) {
   /* build AST node and pass it back in p->ast */
   p->ast = m2t_ast_new_node(AST_MODDECL, id, prio, implist, exp, body, NULL);
   
+  PARSER_PROFILE_EXIT(MODULE_DECLARATION);
+  
   return lookahead;
 } /* end module_declaration */
 
@@ -3329,10 +5686,14 @@ m2t_token_t module_declaration (m2t_parser_context_t p) {
 
 m2t_token_t export (m2t_parser_context_t p) {
   m2t_astnode_t idlist;
+  m2t_source_span_t span;
   m2t_token_t lookahead;
   bool qualified = false;
   
   PARSER_DEBUG_INFO("export");
+  PARSER_PROFILE_ENTER(EXPORT);
+  
+  SPAN_BEGIN(p, span);
   
   /* EXPORT */
   lookahead = m2t_consume_sym(p->lexer);
@@ -3362,6 +5723,10 @@ m2t_token_t export (m2t_parser_context_t p) {
     p->ast = m2t_ast_new_node(AST_EXPORT, idlist, NULL);
   } /* end if */
   
+  SPAN_END(p, span, p->ast);
+  
+  PARSER_PROFILE_EXIT(EXPORT);
+  
   return lookahead;
 } /* end export */
 
@@ -3379,15 +5744,17 @@ m2t_token_t export (m2t_parser_context_t p) {
 m2t_token_t statement (m2t_parser_context_t p);
 
 m2t_token_t statement_sequence (m2t_parser_context_t p) {
-  m2t_fifo_t tmplist;
+  uint_t mark;
   m2t_token_t lookahead;
   uint_t line_of_semicolon, column_of_semicolon;
   
   PARSER_DEBUG_INFO("statementSequence");
+  PARSER_PROFILE_ENTER(STATEMENT_SEQUENCE);
   
   /* statement */
   lookahead = statement(p);
-  tmplist = m2t_fifo_new_queue(p->ast);
+  mark = scratch_mark(p);
+  scratch_push(p, p->ast);
   
   /* ( ';' statement )* */
   while (lookahead == TOKEN_SEMICOLON) {
@@ -3399,7 +5766,7 @@ m2t_token_t statement_sequence (m2t_parser_context_t p) {
     /* check if semicolon occurred at the end of a statement sequence */
     if (m2t_tokenset_element(FOLLOW(STATEMENT_SEQUENCE), lookahead)) {
     
-      if (m2t_option_errant_semicolon()) {
+      if (M2T_OPTION_IN_SET(p->options, M2T_OPTION_ERRANT_SEMICOLON)) {
         /* treat as warning */
         m2t_emit_warning_w_pos
           (M2T_SEMICOLON_AFTER_STMT_SEQ,
@@ -3427,13 +5794,14 @@ m2t_token_t statement_sequence (m2t_parser_context_t p) {
     if (match_set(p, FIRST(STATEMENT),
         RESYNC(FIRST_OR_FOLLOW_OF_STATEMENT))) {
       lookahead = statement(p);
-      m2t_fifo_enqueue(tmplist, p->ast);
+      scratch_push(p, p->ast);
     } /* end if */
   } /* end while */
   
   /* build AST node and pass it back in p->ast */
-  p->ast = m2t_ast_new_list_node(AST_STMTSEQ, tmplist);
-  m2t_fifo_release(tmplist);
+  p->ast = scratch_list_node(p, AST_STMTSEQ, mark);
+  
+  PARSER_PROFILE_EXIT(STATEMENT_SEQUENCE);
   
   return lookahead;
 } /* end statement_sequence */
@@ -3471,6 +5839,7 @@ m2t_token_t statement (m2t_parser_context_t p) {
   m2t_token_t lookahead;
   
   PARSER_DEBUG_INFO("statement");
+  PARSER_PROFILE_ENTER(STATEMENT);
   
   lookahead = m2t_next_sym(p->lexer);
   
@@ -3532,6 +5901,8 @@ m2t_token_t statement (m2t_parser_context_t p) {
       exit(-1);
     } /* end switch */
   
+  PARSER_PROFILE_EXIT(STATEMENT);
+  
   return lookahead;
 } /* end statement */
 
@@ -3558,6 +5929,7 @@ m2t_token_t assignment_or_proc_call (m2t_parser_context_t p) {
   m2t_token_t lookahead;
     
   PARSER_DEBUG_INFO("assignmentOrProcCall");
+  PARSER_PROFILE_ENTER(ASSIGNMENT_OR_PROC_CALL);
   
   /* designator */
   lookahead = designator(p);
@@ -3581,6 +5953,8 @@ m2t_token_t assignment_or_proc_call (m2t_parser_context_t p) {
     /* astnode: (PCALL designatorNode argsNode) */
   } /* end if */
   
+  PARSER_PROFILE_EXIT(ASSIGNMENT_OR_PROC_CALL);
+  
   return lookahead;
 } /* end assignment_or_proc_call */
 
@@ -3596,19 +5970,21 @@ m2t_token_t assignment_or_proc_call (m2t_parser_context_t p) {
  * ----------------------------------------------------------------------- */
 
 m2t_token_t actual_parameters (m2t_parser_context_t p) {
-  m2t_fifo_t tmplist;
+  uint_t mark;
   m2t_token_t lookahead;
   
   PARSER_DEBUG_INFO("actualParameters");
+  PARSER_PROFILE_ENTER(ACTUAL_PARAMETERS);
   
   /* '(' */
   lookahead = m2t_consume_sym(p->lexer);
   
   /* ( expression ( ',' expression )* )? */
-  if (m2t_tokenset_member(FIRST(EXPRESSION), lookahead)) {
+  if (m2t_tokenset_element(FIRST(EXPRESSION), lookahead)) {
     /* expression */
     lookahead = expression(p);
-    tmplist = m2t_fifo_new_queue(p->ast);
+    mark = scratch_mark(p);
+    scratch_push(p, p->ast);
   
     /* ( ',' expression )* */
     while (lookahead == TOKEN_COMMA) {
@@ -3618,12 +5994,11 @@ m2t_token_t actual_parameters (m2t_parser_context_t p) {
       /* expression */
       if (match_set(p, FIRST(EXPRESSION), FOLLOW(EXPRESSION))) {
         lookahead = expression(p);
-        m2t_fifo_enqueue(tmplist, p->ast);
+        scratch_push(p, p->ast);
       } /* end if */
     } /* end while */
     
-    p->ast = m2t_ast_new_list_node(AST_ARGS, tmplist);
-    m2t_fifo_release(tmplist);
+    p->ast = scratch_list_node(p, AST_ARGS, mark);
   }
   else /* no arguments */ {
     p->ast = m2t_ast_empty_node();
@@ -3634,6 +6009,8 @@ m2t_token_t actual_parameters (m2t_parser_context_t p) {
     lookahead = m2t_consume_sym(p->lexer);
   } /* end if */
   
+  PARSER_PROFILE_EXIT(ACTUAL_PARAMETERS);
+  
   return lookahead;
 } /* end actual_parameters */
 
@@ -3653,6 +6030,7 @@ m2t_token_t return_statement (m2t_parser_context_t p) {
   m2t_token_t lookahead;
     
   PARSER_DEBUG_INFO("returnStatement");
+  PARSER_PROFILE_ENTER(RETURN_STATEMENT);
   
   /* RETURN */
   lookahead = m2t_consume_sym(p->lexer);
@@ -3669,6 +6047,8 @@ m2t_token_t return_statement (m2t_parser_context_t p) {
   /* build AST node and pass it back in p->ast */
   p->ast = m2t_ast_new_node(AST_RETURN, expr, NULL);
   
+  PARSER_PROFILE_EXIT(RETURN_STATEMENT);
+  
   return lookahead;
 } /* end return_statement */
 
@@ -3688,6 +6068,7 @@ m2t_token_t with_statement (m2t_parser_context_t p) {
   m2t_token_t lookahead;
   
   PARSER_DEBUG_INFO("withStatement");
+  PARSER_PROFILE_ENTER(WITH_STATEMENT);
   
   /* WITH */
   lookahead = m2t_consume_sym(p->lexer);
@@ -3731,6 +6112,8 @@ m2t_token_t with_statement (m2t_parser_context_t p) {
   /* build AST node and pass it back in p->ast */
   p->ast = m2t_ast_new_node(AST_WITH, desig, stmtseq, NULL);
   
+  PARSER_PROFILE_EXIT(WITH_STATEMENT);
+  
   return lookahead;
 } /* end with_statement */
 
@@ -3753,8 +6136,10 @@ m2t_token_t with_statement (m2t_parser_context_t p) {
 m2t_token_t if_statement (m2t_parser_context_t p) {
   m2t_astnode_t ifexpr, ifseq, elif, expr, stmtseq, elifseq, elseseq;
   m2t_token_t lookahead;
+  uint_t mark;
   
   PARSER_DEBUG_INFO("ifStatement");
+  PARSER_PROFILE_ENTER(IF_STATEMENT);
   
   /* IF */
   lookahead = m2t_consume_sym(p->lexer);
@@ -3794,6 +6179,7 @@ m2t_token_t if_statement (m2t_parser_context_t p) {
   } /* end if */
   
   /* ( ELSIF boolExpression THEN statementSequence )* */
+  mark = scratch_mark(p);
   while (lookahead == TOKEN_ELSIF) {
     
     /* ELSIF */
@@ -3826,7 +6212,7 @@ m2t_token_t if_statement (m2t_parser_context_t p) {
           stmtseq = p->ast;
           
           elif = m2t_ast_new_node(AST_ELSIF, expr, stmtseq, NULL);
-          m2t_fifo_enqueue(tmplist, elif);
+          scratch_push(p, elif);
         }
         else /* resync */ {
           lookahead = m2t_next_sym(p->lexer);
@@ -3841,15 +6227,13 @@ m2t_token_t if_statement (m2t_parser_context_t p) {
     } /* end if */
   } /* end while */
   
-  if (m2t_fifo_entry_count(tmplist) > 0) {
-    elifseq = m2t_ast_new_list_node(ELSIFSEQ, tmplist);
+  if (scratch_count(p, mark) > 0) {
+    elifseq = scratch_list_node(p, AST_ELSIFSEQ, mark);
   }
   else /* no ELSIF branches */ {
     elifseq = m2t_ast_empty_node();
   } /* end if */
   
-  m2t_fifo_release(tmplist);
-  
   /* ( ELSE statementSequence )? */
   if (lookahead == TOKEN_ELSE) {
   
@@ -3887,6 +6271,8 @@ m2t_token_t if_statement (m2t_parser_context_t p) {
   /* build AST node and pass it back in p->ast */
   p->ast = m2t_ast_new_node(AST_IF, ifexpr, ifseq, elifseq, elseseq, NULL);
   
+  PARSER_PROFILE_EXIT(IF_STATEMENT);
+  
   return lookahead;
 } /* end if_statement */
 
@@ -3910,8 +6296,18 @@ m2t_token_t case_branch (m2t_parser_context_t p);
 m2t_token_t case_statement (m2t_parser_context_t p) {
   m2t_astnode_t expr, caselist, elseseq;
   m2t_token_t lookahead;
+  uint_t mark, labels, outer_branch;
   
   PARSER_DEBUG_INFO("caseStatement");
+  PARSER_PROFILE_ENTER(CASE_STATEMENT);
+  
+  /* list entries are pushed above mark */
+  mark = scratch_mark(p);
+  
+  /* labels are recorded above labels, branches are counted from zero */
+  labels = label_mark(p);
+  outer_branch = p->branch;
+  p->branch = 0;
   
   /* CASE */
   lookahead = m2t_consume_sym(p->lexer);
@@ -3928,7 +6324,8 @@ m2t_token_t case_statement (m2t_parser_context_t p) {
       /* case */
       if (match_set(p, FIRST(CASE), RESYNC(ELSE_OR_END))) {
         lookahead = case_branch(p);
-        tmplist = m2t_fifo_new_queue(p->ast);
+        scratch_push(p, p->ast);
+        p->branch++;
         
         /* ( '| case )* */
         while (lookahead == TOKEN_BAR) {
@@ -3938,7 +6335,8 @@ m2t_token_t case_statement (m2t_parser_context_t p) {
           /* case */
           if (match_set(p, FIRST(CASE), RESYNC(ELSE_OR_END))) {
             lookahead = case_branch(p);
-            m2t_fifo_enqueue(tmplist, p->ast);
+            scratch_push(p, p->ast);
+            p->branch++;
           }
           else /* resync */ {
             lookahead = m2t_next_sym(p->lexer);
@@ -3954,8 +6352,11 @@ m2t_token_t case_statement (m2t_parser_context_t p) {
     } /* end if */
   } /* end if */
   
-  caselist = m2t_ast_new_list_node(AST_CASELIST, tmplist);
-  m2t_fifo_release(tmplist);
+  caselist = scratch_list_node(p, AST_CASELIST, mark);
+  
+  /* report duplicate and overlapping labels */
+  check_case_labels(p, labels);
+  p->branch = outer_branch;
   
   /* ( ELSE statementSequence )? */
   if (lookahead == TOKEN_ELSE) {
@@ -3995,6 +6396,8 @@ m2t_token_t case_statement (m2t_parser_context_t p) {
   /* build AST node and pass it back in p->ast */
   p->ast = m2t_ast_new_node(AST_SWITCH, expr, caselist, elseseq, NULL);
   
+  PARSER_PROFILE_EXIT(CASE_STATEMENT);
+  
   return lookahead;
 } /* end case_statement */
 
@@ -4016,6 +6419,7 @@ m2t_token_t case_branch (m2t_parser_context_t p) {
   m2t_token_t lookahead;
     
   PARSER_DEBUG_INFO("case");
+  PARSER_PROFILE_ENTER(CASE);
   
   /* caseLabelList */
   lookahead = case_label_list(p);
@@ -4045,6 +6449,8 @@ m2t_token_t case_branch (m2t_parser_context_t p) {
   /* build AST node and pass it back in p->ast */
   p->ast = m2t_ast_new_node(AST_CASE, cllist, stmtseq, NULL);
   
+  PARSER_PROFILE_EXIT(CASE);
+  
   return lookahead;
 } /* end case_branch */
 
@@ -4064,6 +6470,7 @@ m2t_token_t loop_statement (m2t_parser_context_t p) {
   m2t_token_t lookahead;
   
   PARSER_DEBUG_INFO("loopStatement");
+  PARSER_PROFILE_ENTER(LOOP_STATEMENT);
   
   /* LOOP */
   lookahead = m2t_consume_sym(p->lexer);
@@ -4095,6 +6502,8 @@ m2t_token_t loop_statement (m2t_parser_context_t p) {
   /* build AST node and pass it back in p->ast */
   p->ast = m2t_ast_new_node(AST_LOOP, stmtseq, NULL);
   
+  PARSER_PROFILE_EXIT(LOOP_STATEMENT);
+  
   return lookahead;
 } /* end loop_statement */
 
@@ -4116,6 +6525,7 @@ m2t_token_t while_statement (m2t_parser_context_t p) {
   m2t_token_t lookahead;
   
   PARSER_DEBUG_INFO("whileStatement");
+  PARSER_PROFILE_ENTER(WHILE_STATEMENT);
   
   /* WHILE */
   lookahead = m2t_consume_sym(p->lexer);
@@ -4159,6 +6569,8 @@ m2t_token_t while_statement (m2t_parser_context_t p) {
   /* build AST node and pass it back in p->ast */
   p->ast = m2t_ast_new_node(AST_WHILE, expr, stmtseq, NULL);
   
+  PARSER_PROFILE_EXIT(WHILE_STATEMENT);
+  
   return lookahead;
 } /* end while_statement */
 
@@ -4180,6 +6592,7 @@ m2t_token_t repeat_statement (m2t_parser_context_t p) {
   m2t_token_t lookahead;
   
   PARSER_DEBUG_INFO("repeatStatement");
+  PARSER_PROFILE_ENTER(REPEAT_STATEMENT);
   
   /* REPEAT */
   lookahead = m2t_consume_sym(p->lexer);
@@ -4218,6 +6631,8 @@ m2t_token_t repeat_statement (m2t_parser_context_t p) {
   /* build AST node and pass it back in p->ast */
   p->ast = m2t_ast_new_node(AST_REPEAT, stmtseq, expr, NULL);
   
+  PARSER_PROFILE_EXIT(REPEAT_STATEMENT);
+  
   return lookahead;
 } /* end repeat_statement */
 
@@ -4247,6 +6662,7 @@ m2t_token_t for_statement (m2t_parser_context_t p) {
   m2t_token_t lookahead;
   
   PARSER_DEBUG_INFO("forStatement");
+  PARSER_PROFILE_ENTER(FOR_STATEMENT);
   
   /* FOR */
   lookahead = m2t_consume_sym(p->lexer);
@@ -4329,6 +6745,8 @@ m2t_token_t for_statement (m2t_parser_context_t p) {
   /* build AST node and pass it back in p->ast */
   p->ast = m2t_ast_new_node(AST_FORTO, id, start, end, step, stmtseq, NULL);
   
+  PARSER_PROFILE_EXIT(FOR_STATEMENT);
+  
   return lookahead;
 } /* end for_statement */
 
@@ -4350,6 +6768,7 @@ m2t_token_t designator (m2t_parser_context_t p) {
   m2t_token_t lookahead;
     
   PARSER_DEBUG_INFO("designator");
+  PARSER_PROFILE_ENTER(DESIGNATOR);
   
   /* qualident */
   lookahead = qualident(p);
@@ -4373,6 +6792,8 @@ m2t_token_t designator (m2t_parser_context_t p) {
     } /* end if */
   } /* end if */
   
+  PARSER_PROFILE_EXIT(DESIGNATOR);
+  
   return lookahead;
 } /* end designator */
 
@@ -4394,6 +6815,7 @@ m2t_token_t selector (m2t_parser_context_t p) {
   m2t_token_t lookahead;
   
   PARSER_DEBUG_INFO("selector");
+  PARSER_PROFILE_ENTER(SELECTOR);
   
   lookahead = m2t_next_sym(p->lexer);
       
@@ -4438,6 +6860,8 @@ m2t_token_t selector (m2t_parser_context_t p) {
       exit(-1);
   } /* end switch */
       
+  PARSER_PROFILE_EXIT(SELECTOR);
+  
   return lookahead;
 } /* end selector */
 
@@ -4453,14 +6877,16 @@ m2t_token_t selector (m2t_parser_context_t p) {
  * ----------------------------------------------------------------------- */
 
 m2t_token_t index_list (m2t_parser_context_t p) {
-  m2t_fifo_t tmplist;
+  uint_t mark;
   m2t_token_t lookahead;
   
   PARSER_DEBUG_INFO("expressionList");
+  PARSER_PROFILE_ENTER(EXPRESSION_LIST);
   
   /* expression */
   lookahead = expression(p);
-  tmplist = m2t_fifo_new_queue(p->ast);
+  mark = scratch_mark(p);
+  scratch_push(p, p->ast);
   
   /* ( ',' expression )* */
   while (lookahead == TOKEN_COMMA) {
@@ -4470,13 +6896,14 @@ m2t_token_t index_list (m2t_parser_context_t p) {
     /* expression */
     if (match_set(p, FIRST(EXPRESSION), FOLLOW(EXPRESSION))) {
       lookahead = expression(p);
-      m2t_fifo_enqueue(tmplist, p->ast);
+      scratch_push(p, p->ast);
     } /* end if */
   } /* end while */
   
   /* build AST node and pass it back in p->ast */
-  p->ast = m2t_ast_new_list_node(AST_INDEX, tmplist);
-  m2t_fifo_release(tmplist);
+  p->ast = scratch_list_node(p, AST_INDEX, mark);
+  
+  PARSER_PROFILE_EXIT(EXPRESSION_LIST);
   
   return lookahead;
 } /* end index_list */
@@ -4510,6 +6937,7 @@ m2t_token_t expression (m2t_parser_context_t p) {
   m2t_token_t lookahead;
     
   PARSER_DEBUG_INFO("expression");
+  PARSER_PROFILE_ENTER(EXPRESSION);
   
   /* simpleExpression */
   lookahead = simple_expression(p);
@@ -4557,6 +6985,8 @@ m2t_token_t expression (m2t_parser_context_t p) {
     } /* end if */
   } /* end if */
   
+  PARSER_PROFILE_EXIT(EXPRESSION);
+  
   return lookahead;
 } /* end expression */
 
@@ -4587,6 +7017,7 @@ m2t_token_t simple_expression (m2t_parser_context_t p) {
   bool unary_minus = false;
   
   PARSER_DEBUG_INFO("simpleExpression");
+  PARSER_PROFILE_ENTER(SIMPLE_EXPRESSION);
   
   lookahead = m2t_next_sym(p->lexer);
   
@@ -4636,6 +7067,8 @@ m2t_token_t simple_expression (m2t_parser_context_t p) {
     } /* end while */
   } /* end if */
     
+  PARSER_PROFILE_EXIT(SIMPLE_EXPRESSION);
+  
   return lookahead;
 } /* end simple_expression */
 
@@ -4666,6 +7099,7 @@ m2t_token_t term (m2t_parser_context_t p) {
   m2t_token_t lookahead;
   
   PARSER_DEBUG_INFO("term");
+  PARSER_PROFILE_ENTER(TERM);
   
   /* simpleTerm */
   lookahead = simple_term(p);
@@ -4707,6 +7141,8 @@ m2t_token_t term (m2t_parser_context_t p) {
     } /* end if */
   } /* end while */
   
+  PARSER_PROFILE_EXIT(TERM);
+  
   return lookahead;
 } /* end term */
 
@@ -4728,6 +7164,7 @@ m2t_token_t simple_term (m2t_parser_context_t p) {
   bool negation = false;
   
   PARSER_DEBUG_INFO("simpleTerm");
+  PARSER_PROFILE_ENTER(SIMPLE_TERM);
   
   lookahead = m2t_next_sym(p->lexer);
   
@@ -4746,6 +7183,8 @@ m2t_token_t simple_term (m2t_parser_context_t p) {
     } /* end if */
   } /* end if */
 
+  PARSER_PROFILE_EXIT(SIMPLE_TERM);
+  
   return lookahead;
 } /* end simple_term */
 
@@ -4772,6 +7211,7 @@ m2t_token_t factor (m2t_parser_context_t p) {
   m2t_token_t lookahead;
   
   PARSER_DEBUG_INFO("factor");
+  PARSER_PROFILE_ENTER(FACTOR);
   
   lookahead = m2t_next_sym(p->lexer);
   
@@ -4833,6 +7273,8 @@ m2t_token_t factor (m2t_parser_context_t p) {
       exit(-1);
   } /* end switch */
   
+  PARSER_PROFILE_EXIT(FACTOR);
+  
   return lookahead;
 } /* end factor */
 
@@ -4853,6 +7295,7 @@ m2t_token_t designator_or_func_call (m2t_parser_context_t p) {
   m2t_token_t lookahead;
     
   PARSER_DEBUG_INFO("designatorOrFuncCall");
+  PARSER_PROFILE_ENTER(DESIGNATOR_OR_FUNC_CALL);
   
   /* designator */
   lookahead = designator(p);
@@ -4876,6 +7319,8 @@ m2t_token_t designator_or_func_call (m2t_parser_context_t p) {
     } /* end if */
   } /* end if */
     
+  PARSER_PROFILE_EXIT(DESIGNATOR_OR_FUNC_CALL);
+  
   return lookahead;
 } /* end designator_or_func_call */
 
@@ -4894,10 +7339,14 @@ m2t_token_t element (m2t_parser_context_t p);
 
 m2t_token_t set_value (m2t_parser_context_t p) {
   m2t_astnode_t empty, elemlist;
-  m2t_ast_fifo_t tmplist;
+  uint_t mark;
   m2t_token_t lookahead;
   
   PARSER_DEBUG_INFO("setValue");
+  PARSER_PROFILE_ENTER(SET_VALUE);
+  
+  /* list entries are pushed above mark */
+  mark = scratch_mark(p);
   
   /* '{' */
   lookahead = m2t_consume_sym(p->lexer);
@@ -4905,7 +7354,7 @@ m2t_token_t set_value (m2t_parser_context_t p) {
   /* element */
   if (match_set(p, FIRST(ELEMENT), FOLLOW(SET_VALUE))) {
     lookahead = element(p);
-    tmplist = m2t_fifo_new_queue(p->ast);
+    scratch_push(p, p->ast);
     
     /* ( ',' element )* */
     while (lookahead == TOKEN_COMMA) {
@@ -4915,7 +7364,7 @@ m2t_token_t set_value (m2t_parser_context_t p) {
       /* element */
       if (match_set(p, FIRST(ELEMENT), FOLLOW(SET_VALUE))) {
         lookahead = element(p);
-        m2t_fifo_enqueue(tmplist, p->ast);
+        scratch_push(p, p->ast);
       }
       else /* resync */ {
         lookahead = m2t_next_sym(p->lexer);
@@ -4928,19 +7377,19 @@ m2t_token_t set_value (m2t_parser_context_t p) {
     } /* end if */
   } /* end if */
   
-  if (m2t_fifo_entry_count(tmplist) > 0) {
-    elemlist = m2t_ast_new_list_node(AST_ELEMLIST, tmplist);
+  if (scratch_count(p, mark) > 0) {
+    elemlist = scratch_list_node(p, AST_ELEMLIST, mark);
   }
   else /* empty set */ {
     elemlist = m2t_ast_empty_node();
   } /* end if */
   
-  m2t_fifo_release(tmplist);
-  
   /* build AST node and pass it back in p->ast */
   empty = m2t_ast_empty_node();
   p->ast = m2t_ast_new_node(AST_SETVAL, empty, elemlist, NULL);
   
+  PARSER_PROFILE_EXIT(SET_VALUE);
+  
   return lookahead;
 } /* end set_value */
 
@@ -4960,6 +7409,7 @@ m2t_token_t element (m2t_parser_context_t p) {
   m2t_token_t lookahead;
     
   PARSER_DEBUG_INFO("element");
+  PARSER_PROFILE_ENTER(ELEMENT);
   
   /* expression */
   lookahead = expression(p);
@@ -4976,6 +7426,8 @@ m2t_token_t element (m2t_parser_context_t p) {
     } /* end if */
   } /* end if */
   
+  PARSER_PROFILE_EXIT(ELEMENT);
+  
   return lookahead;
 } /* end element */
 
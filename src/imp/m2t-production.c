@@ -0,0 +1,216 @@
+/* M2T -- Sorce to Source Modula-2 Translator
+ *
+ * Copyright (c) 2016-2023 Benjamin Kowarsch
+ *
+ * Author & Maintainer: Benjamin Kowarsch <org.m2sf>
+ *
+ * @synopsis
+ *
+ * M2T is a multi-dialect Modula-2 source-to-source translator. It translates
+ * source files  written in the  classic dialects  to semantically equivalent
+ * source files in  Modula-2 Revision 2010 (M2R10).  It supports  the classic
+ * Modula-2 dialects  described in  the 2nd, 3rd and 4th editions  of Niklaus
+ * Wirth's book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * For more details please visit: https://github.com/trijezdci/m2t/wiki
+ *
+ * @repository
+ *
+ * https://github.com/trijezdci/m2t
+ *
+ * @file
+ *
+ * m2t-production.c
+ *
+ * Implementation of M2T production lookup.
+ *
+ * @license
+ *
+ * M2T is free software:  You can redistribute and modify it  under the terms
+ * of the  GNU Lesser General Public License (LGPL) either version 2.1  or at
+ * your choice version 3, both as published by the Free Software Foundation.
+ *
+ * M2T is distributed  in the hope  that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even  the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received  a copy of the  GNU Lesser General Public License
+ * along with M2T.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#include "m2t-production.h"
+#include "m2t-option-flags.h"
+
+#include <stddef.h>
+
+
+/* --------------------------------------------------------------------------
+ * private variables m2t_first_set and m2t_follow_set
+ * --------------------------------------------------------------------------
+ * Tables of FIRST and FOLLOW sets, generated by gen/m2t-gen-tokensets.c
+ * ----------------------------------------------------------------------- */
+
+#include "m2t-first-set-table.h"
+#include "m2t-follow-set-table.h"
+
+
+/* --------------------------------------------------------------------------
+ * private variable empty_set
+ * --------------------------------------------------------------------------
+ * Empty tokenset, returned for invalid productions.
+ * ----------------------------------------------------------------------- */
+
+static const m2t_tokenset_t empty_set = { { 0 } };
+
+
+/* --------------------------------------------------------------------------
+ * private variable m2t_production_name_table
+ * --------------------------------------------------------------------------
+ * Table of pointers to human readable production names
+ * ----------------------------------------------------------------------- */
+
+static const char *m2t_production_name_table[] = {
+  "definitionModule",
+  "import",
+  "qualifiedImport",
+  "unqualifiedImport",
+  "identList",
+  "definition",
+  "constDefinition",
+  "typeDefinition",
+  "type",
+  "derivedOrSubrangeType",
+  "qualident",
+  "range",
+  "enumType",
+  "setType",
+  "countableType",
+  "arrayType",
+  "extensibleRecordType",
+  "fieldListSequence",
+  "variantRecordType",
+  "variantFieldListSeq",
+  "variantFieldList",
+  "variantFields",
+  "variant",
+  "caseLabelList",
+  "caseLabels",
+  "pointerType",
+  "procedureType",
+  "simpleFormalType",
+  "procedureHeader",
+  "procedureSignature",
+  "simpleFormalParams",
+  "implementationModule",
+  "programModule",
+  "modulePriority",
+  "block",
+  "declaration",
+  "typeDeclaration",
+  "varSizeRecordType",
+  "variableDeclaration",
+  "procedureDeclaration",
+  "moduleDeclaration",
+  "export",
+  "statementSequence",
+  "statement",
+  "assignmentOrProcCall",
+  "actualParameters",
+  "expressionList",
+  "returnStatement",
+  "withStatement",
+  "ifStatement",
+  "caseStatement",
+  "case",
+  "loopStatement",
+  "whileStatement",
+  "repeatStatement",
+  "forStatement",
+  "designator",
+  "selector",
+  "expression",
+  "simpleExpression",
+  "term",
+  "simpleTerm",
+  "factor",
+  "designatorOrFuncCall",
+  "setValue",
+  "element",
+  "formalType",
+  "attributedFormalType",
+  "formalParamList",
+  "formalParams",
+  "attribFormalParams",
+  "typeDeclarationTail"
+}; /* end m2t_production_name_table */
+
+
+/* --------------------------------------------------------------------------
+ * function macro IS_OPTION_DEPENDENT(p)
+ * --------------------------------------------------------------------------
+ * Returns TRUE if the sets of p depend on option variant records.
+ * ----------------------------------------------------------------------- */
+
+#define IS_OPTION_DEPENDENT(_p) \
+  (((_p) >= M2T_FIRST_OPTION_DEPENDENT) && \
+   ((_p) <= M2T_LAST_OPTION_DEPENDENT))
+
+
+/* --------------------------------------------------------------------------
+ * function FIRST(p)
+ * --------------------------------------------------------------------------
+ * Returns a tokenset with the FIRST set of production p.  The sets are
+ * generated at build time and stored in read-only data, the empty set is
+ * returned if p is invalid.
+ * ----------------------------------------------------------------------- */
+
+m2t_tokenset_t FIRST (m2t_production_t p) {
+  if (M2T_IS_INVALID_PRODUCTION(p)) {
+    return empty_set;
+  } /* end if */
+  
+  if ((IS_OPTION_DEPENDENT(p)) && (m2t_option_variant_records())) {
+    p = p + M2T_ALTERNATE_SET_OFFSET;
+  } /* end if */
+  
+  return m2t_first_set[p];
+} /* end FIRST */
+
+
+/* --------------------------------------------------------------------------
+ * function FOLLOW(p)
+ * --------------------------------------------------------------------------
+ * Returns a tokenset with the FOLLOW set of production p.  The sets are
+ * generated at build time and stored in read-only data, the empty set is
+ * returned if p is invalid.
+ * ----------------------------------------------------------------------- */
+
+m2t_tokenset_t FOLLOW (m2t_production_t p) {
+  if (M2T_IS_INVALID_PRODUCTION(p)) {
+    return empty_set;
+  } /* end if */
+  
+  if ((IS_OPTION_DEPENDENT(p)) && (m2t_option_variant_records())) {
+    p = p + M2T_ALTERNATE_SET_OFFSET;
+  } /* end if */
+  
+  return m2t_follow_set[p];
+} /* end FOLLOW */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_name_for_production(p)
+ * --------------------------------------------------------------------------
+ * Returns an immutable pointer to a NUL terminated character string with
+ * a human readable name for p.  Returns NULL if p is not valid.
+ * ----------------------------------------------------------------------- */
+
+const char *m2t_name_for_production (m2t_production_t p) {
+  if (M2T_IS_INVALID_PRODUCTION(p)) {
+    return NULL;
+  } /* end if */
+  
+  return m2t_production_name_table[p];
+} /* end m2t_name_for_production */
+
+/* END OF FILE */
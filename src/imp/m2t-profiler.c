@@ -0,0 +1,363 @@
+/* M2T -- Sorce to Source Modula-2 Translator
+ *
+ * Copyright (c) 2016-2023 Benjamin Kowarsch
+ *
+ * Author & Maintainer: Benjamin Kowarsch <org.m2sf>
+ *
+ * @synopsis
+ *
+ * M2T is a multi-dialect Modula-2 source-to-source translator. It translates
+ * source files  written in the  classic dialects  to semantically equivalent
+ * source files in  Modula-2 Revision 2010 (M2R10).  It supports  the classic
+ * Modula-2 dialects  described in  the 2nd, 3rd and 4th editions  of Niklaus
+ * Wirth's book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * For more details please visit: https://github.com/trijezdci/m2t/wiki
+ *
+ * @repository
+ *
+ * https://github.com/trijezdci/m2t
+ *
+ * @file
+ *
+ * m2t-profiler.c
+ *
+ * Implementation of M2T parser profiler.
+ *
+ * @license
+ *
+ * M2T is free software:  You can redistribute and modify it  under the terms
+ * of the  GNU Lesser General Public License (LGPL) either version 2.1  or at
+ * your choice version 3, both as published by the Free Software Foundation.
+ *
+ * M2T is distributed  in the hope  that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even  the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received  a copy of the  GNU Lesser General Public License
+ * along with M2T.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#include "m2t-profiler.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <time.h>
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * private function read_time_counter()
+ * --------------------------------------------------------------------------
+ * Returns the current value of the time counter.
+ * ----------------------------------------------------------------------- */
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#define M2T_PROFILER_TIME_UNIT "cycles"
+
+static inline uint64_t read_time_counter (void) {
+  return __rdtsc();
+} /* end read_time_counter */
+
+#elif defined(__aarch64__)
+
+#define M2T_PROFILER_TIME_UNIT "ticks"
+
+static inline uint64_t read_time_counter (void) {
+  uint64_t value;
+  __asm__ __volatile__ ("mrs %0, cntvct_el0" : "=r" (value));
+  return value;
+} /* end read_time_counter */
+
+#else /* portable fallback */
+
+#define M2T_PROFILER_TIME_UNIT "ns"
+
+static inline uint64_t read_time_counter (void) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint64_t) now.tv_sec * 1000000000u + (uint64_t) now.tv_nsec;
+} /* end read_time_counter */
+
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * private type production_counters_t
+ * --------------------------------------------------------------------------
+ * Record type holding the counters for a production.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* enter_count */ uint64_t enter_count;
+  /* inclusive */ uint64_t inclusive;
+  /* exclusive */ uint64_t exclusive;
+  /* active */ uint_t active;
+} production_counters_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type activation_t
+ * --------------------------------------------------------------------------
+ * Record type representing an active production on the shadow stack.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* production */ m2t_production_t production;
+  /* start */ uint64_t start;
+  /* callee_time */ uint64_t callee_time;
+} activation_t;
+
+
+/* --------------------------------------------------------------------------
+ * private variables
+ * ----------------------------------------------------------------------- */
+
+static production_counters_t production[M2T_PRODUCTION_COUNT];
+
+static uint64_t token_count[TOKEN_END_MARK];
+
+static activation_t stack[M2T_PROFILER_STACK_LIMIT];
+
+static uint_t depth = 0;
+
+static uint64_t overflow_count = 0;
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_profiler_enter(p)
+ * --------------------------------------------------------------------------
+ * Records entry into production p.
+ * ----------------------------------------------------------------------- */
+
+void m2t_profiler_enter (m2t_production_t p) {
+  
+  if (p >= M2T_PRODUCTION_COUNT) {
+    return;
+  } /* end if */
+  
+  production[p].enter_count++;
+  
+  if (depth < M2T_PROFILER_STACK_LIMIT) {
+    production[p].active++;
+    stack[depth].production = p;
+    stack[depth].callee_time = 0;
+    stack[depth].start = read_time_counter();
+  }
+  else /* too deep, count only */ {
+    overflow_count++;
+  } /* end if */
+  
+  depth++;
+} /* end m2t_profiler_enter */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_profiler_exit(p)
+ * --------------------------------------------------------------------------
+ * Records exit from production p.
+ * ----------------------------------------------------------------------- */
+
+void m2t_profiler_exit (m2t_production_t p) {
+  
+  uint64_t elapsed;
+  activation_t *top;
+  
+  if ((p >= M2T_PRODUCTION_COUNT) || (depth == 0)) {
+    return;
+  } /* end if */
+  
+  depth--;
+  
+  if (depth >= M2T_PROFILER_STACK_LIMIT) {
+    return;
+  } /* end if */
+  
+  top = &stack[depth];
+  elapsed = read_time_counter() - top->start;
+  
+  production[top->production].exclusive += elapsed - top->callee_time;
+  production[top->production].active--;
+  
+  /* only the outermost activation of a recursion adds inclusive time */
+  if (production[top->production].active == 0) {
+    production[top->production].inclusive += elapsed;
+  } /* end if */
+  
+  if (depth > 0) {
+    stack[depth - 1].callee_time += elapsed;
+  } /* end if */
+} /* end m2t_profiler_exit */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_profiler_count_token(token)
+ * --------------------------------------------------------------------------
+ * Increments the count of consumed tokens of value token.
+ * ----------------------------------------------------------------------- */
+
+void m2t_profiler_count_token (m2t_token_t token) {
+  if (token < TOKEN_END_MARK) {
+    token_count[token]++;
+  } /* end if */
+} /* end m2t_profiler_count_token */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_profiler_write(path, status)
+ * --------------------------------------------------------------------------
+ * Writes all counters to the file at path in CSV or JSON format.
+ * ----------------------------------------------------------------------- */
+
+static void write_csv (FILE *file);
+
+static void write_json (FILE *file);
+
+void m2t_profiler_write (const char *path, m2t_profiler_status_t *status) {
+  
+  FILE *file;
+  uint_t length;
+  int result;
+  
+  if (path == NULL) {
+    SET_STATUS(status, M2T_PROFILER_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  file = fopen(path, "w");
+  
+  if (file == NULL) {
+    SET_STATUS(status, M2T_PROFILER_STATUS_FOPEN_FAILED);
+    return;
+  } /* end if */
+  
+  length = strlen(path);
+  
+  if ((length >= 4) && (strcmp(path + length - 4, ".csv") == 0)) {
+    write_csv(file);
+  }
+  else /* JSON */ {
+    write_json(file);
+  } /* end if */
+  
+  result = ferror(file);
+  
+  if ((fclose(file) != 0) || (result != 0)) {
+    SET_STATUS(status, M2T_PROFILER_STATUS_WRITE_FAILED);
+    return;
+  } /* end if */
+  
+  SET_STATUS(status, M2T_PROFILER_STATUS_SUCCESS);
+} /* end m2t_profiler_write */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_profiler_reset()
+ * --------------------------------------------------------------------------
+ * Clears all counters.
+ * ----------------------------------------------------------------------- */
+
+void m2t_profiler_reset (void) {
+  memset(production, 0, sizeof(production));
+  memset(token_count, 0, sizeof(token_count));
+  depth = 0;
+  overflow_count = 0;
+} /* end m2t_profiler_reset */
+
+
+/* --------------------------------------------------------------------------
+ * Private Functions
+ * ----------------------------------------------------------------------- */
+
+/* --------------------------------------------------------------------------
+ * private procedure write_csv(file)
+ * --------------------------------------------------------------------------
+ * Writes all non-zero counters to file in CSV format, one record per line.
+ * ----------------------------------------------------------------------- */
+
+static void write_csv (FILE *file) {
+  
+  m2t_production_t p;
+  m2t_token_t token;
+  
+  fprintf(file, "kind,name,count,inclusive_" M2T_PROFILER_TIME_UNIT
+    ",exclusive_" M2T_PROFILER_TIME_UNIT "\n");
+  
+  p = 0;
+  while (p < M2T_PRODUCTION_COUNT) {
+    if (production[p].enter_count > 0) {
+      fprintf(file, "production,%s,%llu,%llu,%llu\n",
+        m2t_name_for_production(p),
+        (unsigned long long) production[p].enter_count,
+        (unsigned long long) production[p].inclusive,
+        (unsigned long long) production[p].exclusive);
+    } /* end if */
+    p++;
+  } /* end while */
+  
+  token = 0;
+  while (token < TOKEN_END_MARK) {
+    if (token_count[token] > 0) {
+      fprintf(file, "token,%s,%llu,,\n", m2t_name_for_token(token),
+        (unsigned long long) token_count[token]);
+    } /* end if */
+    token++;
+  } /* end while */
+} /* end write_csv */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_json(file)
+ * --------------------------------------------------------------------------
+ * Writes all non-zero counters to file in JSON format.
+ * ----------------------------------------------------------------------- */
+
+static void write_json (FILE *file) {
+  
+  m2t_production_t p;
+  m2t_token_t token;
+  const char *separator;
+  
+  fprintf(file, "{\n  \"time_unit\": \"%s\",\n", M2T_PROFILER_TIME_UNIT);
+  fprintf(file, "  \"untimed_activations\": %llu,\n",
+    (unsigned long long) overflow_count);
+  
+  fprintf(file, "  \"productions\": [");
+  separator = "\n";
+  p = 0;
+  while (p < M2T_PRODUCTION_COUNT) {
+    if (production[p].enter_count > 0) {
+      fprintf(file, "%s    { \"name\": \"%s\", \"count\": %llu, "
+        "\"inclusive\": %llu, \"exclusive\": %llu }",
+        separator, m2t_name_for_production(p),
+        (unsigned long long) production[p].enter_count,
+        (unsigned long long) production[p].inclusive,
+        (unsigned long long) production[p].exclusive);
+      separator = ",\n";
+    } /* end if */
+    p++;
+  } /* end while */
+  fprintf(file, "\n  ],\n");
+  
+  fprintf(file, "  \"tokens\": [");
+  separator = "\n";
+  token = 0;
+  while (token < TOKEN_END_MARK) {
+    if (token_count[token] > 0) {
+      fprintf(file, "%s    { \"name\": \"%s\", \"count\": %llu }",
+        separator, m2t_name_for_token(token),
+        (unsigned long long) token_count[token]);
+      separator = ",\n";
+    } /* end if */
+    token++;
+  } /* end while */
+  fprintf(file, "\n  ]\n}\n");
+} /* end write_json */
+
+
+/* END OF FILE */
@@ -0,0 +1,1570 @@
+/* M2T -- Sorce to Source Modula-2 Translator
+ *
+ * Copyright (c) 2016-2023 Benjamin Kowarsch
+ *
+ * Author & Maintainer: Benjamin Kowarsch <org.m2sf>
+ *
+ * @synopsis
+ *
+ * M2T is a multi-dialect Modula-2 source-to-source translator. It translates
+ * source files  written in the  classic dialects  to semantically equivalent
+ * source files in  Modula-2 Revision 2010 (M2R10).  It supports  the classic
+ * Modula-2 dialects  described in  the 2nd, 3rd and 4th editions  of Niklaus
+ * Wirth's book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * For more details please visit: https://github.com/trijezdci/m2t/wiki
+ *
+ * @repository
+ *
+ * https://github.com/trijezdci/m2t
+ *
+ * @file
+ *
+ * m2t-r10writer.c
+ *
+ * Implementation of M2T M2R10 writer.
+ *
+ * @license
+ *
+ * M2T is free software:  You can redistribute and modify it  under the terms
+ * of the  GNU Lesser General Public License (LGPL) either version 2.1  or at
+ * your choice version 3, both as published by the Free Software Foundation.
+ *
+ * M2T is distributed  in the hope  that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even  the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received  a copy of the  GNU Lesser General Public License
+ * along with M2T.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+
+#include "m2t-r10writer.h"
+#include "m2t-fileutils.h"
+#include "m2t-option-flags.h"
+#include "m2-trace-probes.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* --------------------------------------------------------------------------
+ * Replacement text for type CARDINAL under option subtype-cardinals
+ * ----------------------------------------------------------------------- */
+
+#define R10_CARDINAL_SUBRANGE "[0..TMAX(INTEGER)] OF INTEGER"
+
+
+/* --------------------------------------------------------------------------
+ * Operator precedence levels of expressions
+ * ----------------------------------------------------------------------- */
+
+#define R10_PREC_ANY 0
+
+#define R10_PREC_RELATION 1
+
+#define R10_PREC_SIMPLE 2
+
+#define R10_PREC_TERM 3
+
+#define R10_PREC_FACTOR 4
+
+
+/* --------------------------------------------------------------------------
+ * private type r10_writer_s
+ * --------------------------------------------------------------------------
+ * record type representing the state of the writer.  Field source holds
+ * the source text, mapped if mapped is true, otherwise read into memory.
+ * Field line_start holds the offset of the first character of each source
+ * line.  Field cursor holds the offset of the first source character not
+ * yet written or skipped.  Field indent_start and indent_length hold the
+ * leading whitespace of the line on which the construct being regenerated
+ * starts.  Field comments holds the comments of the source, or NULL.
+ * Field view holds the view the AST written is presented by, or NULL, spans
+ * of its copies are looked up by the base nodes they were copied from.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* file */ FILE *file;
+  /* source */ const char *source;
+  /* length */ size_t length;
+  /* mapped */ bool mapped;
+  /* line_start */ size_t *line_start;
+  /* line_count */ uint_t line_count;
+  /* view */ m2c_ast_view_t view;
+  /* spans */ m2t_span_table_t spans;
+  /* comments */ m2t_comment_table_t comments;
+  /* cursor */ size_t cursor;
+  /* indent_start */ size_t indent_start;
+  /* indent_length */ size_t indent_length;
+  /* cardinals */ bool cardinals;
+} r10_writer_s;
+
+
+/* --------------------------------------------------------------------------
+ * Forward declarations
+ * ----------------------------------------------------------------------- */
+
+static void write_translation
+  (const char *path, const char *srcpath, m2t_astnode_t ast,
+   m2c_ast_view_t view, m2t_span_table_t spans,
+   m2t_comment_table_t comments, m2t_r10writer_status_t *status);
+
+static bool load_source (r10_writer_s *w, const char *srcpath);
+
+static void release_source (r10_writer_s *w);
+
+static bool build_line_table (r10_writer_s *w);
+
+static size_t offset_for_position (r10_writer_s *w, uint_t line, uint_t col);
+
+static bool node_span
+  (r10_writer_s *w, m2t_astnode_t node, size_t *first, size_t *end);
+
+static size_t trailing_trivia (r10_writer_s *w, size_t first, size_t end);
+
+static void copy_through (r10_writer_s *w, size_t offset);
+
+static bool is_convertible_subnode
+  (m2t_ast_nodetype_t node_type, uint_t index);
+
+static bool is_conversion (r10_writer_s *w, m2t_astnode_t node);
+
+static bool is_cardinal (r10_writer_s *w, m2t_astnode_t node);
+
+static bool contains_conversion (r10_writer_s *w, m2t_astnode_t node);
+
+static bool can_descend (r10_writer_s *w, m2t_astnode_t node);
+
+static void write_node (r10_writer_s *w, m2t_astnode_t node);
+
+static void regenerate
+  (r10_writer_s *w, m2t_astnode_t node, size_t first, size_t end);
+
+static void write_comments (r10_writer_s *w, size_t first, size_t end);
+
+static void write_export (r10_writer_s *w, m2t_astnode_t export);
+
+static void write_type (r10_writer_s *w, m2t_astnode_t type, uint_t depth);
+
+static void write_formal_type (r10_writer_s *w, m2t_astnode_t type);
+
+static void write_record
+  (r10_writer_s *w, m2t_astnode_t base, m2t_astnode_t flseq, uint_t depth);
+
+static uint_t field_count (m2t_astnode_t flseq);
+
+static void write_field_seq
+  (r10_writer_s *w, m2t_astnode_t flseq, uint_t depth,
+   uint_t total, uint_t *count);
+
+static void write_variant_fields
+  (r10_writer_s *w, m2t_astnode_t vflist, uint_t depth,
+   uint_t total, uint_t *count);
+
+static void write_field
+  (r10_writer_s *w, m2t_astnode_t names, m2t_astnode_t type, uint_t depth,
+   uint_t total, uint_t *count);
+
+static void write_case_labels (r10_writer_s *w, m2t_astnode_t cllist);
+
+static void write_expr (r10_writer_s *w, m2t_astnode_t expr, uint_t prec);
+
+static void write_expr_list (r10_writer_s *w, m2t_astnode_t list);
+
+static void write_quoted (r10_writer_s *w, m2t_string_t string);
+
+static void write_ident_list (r10_writer_s *w, m2t_astnode_t idlist);
+
+static void write_qualident (r10_writer_s *w, m2t_astnode_t qualident);
+
+static void write_newline (r10_writer_s *w, uint_t depth);
+
+static void emit_str (r10_writer_s *w, const char *str);
+
+static void emit_string (r10_writer_s *w, m2t_string_t string);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_r10_write(path, srcpath, ast, spans, status)
+ * --------------------------------------------------------------------------
+ * Writes the M2R10 translation of the source file at srcpath to the file at
+ * path, replacing any existing file.
+ * ----------------------------------------------------------------------- */
+
+void m2t_r10_write
+  (const char *path,
+   const char *srcpath,
+   m2t_astnode_t ast,
+   m2t_span_table_t spans,
+   m2t_r10writer_status_t *status) {
+  
+  m2t_r10_write_w_comments(path, srcpath, ast, spans, NULL, status);
+  return;
+} /* end m2t_r10_write */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_r10_write_w_comments(path, srcpath, ast, spans, ...)
+ * --------------------------------------------------------------------------
+ * Writes the M2R10 translation of the source file at srcpath to the file at
+ * path like m2t_r10_write() but preserves the comments within regenerated
+ * constructs, as recorded in comments.
+ * ----------------------------------------------------------------------- */
+
+void m2t_r10_write_w_comments
+  (const char *path,
+   const char *srcpath,
+   m2t_astnode_t ast,
+   m2t_span_table_t spans,
+   m2t_comment_table_t comments,
+   m2t_r10writer_status_t *status) {
+  
+  write_translation(path, srcpath, ast, NULL, spans, comments, status);
+  return;
+} /* end m2t_r10_write_w_comments */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_r10_write_view(path, srcpath, view, spans, comments, ...)
+ * --------------------------------------------------------------------------
+ * Writes the M2R10 translation of the source file at srcpath as presented
+ * by view to the file at path like m2t_r10_write_w_comments(), resolving
+ * the spans of copied nodes through their origins in view.
+ * ----------------------------------------------------------------------- */
+
+void m2t_r10_write_view
+  (const char *path,
+   const char *srcpath,
+   m2c_ast_view_t view,
+   m2t_span_table_t spans,
+   m2t_comment_table_t comments,
+   m2t_r10writer_status_t *status) {
+  
+  write_translation
+    (path, srcpath, m2c_ast_view_root(view), view, spans, comments, status);
+  return;
+} /* end m2t_r10_write_view */
+
+
+/* ************************************************************************ *
+ * Private Functions                                                        *
+ * ************************************************************************ */
+
+/* --------------------------------------------------------------------------
+ * private procedure write_translation(path, srcpath, ast, view, ...)
+ * --------------------------------------------------------------------------
+ * Writes the M2R10 translation of the source file at srcpath with the given
+ * AST, spans and comments to the file at path.  If view is not NULL, ast is
+ * the root of view and spans are looked up by the origins of its nodes.
+ * ----------------------------------------------------------------------- */
+
+static void write_translation
+  (const char *path, const char *srcpath, m2t_astnode_t ast,
+   m2c_ast_view_t view, m2t_span_table_t spans,
+   m2t_comment_table_t comments, m2t_r10writer_status_t *status) {
+  
+  r10_writer_s writer;
+  bool failed;
+  
+  if ((path == NULL) || (srcpath == NULL) || (ast == NULL) ||
+      (spans == NULL) || (strcmp(path, srcpath) == 0)) {
+    SET_STATUS(status, M2T_R10WRITER_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  if (NOT(load_source(&writer, srcpath))) {
+    SET_STATUS(status, M2T_R10WRITER_STATUS_SOURCE_UNAVAILABLE);
+    return;
+  } /* end if */
+  
+  if (NOT(build_line_table(&writer))) {
+    release_source(&writer);
+    SET_STATUS(status, M2T_R10WRITER_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  writer.file = fopen(path, "w");
+  
+  if (writer.file == NULL) {
+    release_source(&writer);
+    SET_STATUS(status, M2T_R10WRITER_STATUS_FOPEN_FAILED);
+    return;
+  } /* end if */
+  
+  M2C_TRACE_WRITE_START("r10", path);
+  
+  writer.view = view;
+  writer.spans = spans;
+  writer.comments = comments;
+  writer.cursor = 0;
+  writer.indent_start = 0;
+  writer.indent_length = 0;
+  writer.cardinals = m2t_option_subtype_cardinals();
+  
+  /* the root node spans the whole source */
+  if (m2t_ast_nodetype(ast) == AST_ROOT) {
+    ast = m2t_ast_subnode_for_index(ast, 2);
+  } /* end if */
+  
+  write_node(&writer, ast);
+  copy_through(&writer, writer.length);
+  
+  failed = (ferror(writer.file) != 0);
+  failed = (fclose(writer.file) != 0) || failed;
+  release_source(&writer);
+  
+  M2C_TRACE_WRITE_END("r10", path, failed);
+  
+  if (failed) {
+    SET_STATUS(status, M2T_R10WRITER_STATUS_WRITE_FAILED);
+  }
+  else {
+    SET_STATUS(status, M2T_R10WRITER_STATUS_SUCCESS);
+  } /* end if */
+} /* end write_translation */
+
+
+/* --------------------------------------------------------------------------
+ * private function load_source(w, srcpath)
+ * --------------------------------------------------------------------------
+ * Maps the source file at srcpath into memory, or reads it into memory if
+ * it cannot be mapped.  Returns true on success, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+static bool load_source (r10_writer_s *w, const char *srcpath) {
+  
+  char *buffer;
+  long int size;
+  FILE *file;
+  
+  w->line_start = NULL;
+  w->line_count = 0;
+  
+  if (map_file(srcpath, &w->source, &w->length)) {
+    w->mapped = true;
+    return true;
+  } /* end if */
+  
+  /* empty files and hosts without mapped files */
+  w->mapped = false;
+  
+  if (NOT(get_filesize(srcpath, &size)) || (size < 0)) {
+    return false;
+  } /* end if */
+  
+  buffer = malloc((size_t) size + 1);
+  
+  if (buffer == NULL) {
+    return false;
+  } /* end if */
+  
+  file = fopen(srcpath, "rb");
+  
+  if (file == NULL) {
+    free(buffer);
+    return false;
+  } /* end if */
+  
+  w->length = fread(buffer, 1, (size_t) size, file);
+  fclose(file);
+  
+  w->source = buffer;
+  
+  return true;
+} /* end load_source */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure release_source(w)
+ * --------------------------------------------------------------------------
+ * Releases the source text and the line table of w.
+ * ----------------------------------------------------------------------- */
+
+static void release_source (r10_writer_s *w) {
+  
+  if (w->mapped) {
+    unmap_file(w->source, w->length);
+  }
+  else {
+    free((void *) w->source);
+  } /* end if */
+  
+  free(w->line_start);
+  w->line_start = NULL;
+} /* end release_source */
+
+
+/* --------------------------------------------------------------------------
+ * private function build_line_table(w)
+ * --------------------------------------------------------------------------
+ * Records the offset of the first character of each line of the source
+ * text of w.  Lines end in LF, CR or CR LF, as counted by the lexer.
+ * Returns false if the table could not be allocated.
+ * ----------------------------------------------------------------------- */
+
+static bool build_line_table (r10_writer_s *w) {
+  
+  size_t index, capacity;
+  size_t *table;
+  char ch;
+  
+  capacity = 1;
+  for (index = 0; index < w->length; index++) {
+    ch = w->source[index];
+  
+    if ((ch == ASCII_LF) ||
+        ((ch == ASCII_CR) &&
+         ((index + 1 == w->length) || (w->source[index + 1] != ASCII_LF)))) {
+      capacity++;
+    } /* end if */
+  } /* end for */
+  
+  w->line_start = malloc(capacity * sizeof(size_t));
+  
+  if (w->line_start == NULL) {
+    return false;
+  } /* end if */
+  
+  table = w->line_start;
+  table[0] = 0;
+  w->line_count = 1;
+  
+  for (index = 0; index < w->length; index++) {
+    ch = w->source[index];
+  
+    if ((ch == ASCII_LF) ||
+        ((ch == ASCII_CR) &&
+         ((index + 1 == w->length) || (w->source[index + 1] != ASCII_LF)))) {
+      table[w->line_count] = index + 1;
+      w->line_count++;
+    } /* end if */
+  } /* end for */
+  
+  return true;
+} /* end build_line_table */
+
+
+/* --------------------------------------------------------------------------
+ * private function offset_for_position(w, line, col)
+ * --------------------------------------------------------------------------
+ * Returns the offset of the character at the given line and column of the
+ * source text of w, limited to the length of the source text.
+ * ----------------------------------------------------------------------- */
+
+static size_t offset_for_position (r10_writer_s *w, uint_t line, uint_t col) {
+  
+  size_t offset;
+  
+  if (line == 0) {
+    return 0;
+  }
+  else if (line > w->line_count) {
+    return w->length;
+  } /* end if */
+  
+  offset = w->line_start[line - 1];
+  
+  if (col > 0) {
+    offset = offset + col - 1;
+  } /* end if */
+  
+  if (offset > w->length) {
+    return w->length;
+  } /* end if */
+  
+  return offset;
+} /* end offset_for_position */
+
+
+/* --------------------------------------------------------------------------
+ * private function node_span(w, node, first, end)
+ * --------------------------------------------------------------------------
+ * Passes the offsets of the first character of node and of the character
+ * following its span back in first and end and returns true.  Returns
+ * false if no span has been recorded for node or if its span lies before
+ * text already written.
+ * ----------------------------------------------------------------------- */
+
+static bool node_span
+  (r10_writer_s *w, m2t_astnode_t node, size_t *first, size_t *end) {
+  
+  m2t_source_span_t span;
+  
+  if (NOT(m2t_span_table_lookup(w->spans,
+      m2c_ast_view_origin(w->view, node), &span))) {
+    return false;
+  } /* end if */
+  
+  *first = offset_for_position(w, span.first_line, span.first_column);
+  *end = offset_for_position(w, span.end_line, span.end_column);
+  
+  return (*first >= w->cursor) && (*end >= *first);
+} /* end node_span */
+
+
+/* --------------------------------------------------------------------------
+ * private function trailing_trivia(w, first, end)
+ * --------------------------------------------------------------------------
+ * Returns the offset at which the whitespace and comments that trail the
+ * last symbol of the span from first to end begin.
+ * ----------------------------------------------------------------------- */
+
+static size_t trailing_trivia (r10_writer_s *w, size_t first, size_t end) {
+  
+  const char *src = w->source;
+  size_t pos, index;
+  uint_t depth;
+  
+  pos = end;
+  while (pos > first) {
+  
+    /* whitespace */
+    if ((src[pos - 1] == ' ') || (src[pos - 1] == ASCII_TAB) ||
+        (src[pos - 1] == ASCII_LF) || (src[pos - 1] == ASCII_CR)) {
+      pos--;
+    }
+    /* comment, possibly nested */
+    else if ((pos - first >= 4) &&
+             (src[pos - 1] == ')') && (src[pos - 2] == '*')) {
+      depth = 1;
+      index = pos - 2;
+  
+      while ((index >= first + 2) && (depth > 0)) {
+        if ((src[index - 2] == '(') && (src[index - 1] == '*')) {
+          depth--;
+          index = index - 2;
+        }
+        else if ((src[index - 2] == '*') && (src[index - 1] == ')')) {
+          depth++;
+          index = index - 2;
+        }
+        else {
+          index--;
+        } /* end if */
+      } /* end while */
+  
+      if (depth > 0) {
+        break;
+      } /* end if */
+  
+      pos = index;
+    }
+    else {
+      break;
+    } /* end if */
+  } /* end while */
+  
+  return pos;
+} /* end trailing_trivia */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure copy_through(w, offset)
+ * --------------------------------------------------------------------------
+ * Copies the source text of w from the cursor up to offset to the output
+ * unchanged and advances the cursor to offset.
+ * ----------------------------------------------------------------------- */
+
+static void copy_through (r10_writer_s *w, size_t offset) {
+  
+  if (offset > w->cursor) {
+    fwrite(w->source + w->cursor, 1, offset - w->cursor, w->file);
+    w->cursor = offset;
+  } /* end if */
+} /* end copy_through */
+
+
+/* --------------------------------------------------------------------------
+ * private function is_convertible_subnode(node_type, index)
+ * --------------------------------------------------------------------------
+ * Returns true if the subnode at index of a node of type node_type is a
+ * definition, declaration, type or export list that may need conversion.
+ * Subnodes that are names, expressions or statements are never converted.
+ * Neither are formal parameters, procedure types and returned types, they
+ * contain nothing to regenerate but type CARDINAL, which M2R10 permits
+ * only as a type identifier there.
+ * ----------------------------------------------------------------------- */
+
+static bool is_convertible_subnode
+  (m2t_ast_nodetype_t node_type, uint_t index) {
+  
+  switch (node_type) {
+  
+    /* all subnodes */
+    case AST_DEFLIST :
+    case AST_DECLLIST :
+    case AST_FIELDLISTSEQ :
+    case AST_VFLISTSEQ :
+    case AST_INDEXLIST :
+      return true;
+  
+    /* first subnode */
+    case AST_BLOCK :
+    case AST_SET :
+    case AST_RECORD :
+    case AST_POINTER :
+    case AST_VSREC :
+      return (index == 0);
+  
+    /* second subnode */
+    case AST_TYPEDEF :
+    case AST_TYPEDECL :
+    case AST_VARDECL :
+    case AST_FIELDLIST :
+    case AST_ARRAY :
+    case AST_EXTREC :
+      return (index == 1);
+  
+    /* block, the heading holds formal parameters and returned type only */
+    case AST_PROC :
+      return (index == 1);
+  
+    /* base type */
+    case AST_SUBR :
+      return (index == 2);
+  
+    /* definitions */
+    case AST_DEFMOD :
+      return (index == 2);
+  
+    /* block */
+    case AST_IMPMOD :
+      return (index == 3);
+  
+    /* export list and block */
+    case AST_MODDECL :
+      return (index == 3) || (index == 4);
+  
+    default :
+      return false;
+  } /* end switch */
+} /* end is_convertible_subnode */
+
+
+/* --------------------------------------------------------------------------
+ * private function is_conversion(w, node)
+ * --------------------------------------------------------------------------
+ * Returns true if node itself is a construct that must be regenerated.
+ * Must only be called for nodes in a convertible position.
+ * ----------------------------------------------------------------------- */
+
+static bool is_conversion (r10_writer_s *w, m2t_astnode_t node) {
+  
+  switch (m2t_ast_nodetype(node)) {
+    case AST_VRNTREC :
+    case AST_EXPORT :
+    case AST_QUALEXP :
+      return true;
+  
+    case AST_IDENT :
+      return is_cardinal(w, node);
+  
+    default :
+      return false;
+  } /* end switch */
+} /* end is_conversion */
+
+
+/* --------------------------------------------------------------------------
+ * private function is_cardinal(w, node)
+ * --------------------------------------------------------------------------
+ * Returns true if node is type identifier CARDINAL and option
+ * subtype-cardinals is set, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+static bool is_cardinal (r10_writer_s *w, m2t_astnode_t node) {
+  
+  if ((NOT(w->cardinals)) || (m2t_ast_nodetype(node) != AST_IDENT)) {
+    return false;
+  } /* end if */
+  
+  return
+    (strcmp(m2t_string_char_ptr(m2t_ast_value(node)), "CARDINAL") == 0);
+} /* end is_cardinal */
+
+
+/* --------------------------------------------------------------------------
+ * private function contains_conversion(w, node)
+ * --------------------------------------------------------------------------
+ * Returns true if node is or contains a construct that must be regenerated.
+ * ----------------------------------------------------------------------- */
+
+static bool contains_conversion (r10_writer_s *w, m2t_astnode_t node) {
+  
+  m2t_ast_nodetype_t node_type;
+  uint_t index, count;
+  
+  if (node == NULL) {
+    return false;
+  } /* end if */
+  
+  if (is_conversion(w, node)) {
+    return true;
+  } /* end if */
+  
+  node_type = m2t_ast_nodetype(node);
+  count = m2t_ast_subnode_count(node);
+  
+  for (index = 0; index < count; index++) {
+    if ((is_convertible_subnode(node_type, index)) &&
+        (contains_conversion(w, m2t_ast_subnode_for_index(node, index)))) {
+      return true;
+    } /* end if */
+  } /* end for */
+  
+  return false;
+} /* end contains_conversion */
+
+
+/* --------------------------------------------------------------------------
+ * private function can_descend(w, node)
+ * --------------------------------------------------------------------------
+ * Returns true if every construct to be regenerated within node lies within
+ * a subnode that has a span of its own, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+static bool can_descend (r10_writer_s *w, m2t_astnode_t node) {
+  
+  m2t_ast_nodetype_t node_type;
+  m2t_astnode_t subnode;
+  uint_t index, count;
+  
+  node_type = m2t_ast_nodetype(node);
+  count = m2t_ast_subnode_count(node);
+  
+  for (index = 0; index < count; index++) {
+    if (NOT(is_convertible_subnode(node_type, index))) {
+      continue;
+    } /* end if */
+  
+    subnode = m2t_ast_subnode_for_index(node, index);
+  
+    if ((NOT(contains_conversion(w, subnode))) ||
+        (m2t_span_table_lookup(w->spans,
+          m2c_ast_view_origin(w->view, subnode), NULL))) {
+      continue;
+    } /* end if */
+  
+    if ((is_conversion(w, subnode)) || (NOT(can_descend(w, subnode)))) {
+      return false;
+    } /* end if */
+  } /* end for */
+  
+  return true;
+} /* end can_descend */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_node(w, node)
+ * --------------------------------------------------------------------------
+ * Writes the translation of node.  Unless node contains a construct to be
+ * regenerated, nothing is written and the text of node is later copied
+ * through with the text that follows it.  Otherwise node is regenerated if
+ * it is itself such a construct or if any such construct within it cannot
+ * be reached through subnodes with spans.  Else its subnodes are written
+ * in turn.
+ * ----------------------------------------------------------------------- */
+
+static void write_node (r10_writer_s *w, m2t_astnode_t node) {
+  
+  m2t_ast_nodetype_t node_type;
+  uint_t index, count;
+  size_t first, end;
+  
+  if (NOT(contains_conversion(w, node))) {
+    return;
+  } /* end if */
+  
+  if ((node_span(w, node, &first, &end)) &&
+      ((is_conversion(w, node)) || (NOT(can_descend(w, node))))) {
+    regenerate(w, node, first, end);
+    return;
+  } /* end if */
+  
+  node_type = m2t_ast_nodetype(node);
+  count = m2t_ast_subnode_count(node);
+  
+  for (index = 0; index < count; index++) {
+    if (is_convertible_subnode(node_type, index)) {
+      write_node(w, m2t_ast_subnode_for_index(node, index));
+    } /* end if */
+  } /* end for */
+} /* end write_node */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure regenerate(w, node, first, end)
+ * --------------------------------------------------------------------------
+ * Copies the source text up to first, writes the regenerated text of node
+ * in place of its source text, followed by the comments within it and by
+ * the whitespace and comments that trail it, and advances the cursor to end.
+ * ----------------------------------------------------------------------- */
+
+static void regenerate
+  (r10_writer_s *w, m2t_astnode_t node, size_t first, size_t end) {
+  
+  size_t line, trivia;
+  
+  trivia = trailing_trivia(w, first, end);
+  copy_through(w, first);
+  
+  /* nested lines are indented relative to the line of first */
+  line = first;
+  while ((line > 0) &&
+         (w->source[line - 1] != ASCII_LF) &&
+         (w->source[line - 1] != ASCII_CR)) {
+    line--;
+  } /* end while */
+  
+  w->indent_start = line;
+  while ((line < first) &&
+         ((w->source[line] == ' ') || (w->source[line] == ASCII_TAB))) {
+    line++;
+  } /* end while */
+  w->indent_length = line - w->indent_start;
+  
+  switch (m2t_ast_nodetype(node)) {
+    case AST_EXPORT :
+    case AST_QUALEXP :
+      write_export(w, node);
+      break;
+  
+    default :
+      write_type(w, node, 0);
+  } /* end switch */
+  
+  write_comments(w, first, trivia);
+  
+  w->cursor = trivia;
+  copy_through(w, end);
+} /* end regenerate */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_comments(w, first, end)
+ * --------------------------------------------------------------------------
+ * Writes the comments of the source text from first up to end, if comments
+ * are recorded, each copied from the source and preceded by a space.  A
+ * line comment is followed by a new line.
+ * ----------------------------------------------------------------------- */
+
+static void write_comments (r10_writer_s *w, size_t first, size_t end) {
+  
+  m2t_comment_t comment;
+  uint_t index;
+  
+  if (w->comments == NULL) {
+    return;
+  } /* end if */
+  
+  index = m2t_comment_table_index_for_offset(w->comments, (uint32_t) first);
+  
+  while ((m2t_comment_table_entry(w->comments, index, &comment)) &&
+         ((size_t) comment.offset + comment.length <= end)) {
+    fputc(' ', w->file);
+    fwrite(w->source + comment.offset, 1, comment.length, w->file);
+    
+    if (w->source[comment.offset] == '!') {
+      write_newline(w, 0);
+    } /* end if */
+    
+    index++;
+  } /* end while */
+} /* end write_comments */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_export(w, export)
+ * --------------------------------------------------------------------------
+ * Writes export list export as a comment.  M2R10 has no export lists.
+ * ----------------------------------------------------------------------- */
+
+static void write_export (r10_writer_s *w, m2t_astnode_t export) {
+  
+  if (m2t_ast_nodetype(export) == AST_QUALEXP) {
+    emit_str(w, "(* EXPORT QUALIFIED ");
+  }
+  else {
+    emit_str(w, "(* EXPORT ");
+  } /* end if */
+  
+  write_ident_list(w, m2t_ast_subnode_for_index(export, 0));
+  emit_str(w, "; *)");
+} /* end write_export */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_type(w, type, depth)
+ * --------------------------------------------------------------------------
+ * Writes type denoter type.  Nested lines are indented by depth levels
+ * relative to the line on which the regenerated construct starts.
+ * ----------------------------------------------------------------------- */
+
+static void write_type (r10_writer_s *w, m2t_astnode_t type, uint_t depth) {
+  
+  m2t_astnode_t subnode;
+  uint_t index, count;
+  
+  switch (m2t_ast_nodetype(type)) {
+  
+    case AST_IDENT :
+      if (is_cardinal(w, type)) {
+        emit_str(w, R10_CARDINAL_SUBRANGE);
+      }
+      else {
+        emit_string(w, m2t_ast_value(type));
+      } /* end if */
+      break;
+  
+    case AST_QUALIDENT :
+      write_qualident(w, type);
+      break;
+  
+    /* [lo..hi] OF base */
+    case AST_SUBR :
+      emit_str(w, "[");
+      write_expr(w, m2t_ast_subnode_for_index(type, 0), R10_PREC_ANY);
+      emit_str(w, "..");
+      write_expr(w, m2t_ast_subnode_for_index(type, 1), R10_PREC_ANY);
+      emit_str(w, "]");
+  
+      subnode = m2t_ast_subnode_for_index(type, 2);
+      if (m2t_ast_nodetype(subnode) != AST_EMPTY) {
+        emit_str(w, " OF ");
+  
+        if (is_cardinal(w, subnode)) {
+          emit_str(w, "INTEGER");
+        }
+        else {
+          write_type(w, subnode, depth);
+        } /* end if */
+      } /* end if */
+      break;
+  
+    case AST_ENUM :
+      emit_str(w, "( ");
+      write_ident_list(w, m2t_ast_subnode_for_index(type, 0));
+      emit_str(w, " )");
+      break;
+  
+    case AST_SET :
+      emit_str(w, "SET OF ");
+      write_type(w, m2t_ast_subnode_for_index(type, 0), depth);
+      break;
+  
+    case AST_ARRAY :
+      emit_str(w, "ARRAY ");
+      subnode = m2t_ast_subnode_for_index(type, 0);
+      count = m2t_ast_subnode_count(subnode);
+  
+      for (index = 0; index < count; index++) {
+        if (index > 0) {
+          emit_str(w, ", ");
+        } /* end if */
+        write_type(w, m2t_ast_subnode_for_index(subnode, index), depth);
+      } /* end for */
+  
+      emit_str(w, " OF ");
+      write_type(w, m2t_ast_subnode_for_index(type, 1), depth);
+      break;
+  
+    case AST_RECORD :
+    case AST_VRNTREC :
+      write_record(w, NULL, m2t_ast_subnode_for_index(type, 0), depth);
+      break;
+  
+    case AST_EXTREC :
+      write_record(w, m2t_ast_subnode_for_index(type, 0),
+        m2t_ast_subnode_for_index(type, 1), depth);
+      break;
+  
+    case AST_POINTER :
+      emit_str(w, "POINTER TO ");
+      write_type(w, m2t_ast_subnode_for_index(type, 0), depth);
+      break;
+  
+    case AST_PROCTYPE :
+      emit_str(w, "PROCEDURE");
+      subnode = m2t_ast_subnode_for_index(type, 0);
+  
+      if (m2t_ast_nodetype(subnode) != AST_EMPTY) {
+        emit_str(w, " ( ");
+        count = m2t_ast_subnode_count(subnode);
+  
+        for (index = 0; index < count; index++) {
+          if (index > 0) {
+            emit_str(w, ", ");
+          } /* end if */
+          write_formal_type(w, m2t_ast_subnode_for_index(subnode, index));
+        } /* end for */
+  
+        emit_str(w, " )");
+      } /* end if */
+  
+      subnode = m2t_ast_subnode_for_index(type, 1);
+      if (m2t_ast_nodetype(subnode) != AST_EMPTY) {
+        emit_str(w, " : ");
+        write_formal_type(w, subnode);
+      } /* end if */
+      break;
+  
+    default : /* not a type */
+      break;
+  } /* end switch */
+} /* end write_type */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_formal_type(w, type)
+ * --------------------------------------------------------------------------
+ * Writes formal type or returned type type of a procedure type.  Type
+ * CARDINAL is written as is, M2R10 permits only type identifiers there.
+ * ----------------------------------------------------------------------- */
+
+static void write_formal_type (r10_writer_s *w, m2t_astnode_t type) {
+  
+  switch (m2t_ast_nodetype(type)) {
+  
+    case AST_IDENT :
+      emit_string(w, m2t_ast_value(type));
+      break;
+  
+    case AST_QUALIDENT :
+      write_qualident(w, type);
+      break;
+  
+    case AST_OPENARRAY :
+      emit_str(w, "ARRAY OF ");
+      write_formal_type(w, m2t_ast_subnode_for_index(type, 0));
+      break;
+  
+    case AST_CONSTP :
+      emit_str(w, "CONST ");
+      write_formal_type(w, m2t_ast_subnode_for_index(type, 0));
+      break;
+  
+    case AST_VARP :
+      emit_str(w, "VAR ");
+      write_formal_type(w, m2t_ast_subnode_for_index(type, 0));
+      break;
+  
+    default : /* not a formal type */
+      break;
+  } /* end switch */
+} /* end write_formal_type */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_record(w, base, flseq, depth)
+ * --------------------------------------------------------------------------
+ * Writes a record type with field list sequence flseq, extending base if
+ * base is not NULL.  Variant parts are flattened into ordinary fields.
+ * ----------------------------------------------------------------------- */
+
+static void write_record
+  (r10_writer_s *w, m2t_astnode_t base, m2t_astnode_t flseq, uint_t depth) {
+  
+  uint_t total, count;
+  
+  emit_str(w, "RECORD");
+  
+  if (base != NULL) {
+    emit_str(w, " ( ");
+    write_type(w, base, depth);
+    emit_str(w, " )");
+  } /* end if */
+  
+  total = field_count(flseq);
+  count = 0;
+  write_field_seq(w, flseq, depth + 1, total, &count);
+  
+  write_newline(w, depth);
+  emit_str(w, "END");
+} /* end write_record */
+
+
+/* --------------------------------------------------------------------------
+ * private function field_count(flseq)
+ * --------------------------------------------------------------------------
+ * Returns the number of fields of field list sequence flseq once variant
+ * parts have been flattened.
+ * ----------------------------------------------------------------------- */
+
+static uint_t field_count (m2t_astnode_t flseq) {
+  
+  m2t_astnode_t item, vlist;
+  uint_t index, count, vindex, vcount, total;
+  
+  if ((flseq == NULL) || (m2t_ast_nodetype(flseq) == AST_EMPTY)) {
+    return 0;
+  } /* end if */
+  
+  total = 0;
+  count = m2t_ast_subnode_count(flseq);
+  
+  for (index = 0; index < count; index++) {
+    item = m2t_ast_subnode_for_index(flseq, index);
+  
+    if (m2t_ast_nodetype(item) == AST_FIELDLIST) {
+      total++;
+    }
+    else if (m2t_ast_nodetype(item) == AST_VFLIST) {
+      /* tag field */
+      if (m2t_ast_nodetype(m2t_ast_subnode_for_index(item, 0)) != AST_EMPTY) {
+        total++;
+      } /* end if */
+  
+      /* variants */
+      vlist = m2t_ast_subnode_for_index(item, 2);
+      vcount = m2t_ast_subnode_count(vlist);
+  
+      for (vindex = 0; vindex < vcount; vindex++) {
+        total = total + field_count
+          (m2t_ast_subnode_for_index
+            (m2t_ast_subnode_for_index(vlist, vindex), 1));
+      } /* end for */
+  
+      /* ELSE part */
+      total = total + field_count(m2t_ast_subnode_for_index(item, 3));
+    } /* end if */
+  } /* end for */
+  
+  return total;
+} /* end field_count */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_field_seq(w, flseq, depth, total, count)
+ * --------------------------------------------------------------------------
+ * Writes the fields of field list sequence flseq, one field list per line.
+ * Field total holds the number of fields of the whole record, count the
+ * number of fields written so far.
+ * ----------------------------------------------------------------------- */
+
+static void write_field_seq
+  (r10_writer_s *w, m2t_astnode_t flseq, uint_t depth,
+   uint_t total, uint_t *count) {
+  
+  m2t_astnode_t item;
+  uint_t index, item_count;
+  
+  if ((flseq == NULL) || (m2t_ast_nodetype(flseq) == AST_EMPTY)) {
+    return;
+  } /* end if */
+  
+  item_count = m2t_ast_subnode_count(flseq);
+  
+  for (index = 0; index < item_count; index++) {
+    item = m2t_ast_subnode_for_index(flseq, index);
+  
+    if (m2t_ast_nodetype(item) == AST_FIELDLIST) {
+      write_field(w, m2t_ast_subnode_for_index(item, 0),
+        m2t_ast_subnode_for_index(item, 1), depth, total, count);
+    }
+    else if (m2t_ast_nodetype(item) == AST_VFLIST) {
+      write_variant_fields(w, item, depth, total, count);
+    } /* end if */
+  } /* end for */
+} /* end write_field_seq */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_variant_fields(w, vflist, depth, total, count)
+ * --------------------------------------------------------------------------
+ * Writes the variant part vflist as ordinary fields.  The tag becomes a
+ * field of its own and the case structure is written as comments.
+ * ----------------------------------------------------------------------- */
+
+static void write_variant_fields
+  (r10_writer_s *w, m2t_astnode_t vflist, uint_t depth,
+   uint_t total, uint_t *count) {
+  
+  m2t_astnode_t tag, tagtype, vlist, variant, flseq;
+  uint_t index, vcount;
+  
+  tag = m2t_ast_subnode_for_index(vflist, 0);
+  tagtype = m2t_ast_subnode_for_index(vflist, 1);
+  
+  /* CASE tag : Type OF */
+  write_newline(w, depth);
+  emit_str(w, "(* CASE ");
+  
+  if (m2t_ast_nodetype(tag) != AST_EMPTY) {
+    emit_string(w, m2t_ast_value(tag));
+    emit_str(w, " ");
+  } /* end if */
+  
+  emit_str(w, ": ");
+  emit_string(w, m2t_ast_value(tagtype));
+  emit_str(w, " OF *)");
+  
+  if (m2t_ast_nodetype(tag) != AST_EMPTY) {
+    write_field(w, tag, tagtype, depth, total, count);
+  } /* end if */
+  
+  /* variant ( '|' variant )* */
+  vlist = m2t_ast_subnode_for_index(vflist, 2);
+  vcount = m2t_ast_subnode_count(vlist);
+  
+  for (index = 0; index < vcount; index++) {
+    variant = m2t_ast_subnode_for_index(vlist, index);
+  
+    write_newline(w, depth);
+    emit_str(w, (index == 0) ? "(* " : "(* | ");
+    write_case_labels(w, m2t_ast_subnode_for_index(variant, 0));
+    emit_str(w, " : *)");
+  
+    write_field_seq
+      (w, m2t_ast_subnode_for_index(variant, 1), depth, total, count);
+  } /* end for */
+  
+  /* ELSE fieldListSequence */
+  flseq = m2t_ast_subnode_for_index(vflist, 3);
+  
+  if ((flseq != NULL) && (m2t_ast_nodetype(flseq) != AST_EMPTY)) {
+    write_newline(w, depth);
+    emit_str(w, "(* ELSE *)");
+    write_field_seq(w, flseq, depth, total, count);
+  } /* end if */
+  
+  write_newline(w, depth);
+  emit_str(w, "(* END *)");
+} /* end write_variant_fields */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_field(w, names, type, depth, total, count)
+ * --------------------------------------------------------------------------
+ * Writes a field list on a line of its own.  Parameter names is either an
+ * identifier list or a single identifier.  The field list is terminated
+ * by a semicolon unless it is the last field list of the record.
+ * ----------------------------------------------------------------------- */
+
+static void write_field
+  (r10_writer_s *w, m2t_astnode_t names, m2t_astnode_t type, uint_t depth,
+   uint_t total, uint_t *count) {
+  
+  write_newline(w, depth);
+  
+  if (m2t_ast_nodetype(names) == AST_IDENT) {
+    emit_string(w, m2t_ast_value(names));
+  }
+  else {
+    write_ident_list(w, names);
+  } /* end if */
+  
+  emit_str(w, " : ");
+  write_type(w, type, depth);
+  
+  (*count)++;
+  if (*count < total) {
+    emit_str(w, ";");
+  } /* end if */
+} /* end write_field */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_case_labels(w, cllist)
+ * --------------------------------------------------------------------------
+ * Writes case label list cllist.
+ * ----------------------------------------------------------------------- */
+
+static void write_case_labels (r10_writer_s *w, m2t_astnode_t cllist) {
+  
+  m2t_astnode_t labels, upper;
+  uint_t index, count;
+  
+  count = m2t_ast_subnode_count(cllist);
+  
+  for (index = 0; index < count; index++) {
+    labels = m2t_ast_subnode_for_index(cllist, index);
+  
+    if (index > 0) {
+      emit_str(w, ", ");
+    } /* end if */
+  
+    write_expr(w, m2t_ast_subnode_for_index(labels, 0), R10_PREC_ANY);
+    upper = m2t_ast_subnode_for_index(labels, 1);
+  
+    if ((upper != NULL) && (m2t_ast_nodetype(upper) != AST_EMPTY)) {
+      emit_str(w, "..");
+      write_expr(w, upper, R10_PREC_ANY);
+    } /* end if */
+  } /* end for */
+} /* end write_case_labels */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_expr(w, expr, prec)
+ * --------------------------------------------------------------------------
+ * Writes expression expr, enclosed in parentheses if its operator binds
+ * less tightly than prec requires.
+ * ----------------------------------------------------------------------- */
+
+static void write_expr (r10_writer_s *w, m2t_astnode_t expr, uint_t prec) {
+  
+  m2t_ast_nodetype_t node_type;
+  m2t_astnode_t subnode;
+  const char *operator;
+  uint_t level;
+  
+  node_type = m2t_ast_nodetype(expr);
+  
+  switch (node_type) {
+  
+    case AST_IDENT :
+    case AST_INTVAL :
+    case AST_REALVAL :
+    case AST_CHRVAL :
+      emit_string(w, m2t_ast_value(expr));
+      return;
+  
+    case AST_QUALIDENT :
+      write_qualident(w, expr);
+      return;
+  
+    case AST_QUOTEDVAL :
+      write_quoted(w, m2t_ast_value(expr));
+      return;
+  
+    case AST_NEG :
+      if (prec > R10_PREC_SIMPLE) {
+        emit_str(w, "(");
+      } /* end if */
+  
+      emit_str(w, "-");
+      write_expr(w, m2t_ast_subnode_for_index(expr, 0), R10_PREC_TERM);
+  
+      if (prec > R10_PREC_SIMPLE) {
+        emit_str(w, ")");
+      } /* end if */
+      return;
+  
+    case AST_NOT :
+      emit_str(w, "NOT ");
+      write_expr(w, m2t_ast_subnode_for_index(expr, 0), R10_PREC_FACTOR);
+      return;
+  
+    case AST_FCALL :
+      write_expr(w, m2t_ast_subnode_for_index(expr, 0), R10_PREC_FACTOR);
+      emit_str(w, "(");
+      write_expr_list(w, m2t_ast_subnode_for_index(expr, 1));
+      emit_str(w, ")");
+      return;
+  
+    case AST_SETVAL :
+      subnode = m2t_ast_subnode_for_index(expr, 0);
+  
+      if (m2t_ast_nodetype(subnode) != AST_EMPTY) {
+        write_expr(w, subnode, R10_PREC_FACTOR);
+        emit_str(w, " ");
+      } /* end if */
+  
+      emit_str(w, "{ ");
+      write_expr_list(w, m2t_ast_subnode_for_index(expr, 1));
+      emit_str(w, " }");
+      return;
+  
+    case AST_RANGE :
+      write_expr(w, m2t_ast_subnode_for_index(expr, 0), R10_PREC_ANY);
+      emit_str(w, "..");
+      write_expr(w, m2t_ast_subnode_for_index(expr, 1), R10_PREC_ANY);
+      return;
+  
+    case AST_DESIG :
+      write_expr(w, m2t_ast_subnode_for_index(expr, 0), R10_PREC_FACTOR);
+      subnode = m2t_ast_subnode_for_index(expr, 1);
+  
+      if (m2t_ast_nodetype(subnode) == AST_FIELD) {
+        emit_str(w, ".");
+        write_expr(w, m2t_ast_subnode_for_index(subnode, 0), R10_PREC_ANY);
+      }
+      else {
+        emit_str(w, "[");
+        write_expr_list(w, subnode);
+        emit_str(w, "]");
+      } /* end if */
+      return;
+  
+    case AST_DEREF :
+      write_expr(w, m2t_ast_subnode_for_index(expr, 0), R10_PREC_FACTOR);
+      emit_str(w, "^");
+      return;
+  
+    default :
+      break;
+  } /* end switch */
+  
+  /* binary operators */
+  switch (node_type) {
+    case AST_EQ : operator = " = "; level = R10_PREC_RELATION; break;
+    case AST_NEQ : operator = " # "; level = R10_PREC_RELATION; break;
+    case AST_LT : operator = " < "; level = R10_PREC_RELATION; break;
+    case AST_LTEQ : operator = " <= "; level = R10_PREC_RELATION; break;
+    case AST_GT : operator = " > "; level = R10_PREC_RELATION; break;
+    case AST_GTEQ : operator = " >= "; level = R10_PREC_RELATION; break;
+    case AST_IN : operator = " IN "; level = R10_PREC_RELATION; break;
+    case AST_PLUS : operator = " + "; level = R10_PREC_SIMPLE; break;
+    case AST_MINUS : operator = " - "; level = R10_PREC_SIMPLE; break;
+    case AST_OR : operator = " OR "; level = R10_PREC_SIMPLE; break;
+    case AST_ASTERISK : operator = " * "; level = R10_PREC_TERM; break;
+    case AST_SOLIDUS : operator = " / "; level = R10_PREC_TERM; break;
+    case AST_DIV : operator = " DIV "; level = R10_PREC_TERM; break;
+    case AST_MOD : operator = " MOD "; level = R10_PREC_TERM; break;
+    case AST_AND : operator = " AND "; level = R10_PREC_TERM; break;
+    default : /* not an expression */
+      return;
+  } /* end switch */
+  
+  if (level < prec) {
+    emit_str(w, "(");
+  } /* end if */
+  
+  /* operators are left associative, relations do not associate */
+  write_expr(w, m2t_ast_subnode_for_index(expr, 0), level);
+  emit_str(w, operator);
+  write_expr(w, m2t_ast_subnode_for_index(expr, 1), level + 1);
+  
+  if (level < prec) {
+    emit_str(w, ")");
+  } /* end if */
+} /* end write_expr */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_expr_list(w, list)
+ * --------------------------------------------------------------------------
+ * Writes the expressions of list separated by commas.  Writes nothing if
+ * list is empty.
+ * ----------------------------------------------------------------------- */
+
+static void write_expr_list (r10_writer_s *w, m2t_astnode_t list) {
+  
+  uint_t index, count;
+  
+  if ((list == NULL) || (m2t_ast_nodetype(list) == AST_EMPTY)) {
+    return;
+  } /* end if */
+  
+  count = m2t_ast_subnode_count(list);
+  
+  for (index = 0; index < count; index++) {
+    if (index > 0) {
+      emit_str(w, ", ");
+    } /* end if */
+    write_expr(w, m2t_ast_subnode_for_index(list, index), R10_PREC_ANY);
+  } /* end for */
+} /* end write_expr_list */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_quoted(w, string)
+ * --------------------------------------------------------------------------
+ * Writes quoted literal string, delimited by double quotes unless it
+ * contains a double quote.
+ * ----------------------------------------------------------------------- */
+
+static void write_quoted (r10_writer_s *w, m2t_string_t string) {
+  
+  const char *str;
+  char delimiter;
+  
+  str = m2t_string_char_ptr(string);
+  delimiter = (strchr(str, '"') == NULL) ? '"' : '\'';
+  
+  fputc(delimiter, w->file);
+  fputs(str, w->file);
+  fputc(delimiter, w->file);
+} /* end write_quoted */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_ident_list(w, idlist)
+ * --------------------------------------------------------------------------
+ * Writes the identifiers of idlist separated by commas.
+ * ----------------------------------------------------------------------- */
+
+static void write_ident_list (r10_writer_s *w, m2t_astnode_t idlist) {
+  
+  uint_t index, count;
+  
+  count = m2t_ast_subnode_count(idlist);
+  
+  for (index = 0; index < count; index++) {
+    if (index > 0) {
+      emit_str(w, ", ");
+    } /* end if */
+    emit_string(w, m2t_ast_value_for_index(idlist, index));
+  } /* end for */
+} /* end write_ident_list */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_qualident(w, qualident)
+ * --------------------------------------------------------------------------
+ * Writes the components of qualident separated by periods.
+ * ----------------------------------------------------------------------- */
+
+static void write_qualident (r10_writer_s *w, m2t_astnode_t qualident) {
+  
+  uint_t index, count;
+  
+  count = m2t_ast_subnode_count(qualident);
+  
+  for (index = 0; index < count; index++) {
+    if (index > 0) {
+      emit_str(w, ".");
+    } /* end if */
+    emit_string(w, m2t_ast_value_for_index(qualident, index));
+  } /* end for */
+} /* end write_qualident */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_newline(w, depth)
+ * --------------------------------------------------------------------------
+ * Starts a new line, indented like the line on which the regenerated
+ * construct starts and by depth further levels of two spaces each.
+ * ----------------------------------------------------------------------- */
+
+static void write_newline (r10_writer_s *w, uint_t depth) {
+  
+  uint_t level;
+  
+  fputc('\n', w->file);
+  fwrite(w->source + w->indent_start, 1, w->indent_length, w->file);
+  
+  for (level = 0; level < depth; level++) {
+    fputs("  ", w->file);
+  } /* end for */
+} /* end write_newline */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure emit_str(w, str)
+ * --------------------------------------------------------------------------
+ * Writes C string str.
+ * ----------------------------------------------------------------------- */
+
+static void emit_str (r10_writer_s *w, const char *str) {
+  fputs(str, w->file);
+} /* end emit_str */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure emit_string(w, string)
+ * --------------------------------------------------------------------------
+ * Writes interned string string.  Writes nothing if string is NULL.
+ * ----------------------------------------------------------------------- */
+
+static void emit_string (r10_writer_s *w, m2t_string_t string) {
+  
+  if (string != NULL) {
+    fputs(m2t_string_char_ptr(string), w->file);
+  } /* end if */
+} /* end emit_string */
+
+
+/* END OF FILE */
@@ -0,0 +1,301 @@
+/* M2T -- Sorce to Source Modula-2 Translator
+ *
+ * Copyright (c) 2016-2023 Benjamin Kowarsch
+ *
+ * Author & Maintainer: Benjamin Kowarsch <org.m2sf>
+ *
+ * @synopsis
+ *
+ * M2T is a multi-dialect Modula-2 source-to-source translator. It translates
+ * source files  written in the  classic dialects  to semantically equivalent
+ * source files in  Modula-2 Revision 2010 (M2R10).  It supports  the classic
+ * Modula-2 dialects  described in  the 2nd, 3rd and 4th editions  of Niklaus
+ * Wirth's book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * For more details please visit: https://github.com/trijezdci/m2t/wiki
+ *
+ * @repository
+ *
+ * https://github.com/trijezdci/m2t
+ *
+ * @file
+ *
+ * m2t-regions.c
+ *
+ * Implementation of M2T declaration region tables.
+ *
+ * @license
+ *
+ * M2T is free software:  You can redistribute and modify it  under the terms
+ * of the  GNU Lesser General Public License (LGPL) either version 2.1  or at
+ * your choice version 3, both as published by the Free Software Foundation.
+ *
+ * M2T is distributed  in the hope  that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even  the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received  a copy of the  GNU Lesser General Public License
+ * along with M2T.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#include "m2t-regions.h"
+
+#include <stdlib.h>
+
+
+/* --------------------------------------------------------------------------
+ * Initial capacity of a region table
+ * ----------------------------------------------------------------------- */
+
+#define M2T_REGION_TABLE_INIT_CAPACITY 64
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2t_region_table_s
+ * --------------------------------------------------------------------------
+ * record type representing a region table.  The regions are held in an
+ * array in source order, which doubles its capacity whenever it is full.
+ * ----------------------------------------------------------------------- */
+
+struct m2t_region_table_s {
+  /* capacity */ uint_t capacity;
+  /* count */ uint_t count;
+  /* region */ m2t_region_t *region;
+};
+
+typedef struct m2t_region_table_s m2t_region_table_s;
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_new_region_table()
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated empty region table, or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2t_region_table_t m2t_new_region_table (void) {
+  
+  m2t_region_table_t new_table;
+  
+  new_table = malloc(sizeof(m2t_region_table_s));
+  
+  if (new_table == NULL) {
+    return NULL;
+  } /* end if */
+  
+  new_table->region =
+    malloc(M2T_REGION_TABLE_INIT_CAPACITY * sizeof(m2t_region_t));
+  
+  if (new_table->region == NULL) {
+    free(new_table);
+    return NULL;
+  } /* end if */
+  
+  new_table->capacity = M2T_REGION_TABLE_INIT_CAPACITY;
+  new_table->count = 0;
+  
+  return new_table;
+} /* end m2t_new_region_table */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_region_table_append(table, region)
+ * --------------------------------------------------------------------------
+ * Appends region to table.  Regions must be appended in source order.
+ * Returns true on success, or false if table or region is NULL, if region
+ * starts before the end of the last region in table or if the table could
+ * not be grown.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_region_table_append
+  (m2t_region_table_t table, const m2t_region_t *region) {
+  
+  m2t_region_t *new_region;
+  
+  if ((table == NULL) || (region == NULL)) {
+    return false;
+  } /* end if */
+  
+  if ((table->count > 0) &&
+      (region->start < table->region[table->count - 1].end)) {
+    return false;
+  } /* end if */
+  
+  if (table->count == table->capacity) {
+    new_region =
+      realloc(table->region, 2 * table->capacity * sizeof(m2t_region_t));
+    
+    if (new_region == NULL) {
+      return false;
+    } /* end if */
+    
+    table->region = new_region;
+    table->capacity = 2 * table->capacity;
+  } /* end if */
+  
+  table->region[table->count] = *region;
+  table->count++;
+  
+  return true;
+} /* end m2t_region_table_append */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_region_table_count(table)
+ * --------------------------------------------------------------------------
+ * Returns the number of regions in table, or zero if table is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2t_region_table_count (m2t_region_table_t table) {
+  
+  if (table == NULL) {
+    return 0;
+  } /* end if */
+  
+  return table->count;
+} /* end m2t_region_table_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_region_table_entry(table, index, region)
+ * --------------------------------------------------------------------------
+ * Passes the region at index in table back in region and returns true.
+ * Returns false and leaves region unmodified if table is NULL or if index
+ * is out of range.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_region_table_entry
+  (m2t_region_table_t table, uint_t index, m2t_region_t *region) {
+  
+  if ((table == NULL) || (index >= table->count)) {
+    return false;
+  } /* end if */
+  
+  if (region != NULL) {
+    *region = table->region[index];
+  } /* end if */
+  
+  return true;
+} /* end m2t_region_table_entry */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_region_table_find(table, offset, length, index)
+ * --------------------------------------------------------------------------
+ * Searches table for the region that contains the bytes from offset up to
+ * but not including offset + length.  If length is zero, the region that
+ * contains offset is searched for, an offset at the end of the last region
+ * belongs to the last region.  Passes the index of the region back in
+ * index and returns true if found.  Returns false and leaves index
+ * unmodified if table is NULL or if no single region contains the bytes.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_region_table_find
+  (m2t_region_table_t table, uint32_t offset, uint32_t length,
+   uint_t *index) {
+  
+  uint_t low, high, mid;
+  m2t_region_t *region;
+  
+  if ((table == NULL) || (table->count == 0) ||
+      (offset < table->region[0].start)) {
+    return false;
+  } /* end if */
+  
+  /* binary search for the last region starting at or before offset */
+  low = 0;
+  high = table->count - 1;
+  while (low < high) {
+    mid = low + (high - low + 1) / 2;
+    
+    if (table->region[mid].start <= offset) {
+      low = mid;
+    }
+    else /* region starts after offset */ {
+      high = mid - 1;
+    } /* end if */
+  } /* end while */
+  
+  region = &table->region[low];
+  
+  /* the bytes must end within the region */
+  if ((offset + length > region->end) ||
+      ((length == 0) && (offset == region->end) &&
+       (low + 1 < table->count))) {
+    return false;
+  } /* end if */
+  
+  WRITE_OUTPARAM(index, low);
+  
+  return true;
+} /* end m2t_region_table_find */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_region_table_resize(table, index, delta)
+ * --------------------------------------------------------------------------
+ * Adds delta to the end of the region at index in table and to the start
+ * and end of all regions following it, as after an edit within the region
+ * at index that has inserted delta bytes, or removed -delta bytes if delta
+ * is negative.  Does nothing if table is NULL or if index is out of range.
+ * ----------------------------------------------------------------------- */
+
+void m2t_region_table_resize
+  (m2t_region_table_t table, uint_t index, int32_t delta) {
+  
+  uint_t n;
+  
+  if ((table == NULL) || (index >= table->count)) {
+    return;
+  } /* end if */
+  
+  table->region[index].end =
+    (uint32_t) ((int32_t) table->region[index].end + delta);
+  
+  for (n = index + 1; n < table->count; n++) {
+    table->region[n].start =
+      (uint32_t) ((int32_t) table->region[n].start + delta);
+    table->region[n].end =
+      (uint32_t) ((int32_t) table->region[n].end + delta);
+  } /* end for */
+  
+  return;
+} /* end m2t_region_table_resize */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_region_table_clear(table)
+ * --------------------------------------------------------------------------
+ * Removes all regions from table.  Does nothing if table is NULL.
+ * ----------------------------------------------------------------------- */
+
+void m2t_region_table_clear (m2t_region_table_t table) {
+  
+  if (table == NULL) {
+    return;
+  } /* end if */
+  
+  table->count = 0;
+  
+  return;
+} /* end m2t_region_table_clear */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_release_region_table(table)
+ * --------------------------------------------------------------------------
+ * Releases the region table passed in table and passes back NULL in table.
+ * ----------------------------------------------------------------------- */
+
+void m2t_release_region_table (m2t_region_table_t *table) {
+  
+  if ((table == NULL) || (*table == NULL)) {
+    return;
+  } /* end if */
+  
+  free((*table)->region);
+  free(*table);
+  *table = NULL;
+} /* end m2t_release_region_table */
+
+
+/* END OF FILE */
@@ -0,0 +1,315 @@
+/* M2T -- Sorce to Source Modula-2 Translator
+ *
+ * Copyright (c) 2016-2023 Benjamin Kowarsch
+ *
+ * Author & Maintainer: Benjamin Kowarsch <org.m2sf>
+ *
+ * @synopsis
+ *
+ * M2T is a multi-dialect Modula-2 source-to-source translator. It translates
+ * source files  written in the  classic dialects  to semantically equivalent
+ * source files in  Modula-2 Revision 2010 (M2R10).  It supports  the classic
+ * Modula-2 dialects  described in  the 2nd, 3rd and 4th editions  of Niklaus
+ * Wirth's book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * For more details please visit: https://github.com/trijezdci/m2t/wiki
+ *
+ * @repository
+ *
+ * https://github.com/trijezdci/m2t
+ *
+ * @file
+ *
+ * m2t-spans.c
+ *
+ * Implementation of M2T source span tables.
+ *
+ * @license
+ *
+ * M2T is free software:  You can redistribute and modify it  under the terms
+ * of the  GNU Lesser General Public License (LGPL) either version 2.1  or at
+ * your choice version 3, both as published by the Free Software Foundation.
+ *
+ * M2T is distributed  in the hope  that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even  the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received  a copy of the  GNU Lesser General Public License
+ * along with M2T.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#include "m2t-spans.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+
+/* --------------------------------------------------------------------------
+ * Initial capacity and maximum load of a span table
+ * ----------------------------------------------------------------------- */
+
+#define M2T_SPAN_TABLE_INIT_CAPACITY 256
+
+#define M2T_SPAN_TABLE_MAX_LOAD_PERCENT 75
+
+
+/* --------------------------------------------------------------------------
+ * private type m2t_span_entry_s
+ * --------------------------------------------------------------------------
+ * record type representing a slot of a span table.  A slot is empty if its
+ * node is NULL.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* node */ m2t_astnode_t node;
+  /* span */ m2t_source_span_t span;
+} m2t_span_entry_s;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2t_span_table_s
+ * --------------------------------------------------------------------------
+ * record type representing a span table.  The table is an open addressing
+ * table with linear probing, keyed by node.  The capacity is a power of
+ * two.  Spans are never removed, the table is released as a whole.
+ * ----------------------------------------------------------------------- */
+
+struct m2t_span_table_s {
+  /* capacity */ uint_t capacity;
+  /* used */ uint_t used;
+  /* slot */ m2t_span_entry_s *slot;
+};
+
+typedef struct m2t_span_table_s m2t_span_table_s;
+
+
+/* --------------------------------------------------------------------------
+ * Forward declarations
+ * ----------------------------------------------------------------------- */
+
+static inline uint_t home_slot (m2t_astnode_t node, uint_t mask);
+
+static uint_t table_probe (m2t_span_table_t table, m2t_astnode_t node);
+
+static bool table_reserve (m2t_span_table_t table);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_new_span_table()
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated empty span table, or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2t_span_table_t m2t_new_span_table (void) {
+  
+  m2t_span_table_t new_table;
+  
+  new_table = malloc(sizeof(m2t_span_table_s));
+  
+  if (new_table == NULL) {
+    return NULL;
+  } /* end if */
+  
+  new_table->slot =
+    calloc(M2T_SPAN_TABLE_INIT_CAPACITY, sizeof(m2t_span_entry_s));
+  
+  if (new_table->slot == NULL) {
+    free(new_table);
+    return NULL;
+  } /* end if */
+  
+  new_table->capacity = M2T_SPAN_TABLE_INIT_CAPACITY;
+  new_table->used = 0;
+  
+  return new_table;
+} /* end m2t_new_span_table */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_span_table_add(table, node, span)
+ * --------------------------------------------------------------------------
+ * Records span as the source span of node in table, replacing any span
+ * previously recorded for node.  Returns true on success, or false if
+ * table, node or span is NULL or if the table could not be grown.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_span_table_add
+  (m2t_span_table_t table, m2t_astnode_t node, const m2t_source_span_t *span) {
+  
+  uint_t slot;
+  
+  if ((table == NULL) || (node == NULL) || (span == NULL)) {
+    return false;
+  } /* end if */
+  
+  if (NOT(table_reserve(table))) {
+    return false;
+  } /* end if */
+  
+  slot = table_probe(table, node);
+  
+  if (table->slot[slot].node == NULL) {
+    table->slot[slot].node = node;
+    table->used++;
+  } /* end if */
+  
+  table->slot[slot].span = *span;
+  
+  return true;
+} /* end m2t_span_table_add */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_span_table_lookup(table, node, span)
+ * --------------------------------------------------------------------------
+ * Passes the source span recorded for node in table back in span and
+ * returns true.  Returns false and leaves span unmodified if no span has
+ * been recorded for node or if table is NULL.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_span_table_lookup
+  (m2t_span_table_t table, m2t_astnode_t node, m2t_source_span_t *span) {
+  
+  uint_t slot;
+  
+  if ((table == NULL) || (node == NULL)) {
+    return false;
+  } /* end if */
+  
+  slot = table_probe(table, node);
+  
+  if (table->slot[slot].node == NULL) {
+    return false;
+  } /* end if */
+  
+  if (span != NULL) {
+    *span = table->slot[slot].span;
+  } /* end if */
+  
+  return true;
+} /* end m2t_span_table_lookup */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_span_table_count(table)
+ * --------------------------------------------------------------------------
+ * Returns the number of spans recorded in table, or zero if table is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2t_span_table_count (m2t_span_table_t table) {
+  
+  if (table == NULL) {
+    return 0;
+  } /* end if */
+  
+  return table->used;
+} /* end m2t_span_table_count */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_release_span_table(table)
+ * --------------------------------------------------------------------------
+ * Releases the span table passed in table and passes back NULL in table.
+ * The nodes recorded in the table are not released.
+ * ----------------------------------------------------------------------- */
+
+void m2t_release_span_table (m2t_span_table_t *table) {
+  
+  if ((table == NULL) || (*table == NULL)) {
+    return;
+  } /* end if */
+  
+  free((*table)->slot);
+  free(*table);
+  *table = NULL;
+} /* end m2t_release_span_table */
+
+
+/* ************************************************************************ *
+ * Private Functions                                                        *
+ * ************************************************************************ */
+
+/* --------------------------------------------------------------------------
+ * private function home_slot(node, mask)
+ * --------------------------------------------------------------------------
+ * Returns the home slot of node for a table with capacity mask + 1.
+ * ----------------------------------------------------------------------- */
+
+static inline uint_t home_slot (m2t_astnode_t node, uint_t mask) {
+  
+  uint64_t key;
+  
+  key = ((uint64_t) (uintptr_t) node) * 0x9E3779B97F4A7C15ULL;
+  
+  return ((uint_t) (key >> 32)) & mask;
+} /* end home_slot */
+
+
+/* --------------------------------------------------------------------------
+ * private function table_probe(table, node)
+ * --------------------------------------------------------------------------
+ * Returns the slot of node in table, or the empty slot where node would
+ * be stored if node is not present.
+ * ----------------------------------------------------------------------- */
+
+static uint_t table_probe (m2t_span_table_t table, m2t_astnode_t node) {
+  
+  uint_t slot, mask;
+  
+  mask = table->capacity - 1;
+  slot = home_slot(node, mask);
+  
+  while ((table->slot[slot].node != NULL) &&
+         (table->slot[slot].node != node)) {
+    slot = (slot + 1) & mask;
+  } /* end while */
+  
+  return slot;
+} /* end table_probe */
+
+
+/* --------------------------------------------------------------------------
+ * private function table_reserve(table)
+ * --------------------------------------------------------------------------
+ * Makes room for one more node in table, doubling its capacity if the
+ * maximum load would otherwise be exceeded.  Returns false if the table
+ * needed to grow but could not be grown.
+ * ----------------------------------------------------------------------- */
+
+static bool table_reserve (m2t_span_table_t table) {
+  
+  m2t_span_entry_s *old_slot;
+  uint_t old_capacity, slot, new_slot;
+  
+  if (((table->used + 1) * 100) <=
+      (table->capacity * M2T_SPAN_TABLE_MAX_LOAD_PERCENT)) {
+    return true;
+  } /* end if */
+  
+  old_slot = table->slot;
+  old_capacity = table->capacity;
+  
+  table->slot = calloc(2 * old_capacity, sizeof(m2t_span_entry_s));
+  
+  if (table->slot == NULL) {
+    table->slot = old_slot;
+    return false;
+  } /* end if */
+  
+  table->capacity = 2 * old_capacity;
+  
+  /* rehash occupied slots */
+  for (slot = 0; slot < old_capacity; slot++) {
+    if (old_slot[slot].node != NULL) {
+      new_slot = table_probe(table, old_slot[slot].node);
+      table->slot[new_slot] = old_slot[slot];
+    } /* end if */
+  } /* end for */
+  
+  free(old_slot);
+  
+  return true;
+} /* end table_reserve */
+
+
+/* END OF FILE */
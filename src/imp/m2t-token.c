@@ -41,6 +41,7 @@
 #include "m2t-token.h"
 
 #include <stddef.h>
+#include <string.h>
 
 
 /* --------------------------------------------------------------------------
@@ -244,31 +245,75 @@ static const char *m2t_special_symbol_lexeme_table[] = {
 
 
 /* --------------------------------------------------------------------------
- * private function str_match(str1, str2)
+ * Reserved word hash
  * --------------------------------------------------------------------------
- * Returns true character strings str1 and str2 match, otherwise false.
+ * Hash over length, first and last character of a reserved word.  The
+ * multipliers are chosen such that the hash is collision free over all
+ * reserved words.  When a reserved word is added, it must be verified
+ * that the hash remains collision free, or new multipliers be chosen.
+ * A collision shows as a duplicate designated initializer in the
+ * hash table below, which GCC and Clang report with -Woverride-init.
  * ----------------------------------------------------------------------- */
 
 #define MAX_RESWORD_LENGTH 14
 
-static bool str_match (const char *str1, const char *str2) {
-  uint_t index;
-  
-  index = 0;
-  while (index <= MAX_RESWORD_LENGTH + 1) {
-    if (str1[index] != str2[index]) {
-      return false;
-    }
-    else if (str1[index] == '\0') {
-      return true;
-    }
-    else {
-      index++;
-    } /* end if */
-  } /* end while */
-  
-  return false;
-} /* end str_match */
+#define RESWORD_HASH_TABLE_SIZE 128
+
+#define RESWORD_HASH(_length, _first, _last) \
+  ((((uint_t) (_length)) + \
+    ((uint_t) (_first)) * 6 + ((uint_t) (_last)) * 22) & \
+   (RESWORD_HASH_TABLE_SIZE - 1))
+
+
+/* --------------------------------------------------------------------------
+ * array m2t_resword_hash_table
+ * --------------------------------------------------------------------------
+ * Perfect hash table mapping reserved word hashes to reserved word tokens.
+ * Unused slots hold TOKEN_UNKNOWN.
+ * ----------------------------------------------------------------------- */
+
+static const m2t_token_t m2t_resword_hash_table[RESWORD_HASH_TABLE_SIZE] = {
+  [RESWORD_HASH(3, 'A', 'D')] = TOKEN_AND,
+  [RESWORD_HASH(5, 'A', 'Y')] = TOKEN_ARRAY,
+  [RESWORD_HASH(5, 'B', 'N')] = TOKEN_BEGIN,
+  [RESWORD_HASH(2, 'B', 'Y')] = TOKEN_BY,
+  [RESWORD_HASH(4, 'C', 'E')] = TOKEN_CASE,
+  [RESWORD_HASH(5, 'C', 'T')] = TOKEN_CONST,
+  [RESWORD_HASH(10, 'D', 'N')] = TOKEN_DEFINITION,
+  [RESWORD_HASH(3, 'D', 'V')] = TOKEN_DIV,
+  [RESWORD_HASH(2, 'D', 'O')] = TOKEN_DO,
+  [RESWORD_HASH(4, 'E', 'E')] = TOKEN_ELSE,
+  [RESWORD_HASH(5, 'E', 'F')] = TOKEN_ELSIF,
+  [RESWORD_HASH(3, 'E', 'D')] = TOKEN_END,
+  [RESWORD_HASH(4, 'E', 'T')] = TOKEN_EXIT,
+  [RESWORD_HASH(6, 'E', 'T')] = TOKEN_EXPORT,
+  [RESWORD_HASH(3, 'F', 'R')] = TOKEN_FOR,
+  [RESWORD_HASH(4, 'F', 'M')] = TOKEN_FROM,
+  [RESWORD_HASH(2, 'I', 'F')] = TOKEN_IF,
+  [RESWORD_HASH(14, 'I', 'N')] = TOKEN_IMPLEMENTATION,
+  [RESWORD_HASH(6, 'I', 'T')] = TOKEN_IMPORT,
+  [RESWORD_HASH(2, 'I', 'N')] = TOKEN_IN,
+  [RESWORD_HASH(4, 'L', 'P')] = TOKEN_LOOP,
+  [RESWORD_HASH(3, 'M', 'D')] = TOKEN_MOD,
+  [RESWORD_HASH(6, 'M', 'E')] = TOKEN_MODULE,
+  [RESWORD_HASH(3, 'N', 'T')] = TOKEN_NOT,
+  [RESWORD_HASH(2, 'O', 'F')] = TOKEN_OF,
+  [RESWORD_HASH(2, 'O', 'R')] = TOKEN_OR,
+  [RESWORD_HASH(7, 'P', 'R')] = TOKEN_POINTER,
+  [RESWORD_HASH(9, 'P', 'E')] = TOKEN_PROCEDURE,
+  [RESWORD_HASH(9, 'Q', 'D')] = TOKEN_QUALIFIED,
+  [RESWORD_HASH(6, 'R', 'D')] = TOKEN_RECORD,
+  [RESWORD_HASH(6, 'R', 'T')] = TOKEN_REPEAT,
+  [RESWORD_HASH(6, 'R', 'N')] = TOKEN_RETURN,
+  [RESWORD_HASH(3, 'S', 'T')] = TOKEN_SET,
+  [RESWORD_HASH(4, 'T', 'N')] = TOKEN_THEN,
+  [RESWORD_HASH(2, 'T', 'O')] = TOKEN_TO,
+  [RESWORD_HASH(4, 'T', 'E')] = TOKEN_TYPE,
+  [RESWORD_HASH(5, 'U', 'L')] = TOKEN_UNTIL,
+  [RESWORD_HASH(3, 'V', 'R')] = TOKEN_VAR,
+  [RESWORD_HASH(5, 'W', 'E')] = TOKEN_WHILE,
+  [RESWORD_HASH(4, 'W', 'H')] = TOKEN_WITH
+}; /* end m2t_resword_hash_table */
 
 
 /* --------------------------------------------------------------------------
@@ -323,7 +368,7 @@ inline bool m2t_is_malformed_literal_token (m2t_token_t token) {
  * ----------------------------------------------------------------------- */
 
 inline bool m2t_is_special_symbol_token (m2t_token_t token) {
-  return ((token >= TOKEN_ADDITION) && (token <= TOKEN_RIGHT_BRACE));
+  return ((token >= TOKEN_PLUS) && (token <= TOKEN_RIGHT_BRACE));
 } /* end m2t_is_special_symbol_token */
 
 
@@ -335,456 +380,30 @@ inline bool m2t_is_special_symbol_token (m2t_token_t token) {
  * ----------------------------------------------------------------------- */
 
 m2t_token_t m2t_token_for_resword (const char *lexeme, uint_t length) {
+  m2t_token_t token;
+  const char *resword;
   
   /* verify pre-conditions */
-  if ((lexeme == NULL) || (length < 2) || (length > 14)) {
+  if ((lexeme == NULL) || (length < 2) || (length > MAX_RESWORD_LENGTH)) {
     return TOKEN_UNKNOWN;
   } /* end if */
   
-  switch (length) {
-    case /* length = 2 */ 2 :
-      switch (lexeme[0]) {
-      
-	    case 'B' :
-	      /* BY */
-	      if (lexeme[1] == 'Y') {
-	        return TOKEN_BY;
-	      }
-	    
-	      else {
-	        return TOKEN_UNKNOWN;
-	      } /* end if */
-	
-	    case 'D' :
-	      /* DO */
-	      if (lexeme[1] == 'O') {
-	        return TOKEN_DO;
-	      }
-	      
-	      else {
-	        return TOKEN_UNKNOWN;
-	      } /* end if */
-	
-	    case 'I' :
-	      /* IF */
-	      if (lexeme[1] == 'F') {
-	        return TOKEN_IF;
-	      }
-	  	    
-	      /* IN */
-	      else if (lexeme[1] == 'N') {
-	        return TOKEN_IN;
-	      }
-	      
-	      else {
-	        return TOKEN_UNKNOWN;
-	      } /* end if */
-	    
-	    case 'O' :
-	      /* OF */
-	      if (lexeme[1] == 'F') {
-	        return TOKEN_OF;
-	      }
-	      
-	      /* OR */
-	      else if (lexeme[1] == 'R') {
-	        return TOKEN_OR;
-	      }
-	      
-	      else {
-	        return TOKEN_UNKNOWN;
-	      } /* end if */
-	    
-	    case 'T' :
-	      /* TO */
-	      if (lexeme[1] == 'O') {
-	        return TOKEN_TO;
-	      }
-	      
-	      else {
-	        return TOKEN_UNKNOWN;
-	      } /* end if */
-	    
-	    default :
-	      return TOKEN_UNKNOWN;
-	  } /* end switch */
-	
-    case /* length = 3 */ 3 :
-      switch (lexeme[0]) {
-      
-	    case 'A' :
-	      /* AND */
-	      if (str_match(lexeme, m2t_resword_lexeme_table[TOKEN_AND])) {
-	        return TOKEN_AND;
-	      }
-	      
-	      else {
-	        return TOKEN_UNKNOWN;
-	      } /* end if */
-        	
-	    case 'D' :
-	      /* DIV */
-	      if (str_match(lexeme, m2t_resword_lexeme_table[TOKEN_DIV])) {
-	        return TOKEN_DIV;
-	      }
-	      
-	      else {
-	        return TOKEN_UNKNOWN;
-	      } /* end if */
-	
-	    case 'E' :
-	      /* END */
-	      if (str_match(lexeme, m2t_resword_lexeme_table[TOKEN_END])) {
-	        return TOKEN_END;
-	      }
-	      
-	      else {
-	        return TOKEN_UNKNOWN;
-	      } /* end if */
-	      
-	    case 'F' :
-	      /* FOR */
-	      if (str_match(lexeme, m2t_resword_lexeme_table[TOKEN_FOR])) {
-	        return TOKEN_FOR;
-	      }
-	      
-	      else {
-	        return TOKEN_UNKNOWN;
-	      } /* end if */
-	      
-	    case 'M' :
-	      /* MOD */
-	      if (str_match(lexeme, m2t_resword_lexeme_table[TOKEN_MOD])) {
-	        return TOKEN_MOD;
-	      }
-	      
-	      else {
-	        return TOKEN_UNKNOWN;
-	      } /* end if */
-	      
-	    case 'N' :
-	      /* NOT */
-	      if (str_match(lexeme, m2t_resword_lexeme_table[TOKEN_NOT])) {
-	        return TOKEN_NOT;
-	      }
-	      
-	      else {
-	        return TOKEN_UNKNOWN;
-	      } /* end if */
-	      
-	    case 'S' :
-	      /* SET */
-	      if (str_match(lexeme, m2t_resword_lexeme_table[TOKEN_SET])) {
-	        return TOKEN_SET;
-	      }
-	      
-	      else {
-	        return TOKEN_UNKNOWN;
-	      } /* end if */
-	      
-	    case 'V' :
-	      /* VAR */
-	      if (str_match(lexeme, m2t_resword_lexeme_table[TOKEN_VAR])) {
-	        return TOKEN_VAR;
-	      }
-	      
-	      else {
-	        return TOKEN_UNKNOWN;
-	      } /* end if */
-	      
-	    default :
-	      return TOKEN_UNKNOWN;
-	  } /* end switch */
-	
-    case /* length = 4 */ 4 :
-      switch (lexeme[1]) {
-      
-	    case 'A' :
-	      /* CASE */
-	      if (str_match(lexeme, m2t_resword_lexeme_table[TOKEN_CASE])) {
-	        return TOKEN_CASE;
-	      }
-	      
-	      else {
-	        return TOKEN_UNKNOWN;
-	      } /* end if */
-	      
-	    case 'H' :
-	      /* THEN */
-	      if (str_match(lexeme, m2t_resword_lexeme_table[TOKEN_THEN])) {
-	        return TOKEN_THEN;
-	      }
-	      
-	      else {
-	        return TOKEN_UNKNOWN;
-	      } /* end if */
-	      
-	    case 'I' :
-	      /* WITH */
-	      if (str_match(lexeme, m2t_resword_lexeme_table[TOKEN_WITH])) {
-	        return TOKEN_WITH;
-	      }
-	      
-	      else {
-	        return TOKEN_UNKNOWN;
-	      } /* end if */
-	      
-	    case 'L' :
-	      /* ELSE */
-	      if (str_match(lexeme, m2t_resword_lexeme_table[TOKEN_ELSE])) {
-	        return TOKEN_ELSE;
-	      }
-	      
-	      else {
-	        return TOKEN_UNKNOWN;
-	      } /* end if */
-	      
-	    case 'O' :
-	      /* LOOP */
-	      if (str_match(lexeme, m2t_resword_lexeme_table[TOKEN_LOOP])) {
-	        return TOKEN_LOOP;
-	      }
-	      
-	      else {
-	        return TOKEN_UNKNOWN;
-	      } /* end if */
-	      
-	    case 'R' :
-	      /* FROM */
-	      if (str_match(lexeme, m2t_resword_lexeme_table[TOKEN_FROM])) {
-	        return TOKEN_FROM;
-	      }
-	      
-	      else {
-	        return TOKEN_UNKNOWN;
-	      } /* end if */
-	      
-	    case 'X' :
-	      /* EXIT */
-	      if (str_match(lexeme, m2t_resword_lexeme_table[TOKEN_EXIT])) {
-	        return TOKEN_EXIT;
-	      }
-	      
-	      else {
-	        return TOKEN_UNKNOWN;
-	      } /* end if */
-	      
-        case 'Y' :
-          /* TYPE */
-	      if (str_match(lexeme, m2t_resword_lexeme_table[TOKEN_TYPE])) {
-	        return TOKEN_TYPE;
-	      }
-	      
-	      else {
-	        return TOKEN_UNKNOWN;
-	      } /* end if */
-	      
-	    default :
-	      return TOKEN_UNKNOWN;
-	  } /* end switch */
-	
-    case /* length = 5 */ 5 :
-      switch (lexeme[0]) {
-      
-	    case 'A' :
-	      /* ARRAY */
-	      if (str_match(lexeme, m2t_resword_lexeme_table[TOKEN_ARRAY])) {
-	        return TOKEN_ARRAY;
-	      }
-	      
-	      else {
-	        return TOKEN_UNKNOWN;
-	      } /* end if */
-	      
-	    case 'B' :
-	      /* BEGIN */
-	      if (str_match(lexeme, m2t_resword_lexeme_table[TOKEN_BEGIN])) {
-	        return TOKEN_BEGIN;
-	      }
-	      
-	      else {
-	        return TOKEN_UNKNOWN;
-	      } /* end if */
-	      
-	    case 'C' :
-	      /* CONST */
-	      if (str_match(lexeme, m2t_resword_lexeme_table[TOKEN_CONST])) {
-	        return TOKEN_CONST;
-	      }
-	      
-	      else {
-	        return TOKEN_UNKNOWN;
-	      } /* end if */
-	      
-	    case 'E' :
-	      /* ELSIF */
-	      if (str_match(lexeme, m2t_resword_lexeme_table[TOKEN_ELSIF])) {
-	        return TOKEN_ELSIF;
-	      }
-	      
-	      else {
-	        return TOKEN_UNKNOWN;
-	      } /* end if */
-	      
-	    case 'U' :
-	      /* UNTIL */
-	      if (str_match(lexeme, m2t_resword_lexeme_table[TOKEN_UNTIL])) {
-	        return TOKEN_UNTIL;
-	      }
-	      
-	      else {
-	        return TOKEN_UNKNOWN;
-	      } /* end if */
-	      
-	    case 'W' :
-	      /* WHILE */
-	      if (str_match(lexeme, m2t_resword_lexeme_table[TOKEN_WHILE])) {
-	        return TOKEN_WHILE;
-	      }
-	      
-	      else {
-	        return TOKEN_UNKNOWN;
-	      } /* end if */
-	      
-	    default :
-	      return TOKEN_UNKNOWN;
-	  } /* end switch */
-	
-    case /* length 6 */ 6 :
-      switch (lexeme[5]) {
-      
-	    case 'E' :
-	      /* MODULE */
-	      if (str_match(lexeme, m2t_resword_lexeme_table[TOKEN_MODULE])) {
-	        return TOKEN_MODULE;
-	      }
-	      
-	      else {
-	        return TOKEN_UNKNOWN;
-	      } /* end if */
-	      
-	    case 'D' :
-	      /* RECORD */
-	      if (str_match(lexeme, m2t_resword_lexeme_table[TOKEN_RECORD])) {
-	        return TOKEN_RECORD;
-	      }
-	      
-	      else {
-	        return TOKEN_UNKNOWN;
-	      } /* end if */
-	      
-	    case 'N' :
-	      /* RETURN */
-	      if (str_match(lexeme, m2t_resword_lexeme_table[TOKEN_RETURN])) {
-	        return TOKEN_RETURN;
-	      }
-	      
-	      else {
-	        return TOKEN_UNKNOWN;
-	      } /* end if */
-	      
-	    case 'T' :
-	      switch (lexeme[0]) {
-	      
-	        case 'E' :
-	          /* EXPORT */
-	          if (str_match(lexeme, m2t_resword_lexeme_table[TOKEN_EXPORT])) {
-	            return TOKEN_EXPORT;
-	          }
-	          
-	          else {
-	            return TOKEN_UNKNOWN;
-	          } /* end if */
-	        
-	        case 'I' :
-	          /* IMPORT */
-	          if (str_match(lexeme, m2t_resword_lexeme_table[TOKEN_IMPORT])) {
-	            return TOKEN_IMPORT;
-	          }
-	          
-	          else {
-	            return TOKEN_UNKNOWN;
-	          } /* end if */
-	        
-	        case 'R' :
-	          /* REPEAT */
-	          if (str_match(lexeme, m2t_resword_lexeme_table[TOKEN_REPEAT])) {
-	            return TOKEN_REPEAT;
-	          }
-	          
-	          else {
-	            return TOKEN_UNKNOWN;
-	          } /* end if */
-	          
-	        default :
-	          return TOKEN_UNKNOWN;
-	      } /* end switch */
-	      
-	    default :
-	      return TOKEN_UNKNOWN;
-	  } /* end switch */
-	
-    case /* length = 7 */ 7 :
-      /* POINTER */
-      if (str_match(lexeme, m2t_resword_lexeme_table[TOKEN_POINTER])) {
-	    return TOKEN_POINTER;
-      }
-      
-      else {
-	    return TOKEN_UNKNOWN;
-      } /* end if */
-      
-    case /* length = 9 */ 9 :
-      switch (lexeme[0]) {
-      
-        case 'P' :
-          /* PROCEDURE */
-          if (str_match(lexeme, m2t_resword_lexeme_table[TOKEN_PROCEDURE])) {
-	        return TOKEN_PROCEDURE;
-          }
-          
-          else {
-	        return TOKEN_UNKNOWN;
-          } /* end if */
-        
-        case 'Q' :
-          /* QUALIFIED */
-          if (str_match(lexeme, m2t_resword_lexeme_table[TOKEN_QUALIFIED])) {
-	        return TOKEN_QUALIFIED;
-          }
-          
-          else {
-	        return TOKEN_UNKNOWN;
-          } /* end if */
-        
-        default :
-	      return TOKEN_UNKNOWN;
-      } /* end switch */
-	
-    case /* length = 10 */ 10 :
-      /* DEFINITION */
-      if (str_match(lexeme, m2t_resword_lexeme_table[TOKEN_DEFINITION])) {
-	    return TOKEN_DEFINITION;
-      }
-      
-      else {
-	    return TOKEN_UNKNOWN;
-      } /* end if */
-    
-    case /* length = 14 */ 14 :
-      /* IMPLEMENTATION */
-      if (str_match(lexeme,
-          m2t_resword_lexeme_table[TOKEN_IMPLEMENTATION])) {
-	    return TOKEN_IMPLEMENTATION;
-      }
-      
-      else {
-	    return TOKEN_UNKNOWN;
-      } /* end if */
-    
-    default :
-      return TOKEN_UNKNOWN;
-  } /* end switch (length) */
+  /* look up candidate */
+  token = m2t_resword_hash_table
+    [RESWORD_HASH(length, lexeme[0], lexeme[length - 1])];
+  
+  if (token == TOKEN_UNKNOWN) {
+    return TOKEN_UNKNOWN;
+  } /* end if */
+  
+  /* confirm match, the candidate's terminator is checked last */
+  resword = m2t_resword_lexeme_table[token];
+  if ((strncmp(lexeme, resword, length) == 0) && (resword[length] == '\0')) {
+    return token;
+  }
+  else {
+    return TOKEN_UNKNOWN;
+  } /* end if */
 } /* end m2t_token_for_resword */
 
 
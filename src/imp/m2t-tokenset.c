@@ -41,68 +41,53 @@
 
 #include "m2t-tokenset.h"
 
-#include "m2t-first-set-inits.h"
-#include "m2t-follow-set-inits.h"
-
 #include <stdio.h>
-#include <stdlib.h>
 #include <stdarg.h>
 
 
 /* --------------------------------------------------------------------------
- * constant M2T_TOKENSET_SEGMENT_COUNT
- * --------------------------------------------------------------------------
- * Number of 32 bit segments in a tokenset.
+ * external definitions of inline functions
  * ----------------------------------------------------------------------- */
 
-#define M2T_TOKENSET_SEGMENT_COUNT ((TOKEN_END_MARK / 32) + 1)
+extern inline uint_t m2t_tokenset_popcount (uint32_t bits);
 
+extern inline m2t_tokenset_t m2t_tokenset_union
+  (m2t_tokenset_t set1, m2t_tokenset_t set2);
 
-/* --------------------------------------------------------------------------
- * hidden type m2t_tokenset_opaque_t
- * --------------------------------------------------------------------------
- * Opaque record type representing a Modula-2 tokenset object,
- * implemented as an array of 32-bit segments.
- * ----------------------------------------------------------------------- */
+extern inline m2t_tokenset_t m2t_tokenset_intersection
+  (m2t_tokenset_t set1, m2t_tokenset_t set2);
+
+extern inline bool m2t_tokenset_element (m2t_tokenset_t set, m2t_token_t token);
 
-struct m2t_tokenset_opaque_t {
-   /* segment */ uint32_t segment[M2T_TOKENSET_SEGMENT_COUNT];
-   /* elem_count */ uint_t elem_count;
-};
+extern inline uint_t m2t_tokenset_element_count (m2t_tokenset_t set);
 
-typedef struct m2t_tokenset_opaque_t m2t_tokenset_opaque_t;
+extern inline bool m2t_tokenset_subset
+  (m2t_tokenset_t set, m2t_tokenset_t subset);
+
+extern inline bool m2t_tokenset_disjunct
+  (m2t_tokenset_t set1, m2t_tokenset_t set2);
 
 
 /* --------------------------------------------------------------------------
- * function m2t_new_tokenset_from_list(token_list)
+ * function m2t_tokenset_from_list(token_list)
  * --------------------------------------------------------------------------
- * Returns a newly allocated tokenset object that includes the tokens passed
- * as arguments of a non-empty variadic argument list.  The argument list
- * must be explicitly terminated with 0.
+ * Returns a tokenset that includes the tokens passed as arguments of a
+ * non-empty variadic argument list.  The argument list must be explicitly
+ * terminated with 0.  Tokens outside of the token range are ignored.
  * ----------------------------------------------------------------------- */
 
-uint_t count_bits_in_set (m2t_tokenset_t set);
-
-m2t_tokenset_t m2t_new_tokenset_from_list (m2t_token_t first_token, ...) {
+m2t_tokenset_t m2t_tokenset_from_list (m2t_token_t first_token, ...) {
   m2t_tokenset_t new_set;
-  uint_t bit, seg_index;
+  uint_t seg_index;
   m2t_token_t token;
   
   va_list token_list;
   va_start(token_list, first_token);
   
-  /* allocate new set */
-  new_set = malloc(sizeof(m2t_tokenset_opaque_t));
-  
-  /* bail out if allocation failed */
-  if (new_set == NULL) {
-    return NULL;
-  } /* end if */
-  
   /* initialise */
   seg_index = 0;
   while (seg_index < M2T_TOKENSET_SEGMENT_COUNT) {
-    new_set->segment[seg_index] = 0;
+    new_set.segment[seg_index] = 0;
     seg_index++;
   } /* end while */
   
@@ -112,157 +97,17 @@ m2t_tokenset_t m2t_new_tokenset_from_list (m2t_token_t first_token, ...) {
   
     /* store token in set if in range */
     if (token < TOKEN_END_MARK) {
-      seg_index = token / 32;
-      bit = token % 32;
-      new_set->segment[seg_index] = new_set->segment[seg_index] | (1 << bit);
+      new_set.segment[token / 32] |= (UINT32_C(1) << (token % 32));
     } /* end if */
     
     /* get next token in list */
     token = va_arg(token_list, m2t_token_t);
   } /* end while */
   
-  /* update element counter */
-  new_set->elem_count = count_bits_in_set(new_set);
-  
-  return new_set;
-} /* end m2t_new_tokenset_from_list */
-
-
-/* --------------------------------------------------------------------------
- * function m2t_new_tokenset_from_union(set_list)
- * --------------------------------------------------------------------------
- * Returns a newly allocated tokenset object that represents the set union of
- * the tokensets passed as arguments of a non-empty variadic argument list.
- * The argument list must be explicitly terminated with NULL.
- * ----------------------------------------------------------------------- */
-
-m2t_tokenset_t m2t_new_tokenset_from_union (m2t_tokenset_t first_set, ...) {
-  m2t_tokenset_t new_set;
-  uint_t seg_index;
-  m2t_tokenset_t set;
-  
-  va_list set_list;
-  va_start(set_list, first_set);
-  
-  /* allocate new set */
-  new_set = malloc(sizeof(m2t_tokenset_opaque_t));
-  
-  /* bail out if allocation failed */
-  if (new_set == NULL) {
-    return NULL;
-  } /* end if */
-  
-  /* initialise */
-  seg_index = 0;
-  while (seg_index < M2T_TOKENSET_SEGMENT_COUNT) {
-    new_set->segment[seg_index] = 0;
-    seg_index++;
-  } /* end while */
-  
-  set = first_set;
-  /* calculate union with each set in list */
-  while (set != NULL) {
-    /* for each segment ... */
-    while (seg_index < M2T_TOKENSET_SEGMENT_COUNT) {
-      /* ... store union of corresponding segments */
-      new_set->segment[seg_index] =
-        new_set->segment[seg_index] | set->segment[seg_index];
-      
-      /* next segment */
-      seg_index++;
-    } /* end while */
-    
-    /* get next set in list */
-    set = va_arg(set_list, m2t_tokenset_t);
-  } /* end while */
-  
-  /* update element counter */
-  new_set->elem_count = count_bits_in_set(new_set);
+  va_end(token_list);
   
   return new_set;
-} /* m2t_new_tokenset_from_union */
-
-
-/* --------------------------------------------------------------------------
- * function m2t_tokenset_element(set, token)
- * --------------------------------------------------------------------------
- * Returns true if token is an element of set, otherwise false.
- * ----------------------------------------------------------------------- */
-
-bool m2t_tokenset_element (m2t_tokenset_t set, m2t_token_t token) {
-  uint_t bit, seg_index;
-  
-  if (token >= TOKEN_END_MARK) {
-    return false;
-  } /* end if */
-  
-  seg_index = token / 32;
-  bit = token % 32;
-  
-  return ((set->segment[seg_index] & (1 << bit)) != 0);
-} /* end m2t_tokenset_element */
-
-
-/* --------------------------------------------------------------------------
- * procedure m2t_tokenset_element_count(set)
- * --------------------------------------------------------------------------
- * Returns the number of elements in set.
- * ----------------------------------------------------------------------- */
-
-uint_t m2t_tokenset_element_count (m2t_tokenset_t set) {  
-  if (set == NULL) {
-    return 0;
-  } /* end if */
-  
-  return set->elem_count;
-} /* end m2t_tokenset_element_count */
-
-
-/* --------------------------------------------------------------------------
- * function m2t_tokenset_subset (set, subset)
- * --------------------------------------------------------------------------
- * Returns true if each element in subset is also in set, otherwise false.
- * ----------------------------------------------------------------------- */
-
-bool m2t_tokenset_subset (m2t_tokenset_t set, m2t_tokenset_t subset) {
-  uint_t seg_index;
-  
-  seg_index = 0;
-  while (seg_index < M2T_TOKENSET_SEGMENT_COUNT) {
-    if (((set->segment[seg_index] & subset->segment[seg_index]) ^
-        subset->segment[seg_index]) == 0) {
-      seg_index++;
-    }
-    else {
-      return false;
-    } /* end if */
-  } /* end while */
-  
-  return true;
-} /* end m2t_tokenset_subset */
-
-
-/* --------------------------------------------------------------------------
- * function m2t_tokenset_disjunct(set1, set2)
- * --------------------------------------------------------------------------
- * Returns true if set1 and set2 have no common elements, otherwise false.
- * ----------------------------------------------------------------------- */
-
-bool m2t_tokenset_disjunct (m2t_tokenset_t set1, m2t_tokenset_t set2) {
-  uint_t seg_index;
-  
-  seg_index = 0;
-  while (seg_index < M2T_TOKENSET_SEGMENT_COUNT) {
-    if ((set1->segment[seg_index] & set2->segment[seg_index]) == 0) {
-      seg_index++;
-    }
-    else {
-      return false;
-    } /* end if */
-  } /* end while */
-  
-  return true;
-} /* end m2t_tokenset_disjunct */
+} /* end m2t_tokenset_from_list */
 
 
 /* --------------------------------------------------------------------------
@@ -273,23 +118,25 @@ bool m2t_tokenset_disjunct (m2t_tokenset_t set1, m2t_tokenset_t set2) {
  * ----------------------------------------------------------------------- */
 
 void m2t_tokenset_print_set (const char *set_name, m2t_tokenset_t set) {
-  uint_t bit, seg_index, count;
+  uint_t bit, seg_index, count, elem_count;
   m2t_token_t token;
   
   printf("%s = {", set_name);
   
-  if (set->elem_count == 0) {
+  elem_count = m2t_tokenset_element_count(set);
+  
+  if (elem_count == 0) {
     printf(" ");
   } /* end if */
   
   count = 0;
   token = 0;
-  while ((count <= set->elem_count) && (token < TOKEN_END_MARK)) {
+  while ((count <= elem_count) && (token < TOKEN_END_MARK)) {
     seg_index = token / 32;
     bit = token % 32;
-    if ((set->segment[seg_index] & (1 << bit)) != 0) {
+    if ((set.segment[seg_index] & (UINT32_C(1) << bit)) != 0) {
       count++;
-      if (count < set->elem_count) {
+      if (count < elem_count) {
         printf("\n  %s,", m2t_name_for_token(token));
       }
       else {
@@ -311,23 +158,25 @@ void m2t_tokenset_print_set (const char *set_name, m2t_tokenset_t set) {
  * ----------------------------------------------------------------------- */
 
 void m2t_tokenset_print_list (m2t_tokenset_t set) {
-  uint_t bit, seg_index, count;
+  uint_t bit, seg_index, count, elem_count;
   m2t_token_t token;
   
-  if (set->elem_count == 0) {
+  elem_count = m2t_tokenset_element_count(set);
+  
+  if (elem_count == 0) {
     printf("(nil)");
   } /* end if */
   
   count = 0;
   token = 0;
-  while ((count <= set->elem_count) && (token < TOKEN_END_MARK)) {
+  while ((count <= elem_count) && (token < TOKEN_END_MARK)) {
     seg_index = token / 32;
     bit = token % 32;
     
-    if ((set->segment[seg_index] & (1 << bit)) != 0) {
+    if ((set.segment[seg_index] & (UINT32_C(1) << bit)) != 0) {
       count++;
       if (count > 1) {
-        if (count < set->elem_count) {
+        if (count < elem_count) {
           printf(", ");
         }
         else {
@@ -367,89 +216,26 @@ void m2t_tokenset_print_list (m2t_tokenset_t set) {
 } /* m2t_tokenset_print_list */
 
 
-/* --------------------------------------------------------------------------
- * procedure m2t_tokenset_print_literal_struct(ident)
- * --------------------------------------------------------------------------
- * Prints a struct definition for tokenset literals.
- * Format: struct ident { uint_t s0, s1, s2, ..., n };
- * ----------------------------------------------------------------------- */
-
-void m2t_tokenset_print_literal_struct (const char *ident) {
-  uint_t seg_index;
-  
-  printf("struct %s { uint_t s0", ident);
-  
-  seg_index = 1;
-  while (seg_index < M2T_TOKENSET_SEGMENT_COUNT) {
-    printf(", s%u", seg_index);
-    seg_index++;
-  } /* end while */
-  
-  printf(", n; };\n");
-  
-  printf("typedef struct %s %s;\n", ident, ident);
-} /* m2t_tokenset_print_literal_struct */
-
-
 /* --------------------------------------------------------------------------
  * procedure m2t_tokenset_print_literal(set)
  * --------------------------------------------------------------------------
- * Prints a sequence of hex values representing the bit pattern of set.
- * Format: { 0xHHHHHHHH, 0xHHHHHHHH, ..., count };
+ * Prints an initialiser for an m2t_tokenset_t object with the bit pattern
+ * of set, without any trailing punctuation or newline.
+ * Format: { { 0xHHHHHHHH, 0xHHHHHHHH, ... } }
  * ----------------------------------------------------------------------- */
 
 void m2t_tokenset_print_literal (m2t_tokenset_t set) {
   uint_t seg_index;
   
-  printf("{ /* bits: */ 0x%08X", set->segment[0]);
+  printf("{ { 0x%08X", set.segment[0]);
   
   seg_index = 1;
   while (seg_index < M2T_TOKENSET_SEGMENT_COUNT) {
-    printf(", 0x%08X", set->segment[seg_index]);
+    printf(", 0x%08X", set.segment[seg_index]);
     seg_index++;
   } /* end while */
   
-  printf(", /* counter: */ %u }\n", set->elem_count);
+  printf(" } }");
 } /* m2t_tokenset_print_literal */
 
-
-/* --------------------------------------------------------------------------
- * procedure m2t_tokenset_release(set)
- * --------------------------------------------------------------------------
- * Deallocates tokenset set.
- * ----------------------------------------------------------------------- */
-
-void m2t_tokenset_release (m2t_tokenset_t set) {
-  if (set != NULL) {
-    free(set);
-  } /* end if */
-} /* end m2t_tokenset_release */
-
-
-/* --------------------------------------------------------------------------
- * private function count_bits_in_set(set)
- * --------------------------------------------------------------------------
- * Returns the number of set bits in set.
- * ----------------------------------------------------------------------- */
-
-uint_t count_bits_in_set (m2t_tokenset_t set) {
-  uint_t bit, seg_index, bit_count;
-  
-  bit_count = 0;
-  seg_index = 0;
-  
-  while (seg_index < M2T_TOKENSET_SEGMENT_COUNT) {
-    bit = 0;
-    while (bit < 32) {
-      if ((set->segment[seg_index] & (1 << bit)) != 0) {
-        bit_count++;
-      } /* end if */
-      bit++;
-    } /* end while */
-    seg_index++;
-  } /* end while */
-  
-  return bit_count;
-} /* count_bits_in_set */
-
-/* END OF FILE */
\ No newline at end of file
+/* END OF FILE */
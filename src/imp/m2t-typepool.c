@@ -0,0 +1,583 @@
+/* M2T -- Sorce to Source Modula-2 Translator
+ *
+ * Copyright (c) 2016-2023 Benjamin Kowarsch
+ *
+ * Author & Maintainer: Benjamin Kowarsch <org.m2sf>
+ *
+ * @synopsis
+ *
+ * M2T is a multi-dialect Modula-2 source-to-source translator. It translates
+ * source files  written in the  classic dialects  to semantically equivalent
+ * source files in  Modula-2 Revision 2010 (M2R10).  It supports  the classic
+ * Modula-2 dialects  described in  the 2nd, 3rd and 4th editions  of Niklaus
+ * Wirth's book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * For more details please visit: https://github.com/trijezdci/m2t/wiki
+ *
+ * @repository
+ *
+ * https://github.com/trijezdci/m2t
+ *
+ * @file
+ *
+ * m2t-typepool.c
+ *
+ * Implementation of M2T type pools.
+ *
+ * @license
+ *
+ * M2T is free software:  You can redistribute and modify it  under the terms
+ * of the  GNU Lesser General Public License (LGPL) either version 2.1  or at
+ * your choice version 3, both as published by the Free Software Foundation.
+ *
+ * M2T is distributed  in the hope  that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even  the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received  a copy of the  GNU Lesser General Public License
+ * along with M2T.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#include "m2t-typepool.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+
+/* --------------------------------------------------------------------------
+ * Initial capacities and maximum load of a type pool
+ * ----------------------------------------------------------------------- */
+
+#define M2T_TYPE_POOL_INIT_CAPACITY 256
+
+#define M2T_TYPE_POOL_MAX_LOAD_PERCENT 75
+
+#define M2T_TYPE_POOL_INIT_GARBAGE_CAPACITY 64
+
+
+/* --------------------------------------------------------------------------
+ * private type m2t_type_pool_entry_s
+ * --------------------------------------------------------------------------
+ * record type representing a slot of a type pool.  A slot is empty if its
+ * node is NULL.  The hash of the node is kept to speed up probing and to
+ * rehash without visiting the node.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* node */ m2t_astnode_t node;
+  /* hash */ uint_t hash;
+} m2t_type_pool_entry_s;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2t_type_pool_s
+ * --------------------------------------------------------------------------
+ * record type representing a type pool.  The pool is an open addressing
+ * table with linear probing, keyed by node type and the identities of the
+ * subnodes or values of a node.  The capacity is a power of two.  Nodes
+ * are never removed, the pool is released as a whole.  Duplicates found
+ * while interning a subtree are collected in garbage and released once
+ * the subtree has been interned.
+ * ----------------------------------------------------------------------- */
+
+struct m2t_type_pool_s {
+  /* capacity */ uint_t capacity;
+  /* used */ uint_t used;
+  /* shared */ uint_t shared;
+  /* slot */ m2t_type_pool_entry_s *slot;
+  /* garbage */ m2t_astnode_t *garbage;
+  /* garbage_count */ uint_t garbage_count;
+  /* garbage_capacity */ uint_t garbage_capacity;
+};
+
+typedef struct m2t_type_pool_s m2t_type_pool_s;
+
+
+/* --------------------------------------------------------------------------
+ * Forward declarations
+ * ----------------------------------------------------------------------- */
+
+static m2t_astnode_t intern_node (m2t_type_pool_t pool, m2t_astnode_t node);
+
+static inline bool is_opaque (m2t_astnode_t node);
+
+static inline bool is_terminal (m2t_astnode_t node);
+
+static inline const void *slot_key
+  (m2t_astnode_t node, uint_t index, bool terminal);
+
+static uint_t node_hash (m2t_astnode_t node, bool terminal);
+
+static bool same_structure
+  (m2t_astnode_t node1, m2t_astnode_t node2, bool terminal);
+
+static uint_t table_probe
+  (m2t_type_pool_t pool, m2t_astnode_t node, uint_t hash, bool terminal);
+
+static bool table_reserve (m2t_type_pool_t pool);
+
+static void collect_garbage (m2t_type_pool_t pool, m2t_astnode_t node);
+
+static void release_garbage (m2t_type_pool_t pool);
+
+static int compare_addresses (const void *node1, const void *node2);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_new_type_pool()
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated empty type pool, or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2t_type_pool_t m2t_new_type_pool (void) {
+  
+  m2t_type_pool_t new_pool;
+  
+  new_pool = malloc(sizeof(m2t_type_pool_s));
+  
+  if (new_pool == NULL) {
+    return NULL;
+  } /* end if */
+  
+  new_pool->slot =
+    calloc(M2T_TYPE_POOL_INIT_CAPACITY, sizeof(m2t_type_pool_entry_s));
+  
+  if (new_pool->slot == NULL) {
+    free(new_pool);
+    return NULL;
+  } /* end if */
+  
+  new_pool->capacity = M2T_TYPE_POOL_INIT_CAPACITY;
+  new_pool->used = 0;
+  new_pool->shared = 0;
+  
+  /* garbage list is allocated on first use */
+  new_pool->garbage = NULL;
+  new_pool->garbage_count = 0;
+  new_pool->garbage_capacity = 0;
+  
+  return new_pool;
+} /* end m2t_new_type_pool */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_type_pool_intern(pool, node)
+ * --------------------------------------------------------------------------
+ * Interns the subtree of node in pool and returns its shared node.  Nodes
+ * of the subtree for which pool holds a structurally identical node are
+ * replaced by that node and released, all other nodes are entered into
+ * pool.  Returns node unchanged if pool or node is NULL.  If the pool can
+ * not be grown, nodes are left unshared.
+ * ----------------------------------------------------------------------- */
+
+m2t_astnode_t m2t_type_pool_intern (m2t_type_pool_t pool, m2t_astnode_t node) {
+  
+  m2t_astnode_t shared_node;
+  
+  if ((pool == NULL) || (node == NULL)) {
+    return node;
+  } /* end if */
+  
+  shared_node = intern_node(pool, node);
+  
+  /* duplicates are unreachable now */
+  release_garbage(pool);
+  
+  return shared_node;
+} /* end m2t_type_pool_intern */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_type_pool_count(pool)
+ * --------------------------------------------------------------------------
+ * Returns the number of distinct nodes held in pool, or zero if pool is
+ * NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2t_type_pool_count (m2t_type_pool_t pool) {
+  
+  if (pool == NULL) {
+    return 0;
+  } /* end if */
+  
+  return pool->used;
+} /* end m2t_type_pool_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_type_pool_shared_count(pool)
+ * --------------------------------------------------------------------------
+ * Returns the number of nodes that have been replaced by a shared node of
+ * pool, or zero if pool is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2t_type_pool_shared_count (m2t_type_pool_t pool) {
+  
+  if (pool == NULL) {
+    return 0;
+  } /* end if */
+  
+  return pool->shared;
+} /* end m2t_type_pool_shared_count */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_release_type_pool(pool)
+ * --------------------------------------------------------------------------
+ * Releases the type pool passed in pool and passes back NULL in pool.
+ * The nodes held in the pool are not released.
+ * ----------------------------------------------------------------------- */
+
+void m2t_release_type_pool (m2t_type_pool_t *pool) {
+  
+  if ((pool == NULL) || (*pool == NULL)) {
+    return;
+  } /* end if */
+  
+  free((*pool)->garbage);
+  free((*pool)->slot);
+  free(*pool);
+  *pool = NULL;
+} /* end m2t_release_type_pool */
+
+
+/* ************************************************************************ *
+ * Private Functions                                                        *
+ * ************************************************************************ */
+
+/* --------------------------------------------------------------------------
+ * private function intern_node(pool, node)
+ * --------------------------------------------------------------------------
+ * Interns the subtree of node bottom-up and returns its shared node.  The
+ * subnodes of node are replaced by their shared nodes first, thus two
+ * nodes are structurally identical if their node types match and their
+ * subnodes or values are identical.  A duplicate of a pooled node is
+ * collected as garbage.
+ * ----------------------------------------------------------------------- */
+
+static m2t_astnode_t intern_node (m2t_type_pool_t pool, m2t_astnode_t node) {
+  
+  m2t_astnode_t subnode, shared_node;
+  uint_t index, count, hash, slot;
+  bool terminal;
+  
+  if ((node == NULL) || (is_opaque(node))) {
+    return node;
+  } /* end if */
+  
+  terminal = is_terminal(node);
+  
+  /* intern subnodes first */
+  if (NOT(terminal)) {
+    count = m2t_ast_subnode_count(node);
+    for (index = 0; index < count; index++) {
+      subnode = m2t_ast_subnode_for_index(node, index);
+      shared_node = intern_node(pool, subnode);
+      if (shared_node != subnode) {
+        m2t_ast_replace_subnode(node, index, shared_node);
+      } /* end if */
+    } /* end for */
+  } /* end if */
+  
+  if (NOT(table_reserve(pool))) {
+    return node;
+  } /* end if */
+  
+  hash = node_hash(node, terminal);
+  slot = table_probe(pool, node, hash, terminal);
+  
+  /* first occurrence */
+  if (pool->slot[slot].node == NULL) {
+    pool->slot[slot].node = node;
+    pool->slot[slot].hash = hash;
+    pool->used++;
+    return node;
+  } /* end if */
+  
+  shared_node = pool->slot[slot].node;
+  
+  /* duplicate */
+  if (shared_node != node) {
+    collect_garbage(pool, node);
+    pool->shared++;
+  } /* end if */
+  
+  return shared_node;
+} /* end intern_node */
+
+
+/* --------------------------------------------------------------------------
+ * private function is_opaque(node)
+ * --------------------------------------------------------------------------
+ * Returns true if node must not be interned, otherwise false.  Record and
+ * enumeration types declare entities of their own, the empty node is a
+ * singleton already.
+ * ----------------------------------------------------------------------- */
+
+static inline bool is_opaque (m2t_astnode_t node) {
+  
+  switch (m2t_ast_nodetype(node)) {
+    case AST_EMPTY :
+    case AST_ENUM :
+    case AST_RECORD :
+    case AST_EXTREC :
+    case AST_VRNTREC :
+      return true;
+    
+    default :
+      return false;
+  } /* end switch */
+} /* end is_opaque */
+
+
+/* --------------------------------------------------------------------------
+ * private function is_terminal(node)
+ * --------------------------------------------------------------------------
+ * Returns true if node is a terminal node, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+static inline bool is_terminal (m2t_astnode_t node) {
+  return ((m2t_ast_subnode_count(node) > 0) &&
+    (m2t_ast_value_for_index(node, 0) != NULL));
+} /* end is_terminal */
+
+
+/* --------------------------------------------------------------------------
+ * private function slot_key(node, index, terminal)
+ * --------------------------------------------------------------------------
+ * Returns the identity of the value or subnode at index of node.  Values
+ * are interned strings, their identity is therefore their content.
+ * ----------------------------------------------------------------------- */
+
+static inline const void *slot_key
+  (m2t_astnode_t node, uint_t index, bool terminal) {
+  
+  if (terminal) {
+    return (const void *) m2t_ast_value_for_index(node, index);
+  }
+  else /* non-terminal */ {
+    return (const void *) m2t_ast_subnode_for_index(node, index);
+  } /* end if */
+} /* end slot_key */
+
+
+/* --------------------------------------------------------------------------
+ * private function node_hash(node, terminal)
+ * --------------------------------------------------------------------------
+ * Returns the hash of the node type of node and the identities of its
+ * subnodes or values.
+ * ----------------------------------------------------------------------- */
+
+static uint_t node_hash (m2t_astnode_t node, bool terminal) {
+  
+  uint64_t hash;
+  uint_t index, count;
+  
+  count = m2t_ast_subnode_count(node);
+  hash = ((uint64_t) m2t_ast_nodetype(node) + 1) * 0x9E3779B97F4A7C15ULL;
+  
+  for (index = 0; index < count; index++) {
+    hash = (hash ^ (uint64_t) (uintptr_t) slot_key(node, index, terminal)) *
+      0x100000001B3ULL;
+  } /* end for */
+  
+  return (uint_t) (hash >> 32);
+} /* end node_hash */
+
+
+/* --------------------------------------------------------------------------
+ * private function same_structure(node1, node2, terminal)
+ * --------------------------------------------------------------------------
+ * Returns true if node1 and node2 are of the same node type and their
+ * subnodes or values are identical, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+static bool same_structure
+  (m2t_astnode_t node1, m2t_astnode_t node2, bool terminal) {
+  
+  uint_t index, count;
+  
+  if (node1 == node2) {
+    return true;
+  } /* end if */
+  
+  if (m2t_ast_nodetype(node1) != m2t_ast_nodetype(node2)) {
+    return false;
+  } /* end if */
+  
+  count = m2t_ast_subnode_count(node1);
+  
+  if (count != m2t_ast_subnode_count(node2)) {
+    return false;
+  } /* end if */
+  
+  for (index = 0; index < count; index++) {
+    if (slot_key(node1, index, terminal) !=
+        slot_key(node2, index, terminal)) {
+      return false;
+    } /* end if */
+  } /* end for */
+  
+  return true;
+} /* end same_structure */
+
+
+/* --------------------------------------------------------------------------
+ * private function table_probe(pool, node, hash, terminal)
+ * --------------------------------------------------------------------------
+ * Returns the slot of the node in pool that is structurally identical to
+ * node, or the empty slot where node would be stored if there is none.
+ * ----------------------------------------------------------------------- */
+
+static uint_t table_probe
+  (m2t_type_pool_t pool, m2t_astnode_t node, uint_t hash, bool terminal) {
+  
+  uint_t slot, mask;
+  
+  mask = pool->capacity - 1;
+  slot = hash & mask;
+  
+  while ((pool->slot[slot].node != NULL) &&
+         ((pool->slot[slot].hash != hash) ||
+          (NOT(same_structure(pool->slot[slot].node, node, terminal))))) {
+    slot = (slot + 1) & mask;
+  } /* end while */
+  
+  return slot;
+} /* end table_probe */
+
+
+/* --------------------------------------------------------------------------
+ * private function table_reserve(pool)
+ * --------------------------------------------------------------------------
+ * Makes room for one more node in pool, doubling its capacity if the
+ * maximum load would otherwise be exceeded.  Returns false if the pool
+ * needed to grow but could not be grown.
+ * ----------------------------------------------------------------------- */
+
+static bool table_reserve (m2t_type_pool_t pool) {
+  
+  m2t_type_pool_entry_s *old_slot;
+  uint_t old_capacity, slot, new_slot, mask;
+  
+  if (((pool->used + 1) * 100) <=
+      (pool->capacity * M2T_TYPE_POOL_MAX_LOAD_PERCENT)) {
+    return true;
+  } /* end if */
+  
+  old_slot = pool->slot;
+  old_capacity = pool->capacity;
+  
+  pool->slot = calloc(2 * old_capacity, sizeof(m2t_type_pool_entry_s));
+  
+  if (pool->slot == NULL) {
+    pool->slot = old_slot;
+    return false;
+  } /* end if */
+  
+  pool->capacity = 2 * old_capacity;
+  mask = pool->capacity - 1;
+  
+  /* rehash occupied slots, pooled nodes are distinct */
+  for (slot = 0; slot < old_capacity; slot++) {
+    if (old_slot[slot].node != NULL) {
+      new_slot = old_slot[slot].hash & mask;
+      while (pool->slot[new_slot].node != NULL) {
+        new_slot = (new_slot + 1) & mask;
+      } /* end while */
+      pool->slot[new_slot] = old_slot[slot];
+    } /* end if */
+  } /* end for */
+  
+  free(old_slot);
+  
+  return true;
+} /* end table_reserve */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure collect_garbage(pool, node)
+ * --------------------------------------------------------------------------
+ * Appends node to the garbage list of pool.  If the list can not be grown,
+ * node is not released.
+ * ----------------------------------------------------------------------- */
+
+static void collect_garbage (m2t_type_pool_t pool, m2t_astnode_t node) {
+  
+  m2t_astnode_t *new_garbage;
+  uint_t new_capacity;
+  
+  if (pool->garbage_count == pool->garbage_capacity) {
+    
+    if (pool->garbage_capacity == 0) {
+      new_capacity = M2T_TYPE_POOL_INIT_GARBAGE_CAPACITY;
+    }
+    else {
+      new_capacity = 2 * pool->garbage_capacity;
+    } /* end if */
+    
+    new_garbage =
+      realloc(pool->garbage, new_capacity * sizeof(m2t_astnode_t));
+    
+    if (new_garbage == NULL) {
+      return;
+    } /* end if */
+    
+    pool->garbage = new_garbage;
+    pool->garbage_capacity = new_capacity;
+  } /* end if */
+  
+  pool->garbage[pool->garbage_count] = node;
+  pool->garbage_count++;
+} /* end collect_garbage */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure release_garbage(pool)
+ * --------------------------------------------------------------------------
+ * Releases the nodes on the garbage list of pool and empties the list.
+ * The list is sorted by address and nodes are released from the top down,
+ * so that an arena can take back each node as the most recently allocated
+ * one.
+ * ----------------------------------------------------------------------- */
+
+static void release_garbage (m2t_type_pool_t pool) {
+  
+  if (pool->garbage_count > 1) {
+    qsort(pool->garbage, pool->garbage_count,
+      sizeof(m2t_astnode_t), compare_addresses);
+  } /* end if */
+  
+  while (pool->garbage_count > 0) {
+    pool->garbage_count--;
+    m2t_ast_release_node(pool->garbage[pool->garbage_count]);
+  } /* end while */
+} /* end release_garbage */
+
+
+/* --------------------------------------------------------------------------
+ * private function compare_addresses(node1, node2)
+ * --------------------------------------------------------------------------
+ * Comparison function for qsort() to sort nodes by ascending address.
+ * ----------------------------------------------------------------------- */
+
+static int compare_addresses (const void *node1, const void *node2) {
+  
+  uintptr_t addr1, addr2;
+  
+  addr1 = (uintptr_t) *(const m2t_astnode_t *) node1;
+  addr2 = (uintptr_t) *(const m2t_astnode_t *) node2;
+  
+  if (addr1 < addr2) {
+    return -1;
+  }
+  else if (addr1 > addr2) {
+    return 1;
+  }
+  else /* same node */ {
+    return 0;
+  } /* end if */
+} /* end compare_addresses */
+
+
+/* END OF FILE */
@@ -34,9 +34,78 @@
  */
 
 #include "m2-error.h"
+#include "m2-thread.h"
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <stddef.h>
+#include <stdarg.h>
+
+
+/* --------------------------------------------------------------------------
+ * Initial size of diagnostics buffer and size at which it is written
+ * ----------------------------------------------------------------------- */
+
+#define M2C_DIAGNOSTICS_INITIAL_SIZE 4096
+
+#define M2C_DIAGNOSTICS_FLUSH_THRESHOLD (64 * 1024)
+
+
+/* --------------------------------------------------------------------------
+ * private type m2c_diagnostics_t
+ * --------------------------------------------------------------------------
+ * record type holding the diagnostics buffer, error counts and settings.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* buffer */ char *buffer;
+  /* length */ size_t length;
+  /* size */ size_t size;
+  /* error_count */ uint_t error_count;
+  /* error_limit */ uint_t error_limit;
+  /* format */ m2c_diagnostic_format_t format;
+  /* exit_handler */ bool exit_handler;
+} m2c_diagnostics_t;
+
+
+/* --------------------------------------------------------------------------
+ * diagnostics state and its lock
+ * --------------------------------------------------------------------------
+ * Diagnostics may be emitted by a pipelined lexer thread and by the worker
+ * threads of batch translation.  The lock is statically initialised.
+ * ----------------------------------------------------------------------- */
+
+static m2c_diagnostics_t diagnostics = {
+  /* buffer */ NULL,
+  /* length */ 0,
+  /* size */ 0,
+  /* error_count */ 0,
+  /* error_limit */ 0,
+  /* format */ M2C_DIAGNOSTIC_FORMAT_TEXT,
+  /* exit_handler */ false
+}; /* diagnostics */
+
+static m2c_lock_t lock = M2C_LOCK_INITIALIZER;
+
+
+/* --------------------------------------------------------------------------
+ * Forward declarations
+ * ----------------------------------------------------------------------- */
+
+static bool begin_diagnostic
+  (bool is_error, m2c_error_t error, uint_t line, uint_t column);
+
+static void end_diagnostic (bool flush);
+
+static void emit (const char *format, ...);
+
+static void emit_symbol (m2c_token_t sym, const char *lexeme);
+
+static void emit_token_list (m2c_tokenset_t set);
+
+static void flush_buffer (void);
+
+static void flush_at_exit (void);
 
 
 /* --------------------------------------------------------------------------
@@ -82,6 +151,7 @@ static const char *m2c_error_text_array[] = {
   "semicolon at end of formal parameter list\0",
   "semicolon at end of statement sequence\0",
   "empty statement sequence\0",
+  "duplicate or overlapping case label\0",
   "Y\0",
   
   /* Semantic Errors */
@@ -164,6 +234,104 @@ const char *m2c_error_text (m2c_error_t error) {
 } /* end m2c_error_text */
 
 
+/* --------------------------------------------------------------------------
+ * procedure m2c_set_error_limit(limit)
+ * --------------------------------------------------------------------------
+ * Sets the maximum number of errors to be emitted, zero means no limit.
+ * ----------------------------------------------------------------------- */
+
+void m2c_set_error_limit (uint_t limit) {
+  
+  M2C_LOCK_ACQUIRE(&lock);
+  diagnostics.error_limit = limit;
+  M2C_LOCK_RELEASE(&lock);
+  
+} /* end m2c_set_error_limit */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_error_count()
+ * --------------------------------------------------------------------------
+ * Returns the number of errors emitted or suppressed so far.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_error_count (void) {
+  
+  uint_t count;
+  
+  M2C_LOCK_ACQUIRE(&lock);
+  count = diagnostics.error_count;
+  M2C_LOCK_RELEASE(&lock);
+  
+  return count;
+} /* end m2c_error_count */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_reset_error_count()
+ * --------------------------------------------------------------------------
+ * Resets the number of errors emitted or suppressed so far to zero, so that
+ * the error limit applies afresh.  Must not race with any emitting call.
+ * ----------------------------------------------------------------------- */
+
+void m2c_reset_error_count (void) {
+  
+  M2C_LOCK_ACQUIRE(&lock);
+  diagnostics.error_count = 0;
+  M2C_LOCK_RELEASE(&lock);
+  
+} /* end m2c_reset_error_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_error_limit_reached()
+ * --------------------------------------------------------------------------
+ * Returns true if an error limit has been set and reached, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_error_limit_reached (void) {
+  
+  bool reached;
+  
+  M2C_LOCK_ACQUIRE(&lock);
+  reached = (diagnostics.error_limit > 0) &&
+    (diagnostics.error_count >= diagnostics.error_limit);
+  M2C_LOCK_RELEASE(&lock);
+  
+  return reached;
+} /* end m2c_error_limit_reached */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_set_diagnostic_format(format)
+ * --------------------------------------------------------------------------
+ * Sets the output format of diagnostics.
+ * ----------------------------------------------------------------------- */
+
+void m2c_set_diagnostic_format (m2c_diagnostic_format_t format) {
+  
+  M2C_LOCK_ACQUIRE(&lock);
+  diagnostics.format = format;
+  M2C_LOCK_RELEASE(&lock);
+  
+} /* end m2c_set_diagnostic_format */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_flush_diagnostics()
+ * --------------------------------------------------------------------------
+ * Writes any buffered diagnostics to the console.
+ * ----------------------------------------------------------------------- */
+
+void m2c_flush_diagnostics (void) {
+  
+  M2C_LOCK_ACQUIRE(&lock);
+  flush_buffer();
+  M2C_LOCK_RELEASE(&lock);
+  
+} /* end m2c_flush_diagnostics */
+
+
 /* --------------------------------------------------------------------------
  * procedure m2c_emit_error(error)
  * --------------------------------------------------------------------------
@@ -172,8 +340,9 @@ const char *m2c_error_text (m2c_error_t error) {
  */
 
 void m2c_emit_error (m2c_error_t error) {
-  if (error < ERROR_END_MARK) {
-      printf("%s\n", m2c_error_text_array[error]);
+  if ((error < ERROR_END_MARK) && (begin_diagnostic(true, error, 0, 0))) {
+    emit("%s\n", m2c_error_text_array[error]);
+    end_diagnostic(true);
   } /* end if */
 } /* end m2c_emit_error */
 
@@ -186,8 +355,9 @@ void m2c_emit_error (m2c_error_t error) {
  */
 
 void m2c_emit_error_w_str (m2c_error_t error, const char *offending_str) {
-  if (error < ERROR_END_MARK) {
-      printf("%s: %s\n", m2c_error_text_array[error], offending_str);
+  if ((error < ERROR_END_MARK) && (begin_diagnostic(true, error, 0, 0))) {
+    emit("%s: %s\n", m2c_error_text_array[error], offending_str);
+    end_diagnostic(true);
   } /* end if */
 } /* end m2c_emit_error_w_str */
 
@@ -201,9 +371,13 @@ void m2c_emit_error_w_str (m2c_error_t error, const char *offending_str) {
 
 void m2c_emit_error_w_pos
   (m2c_error_t error, uint_t line, uint_t column) {
-  if (error < ERROR_END_MARK) {
-    printf("line %u, column %u, error: %s\n",
-      line, column, m2c_error_text_array[error]);
+  if ((error < ERROR_END_MARK) &&
+      (begin_diagnostic(true, error, line, column))) {
+    if (diagnostics.format == M2C_DIAGNOSTIC_FORMAT_TEXT) {
+      emit("line %u, column %u, error: ", line, column);
+    } /* end if */
+    emit("%s\n", m2c_error_text_array[error]);
+    end_diagnostic(false);
   } /* end if */
 } /* end m2c_emit_error_w_pos */
 
@@ -220,15 +394,19 @@ void m2c_emit_error_w_pos
 
 void m2c_emit_error_w_chr
   (m2c_error_t error, uint_t line, uint_t column, char offending_chr) {
-  if (error < ERROR_END_MARK) {
-    printf("line: %u, column: %u, %s",
-      line, column, m2c_error_text_array[error]);
+  if ((error < ERROR_END_MARK) &&
+      (begin_diagnostic(true, error, line, column))) {
+    if (diagnostics.format == M2C_DIAGNOSTIC_FORMAT_TEXT) {
+      emit("line: %u, column: %u, ", line, column);
+    } /* end if */
+    emit("%s", m2c_error_text_array[error]);
     if (IS_PRINTABLE(offending_chr)) {
-      printf(", offending character: '%c'\n", offending_chr);
+      emit(", offending character: '%c'\n", offending_chr);
     }
     else /* non-printable */ {
-      printf(", offending character code: 0u%X\n", offending_chr);
+      emit(", offending character code: 0u%X\n", offending_chr);
     } /* end if */
+    end_diagnostic(false);
   } /* end if */
 } /* end m2c_emit_error_w_chr */
 
@@ -243,15 +421,19 @@ void m2c_emit_error_w_chr
 void m2c_emit_error_w_lex
   (m2c_error_t error,
    uint_t line, uint_t column, const char *offending_lex) {
-  if (error < ERROR_END_MARK) {
-    printf("line: %u, column: %u, %s",
-      line, column, m2c_error_text_array[error]);
+  if ((error < ERROR_END_MARK) &&
+      (begin_diagnostic(true, error, line, column))) {
+    if (diagnostics.format == M2C_DIAGNOSTIC_FORMAT_TEXT) {
+      emit("line: %u, column: %u, ", line, column);
+    } /* end if */
+    emit("%s", m2c_error_text_array[error]);
     if (offending_lex != NULL) {
-      printf(", offending lexeme: %s\n", offending_lex);
+      emit(", offending lexeme: %s\n", offending_lex);
     }
     else {
-      printf(", offending lexeme: (null)\n");
+      emit(", offending lexeme: (null)\n");
     } /* end if */
+    end_diagnostic(false);
   } /* end if */
 } /* end m2c_emit_error_w_lex */
 
@@ -270,51 +452,45 @@ void m2c_emit_syntax_error_w_token
    const char *offending_lex,
    m2c_token_t expected_token) {
   
+  if (!begin_diagnostic(true, M2C_ERROR_UNEXPECTED_TOKEN, line, column)) {
+    return;
+  } /* end if */
+  
   /* print line and column */
-  printf("line %u, column %u, error: unexpected ", line, column);
+  if (diagnostics.format == M2C_DIAGNOSTIC_FORMAT_TEXT) {
+    emit("line %u, column %u, error: ", line, column);
+  } /* end if */
   
   /* print offending symbol and its lexeme */
-  if (offending_sym == TOKEN_IDENTIFIER) {
-    printf("identifier '%s'", offending_lex);
-  }
-  else if (m2c_is_literal_token(offending_sym)) {
-    printf("literal <<%s>>", offending_lex);
-  }
-  else if (m2c_is_resword_token(offending_sym)) {
-    printf("reserved word %s", m2c_lexeme_for_resword(offending_sym));
-  }
-  else if (m2c_is_special_symbol_token(offending_sym)) {
-    printf("symbol '%s'", m2c_lexeme_for_special_symbol(offending_sym));
-  }
-  else if (offending_sym == TOKEN_END_OF_FILE) {
-    printf("end of file");
-  }
-  else {
-    printf("unknown token");
-  } /* end if */
-
-  printf(" found\n");
+  emit("unexpected ");
+  emit_symbol(offending_sym, offending_lex);
   
   /* print name of expected token */
-  printf("  expected ");
+  if (diagnostics.format == M2C_DIAGNOSTIC_FORMAT_TEXT) {
+    emit(" found\n  expected ");
+  }
+  else /* machine readable */ {
+    emit(" found, expected ");
+  } /* end if */
   
   if (expected_token == TOKEN_IDENTIFIER) {
-    printf("identifier");
+    emit("identifier");
   }
   else if (m2c_is_literal_token(expected_token)) {
-    printf("integer, real number, character code or string literal");
+    emit("integer, real number, character code or string literal");
   }
   else if (m2c_is_resword_token(expected_token)) {
-    printf("reserved word %s", m2c_lexeme_for_resword(expected_token));
+    emit("reserved word %s", m2c_lexeme_for_resword(expected_token));
   }
   else if (m2c_is_special_symbol_token(expected_token)) {
-    printf("symbol '%s'", m2c_lexeme_for_special_symbol(expected_token));
+    emit("symbol '%s'", m2c_lexeme_for_special_symbol(expected_token));
   }
   else if (expected_token == TOKEN_END_OF_FILE) {
-    printf("end of file");
+    emit("end of file");
   } /* end if */
   
-  printf("\n");
+  emit("\n");
+  end_diagnostic(false);
   
 } /* end m2c_emit_syntax_error_w_token */
 
@@ -333,34 +509,29 @@ void m2c_emit_syntax_error_w_set
    const char *offending_lex,
    m2c_tokenset_t expected_set) {
   
+  if (!begin_diagnostic(true, M2C_ERROR_UNEXPECTED_TOKEN, line, column)) {
+    return;
+  } /* end if */
+  
   /* print line and column */
-  printf("line %u, column %u, error: unexpected ", line, column);
+  if (diagnostics.format == M2C_DIAGNOSTIC_FORMAT_TEXT) {
+    emit("line %u, column %u, error: ", line, column);
+  } /* end if */
   
   /* print offending symbol and its lexeme */
-  if (offending_sym == TOKEN_IDENTIFIER) {
-    printf("identifier '%s'", offending_lex);
-  }
-  else if (m2c_is_literal_token(offending_sym)) {
-    printf("literal <<%s>>", offending_lex);
-  }
-  else if (m2c_is_resword_token(offending_sym)) {
-    printf("reserved word %s", m2c_lexeme_for_resword(offending_sym));
-  }
-  else if (m2c_is_special_symbol_token(offending_sym)) {
-    printf("symbol '%s'", m2c_lexeme_for_special_symbol(offending_sym));
-  }
-  else if (offending_sym == TOKEN_END_OF_FILE) {
-    printf("end of file");
+  emit("unexpected ");
+  emit_symbol(offending_sym, offending_lex);
+  
+  /* print list of expected symbols */
+  if (diagnostics.format == M2C_DIAGNOSTIC_FORMAT_TEXT) {
+    emit(" found\n  expected ");
   }
-  else {
-    printf("unknown token");
+  else /* machine readable */ {
+    emit(" found, expected ");
   } /* end if */
-
-  printf(" found\n");
   
-  /* print list of expected symbols */
-  printf("  expected ");
-  m2c_tokenset_print_list(expected_set);
+  emit_token_list(expected_set);
+  end_diagnostic(false);
   
 } /* end m2c_emit_syntax_error_w_set */
 
@@ -373,9 +544,13 @@ void m2c_emit_syntax_error_w_set
 
 void m2c_emit_warning_w_pos
   (m2c_error_t error, uint_t line, uint_t column) {
-  if (error < ERROR_END_MARK) {
-    printf("line %u, column %u, warning: %s\n",
-      line, column, m2c_error_text_array[error]);
+  if ((error < ERROR_END_MARK) &&
+      (begin_diagnostic(false, error, line, column))) {
+    if (diagnostics.format == M2C_DIAGNOSTIC_FORMAT_TEXT) {
+      emit("line %u, column %u, warning: ", line, column);
+    } /* end if */
+    emit("%s\n", m2c_error_text_array[error]);
+    end_diagnostic(false);
   } /* end if */
 } /* end m2c_emit_error_w_pos */
 
@@ -388,10 +563,269 @@ void m2c_emit_warning_w_pos
 
 void m2c_emit_warning_w_range
   (m2c_error_t error, uint_t first_line, uint_t last_line) {
-  if (error < ERROR_END_MARK) {
-    printf("line %u to line %u, warning: %s\n",
-      first_line, last_line, m2c_error_text_array[error]);
+  if ((error < ERROR_END_MARK) &&
+      (begin_diagnostic(false, error, first_line, 0))) {
+    if (diagnostics.format == M2C_DIAGNOSTIC_FORMAT_TEXT) {
+      emit("line %u to line %u, warning: ", first_line, last_line);
+    } /* end if */
+    emit("%s\n", m2c_error_text_array[error]);
+    end_diagnostic(false);
   } /* end if */
 } /* end m2c_emit_warning_w_range */
 
+
+/* --------------------------------------------------------------------------
+ * Private Functions
+ * ----------------------------------------------------------------------- */
+
+/* --------------------------------------------------------------------------
+ * private function begin_diagnostic(is_error, error, line, column)
+ * --------------------------------------------------------------------------
+ * Acquires the lock and counts the diagnostic.  Returns true if it is to be
+ * emitted, otherwise releases the lock and returns false.  Errors beyond
+ * the error limit are not emitted, the first of them emits a note instead.
+ * In the machine readable format, emits the position, kind and code.
+ * ----------------------------------------------------------------------- */
+
+static bool begin_diagnostic
+  (bool is_error, m2c_error_t error, uint_t line, uint_t column) {
+  
+  M2C_LOCK_ACQUIRE(&lock);
+  
+  if (is_error) {
+    diagnostics.error_count++;
+    
+    if ((diagnostics.error_limit > 0) &&
+        (diagnostics.error_count > diagnostics.error_limit)) {
+      
+      if (diagnostics.error_count == diagnostics.error_limit + 1) {
+        if (diagnostics.format == M2C_DIAGNOSTIC_FORMAT_TEXT) {
+          emit("error limit of %u reached, further errors suppressed\n",
+            diagnostics.error_limit);
+        }
+        else /* machine readable */ {
+          emit("0:0:note:0:error limit of %u reached\n",
+            diagnostics.error_limit);
+        } /* end if */
+      } /* end if */
+      
+      M2C_LOCK_RELEASE(&lock);
+      return false;
+    } /* end if */
+  } /* end if */
+  
+  if (diagnostics.format == M2C_DIAGNOSTIC_FORMAT_MACHINE) {
+    emit("%u:%u:%s:%u:",
+      line, column, (is_error ? "error" : "warning"), (uint_t) error);
+  } /* end if */
+  
+  return true;
+} /* end begin_diagnostic */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure end_diagnostic(flush)
+ * --------------------------------------------------------------------------
+ * Writes the buffer if flush is true or if it has reached the threshold,
+ * then releases the lock.
+ * ----------------------------------------------------------------------- */
+
+static void end_diagnostic (bool flush) {
+  
+  if ((flush) || (diagnostics.length >= M2C_DIAGNOSTICS_FLUSH_THRESHOLD)) {
+    flush_buffer();
+  } /* end if */
+  
+  M2C_LOCK_RELEASE(&lock);
+  
+} /* end end_diagnostic */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure emit(format, ...)
+ * --------------------------------------------------------------------------
+ * Appends formatted text to the buffer, growing the buffer as needed.  If
+ * the buffer cannot be grown, buffered text is written and the formatted
+ * text is written directly.  The lock must be held.
+ * ----------------------------------------------------------------------- */
+
+static void emit (const char *format, ...) {
+  
+  va_list args;
+  size_t new_size;
+  char *new_buffer;
+  int length;
+  
+  /* format into the remaining space of the buffer */
+  va_start(args, format);
+  length = vsnprintf(diagnostics.buffer + diagnostics.length,
+    diagnostics.size - diagnostics.length, format, args);
+  va_end(args);
+  
+  if (length < 0) {
+    return;
+  } /* end if */
+  
+  /* grow buffer and format again if it did not fit */
+  if (diagnostics.length + length >= diagnostics.size) {
+    new_size = (diagnostics.size == 0) ?
+      M2C_DIAGNOSTICS_INITIAL_SIZE : diagnostics.size;
+    while (diagnostics.length + length >= new_size) {
+      new_size = 2 * new_size;
+    } /* end while */
+    
+    new_buffer = realloc(diagnostics.buffer, new_size);
+    
+    if (new_buffer == NULL) {
+      flush_buffer();
+      va_start(args, format);
+      vprintf(format, args);
+      va_end(args);
+      return;
+    } /* end if */
+    
+    /* write buffered diagnostics on exit */
+    if (!diagnostics.exit_handler) {
+      diagnostics.exit_handler = (atexit(flush_at_exit) == 0);
+    } /* end if */
+    
+    diagnostics.buffer = new_buffer;
+    diagnostics.size = new_size;
+    
+    va_start(args, format);
+    vsnprintf(diagnostics.buffer + diagnostics.length,
+      diagnostics.size - diagnostics.length, format, args);
+    va_end(args);
+  } /* end if */
+  
+  diagnostics.length = diagnostics.length + length;
+  
+} /* end emit */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure emit_symbol(sym, lexeme)
+ * --------------------------------------------------------------------------
+ * Appends a description of symbol sym with lexeme to the buffer.
+ * ----------------------------------------------------------------------- */
+
+static void emit_symbol (m2c_token_t sym, const char *lexeme) {
+  
+  if (sym == TOKEN_IDENTIFIER) {
+    emit("identifier '%s'", lexeme);
+  }
+  else if (m2c_is_literal_token(sym)) {
+    emit("literal <<%s>>", lexeme);
+  }
+  else if (m2c_is_resword_token(sym)) {
+    emit("reserved word %s", m2c_lexeme_for_resword(sym));
+  }
+  else if (m2c_is_special_symbol_token(sym)) {
+    emit("symbol '%s'", m2c_lexeme_for_special_symbol(sym));
+  }
+  else if (sym == TOKEN_END_OF_FILE) {
+    emit("end of file");
+  }
+  else {
+    emit("unknown token");
+  } /* end if */
+  
+} /* end emit_symbol */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure emit_token_list(set)
+ * --------------------------------------------------------------------------
+ * Appends a human readable list of the symbols in set to the buffer.
+ * Format: first, second, third, ..., secondToLast or last
+ * ----------------------------------------------------------------------- */
+
+static void emit_token_list (m2c_tokenset_t set) {
+  
+  uint_t count, elem_count;
+  m2c_token_t token;
+  
+  elem_count = m2c_tokenset_element_count(set);
+  
+  if (elem_count == 0) {
+    emit("(nil)");
+  } /* end if */
+  
+  count = 0;
+  token = 0;
+  while ((count <= elem_count) && (token < TOKEN_END_MARK)) {
+    
+    if (m2c_tokenset_element(set, token)) {
+      count++;
+      if (count > 1) {
+        if (count < elem_count) {
+          emit(", ");
+        }
+        else {
+          emit(" or ");
+        } /* end if */
+      } /* end if */
+      
+      if (token == TOKEN_IDENTIFIER) {
+        emit("identifier");
+      }
+      else if (token == TOKEN_STRING) {
+        emit("string");
+      }
+      else if (token == TOKEN_INTEGER) {
+        emit("integer");
+      }
+      else if (token == TOKEN_REAL) {
+        emit("real number");
+      }
+      else if (token == TOKEN_CHAR) {
+        emit("character code");
+      }
+      else if (m2c_is_resword_token(token)) {
+        emit("%s", m2c_lexeme_for_resword(token));
+      }
+      else if (m2c_is_special_symbol_token(token)) {
+        emit("'%s'", m2c_lexeme_for_special_symbol(token));
+      }
+      else if (token == TOKEN_END_OF_FILE) {
+        emit("<EOF>");
+      } /* end if */
+    } /* end if */
+    token++;
+  } /* end while */
+  
+  emit(".\n");
+} /* end emit_token_list */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure flush_buffer()
+ * --------------------------------------------------------------------------
+ * Writes the buffer to the console in a single write.  The lock must be
+ * held.
+ * ----------------------------------------------------------------------- */
+
+static void flush_buffer (void) {
+  
+  if (diagnostics.length > 0) {
+    fwrite(diagnostics.buffer, 1, diagnostics.length, stdout);
+    fflush(stdout);
+    diagnostics.length = 0;
+  } /* end if */
+  
+} /* end flush_buffer */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure flush_at_exit()
+ * --------------------------------------------------------------------------
+ * Exit handler, writes any buffered diagnostics.
+ * ----------------------------------------------------------------------- */
+
+static void flush_at_exit (void) {
+  
+  m2c_flush_diagnostics();
+  
+} /* end flush_at_exit */
+
 /* END OF FILE */
\ No newline at end of file
@@ -33,31 +33,203 @@
  * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
  */
 
+/* fseeko(), ftello() and a 64-bit off_t are not part of ISO C99 */
+#define _FILE_OFFSET_BITS 64
+#if !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
 #include "m2-filereader.h"
 #include "m2-common.h"
-#include "m2-fileutils.h"
+#include "fileutils.h"
+#include "m2-trace-probes.h"
 
 #include <stdio.h>
 #include <errno.h>
 #include <stdlib.h>
 #include <stddef.h>
+#include <stdint.h>
+#include <limits.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/types.h>
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * Initial and maximum capacity of line table
+ * --------------------------------------------------------------------------
+ * The line table records the start of every line until it reaches its
+ * maximum capacity, it then records the start of every second line, then
+ * of every fourth line, and so on.  Its size is thus bounded regardless of
+ * the number of lines in a source file.
+ * ----------------------------------------------------------------------- */
+
+#define M2C_INFILE_LINE_TABLE_INITIAL_SIZE 256
+
+#define M2C_INFILE_LINE_TABLE_MAX_SIZE (64 * 1024)
+
+
+/* --------------------------------------------------------------------------
+ * Size of probe buffer for out-of-window access in streaming mode
+ * ----------------------------------------------------------------------- */
+
+#define M2C_INFILE_PROBE_SIZE 512
+
+
+/* --------------------------------------------------------------------------
+ * Size of sliding window in streaming mode
+ * ----------------------------------------------------------------------- */
+
+#define M2C_INFILE_WINDOW_SIZE \
+  (M2C_INFILE_STREAM_CHUNK_SIZE * M2C_INFILE_STREAM_CHUNK_COUNT)
+
+
+/* --------------------------------------------------------------------------
+ * Source access macros
+ * ----------------------------------------------------------------------- */
+
+/* character at absolute offset, offset must lie within the window */
+#define SRC(_infile, _offset) \
+  ((_infile)->source[(_offset) - (_infile)->base])
+
+/* refill window if up to two lookahead characters are not loaded */
+#define ENSURE_LOOKAHEAD(_infile) \
+  if (((_infile)->index + 3 > (_infile)->window_end) && \
+      ((_infile)->window_end < (_infile)->buflen)) { \
+    refill_window(_infile); \
+  } /* end if */
+
+
+/* --------------------------------------------------------------------------
+ * Vector primitives for bulk scanning of character runs
+ * --------------------------------------------------------------------------
+ * Each comparison yields a bit mask with one bit per byte of a vector,
+ * bit 0 corresponding to the byte at the lowest address.  Without vector
+ * support, or with compilers lacking the GCC bit scan builtins, character
+ * runs are scanned by a scalar loop only.
+ * ----------------------------------------------------------------------- */
+
+#if defined(__GNUC__) && defined(__AVX2__)
+#include <immintrin.h>
+#define M2C_INFILE_SIMD 1
+#define VEC_WIDTH 32
+typedef __m256i vec_t;
+#define VEC_LOAD(_p) _mm256_loadu_si256((const __m256i *) (_p))
+#define VEC_SPLAT(_c) _mm256_set1_epi8(_c)
+#define VEC_EQ(_a,_b) \
+  ((uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8((_a), (_b))))
+#define VEC_GT(_a,_b) \
+  ((uint32_t) _mm256_movemask_epi8(_mm256_cmpgt_epi8((_a), (_b))))
+
+#elif defined(__GNUC__) && defined(__SSE2__)
+#include <emmintrin.h>
+#define M2C_INFILE_SIMD 1
+#define VEC_WIDTH 16
+typedef __m128i vec_t;
+#define VEC_LOAD(_p) _mm_loadu_si128((const __m128i *) (_p))
+#define VEC_SPLAT(_c) _mm_set1_epi8(_c)
+#define VEC_EQ(_a,_b) \
+  ((uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8((_a), (_b))))
+#define VEC_GT(_a,_b) \
+  ((uint32_t) _mm_movemask_epi8(_mm_cmpgt_epi8((_a), (_b))))
+
+#elif defined(__GNUC__) && defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define M2C_INFILE_SIMD 1
+#define VEC_WIDTH 16
+typedef int8x16_t vec_t;
+#define VEC_LOAD(_p) vld1q_s8((const int8_t *) (_p))
+#define VEC_SPLAT(_c) vdupq_n_s8(_c)
+#define VEC_EQ(_a,_b) neon_movemask(vceqq_s8((_a), (_b)))
+#define VEC_GT(_a,_b) neon_movemask(vcgtq_s8((_a), (_b)))
+
+static inline uint32_t neon_movemask (uint8x16_t cmp) {
+  static const uint8_t weight[16] =
+    { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+  uint8x16_t bits;
+  
+  bits = vandq_u8(cmp, vld1q_u8(weight));
+  return (uint32_t) vaddv_u8(vget_low_u8(bits)) |
+    ((uint32_t) vaddv_u8(vget_high_u8(bits)) << 8);
+} /* end neon_movemask */
+#endif
+
+#if defined(M2C_INFILE_SIMD)
+#define VEC_ALL_BITS \
+  ((VEC_WIDTH == 32) ? 0xFFFFFFFFu : ((1u << VEC_WIDTH) - 1))
+#endif
 
 
 /* --------------------------------------------------------------------------
  * private type m2c_infile_struct_t
  * --------------------------------------------------------------------------
  * record type representing a Modula-2 source file.
+ *
+ * Field source points to the file's contents.  For files smaller than
+ * M2C_INFILE_MMAP_THRESHOLD it points to the trailing buffer of the record,
+ * for larger files it points to a read-only memory mapping of the file.
+ * In the latter case field file is NULL and field buffer is not allocated.
+ * For infiles opened on a caller owned buffer, field source points to that
+ * buffer, field file is NULL and field mapped is false.
+ *
+ * For files of M2C_INFILE_STREAM_THRESHOLD and larger, field streaming is
+ * set and the trailing buffer holds a sliding window of the file that is
+ * refilled chunk by chunk as the reader advances.  Field base holds the
+ * file offset of the first byte in the window, field window_end the file
+ * offset following the last byte in the window.  When not streaming, base
+ * is zero and window_end is equal to buflen.  All offsets are file offsets.
+ * Bytes outside of the window are retrieved through the probe buffer.
+ *
+ * While field marker_hashed is set, every character consumed after the
+ * marker is added to the hash calculation in field lexeme_hash, thus the
+ * marked lexeme is hashed while it is scanned.  The flag is cleared when
+ * a consumed character is not permitted in an interned string.
+ *
+ * Field line_count holds the number of lines whose start offsets have been
+ * determined, field line_start the start offset of the last of these.  The
+ * line table holds the start offset of every line_stride-th line up to
+ * line_count, starting with line 1, in its first line_entries entries.
+ * Starts of lines in between are found by scanning forward from the nearest
+ * entry.
+ * The table is filled lazily as the reader advances past line breaks, and
+ * on demand when the source of a line beyond line_count is requested.
+ *
+ * Field validated is set if the source has been verified at open to hold
+ * printable ASCII characters, TAB, LF and CR only, field has_cr if it holds
+ * any CR.  Field unchecked is set if the source is validated, free of CR and
+ * held in the trailing buffer, whose terminating NUL then serves as end of
+ * file sentinel.  Characters are read without bounds and CR checks then.
  * ----------------------------------------------------------------------- */
 
 struct m2c_infile_struct_t {
   /* file */            FILE *file;
+  /* mapped */          bool mapped;
+  /* streaming */       bool streaming;
+  /* source */          const char *source;
+  /* base */            size_t base;
+  /* window_end */      size_t window_end;
   /* filename */        m2c_string_t filename;
   /* index */           size_t index;
   /* line */            uint_t line;
-  /* column */          uint_t column;
   /* marker_set */      bool marker_set;
   /* marker_index */    size_t marked_index;
+  /* marker_evicted */  bool marker_evicted;
+  /* marker_hashed */   bool marker_hashed;
+  /* lexeme_hash */     m2c_string_hasher_t lexeme_hash;
   /* status */          m2c_infile_status_t status;
+  /* line_count */      uint_t line_count;
+  /* line_start */      size_t line_start;
+  /* line_stride */     uint_t line_stride;
+  /* line_entries */    uint_t line_entries;
+  /* line_table_size */ uint_t line_table_size;
+  /* line_table */      size_t *line_table;
+  /* probe_base */      size_t probe_base;
+  /* probe_len */       size_t probe_len;
+  /* probe */           char *probe;
+  /* validated */       bool validated;
+  /* has_cr */          bool has_cr;
+  /* unchecked */       bool unchecked;
   /* buflen */          size_t buflen;
   /* buffer */          char buffer[];
 };
@@ -65,6 +237,39 @@ struct m2c_infile_struct_t {
 typedef struct m2c_infile_struct_t m2c_infile_struct_t;
 
 
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static bool file_size (FILE *file, uintmax_t *size);
+
+static bool seek_offset (FILE *file, size_t offset);
+
+static void refill_window (m2c_infile_t infile);
+
+static int byte_at (m2c_infile_t infile, size_t offset);
+
+static bool read_at
+  (m2c_infile_t infile, size_t offset, size_t length, char *target);
+
+static size_t scan_run
+  (m2c_infile_t infile, size_t length, m2c_infile_run_t run, char delimiter);
+
+static bool is_run_char (char ch, m2c_infile_run_t run, char delimiter);
+
+static void add_line_start (m2c_infile_t infile, size_t index);
+
+static void thin_line_table (m2c_infile_t infile);
+
+static bool next_line_start (m2c_infile_t infile, size_t *index);
+
+static bool extend_line_table (m2c_infile_t infile);
+
+static bool index_for_line (m2c_infile_t infile, uint_t line, size_t *index);
+
+static void validate_source (m2c_infile_t infile);
+
+
 /* --------------------------------------------------------------------------
  * procedure m2c_open_infile(infile, filename, status)
  * --------------------------------------------------------------------------
@@ -77,7 +282,7 @@ typedef struct m2c_infile_struct_t m2c_infile_struct_t;
  *
  * post-conditions:
  * o  pointer to newly allocated and opened file is passed back in infile
- * o  line and column counters of the newly allocated infile are set to 1
+ * o  line counter of the newly allocated infile is set to 1
  * o  M2C_INFILE_STATUS_SUCCESS is passed back in status, unless NULL
  *
  * error-conditions:
@@ -92,12 +297,12 @@ typedef struct m2c_infile_struct_t m2c_infile_struct_t;
  * --------------------------------------------------------------------------
  */
 
-/* TO DO : Check for file size limit */
-
 m2c_infile_t m2c_open_infile
   (m2c_string_t filename, m2c_infile_status_t *status) {
   
-  FILE *file; size_t size;
+  FILE *file; uintmax_t filesize;
+  const char *path, *mapping;
+  size_t size, mapsize;
   m2c_infile_t new_infile;
   
   /* check pre-conditions */
@@ -106,8 +311,10 @@ m2c_infile_t m2c_open_infile
     return NULL;
   } /* end if */
   
-  /* open file */
-  file = fopen(m2c_string_char_ptr(filename), "r");
+  path = m2c_string_char_ptr(filename);
+  
+  /* open file, line endings are handled by the reader itself */
+  file = fopen(path, "rb");
   
   /* if operation failed, pass back status and return */
   if (file == NULL) {
@@ -130,49 +337,291 @@ m2c_infile_t m2c_open_infile
     return NULL;
   } /* end if */
   
-  /* allocate new infile */
-  size = filesize(m2c_string_char_ptr(filename));
-  new_infile = malloc(sizeof(m2c_infile_struct_t) + size + 1);
+  /* determine file size, only regular files may be read */
+  if ((is_regular_file(path) == false) ||
+      (file_size(file, &filesize) == false)) {
+    fclose(file);
+    
+    SET_STATUS(status, M2C_INFILE_STATUS_IO_SUBSYSTEM_ERROR);
+    return NULL;
+  } /* end if */
   
-  /* if allocation failed, close file, pass status and return */
-  if (new_infile == NULL) {
+  /* offsets into the file must be representable */
+  if (filesize > (uintmax_t) SIZE_MAX) {
     fclose(file);
     
-    SET_STATUS(status, M2C_INFILE_STATUS_ALLOCATION_FAILED);    
+    SET_STATUS(status, M2C_INFILE_STATUS_FILE_TOO_LARGE);
     return NULL;
   } /* end if */
   
-  /* read file contents into buffer */
-  new_infile->buflen = fread(&new_infile->buffer, sizeof(char), size, file);
+  size = (size_t) filesize;
+  
+  /* if file is very large, stream it through a sliding window */
+  if (size >= M2C_INFILE_STREAM_THRESHOLD) {
+    
+    /* allocate new infile with window */
+    new_infile = malloc(sizeof(m2c_infile_struct_t) + M2C_INFILE_WINDOW_SIZE);
+    
+    /* if allocation failed, close file, pass status and return */
+    if (new_infile == NULL) {
+      fclose(file);
+      
+      SET_STATUS(status, M2C_INFILE_STATUS_ALLOCATION_FAILED);
+      return NULL;
+    } /* end if */
+    
+    new_infile->probe = malloc(M2C_INFILE_PROBE_SIZE);
+    
+    if (new_infile->probe == NULL) {
+      free(new_infile);
+      fclose(file);
+      
+      SET_STATUS(status, M2C_INFILE_STATUS_ALLOCATION_FAILED);
+      return NULL;
+    } /* end if */
+    
+    new_infile->file = file;
+    new_infile->mapped = false;
+    new_infile->streaming = true;
+    new_infile->source = new_infile->buffer;
+    new_infile->buflen = size;
+    new_infile->index = 0;
+    new_infile->marker_set = false;
+    
+    /* load first chunks */
+    new_infile->base = 0;
+    new_infile->window_end = 0;
+    refill_window(new_infile);
+  }
+  /* if file is large, try to map it into memory */
+  else if ((size >= M2C_INFILE_MMAP_THRESHOLD) &&
+      (map_file(path, &mapping, &mapsize))) {
+    
+    /* the mapping does not depend on the file handle */
+    fclose(file);
+    
+    /* allocate new infile without buffer */
+    new_infile = malloc(sizeof(m2c_infile_struct_t));
+    
+    /* if allocation failed, unmap file, pass status and return */
+    if (new_infile == NULL) {
+      unmap_file(mapping, mapsize);
+      
+      SET_STATUS(status, M2C_INFILE_STATUS_ALLOCATION_FAILED);
+      return NULL;
+    } /* end if */
+    
+    new_infile->file = NULL;
+    new_infile->mapped = true;
+    new_infile->streaming = false;
+    new_infile->source = mapping;
+    new_infile->buflen = mapsize;
+    new_infile->probe = NULL;
+  }
+  else /* read file into buffer */ {
+    
+    /* allocate new infile */
+    new_infile = malloc(sizeof(m2c_infile_struct_t) + size + 1);
+    
+    /* if allocation failed, close file, pass status and return */
+    if (new_infile == NULL) {
+      fclose(file);
+      
+      SET_STATUS(status, M2C_INFILE_STATUS_ALLOCATION_FAILED);    
+      return NULL;
+    } /* end if */
+    
+    /* read file contents into buffer */
+    new_infile->buflen =
+      fread(&new_infile->buffer, sizeof(char), size, file);
+    new_infile->buffer[new_infile->buflen] = ASCII_NUL;
+    
+    new_infile->file = file;
+    new_infile->mapped = false;
+    new_infile->streaming = false;
+    new_infile->source = new_infile->buffer;
+    new_infile->probe = NULL;
+  } /* end if */
+  
+  /* when not streaming, the window spans the entire file */
+  if (new_infile->streaming == false) {
+    new_infile->base = 0;
+    new_infile->window_end = new_infile->buflen;
+  } /* end if */
   
   /* if file empty, close file, deallocate infile, pass status and return */
-  if (new_infile->buflen == 0) {
+  if ((new_infile->buflen == 0) || (new_infile->window_end == 0)) {
+    if (new_infile->file != NULL) {
+      fclose(new_infile->file);
+    } /* end if */
+    free(new_infile->probe);
     free(new_infile);
-    fclose(file);
     
     SET_STATUS(status, M2C_INFILE_STATUS_FILE_EMPTY);
     return NULL;
   } /* end if */
   
+  /* allocate line table, line 1 always starts at offset 0 */
+  new_infile->line_table =
+    malloc(M2C_INFILE_LINE_TABLE_INITIAL_SIZE * sizeof(size_t));
+  
+  if (new_infile->line_table == NULL) {
+    if (new_infile->mapped) {
+      unmap_file(new_infile->source, new_infile->buflen);
+    }
+    else {
+      fclose(new_infile->file);
+    } /* end if */
+    free(new_infile->probe);
+    free(new_infile);
+    
+    SET_STATUS(status, M2C_INFILE_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  new_infile->line_table[0] = 0;
+  new_infile->line_count = 1;
+  new_infile->line_start = 0;
+  new_infile->line_stride = 1;
+  new_infile->line_entries = 1;
+  new_infile->line_table_size = M2C_INFILE_LINE_TABLE_INITIAL_SIZE;
+  
   /* initialise newly allocated infile */
-  new_infile->file = file;
   new_infile->filename = filename;
   new_infile->index = 0;
   new_infile->line = 1;
-  new_infile->column = 1;
   new_infile->marker_set = false;
   new_infile->marked_index = 0;
+  new_infile->marker_evicted = false;
+  new_infile->marker_hashed = false;
+  new_infile->probe_base = 0;
+  new_infile->probe_len = 0;
   new_infile->status = M2C_INFILE_STATUS_SUCCESS;
   
+  /* verify source in a single pass, streamed files are not verified */
+  validate_source(new_infile);
+  
+  /* the trailing buffer of a buffered file is NUL terminated */
+  new_infile->unchecked =
+    (new_infile->validated) && (new_infile->has_cr == false) &&
+    (new_infile->mapped == false) && (new_infile->streaming == false);
+  
+  M2C_TRACE_FILE_OPEN(path, filesize);
+  
+  SET_STATUS(status, M2C_INFILE_STATUS_SUCCESS);
   return new_infile;
 } /* m2c_open_infile */
 
+/* --------------------------------------------------------------------------
+ * procedure m2c_open_infile_from_buffer(name, buffer, length, status)
+ * --------------------------------------------------------------------------
+ * Allocates a new object of type m2c_infile_t and associates it with the
+ * caller owned source text in buffer of the given length.  The buffer is
+ * NOT copied.  It must remain valid and unmodified until the infile object
+ * has been closed.  Parameter name is used in place of a filename.
+ *
+ * pre-conditions:
+ * o  parameters name and buffer must not be NULL upon entry
+ * o  parameter status may be NULL
+ *
+ * post-conditions:
+ * o  pointer to newly allocated infile is returned
+ * o  line counter of the newly allocated infile is set to 1
+ * o  M2C_INFILE_STATUS_SUCCESS is passed back in status, unless NULL
+ *
+ * error-conditions:
+ * o  if name or buffer is NULL upon entry, no operation is carried out
+ *    and status M2C_INFILE_STATUS_INVALID_REFERENCE is returned
+ * o  if length is zero upon entry, no operation is carried out
+ *    and status M2C_INFILE_STATUS_FILE_EMPTY is returned
+ * o  if no infile object could be allocated
+ *    status M2C_INFILE_STATUS_ALLOCATION_FAILED is returned
+ * --------------------------------------------------------------------------
+ */
+
+m2c_infile_t m2c_open_infile_from_buffer
+  (m2c_string_t name,
+   const char *buffer,
+   size_t length,
+   m2c_infile_status_t *status) {
+  
+  m2c_infile_t new_infile;
+  
+  /* check pre-conditions */
+  if ((name == NULL) || (buffer == NULL)) {
+    SET_STATUS(status, M2C_INFILE_STATUS_INVALID_REFERENCE);
+    return NULL;
+  } /* end if */
+  
+  if (length == 0) {
+    SET_STATUS(status, M2C_INFILE_STATUS_FILE_EMPTY);
+    return NULL;
+  } /* end if */
+  
+  /* allocate new infile without buffer */
+  new_infile = malloc(sizeof(m2c_infile_struct_t));
+  
+  if (new_infile == NULL) {
+    SET_STATUS(status, M2C_INFILE_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  /* allocate line table, line 1 always starts at offset 0 */
+  new_infile->line_table =
+    malloc(M2C_INFILE_LINE_TABLE_INITIAL_SIZE * sizeof(size_t));
+  
+  if (new_infile->line_table == NULL) {
+    free(new_infile);
+    
+    SET_STATUS(status, M2C_INFILE_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  new_infile->line_table[0] = 0;
+  new_infile->line_count = 1;
+  new_infile->line_start = 0;
+  new_infile->line_stride = 1;
+  new_infile->line_entries = 1;
+  new_infile->line_table_size = M2C_INFILE_LINE_TABLE_INITIAL_SIZE;
+  
+  /* borrow caller's buffer, there is neither a file nor a mapping */
+  new_infile->file = NULL;
+  new_infile->mapped = false;
+  new_infile->streaming = false;
+  new_infile->source = buffer;
+  new_infile->buflen = length;
+  new_infile->base = 0;
+  new_infile->window_end = length;
+  new_infile->probe = NULL;
+  
+  /* initialise newly allocated infile */
+  new_infile->filename = name;
+  new_infile->index = 0;
+  new_infile->line = 1;
+  new_infile->marker_set = false;
+  new_infile->marked_index = 0;
+  new_infile->marker_evicted = false;
+  new_infile->marker_hashed = false;
+  new_infile->probe_base = 0;
+  new_infile->probe_len = 0;
+  new_infile->status = M2C_INFILE_STATUS_SUCCESS;
+  
+  /* verify source, the caller's buffer carries no sentinel */
+  validate_source(new_infile);
+  new_infile->unchecked = false;
+  
+  M2C_TRACE_FILE_OPEN(m2c_string_char_ptr(name), length);
+  
+  SET_STATUS(status, M2C_INFILE_STATUS_SUCCESS);
+  return new_infile;
+} /* m2c_open_infile_from_buffer */
+
 
 /* --------------------------------------------------------------------------
  * function m2c_read_char(infile)
  * --------------------------------------------------------------------------
  * Reads the lookahead character from infile, advancing the current reading
- * position, updating line and column counter and returns its character code.
+ * position, updating the line counter and returns its character code.
  * Returns EOF if the lookahead character lies beyond the end of infile.
  *
  * pre-conditions:
@@ -180,7 +629,7 @@ m2c_infile_t m2c_open_infile
  *
  * post-conditions:
  * o  character code of lookahead character or EOF is returned
- * o  current reading position and line and column counters are updated
+ * o  current reading position and line counter are updated
  * o  file status is set to M2C_INFILE_STATUC_SUCCESS
  *
  * error-conditions:
@@ -189,7 +638,7 @@ m2c_infile_t m2c_open_infile
  * --------------------------------------------------------------------------
  */
 
-/* TO DO : Check for line and column counter limit */
+/* TO DO : Check for line counter limit */
 
 int m2c_read_char (m2c_infile_t infile) {
   char ch;
@@ -199,33 +648,57 @@ int m2c_read_char (m2c_infile_t infile) {
     return ASCII_NUL;
   } /* end if */
   
-  if (infile->index == infile->buflen) {
-    infile->status = M2C_INFILE_STATUS_ATTEMPT_TO_READ_PAST_EOF;
-    return ASCII_EOT;
+  /* validated buffer without CR, the NUL sentinel marks the end */
+  if (infile->unchecked) {
+    ch = infile->source[infile->index];
+    
+    if (ch == ASCII_NUL) {
+      infile->status = M2C_INFILE_STATUS_ATTEMPT_TO_READ_PAST_EOF;
+      return ASCII_EOT;
+    } /* end if */
+  }
+  else /* check bounds */ {
+    ENSURE_LOOKAHEAD(infile);
+    
+    if (infile->index == infile->buflen) {
+      infile->status = M2C_INFILE_STATUS_ATTEMPT_TO_READ_PAST_EOF;
+      return ASCII_EOT;
+    } /* end if */
+    
+    ch = SRC(infile, infile->index);
   } /* end if */
   
-  ch = infile->buffer[infile->index];
   infile->index++;
   
-  /* if new line encountered, update line and column counters */
+  /* hash character if it belongs to a marked lexeme */
+  if ((infile->marker_set) && (infile->marker_hashed)) {
+    if (IS_CONTROL_CHAR(ch)) {
+      infile->marker_hashed = false;
+    }
+    else {
+      m2c_string_hasher_add_chars(&infile->lexeme_hash, &ch, 1);
+    } /* end if */
+  } /* end if */
+  
+  /* if new line encountered, update line counter */
   if (ch == ASCII_LF) {
     infile->line++;
-    infile->column = 1;
   }
   else if (ch == ASCII_CR) {
     infile->line++;
-    infile->column = 1;
     
     /* if LF follows, skip it */
     if ((infile->index < infile->buflen) &&
-        (infile->buffer[infile->index] == ASCII_LF)) {
+        (SRC(infile, infile->index) == ASCII_LF)) {
       infile->index++;
     } /* end if */
         
     ch = ASCII_LF;
-  }
-  else {
-    infile->column++;
+  } /* end if */
+  
+  /* record start of new line if not already in line table */
+  if ((ch == ASCII_LF) && (infile->line == infile->line_count + 1)) {
+    add_line_start(infile, infile->index);
   } /* end if */
   
   infile->status = M2C_INFILE_STATUS_SUCCESS;
@@ -260,6 +733,9 @@ void m2c_mark_lexeme (m2c_infile_t infile) {
   /* set marker */
   infile->marker_set = true;
   infile->marked_index = infile->index;
+  infile->marker_evicted = false;
+  infile->marker_hashed = true;
+  m2c_string_hasher_init(&infile->lexeme_hash);
   
   return;
 } /* end m2c_mark_lexeme */
@@ -289,6 +765,7 @@ m2c_string_t m2c_read_marked_lexeme (m2c_infile_t infile) {
   m2c_string_t lexeme;
   unsigned int length;
   m2c_string_status_t status;
+  char *temp;
   
   /* check pre-conditions */
   if ((!infile->marker_set) || (infile->marked_index == infile->index)) {
@@ -298,9 +775,33 @@ m2c_string_t m2c_read_marked_lexeme (m2c_infile_t infile) {
   /* determine length */
   length = infile->index - infile->marked_index;
   
-  /* copy lexeme */
-  lexeme = m2c_get_string_for_slice
-    (infile->buffer, infile->marked_index, length, &status);
+  /* copy lexeme, using the hash calculated while scanning if available */
+  if ((infile->marker_evicted == false) && (infile->marker_hashed)) {
+    lexeme = m2c_get_string_for_slice_w_hash
+      (infile->source, infile->marked_index - infile->base, length,
+       m2c_string_hasher_value(&infile->lexeme_hash), &status);
+  }
+  else if (infile->marker_evicted == false) {
+    lexeme = m2c_get_string_for_slice
+      (infile->source, infile->marked_index - infile->base, length, &status);
+  }
+  else /* lexeme is longer than the window, read it back from file */ {
+    temp = malloc(length);
+    
+    if (temp == NULL) {
+      infile->status = M2C_INFILE_STATUS_ALLOCATION_FAILED;
+      return NULL;
+    } /* end if */
+    
+    if (read_at(infile, infile->marked_index, length, temp) == false) {
+      free(temp);
+      infile->status = M2C_INFILE_STATUS_IO_SUBSYSTEM_ERROR;
+      return NULL;
+    } /* end if */
+    
+    lexeme = m2c_get_string_for_slice(temp, 0, length, &status);
+    free(temp);
+  } /* end if */
   
   if (status == M2C_STRING_STATUS_ALLOCATION_FAILED) {
     infile->status = M2C_INFILE_STATUS_ALLOCATION_FAILED;
@@ -314,39 +815,58 @@ m2c_string_t m2c_read_marked_lexeme (m2c_infile_t infile) {
 } /* end m2c_read_marked_lexeme */
 
 
-static size_t m2c_infile_index_for_line (m2c_infile_t infile, uint_t line) {
-  size_t index = 0;
-  uint_t this_line = 1;
-  
-  while (this_line != line) {
-    /* find end of line */
-    while ((index < infile->buflen) &&
-           (infile->buffer[index] != ASCII_CR) &&
-           (infile->buffer[index] != ASCII_LF)) {
-     index++;
-     } /* end while */
-     
-     /* skip LF */
-     if (infile->buffer[index] == ASCII_LF) {
-       index++;
-     }
-     /* skip CR or CR LF */
-     else if (infile->buffer[index] == ASCII_CR) {
-       index++;
-       if (infile->buffer[index] == ASCII_LF) {
-         index++;
-       } /* end if */
-     }
-     else /* target line does not exist */ {
-       return 0;
-     } /* end if */
-     
-     /* next line */
-     this_line++;
-  } /* end while */
+/* --------------------------------------------------------------------------
+ * function m2c_skip_marked_lexeme(infile, length)
+ * --------------------------------------------------------------------------
+ * Discards the lexeme marked using procedure m2c_mark_lexeme() without
+ * creating a string object for it.  Returns a pointer to its character
+ * sequence within the input buffer, or NULL if it has been evicted.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_skip_marked_lexeme (m2c_infile_t infile, uint_t *length) {
+  
+  /* check pre-conditions */
+  if ((!infile->marker_set) || (infile->marked_index == infile->index)) {
+    *length = 0;
+    return NULL;
+  } /* end if */
+  
+  /* determine length and clear marker */
+  *length = (uint_t) (infile->index - infile->marked_index);
+  infile->marker_set = false;
+  
+  if (infile->marker_evicted) {
+    return NULL;
+  } /* end if */
+  
+  return &infile->source[infile->marked_index - infile->base];
+} /* end m2c_skip_marked_lexeme */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_marked_chars(infile, length)
+ * --------------------------------------------------------------------------
+ * Returns a pointer to the characters consumed since the lexeme marker was
+ * set, within the input buffer, and passes their number back in length.
+ * The marker is not cleared.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_marked_chars (m2c_infile_t infile, uint_t *length) {
+  
+  /* check pre-conditions */
+  if (!infile->marker_set) {
+    *length = 0;
+    return NULL;
+  } /* end if */
+  
+  *length = (uint_t) (infile->index - infile->marked_index);
+  
+  if (infile->marker_evicted) {
+    return NULL;
+  } /* end if */
   
-  return index;
-} /* end m2c_infile_index_for_line */
+  return &infile->source[infile->marked_index - infile->base];
+} /* end m2c_marked_chars */
 
 
 /* --------------------------------------------------------------------------
@@ -370,6 +890,7 @@ m2c_string_t m2c_infile_source_for_line (m2c_infile_t infile, uint_t line) {
   m2c_string_t source;
   size_t start, offset, length;
   m2c_string_status_t status;
+  char *temp;
   
   /* check pre-conditions */
   if ((infile == NULL) || (line == 0)) {
@@ -377,17 +898,15 @@ m2c_string_t m2c_infile_source_for_line (m2c_infile_t infile, uint_t line) {
   } /* end if */
   
   /* determine start of line */
-  start = m2c_infile_index_for_line(infile, line);
-  
-  if (start == 0) {
+  if (index_for_line(infile, line, &start) == false) {
     return NULL;
   } /* end if */
   
   /* determine end of line */
   offset = start;
   while ((offset < infile->buflen) &&
-         (infile->buffer[offset] != ASCII_LF) &&
-         (infile->buffer[offset] != ASCII_CR)) {
+         (byte_at(infile, offset) != ASCII_LF) &&
+         (byte_at(infile, offset) != ASCII_CR)) {
     offset++;
   } /* end while */
   
@@ -395,8 +914,27 @@ m2c_string_t m2c_infile_source_for_line (m2c_infile_t infile, uint_t line) {
   length = offset - start;
     
   /* copy current line */
-  source = m2c_get_string_for_slice
-    (infile->buffer, start, length, &status);
+  if ((start >= infile->base) && (offset <= infile->window_end)) {
+    source = m2c_get_string_for_slice
+      (infile->source, start - infile->base, length, &status);
+  }
+  else /* line lies outside of window */ {
+    temp = malloc(length + 1);
+    
+    if (temp == NULL) {
+      infile->status = M2C_INFILE_STATUS_ALLOCATION_FAILED;
+      return NULL;
+    } /* end if */
+    
+    if (read_at(infile, start, length, temp) == false) {
+      free(temp);
+      infile->status = M2C_INFILE_STATUS_IO_SUBSYSTEM_ERROR;
+      return NULL;
+    } /* end if */
+    
+    source = m2c_get_string_for_slice(temp, 0, length, &status);
+    free(temp);
+  } /* end if */
   
   if (status == M2C_STRING_STATUS_ALLOCATION_FAILED) {
     infile->status = M2C_INFILE_STATUS_ALLOCATION_FAILED;
@@ -411,7 +949,7 @@ m2c_string_t m2c_infile_source_for_line (m2c_infile_t infile, uint_t line) {
  * function m2c_consume_char(infile)
  * --------------------------------------------------------------------------
  * Consumes the current lookahead character, advancing the current reading
- * position, updating line and column counter and returns the character code
+ * position, updating the line counter and returns the character code
  * of the new lookahead character that follows the consumed character.
  * Returns EOF if the lookahead character lies beyond the end of infile.
  *
@@ -420,7 +958,7 @@ m2c_string_t m2c_infile_source_for_line (m2c_infile_t infile, uint_t line) {
  *
  * post-conditions:
  * o  character code of lookahead character or EOF is returned
- * o  current reading position and line and column counters are updated
+ * o  current reading position and line counter are updated
  * o  file status is set to M2C_INFILE_STATUC_SUCCESS
  *
  * error-conditions:
@@ -451,7 +989,7 @@ inline int m2c_consume_char (m2c_infile_t infile) {
  *
  * post-conditions:
  * o  character code of lookahead character or EOF is returned
- * o  current reading position and line and column counters are NOT updated
+ * o  current reading position and line counter are NOT updated
  * o  file status is set to M2C_INFILE_STATUC_SUCCESS
  *
  * error-conditions:
@@ -468,12 +1006,27 @@ int m2c_next_char (m2c_infile_t infile) {
     return ASCII_NUL;
   } /* end if */
   
+  /* validated buffer without CR, the NUL sentinel marks the end */
+  if (infile->unchecked) {
+    ch = infile->source[infile->index];
+    
+    if (ch == ASCII_NUL) {
+      infile->status = M2C_INFILE_STATUS_ATTEMPT_TO_READ_PAST_EOF;
+      return ASCII_EOT;
+    } /* end if */
+    
+    infile->status = M2C_INFILE_STATUS_SUCCESS;
+    return ch;
+  } /* end if */
+  
+  ENSURE_LOOKAHEAD(infile);
+  
   if (infile->index == infile->buflen) {
     infile->status = M2C_INFILE_STATUS_ATTEMPT_TO_READ_PAST_EOF;
     return ASCII_EOT;
   } /* end if */
   
-  ch = infile->buffer[infile->index];
+  ch = SRC(infile, infile->index);
   
   /* return LF for CR */
   if (ch == ASCII_CR) {
@@ -497,7 +1050,7 @@ int m2c_next_char (m2c_infile_t infile) {
  *
  * post-conditions:
  * o  character code of second lookahead character or EOF is returned
- * o  current reading position and line and column counters are NOT updated
+ * o  current reading position and line counter are NOT updated
  * o  file status is set to M2C_INFILE_STATUC_SUCCESS
  *
  * error-conditions:
@@ -514,21 +1067,23 @@ int m2c_la2_char (m2c_infile_t infile) {
     return ASCII_NUL;
   } /* end if */
   
-  if (infile->index+1 == infile->buflen) {
+  ENSURE_LOOKAHEAD(infile);
+  
+  if (infile->index+1 >= infile->buflen) {
     infile->status = M2C_INFILE_STATUS_ATTEMPT_TO_READ_PAST_EOF;
     return ASCII_EOT;
   } /* end if */
   
-  la2 = infile->buffer[infile->index+1];
+  la2 = SRC(infile, infile->index+1);
   
   /* skip CR LF sequence if encountered */
-  if ((infile->buffer[infile->index] == ASCII_CR) && (la2 == ASCII_LF)) {
+  if ((SRC(infile, infile->index) == ASCII_CR) && (la2 == ASCII_LF)) {
     if (infile->index+2 == infile->buflen) {
       infile->status = M2C_INFILE_STATUS_ATTEMPT_TO_READ_PAST_EOF;
       return EOF;
     } /* end if */
     
-    la2 = infile->buffer[infile->index+2];
+    la2 = SRC(infile, infile->index+2);
   } /* end if */
   
   /* return LF for CR */
@@ -541,6 +1096,54 @@ int m2c_la2_char (m2c_infile_t infile) {
 } /* end m2c_la2_char */
 
 
+/* --------------------------------------------------------------------------
+ * function m2c_consume_run(infile, run, delimiter)
+ * --------------------------------------------------------------------------
+ * Consumes the longest sequence of characters starting at the lookahead
+ * character that belong to character class run and returns the number of
+ * bytes consumed.  Line breaks within the sequence are recorded in bulk.
+ * --------------------------------------------------------------------------
+ */
+
+size_t m2c_consume_run
+  (m2c_infile_t infile, m2c_infile_run_t run, char delimiter) {
+  size_t total, length, count;
+  
+  /* check pre-conditions */
+  if (infile == NULL) {
+    return 0;
+  } /* end if */
+  
+  total = 0;
+  
+  /* scan window by window until a character outside of run is found */
+  do {
+    ENSURE_LOOKAHEAD(infile);
+    
+    length = infile->window_end - infile->index;
+    count = scan_run(infile, length, run, delimiter);
+    
+    /* hash run while it is still cached if it belongs to a marked lexeme */
+    if ((infile->marker_set) && (infile->marker_hashed) && (count > 0)) {
+      if ((run == M2C_INFILE_RUN_COMMENT_TEXT) ||
+          (run == M2C_INFILE_RUN_LINE_COMMENT)) {
+        infile->marker_hashed = false;
+      }
+      else {
+        m2c_string_hasher_add_chars
+          (&infile->lexeme_hash, &SRC(infile, infile->index), (uint_t) count);
+      } /* end if */
+    } /* end if */
+    
+    infile->index = infile->index + count;
+    total = total + count;
+  } while ((count == length) && (infile->window_end < infile->buflen));
+  
+  infile->status = M2C_INFILE_STATUS_SUCCESS;
+  return total;
+} /* end m2c_consume_run */
+
+
 /* --------------------------------------------------------------------------
  * function m2c_infile_filename(infile)
  * --------------------------------------------------------------------------
@@ -597,15 +1200,34 @@ bool m2c_infile_eof (m2c_infile_t infile) {
 
 
 /* --------------------------------------------------------------------------
- * function m2c_infile_current_line(infile)
+ * function m2c_infile_is_validated(infile)
  * --------------------------------------------------------------------------
- * Returns the current line counter of infile.
+ * Returns true if the entire source of infile has been verified to consist
+ * of printable ASCII characters, TAB, LF and CR only, returns false if it
+ * contains any other character or if it has not been verified.
  * --------------------------------------------------------------------------
  */
 
-unsigned int m2c_infile_current_line (m2c_infile_t infile) {
-
-  /* check pre-conditions */
+bool m2c_infile_is_validated (m2c_infile_t infile) {
+  
+  if (infile == NULL) {
+    return false;
+  } /* end if */
+  
+  return infile->validated;
+} /* end m2c_infile_is_validated */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_infile_current_line(infile)
+ * --------------------------------------------------------------------------
+ * Returns the current line counter of infile.
+ * --------------------------------------------------------------------------
+ */
+
+unsigned int m2c_infile_current_line (m2c_infile_t infile) {
+
+  /* check pre-conditions */
   if (infile == NULL) {
     return 0;
   } /* end if */
@@ -617,21 +1239,136 @@ unsigned int m2c_infile_current_line (m2c_infile_t infile) {
 /* --------------------------------------------------------------------------
  * function m2c_infile_current_column(infile)
  * --------------------------------------------------------------------------
- * Returns the current column counter of infile.
+ * Returns the current column counter of infile.  The column is not counted
+ * while reading, it is derived from the start offset of the current line.
  * --------------------------------------------------------------------------
  */
 
 unsigned int m2c_infile_current_column (m2c_infile_t infile) {
-
+  size_t start;
+  
   /* check pre-conditions */
   if (infile == NULL) {
     return 0;
   } /* end if */
   
-  return infile->column;
+  if (index_for_line(infile, infile->line, &start) == false) {
+    return 0;
+  } /* end if */
+  
+  return (unsigned int) (infile->index - start) + 1;
 } /* end m2c_infile_current_column */
 
 
+/* --------------------------------------------------------------------------
+ * function m2c_infile_current_offset(infile)
+ * --------------------------------------------------------------------------
+ * Returns the byte offset of the current reading position of infile.  Line
+ * and column of an offset are obtained by m2c_infile_position_for_offset().
+ * --------------------------------------------------------------------------
+ */
+
+size_t m2c_infile_current_offset (m2c_infile_t infile) {
+  
+  /* check pre-conditions */
+  if (infile == NULL) {
+    return 0;
+  } /* end if */
+  
+  return infile->index;
+} /* end m2c_infile_current_offset */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_infile_line_count(infile)
+ * --------------------------------------------------------------------------
+ * Returns the number of lines of infile whose start offsets have been
+ * determined so far.
+ * --------------------------------------------------------------------------
+ */
+
+uint_t m2c_infile_line_count (m2c_infile_t infile) {
+
+  /* check pre-conditions */
+  if (infile == NULL) {
+    return 0;
+  } /* end if */
+  
+  return infile->line_count;
+} /* end m2c_infile_line_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_infile_position_for_offset(infile, offset, line, column)
+ * --------------------------------------------------------------------------
+ * Determines line and column of the character at the given byte offset of
+ * infile, passes them back in out-parameters line and column and returns
+ * true.  Returns false if offset lies beyond the end of infile.
+ *
+ * pre-conditions:
+ * o  parameter infile must not be NULL upon entry
+ * o  parameters line and column must not be NULL upon entry
+ *
+ * post-conditions:
+ * o  line and column of offset are passed back in line and column
+ *
+ * error-conditions:
+ * o  if any pre-condition is not met or offset lies beyond the end of
+ *    infile, no operation is carried out and false is returned
+ * --------------------------------------------------------------------------
+ */
+
+bool m2c_infile_position_for_offset
+  (m2c_infile_t infile, size_t offset, uint_t *line, uint_t *column) {
+  
+  uint_t low, high, mid, line_no;
+  size_t start, next;
+  
+  /* check pre-conditions */
+  if ((infile == NULL) || (line == NULL) || (column == NULL) ||
+      (offset > infile->buflen)) {
+    return false;
+  } /* end if */
+  
+  /* make sure the line containing offset is recorded */
+  while ((infile->line_start <= offset) &&
+         (extend_line_table(infile))) {
+    /* next line recorded */
+  } /* end while */
+  
+  /* binary search for last table entry starting at or before offset */
+  low = 0;
+  high = infile->line_entries - 1;
+  while (low < high) {
+    mid = (low + high + 1) / 2;
+    if (infile->line_table[mid] <= offset) {
+      low = mid;
+    }
+    else {
+      high = mid - 1;
+    } /* end if */
+  } /* end while */
+  
+  /* scan forward to the last line starting at or before offset */
+  line_no = low * infile->line_stride + 1;
+  start = infile->line_table[low];
+  while (line_no < infile->line_count) {
+    next = start;
+    if ((next_line_start(infile, &next) == false) || (next > offset)) {
+      break;
+    } /* end if */
+    start = next;
+    line_no++;
+  } /* end while */
+  
+  /* pass back line and column */
+  *line = line_no;
+  *column = (uint_t) (offset - start) + 1;
+  
+  return true;
+} /* end m2c_infile_position_for_offset */
+
+
 /* --------------------------------------------------------------------------
  * procedure m2c_close_infile(file, status)
  * --------------------------------------------------------------------------
@@ -664,7 +1401,17 @@ void m2c_close_infile (m2c_infile_t *infptr, m2c_infile_status_t *status) {
   
   infile = *infptr;
   
-  fclose(infile->file);
+  M2C_TRACE_FILE_CLOSE(m2c_string_char_ptr(infile->filename));
+  
+  if (infile->mapped) {
+    unmap_file(infile->source, infile->buflen);
+  }
+  else if (infile->file != NULL) {
+    fclose(infile->file);
+  } /* end if */
+  
+  free(infile->line_table);
+  free(infile->probe);
   free(infile);
   *infptr = NULL;
   
@@ -672,4 +1419,657 @@ void m2c_close_infile (m2c_infile_t *infptr, m2c_infile_status_t *status) {
   return;
 } /* end m2c_close_infile */
 
+
+/* *** Private Functions *** */
+
+
+/* --------------------------------------------------------------------------
+ * private function file_size(file, size)
+ * --------------------------------------------------------------------------
+ * Determines the size of file, passes it back in size, rewinds file and
+ * returns true.  Returns false on failure.  Sizes are obtained from the
+ * host's 64-bit file position functions where these are available.
+ * ----------------------------------------------------------------------- */
+
+static bool file_size (FILE *file, uintmax_t *size) {
+#if defined(_WIN32)
+  __int64 end;
+  
+  if (_fseeki64(file, 0, SEEK_END) != 0) {
+    return false;
+  } /* end if */
+  end = _ftelli64(file);
+#elif defined(__unix__) || defined(__APPLE__)
+  off_t end;
+  
+  if (fseeko(file, 0, SEEK_END) != 0) {
+    return false;
+  } /* end if */
+  end = ftello(file);
+#else
+  long int end;
+  
+  if (fseek(file, 0, SEEK_END) != 0) {
+    return false;
+  } /* end if */
+  end = ftell(file);
+#endif
+  
+  if ((end < 0) || (seek_offset(file, 0) == false)) {
+    return false;
+  } /* end if */
+  
+  *size = (uintmax_t) end;
+  return true;
+} /* end file_size */
+
+
+/* --------------------------------------------------------------------------
+ * private function seek_offset(file, offset)
+ * --------------------------------------------------------------------------
+ * Sets the position of file to the given offset from its start.  Offsets
+ * are passed to the host's 64-bit seek function where one is available.
+ * Returns true on success, false on failure.
+ * ----------------------------------------------------------------------- */
+
+static bool seek_offset (FILE *file, size_t offset) {
+#if defined(_WIN32)
+  return (_fseeki64(file, (__int64) offset, SEEK_SET) == 0);
+#elif defined(__unix__) || defined(__APPLE__)
+  return (fseeko(file, (off_t) offset, SEEK_SET) == 0);
+#else
+  if (offset > (size_t) LONG_MAX) {
+    return false;
+  } /* end if */
+  
+  return (fseek(file, (long int) offset, SEEK_SET) == 0);
+#endif
+} /* end seek_offset */
+
+
+/* --------------------------------------------------------------------------
+ * private function refill_window(infile)
+ * --------------------------------------------------------------------------
+ * Slides the window of a streaming infile forward and loads as many of the
+ * following bytes of the file as fit into the window.  Bytes from the
+ * marked position onwards are retained unless the marked lexeme would not
+ * leave room for at least one chunk, in which case the marker is flagged
+ * as evicted and the lexeme is later read back from file.  Bytes before
+ * the current reading position are discarded.
+ * ----------------------------------------------------------------------- */
+
+static void refill_window (m2c_infile_t infile) {
+  size_t keep, retained, space, count, index;
+  
+  /* determine start of bytes to keep */
+  keep = infile->index;
+  if ((infile->marker_set) && (infile->marker_evicted == false)) {
+    if (infile->index - infile->marked_index <=
+        M2C_INFILE_WINDOW_SIZE - M2C_INFILE_STREAM_CHUNK_SIZE) {
+      keep = infile->marked_index;
+    }
+    else {
+      infile->marker_evicted = true;
+    } /* end if */
+  } /* end if */
+  
+  /* move retained bytes to the start of the window */
+  retained = infile->window_end - keep;
+  for (index = 0; index < retained; index++) {
+    infile->buffer[index] = infile->buffer[keep - infile->base + index];
+  } /* end for */
+  infile->base = keep;
+  
+  /* determine number of bytes to load */
+  space = M2C_INFILE_WINDOW_SIZE - retained;
+  if (space > infile->buflen - infile->window_end) {
+    space = infile->buflen - infile->window_end;
+  } /* end if */
+  
+  /* load following bytes */
+  count = 0;
+  if (seek_offset(infile->file, infile->window_end)) {
+    count =
+      fread(&infile->buffer[retained], sizeof(char), space, infile->file);
+  } /* end if */
+  
+  /* if the file was truncated or could not be read, treat it as ended */
+  if (count < space) {
+    infile->buflen = infile->window_end + count;
+    infile->status = M2C_INFILE_STATUS_IO_SUBSYSTEM_ERROR;
+  } /* end if */
+  
+  infile->window_end = infile->window_end + count;
+  
+  return;
+} /* end refill_window */
+
+
+/* --------------------------------------------------------------------------
+ * private function byte_at(infile, offset)
+ * --------------------------------------------------------------------------
+ * Returns the byte at the given file offset of infile.  Bytes outside of
+ * the window of a streaming infile are read through its probe buffer.
+ * Returns ASCII_EOT if offset lies beyond the end of infile.
+ * ----------------------------------------------------------------------- */
+
+static int byte_at (m2c_infile_t infile, size_t offset) {
+  size_t length;
+  
+  if (offset >= infile->buflen) {
+    return ASCII_EOT;
+  } /* end if */
+  
+  /* byte lies within window */
+  if ((offset >= infile->base) && (offset < infile->window_end)) {
+    return SRC(infile, offset);
+  } /* end if */
+  
+  /* byte lies outside of probe buffer */
+  if ((offset < infile->probe_base) ||
+      (offset >= infile->probe_base + infile->probe_len)) {
+    
+    length = M2C_INFILE_PROBE_SIZE;
+    if (length > infile->buflen - offset) {
+      length = infile->buflen - offset;
+    } /* end if */
+    
+    if (read_at(infile, offset, length, infile->probe) == false) {
+      infile->probe_len = 0;
+      return ASCII_EOT;
+    } /* end if */
+    
+    infile->probe_base = offset;
+    infile->probe_len = length;
+  } /* end if */
+  
+  return infile->probe[offset - infile->probe_base];
+} /* end byte_at */
+
+
+/* --------------------------------------------------------------------------
+ * private function read_at(infile, offset, length, target)
+ * --------------------------------------------------------------------------
+ * Reads length bytes starting at the given file offset of a streaming
+ * infile into target.  Returns true on success, false on failure.
+ * ----------------------------------------------------------------------- */
+
+static bool read_at
+  (m2c_infile_t infile, size_t offset, size_t length, char *target) {
+  
+  if ((infile->file == NULL) ||
+      (seek_offset(infile->file, offset) == false)) {
+    return false;
+  } /* end if */
+  
+  return (fread(target, sizeof(char), length, infile->file) == length);
+} /* end read_at */
+
+
+/* --------------------------------------------------------------------------
+ * private function record_line_breaks(infile, offset, mask)
+ * --------------------------------------------------------------------------
+ * Records the line breaks of a vector at file offset whose positions are
+ * given by the bits of mask, advancing the line counter by the number of
+ * line breaks.  Line table entries are only added for lines not yet
+ * recorded.
+ * ----------------------------------------------------------------------- */
+
+#if defined(M2C_INFILE_SIMD)
+static void record_line_breaks
+  (m2c_infile_t infile, size_t offset, uint32_t mask) {
+  uint32_t pending;
+  
+  if (mask == 0) {
+    return;
+  } /* end if */
+  
+  /* lines already in line table, only advance line counter */
+  if (infile->line + (uint_t) __builtin_popcount(mask) <= 
+      infile->line_count) {
+    infile->line = infile->line + (uint_t) __builtin_popcount(mask);
+    return;
+  } /* end if */
+  
+  /* record each new line */
+  pending = mask;
+  while (pending != 0) {
+    infile->line++;
+    if (infile->line == infile->line_count + 1) {
+      add_line_start(infile, offset + (uint_t) __builtin_ctz(pending) + 1);
+    } /* end if */
+    pending = pending & (pending - 1);
+  } /* end while */
+  
+  return;
+} /* end record_line_breaks */
+
+
+/* --------------------------------------------------------------------------
+ * private function run_stop_mask(data, run, delimiter)
+ * --------------------------------------------------------------------------
+ * Returns a bit mask of the bytes in vector data that do not belong to
+ * character class run.  Signed byte comparisons place codes of 128 and
+ * above below zero, thus outside of all letter and digit ranges and
+ * outside of the control character range.
+ * ----------------------------------------------------------------------- */
+
+static inline uint32_t run_stop_mask
+  (vec_t data, m2c_infile_run_t run, char delimiter) {
+  uint32_t control, letters;
+  
+  switch (run) {
+    case M2C_INFILE_RUN_IDENT_CHARS :
+      letters =
+        (VEC_GT(data, VEC_SPLAT('0' - 1)) & VEC_GT(VEC_SPLAT('9' + 1), data)) |
+        (VEC_GT(data, VEC_SPLAT('A' - 1)) & VEC_GT(VEC_SPLAT('Z' + 1), data)) |
+        (VEC_GT(data, VEC_SPLAT('a' - 1)) & VEC_GT(VEC_SPLAT('z' + 1), data));
+      return ~letters & VEC_ALL_BITS;
+      
+    case M2C_INFILE_RUN_UPPER_CHARS :
+      letters =
+        (VEC_GT(data, VEC_SPLAT('A' - 1)) & VEC_GT(VEC_SPLAT('Z' + 1), data));
+      return ~letters & VEC_ALL_BITS;
+      
+    case M2C_INFILE_RUN_DECIMAL_DIGITS :
+      letters =
+        (VEC_GT(data, VEC_SPLAT('0' - 1)) & VEC_GT(VEC_SPLAT('9' + 1), data));
+      return ~letters & VEC_ALL_BITS;
+      
+    case M2C_INFILE_RUN_HEX_DIGITS :
+      letters =
+        (VEC_GT(data, VEC_SPLAT('0' - 1)) & VEC_GT(VEC_SPLAT('9' + 1), data)) |
+        (VEC_GT(data, VEC_SPLAT('A' - 1)) & VEC_GT(VEC_SPLAT('F' + 1), data));
+      return ~letters & VEC_ALL_BITS;
+      
+    default :
+      break;
+  } /* end switch */
+  
+  control =
+    (VEC_GT(data, VEC_SPLAT(-1)) & VEC_GT(VEC_SPLAT(0x20), data)) |
+    VEC_EQ(data, VEC_SPLAT(0x7f));
+  
+  switch (run) {
+    case M2C_INFILE_RUN_COMMENT_TEXT :
+      return
+        (control &
+         ~(VEC_EQ(data, VEC_SPLAT(ASCII_TAB)) |
+           VEC_EQ(data, VEC_SPLAT(ASCII_LF)))) |
+        VEC_EQ(data, VEC_SPLAT('*')) | VEC_EQ(data, VEC_SPLAT('('));
+      
+    case M2C_INFILE_RUN_LINE_COMMENT :
+      return control & ~VEC_EQ(data, VEC_SPLAT(ASCII_TAB));
+      
+    case M2C_INFILE_RUN_QUOTED_TEXT :
+      return control |
+        VEC_EQ(data, VEC_SPLAT(delimiter)) | VEC_EQ(data, VEC_SPLAT('\\'));
+      
+    default :
+      return VEC_ALL_BITS;
+  } /* end switch */
+} /* end run_stop_mask */
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * private function scan_run(infile, length, run, delimiter)
+ * --------------------------------------------------------------------------
+ * Scans at most length bytes from the current reading position of infile
+ * and returns the number of leading bytes that belong to character class
+ * run.  Line breaks within those bytes are recorded.  The reading position
+ * itself is not updated.
+ * ----------------------------------------------------------------------- */
+
+static size_t scan_run
+  (m2c_infile_t infile, size_t length, m2c_infile_run_t run, char delimiter) {
+  const char *source;
+  size_t pos;
+  char ch;
+  
+#if defined(M2C_INFILE_SIMD)
+  uint32_t stop, breaks;
+  vec_t data;
+#endif
+  
+  source = &SRC(infile, infile->index);
+  pos = 0;
+  
+#if defined(M2C_INFILE_SIMD)
+  while (pos + VEC_WIDTH <= length) {
+    data = VEC_LOAD(source + pos);
+    stop = run_stop_mask(data, run, delimiter);
+    
+    if (run == M2C_INFILE_RUN_COMMENT_TEXT) {
+      breaks = VEC_EQ(data, VEC_SPLAT(ASCII_LF));
+      
+      /* only line breaks before the first stop byte belong to the run */
+      if (stop != 0) {
+        breaks = breaks & ((1u << __builtin_ctz(stop)) - 1);
+      } /* end if */
+      
+      record_line_breaks(infile, infile->index + pos, breaks);
+    } /* end if */
+    
+    if (stop != 0) {
+      return pos + (uint_t) __builtin_ctz(stop);
+    } /* end if */
+    
+    pos = pos + VEC_WIDTH;
+  } /* end while */
+#endif
+  
+  /* remaining bytes */
+  while (pos < length) {
+    ch = source[pos];
+    
+    if (is_run_char(ch, run, delimiter) == false) {
+      break;
+    } /* end if */
+    
+    pos++;
+    
+    if (ch == ASCII_LF) {
+      infile->line++;
+      if (infile->line == infile->line_count + 1) {
+        add_line_start(infile, infile->index + pos);
+      } /* end if */
+    } /* end if */
+  } /* end while */
+  
+  return pos;
+} /* end scan_run */
+
+
+/* --------------------------------------------------------------------------
+ * private function is_run_char(ch, run, delimiter)
+ * --------------------------------------------------------------------------
+ * Returns true if ch belongs to character class run, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+static bool is_run_char (char ch, m2c_infile_run_t run, char delimiter) {
+  
+  switch (run) {
+    case M2C_INFILE_RUN_COMMENT_TEXT :
+      return ((!IS_CONTROL_CHAR(ch)) && (ch != '*') && (ch != '(')) ||
+        (ch == ASCII_TAB) || (ch == ASCII_LF);
+      
+    case M2C_INFILE_RUN_LINE_COMMENT :
+      return (!IS_CONTROL_CHAR(ch)) || (ch == ASCII_TAB);
+      
+    case M2C_INFILE_RUN_IDENT_CHARS :
+      return IS_ALPHANUMERIC(ch);
+      
+    case M2C_INFILE_RUN_UPPER_CHARS :
+      return IS_UPPER(ch);
+      
+    case M2C_INFILE_RUN_DECIMAL_DIGITS :
+      return IS_DIGIT(ch);
+      
+    case M2C_INFILE_RUN_HEX_DIGITS :
+      return IS_DIGIT(ch) || IS_A_TO_F(ch);
+      
+    case M2C_INFILE_RUN_QUOTED_TEXT :
+      return (!IS_CONTROL_CHAR(ch)) && (ch != delimiter) && (ch != '\\');
+      
+    default :
+      return false;
+  } /* end switch */
+} /* end is_run_char */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure add_line_start(infile, index)
+ * --------------------------------------------------------------------------
+ * Records index as the start offset of the line following the last line
+ * whose start is known.  The offset is entered into the line table if the
+ * line begins a stride.  If the table is full and cannot be grown, it is
+ * thinned out first.
+ * ----------------------------------------------------------------------- */
+
+static void add_line_start (m2c_infile_t infile, size_t index) {
+  size_t *new_table;
+  uint_t new_size;
+  
+  /* the new line is line_count + 1, entered if it begins a stride */
+  if ((infile->line_count % infile->line_stride) == 0) {
+    
+    /* grow table if full, thin it out at maximum size */
+    if (infile->line_entries == infile->line_table_size) {
+      new_table = NULL;
+      
+      if (infile->line_table_size < M2C_INFILE_LINE_TABLE_MAX_SIZE) {
+        new_size = 2 * infile->line_table_size;
+        new_table = realloc(infile->line_table, new_size * sizeof(size_t));
+      } /* end if */
+      
+      if (new_table != NULL) {
+        infile->line_table = new_table;
+        infile->line_table_size = new_size;
+      }
+      else {
+        thin_line_table(infile);
+      } /* end if */
+    } /* end if */
+    
+    /* the stride may have doubled */
+    if ((infile->line_count % infile->line_stride) == 0) {
+      infile->line_table[infile->line_entries] = index;
+      infile->line_entries++;
+    } /* end if */
+  } /* end if */
+  
+  infile->line_start = index;
+  infile->line_count++;
+  
+  return;
+} /* end add_line_start */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure thin_line_table(infile)
+ * --------------------------------------------------------------------------
+ * Removes every second entry from the line table of infile, starting with
+ * the second entry, and doubles the line stride.
+ * ----------------------------------------------------------------------- */
+
+static void thin_line_table (m2c_infile_t infile) {
+  uint_t index;
+  
+  for (index = 1; 2 * index < infile->line_entries; index++) {
+    infile->line_table[index] = infile->line_table[2 * index];
+  } /* end for */
+  
+  infile->line_entries = (infile->line_entries + 1) / 2;
+  infile->line_stride = 2 * infile->line_stride;
+  
+  return;
+} /* end thin_line_table */
+
+
+/* --------------------------------------------------------------------------
+ * private function next_line_start(infile, index)
+ * --------------------------------------------------------------------------
+ * Scans infile from offset index to the next line break and passes back
+ * the start offset of the line that follows in index.  Returns true on
+ * success, false if the line at index is the last line of infile.
+ * ----------------------------------------------------------------------- */
+
+static bool next_line_start (m2c_infile_t infile, size_t *index) {
+  size_t offset;
+  
+  offset = *index;
+  
+  /* find end of line */
+  while ((offset < infile->buflen) &&
+         (byte_at(infile, offset) != ASCII_CR) &&
+         (byte_at(infile, offset) != ASCII_LF)) {
+    offset++;
+  } /* end while */
+  
+  /* last line reached */
+  if (offset >= infile->buflen) {
+    return false;
+  } /* end if */
+  
+  /* skip LF, CR or CR LF */
+  if ((byte_at(infile, offset) == ASCII_CR) &&
+      (offset + 1 < infile->buflen) &&
+      (byte_at(infile, offset + 1) == ASCII_LF)) {
+    offset++;
+  } /* end if */
+  offset++;
+  
+  *index = offset;
+  return true;
+} /* end next_line_start */
+
+
+/* --------------------------------------------------------------------------
+ * private function extend_line_table(infile)
+ * --------------------------------------------------------------------------
+ * Scans infile from the start of the last recorded line to the next line
+ * break and records the start of the line that follows.  Returns true if
+ * a line was recorded, false if the last recorded line is the last line
+ * of infile.
+ * ----------------------------------------------------------------------- */
+
+static bool extend_line_table (m2c_infile_t infile) {
+  size_t index;
+  
+  index = infile->line_start;
+  
+  if (next_line_start(infile, &index) == false) {
+    return false;
+  } /* end if */
+  
+  add_line_start(infile, index);
+  return true;
+} /* end extend_line_table */
+
+
+/* --------------------------------------------------------------------------
+ * private function index_for_line(infile, line, index)
+ * --------------------------------------------------------------------------
+ * Passes back the start offset of line in index and returns true, or
+ * returns false if line does not exist in infile.  Lines that have not
+ * yet been recorded are recorded on demand.  Lines not held in the line
+ * table are found by scanning forward from the nearest entry.
+ * ----------------------------------------------------------------------- */
+
+static bool index_for_line (m2c_infile_t infile, uint_t line, size_t *index) {
+  uint_t count;
+  size_t start;
+  
+  if (line == 0) {
+    return false;
+  } /* end if */
+  
+  while (line > infile->line_count) {
+    if (extend_line_table(infile) == false) {
+      return false;
+    } /* end if */
+  } /* end while */
+  
+  /* the reader is usually on the last recorded line */
+  if (line == infile->line_count) {
+    *index = infile->line_start;
+    return true;
+  } /* end if */
+  
+  start = infile->line_table[(line - 1) / infile->line_stride];
+  
+  for (count = (line - 1) % infile->line_stride; count > 0; count--) {
+    if (next_line_start(infile, &start) == false) {
+      return false;
+    } /* end if */
+  } /* end for */
+  
+  *index = start;
+  return true;
+} /* end index_for_line */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure validate_source(infile)
+ * --------------------------------------------------------------------------
+ * Verifies in a single pass that the source of infile holds no characters
+ * other than printable ASCII characters, TAB, LF and CR, and sets fields
+ * validated and has_cr accordingly.  Streamed sources are not verified.
+ * Bytes with codes of 128 and above count as control characters in the
+ * vector comparison, which is signed.
+ * ----------------------------------------------------------------------- */
+
+static void validate_source (m2c_infile_t infile) {
+  
+  const char *source;
+  size_t index, length;
+  bool has_cr;
+  char ch;
+#if defined(M2C_INFILE_SIMD)
+  vec_t data, space, tab, lf, cr, del;
+  uint32_t ctrl, permitted;
+#endif
+  
+  infile->validated = false;
+  infile->has_cr = false;
+  
+  if (infile->streaming) {
+    return;
+  } /* end if */
+  
+  source = infile->source;
+  length = infile->buflen;
+  has_cr = false;
+  index = 0;
+  
+#if defined(M2C_INFILE_SIMD)
+  space = VEC_SPLAT(0x20);
+  tab = VEC_SPLAT(ASCII_TAB);
+  lf = VEC_SPLAT(ASCII_LF);
+  cr = VEC_SPLAT(ASCII_CR);
+  del = VEC_SPLAT(0x7f);
+  
+  while (index + VEC_WIDTH <= length) {
+    data = VEC_LOAD(source + index);
+    ctrl = VEC_GT(space, data) | VEC_EQ(data, del);
+    
+    if (ctrl != 0) {
+      permitted = VEC_EQ(data, tab) | VEC_EQ(data, lf) | VEC_EQ(data, cr);
+      
+      if ((ctrl & ~permitted) != 0) {
+        return;
+      } /* end if */
+      
+      if (VEC_EQ(data, cr) != 0) {
+        has_cr = true;
+      } /* end if */
+    } /* end if */
+    
+    index = index + VEC_WIDTH;
+  } /* end while */
+#endif
+  
+  /* remaining bytes, or all bytes without vector support */
+  while (index < length) {
+    ch = source[index];
+    
+    if (ch == ASCII_CR) {
+      has_cr = true;
+    }
+    else if (((unsigned char) ch > 0x7e) ||
+      (IS_CONTROL_CHAR(ch) && (ch != ASCII_TAB) && (ch != ASCII_LF))) {
+      return;
+    } /* end if */
+    
+    index++;
+  } /* end while */
+  
+  infile->validated = true;
+  infile->has_cr = has_cr;
+  
+  return;
+} /* end validate_source */
+
+
 /* END OF FILE */
\ No newline at end of file
@@ -46,7 +46,7 @@
  * FIRST set data structures
  * ----------------------------------------------------------------------- */
 
-m2c_tokenset_literal_t
+static const m2c_tokenset_literal_t
   first_of_definition_module = INIT_FIRST_OF_DEFINITION_MODULE,
   first_of_import = INIT_FIRST_OF_IMPORT,
   first_of_qualified_import = INIT_FIRST_OF_QUALIFIED_IMPORT,
@@ -137,7 +137,7 @@ m2c_tokenset_literal_t
  * FOLLOW set data structures
  * ----------------------------------------------------------------------- */
 
-m2c_tokenset_literal_t
+static const m2c_tokenset_literal_t
   follow_of_definition_module = INIT_FOLLOW_OF_DEFINITION_MODULE,
   follow_of_import = INIT_FOLLOW_OF_IMPORT,
   follow_of_qualified_import = INIT_FOLLOW_OF_QUALIFIED_IMPORT,
@@ -231,7 +231,7 @@ m2c_tokenset_literal_t
  * Table of pointers to FIRST set data structures
  * ----------------------------------------------------------------------- */
 
-m2c_tokenset_literal_t *m2c_first_set[] = {
+static const m2c_tokenset_literal_t *m2c_first_set[] = {
   &first_of_definition_module,        /* FIRST(definitionModule) */
   &first_of_import,                   /* FIRST(import) */
   &first_of_qualified_import,         /* FIRST(qualifiedImport) */
@@ -325,7 +325,7 @@ m2c_tokenset_literal_t *m2c_first_set[] = {
  * Table of pointers to FOLLOW set data structures
  * ----------------------------------------------------------------------- */
 
-m2c_tokenset_literal_t *m2c_follow_set[] = {
+static const m2c_tokenset_literal_t *m2c_follow_set[] = {
   &follow_of_definition_module,        /* FOLLOW(definitionModule) */
   &follow_of_import,                   /* FOLLOW(import) */
   &follow_of_qualified_import,         /* FOLLOW(qualifiedImport) */
@@ -419,7 +419,7 @@ m2c_tokenset_literal_t *m2c_follow_set[] = {
  * Table of pointers to human readable production names
  * ----------------------------------------------------------------------- */
 
-const char *m2c_production_name_table[] = {
+static const char *m2c_production_name_table[] = {
   "definitionModule\0",
   "import\0",
   "qualifiedImport\0",
@@ -34,13 +34,37 @@
  */
 
 #include "m2-symtab.h"
+#include "m2-alloc-stats.h"
 
-#include "hash.h"
 #include <stdlib.h>
+#include <stdint.h>
 
-#define M2C_SYMTAB_BUCKET_COUNT_TOPSCOPE 97
 
-#define M2C_SYMTAB_BUCKET_COUNT_SUBSCOPE 17
+/* --------------------------------------------------------------------------
+ * Initial capacities and load factor
+ * --------------------------------------------------------------------------
+ * The innermost visible binding of each identifier is recorded in a table
+ * of the symbol table, open addressed with linear probing.  Its capacity is
+ * a power of two, it doubles when its load would exceed the given maximum.
+ * The symbols of a scope are packed into chunks, the first chunk of a
+ * scope holds as many symbols as given by the initial chunk size.
+ * ----------------------------------------------------------------------- */
+
+#define M2C_SYMTAB_INITIAL_BINDING_CAPACITY 256
+
+#define M2C_SYMTAB_MAX_LOAD_PERCENT 75
+
+#define M2C_SYMTAB_INITIAL_CHUNK_SIZE_TOPSCOPE 96
+
+#define M2C_SYMTAB_INITIAL_CHUNK_SIZE_SUBSCOPE 12
+
+
+/* --------------------------------------------------------------------------
+ * Hash constant
+ * ----------------------------------------------------------------------- */
+
+#define HASH_MULTIPLIER 0x9E3779B97F4A7C15ULL
+
 
 /* --------------------------------------------------------------------------
  * Logical Representation of Symbol Table
@@ -60,49 +84,140 @@
  *               +------------+                 +------------+
  *
  * symbol
- *               +------------+------------+------------+------------+
- *  fields:      | ident      | kind       | type_id    | definition |
- *               +------------+------------+------------+------------+
- * 
+ *               +--------+--------+---------+------------+-------+----------+
+ *  fields:      | ident  | kind   | type_id | definition | scope | shadowed |
+ *               +--------+--------+---------+------------+-------+----------+
+ *
+ * binding table
+ *               +------------+------------+
+ *  slot:        | ident      | innermost  | --> symbol --> shadowed . . .
+ *               +------------+------------+
+ *
+ * The binding table maps each identifier to its innermost visible symbol.
+ * The home slot of an identifier is derived from the address of its
+ * interned string.  Each symbol links to the symbol it shadows, so the
+ * symbols of an identifier form a stack across scopes.  Inserting a symbol
+ * pushes it, closing its scope pops it.  A lookup is therefore one probe
+ * of the binding table, regardless of the depth of the scope nesting.
+ * Symbols are not allocated individually but packed into chunks owned by
+ * their scope.  The first chunk is allocated together with the scope.
+ *
+ * snapshot
+ *               +------------+------------+--------+---------+------------+
+ *  entry:       | ident      | scope      | kind   | type_id | definition |
+ *               +------------+------------+--------+---------+------------+
+ *
+ * A snapshot is a frozen copy of the innermost visible symbol of each
+ * identifier, open addressed like the binding table.  It is never written
+ * after it has been built, thus any number of threads may probe it at the
+ * same time without locking.  A symbol table based on a snapshot consults
+ * the snapshot for identifiers without a visible symbol of its own, the
+ * symbols of its scopes therefore hide those of the snapshot.
  * ----------------------------------------------------------------------- */
 
 /* --------------------------------------------------------------------------
  * private types m2c_symbol_s and m2c_symbol_t
  * --------------------------------------------------------------------------
- * Record and pointer type representing a symbol table entry.
+ * Record and pointer type representing a symbol table entry.  Field
+ * shadowed links to the symbol with the same identifier in an enclosing
+ * scope that this symbol hides, or NULL if there is none.
  * ----------------------------------------------------------------------- */
 
 typedef struct m2c_symbol_s *m2c_symbol_t;
 
+typedef struct m2c_symtab_scope_s *m2c_symtab_scope_t;
+
 struct m2c_symbol_s {
-  /* next */ m2c_symbol_t next;
-  /* ident */ const char *ident;
+  /* ident */ m2c_string_t ident;
   /* kind */ m2c_symtype_t kind;
-  /* type_id */ const char *type_id;
+  /* type_id */ m2c_string_t type_id;
   /* definition */ m2c_astnode_t definition;
+  /* scope */ m2c_symtab_scope_t scope;
+  /* shadowed */ m2c_symbol_t shadowed;
 };
 
 typedef struct m2c_symbol_s m2c_symbol_s;
 
 
 /* --------------------------------------------------------------------------
- * private types m2c_symtab_scope_s and m2c_symtab_scope_t
+ * private types m2c_symbol_chunk_s and m2c_symbol_chunk_t
  * --------------------------------------------------------------------------
- * Record and pointer type representing a symbol table scope.
+ * Record and pointer type representing a chunk of a scope's symbol arena.
+ * Chunks are linked with the most recently allocated chunk first.
  * ----------------------------------------------------------------------- */
 
-typedef struct m2c_symtab_scope_s *m2c_symtab_scope_t;
+typedef struct m2c_symbol_chunk_s *m2c_symbol_chunk_t;
+
+struct m2c_symbol_chunk_s {
+  /* next */ m2c_symbol_chunk_t next;
+  /* used */ uint_t used;
+  /* size */ uint_t size;
+  /* symbol */ m2c_symbol_s symbol[];
+};
+
+typedef struct m2c_symbol_chunk_s m2c_symbol_chunk_s;
+
+
+/* --------------------------------------------------------------------------
+ * private types m2c_symtab_scope_s and m2c_symtab_scope_t
+ * --------------------------------------------------------------------------
+ * Record and pointer type representing a symbol table scope.  The last
+ * chunk in the chunk list is part of the scope allocation.
+ * ----------------------------------------------------------------------- */
 
 struct m2c_symtab_scope_s {
   /* previous */ m2c_symtab_scope_t previous;
-  /* ident */ const char *ident;
-  /* bucket_count */ uint_t bucket_count;
-  /* bucket (table) */ m2c_symbol_t bucket[];
+  /* ident */ m2c_string_t ident;
+  /* symbol_count */ uint_t symbol_count;
+  /* chunk */ m2c_symbol_chunk_t chunk;
 };
 
 typedef struct m2c_symtab_scope_s m2c_symtab_scope_s;
 
 
+/* --------------------------------------------------------------------------
+ * private type m2c_binding_s
+ * --------------------------------------------------------------------------
+ * Record type representing a slot of the binding table.  A slot is empty
+ * if ident is NULL.  Slots are never removed, field innermost is NULL if
+ * no symbol for ident is visible.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* ident */ m2c_string_t ident;
+  /* innermost */ m2c_symbol_t innermost;
+} m2c_binding_s;
+
+
+/* --------------------------------------------------------------------------
+ * private type m2c_snapshot_entry_s
+ * --------------------------------------------------------------------------
+ * Record type representing a slot of a snapshot.  A slot is empty if ident
+ * is NULL.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* ident */ m2c_string_t ident;
+  /* attributes */ m2c_sym_attr_t attributes;
+} m2c_snapshot_entry_s;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_symtab_snapshot_struct_t
+ * --------------------------------------------------------------------------
+ * Record type representing a symbol table snapshot.  Its slots are part of
+ * the snapshot allocation.
+ * ----------------------------------------------------------------------- */
+
+struct m2c_symtab_snapshot_struct_t {
+  /* symbol_count */ uint_t symbol_count;
+  /* capacity */ uint_t capacity;
+  /* entry */ m2c_snapshot_entry_s entry[];
+};
+
+typedef struct m2c_symtab_snapshot_struct_t m2c_symtab_snapshot_struct_t;
+
+
 /* --------------------------------------------------------------------------
  * hidden type m2c_symtab_struct_t
  * --------------------------------------------------------------------------
@@ -114,6 +229,10 @@ struct m2c_symtab_struct_t {
   /* current */ m2c_symtab_scope_t current;
   /* scope_count */ uint_t scope_count;
   /* symbol_count */ uint_t symbol_count;
+  /* binding_count */ uint_t binding_count;
+  /* capacity */ uint_t capacity;
+  /* binding */ m2c_binding_s *binding;
+  /* snapshot */ m2c_symtab_snapshot_t snapshot;
 };
 
 typedef struct m2c_symtab_struct_t m2c_symtab_struct_t;
@@ -123,18 +242,32 @@ typedef struct m2c_symtab_struct_t m2c_symtab_struct_t;
  * forward declarations
  * ----------------------------------------------------------------------- */
 
-typedef uint32_t m2c_hash_t;
+static inline uint_t home_slot (m2c_string_t ident, uint_t mask);
+
+static uint_t binding_probe
+  (m2c_binding_s *binding, uint_t capacity, m2c_string_t ident);
 
-static m2c_hash_t key_for_cstr (const char *cstr);
+static m2c_binding_s *binding_for_ident
+  (m2c_symtab_t symtab, m2c_string_t ident);
 
-static m2c_symbol_t new_symbol (const char *ident,
-  m2c_symtype_t kind, const char *type_id, m2c_astnode_t defn);
+static bool grow_bindings (m2c_symtab_t symtab);
 
-static m2c_symbol_t scope_lookup
-  (m2c_symtab_scope_t scope, const char *ident, m2c_hash_t key);
+static m2c_symbol_t new_symbol (m2c_symtab_scope_t scope,
+  m2c_string_t ident, m2c_symtype_t kind,
+  m2c_string_t type_id, m2c_astnode_t defn);
 
 static void remove_scope (m2c_symtab_t symtab, m2c_symtab_scope_t scope);
 
+static m2c_symtab_t new_symtab
+  (m2c_string_t scope_id, m2c_symtab_snapshot_t snapshot);
+
+static uint_t snapshot_probe
+  (const m2c_symtab_snapshot_struct_t *snapshot, m2c_string_t ident);
+
+static void snapshot_enter
+  (m2c_symtab_snapshot_t snapshot, m2c_string_t ident,
+   const m2c_sym_attr_t *attributes);
+
 
 /* --------------------------------------------------------------------------
  * function m2c_new_symtab(scope_id)
@@ -142,38 +275,91 @@ static void remove_scope (m2c_symtab_t symtab, m2c_symtab_scope_t scope);
  * Allocates and initialises a new symbol table.
  * ----------------------------------------------------------------------- */
 
-m2c_symtab_t m2c_new_symtab (const char *top_level_scope_id) {
+m2c_symtab_t m2c_new_symtab (m2c_string_t top_level_scope_id) {
+  
+  return new_symtab(top_level_scope_id, NULL);
+} /* end m2c_new_symtab */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_new_symtab_w_snapshot(snapshot, scope_id)
+ * --------------------------------------------------------------------------
+ * Allocates and initialises a new symbol table based on snapshot.  Its
+ * first scope is opened with scope_id and nested within the scopes of the
+ * snapshot.  Lookups consult the snapshot for any identifier that has no
+ * visible symbol in the scopes of the new table.  Symbols inserted into
+ * the new table may hide symbols of the snapshot.  The snapshot is not
+ * modified, any number of symbol tables may be based on the same snapshot
+ * and used by different threads at once.  The snapshot must not be
+ * released before all symbol tables based on it.  Returns NULL if
+ * snapshot or scope_id is NULL or if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+m2c_symtab_t m2c_new_symtab_w_snapshot
+  (m2c_symtab_snapshot_t snapshot, m2c_string_t scope_id) {
+  
+  if (snapshot == NULL) {
+    return NULL;
+  } /* end if */
+  
+  return new_symtab(scope_id, snapshot);
+} /* end m2c_new_symtab_w_snapshot */
+
+
+/* --------------------------------------------------------------------------
+ * private function new_symtab(scope_id, snapshot)
+ * --------------------------------------------------------------------------
+ * Allocates and initialises a new symbol table based on snapshot, or on
+ * no snapshot if snapshot is NULL, and opens its first scope.
+ * ----------------------------------------------------------------------- */
+
+static m2c_symtab_t new_symtab
+  (m2c_string_t scope_id, m2c_symtab_snapshot_t snapshot) {
   
   m2c_symtab_t new_table;
   m2c_symtab_status_t status;
   
-  if (top_level_scope_id == NULL) {
+  if (scope_id == NULL) {
     return NULL;
   } /* end if */
   
   /* allocate new table */
-  new_table = malloc(sizeof(m2c_symtab_struct_t));
+  new_table = m2c_alloc(M2C_ALLOC_SYMTABS, sizeof(m2c_symtab_struct_t));
   
   if (new_table == NULL) {
     return NULL;
   } /* end if */
   
+  /* allocate binding table */
+  new_table->binding = m2c_alloc_zeroed(M2C_ALLOC_SYMTABS,
+    M2C_SYMTAB_INITIAL_BINDING_CAPACITY, sizeof(m2c_binding_s));
+  
+  if (new_table->binding == NULL) {
+    m2c_dealloc(M2C_ALLOC_SYMTABS, new_table, sizeof(m2c_symtab_struct_t));
+    return NULL;
+  } /* end if */
+  
   /* initialise table */
   new_table->top = NULL;
   new_table->current = NULL;
   new_table->scope_count = 0;
   new_table->symbol_count = 0;
+  new_table->binding_count = 0;
+  new_table->capacity = M2C_SYMTAB_INITIAL_BINDING_CAPACITY;
+  new_table->snapshot = snapshot;
   
-  /* allocate and initialise top level scope */
-  status = m2c_symtab_open_scope(new_table, top_level_scope_id);
+  /* allocate and initialise first scope */
+  status = m2c_symtab_open_scope(new_table, scope_id);
   
   if (status != M2C_SYMTAB_STATUS_SUCCESS) {
-    free(new_table);
+    m2c_dealloc(M2C_ALLOC_SYMTABS, new_table->binding,
+      new_table->capacity * sizeof(m2c_binding_s));
+    m2c_dealloc(M2C_ALLOC_SYMTABS, new_table, sizeof(m2c_symtab_struct_t));
     return NULL;
   } /* end if */
   
   return new_table;
-} /* end m2c_new_symtab */
+} /* end new_symtab */
 
 
 /* --------------------------------------------------------------------------
@@ -183,10 +369,11 @@ m2c_symtab_t m2c_new_symtab (const char *top_level_scope_id) {
  * ----------------------------------------------------------------------- */
 
 m2c_symtab_status_t m2c_symtab_open_scope
-  (m2c_symtab_t symtab, const char *scope_id) {
+  (m2c_symtab_t symtab, m2c_string_t scope_id) {
   
-  uint_t index, bucket_count;
+  uint_t chunk_size;
   m2c_symtab_scope_t new_scope;
+  m2c_symbol_chunk_t chunk;
   
   if (symtab == NULL) {
     return M2C_SYMTAB_STATUS_INVALID_REFERENCE;
@@ -196,16 +383,17 @@ m2c_symtab_status_t m2c_symtab_open_scope
     return M2C_SYMTAB_STATUS_INVALID_SCOPE;
   } /* end if */
   
-  if (symtab->top == NULL) {
-    bucket_count = M2C_SYMTAB_BUCKET_COUNT_TOPSCOPE;
+  /* the first scope of a table based on a snapshot is a subscope */
+  if ((symtab->top == NULL) && (symtab->snapshot == NULL)) {
+    chunk_size = M2C_SYMTAB_INITIAL_CHUNK_SIZE_TOPSCOPE;
   }
   else {
-    bucket_count = M2C_SYMTAB_BUCKET_COUNT_SUBSCOPE;
+    chunk_size = M2C_SYMTAB_INITIAL_CHUNK_SIZE_SUBSCOPE;
   } /* end if */
   
-  /* allocate new scope */
-  new_scope =
-    malloc(sizeof(m2c_symtab_scope_s) + bucket_count * sizeof(m2c_symbol_t));
+  /* allocate new scope with its first chunk */
+  new_scope = m2c_alloc(M2C_ALLOC_SYMTABS, sizeof(m2c_symtab_scope_s) +
+    sizeof(m2c_symbol_chunk_s) + chunk_size * sizeof(m2c_symbol_s));
   
   if (new_scope == NULL) {
     return M2C_SYMTAB_STATUS_ALLOCATION_FAILED;
@@ -213,12 +401,14 @@ m2c_symtab_status_t m2c_symtab_open_scope
   
   /* initialise scope */
   new_scope->ident = scope_id;
-  new_scope->bucket_count = bucket_count;
+  new_scope->symbol_count = 0;
   
-  /* initialise buckets */
-  for (index = 0; index < bucket_count; index++) {
-    new_scope->bucket[index] = NULL;
-  } /* end for */
+  /* initialise first chunk */
+  chunk = (m2c_symbol_chunk_t) (new_scope + 1);
+  chunk->next = NULL;
+  chunk->used = 0;
+  chunk->size = chunk_size;
+  new_scope->chunk = chunk;
   
   /* link new scope to symbol table */
   if (symtab->top == NULL) {
@@ -246,15 +436,14 @@ m2c_symtab_status_t m2c_symtab_open_scope
 
 m2c_symtab_status_t m2c_symtab_insert
   (m2c_symtab_t symtab,
-   const char *ident,
+   m2c_string_t ident,
    m2c_symtype_t kind,
-   const char *type_id,
+   m2c_string_t type_id,
    m2c_astnode_t definition) {
   
-  uint_t index;
-  m2c_hash_t key;
   m2c_symtab_scope_t scope;
-  m2c_symbol_t prev_symbol, this_symbol;
+  m2c_binding_s *binding;
+  m2c_symbol_t this_symbol;
   
   if (symtab == NULL) {
     return M2C_SYMTAB_STATUS_INVALID_REFERENCE;
@@ -269,38 +458,31 @@ m2c_symtab_status_t m2c_symtab_insert
   if (scope == NULL) {
     return M2C_SYMTAB_STATUS_MISSING_SCOPE;
   } /* end if */
-    
-  /* determine bucket index */
-  key = key_for_cstr(ident);
-  index = key % scope->bucket_count;
   
-  /* get first symbol slot in bucket */
-  this_symbol = scope->bucket[index];
+  binding = binding_for_ident(symtab, ident);
   
-  if /* bucket empty */ (this_symbol == NULL) {
-    this_symbol = new_symbol(ident, kind, type_id, definition);
-    scope->bucket[index] = this_symbol;
-  }
-  else /* bucket not empty */ {
-    /* check if symbol is already in bucket */
-    do /* traverse bucket */ {
-      
-      /* symbol is already present, bail out to avoid duplication */
-      if (this_symbol->ident == ident) {
-        return M2C_SYMTAB_STATUS_IDENT_NOT_UNIQUE;
-      } /* end if */
-      
-      /* move to next symbol */
-      prev_symbol = this_symbol;
-      this_symbol = this_symbol->next;
-    } while (this_symbol != NULL);
-    
-    /* symbol not found in bucket, allocate and add new symbol */
-    this_symbol = new_symbol(ident, kind, type_id, definition);
-    prev_symbol->next = this_symbol;
+  if (binding == NULL) {
+    return M2C_SYMTAB_STATUS_ALLOCATION_FAILED;
   } /* end if */
   
-  /* update counter */
+  /* symbol is already present, bail out to avoid duplication */
+  if ((binding->innermost != NULL) && (binding->innermost->scope == scope)) {
+    return M2C_SYMTAB_STATUS_IDENT_NOT_UNIQUE;
+  } /* end if */
+  
+  /* allocate new symbol from scope's arena */
+  this_symbol = new_symbol(scope, ident, kind, type_id, definition);
+  
+  if (this_symbol == NULL) {
+    return M2C_SYMTAB_STATUS_ALLOCATION_FAILED;
+  } /* end if */
+  
+  /* push new symbol onto the identifier's binding stack */
+  this_symbol->shadowed = binding->innermost;
+  binding->innermost = this_symbol;
+  
+  /* update counters */
+  scope->symbol_count++;
   symtab->symbol_count++;
   
   return M2C_SYMTAB_STATUS_SUCCESS;
@@ -314,11 +496,9 @@ m2c_symtab_status_t m2c_symtab_insert
  * ----------------------------------------------------------------------- */
 
 m2c_symtab_status_t m2c_symtab_lookup
-  (m2c_symtab_t symtab, const char *ident, m2c_sym_attr_t *attributes) {
+  (m2c_symtab_t symtab, m2c_string_t ident, m2c_sym_attr_t *attributes) {
   
-  m2c_hash_t key;
   m2c_symbol_t this_symbol;
-  m2c_symtab_scope_t this_scope;
   
   if (symtab == NULL) {
     return M2C_SYMTAB_STATUS_INVALID_REFERENCE;
@@ -328,32 +508,22 @@ m2c_symtab_status_t m2c_symtab_lookup
     return M2C_SYMTAB_STATUS_INVALID_IDENT;
   } /* end if */
   
-  /* start with current scope */
-  this_scope = symtab->current;
+  /* the innermost visible symbol, empty slots have no symbol */
+  this_symbol = symtab->binding
+    [binding_probe(symtab->binding, symtab->capacity, ident)].innermost;
   
-  key = key_for_cstr(ident);
-  
-  /* iterate over all scopes */
-  while (this_scope != NULL) {
-    /* lookup symbol in this scope */
-    this_symbol = scope_lookup(this_scope, ident, key);
-    
-    /* exit loop if found */
-    if (this_symbol != NULL) {
-      break;
-    } /* end if */
-    
-    /* move to previous scope */
-    this_scope = this_scope->previous;
-  } /* end while */
+  /* fall back to the snapshot the table is based on, if any */
+  if ((this_symbol == NULL) && (symtab->snapshot != NULL)) {
+    return m2c_symtab_snapshot_lookup(symtab->snapshot, ident, attributes);
+  } /* end if */
   
-  if (this_scope == NULL) {
+  if (this_symbol == NULL) {
     return M2C_SYMTAB_STATUS_IDENT_NOT_FOUND;
   } /* end if */
   
   /* pass back symbol's attributes */
   if (attributes != NULL) {
-    (*attributes).scope = this_scope->ident;
+    (*attributes).scope = this_symbol->scope->ident;
     (*attributes).kind = this_symbol->kind;
     (*attributes).type_id = this_symbol->type_id;
     (*attributes).definition = this_symbol->definition;
@@ -367,6 +537,7 @@ m2c_symtab_status_t m2c_symtab_lookup
  * function m2c_symtab_symbol_count(symtab)
  * --------------------------------------------------------------------------
  * Returns the number of symbols currently stored in symbol table symtab.
+ * Symbols of a snapshot symtab is based on are not counted.
  * ----------------------------------------------------------------------- */
 
 uint_t m2c_symtab_symbol_count (m2c_symtab_t symtab) {
@@ -383,6 +554,7 @@ uint_t m2c_symtab_symbol_count (m2c_symtab_t symtab) {
  * function m2c_symtab_scope_count(symtab)
  * --------------------------------------------------------------------------
  * Returns the number of scopes currently open in symbol table symtab.
+ * Scopes of a snapshot symtab is based on are not counted.
  * ----------------------------------------------------------------------- */
 
 uint_t m2c_symtab_scope_count (m2c_symtab_t symtab) {
@@ -402,10 +574,14 @@ uint_t m2c_symtab_scope_count (m2c_symtab_t symtab) {
  * ----------------------------------------------------------------------- */
 
 m2c_symtab_status_t m2c_symtab_close_scope
-  (m2c_symtab_t symtab, const char *scope_id) {
+  (m2c_symtab_t symtab, m2c_string_t scope_id) {
   
   m2c_symtab_scope_t target_scope, this_scope, prev_scope;
   
+  if (symtab == NULL) {
+    return M2C_SYMTAB_STATUS_INVALID_REFERENCE;
+  } /* end if */
+  
   /* determine if scope_id is valid */
   
   /* start with current scope */
@@ -470,92 +646,355 @@ m2c_symtab_status_t m2c_release_symtab (m2c_symtab_t symtab) {
   } /* end while */
   
   symtab->current = NULL;
-  free(symtab);
+  m2c_dealloc(M2C_ALLOC_SYMTABS, symtab->binding,
+    symtab->capacity * sizeof(m2c_binding_s));
+  m2c_dealloc(M2C_ALLOC_SYMTABS, symtab, sizeof(m2c_symtab_struct_t));
   
   return M2C_SYMTAB_STATUS_SUCCESS;
 } /* end m2c_release_symtab */
 
 
+/* --------------------------------------------------------------------------
+ * function m2c_new_symtab_snapshot(symtab)
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated immutable snapshot of the symbols visible in
+ * symtab, including those visible through a snapshot symtab is based on.
+ * The snapshot does not change when symtab is changed or released, but
+ * the strings and AST nodes it refers to must remain valid for as long as
+ * it is used.  A snapshot may be queried by any number of threads at once
+ * without locking.  Returns NULL if symtab is NULL or allocation failed.
+ * ----------------------------------------------------------------------- */
+
+m2c_symtab_snapshot_t m2c_new_symtab_snapshot (m2c_symtab_t symtab) {
+  
+  m2c_symtab_snapshot_t new_snapshot, base;
+  m2c_sym_attr_t attributes;
+  m2c_symbol_t this_symbol;
+  m2c_string_t ident;
+  uint_t index, count, capacity, slot;
+  
+  if (symtab == NULL) {
+    return NULL;
+  } /* end if */
+  
+  base = symtab->snapshot;
+  
+  /* count visible symbols, the table's own hide those of its base */
+  count = 0;
+  for (index = 0; index < symtab->capacity; index++) {
+    if (symtab->binding[index].innermost != NULL) {
+      count++;
+    } /* end if */
+  } /* end for */
+  
+  if (base != NULL) {
+    for (index = 0; index < base->capacity; index++) {
+      ident = base->entry[index].ident;
+      
+      if (ident != NULL) {
+        slot = binding_probe(symtab->binding, symtab->capacity, ident);
+        
+        if (symtab->binding[slot].innermost == NULL) {
+          count++;
+        } /* end if */
+      } /* end if */
+    } /* end for */
+  } /* end if */
+  
+  /* smallest power of two capacity within the load limit */
+  capacity = 16;
+  while ((count * 100) > (capacity * M2C_SYMTAB_MAX_LOAD_PERCENT)) {
+    capacity = 2 * capacity;
+  } /* end while */
+  
+  new_snapshot = m2c_alloc_zeroed(M2C_ALLOC_SYMTABS, 1,
+    sizeof(m2c_symtab_snapshot_struct_t) +
+    capacity * sizeof(m2c_snapshot_entry_s));
+  
+  if (new_snapshot == NULL) {
+    return NULL;
+  } /* end if */
+  
+  new_snapshot->symbol_count = 0;
+  new_snapshot->capacity = capacity;
+  
+  /* copy the innermost visible symbol of each identifier */
+  for (index = 0; index < symtab->capacity; index++) {
+    this_symbol = symtab->binding[index].innermost;
+    
+    if (this_symbol != NULL) {
+      attributes.scope = this_symbol->scope->ident;
+      attributes.kind = this_symbol->kind;
+      attributes.type_id = this_symbol->type_id;
+      attributes.definition = this_symbol->definition;
+      snapshot_enter(new_snapshot, this_symbol->ident, &attributes);
+    } /* end if */
+  } /* end for */
+  
+  /* copy the symbols of the base that are not hidden */
+  if (base != NULL) {
+    for (index = 0; index < base->capacity; index++) {
+      ident = base->entry[index].ident;
+      
+      if (ident != NULL) {
+        slot = binding_probe(symtab->binding, symtab->capacity, ident);
+        
+        if (symtab->binding[slot].innermost == NULL) {
+          snapshot_enter
+            (new_snapshot, ident, &(base->entry[index].attributes));
+        } /* end if */
+      } /* end if */
+    } /* end for */
+  } /* end if */
+  
+  return new_snapshot;
+} /* end m2c_new_symtab_snapshot */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symtab_snapshot_lookup(snapshot, ident, attributes)
+ * --------------------------------------------------------------------------
+ * Looks up the symbol for ident in snapshot and if found, passes back its
+ * attributes.  May be called by any number of threads at once.
+ * ----------------------------------------------------------------------- */
+
+m2c_symtab_status_t m2c_symtab_snapshot_lookup
+  (m2c_symtab_snapshot_t snapshot,
+   m2c_string_t ident,
+   m2c_sym_attr_t *attributes) {
+  
+  uint_t slot;
+  
+  if (snapshot == NULL) {
+    return M2C_SYMTAB_STATUS_INVALID_REFERENCE;
+  } /* end if */
+  
+  if (ident == NULL) {
+    return M2C_SYMTAB_STATUS_INVALID_IDENT;
+  } /* end if */
+  
+  slot = snapshot_probe(snapshot, ident);
+  
+  if (snapshot->entry[slot].ident == NULL) {
+    return M2C_SYMTAB_STATUS_IDENT_NOT_FOUND;
+  } /* end if */
+  
+  /* pass back symbol's attributes */
+  if (attributes != NULL) {
+    *attributes = snapshot->entry[slot].attributes;
+  } /* end if */
+  
+  return M2C_SYMTAB_STATUS_SUCCESS;
+} /* end m2c_symtab_snapshot_lookup */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symtab_snapshot_symbol_count(snapshot)
+ * --------------------------------------------------------------------------
+ * Returns the number of symbols in snapshot, or zero if snapshot is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_symtab_snapshot_symbol_count (m2c_symtab_snapshot_t snapshot) {
+  
+  if (snapshot == NULL) {
+    return 0;
+  } /* end if */
+  
+  return snapshot->symbol_count;
+} /* end m2c_symtab_snapshot_symbol_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_release_symtab_snapshot(snapshot)
+ * --------------------------------------------------------------------------
+ * Deallocates a given snapshot.  No symbol table may be based on it.
+ * ----------------------------------------------------------------------- */
+
+m2c_symtab_status_t m2c_release_symtab_snapshot
+  (m2c_symtab_snapshot_t snapshot) {
+  
+  if (snapshot == NULL) {
+    return M2C_SYMTAB_STATUS_INVALID_REFERENCE;
+  } /* end if */
+  
+  m2c_dealloc(M2C_ALLOC_SYMTABS, snapshot,
+    sizeof(m2c_symtab_snapshot_struct_t) +
+    snapshot->capacity * sizeof(m2c_snapshot_entry_s));
+  
+  return M2C_SYMTAB_STATUS_SUCCESS;
+} /* end m2c_release_symtab_snapshot */
+
+
 /* *********************************************************************** *
  * Private Functions                                                       *
  * *********************************************************************** */
 
 /* --------------------------------------------------------------------------
- * private function key_for_cstr(cstr)
+ * private function home_slot(ident, mask)
  * --------------------------------------------------------------------------
- * Returns hash key for a given NUL terminated C string.
+ * Returns the home slot of ident in a binding table with capacity mask + 1.
+ * Identifiers are interned, their address serves as their key.  The low
+ * bits of an address are always zero, the top bits of the product are
+ * therefore used, folded into the range of mask.
  * ----------------------------------------------------------------------- */
 
-static m2c_hash_t key_for_cstr (const char *cstr) {
+static inline uint_t home_slot (m2c_string_t ident, uint_t mask) {
   
-  m2c_hash_t key;
-  uint_t index;
-  char ch;
-  
-  index = 0;
-  ch = cstr[index];
-  key = HASH_INITIAL;
-  while (ch != ASCII_NUL) {
-    key = HASH_NEXT_CHAR(key, ch);
-    index++;
-    ch = cstr[index];
+  uint64_t key;
+  
+  key = ((uint64_t) (uintptr_t) ident) * HASH_MULTIPLIER;
+  
+  return ((uint_t) (key >> 32)) & mask;
+} /* end home_slot */
+
+
+/* --------------------------------------------------------------------------
+ * private function binding_probe(binding, capacity, ident)
+ * --------------------------------------------------------------------------
+ * Probes binding table binding of the given capacity from the home slot of
+ * ident and returns the index of the slot for ident, or of the first empty
+ * slot if there is no slot for ident.
+ * ----------------------------------------------------------------------- */
+
+static uint_t binding_probe
+  (m2c_binding_s *binding, uint_t capacity, m2c_string_t ident) {
+  
+  uint_t index, mask;
+  
+  mask = capacity - 1;
+  index = home_slot(ident, mask);
+  
+  while ((binding[index].ident != NULL) && (binding[index].ident != ident)) {
+    index = (index + 1) & mask;
   } /* end while */
   
-  return HASH_FINAL(key);
-} /* end key_for_cstr */
+  return index;
+} /* end binding_probe */
 
 
 /* --------------------------------------------------------------------------
- * private function scope_lookup(scope, ident)
+ * private function binding_for_ident(symtab, ident)
  * --------------------------------------------------------------------------
- * Searches ident in scope and returns matching symbol or NULL if not found.
+ * Returns the binding table slot for ident in symtab, claiming an empty
+ * slot if ident has no slot yet.  Returns NULL if allocation fails.
  * ----------------------------------------------------------------------- */
 
-static m2c_symbol_t scope_lookup
-  (m2c_symtab_scope_t scope, const char *ident, m2c_hash_t key) {
+static m2c_binding_s *binding_for_ident
+  (m2c_symtab_t symtab, m2c_string_t ident) {
   
   uint_t index;
-  m2c_symbol_t this_symbol;
+  
+  index = binding_probe(symtab->binding, symtab->capacity, ident);
+  
+  if (symtab->binding[index].ident != NULL) {
+    return &symtab->binding[index];
+  } /* end if */
+  
+  /* grow binding table if its load would exceed the limit */
+  if (((symtab->binding_count + 1) * 100) >
+      (symtab->capacity * M2C_SYMTAB_MAX_LOAD_PERCENT)) {
+    
+    if (grow_bindings(symtab) == false) {
+      return NULL;
+    } /* end if */
     
-  /* determine bucket index */
-  index = key % scope->bucket_count;
+    index = binding_probe(symtab->binding, symtab->capacity, ident);
+  } /* end if */
   
-  this_symbol = scope->bucket[index];
+  symtab->binding[index].ident = ident;
+  symtab->binding[index].innermost = NULL;
+  symtab->binding_count++;
   
-  while ((this_symbol != NULL) && (this_symbol->ident != ident)) {
-    this_symbol = this_symbol->next;
-  } /* end while */
+  return &symtab->binding[index];
+} /* end binding_for_ident */
+
+
+/* --------------------------------------------------------------------------
+ * private function grow_bindings(symtab)
+ * --------------------------------------------------------------------------
+ * Rehashes all slots of the binding table of symtab into a table of twice
+ * the capacity.  Returns true on success.  Returns false and leaves symtab
+ * unchanged if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static bool grow_bindings (m2c_symtab_t symtab) {
+  
+  m2c_binding_s *new_binding;
+  uint_t index, new_index, new_capacity;
   
-  return this_symbol;
-} /* end scope_lookup */
+  new_capacity = 2 * symtab->capacity;
+  new_binding =
+    m2c_alloc_zeroed(M2C_ALLOC_SYMTABS, new_capacity, sizeof(m2c_binding_s));
+  
+  if (new_binding == NULL) {
+    return false;
+  } /* end if */
+  
+  /* move slots, using the addresses of their identifiers */
+  for (index = 0; index < symtab->capacity; index++) {
+    if (symtab->binding[index].ident != NULL) {
+      new_index = binding_probe
+        (new_binding, new_capacity, symtab->binding[index].ident);
+      new_binding[new_index] = symtab->binding[index];
+    } /* end if */
+  } /* end for */
+  
+  m2c_dealloc(M2C_ALLOC_SYMTABS, symtab->binding,
+    symtab->capacity * sizeof(m2c_binding_s));
+  symtab->binding = new_binding;
+  symtab->capacity = new_capacity;
+  
+  return true;
+} /* end grow_bindings */
 
 
 /* --------------------------------------------------------------------------
- * private function new_symbol(ident, kind, type_id, defn)
+ * private function new_symbol(scope, ident, kind, type_id, defn)
  * --------------------------------------------------------------------------
- * Returns a newly allocated symbol, initialised with parameters ident, kind,
- * type_id and defn.  Returns NULL if allocation fails.
+ * Returns a new symbol from the arena of scope, initialised with parameters
+ * ident, kind, type_id and defn.  When the current chunk is full, a new
+ * chunk as large as the number of symbols in scope is added.  Returns NULL
+ * if allocation fails.
  * ----------------------------------------------------------------------- */
 
 static m2c_symbol_t new_symbol
-  (const char *ident,
+  (m2c_symtab_scope_t scope,
+   m2c_string_t ident,
    m2c_symtype_t kind,
-   const char *type_id,
+   m2c_string_t type_id,
    m2c_astnode_t defn) {
   
+  m2c_symbol_chunk_t chunk;
   m2c_symbol_t new_sym;
+  uint_t size;
   
-  new_sym = malloc(sizeof(m2c_symbol_s));
+  chunk = scope->chunk;
   
-  if (new_sym == NULL) {
-    return NULL;
+  /* add a new chunk if current chunk is full */
+  if (chunk->used == chunk->size) {
+    size = scope->symbol_count;
+    chunk = m2c_alloc(M2C_ALLOC_SYMTABS,
+      sizeof(m2c_symbol_chunk_s) + size * sizeof(m2c_symbol_s));
+    
+    if (chunk == NULL) {
+      return NULL;
+    } /* end if */
+    
+    chunk->next = scope->chunk;
+    chunk->used = 0;
+    chunk->size = size;
+    scope->chunk = chunk;
   } /* end if */
   
-  new_sym->next = NULL;
+  new_sym = &chunk->symbol[chunk->used];
+  chunk->used++;
+  
   new_sym->ident = ident;
   new_sym->kind = kind;
   new_sym->type_id = type_id;
   new_sym->definition = defn;
+  new_sym->scope = scope;
+  new_sym->shadowed = NULL;
   
   return new_sym;
 } /* end new_symbol */
@@ -564,32 +1003,92 @@ static m2c_symbol_t new_symbol
 /* --------------------------------------------------------------------------
  * private function remove_scope(symtab, scope)
  * --------------------------------------------------------------------------
- * Deallocates a given scope.  Updates counters of symtab.
+ * Pops the symbols of scope off their binding stacks, then deallocates
+ * scope with its symbol arena.  Updates counters of symtab.  Scopes must
+ * be removed innermost first.
  * ----------------------------------------------------------------------- */
 
 static void remove_scope (m2c_symtab_t symtab, m2c_symtab_scope_t scope) {
   
-  uint_t index;
-  m2c_symbol_t this_symbol, next_symbol;
-  
-  for (index = 0; index < scope->bucket_count; index++) {
-    /* get first symbol slot in bucket */
-    this_symbol = scope->bucket[index];
-    
-    /* remove all entries in bucket */
-    while (this_symbol != NULL) {
-      next_symbol = this_symbol->next;
-      free(this_symbol);
-      symtab->symbol_count--;
-      this_symbol = next_symbol;
-    } /* end while */
+  m2c_symbol_chunk_t this_chunk, next_chunk;
+  m2c_symbol_t this_symbol;
+  uint_t index, slot, first_size;
+  
+  this_chunk = scope->chunk;
+  first_size = 0;
+  
+  while (this_chunk != NULL) {
+    /* restore the bindings shadowed by this chunk's symbols */
+    for (index = 0; index < this_chunk->used; index++) {
+      this_symbol = &this_chunk->symbol[index];
+      slot = binding_probe
+        (symtab->binding, symtab->capacity, this_symbol->ident);
+      symtab->binding[slot].innermost = this_symbol->shadowed;
+    } /* end for */
     
-    /* clear first symbol slot */
-    scope->bucket[index] = NULL;
-  } /* end for */
+    /* the last chunk in the list is part of the scope allocation */
+    next_chunk = this_chunk->next;
+    if (next_chunk != NULL) {
+      m2c_dealloc(M2C_ALLOC_SYMTABS, this_chunk,
+        sizeof(m2c_symbol_chunk_s) + this_chunk->size * sizeof(m2c_symbol_s));
+    }
+    else {
+      first_size = this_chunk->size;
+    } /* end if */
+    this_chunk = next_chunk;
+  } /* end while */
   
-  free(scope);
+  symtab->symbol_count = symtab->symbol_count - scope->symbol_count;
+  
+  m2c_dealloc(M2C_ALLOC_SYMTABS, scope, sizeof(m2c_symtab_scope_s) +
+    sizeof(m2c_symbol_chunk_s) + first_size * sizeof(m2c_symbol_s));
   symtab->scope_count--;
 } /* end remove_scope */
 
-/* END OF FILE */
\ No newline at end of file
+
+/* --------------------------------------------------------------------------
+ * private function snapshot_probe(snapshot, ident)
+ * --------------------------------------------------------------------------
+ * Probes snapshot from the home slot of ident and returns the index of the
+ * slot for ident, or of the first empty slot if there is no slot for it.
+ * ----------------------------------------------------------------------- */
+
+static uint_t snapshot_probe
+  (const m2c_symtab_snapshot_struct_t *snapshot, m2c_string_t ident) {
+  
+  uint_t index, mask;
+  
+  mask = snapshot->capacity - 1;
+  index = home_slot(ident, mask);
+  
+  while ((snapshot->entry[index].ident != NULL) &&
+         (snapshot->entry[index].ident != ident)) {
+    index = (index + 1) & mask;
+  } /* end while */
+  
+  return index;
+} /* end snapshot_probe */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure snapshot_enter(snapshot, ident, attributes)
+ * --------------------------------------------------------------------------
+ * Enters ident with attributes into a snapshot that is being built.  The
+ * snapshot must have a free slot and must not hold ident yet.
+ * ----------------------------------------------------------------------- */
+
+static void snapshot_enter
+  (m2c_symtab_snapshot_t snapshot, m2c_string_t ident,
+   const m2c_sym_attr_t *attributes) {
+  
+  uint_t slot;
+  
+  slot = snapshot_probe(snapshot, ident);
+  
+  snapshot->entry[slot].ident = ident;
+  snapshot->entry[slot].attributes = *attributes;
+  snapshot->symbol_count++;
+  
+} /* end snapshot_enter */
+
+/* END OF FILE */
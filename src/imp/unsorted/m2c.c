@@ -33,16 +33,46 @@
  * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
  */
 
+#include "m2-fifo.h"
+#include "cstring.h"
 #include "fileutils.h"
+#include "m2-dircache.h"
 #include "m2-lexer.h"
 #include "m2-error.h"
 #include "m2-parser.h"
+#include "m2-ast.h"
+#include "m2-astwriter.h"
+#include "m2-dotwriter.h"
+#include "m2-ast-parallel.h"
+#include "m2-ast-view.h"
+#include "m2-symfile.h"
+#include "m2-c99writer.h"
+#include "m2-r10writer.h"
 #include "m2-pathnames.h"
+#include "m2-workpool.h"
+#include "m2-readahead.h"
 #include "m2-unique-string.h"
 #include "m2-compiler-options.h"
+#include "m2-phase-timing.h"
+#include "m2-trace-probes.h"
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+/* --------------------------------------------------------------------------
+ * Local sockets are required for server mode
+ * ----------------------------------------------------------------------- */
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#define M2C_SERVER_MODE 1
+#else
+#define M2C_SERVER_MODE 0
+#endif
 
 
 #define M2C_IDENTIFICATION "m2c Modula-2 Compiler & Translator"
@@ -56,6 +86,155 @@
   "licensed under the GNU Lesser General Public License v.2 and v.3"
 
 
+/* --------------------------------------------------------------------------
+ * Maximum line length of a batch list file
+ * ----------------------------------------------------------------------- */
+
+#define M2C_BATCH_MAX_LINE_LENGTH 1024
+
+
+/* --------------------------------------------------------------------------
+ * Number of sources read ahead per worker in batch mode
+ * ----------------------------------------------------------------------- */
+
+#define M2C_BATCH_READ_AHEAD_PER_WORKER 2
+
+
+/* --------------------------------------------------------------------------
+ * Maximum length of a server request, pending connections, cache capacity
+ * ----------------------------------------------------------------------- */
+
+#define M2C_SERVER_MAX_REQUEST_LENGTH 1024
+
+#define M2C_SERVER_BACKLOG 8
+
+#define M2C_SERVER_INITIAL_CACHE_CAPACITY 64
+
+
+/* --------------------------------------------------------------------------
+ * Symbol file suffix
+ * --------------------------------------------------------------------------
+ * Symbol files are named after their definition module with this suffix in
+ * all modes, so that a symbol file written in one mode is found by all.
+ * ----------------------------------------------------------------------- */
+
+#define M2C_SYMFILE_SUFFIX ".def.sym"
+
+
+/* --------------------------------------------------------------------------
+ * M2R10 translation suffixes
+ * --------------------------------------------------------------------------
+ * M2R10 translations are written under option r10-output.  Their suffixes
+ * end other than in .def or .mod, so that a translation in a directory of
+ * sources is not taken for a source itself.
+ * ----------------------------------------------------------------------- */
+
+#define M2C_R10_DEF_SUFFIX ".def.r10"
+
+#define M2C_R10_MOD_SUFFIX ".mod.r10"
+
+
+/* --------------------------------------------------------------------------
+ * Translation cache
+ * --------------------------------------------------------------------------
+ * In batch mode, a stamp file with suffix M2C_CACHE_STAMP_SUFFIX is written
+ * next to the output files of each source translated without errors once all
+ * its outputs have been written.  It records the cache key of the
+ * translation: a 64-bit FNV-1a hash of the source contents, seeded with the
+ * option fingerprint and combined with the interfaces of the definition
+ * modules the source depends on.  A source whose key matches its stamp is
+ * not translated again, its previous outputs are reused.  The interface of a
+ * definition module combines the fingerprint recorded in its symbol file
+ * with the interfaces of its own prerequisites.  A change to a transitively
+ * imported definition module therefore only invalidates its clients if it
+ * changes what the module exports, edits to comments, layout or the order
+ * of declarations do not.
+ * ----------------------------------------------------------------------- */
+
+#define M2C_CACHE_STAMP_SUFFIX ".key"
+
+#define M2C_CACHE_HASH_OFFSET 14695981039346656037ULL
+
+#define M2C_CACHE_HASH_PRIME 1099511628211ULL
+
+#define M2C_CACHE_READ_BUFFER_SIZE 65536
+
+
+/* --------------------------------------------------------------------------
+ * private type m2c_batch_job_s
+ * --------------------------------------------------------------------------
+ * record type representing the translation of one source file in batch
+ * mode.  Field module holds the module identifier and field imports the
+ * identifiers of imported modules found by the import pre-scan.  Field
+ * dependents holds the jobs that must wait for this job, prerequisites the
+ * jobs this job must wait for and wait_count the number of those that are
+ * still unfinished.  Field key holds the cache key, zero if the source
+ * cannot be cached.  Field interface holds the interface of a definition
+ * module once it is done, zero if unknown.  Field read_index holds the
+ * position of the source in the read-ahead list of the batch.  The result
+ * fields are written by the worker carrying out the job.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_batch_job_s m2c_batch_job_s;
+
+struct m2c_batch_job_s {
+  /* srcpath */ const char *srcpath;
+  /* basename */ const char *basename;
+  /* srctype */ m2c_sourcetype_t srctype;
+  /* size */ long int size;
+  /* module */ m2c_string_t module;
+  /* imports */ m2c_fifo_t imports;
+  /* dependents */ m2c_fifo_t dependents;
+  /* prerequisites */ m2c_fifo_t prerequisites;
+  /* wait_count */ uint_t wait_count;
+  /* read_index */ uint_t read_index;
+  /* key */ uint64_t key;
+  /* interface */ uint64_t interface;
+  /* done */ bool done;
+  /* stats */ m2c_stats_t stats;
+  /* status */ m2c_parser_status_t status;
+};
+
+
+/* --------------------------------------------------------------------------
+ * private type m2c_batch_s
+ * --------------------------------------------------------------------------
+ * record type representing the set of source files to translate in batch
+ * mode.  Field dirpath holds the directory being read, if any.  Field
+ * timing_file holds the file phase times are appended to, or NULL if phase
+ * times are not requested.  Field readahead holds the read-ahead object
+ * loading the sources ahead of translation, or NULL if none is available,
+ * and field read_list the list of source paths it loads, or NULL.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* workdir */ const char *workdir;
+  /* dirpath */ const char *dirpath;
+  /* timing_file */ FILE *timing_file;
+  /* readahead */ m2c_readahead_t readahead;
+  /* read_list */ const char **read_list;
+  /* job_count */ uint_t job_count;
+  /* capacity */ uint_t capacity;
+  /* job */ m2c_batch_job_s *job;
+} m2c_batch_s;
+
+
+/* --------------------------------------------------------------------------
+ * private type m2c_import_dir_s
+ * --------------------------------------------------------------------------
+ * record type representing the location of the symbol files of imported
+ * modules, named after the module with the given suffix in dirpath.  Field
+ * listing holds a listing cache of dirpath, or NULL if dirpath may change
+ * while imports are loaded.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* dirpath */ const char *dirpath;
+  /* suffix */ const char *suffix;
+  /* listing */ m2c_dircache_t listing;
+} m2c_import_dir_s;
+
+
 static void print_identification(void) {
   printf(M2C_IDENTIFICATION ", " M2C_VERSION_INFO "\n");
 } /* end print_identification */
@@ -79,6 +258,9 @@ static void print_license(void) {
 static void print_usage(void) {
   printf("usage:\n");
   printf(" m2c sourcefile [options]\n");
+  printf(" m2c directory [options]\n");
+  printf(" m2c @listfile [options]\n");
+  printf(" m2c socketpath --server [options]\n");
 } /* end print_usage */
 
 
@@ -105,50 +287,62 @@ static void exit_with_version(void) {
 } /* end exit_with_version */
 
 
+static int translate_batch (const char *argpath);
+
+static int run_batch (m2c_batch_s *batch);
+
+static void release_batch (m2c_batch_s *batch);
+
+static int serve_requests (const char *sockpath);
+
+static bool find_source
+  (const char *srcpath, m2c_sourcetype_t *srctype, const char **basename);
+
+static int translate_source
+  (m2c_sourcetype_t srctype, const char *srcpath, const char *basename,
+   m2c_c99_import_loader_f load, void *context, m2c_phase_timing_t *timing);
+
+static m2c_symfile_t load_import (const char *module, void *context);
+
+static void write_timing (const char *srcpath, m2c_phase_timing_t *timing);
+
+static void report_write_failure
+  (const char *output, const char *path, m2c_stats_t *stats);
+
+static void parse_and_stream_ast
+  (m2c_sourcetype_t srctype, const char *srcpath, const char *astpath,
+   m2c_stats_t *stats, m2c_parser_status_t *status);
+
+
 int main (int argc, char *argv[]) {
   /* path of working directory */
   const char *workdir = NULL;
   
   /* full path to source file */
   const char *srcpath = NULL;
-
-  /* directory path of srcpath */
-  const char *dirpath = NULL;
-  
-  /* filename of srcpath */
-  const char *filename = NULL;
   
   /* source file's base name excluding suffix */
   const char *basename = NULL;
   
-  /* source file's suffix */
-  const char *suffix = NULL;
-  
-  /* path to log file */
-  const char *logpath = NULL;
-  
-  /* path to AST output file */
-  const char *astpath = NULL;
-  
-  /* path to DOT output file */
-  const char *dotpath = NULL;
+  /* phase times, clock value at the start of the current phase */
+  m2c_phase_timing_t timing;
+  uint64_t clock_value;
   
-  /* path to SYM output file */
-  const char *sympath = NULL;
-  
-  /* path to C output file */
-  const char *tgtpath = NULL;
-  
-  uint_t index;
-  m2c_stats_t stats;
+  m2c_sourcetype_t srctype;
   m2c_option_status_t cli_status;
-  m2c_parser_status_t parser_status;
-  m2c_pathname_status_t pathname_status;
+  m2c_ast_arena_t arena;
+  int status;
   
   if (argc < 2) {
     exit_with_usage();
   } /* end if */
   
+  /* register trace probes, if compiled in */
+  m2c_trace_probes_init();
+  
+  m2c_phase_timing_reset(&timing);
+  clock_value = m2c_phase_clock();
+  
   /* get command line arguments and filename */
   srcpath = m2c_get_cli_args(argc, argv, &cli_status);
   
@@ -163,103 +357,354 @@ int main (int argc, char *argv[]) {
     exit_with_version();
   } /* end if */
   
+  /* set up error budget and diagnostic format */
+  m2c_set_error_limit(m2c_option_max_errors());
+  
+  if (m2c_option_machine_diagnostics()) {
+    m2c_set_diagnostic_format(M2C_DIAGNOSTIC_FORMAT_MACHINE);
+  } /* end if */
+  
+  clock_value = m2c_phase_timing_add(&timing, M2C_PHASE_OPTIONS, clock_value);
+  
   /* check source path validity */
   if ((srcpath == NULL) || (srcpath[0] == ASCII_NUL)) {
     m2c_emit_error(M2C_ERROR_MISSING_FILENAME);
     exit(EXIT_FAILURE);
   } /* end if */
   
-  /* get directory path and filename */
-  pathname_status = split_pathname(srcpath, &dirpath, &filename, &index);
-    
-  if (pathname_status == M2C_PATHNAME_STATUS_INVALID_PATH) {
-    m2c_emit_error_w_str(M2C_ERROR_INVALID_FILENAME, srcpath);
-    exit(EXIT_FAILURE);
+  /* server mode, the path in place of a source names the socket */
+  if (m2c_option_server()) {
+    return serve_requests(srcpath);
   } /* end if */
   
-  if ((filename == NULL) || (filename[0] == ASCII_NUL)) {
-    m2c_emit_error_w_str(M2C_ERROR_INVALID_FILENAME, srcpath);
+  /* batch mode for a directory or a list file */
+  if ((srcpath[0] == '@') || (is_directory(srcpath))) {
+    return translate_batch(srcpath);
+  } /* end if */
+  
+  /* get source type and basename */
+  if (NOT(find_source(srcpath, &srctype, &basename))) {
     exit(EXIT_FAILURE);
   } /* end if */
   
-  /* get basename and suffix */
-  pathname_status = split_filename(filename, &basename, &suffix, &index);
+  /* get working directory, obtained once per process */
+  workdir = current_workdir();
   
-  if (pathname_status == M2C_PATHNAME_STATUS_INVALID_FILENAME) {
-    m2c_emit_error_w_str(M2C_ERROR_INVALID_FILENAME, filename);
+  if (workdir == NULL) {
+    printf("unable to get current working directory.\n");
     exit(EXIT_FAILURE);
   } /* end if */
   
-  if ((basename == NULL) || (basename[0] == ASCII_NUL)) {
-    m2c_emit_error_w_str(M2C_ERROR_INVALID_FILENAME, filename);
-    exit(EXIT_FAILURE);
+  m2c_phase_timing_add(&timing, M2C_PHASE_PATHS, clock_value);
+  
+  /* initialise string repo, strings live until translation is done,
+   * a pipelined lexer and procedures parsed on workers intern strings
+   * on threads of their own */
+  if ((m2c_option_pipeline()) || (m2c_option_parallel_parse())) {
+    m2c_init_string_repository_w_mode(0, M2C_STRING_ALLOC_CONCURRENT, NULL);
+  }
+  else {
+    m2c_init_string_repository_w_mode(0, M2C_STRING_ALLOC_ARENA, NULL);
+  } /* end if */
+  
+  /* allocate AST nodes from an arena, released when translation is done,
+   * streamed nodes are released as soon as they have been written */
+  arena = NULL;
+  if (NOT(m2c_option_stream_ast())) {
+    arena = m2c_ast_new_arena();
+    m2c_ast_set_arena(arena);
+  } /* end if */
+  
+  /* print banner */
+  print_identification();
+  
+  if (m2c_option_parser_debug()) {
+    m2c_print_options();
+  } /* end if */
+  
+  status =
+    translate_source(srctype, srcpath, basename, NULL, NULL, &timing);
+  
+  /* release the AST, the basename and the strings */
+  if (arena != NULL) {
+    m2c_ast_set_arena(NULL);
+    m2c_ast_release_arena(arena);
+  } /* end if */
+  
+  free((void *) basename);
+  m2c_dispose_string_repository(NULL);
+  
+  return status;
+} /* end main */
+
+
+/* --------------------------------------------------------------------------
+ * private function find_source(srcpath, srctype, basename)
+ * --------------------------------------------------------------------------
+ * Verifies that srcpath is the pathname of an existing Modula-2 source file
+ * with suffix .def or .mod.  If so, passes back its source type in srctype
+ * and a newly allocated copy of its basename in basename and returns true.
+ * Otherwise emits an error and returns false.
+ * ----------------------------------------------------------------------- */
+
+static bool find_source
+  (const char *srcpath, m2c_sourcetype_t *srctype, const char **basename) {
+  
+  /* offsets of the components of srcpath */
+  m2c_path_view_t view;
+  
+  /* filename and suffix of srcpath, point into srcpath */
+  const char *filename, *suffix;
+  
+  m2c_pathname_status_t pathname_status;
+  uint_t index;
+  
+  /* get filename, basename and suffix without copying them */
+  pathname_status = split_pathname_view(srcpath, &view, &index);
+    
+  if (pathname_status != M2C_PATHNAME_STATUS_SUCCESS) {
+    m2c_emit_error_w_str(M2C_ERROR_INVALID_FILENAME, srcpath);
+    return false;
+  } /* end if */
+  
+  filename = srcpath + view.filename;
+  suffix = srcpath + view.suffix;
+  
+  if ((filename[0] == ASCII_NUL) || (view.suffix == view.filename)) {
+    m2c_emit_error_w_str(M2C_ERROR_INVALID_FILENAME, srcpath);
+    return false;
   } /* end if */
     
   /* check suffix validity */
-  if (suffix == NULL) {
+  if (suffix[0] == ASCII_NUL) {
     m2c_emit_error(M2C_ERROR_INVALID_FILENAME_SUFFIX);
-    exit(EXIT_FAILURE);
+    return false;
   }
   else if (is_def_suffix(suffix)) {
-    srctype = M2C_DEF_SOURCE;
+    *srctype = M2C_DEF_SOURCE;
   }
   else if (is_mod_suffix(suffix)) {
-    srctype = M2C_MOD_SOURCE;
+    *srctype = M2C_MOD_SOURCE;
   }
   else /* invalid suffix */ {
     m2c_emit_error(M2C_ERROR_INVALID_FILENAME_SUFFIX);
-    exit(EXIT_FAILURE);
+    return false;
   } /* end if */
     
   /* check source file availability */
   if (NOT(file_exists(srcpath))) {
-    m2c_emit_error_w_str(M2C_ERROR_INPUT_FILE_NOT_FOUND, path);
-    exit(EXIT_FAILURE);
+    m2c_emit_error_w_str(M2C_ERROR_INPUT_FILE_NOT_FOUND, srcpath);
+    return false;
   } /* end if */
-    
-  /* get working directory */
-  workdir = new_path_w_current_working_directory();
   
-  if (workdir == NULL) {
-    printf("unable to get current working directory.\n");
-    exit(EXIT_FAILURE);
+  /* the only component copied, output paths need it NUL terminated */
+  *basename =
+    new_cstr_from_slice(srcpath, view.filename, view.suffix - view.filename);
+  
+  if (*basename == NULL) {
+    printf("unable to allocate memory.\n");
+    return false;
   } /* end if */
   
-  /* initialise string repo */
-  m2c_init_string_repository(0, NULL);
+  return true;
+} /* end find_source */
+
+
+/* --------------------------------------------------------------------------
+ * private function translate_source(srctype, srcpath, basename, ...)
+ * --------------------------------------------------------------------------
+ * Parses the source at srcpath and writes its outputs to the working
+ * directory, named after basename.  Imported symbol files are obtained
+ * from import loader load with context, or if load is NULL, from a listing
+ * of the working directory made for this translation.  Phase times are
+ * added to timing and appended to the timing file if requested.  Prints
+ * statistics.  Returns EXIT_SUCCESS if the source was translated without
+ * errors, otherwise EXIT_FAILURE.
+ * ----------------------------------------------------------------------- */
+
+static int translate_source
+  (m2c_sourcetype_t srctype, const char *srcpath, const char *basename,
+   m2c_c99_import_loader_f load, void *context, m2c_phase_timing_t *timing) {
   
-  /* print banner */
-  print_identification();
+  /* path of working directory */
+  const char *workdir;
   
-  if (m2c_option_parser_debug()) {
-    m2c_print_options();
+  /* paths to AST, DOT, SYM, C and M2R10 output files */
+  const char *astpath, *dotpath, *sympath, *tgtpath, *r10path;
+  
+  /* source spans and comments, recorded for the M2R10 writer */
+  m2c_span_table_t spans;
+  m2c_comment_table_t comments;
+  
+  /* location of imported symbol files */
+  m2c_import_dir_s imports;
+  
+  /* clock value at the start of the current phase */
+  uint64_t clock_value;
+  
+  m2c_ast_t ast;
+  long int size;
+  bool translatable;
+  m2c_stats_t stats;
+  m2c_parser_status_t parser_status;
+  m2c_r10writer_status_t r10_status;
+  m2c_ast_view_t view;
+  
+  workdir = current_workdir();
+  dotpath = NULL;
+  sympath = NULL;
+  tgtpath = NULL;
+  r10path = NULL;
+  spans = NULL;
+  comments = NULL;
+  
+  if (get_filesize(srcpath, &size)) {
+    timing->bytes = (uint64_t) size;
   } /* end if */
   
   printf("processing %s\n", srcpath);
   
   /* run parser on input */
-  m2c_parse_file(srctype, srcpath, &ast, &stats, &parser_status);
+  ast = NULL;
+  clock_value = m2c_phase_clock();
+  astpath = new_path_w_components(workdir, basename, ".ast");
+  clock_value = m2c_phase_timing_add(timing, M2C_PHASE_PATHS, clock_value);
+  
+  if (m2c_option_stream_ast()) {
+    /* write AST in S-expression format while parsing,
+     * loading, lexing and writing are timed as part of parsing */
+    printf("writing AST to %s\n", astpath);
+    parse_and_stream_ast(srctype, srcpath, astpath, &stats, &parser_status);
+    m2c_phase_timing_add(timing, M2C_PHASE_PARSE, clock_value);
+  }
+  else if (m2c_option_r10_output()) {
+    /* the M2R10 writer copies source text through by span,
+     * loading, lexing and recording are timed as part of parsing */
+    spans = m2c_new_span_table();
+    comments = m2c_new_comment_table();
+    m2c_parse_file_w_comments
+      (srctype, srcpath, &ast, spans, comments, &stats, &parser_status);
+    m2c_phase_timing_add(timing, M2C_PHASE_PARSE, clock_value);
+  }
+  else {
+    m2c_parse_file_w_timing
+      (srctype, srcpath, &ast, timing, &stats, &parser_status);
+  } /* end if */
+  
+  m2c_flush_diagnostics();
+  
+  /* outputs derived from the AST require a source without errors */
+  translatable = (ast != NULL) && (m2c_stats_errors(stats) == 0);
   
   /* write AST to file */
   if (ast != NULL) {
     /* write AST in S-expression format */
-    astpath = new_path_w_components(workdir, basename, ".ast", NULL);
+    clock_value = m2c_phase_clock();
     printf("writing AST to %s\n", astpath);
     m2c_ast_write_tree(astpath, ast);
+    clock_value =
+      m2c_phase_timing_add(timing, M2C_PHASE_WRITE_AST, clock_value);
     
     /* write AST in graphviz DOT format */
-    dotpath = new_path_w_components(workdir, basename, ".dot", NULL);
+    dotpath = new_path_w_components(workdir, basename, ".dot");
+    clock_value = m2c_phase_timing_add(timing, M2C_PHASE_PATHS, clock_value);
     printf("writing AST graph to %s\n", dotpath);
     m2c_ast_draw_tree(dotpath, ast);
+    clock_value =
+      m2c_phase_timing_add(timing, M2C_PHASE_WRITE_DOT, clock_value);
+    
+    /* write symbol file for importing modules */
+    if ((srctype == M2C_DEF_SOURCE) && (translatable)) {
+      sympath = new_path_w_components(workdir, basename, M2C_SYMFILE_SUFFIX);
+      clock_value =
+        m2c_phase_timing_add(timing, M2C_PHASE_PATHS, clock_value);
+      printf("writing symbols to %s\n", sympath);
+      if (m2c_symfile_write(sympath, srcpath, ast, NULL) !=
+          M2C_FILEIO_STATUS_SUCCESS) {
+        report_write_failure("symbols", sympath, &stats);
+      } /* end if */
+      m2c_phase_timing_add(timing, M2C_PHASE_WRITE_SYM, clock_value);
+    } /* end if */
+  } /* end if */
+  
+  /* write C translation */
+  if (translatable) {
+    clock_value = m2c_phase_clock();
+    imports.listing = NULL;
+    
+    /* without a loader, symbol files are looked up in a fresh listing */
+    if (load == NULL) {
+      imports.dirpath = workdir;
+      imports.suffix = M2C_SYMFILE_SUFFIX;
+      imports.listing = m2c_new_dircache(workdir);
+      load = load_import;
+      context = &imports;
+    } /* end if */
+    
+    if (srctype == M2C_DEF_SOURCE) {
+      tgtpath = new_path_w_components(workdir, basename, ".h");
+    }
+    else {
+      tgtpath = new_path_w_components(workdir, basename, ".c");
+    } /* end if */
+    
+    clock_value = m2c_phase_timing_add(timing, M2C_PHASE_PATHS, clock_value);
+    printf("writing C to %s\n", tgtpath);
+    
+    /* each backend reads a view of its own, the AST stays unmodified */
+    view = m2c_ast_new_view(ast);
+    if (m2c_c99_write_view(tgtpath, view, NULL, load, context, NULL) !=
+        M2C_FILEIO_STATUS_SUCCESS) {
+      report_write_failure("C", tgtpath, &stats);
+    } /* end if */
+    m2c_ast_release_view(view);
+    m2c_release_dircache(&imports.listing);
+    m2c_phase_timing_add(timing, M2C_PHASE_WRITE_C, clock_value);
+  } /* end if */
+  
+  /* write M2R10 translation */
+  if ((translatable) && (m2c_option_r10_output())) {
+    clock_value = m2c_phase_clock();
+    
+    if (srctype == M2C_DEF_SOURCE) {
+      r10path = new_path_w_components(workdir, basename, M2C_R10_DEF_SUFFIX);
+    }
+    else {
+      r10path = new_path_w_components(workdir, basename, M2C_R10_MOD_SUFFIX);
+    } /* end if */
+    
+    clock_value = m2c_phase_timing_add(timing, M2C_PHASE_PATHS, clock_value);
+    printf("writing M2R10 to %s\n", r10path);
+    view = m2c_ast_new_view(ast);
+    m2c_r10_write_view(r10path, srcpath, view, spans, comments, &r10_status);
+    if (r10_status != M2C_R10WRITER_STATUS_SUCCESS) {
+      report_write_failure("M2R10", r10path, &stats);
+    } /* end if */
+    m2c_ast_release_view(view);
+    m2c_phase_timing_add(timing, M2C_PHASE_WRITE_R10, clock_value);
   } /* end if */
   
-  /* TO DO: semantic analysis and final code generation */
+  m2c_release_span_table(&spans);
+  m2c_release_comment_table(&comments);
+  
+  /* TO DO: semantic analysis */
   
   /* print statistics */
   printf("warnings: %u\n", m2c_stats_warnings(stats));
   printf("errors: %u\n", m2c_stats_errors(stats));
   printf("lines: %u\n", m2c_stats_lines(stats));
   
+  /* append phase times if requested */
+  if (m2c_option_timing()) {
+    write_timing(srcpath, timing);
+  } /* end if */
+  
+  free((void *) astpath);
+  free((void *) dotpath);
+  free((void *) sympath);
+  free((void *) tgtpath);
+  free((void *) r10path);
+  
   /* pass status code to caller */
   if (m2c_stats_errors(stats) == 0) {
     return EXIT_SUCCESS;
@@ -267,6 +712,1830 @@ int main (int argc, char *argv[]) {
   else /* errors occurred */ {
     return EXIT_FAILURE;
   } /* end if */
-} /* end main */
+} /* end translate_source */
+
+
+/* --------------------------------------------------------------------------
+ * private function load_import(module, context)
+ * --------------------------------------------------------------------------
+ * Import loader for the C99 writer, loads the symbol file of module from
+ * the import directory passed in context.  Returns NULL if the symbol file
+ * does not exist or cannot be loaded.  If the import directory has a
+ * listing cache, missing symbol files are detected without a file system
+ * access.
+ * ----------------------------------------------------------------------- */
+
+static m2c_symfile_t load_import (const char *module, void *context) {
+  m2c_import_dir_s *imports = context;
+  m2c_fileio_status_t status;
+  m2c_symfile_t symfile;
+  const char *sympath;
+  cstr_view_t path;
+  unsigned namelen;
+  
+  sympath = new_path_w_components(imports->dirpath, module, imports->suffix);
+  
+  if (sympath == NULL) {
+    return NULL;
+  } /* end if */
+  
+  /* the filename is the tail of sympath */
+  if (imports->listing != NULL) {
+    path = cstr_view(sympath);
+    namelen = cstr_length(module) + cstr_length(imports->suffix);
+    
+    if (NOT(m2c_dircache_contains(imports->listing,
+        path.ptr + path.len - namelen))) {
+      free((void *) sympath);
+      return NULL;
+    } /* end if */
+  } /* end if */
+  
+  symfile = m2c_symfile_load(sympath, &status);
+  free((void *) sympath);
+  
+  return symfile;
+} /* end load_import */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_timing(srcpath, timing)
+ * --------------------------------------------------------------------------
+ * Appends the phase times of the translation of srcpath in timing as a JSON
+ * line to the timing file in the current working directory.
+ * ----------------------------------------------------------------------- */
+
+static void write_timing (const char *srcpath, m2c_phase_timing_t *timing) {
+  FILE *file;
+  
+  file = fopen(M2C_PHASE_TIMING_OUTPUT_FILE, "a");
+  
+  if (file == NULL) {
+    printf("unable to write phase times to %s\n",
+      M2C_PHASE_TIMING_OUTPUT_FILE);
+    return;
+  } /* end if */
+  
+  m2c_phase_timing_write(file, srcpath, timing);
+  fclose(file);
+} /* end write_timing */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure report_write_failure(output, path, stats)
+ * --------------------------------------------------------------------------
+ * Reports that output could not be written to the file at path and counts
+ * the failure as an error in stats.
+ * ----------------------------------------------------------------------- */
+
+static void report_write_failure
+  (const char *output, const char *path, m2c_stats_t *stats) {
+  
+  printf("unable to write %s to %s\n", output, path);
+  *stats = m2c_stats_new(m2c_stats_warnings(*stats),
+    m2c_stats_errors(*stats) + 1, m2c_stats_lines(*stats));
+} /* end report_write_failure */
+
+
+/* *********************************************************************** *
+ * AST Streaming                                                           *
+ * *********************************************************************** */
+
+static void write_parse_event
+  (m2c_parse_event_t event, m2c_ast_nodetype_t node_type,
+   m2c_astnode_t node, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * private procedure parse_and_stream_ast(srctype, srcpath, astpath, ...)
+ * --------------------------------------------------------------------------
+ * Parses the source at srcpath and writes its AST in S-expression format to
+ * the file at astpath while parsing.  Only the subtree being parsed is held
+ * in memory, the whole tree is never built.  Passes statistics back in
+ * stats and the parser status back in status.
+ * ----------------------------------------------------------------------- */
+
+static void parse_and_stream_ast
+  (m2c_sourcetype_t srctype, const char *srcpath, const char *astpath,
+   m2c_stats_t *stats, m2c_parser_status_t *status) {
+  
+  m2c_fileio_status_t write_status;
+  m2c_ast_stream_t stream;
+  
+  stream = m2c_ast_stream_new(astpath, &write_status);
+  
+  if (stream == NULL) {
+    printf("unable to write AST to %s\n", astpath);
+  } /* end if */
+  
+  /* parse even if the output failed, diagnostics are still reported */
+  m2c_parse_file_w_handler
+    (srctype, srcpath, write_parse_event, stream, stats, status);
+  
+  if (stream != NULL) {
+    write_status = m2c_ast_stream_release(&stream, NULL);
+    
+    if (write_status != M2C_FILEIO_STATUS_SUCCESS) {
+      printf("unable to write AST to %s\n", astpath);
+    } /* end if */
+  } /* end if */
+  
+  return;
+} /* end parse_and_stream_ast */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_parse_event(event, node_type, node, context)
+ * --------------------------------------------------------------------------
+ * Parse event handler, writes the event to the AST stream in context.
+ * ----------------------------------------------------------------------- */
+
+static void write_parse_event
+  (m2c_parse_event_t event, m2c_ast_nodetype_t node_type,
+   m2c_astnode_t node, void *context) {
+  
+  m2c_ast_stream_t stream = (m2c_ast_stream_t) context;
+  
+  switch (event) {
+    case M2C_PARSE_EVENT_OPEN :
+      m2c_ast_stream_open_node(stream, node_type);
+      break;
+      
+    case M2C_PARSE_EVENT_NODE :
+      m2c_ast_stream_write_node(stream, node);
+      break;
+      
+    case M2C_PARSE_EVENT_CLOSE :
+      m2c_ast_stream_close_node(stream);
+      break;
+  } /* end switch */
+  
+  return;
+} /* end write_parse_event */
+
+
+/* *********************************************************************** *
+ * Batch Mode                                                              *
+ * *********************************************************************** */
+
+static bool add_batch_source (m2c_batch_s *batch, const char *srcpath);
+
+static void add_dir_entry (const char *name, void *context);
+
+static bool add_list_file_entries (m2c_batch_s *batch, const char *listpath);
+
+static int compare_job_size (const void *job1, const void *job2);
+
+static int compare_job_module (const void *job1, const void *job2);
+
+static void scan_imports_job
+  (m2c_workpool_t pool, uint_t worker, void *job, void *context);
+
+static void link_dependencies (m2c_batch_s *batch);
+
+static void add_dependency
+  (m2c_batch_job_s *client, m2c_batch_job_s *prerequisite);
+
+static void translate_job
+  (m2c_workpool_t pool, uint_t worker, void *job, void *context);
+
+static const char **new_read_ahead_list (m2c_batch_s *batch);
+
+static uint64_t cache_key_for_job
+  (m2c_batch_job_s *job, const char *source, size_t length,
+   uint64_t *imported);
+
+static uint64_t interface_for_job
+  (m2c_batch_s *batch, m2c_batch_job_s *job, uint64_t imported);
+
+static uint64_t interface_from_fingerprint
+  (uint64_t fingerprint, uint64_t imported);
+
+static const char *new_output_path
+  (m2c_batch_s *batch, m2c_batch_job_s *job, const char *suffix);
+
+static bool outputs_exist (m2c_batch_s *batch, m2c_batch_job_s *job);
+
+static bool reuse_cached_output (m2c_batch_s *batch, m2c_batch_job_s *job);
+
+static void write_cache_stamp (m2c_batch_s *batch, m2c_batch_job_s *job);
+
+static void remove_cache_stamp (m2c_batch_s *batch, m2c_batch_job_s *job);
+
+
+/* --------------------------------------------------------------------------
+ * function translate_batch(argpath)
+ * --------------------------------------------------------------------------
+ * Translates all Modula-2 sources in the directory at argpath, or if
+ * argpath starts with '@', all sources listed in the file at the remainder
+ * of argpath, one path per line.  Empty lines and lines starting with '#'
+ * are ignored.  Sources are translated in one process by a pool of workers
+ * sharing one string repository.  An import pre-scan determines the
+ * dependencies between sources.  A source is translated only after the
+ * definition modules it imports and, for an implementation module, its own
+ * definition module.  Independent sources are translated in parallel.
+ * Sources are loaded ahead of translation on an I/O thread, those ready
+ * for translation first, so that workers do not wait for them to load.
+ * Sources involved in circular imports are reported and not translated.
+ * Sources unchanged since their last translation are not translated again.
+ * Output is written to the working directory.  Since a definition and an
+ * implementation module may share a basename, their output files carry the
+ * source suffix before the output suffix, as in Foo.def.ast and Foo.mod.ast.
+ * Returns EXIT_SUCCESS if all sources were translated without errors,
+ * otherwise EXIT_FAILURE.
+ * ----------------------------------------------------------------------- */
+
+static int translate_batch (const char *argpath) {
+  m2c_string_status_t string_status;
+  m2c_batch_s batch;
+  bool listed;
+  int status;
+  
+  /* get working directory, obtained once per process */
+  batch.workdir = current_workdir();
+  
+  if (batch.workdir == NULL) {
+    printf("unable to get current working directory.\n");
+    return EXIT_FAILURE;
+  } /* end if */
+  
+  batch.dirpath = NULL;
+  batch.timing_file = NULL;
+  batch.readahead = NULL;
+  batch.read_list = NULL;
+  batch.job_count = 0;
+  batch.capacity = 0;
+  batch.job = NULL;
+  
+  /* initialise string repo, shared by all workers, unless a server
+   * running the batch has already initialised it */
+  m2c_init_string_repository_w_mode
+    (0, M2C_STRING_ALLOC_CONCURRENT, &string_status);
+  
+  /* collect sources */
+  if (argpath[0] == '@') {
+    listed = add_list_file_entries(&batch, argpath + 1);
+  }
+  else /* directory */ {
+    batch.dirpath = argpath;
+    listed = read_directory(argpath, add_dir_entry, &batch);
+  } /* end if */
+  
+  if (NOT(listed)) {
+    m2c_emit_error_w_str(M2C_ERROR_INPUT_FILE_NOT_FOUND, argpath);
+    status = EXIT_FAILURE;
+  }
+  else {
+    /* print banner */
+    print_identification();
+    
+    if (m2c_option_parser_debug()) {
+      m2c_print_options();
+    } /* end if */
+    
+    status = run_batch(&batch);
+  } /* end if */
+  
+  /* all exits release the batch */
+  release_batch(&batch);
+  
+  if (string_status == M2C_STRING_STATUS_SUCCESS) {
+    m2c_dispose_string_repository(NULL);
+  } /* end if */
+  
+  return status;
+} /* end translate_batch */
+
+
+/* --------------------------------------------------------------------------
+ * private function run_batch(batch)
+ * --------------------------------------------------------------------------
+ * Pre-scans the imports of the sources of batch, links their dependencies
+ * and translates them on a pool of workers, then prints the statistics of
+ * the batch.  Resources acquired for batch are left to release_batch().
+ * Returns EXIT_SUCCESS if all sources were translated without errors,
+ * otherwise EXIT_FAILURE.
+ * ----------------------------------------------------------------------- */
+
+static int run_batch (m2c_batch_s *batch) {
+  m2c_workpool_status_t pool_status;
+  m2c_workpool_t pool;
+  uint_t index, worker, warnings, errors, lines, failed;
+  
+  /* pre-scan imports of all sources in parallel */
+  pool = m2c_new_workpool(0, scan_imports_job, batch, &pool_status);
+  
+  if (pool == NULL) {
+    printf("unable to allocate worker pool.\n");
+    return EXIT_FAILURE;
+  } /* end if */
+  
+  for (index = 0; index < batch->job_count; index++) {
+    m2c_workpool_submit(pool, index, &batch->job[index], NULL);
+  } /* end for */
+  
+  m2c_workpool_run(pool, NULL);
+  m2c_release_workpool(pool);
+  
+  /* start with the largest sources, so that stealing balances the tail */
+  qsort(batch->job, batch->job_count, sizeof(m2c_batch_job_s),
+    compare_job_size);
+  
+  /* build import graph, this must follow sorting as it links job addresses */
+  link_dependencies(batch);
+  
+  pool = m2c_new_workpool(0, translate_job, batch, &pool_status);
+  
+  if (pool == NULL) {
+    printf("unable to allocate worker pool.\n");
+    return EXIT_FAILURE;
+  } /* end if */
+  
+  printf("translating %u sources with %u workers\n",
+    batch->job_count, m2c_workpool_worker_count(pool));
+  
+  /* load sources ahead, without read-ahead workers read them themselves */
+  batch->read_list = new_read_ahead_list(batch);
+  
+  if (batch->read_list != NULL) {
+    batch->readahead = m2c_new_readahead(batch->job_count, batch->read_list,
+      M2C_BATCH_READ_AHEAD_PER_WORKER * m2c_workpool_worker_count(pool),
+      NULL);
+  } /* end if */
+  
+  /* sources are already translated in parallel, their dumps are not */
+  m2c_ast_parallel_set_worker_count(1);
+  
+  /* workers append phase times to a shared file, a line at a time */
+  if (m2c_option_timing()) {
+    batch->timing_file = fopen(M2C_PHASE_TIMING_OUTPUT_FILE, "a");
+    
+    if (batch->timing_file == NULL) {
+      printf("unable to write phase times to %s\n",
+        M2C_PHASE_TIMING_OUTPUT_FILE);
+    } /* end if */
+  } /* end if */
+  
+  /* deal jobs without prerequisites round robin, others follow on demand */
+  worker = 0;
+  pool_status = M2C_WORKPOOL_STATUS_SUCCESS;
+  for (index = 0; (index < batch->job_count) &&
+       (pool_status == M2C_WORKPOOL_STATUS_SUCCESS); index++) {
+    if (batch->job[index].wait_count == 0) {
+      m2c_workpool_submit(pool, worker, &batch->job[index], &pool_status);
+      worker++;
+    } /* end if */
+  } /* end for */
+  
+  if (pool_status != M2C_WORKPOOL_STATUS_SUCCESS) {
+    printf("unable to allocate worker pool.\n");
+    m2c_release_workpool(pool);
+    return EXIT_FAILURE;
+  } /* end if */
+  
+  m2c_workpool_run(pool, NULL);
+  m2c_release_workpool(pool);
+  
+  /* sum up statistics */
+  warnings = 0;
+  errors = 0;
+  lines = 0;
+  failed = 0;
+  for (index = 0; index < batch->job_count; index++) {
+    warnings = warnings + m2c_stats_warnings(batch->job[index].stats);
+    errors = errors + m2c_stats_errors(batch->job[index].stats);
+    lines = lines + m2c_stats_lines(batch->job[index].stats);
+    if (NOT(batch->job[index].done)) {
+      printf("circular import involving %s\n", batch->job[index].srcpath);
+      failed++;
+    }
+    else if (batch->job[index].status != M2C_PARSER_STATUS_SUCCESS) {
+      failed++;
+    } /* end if */
+  } /* end for */
+  
+  /* print statistics */
+  printf("sources: %u\n", batch->job_count);
+  printf("warnings: %u\n", warnings);
+  printf("errors: %u\n", errors);
+  printf("lines: %u\n", lines);
+  
+  /* pass status code to caller */
+  if ((errors == 0) && (failed == 0)) {
+    return EXIT_SUCCESS;
+  }
+  else /* errors occurred */ {
+    return EXIT_FAILURE;
+  } /* end if */
+} /* end run_batch */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure release_batch(batch)
+ * --------------------------------------------------------------------------
+ * Releases the read-ahead and the timing file of batch, the paths and the
+ * queues of all its jobs and the job table.  Jobs that have run already
+ * released their queues.
+ * ----------------------------------------------------------------------- */
+
+static void release_batch (m2c_batch_s *batch) {
+  m2c_batch_job_s *job;
+  uint_t index;
+  
+  m2c_release_readahead(batch->readahead);
+  batch->readahead = NULL;
+  free(batch->read_list);
+  batch->read_list = NULL;
+  
+  if (batch->timing_file != NULL) {
+    fclose(batch->timing_file);
+    batch->timing_file = NULL;
+  } /* end if */
+  
+  for (index = 0; index < batch->job_count; index++) {
+    job = &batch->job[index];
+    free((void *) job->srcpath);
+    free((void *) job->basename);
+    m2c_fifo_release_queue(job->imports);
+    m2c_fifo_release_queue(job->dependents);
+    m2c_fifo_release_queue(job->prerequisites);
+  } /* end for */
+  
+  free(batch->job);
+  batch->job = NULL;
+  batch->job_count = 0;
+  batch->capacity = 0;
+} /* end release_batch */
+
+
+/* --------------------------------------------------------------------------
+ * private function add_batch_source(batch, srcpath)
+ * --------------------------------------------------------------------------
+ * Appends a job for srcpath to batch if srcpath is a valid pathname of an
+ * existing regular file with suffix .def or .mod.  Returns true if a job
+ * was added, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+static bool add_batch_source (m2c_batch_s *batch, const char *srcpath) {
+  const char *basename, *suffix;
+  m2c_pathname_status_t pathname_status;
+  m2c_sourcetype_t srctype;
+  m2c_batch_job_s *new_job;
+  m2c_path_view_t view;
+  long int size;
+  
+  /* locate basename and suffix without copying them */
+  pathname_status = split_pathname_view(srcpath, &view, NULL);
+  
+  if ((pathname_status != M2C_PATHNAME_STATUS_SUCCESS) ||
+      (view.suffix == view.filename) || (view.suffix == view.length)) {
+    return false;
+  } /* end if */
+  
+  suffix = srcpath + view.suffix;
+  
+  /* determine source type */
+  if (is_def_suffix(suffix)) {
+    srctype = M2C_DEF_SOURCE;
+  }
+  else if (is_mod_suffix(suffix)) {
+    srctype = M2C_MOD_SOURCE;
+  }
+  else /* not a Modula-2 source */ {
+    return false;
+  } /* end if */
+  
+  if (NOT(get_filesize(srcpath, &size))) {
+    return false;
+  } /* end if */
+  
+  /* the job keeps its basename for naming its output files */
+  basename =
+    new_cstr_from_slice(srcpath, view.filename, view.suffix - view.filename);
+  
+  if (basename == NULL) {
+    return false;
+  } /* end if */
+  
+  /* grow job table if full */
+  if (batch->job_count == batch->capacity) {
+    if (batch->capacity == 0) {
+      batch->capacity = 64;
+    }
+    else {
+      batch->capacity = 2 * batch->capacity;
+    } /* end if */
+    
+    new_job = realloc(batch->job, batch->capacity * sizeof(m2c_batch_job_s));
+    
+    if (new_job == NULL) {
+      free((void *) basename);
+      return false;
+    } /* end if */
+    
+    batch->job = new_job;
+  } /* end if */
+  
+  /* append job */
+  new_job = &batch->job[batch->job_count];
+  new_job->srcpath = srcpath;
+  new_job->basename = basename;
+  new_job->srctype = srctype;
+  new_job->size = size;
+  new_job->module = NULL;
+  new_job->imports = NULL;
+  new_job->dependents = NULL;
+  new_job->prerequisites = NULL;
+  new_job->wait_count = 0;
+  new_job->read_index = 0;
+  new_job->key = 0;
+  new_job->interface = 0;
+  new_job->done = false;
+  new_job->stats = m2c_stats_new(0, 0, 0);
+  new_job->status = M2C_PARSER_STATUS_SUCCESS;
+  batch->job_count++;
+  
+  return true;
+} /* end add_batch_source */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure add_dir_entry(name, context)
+ * --------------------------------------------------------------------------
+ * Directory entry handler, appends a job for a Modula-2 source named name
+ * in the directory being read to the batch passed in context.
+ * ----------------------------------------------------------------------- */
+
+static void add_dir_entry (const char *name, void *context) {
+  m2c_batch_s *batch = context;
+  const char *srcpath, *suffix;
+  
+  /* skip entries that are not Modula-2 sources before allocating */
+  suffix = strrchr(name, '.');
+  
+  if ((suffix == NULL) ||
+      ((NOT(is_def_suffix(suffix))) && (NOT(is_mod_suffix(suffix)))) ||
+      (NOT(is_valid_filename(name)))) {
+    return;
+  } /* end if */
+  
+  /* the filename is the basename with its suffix */
+  srcpath = new_path_w_components(batch->dirpath, name, "");
+  
+  if ((srcpath != NULL) && (NOT(add_batch_source(batch, srcpath)))) {
+    free((void *) srcpath);
+  } /* end if */
+} /* end add_dir_entry */
+
+
+/* --------------------------------------------------------------------------
+ * private function add_list_file_entries(batch, listpath)
+ * --------------------------------------------------------------------------
+ * Appends a job for each source path listed in the file at listpath to
+ * batch.  Reports listed paths that are not Modula-2 sources.  Returns
+ * false if the list file could not be opened, otherwise true.
+ * ----------------------------------------------------------------------- */
+
+static bool add_list_file_entries (m2c_batch_s *batch, const char *listpath) {
+  char line[M2C_BATCH_MAX_LINE_LENGTH];
+  char *srcpath;
+  size_t len;
+  FILE *file;
+  
+  file = fopen(listpath, "r");
+  
+  if (file == NULL) {
+    return false;
+  } /* end if */
+  
+  while (fgets(line, M2C_BATCH_MAX_LINE_LENGTH, file) != NULL) {
+    
+    /* strip trailing whitespace and line terminator */
+    len = strlen(line);
+    while ((len > 0) && (line[len - 1] <= ' ')) {
+      len--;
+    } /* end while */
+    line[len] = ASCII_NUL;
+    
+    /* skip empty lines and comments */
+    if ((len == 0) || (line[0] == '#')) {
+      continue;
+    } /* end if */
+    
+    srcpath = malloc(len + 1);
+    
+    if (srcpath == NULL) {
+      break;
+    } /* end if */
+    
+    memcpy(srcpath, line, len + 1);
+    
+    if (NOT(add_batch_source(batch, srcpath))) {
+      m2c_emit_error_w_str(M2C_ERROR_INVALID_FILENAME, srcpath);
+      free(srcpath);
+    } /* end if */
+  } /* end while */
+  
+  fclose(file);
+  return true;
+} /* end add_list_file_entries */
+
+
+/* --------------------------------------------------------------------------
+ * private function compare_job_size(job1, job2)
+ * --------------------------------------------------------------------------
+ * Comparison function for qsort, orders jobs by descending source size.
+ * ----------------------------------------------------------------------- */
+
+static int compare_job_size (const void *job1, const void *job2) {
+  long int size1 = ((const m2c_batch_job_s *) job1)->size;
+  long int size2 = ((const m2c_batch_job_s *) job2)->size;
+  
+  if (size1 > size2) {
+    return -1;
+  }
+  else if (size1 < size2) {
+    return 1;
+  }
+  else {
+    return 0;
+  } /* end if */
+} /* end compare_job_size */
+
+
+/* --------------------------------------------------------------------------
+ * private function compare_job_module(job1, job2)
+ * --------------------------------------------------------------------------
+ * Comparison function for qsort and bsearch on a table of job pointers,
+ * orders jobs by the address of their unique module identifier string.
+ * ----------------------------------------------------------------------- */
+
+static int compare_job_module (const void *job1, const void *job2) {
+  m2c_string_t module1 = (*(m2c_batch_job_s * const *) job1)->module;
+  m2c_string_t module2 = (*(m2c_batch_job_s * const *) job2)->module;
+  
+  if (module1 < module2) {
+    return -1;
+  }
+  else if (module1 > module2) {
+    return 1;
+  }
+  else {
+    return 0;
+  } /* end if */
+} /* end compare_job_module */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure scan_imports_job(pool, worker, job, context)
+ * --------------------------------------------------------------------------
+ * Job handler, scans the module header and import lists of the source of
+ * job and records its module identifier and imported module identifiers.
+ * ----------------------------------------------------------------------- */
+
+static void scan_imports_job
+  (m2c_workpool_t pool, uint_t worker, void *job, void *context) {
+  m2c_batch_job_s *this_job = job;
+  m2c_sourcetype_t srctype;
+  
+  m2c_parse_imports(this_job->srcpath,
+    &srctype, &this_job->module, &this_job->imports, NULL);
+} /* end scan_imports_job */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure link_dependencies(batch)
+ * --------------------------------------------------------------------------
+ * Builds the import graph of batch.  Each source depends on the definition
+ * modules of the modules it imports, an implementation module also depends
+ * on its own definition module.  Imports of modules without a definition
+ * module in batch are ignored.  Releases the import lists.
+ * ----------------------------------------------------------------------- */
+
+static void link_dependencies (m2c_batch_s *batch) {
+  m2c_batch_job_s **def_job, **match, *this_job, key;
+  m2c_batch_job_s *key_ptr = &key;
+  uint_t index, def_count;
+  
+  /* table of definition module jobs, ordered by module identifier */
+  def_job = malloc((batch->job_count + 1) * sizeof(m2c_batch_job_s *));
+  
+  if (def_job == NULL) {
+    return;
+  } /* end if */
+  
+  def_count = 0;
+  for (index = 0; index < batch->job_count; index++) {
+    this_job = &batch->job[index];
+    if ((this_job->srctype == M2C_DEF_SOURCE) && (this_job->module != NULL)) {
+      def_job[def_count] = this_job;
+      def_count++;
+    } /* end if */
+  } /* end for */
+  
+  qsort(def_job, def_count, sizeof(m2c_batch_job_s *), compare_job_module);
+  
+  /* link each job to its prerequisites */
+  for (index = 0; index < batch->job_count; index++) {
+    this_job = &batch->job[index];
+    
+    /* an implementation module depends on its own definition module */
+    if ((this_job->srctype == M2C_MOD_SOURCE) &&
+        (this_job->module != NULL)) {
+      key.module = this_job->module;
+      match = bsearch(&key_ptr, def_job, def_count,
+        sizeof(m2c_batch_job_s *), compare_job_module);
+      
+      if (match != NULL) {
+        add_dependency(this_job, *match);
+      } /* end if */
+    } /* end if */
+    
+    /* every source depends on the definition modules it imports */
+    while ((key.module = m2c_fifo_dequeue(this_job->imports)) != NULL) {
+      match = bsearch(&key_ptr, def_job, def_count,
+        sizeof(m2c_batch_job_s *), compare_job_module);
+      
+      if ((match != NULL) && (*match != this_job)) {
+        add_dependency(this_job, *match);
+      } /* end if */
+    } /* end while */
+    
+    m2c_fifo_release_queue(this_job->imports);
+    this_job->imports = NULL;
+  } /* end for */
+  
+  free(def_job);
+} /* end link_dependencies */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure add_dependency(client, prerequisite)
+ * --------------------------------------------------------------------------
+ * Records that job client must wait for job prerequisite.
+ * ----------------------------------------------------------------------- */
+
+static void add_dependency
+  (m2c_batch_job_s *client, m2c_batch_job_s *prerequisite) {
+  
+  if (prerequisite->dependents == NULL) {
+    prerequisite->dependents = m2c_fifo_new_queue(client);
+    
+    if (prerequisite->dependents == NULL) {
+      return;
+    } /* end if */
+  }
+  else if (m2c_fifo_enqueue(prerequisite->dependents, client) == NULL) {
+    return;
+  } /* end if */
+  
+  /* the cache key of client depends on its prerequisites */
+  if (client->prerequisites == NULL) {
+    client->prerequisites = m2c_fifo_new_queue(prerequisite);
+  }
+  else {
+    m2c_fifo_enqueue(client->prerequisites, prerequisite);
+  } /* end if */
+  
+  client->wait_count++;
+} /* end add_dependency */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure translate_job(pool, worker, job, context)
+ * --------------------------------------------------------------------------
+ * Job handler, parses the source of job with a parser instance of its own
+ * and writes its AST in S-expression and graphviz DOT format, unless the
+ * outputs of a previous translation can be reused.  The source is taken
+ * from the read-ahead of the batch if it has been loaded ahead, otherwise
+ * it is read from its file.  Under option r10-output it is always read
+ * from its file, recording the spans and comments the M2R10 writer needs.
+ * The interface of a definition module is the fingerprint computed while
+ * writing its symbol file.  If the symbol file cannot be written, the job
+ * fails and the interface is zero, so that its clients are not reused.
+ * Phase times of the translation are appended to the timing file of the
+ * batch, if any.  Then submits those dependents of job that have no other
+ * unfinished prerequisites.
+ * ----------------------------------------------------------------------- */
+
+static void translate_job
+  (m2c_workpool_t pool, uint_t worker, void *job, void *context) {
+  m2c_batch_job_s *this_job = job;
+  m2c_batch_s *batch = context;
+  m2c_batch_job_s *dependent;
+  const char *astpath, *dotpath, *sympath, *cpath, *r10path;
+  m2c_r10writer_status_t r10_status;
+  m2c_comment_table_t comments;
+  m2c_span_table_t spans;
+  m2c_import_dir_s imports;
+  m2c_phase_timing_t timing;
+  m2c_ast_arena_t arena;
+  m2c_ast_view_t view;
+  uint64_t clock_value, imported, fingerprint;
+  const char *source;
+  size_t length;
+  m2c_ast_t ast;
+  bool reused, complete;
+  
+  /* take source if it has been loaded ahead */
+  length = 0;
+  source = m2c_readahead_take(batch->readahead, this_job->read_index, &length);
+  
+  /* all prerequisites are done, their interfaces are final */
+  this_job->key = cache_key_for_job(this_job, source, length, &imported);
+  
+  reused = reuse_cached_output(batch, this_job);
+  
+  /* the symbol file of a reused definition module must still be valid */
+  if ((reused) && (this_job->srctype == M2C_DEF_SOURCE)) {
+    this_job->interface = interface_for_job(batch, this_job, imported);
+    reused = (this_job->interface != 0);
+  } /* end if */
+  
+  if (reused) {
+    printf("up to date %s\n", this_job->srcpath);
+  }
+  else {
+    printf("processing %s\n", this_job->srcpath);
+    
+    /* previous outputs are about to be replaced, they are no longer valid */
+    remove_cache_stamp(batch, this_job);
+    
+    m2c_phase_timing_reset(&timing);
+    timing.bytes = (uint64_t) this_job->size;
+    
+    /* the job's AST is allocated from an arena of its own,
+     * streamed nodes are released as soon as they have been written */
+    arena = NULL;
+    if (NOT(m2c_option_stream_ast())) {
+      arena = m2c_ast_new_arena();
+      m2c_ast_set_arena(arena);
+    } /* end if */
+    
+    /* run parser on input */
+    ast = NULL;
+    spans = NULL;
+    comments = NULL;
+    if (m2c_option_stream_ast()) {
+      /* write AST in S-expression format while parsing, the outputs are
+       * incomplete, no cache stamp is therefore recorded */
+      clock_value = m2c_phase_clock();
+      astpath = new_output_path(batch, this_job, ".ast");
+      clock_value =
+        m2c_phase_timing_add(&timing, M2C_PHASE_PATHS, clock_value);
+      parse_and_stream_ast(this_job->srctype, this_job->srcpath,
+        astpath, &this_job->stats, &this_job->status);
+      m2c_phase_timing_add(&timing, M2C_PHASE_PARSE, clock_value);
+      free((void *) astpath);
+    }
+    else if (m2c_option_r10_output()) {
+      clock_value = m2c_phase_clock();
+      spans = m2c_new_span_table();
+      comments = m2c_new_comment_table();
+      m2c_parse_file_w_comments(this_job->srctype, this_job->srcpath,
+        &ast, spans, comments, &this_job->stats, &this_job->status);
+      m2c_phase_timing_add(&timing, M2C_PHASE_PARSE, clock_value);
+    }
+    else if (source != NULL) {
+      m2c_parse_buffer_w_timing(this_job->srctype, this_job->srcpath,
+        source, length, &ast, &timing, &this_job->stats, &this_job->status);
+    }
+    else {
+      m2c_parse_file_w_timing(this_job->srctype, this_job->srcpath,
+        &ast, &timing, &this_job->stats, &this_job->status);
+    } /* end if */
+    
+    m2c_flush_diagnostics();
+    
+    /* write AST to file */
+    if (ast != NULL) {
+      /* write AST in S-expression format */
+      clock_value = m2c_phase_clock();
+      astpath = new_output_path(batch, this_job, ".ast");
+      dotpath = new_output_path(batch, this_job, ".dot");
+      clock_value =
+        m2c_phase_timing_add(&timing, M2C_PHASE_PATHS, clock_value);
+      complete =
+        (m2c_ast_write(astpath, ast, NULL) == M2C_FILEIO_STATUS_SUCCESS);
+      clock_value =
+        m2c_phase_timing_add(&timing, M2C_PHASE_WRITE_AST, clock_value);
+      
+      /* write AST in graphviz DOT format */
+      if (m2c_dot_write(dotpath, ast, NULL) != M2C_FILEIO_STATUS_SUCCESS) {
+        complete = false;
+      } /* end if */
+      clock_value =
+        m2c_phase_timing_add(&timing, M2C_PHASE_WRITE_DOT, clock_value);
+      
+      free((void *) astpath);
+      free((void *) dotpath);
+      
+      if ((this_job->status == M2C_PARSER_STATUS_SUCCESS) &&
+          (m2c_stats_errors(this_job->stats) == 0)) {
+        
+        /* write symbol file for importing modules */
+        if (this_job->srctype == M2C_DEF_SOURCE) {
+          sympath = new_path_w_components
+            (batch->workdir, this_job->basename, M2C_SYMFILE_SUFFIX);
+          clock_value =
+            m2c_phase_timing_add(&timing, M2C_PHASE_PATHS, clock_value);
+          if (m2c_symfile_write_w_fingerprint(sympath, this_job->srcpath,
+              ast, NULL, &fingerprint) == M2C_FILEIO_STATUS_SUCCESS) {
+            /* clients are keyed on the interface, not on the source */
+            this_job->interface =
+              interface_from_fingerprint(fingerprint, imported);
+          }
+          else /* clients must not be keyed on a stale symbol file */ {
+            report_write_failure("symbols", sympath, &this_job->stats);
+            this_job->interface = 0;
+            complete = false;
+          } /* end if */
+          clock_value =
+            m2c_phase_timing_add(&timing, M2C_PHASE_WRITE_SYM, clock_value);
+          free((void *) sympath);
+        } /* end if */
+        
+        /* write C translation, imported symbols are taken from the
+         * symbol files of prerequisites, which are all done by now */
+        imports.dirpath = batch->workdir;
+        imports.suffix = M2C_SYMFILE_SUFFIX;
+        
+        /* symbol files are still being written by other workers */
+        imports.listing = NULL;
+        
+        if (this_job->srctype == M2C_DEF_SOURCE) {
+          cpath =
+            new_path_w_components(batch->workdir, this_job->basename, ".h");
+        }
+        else {
+          cpath =
+            new_path_w_components(batch->workdir, this_job->basename, ".c");
+        } /* end if */
+        
+        clock_value =
+          m2c_phase_timing_add(&timing, M2C_PHASE_PATHS, clock_value);
+        
+        /* each backend reads a view of its own, the AST stays unmodified */
+        view = m2c_ast_new_view(ast);
+        if (m2c_c99_write_view(cpath, view, NULL, load_import, &imports,
+            NULL) != M2C_FILEIO_STATUS_SUCCESS) {
+          report_write_failure("C", cpath, &this_job->stats);
+          complete = false;
+        } /* end if */
+        m2c_ast_release_view(view);
+        clock_value =
+          m2c_phase_timing_add(&timing, M2C_PHASE_WRITE_C, clock_value);
+        free((void *) cpath);
+        
+        /* write M2R10 translation */
+        if (m2c_option_r10_output()) {
+          if (this_job->srctype == M2C_DEF_SOURCE) {
+            r10path = new_path_w_components
+              (batch->workdir, this_job->basename, M2C_R10_DEF_SUFFIX);
+          }
+          else {
+            r10path = new_path_w_components
+              (batch->workdir, this_job->basename, M2C_R10_MOD_SUFFIX);
+          } /* end if */
+          
+          clock_value =
+            m2c_phase_timing_add(&timing, M2C_PHASE_PATHS, clock_value);
+          view = m2c_ast_new_view(ast);
+          m2c_r10_write_view(r10path, this_job->srcpath,
+            view, spans, comments, &r10_status);
+          if (r10_status != M2C_R10WRITER_STATUS_SUCCESS) {
+            report_write_failure("M2R10", r10path, &this_job->stats);
+            complete = false;
+          } /* end if */
+          m2c_ast_release_view(view);
+          m2c_phase_timing_add(&timing, M2C_PHASE_WRITE_R10, clock_value);
+          free((void *) r10path);
+        } /* end if */
+        
+        /* record cache key for the next run, if all outputs were written */
+        if (complete) {
+          write_cache_stamp(batch, this_job);
+        } /* end if */
+      } /* end if */
+    } /* end if */
+    
+    m2c_release_span_table(&spans);
+    m2c_release_comment_table(&comments);
+    
+    /* release the whole AST at once */
+    if (arena != NULL) {
+      m2c_ast_set_arena(NULL);
+      m2c_ast_release_arena(arena);
+    } /* end if */
+    
+    m2c_phase_timing_write(batch->timing_file, this_job->srcpath, &timing);
+  } /* end if */
+  
+  free((void *) source);
+  this_job->done = true;
+  
+  /* submit dependents whose prerequisites have now all been translated */
+  while ((dependent = m2c_fifo_dequeue(this_job->dependents)) != NULL) {
+    if (m2c_workpool_decrement(pool, &dependent->wait_count) == 0) {
+      m2c_workpool_submit(pool, worker, dependent, NULL);
+    } /* end if */
+  } /* end while */
+  
+  m2c_fifo_release_queue(this_job->dependents);
+  this_job->dependents = NULL;
+} /* end translate_job */
+
+
+/* --------------------------------------------------------------------------
+ * private function new_read_ahead_list(batch)
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated list of the source paths of batch in the order
+ * in which they are to be read ahead and records the position of each job
+ * in its field read_index.  Sources without prerequisites are dealt to the
+ * workers first and are therefore listed first, others follow in job
+ * order.  Returns NULL if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static const char **new_read_ahead_list (m2c_batch_s *batch) {
+  const char **list;
+  uint_t index, count;
+  
+  list = malloc((batch->job_count + 1) * sizeof(const char *));
+  
+  if (list == NULL) {
+    return NULL;
+  } /* end if */
+  
+  count = 0;
+  
+  /* sources without prerequisites */
+  for (index = 0; index < batch->job_count; index++) {
+    if (batch->job[index].wait_count == 0) {
+      batch->job[index].read_index = count;
+      list[count] = batch->job[index].srcpath;
+      count++;
+    } /* end if */
+  } /* end for */
+  
+  /* sources with prerequisites */
+  for (index = 0; index < batch->job_count; index++) {
+    if (batch->job[index].wait_count != 0) {
+      batch->job[index].read_index = count;
+      list[count] = batch->job[index].srcpath;
+      count++;
+    } /* end if */
+  } /* end for */
+  
+  return list;
+} /* end new_read_ahead_list */
+
+
+/* --------------------------------------------------------------------------
+ * private function cache_key_for_job(job, source, length, imported)
+ * --------------------------------------------------------------------------
+ * Returns the cache key of job, computed from the contents of its source
+ * file, the option fingerprint and the interfaces of its prerequisites, in
+ * the order in which they were linked.  If source is not NULL, it holds the
+ * contents of the source file and their length is given in length, the
+ * file is then not read again.  The combined interfaces of the prerequisites
+ * are passed back in imported.  Returns zero if the source file cannot be
+ * read or if the interface of any prerequisite is zero, imported is then
+ * zero as well if any interface was zero.  Releases the list of
+ * prerequisites.
+ * ----------------------------------------------------------------------- */
+
+static uint64_t cache_key_for_job
+  (m2c_batch_job_s *job, const char *source, size_t length,
+   uint64_t *imported) {
+  
+  unsigned char buffer[M2C_CACHE_READ_BUFFER_SIZE];
+  m2c_batch_job_s *prerequisite;
+  uint64_t key, interfaces;
+  const char *addr;
+  size_t index, size;
+  FILE *file;
+  
+  key = M2C_CACHE_HASH_OFFSET ^ (uint64_t) m2c_option_fingerprint();
+  key = key * M2C_CACHE_HASH_PRIME;
+  
+  /* hash source contents, loaded ahead or mapped if possible */
+  if (source != NULL) {
+    for (index = 0; index < length; index++) {
+      key = (key ^ (unsigned char) source[index]) * M2C_CACHE_HASH_PRIME;
+    } /* end for */
+  }
+  else if (map_file(job->srcpath, &addr, &size)) {
+    for (index = 0; index < size; index++) {
+      key = (key ^ (unsigned char) addr[index]) * M2C_CACHE_HASH_PRIME;
+    } /* end for */
+    unmap_file(addr, size);
+  }
+  else {
+    file = fopen(job->srcpath, "rb");
+    
+    if (file == NULL) {
+      key = 0;
+    }
+    else {
+      while ((size = fread(buffer, 1, M2C_CACHE_READ_BUFFER_SIZE, file)) > 0) {
+        for (index = 0; index < size; index++) {
+          key = (key ^ buffer[index]) * M2C_CACHE_HASH_PRIME;
+        } /* end for */
+      } /* end while */
+      fclose(file);
+    } /* end if */
+  } /* end if */
+  
+  /* combine with interfaces of prerequisites */
+  interfaces = M2C_CACHE_HASH_OFFSET;
+  while ((prerequisite = m2c_fifo_dequeue(job->prerequisites)) != NULL) {
+    if ((interfaces != 0) && (prerequisite->interface != 0)) {
+      interfaces =
+        (interfaces ^ prerequisite->interface) * M2C_CACHE_HASH_PRIME;
+    }
+    else {
+      interfaces = 0;
+    } /* end if */
+  } /* end while */
+  
+  m2c_fifo_release_queue(job->prerequisites);
+  job->prerequisites = NULL;
+  
+  if ((key != 0) && (interfaces != 0)) {
+    key = (key ^ interfaces) * M2C_CACHE_HASH_PRIME;
+  }
+  else {
+    key = 0;
+  } /* end if */
+  
+  *imported = interfaces;
+  
+  return key;
+} /* end cache_key_for_job */
+
+
+/* --------------------------------------------------------------------------
+ * private function interface_for_job(batch, job, imported)
+ * --------------------------------------------------------------------------
+ * Returns the interface of definition module job, computed from the
+ * fingerprint recorded in its symbol file and the combined interfaces of
+ * its prerequisites passed in imported.  Returns zero if imported is zero
+ * or if the symbol file cannot be loaded.
+ * ----------------------------------------------------------------------- */
+
+static uint64_t interface_for_job
+  (m2c_batch_s *batch, m2c_batch_job_s *job, uint64_t imported) {
+  
+  m2c_symfile_t symfile;
+  const char *sympath;
+  uint64_t interface;
+  
+  if (imported == 0) {
+    return 0;
+  } /* end if */
+  
+  sympath =
+    new_path_w_components(batch->workdir, job->basename, M2C_SYMFILE_SUFFIX);
+  
+  if (sympath == NULL) {
+    return 0;
+  } /* end if */
+  
+  symfile = m2c_symfile_load(sympath, NULL);
+  free((void *) sympath);
+  
+  if (symfile == NULL) {
+    return 0;
+  } /* end if */
+  
+  interface =
+    interface_from_fingerprint(m2c_symfile_fingerprint(symfile), imported);
+  m2c_symfile_release(symfile);
+  
+  return interface;
+} /* end interface_for_job */
+
+
+/* --------------------------------------------------------------------------
+ * private function interface_from_fingerprint(fingerprint, imported)
+ * --------------------------------------------------------------------------
+ * Returns the interface of a definition module with the given interface
+ * fingerprint whose prerequisites have the combined interfaces passed in
+ * imported.  Returns zero if fingerprint or imported is zero.
+ * ----------------------------------------------------------------------- */
+
+static uint64_t interface_from_fingerprint
+  (uint64_t fingerprint, uint64_t imported) {
+  
+  if ((fingerprint == 0) || (imported == 0)) {
+    return 0;
+  } /* end if */
+  
+  return (fingerprint ^ imported) * M2C_CACHE_HASH_PRIME;
+} /* end interface_from_fingerprint */
+
+
+/* --------------------------------------------------------------------------
+ * private function new_output_path(batch, job, suffix)
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated path in the working directory for the output
+ * of job with the given suffix, preceded by the suffix of the source type.
+ * ----------------------------------------------------------------------- */
+
+static const char *new_output_path
+  (m2c_batch_s *batch, m2c_batch_job_s *job, const char *suffix) {
+  char full_suffix[16];
+  
+  if (job->srctype == M2C_DEF_SOURCE) {
+    snprintf(full_suffix, sizeof(full_suffix), ".def%s", suffix);
+  }
+  else {
+    snprintf(full_suffix, sizeof(full_suffix), ".mod%s", suffix);
+  } /* end if */
+  
+  return new_path_w_components(batch->workdir, job->basename, full_suffix);
+} /* end new_output_path */
+
+
+/* --------------------------------------------------------------------------
+ * private function outputs_exist(batch, job)
+ * --------------------------------------------------------------------------
+ * Returns true if all outputs of a translation of job exist, that is its
+ * AST in S-expression and graphviz DOT format, its C translation, for a
+ * definition module its symbol file and under option r10-output its M2R10
+ * translation, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+static bool outputs_exist (m2c_batch_s *batch, m2c_batch_job_s *job) {
+  const char *path[5];
+  uint_t index, count;
+  bool exist;
+  
+  path[0] = new_output_path(batch, job, ".ast");
+  path[1] = new_output_path(batch, job, ".dot");
+  
+  if (job->srctype == M2C_DEF_SOURCE) {
+    path[2] = new_path_w_components(batch->workdir, job->basename, ".h");
+    path[3] = new_path_w_components
+      (batch->workdir, job->basename, M2C_SYMFILE_SUFFIX);
+    count = 4;
+  }
+  else {
+    path[2] = new_path_w_components(batch->workdir, job->basename, ".c");
+    count = 3;
+  } /* end if */
+  
+  if ((m2c_option_r10_output()) && (job->srctype == M2C_DEF_SOURCE)) {
+    path[count] = new_path_w_components
+      (batch->workdir, job->basename, M2C_R10_DEF_SUFFIX);
+    count++;
+  }
+  else if (m2c_option_r10_output()) {
+    path[count] = new_path_w_components
+      (batch->workdir, job->basename, M2C_R10_MOD_SUFFIX);
+    count++;
+  } /* end if */
+  
+  exist = true;
+  for (index = 0; index < count; index++) {
+    if ((path[index] == NULL) || (NOT(file_exists(path[index])))) {
+      exist = false;
+    } /* end if */
+    free((void *) path[index]);
+  } /* end for */
+  
+  return exist;
+} /* end outputs_exist */
+
+
+/* --------------------------------------------------------------------------
+ * private function reuse_cached_output(batch, job)
+ * --------------------------------------------------------------------------
+ * Returns true if the stamp file of job records the current key of job and
+ * all outputs of the previous translation are present.  The statistics of
+ * the previous translation are then passed back in the job.
+ * ----------------------------------------------------------------------- */
+
+static bool reuse_cached_output (m2c_batch_s *batch, m2c_batch_job_s *job) {
+  unsigned int key_high, key_low, warnings, errors, lines;
+  const char *stamppath;
+  bool reusable;
+  FILE *file;
+  
+  if (job->key == 0) {
+    return false;
+  } /* end if */
+  
+  stamppath = new_output_path(batch, job, M2C_CACHE_STAMP_SUFFIX);
+  reusable = false;
+  
+  if ((stamppath != NULL) && (outputs_exist(batch, job))) {
+    file = fopen(stamppath, "r");
+    
+    if (file != NULL) {
+      if ((fscanf(file, "%8x%8x %u %u %u",
+            &key_high, &key_low, &warnings, &errors, &lines) == 5) &&
+          (key_high == (unsigned int) (job->key >> 32)) &&
+          (key_low == (unsigned int) (job->key & 0xffffffff))) {
+        job->stats = m2c_stats_new(warnings, errors, lines);
+        reusable = true;
+      } /* end if */
+      fclose(file);
+    } /* end if */
+  } /* end if */
+  
+  free((void *) stamppath);
+  
+  return reusable;
+} /* end reuse_cached_output */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_cache_stamp(batch, job)
+ * --------------------------------------------------------------------------
+ * Writes the stamp file of job, recording its key and statistics.  Jobs
+ * with a key of zero are not recorded.
+ * ----------------------------------------------------------------------- */
+
+static void write_cache_stamp (m2c_batch_s *batch, m2c_batch_job_s *job) {
+  const char *stamppath;
+  FILE *file;
+  
+  if (job->key == 0) {
+    return;
+  } /* end if */
+  
+  stamppath = new_output_path(batch, job, M2C_CACHE_STAMP_SUFFIX);
+  
+  if (stamppath == NULL) {
+    return;
+  } /* end if */
+  
+  file = fopen(stamppath, "w");
+  
+  if (file != NULL) {
+    fprintf(file, "%08x%08x %u %u %u\n",
+      (unsigned int) (job->key >> 32),
+      (unsigned int) (job->key & 0xffffffff),
+      m2c_stats_warnings(job->stats),
+      m2c_stats_errors(job->stats),
+      m2c_stats_lines(job->stats));
+    fclose(file);
+  } /* end if */
+  
+  free((void *) stamppath);
+} /* end write_cache_stamp */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure remove_cache_stamp(batch, job)
+ * --------------------------------------------------------------------------
+ * Removes the stamp file of job, if any, so that outputs of job that are
+ * being replaced are not reused should the translation fail.
+ * ----------------------------------------------------------------------- */
+
+static void remove_cache_stamp (m2c_batch_s *batch, m2c_batch_job_s *job) {
+  const char *stamppath;
+  
+  stamppath = new_output_path(batch, job, M2C_CACHE_STAMP_SUFFIX);
+  
+  if (stamppath != NULL) {
+    remove(stamppath);
+    free((void *) stamppath);
+  } /* end if */
+} /* end remove_cache_stamp */
+
+
+/* *********************************************************************** *
+ * Server Mode                                                             *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * Server protocol
+ * --------------------------------------------------------------------------
+ * In server mode, m2c listens on a local socket at the path given in place
+ * of a source and serves one request per connection.  A request is a single
+ * line holding the path of a source file, of a directory or of a list file
+ * prefixed with @, which is translated as if given on the command line with
+ * the options of the server.  The output of the translation is sent back
+ * on the connection, followed by a final line "status: n" where n is the
+ * exit status.  Request "reset" discards all cached state and request
+ * "shutdown" stops the server.  Between requests, the string repository,
+ * the options, the listing of the working directory and the symbol files
+ * of imported modules are kept.  A cached symbol file is reloaded when its
+ * modification time or size has changed.  Symbol files written by other
+ * processes are only found after a reset.
+ * ----------------------------------------------------------------------- */
+
+/* --------------------------------------------------------------------------
+ * private type m2c_cached_symfile_s
+ * --------------------------------------------------------------------------
+ * record type representing a symbol file kept between requests.  Fields
+ * time and size hold the modification time and size of the file at the
+ * time it was loaded.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* module */ const char *module;
+  /* symfile */ m2c_symfile_t symfile;
+  /* time */ long int time;
+  /* size */ long int size;
+} m2c_cached_symfile_s;
+
+
+/* --------------------------------------------------------------------------
+ * private type m2c_server_s
+ * --------------------------------------------------------------------------
+ * record type representing the state kept by the server between requests.
+ * Field imports holds the location of imported symbol files and a listing
+ * of the working directory, field symfile the symbol files loaded so far.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* imports */ m2c_import_dir_s imports;
+  /* count */ uint_t count;
+  /* capacity */ uint_t capacity;
+  /* symfile */ m2c_cached_symfile_s *symfile;
+} m2c_server_s;
+
+
+#if (M2C_SERVER_MODE)
+static bool read_request (int connection, char *request);
+
+static int serve_request (m2c_server_s *server, const char *request);
+
+static m2c_symfile_t load_cached_import (const char *module, void *context);
+
+static void forget_cached_import (m2c_server_s *server, const char *basename);
+
+static void reset_server (m2c_server_s *server);
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * private function serve_requests(sockpath)
+ * --------------------------------------------------------------------------
+ * Listens on a local socket at sockpath and serves translation requests
+ * until a shutdown request is received.  Any stale socket at sockpath is
+ * replaced.  Returns EXIT_SUCCESS after a shutdown request, or EXIT_FAILURE
+ * if the socket could not be set up or server mode is not supported on the
+ * host platform.
+ * ----------------------------------------------------------------------- */
+
+static int serve_requests (const char *sockpath) {
+#if (M2C_SERVER_MODE)
+  char request[M2C_SERVER_MAX_REQUEST_LENGTH + 1];
+  struct sockaddr_un address;
+  int listener, connection, saved_stdout, saved_stderr, status;
+  m2c_server_s server;
+  bool stopped;
+  
+  if (cstr_length(sockpath) >= sizeof(address.sun_path)) {
+    m2c_emit_error_w_str(M2C_ERROR_INVALID_FILENAME, sockpath);
+    return EXIT_FAILURE;
+  } /* end if */
+  
+  server.imports.dirpath = current_workdir();
+  
+  if (server.imports.dirpath == NULL) {
+    printf("unable to get current working directory.\n");
+    return EXIT_FAILURE;
+  } /* end if */
+  
+  server.imports.suffix = M2C_SYMFILE_SUFFIX;
+  server.imports.listing = m2c_new_dircache(server.imports.dirpath);
+  server.count = 0;
+  server.capacity = 0;
+  server.symfile = NULL;
+  
+  /* set up socket */
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  strcpy(address.sun_path, sockpath);
+  
+  listener = socket(AF_UNIX, SOCK_STREAM, 0);
+  
+  if (listener < 0) {
+    printf("unable to open socket %s\n", sockpath);
+    return EXIT_FAILURE;
+  } /* end if */
+  
+  unlink(sockpath);
+  
+  if ((bind(listener, (struct sockaddr *) &address, sizeof(address)) < 0) ||
+      (listen(listener, M2C_SERVER_BACKLOG) < 0)) {
+    printf("unable to listen on socket %s\n", sockpath);
+    close(listener);
+    return EXIT_FAILURE;
+  } /* end if */
+  
+  /* a client hanging up must not terminate the server */
+  signal(SIGPIPE, SIG_IGN);
+  
+  /* initialise string repo, strings live until the server exits,
+   * batch requests intern strings on worker threads */
+  m2c_init_string_repository_w_mode(0, M2C_STRING_ALLOC_CONCURRENT, NULL);
+  
+  /* print banner */
+  print_identification();
+  printf("listening on %s\n", sockpath);
+  fflush(stdout);
+  
+  saved_stdout = dup(STDOUT_FILENO);
+  saved_stderr = dup(STDERR_FILENO);
+  
+  stopped = false;
+  while (NOT(stopped)) {
+    connection = accept(listener, NULL, NULL);
+    
+    if (connection < 0) {
+      continue;
+    } /* end if */
+    
+    if (NOT(read_request(connection, request))) {
+      close(connection);
+      continue;
+    } /* end if */
+    
+    /* output of the request goes to the client */
+    dup2(connection, STDOUT_FILENO);
+    dup2(connection, STDERR_FILENO);
+    
+    if (strcmp(request, "shutdown") == 0) {
+      stopped = true;
+      status = EXIT_SUCCESS;
+    }
+    else if (strcmp(request, "reset") == 0) {
+      reset_server(&server);
+      status = EXIT_SUCCESS;
+    }
+    else {
+      status = serve_request(&server, request);
+    } /* end if */
+    
+    printf("status: %d\n", status);
+    fflush(stdout);
+    fflush(stderr);
+    
+    /* restore output */
+    dup2(saved_stdout, STDOUT_FILENO);
+    dup2(saved_stderr, STDERR_FILENO);
+    close(connection);
+  } /* end while */
+  
+  reset_server(&server);
+  m2c_release_dircache(&server.imports.listing);
+  free(server.symfile);
+  close(listener);
+  unlink(sockpath);
+  
+  return EXIT_SUCCESS;
+#else /* server mode unsupported */
+  printf("server mode not supported on this host platform.\n");
+  return EXIT_FAILURE;
+#endif
+} /* end serve_requests */
+
+
+#if (M2C_SERVER_MODE)
+/* --------------------------------------------------------------------------
+ * private function read_request(connection, request)
+ * --------------------------------------------------------------------------
+ * Reads a request line from connection into request, which must provide
+ * space for M2C_SERVER_MAX_REQUEST_LENGTH characters and a terminating NUL.
+ * The line feed and any carriage return ending the line are removed.
+ * Returns true if a non-empty request was read, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+static bool read_request (int connection, char *request) {
+  uint_t length;
+  ssize_t count;
+  char ch;
+  
+  length = 0;
+  count = read(connection, &ch, 1);
+  while ((count == 1) && (ch != ASCII_LF)) {
+    if (length == M2C_SERVER_MAX_REQUEST_LENGTH) {
+      return false;
+    } /* end if */
+    
+    request[length] = ch;
+    length++;
+    count = read(connection, &ch, 1);
+  } /* end while */
+  
+  if ((length > 0) && (request[length - 1] == ASCII_CR)) {
+    length--;
+  } /* end if */
+  
+  request[length] = ASCII_NUL;
+  
+  return (length > 0);
+} /* end read_request */
+
+
+/* --------------------------------------------------------------------------
+ * private function serve_request(server, request)
+ * --------------------------------------------------------------------------
+ * Translates the source, directory or list file named by request as main
+ * would if it had been given on the command line.  Single sources are
+ * translated with the cached state of server.  Returns the exit status.
+ * ----------------------------------------------------------------------- */
+
+static int serve_request (m2c_server_s *server, const char *request) {
+  const char *basename;
+  m2c_phase_timing_t timing;
+  m2c_sourcetype_t srctype;
+  m2c_ast_arena_t arena;
+  int status;
+  
+  /* the error limit applies to each request afresh */
+  m2c_reset_error_count();
+  
+  /* batch mode for a directory or a list file */
+  if ((request[0] == '@') || (is_directory(request))) {
+    status = translate_batch(request);
+    
+    /* outputs of the batch are not known individually */
+    reset_server(server);
+    
+    return status;
+  } /* end if */
+  
+  if (NOT(find_source(request, &srctype, &basename))) {
+    m2c_flush_diagnostics();
+    return EXIT_FAILURE;
+  } /* end if */
+  
+  m2c_phase_timing_reset(&timing);
+  
+  /* the AST is allocated from an arena of its own, released afterwards */
+  arena = NULL;
+  if (NOT(m2c_option_stream_ast())) {
+    arena = m2c_ast_new_arena();
+    m2c_ast_set_arena(arena);
+  } /* end if */
+  
+  status = translate_source
+    (srctype, request, basename, load_cached_import, server, &timing);
+  
+  if (arena != NULL) {
+    m2c_ast_set_arena(NULL);
+    m2c_ast_release_arena(arena);
+  } /* end if */
+  
+  /* a definition module may have replaced its symbol file */
+  if (srctype == M2C_DEF_SOURCE) {
+    forget_cached_import(server, basename);
+  } /* end if */
+  
+  free((void *) basename);
+  
+  return status;
+} /* end serve_request */
+
+
+/* --------------------------------------------------------------------------
+ * private function load_cached_import(module, context)
+ * --------------------------------------------------------------------------
+ * Import loader for the C99 writer, returns the symbol file of module from
+ * the cache of the server passed in context.  If it is not cached or if
+ * the symbol file has changed since it was cached, it is loaded by function
+ * load_import() and cached.  Each symbol file returned carries a reference
+ * of its own, to be released by the writer.
+ * ----------------------------------------------------------------------- */
+
+static m2c_symfile_t load_cached_import (const char *module, void *context) {
+  m2c_server_s *server = context;
+  m2c_cached_symfile_s *entry, *new_table;
+  m2c_symfile_t symfile;
+  const char *sympath;
+  long int time, size;
+  uint_t index, new_capacity;
+  
+  sympath = new_path_w_components
+    (server->imports.dirpath, module, server->imports.suffix);
+  
+  if (sympath == NULL) {
+    return NULL;
+  } /* end if */
+  
+  time = 0;
+  size = 0;
+  get_filetime(sympath, &time);
+  get_filesize(sympath, &size);
+  free((void *) sympath);
+  
+  /* look up cache */
+  entry = NULL;
+  for (index = 0; index < server->count; index++) {
+    if (strcmp(server->symfile[index].module, module) == 0) {
+      entry = &server->symfile[index];
+      break;
+    } /* end if */
+  } /* end for */
+  
+  if ((entry != NULL) && (entry->time == time) && (entry->size == size)) {
+    return m2c_symfile_retain(entry->symfile);
+  } /* end if */
+  
+  symfile = load_import(module, &server->imports);
+  
+  if (symfile == NULL) {
+    return NULL;
+  } /* end if */
+  
+  /* replace stale entry */
+  if (entry != NULL) {
+    m2c_symfile_release(entry->symfile);
+    entry->symfile = m2c_symfile_retain(symfile);
+    entry->time = time;
+    entry->size = size;
+    return symfile;
+  } /* end if */
+  
+  /* add new entry, if that fails the symbol file is merely not cached */
+  if (server->count == server->capacity) {
+    if (server->capacity == 0) {
+      new_capacity = M2C_SERVER_INITIAL_CACHE_CAPACITY;
+    }
+    else {
+      new_capacity = 2 * server->capacity;
+    } /* end if */
+    
+    new_table = realloc(server->symfile,
+      new_capacity * sizeof(m2c_cached_symfile_s));
+    
+    if (new_table == NULL) {
+      return symfile;
+    } /* end if */
+    
+    server->symfile = new_table;
+    server->capacity = new_capacity;
+  } /* end if */
+  
+  entry = &server->symfile[server->count];
+  entry->module = new_cstr_from_slice(module, 0, cstr_length(module));
+  
+  if (entry->module == NULL) {
+    return symfile;
+  } /* end if */
+  
+  entry->symfile = m2c_symfile_retain(symfile);
+  entry->time = time;
+  entry->size = size;
+  server->count++;
+  
+  return symfile;
+} /* end load_cached_import */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure forget_cached_import(server, basename)
+ * --------------------------------------------------------------------------
+ * Removes the cached symbol file of the module named basename from server
+ * and refreshes the listing of the working directory, which may have
+ * gained a symbol file.
+ * ----------------------------------------------------------------------- */
+
+static void forget_cached_import (m2c_server_s *server, const char *basename) {
+  uint_t index;
+  
+  for (index = 0; index < server->count; index++) {
+    if (strcmp(server->symfile[index].module, basename) == 0) {
+      m2c_symfile_release(server->symfile[index].symfile);
+      free((void *) server->symfile[index].module);
+      server->count--;
+      server->symfile[index] = server->symfile[server->count];
+      break;
+    } /* end if */
+  } /* end for */
+  
+  m2c_release_dircache(&server->imports.listing);
+  server->imports.listing = m2c_new_dircache(server->imports.dirpath);
+} /* end forget_cached_import */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure reset_server(server)
+ * --------------------------------------------------------------------------
+ * Releases all cached symbol files of server and refreshes the listing of
+ * the working directory.
+ * ----------------------------------------------------------------------- */
+
+static void reset_server (m2c_server_s *server) {
+  uint_t index;
+  
+  for (index = 0; index < server->count; index++) {
+    m2c_symfile_release(server->symfile[index].symfile);
+    free((void *) server->symfile[index].module);
+  } /* end for */
+  
+  server->count = 0;
+  
+  m2c_release_dircache(&server->imports.listing);
+  server->imports.listing = m2c_new_dircache(server->imports.dirpath);
+} /* end reset_server */
+#endif
 
 /* END OF FILE */
\ No newline at end of file
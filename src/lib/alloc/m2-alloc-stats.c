@@ -0,0 +1,348 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015-2016 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * m2-alloc-stats.c
+ *
+ * Implementation of M2C allocation accounting.
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute and/or modify it under the
+ * terms of the GNU Lesser General Public License (LGPL) either version 2.1
+ * or at your choice version 3 as published by the Free Software Foundation.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+
+#include "m2-alloc-stats.h"
+
+#include <stdlib.h>
+#include <inttypes.h>
+
+
+/* --------------------------------------------------------------------------
+ * Atomic update of counters
+ * --------------------------------------------------------------------------
+ * Counters are updated with relaxed atomic operations, they are statistics
+ * and do not order any other memory accesses.  On hosts without atomic
+ * builtins, counters are updated non-atomically and are only exact while
+ * a single thread allocates.
+ * ----------------------------------------------------------------------- */
+
+#if defined(__GNUC__) || defined(__clang__)
+#define ATOMIC_LOAD(_ptr) __atomic_load_n((_ptr), __ATOMIC_RELAXED)
+#define ATOMIC_ADD(_ptr, _value) \
+  __atomic_add_fetch((_ptr), (_value), __ATOMIC_RELAXED)
+#define ATOMIC_CAS(_ptr, _expected_ptr, _value) \
+  __atomic_compare_exchange_n((_ptr), (_expected_ptr), (_value), \
+    true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+
+#else /* no atomic builtins */
+#define ATOMIC_LOAD(_ptr) (*(_ptr))
+#define ATOMIC_ADD(_ptr, _value) (*(_ptr) += (_value))
+#define ATOMIC_CAS(_ptr, _expected_ptr, _value) \
+  ((*(_ptr) = (_value)), true)
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * Accounting switch and counters
+ * ----------------------------------------------------------------------- */
+
+static bool enabled = false;
+
+static m2c_alloc_counters_t counter[M2C_ALLOC_SUBSYSTEM_COUNT];
+
+
+/* --------------------------------------------------------------------------
+ * Subsystem names
+ * ----------------------------------------------------------------------- */
+
+static const char *subsystem_name[M2C_ALLOC_SUBSYSTEM_COUNT] = {
+  "strings",
+  "ast",
+  "fifos",
+  "symtabs",
+  "strlists"
+}; /* end subsystem_name */
+
+
+/* --------------------------------------------------------------------------
+ * Forward declarations
+ * ----------------------------------------------------------------------- */
+
+static void count_allocation (m2c_alloc_subsystem_t subsystem, size_t size);
+
+static void count_release (m2c_alloc_subsystem_t subsystem, size_t size);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_alloc_stats_enable(enable)
+ * --------------------------------------------------------------------------
+ * Turns allocation accounting on if enable is true, otherwise off.
+ * ----------------------------------------------------------------------- */
+
+void m2c_alloc_stats_enable (bool enable) {
+  enabled = enable;
+} /* end m2c_alloc_stats_enable */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_alloc_stats_enabled()
+ * --------------------------------------------------------------------------
+ * Returns true if allocation accounting is on, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_alloc_stats_enabled (void) {
+  return enabled;
+} /* end m2c_alloc_stats_enabled */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_alloc(subsystem, size)
+ * --------------------------------------------------------------------------
+ * Allocates size bytes like malloc() on behalf of subsystem and returns
+ * the allocated memory, or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+void *m2c_alloc (m2c_alloc_subsystem_t subsystem, size_t size) {
+  
+  void *ptr;
+  
+  ptr = malloc(size);
+  
+  if ((enabled) && (ptr != NULL)) {
+    count_allocation(subsystem, size);
+  } /* end if */
+  
+  return ptr;
+} /* end m2c_alloc */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_alloc_zeroed(subsystem, count, size)
+ * --------------------------------------------------------------------------
+ * Allocates count elements of size bytes like calloc() on behalf of
+ * subsystem and returns the allocated memory, or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+void *m2c_alloc_zeroed
+  (m2c_alloc_subsystem_t subsystem, size_t count, size_t size) {
+  
+  void *ptr;
+  
+  ptr = calloc(count, size);
+  
+  if ((enabled) && (ptr != NULL)) {
+    count_allocation(subsystem, count * size);
+  } /* end if */
+  
+  return ptr;
+} /* end m2c_alloc_zeroed */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_realloc(subsystem, ptr, old_size, new_size)
+ * --------------------------------------------------------------------------
+ * Resizes the memory at ptr of old_size bytes to new_size bytes like
+ * realloc() on behalf of subsystem and returns the resized memory, or NULL
+ * on failure, in which case the memory at ptr is left unchanged.
+ * ----------------------------------------------------------------------- */
+
+void *m2c_realloc
+  (m2c_alloc_subsystem_t subsystem,
+   void *ptr, size_t old_size, size_t new_size) {
+  
+  void *new_ptr;
+  
+  new_ptr = realloc(ptr, new_size);
+  
+  if ((enabled) && (new_ptr != NULL)) {
+    if (ptr != NULL) {
+      count_release(subsystem, old_size);
+    } /* end if */
+    count_allocation(subsystem, new_size);
+  } /* end if */
+  
+  return new_ptr;
+} /* end m2c_realloc */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_dealloc(subsystem, ptr, size)
+ * --------------------------------------------------------------------------
+ * Releases the memory at ptr of size bytes like free() on behalf of
+ * subsystem.
+ * ----------------------------------------------------------------------- */
+
+void m2c_dealloc (m2c_alloc_subsystem_t subsystem, void *ptr, size_t size) {
+  
+  if (ptr == NULL) {
+    return;
+  } /* end if */
+  
+  free(ptr);
+  
+  if (enabled) {
+    count_release(subsystem, size);
+  } /* end if */
+} /* end m2c_dealloc */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_alloc_stats_get(subsystem, counters)
+ * --------------------------------------------------------------------------
+ * Passes the counters of subsystem back in counters.
+ * ----------------------------------------------------------------------- */
+
+void m2c_alloc_stats_get
+  (m2c_alloc_subsystem_t subsystem, m2c_alloc_counters_t *counters) {
+  
+  if (counters == NULL) {
+    return;
+  } /* end if */
+  
+  if ((uint_fast32_t) subsystem >= M2C_ALLOC_SUBSYSTEM_COUNT) {
+    counters->allocations = 0;
+    counters->bytes = 0;
+    counters->live_bytes = 0;
+    counters->peak_live_bytes = 0;
+    return;
+  } /* end if */
+  
+  counters->allocations = ATOMIC_LOAD(&counter[subsystem].allocations);
+  counters->bytes = ATOMIC_LOAD(&counter[subsystem].bytes);
+  counters->live_bytes = ATOMIC_LOAD(&counter[subsystem].live_bytes);
+  counters->peak_live_bytes =
+    ATOMIC_LOAD(&counter[subsystem].peak_live_bytes);
+} /* end m2c_alloc_stats_get */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_alloc_subsystem_name(subsystem)
+ * --------------------------------------------------------------------------
+ * Returns an immutable lowercase name for subsystem, or NULL if invalid.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_alloc_subsystem_name (m2c_alloc_subsystem_t subsystem) {
+  
+  if ((uint_fast32_t) subsystem >= M2C_ALLOC_SUBSYSTEM_COUNT) {
+    return NULL;
+  } /* end if */
+  
+  return subsystem_name[subsystem];
+} /* end m2c_alloc_subsystem_name */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_alloc_stats_write(file)
+ * --------------------------------------------------------------------------
+ * Writes the counters of all subsystems to file, one line per subsystem.
+ * ----------------------------------------------------------------------- */
+
+void m2c_alloc_stats_write (FILE *file) {
+  
+  m2c_alloc_counters_t counters;
+  uint_fast32_t index;
+  
+  if (file == NULL) {
+    return;
+  } /* end if */
+  
+  for (index = 0; index < M2C_ALLOC_SUBSYSTEM_COUNT; index++) {
+    m2c_alloc_stats_get((m2c_alloc_subsystem_t) index, &counters);
+    fprintf(file,
+      "%-8s allocations: %" PRIu64 " bytes: %" PRIu64
+      " live: %" PRIu64 " peak: %" PRIu64 "\n",
+      subsystem_name[index], counters.allocations, counters.bytes,
+      counters.live_bytes, counters.peak_live_bytes);
+  } /* end for */
+} /* end m2c_alloc_stats_write */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_alloc_stats_reset()
+ * --------------------------------------------------------------------------
+ * Clears allocation counts and byte counts of all subsystems and sets the
+ * peak of live bytes to the current live bytes.
+ * ----------------------------------------------------------------------- */
+
+void m2c_alloc_stats_reset (void) {
+  
+  uint_fast32_t index;
+  
+  for (index = 0; index < M2C_ALLOC_SUBSYSTEM_COUNT; index++) {
+    counter[index].allocations = 0;
+    counter[index].bytes = 0;
+    counter[index].peak_live_bytes = counter[index].live_bytes;
+  } /* end for */
+} /* end m2c_alloc_stats_reset */
+
+
+/* *********************************************************************** *
+ * Private Functions                                                       *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private procedure count_allocation(subsystem, size)
+ * --------------------------------------------------------------------------
+ * Counts an allocation of size bytes for subsystem and raises its peak of
+ * live bytes if the allocation exceeds it.
+ * ----------------------------------------------------------------------- */
+
+static void count_allocation (m2c_alloc_subsystem_t subsystem, size_t size) {
+  
+  uint64_t live, peak;
+  
+  ATOMIC_ADD(&counter[subsystem].allocations, 1);
+  ATOMIC_ADD(&counter[subsystem].bytes, size);
+  live = ATOMIC_ADD(&counter[subsystem].live_bytes, size);
+  
+  peak = ATOMIC_LOAD(&counter[subsystem].peak_live_bytes);
+  while ((live > peak) &&
+         (!ATOMIC_CAS(&counter[subsystem].peak_live_bytes, &peak, live))) {
+    /* peak has been reloaded, retry */
+  } /* end while */
+} /* end count_allocation */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure count_release(subsystem, size)
+ * --------------------------------------------------------------------------
+ * Counts a release of size bytes for subsystem.  Live bytes do not drop
+ * below zero when memory allocated before accounting was turned on is
+ * released.
+ * ----------------------------------------------------------------------- */
+
+static void count_release (m2c_alloc_subsystem_t subsystem, size_t size) {
+  
+  uint64_t live, new_live;
+  
+  live = ATOMIC_LOAD(&counter[subsystem].live_bytes);
+  do {
+    new_live = (live > size) ? live - size : 0;
+  } while (!ATOMIC_CAS(&counter[subsystem].live_bytes, &live, new_live));
+} /* end count_release */
+
+
+/* END OF FILE */
@@ -0,0 +1,198 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015-2016 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * m2-alloc-stats.h
+ *
+ * Public interface for M2C allocation accounting.
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute and/or modify it under the
+ * terms of the GNU Lesser General Public License (LGPL) either version 2.1
+ * or at your choice version 3 as published by the Free Software Foundation.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+
+#ifndef M2C_ALLOC_STATS_H
+#define M2C_ALLOC_STATS_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+
+/* --------------------------------------------------------------------------
+ * Allocation accounting
+ * --------------------------------------------------------------------------
+ * Subsystems allocate and release their memory through the functions of
+ * this interface, which count allocations, allocated bytes, live bytes and
+ * the peak of live bytes per subsystem.  Accounting is off by default, the
+ * functions then reduce to plain calls of malloc(), calloc(), realloc()
+ * and free().  Counters are process wide and may be updated concurrently.
+ * An arena allocates its nodes in chunks, thus allocations count chunks
+ * of an arena, not the nodes carved from it.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_alloc_subsystem_t
+ * --------------------------------------------------------------------------
+ * Enumeration representing the subsystems whose allocations are counted.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_ALLOC_STRINGS,  /* string repository */
+  M2C_ALLOC_AST,      /* AST nodes and arenas */
+  M2C_ALLOC_FIFOS,    /* FIFO queues */
+  M2C_ALLOC_SYMTABS,  /* symbol tables */
+  M2C_ALLOC_STRLISTS  /* string lists */
+} m2c_alloc_subsystem_t;
+
+#define M2C_ALLOC_SUBSYSTEM_COUNT (M2C_ALLOC_STRLISTS + 1)
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_alloc_counters_t
+ * --------------------------------------------------------------------------
+ * Record type representing the allocation counters of a subsystem.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* allocations */ uint64_t allocations;
+  /* bytes */ uint64_t bytes;
+  /* live_bytes */ uint64_t live_bytes;
+  /* peak_live_bytes */ uint64_t peak_live_bytes;
+} m2c_alloc_counters_t;
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_alloc_stats_enable(enable)
+ * --------------------------------------------------------------------------
+ * Turns allocation accounting on if enable is true, otherwise off.  Should
+ * be called before any counted allocation is made, memory allocated while
+ * accounting is off is not counted as live when it is released.
+ * ----------------------------------------------------------------------- */
+
+void m2c_alloc_stats_enable (bool enable);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_alloc_stats_enabled()
+ * --------------------------------------------------------------------------
+ * Returns true if allocation accounting is on, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_alloc_stats_enabled (void);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_alloc(subsystem, size)
+ * --------------------------------------------------------------------------
+ * Allocates size bytes like malloc() on behalf of subsystem and returns
+ * the allocated memory, or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+void *m2c_alloc (m2c_alloc_subsystem_t subsystem, size_t size);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_alloc_zeroed(subsystem, count, size)
+ * --------------------------------------------------------------------------
+ * Allocates count elements of size bytes like calloc() on behalf of
+ * subsystem and returns the allocated memory, or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+void *m2c_alloc_zeroed
+  (m2c_alloc_subsystem_t subsystem, size_t count, size_t size);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_realloc(subsystem, ptr, old_size, new_size)
+ * --------------------------------------------------------------------------
+ * Resizes the memory at ptr of old_size bytes to new_size bytes like
+ * realloc() on behalf of subsystem and returns the resized memory, or NULL
+ * on failure, in which case the memory at ptr is left unchanged.
+ * ----------------------------------------------------------------------- */
+
+void *m2c_realloc
+  (m2c_alloc_subsystem_t subsystem,
+   void *ptr, size_t old_size, size_t new_size);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_dealloc(subsystem, ptr, size)
+ * --------------------------------------------------------------------------
+ * Releases the memory at ptr of size bytes like free() on behalf of
+ * subsystem.  Size must be the size the memory was allocated with.
+ * ----------------------------------------------------------------------- */
+
+void m2c_dealloc (m2c_alloc_subsystem_t subsystem, void *ptr, size_t size);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_alloc_stats_get(subsystem, counters)
+ * --------------------------------------------------------------------------
+ * Passes the counters of subsystem back in counters.  Passes back zeroes
+ * if subsystem is invalid.  No operation is carried out if counters is
+ * NULL.
+ * ----------------------------------------------------------------------- */
+
+void m2c_alloc_stats_get
+  (m2c_alloc_subsystem_t subsystem, m2c_alloc_counters_t *counters);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_alloc_subsystem_name(subsystem)
+ * --------------------------------------------------------------------------
+ * Returns an immutable lowercase name for subsystem, or NULL if subsystem
+ * is invalid.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_alloc_subsystem_name (m2c_alloc_subsystem_t subsystem);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_alloc_stats_write(file)
+ * --------------------------------------------------------------------------
+ * Writes the counters of all subsystems to file, one line per subsystem.
+ * No operation is carried out if file is NULL.
+ * ----------------------------------------------------------------------- */
+
+void m2c_alloc_stats_write (FILE *file);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_alloc_stats_reset()
+ * --------------------------------------------------------------------------
+ * Clears allocation counts and byte counts of all subsystems and sets the
+ * peak of live bytes to the current live bytes.
+ * ----------------------------------------------------------------------- */
+
+void m2c_alloc_stats_reset (void);
+
+
+#endif /* M2C_ALLOC_STATS_H */
+
+/* END OF FILE */
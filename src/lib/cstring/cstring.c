@@ -30,6 +30,7 @@
 
 #include <stdlib.h>
 #include <stdarg.h>
+#include <string.h>
 
 
 /* --------------------------------------------------------------------------
@@ -47,6 +48,43 @@
 #define RANK_NONE (-2)
 
 
+/* --------------------------------------------------------------------------
+ * Default chunk size of string arenas
+ * ----------------------------------------------------------------------- */
+
+#define CSTR_ARENA_DEFAULT_CHUNK_SIZE 4096
+
+
+/* --------------------------------------------------------------------------
+ * private type cstr_arena_chunk_t
+ * --------------------------------------------------------------------------
+ * pointer type representing a chunk of a string arena.  Field used holds
+ * the number of bytes of the chunk already handed out.
+ * ----------------------------------------------------------------------- */
+
+typedef struct cstr_arena_chunk_s *cstr_arena_chunk_t;
+
+struct cstr_arena_chunk_s {
+  /* next */ cstr_arena_chunk_t next;
+  /* size */ unsigned size;
+  /* used */ unsigned used;
+  /* data */ char data[];
+};
+
+
+/* --------------------------------------------------------------------------
+ * hidden type cstr_arena_s
+ * --------------------------------------------------------------------------
+ * record type representing a string arena.  New strings are allocated from
+ * the chunk at the head of the chunk list.
+ * ----------------------------------------------------------------------- */
+
+struct cstr_arena_s {
+  /* chunk_size */ unsigned chunk_size;
+  /* head */ cstr_arena_chunk_t head;
+};
+
+
 /* --------------------------------------------------------------------------
  * Collation ranking table for dictionary mode, lower- before uppercase
  * ----------------------------------------------------------------------- */
@@ -166,17 +204,12 @@ static inline short int collation_rank (char ch, cstr_collation_mode_t mode);
  * ----------------------------------------------------------------------- */
 
 unsigned cstr_length (const char *cstr) {
-  unsigned length = 0;
   
   if (cstr == NULL) {
     return 0;
   } /* end if */
   
-  while (cstr[length] != ASCII_NUL) {
-    length++;
-  } /* end while */
-  
-  return length;
+  return (unsigned) strlen(cstr);
 } /* end cstr_length */
 
 
@@ -187,23 +220,7 @@ unsigned cstr_length (const char *cstr) {
  * ----------------------------------------------------------------------- */
 
 char cstr_last_char (const char *cstr) {
-  
-  unsigned index = 0;
-  
-  if (cstr == NULL) {
-    return ASCII_NUL;
-  } /* end if */
-  
-  while (cstr[index] != ASCII_NUL) {
-    index++;
-  } /* end while */
-  
-  if (index > 0) {
-    return cstr[index-1];
-  }
-  else {
-    return ASCII_NUL;
-  } /* end if */
+  return cstr_view_last_char(cstr_view(cstr));
 } /* end cstr_last_char */
 
 
@@ -214,20 +231,13 @@ char cstr_last_char (const char *cstr) {
  * ----------------------------------------------------------------------- */
 
 bool cstr_contains_char(const char *cstr, char ch) {
-  unsigned index = 0;
   
-  if (cstr == NULL) {
+  /* the terminator is not part of cstr */
+  if ((cstr == NULL) || (ch == ASCII_NUL)) {
     return false;
   } /* end if */
   
-  while (cstr[index] != ASCII_NUL) {
-    if (cstr[index] == ch) {
-      return true; 
-    } /* end if */
-    index++;
-  } /* end for */
-  
-  return false;
+  return (strchr(cstr, ch) != NULL);
 } /* end cstr_contains_char */
 
 
@@ -324,10 +334,9 @@ const char *new_cstr_from_slice
   } /* end if */
   
   /* length of source must not be less than start_index + length */
-  index = 0;
   reqlen = start_index + length;
   for (index = 0; index < reqlen; index++) {
-    if (source[0] == ASCII_NUL) {
+    if (source[index] == ASCII_NUL) {
       return NULL;
     } /* end if */
   } /* end for */
@@ -341,9 +350,7 @@ const char *new_cstr_from_slice
   } /* end if */
   
   /* copy slice from source to target */
-  for (index = 0; index < length; index++) {
-    target[index] = source[start_index + index];
-  } /* end for */
+  memcpy(target, source + start_index, length);
   
   /* terminate target */
   target[length] = ASCII_NUL;
@@ -425,6 +432,267 @@ const char *new_cstr_by_concat (const char *first, ...) {
 } /* end new_cstr_by_concat */
 
 
+/* --------------------------------------------------------------------------
+ * function cstr_view(cstr)
+ * --------------------------------------------------------------------------
+ * Returns a view of C string cstr, excluding its NUL terminator.  Returns
+ * an empty view if cstr is NULL.  The length of cstr is obtained once.
+ * ----------------------------------------------------------------------- */
+
+cstr_view_t cstr_view (const char *cstr) {
+  cstr_view_t view;
+  
+  if (cstr == NULL) {
+    view.ptr = "";
+    view.len = 0;
+  }
+  else {
+    view.ptr = cstr;
+    view.len = (unsigned) strlen(cstr);
+  } /* end if */
+  
+  return view;
+} /* end cstr_view */
+
+
+/* --------------------------------------------------------------------------
+ * function cstr_view_w_len(ptr, len)
+ * --------------------------------------------------------------------------
+ * Returns a view of len characters starting at ptr.  Use this function
+ * when the length is already known, as for interned strings.
+ * ----------------------------------------------------------------------- */
+
+cstr_view_t cstr_view_w_len (const char *ptr, unsigned len) {
+  cstr_view_t view;
+  
+  if (ptr == NULL) {
+    view.ptr = "";
+    view.len = 0;
+  }
+  else {
+    view.ptr = ptr;
+    view.len = len;
+  } /* end if */
+  
+  return view;
+} /* end cstr_view_w_len */
+
+
+/* --------------------------------------------------------------------------
+ * function cstr_view_last_char(view)
+ * --------------------------------------------------------------------------
+ * Returns last character of view, or ASCII NUL if view is empty.
+ * ----------------------------------------------------------------------- */
+
+char cstr_view_last_char (cstr_view_t view) {
+  
+  if (view.len == 0) {
+    return ASCII_NUL;
+  } /* end if */
+  
+  return view.ptr[view.len - 1];
+} /* end cstr_view_last_char */
+
+
+/* --------------------------------------------------------------------------
+ * function cstr_view_contains_char(view, ch)
+ * --------------------------------------------------------------------------
+ * Returns true if view contains ch, otherwise false.  Searches with the C
+ * library's memchr(), which is vectorised on mainstream hosts.
+ * ----------------------------------------------------------------------- */
+
+bool cstr_view_contains_char (cstr_view_t view, char ch) {
+  
+  if (view.len == 0) {
+    return false;
+  } /* end if */
+  
+  return (memchr(view.ptr, ch, view.len) != NULL);
+} /* end cstr_view_contains_char */
+
+
+/* --------------------------------------------------------------------------
+ * function cstr_view_match(view1, view2)
+ * --------------------------------------------------------------------------
+ * Returns true if view1 and view2 have the same length and characters,
+ * otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool cstr_view_match (cstr_view_t view1, cstr_view_t view2) {
+  
+  /* lengths are compared first, without touching the text */
+  if (view1.len != view2.len) {
+    return false;
+  } /* end if */
+  
+  return (memcmp(view1.ptr, view2.ptr, view1.len) == 0);
+} /* end cstr_view_match */
+
+
+/* --------------------------------------------------------------------------
+ * function new_cstr_from_views(count, views)
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated and NUL terminated C string containing the
+ * concatenation of the count views in array views in left-to-right order.
+ * The required size is known from the views, the text of each view is
+ * copied once.  Returns NULL if views is NULL or if allocation fails.
+ * ----------------------------------------------------------------------- */
+
+const char *new_cstr_from_views (unsigned count, const cstr_view_t *views) {
+  unsigned reqlen, index, offset;
+  char *target;
+  
+  if (views == NULL) {
+    return NULL;
+  } /* end if */
+  
+  /* calculate required length for target */
+  reqlen = 0;
+  for (index = 0; index < count; index++) {
+    reqlen = reqlen + views[index].len;
+  } /* end for */
+  
+  /* allocate target string */
+  target = malloc(reqlen + 1);
+  
+  if (target == NULL) {
+    return NULL;
+  } /* end if */
+  
+  /* copy views to target */
+  offset = 0;
+  for (index = 0; index < count; index++) {
+    memcpy(target + offset, views[index].ptr, views[index].len);
+    offset = offset + views[index].len;
+  } /* end for */
+  
+  /* terminate target */
+  target[offset] = ASCII_NUL;
+  
+  return (const char *) target;
+} /* end new_cstr_from_views */
+
+
+/* --------------------------------------------------------------------------
+ * function cstr_new_arena(chunk_size)
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated empty arena whose chunks hold chunk_size bytes,
+ * or a default size if chunk_size is zero.  Returns NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+cstr_arena_t cstr_new_arena (unsigned chunk_size) {
+  cstr_arena_t new_arena;
+  
+  new_arena = malloc(sizeof(struct cstr_arena_s));
+  
+  if (new_arena == NULL) {
+    return NULL;
+  } /* end if */
+  
+  if (chunk_size == 0) {
+    chunk_size = CSTR_ARENA_DEFAULT_CHUNK_SIZE;
+  } /* end if */
+  
+  /* chunks are allocated on demand */
+  new_arena->chunk_size = chunk_size;
+  new_arena->head = NULL;
+  
+  return new_arena;
+} /* end cstr_new_arena */
+
+
+/* --------------------------------------------------------------------------
+ * function cstr_arena_concat(arena, count, views)
+ * --------------------------------------------------------------------------
+ * Returns a NUL terminated C string allocated in arena, containing the
+ * concatenation of the count views in array views in left-to-right order.
+ * The string must not be released by the caller, it lives until the arena
+ * is released.  Returns NULL if arena or views is NULL or if allocation
+ * fails.
+ * ----------------------------------------------------------------------- */
+
+const char *cstr_arena_concat
+  (cstr_arena_t arena, unsigned count, const cstr_view_t *views) {
+  
+  cstr_arena_chunk_t chunk;
+  unsigned reqsize, size, index;
+  char *target;
+  
+  if ((arena == NULL) || (views == NULL)) {
+    return NULL;
+  } /* end if */
+  
+  /* calculate required size including terminator */
+  reqsize = 1;
+  for (index = 0; index < count; index++) {
+    reqsize = reqsize + views[index].len;
+  } /* end for */
+  
+  chunk = arena->head;
+  
+  /* start a new chunk if the current one cannot hold the string */
+  if ((chunk == NULL) || (chunk->size - chunk->used < reqsize)) {
+    size = arena->chunk_size;
+    
+    /* oversized strings get a chunk of their own */
+    if (reqsize > size) {
+      size = reqsize;
+    } /* end if */
+    
+    chunk = malloc(sizeof(struct cstr_arena_chunk_s) + size);
+    
+    if (chunk == NULL) {
+      return NULL;
+    } /* end if */
+    
+    chunk->size = size;
+    chunk->used = 0;
+    chunk->next = arena->head;
+    arena->head = chunk;
+  } /* end if */
+  
+  target = chunk->data + chunk->used;
+  chunk->used = chunk->used + reqsize;
+  
+  /* copy views to target */
+  size = 0;
+  for (index = 0; index < count; index++) {
+    memcpy(target + size, views[index].ptr, views[index].len);
+    size = size + views[index].len;
+  } /* end for */
+  
+  /* terminate target */
+  target[size] = ASCII_NUL;
+  
+  return (const char *) target;
+} /* end cstr_arena_concat */
+
+
+/* --------------------------------------------------------------------------
+ * procedure cstr_release_arena(arena)
+ * --------------------------------------------------------------------------
+ * Releases arena and all strings allocated in it, passes back NULL.
+ * ----------------------------------------------------------------------- */
+
+void cstr_release_arena (cstr_arena_t *arena) {
+  cstr_arena_chunk_t chunk, next;
+  
+  if ((arena == NULL) || (*arena == NULL)) {
+    return;
+  } /* end if */
+  
+  chunk = (*arena)->head;
+  while (chunk != NULL) {
+    next = chunk->next;
+    free(chunk);
+    chunk = next;
+  } /* end while */
+  
+  free(*arena);
+  *arena = NULL;
+} /* end cstr_release_arena */
+
+
 /* *********************************************************************** *
  * Private Functions
  * *********************************************************************** */
@@ -34,8 +34,49 @@
  */
 
 #include "m2-fifo.h"
+#include "m2-alloc-stats.h"
 
 #include <stdlib.h>
+#include <stdint.h>
+
+
+/* --------------------------------------------------------------------------
+ * Atomic access to the shared counters of SPSC queues
+ * --------------------------------------------------------------------------
+ * The producer publishes values with a release store of its tail counter,
+ * the consumer publishes free space with a release store of its head
+ * counter, each side reads the other side's counter with an acquire load.
+ * MSVC gives volatile accesses these semantics.  On other hosts a queue
+ * must not be shared between threads.
+ * ----------------------------------------------------------------------- */
+
+#if defined(__GNUC__) || defined(__clang__)
+#define LOAD_ACQUIRE(_ptr) __atomic_load_n((_ptr), __ATOMIC_ACQUIRE)
+#define STORE_RELEASE(_ptr, _value) \
+  __atomic_store_n((_ptr), (_value), __ATOMIC_RELEASE)
+
+#elif defined(_MSC_VER)
+#define LOAD_ACQUIRE(_ptr) (*(volatile uint_t *) (_ptr))
+#define STORE_RELEASE(_ptr, _value) (*(volatile uint_t *) (_ptr) = (_value))
+
+#else
+#define LOAD_ACQUIRE(_ptr) (*(_ptr))
+#define STORE_RELEASE(_ptr, _value) (*(_ptr) = (_value))
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * Allocation sizes of queues and segments
+ * ----------------------------------------------------------------------- */
+
+#define QUEUE_ALLOC_SIZE (sizeof(m2c_fifo_struct_t) + \
+  M2C_FIFO_SEGMENT_SIZE * sizeof(m2c_fifo_value_t))
+
+#define SEGMENT_ALLOC_SIZE (sizeof(m2c_fifo_segment_s) + \
+  M2C_FIFO_SEGMENT_SIZE * sizeof(m2c_fifo_value_t))
+
+#define SPSC_BASE_ALLOC_SIZE \
+  (sizeof(m2c_fifo_spsc_struct_t) + M2C_FIFO_CACHE_LINE_SIZE)
 
 
 /* --------------------------------------------------------------------------
@@ -54,6 +95,41 @@ struct m2c_fifo_segment_s {
 typedef struct m2c_fifo_segment_s m2c_fifo_segment_s;
 
 
+/* --------------------------------------------------------------------------
+ * Initial capacity and maximum load of a membership index
+ * ----------------------------------------------------------------------- */
+
+#define M2C_FIFO_INDEX_INIT_CAPACITY (2 * M2C_FIFO_SEGMENT_SIZE)
+
+#define M2C_FIFO_INDEX_MAX_LOAD_PERCENT 75
+
+
+/* --------------------------------------------------------------------------
+ * private type m2c_fifo_index_t
+ * --------------------------------------------------------------------------
+ * pointer type representing the membership index of a FIFO queue.  The
+ * index is an open addressing table with linear probing, keyed by value.
+ * Each slot holds a distinct value and the number of its occurrences in
+ * the queue.  A slot is empty if its value is NULL.  The capacity is a
+ * power of two.  Slots are vacated by backward shift, without tombstones.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* value */ m2c_fifo_value_t value;
+  /* count */ uint_t count;
+} m2c_fifo_member_s;
+
+typedef struct m2c_fifo_index_s *m2c_fifo_index_t;
+
+struct m2c_fifo_index_s {
+  /* capacity */ uint_t capacity;
+  /* used */ uint_t used;
+  /* slot */ m2c_fifo_member_s *slot;
+};
+
+typedef struct m2c_fifo_index_s m2c_fifo_index_s;
+
+
 /* --------------------------------------------------------------------------
  * hidden type m2c_fifo_struct_t
  * --------------------------------------------------------------------------
@@ -64,6 +140,7 @@ struct m2c_fifo_struct_t {
   /* entry_count */ uint_t entry_count;
   /* head_index */ uint_t head_index;
   /* tail_index */ uint_t tail_index;
+  /* index */ m2c_fifo_index_t index;
   /* next */ m2c_fifo_segment_t next;
   /* table */ m2c_fifo_value_t table[M2C_FIFO_SEGMENT_SIZE];
 };
@@ -71,12 +148,114 @@ struct m2c_fifo_struct_t {
 typedef struct m2c_fifo_struct_t m2c_fifo_struct_t;
 
 
+/* --------------------------------------------------------------------------
+ * private type m2c_fifo_spsc_segment_t
+ * --------------------------------------------------------------------------
+ * pointer type representing an SPSC queue segment.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_fifo_spsc_segment_s *m2c_fifo_spsc_segment_t;
+
+struct m2c_fifo_spsc_segment_s {
+  /* next */ m2c_fifo_spsc_segment_t next;
+  /* table */ m2c_fifo_value_t table[M2C_FIFO_SPSC_SEGMENT_SIZE];
+};
+
+typedef struct m2c_fifo_spsc_segment_s m2c_fifo_spsc_segment_s;
+
+
+/* --------------------------------------------------------------------------
+ * private type m2c_fifo_spsc_consumer_s
+ * --------------------------------------------------------------------------
+ * record type representing the consumer side of an SPSC queue.  Field
+ * head_count is the number of values ever removed, it is written by the
+ * consumer and read by the producer.  Field tail_cache is the consumer's
+ * last reading of the producer's tail_count, it is reloaded only when the
+ * queue seems empty.  Field index is the position of the next value to be
+ * removed in segment.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* head_count */ uint_t head_count;
+  /* tail_cache */ uint_t tail_cache;
+  /* index */ uint_t index;
+  /* segment */ m2c_fifo_spsc_segment_t segment;
+} m2c_fifo_spsc_consumer_s;
+
+
+/* --------------------------------------------------------------------------
+ * private type m2c_fifo_spsc_producer_s
+ * --------------------------------------------------------------------------
+ * record type representing the producer side of an SPSC queue.  Field
+ * tail_count is the number of values ever added, it is written by the
+ * producer and read by the consumer.  Field head_cache is the producer's
+ * last reading of the consumer's head_count.  Field index is the position
+ * of the next value to be added in segment.  Segments drained by the
+ * consumer remain linked, field spare is the oldest of them and spare_count
+ * the value count at which it started.  They are reused by the producer
+ * instead of being deallocated.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* tail_count */ uint_t tail_count;
+  /* head_cache */ uint_t head_cache;
+  /* index */ uint_t index;
+  /* capacity */ uint_t capacity;
+  /* spare_count */ uint_t spare_count;
+  /* segment */ m2c_fifo_spsc_segment_t segment;
+  /* spare */ m2c_fifo_spsc_segment_t spare;
+  /* base */ void *base;
+} m2c_fifo_spsc_producer_s;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_fifo_spsc_struct_t
+ * --------------------------------------------------------------------------
+ * record type representing an SPSC queue object.  Each side is padded to
+ * a cache line of its own and the object is aligned to a cache line, the
+ * counters of producer and consumer therefore never share a cache line.
+ * Field base is the address of the allocation holding the object.
+ * ----------------------------------------------------------------------- */
+
+struct m2c_fifo_spsc_struct_t {
+  /* consumer */ union {
+    m2c_fifo_spsc_consumer_s side;
+    char pad[M2C_FIFO_CACHE_LINE_SIZE];
+  } consumer;
+  /* producer */ union {
+    m2c_fifo_spsc_producer_s side;
+    char pad[M2C_FIFO_CACHE_LINE_SIZE];
+  } producer;
+};
+
+typedef struct m2c_fifo_spsc_struct_t m2c_fifo_spsc_struct_t;
+
+
 /* --------------------------------------------------------------------------
  * forward declarations
  * ----------------------------------------------------------------------- */
 
+static m2c_fifo_t append_value
+  (m2c_fifo_t queue, m2c_fifo_value_t new_value);
+
+static m2c_fifo_value_t remove_head (m2c_fifo_t queue);
+
 static m2c_fifo_segment_t alloc_init_segment (void);
 
+static m2c_fifo_index_t new_index (void);
+
+static inline uint_t home_slot (m2c_fifo_value_t value, uint_t mask);
+
+static uint_t index_probe (m2c_fifo_index_t index, m2c_fifo_value_t value);
+
+static bool index_reserve (m2c_fifo_index_t index);
+
+static void index_add (m2c_fifo_index_t index, m2c_fifo_value_t value);
+
+static void index_remove (m2c_fifo_index_t index, m2c_fifo_value_t value);
+
+static m2c_fifo_spsc_segment_t next_spsc_segment (m2c_fifo_spsc_t queue);
+
 
 /* --------------------------------------------------------------------------
  * function m2c_fifo_new_queue(first_value)
@@ -91,9 +270,7 @@ m2c_fifo_t m2c_fifo_new_queue (m2c_fifo_value_t first_value) {
   uint_t index;
   
   /* allocate new queue */
-  new_queue = malloc
-    (sizeof(m2c_fifo_struct_t) +
-     M2C_FIFO_SEGMENT_SIZE * sizeof(m2c_fifo_value_t));
+  new_queue = m2c_alloc(M2C_ALLOC_FIFOS, QUEUE_ALLOC_SIZE);
   
   if (new_queue == NULL) {
     return NULL;
@@ -108,6 +285,7 @@ m2c_fifo_t m2c_fifo_new_queue (m2c_fifo_value_t first_value) {
   
   new_queue->head_index = 0;
   new_queue->tail_index = 0;
+  new_queue->index = NULL;
   new_queue->next = NULL;
   
   new_queue->table[0] = first_value;
@@ -121,70 +299,63 @@ m2c_fifo_t m2c_fifo_new_queue (m2c_fifo_value_t first_value) {
 
 
 /* --------------------------------------------------------------------------
- * function m2c_fifo_enqueue(queue, new_value)
+ * function m2c_fifo_new_indexed_queue(first_value)
  * --------------------------------------------------------------------------
- * Adds a value to the head of queue and returns queue, or NULL on failure.
+ * Allocates a new queue object like m2c_fifo_new_queue() but with a
+ * membership index that is maintained on enqueue and dequeue.  Functions
+ * m2c_fifo_entry_exists() and m2c_fifo_enqueue_unique() then take constant
+ * time.  Returns NULL on failure.
  * ----------------------------------------------------------------------- */
 
-m2c_fifo_t m2c_fifo_enqueue (m2c_fifo_t queue, m2c_fifo_value_t new_value) {
+m2c_fifo_t m2c_fifo_new_indexed_queue (m2c_fifo_value_t first_value) {
   
-  uint_t index, new_tail_index, this_segment_index, target_segment_index;
-  m2c_fifo_segment_t this_segment, new_segment;
+  m2c_fifo_t new_queue;
   
-  if ((queue == NULL) || (new_value == NULL)) {
+  new_queue = m2c_fifo_new_queue(first_value);
+  
+  if (new_queue == NULL) {
     return NULL;
-  } /* end if */ 
+  } /* end if */
   
-  if (queue->entry_count > 0) {
-    new_tail_index = queue->tail_index + 1;
+  new_queue->index = new_index();
+  
+  if (new_queue->index == NULL) {
+    m2c_dealloc(M2C_ALLOC_FIFOS, new_queue, QUEUE_ALLOC_SIZE);
+    return NULL;
   } /* end if */
   
-  /* check if tail is within base segment */
-  if (new_tail_index < M2C_FIFO_SEGMENT_SIZE) {
-    /* store value in base segment */
-    queue->table[new_tail_index] = new_value;
-    queue->entry_count++;
-    queue->tail_index++;
-    return queue;
+  if (first_value != NULL) {
+    index_add(new_queue->index, first_value);
   } /* end if */
   
-  if (queue->next == NULL) {
-    new_segment = alloc_init_segment();
-    
-    if (new_segment == NULL) {
-      return NULL;
-    } /* end if */
-    
-    queue->next = new_segment;
+  return new_queue;
+} /* end m2c_fifo_new_indexed_queue */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_fifo_enqueue(queue, new_value)
+ * --------------------------------------------------------------------------
+ * Adds a value to the head of queue and returns queue, or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2c_fifo_t m2c_fifo_enqueue (m2c_fifo_t queue, m2c_fifo_value_t new_value) {
+  
+  if ((queue == NULL) || (new_value == NULL)) {
+    return NULL;
   } /* end if */
   
-  this_segment_index = 1;
-  this_segment = queue->next;
-  target_segment_index = new_tail_index / M2C_FIFO_SEGMENT_SIZE;
+  /* make room in the index first, adding to it can then not fail */
+  if ((queue->index != NULL) && (index_reserve(queue->index) == false)) {
+    return NULL;
+  } /* end if */
   
-  /* find target segment */
-  while (this_segment_index != target_segment_index) {
-    
-    if (this_segment->next == NULL) {
-      /* allocate new segment */
-      new_segment = alloc_init_segment();
-      
-      if (new_segment == NULL) {
-        return NULL;
-      } /* end if */
-      
-      this_segment->next = new_segment;
-    } /* end if */
-    
-    this_segment = this_segment->next;
-    this_segment_index++;
-  } /* end while */
+  if (append_value(queue, new_value) == NULL) {
+    return NULL;
+  } /* end if */
   
-  /* store new value in target segment */
-  index = new_tail_index % M2C_FIFO_SEGMENT_SIZE;
-  this_segment->table[index] = new_value;
-  queue->entry_count++;
-  queue->tail_index++;
+  if (queue->index != NULL) {
+    index_add(queue->index, new_value);
+  } /* end if */
   
   return queue;
 } /* end m2c_fifo_enqueue */
@@ -218,65 +389,13 @@ m2c_fifo_t m2c_fifo_enqueue_unique
 m2c_fifo_value_t m2c_fifo_dequeue (m2c_fifo_t queue) {
   
   m2c_fifo_value_t head_value;
-  m2c_fifo_segment_t this_segment;
-  uint_t head_index, table_index, this_segment_index, target_segment_index;
-  
-  if ((queue == NULL) || (queue->entry_count == 0)) {
-    return NULL;
-  } /* end if */ 
-  
-  head_index = queue->head_index;
-  
-  /* check if head entry is within base segment */
-  if (queue->head_index < M2C_FIFO_SEGMENT_SIZE) {
-    
-    /* remove head entry */
-    head_value = queue->table[head_index];
-    queue->table[head_index] = NULL;
-    queue->entry_count--;
-    
-    if (queue->entry_count == 0) {
-      queue->head_index = 0;
-      queue->tail_index = 0;
-    }
-    else {
-      queue->head_index++;
-    } /* end if */
-    
-    /* and return it */
-    return head_value;
-  } /* end if */
-  
-  this_segment_index = 1;
-  this_segment = queue->next;
-  target_segment_index = head_index / M2C_FIFO_SEGMENT_SIZE;
-  
-  /* find target segment */
-  while (this_segment_index != target_segment_index) {
-    
-    this_segment = this_segment->next;
-    this_segment_index++;
-    
-    if (this_segment == NULL) {
-      return NULL;
-    } /* end if */
-  } /* end while */
   
-  /* remove head entry */
-  table_index = head_index % M2C_FIFO_SEGMENT_SIZE;
-  head_value = this_segment->table[table_index];
-  this_segment->table[table_index] = NULL;
-  queue->entry_count--;
+  head_value = remove_head(queue);
   
-  if (queue->entry_count == 0) {
-    queue->head_index = 0;
-    queue->tail_index = 0;
-  }
-  else {
-    queue->head_index++;
+  if ((head_value != NULL) && (queue->index != NULL)) {
+    index_remove(queue->index, head_value);
   } /* end if */
   
-  /* and return it */
   return head_value;
 } /* end m2c_fifo_dequeue */
 
@@ -306,76 +425,59 @@ uint_t m2c_fifo_entry_count (m2c_fifo_t queue) {
 bool m2c_fifo_entry_exists (m2c_fifo_t queue, m2c_fifo_value_t value) {
   
   m2c_fifo_segment_t this_segment;
+  m2c_fifo_value_t *table;
   uint_t index, table_index, this_segment_index, target_segment_index;
   
-  if ((queue == NULL) || (value == NULL)) {
+  if ((queue == NULL) || (value == NULL) || (queue->entry_count == 0)) {
     return false;
   } /* end if */ 
   
-  /*** case 1 : both head and tail in base segment ***/
+  /* indexed queue, one probe */
+  if (queue->index != NULL) {
+    return (queue->index->slot[index_probe(queue->index, value)].value != NULL);
+  } /* end if */
   
-  if (queue->head_index < M2C_FIFO_SEGMENT_SIZE) {
-    if (queue->tail_index < M2C_FIFO_SEGMENT_SIZE) {
-      /* search in base segment */
-      for (index = queue->head_index;
-           index <= queue->tail_index; index++) {
-        if /* not unique */ (queue->table[index] == value) {
-          return true;
-        } /* end if */
-      } /* end for */
-      return false;
-    }
-    
-  /*** case 2 : head in base segment, tail further down ***/
+  /* move to the segment holding the head entry */
+  this_segment = NULL;
+  this_segment_index = 0;
+  target_segment_index = queue->head_index / M2C_FIFO_SEGMENT_SIZE;
   
-    else {
-      /* search in base segment */
-      for (index = queue->head_index;
-           index < M2C_FIFO_SEGMENT_SIZE; index++) {
-        if /* not unique */ (queue->table[index] == value) {
-          return true;
-        } /* end if */
-      } /* end for */
-      
-      /* proceed to next segment */
-      index = 0;
+  while (this_segment_index < target_segment_index) {
+    if (this_segment == NULL) {
       this_segment = queue->next;
+    }
+    else {
+      this_segment = this_segment->next;
     } /* end if */
-  }
-  
-  /*** case 3 : both head and tail further down ***/
+    this_segment_index++;
+  } /* end while */
   
+  if (this_segment == NULL) {
+    table = queue->table;
+  }
   else {
-    /* set table index from where to commence */
-    index = queue->head_index;
-    
-    /* set segment from where to commence */
-    this_segment_index = 1;
-    this_segment = queue->next;
-    target_segment_index = queue->head_index / M2C_FIFO_SEGMENT_SIZE;
-    
-    /* move to target segment */
-    while (this_segment_index < target_segment_index) {
-      this_segment = this_segment->next;
-      this_segment_index++;
-    } /* end while */
+    table = this_segment->table;
   } /* end if */
   
-  /*** continue search for cases 2 and 3 ***/
-  
-  while (index < queue->tail_index) {
+  /* search from head to tail */
+  for (index = queue->head_index; index <= queue->tail_index; index++) {
     table_index = index % M2C_FIFO_SEGMENT_SIZE;
     
-    if (this_segment->table[table_index] == value) {
-      return true;
+    /* proceed to next segment */
+    if ((table_index == 0) && (index != queue->head_index)) {
+      if (this_segment == NULL) {
+        this_segment = queue->next;
+      }
+      else {
+        this_segment = this_segment->next;
+      } /* end if */
+      table = this_segment->table;
     } /* end if */
     
-    if ((table_index + 1) == M2C_FIFO_SEGMENT_SIZE) {
-      this_segment = this_segment->next;
+    if (table[table_index] == value) {
+      return true;
     } /* end if */
-    
-    index++;
-  } /* end while */ 
+  } /* end for */
   
   return false;
 } /* end m2c_fifo_entry_exists */
@@ -402,6 +504,14 @@ m2c_fifo_t m2c_fifo_reset_queue (m2c_fifo_t queue) {
   queue->head_index = 0;
   queue->tail_index = 0;
   
+  /* reset membership index */
+  if (queue->index != NULL) {
+    for (index = 0; index < queue->index->capacity; index++) {
+      queue->index->slot[index].value = NULL;
+    } /* end for */
+    queue->index->used = 0;
+  } /* end if */
+  
   /* reset all entries in base segment */
   for (index = 0; index < M2C_FIFO_SEGMENT_SIZE; index++) {
     queue->table[index] = NULL;
@@ -426,50 +536,712 @@ m2c_fifo_t m2c_fifo_reset_queue (m2c_fifo_t queue) {
 /* --------------------------------------------------------------------------
  * function m2c_fifo_release_queue(queue)
  * --------------------------------------------------------------------------
- * Deallocates queue. 
+ * Deallocates queue and its segments.  Values are not deallocated.
  * ----------------------------------------------------------------------- */
 
 void m2c_fifo_release_queue (m2c_fifo_t queue) {
   
+  m2c_fifo_segment_t this_segment, next_segment;
+  
   if (queue == NULL) {
    return;
   } /* end if */  
   
+  if (queue->index != NULL) {
+    m2c_dealloc(M2C_ALLOC_FIFOS, queue->index->slot,
+      queue->index->capacity * sizeof(m2c_fifo_member_s));
+    m2c_dealloc(M2C_ALLOC_FIFOS, queue->index, sizeof(m2c_fifo_index_s));
+  } /* end if */
+  
+  /* segments beyond the base segment */
+  this_segment = queue->next;
+  
+  while (this_segment != NULL) {
+    next_segment = this_segment->next;
+    m2c_dealloc(M2C_ALLOC_FIFOS, this_segment, SEGMENT_ALLOC_SIZE);
+    this_segment = next_segment;
+  } /* end while */
+  
   queue->entry_count = 0;
   queue->head_index = 0;
   queue->tail_index = 0;
-  free(queue);
+  m2c_dealloc(M2C_ALLOC_FIFOS, queue, QUEUE_ALLOC_SIZE);
   
   return;
 } /* end m2c_fifo_release_queue */
 
 
 /* --------------------------------------------------------------------------
- * private function alloc_init_segment()
+ * function m2c_fifo_spsc_new_queue(capacity)
+ * --------------------------------------------------------------------------
+ * Allocates a new empty SPSC queue that holds at most capacity values and
+ * returns it.  Returns NULL if capacity is zero or allocation fails.
  * ----------------------------------------------------------------------- */
 
-static m2c_fifo_segment_t alloc_init_segment (void) {
+m2c_fifo_spsc_t m2c_fifo_spsc_new_queue (uint_t capacity) {
   
-  m2c_fifo_segment_t new_segment;
-  uint_t index;
+  void *base;
+  m2c_fifo_spsc_t new_queue;
+  m2c_fifo_spsc_segment_t segment;
+  uintptr_t addr;
   
-  /* allocate a new segment */
-  new_segment = malloc
-    (sizeof(m2c_fifo_segment_s) +
-     M2C_FIFO_SEGMENT_SIZE * sizeof(m2c_fifo_value_t));
+  if (capacity == 0) {
+    return NULL;
+  } /* end if */
   
-  if (new_segment == NULL) {
+  /* allocate with slack for alignment to a cache line */
+  base = m2c_alloc(M2C_ALLOC_FIFOS, SPSC_BASE_ALLOC_SIZE);
+  
+  if (base == NULL) {
     return NULL;
   } /* end if */
   
-  /* initialise new segment */
-  new_segment->next = NULL;
-  for (index = 0; index < M2C_FIFO_SEGMENT_SIZE; index++) {
-    new_segment->table[index] = NULL;
-  } /* end for */
+  segment = m2c_alloc(M2C_ALLOC_FIFOS, sizeof(m2c_fifo_spsc_segment_s));
   
-  return new_segment;
-} /* end alloc_init_segment */
+  if (segment == NULL) {
+    m2c_dealloc(M2C_ALLOC_FIFOS, base, SPSC_BASE_ALLOC_SIZE);
+    return NULL;
+  } /* end if */
+  
+  segment->next = NULL;
+  
+  addr = (uintptr_t) base + M2C_FIFO_CACHE_LINE_SIZE - 1;
+  addr = addr - (addr % M2C_FIFO_CACHE_LINE_SIZE);
+  new_queue = (m2c_fifo_spsc_t) addr;
+  
+  /* initialise consumer side */
+  new_queue->consumer.side.head_count = 0;
+  new_queue->consumer.side.tail_cache = 0;
+  new_queue->consumer.side.index = 0;
+  new_queue->consumer.side.segment = segment;
+  
+  /* initialise producer side */
+  new_queue->producer.side.tail_count = 0;
+  new_queue->producer.side.head_cache = 0;
+  new_queue->producer.side.index = 0;
+  new_queue->producer.side.capacity = capacity;
+  new_queue->producer.side.spare_count = 0;
+  new_queue->producer.side.segment = segment;
+  new_queue->producer.side.spare = segment;
+  new_queue->producer.side.base = base;
+  
+  return new_queue;
+} /* end m2c_fifo_spsc_new_queue */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_fifo_spsc_enqueue(queue, new_value)
+ * --------------------------------------------------------------------------
+ * Adds a value to the tail of queue.  Returns true on success, or false if
+ * queue is full, new_value is NULL or allocation fails.  Producer only.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_fifo_spsc_enqueue (m2c_fifo_spsc_t queue, m2c_fifo_value_t new_value) {
+  
+  return (m2c_fifo_spsc_enqueue_batch(queue, &new_value, 1) == 1);
+  
+} /* end m2c_fifo_spsc_enqueue */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_fifo_spsc_enqueue_batch(queue, values, count)
+ * --------------------------------------------------------------------------
+ * Adds up to count values from array values to the tail of queue, in order,
+ * and publishes them to the consumer at once.  Returns the number of values
+ * added, which is less than count if queue becomes full, a value is NULL or
+ * allocation fails.  Producer only.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_fifo_spsc_enqueue_batch
+  (m2c_fifo_spsc_t queue, const m2c_fifo_value_t *values, uint_t count) {
+  
+  m2c_fifo_spsc_producer_s *producer;
+  m2c_fifo_spsc_segment_t new_segment;
+  uint_t tail, added;
+  
+  if ((queue == NULL) || (values == NULL)) {
+    return 0;
+  } /* end if */
+  
+  producer = &queue->producer.side;
+  tail = producer->tail_count;
+  added = 0;
+  
+  while ((added < count) && (values[added] != NULL)) {
+    
+    /* check for free space, reload head only when full */
+    if ((tail - producer->head_cache) >= producer->capacity) {
+      producer->head_cache = LOAD_ACQUIRE(&queue->consumer.side.head_count);
+      
+      if ((tail - producer->head_cache) >= producer->capacity) {
+        break;
+      } /* end if */
+    } /* end if */
+    
+    /* link a new segment when the current segment is full */
+    if (producer->index == M2C_FIFO_SPSC_SEGMENT_SIZE) {
+      new_segment = next_spsc_segment(queue);
+      
+      if (new_segment == NULL) {
+        break;
+      } /* end if */
+      
+      producer->segment->next = new_segment;
+      producer->segment = new_segment;
+      producer->index = 0;
+    } /* end if */
+    
+    producer->segment->table[producer->index] = values[added];
+    producer->index++;
+    tail++;
+    added++;
+  } /* end while */
+  
+  /* publish all added values at once */
+  if (added > 0) {
+    STORE_RELEASE(&producer->tail_count, tail);
+  } /* end if */
+  
+  return added;
+} /* end m2c_fifo_spsc_enqueue_batch */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_fifo_spsc_dequeue(queue)
+ * --------------------------------------------------------------------------
+ * Removes the value at the head of queue and returns it, or NULL if queue
+ * is empty.  Consumer only.
+ * ----------------------------------------------------------------------- */
+
+m2c_fifo_value_t m2c_fifo_spsc_dequeue (m2c_fifo_spsc_t queue) {
+  
+  m2c_fifo_value_t value;
+  
+  if (m2c_fifo_spsc_dequeue_batch(queue, &value, 1) == 0) {
+    return NULL;
+  } /* end if */
+  
+  return value;
+} /* end m2c_fifo_spsc_dequeue */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_fifo_spsc_dequeue_batch(queue, values, max_count)
+ * --------------------------------------------------------------------------
+ * Removes up to max_count values from the head of queue, in order, stores
+ * them in array values and returns the number of values removed, which is
+ * zero if queue is empty.  Consumer only.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_fifo_spsc_dequeue_batch
+  (m2c_fifo_spsc_t queue, m2c_fifo_value_t *values, uint_t max_count) {
+  
+  m2c_fifo_spsc_consumer_s *consumer;
+  uint_t head, removed;
+  
+  if ((queue == NULL) || (values == NULL)) {
+    return 0;
+  } /* end if */
+  
+  consumer = &queue->consumer.side;
+  head = consumer->head_count;
+  removed = 0;
+  
+  while (removed < max_count) {
+    
+    /* check for values, reload tail only when empty */
+    if (head == consumer->tail_cache) {
+      consumer->tail_cache = LOAD_ACQUIRE(&queue->producer.side.tail_count);
+      
+      if (head == consumer->tail_cache) {
+        break;
+      } /* end if */
+    } /* end if */
+    
+    /* move on to the next segment when the current one is drained */
+    if (consumer->index == M2C_FIFO_SPSC_SEGMENT_SIZE) {
+      consumer->segment = consumer->segment->next;
+      consumer->index = 0;
+    } /* end if */
+    
+    values[removed] = consumer->segment->table[consumer->index];
+    consumer->index++;
+    head++;
+    removed++;
+  } /* end while */
+  
+  /* release the space of all removed values at once */
+  if (removed > 0) {
+    STORE_RELEASE(&consumer->head_count, head);
+  } /* end if */
+  
+  return removed;
+} /* end m2c_fifo_spsc_dequeue_batch */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_fifo_spsc_entry_count(queue)
+ * --------------------------------------------------------------------------
+ * Returns the number of values present in queue.  While the other thread
+ * is active, the result is a snapshot that may be out of date on return.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_fifo_spsc_entry_count (m2c_fifo_spsc_t queue) {
+  
+  uint_t head, tail;
+  
+  if (queue == NULL) {
+    return 0;
+  } /* end if */
+  
+  head = LOAD_ACQUIRE(&queue->consumer.side.head_count);
+  tail = LOAD_ACQUIRE(&queue->producer.side.tail_count);
+  
+  return tail - head;
+} /* end m2c_fifo_spsc_entry_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_fifo_spsc_release_queue(queue)
+ * --------------------------------------------------------------------------
+ * Deallocates queue and its segments.  Values are not deallocated.  Must
+ * not be called while the producer or the consumer still uses queue.
+ * ----------------------------------------------------------------------- */
+
+void m2c_fifo_spsc_release_queue (m2c_fifo_spsc_t queue) {
+  
+  m2c_fifo_spsc_segment_t this_segment, next_segment;
+  
+  if (queue == NULL) {
+    return;
+  } /* end if */
+  
+  /* all segments are linked from the oldest spare segment */
+  this_segment = queue->producer.side.spare;
+  
+  while (this_segment != NULL) {
+    next_segment = this_segment->next;
+    m2c_dealloc
+      (M2C_ALLOC_FIFOS, this_segment, sizeof(m2c_fifo_spsc_segment_s));
+    this_segment = next_segment;
+  } /* end while */
+  
+  m2c_dealloc
+    (M2C_ALLOC_FIFOS, queue->producer.side.base, SPSC_BASE_ALLOC_SIZE);
+  
+  return;
+} /* end m2c_fifo_spsc_release_queue */
+
+
+/* --------------------------------------------------------------------------
+ * private function append_value(queue, value)
+ * --------------------------------------------------------------------------
+ * Stores value after the tail entry of queue and returns queue, or NULL if
+ * allocation failed.  Does not update the membership index.
+ * ----------------------------------------------------------------------- */
+
+static m2c_fifo_t append_value (m2c_fifo_t queue, m2c_fifo_value_t new_value) {
+  
+  uint_t index, new_tail_index, this_segment_index, target_segment_index;
+  m2c_fifo_segment_t this_segment, new_segment;
+  
+  if ((queue == NULL) || (new_value == NULL)) {
+    return NULL;
+  } /* end if */ 
+  
+  if (queue->entry_count > 0) {
+    new_tail_index = queue->tail_index + 1;
+  }
+  else /* empty queue, head and tail are at the same position */ {
+    new_tail_index = queue->head_index;
+  } /* end if */
+  
+  /* check if tail is within base segment */
+  if (new_tail_index < M2C_FIFO_SEGMENT_SIZE) {
+    /* store value in base segment */
+    queue->table[new_tail_index] = new_value;
+    queue->entry_count++;
+    queue->tail_index = new_tail_index;
+    return queue;
+  } /* end if */
+  
+  if (queue->next == NULL) {
+    new_segment = alloc_init_segment();
+    
+    if (new_segment == NULL) {
+      return NULL;
+    } /* end if */
+    
+    queue->next = new_segment;
+  } /* end if */
+  
+  this_segment_index = 1;
+  this_segment = queue->next;
+  target_segment_index = new_tail_index / M2C_FIFO_SEGMENT_SIZE;
+  
+  /* find target segment */
+  while (this_segment_index != target_segment_index) {
+    
+    if (this_segment->next == NULL) {
+      /* allocate new segment */
+      new_segment = alloc_init_segment();
+      
+      if (new_segment == NULL) {
+        return NULL;
+      } /* end if */
+      
+      this_segment->next = new_segment;
+    } /* end if */
+    
+    this_segment = this_segment->next;
+    this_segment_index++;
+  } /* end while */
+  
+  /* store new value in target segment */
+  index = new_tail_index % M2C_FIFO_SEGMENT_SIZE;
+  this_segment->table[index] = new_value;
+  queue->entry_count++;
+  queue->tail_index = new_tail_index;
+  
+  return queue;
+} /* end append_value */
+
+
+/* --------------------------------------------------------------------------
+ * private function remove_head(queue)
+ * --------------------------------------------------------------------------
+ * Removes the head entry of queue and returns it, or NULL if queue is NULL
+ * or empty.  Does not update the membership index.
+ * ----------------------------------------------------------------------- */
+
+static m2c_fifo_value_t remove_head (m2c_fifo_t queue) {
+  
+  m2c_fifo_value_t head_value;
+  m2c_fifo_segment_t this_segment;
+  uint_t head_index, table_index, this_segment_index, target_segment_index;
+  
+  if ((queue == NULL) || (queue->entry_count == 0)) {
+    return NULL;
+  } /* end if */ 
+  
+  head_index = queue->head_index;
+  
+  /* check if head entry is within base segment */
+  if (queue->head_index < M2C_FIFO_SEGMENT_SIZE) {
+    
+    /* remove head entry */
+    head_value = queue->table[head_index];
+    queue->table[head_index] = NULL;
+    queue->entry_count--;
+    
+    if (queue->entry_count == 0) {
+      queue->head_index = 0;
+      queue->tail_index = 0;
+    }
+    else {
+      queue->head_index++;
+    } /* end if */
+    
+    /* and return it */
+    return head_value;
+  } /* end if */
+  
+  this_segment_index = 1;
+  this_segment = queue->next;
+  target_segment_index = head_index / M2C_FIFO_SEGMENT_SIZE;
+  
+  /* find target segment */
+  while (this_segment_index != target_segment_index) {
+    
+    this_segment = this_segment->next;
+    this_segment_index++;
+    
+    if (this_segment == NULL) {
+      return NULL;
+    } /* end if */
+  } /* end while */
+  
+  /* remove head entry */
+  table_index = head_index % M2C_FIFO_SEGMENT_SIZE;
+  head_value = this_segment->table[table_index];
+  this_segment->table[table_index] = NULL;
+  queue->entry_count--;
+  
+  if (queue->entry_count == 0) {
+    queue->head_index = 0;
+    queue->tail_index = 0;
+  }
+  else {
+    queue->head_index++;
+  } /* end if */
+  
+  /* and return it */
+  return head_value;
+} /* end remove_head */
+
+
+/* --------------------------------------------------------------------------
+ * private function alloc_init_segment()
+ * ----------------------------------------------------------------------- */
+
+static m2c_fifo_segment_t alloc_init_segment (void) {
+  
+  m2c_fifo_segment_t new_segment;
+  uint_t index;
+  
+  /* allocate a new segment */
+  new_segment = m2c_alloc(M2C_ALLOC_FIFOS, SEGMENT_ALLOC_SIZE);
+  
+  if (new_segment == NULL) {
+    return NULL;
+  } /* end if */
+  
+  /* initialise new segment */
+  new_segment->next = NULL;
+  for (index = 0; index < M2C_FIFO_SEGMENT_SIZE; index++) {
+    new_segment->table[index] = NULL;
+  } /* end for */
+  
+  return new_segment;
+} /* end alloc_init_segment */
+
+
+/* --------------------------------------------------------------------------
+ * private function new_index()
+ * --------------------------------------------------------------------------
+ * Returns a new empty membership index, or NULL if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static m2c_fifo_index_t new_index (void) {
+  
+  m2c_fifo_index_t new_idx;
+  
+  new_idx = m2c_alloc(M2C_ALLOC_FIFOS, sizeof(m2c_fifo_index_s));
+  
+  if (new_idx == NULL) {
+    return NULL;
+  } /* end if */
+  
+  new_idx->slot = m2c_alloc_zeroed
+    (M2C_ALLOC_FIFOS, M2C_FIFO_INDEX_INIT_CAPACITY, sizeof(m2c_fifo_member_s));
+  
+  if (new_idx->slot == NULL) {
+    m2c_dealloc(M2C_ALLOC_FIFOS, new_idx, sizeof(m2c_fifo_index_s));
+    return NULL;
+  } /* end if */
+  
+  new_idx->capacity = M2C_FIFO_INDEX_INIT_CAPACITY;
+  new_idx->used = 0;
+  
+  return new_idx;
+} /* end new_index */
+
+
+/* --------------------------------------------------------------------------
+ * private function home_slot(value, mask)
+ * --------------------------------------------------------------------------
+ * Returns the home slot of value in an index with capacity mask + 1.  The
+ * low bits of a pointer are mostly zero, the top bits of the product are
+ * therefore used.
+ * ----------------------------------------------------------------------- */
+
+static inline uint_t home_slot (m2c_fifo_value_t value, uint_t mask) {
+  
+  uint64_t key;
+  
+  key = ((uint64_t) (uintptr_t) value) * 0x9E3779B97F4A7C15ULL;
+  
+  return ((uint_t) (key >> 32)) & mask;
+} /* end home_slot */
+
+
+/* --------------------------------------------------------------------------
+ * private function index_probe(index, value)
+ * --------------------------------------------------------------------------
+ * Returns the slot of value in index, or the empty slot where value would
+ * be stored if value is not present.
+ * ----------------------------------------------------------------------- */
+
+static uint_t index_probe (m2c_fifo_index_t index, m2c_fifo_value_t value) {
+  
+  uint_t slot, mask;
+  
+  mask = index->capacity - 1;
+  slot = home_slot(value, mask);
+  
+  while ((index->slot[slot].value != NULL) &&
+         (index->slot[slot].value != value)) {
+    slot = (slot + 1) & mask;
+  } /* end while */
+  
+  return slot;
+} /* end index_probe */
+
+
+/* --------------------------------------------------------------------------
+ * private function index_reserve(index)
+ * --------------------------------------------------------------------------
+ * Doubles the capacity of index if adding another distinct value would
+ * exceed the maximum load.  Returns false if allocation failed, leaving
+ * index unchanged, otherwise true.
+ * ----------------------------------------------------------------------- */
+
+static bool index_reserve (m2c_fifo_index_t index) {
+  
+  m2c_fifo_member_s *old_slot;
+  uint_t old_capacity, slot, new_slot;
+  
+  if (((index->used + 1) * 100) <=
+      (index->capacity * M2C_FIFO_INDEX_MAX_LOAD_PERCENT)) {
+    return true;
+  } /* end if */
+  
+  old_slot = index->slot;
+  old_capacity = index->capacity;
+  
+  index->slot = m2c_alloc_zeroed
+    (M2C_ALLOC_FIFOS, 2 * old_capacity, sizeof(m2c_fifo_member_s));
+  
+  if (index->slot == NULL) {
+    index->slot = old_slot;
+    return false;
+  } /* end if */
+  
+  index->capacity = 2 * old_capacity;
+  
+  /* rehash occupied slots */
+  for (slot = 0; slot < old_capacity; slot++) {
+    if (old_slot[slot].value != NULL) {
+      new_slot = index_probe(index, old_slot[slot].value);
+      index->slot[new_slot] = old_slot[slot];
+    } /* end if */
+  } /* end for */
+  
+  m2c_dealloc
+    (M2C_ALLOC_FIFOS, old_slot, old_capacity * sizeof(m2c_fifo_member_s));
+  
+  return true;
+} /* end index_reserve */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure index_add(index, value)
+ * --------------------------------------------------------------------------
+ * Counts another occurrence of value in index.  The caller must have made
+ * room by calling index_reserve() first.
+ * ----------------------------------------------------------------------- */
+
+static void index_add (m2c_fifo_index_t index, m2c_fifo_value_t value) {
+  
+  uint_t slot;
+  
+  slot = index_probe(index, value);
+  
+  if (index->slot[slot].value == NULL) {
+    index->slot[slot].value = value;
+    index->slot[slot].count = 0;
+    index->used++;
+  } /* end if */
+  
+  index->slot[slot].count++;
+  
+  return;
+} /* end index_add */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure index_remove(index, value)
+ * --------------------------------------------------------------------------
+ * Uncounts an occurrence of value in index.  When no occurrence is left,
+ * the slot of value is vacated and the entries that follow it in the same
+ * probe run are shifted back, so that every entry remains reachable from
+ * its home slot.
+ * ----------------------------------------------------------------------- */
+
+static void index_remove (m2c_fifo_index_t index, m2c_fifo_value_t value) {
+  
+  uint_t vacant, slot, home, mask;
+  
+  vacant = index_probe(index, value);
+  
+  if (index->slot[vacant].value == NULL) {
+    return;
+  } /* end if */
+  
+  index->slot[vacant].count--;
+  
+  if (index->slot[vacant].count > 0) {
+    return;
+  } /* end if */
+  
+  mask = index->capacity - 1;
+  slot = vacant;
+  
+  /* shift back entries whose home slot is not between vacant and slot */
+  while (true) {
+    slot = (slot + 1) & mask;
+    
+    if (index->slot[slot].value == NULL) {
+      break;
+    } /* end if */
+    
+    home = home_slot(index->slot[slot].value, mask);
+    
+    if (((slot - home) & mask) >= ((slot - vacant) & mask)) {
+      index->slot[vacant] = index->slot[slot];
+      vacant = slot;
+    } /* end if */
+  } /* end while */
+  
+  index->slot[vacant].value = NULL;
+  index->used--;
+  
+  return;
+} /* end index_remove */
+
+
+/* --------------------------------------------------------------------------
+ * private function next_spsc_segment(queue)
+ * --------------------------------------------------------------------------
+ * Returns a segment to be linked after the producer's current segment.
+ * The oldest spare segment is unlinked and reused once the consumer has
+ * moved beyond it, which is the case when it has removed a value following
+ * the segment.  Otherwise a new segment is allocated.  Returns NULL if
+ * allocation fails.
+ * ----------------------------------------------------------------------- */
+
+static m2c_fifo_spsc_segment_t next_spsc_segment (m2c_fifo_spsc_t queue) {
+  
+  m2c_fifo_spsc_producer_s *producer;
+  m2c_fifo_spsc_segment_t segment;
+  
+  producer = &queue->producer.side;
+  
+  if ((producer->head_cache - producer->spare_count) <=
+      M2C_FIFO_SPSC_SEGMENT_SIZE) {
+    producer->head_cache = LOAD_ACQUIRE(&queue->consumer.side.head_count);
+  } /* end if */
+  
+  /* recycle the oldest spare segment if the consumer is done with it */
+  if ((producer->head_cache - producer->spare_count) >
+      M2C_FIFO_SPSC_SEGMENT_SIZE) {
+    segment = producer->spare;
+    producer->spare = segment->next;
+    producer->spare_count =
+      producer->spare_count + M2C_FIFO_SPSC_SEGMENT_SIZE;
+  }
+  else /* allocate a new segment */ {
+    segment = m2c_alloc(M2C_ALLOC_FIFOS, sizeof(m2c_fifo_spsc_segment_s));
+    
+    if (segment == NULL) {
+      return NULL;
+    } /* end if */
+  } /* end if */
+  
+  segment->next = NULL;
+  
+  return segment;
+} /* end next_spsc_segment */
 
 
 /* END OF FILE */
\ No newline at end of file
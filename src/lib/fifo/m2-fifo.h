@@ -48,6 +48,20 @@
 #define M2C_FIFO_SEGMENT_SIZE 16
 
 
+/* --------------------------------------------------------------------------
+ * Number of entries per single-producer/single-consumer queue segment
+ * ----------------------------------------------------------------------- */
+
+#define M2C_FIFO_SPSC_SEGMENT_SIZE 256
+
+
+/* --------------------------------------------------------------------------
+ * Assumed cache line size of the host
+ * ----------------------------------------------------------------------- */
+
+#define M2C_FIFO_CACHE_LINE_SIZE 64
+
+
 /* --------------------------------------------------------------------------
  * type m2c_fifo_value_t
  * --------------------------------------------------------------------------
@@ -79,6 +93,18 @@ void print_fifo_info(m2c_fifo_t q);
 m2c_fifo_t m2c_fifo_new_queue (m2c_fifo_value_t first_value);
 
 
+/* --------------------------------------------------------------------------
+ * function m2c_fifo_new_indexed_queue(first_value)
+ * --------------------------------------------------------------------------
+ * Allocates a new queue object like m2c_fifo_new_queue() but with a
+ * membership index that is maintained on enqueue and dequeue.  Functions
+ * m2c_fifo_entry_exists() and m2c_fifo_enqueue_unique() then take constant
+ * time.  Returns NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2c_fifo_t m2c_fifo_new_indexed_queue (m2c_fifo_value_t first_value);
+
+
 /* --------------------------------------------------------------------------
  * function m2c_fifo_enqueue(queue, new_value)
  * --------------------------------------------------------------------------
@@ -120,7 +146,8 @@ uint_t m2c_fifo_entry_count (m2c_fifo_t queue);
 /* --------------------------------------------------------------------------
  * function m2c_fifo_entry_exists(queue, value)
  * --------------------------------------------------------------------------
- * Returns true if value is present in queue, otherwise false. 
+ * Returns true if value is present in queue, otherwise false.  Takes time
+ * proportional to the number of entries unless queue is indexed.
  * ----------------------------------------------------------------------- */
 
 bool m2c_fifo_entry_exists (m2c_fifo_t queue, m2c_fifo_value_t value);
@@ -139,11 +166,100 @@ m2c_fifo_t m2c_fifo_reset_queue (m2c_fifo_t queue);
 /* --------------------------------------------------------------------------
  * function m2c_fifo_release_queue(queue)
  * --------------------------------------------------------------------------
- * Deallocates queue. 
+ * Deallocates queue and its segments.  Values are not deallocated.
  * ----------------------------------------------------------------------- */
 
 void m2c_fifo_release_queue (m2c_fifo_t queue);
 
+
+/* --------------------------------------------------------------------------
+ * opaque type m2c_fifo_spsc_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing a bounded FIFO queue object that may be
+ * shared by exactly one producer thread and one consumer thread without a
+ * lock.  Only the producer may call the enqueue functions, only the
+ * consumer may call the dequeue functions.  No function blocks, a consumer
+ * finding the queue empty or a producer finding it full must retry.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_fifo_spsc_struct_t *m2c_fifo_spsc_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_fifo_spsc_new_queue(capacity)
+ * --------------------------------------------------------------------------
+ * Allocates a new empty SPSC queue that holds at most capacity values and
+ * returns it.  Returns NULL if capacity is zero or allocation fails.
+ * ----------------------------------------------------------------------- */
+
+m2c_fifo_spsc_t m2c_fifo_spsc_new_queue (uint_t capacity);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_fifo_spsc_enqueue(queue, new_value)
+ * --------------------------------------------------------------------------
+ * Adds a value to the tail of queue.  Returns true on success, or false if
+ * queue is full, new_value is NULL or allocation fails.  Producer only.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_fifo_spsc_enqueue (m2c_fifo_spsc_t queue, m2c_fifo_value_t new_value);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_fifo_spsc_enqueue_batch(queue, values, count)
+ * --------------------------------------------------------------------------
+ * Adds up to count values from array values to the tail of queue, in order,
+ * and publishes them to the consumer at once.  Returns the number of values
+ * added, which is less than count if queue becomes full, a value is NULL or
+ * allocation fails.  Producer only.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_fifo_spsc_enqueue_batch
+  (m2c_fifo_spsc_t queue, const m2c_fifo_value_t *values, uint_t count);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_fifo_spsc_dequeue(queue)
+ * --------------------------------------------------------------------------
+ * Removes the value at the head of queue and returns it, or NULL if queue
+ * is empty.  Consumer only.
+ * ----------------------------------------------------------------------- */
+
+m2c_fifo_value_t m2c_fifo_spsc_dequeue (m2c_fifo_spsc_t queue);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_fifo_spsc_dequeue_batch(queue, values, max_count)
+ * --------------------------------------------------------------------------
+ * Removes up to max_count values from the head of queue, in order, stores
+ * them in array values and returns the number of values removed, which is
+ * zero if queue is empty.  Consumer only.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_fifo_spsc_dequeue_batch
+  (m2c_fifo_spsc_t queue, m2c_fifo_value_t *values, uint_t max_count);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_fifo_spsc_entry_count(queue)
+ * --------------------------------------------------------------------------
+ * Returns the number of values present in queue.  While the other thread
+ * is active, the result is a snapshot that may be out of date on return.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_fifo_spsc_entry_count (m2c_fifo_spsc_t queue);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_fifo_spsc_release_queue(queue)
+ * --------------------------------------------------------------------------
+ * Deallocates queue and its segments.  Values are not deallocated.  Must
+ * not be called while the producer or the consumer still uses queue.
+ * ----------------------------------------------------------------------- */
+
+void m2c_fifo_spsc_release_queue (m2c_fifo_spsc_t queue);
+
+
 #endif /* M2C_FIFO_H */
 
 /* END OF FILE */
\ No newline at end of file
@@ -35,6 +35,8 @@
 
 #include "fileutils.h"
 
+#include <dirent.h>
+#include <string.h>
 #include <unistd.h>
 #include <stdlib.h>
 #include <sys/stat.h>
@@ -230,4 +232,70 @@ const char *new_path_w_current_workdir (void) {
 } /* end new_path_w_current_workdir */
 
 
+/* --------------------------------------------------------------------------
+ * function map_file(path, addr, size)
+ * --------------------------------------------------------------------------
+ * AmigaOS does not support memory mapped files.  Always returns false and
+ * leaves the out-parameters unmodified.  Callers are expected to fall back
+ * on reading the file into a buffer.
+ * ----------------------------------------------------------------------- */
+
+bool map_file (const char *path, const char **addr, size_t *size) {
+  
+  return false;
+} /* end map_file */
+
+
+/* --------------------------------------------------------------------------
+ * function unmap_file(addr, size)
+ * --------------------------------------------------------------------------
+ * AmigaOS does not support memory mapped files.  Always returns false.
+ * ----------------------------------------------------------------------- */
+
+bool unmap_file (const char *addr, size_t size) {
+  
+  return false;
+} /* end unmap_file */
+
+
+/* --------------------------------------------------------------------------
+ * function read_directory(path, handler, context)
+ * --------------------------------------------------------------------------
+ * Tests if path is a valid pathname indicating an existing directory and if
+ * so, calls handler with the filename of each entry in the directory and
+ * with context, then returns true.  Entries "." and ".." are skipped.
+ * Otherwise it does not call handler and returns false.  Requires the
+ * dirent interface of the clib2 or libnix runtime libraries.
+ * ----------------------------------------------------------------------- */
+
+bool read_directory
+  (const char *path, dir_entry_handler_f handler, void *context) {
+  struct dirent *entry;
+  DIR *dir;
+  
+  /* path may not be NULL or empty, handler may not be NULL */
+  if ((path == NULL) || (path[0] == 0) || (handler == NULL)) {
+    return false;
+  } /* end if */
+  
+  /* open directory */
+  dir = opendir(path);
+  
+  if (dir == NULL) {
+    return false;
+  } /* end if */
+  
+  /* pass each entry to handler */
+  while ((entry = readdir(dir)) != NULL) {
+    if ((strcmp(entry->d_name, ".") != 0) &&
+        (strcmp(entry->d_name, "..") != 0)) {
+      handler(entry->d_name, context);
+    } /* end if */
+  } /* end while */
+  
+  closedir(dir);
+  return true;
+} /* end read_directory */
+
+
 /* END OF FILE */
\ No newline at end of file
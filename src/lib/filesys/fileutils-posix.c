@@ -33,10 +33,17 @@
  * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
  */
 
+/* stat() must not fail on files of 2 GiB and larger on 32-bit hosts */
+#define _FILE_OFFSET_BITS 64
+
 #include "fileutils.h"
 
+#include <fcntl.h>
+#include <dirent.h>
+#include <string.h>
 #include <unistd.h>
 #include <stdlib.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 
 
@@ -217,4 +224,119 @@ const char *new_path_w_current_workdir (void) {
 } /* end new_path_w_current_workdir */
 
 
+/* --------------------------------------------------------------------------
+ * function map_file(path, addr, size)
+ * --------------------------------------------------------------------------
+ * Tests if path is a valid pathname indicating an existing non-empty regular
+ * file and if so, maps the file's contents read-only into memory, copies
+ * the start address of the mapping to out-parameter addr, the length of the
+ * mapping to out-parameter size and returns true.  Otherwise it leaves the
+ * out-parameters unmodified and returns false.
+ * ----------------------------------------------------------------------- */
+
+bool map_file (const char *path, const char **addr, size_t *size) {
+  struct stat st;
+  int fd, status;
+  void *mapping;
+  
+  /* path may not be NULL or empty, out-parameters may not be NULL */
+  if ((path == NULL) || (path[0] == 0) || (addr == NULL) || (size == NULL)) {
+    return false;
+  } /* end if */
+  
+  /* open file */
+  fd = open(path, O_RDONLY);
+  
+  if (fd < 0) {
+    return false;
+  } /* end if */
+  
+  /* obtain file info */
+  status = fstat(fd, &st);
+  
+  /* check if file is a non-empty regular file */
+  if ((status != 0) || !(S_ISREG(st.st_mode)) || (st.st_size == 0)) {
+    close(fd);
+    return false;
+  } /* end if */
+  
+  /* map file contents */
+  mapping = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  
+  /* the mapping remains valid after its file descriptor has been closed */
+  close(fd);
+  
+  if (mapping == MAP_FAILED) {
+    return false;
+  } /* end if */
+  
+#if defined(POSIX_MADV_SEQUENTIAL)
+  /* source files are read front to back */
+  posix_madvise(mapping, (size_t) st.st_size, POSIX_MADV_SEQUENTIAL);
+#endif
+  
+  /* pass back address and size */
+  *addr = (const char *) mapping;
+  *size = (size_t) st.st_size;
+  
+  return true;
+} /* end map_file */
+
+
+/* --------------------------------------------------------------------------
+ * function unmap_file(addr, size)
+ * --------------------------------------------------------------------------
+ * Releases a memory mapping previously established by function map_file().
+ * Returns true on success, or false on failure.
+ * ----------------------------------------------------------------------- */
+
+bool unmap_file (const char *addr, size_t size) {
+  
+  if ((addr == NULL) || (size == 0)) {
+    return false;
+  } /* end if */
+  
+  return (munmap((void *) addr, size) == 0);
+} /* end unmap_file */
+
+
+/* --------------------------------------------------------------------------
+ * function read_directory(path, handler, context)
+ * --------------------------------------------------------------------------
+ * Tests if path is a valid pathname indicating an existing directory and if
+ * so, calls handler with the filename of each entry in the directory and
+ * with context, then returns true.  Entries "." and ".." are skipped.
+ * Otherwise it does not call handler and returns false.
+ * ----------------------------------------------------------------------- */
+
+bool read_directory
+  (const char *path, dir_entry_handler_f handler, void *context) {
+  struct dirent *entry;
+  DIR *dir;
+  
+  /* path may not be NULL or empty, handler may not be NULL */
+  if ((path == NULL) || (path[0] == 0) || (handler == NULL)) {
+    return false;
+  } /* end if */
+  
+  /* open directory */
+  dir = opendir(path);
+  
+  if (dir == NULL) {
+    return false;
+  } /* end if */
+  
+  /* pass each entry to handler */
+  while ((entry = readdir(dir)) != NULL) {
+    if ((strcmp(entry->d_name, ".") != 0) &&
+        (strcmp(entry->d_name, "..") != 0)) {
+      handler(entry->d_name, context);
+    } /* end if */
+  } /* end while */
+  
+  closedir(dir);
+  return true;
+} /* end read_directory */
+
+
 /* END OF FILE */
\ No newline at end of file
@@ -37,10 +37,15 @@
 
 #include <stddef.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <direct.h>
 
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
 
 /* --------------------------------------------------------------------------
  * Windows path length limit
@@ -239,4 +244,161 @@ const char *new_path_w_current_workdir (void) {
 } /* end new_path_w_current_workdir */
 
 
+/* --------------------------------------------------------------------------
+ * function map_file(path, addr, size)
+ * --------------------------------------------------------------------------
+ * Tests if path is a valid pathname indicating an existing non-empty regular
+ * file and if so, maps the file's contents read-only into memory, copies
+ * the start address of the mapping to out-parameter addr, the length of the
+ * mapping to out-parameter size and returns true.  Otherwise it leaves the
+ * out-parameters unmodified and returns false.
+ * ----------------------------------------------------------------------- */
+
+#if defined(_WIN32)
+bool map_file (const char *path, const char **addr, size_t *size) {
+  HANDLE file, mapping;
+  LARGE_INTEGER filesize;
+  LPVOID view;
+  
+  /* path may not be NULL or empty, out-parameters may not be NULL */
+  if ((path == NULL) || (path[0] == 0) || (addr == NULL) || (size == NULL)) {
+    return false;
+  } /* end if */
+  
+  /* open file */
+  file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+  
+  if (file == INVALID_HANDLE_VALUE) {
+    return false;
+  } /* end if */
+  
+  /* obtain file size, empty files cannot be mapped */
+  if ((GetFileSizeEx(file, &filesize) == 0) ||
+      (filesize.QuadPart == 0) ||
+      ((unsigned long long) filesize.QuadPart > (size_t) -1)) {
+    CloseHandle(file);
+    return false;
+  } /* end if */
+  
+  /* create mapping object */
+  mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  
+  if (mapping == NULL) {
+    CloseHandle(file);
+    return false;
+  } /* end if */
+  
+  /* map view of entire file */
+  view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  
+  /* the view remains valid after its handles have been closed */
+  CloseHandle(mapping);
+  CloseHandle(file);
+  
+  if (view == NULL) {
+    return false;
+  } /* end if */
+  
+  /* pass back address and size */
+  *addr = (const char *) view;
+  *size = (size_t) filesize.QuadPart;
+  
+  return true;
+} /* end map_file */
+
+
+/* --------------------------------------------------------------------------
+ * function unmap_file(addr, size)
+ * --------------------------------------------------------------------------
+ * Releases a memory mapping previously established by function map_file().
+ * Returns true on success, or false on failure.
+ * ----------------------------------------------------------------------- */
+
+bool unmap_file (const char *addr, size_t size) {
+  
+  if ((addr == NULL) || (size == 0)) {
+    return false;
+  } /* end if */
+  
+  return (UnmapViewOfFile((LPCVOID) addr) != 0);
+} /* end unmap_file */
+
+#else /* MS-DOS and OS/2 do not support memory mapped files */
+bool map_file (const char *path, const char **addr, size_t *size) {
+  return false;
+} /* end map_file */
+
+bool unmap_file (const char *addr, size_t size) {
+  return false;
+} /* end unmap_file */
+#endif /* _WIN32 */
+
+
+/* --------------------------------------------------------------------------
+ * function read_directory(path, handler, context)
+ * --------------------------------------------------------------------------
+ * Tests if path is a valid pathname indicating an existing directory and if
+ * so, calls handler with the filename of each entry in the directory and
+ * with context, then returns true.  Entries "." and ".." are skipped.
+ * Otherwise it does not call handler and returns false.
+ * ----------------------------------------------------------------------- */
+
+#if defined(_WIN32)
+bool read_directory
+  (const char *path, dir_entry_handler_f handler, void *context) {
+  WIN32_FIND_DATAA entry;
+  HANDLE search;
+  char *pattern;
+  size_t len;
+  
+  /* path may not be NULL or empty, handler may not be NULL */
+  if ((path == NULL) || (path[0] == 0) || (handler == NULL)) {
+    return false;
+  } /* end if */
+  
+  /* compose search pattern path\* */
+  len = strlen(path);
+  pattern = malloc(len + 3);
+  
+  if (pattern == NULL) {
+    return false;
+  } /* end if */
+  
+  memcpy(pattern, path, len);
+  if ((path[len - 1] != '\\') && (path[len - 1] != '/')) {
+    pattern[len] = '\\';
+    len++;
+  } /* end if */
+  pattern[len] = '*';
+  pattern[len + 1] = 0;
+  
+  /* open search */
+  search = FindFirstFileA(pattern, &entry);
+  free(pattern);
+  
+  if (search == INVALID_HANDLE_VALUE) {
+    return false;
+  } /* end if */
+  
+  /* pass each entry to handler */
+  do {
+    if ((strcmp(entry.cFileName, ".") != 0) &&
+        (strcmp(entry.cFileName, "..") != 0)) {
+      handler(entry.cFileName, context);
+    } /* end if */
+  } while (FindNextFileA(search, &entry) != 0);
+  
+  FindClose(search);
+  return true;
+} /* end read_directory */
+
+#else /* MS-DOS and OS/2 directory search is not supported */
+bool read_directory
+  (const char *path, dir_entry_handler_f handler, void *context) {
+  return false;
+} /* end read_directory */
+#endif /* _WIN32 */
+
+
 /* END OF FILE */
\ No newline at end of file
@@ -89,4 +89,25 @@
 #endif
 
 
+/* --------------------------------------------------------------------------
+ * function current_workdir()
+ * --------------------------------------------------------------------------
+ * Returns a NUL terminated character string containing the absolute path
+ * of the current working directory as it was when this function was first
+ * called.  The path is obtained once per process and must not be released
+ * by the caller.  Returns NULL on failure.  The first call must not race
+ * with any other call.
+ * ----------------------------------------------------------------------- */
+
+const char *current_workdir (void) {
+  static const char *workdir = NULL;
+  
+  if (workdir == NULL) {
+    workdir = new_path_w_current_workdir();
+  } /* end if */
+  
+  return workdir;
+} /* end current_workdir */
+
+
 /* END OF FILE */
\ No newline at end of file
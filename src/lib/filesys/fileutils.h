@@ -36,6 +36,7 @@
 #ifndef FILEUTILS_H
 #define FILEUTILS_H
 
+#include <stddef.h>
 #include <stdbool.h>
 
 
@@ -102,6 +103,70 @@ bool get_filetime (const char *path, long int *timestamp);
 const char *new_path_w_current_workdir (void);
 
 
+/* --------------------------------------------------------------------------
+ * function current_workdir()
+ * --------------------------------------------------------------------------
+ * Returns a NUL terminated character string containing the absolute path
+ * of the current working directory as it was when this function was first
+ * called.  The path is obtained once per process and must not be released
+ * by the caller.  Returns NULL on failure.  The first call must not race
+ * with any other call.
+ * ----------------------------------------------------------------------- */
+
+const char *current_workdir (void);
+
+
+/* --------------------------------------------------------------------------
+ * function map_file(path, addr, size)
+ * --------------------------------------------------------------------------
+ * Tests if path is a valid pathname indicating an existing non-empty regular
+ * file and if so, maps the file's contents read-only into memory, copies
+ * the start address of the mapping to out-parameter addr, the length of the
+ * mapping to out-parameter size and returns true.  Otherwise it leaves the
+ * out-parameters unmodified and returns false.  The mapping is NOT NUL
+ * terminated and must be released by calling function unmap_file().
+ * Returns false on host platforms without memory mapped file support.
+ * ----------------------------------------------------------------------- */
+
+bool map_file (const char *path, const char **addr, size_t *size);
+
+
+/* --------------------------------------------------------------------------
+ * function unmap_file(addr, size)
+ * --------------------------------------------------------------------------
+ * Releases a memory mapping previously established by function map_file().
+ * Returns true on success, or false on failure.
+ * ----------------------------------------------------------------------- */
+
+bool unmap_file (const char *addr, size_t size);
+
+
+/* --------------------------------------------------------------------------
+ * type dir_entry_handler_f
+ * --------------------------------------------------------------------------
+ * Type of the handler function called by function read_directory() for
+ * each entry of a directory.  Parameter name is the entry's filename, it is
+ * only valid for the duration of the call.  Parameter context is passed
+ * through from the caller of read_directory().
+ * ----------------------------------------------------------------------- */
+
+typedef void (*dir_entry_handler_f) (const char *name, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * function read_directory(path, handler, context)
+ * --------------------------------------------------------------------------
+ * Tests if path is a valid pathname indicating an existing directory and if
+ * so, calls handler with the filename of each entry in the directory and
+ * with context, then returns true.  Entries "." and ".." are skipped.  The
+ * order in which entries are passed to handler is unspecified.  Otherwise
+ * it does not call handler and returns false.
+ * ----------------------------------------------------------------------- */
+
+bool read_directory
+  (const char *path, dir_entry_handler_f handler, void *context);
+
+
 #endif /* FILEUTILS_H */
 
 /* END OF FILE */
\ No newline at end of file
@@ -0,0 +1,557 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015-2016 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * m2-dircache.c
+ *
+ * Implementation of directory listing caches.
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute and/or modify it under the
+ * terms of the GNU Lesser General Public License (LGPL) either version 2.1
+ * or at your choice version 3 as published by the Free Software Foundation.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+
+#include "m2-dircache.h"
+#include "fileutils.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* --------------------------------------------------------------------------
+ * Initial capacity and maximum load of the entry table
+ * ----------------------------------------------------------------------- */
+
+#define M2C_DIRCACHE_INIT_CAPACITY 64
+
+#define M2C_DIRCACHE_MAX_LOAD_PERCENT 75
+
+
+/* --------------------------------------------------------------------------
+ * Case folding of filenames
+ * --------------------------------------------------------------------------
+ * Filenames are matched without regard to case on host platforms whose
+ * file systems are case insensitive, as a stat() call would match them.
+ * ----------------------------------------------------------------------- */
+
+#if (defined(_WIN32)) || (defined(_WIN64)) || (defined(MSDOS)) || \
+    (defined(OS2)) || (defined(__amigaos__)) || \
+    (defined(VMS)) || (defined(__VMS))
+#define M2C_DIRCACHE_CASE_FOLDING 1
+#else
+#define M2C_DIRCACHE_CASE_FOLDING 0
+#endif
+
+#if (M2C_DIRCACHE_CASE_FOLDING != 0)
+#define FOLD(_ch) \
+  ((((_ch) >= 'a') && ((_ch) <= 'z')) ? ((_ch) - 'a' + 'A') : (_ch))
+#else
+#define FOLD(_ch) (_ch)
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * Directory separators
+ * ----------------------------------------------------------------------- */
+
+#if (defined(_WIN32)) || (defined(_WIN64)) || \
+    (defined(MSDOS)) || (defined(OS2))
+#define IS_DIRSEP(_ch) (((_ch) == '/') || ((_ch) == '\\'))
+#define DIRSEP '\\'
+#elif defined(__amigaos__)
+#define IS_DIRSEP(_ch) (((_ch) == '/') || ((_ch) == ':'))
+#define DIRSEP '/'
+#elif (defined(VMS)) || (defined(__VMS))
+#define IS_DIRSEP(_ch) (((_ch) == ']') || ((_ch) == ':'))
+#define DIRSEP ']'
+#else
+#define IS_DIRSEP(_ch) ((_ch) == '/')
+#define DIRSEP '/'
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * private type m2c_dircache_entry_s
+ * --------------------------------------------------------------------------
+ * record type representing an entry of a directory listing cache.  A slot
+ * is empty if its name is NULL.  Field probed is set once size and time
+ * have been obtained, field regular is then set if the entry is a regular
+ * file.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* name */ char *name;
+  /* hash */ uint32_t hash;
+  /* probed */ bool probed;
+  /* regular */ bool regular;
+  /* size */ long int size;
+  /* time */ long int time;
+} m2c_dircache_entry_s;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_dircache_s
+ * --------------------------------------------------------------------------
+ * record type representing a directory listing cache.  The entry table is
+ * an open addressing table with linear probing, keyed by filename.  Its
+ * capacity is a power of two.  Field failed is set if an entry could not
+ * be recorded while reading the directory.
+ * ----------------------------------------------------------------------- */
+
+struct m2c_dircache_s {
+  /* dirpath */ char *dirpath;
+  /* capacity */ uint_t capacity;
+  /* count */ uint_t count;
+  /* failed */ bool failed;
+  /* slot */ m2c_dircache_entry_s *slot;
+};
+
+typedef struct m2c_dircache_s m2c_dircache_s;
+
+
+/* --------------------------------------------------------------------------
+ * Forward declarations
+ * ----------------------------------------------------------------------- */
+
+static uint32_t name_hash (const char *name);
+
+static bool names_match (const char *name1, const char *name2);
+
+static m2c_dircache_entry_s *lookup
+  (m2c_dircache_t cache, const char *filename);
+
+static uint_t table_probe
+  (m2c_dircache_t cache, const char *name, uint32_t hash);
+
+static bool table_reserve (m2c_dircache_t cache);
+
+static void add_entry (const char *name, void *context);
+
+static bool probe_entry (m2c_dircache_t cache, m2c_dircache_entry_s *entry);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_new_dircache(dirpath)
+ * --------------------------------------------------------------------------
+ * Reads the entries of the directory at dirpath and returns a newly
+ * allocated cache of its listing.  Returns NULL if dirpath is not the path
+ * of a readable directory or if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+m2c_dircache_t m2c_new_dircache (const char *dirpath) {
+  
+  m2c_dircache_t new_cache;
+  size_t len;
+  
+  if ((dirpath == NULL) || (dirpath[0] == ASCII_NUL)) {
+    return NULL;
+  } /* end if */
+  
+  new_cache = malloc(sizeof(m2c_dircache_s));
+  
+  if (new_cache == NULL) {
+    return NULL;
+  } /* end if */
+  
+  len = strlen(dirpath);
+  new_cache->dirpath = malloc(len + 1);
+  new_cache->slot =
+    calloc(M2C_DIRCACHE_INIT_CAPACITY, sizeof(m2c_dircache_entry_s));
+  
+  if ((new_cache->dirpath == NULL) || (new_cache->slot == NULL)) {
+    free(new_cache->dirpath);
+    free(new_cache->slot);
+    free(new_cache);
+    return NULL;
+  } /* end if */
+  
+  memcpy(new_cache->dirpath, dirpath, len + 1);
+  new_cache->capacity = M2C_DIRCACHE_INIT_CAPACITY;
+  new_cache->count = 0;
+  new_cache->failed = false;
+  
+  /* one listing replaces a stat() call per probe */
+  if ((NOT(read_directory(dirpath, add_entry, new_cache))) ||
+      (new_cache->failed)) {
+    m2c_release_dircache(&new_cache);
+    return NULL;
+  } /* end if */
+  
+  return new_cache;
+} /* end m2c_new_dircache */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_dircache_dirpath(cache)
+ * --------------------------------------------------------------------------
+ * Returns the directory path of cache, or NULL if cache is NULL.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_dircache_dirpath (m2c_dircache_t cache) {
+  
+  if (cache == NULL) {
+    return NULL;
+  } /* end if */
+  
+  return cache->dirpath;
+} /* end m2c_dircache_dirpath */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_dircache_entry_count(cache)
+ * --------------------------------------------------------------------------
+ * Returns the number of entries of cache, or zero if cache is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_dircache_entry_count (m2c_dircache_t cache) {
+  
+  if (cache == NULL) {
+    return 0;
+  } /* end if */
+  
+  return cache->count;
+} /* end m2c_dircache_entry_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_dircache_contains(cache, filename)
+ * --------------------------------------------------------------------------
+ * Returns true if the directory of cache had an entry named filename when
+ * it was read, otherwise false.  Does not access the file system.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_dircache_contains (m2c_dircache_t cache, const char *filename) {
+  return (lookup(cache, filename) != NULL);
+} /* end m2c_dircache_contains */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_dircache_filesize(cache, filename, size)
+ * --------------------------------------------------------------------------
+ * Tests if the directory of cache has an entry named filename that is a
+ * regular file and if so, copies the file's size to out-parameter size and
+ * returns true.  Otherwise it leaves the out-parameter unmodified and
+ * returns false.  The file system is accessed at most once per entry.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_dircache_filesize
+  (m2c_dircache_t cache, const char *filename, long int *size) {
+  
+  m2c_dircache_entry_s *entry;
+  
+  entry = lookup(cache, filename);
+  
+  if ((entry == NULL) || (NOT(probe_entry(cache, entry)))) {
+    return false;
+  } /* end if */
+  
+  WRITE_OUTPARAM(size, entry->size);
+  
+  return true;
+} /* end m2c_dircache_filesize */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_dircache_filetime(cache, filename, timestamp)
+ * --------------------------------------------------------------------------
+ * Tests if the directory of cache has an entry named filename that is a
+ * regular file and if so, copies the file's last modification time to out-
+ * parameter timestamp and returns true.  Otherwise it leaves the out-
+ * parameter unmodified and returns false.  The file system is accessed at
+ * most once per entry.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_dircache_filetime
+  (m2c_dircache_t cache, const char *filename, long int *timestamp) {
+  
+  m2c_dircache_entry_s *entry;
+  
+  entry = lookup(cache, filename);
+  
+  if ((entry == NULL) || (NOT(probe_entry(cache, entry)))) {
+    return false;
+  } /* end if */
+  
+  WRITE_OUTPARAM(timestamp, entry->time);
+  
+  return true;
+} /* end m2c_dircache_filetime */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_release_dircache(cache)
+ * --------------------------------------------------------------------------
+ * Releases cache and passes back NULL in cache.
+ * ----------------------------------------------------------------------- */
+
+void m2c_release_dircache (m2c_dircache_t *cache) {
+  
+  uint_t slot;
+  
+  if ((cache == NULL) || (*cache == NULL)) {
+    return;
+  } /* end if */
+  
+  for (slot = 0; slot < (*cache)->capacity; slot++) {
+    free((*cache)->slot[slot].name);
+  } /* end for */
+  
+  free((*cache)->slot);
+  free((*cache)->dirpath);
+  free(*cache);
+  *cache = NULL;
+} /* end m2c_release_dircache */
+
+
+/* ************************************************************************ *
+ * Private Functions                                                        *
+ * ************************************************************************ */
+
+/* --------------------------------------------------------------------------
+ * private function name_hash(name)
+ * --------------------------------------------------------------------------
+ * Returns the FNV-1a hash of name, case folded where filenames are case
+ * insensitive.
+ * ----------------------------------------------------------------------- */
+
+static uint32_t name_hash (const char *name) {
+  
+  uint32_t hash = 2166136261u;
+  
+  while (*name != ASCII_NUL) {
+    hash = (hash ^ (uint32_t) (unsigned char) FOLD(*name)) * 16777619u;
+    name++;
+  } /* end while */
+  
+  return hash;
+} /* end name_hash */
+
+
+/* --------------------------------------------------------------------------
+ * private function names_match(name1, name2)
+ * --------------------------------------------------------------------------
+ * Returns true if name1 and name2 denote the same filename, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+static bool names_match (const char *name1, const char *name2) {
+  
+  while ((*name1 != ASCII_NUL) && (FOLD(*name1) == FOLD(*name2))) {
+    name1++;
+    name2++;
+  } /* end while */
+  
+  return (FOLD(*name1) == FOLD(*name2));
+} /* end names_match */
+
+
+/* --------------------------------------------------------------------------
+ * private function lookup(cache, filename)
+ * --------------------------------------------------------------------------
+ * Returns the entry of cache for filename, or NULL if there is none.
+ * ----------------------------------------------------------------------- */
+
+static m2c_dircache_entry_s *lookup
+  (m2c_dircache_t cache, const char *filename) {
+  
+  uint_t slot;
+  
+  if ((cache == NULL) || (filename == NULL) || (filename[0] == ASCII_NUL)) {
+    return NULL;
+  } /* end if */
+  
+  slot = table_probe(cache, filename, name_hash(filename));
+  
+  if (cache->slot[slot].name == NULL) {
+    return NULL;
+  } /* end if */
+  
+  return &cache->slot[slot];
+} /* end lookup */
+
+
+/* --------------------------------------------------------------------------
+ * private function table_probe(cache, name, hash)
+ * --------------------------------------------------------------------------
+ * Returns the slot of name in the entry table of cache, or the empty slot
+ * where name would be stored if name is not present.
+ * ----------------------------------------------------------------------- */
+
+static uint_t table_probe
+  (m2c_dircache_t cache, const char *name, uint32_t hash) {
+  
+  uint_t slot, mask;
+  
+  mask = cache->capacity - 1;
+  slot = hash & mask;
+  
+  while ((cache->slot[slot].name != NULL) &&
+         ((cache->slot[slot].hash != hash) ||
+          (NOT(names_match(cache->slot[slot].name, name))))) {
+    slot = (slot + 1) & mask;
+  } /* end while */
+  
+  return slot;
+} /* end table_probe */
+
+
+/* --------------------------------------------------------------------------
+ * private function table_reserve(cache)
+ * --------------------------------------------------------------------------
+ * Makes room for one more entry in cache, doubling the capacity of its
+ * entry table if the maximum load would otherwise be exceeded.  Returns
+ * false if the table needed to grow but could not be grown.
+ * ----------------------------------------------------------------------- */
+
+static bool table_reserve (m2c_dircache_t cache) {
+  
+  m2c_dircache_entry_s *old_slot;
+  uint_t old_capacity, slot, new_slot;
+  
+  if (((cache->count + 1) * 100) <=
+      (cache->capacity * M2C_DIRCACHE_MAX_LOAD_PERCENT)) {
+    return true;
+  } /* end if */
+  
+  old_slot = cache->slot;
+  old_capacity = cache->capacity;
+  
+  cache->slot = calloc(2 * old_capacity, sizeof(m2c_dircache_entry_s));
+  
+  if (cache->slot == NULL) {
+    cache->slot = old_slot;
+    return false;
+  } /* end if */
+  
+  cache->capacity = 2 * old_capacity;
+  
+  /* rehash occupied slots, hashes are kept with the entries */
+  for (slot = 0; slot < old_capacity; slot++) {
+    if (old_slot[slot].name != NULL) {
+      new_slot =
+        table_probe(cache, old_slot[slot].name, old_slot[slot].hash);
+      cache->slot[new_slot] = old_slot[slot];
+    } /* end if */
+  } /* end for */
+  
+  free(old_slot);
+  
+  return true;
+} /* end table_reserve */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure add_entry(name, context)
+ * --------------------------------------------------------------------------
+ * Directory entry handler, records name in the cache passed in context.
+ * ----------------------------------------------------------------------- */
+
+static void add_entry (const char *name, void *context) {
+  
+  m2c_dircache_t cache = context;
+  m2c_dircache_entry_s *entry;
+  uint32_t hash;
+  size_t len;
+  uint_t slot;
+  
+  if (cache->failed) {
+    return;
+  } /* end if */
+  
+  if (NOT(table_reserve(cache))) {
+    cache->failed = true;
+    return;
+  } /* end if */
+  
+  hash = name_hash(name);
+  slot = table_probe(cache, name, hash);
+  entry = &cache->slot[slot];
+  
+  /* names that differ only in case on a case insensitive host */
+  if (entry->name != NULL) {
+    return;
+  } /* end if */
+  
+  len = strlen(name);
+  entry->name = malloc(len + 1);
+  
+  if (entry->name == NULL) {
+    cache->failed = true;
+    return;
+  } /* end if */
+  
+  memcpy(entry->name, name, len + 1);
+  entry->hash = hash;
+  entry->probed = false;
+  entry->regular = false;
+  entry->size = 0;
+  entry->time = 0;
+  cache->count++;
+} /* end add_entry */
+
+
+/* --------------------------------------------------------------------------
+ * private function probe_entry(cache, entry)
+ * --------------------------------------------------------------------------
+ * Obtains the size and modification time of entry unless they have been
+ * obtained before.  Returns true if entry is a regular file, else false.
+ * ----------------------------------------------------------------------- */
+
+static bool probe_entry (m2c_dircache_t cache, m2c_dircache_entry_s *entry) {
+  
+  size_t dirlen, namelen;
+  char *path;
+  
+  if (entry->probed) {
+    return entry->regular;
+  } /* end if */
+  
+  dirlen = strlen(cache->dirpath);
+  namelen = strlen(entry->name);
+  path = malloc(dirlen + namelen + 2);
+  
+  if (path == NULL) {
+    return false;
+  } /* end if */
+  
+  /* compose dirpath/name */
+  memcpy(path, cache->dirpath, dirlen);
+  if (NOT(IS_DIRSEP(path[dirlen - 1]))) {
+    path[dirlen] = DIRSEP;
+    dirlen++;
+  } /* end if */
+  memcpy(path + dirlen, entry->name, namelen + 1);
+  
+  entry->regular =
+    (get_filesize(path, &entry->size)) && (get_filetime(path, &entry->time));
+  entry->probed = true;
+  free(path);
+  
+  return entry->regular;
+} /* end probe_entry */
+
+
+/* END OF FILE */
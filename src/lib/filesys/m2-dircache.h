@@ -0,0 +1,144 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015-2016 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * m2-dircache.h
+ *
+ * Public interface for directory listing caches.
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute and/or modify it under the
+ * terms of the GNU Lesser General Public License (LGPL) either version 2.1
+ * or at your choice version 3 as published by the Free Software Foundation.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+
+#ifndef M2C_DIRCACHE_H
+#define M2C_DIRCACHE_H
+
+#include "m2-common.h"
+
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * Directory listing caches
+ * --------------------------------------------------------------------------
+ * A directory listing cache reads the entries of a directory once and
+ * answers existence probes for filenames within the directory from an in-
+ * memory hash table, without any further file system access.  The size and
+ * modification time of an entry are obtained on the first probe for either
+ * and are then kept with the entry.  A cache reflects the directory at the
+ * time it was read, it is therefore only suitable for directories that do
+ * not change while the cache is in use, such as library search paths.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2c_dircache_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing a directory listing cache.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_dircache_s *m2c_dircache_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_new_dircache(dirpath)
+ * --------------------------------------------------------------------------
+ * Reads the entries of the directory at dirpath and returns a newly
+ * allocated cache of its listing.  Returns NULL if dirpath is not the path
+ * of a readable directory or if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+m2c_dircache_t m2c_new_dircache (const char *dirpath);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_dircache_dirpath(cache)
+ * --------------------------------------------------------------------------
+ * Returns the directory path of cache, or NULL if cache is NULL.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_dircache_dirpath (m2c_dircache_t cache);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_dircache_entry_count(cache)
+ * --------------------------------------------------------------------------
+ * Returns the number of entries of cache, or zero if cache is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_dircache_entry_count (m2c_dircache_t cache);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_dircache_contains(cache, filename)
+ * --------------------------------------------------------------------------
+ * Returns true if the directory of cache had an entry named filename when
+ * it was read, otherwise false.  Does not access the file system.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_dircache_contains (m2c_dircache_t cache, const char *filename);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_dircache_filesize(cache, filename, size)
+ * --------------------------------------------------------------------------
+ * Tests if the directory of cache has an entry named filename that is a
+ * regular file and if so, copies the file's size to out-parameter size and
+ * returns true.  Otherwise it leaves the out-parameter unmodified and
+ * returns false.  The file system is accessed at most once per entry.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_dircache_filesize
+  (m2c_dircache_t cache, const char *filename, long int *size);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_dircache_filetime(cache, filename, timestamp)
+ * --------------------------------------------------------------------------
+ * Tests if the directory of cache has an entry named filename that is a
+ * regular file and if so, copies the file's last modification time to out-
+ * parameter timestamp and returns true.  Otherwise it leaves the out-
+ * parameter unmodified and returns false.  The file system is accessed at
+ * most once per entry.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_dircache_filetime
+  (m2c_dircache_t cache, const char *filename, long int *timestamp);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_release_dircache(cache)
+ * --------------------------------------------------------------------------
+ * Releases cache and passes back NULL in cache.
+ * ----------------------------------------------------------------------- */
+
+void m2c_release_dircache (m2c_dircache_t *cache);
+
+
+#endif /* M2C_DIRCACHE_H */
+
+/* END OF FILE */
@@ -0,0 +1,482 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015-2016 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * m2-qualified-name.c
+ *
+ * Implementation of M2C qualified name module.
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute and/or modify it under the
+ * terms of the GNU Lesser General Public License (LGPL) either version 2.1
+ * or at your choice version 3 as published by the Free Software Foundation.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#include "m2-qualified-name.h"
+#include "m2-alloc-stats.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * Defaults
+ * --------------------------------------------------------------------------
+ * The slot table is allocated with M2C_QUALNAME_DEFAULT_CAPACITY slots
+ * when the first qualified name is entered and grows to twice its capacity
+ * whenever it would become more than half full.  Qualified name objects
+ * are allocated in slabs of M2C_QUALNAME_SLAB_SIZE objects.
+ * ----------------------------------------------------------------------- */
+
+#define M2C_QUALNAME_DEFAULT_CAPACITY 256
+
+#define M2C_QUALNAME_SLAB_SIZE 128
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_qualname_struct_t
+ * --------------------------------------------------------------------------
+ * record type representing a qualified name object.  Field text is NULL
+ * until the text is first requested.
+ * ----------------------------------------------------------------------- */
+
+struct m2c_qualname_struct_t {
+  /* module */ m2c_string_t module;
+  /* ident */ m2c_string_t ident;
+  /* hash */ uint_t hash;
+  /* text */ char *text;
+};
+
+typedef struct m2c_qualname_struct_t m2c_qualname_struct_t;
+
+
+/* --------------------------------------------------------------------------
+ * private types m2c_qualname_slab_t and m2c_qualname_slab_s
+ * --------------------------------------------------------------------------
+ * pointer and record type representing a slab of qualified name objects.
+ * Slabs are linked with the most recently allocated slab first.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_qualname_slab_s *m2c_qualname_slab_t;
+
+struct m2c_qualname_slab_s {
+  /* next */ m2c_qualname_slab_t next;
+  /* used */ uint_t used;
+  /* entry */ m2c_qualname_struct_t entry[M2C_QUALNAME_SLAB_SIZE];
+};
+
+typedef struct m2c_qualname_slab_s m2c_qualname_slab_s;
+
+
+/* --------------------------------------------------------------------------
+ * private types m2c_qualname_table_t and m2c_qualname_table_s
+ * --------------------------------------------------------------------------
+ * pointer and record type representing the qualified name table.  The
+ * table uses open addressing with linear probing, its capacity is a power
+ * of two.  Qualified names are never removed.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_qualname_table_s *m2c_qualname_table_t;
+
+struct m2c_qualname_table_s {
+  /* entry_count */ uint_t entry_count;
+  /* capacity */ uint_t capacity;
+  /* slot */ m2c_qualname_t *slot;
+  /* slab */ m2c_qualname_slab_t slab;
+};
+
+typedef struct m2c_qualname_table_s m2c_qualname_table_s;
+
+
+/* --------------------------------------------------------------------------
+ * private variable table
+ * --------------------------------------------------------------------------
+ * pointer to global qualified name table.
+ * ----------------------------------------------------------------------- */
+
+static m2c_qualname_table_t table = NULL;
+
+
+/* --------------------------------------------------------------------------
+ * Forward declarations
+ * ----------------------------------------------------------------------- */
+
+static m2c_qualname_t new_qualname
+  (m2c_string_t module, m2c_string_t ident, uint_t hash);
+
+static bool grow_table (uint_t new_capacity);
+
+static inline uint_t hash_for_pair (m2c_string_t module, m2c_string_t ident);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_get_qualname(module, ident, status)
+ * --------------------------------------------------------------------------
+ * Returns the unique qualified name object for identifier ident qualified
+ * by module.  Neither characters are copied nor hashed, the qualified name
+ * is identified by the string objects of module and ident alone.
+ * ----------------------------------------------------------------------- */
+
+m2c_qualname_t m2c_get_qualname
+  (m2c_string_t module, m2c_string_t ident, m2c_string_status_t *status) {
+  
+  m2c_qualname_t this_name;
+  uint_t hash, index, mask;
+  
+  /* check pre-conditions */
+  if ((module == NULL) || (ident == NULL)) {
+    SET_STATUS(status, M2C_STRING_STATUS_INVALID_REFERENCE);
+    return NULL;
+  } /* end if */
+  
+  /* allocate table when the first name is entered */
+  if (table == NULL) {
+    table = m2c_alloc_zeroed(M2C_ALLOC_STRINGS, 1,
+      sizeof(m2c_qualname_table_s));
+  
+    if ((table == NULL) || (NOT(grow_table(M2C_QUALNAME_DEFAULT_CAPACITY)))) {
+      if (table != NULL) {
+        m2c_dealloc(M2C_ALLOC_STRINGS, table, sizeof(m2c_qualname_table_s));
+        table = NULL;
+      } /* end if */
+      SET_STATUS(status, M2C_STRING_STATUS_ALLOCATION_FAILED);
+      return NULL;
+    } /* end if */
+  } /* end if */
+  
+  hash = hash_for_pair(module, ident);
+  mask = table->capacity - 1;
+  index = hash & mask;
+  
+  /* look for an existing entry */
+  while (table->slot[index] != NULL) {
+    this_name = table->slot[index];
+    if ((this_name->module == module) && (this_name->ident == ident)) {
+      SET_STATUS(status, M2C_STRING_STATUS_SUCCESS);
+      return this_name;
+    } /* end if */
+  
+    index = (index + 1) & mask;
+  } /* end while */
+  
+  /* keep the load factor of the table at or below one half */
+  if ((table->entry_count + 1) * 2 > table->capacity) {
+    if (NOT(grow_table(table->capacity * 2))) {
+      SET_STATUS(status, M2C_STRING_STATUS_ALLOCATION_FAILED);
+      return NULL;
+    } /* end if */
+  
+    mask = table->capacity - 1;
+    index = hash & mask;
+  
+    while (table->slot[index] != NULL) {
+      index = (index + 1) & mask;
+    } /* end while */
+  } /* end if */
+  
+  this_name = new_qualname(module, ident, hash);
+  
+  if (this_name == NULL) {
+    SET_STATUS(status, M2C_STRING_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  table->slot[index] = this_name;
+  table->entry_count++;
+  
+  SET_STATUS(status, M2C_STRING_STATUS_SUCCESS);
+  return this_name;
+} /* end m2c_get_qualname */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_qualname_module(qualname)
+ * --------------------------------------------------------------------------
+ * Returns the string object of the module of qualname, or NULL if qualname
+ * is NULL.
+ * ----------------------------------------------------------------------- */
+
+m2c_string_t m2c_qualname_module (m2c_qualname_t qualname) {
+  
+  if (qualname == NULL) {
+    return NULL;
+  } /* end if */
+  
+  return qualname->module;
+} /* end m2c_qualname_module */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_qualname_ident(qualname)
+ * --------------------------------------------------------------------------
+ * Returns the string object of the identifier of qualname, or NULL if
+ * qualname is NULL.
+ * ----------------------------------------------------------------------- */
+
+m2c_string_t m2c_qualname_ident (m2c_qualname_t qualname) {
+  
+  if (qualname == NULL) {
+    return NULL;
+  } /* end if */
+  
+  return qualname->ident;
+} /* end m2c_qualname_ident */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_qualname_length(qualname)
+ * --------------------------------------------------------------------------
+ * Returns the length of the text of qualname, or zero if qualname is NULL.
+ * The text is not composed.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_qualname_length (m2c_qualname_t qualname) {
+  
+  if (qualname == NULL) {
+    return 0;
+  } /* end if */
+  
+  return m2c_string_length(qualname->module) + 1 +
+    m2c_string_length(qualname->ident);
+} /* end m2c_qualname_length */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_qualname_char_ptr(qualname)
+ * --------------------------------------------------------------------------
+ * Returns an immutable pointer to the NUL terminated text of qualname in
+ * the form Module.Ident.  The text is composed when it is first requested
+ * and kept until the table is disposed.  Returns NULL if qualname is NULL
+ * or if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_qualname_char_ptr (m2c_qualname_t qualname) {
+  
+  uint_t module_length, ident_length;
+  char *text;
+  
+  if (qualname == NULL) {
+    return NULL;
+  } /* end if */
+  
+  if (qualname->text != NULL) {
+    return qualname->text;
+  } /* end if */
+  
+  module_length = m2c_string_length(qualname->module);
+  ident_length = m2c_string_length(qualname->ident);
+  text = m2c_alloc(M2C_ALLOC_STRINGS, module_length + ident_length + 2);
+  
+  if (text == NULL) {
+    return NULL;
+  } /* end if */
+  
+  memcpy(text, m2c_string_char_ptr(qualname->module), module_length);
+  text[module_length] = '.';
+  memcpy(text + module_length + 1,
+    m2c_string_char_ptr(qualname->ident), ident_length + 1);
+  
+  qualname->text = text;
+  return text;
+} /* end m2c_qualname_char_ptr */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_qualname_count()
+ * --------------------------------------------------------------------------
+ * Returns the number of qualified names stored in the table.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_qualname_count (void) {
+  
+  if (table == NULL) {
+    return 0;
+  } /* end if */
+  
+  return table->entry_count;
+} /* end m2c_qualname_count */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_dispose_qualname_table(status)
+ * --------------------------------------------------------------------------
+ * Deallocates the global qualified name table together with all qualified
+ * name objects stored in it and releases their module and identifier
+ * strings.
+ * ----------------------------------------------------------------------- */
+
+void m2c_dispose_qualname_table (m2c_string_status_t *status) {
+  
+  m2c_qualname_slab_t this_slab, next_slab;
+  m2c_qualname_t this_name;
+  uint_t index;
+  
+  /* check pre-conditions */
+  if (table == NULL) {
+    SET_STATUS(status, M2C_STRING_STATUS_NOT_INITIALIZED);
+    return;
+  } /* end if */
+  
+  this_slab = table->slab;
+  while (this_slab != NULL) {
+    for (index = 0; index < this_slab->used; index++) {
+      this_name = &this_slab->entry[index];
+  
+      if (this_name->text != NULL) {
+        m2c_dealloc(M2C_ALLOC_STRINGS, this_name->text,
+          m2c_qualname_length(this_name) + 1);
+      } /* end if */
+  
+      m2c_string_release(this_name->module);
+      m2c_string_release(this_name->ident);
+    } /* end for */
+  
+    next_slab = this_slab->next;
+    m2c_dealloc(M2C_ALLOC_STRINGS, this_slab, sizeof(m2c_qualname_slab_s));
+    this_slab = next_slab;
+  } /* end while */
+  
+  m2c_dealloc(M2C_ALLOC_STRINGS, table->slot,
+    table->capacity * sizeof(m2c_qualname_t));
+  m2c_dealloc(M2C_ALLOC_STRINGS, table, sizeof(m2c_qualname_table_s));
+  table = NULL;
+  
+  SET_STATUS(status, M2C_STRING_STATUS_SUCCESS);
+  return;
+} /* end m2c_dispose_qualname_table */
+
+
+/* *********************************************************************** *
+ * Private Functions
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private function new_qualname(module, ident, hash)
+ * --------------------------------------------------------------------------
+ * Returns a new qualified name object for module and ident with the given
+ * hash value, allocated from the current slab of the table.  Retains both
+ * module and ident.  Returns NULL if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static m2c_qualname_t new_qualname
+  (m2c_string_t module, m2c_string_t ident, uint_t hash) {
+  
+  m2c_qualname_slab_t new_slab;
+  m2c_qualname_t new_name;
+  
+  if ((table->slab == NULL) ||
+      (table->slab->used == M2C_QUALNAME_SLAB_SIZE)) {
+    new_slab = m2c_alloc(M2C_ALLOC_STRINGS, sizeof(m2c_qualname_slab_s));
+  
+    if (new_slab == NULL) {
+      return NULL;
+    } /* end if */
+  
+    new_slab->next = table->slab;
+    new_slab->used = 0;
+    table->slab = new_slab;
+  } /* end if */
+  
+  new_name = &table->slab->entry[table->slab->used];
+  table->slab->used++;
+  
+  m2c_string_retain(module);
+  m2c_string_retain(ident);
+  
+  new_name->module = module;
+  new_name->ident = ident;
+  new_name->hash = hash;
+  new_name->text = NULL;
+  
+  return new_name;
+} /* end new_qualname */
+
+
+/* --------------------------------------------------------------------------
+ * private function grow_table(new_capacity)
+ * --------------------------------------------------------------------------
+ * Replaces the slot table of the table by one with new_capacity slots,
+ * which must be a power of two, and re-enters all qualified names using
+ * their stored hash values.  Returns true on success, false if allocation
+ * failed, in which case the table is left unchanged.
+ * ----------------------------------------------------------------------- */
+
+static bool grow_table (uint_t new_capacity) {
+  
+  m2c_qualname_t *new_slot;
+  uint_t index, new_index, mask;
+  
+  new_slot = m2c_alloc_zeroed(M2C_ALLOC_STRINGS,
+    new_capacity, sizeof(m2c_qualname_t));
+  
+  if (new_slot == NULL) {
+    return false;
+  } /* end if */
+  
+  mask = new_capacity - 1;
+  for (index = 0; index < table->capacity; index++) {
+    if (table->slot[index] != NULL) {
+      new_index = table->slot[index]->hash & mask;
+  
+      while (new_slot[new_index] != NULL) {
+        new_index = (new_index + 1) & mask;
+      } /* end while */
+  
+      new_slot[new_index] = table->slot[index];
+    } /* end if */
+  } /* end for */
+  
+  if (table->slot != NULL) {
+    m2c_dealloc(M2C_ALLOC_STRINGS, table->slot,
+      table->capacity * sizeof(m2c_qualname_t));
+  } /* end if */
+  
+  table->slot = new_slot;
+  table->capacity = new_capacity;
+  
+  return true;
+} /* end grow_table */
+
+
+/* --------------------------------------------------------------------------
+ * private function hash_for_pair(module, ident)
+ * --------------------------------------------------------------------------
+ * Returns the hash value of the pair of string objects module and ident.
+ * Since string objects are unique, their addresses identify them.
+ * ----------------------------------------------------------------------- */
+
+static inline uint_t hash_for_pair (m2c_string_t module, m2c_string_t ident) {
+  uint64_t hash;
+  
+  hash = (((uint64_t) (uintptr_t) module) >> 3) * 0x9E3779B97F4A7C15ULL;
+  hash = (hash ^ (((uint64_t) (uintptr_t) ident) >> 3)) *
+    0x9E3779B97F4A7C15ULL;
+  
+  return (uint_t) (hash ^ (hash >> 32));
+} /* end hash_for_pair */
+
+
+/* END OF FILE */
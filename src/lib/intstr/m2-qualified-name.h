@@ -0,0 +1,169 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015-2016 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * m2-qualified-name.h
+ *
+ * Public interface for M2C qualified name module.
+ *
+ * The module provides a qualified name ADT managed in an internal global
+ * table keyed by the pair of unique strings of module and identifier.
+ * Qualified names are unique, they may be compared by pointer.  The text
+ * of a qualified name is only composed when it is first requested.
+ *
+ * The table is not protected by a lock and must not be used from more
+ * than one thread.
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute and/or modify it under the
+ * terms of the GNU Lesser General Public License (LGPL) either version 2.1
+ * or at your choice version 3 as published by the Free Software Foundation.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#ifndef M2C_QUALIFIED_NAME_H
+#define M2C_QUALIFIED_NAME_H
+
+#include "m2-common.h"
+#include "m2-unique-string.h"
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2c_qualname_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing a qualified name.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_qualname_struct_t *m2c_qualname_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_get_qualname(module, ident, status)
+ * --------------------------------------------------------------------------
+ * Returns the unique qualified name object for identifier ident qualified
+ * by module.  Neither characters are copied nor hashed, the qualified name
+ * is identified by the string objects of module and ident alone.
+ *
+ * pre-conditions:
+ * o  parameter module must not be NULL upon entry
+ * o  parameter ident must not be NULL upon entry
+ *
+ * post-conditions:
+ * o  if a qualified name object for module and ident is present in the
+ *    internal table, that qualified name object is returned.
+ * o  if no qualified name object for module and ident is present in the
+ *    table, a new qualified name object is created, stored and returned.
+ *    Both module and ident are then retained until the table is disposed.
+ * o  M2C_STRING_STATUS_SUCCESS is passed back in status, unless NULL
+ *
+ * error-conditions:
+ * o  if any of module or ident is NULL upon entry, no operation is carried
+ *    out, NULL is returned and M2C_STRING_STATUS_INVALID_REFERENCE is
+ *    passed back in status unless status is NULL
+ * o  if qualified name object allocation failed, NULL is returned and
+ *    M2C_STRING_STATUS_ALLOCATION_FAILED is passed back in status,
+ *    unless NULL
+ * ----------------------------------------------------------------------- */
+
+m2c_qualname_t m2c_get_qualname
+  (m2c_string_t module, m2c_string_t ident, m2c_string_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_qualname_module(qualname)
+ * --------------------------------------------------------------------------
+ * Returns the string object of the module of qualname, or NULL if qualname
+ * is NULL.
+ * ----------------------------------------------------------------------- */
+
+m2c_string_t m2c_qualname_module (m2c_qualname_t qualname);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_qualname_ident(qualname)
+ * --------------------------------------------------------------------------
+ * Returns the string object of the identifier of qualname, or NULL if
+ * qualname is NULL.
+ * ----------------------------------------------------------------------- */
+
+m2c_string_t m2c_qualname_ident (m2c_qualname_t qualname);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_qualname_length(qualname)
+ * --------------------------------------------------------------------------
+ * Returns the length of the text of qualname, or zero if qualname is NULL.
+ * The text is not composed.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_qualname_length (m2c_qualname_t qualname);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_qualname_char_ptr(qualname)
+ * --------------------------------------------------------------------------
+ * Returns an immutable pointer to the NUL terminated text of qualname in
+ * the form Module.Ident.  The text is composed when it is first requested
+ * and kept until the table is disposed.  Returns NULL if qualname is NULL
+ * or if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_qualname_char_ptr (m2c_qualname_t qualname);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_qualname_count()
+ * --------------------------------------------------------------------------
+ * Returns the number of qualified names stored in the table.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_qualname_count (void);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_dispose_qualname_table(status)
+ * --------------------------------------------------------------------------
+ * Deallocates the global qualified name table together with all qualified
+ * name objects stored in it and releases their module and identifier
+ * strings.  The table must be disposed of before the string repository.
+ *
+ * pre-conditions:
+ * o  parameter status may be NULL upon entry
+ *
+ * post-conditions:
+ * o  the table and all its qualified name objects are deallocated
+ * o  any qualified name objects still held by clients become invalid
+ * o  M2C_STRING_STATUS_SUCCESS is passed back in status, unless NULL
+ *
+ * error-conditions:
+ * o  if the table has not been allocated upon entry, no operation is
+ *    carried out and M2C_STRING_STATUS_NOT_INITIALIZED is passed back
+ *    in status unless status is NULL
+ * ----------------------------------------------------------------------- */
+
+void m2c_dispose_qualname_table (m2c_string_status_t *status);
+
+
+#endif /* M2C_QUALIFIED_NAME_H */
+
+/* END OF FILE */
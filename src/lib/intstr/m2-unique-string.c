@@ -37,20 +37,68 @@
  */
 
 #include "m2-unique-string.h"
-
-#include "hash.h"
+#include "m2-alloc-stats.h"
+#include "m2-trace-probes.h"
+#include "m2-thread.h"
 
 #include <stdio.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <limits.h>
+#include <string.h>
 #include <stdbool.h>
 
 
 /* --------------------------------------------------------------------------
  * Defaults
+ * --------------------------------------------------------------------------
+ * The slot table of the repository is kept at a power of two capacity and
+ * grows to twice its capacity whenever the number of occupied and removed
+ * slots would exceed M2C_STRING_REPO_MAX_LOAD_PERCENT of the capacity.
+ * ----------------------------------------------------------------------- */
+
+#define M2C_STRING_REPO_DEFAULT_CAPACITY 2048
+
+#define M2C_STRING_REPO_MAX_LOAD_PERCENT 75
+
+
+/* --------------------------------------------------------------------------
+ * Shard count
+ * --------------------------------------------------------------------------
+ * In concurrent mode, the repository is split into shards, each with its
+ * own table, arena and lock.  The shard of a string is selected by the top
+ * bits of its hash, the slot within the shard by the bottom bits.  Other
+ * modes use a single shard.  The shard count must be a power of two.
+ * On hosts without a supported thread API shards are not locked, concurrent
+ * mode must then not be used from more than one thread.
+ * ----------------------------------------------------------------------- */
+
+#define M2C_STRING_REPO_SHARD_COUNT 16
+
+#define M2C_STRING_REPO_SHARD_BITS 4
+
+
+/* --------------------------------------------------------------------------
+ * Arena slab size and alignment
+ * --------------------------------------------------------------------------
+ * In arena mode, string objects are carved out of slabs of the given size.
+ * String objects larger than a quarter of the slab size are given a slab
+ * of their own.  String objects are aligned to M2C_STRING_ARENA_ALIGNMENT.
  * ----------------------------------------------------------------------- */
 
-#define M2C_STRING_REPO_DEFAULT_BUCKET_COUNT 2011
+#define M2C_STRING_ARENA_SLAB_SIZE (64 * 1024)
+
+#define M2C_STRING_ARENA_ALIGNMENT (sizeof(void *))
+
+
+/* --------------------------------------------------------------------------
+ * Hash constants
+ * ----------------------------------------------------------------------- */
+
+#define HASH_SEED 0x243F6A8885A308D3ULL
+
+#define HASH_MULTIPLIER 0x9E3779B97F4A7C15ULL
 
 
 /* --------------------------------------------------------------------------
@@ -59,7 +107,18 @@
  * unsigned integer type representing a 32-bit hash value.
  * ----------------------------------------------------------------------- */
 
-typedef uint32_t m2c_hash_t;
+typedef m2c_string_hash_t m2c_hash_t;
+
+
+/* --------------------------------------------------------------------------
+ * Hash step
+ * --------------------------------------------------------------------------
+ * Combines hash state _state with a word of eight characters.
+ * ----------------------------------------------------------------------- */
+
+#define HASH_WORD(_state,_word) \
+  ((((_state) ^ (_word)) * HASH_MULTIPLIER) ^ \
+   ((((_state) ^ (_word)) * HASH_MULTIPLIER) >> 32))
 
 
 /* --------------------------------------------------------------------------
@@ -78,20 +137,59 @@ typedef struct m2c_string_struct_t m2c_string_struct_t;
 
 
 /* --------------------------------------------------------------------------
- * private types m2c_string_repo_entry_t and m2c_string_repo_entry_s
+ * private type m2c_string_repo_slot_s
  * --------------------------------------------------------------------------
- * pointer and record type representing a string repository entry.
+ * record type representing a slot of the string repository's table.
+ * A slot is empty if str is NULL and removed if str is REMOVED_SLOT.
  * ----------------------------------------------------------------------- */
 
-typedef struct m2c_string_repo_entry_s *m2c_string_repo_entry_t;
-
-struct m2c_string_repo_entry_s {
+struct m2c_string_repo_slot_s {
   /* key */ m2c_hash_t key;
   /* str */ m2c_string_t str;
-  /* next */ m2c_string_repo_entry_t next;
 };
 
-typedef struct m2c_string_repo_entry_s m2c_string_repo_entry_s;
+typedef struct m2c_string_repo_slot_s m2c_string_repo_slot_s;
+
+
+/* --------------------------------------------------------------------------
+ * private types m2c_string_slab_t and m2c_string_slab_s
+ * --------------------------------------------------------------------------
+ * pointer and record type representing an arena slab.  Slabs are linked
+ * with the most recently allocated slab first.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_string_slab_s *m2c_string_slab_t;
+
+struct m2c_string_slab_s {
+  /* next */ m2c_string_slab_t next;
+  /* size */ size_t size;
+  /* used */ size_t used;
+  /* data */ char data[];
+};
+
+typedef struct m2c_string_slab_s m2c_string_slab_s;
+
+
+/* --------------------------------------------------------------------------
+ * private types m2c_string_shard_t and m2c_string_shard_s
+ * --------------------------------------------------------------------------
+ * pointer and record type representing a shard of the string repository.
+ * The table uses open addressing with linear probing, its capacity is a
+ * power of two.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_string_shard_s *m2c_string_shard_t;
+
+struct m2c_string_shard_s {
+  /* lock */ m2c_lock_t lock;
+  /* entry_count */ uint_t entry_count;
+  /* removed_count */ uint_t removed_count;
+  /* capacity */ uint_t capacity;
+  /* slot */ m2c_string_repo_slot_s *slot;
+  /* slab */ m2c_string_slab_t slab;
+};
+
+typedef struct m2c_string_shard_s m2c_string_shard_s;
 
 
 /* --------------------------------------------------------------------------
@@ -103,14 +201,33 @@ typedef struct m2c_string_repo_entry_s m2c_string_repo_entry_s;
 typedef struct m2c_string_repo_s *m2c_string_repo_t;
 
 struct m2c_string_repo_s {
-  /* entry_count */ uint_t entry_count;
-  /* bucket_count */ uint_t bucket_count;
-  /* bucket */ m2c_string_repo_entry_t bucket[];
+  /* mode */ m2c_string_alloc_mode_t mode;
+  /* shard_count */ uint_t shard_count;
+  /* shard */ m2c_string_shard_s shard[];
 };
 
 typedef struct m2c_string_repo_s m2c_string_repo_s;
 
 
+/* --------------------------------------------------------------------------
+ * Shard selection and locking
+ * ----------------------------------------------------------------------- */
+
+#define SHARD_FOR_KEY(_key) \
+  ((repository->shard_count == 1) ? &repository->shard[0] : \
+   &repository->shard[(_key) >> (32 - M2C_STRING_REPO_SHARD_BITS)])
+
+#define SHARD_LOCK(_shard) \
+  if (repository->mode == M2C_STRING_ALLOC_CONCURRENT) { \
+    M2C_LOCK_ACQUIRE(&(_shard)->lock); \
+  } /* end if */
+
+#define SHARD_UNLOCK(_shard) \
+  if (repository->mode == M2C_STRING_ALLOC_CONCURRENT) { \
+    M2C_LOCK_RELEASE(&(_shard)->lock); \
+  } /* end if */
+
+
 /* --------------------------------------------------------------------------
  * private variable repository
  * --------------------------------------------------------------------------
@@ -120,35 +237,60 @@ typedef struct m2c_string_repo_s m2c_string_repo_s;
 static m2c_string_repo_t repository = NULL;
 
 
+/* --------------------------------------------------------------------------
+ * private variable removed_slot_marker
+ * --------------------------------------------------------------------------
+ * object whose address marks removed slots.
+ * ----------------------------------------------------------------------- */
+
+static m2c_string_struct_t removed_slot_marker = { 0, 0 };
+
+#define REMOVED_SLOT (&removed_slot_marker)
+
+
 /* --------------------------------------------------------------------------
  * Forward declarations
  * ----------------------------------------------------------------------- */
 
-static m2c_string_t new_string_from_string (char *str, uint_t length);
+static m2c_string_t unique_string_for_chars
+  (const char *chars, uint_t length, m2c_string_status_t *status);
 
-static m2c_string_t new_string_from_slice
-  (char *str, uint_t offset, uint_t length);
+static m2c_string_t unique_string_for_key
+  (const char *chars, uint_t length, m2c_hash_t key,
+   m2c_string_status_t *status);
 
-static m2c_string_t new_string_by_appending
-  (char *str, char *append_str, uint_t str_len, uint_t append_str_len);
+static m2c_string_t lookup_or_insert
+  (m2c_string_shard_t shard, m2c_hash_t key,
+   const char *chars, uint_t length, m2c_string_status_t *status);
+
+static m2c_string_t new_string_from_chars
+  (m2c_string_shard_t shard, const char *chars, uint_t length);
 
 static bool matches_str_and_len
   (m2c_string_t str, const char *cmpstr, uint_t length);
 
-static m2c_string_repo_entry_t new_repo_entry
-  (m2c_string_t str, m2c_hash_t key);
+static void *arena_allocate (m2c_string_shard_t shard, size_t size);
+
+static bool grow_shard (m2c_string_shard_t shard, uint_t new_capacity);
 
-static m2c_string_t remove_repo_entry (m2c_string_t str, m2c_hash_t key);
+static void remove_repo_entry (m2c_string_t str);
 
-static inline m2c_hash_t key_for_string (m2c_string_t str);
+static inline void add_chars_to_hasher
+  (m2c_string_hasher_t *hasher, const char *chars, uint_t length);
+
+static inline m2c_hash_t value_of_hasher (const m2c_string_hasher_t *hasher);
+
+static inline m2c_hash_t key_for_chars (const char *chars, uint_t length);
 
 
 /* --------------------------------------------------------------------------
  * procedure m2c_init_string_repository(size, status)
  * --------------------------------------------------------------------------
  * Allocates and initialises global string repository.  Parameter size
- * determines the number of buckets of the repository's internal hash table.
- * If size is zero, value M2C_STRING_REPO_DEFAULT_BUCKET_COUNT is used.
+ * determines the initial capacity of the repository's internal hash table,
+ * rounded up to the next power of two.  If size is zero, value
+ * M2C_STRING_REPO_DEFAULT_CAPACITY is used.  The table is allocated when
+ * the first string is entered and grows on demand.
  *
  * pre-conditions:
  * o  global repository must be uninitialised upon entry
@@ -170,7 +312,23 @@ static inline m2c_hash_t key_for_string (m2c_string_t str);
 void m2c_init_string_repository
   (uint_t size, m2c_string_status_t *status) {
   
-  uint_t index, bucket_count, allocation_size;
+  m2c_init_string_repository_w_mode(size, M2C_STRING_ALLOC_HEAP, status);
+  
+} /* end m2c_init_string_repository */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_init_string_repository_w_mode(size, mode, status)
+ * --------------------------------------------------------------------------
+ * Allocates and initialises global string repository with allocation mode
+ * mode.  Parameter size is interpreted as by m2c_init_string_repository().
+ * ----------------------------------------------------------------------- */
+
+void m2c_init_string_repository_w_mode
+  (uint_t size, m2c_string_alloc_mode_t mode, m2c_string_status_t *status) {
+  
+  uint_t index, capacity, shard_count;
+  m2c_string_shard_t shard;
   
   /* check pre-conditions */
   if (repository != NULL) {
@@ -178,18 +336,28 @@ void m2c_init_string_repository
     return;
   } /* end if */
   
-  /* determine bucket count */
-  if (size == 0) {
-    bucket_count = M2C_STRING_REPO_DEFAULT_BUCKET_COUNT;
+  /* determine shard count */
+  if (mode == M2C_STRING_ALLOC_CONCURRENT) {
+    shard_count = M2C_STRING_REPO_SHARD_COUNT;
   }
-  else /* size != 0 */ {
-    bucket_count = size;
+  else {
+    shard_count = 1;
   } /* end if */
   
+  /* determine capacity per shard */
+  if (size == 0) {
+    size = M2C_STRING_REPO_DEFAULT_CAPACITY;
+  } /* end if */
+  
+  size = size / shard_count;
+  capacity = 16;
+  while ((capacity < size) && (capacity < (UINT_MAX / 4) + 1)) {
+    capacity = 2 * capacity;
+  } /* end while */
+  
   /* allocate repository */
-  allocation_size = sizeof(m2c_string_repo_s) +
-    bucket_count * sizeof(m2c_string_repo_entry_t);
-  repository = malloc(allocation_size);
+  repository = m2c_alloc(M2C_ALLOC_STRINGS,
+    sizeof(m2c_string_repo_s) + shard_count * sizeof(m2c_string_shard_s));
   
   /* bail out if allocation failed */
   if (repository == NULL) {
@@ -197,20 +365,87 @@ void m2c_init_string_repository
     return;
   } /* end if */
   
-  /* set entry and bucket count */
-  repository->entry_count = 0;
-  repository->bucket_count = bucket_count;
+  repository->mode = mode;
+  repository->shard_count = shard_count;
   
-  /* initialise buckets */
-  index = 0;
-  while (index < bucket_count) {
-    repository->bucket[index] = NULL;
-    index++;
-  } /* end while */
+  /* initialise shards, slot tables are allocated on first insertion,
+   * so that a short run does not pay for clearing unused tables */
+  for (index = 0; index < shard_count; index++) {
+    shard = &repository->shard[index];
+    shard->slot = NULL;
+    
+    /* set counters and capacity */
+    shard->entry_count = 0;
+    shard->removed_count = 0;
+    shard->capacity = capacity;
+    shard->slab = NULL;
+    M2C_LOCK_INIT(&shard->lock);
+  } /* end for */
   
   SET_STATUS(status, M2C_STRING_STATUS_SUCCESS);
   return;
-} /* end m2c_init_string_repository */
+} /* end m2c_init_string_repository_w_mode */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_dispose_string_repository(status)
+ * --------------------------------------------------------------------------
+ * Deallocates the global string repository together with all string
+ * objects stored in it.
+ * ----------------------------------------------------------------------- */
+
+void m2c_dispose_string_repository (m2c_string_status_t *status) {
+  
+  m2c_string_slab_t this_slab, next_slab;
+  m2c_string_shard_t shard;
+  m2c_string_t this_string;
+  uint_t index, slot_index;
+  
+  /* check pre-conditions */
+  if (repository == NULL) {
+    SET_STATUS(status, M2C_STRING_STATUS_NOT_INITIALIZED);
+    return;
+  } /* end if */
+  
+  for (index = 0; index < repository->shard_count; index++) {
+    shard = &repository->shard[index];
+    
+    /* heap mode, deallocate each string object */
+    if ((repository->mode == M2C_STRING_ALLOC_HEAP) && (shard->slot != NULL)) {
+      for (slot_index = 0; slot_index < shard->capacity; slot_index++) {
+        this_string = shard->slot[slot_index].str;
+        if ((this_string != NULL) && (this_string != REMOVED_SLOT)) {
+          m2c_dealloc(M2C_ALLOC_STRINGS, this_string,
+            sizeof(m2c_string_struct_t) + this_string->length + 1);
+        } /* end if */
+      } /* end for */
+    }
+    
+    /* arena and concurrent mode, deallocate slabs in bulk */
+    else {
+      this_slab = shard->slab;
+      while (this_slab != NULL) {
+        next_slab = this_slab->next;
+        m2c_dealloc(M2C_ALLOC_STRINGS, this_slab,
+          sizeof(m2c_string_slab_s) + this_slab->size);
+        this_slab = next_slab;
+      } /* end while */
+    } /* end if */
+    
+    if (shard->slot != NULL) {
+      m2c_dealloc(M2C_ALLOC_STRINGS, shard->slot,
+        shard->capacity * sizeof(m2c_string_repo_slot_s));
+    } /* end if */
+    M2C_LOCK_DISPOSE(&shard->lock);
+  } /* end for */
+  
+  m2c_dealloc(M2C_ALLOC_STRINGS, repository, sizeof(m2c_string_repo_s) +
+    repository->shard_count * sizeof(m2c_string_shard_s));
+  repository = NULL;
+  
+  SET_STATUS(status, M2C_STRING_STATUS_SUCCESS);
+  return;
+} /* end m2c_dispose_string_repository */
 
 
 /* --------------------------------------------------------------------------
@@ -239,11 +474,6 @@ void m2c_init_string_repository
  * ----------------------------------------------------------------------- */
 
 m2c_string_t m2c_get_string (char *str, m2c_string_status_t *status) {
-  m2c_string_repo_entry_t new_entry, this_entry;
-  m2c_string_t new_string, this_string;
-  uint_t index, length;
-  m2c_hash_t key;
-  char ch;
   
   /* check repository */
   if (repository == NULL) {
@@ -256,85 +486,8 @@ m2c_string_t m2c_get_string (char *str, m2c_string_status_t *status) {
     SET_STATUS(status, M2C_STRING_STATUS_INVALID_REFERENCE);
     return NULL;
   } /* end if */
-    
-  /* determine length and key */
-  index = 0;
-  ch = str[index];
-  key = HASH_INITIAL;
-  while (ch != ASCII_NUL) {
-    key = HASH_NEXT_CHAR(key, ch);
-    index++;
-    ch = str[index];
-  } /* end while */
-  
-  length = index + 1;
-  key = HASH_FINAL(key);
   
-  /* determine bucket index */
-  index = key % repository->bucket_count;
-  
-  /* check if str is already in repository */
-  if /* bucket empty */ (repository->bucket[index] == NULL) {
-    
-    /* create a new string object */
-    new_string = new_string_from_string(str, length);
-    
-    /* create a new repository entry */
-    new_entry = new_repo_entry(new_string, key);
-    
-    /* link the bucket to the new entry */
-    repository->bucket[index] = new_entry;
-    
-    /* update the entry counter */
-    repository->entry_count++;
-    
-    /* set status and return string object */
-    SET_STATUS(status, M2C_STRING_STATUS_SUCCESS);
-    return new_string;
-  }
-  else /* bucket not empty */ {
-    
-    /* first entry in bucket is starting point */
-    this_entry = repository->bucket[index];
-    
-    /* search bucket for matching string */
-    while (true) {
-      if /* match found in current entry */
-        ((this_entry->key == key) &&
-          matches_str_and_len(this_entry->str, str, length)) {
-        
-        /* get string object of matching entry and retain it */
-        this_string = this_entry->str;
-        m2c_string_retain(this_string);
-        
-        /* set status and return string object */
-        SET_STATUS(status, M2C_STRING_STATUS_SUCCESS);
-        return this_string;
-      }
-      else if /* last entry reached without match */
-        (this_entry->next == NULL) {
-        
-        /* create a new string object */
-        new_string = new_string_from_string(str, length);
-        
-        /* create a new repository entry */
-        new_entry = new_repo_entry(new_string, key);
-        
-        /* link last entry to the new entry */
-        this_entry->next = new_entry;
-        
-        /* update the entry counter */
-        repository->entry_count++;
-        
-        /* set status and return string object */
-        SET_STATUS(status, M2C_STRING_STATUS_SUCCESS);
-        return new_string;
-      }
-      else /* not last entry yet, move to next entry */ {
-        this_entry = this_entry->next;
-      } /* end if */
-    } /* end while */      
-  } /* end if */  
+  return unique_string_for_chars(str, (uint_t) strlen(str), status);
 } /* end m2c_get_string */
 
 
@@ -372,13 +525,9 @@ m2c_string_t m2c_get_string (char *str, m2c_string_status_t *status) {
  * ----------------------------------------------------------------------- */
 
 m2c_string_t m2c_get_string_for_slice
-  (char *str, uint_t offset, uint_t length, m2c_string_status_t *status) {
+  (const char *str, uint_t offset, uint_t length, m2c_string_status_t *status) {
   
-  m2c_string_repo_entry_t new_entry, this_entry;
-  m2c_string_t new_string, this_string;
   uint_t index;
-  m2c_hash_t key;
-  char ch;
   
   /* check repository */
   if (repository == NULL) {
@@ -392,110 +541,115 @@ m2c_string_t m2c_get_string_for_slice
     return NULL;
   } /* end if */
   
-  /* determine key for slice */
-  index = offset;
-  key = HASH_INITIAL;
-  while (index < length) {
-    ch = str[index];
-    /* bail out if any control codes are found */
-    if (IS_CONTROL_CHAR(ch)) {
+  /* bail out if any control codes are found */
+  for (index = offset; index < offset + length; index++) {
+    if (IS_CONTROL_CHAR(str[index])) {
       SET_STATUS(status, M2C_STRING_STATUS_INVALID_INDICES);
       return NULL;
     } /* end if */
-    key = HASH_NEXT_CHAR(key, ch);
-    index++;
-  } /* end while */
+  } /* end for */
   
-  key = HASH_FINAL(key);
+  return unique_string_for_chars(&str[offset], length, status);
+} /* end m2c_get_string_for_slice */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_string_hasher_init(hasher)
+ * --------------------------------------------------------------------------
+ * Initialises hasher for the calculation of a new hash value.
+ * ----------------------------------------------------------------------- */
+
+void m2c_string_hasher_init (m2c_string_hasher_t *hasher) {
   
-  /* determine bucket index */
-  index = key % repository->bucket_count;
+  hasher->state = HASH_SEED;
+  hasher->length = 0;
   
-  /* check if str is already in repository */
-  if /* bucket empty */ (repository->bucket[index] == NULL) {
-    
-    /* create a new string object */
-    new_string = new_string_from_slice(str, offset, length);
-    
-    /* create a new repository entry */
-    new_entry = new_repo_entry(new_string, key);
-    
-    /* link the bucket to the new entry */
-    repository->bucket[index] = new_entry;
-    
-    /* update the entry counter */
-    repository->entry_count++;
-    
-    /* set status and return string object */
-    SET_STATUS(status, M2C_STRING_STATUS_SUCCESS);
-    return new_string;
-  }
-  else /* bucket not empty */ {
-    
-    /* first entry in bucket is starting point */
-    this_entry = repository->bucket[index];
-    
-    /* search bucket for matching string */
-    while (true) {
-      if /* match found in current entry */
-        ((this_entry->key == key) &&
-          matches_str_and_len(this_entry->str, str, length)) {
-        
-        /* get string object of matching entry and retain it */
-        this_string = this_entry->str;
-        m2c_string_retain(this_string);
-        
-        /* set status and return string object */
-        SET_STATUS(status, M2C_STRING_STATUS_SUCCESS);
-        return this_string;
-      }
-      else if /* last entry reached without match */
-        (this_entry->next == NULL) {
-        
-        /* create a new string object */
-        new_string = new_string_from_slice(str, offset, length);
-        
-        /* create a new repository entry */
-        new_entry = new_repo_entry(new_string, key);
-        
-        /* link last entry to the new entry */
-        this_entry->next = new_entry;
-        
-        /* update the entry counter */
-        repository->entry_count++;
-        
-        /* set status and return string object */
-        SET_STATUS(status, M2C_STRING_STATUS_SUCCESS);
-        return new_string;
-      }
-      else /* not last entry yet, move to next entry */ {
-        this_entry = this_entry->next;
-      } /* end if */
-    } /* end while */      
-  } /* end if */  
-} /* end m2c_get_string_for_slice */
+  return;
+} /* end m2c_string_hasher_init */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_string_hasher_add_chars(hasher, chars, length)
+ * --------------------------------------------------------------------------
+ * Appends the character sequence of the given length at chars to the
+ * sequence represented by hasher.
+ * ----------------------------------------------------------------------- */
+
+void m2c_string_hasher_add_chars
+  (m2c_string_hasher_t *hasher, const char *chars, uint_t length) {
+  
+  add_chars_to_hasher(hasher, chars, length);
+  
+  return;
+} /* end m2c_string_hasher_add_chars */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_string_hasher_value(hasher)
+ * --------------------------------------------------------------------------
+ * Returns the hash value of the character sequence represented by hasher.
+ * ----------------------------------------------------------------------- */
+
+m2c_string_hash_t m2c_string_hasher_value (const m2c_string_hasher_t *hasher) {
+  return value_of_hasher(hasher);
+} /* end m2c_string_hasher_value */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_get_string_for_slice_w_hash(str, offset, length, hash, status)
+ * --------------------------------------------------------------------------
+ * Returns a unique string object for a given slice of str whose hash value
+ * has already been calculated by the caller.  The slice is neither hashed
+ * nor checked for control codes.
+ * ----------------------------------------------------------------------- */
+
+m2c_string_t m2c_get_string_for_slice_w_hash
+  (const char *str, uint_t offset, uint_t length,
+   m2c_string_hash_t hash, m2c_string_status_t *status) {
+  
+  /* check repository */
+  if (repository == NULL) {
+    SET_STATUS(status, M2C_STRING_STATUS_NOT_INITIALIZED);
+    return NULL;
+  } /* end if */
+  
+  /* check str */
+  if (str == NULL) {
+    SET_STATUS(status, M2C_STRING_STATUS_INVALID_REFERENCE);
+    return NULL;
+  } /* end if */
+  
+  return unique_string_for_key(&str[offset], length, hash, status);
+} /* end m2c_get_string_for_slice_w_hash */
 
 
 /* --------------------------------------------------------------------------
  * function m2c_get_string_for_concatenation(str, append_str, status)
  * --------------------------------------------------------------------------
- * Allocates a new object of type m2c_string_t and initialises it with a
- * copy of str appended by a copy of append_str each of which must be a
- * pointer to a NUL terminated character string.
+ * Returns a unique string object for the character string resulting from
+ * concatenation of str and append_str.  Parameters str and append_str must
+ * be pointers to NUL terminated character strings.
  *
  * pre-conditions:
  * o  parameter str must not be NULL upon entry
  * o  parameter append_str must not be NULL upon entry
  *
  * post-conditions:
- * o  pointer to newly allocated dynamic string is returned
- * o  copy of character string and its length is stored internally
+ * o  if a string object for the resulting concatenation string is present in
+ *    the internal repository, that string object is retrieved, retained and
+ *    returned.
+ * o  if no string object for the resulting concatenation is present in the
+ *    repository, a new string object with a copy of the concatenation is
+ *    created, stored and returned.
  * o  M2C_STRING_STATUS_SUCCESS is passed back in status, unless NULL
  *
  * error-conditions:
  * o  if any of str or append_str is NULL upon entry, no operation is
  *    carried out, NULL is returned and M2C_STRING_STATUS_INVALID_REFERENCE
  *    is passed back in status, unless NULL
+ * o  if the concatenation exceeds M2C_STRING_SIZE_LIMIT, no operation is
+ *    carried out, NULL is returned and M2C_STRING_STATUS_SIZE_LIMIT_EXCEEDED
+ *    is passed back in status, unless NULL
  * o  if no dynamic string object could be allocated, NULL is returned,
  *    and M2C_STRING_STATUS_ALLOCATION_FAILED is passed back in status,
  *    unless NULL
@@ -504,11 +658,8 @@ m2c_string_t m2c_get_string_for_slice
 m2c_string_t m2c_get_string_for_concatenation
   (char *str, char *append_str, m2c_string_status_t *status) {
   
-  m2c_string_repo_entry_t new_entry, this_entry;
-  m2c_string_t new_string, this_string;
-  uint_t index, length, str_len, append_str_len;
-  m2c_hash_t key;
-  char ch;
+  char buffer[M2C_STRING_SIZE_LIMIT + 1];
+  size_t str_len, append_str_len;
   
   /* check repository */
   if (repository == NULL) {
@@ -522,102 +673,22 @@ m2c_string_t m2c_get_string_for_concatenation
     return NULL;
   } /* end if */
   
-  /* determine key and length of str */
-  index = 0;
-  ch = str[index];
-  key = HASH_INITIAL;
-  while (ch != ASCII_NUL) {
-    key = HASH_NEXT_CHAR(key, ch);
-    index++;
-    ch = str[index];
-  } /* end while */
-  
-  str_len = index + 1;
+  str_len = strlen(str);
+  append_str_len = strlen(append_str);
   
-  /* determine key and length of append_str */
-  index = 0;
-  ch = append_str[index];
-  key = HASH_INITIAL;
-  while (ch != ASCII_NUL) {
-    key = HASH_NEXT_CHAR(key, ch);
-    index++;
-    ch = append_str[index];
-  } /* end while */
-  
-  append_str_len = index + 1;
-  
-  /* finalise length and key of concatenation */
-  length = str_len + append_str_len;
-  key = HASH_FINAL(key);
+  /* check size limit */
+  if (str_len + append_str_len > M2C_STRING_SIZE_LIMIT) {
+    SET_STATUS(status, M2C_STRING_STATUS_SIZE_LIMIT_EXCEEDED);
+    return NULL;
+  } /* end if */
   
-  /* determine bucket index */
-  index = key % repository->bucket_count;
+  /* concatenate */
+  memcpy(buffer, str, str_len);
+  memcpy(&buffer[str_len], append_str, append_str_len);
   
-  /* check if str is already in repository */
-  if /* bucket empty */ (repository->bucket[index] == NULL) {
-    
-    /* create a new string object */
-    new_string =
-      new_string_by_appending(str, append_str, str_len, append_str_len);
-    
-    /* create a new repository entry */
-    new_entry = new_repo_entry(new_string, key);
-    
-    /* link the bucket to the new entry */
-    repository->bucket[index] = new_entry;
-    
-    /* update the entry counter */
-    repository->entry_count++;
-    
-    /* set status and return string object */
-    SET_STATUS(status, M2C_STRING_STATUS_SUCCESS);
-    return new_string;
-  }
-  else /* bucket not empty */ {
-    
-    /* first entry in bucket is starting point */
-    this_entry = repository->bucket[index];
-    
-    /* search bucket for matching string */
-    while (true) {
-      if /* match found in current entry */
-        ((this_entry->key == key) &&
-          matches_str_and_len(this_entry->str, str, length)) {
-        
-        /* get string object of matching entry and retain it */
-        this_string = this_entry->str;
-        m2c_string_retain(this_string);
-        
-        /* set status and return string object */
-        SET_STATUS(status, M2C_STRING_STATUS_SUCCESS);
-        return this_string;
-      }
-      else if /* last entry reached without match */
-        (this_entry->next == NULL) {
-        
-        /* create a new string object */
-        new_string =
-          new_string_by_appending(str, append_str, str_len, append_str_len);
-        
-        /* create a new repository entry */
-        new_entry = new_repo_entry(new_string, key);
-        
-        /* link last entry to the new entry */
-        this_entry->next = new_entry;
-        
-        /* update the entry counter */
-        repository->entry_count++;
-        
-        /* set status and return string object */
-        SET_STATUS(status, M2C_STRING_STATUS_SUCCESS);
-        return new_string;
-      }
-      else /* not last entry yet, move to next entry */ {
-        this_entry = this_entry->next;
-      } /* end if */
-    } /* end while */      
-  } /* end if */  
-} /* end m2c_new_string_by_appending_string */
+  return unique_string_for_chars
+    (buffer, (uint_t) (str_len + append_str_len), status);
+} /* end m2c_get_string_for_concatenation */
 
 
 /* --------------------------------------------------------------------------
@@ -686,12 +757,22 @@ inline const char *m2c_string_char_ptr (m2c_string_t str) {
  * ----------------------------------------------------------------------- */
 
 inline uint_t m2c_unique_string_count (void) {
+  m2c_string_shard_t shard;
+  uint_t index, count;
   
   if (repository == NULL) {
     return 0;
   } /* end if */
   
-  return repository->entry_count;
+  count = 0;
+  for (index = 0; index < repository->shard_count; index++) {
+    shard = &repository->shard[index];
+    SHARD_LOCK(shard);
+    count = count + shard->entry_count;
+    SHARD_UNLOCK(shard);
+  } /* end for */
+  
+  return count;
 } /* end m2c_unique_string_count */
 
 
@@ -712,6 +793,12 @@ inline uint_t m2c_unique_string_count (void) {
 
 void m2c_string_retain (m2c_string_t str) {
   
+  /* concurrent mode, strings are interned until disposal */
+  if ((repository != NULL) &&
+      (repository->mode == M2C_STRING_ALLOC_CONCURRENT)) {
+    return;
+  } /* end if */
+  
   if ((str != NULL) && (str->ref_count > 0)) {
     str->ref_count++;
   } /* end if */
@@ -719,6 +806,7 @@ void m2c_string_retain (m2c_string_t str) {
 } /* end m2c_string_retain */
 
 
+
 /* --------------------------------------------------------------------------
  * function m2c_string_release(str)
  * --------------------------------------------------------------------------
@@ -738,27 +826,29 @@ void m2c_string_retain (m2c_string_t str) {
 
 void m2c_string_release (m2c_string_t str) {
   
-  m2c_hash_t key;
+  uint_t length;
   
   if (str == NULL) {
     return;
   } /* end if */
   
-  /* printf("  release called on '%s', refcount %u\n",
-    str->char_array, str->ref_count); */
+  /* concurrent mode, strings are interned until disposal */
+  if ((repository != NULL) &&
+      (repository->mode == M2C_STRING_ALLOC_CONCURRENT)) {
+    return;
+  } /* end if */
   
   if (str->ref_count > 1) {
     str->ref_count--;
-    /* printf("  new refcount %u\n", str->ref_count); */
+  }
+  else if /* arena mode, keep until repository is disposed of */
+    ((repository != NULL) && (repository->mode == M2C_STRING_ALLOC_ARENA)) {
+    return;
   }
   else if (str->ref_count == 1) {
-    /* remove and deallocate */
-    printf("* deallocating string '%s' (%p)\n",
-      m2c_string_char_ptr(str), str);
-    
     /* remove from repo */
-    key = key_for_string(str);
-    remove_repo_entry(str, key);
+    remove_repo_entry(str);
+    length = str->length;
     
     /* reset */
     str->length = 0;
@@ -766,7 +856,8 @@ void m2c_string_release (m2c_string_t str) {
     str->char_array[0] = ASCII_NUL;
     
     /* deallocate */
-    free(str);
+    m2c_dealloc
+      (M2C_ALLOC_STRINGS, str, sizeof(m2c_string_struct_t) + length + 1);
   } /* end if */
 } /* end m2c_string_release */
 
@@ -776,13 +867,197 @@ void m2c_string_release (m2c_string_t str) {
  * *********************************************************************** */
 
 /* --------------------------------------------------------------------------
- * private function new_string_from_string(str, length)
+ * private function unique_string_for_chars(chars, length, status)
  * --------------------------------------------------------------------------
- * Allocates and returns a new string object, initialised with str and
- * length.  Returns NULL if allocation failed.
+ * Looks up the character sequence of the given length at chars in the
+ * repository.  If present, its string object is retained and returned.
+ * Otherwise a new string object with a copy of the sequence is created,
+ * stored and returned.  Returns NULL if allocation failed.
  *
  * pre-conditions:
- * o  parameter str must not be NULL upon entry (NOT GUARDED)
+ * o  repository must be initialised (NOT GUARDED)
+ * o  parameter chars must not be NULL upon entry (NOT GUARDED)
+ *
+ * post-conditions:
+ * o  unique string object for chars is returned
+ * o  M2C_STRING_STATUS_SUCCESS is passed back in status, unless NULL
+ *
+ * error-conditions:
+ * o  if allocation fails, NULL is returned and
+ *    M2C_STRING_STATUS_ALLOCATION_FAILED is passed back in status,
+ *    unless NULL
+ * ----------------------------------------------------------------------- */
+
+static m2c_string_t unique_string_for_chars
+  (const char *chars, uint_t length, m2c_string_status_t *status) {
+  
+  return unique_string_for_key
+    (chars, length, key_for_chars(chars, length), status);
+} /* end unique_string_for_chars */
+
+
+/* --------------------------------------------------------------------------
+ * private function unique_string_for_key(chars, length, key, status)
+ * --------------------------------------------------------------------------
+ * Looks up the character sequence of the given length at chars with hash
+ * key in the repository, locking the shard selected by key.  Otherwise
+ * like unique_string_for_chars().
+ *
+ * pre-conditions:
+ * o  repository must be initialised (NOT GUARDED)
+ * o  parameter chars must not be NULL upon entry (NOT GUARDED)
+ * o  key must be the hash key of chars (NOT GUARDED)
+ *
+ * post-conditions:
+ * o  unique string object for chars is returned
+ * o  M2C_STRING_STATUS_SUCCESS is passed back in status, unless NULL
+ *
+ * error-conditions:
+ * o  if allocation fails, NULL is returned and
+ *    M2C_STRING_STATUS_ALLOCATION_FAILED is passed back in status,
+ *    unless NULL
+ * ----------------------------------------------------------------------- */
+
+static m2c_string_t unique_string_for_key
+  (const char *chars, uint_t length, m2c_hash_t key,
+   m2c_string_status_t *status) {
+  
+  m2c_string_shard_t shard;
+  m2c_string_t str;
+  
+  shard = SHARD_FOR_KEY(key);
+  
+  SHARD_LOCK(shard);
+  str = lookup_or_insert(shard, key, chars, length, status);
+  SHARD_UNLOCK(shard);
+  
+  return str;
+} /* end unique_string_for_key */
+
+
+/* --------------------------------------------------------------------------
+ * private function lookup_or_insert(shard, key, chars, length, status)
+ * --------------------------------------------------------------------------
+ * Looks up the character sequence of the given length at chars with hash
+ * key in shard.  If present, its string object is retained and returned.
+ * Otherwise a new string object with a copy of the sequence is created,
+ * stored in shard and returned.  Returns NULL if allocation failed.
+ *
+ * pre-conditions:
+ * o  shard must be locked by the caller in concurrent mode (NOT GUARDED)
+ * o  parameter chars must not be NULL upon entry (NOT GUARDED)
+ *
+ * post-conditions:
+ * o  unique string object for chars is returned
+ * o  M2C_STRING_STATUS_SUCCESS is passed back in status, unless NULL
+ *
+ * error-conditions:
+ * o  if allocation fails, NULL is returned and
+ *    M2C_STRING_STATUS_ALLOCATION_FAILED is passed back in status,
+ *    unless NULL
+ * ----------------------------------------------------------------------- */
+
+static m2c_string_t lookup_or_insert
+  (m2c_string_shard_t shard, m2c_hash_t key,
+   const char *chars, uint_t length, m2c_string_status_t *status) {
+  
+  m2c_string_repo_slot_s *this_slot, *target_slot;
+  m2c_string_t this_string, new_string;
+  uint_t index, mask, used;
+  
+  /* allocate slot table when the first string is entered into shard */
+  if ((shard->slot == NULL) && (NOT(grow_shard(shard, shard->capacity)))) {
+    SET_STATUS(status, M2C_STRING_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  /* grow table if the new entry would exceed the maximum load factor */
+  used = shard->entry_count + shard->removed_count + 1;
+  if ((uint64_t) used * 100 >
+      (uint64_t) shard->capacity * M2C_STRING_REPO_MAX_LOAD_PERCENT) {
+    
+    /* double capacity, unless most used slots are removed slots */
+    if (shard->entry_count + 1 > shard->capacity / 4) {
+      grow_shard(shard, 2 * shard->capacity);
+    }
+    else {
+      grow_shard(shard, shard->capacity);
+    } /* end if */
+  } /* end if */
+  
+  /* bail out if no empty slot would remain and the table was not grown */
+  if (shard->entry_count + shard->removed_count + 1 >=
+      shard->capacity) {
+    SET_STATUS(status, M2C_STRING_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  /* probe from home slot until the string or an empty slot is found */
+  mask = shard->capacity - 1;
+  index = key & mask;
+  target_slot = NULL;
+  
+  while (true) {
+    this_slot = &shard->slot[index];
+    this_string = this_slot->str;
+    
+    if /* empty slot, string is not in repository */ (this_string == NULL) {
+      break;
+    }
+    else if /* removed slot, remember first for reuse */
+      (this_string == REMOVED_SLOT) {
+      if (target_slot == NULL) {
+        target_slot = this_slot;
+      } /* end if */
+    }
+    else if /* match found */
+      ((this_slot->key == key) &&
+       matches_str_and_len(this_string, chars, length)) {
+      
+      /* retain and return string object of matching slot */
+      m2c_string_retain(this_string);
+      SET_STATUS(status, M2C_STRING_STATUS_SUCCESS);
+      return this_string;
+    } /* end if */
+    
+    index = (index + 1) & mask;
+  } /* end while */
+  
+  /* create a new string object */
+  new_string = new_string_from_chars(shard, chars, length);
+  
+  if (new_string == NULL) {
+    SET_STATUS(status, M2C_STRING_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  /* store it in the first removed slot passed, or else the empty slot */
+  if (target_slot != NULL) {
+    shard->removed_count--;
+  }
+  else {
+    target_slot = this_slot;
+  } /* end if */
+  
+  target_slot->key = key;
+  target_slot->str = new_string;
+  shard->entry_count++;
+  
+  SET_STATUS(status, M2C_STRING_STATUS_SUCCESS);
+  return new_string;
+} /* end lookup_or_insert */
+
+
+/* --------------------------------------------------------------------------
+ * private function new_string_from_chars(shard, chars, length)
+ * --------------------------------------------------------------------------
+ * Allocates and returns a new string object, initialised with a copy of
+ * the character sequence of the given length at chars.  Returns NULL if
+ * allocation failed.
+ *
+ * pre-conditions:
+ * o  repository must be initialised (NOT GUARDED)
+ * o  parameter chars must not be NULL upon entry (NOT GUARDED)
  *
  * post-conditions:
  * o  newly allocated, initalised and retained string object is returned
@@ -791,13 +1066,20 @@ void m2c_string_release (m2c_string_t str) {
  * o  if allocation fails, no operation is carried out, NULL is returned
  * ----------------------------------------------------------------------- */
 
-static m2c_string_t new_string_from_string (char *str, uint_t length) {
+static m2c_string_t new_string_from_chars
+  (m2c_string_shard_t shard, const char *chars, uint_t length) {
   
   m2c_string_t new_string;
-  uint_t index;
   
   /* allocate new string object */
-  new_string = malloc(sizeof(m2c_string_struct_t) + length + 1);
+  if (repository->mode != M2C_STRING_ALLOC_HEAP) {
+    new_string =
+      arena_allocate(shard, sizeof(m2c_string_struct_t) + length + 1);
+  }
+  else {
+    new_string = m2c_alloc
+      (M2C_ALLOC_STRINGS, sizeof(m2c_string_struct_t) + length + 1);
+  } /* end if */
   
   /* bail if allocation failed */
   if (new_string == NULL) {
@@ -808,28 +1090,22 @@ static m2c_string_t new_string_from_string (char *str, uint_t length) {
   new_string->ref_count = 1;
   new_string->length = length;
   
-  /* copy string */
-  index = 0;
-  while (index < length) {
-    new_string->char_array[index] = str[index];
-    index++;
-  } /* end while */
-  
-  /* terminate character array */
-  new_string->char_array[index] = ASCII_NUL;
+  /* copy and terminate character array */
+  memcpy(new_string->char_array, chars, length);
+  new_string->char_array[length] = ASCII_NUL;
   
   return new_string;
-} /* end new_string_from_string */
+} /* end new_string_from_chars */
 
 
 /* --------------------------------------------------------------------------
- * private function matches_str_and_len(str1, str2, length)
+ * private function matches_str_and_len(str, cmpstr, length)
  * --------------------------------------------------------------------------
- * Compares character strings str1 and str2 up to length characters
- * and returns true if they match, otherwise false.
+ * Compares the character string of str with the character sequence of the
+ * given length at cmpstr and returns true if they match, otherwise false.
  *
  * pre-conditions:
- * o  parameters str1 and str2 must not be NULL upon entry (NOT GUARDED)
+ * o  parameters str and cmpstr must not be NULL upon entry (NOT GUARDED)
  *
  * post-conditions:
  * o  boolean result is returned
@@ -841,241 +1117,303 @@ static m2c_string_t new_string_from_string (char *str, uint_t length) {
 static bool matches_str_and_len
   (m2c_string_t str, const char *cmpstr, uint_t length) {
   
-  uint_t index;
-  
   if (str->length != length) {
     return false;
   } /* end if */
   
-  index = 0;
-  while (index <= length) {
-    if (str->char_array[index] != cmpstr[index]) {
-      return false;
-    }
-    else if (str->char_array[index] == ASCII_NUL) {
-      return true;
-    }
-    else {
-      index++;
-    } /* end if */
-  } /* end while */
-  
-  return false;
+  return (memcmp(str->char_array, cmpstr, length) == 0);
 } /* end matches_str_and_len */
 
 
 /* --------------------------------------------------------------------------
- * private function new_string_from_slice(str, offset, length)
+ * private function arena_allocate(shard, size)
  * --------------------------------------------------------------------------
- * Allocates and returns a new string object.  The string is initialised with
- * a slice of str starting at offset and ending at offset+length.
- * Returns NULL if allocation failed.
+ * Allocates size bytes from the current arena slab of shard and returns a
+ * pointer to the allocated space.  A new slab is allocated when the current
+ * slab does not have enough space left.  Returns NULL if allocation failed.
  *
  * pre-conditions:
- * o  parameter str must not be NULL upon entry (NOT GUARDED)
+ * o  repository must not be initialised in heap mode (NOT GUARDED)
  *
  * post-conditions:
- * o  newly allocated, initalised and retained string object is returned
+ * o  pointer to size bytes of aligned space within a slab is returned
  *
  * error-conditions:
- * o  if allocation fails, no operation is carried out, NULL is returned
+ * o  if slab allocation fails, no operation is carried out, NULL is returned
  * ----------------------------------------------------------------------- */
 
-static m2c_string_t new_string_from_slice
-  (char *str, uint_t offset, uint_t length) {
+static void *arena_allocate (m2c_string_shard_t shard, size_t size) {
   
-  m2c_string_t new_string;
-  uint_t source_index, target_index;
+  m2c_string_slab_t this_slab, new_slab;
+  size_t slab_size;
+  void *space;
   
-  /* allocate new string object */
-  new_string = malloc(sizeof(m2c_string_struct_t) + length + 1);
+  /* round size up to alignment */
+  size = (size + M2C_STRING_ARENA_ALIGNMENT - 1) &
+    ~(M2C_STRING_ARENA_ALIGNMENT - 1);
+  
+  this_slab = shard->slab;
+  
+  /* allocate from current slab if space is left */
+  if ((this_slab != NULL) && (this_slab->size - this_slab->used >= size)) {
+    space = &this_slab->data[this_slab->used];
+    this_slab->used = this_slab->used + size;
+    return space;
+  } /* end if */
   
-  /* check allocation, bail out on failure */
-  if /* allocation failed */ (new_string == NULL) {
+  /* large objects get a slab of their own */
+  if (size > M2C_STRING_ARENA_SLAB_SIZE / 4) {
+    slab_size = size;
+  }
+  else {
+    slab_size = M2C_STRING_ARENA_SLAB_SIZE;
+  } /* end if */
+  
+  new_slab =
+    m2c_alloc(M2C_ALLOC_STRINGS, sizeof(m2c_string_slab_s) + slab_size);
+  
+  /* bail out if allocation failed */
+  if (new_slab == NULL) {
     return NULL;
   } /* end if */
-    
-  /* initialise */
-  new_string->ref_count = 1;
-  new_string->length = length;
   
-  /* copy slice */
-  target_index = 0;
-  source_index = offset;
-  while (target_index < length) {
-    new_string->char_array[target_index] = str[source_index];
-    target_index++;
-    source_index++;
-  } /* end while */
+  new_slab->size = slab_size;
+  new_slab->used = size;
   
-  /* terminate character array */
-  new_string->char_array[target_index] = ASCII_NUL;
+  /* a dedicated slab is linked behind the current slab to keep using it */
+  if ((slab_size == size) && (this_slab != NULL)) {
+    new_slab->next = this_slab->next;
+    this_slab->next = new_slab;
+  }
+  else {
+    new_slab->next = this_slab;
+    shard->slab = new_slab;
+  } /* end if */
   
-  return new_string;
-} /* end new_string_from_slice */
+  return &new_slab->data[0];
+} /* end arena_allocate */
 
 
 /* --------------------------------------------------------------------------
- * private function new_string_by_appending(str, append_str, len, len2)
+ * private function grow_shard(shard, new_capacity)
  * --------------------------------------------------------------------------
- * Allocates and returns a new string object.  The string is initialised with
- * the concatenation product of str and append_str.
- * Returns NULL if allocation failed.
+ * Rehashes all entries of shard into a new slot table of the given
+ * capacity, dropping removed slots.  If shard has no slot table yet, an
+ * empty table is allocated.  Returns true on success.  Returns false and
+ * leaves shard unchanged if allocation failed.
  *
  * pre-conditions:
- * o  parameters str and append_str must not be NULL upon entry (NOT GUARDED)
+ * o  shard must be locked by the caller in concurrent mode (NOT GUARDED)
+ * o  new_capacity must be a power of two larger than entry_count
  *
  * post-conditions:
- * o  newly allocated, initalised and retained string object is returned
+ * o  shard holds all its entries in a table of new_capacity slots
  *
  * error-conditions:
- * o  if allocation fails, no operation is carried out, NULL is returned
+ * o  if allocation fails, no operation is carried out, false is returned
  * ----------------------------------------------------------------------- */
 
-static m2c_string_t new_string_by_appending
-  (char *str, char *append_str, uint_t str_len, uint_t append_str_len) {
-  
-  m2c_string_t new_string;
-  uint_t source_index, target_index, length;
+static bool grow_shard (m2c_string_shard_t shard, uint_t new_capacity) {
   
-  length = str_len + append_str_len;
+  m2c_string_repo_slot_s *new_slot;
+  uint_t index, new_index, mask;
+  m2c_string_t this_string;
   
-  /* allocate new dynamic string */
-  new_string = malloc(sizeof(m2c_string_struct_t) + length + 1);
+  new_slot = m2c_alloc_zeroed
+    (M2C_ALLOC_STRINGS, new_capacity, sizeof(m2c_string_repo_slot_s));
   
-  /* bail if allocation failed */
-  if (new_string == NULL) {
-    return NULL;
+  /* bail out if allocation failed */
+  if (new_slot == NULL) {
+    return false;
   } /* end if */
+  
+  /* move entries of an existing table, using their stored keys */
+  if (shard->slot != NULL) {
+    mask = new_capacity - 1;
+    for (index = 0; index < shard->capacity; index++) {
+      this_string = shard->slot[index].str;
       
-  /* initialise */
-  new_string->ref_count = 1;
-  new_string->length = length;
+      if ((this_string != NULL) && (this_string != REMOVED_SLOT)) {
+        new_index = shard->slot[index].key & mask;
+        while (new_slot[new_index].str != NULL) {
+          new_index = (new_index + 1) & mask;
+        } /* end while */
+        new_slot[new_index] = shard->slot[index];
+      } /* end if */
+    } /* end for */
+    
+    M2C_TRACE_STRING_GROW(shard->capacity, new_capacity);
+    
+    m2c_dealloc(M2C_ALLOC_STRINGS, shard->slot,
+      shard->capacity * sizeof(m2c_string_repo_slot_s));
+  } /* end if */
   
-  target_index = 0;
+  shard->slot = new_slot;
+  shard->capacity = new_capacity;
+  shard->removed_count = 0;
   
-  /* copy str */
-  source_index = 0;
-  while (target_index < str_len) {
-    new_string->char_array[target_index] = str[source_index];
-    target_index++;
-    source_index++;
-  } /* end while */
+  return true;
+} /* end grow_shard */
+
+
+/* --------------------------------------------------------------------------
+ * private function remove_repo_entry(str)
+ * --------------------------------------------------------------------------
+ * Removes the repository entry for str, marking its slot as removed.
+ *
+ * pre-conditions:
+ * o  parameter str must not be NULL upon entry (NOT GUARDED)
+ *
+ * post-conditions:
+ * o  if an entry for str exists, it is removed
+ *
+ * error-conditions:
+ * o  if no entry for str exists, no operation is carried out
+ * ----------------------------------------------------------------------- */
+
+static void remove_repo_entry (m2c_string_t str) {
   
-  /* copy append_str */
-  source_index = 0;
-  while (target_index < append_str_len) {
-    new_string->char_array[target_index] = append_str[source_index];
-    target_index++;
-    source_index++;
-  } /* end while */
+  m2c_string_shard_t shard;
+  uint_t index, mask;
+  m2c_hash_t key;
+  
+  if (repository == NULL) {
+    return;
+  } /* end if */
   
-  /* terminate character array */
-  new_string->char_array[target_index] = ASCII_NUL;
+  key = key_for_chars(str->char_array, str->length);
+  shard = SHARD_FOR_KEY(key);
   
-  return new_string;
-} /* end new_string_by_appending */
+  /* probe from home slot, entries are identified by address */
+  mask = shard->capacity - 1;
+  index = key & mask;
+  
+  while (shard->slot[index].str != NULL) {
+    if (shard->slot[index].str == str) {
+      shard->slot[index].str = REMOVED_SLOT;
+      shard->entry_count--;
+      shard->removed_count++;
+      return;
+    } /* end if */
+    
+    index = (index + 1) & mask;
+  } /* end while */
+  
+  return;
+} /* end remove_repo_entry */
 
 
 /* --------------------------------------------------------------------------
- * private function new_repo_entry(str, key)
+ * private function add_chars_to_hasher(hasher, chars, length)
  * --------------------------------------------------------------------------
- * Allocates and returns a new repository entry, initialised with str and
- * key.  Returns NULL if allocation failed.
+ * Appends the character sequence of the given length at chars to the
+ * sequence represented by hasher.  Characters are hashed eight at a time,
+ * each word being combined with the state by a multiply and xor-shift step.
+ * Characters that do not complete a word are kept pending in hasher.
  *
  * pre-conditions:
- * o  parameter str must not be NULL upon entry (NOT GUARDED)
+ * o  parameters hasher and chars must not be NULL upon entry (NOT GUARDED)
  *
  * post-conditions:
- * o  newly allocated and initalised entry is returned
+ * o  the characters are added to the hash calculation of hasher
  *
  * error-conditions:
- * o  if allocation fails, no operation is carried out, NULL is returned
- * --------------------------------------------------------------------------
- */
- 
-static m2c_string_repo_entry_t new_repo_entry (m2c_string_t str, m2c_hash_t key) {
+ * o  none
+ * ----------------------------------------------------------------------- */
+
+static inline void add_chars_to_hasher
+  (m2c_string_hasher_t *hasher, const char *chars, uint_t length) {
+  uint_t fill, count;
+  uint64_t word;
   
-  m2c_string_repo_entry_t new_entry;
+  fill = hasher->length % sizeof(uint64_t);
+  hasher->length = hasher->length + length;
   
-  /* allocate new entry */
-  new_entry = malloc(sizeof(m2c_string_repo_entry_s));
+  /* complete pending word */
+  if (fill > 0) {
+    count = sizeof(uint64_t) - fill;
+    if (count > length) {
+      count = length;
+    } /* end if */
+    
+    memcpy(&hasher->pending[fill], chars, count);
+    chars = chars + count;
+    length = length - count;
+    
+    if (fill + count < sizeof(uint64_t)) {
+      return;
+    } /* end if */
+    
+    memcpy(&word, hasher->pending, sizeof(uint64_t));
+    hasher->state = HASH_WORD(hasher->state, word);
+  } /* end if */
   
-  /* initialise new entry */
-  if (new_entry != NULL) {
-    new_entry->str = str;
-    new_entry->key = key;
-    new_entry->next = NULL;
+  /* full words */
+  while (length >= sizeof(uint64_t)) {
+    memcpy(&word, chars, sizeof(uint64_t));
+    hasher->state = HASH_WORD(hasher->state, word);
+    chars = chars + sizeof(uint64_t);
+    length = length - sizeof(uint64_t);
+  } /* end while */
+  
+  /* keep trailing characters pending */
+  if (length > 0) {
+    memcpy(hasher->pending, chars, length);
   } /* end if */
   
-  return new_entry;
-} /* end new_repo_entry */
+  return;
+} /* end add_chars_to_hasher */
 
 
 /* --------------------------------------------------------------------------
- * private function remove_repo_entry(str, key)
+ * private function value_of_hasher(hasher)
  * --------------------------------------------------------------------------
- * Removes the repository entry for str and key.
+ * Calculates and returns the hash key for the character sequence
+ * represented by hasher.  Pending characters are hashed as a zero padded
+ * word, then the length is combined with the state in a final avalanche.
  *
  * pre-conditions:
- * o  parameter str must not be NULL upon entry (NOT GUARDED)
+ * o  parameter hasher must not be NULL upon entry (NOT GUARDED)
  *
  * post-conditions:
- * o  if entry for str and key exists, entry is removed, str is returned
+ * o  hash key is returned
  *
  * error-conditions:
- * o  if entry for str and key does not exist, NULL is returned
+ * o  none
  * ----------------------------------------------------------------------- */
 
-static m2c_string_t remove_repo_entry (m2c_string_t str, m2c_hash_t key) {
+static inline m2c_hash_t value_of_hasher (const m2c_string_hasher_t *hasher) {
+  uint64_t state, word;
+  uint_t fill;
   
-  m2c_string_repo_entry_t this_entry, prev_entry;
-  uint_t index;
-  
-  /* determine bucket index */
-  index = key % repository->bucket_count;
+  state = hasher->state;
+  fill = hasher->length % sizeof(uint64_t);
   
-  /* check first entry of bucket for matching string */
-  this_entry = repository->bucket[index];
-  if (str == this_entry->str) {
-    repository->bucket[index] = this_entry->next;
-    repository->entry_count--;
-    free(this_entry);
-    return str;
+  /* pending characters */
+  if (fill > 0) {
+    word = 0;
+    memcpy(&word, hasher->pending, fill);
+    state = HASH_WORD(state, word);
   } /* end if */
   
-  /* move to next entry */
-  prev_entry = this_entry;
-  this_entry = this_entry->next;
-  
-  /* search remainder of bucket for matching string */
-  while (this_entry != NULL) {
-    if (str == this_entry->str) {
-      /* match, remove entry */
-      prev_entry->next = this_entry->next;
-      repository->entry_count--;
-      free(this_entry);
-      return str;
-    }
-    else /* no match */ {
-      /* move to next entry */
-      prev_entry = this_entry;
-      this_entry = this_entry->next;
-    } /* end if */
-  } /* end while */
+  /* final avalanche */
+  state = (state ^ ((uint64_t) hasher->length * HASH_MULTIPLIER)) *
+    HASH_MULTIPLIER;
   
-  /* no match in bucket */  
-  return NULL;
-} /* end remove_repo_entry */
+  return (m2c_hash_t) (state >> 32);
+} /* end value_of_hasher */
 
 
 /* --------------------------------------------------------------------------
- * private function key_for_string(str)
+ * private function key_for_chars(chars, length)
  * --------------------------------------------------------------------------
- * Calculates and returns the hash key for string str.
+ * Calculates and returns the hash key for the character sequence of the
+ * given length at chars.  The key is the same as that calculated by an
+ * m2c_string_hasher_t to which the sequence is passed in any number of
+ * pieces.
  *
  * pre-conditions:
- * o  parameter str must not be NULL upon entry (NOT GUARDED)
+ * o  parameter chars must not be NULL upon entry (NOT GUARDED)
  *
  * post-conditions:
  * o  hash key is returned
@@ -1084,24 +1422,15 @@ static m2c_string_t remove_repo_entry (m2c_string_t str, m2c_hash_t key) {
  * o  none
  * ----------------------------------------------------------------------- */
 
-static inline m2c_hash_t key_for_string (m2c_string_t str) {
-  m2c_hash_t key;
-  uint_t index;
-  char ch;
-  
-  index = 0;
-  ch = str->char_array[index];
-  key = HASH_INITIAL;
-  while (ch != ASCII_NUL) {
-    key = HASH_NEXT_CHAR(key, ch);
-    index++;
-    ch = str->char_array[index];
-  } /* end while */
-
-  key = HASH_FINAL(key);
+static inline m2c_hash_t key_for_chars (const char *chars, uint_t length) {
+  m2c_string_hasher_t hasher;
+  
+  hasher.state = HASH_SEED;
+  hasher.length = 0;
+  add_chars_to_hasher(&hasher, chars, length);
   
-  return key;  
-} /* end key_for_string */
+  return value_of_hasher(&hasher);
+} /* end key_for_chars */
 
 
-/* END OF FILE */
\ No newline at end of file
+/* END OF FILE */
@@ -75,12 +75,64 @@ typedef enum {
 } m2c_string_status_t;
 
 
+/* --------------------------------------------------------------------------
+ * type m2c_string_alloc_mode_t
+ * --------------------------------------------------------------------------
+ * Allocation modes for string objects of the string repository.
+ *
+ * M2C_STRING_ALLOC_HEAP :
+ *   each string object is allocated individually and deallocated when its
+ *   last reference is released.
+ * M2C_STRING_ALLOC_ARENA :
+ *   string objects are allocated from large slabs and live until the
+ *   repository is disposed of, when all slabs are deallocated in bulk.
+ * M2C_STRING_ALLOC_CONCURRENT :
+ *   like arena mode, but the repository is split into shards with a lock
+ *   each and may be shared by multiple threads.  String objects are interned
+ *   until the repository is disposed of, retain and release have no effect.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_STRING_ALLOC_HEAP,
+  M2C_STRING_ALLOC_ARENA,
+  M2C_STRING_ALLOC_CONCURRENT
+} m2c_string_alloc_mode_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_string_hash_t
+ * --------------------------------------------------------------------------
+ * Unsigned integer type representing the hash value of a character
+ * sequence as used by the string repository.
+ * ----------------------------------------------------------------------- */
+
+typedef uint32_t m2c_string_hash_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_string_hasher_t
+ * --------------------------------------------------------------------------
+ * Record type holding the state of an incremental hash calculation.  A
+ * character sequence may be passed to the hasher in pieces of any length,
+ * the resulting hash value is the same as if it was passed in one piece.
+ * Its fields are private to the string repository.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* state */ uint64_t state;
+  /* length */ uint_t length;
+  /* pending */ char pending[8];
+} m2c_string_hasher_t;
+
+
 /* --------------------------------------------------------------------------
  * procedure m2c_init_string_repository(size, status)
  * --------------------------------------------------------------------------
  * Allocates and initialises global string repository.  Parameter size
- * determines the number of buckets of the repository's internal hash table.
- * If size is zero, value M2C_STRING_REPO_DEFAULT_BUCKET_COUNT is used.
+ * determines the initial capacity of the repository's internal hash table,
+ * rounded up to the next power of two.  If size is zero, value
+ * M2C_STRING_REPO_DEFAULT_CAPACITY is used.  The table is allocated when
+ * the first string is entered and grows on demand.
  *
  * pre-conditions:
  * o  global repository must be uninitialised upon entry
@@ -103,6 +155,58 @@ void m2c_init_string_repository
   (uint_t size, m2c_string_status_t *status);
 
 
+/* --------------------------------------------------------------------------
+ * procedure m2c_init_string_repository_w_mode(size, mode, status)
+ * --------------------------------------------------------------------------
+ * Allocates and initialises global string repository with allocation mode
+ * mode.  Parameter size is interpreted as by m2c_init_string_repository().
+ *
+ * pre-conditions:
+ * o  global repository must be uninitialised upon entry
+ * o  parameter size may be zero upon entry
+ * o  parameter status may be NULL upon entry
+ *
+ * post-conditions:
+ * o  global string repository is allocated and intialised.
+ * o  M2C_STRING_STATUS_SUCCESS is passed back in status, unless NULL
+ *
+ * error-conditions:
+ * o  if repository has already been initialised upon entry,
+ *    no operation is carried out and M2C_STRING_STATUS_ALREADY_INITIALIZED
+ *    is passed back in status unless status is NULL
+ * o  if repository allocation failed, M2C_STRING_STATUS_ALLOCATION_FAILED
+ *    is passed back in status unless status is NULL
+ * ----------------------------------------------------------------------- */
+
+void m2c_init_string_repository_w_mode
+  (uint_t size, m2c_string_alloc_mode_t mode, m2c_string_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_dispose_string_repository(status)
+ * --------------------------------------------------------------------------
+ * Deallocates the global string repository together with all string
+ * objects stored in it.  In arena mode, the slabs holding the string
+ * objects are deallocated in bulk.
+ *
+ * pre-conditions:
+ * o  global repository must be initialised upon entry
+ * o  parameter status may be NULL upon entry
+ *
+ * post-conditions:
+ * o  global string repository and all its string objects are deallocated
+ * o  any string objects still held by clients become invalid
+ * o  M2C_STRING_STATUS_SUCCESS is passed back in status, unless NULL
+ *
+ * error-conditions:
+ * o  if repository has not been initialised upon entry,
+ *    no operation is carried out and M2C_STRING_STATUS_NOT_INITIALIZED
+ *    is passed back in status unless status is NULL
+ * ----------------------------------------------------------------------- */
+
+void m2c_dispose_string_repository (m2c_string_status_t *status);
+
+
 /* --------------------------------------------------------------------------
  * function m2c_get_string(str, status)
  * --------------------------------------------------------------------------
@@ -165,7 +269,103 @@ m2c_string_t m2c_get_string (char *str, m2c_string_status_t *status);
  * ----------------------------------------------------------------------- */
 
 m2c_string_t m2c_get_string_for_slice
-  (char *str, uint_t offset, uint_t length, m2c_string_status_t *status);
+  (const char *str, uint_t offset, uint_t length, m2c_string_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_string_hasher_init(hasher)
+ * --------------------------------------------------------------------------
+ * Initialises hasher for the calculation of a new hash value.
+ *
+ * pre-conditions:
+ * o  parameter hasher must not be NULL upon entry (NOT GUARDED)
+ *
+ * post-conditions:
+ * o  hasher represents the empty character sequence
+ *
+ * error-conditions:
+ * o  none
+ * ----------------------------------------------------------------------- */
+
+void m2c_string_hasher_init (m2c_string_hasher_t *hasher);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_string_hasher_add_chars(hasher, chars, length)
+ * --------------------------------------------------------------------------
+ * Appends the character sequence of the given length at chars to the
+ * sequence represented by hasher.
+ *
+ * pre-conditions:
+ * o  parameter hasher must not be NULL upon entry (NOT GUARDED)
+ * o  parameter chars must not be NULL upon entry (NOT GUARDED)
+ *
+ * post-conditions:
+ * o  the characters are added to the hash calculation of hasher
+ *
+ * error-conditions:
+ * o  none
+ * ----------------------------------------------------------------------- */
+
+void m2c_string_hasher_add_chars
+  (m2c_string_hasher_t *hasher, const char *chars, uint_t length);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_string_hasher_value(hasher)
+ * --------------------------------------------------------------------------
+ * Returns the hash value of the character sequence represented by hasher.
+ * Hasher is not modified and more characters may be added afterwards.
+ *
+ * pre-conditions:
+ * o  parameter hasher must not be NULL upon entry (NOT GUARDED)
+ *
+ * post-conditions:
+ * o  hash value is returned
+ *
+ * error-conditions:
+ * o  none
+ * ----------------------------------------------------------------------- */
+
+m2c_string_hash_t m2c_string_hasher_value (const m2c_string_hasher_t *hasher);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_get_string_for_slice_w_hash(str, offset, length, hash, status)
+ * --------------------------------------------------------------------------
+ * Returns a unique string object for a given slice of str like function
+ * m2c_get_string_for_slice(), but takes the hash value of the slice from
+ * parameter hash instead of calculating it.  The slice is neither hashed
+ * nor checked for control codes, thus a caller that hashes a lexeme while
+ * scanning it touches each character only once more, for comparison with
+ * a string object of the same hash value.
+ *
+ * pre-conditions:
+ * o  parameter str must not be NULL upon entry
+ * o  slice must be within range of str (NOT GUARDED)
+ * o  slice must not contain any control codes (NOT GUARDED)
+ * o  hash must be the hash value of the slice as calculated by an
+ *    m2c_string_hasher_t (NOT GUARDED)
+ *
+ * post-conditions:
+ * o  if a string object for the slice is present in the internal repository,
+ *    that string object is retrieved, retained and returned.
+ * o  if no string object for the slice is present in the repository, a new
+ *    string object with a copy of the slice is created, stored and returned.
+ * o  M2C_STRING_STATUS_SUCCESS is passed back in status, unless NULL
+ *
+ * error-conditions:
+ * o  if precondition #1 is not met, no operation is carried out,
+ *    NULL is returned and M2C_STRING_STATUS_INVALID_REFERENCE is
+ *    passed back in status, unless status is NULL
+ * o  if string object allocation failed, no operation is carried out,
+ *    NULL is returned and M2C_STRING_STATUS_ALLOCATION_FAILED is
+ *    passed back in status unless status is NULL
+ * ----------------------------------------------------------------------- */
+
+m2c_string_t m2c_get_string_for_slice_w_hash
+  (const char *str, uint_t offset, uint_t length,
+   m2c_string_hash_t hash, m2c_string_status_t *status);
 
 
 /* --------------------------------------------------------------------------
@@ -192,6 +392,9 @@ m2c_string_t m2c_get_string_for_slice
  * o  if any of str or append_str is NULL upon entry, no operation is
  *    carried out, NULL is returned and M2C_STRING_STATUS_INVALID_REFERENCE
  *    is passed back in status, unless NULL
+ * o  if the concatenation exceeds M2C_STRING_SIZE_LIMIT, no operation is
+ *    carried out, NULL is returned and M2C_STRING_STATUS_SIZE_LIMIT_EXCEEDED
+ *    is passed back in status, unless NULL
  * o  if no dynamic string object could be allocated, NULL is returned,
  *    and M2C_STRING_STATUS_ALLOCATION_FAILED is passed back in status,
  *    unless NULL
@@ -265,6 +468,7 @@ uint_t m2c_unique_string_count (void);
  *
  * post-conditions:
  * o  str's reference count is incremented.
+ * o  in concurrent mode, no operation is carried out
  *
  * error-conditions:
  * o  if str is not NULL upon entry, no operation is carried out
@@ -285,6 +489,8 @@ void m2c_string_retain (m2c_string_t str);
  * post-conditions:
  * o  if str's reference count is zero upon entry, str is deallocated
  * o  if str's reference count is not zero upon entry, it is decremented
+ * o  in arena mode, str is never deallocated individually
+ * o  in concurrent mode, no operation is carried out
  *
  * error-conditions:
  * o  if str is not NULL upon entry, no operation is carried out
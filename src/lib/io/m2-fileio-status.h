@@ -48,6 +48,12 @@ typedef enum {
   M2C_FILEIO_FILE_NOT_FOUND,
   M2C_FILEIO_ACCESS_DENIED,
   M2C_FILEIO_DEVICE_ERROR,
+  M2C_FILEIO_STATUS_INVALID_FILE,
+  M2C_FILEIO_STATUS_FOPEN_FAILED,
+  M2C_FILEIO_STATUS_READ_FAILED,
+  M2C_FILEIO_STATUS_WRITE_FAILED,
+  M2C_FILEIO_STATUS_ALLOCATION_FAILED,
+  M2C_FILEIO_STATUS_INVALID_FORMAT,
   /* ... */
 } m2c_fileio_status_t;
 
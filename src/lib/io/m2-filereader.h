@@ -38,6 +38,7 @@
 
 #include "m2-unique-string.h"
 
+#include <stddef.h>
 #include <stdbool.h>
 
 
@@ -53,6 +54,35 @@
 #define M2C_INFILE_MAX_COLUMNS 200
 
 
+/* --------------------------------------------------------------------------
+ * Memory mapping threshold
+ * --------------------------------------------------------------------------
+ * Source files whose size in bytes is equal to or larger than the threshold
+ * are memory mapped instead of being read into a heap allocated buffer,
+ * provided the host platform supports memory mapped files.
+ * --------------------------------------------------------------------------
+ */
+
+#define M2C_INFILE_MMAP_THRESHOLD (64 * 1024)
+
+
+/* --------------------------------------------------------------------------
+ * Streaming threshold, chunk size and chunk count
+ * --------------------------------------------------------------------------
+ * Source files whose size in bytes is equal to or larger than the streaming
+ * threshold are neither buffered nor mapped but read chunk by chunk into a
+ * window of M2C_INFILE_STREAM_CHUNK_COUNT chunks, thereby bounding memory
+ * use per open source file regardless of file size.
+ * --------------------------------------------------------------------------
+ */
+
+#define M2C_INFILE_STREAM_THRESHOLD (16 * 1024 * 1024)
+
+#define M2C_INFILE_STREAM_CHUNK_SIZE (64 * 1024)
+
+#define M2C_INFILE_STREAM_CHUNK_COUNT 4
+
+
 /* --------------------------------------------------------------------------
  * opaque type m2c_infile_t
  * --------------------------------------------------------------------------
@@ -77,11 +107,47 @@ typedef enum {
   M2C_INFILE_STATUS_FILE_ACCESS_DENIED,
   M2C_INFILE_STATUS_ALLOCATION_FAILED,
   M2C_INFILE_STATUS_FILE_EMPTY,
+  M2C_INFILE_STATUS_FILE_TOO_LARGE,
   M2C_INFILE_STATUS_ATTEMPT_TO_READ_PAST_EOF,
   M2C_INFILE_STATUS_IO_SUBSYSTEM_ERROR
 } m2c_infile_status_t;
 
 
+/* --------------------------------------------------------------------------
+ * type m2c_infile_run_t
+ * --------------------------------------------------------------------------
+ * Character classes for bulk consumption by function m2c_consume_run().
+ *
+ * M2C_INFILE_RUN_COMMENT_TEXT :
+ *   printable characters, TAB and LF, except '*' and '('
+ * M2C_INFILE_RUN_LINE_COMMENT :
+ *   printable characters and TAB
+ * M2C_INFILE_RUN_IDENT_CHARS :
+ *   letters and digits
+ * M2C_INFILE_RUN_UPPER_CHARS :
+ *   uppercase letters
+ * M2C_INFILE_RUN_QUOTED_TEXT :
+ *   printable characters, except the given delimiter and backslash
+ * M2C_INFILE_RUN_DECIMAL_DIGITS :
+ *   digits '0' to '9'
+ * M2C_INFILE_RUN_HEX_DIGITS :
+ *   digits '0' to '9' and uppercase letters 'A' to 'F'
+ *
+ * Characters with codes of 128 and above are printable for this purpose.
+ * --------------------------------------------------------------------------
+ */
+
+typedef enum {
+  M2C_INFILE_RUN_COMMENT_TEXT,
+  M2C_INFILE_RUN_LINE_COMMENT,
+  M2C_INFILE_RUN_IDENT_CHARS,
+  M2C_INFILE_RUN_UPPER_CHARS,
+  M2C_INFILE_RUN_QUOTED_TEXT,
+  M2C_INFILE_RUN_DECIMAL_DIGITS,
+  M2C_INFILE_RUN_HEX_DIGITS
+} m2c_infile_run_t;
+
+
 /* --------------------------------------------------------------------------
  * procedure m2c_open_infile(infile, filename, status)
  * --------------------------------------------------------------------------
@@ -94,7 +160,7 @@ typedef enum {
  *
  * post-conditions:
  * o  pointer to newly allocated and opened file is passed back in infile
- * o  line and column counters of the newly allocated infile are set to 1
+ * o  line counter of the newly allocated infile is set to 1
  * o  M2C_INFILE_STATUS_SUCCESS is passed back in status, unless NULL
  *
  * error-conditions:
@@ -104,6 +170,8 @@ typedef enum {
  *    status M2C_INFILE_STATUS_FILE_NOT_FOUND is returned
  * o  if the file represented by filename cannot be accessed
  *    status M2C_INFILE_STATUS_FILE_ACCESS_DENIED is returned
+ * o  if the size of the file exceeds the address space of the host
+ *    status M2C_INFILE_STATUS_FILE_TOO_LARGE is returned
  * o  if no infile object could be allocated
  *    status M2C_INFILE_STATUS_ALLOCATION_FAILED is returned
  * --------------------------------------------------------------------------
@@ -113,11 +181,45 @@ m2c_infile_t m2c_open_infile
   (m2c_string_t filename, m2c_infile_status_t *status);
 
 
+/* --------------------------------------------------------------------------
+ * procedure m2c_open_infile_from_buffer(name, buffer, length, status)
+ * --------------------------------------------------------------------------
+ * Allocates a new object of type m2c_infile_t and associates it with the
+ * caller owned source text in buffer of the given length.  The buffer is
+ * NOT copied.  It must remain valid and unmodified until the infile object
+ * has been closed.  Parameter name is used in place of a filename.
+ *
+ * pre-conditions:
+ * o  parameters name and buffer must not be NULL upon entry
+ * o  parameter status may be NULL
+ *
+ * post-conditions:
+ * o  pointer to newly allocated infile is returned
+ * o  line counter of the newly allocated infile is set to 1
+ * o  M2C_INFILE_STATUS_SUCCESS is passed back in status, unless NULL
+ *
+ * error-conditions:
+ * o  if name or buffer is NULL upon entry, no operation is carried out
+ *    and status M2C_INFILE_STATUS_INVALID_REFERENCE is returned
+ * o  if length is zero upon entry, no operation is carried out
+ *    and status M2C_INFILE_STATUS_FILE_EMPTY is returned
+ * o  if no infile object could be allocated
+ *    status M2C_INFILE_STATUS_ALLOCATION_FAILED is returned
+ * --------------------------------------------------------------------------
+ */
+
+m2c_infile_t m2c_open_infile_from_buffer
+  (m2c_string_t name,
+   const char *buffer,
+   size_t length,
+   m2c_infile_status_t *status);
+
+
 /* --------------------------------------------------------------------------
  * function m2c_read_char(infile)
  * --------------------------------------------------------------------------
  * Reads the lookahead character from infile, advancing the current reading
- * position, updating line and column counter and returns its character code.
+ * position, updating the line counter and returns its character code.
  * Returns EOF if the lookahead character lies beyond the end of infile.
  *
  * pre-conditions:
@@ -125,7 +227,7 @@ m2c_infile_t m2c_open_infile
  *
  * post-conditions:
  * o  character code of lookahead character or EOF is returned
- * o  current reading position and line and column counters are updated
+ * o  current reading position and line counter are updated
  * o  file status is set to M2C_INFILE_STATUC_SUCCESS
  *
  * error-conditions:
@@ -181,6 +283,44 @@ void m2c_mark_lexeme (m2c_infile_t infile);
 m2c_string_t m2c_read_marked_lexeme (m2c_infile_t infile);
 
 
+/* --------------------------------------------------------------------------
+ * function m2c_skip_marked_lexeme(infile, length)
+ * --------------------------------------------------------------------------
+ * Discards the lexeme marked using procedure m2c_mark_lexeme() without
+ * creating a string object for it.  Returns a pointer to the character
+ * sequence of the lexeme within the input buffer and passes its length
+ * back in length.  The sequence is not NUL terminated, the pointer becomes
+ * invalid when the next character is consumed.  Returns NULL if the lexeme
+ * is no longer held in the input buffer.
+ *
+ * pre-conditions:
+ * o  parameter infile must not be NULL upon entry
+ *
+ * post-conditions:
+ * o  marked position is cleared
+ * o  pointer to the lexeme in the input buffer is returned
+ *
+ * error-conditions:
+ * o  if no marker has been set or if the marked character has not been
+ *    consumed, NULL is returned and zero is passed back in length
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_skip_marked_lexeme (m2c_infile_t infile, uint_t *length);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_marked_chars(infile, length)
+ * --------------------------------------------------------------------------
+ * Returns a pointer to the characters consumed since the lexeme marker was
+ * set, within the input buffer, and passes their number back in length.
+ * The marker is not cleared.  The pointer is only valid until the next
+ * character is consumed.  Returns NULL and passes back zero if no marker
+ * has been set, and NULL if the marked characters have been evicted.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_marked_chars (m2c_infile_t infile, uint_t *length);
+
+
 /* --------------------------------------------------------------------------
  * function m2c_infile_source_for_line(infile, line)
  * --------------------------------------------------------------------------
@@ -205,7 +345,7 @@ m2c_string_t m2c_infile_source_for_line (m2c_infile_t infile, uint_t line);
  * function m2c_consume_char(infile)
  * --------------------------------------------------------------------------
  * Consumes the current lookahead character, advancing the current reading
- * position, updating line and column counter and returns the character code
+ * position, updating the line counter and returns the character code
  * of the new lookahead character that follows the consumed character.
  * Returns EOF if the lookahead character lies beyond the end of infile.
  *
@@ -214,7 +354,7 @@ m2c_string_t m2c_infile_source_for_line (m2c_infile_t infile, uint_t line);
  *
  * post-conditions:
  * o  character code of lookahead character or EOF is returned
- * o  current reading position and line and column counters are updated
+ * o  current reading position and line counter are updated
  * o  file status is set to M2C_INFILE_STATUC_SUCCESS
  *
  * error-conditions:
@@ -238,7 +378,7 @@ int m2c_consume_char (m2c_infile_t infile);
  *
  * post-conditions:
  * o  character code of lookahead character or EOF is returned
- * o  current reading position and line and column counters are NOT updated
+ * o  current reading position and line counter are NOT updated
  * o  file status is set to M2C_INFILE_STATUC_SUCCESS
  *
  * error-conditions:
@@ -262,7 +402,7 @@ int m2c_next_char (m2c_infile_t infile);
  *
  * post-conditions:
  * o  character code of second lookahead character or EOF is returned
- * o  current reading position and line and column counters are NOT updated
+ * o  current reading position and line counter are NOT updated
  * o  file status is set to M2C_INFILE_STATUC_SUCCESS
  *
  * error-conditions:
@@ -274,6 +414,34 @@ int m2c_next_char (m2c_infile_t infile);
 int m2c_la2_char (m2c_infile_t infile);
 
 
+/* --------------------------------------------------------------------------
+ * function m2c_consume_run(infile, run, delimiter)
+ * --------------------------------------------------------------------------
+ * Consumes the longest sequence of characters starting at the lookahead
+ * character that belong to character class run and returns the number of
+ * bytes consumed.  Parameter delimiter is only used with character class
+ * M2C_INFILE_RUN_QUOTED_TEXT and ignored otherwise.  The sequence is
+ * scanned in bulk, using vector instructions where the host supports them.
+ *
+ * pre-conditions:
+ * o  parameter infile must not be NULL upon entry
+ *
+ * post-conditions:
+ * o  the sequence is consumed and its length is returned
+ * o  current reading position and line counter are updated
+ * o  the first character that does not belong to run becomes lookahead
+ * o  file status is set to M2C_INFILE_STATUC_SUCCESS
+ *
+ * error-conditions:
+ * o  if infile is NULL upon entry, no operation is carried out
+ *    and zero is returned
+ * --------------------------------------------------------------------------
+ */
+
+size_t m2c_consume_run
+  (m2c_infile_t infile, m2c_infile_run_t run, char delimiter);
+
+
 /* --------------------------------------------------------------------------
  * function m2c_infile_filename(infile)
  * --------------------------------------------------------------------------
@@ -305,6 +473,21 @@ m2c_infile_status_t m2c_infile_status (m2c_infile_t infile);
 bool m2c_infile_eof (m2c_infile_t infile);
 
 
+/* --------------------------------------------------------------------------
+ * function m2c_infile_is_validated(infile)
+ * --------------------------------------------------------------------------
+ * Returns true if the entire source of infile has been verified to consist
+ * of printable ASCII characters, TAB, LF and CR only, returns false if it
+ * contains any other character or if it has not been verified.  Sources are
+ * verified in a single pass when they are opened, except for streamed
+ * files which are never verified.  A lexer may omit its checks for illegal
+ * characters on validated sources.
+ * --------------------------------------------------------------------------
+ */
+
+bool m2c_infile_is_validated (m2c_infile_t infile);
+
+
 /* --------------------------------------------------------------------------
  * function m2c_infile_current_line(infile)
  * --------------------------------------------------------------------------
@@ -318,13 +501,60 @@ unsigned int m2c_infile_current_line (m2c_infile_t infile);
 /* --------------------------------------------------------------------------
  * function m2c_infile_current_column(infile)
  * --------------------------------------------------------------------------
- * Returns the current column counter of infile.
+ * Returns the current column counter of infile.  The column is not counted
+ * while reading, it is derived from the start offset of the current line.
  * --------------------------------------------------------------------------
  */
 
 unsigned int m2c_infile_current_column (m2c_infile_t infile);
 
 
+/* --------------------------------------------------------------------------
+ * function m2c_infile_current_offset(infile)
+ * --------------------------------------------------------------------------
+ * Returns the byte offset of the current reading position of infile.  Line
+ * and column of an offset are obtained by m2c_infile_position_for_offset().
+ * --------------------------------------------------------------------------
+ */
+
+size_t m2c_infile_current_offset (m2c_infile_t infile);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_infile_line_count(infile)
+ * --------------------------------------------------------------------------
+ * Returns the number of lines of infile whose start offsets have been
+ * determined so far.
+ * --------------------------------------------------------------------------
+ */
+
+uint_t m2c_infile_line_count (m2c_infile_t infile);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_infile_position_for_offset(infile, offset, line, column)
+ * --------------------------------------------------------------------------
+ * Determines line and column of the character at the given byte offset of
+ * infile, passes them back in out-parameters line and column and returns
+ * true.  Returns false if offset lies beyond the end of infile.
+ *
+ * pre-conditions:
+ * o  parameter infile must not be NULL upon entry
+ * o  parameters line and column must not be NULL upon entry
+ *
+ * post-conditions:
+ * o  line and column of offset are passed back in line and column
+ *
+ * error-conditions:
+ * o  if any pre-condition is not met or offset lies beyond the end of
+ *    infile, no operation is carried out and false is returned
+ * --------------------------------------------------------------------------
+ */
+
+bool m2c_infile_position_for_offset
+  (m2c_infile_t infile, size_t offset, uint_t *line, uint_t *column);
+
+
 /* --------------------------------------------------------------------------
  * procedure m2c_close_infile(file, status)
  * --------------------------------------------------------------------------
@@ -0,0 +1,584 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015-2016 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * m2-outsink.c
+ *
+ * Implementation of M2C buffered output sinks.
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute and/or modify it under the
+ * terms of the GNU Lesser General Public License (LGPL) either version 2.1
+ * or at your choice version 3 as published by the Free Software Foundation.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#include "m2-outsink.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* --------------------------------------------------------------------------
+ * Direct output to file descriptors
+ * --------------------------------------------------------------------------
+ * POSIX hosts write file sinks directly to their file descriptors using
+ * vectored writes.  Other hosts write all sinks through stdio.
+ * ----------------------------------------------------------------------- */
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#define M2C_OUTSINK_DIRECT 1
+#else
+#define M2C_OUTSINK_DIRECT 0
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_outsink_struct_t
+ * --------------------------------------------------------------------------
+ * record type representing an output sink.  Field fd holds the file
+ * descriptor of a direct file sink, otherwise -1 and field fptr holds the
+ * stdio stream that is written to.  A memory sink has neither, its output
+ * is moved from the buffer to the heap allocated array memory, which holds
+ * memory_length characters.  Field length holds the number of buffered
+ * characters.
+ * ----------------------------------------------------------------------- */
+
+struct m2c_outsink_struct_t {
+  /* fd */ int fd;
+  /* fptr */ FILE *fptr;
+  /* is_console */ bool is_console;
+  /* is_memory */ bool is_memory;
+  /* memory */ char *memory;
+  /* memory_length */ uint_t memory_length;
+  /* memory_capacity */ uint_t memory_capacity;
+  /* length */ uint_t length;
+  /* chars_written */ uint_t chars_written;
+  /* status */ m2c_fileio_status_t status;
+  /* buffer */ char buffer[M2C_OUTSINK_BUFFER_SIZE];
+};
+
+typedef struct m2c_outsink_struct_t m2c_outsink_struct_t;
+
+
+/* --------------------------------------------------------------------------
+ * Forward declarations
+ * ----------------------------------------------------------------------- */
+
+static m2c_outsink_t new_sink (m2c_fileio_status_t *status);
+
+static void write_out
+  (m2c_outsink_t sink, const char *chars, uint_t length);
+
+static void write_to_memory
+  (m2c_outsink_t sink, const char *chars, uint_t length);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_outsink_open(path, status)
+ * --------------------------------------------------------------------------
+ * Creates or truncates the file at path and returns a new output sink that
+ * writes to it, or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2c_outsink_t m2c_outsink_open
+  (const char *path, m2c_fileio_status_t *status) {
+
+  m2c_outsink_t sink;
+
+  sink = new_sink(status);
+
+  if (sink == NULL) {
+    return NULL;
+  } /* end if */
+
+#if (M2C_OUTSINK_DIRECT)
+  sink->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+
+  if (sink->fd < 0) {
+    free(sink);
+    SET_STATUS(status, M2C_FILEIO_STATUS_FOPEN_FAILED);
+    return NULL;
+  } /* end if */
+#else
+  sink->fptr = fopen(path, "w");
+
+  if (sink->fptr == NULL) {
+    free(sink);
+    SET_STATUS(status, M2C_FILEIO_STATUS_FOPEN_FAILED);
+    return NULL;
+  } /* end if */
+#endif
+
+  return sink;
+} /* end m2c_outsink_open */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_outsink_open_console(status)
+ * --------------------------------------------------------------------------
+ * Returns a new output sink that writes to the console, or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2c_outsink_t m2c_outsink_open_console (m2c_fileio_status_t *status) {
+
+  m2c_outsink_t sink;
+
+  sink = new_sink(status);
+
+  if (sink != NULL) {
+    sink->fptr = stdout;
+    sink->is_console = true;
+  } /* end if */
+
+  return sink;
+} /* end m2c_outsink_open_console */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_outsink_open_memory(status)
+ * --------------------------------------------------------------------------
+ * Returns a new output sink that collects its output in memory, or NULL on
+ * failure.
+ * ----------------------------------------------------------------------- */
+
+m2c_outsink_t m2c_outsink_open_memory (m2c_fileio_status_t *status) {
+
+  m2c_outsink_t sink;
+
+  sink = new_sink(status);
+
+  if (sink != NULL) {
+    sink->is_memory = true;
+  } /* end if */
+
+  return sink;
+} /* end m2c_outsink_open_memory */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_outsink_write_chars(sink, chars, length)
+ * --------------------------------------------------------------------------
+ * Writes length characters starting at chars to sink.
+ * ----------------------------------------------------------------------- */
+
+void m2c_outsink_write_chars
+  (m2c_outsink_t sink, const char *chars, uint_t length) {
+
+  uint_t space;
+
+  if (sink->status != M2C_FILEIO_STATUS_SUCCESS) {
+    return;
+  } /* end if */
+
+  sink->chars_written = sink->chars_written + length;
+  space = M2C_OUTSINK_BUFFER_SIZE - sink->length;
+
+  /* common case, chars fit into the buffer */
+  if (length <= space) {
+    memcpy(&sink->buffer[sink->length], chars, length);
+    sink->length = sink->length + length;
+    return;
+  } /* end if */
+
+  /* chars larger than the buffer are written along with the buffer */
+  if (length >= M2C_OUTSINK_BUFFER_SIZE) {
+    write_out(sink, chars, length);
+    return;
+  } /* end if */
+
+  /* fill up the buffer, write it and buffer the remainder */
+  memcpy(&sink->buffer[sink->length], chars, space);
+  sink->length = M2C_OUTSINK_BUFFER_SIZE;
+  write_out(sink, NULL, 0);
+
+  memcpy(sink->buffer, chars + space, length - space);
+  sink->length = length - space;
+
+} /* end m2c_outsink_write_chars */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_outsink_write_str(sink, str)
+ * --------------------------------------------------------------------------
+ * Writes NUL terminated string str to sink.
+ * ----------------------------------------------------------------------- */
+
+void m2c_outsink_write_str (m2c_outsink_t sink, const char *str) {
+
+  if (str != NULL) {
+    m2c_outsink_write_chars(sink, str, (uint_t) strlen(str));
+  } /* end if */
+
+} /* end m2c_outsink_write_str */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_outsink_write_char(sink, ch)
+ * --------------------------------------------------------------------------
+ * Writes character ch to sink.
+ * ----------------------------------------------------------------------- */
+
+void m2c_outsink_write_char (m2c_outsink_t sink, char ch) {
+
+  if (sink->length < M2C_OUTSINK_BUFFER_SIZE) {
+    sink->buffer[sink->length] = ch;
+    sink->length++;
+    sink->chars_written++;
+  }
+  else {
+    m2c_outsink_write_chars(sink, &ch, 1);
+  } /* end if */
+
+} /* end m2c_outsink_write_char */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_outsink_write_uint(sink, value)
+ * --------------------------------------------------------------------------
+ * Writes the decimal representation of value to sink.
+ * ----------------------------------------------------------------------- */
+
+#define MAX_UINT_DIGITS 20
+
+void m2c_outsink_write_uint (m2c_outsink_t sink, uint_t value) {
+
+  char digits[MAX_UINT_DIGITS];
+  uint_t index;
+
+  /* convert from the least significant digit backwards */
+  index = MAX_UINT_DIGITS;
+  do {
+    index--;
+    digits[index] = (char) ('0' + (value % 10));
+    value = value / 10;
+  } while (value > 0);
+
+  m2c_outsink_write_chars(sink, &digits[index], MAX_UINT_DIGITS - index);
+
+} /* end m2c_outsink_write_uint */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_outsink_write_escaped(sink, str)
+ * --------------------------------------------------------------------------
+ * Writes str to sink with a backslash before each double quote and
+ * backslash.
+ * ----------------------------------------------------------------------- */
+
+void m2c_outsink_write_escaped (m2c_outsink_t sink, const char *str) {
+
+  const char *run;
+
+  if (str == NULL) {
+    return;
+  } /* end if */
+
+  /* write runs of characters that need no escaping in one go */
+  run = str;
+  while (*str != ASCII_NUL) {
+    if ((*str == '"') || (*str == '\\')) {
+      m2c_outsink_write_chars(sink, run, (uint_t) (str - run));
+      m2c_outsink_write_char(sink, '\\');
+      run = str;
+    } /* end if */
+    str++;
+  } /* end while */
+
+  m2c_outsink_write_chars(sink, run, (uint_t) (str - run));
+
+} /* end m2c_outsink_write_escaped */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_outsink_write_sink(sink, source)
+ * --------------------------------------------------------------------------
+ * Writes all output collected so far by memory sink source to sink.
+ * ----------------------------------------------------------------------- */
+
+void m2c_outsink_write_sink (m2c_outsink_t sink, m2c_outsink_t source) {
+
+  if ((source == NULL) || (NOT(source->is_memory))) {
+    return;
+  } /* end if */
+
+  /* a failed part makes the whole output fail */
+  if (source->status != M2C_FILEIO_STATUS_SUCCESS) {
+    if (sink->status == M2C_FILEIO_STATUS_SUCCESS) {
+      sink->status = source->status;
+    } /* end if */
+    return;
+  } /* end if */
+
+  if (source->memory_length > 0) {
+    m2c_outsink_write_chars(sink, source->memory, source->memory_length);
+  } /* end if */
+
+  m2c_outsink_write_chars(sink, source->buffer, source->length);
+
+} /* end m2c_outsink_write_sink */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_outsink_flush(sink)
+ * --------------------------------------------------------------------------
+ * Writes any buffered output of sink.
+ * ----------------------------------------------------------------------- */
+
+void m2c_outsink_flush (m2c_outsink_t sink) {
+
+  if ((sink->status == M2C_FILEIO_STATUS_SUCCESS) && (sink->length > 0)) {
+    write_out(sink, NULL, 0);
+  } /* end if */
+
+  if ((sink->is_console) && (sink->status == M2C_FILEIO_STATUS_SUCCESS)) {
+    fflush(sink->fptr);
+  } /* end if */
+
+} /* end m2c_outsink_flush */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_outsink_chars_written(sink)
+ * --------------------------------------------------------------------------
+ * Returns the number of characters written to sink so far.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_outsink_chars_written (m2c_outsink_t sink) {
+
+  return sink->chars_written;
+
+} /* end m2c_outsink_chars_written */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_outsink_status(sink)
+ * --------------------------------------------------------------------------
+ * Returns the status of sink.
+ * ----------------------------------------------------------------------- */
+
+m2c_fileio_status_t m2c_outsink_status (m2c_outsink_t sink) {
+
+  return sink->status;
+
+} /* end m2c_outsink_status */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_outsink_close(sinkptr)
+ * --------------------------------------------------------------------------
+ * Writes any buffered output, closes the file of the sink unless it is the
+ * console, deallocates the sink and returns its status.
+ * ----------------------------------------------------------------------- */
+
+m2c_fileio_status_t m2c_outsink_close (m2c_outsink_t *sinkptr) {
+
+  m2c_fileio_status_t status;
+  m2c_outsink_t sink;
+
+  if ((sinkptr == NULL) || (*sinkptr == NULL)) {
+    return M2C_FILEIO_STATUS_INVALID_FILE;
+  } /* end if */
+
+  sink = *sinkptr;
+  m2c_outsink_flush(sink);
+  status = sink->status;
+
+#if (M2C_OUTSINK_DIRECT)
+  if ((sink->fd >= 0) && (close(sink->fd) != 0)) {
+    status = M2C_FILEIO_STATUS_WRITE_FAILED;
+  } /* end if */
+#endif
+
+  if ((sink->fptr != NULL) && (!sink->is_console) &&
+      (fclose(sink->fptr) != 0)) {
+    status = M2C_FILEIO_STATUS_WRITE_FAILED;
+  } /* end if */
+
+  free(sink->memory);
+  free(sink);
+  *sinkptr = NULL;
+
+  return status;
+} /* end m2c_outsink_close */
+
+
+/* *********************************************************************** *
+ * Private Functions                                                       *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private function new_sink(status)
+ * --------------------------------------------------------------------------
+ * Allocates and initialises a new sink without a file and returns it, or
+ * NULL if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static m2c_outsink_t new_sink (m2c_fileio_status_t *status) {
+
+  m2c_outsink_t sink;
+
+  sink = malloc(sizeof(m2c_outsink_struct_t));
+
+  if (sink == NULL) {
+    SET_STATUS(status, M2C_FILEIO_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+
+  sink->fd = -1;
+  sink->fptr = NULL;
+  sink->is_console = false;
+  sink->is_memory = false;
+  sink->memory = NULL;
+  sink->memory_length = 0;
+  sink->memory_capacity = 0;
+  sink->length = 0;
+  sink->chars_written = 0;
+  sink->status = M2C_FILEIO_STATUS_SUCCESS;
+
+  SET_STATUS(status, M2C_FILEIO_STATUS_SUCCESS);
+  return sink;
+} /* end new_sink */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_out(sink, chars, length)
+ * --------------------------------------------------------------------------
+ * Writes the buffer of sink followed by length characters at chars and
+ * empties the buffer.  Direct sinks write both in a single vectored write,
+ * retried until all has been written.  Records failure in the status.
+ * ----------------------------------------------------------------------- */
+
+static void write_out
+  (m2c_outsink_t sink, const char *chars, uint_t length) {
+
+  if (sink->is_memory) {
+    write_to_memory(sink, chars, length);
+    return;
+  } /* end if */
+
+#if (M2C_OUTSINK_DIRECT)
+  struct iovec vector[2];
+  ssize_t written;
+  int first;
+
+  if (sink->fd >= 0) {
+    vector[0].iov_base = sink->buffer;
+    vector[0].iov_len = sink->length;
+    vector[1].iov_base = (void *) chars;
+    vector[1].iov_len = length;
+    first = 0;
+
+    while ((first < 2) &&
+           (vector[0].iov_len + vector[1].iov_len > 0)) {
+      written = writev(sink->fd, &vector[first], 2 - first);
+
+      if (written < 0) {
+        if (errno == EINTR) {
+          continue;
+        } /* end if */
+        sink->status = M2C_FILEIO_STATUS_WRITE_FAILED;
+        break;
+      } /* end if */
+
+      /* advance past what has been written */
+      while ((first < 2) && ((size_t) written >= vector[first].iov_len)) {
+        written = written - vector[first].iov_len;
+        vector[first].iov_len = 0;
+        first++;
+      } /* end while */
+
+      if (first < 2) {
+        vector[first].iov_base = (char *) vector[first].iov_base + written;
+        vector[first].iov_len = vector[first].iov_len - written;
+      } /* end if */
+    } /* end while */
+
+    sink->length = 0;
+    return;
+  } /* end if */
+#endif
+
+  if ((fwrite(sink->buffer, 1, sink->length, sink->fptr) != sink->length) ||
+      ((length > 0) && (fwrite(chars, 1, length, sink->fptr) != length))) {
+    sink->status = M2C_FILEIO_STATUS_WRITE_FAILED;
+  } /* end if */
+
+  sink->length = 0;
+
+} /* end write_out */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_to_memory(sink, chars, length)
+ * --------------------------------------------------------------------------
+ * Appends the buffer of memory sink sink followed by length characters at
+ * chars to its memory and empties the buffer.  The memory is grown to
+ * twice the required size when full.  Records failure in the status.
+ * ----------------------------------------------------------------------- */
+
+static void write_to_memory
+  (m2c_outsink_t sink, const char *chars, uint_t length) {
+
+  uint_t required, new_capacity;
+  char *new_memory;
+
+  if (sink->length + length == 0) {
+    return;
+  } /* end if */
+
+  required = sink->memory_length + sink->length + length;
+
+  if (required > sink->memory_capacity) {
+    new_capacity = 2 * required;
+    new_memory = realloc(sink->memory, new_capacity);
+
+    if (new_memory == NULL) {
+      sink->status = M2C_FILEIO_STATUS_ALLOCATION_FAILED;
+      sink->length = 0;
+      return;
+    } /* end if */
+
+    sink->memory = new_memory;
+    sink->memory_capacity = new_capacity;
+  } /* end if */
+
+  memcpy(&sink->memory[sink->memory_length], sink->buffer, sink->length);
+  sink->memory_length = sink->memory_length + sink->length;
+
+  if (length > 0) {
+    memcpy(&sink->memory[sink->memory_length], chars, length);
+    sink->memory_length = sink->memory_length + length;
+  } /* end if */
+
+  sink->length = 0;
+
+} /* end write_to_memory */
+
+
+/* END OF FILE */
@@ -0,0 +1,218 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015-2016 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * m2-outsink.h
+ *
+ * Public interface for M2C buffered output sinks.
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute and/or modify it under the
+ * terms of the GNU Lesser General Public License (LGPL) either version 2.1
+ * or at your choice version 3 as published by the Free Software Foundation.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#ifndef M2C_OUTSINK_H
+#define M2C_OUTSINK_H
+
+#include "m2-common.h"
+#include "m2-fileio-status.h"
+
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * Size of the buffer of an output sink
+ * ----------------------------------------------------------------------- */
+
+#define M2C_OUTSINK_BUFFER_SIZE (64 * 1024)
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2c_outsink_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing a buffered output sink.  Output is
+ * collected in a user space buffer and written when the buffer is full.
+ * On POSIX hosts, file sinks write directly to the file descriptor, output
+ * larger than the buffer is written together with the buffer contents in
+ * a single vectored write.  Memory sinks collect their output in memory
+ * until it is written to another sink.  Errors are sticky, once a write
+ * has failed, all further output is discarded and the status is retained.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_outsink_struct_t *m2c_outsink_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_outsink_open(path, status)
+ * --------------------------------------------------------------------------
+ * Creates or truncates the file at path and returns a new output sink that
+ * writes to it, or NULL on failure.
+ *
+ * error-conditions:
+ * o  if the file cannot be opened, NULL is returned and
+ *    M2C_FILEIO_STATUS_FOPEN_FAILED is passed back in status, unless NULL
+ * o  if allocation fails, NULL is returned and
+ *    M2C_FILEIO_STATUS_ALLOCATION_FAILED is passed back in status,
+ *    unless NULL
+ * ----------------------------------------------------------------------- */
+
+m2c_outsink_t m2c_outsink_open (const char *path, m2c_fileio_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_outsink_open_console(status)
+ * --------------------------------------------------------------------------
+ * Returns a new output sink that writes to the console, or NULL on failure.
+ * Buffered output is written through stdout, it therefore keeps its order
+ * relative to output printed before the sink is flushed.
+ *
+ * error-conditions:
+ * o  if allocation fails, NULL is returned and
+ *    M2C_FILEIO_STATUS_ALLOCATION_FAILED is passed back in status,
+ *    unless NULL
+ * ----------------------------------------------------------------------- */
+
+m2c_outsink_t m2c_outsink_open_console (m2c_fileio_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_outsink_open_memory(status)
+ * --------------------------------------------------------------------------
+ * Returns a new output sink that collects its output in memory, or NULL on
+ * failure.  The output is written to another sink by procedure
+ * m2c_outsink_write_sink(), it is discarded when the sink is closed.
+ *
+ * error-conditions:
+ * o  if allocation fails, NULL is returned and
+ *    M2C_FILEIO_STATUS_ALLOCATION_FAILED is passed back in status,
+ *    unless NULL
+ * ----------------------------------------------------------------------- */
+
+m2c_outsink_t m2c_outsink_open_memory (m2c_fileio_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_outsink_write_chars(sink, chars, length)
+ * --------------------------------------------------------------------------
+ * Writes length characters starting at chars to sink.
+ * ----------------------------------------------------------------------- */
+
+void m2c_outsink_write_chars
+  (m2c_outsink_t sink, const char *chars, uint_t length);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_outsink_write_str(sink, str)
+ * --------------------------------------------------------------------------
+ * Writes NUL terminated string str to sink.  Does nothing if str is NULL.
+ * ----------------------------------------------------------------------- */
+
+void m2c_outsink_write_str (m2c_outsink_t sink, const char *str);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_outsink_write_char(sink, ch)
+ * --------------------------------------------------------------------------
+ * Writes character ch to sink.
+ * ----------------------------------------------------------------------- */
+
+void m2c_outsink_write_char (m2c_outsink_t sink, char ch);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_outsink_write_uint(sink, value)
+ * --------------------------------------------------------------------------
+ * Writes the decimal representation of value to sink.
+ * ----------------------------------------------------------------------- */
+
+void m2c_outsink_write_uint (m2c_outsink_t sink, uint_t value);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_outsink_write_escaped(sink, str)
+ * --------------------------------------------------------------------------
+ * Writes NUL terminated string str to sink with a backslash inserted before
+ * each double quote and backslash, as required within DOT and C string
+ * literals.  Does nothing if str is NULL.
+ * ----------------------------------------------------------------------- */
+
+void m2c_outsink_write_escaped (m2c_outsink_t sink, const char *str);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_outsink_write_sink(sink, source)
+ * --------------------------------------------------------------------------
+ * Writes all output collected so far by memory sink source to sink.  If any
+ * write to source has failed, its status is passed on to sink instead.
+ * Does nothing if source is not a memory sink.
+ * ----------------------------------------------------------------------- */
+
+void m2c_outsink_write_sink (m2c_outsink_t sink, m2c_outsink_t source);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_outsink_flush(sink)
+ * --------------------------------------------------------------------------
+ * Writes any buffered output of sink.
+ * ----------------------------------------------------------------------- */
+
+void m2c_outsink_flush (m2c_outsink_t sink);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_outsink_chars_written(sink)
+ * --------------------------------------------------------------------------
+ * Returns the number of characters written to sink so far.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_outsink_chars_written (m2c_outsink_t sink);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_outsink_status(sink)
+ * --------------------------------------------------------------------------
+ * Returns M2C_FILEIO_STATUS_WRITE_FAILED if any write to sink has failed,
+ * M2C_FILEIO_STATUS_ALLOCATION_FAILED if a memory sink could not be grown,
+ * otherwise M2C_FILEIO_STATUS_SUCCESS.
+ * ----------------------------------------------------------------------- */
+
+m2c_fileio_status_t m2c_outsink_status (m2c_outsink_t sink);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_outsink_close(sinkptr)
+ * --------------------------------------------------------------------------
+ * Writes any buffered output, closes the file of the sink passed in sinkptr
+ * unless it is the console, deallocates the sink and returns its status.
+ * The output of a memory sink is discarded.
+ * Passes NULL back in sinkptr.
+ * ----------------------------------------------------------------------- */
+
+m2c_fileio_status_t m2c_outsink_close (m2c_outsink_t *sinkptr);
+
+
+#endif /* M2C_OUTSINK_H */
+
+/* END OF FILE */
@@ -0,0 +1,400 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015-2016 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * m2-readahead.c
+ *
+ * Implementation of M2C asynchronous read-ahead of source files.
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute and/or modify it under the
+ * terms of the GNU Lesser General Public License (LGPL) either version 2.1
+ * or at your choice version 3 as published by the Free Software Foundation.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#include "m2-readahead.h"
+#include "m2-thread.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+
+/* --------------------------------------------------------------------------
+ * I/O thread
+ * --------------------------------------------------------------------------
+ * Hosts without a supported thread API have no I/O thread, no file is then
+ * loaded ahead.
+ * ----------------------------------------------------------------------- */
+
+#define M2C_READAHEAD_THREADS (M2C_THREADS_AVAILABLE)
+
+
+/* --------------------------------------------------------------------------
+ * private type m2c_readahead_state_t
+ * --------------------------------------------------------------------------
+ * Enumerated type representing the state of a file in the path list.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  READAHEAD_PENDING, /* not yet reached by the I/O thread */
+  READAHEAD_LOADING, /* being loaded by the I/O thread */
+  READAHEAD_LOADED,  /* loaded, not yet taken */
+  READAHEAD_FAILED,  /* could not be loaded, not yet taken */
+  READAHEAD_TAKEN    /* taken */
+} m2c_readahead_state_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type m2c_readahead_entry_s
+ * --------------------------------------------------------------------------
+ * record type representing a file in the path list and its contents.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* state */ m2c_readahead_state_t state;
+  /* length */ size_t length;
+  /* contents */ char *contents;
+} m2c_readahead_entry_s;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_readahead_struct_t
+ * --------------------------------------------------------------------------
+ * record type representing a read-ahead object.  Field next holds the
+ * index of the next file the I/O thread will reach and loaded_count the
+ * number of loaded files not yet taken.  The I/O thread waits on condition
+ * space while loaded_count has reached window, takers wait on condition
+ * ready while the file they take is being loaded.  All fields but the
+ * path list are guarded by lock.
+ * ----------------------------------------------------------------------- */
+
+struct m2c_readahead_struct_t {
+  /* lock */ m2c_lock_t lock;
+  /* space */ m2c_cond_t space;
+  /* ready */ m2c_cond_t ready;
+#if (M2C_READAHEAD_THREADS)
+  /* thread */ m2c_thread_t thread;
+#endif
+  /* stopping */ bool stopping;
+  /* window */ uint_t window;
+  /* loaded_count */ uint_t loaded_count;
+  /* next */ uint_t next;
+  /* path_count */ uint_t path_count;
+  /* path */ const char **path;
+  /* entry */ m2c_readahead_entry_s entry[];
+};
+
+typedef struct m2c_readahead_struct_t m2c_readahead_struct_t;
+
+
+#if (M2C_READAHEAD_THREADS)
+static void reader_loop (m2c_readahead_t readahead);
+
+static char *load_file (const char *path, size_t *length);
+
+static void reader_main (void *arg);
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_new_readahead(path_count, path, window, status)
+ * --------------------------------------------------------------------------
+ * Allocates and returns a new read-ahead object for the path_count files
+ * whose pathnames are given in array path and starts loading them.  The
+ * array and its pathnames are NOT copied, they must remain valid until the
+ * object has been released.  At most window loaded files are held that
+ * have not yet been taken.  A window of zero selects the default window.
+ * ----------------------------------------------------------------------- */
+
+m2c_readahead_t m2c_new_readahead
+  (uint_t path_count, const char **path, uint_t window,
+   m2c_readahead_status_t *status) {
+  
+  m2c_readahead_t readahead;
+  uint_t index;
+  
+  if ((path == NULL) && (path_count > 0)) {
+    SET_STATUS(status, M2C_READAHEAD_STATUS_INVALID_REFERENCE);
+    return NULL;
+  } /* end if */
+  
+  if (window == 0) {
+    window = M2C_READAHEAD_DEFAULT_WINDOW;
+  } /* end if */
+  
+  /* allocate object with one entry per file */
+  readahead = malloc
+    (sizeof(m2c_readahead_struct_t) +
+     path_count * sizeof(m2c_readahead_entry_s));
+  
+  if (readahead == NULL) {
+    SET_STATUS(status, M2C_READAHEAD_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  for (index = 0; index < path_count; index++) {
+    readahead->entry[index].state = READAHEAD_PENDING;
+    readahead->entry[index].length = 0;
+    readahead->entry[index].contents = NULL;
+  } /* end for */
+  
+  readahead->stopping = false;
+  readahead->window = window;
+  readahead->loaded_count = 0;
+  readahead->next = 0;
+  readahead->path_count = path_count;
+  readahead->path = path;
+  
+  M2C_LOCK_INIT(&readahead->lock);
+  M2C_COND_INIT(&readahead->space);
+  M2C_COND_INIT(&readahead->ready);
+  
+#if (M2C_READAHEAD_THREADS)
+  /* start I/O thread */
+  if (NOT(m2c_thread_start(&readahead->thread, reader_main, readahead))) {
+    M2C_COND_DISPOSE(&readahead->ready);
+    M2C_COND_DISPOSE(&readahead->space);
+    M2C_LOCK_DISPOSE(&readahead->lock);
+    free(readahead);
+    SET_STATUS(status, M2C_READAHEAD_STATUS_THREAD_CREATION_FAILED);
+    return NULL;
+  } /* end if */
+#endif
+  
+  SET_STATUS(status, M2C_READAHEAD_STATUS_SUCCESS);
+  return readahead;
+} /* end m2c_new_readahead */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_readahead_take(readahead, index, length)
+ * --------------------------------------------------------------------------
+ * Takes the contents of the file at the given index of the path list of
+ * readahead.  If the file has been loaded, its contents are returned and
+ * their length is passed back in length.  If the file is being loaded, the
+ * load is awaited first.  Returns NULL if the file has not been reached by
+ * the I/O thread, if it could not be loaded, if it has already been taken
+ * or if index is out of range, length is then left unmodified.  The
+ * returned contents are NOT NUL terminated.  They pass to the caller, who
+ * is responsible for releasing them by calling free().  May be called from
+ * any thread.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_readahead_take
+  (m2c_readahead_t readahead, uint_t index, size_t *length) {
+  
+  m2c_readahead_entry_s *entry;
+  char *contents;
+  
+  if ((readahead == NULL) || (index >= readahead->path_count)) {
+    return NULL;
+  } /* end if */
+  
+  entry = &readahead->entry[index];
+  contents = NULL;
+  
+  M2C_LOCK_ACQUIRE(&readahead->lock);
+  
+  /* a load in progress is nearly done, reading again would take longer */
+  while (entry->state == READAHEAD_LOADING) {
+    M2C_COND_WAIT(&readahead->ready, &readahead->lock);
+  } /* end while */
+  
+  if (entry->state == READAHEAD_LOADED) {
+    contents = entry->contents;
+    WRITE_OUTPARAM(length, entry->length);
+    entry->contents = NULL;
+    
+    /* make room for the I/O thread to load another file */
+    readahead->loaded_count--;
+    M2C_COND_BROADCAST(&readahead->space);
+  } /* end if */
+  
+  /* a pending file is skipped by the I/O thread from now on */
+  entry->state = READAHEAD_TAKEN;
+  
+  M2C_LOCK_RELEASE(&readahead->lock);
+  
+  return contents;
+} /* end m2c_readahead_take */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_release_readahead(readahead)
+ * --------------------------------------------------------------------------
+ * Stops the I/O thread of readahead, releases any loaded contents that
+ * have not been taken and releases readahead itself.  Contents already
+ * taken are not affected.  Must not be called while other threads may
+ * still be taking files.  Does nothing if readahead is NULL.
+ * ----------------------------------------------------------------------- */
+
+void m2c_release_readahead (m2c_readahead_t readahead) {
+  uint_t index;
+  
+  if (readahead == NULL) {
+    return;
+  } /* end if */
+  
+#if (M2C_READAHEAD_THREADS)
+  /* stop I/O thread */
+  M2C_LOCK_ACQUIRE(&readahead->lock);
+  readahead->stopping = true;
+  M2C_COND_BROADCAST(&readahead->space);
+  M2C_LOCK_RELEASE(&readahead->lock);
+  
+  m2c_thread_join(&readahead->thread);
+#endif
+  
+  /* release contents not taken */
+  for (index = 0; index < readahead->path_count; index++) {
+    free(readahead->entry[index].contents);
+  } /* end for */
+  
+  M2C_COND_DISPOSE(&readahead->ready);
+  M2C_COND_DISPOSE(&readahead->space);
+  M2C_LOCK_DISPOSE(&readahead->lock);
+  free(readahead);
+} /* end m2c_release_readahead */
+
+
+#if (M2C_READAHEAD_THREADS)
+/* --------------------------------------------------------------------------
+ * private procedure reader_loop(readahead)
+ * --------------------------------------------------------------------------
+ * Main loop of the I/O thread of readahead.  Loads the files of the path
+ * list in list order, skipping those already taken, while the window has
+ * room.  Returns when all files have been reached or readahead is stopped.
+ * ----------------------------------------------------------------------- */
+
+static void reader_loop (m2c_readahead_t readahead) {
+  m2c_readahead_entry_s *entry;
+  char *contents;
+  size_t length;
+  
+  M2C_LOCK_ACQUIRE(&readahead->lock);
+  
+  while ((NOT(readahead->stopping)) &&
+         (readahead->next < readahead->path_count)) {
+    
+    /* wait for a loaded file to be taken */
+    if (readahead->loaded_count >= readahead->window) {
+      M2C_COND_WAIT(&readahead->space, &readahead->lock);
+      continue;
+    } /* end if */
+    
+    entry = &readahead->entry[readahead->next];
+    
+    if (entry->state != READAHEAD_PENDING) {
+      readahead->next++;
+      continue;
+    } /* end if */
+    
+    entry->state = READAHEAD_LOADING;
+    
+    /* load without holding the lock, takers of other files proceed */
+    M2C_LOCK_RELEASE(&readahead->lock);
+    length = 0;
+    contents = load_file(readahead->path[readahead->next], &length);
+    M2C_LOCK_ACQUIRE(&readahead->lock);
+    
+    if (contents != NULL) {
+      entry->state = READAHEAD_LOADED;
+      entry->length = length;
+      entry->contents = contents;
+      readahead->loaded_count++;
+    }
+    else {
+      entry->state = READAHEAD_FAILED;
+    } /* end if */
+    
+    readahead->next++;
+    M2C_COND_BROADCAST(&readahead->ready);
+  } /* end while */
+  
+  M2C_LOCK_RELEASE(&readahead->lock);
+} /* end reader_loop */
+
+
+/* --------------------------------------------------------------------------
+ * private function load_file(path, length)
+ * --------------------------------------------------------------------------
+ * Reads the entire contents of the file at path into a newly allocated
+ * buffer, passes its length back in length and returns the buffer.  An
+ * empty file yields a buffer of length zero.  Returns NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+static char *load_file (const char *path, size_t *length) {
+  char *contents;
+  FILE *file;
+  long size;
+  
+  file = fopen(path, "rb");
+  
+  if (file == NULL) {
+    return NULL;
+  } /* end if */
+  
+  /* determine file size */
+  if ((fseek(file, 0, SEEK_END) != 0) ||
+      ((size = ftell(file)) < 0) ||
+      (fseek(file, 0, SEEK_SET) != 0)) {
+    fclose(file);
+    return NULL;
+  } /* end if */
+  
+  /* allocate at least one byte, so that an empty file is not a failure */
+  contents = malloc(size + 1);
+  
+  if (contents == NULL) {
+    fclose(file);
+    return NULL;
+  } /* end if */
+  
+  if (fread(contents, 1, (size_t) size, file) != (size_t) size) {
+    free(contents);
+    fclose(file);
+    return NULL;
+  } /* end if */
+  
+  fclose(file);
+  
+  *length = (size_t) size;
+  return contents;
+} /* end load_file */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure reader_main(arg)
+ * --------------------------------------------------------------------------
+ * Entry point of the I/O thread of the read-ahead object passed in arg.
+ * ----------------------------------------------------------------------- */
+
+static void reader_main (void *arg) {
+  
+  reader_loop(arg);
+} /* end reader_main */
+#endif /* M2C_READAHEAD_THREADS */
+
+
+/* END OF FILE */
@@ -0,0 +1,153 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015-2016 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * m2-readahead.h
+ *
+ * Public interface for M2C asynchronous read-ahead of source files.
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute and/or modify it under the
+ * terms of the GNU Lesser General Public License (LGPL) either version 2.1
+ * or at your choice version 3 as published by the Free Software Foundation.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#ifndef M2C_READAHEAD_H
+#define M2C_READAHEAD_H
+
+#include "m2-common.h"
+
+#include <stddef.h>
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * Read-ahead
+ * --------------------------------------------------------------------------
+ * A read-ahead object loads a list of files into memory on an I/O thread
+ * of its own, in list order, while the files loaded before are processed.
+ * At most a window of loaded files is held that have not yet been taken,
+ * the I/O thread waits for a file to be taken before it loads the next.
+ * A file taken before the I/O thread reached it is skipped, the taker then
+ * reads it by other means.  On host platforms without threads no file is
+ * loaded ahead and every file is left to the taker.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * Default number of loaded files held ahead
+ * ----------------------------------------------------------------------- */
+
+#define M2C_READAHEAD_DEFAULT_WINDOW 8
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_readahead_status_t
+ * --------------------------------------------------------------------------
+ * Status codes for operations on type m2c_readahead_t.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_READAHEAD_STATUS_SUCCESS,
+  M2C_READAHEAD_STATUS_INVALID_REFERENCE,
+  M2C_READAHEAD_STATUS_ALLOCATION_FAILED,
+  M2C_READAHEAD_STATUS_THREAD_CREATION_FAILED
+} m2c_readahead_status_t;
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2c_readahead_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing a read-ahead object.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_readahead_struct_t *m2c_readahead_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_new_readahead(path_count, path, window, status)
+ * --------------------------------------------------------------------------
+ * Allocates and returns a new read-ahead object for the path_count files
+ * whose pathnames are given in array path and starts loading them.  The
+ * array and its pathnames are NOT copied, they must remain valid until the
+ * object has been released.  At most window loaded files are held that
+ * have not yet been taken.  A window of zero selects the default window.
+ *
+ * pre-conditions:
+ * o  parameter path must not be NULL unless path_count is zero
+ *
+ * post-conditions:
+ * o  a new read-ahead object is returned
+ * o  M2C_READAHEAD_STATUS_SUCCESS is passed back in status, unless NULL
+ *
+ * error-conditions:
+ * o  if path is NULL and path_count is not zero, no operation is carried
+ *    out, NULL is returned and M2C_READAHEAD_STATUS_INVALID_REFERENCE is
+ *    passed back in status, unless NULL
+ * o  if allocation fails, no operation is carried out, NULL is returned
+ *    and M2C_READAHEAD_STATUS_ALLOCATION_FAILED is passed back in status,
+ *    unless NULL
+ * o  if the I/O thread cannot be created, no operation is carried out,
+ *    NULL is returned and M2C_READAHEAD_STATUS_THREAD_CREATION_FAILED is
+ *    passed back in status, unless NULL
+ * ----------------------------------------------------------------------- */
+
+m2c_readahead_t m2c_new_readahead
+  (uint_t path_count, const char **path, uint_t window,
+   m2c_readahead_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_readahead_take(readahead, index, length)
+ * --------------------------------------------------------------------------
+ * Takes the contents of the file at the given index of the path list of
+ * readahead.  If the file has been loaded, its contents are returned and
+ * their length is passed back in length.  If the file is being loaded, the
+ * load is awaited first.  Returns NULL if the file has not been reached by
+ * the I/O thread, if it could not be loaded, if it has already been taken
+ * or if index is out of range, length is then left unmodified.  The
+ * returned contents are NOT NUL terminated.  They pass to the caller, who
+ * is responsible for releasing them by calling free().  May be called from
+ * any thread.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_readahead_take
+  (m2c_readahead_t readahead, uint_t index, size_t *length);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_release_readahead(readahead)
+ * --------------------------------------------------------------------------
+ * Stops the I/O thread of readahead, releases any loaded contents that
+ * have not been taken and releases readahead itself.  Contents already
+ * taken are not affected.  Must not be called while other threads may
+ * still be taking files.  Does nothing if readahead is NULL.
+ * ----------------------------------------------------------------------- */
+
+void m2c_release_readahead (m2c_readahead_t readahead);
+
+
+#endif /* M2C_READAHEAD_H */
+
+/* END OF FILE */
@@ -70,6 +70,24 @@ typedef enum {
 unsigned cstr_length (const char *cstr);
 
 
+/* --------------------------------------------------------------------------
+ * function macro CSTR_FIRST_CHAR(cstr)
+ * --------------------------------------------------------------------------
+ * Returns first character of cstr.  Causes runtime fault if cstr is NULL.
+ * ----------------------------------------------------------------------- */
+
+#define CSTR_FIRST_CHAR(_cstr) (_cstr[0])
+
+
+/* --------------------------------------------------------------------------
+ * function cstr_last_char(cstr)
+ * --------------------------------------------------------------------------
+ * Returns last character of cstr, or ASCII NUL if cstr is NULL or empty.
+ * ----------------------------------------------------------------------- */
+
+char cstr_last_char (const char *cstr);
+
+
 /* --------------------------------------------------------------------------
  * function cstr_contains_char(cstr, ch)
  * --------------------------------------------------------------------------
@@ -128,6 +146,125 @@ const char *new_cstr_from_slice
 const char *new_cstr_by_concat (const char *first, ...);
 
 
+/* --------------------------------------------------------------------------
+ * type cstr_view_t
+ * --------------------------------------------------------------------------
+ * Record type representing a view of len characters starting at ptr.  A
+ * view does not own its characters and need not be NUL terminated.  Views
+ * carry their length so that operations on them never rescan their text.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* ptr */ const char *ptr;
+  /* len */ unsigned len;
+} cstr_view_t;
+
+
+/* --------------------------------------------------------------------------
+ * function cstr_view(cstr)
+ * --------------------------------------------------------------------------
+ * Returns a view of C string cstr, excluding its NUL terminator.  Returns
+ * an empty view if cstr is NULL.  The length of cstr is obtained once.
+ * ----------------------------------------------------------------------- */
+
+cstr_view_t cstr_view (const char *cstr);
+
+
+/* --------------------------------------------------------------------------
+ * function cstr_view_w_len(ptr, len)
+ * --------------------------------------------------------------------------
+ * Returns a view of len characters starting at ptr.  Use this function
+ * when the length is already known, as for interned strings.
+ * ----------------------------------------------------------------------- */
+
+cstr_view_t cstr_view_w_len (const char *ptr, unsigned len);
+
+
+/* --------------------------------------------------------------------------
+ * function cstr_view_last_char(view)
+ * --------------------------------------------------------------------------
+ * Returns last character of view, or ASCII NUL if view is empty.
+ * ----------------------------------------------------------------------- */
+
+char cstr_view_last_char (cstr_view_t view);
+
+
+/* --------------------------------------------------------------------------
+ * function cstr_view_contains_char(view, ch)
+ * --------------------------------------------------------------------------
+ * Returns true if view contains ch, otherwise false.  Searches with the C
+ * library's memchr(), which is vectorised on mainstream hosts.
+ * ----------------------------------------------------------------------- */
+
+bool cstr_view_contains_char (cstr_view_t view, char ch);
+
+
+/* --------------------------------------------------------------------------
+ * function cstr_view_match(view1, view2)
+ * --------------------------------------------------------------------------
+ * Returns true if view1 and view2 have the same length and characters,
+ * otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool cstr_view_match (cstr_view_t view1, cstr_view_t view2);
+
+
+/* --------------------------------------------------------------------------
+ * function new_cstr_from_views(count, views)
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated and NUL terminated C string containing the
+ * concatenation of the count views in array views in left-to-right order.
+ * The required size is known from the views, the text of each view is
+ * copied once.  Returns NULL if views is NULL or if allocation fails.
+ * ----------------------------------------------------------------------- */
+
+const char *new_cstr_from_views (unsigned count, const cstr_view_t *views);
+
+
+/* --------------------------------------------------------------------------
+ * opaque type cstr_arena_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing an arena for C strings.  An arena hands
+ * out strings from large chunks and releases all of them at once, for
+ * strings that share a lifetime, such as the output paths of a compilation.
+ * ----------------------------------------------------------------------- */
+
+typedef struct cstr_arena_s *cstr_arena_t;
+
+
+/* --------------------------------------------------------------------------
+ * function cstr_new_arena(chunk_size)
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated empty arena whose chunks hold chunk_size bytes,
+ * or a default size if chunk_size is zero.  Returns NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+cstr_arena_t cstr_new_arena (unsigned chunk_size);
+
+
+/* --------------------------------------------------------------------------
+ * function cstr_arena_concat(arena, count, views)
+ * --------------------------------------------------------------------------
+ * Returns a NUL terminated C string allocated in arena, containing the
+ * concatenation of the count views in array views in left-to-right order.
+ * The string must not be released by the caller, it lives until the arena
+ * is released.  Returns NULL if arena or views is NULL or if allocation
+ * fails.
+ * ----------------------------------------------------------------------- */
+
+const char *cstr_arena_concat
+  (cstr_arena_t arena, unsigned count, const cstr_view_t *views);
+
+
+/* --------------------------------------------------------------------------
+ * procedure cstr_release_arena(arena)
+ * --------------------------------------------------------------------------
+ * Releases arena and all strings allocated in it, passes back NULL.
+ * ----------------------------------------------------------------------- */
+
+void cstr_release_arena (cstr_arena_t *arena);
+
+
 #endif /* CSTRING_H */
 
 /* END OF FILE */
\ No newline at end of file
@@ -321,27 +321,26 @@ bool is_mod_suffix (const char *suffix) {
 const char *new_path_w_components
   (const char *dirpath, const char *basename, const char *suffix) {
   
-  const char *new_path;
-  uint_t dir_len;
+  cstr_view_t part[4];
+  uint_t count;
   
   if ((dirpath == NULL) || (basename == NULL) || (dirpath[0] == ASCII_NUL)) {
     return NULL;
   } /* end if */
   
-  dir_len = cstr_length(dirpath);
+  /* each component is measured once and copied once */
+  count = 0;
+  part[count++] = cstr_view(dirpath);
   
-  if (dir_len == 0) {
-    return NULL;
-  } /* end if */
-    
-  if /* directory separator missing */ (dirpath[dir_len - 1] != DIRSEP) {
-    new_path = new_cstr_by_concat(dirpath, "/", basename, suffix, NULL);
-  }
-  else /* directory separator present */ {
-    new_path = new_cstr_by_concat(dirpath, basename, suffix, NULL);
+  if /* directory separator missing */
+    (cstr_view_last_char(part[0]) != DIRSEP) {
+    part[count++] = cstr_view("/");
   } /* end if */
   
-  return new_path;
+  part[count++] = cstr_view(basename);
+  part[count++] = cstr_view(suffix);
+  
+  return new_cstr_from_views(count, part);
 } /* end new_path_w_components */
 
 
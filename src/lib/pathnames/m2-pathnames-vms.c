@@ -348,19 +348,22 @@ bool is_mod_suffix (const char *suffix) {
 const char *new_path_w_components
   (const char *dirpath, const char *basename, const char *suffix) {
   
-  const char *new_path;
+  cstr_view_t part[3];
   
   if ((dirpath == NULL) || (dirpath[0] == ASCII_NUL)) {
     return NULL;
   } /* end if */
   
-  if ((basename == NULL) || (dirpath[0] == ASCII_NUL)) {
+  if ((basename == NULL) || (basename[0] == ASCII_NUL)) {
     return NULL;
   } /* end if */
   
-  new_path = new_cstr_by_concat(dirpath, basename, suffix, NULL);
+  /* each component is measured once and copied once */
+  part[0] = cstr_view(dirpath);
+  part[1] = cstr_view(basename);
+  part[2] = cstr_view(suffix);
   
-  return new_path;
+  return new_cstr_from_views(3, part);
 } /* end new_path_w_components */
 
 
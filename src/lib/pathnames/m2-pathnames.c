@@ -77,4 +77,73 @@
 #endif
 
 
+/* --------------------------------------------------------------------------
+ * function split_pathname_view(path, view, chars_processed)
+ * --------------------------------------------------------------------------
+ * Verifies path against the host system's prevailing pathname grammar and
+ * returns a status code.  If path is valid, the offsets of its components
+ * are passed back in view.  Nothing is allocated.  The index of the last
+ * processed character is passed back in chars_processed, unless NULL is
+ * passed in.  Upon success it represents the length of path.  Upon failure,
+ * it represents the index of the first offending character found in path.
+ * --------------------------------------------------------------------------
+ * Shared by all host platforms, it uses the parsing functions of the
+ * platform specific implementation selected above.
+ * ----------------------------------------------------------------------- */
+
+m2c_pathname_status_t split_pathname_view
+  (const char *path,         /* in, may not be NULL */
+   m2c_path_view_t *view,    /* out, may not be NULL */
+   uint_t *chars_processed)  /* out, pass in NULL to ignore */ {
+  
+  bool invalid;
+  int fn_index, suffix_index;
+  uint_t final_index;
+  
+  if ((path == NULL) || (view == NULL)) {
+    return M2C_PATHNAME_STATUS_INVALID_REFERENCE;
+  } /* end if */
+  
+  if (path[0] == ASCII_NUL) {
+    WRITE_OUTPARAM(chars_processed, 0);
+    return M2C_PATHNAME_STATUS_INVALID_PATH;
+  } /* end if */
+  
+  invalid = false;
+  fn_index = NO_FILENAME_FOUND;
+  final_index = parse_pathname(path, 0, &invalid, &fn_index);
+  
+  if (invalid) {
+    WRITE_OUTPARAM(chars_processed, final_index);
+    return M2C_PATHNAME_STATUS_INVALID_PATH;
+  } /* end if */
+  
+  view->length = final_index;
+  
+  if (fn_index == NO_FILENAME_FOUND) {
+    view->filename = final_index;
+    view->suffix = final_index;
+  }
+  else /* filename found */ {
+    view->filename = fn_index;
+  
+    /* locate suffix, the filename has already been verified */
+    suffix_index = NO_SUFFIX_FOUND;
+    parse_filename(path, fn_index, &invalid, &suffix_index);
+  
+    if (suffix_index == NO_SUFFIX_FOUND) {
+      view->suffix = final_index;
+    }
+    else /* suffix found */ {
+      view->suffix = suffix_index;
+    } /* end if */
+  } /* end if */
+  
+  /* pass back number of characters processed */
+  WRITE_OUTPARAM(chars_processed, final_index);
+  
+  return M2C_PATHNAME_STATUS_SUCCESS;
+} /* end split_pathname_view */
+
+
 /* END OF FILE */
\ No newline at end of file
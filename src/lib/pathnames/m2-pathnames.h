@@ -125,6 +125,43 @@ m2c_pathname_status_t split_filename
 bool is_valid_filename (const char *filename);
 
 
+/* --------------------------------------------------------------------------
+ * type m2c_path_view_t
+ * --------------------------------------------------------------------------
+ * Record type representing the components of a pathname as offsets into
+ * the pathname itself.  Field length holds the length of the pathname,
+ * field filename the index of its filename and field suffix the index of
+ * the suffix of its filename.  The directory path spans from index zero to
+ * filename, the basename from filename to suffix and the suffix from suffix
+ * to length.  A missing component has length zero.  Since filename and
+ * suffix both extend to the end of the pathname, path + filename and
+ * path + suffix are themselves NUL terminated C strings.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* length */ uint_t length;
+  /* filename */ uint_t filename;
+  /* suffix */ uint_t suffix;
+} m2c_path_view_t;
+
+
+/* --------------------------------------------------------------------------
+ * function split_pathname_view(path, view, chars_processed)
+ * --------------------------------------------------------------------------
+ * Verifies path against the host system's prevailing pathname grammar and
+ * returns a status code.  If path is valid, the offsets of its components
+ * are passed back in view.  Nothing is allocated.  The index of the last
+ * processed character is passed back in chars_processed, unless NULL is
+ * passed in.  Upon success it represents the length of path.  Upon failure,
+ * it represents the index of the first offending character found in path.
+ * ----------------------------------------------------------------------- */
+
+m2c_pathname_status_t split_pathname_view
+  (const char *path,         /* in, may not be NULL */
+   m2c_path_view_t *view,    /* out, may not be NULL */
+   uint_t *chars_processed); /* out, pass in NULL to ignore */
+
+
 /* --------------------------------------------------------------------------
  * function is_def_suffix(suffix)
  * --------------------------------------------------------------------------
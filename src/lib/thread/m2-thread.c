@@ -0,0 +1,164 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015-2016 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * m2-thread.c
+ *
+ * Implementation of M2C host thread primitives.
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute and/or modify it under the
+ * terms of the GNU Lesser General Public License (LGPL) either version 2.1
+ * or at your choice version 3 as published by the Free Software Foundation.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#include "m2-thread.h"
+
+#include <stddef.h>
+
+
+#if defined(_WIN32)
+/* --------------------------------------------------------------------------
+ * private function thread_main(arg)
+ * --------------------------------------------------------------------------
+ * Entry point of a thread on Windows hosts.  Calls the entry function of
+ * the thread record passed in arg.
+ * ----------------------------------------------------------------------- */
+
+static DWORD WINAPI thread_main (LPVOID arg) {
+  m2c_thread_t *thread = arg;
+  
+  thread->entry(thread->arg);
+  return 0;
+} /* end thread_main */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_thread_start(thread, entry, arg)
+ * --------------------------------------------------------------------------
+ * Starts a thread that calls entry with arg, passes it back in thread and
+ * returns true.  Returns false if the thread could not be created.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_thread_start
+  (m2c_thread_t *thread, m2c_thread_entry_f entry, void *arg) {
+  
+  thread->entry = entry;
+  thread->arg = arg;
+  thread->handle = CreateThread(NULL, 0, thread_main, thread, 0, NULL);
+  
+  return (thread->handle != NULL);
+} /* end m2c_thread_start */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_thread_join(thread)
+ * --------------------------------------------------------------------------
+ * Waits for thread to finish and releases it.
+ * ----------------------------------------------------------------------- */
+
+void m2c_thread_join (m2c_thread_t *thread) {
+  
+  WaitForSingleObject(thread->handle, INFINITE);
+  CloseHandle(thread->handle);
+} /* end m2c_thread_join */
+
+
+#elif (M2C_THREADS_AVAILABLE)
+/* --------------------------------------------------------------------------
+ * private function thread_main(arg)
+ * --------------------------------------------------------------------------
+ * Entry point of a thread on POSIX hosts.  Calls the entry function of the
+ * thread record passed in arg.
+ * ----------------------------------------------------------------------- */
+
+static void *thread_main (void *arg) {
+  m2c_thread_t *thread = arg;
+  
+  thread->entry(thread->arg);
+  return NULL;
+} /* end thread_main */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_thread_start(thread, entry, arg)
+ * --------------------------------------------------------------------------
+ * Starts a thread that calls entry with arg, passes it back in thread and
+ * returns true.  Returns false if the thread could not be created.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_thread_start
+  (m2c_thread_t *thread, m2c_thread_entry_f entry, void *arg) {
+  
+  thread->entry = entry;
+  thread->arg = arg;
+  
+  return (pthread_create(&thread->handle, NULL, thread_main, thread) == 0);
+} /* end m2c_thread_start */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_thread_join(thread)
+ * --------------------------------------------------------------------------
+ * Waits for thread to finish and releases it.
+ * ----------------------------------------------------------------------- */
+
+void m2c_thread_join (m2c_thread_t *thread) {
+  
+  pthread_join(thread->handle, NULL);
+} /* end m2c_thread_join */
+
+
+#else /* no threads */
+/* --------------------------------------------------------------------------
+ * function m2c_thread_start(thread, entry, arg)
+ * --------------------------------------------------------------------------
+ * Returns false, the host has no supported thread API.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_thread_start
+  (m2c_thread_t *thread, m2c_thread_entry_f entry, void *arg) {
+  
+  thread->handle = 0;
+  thread->entry = entry;
+  thread->arg = arg;
+  
+  return false;
+} /* end m2c_thread_start */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_thread_join(thread)
+ * --------------------------------------------------------------------------
+ * No operation, no thread can have been started.
+ * ----------------------------------------------------------------------- */
+
+void m2c_thread_join (m2c_thread_t *thread) {
+  
+  (void) thread;
+} /* end m2c_thread_join */
+#endif
+
+
+/* END OF FILE */
@@ -0,0 +1,158 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015-2016 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * m2-thread.h
+ *
+ * Public interface for M2C host thread primitives.
+ *
+ * Win32 threads, Slim Reader/Writer locks and condition variables are used
+ * on Windows hosts, POSIX threads, mutexes and condition variables on Unix
+ * hosts.  On other hosts M2C_THREADS_AVAILABLE is 0, threads cannot be
+ * started, and locks and condition variables are no-ops.
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute and/or modify it under the
+ * terms of the GNU Lesser General Public License (LGPL) either version 2.1
+ * or at your choice version 3 as published by the Free Software Foundation.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#ifndef M2C_THREAD_H
+#define M2C_THREAD_H
+
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * Threads, locks and condition variables
+ * --------------------------------------------------------------------------
+ * A lock is either initialised by M2C_LOCK_INIT() and disposed of by
+ * M2C_LOCK_DISPOSE(), or statically initialised by M2C_LOCK_INITIALIZER
+ * and never disposed of.  Locks are not recursive.  M2C_COND_WAIT() must
+ * be called with the lock held, M2C_THREAD_YIELD() gives up the processor.
+ * ----------------------------------------------------------------------- */
+
+#if defined(_WIN32)
+#include <windows.h>
+#define M2C_THREADS_AVAILABLE 1
+typedef SRWLOCK m2c_lock_t;
+#define M2C_LOCK_INITIALIZER SRWLOCK_INIT
+#define M2C_LOCK_INIT(_lock) InitializeSRWLock(_lock)
+#define M2C_LOCK_ACQUIRE(_lock) AcquireSRWLockExclusive(_lock)
+#define M2C_LOCK_RELEASE(_lock) ReleaseSRWLockExclusive(_lock)
+#define M2C_LOCK_DISPOSE(_lock) ((void) (_lock))
+typedef CONDITION_VARIABLE m2c_cond_t;
+#define M2C_COND_INIT(_cond) InitializeConditionVariable(_cond)
+#define M2C_COND_WAIT(_cond, _lock) \
+  SleepConditionVariableSRW((_cond), (_lock), INFINITE, 0)
+#define M2C_COND_BROADCAST(_cond) WakeAllConditionVariable(_cond)
+#define M2C_COND_DISPOSE(_cond) ((void) (_cond))
+typedef HANDLE m2c_thread_handle_t;
+#define M2C_THREAD_YIELD() SwitchToThread()
+
+#elif defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#include <sched.h>
+#define M2C_THREADS_AVAILABLE 1
+typedef pthread_mutex_t m2c_lock_t;
+#define M2C_LOCK_INITIALIZER PTHREAD_MUTEX_INITIALIZER
+#define M2C_LOCK_INIT(_lock) pthread_mutex_init((_lock), NULL)
+#define M2C_LOCK_ACQUIRE(_lock) pthread_mutex_lock(_lock)
+#define M2C_LOCK_RELEASE(_lock) pthread_mutex_unlock(_lock)
+#define M2C_LOCK_DISPOSE(_lock) pthread_mutex_destroy(_lock)
+typedef pthread_cond_t m2c_cond_t;
+#define M2C_COND_INIT(_cond) pthread_cond_init((_cond), NULL)
+#define M2C_COND_WAIT(_cond, _lock) pthread_cond_wait((_cond), (_lock))
+#define M2C_COND_BROADCAST(_cond) pthread_cond_broadcast(_cond)
+#define M2C_COND_DISPOSE(_cond) pthread_cond_destroy(_cond)
+typedef pthread_t m2c_thread_handle_t;
+#define M2C_THREAD_YIELD() sched_yield()
+
+#else
+#define M2C_THREADS_AVAILABLE 0
+typedef int m2c_lock_t;
+#define M2C_LOCK_INITIALIZER 0
+#define M2C_LOCK_INIT(_lock) (*(_lock) = 0)
+#define M2C_LOCK_ACQUIRE(_lock) ((void) (_lock))
+#define M2C_LOCK_RELEASE(_lock) ((void) (_lock))
+#define M2C_LOCK_DISPOSE(_lock) ((void) (_lock))
+typedef int m2c_cond_t;
+#define M2C_COND_INIT(_cond) (*(_cond) = 0)
+#define M2C_COND_WAIT(_cond, _lock) ((void) (_cond))
+#define M2C_COND_BROADCAST(_cond) ((void) (_cond))
+#define M2C_COND_DISPOSE(_cond) ((void) (_cond))
+typedef int m2c_thread_handle_t;
+#define M2C_THREAD_YIELD() ((void) 0)
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_thread_entry_f
+ * --------------------------------------------------------------------------
+ * Type of the function a thread runs.  It is called with the argument
+ * passed to m2c_thread_start(), the thread ends when it returns.
+ * ----------------------------------------------------------------------- */
+
+typedef void (*m2c_thread_entry_f) (void *arg);
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_thread_t
+ * --------------------------------------------------------------------------
+ * record type representing a thread.  Its fields are private to m2-thread.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* handle */ m2c_thread_handle_t handle;
+  /* entry */ m2c_thread_entry_f entry;
+  /* arg */ void *arg;
+} m2c_thread_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_thread_start(thread, entry, arg)
+ * --------------------------------------------------------------------------
+ * Starts a thread that calls entry with arg, passes it back in thread and
+ * returns true.  Returns false if the thread could not be created or the
+ * host has no supported thread API.  The record thread must remain valid
+ * until the thread has been joined by calling m2c_thread_join().
+ * ----------------------------------------------------------------------- */
+
+bool m2c_thread_start
+  (m2c_thread_t *thread, m2c_thread_entry_f entry, void *arg);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_thread_join(thread)
+ * --------------------------------------------------------------------------
+ * Waits for a thread started by m2c_thread_start() to finish and releases
+ * it.  Each started thread must be joined exactly once.
+ * ----------------------------------------------------------------------- */
+
+void m2c_thread_join (m2c_thread_t *thread);
+
+
+#endif /* M2C_THREAD_H */
+
+/* END OF FILE */
@@ -0,0 +1,277 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015-2016 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * m2-phase-timing.c
+ *
+ * Implementation of M2C phase timing.
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute and/or modify it under the
+ * terms of the GNU Lesser General Public License (LGPL) either version 2.1
+ * or at your choice version 3 as published by the Free Software Foundation.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+
+#include "m2-phase-timing.h"
+
+#include <string.h>
+#include <inttypes.h>
+#include <time.h>
+
+
+/* --------------------------------------------------------------------------
+ * Maximum length of an output line
+ * --------------------------------------------------------------------------
+ * A line holds fixed text of around 350 characters plus the path of the
+ * source.  Longer paths are truncated.
+ * ----------------------------------------------------------------------- */
+
+#define M2C_PHASE_LINE_LIMIT 2048
+
+#define M2C_PHASE_PATH_LIMIT 1024
+
+
+/* --------------------------------------------------------------------------
+ * Phase names
+ * ----------------------------------------------------------------------- */
+
+static const char *phase_name[M2C_PHASE_COUNT] = {
+  "options",
+  "paths",
+  "load",
+  "lex",
+  "parse",
+  "symtab",
+  "write_ast",
+  "write_dot",
+  "write_sym",
+  "write_c",
+  "write_r10"
+}; /* end phase_name */
+
+
+/* --------------------------------------------------------------------------
+ * Forward declarations
+ * ----------------------------------------------------------------------- */
+
+static void copy_escaped (char *target, const char *source, size_t limit);
+
+static uint64_t per_second (uint64_t count, uint64_t ns);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_phase_clock()
+ * --------------------------------------------------------------------------
+ * Returns the current value of a monotonic clock in nanoseconds.
+ * ----------------------------------------------------------------------- */
+
+uint64_t m2c_phase_clock (void) {
+  
+#if defined(CLOCK_MONOTONIC)
+  struct timespec now;
+  
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint64_t) now.tv_sec * 1000000000u + (uint64_t) now.tv_nsec;
+#else /* no monotonic clock, fall back on processor time */
+  return (uint64_t) clock() * (1000000000u / CLOCKS_PER_SEC);
+#endif
+} /* end m2c_phase_clock */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_phase_timing_reset(timing)
+ * --------------------------------------------------------------------------
+ * Clears all phase times, the byte count and the token count of timing.
+ * ----------------------------------------------------------------------- */
+
+void m2c_phase_timing_reset (m2c_phase_timing_t *timing) {
+  
+  uint_fast32_t index;
+  
+  if (timing == NULL) {
+    return;
+  } /* end if */
+  
+  for (index = 0; index < M2C_PHASE_COUNT; index++) {
+    timing->elapsed[index] = 0;
+  } /* end for */
+  
+  timing->bytes = 0;
+  timing->tokens = 0;
+} /* end m2c_phase_timing_reset */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_phase_timing_add(timing, phase, start)
+ * --------------------------------------------------------------------------
+ * Adds the time elapsed since clock value start to the time of phase in
+ * timing and returns the current clock value, so that the end of a phase
+ * may serve as the start of the next.  If timing is NULL, only the current
+ * clock value is returned.
+ * ----------------------------------------------------------------------- */
+
+uint64_t m2c_phase_timing_add
+  (m2c_phase_timing_t *timing, m2c_phase_t phase, uint64_t start) {
+  
+  uint64_t now;
+  
+  now = m2c_phase_clock();
+  
+  if ((timing != NULL) &&
+      ((uint_fast32_t) phase < M2C_PHASE_COUNT) && (now > start)) {
+    timing->elapsed[phase] += now - start;
+  } /* end if */
+  
+  return now;
+} /* end m2c_phase_timing_add */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_phase_name(phase)
+ * --------------------------------------------------------------------------
+ * Returns the name of phase as used in the output, or NULL if phase is not
+ * a valid phase.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_phase_name (m2c_phase_t phase) {
+  
+  if ((uint_fast32_t) phase >= M2C_PHASE_COUNT) {
+    return NULL;
+  } /* end if */
+  
+  return phase_name[phase];
+} /* end m2c_phase_name */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_phase_timing_write(file, srcpath, timing)
+ * --------------------------------------------------------------------------
+ * Writes timing as a single line JSON object to file.  The object holds
+ * srcpath, the byte and token counts, the time of each phase and the total
+ * in nanoseconds, and bytes and tokens per second.  Throughput is taken
+ * over the time spent loading, lexing and parsing, it is zero if no such
+ * time has been recorded.  The line is written in a single call, lines
+ * of concurrent writers appending to the same file are thus not mixed.
+ * ----------------------------------------------------------------------- */
+
+void m2c_phase_timing_write
+  (FILE *file, const char *srcpath, const m2c_phase_timing_t *timing) {
+  
+  char line[M2C_PHASE_LINE_LIMIT];
+  char path[M2C_PHASE_PATH_LIMIT];
+  uint64_t total, front_end;
+  uint_fast32_t index;
+  size_t length;
+  
+  if ((file == NULL) || (srcpath == NULL) || (timing == NULL)) {
+    return;
+  } /* end if */
+  
+  copy_escaped(path, srcpath, M2C_PHASE_PATH_LIMIT);
+  
+  length = (size_t) snprintf(line, M2C_PHASE_LINE_LIMIT,
+    "{\"file\":\"%s\",\"bytes\":%" PRIu64 ",\"tokens\":%" PRIu64
+    ",\"phases_ns\":{", path, timing->bytes, timing->tokens);
+  
+  total = 0;
+  for (index = 0; index < M2C_PHASE_COUNT; index++) {
+    length += (size_t) snprintf(line + length, M2C_PHASE_LINE_LIMIT - length,
+      "%s\"%s\":%" PRIu64, (index == 0) ? "" : ",",
+      phase_name[index], timing->elapsed[index]);
+    total = total + timing->elapsed[index];
+  } /* end for */
+  
+  front_end = timing->elapsed[M2C_PHASE_LOAD] +
+    timing->elapsed[M2C_PHASE_LEX] + timing->elapsed[M2C_PHASE_PARSE];
+  
+  snprintf(line + length, M2C_PHASE_LINE_LIMIT - length,
+    "},\"total_ns\":%" PRIu64 ",\"bytes_per_s\":%" PRIu64
+    ",\"tokens_per_s\":%" PRIu64 "}\n", total,
+    per_second(timing->bytes, front_end),
+    per_second(timing->tokens, front_end));
+  
+  fputs(line, file);
+  fflush(file);
+} /* end m2c_phase_timing_write */
+
+
+/* *********************************************************************** *
+ * Private Functions                                                       *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private procedure copy_escaped(target, source, limit)
+ * --------------------------------------------------------------------------
+ * Copies source to target as the contents of a JSON string, escaping
+ * quotation marks, backslashes and control characters.  At most limit
+ * characters including the terminating NUL are written to target, the
+ * copy is truncated at a character boundary if source does not fit.
+ * ----------------------------------------------------------------------- */
+
+static void copy_escaped (char *target, const char *source, size_t limit) {
+  
+  size_t index;
+  unsigned char ch;
+  
+  index = 0;
+  while ((*source != '\0') && (index + 7 < limit)) {
+    ch = (unsigned char) *source;
+    
+    if ((ch == '"') || (ch == '\\')) {
+      target[index++] = '\\';
+      target[index++] = (char) ch;
+    }
+    else if (ch < 0x20) {
+      index += (size_t) sprintf(target + index, "\\u%04x", ch);
+    }
+    else {
+      target[index++] = (char) ch;
+    } /* end if */
+    
+    source++;
+  } /* end while */
+  
+  target[index] = '\0';
+} /* end copy_escaped */
+
+
+/* --------------------------------------------------------------------------
+ * private function per_second(count, ns)
+ * --------------------------------------------------------------------------
+ * Returns count per second for count events in ns nanoseconds, or zero
+ * if ns is zero.
+ * ----------------------------------------------------------------------- */
+
+static uint64_t per_second (uint64_t count, uint64_t ns) {
+  
+  if (ns == 0) {
+    return 0;
+  } /* end if */
+  
+  return (uint64_t) (((double) count * 1.0e9) / (double) ns);
+} /* end per_second */
+
+
+/* END OF FILE */
@@ -0,0 +1,155 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015-2016 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * m2-phase-timing.h
+ *
+ * Public interface for M2C phase timing.
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute and/or modify it under the
+ * terms of the GNU Lesser General Public License (LGPL) either version 2.1
+ * or at your choice version 3 as published by the Free Software Foundation.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+
+#ifndef M2C_PHASE_TIMING_H
+#define M2C_PHASE_TIMING_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+
+/* --------------------------------------------------------------------------
+ * Phase timing
+ * --------------------------------------------------------------------------
+ * A timing record holds the time spent in each phase of the translation of
+ * a source file, in nanoseconds of a monotonic clock, together with the
+ * size of the source in bytes and the number of tokens consumed.  Phases
+ * are timed by whoever carries them out, the driver times phases of its
+ * own, the parser times loading, lexing and parsing.  Unless the source is
+ * tokenized up front, lexing is interleaved with parsing and its time is
+ * then included in the time of the parse phase.  Records are written as
+ * JSON lines, one line per source file.
+ * ----------------------------------------------------------------------- */
+
+#define M2C_PHASE_TIMING_OUTPUT_FILE "m2c-timing.jsonl"
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_phase_t
+ * --------------------------------------------------------------------------
+ * Enumeration representing the timed phases of a translation.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_PHASE_OPTIONS,    /* command line option parsing */
+  M2C_PHASE_PATHS,      /* derivation of input and output paths */
+  M2C_PHASE_LOAD,       /* loading of the input file */
+  M2C_PHASE_LEX,        /* lexing, unless interleaved with parsing */
+  M2C_PHASE_PARSE,      /* parsing and AST construction */
+  M2C_PHASE_SYMTAB,     /* symbol table construction */
+  M2C_PHASE_WRITE_AST,  /* AST writer */
+  M2C_PHASE_WRITE_DOT,  /* DOT writer */
+  M2C_PHASE_WRITE_SYM,  /* symbol file writer */
+  M2C_PHASE_WRITE_C,    /* C writer */
+  M2C_PHASE_WRITE_R10   /* M2R10 writer */
+} m2c_phase_t;
+
+#define M2C_PHASE_COUNT (M2C_PHASE_WRITE_R10 + 1)
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_phase_timing_t
+ * --------------------------------------------------------------------------
+ * Record type representing the phase times of the translation of a source
+ * file, its size in bytes and the number of its tokens consumed.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* elapsed */ uint64_t elapsed[M2C_PHASE_COUNT];
+  /* bytes */ uint64_t bytes;
+  /* tokens */ uint64_t tokens;
+} m2c_phase_timing_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_phase_clock()
+ * --------------------------------------------------------------------------
+ * Returns the current value of a monotonic clock in nanoseconds.
+ * ----------------------------------------------------------------------- */
+
+uint64_t m2c_phase_clock (void);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_phase_timing_reset(timing)
+ * --------------------------------------------------------------------------
+ * Clears all phase times, the byte count and the token count of timing.
+ * ----------------------------------------------------------------------- */
+
+void m2c_phase_timing_reset (m2c_phase_timing_t *timing);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_phase_timing_add(timing, phase, start)
+ * --------------------------------------------------------------------------
+ * Adds the time elapsed since clock value start to the time of phase in
+ * timing and returns the current clock value, so that the end of a phase
+ * may serve as the start of the next.  If timing is NULL, only the current
+ * clock value is returned.
+ * ----------------------------------------------------------------------- */
+
+uint64_t m2c_phase_timing_add
+  (m2c_phase_timing_t *timing, m2c_phase_t phase, uint64_t start);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_phase_name(phase)
+ * --------------------------------------------------------------------------
+ * Returns the name of phase as used in the output, or NULL if phase is not
+ * a valid phase.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_phase_name (m2c_phase_t phase);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_phase_timing_write(file, srcpath, timing)
+ * --------------------------------------------------------------------------
+ * Writes timing as a single line JSON object to file.  The object holds
+ * srcpath, the byte and token counts, the time of each phase and the total
+ * in nanoseconds, and bytes and tokens per second.  Throughput is taken
+ * over the time spent loading, lexing and parsing, it is zero if no such
+ * time has been recorded.  The line is written in a single call, lines
+ * of concurrent writers appending to the same file are thus not mixed.
+ * ----------------------------------------------------------------------- */
+
+void m2c_phase_timing_write
+  (FILE *file, const char *srcpath, const m2c_phase_timing_t *timing);
+
+
+#endif /* M2C_PHASE_TIMING_H */
+
+/* END OF FILE */
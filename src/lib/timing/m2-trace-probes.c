@@ -0,0 +1,91 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015-2016 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * m2-trace-probes.c
+ *
+ * Implementation of M2C static trace probes.
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute and/or modify it under the
+ * terms of the GNU Lesser General Public License (LGPL) either version 2.1
+ * or at your choice version 3 as published by the Free Software Foundation.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+
+#include "m2-trace-probes.h"
+
+
+#if defined(M2C_TRACE_ETW)
+
+#include <stdlib.h>
+
+
+/* --------------------------------------------------------------------------
+ * ETW provider
+ * --------------------------------------------------------------------------
+ * Provider M2C with a fixed GUID, so that trace sessions may enable it by
+ * GUID as well as by name.
+ * ----------------------------------------------------------------------- */
+
+TRACELOGGING_DEFINE_PROVIDER(m2c_trace_provider, "M2C",
+  (0x5d3c8f1e, 0x2b7a, 0x4c1e, 0x9a, 0x63, 0x1f, 0x0e, 0x7d, 0x2c, 0x4b, 0x58));
+
+
+/* --------------------------------------------------------------------------
+ * private procedure unregister_provider()
+ * --------------------------------------------------------------------------
+ * Unregisters the ETW provider, installed as an exit handler.
+ * ----------------------------------------------------------------------- */
+
+static void unregister_provider (void) {
+  
+  TraceLoggingUnregister(m2c_trace_provider);
+  return;
+} /* end unregister_provider */
+
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_trace_probes_init()
+ * --------------------------------------------------------------------------
+ * Registers the ETW provider of the probes and arranges for it to be
+ * unregistered at exit.  Does nothing unless ETW probes are compiled in.
+ * Must be called before any other thread is started.
+ * ----------------------------------------------------------------------- */
+
+void m2c_trace_probes_init (void) {
+  
+#if defined(M2C_TRACE_ETW)
+  if (SUCCEEDED(TraceLoggingRegister(m2c_trace_provider))) {
+    atexit(unregister_provider);
+  } /* end if */
+#endif
+  
+  return;
+} /* end m2c_trace_probes_init */
+
+
+/* END OF FILE */
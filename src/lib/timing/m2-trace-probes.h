@@ -0,0 +1,197 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015-2016 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * m2-trace-probes.h
+ *
+ * Public interface for M2C static trace probes.
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute and/or modify it under the
+ * terms of the GNU Lesser General Public License (LGPL) either version 2.1
+ * or at your choice version 3 as published by the Free Software Foundation.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#ifndef M2C_TRACE_PROBES_H
+#define M2C_TRACE_PROBES_H
+
+#include <stdint.h>
+
+
+/* --------------------------------------------------------------------------
+ * Static trace probes
+ * --------------------------------------------------------------------------
+ * Probes mark the boundaries of front-end phases for tracing tools in a
+ * production build.  They are compiled in only if M2C_TRACE_PROBES is
+ * defined, otherwise they expand to nothing and their arguments are not
+ * evaluated.  On Linux and macOS, probes are USDT probes of provider m2c
+ * for use with bpftrace, perf, SystemTap or DTrace, <sys/sdt.h> must then
+ * be available.  On Windows, probes are TraceLogging events of an ETW
+ * provider named M2C, which is registered by m2c_trace_probes_init().
+ *
+ * Probe           Arguments
+ *
+ * file-open       pathname, size in bytes
+ * file-close      pathname
+ * parse-start     pathname
+ * parse-end       pathname, error count
+ * resync          line, column
+ * string-grow     old capacity, new capacity
+ * write-start     writer name, target pathname
+ * write-end       writer name, target pathname, status
+ *
+ * Pathnames and writer names are NUL terminated C strings.  USDT probe
+ * names use a double underscore in place of a dash, as in file__open.
+ * ----------------------------------------------------------------------- */
+
+#if defined(M2C_TRACE_PROBES) && \
+    ((defined(__linux__)) || (defined(__MACH__)))
+#include <sys/sdt.h>
+#define M2C_TRACE_USDT
+
+#elif defined(M2C_TRACE_PROBES) && (defined(_WIN32))
+#include <windows.h>
+#include <TraceLoggingProvider.h>
+#define M2C_TRACE_ETW
+
+TRACELOGGING_DECLARE_PROVIDER(m2c_trace_provider);
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * USDT probes
+ * ----------------------------------------------------------------------- */
+
+#if defined(M2C_TRACE_USDT)
+
+#define M2C_TRACE_FILE_OPEN(_path,_size) \
+  DTRACE_PROBE2(m2c, file__open, (_path), (uint64_t) (_size))
+
+#define M2C_TRACE_FILE_CLOSE(_path) \
+  DTRACE_PROBE1(m2c, file__close, (_path))
+
+#define M2C_TRACE_PARSE_START(_path) \
+  DTRACE_PROBE1(m2c, parse__start, (_path))
+
+#define M2C_TRACE_PARSE_END(_path,_errors) \
+  DTRACE_PROBE2(m2c, parse__end, (_path), (uint32_t) (_errors))
+
+#define M2C_TRACE_RESYNC(_line,_column) \
+  DTRACE_PROBE2(m2c, resync, (uint32_t) (_line), (uint32_t) (_column))
+
+#define M2C_TRACE_STRING_GROW(_old,_new) \
+  DTRACE_PROBE2(m2c, string__grow, (uint32_t) (_old), (uint32_t) (_new))
+
+#define M2C_TRACE_WRITE_START(_writer,_path) \
+  DTRACE_PROBE2(m2c, write__start, (_writer), (_path))
+
+#define M2C_TRACE_WRITE_END(_writer,_path,_status) \
+  DTRACE_PROBE3(m2c, write__end, (_writer), (_path), (int32_t) (_status))
+
+
+/* --------------------------------------------------------------------------
+ * ETW probes
+ * ----------------------------------------------------------------------- */
+
+#elif defined(M2C_TRACE_ETW)
+
+#define M2C_TRACE_FILE_OPEN(_path,_size) \
+  TraceLoggingWrite(m2c_trace_provider, "file-open", \
+    TraceLoggingString((_path), "path"), \
+    TraceLoggingUInt64((uint64_t) (_size), "size"))
+
+#define M2C_TRACE_FILE_CLOSE(_path) \
+  TraceLoggingWrite(m2c_trace_provider, "file-close", \
+    TraceLoggingString((_path), "path"))
+
+#define M2C_TRACE_PARSE_START(_path) \
+  TraceLoggingWrite(m2c_trace_provider, "parse-start", \
+    TraceLoggingString((_path), "path"))
+
+#define M2C_TRACE_PARSE_END(_path,_errors) \
+  TraceLoggingWrite(m2c_trace_provider, "parse-end", \
+    TraceLoggingString((_path), "path"), \
+    TraceLoggingUInt32((uint32_t) (_errors), "errors"))
+
+#define M2C_TRACE_RESYNC(_line,_column) \
+  TraceLoggingWrite(m2c_trace_provider, "resync", \
+    TraceLoggingUInt32((uint32_t) (_line), "line"), \
+    TraceLoggingUInt32((uint32_t) (_column), "column"))
+
+#define M2C_TRACE_STRING_GROW(_old,_new) \
+  TraceLoggingWrite(m2c_trace_provider, "string-grow", \
+    TraceLoggingUInt32((uint32_t) (_old), "old"), \
+    TraceLoggingUInt32((uint32_t) (_new), "new"))
+
+#define M2C_TRACE_WRITE_START(_writer,_path) \
+  TraceLoggingWrite(m2c_trace_provider, "write-start", \
+    TraceLoggingString((_writer), "writer"), \
+    TraceLoggingString((_path), "path"))
+
+#define M2C_TRACE_WRITE_END(_writer,_path,_status) \
+  TraceLoggingWrite(m2c_trace_provider, "write-end", \
+    TraceLoggingString((_writer), "writer"), \
+    TraceLoggingString((_path), "path"), \
+    TraceLoggingInt32((int32_t) (_status), "status"))
+
+
+/* --------------------------------------------------------------------------
+ * Probes disabled
+ * ----------------------------------------------------------------------- */
+
+#else
+
+#define M2C_TRACE_FILE_OPEN(_path,_size) ((void) 0)
+
+#define M2C_TRACE_FILE_CLOSE(_path) ((void) 0)
+
+#define M2C_TRACE_PARSE_START(_path) ((void) 0)
+
+#define M2C_TRACE_PARSE_END(_path,_errors) ((void) 0)
+
+#define M2C_TRACE_RESYNC(_line,_column) ((void) 0)
+
+#define M2C_TRACE_STRING_GROW(_old,_new) ((void) 0)
+
+#define M2C_TRACE_WRITE_START(_writer,_path) ((void) 0)
+
+#define M2C_TRACE_WRITE_END(_writer,_path,_status) ((void) 0)
+
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_trace_probes_init()
+ * --------------------------------------------------------------------------
+ * Registers the ETW provider of the probes and arranges for it to be
+ * unregistered at exit.  Does nothing unless ETW probes are compiled in.
+ * Must be called before any other thread is started.
+ * ----------------------------------------------------------------------- */
+
+void m2c_trace_probes_init (void);
+
+
+#endif /* M2C_TRACE_PROBES_H */
+
+/* END OF FILE */
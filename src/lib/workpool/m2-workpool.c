@@ -0,0 +1,622 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015-2016 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * m2-workpool.c
+ *
+ * Implementation of M2C work stealing worker pool.
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute and/or modify it under the
+ * terms of the GNU Lesser General Public License (LGPL) either version 2.1
+ * or at your choice version 3 as published by the Free Software Foundation.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#include "m2-workpool.h"
+#include "m2-thread.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * Worker threads
+ * --------------------------------------------------------------------------
+ * Hosts without a supported thread API have no worker threads, submitted
+ * jobs are then carried out by the thread that runs the pool.
+ * ----------------------------------------------------------------------- */
+
+#define M2C_WORKPOOL_THREADS (M2C_THREADS_AVAILABLE)
+
+
+/* --------------------------------------------------------------------------
+ * Initial job queue capacity, must be a power of two
+ * ----------------------------------------------------------------------- */
+
+#define M2C_WORKPOOL_QUEUE_INIT_CAPACITY 16
+
+
+/* --------------------------------------------------------------------------
+ * private type m2c_workpool_queue_s
+ * --------------------------------------------------------------------------
+ * record type representing the job queue of a worker.  The queue is a ring
+ * buffer whose capacity is a power of two, it grows when full.  The owner
+ * takes jobs at the head, other workers steal jobs at the tail.
+ * ----------------------------------------------------------------------- */
+
+struct m2c_workpool_queue_s {
+  /* lock */ m2c_lock_t lock;
+  /* head_index */ uint_t head_index;
+  /* entry_count */ uint_t entry_count;
+  /* capacity */ uint_t capacity;
+  /* job */ void **job;
+};
+
+typedef struct m2c_workpool_queue_s m2c_workpool_queue_s;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_workpool_struct_t
+ * --------------------------------------------------------------------------
+ * record type representing a worker pool object.  Field pending_count is
+ * the number of jobs submitted but not yet completed, field queued_count
+ * the number of jobs submitted but not yet taken by a worker.  Both are
+ * protected by the pool lock.
+ * ----------------------------------------------------------------------- */
+
+struct m2c_workpool_struct_t {
+  /* handler */ m2c_workpool_job_f handler;
+  /* context */ void *context;
+  /* lock */ m2c_lock_t lock;
+  /* work_available */ m2c_cond_t work_available;
+  /* pending_count */ uint_t pending_count;
+  /* queued_count */ uint_t queued_count;
+  /* worker_count */ uint_t worker_count;
+  /* queue */ m2c_workpool_queue_s queue[];
+};
+
+typedef struct m2c_workpool_struct_t m2c_workpool_struct_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type m2c_workpool_worker_s
+ * --------------------------------------------------------------------------
+ * record type representing the start argument of a worker thread.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* pool */ m2c_workpool_t pool;
+  /* index */ uint_t index;
+} m2c_workpool_worker_s;
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static void worker_loop (m2c_workpool_t pool, uint_t index);
+
+static void *take_job (m2c_workpool_t pool, uint_t index);
+
+static bool queue_push (m2c_workpool_queue_s *queue, void *job);
+
+static void *queue_pop_head (m2c_workpool_queue_s *queue);
+
+static void *queue_pop_tail (m2c_workpool_queue_s *queue);
+
+#if (M2C_WORKPOOL_THREADS)
+static void worker_main (void *arg);
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_workpool_default_worker_count()
+ * --------------------------------------------------------------------------
+ * Returns the number of processors available on the host system, limited
+ * to M2C_WORKPOOL_MAX_WORKERS, or 1 if it cannot be determined.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_workpool_default_worker_count (void) {
+  long count;
+  
+#if defined(_WIN32)
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  count = (long) info.dwNumberOfProcessors;
+#elif (M2C_WORKPOOL_THREADS) && defined(_SC_NPROCESSORS_ONLN)
+  count = sysconf(_SC_NPROCESSORS_ONLN);
+#else
+  count = 1;
+#endif
+  
+  if (count < 1) {
+    return 1;
+  }
+  else if (count > M2C_WORKPOOL_MAX_WORKERS) {
+    return M2C_WORKPOOL_MAX_WORKERS;
+  } /* end if */
+  
+  return (uint_t) count;
+} /* end m2c_workpool_default_worker_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_new_workpool(worker_count, handler, context, status)
+ * --------------------------------------------------------------------------
+ * Allocates and returns a new worker pool with worker_count workers, each
+ * with its own job queue.  Jobs are carried out by calling handler with
+ * context.  A worker_count of zero selects the default worker count.
+ * ----------------------------------------------------------------------- */
+
+m2c_workpool_t m2c_new_workpool
+  (uint_t worker_count, m2c_workpool_job_f handler, void *context,
+   m2c_workpool_status_t *status) {
+
+  m2c_workpool_t pool;
+  uint_t index;
+
+  if (handler == NULL) {
+    SET_STATUS(status, M2C_WORKPOOL_STATUS_INVALID_REFERENCE);
+    return NULL;
+  } /* end if */
+
+  if (worker_count == 0) {
+    worker_count = m2c_workpool_default_worker_count();
+  }
+  else if (worker_count > M2C_WORKPOOL_MAX_WORKERS) {
+    worker_count = M2C_WORKPOOL_MAX_WORKERS;
+  } /* end if */
+
+  /* allocate pool with one queue per worker */
+  pool = malloc
+    (sizeof(m2c_workpool_struct_t) +
+     worker_count * sizeof(m2c_workpool_queue_s));
+
+  if (pool == NULL) {
+    SET_STATUS(status, M2C_WORKPOOL_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+
+  /* allocate job tables */
+  for (index = 0; index < worker_count; index++) {
+    pool->queue[index].job =
+      malloc(M2C_WORKPOOL_QUEUE_INIT_CAPACITY * sizeof(void *));
+
+    /* bail out if allocation failed */
+    if (pool->queue[index].job == NULL) {
+      while (index > 0) {
+        index--;
+        free(pool->queue[index].job);
+      } /* end while */
+      free(pool);
+      SET_STATUS(status, M2C_WORKPOOL_STATUS_ALLOCATION_FAILED);
+      return NULL;
+    } /* end if */
+  } /* end for */
+
+  /* initialise queues */
+  for (index = 0; index < worker_count; index++) {
+    pool->queue[index].head_index = 0;
+    pool->queue[index].entry_count = 0;
+    pool->queue[index].capacity = M2C_WORKPOOL_QUEUE_INIT_CAPACITY;
+    M2C_LOCK_INIT(&pool->queue[index].lock);
+  } /* end for */
+
+  /* initialise pool */
+  pool->handler = handler;
+  pool->context = context;
+  pool->pending_count = 0;
+  pool->queued_count = 0;
+  pool->worker_count = worker_count;
+  M2C_LOCK_INIT(&pool->lock);
+  M2C_COND_INIT(&pool->work_available);
+  
+  SET_STATUS(status, M2C_WORKPOOL_STATUS_SUCCESS);
+  return pool;
+} /* end m2c_new_workpool */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_workpool_worker_count(pool)
+ * --------------------------------------------------------------------------
+ * Returns the number of workers of pool, or zero if pool is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_workpool_worker_count (m2c_workpool_t pool) {
+  
+  if (pool == NULL) {
+    return 0;
+  } /* end if */
+  
+  return pool->worker_count;
+} /* end m2c_workpool_worker_count */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_workpool_submit(pool, worker, job, status)
+ * --------------------------------------------------------------------------
+ * Adds job to the job queue of the given worker of pool.  The worker index
+ * is taken modulo the worker count.
+ * ----------------------------------------------------------------------- */
+
+void m2c_workpool_submit
+  (m2c_workpool_t pool, uint_t worker, void *job,
+   m2c_workpool_status_t *status) {
+
+  m2c_workpool_queue_s *queue;
+  bool queued;
+
+  if (pool == NULL) {
+    SET_STATUS(status, M2C_WORKPOOL_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+
+  /* count the job as pending before any worker can complete it */
+  M2C_LOCK_ACQUIRE(&pool->lock);
+  pool->pending_count++;
+  pool->queued_count++;
+  M2C_LOCK_RELEASE(&pool->lock);
+  
+  queue = &pool->queue[worker % pool->worker_count];
+  
+  M2C_LOCK_ACQUIRE(&queue->lock);
+  queued = queue_push(queue, job);
+  M2C_LOCK_RELEASE(&queue->lock);
+  
+  M2C_LOCK_ACQUIRE(&pool->lock);
+  if (queued) {
+    M2C_COND_BROADCAST(&pool->work_available);
+  }
+  else /* allocation failed, withdraw the job */ {
+    pool->pending_count--;
+    pool->queued_count--;
+    if (pool->pending_count == 0) {
+      M2C_COND_BROADCAST(&pool->work_available);
+    } /* end if */
+  } /* end if */
+  M2C_LOCK_RELEASE(&pool->lock);
+  
+  if (queued) {
+    SET_STATUS(status, M2C_WORKPOOL_STATUS_SUCCESS);
+  }
+  else {
+    SET_STATUS(status, M2C_WORKPOOL_STATUS_ALLOCATION_FAILED);
+  } /* end if */
+
+  return;
+} /* end m2c_workpool_submit */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_workpool_decrement(pool, counter)
+ * --------------------------------------------------------------------------
+ * Decrements the value at counter under the lock of pool and returns the
+ * new value.  Returns zero if pool or counter is NULL or if the value is
+ * already zero.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_workpool_decrement (m2c_workpool_t pool, uint_t *counter) {
+  
+  uint_t value;
+  
+  if ((pool == NULL) || (counter == NULL)) {
+    return 0;
+  } /* end if */
+  
+  M2C_LOCK_ACQUIRE(&pool->lock);
+  if (*counter > 0) {
+    *counter = *counter - 1;
+  } /* end if */
+  value = *counter;
+  M2C_LOCK_RELEASE(&pool->lock);
+  
+  return value;
+} /* end m2c_workpool_decrement */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_workpool_run(pool, status)
+ * --------------------------------------------------------------------------
+ * Runs the workers of pool until all submitted jobs have been carried out,
+ * including jobs submitted by job handlers.  The calling thread acts as
+ * worker zero.
+ * ----------------------------------------------------------------------- */
+
+void m2c_workpool_run (m2c_workpool_t pool, m2c_workpool_status_t *status) {
+  
+#if (M2C_WORKPOOL_THREADS)
+  m2c_thread_t *thread;
+  m2c_workpool_worker_s *worker;
+  uint_t index, started;
+#endif
+  m2c_workpool_status_t run_status;
+  
+  if (pool == NULL) {
+    SET_STATUS(status, M2C_WORKPOOL_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  run_status = M2C_WORKPOOL_STATUS_SUCCESS;
+  
+#if (M2C_WORKPOOL_THREADS)
+  /* start worker threads for workers 1 to worker_count-1 */
+  started = 0;
+  thread = NULL;
+  worker = NULL;
+  
+  if (pool->worker_count > 1) {
+    thread = malloc(pool->worker_count * sizeof(m2c_thread_t));
+    worker = malloc(pool->worker_count * sizeof(m2c_workpool_worker_s));
+  
+    if ((thread == NULL) || (worker == NULL)) {
+      run_status = M2C_WORKPOOL_STATUS_THREAD_CREATION_FAILED;
+    }
+    else {
+      for (index = 1; index < pool->worker_count; index++) {
+        worker[started].pool = pool;
+        worker[started].index = index;
+  
+        if (m2c_thread_start
+              (&thread[started], worker_main, &worker[started])) {
+          started++;
+        }
+        else {
+          run_status = M2C_WORKPOOL_STATUS_THREAD_CREATION_FAILED;
+        } /* end if */
+      } /* end for */
+    } /* end if */
+  } /* end if */
+#endif
+  
+  /* the calling thread is worker zero */
+  worker_loop(pool, 0);
+  
+#if (M2C_WORKPOOL_THREADS)
+  /* wait for worker threads to finish */
+  for (index = 0; index < started; index++) {
+    m2c_thread_join(&thread[index]);
+  } /* end for */
+  
+  free(thread);
+  free(worker);
+#endif
+  
+  SET_STATUS(status, run_status);
+  return;
+} /* end m2c_workpool_run */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_release_workpool(pool)
+ * --------------------------------------------------------------------------
+ * Deallocates pool.  Jobs still queued are discarded, the jobs themselves
+ * are not deallocated.
+ * ----------------------------------------------------------------------- */
+
+void m2c_release_workpool (m2c_workpool_t pool) {
+  
+  uint_t index;
+  
+  if (pool == NULL) {
+    return;
+  } /* end if */
+  
+  for (index = 0; index < pool->worker_count; index++) {
+    free(pool->queue[index].job);
+    M2C_LOCK_DISPOSE(&pool->queue[index].lock);
+  } /* end for */
+  
+  M2C_COND_DISPOSE(&pool->work_available);
+  M2C_LOCK_DISPOSE(&pool->lock);
+  free(pool);
+  
+  return;
+} /* end m2c_release_workpool */
+
+
+/* *********************************************************************** *
+ * Private Functions                                                       *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private procedure worker_loop(pool, index)
+ * --------------------------------------------------------------------------
+ * Carries out jobs as worker index of pool until no jobs are pending.
+ * When no job can be taken while other jobs are still in progress, waits
+ * until a job has been submitted or all jobs have been completed.
+ * ----------------------------------------------------------------------- */
+
+static void worker_loop (m2c_workpool_t pool, uint_t index) {
+  
+  void *job;
+  bool done;
+  
+  done = false;
+  while (NOT(done)) {
+    job = take_job(pool, index);
+  
+    if (job != NULL) {
+      pool->handler(pool, index, job, pool->context);
+  
+      M2C_LOCK_ACQUIRE(&pool->lock);
+      pool->pending_count--;
+      if (pool->pending_count == 0) {
+        M2C_COND_BROADCAST(&pool->work_available);
+      } /* end if */
+      M2C_LOCK_RELEASE(&pool->lock);
+    }
+    else /* no job available */ {
+      M2C_LOCK_ACQUIRE(&pool->lock);
+      while ((pool->pending_count > 0) && (pool->queued_count == 0)) {
+        M2C_COND_WAIT(&pool->work_available, &pool->lock);
+      } /* end while */
+      done = (pool->pending_count == 0);
+      M2C_LOCK_RELEASE(&pool->lock);
+    } /* end if */
+  } /* end while */
+  
+  return;
+} /* end worker_loop */
+
+
+/* --------------------------------------------------------------------------
+ * private function take_job(pool, index)
+ * --------------------------------------------------------------------------
+ * Takes a job from the head of the queue of worker index.  If that queue is
+ * empty, steals a job from the tail of the queue of the next worker that
+ * has one.  Returns the job, or NULL if all queues are empty.
+ * ----------------------------------------------------------------------- */
+
+static void *take_job (m2c_workpool_t pool, uint_t index) {
+  
+  m2c_workpool_queue_s *queue;
+  uint_t offset;
+  void *job;
+  
+  /* own queue first */
+  queue = &pool->queue[index];
+  M2C_LOCK_ACQUIRE(&queue->lock);
+  job = queue_pop_head(queue);
+  M2C_LOCK_RELEASE(&queue->lock);
+  
+  /* otherwise steal */
+  offset = 1;
+  while ((job == NULL) && (offset < pool->worker_count)) {
+    queue = &pool->queue[(index + offset) % pool->worker_count];
+    M2C_LOCK_ACQUIRE(&queue->lock);
+    job = queue_pop_tail(queue);
+    M2C_LOCK_RELEASE(&queue->lock);
+    offset++;
+  } /* end while */
+  
+  if (job != NULL) {
+    M2C_LOCK_ACQUIRE(&pool->lock);
+    pool->queued_count--;
+    M2C_LOCK_RELEASE(&pool->lock);
+  } /* end if */
+  
+  return job;
+} /* end take_job */
+
+
+/* --------------------------------------------------------------------------
+ * private function queue_push(queue, job)
+ * --------------------------------------------------------------------------
+ * Appends job at the tail of queue, growing its ring buffer if it is full.
+ * Returns true on success, false if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static bool queue_push (m2c_workpool_queue_s *queue, void *job) {
+  
+  uint_t index, mask;
+  void **new_job;
+  
+  if (queue->entry_count == queue->capacity) {
+    new_job = malloc(2 * queue->capacity * sizeof(void *));
+  
+    if (new_job == NULL) {
+      return false;
+    } /* end if */
+  
+    /* copy entries in queue order */
+    mask = queue->capacity - 1;
+    for (index = 0; index < queue->entry_count; index++) {
+      new_job[index] = queue->job[(queue->head_index + index) & mask];
+    } /* end for */
+  
+    free(queue->job);
+    queue->job = new_job;
+    queue->head_index = 0;
+    queue->capacity = 2 * queue->capacity;
+  } /* end if */
+  
+  mask = queue->capacity - 1;
+  queue->job[(queue->head_index + queue->entry_count) & mask] = job;
+  queue->entry_count++;
+  
+  return true;
+} /* end queue_push */
+
+
+/* --------------------------------------------------------------------------
+ * private function queue_pop_head(queue)
+ * --------------------------------------------------------------------------
+ * Removes and returns the job at the head of queue, or NULL if it is empty.
+ * ----------------------------------------------------------------------- */
+
+static void *queue_pop_head (m2c_workpool_queue_s *queue) {
+  
+  void *job;
+  
+  if (queue->entry_count == 0) {
+    return NULL;
+  } /* end if */
+  
+  job = queue->job[queue->head_index];
+  queue->head_index = (queue->head_index + 1) & (queue->capacity - 1);
+  queue->entry_count--;
+  
+  return job;
+} /* end queue_pop_head */
+
+
+/* --------------------------------------------------------------------------
+ * private function queue_pop_tail(queue)
+ * --------------------------------------------------------------------------
+ * Removes and returns the job at the tail of queue, or NULL if it is empty.
+ * ----------------------------------------------------------------------- */
+
+static void *queue_pop_tail (m2c_workpool_queue_s *queue) {
+  
+  if (queue->entry_count == 0) {
+    return NULL;
+  } /* end if */
+  
+  queue->entry_count--;
+  
+  return queue->job
+    [(queue->head_index + queue->entry_count) & (queue->capacity - 1)];
+} /* end queue_pop_tail */
+
+
+#if (M2C_WORKPOOL_THREADS)
+/* --------------------------------------------------------------------------
+ * private procedure worker_main(arg)
+ * --------------------------------------------------------------------------
+ * Entry point of a worker thread.  Runs the worker passed in arg.
+ * ----------------------------------------------------------------------- */
+
+static void worker_main (void *arg) {
+  m2c_workpool_worker_s *worker = arg;
+  
+  worker_loop(worker->pool, worker->index);
+} /* end worker_main */
+#endif
+
+
+/* END OF FILE */
@@ -0,0 +1,217 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015-2016 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * m2-workpool.h
+ *
+ * Public interface for M2C work stealing worker pool.
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute and/or modify it under the
+ * terms of the GNU Lesser General Public License (LGPL) either version 2.1
+ * or at your choice version 3 as published by the Free Software Foundation.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#ifndef M2C_WORKPOOL_H
+#define M2C_WORKPOOL_H
+
+#include "m2-common.h"
+
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * Maximum number of workers per pool
+ * ----------------------------------------------------------------------- */
+
+#define M2C_WORKPOOL_MAX_WORKERS 256
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_workpool_status_t
+ * --------------------------------------------------------------------------
+ * Status codes for operations on type m2c_workpool_t.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_WORKPOOL_STATUS_SUCCESS,
+  M2C_WORKPOOL_STATUS_INVALID_REFERENCE,
+  M2C_WORKPOOL_STATUS_ALLOCATION_FAILED,
+  M2C_WORKPOOL_STATUS_THREAD_CREATION_FAILED
+} m2c_workpool_status_t;
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2c_workpool_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing a worker pool object.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_workpool_struct_t *m2c_workpool_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_workpool_job_f
+ * --------------------------------------------------------------------------
+ * Type of the handler function that carries out a job.  It is called with
+ * the pool, the index of the worker carrying out the job, the job itself
+ * and the context passed to m2c_new_workpool().  The handler may submit
+ * further jobs to the pool, preferably to its own worker index.
+ * ----------------------------------------------------------------------- */
+
+typedef void (*m2c_workpool_job_f)
+  (m2c_workpool_t pool, uint_t worker, void *job, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_workpool_default_worker_count()
+ * --------------------------------------------------------------------------
+ * Returns the number of processors available on the host system, limited
+ * to M2C_WORKPOOL_MAX_WORKERS, or 1 if it cannot be determined.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_workpool_default_worker_count (void);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_new_workpool(worker_count, handler, context, status)
+ * --------------------------------------------------------------------------
+ * Allocates and returns a new worker pool with worker_count workers, each
+ * with its own job queue.  Jobs are carried out by calling handler with
+ * context.  A worker_count of zero selects the default worker count.
+ *
+ * pre-conditions:
+ * o  parameter handler must not be NULL
+ *
+ * post-conditions:
+ * o  a new pool with empty job queues is returned
+ * o  M2C_WORKPOOL_STATUS_SUCCESS is passed back in status, unless NULL
+ *
+ * error-conditions:
+ * o  if handler is NULL, no operation is carried out, NULL is returned
+ *    and M2C_WORKPOOL_STATUS_INVALID_REFERENCE is passed back in status,
+ *    unless NULL
+ * o  if allocation fails, no operation is carried out, NULL is returned
+ *    and M2C_WORKPOOL_STATUS_ALLOCATION_FAILED is passed back in status,
+ *    unless NULL
+ * ----------------------------------------------------------------------- */
+
+m2c_workpool_t m2c_new_workpool
+  (uint_t worker_count, m2c_workpool_job_f handler, void *context,
+   m2c_workpool_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_workpool_worker_count(pool)
+ * --------------------------------------------------------------------------
+ * Returns the number of workers of pool, or zero if pool is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_workpool_worker_count (m2c_workpool_t pool);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_workpool_submit(pool, worker, job, status)
+ * --------------------------------------------------------------------------
+ * Adds job to the job queue of the given worker of pool.  The worker index
+ * is taken modulo the worker count.  May be called before the pool is run
+ * and from within a job handler while it is running.
+ *
+ * pre-conditions:
+ * o  parameter pool must not be NULL
+ *
+ * post-conditions:
+ * o  job is queued and will be carried out by the pool
+ * o  M2C_WORKPOOL_STATUS_SUCCESS is passed back in status, unless NULL
+ *
+ * error-conditions:
+ * o  if pool is NULL, no operation is carried out
+ *    and M2C_WORKPOOL_STATUS_INVALID_REFERENCE is passed back in status,
+ *    unless NULL
+ * o  if allocation fails, no operation is carried out
+ *    and M2C_WORKPOOL_STATUS_ALLOCATION_FAILED is passed back in status,
+ *    unless NULL
+ * ----------------------------------------------------------------------- */
+
+void m2c_workpool_submit
+  (m2c_workpool_t pool, uint_t worker, void *job,
+   m2c_workpool_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_workpool_decrement(pool, counter)
+ * --------------------------------------------------------------------------
+ * Decrements the value at counter under the lock of pool and returns the
+ * new value.  Intended for counters shared between jobs, such as the number
+ * of unfinished prerequisites of a job that is to be submitted once they
+ * have all been completed.  Returns zero if pool or counter is NULL or if
+ * the value is already zero.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_workpool_decrement (m2c_workpool_t pool, uint_t *counter);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_workpool_run(pool, status)
+ * --------------------------------------------------------------------------
+ * Runs the workers of pool until all submitted jobs have been carried out,
+ * including jobs submitted by job handlers.  Each worker takes jobs from
+ * the front of its own queue.  A worker whose queue is empty steals jobs
+ * from the back of the queues of other workers.  The calling thread acts
+ * as worker zero.  On hosts without a supported thread API, all jobs are
+ * carried out by the calling thread.
+ *
+ * pre-conditions:
+ * o  parameter pool must not be NULL
+ * o  pool must not already be running
+ *
+ * post-conditions:
+ * o  all job queues of pool are empty
+ * o  M2C_WORKPOOL_STATUS_SUCCESS is passed back in status, unless NULL
+ *
+ * error-conditions:
+ * o  if pool is NULL, no operation is carried out
+ *    and M2C_WORKPOOL_STATUS_INVALID_REFERENCE is passed back in status,
+ *    unless NULL
+ * o  if some worker threads could not be created, the remaining workers
+ *    carry out all jobs and M2C_WORKPOOL_STATUS_THREAD_CREATION_FAILED
+ *    is passed back in status, unless NULL
+ * ----------------------------------------------------------------------- */
+
+void m2c_workpool_run (m2c_workpool_t pool, m2c_workpool_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_release_workpool(pool)
+ * --------------------------------------------------------------------------
+ * Deallocates pool.  Jobs still queued are discarded, the jobs themselves
+ * are not deallocated.  Must not be called while pool is running.
+ * ----------------------------------------------------------------------- */
+
+void m2c_release_workpool (m2c_workpool_t pool);
+
+
+#endif /* M2C_WORKPOOL_H */
+
+/* END OF FILE */
@@ -16,7 +16,12 @@
 #define M2T_COROUTINES_IMPLEMENTED 0
 #define M2T_LOCAL_MODULES_IMPLEMENTED 0
 #define M2T_VARIANT_RECORDS_IMPLEMENTED 1
-#define M2T_COMMENT_PRESRVN_IMPLEMENTED 0
+#define M2T_COMMENT_PRESRVN_IMPLEMENTED 1
+
+/* Profiling Parameters */
+
+#define M2T_PROFILER_STACK_LIMIT 1024
+#define M2T_PROFILER_OUTPUT_FILE "m2t-profile.json"
 
 
 #endif /* M2T_BUILD_PARAMS_H */
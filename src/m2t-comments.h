@@ -0,0 +1,224 @@
+/* M2T -- Sorce to Source Modula-2 Translator
+ *
+ * Copyright (c) 2016-2023 Benjamin Kowarsch
+ *
+ * Author & Maintainer: Benjamin Kowarsch <org.m2sf>
+ *
+ * @synopsis
+ *
+ * M2T is a multi-dialect Modula-2 source-to-source translator. It translates
+ * source files  written in the  classic dialects  to semantically equivalent
+ * source files in  Modula-2 Revision 2010 (M2R10).  It supports  the classic
+ * Modula-2 dialects  described in  the 2nd, 3rd and 4th editions  of Niklaus
+ * Wirth's book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * For more details please visit: https://github.com/trijezdci/m2t/wiki
+ *
+ * @repository
+ *
+ * https://github.com/trijezdci/m2t
+ *
+ * @file
+ *
+ * m2t-comments.h
+ *
+ * Public interface for M2T comment tables.
+ *
+ * @license
+ *
+ * M2T is free software:  You can redistribute and modify it  under the terms
+ * of the  GNU Lesser General Public License (LGPL) either version 2.1  or at
+ * your choice version 3, both as published by the Free Software Foundation.
+ *
+ * M2T is distributed  in the hope  that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even  the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received  a copy of the  GNU Lesser General Public License
+ * along with M2T.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#ifndef M2T_COMMENTS_H
+#define M2T_COMMENTS_H
+
+#include "m2t-common.h"
+#include "ast/m2t-ast.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+/* --------------------------------------------------------------------------
+ * Comment preservation
+ * --------------------------------------------------------------------------
+ * A comment table records the comments of a source as spans of its text,
+ * the text itself is not copied.  Each comment is recorded with the byte
+ * offset of its opening delimiter and its length including delimiters, in
+ * the order in which the comments occur in the source.  Comments that
+ * precede a definition or declaration are attached to the AST node of the
+ * definition or declaration, those preceding the module header to the node
+ * of the module.  Other comments are attached to no node.  Comment text is
+ * obtained from the source the table refers to, it is not limited in
+ * length.  Comments are recorded only by parses that are passed a table.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * type m2t_comment_t
+ * --------------------------------------------------------------------------
+ * record type representing a comment.  Field offset holds the byte offset
+ * of its opening delimiter, field length its length including delimiters
+ * and field node the AST node it is attached to, or NULL if none.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* offset */ uint32_t offset;
+  /* length */ uint32_t length;
+  /* node */ m2t_astnode_t node;
+} m2t_comment_t;
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2t_comment_table_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing a table of comments of a source.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2t_comment_table_s *m2t_comment_table_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_new_comment_table()
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated empty comment table, or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2t_comment_table_t m2t_new_comment_table (void);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_comment_table_set_source(table, source, length, owned)
+ * --------------------------------------------------------------------------
+ * Sets the source text of length bytes that the comments of table refer
+ * to.  If owned is true, source passes to table and is released when table
+ * is released, otherwise it must remain valid for as long as comment text
+ * is obtained from table.  Any source previously owned by table is
+ * released.  Does nothing if table is NULL.
+ * ----------------------------------------------------------------------- */
+
+void m2t_comment_table_set_source
+  (m2t_comment_table_t table, const char *source, size_t length, bool owned);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_comment_table_add(table, offset, length)
+ * --------------------------------------------------------------------------
+ * Appends a comment of length bytes at byte offset to table.  Comments must
+ * be appended in the order in which they occur in the source.  Returns true
+ * on success, or false if table is NULL, if offset precedes the end of the
+ * last comment or if the table could not be grown.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_comment_table_add
+  (m2t_comment_table_t table, uint32_t offset, uint32_t length);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_comment_table_anchor(table, offset)
+ * --------------------------------------------------------------------------
+ * Records offset as the offset of the symbol that follows the comments of
+ * table appended since the last call.  Called by the lexer for each symbol.
+ * Does nothing if table is NULL.
+ * ----------------------------------------------------------------------- */
+
+void m2t_comment_table_anchor (m2t_comment_table_t table, uint32_t offset);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_comment_table_attach(table, first, last, node)
+ * --------------------------------------------------------------------------
+ * Attaches the comments of table that are followed by a symbol at an offset
+ * from first up to and including last to node, replacing any node they
+ * were attached to.  Does nothing if table or node is NULL.
+ * ----------------------------------------------------------------------- */
+
+void m2t_comment_table_attach
+  (m2t_comment_table_t table, uint32_t first, uint32_t last,
+   m2t_astnode_t node);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_comment_table_count(table)
+ * --------------------------------------------------------------------------
+ * Returns the number of comments in table, or zero if table is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2t_comment_table_count (m2t_comment_table_t table);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_comment_table_entry(table, index, comment)
+ * --------------------------------------------------------------------------
+ * Passes the comment at index in table back in comment and returns true.
+ * Returns false and leaves comment unmodified if table is NULL or if index
+ * is out of range.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_comment_table_entry
+  (m2t_comment_table_t table, uint_t index, m2t_comment_t *comment);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_comment_table_index_for_offset(table, offset)
+ * --------------------------------------------------------------------------
+ * Returns the index of the first comment in table that starts at or after
+ * byte offset, or the number of comments if there is none.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2t_comment_table_index_for_offset
+  (m2t_comment_table_t table, uint32_t offset);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_comment_table_find(table, node, first, count)
+ * --------------------------------------------------------------------------
+ * Passes the index of the first comment attached to node in table back in
+ * first and the number of comments attached to node back in count and
+ * returns true.  Comments attached to the same node are adjacent.  Returns
+ * false and leaves first and count unmodified if no comment is attached to
+ * node or if table is NULL.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_comment_table_find
+  (m2t_comment_table_t table, m2t_astnode_t node,
+   uint_t *first, uint_t *count);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_comment_table_text(table, index, length)
+ * --------------------------------------------------------------------------
+ * Returns a pointer to the text of the comment at index in table within
+ * the source of table and passes its length back in length.  The text
+ * includes the delimiters and is NOT NUL terminated.  Returns NULL and
+ * leaves length unmodified if table is NULL, if index is out of range or
+ * if the comment does not lie within the source of table.
+ * ----------------------------------------------------------------------- */
+
+const char *m2t_comment_table_text
+  (m2t_comment_table_t table, uint_t index, uint_t *length);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_release_comment_table(table)
+ * --------------------------------------------------------------------------
+ * Releases the comment table passed in table and any source it owns and
+ * passes back NULL in table.  The nodes recorded in the table are not
+ * released.
+ * ----------------------------------------------------------------------- */
+
+void m2t_release_comment_table (m2t_comment_table_t *table);
+
+
+#endif /* M2T_COMMENTS_H */
+
+/* END OF FILE */
@@ -0,0 +1,180 @@
+/* M2T -- Sorce to Source Modula-2 Translator
+ *
+ * Copyright (c) 2016-2023 Benjamin Kowarsch
+ *
+ * Author & Maintainer: Benjamin Kowarsch <org.m2sf>
+ *
+ * @synopsis
+ *
+ * M2T is a multi-dialect Modula-2 source-to-source translator. It translates
+ * source files  written in the  classic dialects  to semantically equivalent
+ * source files in  Modula-2 Revision 2010 (M2R10).  It supports  the classic
+ * Modula-2 dialects  described in  the 2nd, 3rd and 4th editions  of Niklaus
+ * Wirth's book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * For more details please visit: https://github.com/trijezdci/m2t/wiki
+ *
+ * @repository
+ *
+ * https://github.com/trijezdci/m2t
+ *
+ * @file
+ *
+ * m2t-constfold.h
+ *
+ * Public interface for M2T constant expression folding.
+ *
+ * @license
+ *
+ * M2T is free software:  You can redistribute and modify it  under the terms
+ * of the  GNU Lesser General Public License (LGPL) either version 2.1  or at
+ * your choice version 3, both as published by the Free Software Foundation.
+ *
+ * M2T is distributed  in the hope  that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even  the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received  a copy of the  GNU Lesser General Public License
+ * along with M2T.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#ifndef M2T_CONSTFOLD_H
+#define M2T_CONSTFOLD_H
+
+#include "m2t-common.h"
+#include "m2t-unique-string.h"
+#include "ast/m2t-ast.h"
+
+#include <stdint.h>
+
+
+/* --------------------------------------------------------------------------
+ * Constant folding
+ * --------------------------------------------------------------------------
+ * A constant folder evaluates constant expression subtrees and memoizes
+ * the value of every node it has evaluated in a side table keyed by node.
+ * Each node is therefore evaluated at most once, no matter how often it
+ * is referenced.  Constant identifiers are bound to the expressions of
+ * their definitions, an identifier in an expression is evaluated through
+ * its binding and thus hits the memoized value of the defining expression.
+ * Nodes that are not constant, or whose values cannot be determined, are
+ * memoized as unknown.  The folder does not own any nodes, they must stay
+ * allocated for the lifetime of the folder.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * type m2t_const_kind_t
+ * --------------------------------------------------------------------------
+ * Enumerated kinds of folded values.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2T_CONST_UNKNOWN,
+  M2T_CONST_WHOLE,
+  M2T_CONST_REAL,
+  M2T_CONST_BOOLEAN,
+  M2T_CONST_CHAR
+} m2t_const_kind_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2t_const_value_t
+ * --------------------------------------------------------------------------
+ * record type representing a folded value.  Whole numbers and character
+ * codes are held in field whole, real numbers in field real and Boolean
+ * values in field boolean.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* kind */ m2t_const_kind_t kind;
+  /* value */ union {
+    /* whole */ int64_t whole;
+    /* real */ double real;
+    /* boolean */ bool boolean;
+  } value;
+} m2t_const_value_t;
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2t_const_folder_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing a constant folder.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2t_const_folder_s *m2t_const_folder_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_new_const_folder()
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated constant folder without bindings, or NULL on
+ * failure.
+ * ----------------------------------------------------------------------- */
+
+m2t_const_folder_t m2t_new_const_folder (void);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_const_folder_bind(folder, ident, expr)
+ * --------------------------------------------------------------------------
+ * Binds constant identifier ident to expression expr in folder, replacing
+ * any previous binding of ident.  Returns true on success, or false if
+ * folder, ident or expr is NULL or if the folder could not be grown.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_const_folder_bind
+  (m2t_const_folder_t folder, m2t_string_t ident, m2t_astnode_t expr);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_const_folder_bind_defs(folder, list)
+ * --------------------------------------------------------------------------
+ * Binds the identifier of every constant definition (CONSTDEF) found among
+ * the subnodes of definition or declaration list list to its expression.
+ * Returns the number of bindings made.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2t_const_folder_bind_defs
+  (m2t_const_folder_t folder, m2t_astnode_t list);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_const_fold(folder, expr, value)
+ * --------------------------------------------------------------------------
+ * Evaluates constant expression expr, memoizing the values of expr and of
+ * its subexpressions in folder.  Passes the value back in value, unless
+ * NULL is passed in, and returns true.  Returns false and passes back a
+ * value of kind M2T_CONST_UNKNOWN if expr is not constant, if its value
+ * cannot be determined or if it depends on its own definition.  Whole
+ * number literals are taken from the literal repository.  DIV and MOD are
+ * only folded for non-negative dividends and positive divisors.  Arithmetic
+ * that overflows 64 bits is not folded.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_const_fold
+  (m2t_const_folder_t folder, m2t_astnode_t expr, m2t_const_value_t *value);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_const_folder_count(folder)
+ * --------------------------------------------------------------------------
+ * Returns the number of nodes memoized in folder, or zero if folder is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2t_const_folder_count (m2t_const_folder_t folder);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_release_const_folder(folder)
+ * --------------------------------------------------------------------------
+ * Releases the constant folder passed in folder and passes back NULL in
+ * folder.  No nodes are released.
+ * ----------------------------------------------------------------------- */
+
+void m2t_release_const_folder (m2t_const_folder_t *folder);
+
+
+#endif /* M2T_CONSTFOLD_H */
+
+/* END OF FILE */
@@ -0,0 +1,165 @@
+/* M2T -- Sorce to Source Modula-2 Translator
+ *
+ * @file
+ *
+ * m2t-first-set-table.h
+ *
+ * Generated by m2t-gen-tokensets first, do not edit.
+ * Change gen/m2t-gen-tokensets.c and regenerate instead.
+ */
+
+#ifndef M2T_FIRST_SET_TABLE_H
+#define M2T_FIRST_SET_TABLE_H
+
+static const m2t_tokenset_t m2t_first_set[] = {
+  /* DEFINITION_MODULE */
+  { { 0x00000080, 0x00000000, 0x00000000 } }, /* 1 */
+  /* IMPORT */
+  { { 0x00090000, 0x00000000, 0x00000000 } }, /* 2 */
+  /* QUALIFIED_IMPORT */
+  { { 0x00080000, 0x00000000, 0x00000000 } }, /* 1 */
+  /* UNQUALIFIED_IMPORT */
+  { { 0x00010000, 0x00000000, 0x00000000 } }, /* 1 */
+  /* IDENT_LIST */
+  { { 0x00000000, 0x00000200, 0x00000000 } }, /* 1 */
+  /* DEFINITION */
+  { { 0x10000040, 0x00000050, 0x00000000 } }, /* 4 */
+  /* CONST_DEFINITION */
+  { { 0x00000000, 0x00000200, 0x00000000 } }, /* 1 */
+  /* TYPE_DEFINITION */
+  { { 0x00000000, 0x00000200, 0x00000000 } }, /* 1 */
+  /* TYPE */
+  { { 0x58000004, 0x00000202, 0x00000050 } }, /* 8 */
+  /* DERIVED_OR_SUBRANGE_TYPE */
+  { { 0x00000000, 0x00000200, 0x00000040 } }, /* 2 */
+  /* QUALIDENT */
+  { { 0x00000000, 0x00000200, 0x00000000 } }, /* 1 */
+  /* RANGE */
+  { { 0x00000000, 0x00000000, 0x00000040 } }, /* 1 */
+  /* ENUM_TYPE */
+  { { 0x00000000, 0x00000000, 0x00000010 } }, /* 1 */
+  /* SET_TYPE */
+  { { 0x00000000, 0x00000002, 0x00000000 } }, /* 1 */
+  /* COUNTABLE_TYPE */
+  { { 0x00000000, 0x00000200, 0x00000050 } }, /* 3 */
+  /* ARRAY_TYPE */
+  { { 0x00000004, 0x00000000, 0x00000000 } }, /* 1 */
+  /* EXTENSIBLE_RECORD_TYPE */
+  { { 0x40000000, 0x00000000, 0x00000000 } }, /* 1 */
+  /* FIELD_LIST_SEQUENCE */
+  { { 0x00000000, 0x00000200, 0x00000000 } }, /* 1 */
+  /* VARIANT_RECORD_TYPE */
+  { { 0x40000000, 0x00000000, 0x00000000 } }, /* 1 */
+  /* VARIANT_FIELD_LIST_SEQ */
+  { { 0x00000020, 0x00000200, 0x00000000 } }, /* 2 */
+  /* VARIANT_FIELD_LIST */
+  { { 0x00000020, 0x00000200, 0x00000000 } }, /* 2 */
+  /* VARIANT_FIELDS */
+  { { 0x00000020, 0x00000000, 0x00000000 } }, /* 1 */
+  /* VARIANT */
+  { { 0x01000000, 0x000C3E00, 0x00000110 } }, /* 10 */
+  /* CASE_LABEL_LIST */
+  { { 0x01000000, 0x000C3E00, 0x00000110 } }, /* 10 */
+  /* CASE_LABELS */
+  { { 0x01000000, 0x000C3E00, 0x00000110 } }, /* 10 */
+  /* POINTER_TYPE */
+  { { 0x08000000, 0x00000000, 0x00000000 } }, /* 1 */
+  /* PROCEDURE_TYPE */
+  { { 0x10000000, 0x00000000, 0x00000000 } }, /* 1 */
+  /* SIMPLE_FORMAL_TYPE */
+  { { 0x00000004, 0x00000200, 0x00000000 } }, /* 2 */
+  /* PROCEDURE_HEADER */
+  { { 0x10000000, 0x00000000, 0x00000000 } }, /* 1 */
+  /* PROCEDURE_SIGNATURE */
+  { { 0x00000000, 0x00000200, 0x00000000 } }, /* 1 */
+  /* SIMPLE_FORMAL_PARAMS */
+  { { 0x00000000, 0x00000200, 0x00000000 } }, /* 1 */
+  /* IMPLEMENTATION_MODULE */
+  { { 0x00040000, 0x00000000, 0x00000000 } }, /* 1 */
+  /* PROGRAM_MODULE */
+  { { 0x00800000, 0x00000000, 0x00000000 } }, /* 1 */
+  /* MODULE_PRIORITY */
+  { { 0x00000000, 0x00000000, 0x00000040 } }, /* 1 */
+  /* BLOCK */
+  { { 0x10801048, 0x00000050, 0x00000000 } }, /* 7 */
+  /* DECLARATION */
+  { { 0x10800040, 0x00000050, 0x00000000 } }, /* 5 */
+  /* TYPE_DECLARATION */
+  { { 0x00000000, 0x00000200, 0x00000000 } }, /* 1 */
+  /* VAR_SIZE_RECORD_TYPE */
+  { { 0x00000000, 0x00000040, 0x00000000 } }, /* 1 */
+  /* VARIABLE_DECLARATION */
+  { { 0x00000000, 0x00000200, 0x00000000 } }, /* 1 */
+  /* PROCEDURE_DECLARATION */
+  { { 0x10000000, 0x00000000, 0x00000000 } }, /* 1 */
+  /* MODULE_DECLARATION */
+  { { 0x00800000, 0x00000000, 0x00000000 } }, /* 1 */
+  /* EXPORT */
+  { { 0x00004000, 0x00000000, 0x00000000 } }, /* 1 */
+  /* STATEMENT_SEQUENCE */
+  { { 0x8022A020, 0x00000381, 0x00000000 } }, /* 10 */
+  /* STATEMENT */
+  { { 0x8022A020, 0x00000381, 0x00000000 } }, /* 10 */
+  /* ASSIGNMENT_OR_PROC_CALL */
+  { { 0x00000000, 0x00000200, 0x00000000 } }, /* 1 */
+  /* ACTUAL_PARAMETERS */
+  { { 0x00000000, 0x00000000, 0x00000010 } }, /* 1 */
+  /* EXPRESSION_LIST */
+  { { 0x01000000, 0x000C3E00, 0x00000110 } }, /* 10 */
+  /* RETURN_STATEMENT */
+  { { 0x00000000, 0x00000001, 0x00000000 } }, /* 1 */
+  /* WITH_STATEMENT */
+  { { 0x00000000, 0x00000100, 0x00000000 } }, /* 1 */
+  /* IF_STATEMENT */
+  { { 0x00020000, 0x00000000, 0x00000000 } }, /* 1 */
+  /* CASE_STATEMENT */
+  { { 0x00000020, 0x00000000, 0x00000000 } }, /* 1 */
+  /* CASE */
+  { { 0x01000000, 0x000C3E00, 0x00000110 } }, /* 10 */
+  /* LOOP_STATEMENT */
+  { { 0x00200000, 0x00000000, 0x00000000 } }, /* 1 */
+  /* WHILE_STATEMENT */
+  { { 0x00000000, 0x00000080, 0x00000000 } }, /* 1 */
+  /* REPEAT_STATEMENT */
+  { { 0x80000000, 0x00000000, 0x00000000 } }, /* 1 */
+  /* FOR_STATEMENT */
+  { { 0x00008000, 0x00000000, 0x00000000 } }, /* 1 */
+  /* DESIGNATOR */
+  { { 0x00000000, 0x00000200, 0x00000000 } }, /* 1 */
+  /* SELECTOR */
+  { { 0x00000000, 0x40000000, 0x00000044 } }, /* 3 */
+  /* EXPRESSION */
+  { { 0x01000000, 0x000C3E00, 0x00000110 } }, /* 10 */
+  /* SIMPLE_EXPRESSION */
+  { { 0x01000000, 0x000C3E00, 0x00000110 } }, /* 10 */
+  /* TERM */
+  { { 0x01000000, 0x00003E00, 0x00000110 } }, /* 8 */
+  /* SIMPLE_TERM */
+  { { 0x01000000, 0x00003E00, 0x00000110 } }, /* 8 */
+  /* FACTOR */
+  { { 0x00000000, 0x00003E00, 0x00000110 } }, /* 7 */
+  /* DESIGNATOR_OR_FUNC_CALL */
+  { { 0x00000000, 0x00000200, 0x00000000 } }, /* 1 */
+  /* SET_VALUE */
+  { { 0x00000000, 0x00000000, 0x00000100 } }, /* 1 */
+  /* ELEMENT */
+  { { 0x01000000, 0x000C3E00, 0x00000110 } }, /* 10 */
+  /* FORMAL_TYPE */
+  { { 0x00000004, 0x00000240, 0x00000000 } }, /* 3 */
+  /* ATTRIBUTED_FORMAL_TYPE */
+  { { 0x00000000, 0x00000040, 0x00000000 } }, /* 1 */
+  /* FORMAL_PARAM_LIST */
+  { { 0x00000000, 0x00000240, 0x00000000 } }, /* 2 */
+  /* FORMAL_PARAMS */
+  { { 0x00000000, 0x00000240, 0x00000000 } }, /* 2 */
+  /* ATTRIB_FORMAL_PARAMS */
+  { { 0x00000000, 0x00000040, 0x00000000 } }, /* 1 */
+  /* TYPE_DECLARATION_TAIL */
+  { { 0x58000004, 0x00000242, 0x00000050 } }, /* 9 */
+  /* ALT(TYPE_DECLARATION_TAIL) */
+  { { 0x58000004, 0x00000202, 0x00000050 } } /* 8 */
+}; /* end m2t_first_set */
+
+#endif /* M2T_FIRST_SET_TABLE_H */
+
+/* END OF FILE */
@@ -0,0 +1,165 @@
+/* M2T -- Sorce to Source Modula-2 Translator
+ *
+ * @file
+ *
+ * m2t-follow-set-table.h
+ *
+ * Generated by m2t-gen-tokensets follow, do not edit.
+ * Change gen/m2t-gen-tokensets.c and regenerate instead.
+ */
+
+#ifndef M2T_FOLLOW_SET_TABLE_H
+#define M2T_FOLLOW_SET_TABLE_H
+
+static const m2t_tokenset_t m2t_follow_set[] = {
+  /* DEFINITION_MODULE */
+  { { 0x00000000, 0x00000000, 0x00000400 } }, /* 1 */
+  /* IMPORT */
+  { { 0x108050C8, 0x00000050, 0x00000000 } }, /* 9 */
+  /* QUALIFIED_IMPORT */
+  { { 0x00000000, 0x00000000, 0x00000001 } }, /* 1 */
+  /* UNQUALIFIED_IMPORT */
+  { { 0x00000000, 0x00000000, 0x00000001 } }, /* 1 */
+  /* IDENT_LIST */
+  { { 0x00000000, 0x80000000, 0x00000021 } }, /* 3 */
+  /* DEFINITION */
+  { { 0x00001000, 0x00000000, 0x00000000 } }, /* 1 */
+  /* CONST_DEFINITION */
+  { { 0x00000000, 0x00000000, 0x00000001 } }, /* 1 */
+  /* TYPE_DEFINITION */
+  { { 0x00000000, 0x00000000, 0x00000001 } }, /* 1 */
+  /* TYPE */
+  { { 0x00000000, 0x00000000, 0x00000001 } }, /* 1 */
+  /* DERIVED_OR_SUBRANGE_TYPE */
+  { { 0x00000000, 0x00000000, 0x00000001 } }, /* 1 */
+  /* QUALIDENT */
+  { { 0x06501F12, 0x3FFC002C, 0x0000037B } }, /* 34 */
+  /* RANGE */
+  { { 0x02000000, 0x20000000, 0x00000001 } }, /* 3 */
+  /* ENUM_TYPE */
+  { { 0x02000000, 0x20000000, 0x00000001 } }, /* 3 */
+  /* SET_TYPE */
+  { { 0x00000000, 0x00000000, 0x00000001 } }, /* 1 */
+  /* COUNTABLE_TYPE */
+  { { 0x02000000, 0x20000000, 0x00000001 } }, /* 3 */
+  /* ARRAY_TYPE */
+  { { 0x00000000, 0x00000000, 0x00000001 } }, /* 1 */
+  /* EXTENSIBLE_RECORD_TYPE */
+  { { 0x00000000, 0x00000000, 0x00000001 } }, /* 1 */
+  /* FIELD_LIST_SEQUENCE */
+  { { 0x00001000, 0x00000040, 0x00000000 } }, /* 2 */
+  /* VARIANT_RECORD_TYPE */
+  { { 0x00000000, 0x00000000, 0x00000001 } }, /* 1 */
+  /* VARIANT_FIELD_LIST_SEQ */
+  { { 0x00001400, 0x00000000, 0x00000008 } }, /* 3 */
+  /* VARIANT_FIELD_LIST */
+  { { 0x00001400, 0x00000000, 0x00000009 } }, /* 4 */
+  /* VARIANT_FIELDS */
+  { { 0x00001400, 0x00000000, 0x00000009 } }, /* 4 */
+  /* VARIANT */
+  { { 0x00001400, 0x00000000, 0x00000008 } }, /* 3 */
+  /* CASE_LABEL_LIST */
+  { { 0x00000000, 0x80000000, 0x00000000 } }, /* 1 */
+  /* CASE_LABELS */
+  { { 0x00000000, 0xA0000000, 0x00000000 } }, /* 2 */
+  /* POINTER_TYPE */
+  { { 0x00000000, 0x00000000, 0x00000001 } }, /* 1 */
+  /* PROCEDURE_TYPE */
+  { { 0x00000000, 0x00000000, 0x00000001 } }, /* 1 */
+  /* SIMPLE_FORMAL_TYPE */
+  { { 0x00000000, 0x20000000, 0x00000020 } }, /* 2 */
+  /* PROCEDURE_HEADER */
+  { { 0x00000000, 0x00000000, 0x00000001 } }, /* 1 */
+  /* PROCEDURE_SIGNATURE */
+  { { 0x00000000, 0x00000000, 0x00000001 } }, /* 1 */
+  /* SIMPLE_FORMAL_PARAMS */
+  { { 0x00000000, 0x00000000, 0x00000021 } }, /* 2 */
+  /* IMPLEMENTATION_MODULE */
+  { { 0x00000000, 0x00000000, 0x00000400 } }, /* 1 */
+  /* PROGRAM_MODULE */
+  { { 0x00000000, 0x00000000, 0x00000400 } }, /* 1 */
+  /* MODULE_PRIORITY */
+  { { 0x00000000, 0x00000000, 0x00000001 } }, /* 1 */
+  /* BLOCK */
+  { { 0x00000000, 0x00000200, 0x00000000 } }, /* 1 */
+  /* DECLARATION */
+  { { 0x00001008, 0x00000000, 0x00000000 } }, /* 2 */
+  /* TYPE_DECLARATION */
+  { { 0x00000000, 0x00000000, 0x00000001 } }, /* 1 */
+  /* VAR_SIZE_RECORD_TYPE */
+  { { 0x00000000, 0x00000000, 0x00000001 } }, /* 1 */
+  /* VARIABLE_DECLARATION */
+  { { 0x00000000, 0x00000000, 0x00000001 } }, /* 1 */
+  /* PROCEDURE_DECLARATION */
+  { { 0x00000000, 0x00000000, 0x00000001 } }, /* 1 */
+  /* MODULE_DECLARATION */
+  { { 0x00000000, 0x00000000, 0x00000001 } }, /* 1 */
+  /* EXPORT */
+  { { 0x10801048, 0x00000050, 0x00000000 } }, /* 7 */
+  /* STATEMENT_SEQUENCE */
+  { { 0x00001C00, 0x00000020, 0x00000008 } }, /* 5 */
+  /* STATEMENT */
+  { { 0x00001C00, 0x00000020, 0x00000009 } }, /* 6 */
+  /* ASSIGNMENT_OR_PROC_CALL */
+  { { 0x00001C00, 0x00000020, 0x00000009 } }, /* 6 */
+  /* ACTUAL_PARAMETERS */
+  { { 0x00001C00, 0x00000020, 0x00000009 } }, /* 6 */
+  /* EXPRESSION_LIST */
+  { { 0x00000000, 0x00000000, 0x00000020 } }, /* 1 */
+  /* RETURN_STATEMENT */
+  { { 0x00001C00, 0x00000020, 0x00000009 } }, /* 6 */
+  /* WITH_STATEMENT */
+  { { 0x00001C00, 0x00000020, 0x00000009 } }, /* 6 */
+  /* IF_STATEMENT */
+  { { 0x00001C00, 0x00000020, 0x00000009 } }, /* 6 */
+  /* CASE_STATEMENT */
+  { { 0x00001C00, 0x00000020, 0x00000009 } }, /* 6 */
+  /* CASE */
+  { { 0x00001400, 0x00000000, 0x00000008 } }, /* 3 */
+  /* LOOP_STATEMENT */
+  { { 0x00001C00, 0x00000020, 0x00000009 } }, /* 6 */
+  /* WHILE_STATEMENT */
+  { { 0x00001C00, 0x00000020, 0x00000009 } }, /* 6 */
+  /* REPEAT_STATEMENT */
+  { { 0x00001C00, 0x00000020, 0x00000009 } }, /* 6 */
+  /* FOR_STATEMENT */
+  { { 0x00001C00, 0x00000020, 0x00000009 } }, /* 6 */
+  /* DESIGNATOR */
+  { { 0x06501F12, 0x3FFC002C, 0x0000033B } }, /* 33 */
+  /* SELECTOR */
+  { { 0x06501F12, 0x3FFC022C, 0x0000033B } }, /* 34 */
+  /* EXPRESSION */
+  { { 0x02001E10, 0x2000002C, 0x0000022B } }, /* 15 */
+  /* SIMPLE_EXPRESSION */
+  { { 0x02101E10, 0x23F0002C, 0x0000022B } }, /* 22 */
+  /* TERM */
+  { { 0x06101E10, 0x23FC002C, 0x0000022B } }, /* 25 */
+  /* SIMPLE_TERM */
+  { { 0x06501F12, 0x2FFC002C, 0x0000022B } }, /* 30 */
+  /* FACTOR */
+  { { 0x06501F12, 0x2FFC002C, 0x0000022B } }, /* 30 */
+  /* DESIGNATOR_OR_FUNC_CALL */
+  { { 0x06501F12, 0x2FFC002C, 0x0000022B } }, /* 30 */
+  /* SET_VALUE */
+  { { 0x06501F12, 0x2FFC002C, 0x0000022B } }, /* 30 */
+  /* ELEMENT */
+  { { 0x00000000, 0x20000000, 0x00000200 } }, /* 2 */
+  /* FORMAL_TYPE */
+  { { 0x00000000, 0x20000000, 0x00000020 } }, /* 2 */
+  /* ATTRIBUTED_FORMAL_TYPE */
+  { { 0x00000000, 0x20000000, 0x00000020 } }, /* 2 */
+  /* FORMAL_PARAM_LIST */
+  { { 0x00000000, 0x00000000, 0x00000020 } }, /* 1 */
+  /* FORMAL_PARAMS */
+  { { 0x00000000, 0x00000000, 0x00000021 } }, /* 2 */
+  /* ATTRIB_FORMAL_PARAMS */
+  { { 0x00000000, 0x00000000, 0x00000021 } }, /* 2 */
+  /* TYPE_DECLARATION_TAIL */
+  { { 0x00000000, 0x00000000, 0x00000001 } }, /* 1 */
+  /* ALT(TYPE_DECLARATION_TAIL) */
+  { { 0x00000000, 0x00000000, 0x00000001 } } /* 1 */
+}; /* end m2t_follow_set */
+
+#endif /* M2T_FOLLOW_SET_TABLE_H */
+
+/* END OF FILE */
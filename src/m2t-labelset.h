@@ -0,0 +1,213 @@
+/* M2T -- Sorce to Source Modula-2 Translator
+ *
+ * Copyright (c) 2016-2023 Benjamin Kowarsch
+ *
+ * Author & Maintainer: Benjamin Kowarsch <org.m2sf>
+ *
+ * @synopsis
+ *
+ * M2T is a multi-dialect Modula-2 source-to-source translator. It translates
+ * source files  written in the  classic dialects  to semantically equivalent
+ * source files in  Modula-2 Revision 2010 (M2R10).  It supports  the classic
+ * Modula-2 dialects  described in  the 2nd, 3rd and 4th editions  of Niklaus
+ * Wirth's book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * For more details please visit: https://github.com/trijezdci/m2t/wiki
+ *
+ * @repository
+ *
+ * https://github.com/trijezdci/m2t
+ *
+ * @file
+ *
+ * m2t-labelset.h
+ *
+ * Public interface for M2T case label sets.
+ *
+ * @license
+ *
+ * M2T is free software:  You can redistribute and modify it  under the terms
+ * of the  GNU Lesser General Public License (LGPL) either version 2.1  or at
+ * your choice version 3, both as published by the Free Software Foundation.
+ *
+ * M2T is distributed  in the hope  that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even  the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received  a copy of the  GNU Lesser General Public License
+ * along with M2T.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+
+#ifndef M2T_LABELSET_H
+#define M2T_LABELSET_H
+
+#include "m2t-common.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/* --------------------------------------------------------------------------
+ * Case label sets
+ * --------------------------------------------------------------------------
+ * A label set collects the labels of CASE statements and variant records
+ * as closed intervals of ordinal values, each recorded with the index of
+ * the branch it selects and the source offset of the label.  A label that
+ * denotes a single value is recorded as an interval whose bounds are equal.
+ * Labels are collected in stack fashion:  A mark is taken before the labels
+ * of a CASE are added and the labels above the mark are sorted, classified
+ * and finally reset to the mark, the labels of enclosing CASEs below the
+ * mark are not affected.  Sorting detects duplicate and overlapping labels
+ * in O(n log n) time.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * Maximum span and minimum density of dense label sets
+ * ----------------------------------------------------------------------- */
+
+#define M2T_LABEL_SET_MAX_TABLE_SIZE 4096
+
+#define M2T_LABEL_SET_MIN_DENSITY_PERCENT 50
+
+
+/* --------------------------------------------------------------------------
+ * type m2t_label_interval_t
+ * --------------------------------------------------------------------------
+ * record type representing a case label.  Fields lower and upper hold the
+ * bounds of the label, field branch the index of the branch it selects and
+ * field offset the source offset of the label.  Field overlaps is set when
+ * the label has been found to share a value with a label that precedes it
+ * in the source.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* lower */ int64_t lower;
+  /* upper */ int64_t upper;
+  /* branch */ uint_t branch;
+  /* offset */ uint32_t offset;
+  /* overlaps */ bool overlaps;
+} m2t_label_interval_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2t_label_set_class_t
+ * --------------------------------------------------------------------------
+ * Enumerated values representing the classification of a sorted label set.
+ * A set is dense if its values span no more than M2T_LABEL_SET_MAX_TABLE_SIZE
+ * and its labels cover at least M2T_LABEL_SET_MIN_DENSITY_PERCENT of the
+ * span, otherwise it is sparse.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2T_LABEL_SET_EMPTY,
+  M2T_LABEL_SET_DENSE,
+  M2T_LABEL_SET_SPARSE
+} m2t_label_set_class_t;
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2t_label_set_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing a stack of case labels.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2t_label_set_s *m2t_label_set_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_new_label_set()
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated empty label set, or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2t_label_set_t m2t_new_label_set (void);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_label_set_mark(set)
+ * --------------------------------------------------------------------------
+ * Returns a mark for the labels presently in set, or zero if set is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2t_label_set_mark (m2t_label_set_t set);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_label_set_add(set, lower, upper, branch, offset)
+ * --------------------------------------------------------------------------
+ * Adds a label with bounds lower and upper that selects branch and occurs
+ * at source offset to set.  Returns true on success, or false if set is
+ * NULL, if lower is greater than upper or if set could not be grown.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_label_set_add
+  (m2t_label_set_t set,
+   int64_t lower, int64_t upper, uint_t branch, uint32_t offset);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_label_set_sort(set, mark)
+ * --------------------------------------------------------------------------
+ * Sorts the labels added to set since mark by their lower bounds.  Of any
+ * two labels found to share a value, the one that occurs later in the
+ * source is marked as overlapping.  Returns the number of labels marked,
+ * or zero if set is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2t_label_set_sort (m2t_label_set_t set, uint_t mark);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_label_set_classify(set, mark)
+ * --------------------------------------------------------------------------
+ * Returns the classification of the labels added to set since mark.  The
+ * labels must have been sorted and must not overlap.
+ * ----------------------------------------------------------------------- */
+
+m2t_label_set_class_t m2t_label_set_classify
+  (m2t_label_set_t set, uint_t mark);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_label_set_count(set)
+ * --------------------------------------------------------------------------
+ * Returns the number of labels in set, or zero if set is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2t_label_set_count (m2t_label_set_t set);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_label_set_interval(set, index)
+ * --------------------------------------------------------------------------
+ * Returns a pointer to the label at index in set, or NULL if set is NULL or
+ * if index is out of range.  The pointer is valid until labels are added.
+ * ----------------------------------------------------------------------- */
+
+const m2t_label_interval_t *m2t_label_set_interval
+  (m2t_label_set_t set, uint_t index);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_label_set_reset(set, mark)
+ * --------------------------------------------------------------------------
+ * Removes the labels added to set since mark.  Does nothing if set is NULL.
+ * ----------------------------------------------------------------------- */
+
+void m2t_label_set_reset (m2t_label_set_t set, uint_t mark);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_release_label_set(set)
+ * --------------------------------------------------------------------------
+ * Releases the label set passed in set and passes back NULL in set.
+ * ----------------------------------------------------------------------- */
+
+void m2t_release_label_set (m2t_label_set_t *set);
+
+
+#endif /* M2T_LABELSET_H */
+
+/* END OF FILE */
@@ -42,8 +42,13 @@
 #define M2T_LEXER_H
 
 #include "m2t-token.h"
+#include "m2t-tokenset.h"
 #include "m2t-common.h"
 #include "m2t-unique-string.h"
+#include "m2t-option-flags.h"
+#include "m2t-comments.h"
+
+#include <stddef.h>
 
 
 /* --------------------------------------------------------------------------
@@ -98,6 +103,105 @@ void m2t_new_lexer
   (m2t_lexer_t *lexer, m2t_string_t filename, m2t_lexer_status_t *status);
 
 
+/* --------------------------------------------------------------------------
+ * procedure m2t_new_lexer_w_options(lexer, filename, options, status)
+ * --------------------------------------------------------------------------
+ * Allocates a new object of type m2t_lexer_t like m2t_new_lexer() but the
+ * newly created lexer object recognises the dialect given by option set
+ * options instead of the dialect selected on the command line.
+ * ----------------------------------------------------------------------- */
+
+void m2t_new_lexer_w_options
+  (m2t_lexer_t *lexer,
+   m2t_string_t filename,
+   m2t_option_set_t options,
+   m2t_lexer_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_new_lexer_from_buffer(lexer, name, buffer, length, status)
+ * --------------------------------------------------------------------------
+ * Allocates a new object of type m2t_lexer_t and associates the caller owned
+ * source text in buffer with the newly created lexer object.  The buffer is
+ * NOT copied.  It must remain valid and unmodified until the lexer has been
+ * released.  Parameter name is reported in place of a filename.
+ *
+ * pre-conditions:
+ * o  parameter lexer must not be NULL upon entry
+ * o  parameters name and buffer must not be NULL upon entry
+ * o  parameter status may be NULL
+ *
+ * post-conditions:
+ * o  pointer to newly allocated lexer is passed back in lexer
+ * o  M2T_LEXER_STATUS_SUCCESS is passed back in status, unless NULL
+ *
+ * error-conditions:
+ * o  if lexer, name or buffer is NULL upon entry, no operation is carried
+ *    out and status M2T_LEXER_STATUS_INVALID_REFERENCE is returned
+ * o  if buffer is empty or no lexer object could be allocated
+ *    status M2T_LEXER_STATUS_ALLOCATION_FAILED is returned
+ * ----------------------------------------------------------------------- */
+
+void m2t_new_lexer_from_buffer
+  (m2t_lexer_t *lexer,
+   m2t_string_t name,
+   const char *buffer,
+   size_t length,
+   m2t_lexer_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_new_lexer_for_range(lexer, name, buffer, start, end, status)
+ * --------------------------------------------------------------------------
+ * Allocates a new object of type m2t_lexer_t like m2t_new_lexer_from_buffer()
+ * but associates only the range of buffer from byte offset start up to but
+ * not including byte offset end with the newly created lexer object.  The
+ * end of the range is reported as the end of the input.  Offsets, lines and
+ * columns of symbols and diagnostics are relative to the start of buffer,
+ * not to the start of the range.
+ *
+ * error-conditions:
+ * o  if lexer, name or buffer is NULL upon entry, no operation is carried
+ *    out and status M2T_LEXER_STATUS_INVALID_REFERENCE is returned
+ * o  if the range is empty or no lexer object could be allocated
+ *    status M2T_LEXER_STATUS_ALLOCATION_FAILED is returned
+ * ----------------------------------------------------------------------- */
+
+void m2t_new_lexer_for_range
+  (m2t_lexer_t *lexer,
+   m2t_string_t name,
+   const char *buffer,
+   size_t start,
+   size_t end,
+   m2t_lexer_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_new_lexer_w_comments(lexer, name, buffer, length, ...)
+ * --------------------------------------------------------------------------
+ * Allocates a new object of type m2t_lexer_t like m2t_new_lexer_from_buffer()
+ * but the newly created lexer object records the offset and length of each
+ * comment it skips in comment table comments, and the offset of the symbol
+ * that follows.  Comments are recorded from the start of buffer, including
+ * those that precede the first symbol.  The comment table is NOT owned by
+ * the lexer.  It must remain valid until the lexer has been released.
+ *
+ * error-conditions:
+ * o  if lexer, name, buffer or comments is NULL upon entry, no operation is
+ *    carried out and status M2T_LEXER_STATUS_INVALID_REFERENCE is returned
+ * o  if buffer is empty or no lexer object could be allocated
+ *    status M2T_LEXER_STATUS_ALLOCATION_FAILED is returned
+ * ----------------------------------------------------------------------- */
+
+void m2t_new_lexer_w_comments
+  (m2t_lexer_t *lexer,
+   m2t_string_t name,
+   const char *buffer,
+   size_t length,
+   m2t_comment_table_t comments,
+   m2t_lexer_status_t *status);
+
+
 /* --------------------------------------------------------------------------
  * function m2t_read_sym(lexer)
  * --------------------------------------------------------------------------
@@ -153,6 +257,20 @@ m2t_token_t m2t_next_sym (m2t_lexer_t lexer);
 m2t_token_t m2t_consume_sym (m2t_lexer_t lexer);
 
 
+/* --------------------------------------------------------------------------
+ * function m2t_lexer_skip_to_set(lexer, resync_set)
+ * --------------------------------------------------------------------------
+ * Consumes symbols until the lookahead symbol is an element of resync_set
+ * or the end of the input has been reached and returns the new lookahead
+ * symbol.  Used for error recovery.  Symbols that are skipped are lexed
+ * without creating lexemes, their lexemes are therefore not available.
+ * Lexical errors within skipped symbols are still reported.
+ * ----------------------------------------------------------------------- */
+
+m2t_token_t m2t_lexer_skip_to_set
+  (m2t_lexer_t lexer, m2t_tokenset_t resync_set);
+
+
 /* --------------------------------------------------------------------------
  * function m2t_lexer_filename(lexer)
  * --------------------------------------------------------------------------
@@ -162,6 +280,44 @@ m2t_token_t m2t_consume_sym (m2t_lexer_t lexer);
 m2t_string_t m2t_lexer_filename (m2t_lexer_t lexer);
 
 
+/* --------------------------------------------------------------------------
+ * function m2t_lexer_options(lexer)
+ * --------------------------------------------------------------------------
+ * Returns the dialect option set captured by lexer when it was created.
+ * ----------------------------------------------------------------------- */
+
+m2t_option_set_t m2t_lexer_options (m2t_lexer_t lexer);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_lexer_comment_table(lexer)
+ * --------------------------------------------------------------------------
+ * Returns the comment table in which lexer records comments, or NULL if
+ * lexer does not record comments.
+ * ----------------------------------------------------------------------- */
+
+m2t_comment_table_t m2t_lexer_comment_table (m2t_lexer_t lexer);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_lexer_token_count(lexer)
+ * --------------------------------------------------------------------------
+ * Returns the number of symbols consumed from lexer so far, including
+ * symbols skipped by m2t_lexer_skip_to_set().
+ * ----------------------------------------------------------------------- */
+
+uint_t m2t_lexer_token_count (m2t_lexer_t lexer);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_lexer_error_count(lexer)
+ * --------------------------------------------------------------------------
+ * Returns the number of lexical errors reported by lexer so far.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2t_lexer_error_count (m2t_lexer_t lexer);
+
+
 /* --------------------------------------------------------------------------
  * function m2t_lexer_status(lexer)
  * --------------------------------------------------------------------------
@@ -189,10 +345,43 @@ m2t_string_t m2t_lexer_lookahead_lexeme (m2t_lexer_t lexer);
 m2t_string_t m2t_lexer_current_lexeme (m2t_lexer_t lexer);
 
 
+/* --------------------------------------------------------------------------
+ * function m2t_lexer_lookahead_offset(lexer)
+ * --------------------------------------------------------------------------
+ * Returns the byte offset of the lookahead symbol.
+ * ----------------------------------------------------------------------- */
+
+uint32_t m2t_lexer_lookahead_offset (m2t_lexer_t lexer);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_lexer_current_offset(lexer)
+ * --------------------------------------------------------------------------
+ * Returns the byte offset of the most recently consumed symbol.
+ * ----------------------------------------------------------------------- */
+
+uint32_t m2t_lexer_current_offset (m2t_lexer_t lexer);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_lexer_position_for_offset(lexer, offset, line, column)
+ * --------------------------------------------------------------------------
+ * Decodes byte offset of the input associated with lexer to line and column
+ * and passes them back in line and column.  Passes back zero in both if
+ * offset lies beyond the end of the input.  Symbols only record their byte
+ * offsets, a client that stores positions should store offsets and decode
+ * them when a diagnostic or writer needs line and column.
+ * ----------------------------------------------------------------------- */
+
+void m2t_lexer_position_for_offset
+  (m2t_lexer_t lexer, uint32_t offset, uint_t *line, uint_t *column);
+
+
 /* --------------------------------------------------------------------------
  * function m2t_lexer_lookahead_line(lexer)
  * --------------------------------------------------------------------------
- * Returns the line counter of the lookahead symbol.
+ * Returns the line counter of the lookahead symbol,
+ * decoded from its byte offset.
  * ----------------------------------------------------------------------- */
 
 uint_t m2t_lexer_lookahead_line (m2t_lexer_t lexer);
@@ -201,7 +390,8 @@ uint_t m2t_lexer_lookahead_line (m2t_lexer_t lexer);
 /* --------------------------------------------------------------------------
  * function m2t_lexer_current_line(lexer)
  * --------------------------------------------------------------------------
- * Returns the line counter of the most recently consumed symbol.
+ * Returns the line counter of the most recently consumed symbol,
+ * decoded from its byte offset.
  * ----------------------------------------------------------------------- */
 
 uint_t m2t_lexer_current_line (m2t_lexer_t lexer);
@@ -210,7 +400,8 @@ uint_t m2t_lexer_current_line (m2t_lexer_t lexer);
 /* --------------------------------------------------------------------------
  * function m2t_lexer_lookahead_column(lexer)
  * --------------------------------------------------------------------------
- * Returns the column counter of the lookahead symbol.
+ * Returns the column counter of the lookahead symbol,
+ * decoded from its byte offset.
  * ----------------------------------------------------------------------- */
 
 uint_t m2t_lexer_lookahead_column (m2t_lexer_t lexer);
@@ -219,7 +410,8 @@ uint_t m2t_lexer_lookahead_column (m2t_lexer_t lexer);
 /* --------------------------------------------------------------------------
  * function m2t_lexer_current_column(lexer)
  * --------------------------------------------------------------------------
- * Returns the column counter of the most recently consumed symbol.
+ * Returns the column counter of the most recently consumed symbol,
+ * decoded from its byte offset.
  * ----------------------------------------------------------------------- */
 
 uint_t m2t_lexer_current_column (m2t_lexer_t lexer);
@@ -236,6 +428,66 @@ void m2t_print_line_and_mark_column
   (m2t_lexer_t lexer, uint_t line, uint_t column);
 
 
+/* --------------------------------------------------------------------------
+ * procedure m2t_lexer_pretokenize(lexer, status)
+ * --------------------------------------------------------------------------
+ * Tokenizes the remainder of the input associated with lexer in one pass
+ * and stores the symbols in a contiguous token stream.  Thereafter, symbols
+ * are served from the stream, which permits arbitrary lookahead by function
+ * m2t_lexer_peek_sym() and backtracking by procedure m2t_lexer_rewind().
+ * ----------------------------------------------------------------------- */
+
+void m2t_lexer_pretokenize (m2t_lexer_t lexer, m2t_lexer_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_lexer_peek_sym(lexer, n)
+ * --------------------------------------------------------------------------
+ * Returns the token of the n-th symbol following the lookahead symbol
+ * without consuming any symbols.  For n = 0 the lookahead token is returned.
+ * Returns TOKEN_UNKNOWN if lexer has not been pre-tokenized and n > 0, or
+ * if the n-th symbol has not been stored in the stream.  Returns
+ * TOKEN_END_OF_FILE if the n-th symbol lies beyond the end of the input.
+ * ----------------------------------------------------------------------- */
+
+m2t_token_t m2t_lexer_peek_sym (m2t_lexer_t lexer, uint_t n);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_lexer_position(lexer)
+ * --------------------------------------------------------------------------
+ * Returns the stream position of the lookahead symbol of a pre-tokenized
+ * lexer for use with procedure m2t_lexer_rewind().  Returns zero if lexer
+ * has not been pre-tokenized or the lookahead lies beyond the stream.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2t_lexer_position (m2t_lexer_t lexer);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_lexer_rewind(lexer, position, status)
+ * --------------------------------------------------------------------------
+ * Resets the lookahead symbol of a pre-tokenized lexer to the symbol at
+ * the given stream position, previously obtained by m2t_lexer_position().
+ * ----------------------------------------------------------------------- */
+
+void m2t_lexer_rewind
+  (m2t_lexer_t lexer, uint_t position, m2t_lexer_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_lexer_start_pipeline(lexer, status)
+ * --------------------------------------------------------------------------
+ * Starts a thread that lexes the remainder of the input associated with
+ * lexer ahead of the parser.  Thereafter, symbols are served in blocks
+ * passed from that thread, together with their lines, columns and lexemes.
+ * The string repository must have been initialised in concurrent mode.
+ * ----------------------------------------------------------------------- */
+
+void m2t_lexer_start_pipeline
+  (m2t_lexer_t lexer, m2t_lexer_status_t *status);
+
+
 /* --------------------------------------------------------------------------
  * procedure m2t_release_lexer(lexer, status)
  * --------------------------------------------------------------------------
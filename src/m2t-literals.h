@@ -0,0 +1,199 @@
+/* M2T -- Sorce to Source Modula-2 Translator
+ *
+ * Copyright (c) 2016-2023 Benjamin Kowarsch
+ *
+ * Author & Maintainer: Benjamin Kowarsch <org.m2sf>
+ *
+ * @synopsis
+ *
+ * M2T is a multi-dialect Modula-2 source-to-source translator. It translates
+ * source files  written in the  classic dialects  to semantically equivalent
+ * source files in  Modula-2 Revision 2010 (M2R10).  It supports  the classic
+ * Modula-2 dialects  described in  the 2nd, 3rd and 4th editions  of Niklaus
+ * Wirth's book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * For more details please visit: https://github.com/trijezdci/m2t/wiki
+ *
+ * @repository
+ *
+ * https://github.com/trijezdci/m2t
+ *
+ * @file
+ *
+ * m2t-literals.h
+ *
+ * Public interface for M2T number literal values.
+ *
+ * @license
+ *
+ * M2T is free software:  You can redistribute and modify it  under the terms
+ * of the  GNU Lesser General Public License (LGPL) either version 2.1  or at
+ * your choice version 3, both as published by the Free Software Foundation.
+ *
+ * M2T is distributed  in the hope  that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even  the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received  a copy of the  GNU Lesser General Public License
+ * along with M2T.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+
+#ifndef M2T_LITERALS_H
+#define M2T_LITERALS_H
+
+#include "m2t-common.h"
+#include "m2t-unique-string.h"
+
+
+/* --------------------------------------------------------------------------
+ * Number literal values
+ * --------------------------------------------------------------------------
+ * While the lexer scans a number literal, it converts the literal to its
+ * value and records the value in the literal repository, keyed by the
+ * literal's interned lexeme.  Later stages look the value up by lexeme
+ * instead of parsing the lexeme again.  Values are only recorded while
+ * the repository is initialised.  Literals whose values do not fit into
+ * 64 bits are not recorded, a failed lookup means the value is unknown.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * type m2t_literal_kind_t
+ * --------------------------------------------------------------------------
+ * Enumerated kinds of literal values.  Whole number literals and character
+ * code literals have whole values, real number literals have real values.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2T_LITERAL_WHOLE,
+  M2T_LITERAL_REAL
+} m2t_literal_kind_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2t_literal_t
+ * --------------------------------------------------------------------------
+ * record type representing the value of a number literal.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* kind */ m2t_literal_kind_t kind;
+  /* value */ union {
+    /* whole */ uint64_t whole;
+    /* real */ double real;
+  } value;
+} m2t_literal_t;
+
+
+/* --------------------------------------------------------------------------
+ * Digit classes
+ * --------------------------------------------------------------------------
+ * Bits returned by function m2t_digit_classes().
+ * ----------------------------------------------------------------------- */
+
+#define M2T_DIGITS_HAVE_8_OR_9 (1 << 0)
+
+#define M2T_DIGITS_HAVE_A_TO_F (1 << 1)
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_init_literal_repository()
+ * --------------------------------------------------------------------------
+ * Allocates and initialises the global literal repository.  Returns true
+ * on success or if the repository is already initialised, false if it
+ * could not be allocated.  Must not race with any other function of the
+ * repository.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_init_literal_repository (void);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_literal_enter(lexeme, literal)
+ * --------------------------------------------------------------------------
+ * Records literal as the value of lexeme, retaining lexeme.  Returns true
+ * on success, or false if the repository is not initialised, if lexeme or
+ * literal is NULL or if the repository could not be grown.  May be called
+ * concurrently from the threads of pipelined lexers.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_literal_enter (m2t_string_t lexeme, const m2t_literal_t *literal);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_literal_lookup(lexeme, literal)
+ * --------------------------------------------------------------------------
+ * Passes the value recorded for lexeme back in literal and returns true.
+ * Returns false and leaves literal unmodified if no value is recorded for
+ * lexeme or if the repository is not initialised.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_literal_lookup (m2t_string_t lexeme, m2t_literal_t *literal);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_literal_count()
+ * --------------------------------------------------------------------------
+ * Returns the number of values recorded in the literal repository.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2t_literal_count (void);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_dispose_literal_repository()
+ * --------------------------------------------------------------------------
+ * Deallocates the global literal repository and releases its lexemes.
+ * Must not race with any other function of the repository.
+ * ----------------------------------------------------------------------- */
+
+void m2t_dispose_literal_repository (void);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_digit_classes(digits, length)
+ * --------------------------------------------------------------------------
+ * Returns the set of digit classes found in the sequence of the given
+ * length at digits, which must consist of characters '0' to '9' and 'A'
+ * to 'F' only (NOT GUARDED).  The sequence is classified eight characters
+ * at a time.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2t_digit_classes (const char *digits, uint_t length);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_decimal_value(digits, length, value)
+ * --------------------------------------------------------------------------
+ * Converts the sequence of decimal digits of the given length at digits,
+ * eight digits at a time, and passes the result back in value.  Returns
+ * false and leaves value unmodified if the result does not fit 64 bits.
+ * The sequence must consist of characters '0' to '9' only (NOT GUARDED).
+ * ----------------------------------------------------------------------- */
+
+bool m2t_decimal_value (const char *digits, uint_t length, uint64_t *value);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_octal_value(digits, length, value)
+ * --------------------------------------------------------------------------
+ * Like m2t_decimal_value() but for octal digits '0' to '7'.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_octal_value (const char *digits, uint_t length, uint64_t *value);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_hex_value(digits, length, value)
+ * --------------------------------------------------------------------------
+ * Like m2t_decimal_value() but for hexadecimal digits '0' to '9' and 'A'
+ * to 'F', which are converted eight at a time.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_hex_value (const char *digits, uint_t length, uint64_t *value);
+
+
+#endif /* M2T_LITERALS_H */
+
+/* END OF FILE */
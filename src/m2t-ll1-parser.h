@@ -0,0 +1,81 @@
+/* M2T -- Sorce to Source Modula-2 Translator
+ *
+ * Copyright (c) 2016-2023 Benjamin Kowarsch
+ *
+ * Author & Maintainer: Benjamin Kowarsch <org.m2sf>
+ *
+ * @synopsis
+ *
+ * M2T is a multi-dialect Modula-2 source-to-source translator. It translates
+ * source files  written in the  classic dialects  to semantically equivalent
+ * source files in  Modula-2 Revision 2010 (M2R10).  It supports  the classic
+ * Modula-2 dialects  described in  the 2nd, 3rd and 4th editions  of Niklaus
+ * Wirth's book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * For more details please visit: https://github.com/trijezdci/m2t/wiki
+ *
+ * @repository
+ *
+ * https://github.com/trijezdci/m2t
+ *
+ * @file
+ *
+ * m2t-ll1-parser.h
+ *
+ * Public interface for M2T table driven LL(1) parser engine.
+ *
+ * @license
+ *
+ * M2T is free software:  You can redistribute and modify it  under the terms
+ * of the  GNU Lesser General Public License (LGPL) either version 2.1  or at
+ * your choice version 3, both as published by the Free Software Foundation.
+ *
+ * M2T is distributed  in the hope  that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even  the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received  a copy of the  GNU Lesser General Public License
+ * along with M2T.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#ifndef M2T_LL1_PARSER_H
+#define M2T_LL1_PARSER_H
+
+#include "m2t-common.h"
+#include "m2t-lexer.h"
+#include "m2t-parser.h"
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_ll1_parse(srctype, lexer, status)
+ * --------------------------------------------------------------------------
+ * Parses the source read by lexer with the table driven LL(1) parser engine
+ * and returns the number of syntax errors found.  The parser tables are
+ * generated by gen/m2t-gen-ll1.c from grammar/m2-grammar.gll.  The engine
+ * checks syntax only, it does not build an abstract syntax tree.  The
+ * lexer is not released.
+ *
+ * pre-conditions:
+ * o  srctype must be a valid source type
+ * o  lexer must be a valid lexer positioned at the start of its source
+ *
+ * post-conditions:
+ * o  the source has been consumed up to and including end of file
+ * o  syntax errors have been reported to the console
+ * o  M2T_PARSER_STATUS_SUCCESS is passed back in status, unless NULL
+ *
+ * error-conditions:
+ * o  if allocation fails, parsing ends, the number of errors found until
+ *    then is returned and M2T_PARSER_STATUS_ALLOCATION_FAILED is passed
+ *    back in status, unless NULL
+ * ----------------------------------------------------------------------- */
+
+uint_t m2t_ll1_parse
+  (m2t_sourcetype_t srctype,      /* in */
+   m2t_lexer_t lexer,             /* in */
+   m2t_parser_status_t *status);  /* out */
+
+
+#endif /* M2T_LL1_PARSER_H */
+
+/* END OF FILE */
@@ -0,0 +1,2165 @@
+/* M2T -- Sorce to Source Modula-2 Translator
+ *
+ * @file
+ *
+ * m2t-ll1-tables.h
+ *
+ * Generated by m2t-gen-ll1 from m2-grammar.gll, do not edit.
+ * Change the grammar and regenerate instead.
+ */
+
+#ifndef M2T_LL1_TABLES_H
+#define M2T_LL1_TABLES_H
+
+#define M2T_LL1_NONTERMINAL_BASE 128
+
+#define M2T_LL1_NONTERMINAL_COUNT 137
+
+#define M2T_LL1_RULE_COUNT 252
+
+#define M2T_LL1_DIALECT_COUNT 2
+
+#define M2T_LL1_START_COMPILATION_UNIT 128
+
+#define M2T_LL1_START_DEFINITION_MODULE 129
+
+#define M2T_LL1_START_IMPLEMENTATION_MODULE 131
+
+#define M2T_LL1_START_PROGRAM_MODULE 132
+
+
+static const char *const m2t_ll1_nonterminal_name[] = {
+  "compilationUnit",
+  "definitionModule",
+  "definitionModule~2",
+  "implementationModule",
+  "programModule",
+  "definitionModule/1",
+  "import",
+  "definitionModule/2",
+  "export",
+  "definitionModule/3",
+  "definition",
+  "definitionModule~2/1",
+  "definitionModule~2/2",
+  "definitionModule~2/3",
+  "programModule/1",
+  "modulePriority",
+  "programModule/2",
+  "block",
+  "import/1",
+  "qualifiedImport",
+  "unqualifiedImport",
+  "export/1",
+  "identList",
+  "definition/1",
+  "constDefinition",
+  "definition/2",
+  "typeDefinition",
+  "definition/3",
+  "variableDeclaration",
+  "procedureHeader",
+  "expression",
+  "block/1",
+  "declaration",
+  "block/2",
+  "statementSequence",
+  "identList/1",
+  "typeDefinition/1",
+  "type",
+  "procedureSignature",
+  "simpleExpression",
+  "expression/1",
+  "OperL1",
+  "declaration/1",
+  "declaration/2",
+  "typeDeclaration",
+  "declaration/3",
+  "procedureDeclaration",
+  "moduleDeclaration",
+  "statement",
+  "statementSequence/1",
+  "derivedOrSubrangeType",
+  "enumType",
+  "setType",
+  "arrayType",
+  "recordType",
+  "pointerType",
+  "procedureType",
+  "procedureSignature/1",
+  "procedureSignature/2",
+  "formalParamList",
+  "procedureSignature/3",
+  "qualident",
+  "simpleExpression/1",
+  "term",
+  "simpleExpression/2",
+  "OperL2",
+  "moduleDeclaration/1",
+  "moduleDeclaration/2",
+  "moduleDeclaration/3",
+  "assignmentOrProcCall",
+  "returnStatement",
+  "withStatement",
+  "ifStatement",
+  "caseStatement",
+  "loopStatement",
+  "whileStatement",
+  "repeatStatement",
+  "forStatement",
+  "derivedOrSubrangeType/1",
+  "range",
+  "countableType",
+  "arrayType/1",
+  "fieldList",
+  "procedureType/1",
+  "procedureType/2",
+  "formalType",
+  "procedureType/3",
+  "procedureType/4",
+  "formalParams",
+  "formalParamList/1",
+  "qualident/1",
+  "simpleTerm",
+  "term/1",
+  "OperL3",
+  "designator",
+  "assignmentOrProcCall/1",
+  "actualParameters",
+  "returnStatement/1",
+  "ifStatement/1",
+  "ifStatement/2",
+  "case",
+  "caseStatement/1",
+  "caseStatement/2",
+  "forStatement/1",
+  "countableType/1",
+  "field",
+  "fieldList/1",
+  "simpleFormalType",
+  "attributedFormalType",
+  "simpleFormalParams",
+  "attribFormalParams",
+  "simpleTerm/1",
+  "factor",
+  "designator/1",
+  "selector",
+  "actualParameters/1",
+  "expressionList",
+  "caseLabelList",
+  "field/1",
+  "variantField",
+  "simpleFormalType/1",
+  "NumberLiteral",
+  "setValue",
+  "designatorOrFuncCall",
+  "expressionList/1",
+  "caseLabels",
+  "caseLabelList/1",
+  "variantField/1",
+  "variant",
+  "variantField/2",
+  "variantField/3",
+  "element",
+  "setValue/1",
+  "designatorOrFuncCall/1",
+  "designatorOrFuncCall/2",
+  "caseLabels/1",
+  "element/1"
+}; /* end m2t_ll1_nonterminal_name */
+
+static const uint16_t m2t_ll1_rhs_start[] = {
+  0, 1, 2, 3, 5, 5, 6, 6, 8, 8, 18, 18, 20, 20, 22, 22, 32, 34, 35, 35, 37, 37,
+  45, 46, 47, 49, 50, 50, 54, 57, 57, 59, 62, 62, 64, 67, 67, 69, 71, 74, 76,
+  76, 78, 78, 81, 83, 87, 90, 90, 92, 95, 97, 97, 99, 102, 104, 106, 106, 108,
+  111, 111, 113, 116, 116, 118, 121, 121, 123, 125, 127, 130, 130, 132, 133,
+  134, 135, 136, 137, 138, 139, 140, 140, 142, 142, 146, 146, 148, 149, 150,
+  150, 153, 153, 156, 157, 158, 159, 160, 161, 162, 163, 166, 170, 171, 171,
+  173, 173, 174, 174, 182, 183, 184, 185, 186, 187, 188, 189, 190, 191, 192,
+  193, 193, 195, 196, 199, 202, 205, 205, 210, 213, 216, 219, 219, 221, 221,
+  224, 224, 226, 226, 229, 232, 232, 234, 237, 237, 239, 242, 242, 244, 245,
+  246, 247, 249, 250, 250, 252, 253, 253, 255, 260, 265, 265, 267, 267, 274,
+  277, 277, 279, 279, 286, 289, 294, 298, 300, 300, 310, 315, 316, 317, 318,
+  318, 320, 323, 323, 325, 326, 327, 328, 329, 330, 330, 332, 333, 334, 335,
+  336, 337, 339, 339, 341, 342, 342, 345, 348, 350, 352, 352, 353, 355, 355,
+  357, 359, 362, 364, 365, 366, 367, 368, 369, 370, 371, 374, 375, 377, 380,
+  383, 383, 385, 388, 388, 390, 391, 391, 394, 394, 396, 396, 405, 408, 408,
+  412, 413, 414, 414, 417, 417, 419, 421, 421, 423, 426, 428, 428, 430
+}; /* end m2t_ll1_rhs_start */
+
+static const uint16_t m2t_ll1_rhs[] = {
+  /* compilationUnit := definitionModule */
+  129,
+  /* compilationUnit := implementationModule */
+  131,
+  /* compilationUnit := programModule */
+  132,
+  /* definitionModule/1 := import definitionModule/1 */
+  133, 134,
+  /* definitionModule/1 := (empty) */
+  /* definitionModule/2 := export */
+  136,
+  /* definitionModule/2 := (empty) */
+  /* definitionModule/3 := definition definitionModule/3 */
+  137, 138,
+  /* definitionModule/3 := (empty) */
+  /* definitionModule := DEFINITION MODULE IDENTIFIER ';' definitionModule/1
+      definitionModule/2 definitionModule/3 END IDENTIFIER '.' */
+  62, 41, 12, 137, 135, 133, 64, 41, 23, 7,
+  /* definitionModule~2/1 := (empty) */
+  /* definitionModule~2/2 := import definitionModule~2/2 */
+  140, 134,
+  /* definitionModule~2/2 := (empty) */
+  /* definitionModule~2/3 := definition definitionModule~2/3 */
+  141, 138,
+  /* definitionModule~2/3 := (empty) */
+  /* definitionModule~2 := definitionModule~2/1 DEFINITION MODULE IDENTIFIER
+      ';' definitionModule~2/2 definitionModule~2/3 END IDENTIFIER '.' */
+  62, 41, 12, 141, 140, 64, 41, 23, 7, 139,
+  /* implementationModule := IMPLEMENTATION programModule */
+  132, 18,
+  /* programModule/1 := modulePriority */
+  143,
+  /* programModule/1 := (empty) */
+  /* programModule/2 := import programModule/2 */
+  144, 134,
+  /* programModule/2 := (empty) */
+  /* programModule := MODULE IDENTIFIER programModule/1 ';' programModule/2
+      block IDENTIFIER '.' */
+  62, 41, 145, 144, 64, 142, 41, 23,
+  /* import/1 := qualifiedImport */
+  147,
+  /* import/1 := unqualifiedImport */
+  148,
+  /* import := import/1 ';' */
+  64, 146,
+  /* export/1 := QUALIFIED */
+  29,
+  /* export/1 := (empty) */
+  /* export := EXPORT export/1 identList ';' */
+  64, 150, 149, 14,
+  /* definition/1 := constDefinition ';' definition/1 */
+  151, 64, 152,
+  /* definition/1 := (empty) */
+  /* definition := CONST definition/1 */
+  151, 6,
+  /* definition/2 := typeDefinition ';' definition/2 */
+  153, 64, 154,
+  /* definition/2 := (empty) */
+  /* definition := TYPE definition/2 */
+  153, 36,
+  /* definition/3 := variableDeclaration ';' definition/3 */
+  155, 64, 156,
+  /* definition/3 := (empty) */
+  /* definition := VAR definition/3 */
+  155, 38,
+  /* definition := procedureHeader ';' */
+  64, 157,
+  /* modulePriority := '[' expression ']' */
+  71, 158, 70,
+  /* block/1 := declaration block/1 */
+  159, 160,
+  /* block/1 := (empty) */
+  /* block/2 := BEGIN statementSequence */
+  162, 3,
+  /* block/2 := (empty) */
+  /* block := block/1 block/2 END */
+  12, 161, 159,
+  /* qualifiedImport := IMPORT identList */
+  150, 19,
+  /* unqualifiedImport := FROM IDENTIFIER IMPORT identList */
+  150, 19, 41, 16,
+  /* identList/1 := ',' IDENTIFIER identList/1 */
+  163, 41, 61,
+  /* identList/1 := (empty) */
+  /* identList := IDENTIFIER identList/1 */
+  163, 41,
+  /* constDefinition := IDENTIFIER '=' expression */
+  158, 52, 41,
+  /* typeDefinition/1 := '=' type */
+  165, 52,
+  /* typeDefinition/1 := (empty) */
+  /* typeDefinition := IDENTIFIER typeDefinition/1 */
+  164, 41,
+  /* variableDeclaration := identList ':' type */
+  165, 63, 150,
+  /* procedureHeader := PROCEDURE procedureSignature */
+  166, 28,
+  /* expression/1 := OperL1 simpleExpression */
+  167, 169,
+  /* expression/1 := (empty) */
+  /* expression := simpleExpression expression/1 */
+  168, 167,
+  /* declaration/1 := constDefinition ';' declaration/1 */
+  170, 64, 152,
+  /* declaration/1 := (empty) */
+  /* declaration := CONST declaration/1 */
+  170, 6,
+  /* declaration/2 := typeDeclaration ';' declaration/2 */
+  171, 64, 172,
+  /* declaration/2 := (empty) */
+  /* declaration := TYPE declaration/2 */
+  171, 36,
+  /* declaration/3 := variableDeclaration ';' declaration/3 */
+  173, 64, 156,
+  /* declaration/3 := (empty) */
+  /* declaration := VAR declaration/3 */
+  173, 38,
+  /* declaration := procedureDeclaration ';' */
+  64, 174,
+  /* declaration := moduleDeclaration ';' */
+  64, 175,
+  /* statementSequence/1 := ';' statement statementSequence/1 */
+  177, 176, 64,
+  /* statementSequence/1 := (empty) */
+  /* statementSequence := statement statementSequence/1 */
+  177, 176,
+  /* type := derivedOrSubrangeType */
+  178,
+  /* type := enumType */
+  179,
+  /* type := setType */
+  180,
+  /* type := arrayType */
+  181,
+  /* type := recordType */
+  182,
+  /* type := pointerType */
+  183,
+  /* type := procedureType */
+  184,
+  /* procedureSignature/2 := formalParamList */
+  187,
+  /* procedureSignature/2 := (empty) */
+  /* procedureSignature/3 := ':' qualident */
+  189, 63,
+  /* procedureSignature/3 := (empty) */
+  /* procedureSignature/1 := '(' procedureSignature/2 ')'
+      procedureSignature/3 */
+  188, 69, 186, 68,
+  /* procedureSignature/1 := (empty) */
+  /* procedureSignature := IDENTIFIER procedureSignature/1 */
+  185, 41,
+  /* simpleExpression/1 := '+' */
+  50,
+  /* simpleExpression/1 := '-' */
+  51,
+  /* simpleExpression/1 := (empty) */
+  /* simpleExpression/2 := OperL2 term simpleExpression/2 */
+  192, 191, 193,
+  /* simpleExpression/2 := (empty) */
+  /* simpleExpression := simpleExpression/1 term simpleExpression/2 */
+  192, 191, 190,
+  /* OperL1 := '=' */
+  52,
+  /* OperL1 := '#' */
+  53,
+  /* OperL1 := '<' */
+  54,
+  /* OperL1 := '<=' */
+  55,
+  /* OperL1 := '>' */
+  56,
+  /* OperL1 := '>=' */
+  57,
+  /* OperL1 := IN */
+  20,
+  /* typeDeclaration := IDENTIFIER '=' type */
+  165, 52, 41,
+  /* procedureDeclaration := procedureHeader ';' block IDENTIFIER */
+  41, 145, 64, 157,
+  /* moduleDeclaration/1 := modulePriority */
+  143,
+  /* moduleDeclaration/1 := (empty) */
+  /* moduleDeclaration/2 := import moduleDeclaration/2 */
+  195, 134,
+  /* moduleDeclaration/2 := (empty) */
+  /* moduleDeclaration/3 := export */
+  136,
+  /* moduleDeclaration/3 := (empty) */
+  /* moduleDeclaration := MODULE IDENTIFIER moduleDeclaration/1 ';'
+      moduleDeclaration/2 moduleDeclaration/3 block IDENTIFIER */
+  41, 145, 196, 195, 64, 194, 41, 23,
+  /* statement := assignmentOrProcCall */
+  197,
+  /* statement := returnStatement */
+  198,
+  /* statement := withStatement */
+  199,
+  /* statement := ifStatement */
+  200,
+  /* statement := caseStatement */
+  201,
+  /* statement := loopStatement */
+  202,
+  /* statement := whileStatement */
+  203,
+  /* statement := repeatStatement */
+  204,
+  /* statement := forStatement */
+  205,
+  /* statement := EXIT */
+  13,
+  /* derivedOrSubrangeType/1 := range */
+  207,
+  /* derivedOrSubrangeType/1 := (empty) */
+  /* derivedOrSubrangeType := qualident derivedOrSubrangeType/1 */
+  206, 189,
+  /* derivedOrSubrangeType := range */
+  207,
+  /* enumType := '(' identList ')' */
+  69, 150, 68,
+  /* setType := SET OF countableType */
+  208, 25, 33,
+  /* arrayType/1 := ',' countableType arrayType/1 */
+  209, 208, 61,
+  /* arrayType/1 := (empty) */
+  /* arrayType := ARRAY countableType arrayType/1 OF type */
+  165, 25, 209, 208, 2,
+  /* recordType := RECORD fieldList END */
+  12, 210, 30,
+  /* pointerType := POINTER TO type */
+  165, 35, 27,
+  /* procedureType/3 := ',' formalType procedureType/3 */
+  214, 213, 61,
+  /* procedureType/3 := (empty) */
+  /* procedureType/2 := formalType procedureType/3 */
+  214, 213,
+  /* procedureType/2 := (empty) */
+  /* procedureType/1 := '(' procedureType/2 ')' */
+  69, 212, 68,
+  /* procedureType/1 := (empty) */
+  /* procedureType/4 := ':' qualident */
+  189, 63,
+  /* procedureType/4 := (empty) */
+  /* procedureType := PROCEDURE procedureType/1 procedureType/4 */
+  215, 211, 28,
+  /* formalParamList/1 := ';' formalParams formalParamList/1 */
+  217, 216, 64,
+  /* formalParamList/1 := (empty) */
+  /* formalParamList := formalParams formalParamList/1 */
+  217, 216,
+  /* qualident/1 := '.' IDENTIFIER qualident/1 */
+  218, 41, 62,
+  /* qualident/1 := (empty) */
+  /* qualident := IDENTIFIER qualident/1 */
+  218, 41,
+  /* term/1 := OperL3 simpleTerm term/1 */
+  220, 219, 221,
+  /* term/1 := (empty) */
+  /* term := simpleTerm term/1 */
+  220, 219,
+  /* OperL2 := '+' */
+  50,
+  /* OperL2 := '-' */
+  51,
+  /* OperL2 := OR */
+  26,
+  /* assignmentOrProcCall/1 := ':=' expression */
+  158, 60,
+  /* assignmentOrProcCall/1 := actualParameters */
+  224,
+  /* assignmentOrProcCall/1 := (empty) */
+  /* assignmentOrProcCall := designator assignmentOrProcCall/1 */
+  223, 222,
+  /* returnStatement/1 := expression */
+  158,
+  /* returnStatement/1 := (empty) */
+  /* returnStatement := RETURN returnStatement/1 */
+  225, 32,
+  /* withStatement := WITH designator DO statementSequence END */
+  12, 162, 9, 222, 40,
+  /* ifStatement/1 := ELSIF expression THEN statementSequence ifStatement/1 */
+  226, 162, 34, 158, 11,
+  /* ifStatement/1 := (empty) */
+  /* ifStatement/2 := ELSE statementSequence */
+  162, 10,
+  /* ifStatement/2 := (empty) */
+  /* ifStatement := IF expression THEN statementSequence ifStatement/1
+      ifStatement/2 END */
+  12, 227, 226, 162, 34, 158, 17,
+  /* caseStatement/1 := '|' case caseStatement/1 */
+  229, 228, 67,
+  /* caseStatement/1 := (empty) */
+  /* caseStatement/2 := ELSE statementSequence */
+  162, 10,
+  /* caseStatement/2 := (empty) */
+  /* caseStatement := CASE expression OF case caseStatement/1
+      caseStatement/2 END */
+  12, 230, 229, 228, 25, 158, 5,
+  /* loopStatement := LOOP statementSequence END */
+  12, 162, 21,
+  /* whileStatement := WHILE expression DO statementSequence END */
+  12, 162, 9, 158, 39,
+  /* repeatStatement := REPEAT statementSequence UNTIL expression */
+  158, 37, 162, 31,
+  /* forStatement/1 := BY expression */
+  158, 4,
+  /* forStatement/1 := (empty) */
+  /* forStatement := FOR IDENTIFIER ':=' expression TO expression
+      forStatement/1 DO statementSequence END */
+  12, 162, 9, 231, 158, 35, 158, 60, 41, 15,
+  /* range := '[' expression '..' expression ']' */
+  71, 158, 65, 158, 70,
+  /* countableType := range */
+  207,
+  /* countableType := enumType */
+  179,
+  /* countableType/1 := range */
+  207,
+  /* countableType/1 := (empty) */
+  /* countableType := qualident countableType/1 */
+  232, 189,
+  /* fieldList/1 := ';' field fieldList/1 */
+  234, 233, 64,
+  /* fieldList/1 := (empty) */
+  /* fieldList := field fieldList/1 */
+  234, 233,
+  /* formalType := simpleFormalType */
+  235,
+  /* formalType := attributedFormalType */
+  236,
+  /* formalParams := simpleFormalParams */
+  237,
+  /* formalParams := attribFormalParams */
+  238,
+  /* simpleTerm/1 := NOT */
+  24,
+  /* simpleTerm/1 := (empty) */
+  /* simpleTerm := simpleTerm/1 factor */
+  240, 239,
+  /* OperL3 := '*' */
+  58,
+  /* OperL3 := '/' */
+  59,
+  /* OperL3 := DIV */
+  8,
+  /* OperL3 := MOD */
+  22,
+  /* OperL3 := AND */
+  1,
+  /* designator/1 := selector designator/1 */
+  241, 242,
+  /* designator/1 := (empty) */
+  /* designator := qualident designator/1 */
+  241, 189,
+  /* actualParameters/1 := expressionList */
+  244,
+  /* actualParameters/1 := (empty) */
+  /* actualParameters := '(' actualParameters/1 ')' */
+  69, 243, 68,
+  /* case := caseLabelList ':' statementSequence */
+  162, 63, 245,
+  /* field/1 := variableDeclaration field/1 */
+  246, 156,
+  /* field/1 := variantField field/1 */
+  246, 247,
+  /* field/1 := (empty) */
+  /* field := field/1 */
+  246,
+  /* simpleFormalType/1 := ARRAY OF */
+  25, 2,
+  /* simpleFormalType/1 := (empty) */
+  /* simpleFormalType := simpleFormalType/1 qualident */
+  189, 248,
+  /* attributedFormalType := VAR simpleFormalType */
+  235, 38,
+  /* simpleFormalParams := identList ':' formalType */
+  213, 63, 150,
+  /* attribFormalParams := VAR simpleFormalParams */
+  237, 38,
+  /* NumberLiteral := INTEGER-LITERAL */
+  43,
+  /* NumberLiteral := REAL-LITERAL */
+  44,
+  /* NumberLiteral := CHAR-LITERAL */
+  45,
+  /* factor := NumberLiteral */
+  249,
+  /* factor := STRING-LITERAL */
+  42,
+  /* factor := setValue */
+  250,
+  /* factor := designatorOrFuncCall */
+  251,
+  /* factor := '(' expression ')' */
+  69, 158, 68,
+  /* selector := '^' */
+  66,
+  /* selector := '.' IDENTIFIER */
+  41, 62,
+  /* selector := '[' expressionList ']' */
+  71, 244, 70,
+  /* expressionList/1 := ',' expression expressionList/1 */
+  252, 158, 61,
+  /* expressionList/1 := (empty) */
+  /* expressionList := expression expressionList/1 */
+  252, 158,
+  /* caseLabelList/1 := ',' caseLabels caseLabelList/1 */
+  254, 253, 61,
+  /* caseLabelList/1 := (empty) */
+  /* caseLabelList := caseLabels caseLabelList/1 */
+  254, 253,
+  /* variantField/1 := IDENTIFIER */
+  41,
+  /* variantField/1 := (empty) */
+  /* variantField/2 := '|' variant variantField/2 */
+  257, 256, 67,
+  /* variantField/2 := (empty) */
+  /* variantField/3 := ELSE fieldList */
+  210, 10,
+  /* variantField/3 := (empty) */
+  /* variantField := CASE variantField/1 ':' qualident OF variant
+      variantField/2 variantField/3 END */
+  12, 258, 257, 256, 25, 189, 63, 255, 5,
+  /* setValue/1 := ',' element setValue/1 */
+  260, 259, 61,
+  /* setValue/1 := (empty) */
+  /* setValue := '{' element setValue/1 '}' */
+  73, 260, 259, 72,
+  /* designatorOrFuncCall/1 := setValue */
+  250,
+  /* designatorOrFuncCall/2 := expressionList */
+  244,
+  /* designatorOrFuncCall/2 := (empty) */
+  /* designatorOrFuncCall/1 := '(' designatorOrFuncCall/2 ')' */
+  69, 262, 68,
+  /* designatorOrFuncCall/1 := (empty) */
+  /* designatorOrFuncCall := designator designatorOrFuncCall/1 */
+  261, 222,
+  /* caseLabels/1 := '..' expression */
+  158, 65,
+  /* caseLabels/1 := (empty) */
+  /* caseLabels := expression caseLabels/1 */
+  263, 158,
+  /* variant := caseLabelList ':' fieldList */
+  210, 63, 245,
+  /* element/1 := '..' expression */
+  158, 65,
+  /* element/1 := (empty) */
+  /* element := expression element/1 */
+  264, 158,
+  0 /* sentinel */
+}; /* end m2t_ll1_rhs */
+
+static const uint16_t m2t_ll1_dialect_nonterminal
+  [M2T_LL1_DIALECT_COUNT][M2T_LL1_NONTERMINAL_COUNT] = {
+  /* dialect 0 */
+  {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20,
+    21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39,
+    40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58,
+    59, 60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76, 77,
+    78, 79, 80, 81, 82, 83, 84, 85, 86, 87, 88, 89, 90, 91, 92, 93, 94, 95, 96,
+    97, 98, 99, 100, 101, 102, 103, 104, 105, 106, 107, 108, 109, 110, 111,
+    112, 113, 114, 115, 116, 117, 118, 119, 120, 121, 122, 123, 124, 125, 126,
+    127, 128, 129, 130, 131, 132, 133, 134, 135, 136
+  },
+  /* dialect 1 */
+  {
+    0, 2, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20,
+    21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39,
+    40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58,
+    59, 60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76, 77,
+    78, 79, 80, 81, 82, 83, 84, 85, 86, 87, 88, 89, 90, 91, 92, 93, 94, 95, 96,
+    97, 98, 99, 100, 101, 102, 103, 104, 105, 106, 107, 108, 109, 110, 111,
+    112, 113, 114, 115, 116, 117, 118, 119, 120, 121, 122, 123, 124, 125, 126,
+    127, 128, 129, 130, 131, 132, 133, 134, 135, 136
+  }
+}; /* end m2t_ll1_dialect_nonterminal */
+
+static const uint16_t m2t_ll1_predict
+  [M2T_LL1_NONTERMINAL_COUNT][TOKEN_END_MARK] = {
+  /* compilationUnit */
+  {
+    0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 3, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* definitionModule */
+  {
+    0, 0, 0, 0, 0, 0, 0, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* definitionModule~2 */
+  {
+    0, 0, 0, 0, 0, 0, 0, 16, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* implementationModule */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 17, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* programModule */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 22, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* definitionModule/1 */
+  {
+    0, 0, 0, 0, 0, 0, 5, 0, 0, 0, 0, 0, 5, 0, 5, 0, 4, 0, 0, 4, 0, 0, 0, 0, 0,
+    0, 0, 0, 5, 0, 0, 0, 0, 0, 0, 0, 5, 0, 5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* import */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 25, 0, 0, 25, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0
+  },
+  /* definitionModule/2 */
+  {
+    0, 0, 0, 0, 0, 0, 7, 0, 0, 0, 0, 0, 7, 0, 6, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 7, 0, 0, 0, 0, 0, 0, 0, 7, 0, 7, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* export */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 28, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* definitionModule/3 */
+  {
+    0, 0, 0, 0, 0, 0, 8, 0, 0, 0, 0, 0, 9, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 8, 0, 0, 0, 0, 0, 0, 0, 8, 0, 8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* definition */
+  {
+    0, 0, 0, 0, 0, 0, 31, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 38, 0, 0, 0, 0, 0, 0, 0, 34, 0, 37, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0
+  },
+  /* definitionModule~2/1 */
+  {
+    0, 0, 0, 0, 0, 0, 0, 11, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* definitionModule~2/2 */
+  {
+    0, 0, 0, 0, 0, 0, 13, 0, 0, 0, 0, 0, 13, 0, 0, 0, 12, 0, 0, 12, 0, 0, 0, 0,
+    0, 0, 0, 0, 13, 0, 0, 0, 0, 0, 0, 0, 13, 0, 13, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0
+  },
+  /* definitionModule~2/3 */
+  {
+    0, 0, 0, 0, 0, 0, 14, 0, 0, 0, 0, 0, 15, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 14, 0, 0, 0, 0, 0, 0, 0, 14, 0, 14, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0
+  },
+  /* programModule/1 */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 19, 0, 0, 0, 0, 0, 18, 0, 0, 0, 0
+  },
+  /* modulePriority */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 39, 0, 0, 0, 0
+  },
+  /* programModule/2 */
+  {
+    0, 0, 0, 21, 0, 0, 21, 0, 0, 0, 0, 0, 21, 0, 0, 0, 20, 0, 0, 20, 0, 0, 0,
+    21, 0, 0, 0, 0, 21, 0, 0, 0, 0, 0, 0, 0, 21, 0, 21, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0
+  },
+  /* block */
+  {
+    0, 0, 0, 44, 0, 0, 44, 0, 0, 0, 0, 0, 44, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 44,
+    0, 0, 0, 0, 44, 0, 0, 0, 0, 0, 0, 0, 44, 0, 44, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0
+  },
+  /* import/1 */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 24, 0, 0, 23, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0
+  },
+  /* qualifiedImport */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 45, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* unqualifiedImport */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 46, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* export/1 */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 26, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 27, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0
+  },
+  /* identList */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 49, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* definition/1 */
+  {
+    0, 0, 0, 0, 0, 0, 30, 0, 0, 0, 0, 0, 30, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 30, 0, 0, 0, 0, 0, 0, 0, 30, 0, 30, 0, 0, 29, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0
+  },
+  /* constDefinition */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 50, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* definition/2 */
+  {
+    0, 0, 0, 0, 0, 0, 33, 0, 0, 0, 0, 0, 33, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 33, 0, 0, 0, 0, 0, 0, 0, 33, 0, 33, 0, 0, 32, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0
+  },
+  /* typeDefinition */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 53, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* definition/3 */
+  {
+    0, 0, 0, 0, 0, 0, 36, 0, 0, 0, 0, 0, 36, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 36, 0, 0, 0, 0, 0, 0, 0, 36, 0, 36, 0, 0, 35, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0
+  },
+  /* variableDeclaration */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 54, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* procedureHeader */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 55, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* expression */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 58,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 58, 58, 58, 58, 58, 0, 0,
+    0, 0, 58, 58, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 58, 0, 0, 0,
+    58, 0, 0
+  },
+  /* block/1 */
+  {
+    0, 0, 0, 41, 0, 0, 40, 0, 0, 0, 0, 0, 41, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 40,
+    0, 0, 0, 0, 40, 0, 0, 0, 0, 0, 0, 0, 40, 0, 40, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0
+  },
+  /* declaration */
+  {
+    0, 0, 0, 0, 0, 0, 61, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 69,
+    0, 0, 0, 0, 68, 0, 0, 0, 0, 0, 0, 0, 64, 0, 67, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0
+  },
+  /* block/2 */
+  {
+    0, 0, 0, 42, 0, 0, 0, 0, 0, 0, 0, 0, 43, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0
+  },
+  /* statementSequence */
+  {
+    0, 0, 0, 0, 0, 72, 0, 0, 0, 0, 0, 0, 0, 72, 0, 72, 0, 72, 0, 0, 0, 72, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 72, 72, 0, 0, 0, 0, 0, 0, 72, 72, 72, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0
+  },
+  /* identList/1 */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 47, 0, 48, 48, 0, 0, 0, 0, 48, 0, 0, 0, 0,
+    0
+  },
+  /* typeDefinition/1 */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 51, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 52, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* type */
+  {
+    0, 0, 76, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 78, 79, 0, 77, 0, 0, 75, 0, 0, 0, 0, 0, 0, 0, 73, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 74, 0, 73, 0,
+    0, 0, 0
+  },
+  /* procedureSignature */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 86, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* simpleExpression */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 92,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 92, 92, 92, 92, 92, 0, 0,
+    0, 0, 92, 92, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 92, 0, 0, 0,
+    92, 0, 0
+  },
+  /* expression/1 */
+  {
+    0, 0, 0, 0, 57, 0, 0, 0, 0, 57, 57, 57, 57, 0, 0, 0, 0, 0, 0, 0, 56, 0, 0,
+    0, 0, 57, 0, 0, 0, 0, 0, 0, 0, 0, 57, 57, 0, 57, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 56, 56, 56, 56, 56, 56, 0, 0, 0, 57, 0, 57, 57, 57, 0, 57,
+    0, 57, 0, 57, 0, 57, 0
+  },
+  /* OperL1 */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 99, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 93, 94, 95, 96, 97, 98, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0
+  },
+  /* declaration/1 */
+  {
+    0, 0, 0, 60, 0, 0, 60, 0, 0, 0, 0, 0, 60, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 60,
+    0, 0, 0, 0, 60, 0, 0, 0, 0, 0, 0, 0, 60, 0, 60, 0, 0, 59, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0
+  },
+  /* declaration/2 */
+  {
+    0, 0, 0, 63, 0, 0, 63, 0, 0, 0, 0, 0, 63, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 63,
+    0, 0, 0, 0, 63, 0, 0, 0, 0, 0, 0, 0, 63, 0, 63, 0, 0, 62, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0
+  },
+  /* typeDeclaration */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 100, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0
+  },
+  /* declaration/3 */
+  {
+    0, 0, 0, 66, 0, 0, 66, 0, 0, 0, 0, 0, 66, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 66,
+    0, 0, 0, 0, 66, 0, 0, 0, 0, 0, 0, 0, 66, 0, 66, 0, 0, 65, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0
+  },
+  /* procedureDeclaration */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 101, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0
+  },
+  /* moduleDeclaration */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 108,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0
+  },
+  /* statement */
+  {
+    0, 0, 0, 0, 0, 113, 0, 0, 0, 0, 0, 0, 0, 118, 0, 117, 0, 112, 0, 0, 0, 114,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 116, 110, 0, 0, 0, 0, 0, 0, 115, 111, 109, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0
+  },
+  /* statementSequence/1 */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 71, 71, 71, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 71, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 70, 0, 0, 71, 0, 0, 0, 0, 0,
+    0, 0
+  },
+  /* derivedOrSubrangeType */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 121, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 122, 0, 0,
+    0, 0
+  },
+  /* enumType */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 123, 0, 0, 0, 0, 0, 0
+  },
+  /* setType */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 124, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0
+  },
+  /* arrayType */
+  {
+    0, 0, 127, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0
+  },
+  /* recordType */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0
+  },
+  /* pointerType */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 129, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0
+  },
+  /* procedureType */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 138, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0
+  },
+  /* procedureSignature/1 */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 85, 0, 0, 0, 84, 0, 0, 0, 0, 0, 0
+  },
+  /* procedureSignature/2 */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 80, 0, 0, 80, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 81, 0, 0, 0, 0,
+    0
+  },
+  /* formalParamList */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 141, 0, 0, 141, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0
+  },
+  /* procedureSignature/3 */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 82, 83, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* qualident */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 144, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0
+  },
+  /* simpleExpression/1 */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 89,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 89, 89, 89, 89, 89, 0, 0,
+    0, 0, 87, 88, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 89, 0, 0, 0,
+    89, 0, 0
+  },
+  /* term */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    147, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 147, 147, 147, 147,
+    147, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 147,
+    0, 0, 0, 147, 0, 0
+  },
+  /* simpleExpression/2 */
+  {
+    0, 0, 0, 0, 91, 0, 0, 0, 0, 91, 91, 91, 91, 0, 0, 0, 0, 0, 0, 0, 91, 0, 0,
+    0, 0, 91, 90, 0, 0, 0, 0, 0, 0, 0, 91, 91, 0, 91, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 90, 90, 91, 91, 91, 91, 91, 91, 0, 0, 0, 91, 0, 91, 91, 91, 0,
+    91, 0, 91, 0, 91, 0, 91, 0
+  },
+  /* OperL2 */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 150, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 148, 149, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0
+  },
+  /* moduleDeclaration/1 */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 103, 0, 0, 0, 0, 0, 102, 0, 0, 0,
+    0
+  },
+  /* moduleDeclaration/2 */
+  {
+    0, 0, 0, 105, 0, 0, 105, 0, 0, 0, 0, 0, 105, 0, 105, 0, 104, 0, 0, 104, 0,
+    0, 0, 105, 0, 0, 0, 0, 105, 0, 0, 0, 0, 0, 0, 0, 105, 0, 105, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0
+  },
+  /* moduleDeclaration/3 */
+  {
+    0, 0, 0, 107, 0, 0, 107, 0, 0, 0, 0, 0, 107, 0, 106, 0, 0, 0, 0, 0, 0, 0,
+    0, 107, 0, 0, 0, 0, 107, 0, 0, 0, 0, 0, 0, 0, 107, 0, 107, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0
+  },
+  /* assignmentOrProcCall */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 154, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0
+  },
+  /* returnStatement */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 157, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0
+  },
+  /* withStatement */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 158, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0
+  },
+  /* ifStatement */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 163, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0
+  },
+  /* caseStatement */
+  {
+    0, 0, 0, 0, 0, 168, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0
+  },
+  /* loopStatement */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 169, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0
+  },
+  /* whileStatement */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 170, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0
+  },
+  /* repeatStatement */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 171, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0
+  },
+  /* forStatement */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 174, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0
+  },
+  /* derivedOrSubrangeType/1 */
+  {
+    0, 0, 0, 0, 0, 120, 0, 0, 0, 0, 120, 0, 120, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 120, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 120, 0, 0, 120, 0, 0,
+    119, 0, 0, 0, 0
+  },
+  /* range */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 175, 0, 0, 0, 0
+  },
+  /* countableType */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 180, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 177, 0, 176, 0, 0,
+    0, 0
+  },
+  /* arrayType/1 */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    126, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 125, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0
+  },
+  /* fieldList */
+  {
+    0, 0, 0, 0, 0, 183, 0, 0, 0, 0, 183, 0, 183, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 183, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 183, 0, 0, 183, 0, 0, 0,
+    0, 0, 0, 0
+  },
+  /* procedureType/1 */
+  {
+    0, 0, 0, 0, 0, 135, 0, 0, 0, 0, 135, 0, 135, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 135, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 135, 135, 0, 0, 135, 134,
+    0, 0, 0, 0, 0, 0
+  },
+  /* procedureType/2 */
+  {
+    0, 0, 132, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 132, 0, 0, 132, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 133, 0, 0,
+    0, 0, 0
+  },
+  /* formalType */
+  {
+    0, 0, 184, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 185, 0, 0, 184, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0
+  },
+  /* procedureType/3 */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 130, 0, 0, 0, 0, 0, 0, 0, 131, 0, 0, 0, 0,
+    0
+  },
+  /* procedureType/4 */
+  {
+    0, 0, 0, 0, 0, 137, 0, 0, 0, 0, 137, 0, 137, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 137, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 136, 137, 0, 0, 137, 0, 0,
+    0, 0, 0, 0, 0
+  },
+  /* formalParams */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 187, 0, 0, 186, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0
+  },
+  /* formalParamList/1 */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 139, 0, 0, 0, 0, 140, 0, 0, 0, 0,
+    0
+  },
+  /* qualident/1 */
+  {
+    0, 143, 0, 0, 143, 143, 0, 0, 143, 143, 143, 143, 143, 0, 0, 0, 0, 0, 0, 0,
+    143, 0, 143, 0, 0, 143, 143, 0, 0, 0, 0, 0, 0, 0, 143, 143, 0, 143, 0, 0,
+    0, 143, 0, 0, 0, 0, 0, 0, 0, 0, 143, 143, 143, 143, 143, 143, 143, 143,
+    143, 143, 143, 143, 142, 143, 143, 143, 143, 143, 143, 143, 143, 143, 143,
+    143, 0
+  },
+  /* simpleTerm */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    190, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 190, 190, 190, 190,
+    190, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 190,
+    0, 0, 0, 190, 0, 0
+  },
+  /* term/1 */
+  {
+    0, 145, 0, 0, 146, 0, 0, 0, 145, 146, 146, 146, 146, 0, 0, 0, 0, 0, 0, 0,
+    146, 0, 145, 0, 0, 146, 146, 0, 0, 0, 0, 0, 0, 0, 146, 146, 0, 146, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 146, 146, 146, 146, 146, 146, 146, 146, 145,
+    145, 0, 146, 0, 146, 146, 146, 0, 146, 0, 146, 0, 146, 0, 146, 0
+  },
+  /* OperL3 */
+  {
+    0, 195, 0, 0, 0, 0, 0, 0, 193, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 194,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 191, 192, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0
+  },
+  /* designator */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 198, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0
+  },
+  /* assignmentOrProcCall/1 */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 153, 153, 153, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 153, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 151, 0, 0, 0, 153, 0, 0, 153, 152,
+    0, 0, 0, 0, 0, 0
+  },
+  /* actualParameters */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 201, 0, 0, 0, 0, 0, 0
+  },
+  /* returnStatement/1 */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 156, 156, 156, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 155, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 156, 0, 0, 0, 155, 155, 155,
+    155, 155, 0, 0, 0, 0, 155, 155, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 156, 0,
+    0, 156, 155, 0, 0, 0, 155, 0, 0
+  },
+  /* ifStatement/1 */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 160, 159, 160, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0
+  },
+  /* ifStatement/2 */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 161, 0, 162, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0
+  },
+  /* case */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    202, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 202, 202, 202, 202,
+    202, 0, 0, 0, 0, 202, 202, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    202, 0, 0, 0, 202, 0, 0
+  },
+  /* caseStatement/1 */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 165, 0, 165, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 164, 0, 0, 0, 0, 0,
+    0, 0
+  },
+  /* caseStatement/2 */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 166, 0, 167, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0
+  },
+  /* forStatement/1 */
+  {
+    0, 0, 0, 0, 172, 0, 0, 0, 0, 173, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0
+  },
+  /* countableType/1 */
+  {
+    0, 0, 0, 0, 0, 179, 0, 0, 0, 0, 179, 0, 179, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 179, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 179, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 179, 0, 0, 179, 0, 0, 179, 0, 0,
+    178, 0, 0, 0, 0
+  },
+  /* field */
+  {
+    0, 0, 0, 0, 0, 206, 0, 0, 0, 0, 206, 0, 206, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 206, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 206, 0, 0, 206, 0, 0, 0,
+    0, 0, 0, 0
+  },
+  /* fieldList/1 */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 182, 0, 182, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 181, 0, 0, 182, 0, 0, 0, 0, 0,
+    0, 0
+  },
+  /* simpleFormalType */
+  {
+    0, 0, 209, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 209, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0
+  },
+  /* attributedFormalType */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 210, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0
+  },
+  /* simpleFormalParams */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 211, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0
+  },
+  /* attribFormalParams */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 212, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0
+  },
+  /* simpleTerm/1 */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    188, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 189, 189, 189, 189,
+    189, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 189,
+    0, 0, 0, 189, 0, 0
+  },
+  /* factor */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 219, 217, 216, 216, 216, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 220, 0, 0,
+    0, 218, 0, 0
+  },
+  /* designator/1 */
+  {
+    0, 197, 0, 0, 197, 0, 0, 0, 197, 197, 197, 197, 197, 0, 0, 0, 0, 0, 0, 0,
+    197, 0, 197, 0, 0, 197, 197, 0, 0, 0, 0, 0, 0, 0, 197, 197, 0, 197, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 197, 197, 197, 197, 197, 197, 197, 197, 197,
+    197, 197, 197, 196, 197, 197, 197, 196, 197, 197, 197, 196, 197, 197, 197,
+    0
+  },
+  /* selector */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 222, 0, 0, 0, 221, 0, 0, 0, 223, 0, 0,
+    0, 0
+  },
+  /* actualParameters/1 */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    199, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 199, 199, 199, 199,
+    199, 0, 0, 0, 0, 199, 199, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    199, 200, 0, 0, 199, 0, 0
+  },
+  /* expressionList */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    226, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 226, 226, 226, 226,
+    226, 0, 0, 0, 0, 226, 226, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    226, 0, 0, 0, 226, 0, 0
+  },
+  /* caseLabelList */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    229, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 229, 229, 229, 229,
+    229, 0, 0, 0, 0, 229, 229, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    229, 0, 0, 0, 229, 0, 0
+  },
+  /* field/1 */
+  {
+    0, 0, 0, 0, 0, 204, 0, 0, 0, 0, 205, 0, 205, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 203, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 205, 0, 0, 205, 0, 0, 0,
+    0, 0, 0, 0
+  },
+  /* variantField */
+  {
+    0, 0, 0, 0, 0, 236, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0
+  },
+  /* simpleFormalType/1 */
+  {
+    0, 0, 207, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 208, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0
+  },
+  /* NumberLiteral */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 213, 214, 215, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0
+  },
+  /* setValue */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 239, 0, 0
+  },
+  /* designatorOrFuncCall */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 245, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0
+  },
+  /* expressionList/1 */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 224, 0, 0, 0, 0, 0, 0, 0, 225, 0, 225, 0,
+    0, 0
+  },
+  /* caseLabels */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    248, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 248, 248, 248, 248,
+    248, 0, 0, 0, 0, 248, 248, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    248, 0, 0, 0, 248, 0, 0
+  },
+  /* caseLabelList/1 */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 227, 0, 228, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0
+  },
+  /* variantField/1 */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 230, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 231, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0
+  },
+  /* variant */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    249, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 249, 249, 249, 249,
+    249, 0, 0, 0, 0, 249, 249, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    249, 0, 0, 0, 249, 0, 0
+  },
+  /* variantField/2 */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 233, 0, 233, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 232, 0, 0, 0, 0, 0,
+    0, 0
+  },
+  /* variantField/3 */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 234, 0, 235, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0
+  },
+  /* element */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    252, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 252, 252, 252, 252,
+    252, 0, 0, 0, 0, 252, 252, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    252, 0, 0, 0, 252, 0, 0
+  },
+  /* setValue/1 */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 237, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 238,
+    0
+  },
+  /* designatorOrFuncCall/1 */
+  {
+    0, 244, 0, 0, 244, 0, 0, 0, 244, 244, 244, 244, 244, 0, 0, 0, 0, 0, 0, 0,
+    244, 0, 244, 0, 0, 244, 244, 0, 0, 0, 0, 0, 0, 0, 244, 244, 0, 244, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 244, 244, 244, 244, 244, 244, 244, 244, 244,
+    244, 0, 244, 0, 244, 244, 244, 0, 244, 243, 244, 0, 244, 240, 244, 0
+  },
+  /* designatorOrFuncCall/2 */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    241, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 241, 241, 241, 241,
+    241, 0, 0, 0, 0, 241, 241, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    241, 242, 0, 0, 241, 0, 0
+  },
+  /* caseLabels/1 */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 247, 0, 247, 0, 246, 0, 0, 0, 0, 0, 0, 0,
+    0, 0
+  },
+  /* element/1 */
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 251, 0, 0, 0, 250, 0, 0, 0, 0, 0, 0, 0,
+    251, 0
+  }
+}; /* end m2t_ll1_predict */
+
+static const m2t_tokenset_t m2t_ll1_expected_set[] = {
+  /* compilationUnit */
+  { { 0x00840080, 0x00000000, 0x00000000 } },
+  /* definitionModule */
+  { { 0x00000080, 0x00000000, 0x00000000 } },
+  /* definitionModule~2 */
+  { { 0x00000080, 0x00000000, 0x00000000 } },
+  /* implementationModule */
+  { { 0x00040000, 0x00000000, 0x00000000 } },
+  /* programModule */
+  { { 0x00800000, 0x00000000, 0x00000000 } },
+  /* definitionModule/1 */
+  { { 0x10095040, 0x00000050, 0x00000000 } },
+  /* import */
+  { { 0x00090000, 0x00000000, 0x00000000 } },
+  /* definitionModule/2 */
+  { { 0x10005040, 0x00000050, 0x00000000 } },
+  /* export */
+  { { 0x00004000, 0x00000000, 0x00000000 } },
+  /* definitionModule/3 */
+  { { 0x10001040, 0x00000050, 0x00000000 } },
+  /* definition */
+  { { 0x10000040, 0x00000050, 0x00000000 } },
+  /* definitionModule~2/1 */
+  { { 0x00000080, 0x00000000, 0x00000000 } },
+  /* definitionModule~2/2 */
+  { { 0x10091040, 0x00000050, 0x00000000 } },
+  /* definitionModule~2/3 */
+  { { 0x10001040, 0x00000050, 0x00000000 } },
+  /* programModule/1 */
+  { { 0x00000000, 0x00000000, 0x00000041 } },
+  /* modulePriority */
+  { { 0x00000000, 0x00000000, 0x00000040 } },
+  /* programModule/2 */
+  { { 0x10891048, 0x00000050, 0x00000000 } },
+  /* block */
+  { { 0x10801048, 0x00000050, 0x00000000 } },
+  /* import/1 */
+  { { 0x00090000, 0x00000000, 0x00000000 } },
+  /* qualifiedImport */
+  { { 0x00080000, 0x00000000, 0x00000000 } },
+  /* unqualifiedImport */
+  { { 0x00010000, 0x00000000, 0x00000000 } },
+  /* export/1 */
+  { { 0x20000000, 0x00000200, 0x00000000 } },
+  /* identList */
+  { { 0x00000000, 0x00000200, 0x00000000 } },
+  /* definition/1 */
+  { { 0x10001040, 0x00000250, 0x00000000 } },
+  /* constDefinition */
+  { { 0x00000000, 0x00000200, 0x00000000 } },
+  /* definition/2 */
+  { { 0x10001040, 0x00000250, 0x00000000 } },
+  /* typeDefinition */
+  { { 0x00000000, 0x00000200, 0x00000000 } },
+  /* definition/3 */
+  { { 0x10001040, 0x00000250, 0x00000000 } },
+  /* variableDeclaration */
+  { { 0x00000000, 0x00000200, 0x00000000 } },
+  /* procedureHeader */
+  { { 0x10000000, 0x00000000, 0x00000000 } },
+  /* expression */
+  { { 0x01000000, 0x000C3E00, 0x00000110 } },
+  /* block/1 */
+  { { 0x10801048, 0x00000050, 0x00000000 } },
+  /* declaration */
+  { { 0x10800040, 0x00000050, 0x00000000 } },
+  /* block/2 */
+  { { 0x00001008, 0x00000000, 0x00000000 } },
+  /* statementSequence */
+  { { 0x8022A020, 0x00000381, 0x00000000 } },
+  /* identList/1 */
+  { { 0x00000000, 0xA0000000, 0x00000021 } },
+  /* typeDefinition/1 */
+  { { 0x00000000, 0x00100000, 0x00000001 } },
+  /* type */
+  { { 0x58000004, 0x00000202, 0x00000050 } },
+  /* procedureSignature */
+  { { 0x00000000, 0x00000200, 0x00000000 } },
+  /* simpleExpression */
+  { { 0x01000000, 0x000C3E00, 0x00000110 } },
+  /* expression/1 */
+  { { 0x02101E10, 0xA3F0002C, 0x000002AB } },
+  /* OperL1 */
+  { { 0x00100000, 0x03F00000, 0x00000000 } },
+  /* declaration/1 */
+  { { 0x10801048, 0x00000250, 0x00000000 } },
+  /* declaration/2 */
+  { { 0x10801048, 0x00000250, 0x00000000 } },
+  /* typeDeclaration */
+  { { 0x00000000, 0x00000200, 0x00000000 } },
+  /* declaration/3 */
+  { { 0x10801048, 0x00000250, 0x00000000 } },
+  /* procedureDeclaration */
+  { { 0x10000000, 0x00000000, 0x00000000 } },
+  /* moduleDeclaration */
+  { { 0x00800000, 0x00000000, 0x00000000 } },
+  /* statement */
+  { { 0x8022A020, 0x00000381, 0x00000000 } },
+  /* statementSequence/1 */
+  { { 0x00001C00, 0x00000020, 0x00000009 } },
+  /* derivedOrSubrangeType */
+  { { 0x00000000, 0x00000200, 0x00000040 } },
+  /* enumType */
+  { { 0x00000000, 0x00000000, 0x00000010 } },
+  /* setType */
+  { { 0x00000000, 0x00000002, 0x00000000 } },
+  /* arrayType */
+  { { 0x00000004, 0x00000000, 0x00000000 } },
+  /* recordType */
+  { { 0x40000000, 0x00000000, 0x00000000 } },
+  /* pointerType */
+  { { 0x08000000, 0x00000000, 0x00000000 } },
+  /* procedureType */
+  { { 0x10000000, 0x00000000, 0x00000000 } },
+  /* procedureSignature/1 */
+  { { 0x00000000, 0x00000000, 0x00000011 } },
+  /* procedureSignature/2 */
+  { { 0x00000000, 0x00000240, 0x00000020 } },
+  /* formalParamList */
+  { { 0x00000000, 0x00000240, 0x00000000 } },
+  /* procedureSignature/3 */
+  { { 0x00000000, 0x80000000, 0x00000001 } },
+  /* qualident */
+  { { 0x00000000, 0x00000200, 0x00000000 } },
+  /* simpleExpression/1 */
+  { { 0x01000000, 0x000C3E00, 0x00000110 } },
+  /* term */
+  { { 0x01000000, 0x00003E00, 0x00000110 } },
+  /* simpleExpression/2 */
+  { { 0x06101E10, 0xA3FC002C, 0x000002AB } },
+  /* OperL2 */
+  { { 0x04000000, 0x000C0000, 0x00000000 } },
+  /* moduleDeclaration/1 */
+  { { 0x00000000, 0x00000000, 0x00000041 } },
+  /* moduleDeclaration/2 */
+  { { 0x10895048, 0x00000050, 0x00000000 } },
+  /* moduleDeclaration/3 */
+  { { 0x10805048, 0x00000050, 0x00000000 } },
+  /* assignmentOrProcCall */
+  { { 0x00000000, 0x00000200, 0x00000000 } },
+  /* returnStatement */
+  { { 0x00000000, 0x00000001, 0x00000000 } },
+  /* withStatement */
+  { { 0x00000000, 0x00000100, 0x00000000 } },
+  /* ifStatement */
+  { { 0x00020000, 0x00000000, 0x00000000 } },
+  /* caseStatement */
+  { { 0x00000020, 0x00000000, 0x00000000 } },
+  /* loopStatement */
+  { { 0x00200000, 0x00000000, 0x00000000 } },
+  /* whileStatement */
+  { { 0x00000000, 0x00000080, 0x00000000 } },
+  /* repeatStatement */
+  { { 0x80000000, 0x00000000, 0x00000000 } },
+  /* forStatement */
+  { { 0x00008000, 0x00000000, 0x00000000 } },
+  /* derivedOrSubrangeType/1 */
+  { { 0x00001420, 0x00000200, 0x00000049 } },
+  /* range */
+  { { 0x00000000, 0x00000000, 0x00000040 } },
+  /* countableType */
+  { { 0x00000000, 0x00000200, 0x00000050 } },
+  /* arrayType/1 */
+  { { 0x02000000, 0x20000000, 0x00000000 } },
+  /* fieldList */
+  { { 0x00001420, 0x00000200, 0x00000009 } },
+  /* procedureType/1 */
+  { { 0x00001420, 0x80000200, 0x00000019 } },
+  /* procedureType/2 */
+  { { 0x00000004, 0x00000240, 0x00000020 } },
+  /* formalType */
+  { { 0x00000004, 0x00000240, 0x00000000 } },
+  /* procedureType/3 */
+  { { 0x00000000, 0x20000000, 0x00000020 } },
+  /* procedureType/4 */
+  { { 0x00001420, 0x80000200, 0x00000009 } },
+  /* formalParams */
+  { { 0x00000000, 0x00000240, 0x00000000 } },
+  /* formalParamList/1 */
+  { { 0x00000000, 0x00000000, 0x00000021 } },
+  /* qualident/1 */
+  { { 0x06501F32, 0xFFFC022C, 0x000003FF } },
+  /* simpleTerm */
+  { { 0x01000000, 0x00003E00, 0x00000110 } },
+  /* term/1 */
+  { { 0x06501F12, 0xAFFC002C, 0x000002AB } },
+  /* OperL3 */
+  { { 0x00400102, 0x0C000000, 0x00000000 } },
+  /* designator */
+  { { 0x00000000, 0x00000200, 0x00000000 } },
+  /* assignmentOrProcCall/1 */
+  { { 0x00001C00, 0x10000020, 0x00000019 } },
+  /* actualParameters */
+  { { 0x00000000, 0x00000000, 0x00000010 } },
+  /* returnStatement/1 */
+  { { 0x01001C00, 0x000C3E20, 0x00000119 } },
+  /* ifStatement/1 */
+  { { 0x00001C00, 0x00000000, 0x00000000 } },
+  /* ifStatement/2 */
+  { { 0x00001400, 0x00000000, 0x00000000 } },
+  /* case */
+  { { 0x01000000, 0x000C3E00, 0x00000110 } },
+  /* caseStatement/1 */
+  { { 0x00001400, 0x00000000, 0x00000008 } },
+  /* caseStatement/2 */
+  { { 0x00001400, 0x00000000, 0x00000000 } },
+  /* forStatement/1 */
+  { { 0x00000210, 0x00000000, 0x00000000 } },
+  /* countableType/1 */
+  { { 0x02001420, 0x20000200, 0x00000049 } },
+  /* field */
+  { { 0x00001420, 0x00000200, 0x00000009 } },
+  /* fieldList/1 */
+  { { 0x00001400, 0x00000000, 0x00000009 } },
+  /* simpleFormalType */
+  { { 0x00000004, 0x00000200, 0x00000000 } },
+  /* attributedFormalType */
+  { { 0x00000000, 0x00000040, 0x00000000 } },
+  /* simpleFormalParams */
+  { { 0x00000000, 0x00000200, 0x00000000 } },
+  /* attribFormalParams */
+  { { 0x00000000, 0x00000040, 0x00000000 } },
+  /* simpleTerm/1 */
+  { { 0x01000000, 0x00003E00, 0x00000110 } },
+  /* factor */
+  { { 0x00000000, 0x00003E00, 0x00000110 } },
+  /* designator/1 */
+  { { 0x06501F12, 0xFFFC002C, 0x000003FF } },
+  /* selector */
+  { { 0x00000000, 0x40000000, 0x00000044 } },
+  /* actualParameters/1 */
+  { { 0x01000000, 0x000C3E00, 0x00000130 } },
+  /* expressionList */
+  { { 0x01000000, 0x000C3E00, 0x00000110 } },
+  /* caseLabelList */
+  { { 0x01000000, 0x000C3E00, 0x00000110 } },
+  /* field/1 */
+  { { 0x00001420, 0x00000200, 0x00000009 } },
+  /* variantField */
+  { { 0x00000020, 0x00000000, 0x00000000 } },
+  /* simpleFormalType/1 */
+  { { 0x00000004, 0x00000200, 0x00000000 } },
+  /* NumberLiteral */
+  { { 0x00000000, 0x00003800, 0x00000000 } },
+  /* setValue */
+  { { 0x00000000, 0x00000000, 0x00000100 } },
+  /* designatorOrFuncCall */
+  { { 0x00000000, 0x00000200, 0x00000000 } },
+  /* expressionList/1 */
+  { { 0x00000000, 0x20000000, 0x000000A0 } },
+  /* caseLabels */
+  { { 0x01000000, 0x000C3E00, 0x00000110 } },
+  /* caseLabelList/1 */
+  { { 0x00000000, 0xA0000000, 0x00000000 } },
+  /* variantField/1 */
+  { { 0x00000000, 0x80000200, 0x00000000 } },
+  /* variant */
+  { { 0x01000000, 0x000C3E00, 0x00000110 } },
+  /* variantField/2 */
+  { { 0x00001400, 0x00000000, 0x00000008 } },
+  /* variantField/3 */
+  { { 0x00001400, 0x00000000, 0x00000000 } },
+  /* element */
+  { { 0x01000000, 0x000C3E00, 0x00000110 } },
+  /* setValue/1 */
+  { { 0x00000000, 0x20000000, 0x00000200 } },
+  /* designatorOrFuncCall/1 */
+  { { 0x06501F12, 0xAFFC002C, 0x000003BB } },
+  /* designatorOrFuncCall/2 */
+  { { 0x01000000, 0x000C3E00, 0x00000130 } },
+  /* caseLabels/1 */
+  { { 0x00000000, 0xA0000000, 0x00000002 } },
+  /* element/1 */
+  { { 0x00000000, 0x20000000, 0x00000202 } }
+}; /* end m2t_ll1_expected_set */
+
+static const m2t_tokenset_t m2t_ll1_resync_set[] = {
+  /* compilationUnit */
+  { { 0x00000000, 0x00000000, 0x00000400 } },
+  /* definitionModule */
+  { { 0x00000000, 0x00000000, 0x00000400 } },
+  /* definitionModule~2 */
+  { { 0x00000000, 0x00000000, 0x00000400 } },
+  /* implementationModule */
+  { { 0x00000000, 0x00000000, 0x00000400 } },
+  /* programModule */
+  { { 0x00000000, 0x00000000, 0x00000400 } },
+  /* definitionModule/1 */
+  { { 0x10005040, 0x00000050, 0x00000400 } },
+  /* import */
+  { { 0x10895048, 0x00000050, 0x00000400 } },
+  /* definitionModule/2 */
+  { { 0x10001040, 0x00000050, 0x00000400 } },
+  /* export */
+  { { 0x10801048, 0x00000050, 0x00000400 } },
+  /* definitionModule/3 */
+  { { 0x00001000, 0x00000000, 0x00000400 } },
+  /* definition */
+  { { 0x10001040, 0x00000050, 0x00000400 } },
+  /* definitionModule~2/1 */
+  { { 0x00000080, 0x00000000, 0x00000400 } },
+  /* definitionModule~2/2 */
+  { { 0x10001040, 0x00000050, 0x00000400 } },
+  /* definitionModule~2/3 */
+  { { 0x00001000, 0x00000000, 0x00000400 } },
+  /* programModule/1 */
+  { { 0x00000000, 0x00000000, 0x00000401 } },
+  /* modulePriority */
+  { { 0x00000000, 0x00000000, 0x00000401 } },
+  /* programModule/2 */
+  { { 0x10801048, 0x00000050, 0x00000400 } },
+  /* block */
+  { { 0x00000000, 0x00000200, 0x00000400 } },
+  /* import/1 */
+  { { 0x00000000, 0x00000000, 0x00000401 } },
+  /* qualifiedImport */
+  { { 0x00000000, 0x00000000, 0x00000401 } },
+  /* unqualifiedImport */
+  { { 0x00000000, 0x00000000, 0x00000401 } },
+  /* export/1 */
+  { { 0x00000000, 0x00000200, 0x00000400 } },
+  /* identList */
+  { { 0x00000000, 0x80000000, 0x00000421 } },
+  /* definition/1 */
+  { { 0x10001040, 0x00000050, 0x00000400 } },
+  /* constDefinition */
+  { { 0x00000000, 0x00000000, 0x00000401 } },
+  /* definition/2 */
+  { { 0x10001040, 0x00000050, 0x00000400 } },
+  /* typeDefinition */
+  { { 0x00000000, 0x00000000, 0x00000401 } },
+  /* definition/3 */
+  { { 0x10001040, 0x00000050, 0x00000400 } },
+  /* variableDeclaration */
+  { { 0x00001420, 0x00000200, 0x00000409 } },
+  /* procedureHeader */
+  { { 0x00000000, 0x00000000, 0x00000401 } },
+  /* expression */
+  { { 0x02001E10, 0xA000002C, 0x000006AB } },
+  /* block/1 */
+  { { 0x00001008, 0x00000000, 0x00000400 } },
+  /* declaration */
+  { { 0x10801048, 0x00000050, 0x00000400 } },
+  /* block/2 */
+  { { 0x00001000, 0x00000000, 0x00000400 } },
+  /* statementSequence */
+  { { 0x00001C00, 0x00000020, 0x00000408 } },
+  /* identList/1 */
+  { { 0x00000000, 0x80000000, 0x00000421 } },
+  /* typeDefinition/1 */
+  { { 0x00000000, 0x00000000, 0x00000401 } },
+  /* type */
+  { { 0x00001420, 0x00000200, 0x00000409 } },
+  /* procedureSignature */
+  { { 0x00000000, 0x00000000, 0x00000401 } },
+  /* simpleExpression */
+  { { 0x02101E10, 0xA3F0002C, 0x000006AB } },
+  /* expression/1 */
+  { { 0x02001E10, 0xA000002C, 0x000006AB } },
+  /* OperL1 */
+  { { 0x01000000, 0x000C3E00, 0x00000510 } },
+  /* declaration/1 */
+  { { 0x10801048, 0x00000050, 0x00000400 } },
+  /* declaration/2 */
+  { { 0x10801048, 0x00000050, 0x00000400 } },
+  /* typeDeclaration */
+  { { 0x00000000, 0x00000000, 0x00000401 } },
+  /* declaration/3 */
+  { { 0x10801048, 0x00000050, 0x00000400 } },
+  /* procedureDeclaration */
+  { { 0x00000000, 0x00000000, 0x00000401 } },
+  /* moduleDeclaration */
+  { { 0x00000000, 0x00000000, 0x00000401 } },
+  /* statement */
+  { { 0x00001C00, 0x00000020, 0x00000409 } },
+  /* statementSequence/1 */
+  { { 0x00001C00, 0x00000020, 0x00000408 } },
+  /* derivedOrSubrangeType */
+  { { 0x00001420, 0x00000200, 0x00000409 } },
+  /* enumType */
+  { { 0x02001420, 0x20000200, 0x00000409 } },
+  /* setType */
+  { { 0x00001420, 0x00000200, 0x00000409 } },
+  /* arrayType */
+  { { 0x00001420, 0x00000200, 0x00000409 } },
+  /* recordType */
+  { { 0x00001420, 0x00000200, 0x00000409 } },
+  /* pointerType */
+  { { 0x00001420, 0x00000200, 0x00000409 } },
+  /* procedureType */
+  { { 0x00001420, 0x00000200, 0x00000409 } },
+  /* procedureSignature/1 */
+  { { 0x00000000, 0x00000000, 0x00000401 } },
+  /* procedureSignature/2 */
+  { { 0x00000000, 0x00000000, 0x00000420 } },
+  /* formalParamList */
+  { { 0x00000000, 0x00000000, 0x00000420 } },
+  /* procedureSignature/3 */
+  { { 0x00000000, 0x00000000, 0x00000401 } },
+  /* qualident */
+  { { 0x06501F32, 0xFFFC022C, 0x000007FF } },
+  /* simpleExpression/1 */
+  { { 0x01000000, 0x00003E00, 0x00000510 } },
+  /* term */
+  { { 0x06101E10, 0xA3FC002C, 0x000006AB } },
+  /* simpleExpression/2 */
+  { { 0x02101E10, 0xA3F0002C, 0x000006AB } },
+  /* OperL2 */
+  { { 0x01000000, 0x00003E00, 0x00000510 } },
+  /* moduleDeclaration/1 */
+  { { 0x00000000, 0x00000000, 0x00000401 } },
+  /* moduleDeclaration/2 */
+  { { 0x10805048, 0x00000050, 0x00000400 } },
+  /* moduleDeclaration/3 */
+  { { 0x10801048, 0x00000050, 0x00000400 } },
+  /* assignmentOrProcCall */
+  { { 0x00001C00, 0x00000020, 0x00000409 } },
+  /* returnStatement */
+  { { 0x00001C00, 0x00000020, 0x00000409 } },
+  /* withStatement */
+  { { 0x00001C00, 0x00000020, 0x00000409 } },
+  /* ifStatement */
+  { { 0x00001C00, 0x00000020, 0x00000409 } },
+  /* caseStatement */
+  { { 0x00001C00, 0x00000020, 0x00000409 } },
+  /* loopStatement */
+  { { 0x00001C00, 0x00000020, 0x00000409 } },
+  /* whileStatement */
+  { { 0x00001C00, 0x00000020, 0x00000409 } },
+  /* repeatStatement */
+  { { 0x00001C00, 0x00000020, 0x00000409 } },
+  /* forStatement */
+  { { 0x00001C00, 0x00000020, 0x00000409 } },
+  /* derivedOrSubrangeType/1 */
+  { { 0x00001420, 0x00000200, 0x00000409 } },
+  /* range */
+  { { 0x02001420, 0x20000200, 0x00000409 } },
+  /* countableType */
+  { { 0x02001420, 0x20000200, 0x00000409 } },
+  /* arrayType/1 */
+  { { 0x02000000, 0x00000000, 0x00000400 } },
+  /* fieldList */
+  { { 0x00001400, 0x00000000, 0x00000408 } },
+  /* procedureType/1 */
+  { { 0x00001420, 0x80000200, 0x00000409 } },
+  /* procedureType/2 */
+  { { 0x00000000, 0x00000000, 0x00000420 } },
+  /* formalType */
+  { { 0x00000000, 0x20000000, 0x00000421 } },
+  /* procedureType/3 */
+  { { 0x00000000, 0x00000000, 0x00000420 } },
+  /* procedureType/4 */
+  { { 0x00001420, 0x00000200, 0x00000409 } },
+  /* formalParams */
+  { { 0x00000000, 0x00000000, 0x00000421 } },
+  /* formalParamList/1 */
+  { { 0x00000000, 0x00000000, 0x00000420 } },
+  /* qualident/1 */
+  { { 0x06501F32, 0xFFFC022C, 0x000007FF } },
+  /* simpleTerm */
+  { { 0x06501F12, 0xAFFC002C, 0x000006AB } },
+  /* term/1 */
+  { { 0x06101E10, 0xA3FC002C, 0x000006AB } },
+  /* OperL3 */
+  { { 0x01000000, 0x00003E00, 0x00000510 } },
+  /* designator */
+  { { 0x06501F12, 0xBFFC002C, 0x000007BB } },
+  /* assignmentOrProcCall/1 */
+  { { 0x00001C00, 0x00000020, 0x00000409 } },
+  /* actualParameters */
+  { { 0x00001C00, 0x00000020, 0x00000409 } },
+  /* returnStatement/1 */
+  { { 0x00001C00, 0x00000020, 0x00000409 } },
+  /* ifStatement/1 */
+  { { 0x00001400, 0x00000000, 0x00000400 } },
+  /* ifStatement/2 */
+  { { 0x00001000, 0x00000000, 0x00000400 } },
+  /* case */
+  { { 0x00001400, 0x00000000, 0x00000408 } },
+  /* caseStatement/1 */
+  { { 0x00001400, 0x00000000, 0x00000400 } },
+  /* caseStatement/2 */
+  { { 0x00001000, 0x00000000, 0x00000400 } },
+  /* forStatement/1 */
+  { { 0x00000200, 0x00000000, 0x00000400 } },
+  /* countableType/1 */
+  { { 0x02001420, 0x20000200, 0x00000409 } },
+  /* field */
+  { { 0x00001400, 0x00000000, 0x00000409 } },
+  /* fieldList/1 */
+  { { 0x00001400, 0x00000000, 0x00000408 } },
+  /* simpleFormalType */
+  { { 0x00000000, 0x20000000, 0x00000421 } },
+  /* attributedFormalType */
+  { { 0x00000000, 0x20000000, 0x00000421 } },
+  /* simpleFormalParams */
+  { { 0x00000000, 0x00000000, 0x00000421 } },
+  /* attribFormalParams */
+  { { 0x00000000, 0x00000000, 0x00000421 } },
+  /* simpleTerm/1 */
+  { { 0x00000000, 0x00003E00, 0x00000510 } },
+  /* factor */
+  { { 0x06501F12, 0xAFFC002C, 0x000006AB } },
+  /* designator/1 */
+  { { 0x06501F12, 0xBFFC002C, 0x000007BB } },
+  /* selector */
+  { { 0x06501F12, 0xFFFC002C, 0x000007FF } },
+  /* actualParameters/1 */
+  { { 0x00000000, 0x00000000, 0x00000420 } },
+  /* expressionList */
+  { { 0x00000000, 0x00000000, 0x000004A0 } },
+  /* caseLabelList */
+  { { 0x00000000, 0x80000000, 0x00000400 } },
+  /* field/1 */
+  { { 0x00001400, 0x00000000, 0x00000409 } },
+  /* variantField */
+  { { 0x00001420, 0x00000200, 0x00000409 } },
+  /* simpleFormalType/1 */
+  { { 0x00000000, 0x00000200, 0x00000400 } },
+  /* NumberLiteral */
+  { { 0x06501F12, 0xAFFC002C, 0x000006AB } },
+  /* setValue */
+  { { 0x06501F12, 0xAFFC002C, 0x000006AB } },
+  /* designatorOrFuncCall */
+  { { 0x06501F12, 0xAFFC002C, 0x000006AB } },
+  /* expressionList/1 */
+  { { 0x00000000, 0x00000000, 0x000004A0 } },
+  /* caseLabels */
+  { { 0x00000000, 0xA0000000, 0x00000400 } },
+  /* caseLabelList/1 */
+  { { 0x00000000, 0x80000000, 0x00000400 } },
+  /* variantField/1 */
+  { { 0x00000000, 0x80000000, 0x00000400 } },
+  /* variant */
+  { { 0x00001400, 0x00000000, 0x00000408 } },
+  /* variantField/2 */
+  { { 0x00001400, 0x00000000, 0x00000400 } },
+  /* variantField/3 */
+  { { 0x00001000, 0x00000000, 0x00000400 } },
+  /* element */
+  { { 0x00000000, 0x20000000, 0x00000600 } },
+  /* setValue/1 */
+  { { 0x00000000, 0x00000000, 0x00000600 } },
+  /* designatorOrFuncCall/1 */
+  { { 0x06501F12, 0xAFFC002C, 0x000006AB } },
+  /* designatorOrFuncCall/2 */
+  { { 0x00000000, 0x00000000, 0x00000420 } },
+  /* caseLabels/1 */
+  { { 0x00000000, 0xA0000000, 0x00000400 } },
+  /* element/1 */
+  { { 0x00000000, 0x20000000, 0x00000600 } }
+}; /* end m2t_ll1_resync_set */
+
+#endif /* M2T_LL1_TABLES_H */
+
+/* END OF FILE */
@@ -41,9 +41,56 @@
 #ifndef M2T_OPTION_FLAGS_H
 #define M2T_OPTION_FLAGS_H
 
+#include "m2t-common.h"
+
 #include <stdbool.h>
 
 
+/* --------------------------------------------------------------------------
+ * type m2t_option_set_t
+ * --------------------------------------------------------------------------
+ * Bit set of the option flags that select the dialect of a translation.
+ * A lexer and parser capture a set when they are created and consult only
+ * their own set thereafter.  Thus translations with different dialects may
+ * run concurrently in one process.
+ * ----------------------------------------------------------------------- */
+
+typedef uint_t m2t_option_set_t;
+
+
+/* --------------------------------------------------------------------------
+ * Dialect option flags
+ * --------------------------------------------------------------------------
+ * Bit positions are stable across versions.
+ * ----------------------------------------------------------------------- */
+
+#define M2T_OPTION_SYNONYMS                (1u << 0)
+#define M2T_OPTION_OCTAL_LITERALS          (1u << 1)
+#define M2T_OPTION_ESCAPE_TAB_AND_NEWLINE  (1u << 2)
+#define M2T_OPTION_EXPORT_LISTS            (1u << 3)
+#define M2T_OPTION_SUBTYPE_CARDINALS       (1u << 4)
+#define M2T_OPTION_SAFE_STRING_TERMINATION (1u << 5)
+#define M2T_OPTION_ERRANT_SEMICOLON        (1u << 6)
+#define M2T_OPTION_TYPE_BYTE               (1u << 7)
+#define M2T_OPTION_TYPE_LONGCARD           (1u << 8)
+#define M2T_OPTION_UNIFIED_CAST            (1u << 9)
+#define M2T_OPTION_COROUTINES              (1u << 10)
+#define M2T_OPTION_VARIANT_RECORDS         (1u << 11)
+#define M2T_OPTION_LOCAL_MODULES           (1u << 12)
+#define M2T_OPTION_LOWLINE_IDENTIFIERS     (1u << 13)
+#define M2T_OPTION_LINE_COMMENTS           (1u << 14)
+#define M2T_OPTION_PREFIX_LITERALS         (1u << 15)
+
+
+/* --------------------------------------------------------------------------
+ * function macro M2T_OPTION_IN_SET(set, flag)
+ * --------------------------------------------------------------------------
+ * Returns true if option flag flag is set in option set set, else false.
+ * ----------------------------------------------------------------------- */
+
+#define M2T_OPTION_IN_SET(_set, _flag) (((_set) & (_flag)) != 0)
+
+
 /* --------------------------------------------------------------------------
  * type m2t_option_status_t
  * --------------------------------------------------------------------------
@@ -213,6 +260,33 @@ bool m2t_option_variant_records (void);
 bool m2t_option_local_modules (void);
 
 
+/* --------------------------------------------------------------------------
+ * function m2t_option_lowline_identifiers()
+ * --------------------------------------------------------------------------
+ * Returns true if option flag lowline_identifiers is set, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_option_lowline_identifiers (void);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_option_line_comments()
+ * --------------------------------------------------------------------------
+ * Returns true if option flag line_comments is set, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_option_line_comments (void);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_option_prefix_literals()
+ * --------------------------------------------------------------------------
+ * Returns true if option flag prefix_literals is set, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_option_prefix_literals (void);
+
+
 /* --------------------------------------------------------------------------
  * function m2t_option_lexer_debug()
  * --------------------------------------------------------------------------
@@ -230,6 +304,127 @@ bool m2t_option_lexer_debug (void);
 
 bool m2t_option_parser_debug (void);
 
+/* --------------------------------------------------------------------------
+ * function m2t_option_r10_output()
+ * --------------------------------------------------------------------------
+ * Returns true if option flag r10_output is set, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_option_r10_output (void);
+
+/* --------------------------------------------------------------------------
+ * function m2t_option_stream_ast()
+ * --------------------------------------------------------------------------
+ * Returns true if option flag stream_ast is set, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_option_stream_ast (void);
+
+/* --------------------------------------------------------------------------
+ * function m2t_option_machine_diagnostics()
+ * --------------------------------------------------------------------------
+ * Returns true if option flag machine_diagnostics is set, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_option_machine_diagnostics (void);
+
+/* --------------------------------------------------------------------------
+ * function m2t_option_pipeline()
+ * --------------------------------------------------------------------------
+ * Returns true if option flag pipeline is set, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_option_pipeline (void);
+
+/* --------------------------------------------------------------------------
+ * function m2t_option_pretokenize()
+ * --------------------------------------------------------------------------
+ * Returns true if option flag pretokenize is set, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_option_pretokenize (void);
+
+/* --------------------------------------------------------------------------
+ * function m2t_option_ll1_parser()
+ * --------------------------------------------------------------------------
+ * Returns true if option flag ll1_parser is set, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_option_ll1_parser (void);
+
+/* --------------------------------------------------------------------------
+ * function m2t_option_profile()
+ * --------------------------------------------------------------------------
+ * Returns true if option flag profile is set, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_option_profile (void);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_option_stats()
+ * --------------------------------------------------------------------------
+ * Returns true if option flag stats is set, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_option_stats (void);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_option_timing()
+ * --------------------------------------------------------------------------
+ * Returns true if option flag timing is set, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_option_timing (void);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_option_server()
+ * --------------------------------------------------------------------------
+ * Returns true if option flag server is set, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_option_server (void);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_option_parallel_parse()
+ * --------------------------------------------------------------------------
+ * Returns true if option flag parallel-parse is set, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_option_parallel_parse (void);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_option_max_errors()
+ * --------------------------------------------------------------------------
+ * Returns the maximum number of errors, zero if there is no limit.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2t_option_max_errors (void);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_option_dialect()
+ * --------------------------------------------------------------------------
+ * Returns the option set of the dialect selected on the command line.
+ * ----------------------------------------------------------------------- */
+
+m2t_option_set_t m2t_option_dialect (void);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_option_fingerprint()
+ * --------------------------------------------------------------------------
+ * Returns a bit set with one bit for each option flag that affects the
+ * output of a translation.  Two runs produce the same output for the same
+ * input if their fingerprints are equal.  The fingerprint is the dialect.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2t_option_fingerprint (void);
+
 
 #endif /* M2T_OPTION_FLAGS_H */
 
@@ -42,8 +42,16 @@
 #define M2T_PARSER_H
 
 #include "m2t-common.h"
+#include "m2t-fifo.h"
+#include "m2t-spans.h"
+#include "m2t-regions.h"
+#include "m2t-typepool.h"
+#include "m2t-comments.h"
+#include "m2-phase-timing.h"
 #include "ast/m2t-ast.h"
 
+#include <stddef.h>
+
 
 /* --------------------------------------------------------------------------
  * type m2t_sourcetype_t
@@ -75,6 +83,49 @@ typedef enum {
 } m2t_parser_status_t;
 
 
+/* --------------------------------------------------------------------------
+ * type m2t_parse_event_t
+ * --------------------------------------------------------------------------
+ * Enumeration representing the events reported by a streaming parse.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2T_PARSE_EVENT_OPEN,   /* a node has been opened, subnodes follow */
+  M2T_PARSE_EVENT_NODE,   /* a complete subnode of the open node */
+  M2T_PARSE_EVENT_CLOSE   /* the open node is complete */
+} m2t_parse_event_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2t_parse_handler_t
+ * --------------------------------------------------------------------------
+ * function pointer type for event handlers of a streaming parse.  Called
+ * with the event, the node type of the opened, completed or closed node,
+ * the completed node for M2T_PARSE_EVENT_NODE, otherwise NULL, and the
+ * context passed to m2t_parse_file_w_handler().
+ * ----------------------------------------------------------------------- */
+
+typedef void (*m2t_parse_handler_t)
+  (m2t_parse_event_t event, m2t_ast_nodetype_t node_type,
+   m2t_astnode_t node, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * Parallel parsing
+ * --------------------------------------------------------------------------
+ * If option parallel-parse is set, m2t_parse_file() and m2t_parse_buffer()
+ * prescan the symbols of a module for top-level procedure declarations,
+ * locating their ends by the END and procedure identifier that terminate
+ * them.  If enough are found, each is parsed on a worker thread with a
+ * parser context of its own and its subtree is taken into the AST in
+ * place when the parser reaches it.  Procedures nested in local modules
+ * and procedures that cannot be parsed on their own are parsed by the
+ * parser.  The string repository must have been initialised in concurrent
+ * mode.  Diagnostics of procedures parsed on workers may be reported out
+ * of source order.  A source with lexical errors is parsed sequentially.
+ * ----------------------------------------------------------------------- */
+
+
 /* --------------------------------------------------------------------------
  * function m2t_parse_file(srctype, srcpath, ast, stats, status)
  * --------------------------------------------------------------------------
@@ -90,6 +141,254 @@ typedef enum {
     m2t_stats_t *stats,            /* out */
     m2t_parser_status_t *status);  /* out */
 
+
+/* --------------------------------------------------------------------------
+ * function m2t_parse_buffer(srctype, name, buffer, length, ast, stats, status)
+ * --------------------------------------------------------------------------
+ * Parses Modula-2 source text held in a caller owned buffer of the given
+ * length and returns status.  The buffer is NOT copied.  It must remain
+ * valid and unmodified until the function returns.  Parameter name is
+ * reported in place of a filename.  Builds an abstract syntax tree and
+ * passes it back in ast, or NULL upon failure.  Collects simple statistics
+ * and passes them back in stats.
+ * ----------------------------------------------------------------------- */
+ 
+ void m2t_parse_buffer
+   (m2t_sourcetype_t srctype,      /* in */
+    const char *name,              /* in */
+    const char *buffer,            /* in */
+    size_t length,                 /* in */
+    m2t_ast_t *ast,                /* out */
+    m2t_stats_t *stats,            /* out */
+    m2t_parser_status_t *status);  /* out */
+
+
+/* --------------------------------------------------------------------------
+ * type m2t_text_edit_t
+ * --------------------------------------------------------------------------
+ * Record type representing an edit of source text.  Field offset holds the
+ * byte offset at which the edit took place, field removed the number of
+ * bytes removed at offset and field inserted the number of bytes inserted
+ * at offset in their place.  The inserted text itself is not held, it is
+ * read from the edited source text.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* offset */ uint32_t offset;
+  /* removed */ uint32_t removed;
+  /* inserted */ uint32_t inserted;
+} m2t_text_edit_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_parse_buffer_w_regions(srctype, name, buffer, length, ...)
+ * --------------------------------------------------------------------------
+ * Parses Modula-2 source text held in a caller owned buffer and returns
+ * status like m2t_parse_buffer() and additionally records the regions of
+ * the top-level definitions of a definition module, or of the top-level
+ * declarations of a program or implementation module, in regions.  Any
+ * regions previously held in regions are removed.  The caller allocates
+ * regions and is responsible for releasing it.  The AST and regions may be
+ * passed to m2t_reparse_buffer() after the buffer has been edited.
+ * ----------------------------------------------------------------------- */
+ 
+ void m2t_parse_buffer_w_regions
+   (m2t_sourcetype_t srctype,        /* in */
+    const char *name,                /* in */
+    const char *buffer,              /* in */
+    size_t length,                   /* in */
+    m2t_ast_t *ast,                  /* out */
+    m2t_region_table_t regions,      /* in */
+    m2t_stats_t *stats,              /* out */
+    m2t_parser_status_t *status);    /* out */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_reparse_buffer(srctype, name, buffer, length, edit, ...)
+ * --------------------------------------------------------------------------
+ * Updates an AST and regions obtained from m2t_parse_buffer_w_regions() or
+ * from a prior call to this function after the source text they were
+ * obtained from has been changed by edit, and returns status.  Parameter
+ * buffer holds the edited source text of the given length.  If the bytes
+ * removed by edit lie within a single region and the edited text of that
+ * region still parses as a single definition or declaration, only that
+ * region is relexed and reparsed and its subtree is replaced in ast.  The
+ * statistics then pertain to the reparsed region only.  Otherwise, the
+ * AST passed in is released and the whole buffer is parsed anew.  In
+ * either case, the updated AST is passed back in ast and regions are
+ * updated to match the edited source text.
+ * ----------------------------------------------------------------------- */
+ 
+ void m2t_reparse_buffer
+   (m2t_sourcetype_t srctype,        /* in */
+    const char *name,                /* in */
+    const char *buffer,              /* in */
+    size_t length,                   /* in */
+    const m2t_text_edit_t *edit,     /* in */
+    m2t_ast_t *ast,                  /* in, out */
+    m2t_region_table_t regions,      /* in, out */
+    m2t_stats_t *stats,              /* out */
+    m2t_parser_status_t *status);    /* out */
+
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_parse_file_w_handler(srctype, srcpath, handler, ...)
+ * --------------------------------------------------------------------------
+ * Parses a Modula-2 source file represented by srcpath and returns status
+ * like m2t_parse_file() but passes the abstract syntax tree to handler as
+ * it is built, instead of passing it back.  The nodes along the spine of
+ * the tree, its root, the module, the module's import and definition or
+ * declaration lists and the module's block, are reported as they are
+ * opened and closed.  All other nodes are reported as complete subtrees,
+ * each as soon as it has been parsed, in the order of a depth first
+ * traversal of the tree.  A reported subtree is released when handler
+ * returns.  Peak memory use is therefore bounded by the largest single
+ * import, definition, declaration or module body statement sequence,
+ * independent of the size of the source.  Nodes are released only if they
+ * are not allocated from an arena.  Collects simple statistics and passes
+ * them back in stats.
+ * ----------------------------------------------------------------------- */
+ 
+ void m2t_parse_file_w_handler
+   (m2t_sourcetype_t srctype,        /* in */
+    const char *srcpath,             /* in */
+    m2t_parse_handler_t handler,     /* in */
+    void *context,                   /* in */
+    m2t_stats_t *stats,              /* out */
+    m2t_parser_status_t *status);    /* out */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_parse_file_w_spans(srctype, srcpath, ast, spans, ...)
+ * --------------------------------------------------------------------------
+ * Parses a Modula-2 source file represented by srcpath and returns status
+ * like m2t_parse_file() and additionally records source spans in spans.
+ * Spans are recorded for the nodes of types, formal types, returned types
+ * and export lists, which suffices for a source-to-source writer to copy
+ * all other text through unchanged.  The caller allocates spans and is
+ * responsible for releasing it.
+ * ----------------------------------------------------------------------- */
+ 
+ void m2t_parse_file_w_spans
+   (m2t_sourcetype_t srctype,        /* in */
+    const char *srcpath,             /* in */
+    m2t_ast_t *ast,                  /* out */
+    m2t_span_table_t spans,          /* in */
+    m2t_stats_t *stats,              /* out */
+    m2t_parser_status_t *status);    /* out */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_parse_file_w_comments(srctype, srcpath, ast, spans, ...)
+ * --------------------------------------------------------------------------
+ * Parses a Modula-2 source file represented by srcpath and returns status
+ * like m2t_parse_file_w_spans() and additionally records the comments of
+ * the source in comments.  Each comment is recorded as the byte offset and
+ * length of its text within the source, which is loaded once and passed
+ * to comments, nothing is copied.  Comments preceding the module heading
+ * are attached to the module node, comments preceding or within a constant,
+ * type, variable or procedure heading definition or declaration up to its
+ * terminating semicolon are attached to its node, comments preceding a
+ * procedure or module declaration are attached to its node.  All other
+ * comments are recorded without a node.  If spans is NULL, no spans are
+ * recorded.  The caller allocates spans and comments and is responsible
+ * for releasing them.
+ * ----------------------------------------------------------------------- */
+ 
+ void m2t_parse_file_w_comments
+   (m2t_sourcetype_t srctype,        /* in */
+    const char *srcpath,             /* in */
+    m2t_ast_t *ast,                  /* out */
+    m2t_span_table_t spans,          /* in */
+    m2t_comment_table_t comments,    /* in */
+    m2t_stats_t *stats,              /* out */
+    m2t_parser_status_t *status);    /* out */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_parse_file_w_type_pool(srctype, srcpath, ast, types, ...)
+ * --------------------------------------------------------------------------
+ * Parses a Modula-2 source file represented by srcpath and returns status
+ * like m2t_parse_file() and additionally interns the subtrees of types and
+ * formal types in types, so that structurally identical type denoters share
+ * a single subtree.  Type equivalence of interned subtrees can then be
+ * tested by comparing nodes.  Nodes must be allocated from an AST arena
+ * and the AST must be released together with the arena.  The caller
+ * allocates types and is responsible for releasing it.
+ * ----------------------------------------------------------------------- */
+ 
+ void m2t_parse_file_w_type_pool
+   (m2t_sourcetype_t srctype,        /* in */
+    const char *srcpath,             /* in */
+    m2t_ast_t *ast,                  /* out */
+    m2t_type_pool_t types,           /* in */
+    m2t_stats_t *stats,              /* out */
+    m2t_parser_status_t *status);    /* out */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_parse_file_w_timing(srctype, srcpath, ast, timing, ...)
+ * --------------------------------------------------------------------------
+ * Parses a Modula-2 source file represented by srcpath and returns status
+ * like m2t_parse_file() and additionally adds the time spent loading,
+ * lexing and parsing to timing and the number of consumed tokens to the
+ * token count of timing.  The byte count of timing is left to the caller.
+ * Unless option pretokenize is set, lexing is interleaved with parsing and
+ * its time is included in the time of the parse phase.
+ * ----------------------------------------------------------------------- */
+ 
+ void m2t_parse_file_w_timing
+   (m2t_sourcetype_t srctype,        /* in */
+    const char *srcpath,             /* in */
+    m2t_ast_t *ast,                  /* out */
+    m2c_phase_timing_t *timing,      /* in, out */
+    m2t_stats_t *stats,              /* out */
+    m2t_parser_status_t *status);    /* out */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_parse_buffer_w_timing(srctype, name, buffer, length, ...)
+ * --------------------------------------------------------------------------
+ * Parses Modula-2 source text held in a caller owned buffer and returns
+ * status like m2t_parse_buffer() and additionally adds the time spent
+ * lexing and parsing to timing and the number of consumed tokens to the
+ * token count of timing like m2t_parse_file_w_timing().  Since the source
+ * has already been loaded, only the setup of the lexer is added to the
+ * time of the load phase.
+ * ----------------------------------------------------------------------- */
+ 
+ void m2t_parse_buffer_w_timing
+   (m2t_sourcetype_t srctype,        /* in */
+    const char *name,                /* in */
+    const char *buffer,              /* in */
+    size_t length,                   /* in */
+    m2t_ast_t *ast,                  /* out */
+    m2c_phase_timing_t *timing,      /* in, out */
+    m2t_stats_t *stats,              /* out */
+    m2t_parser_status_t *status);    /* out */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_parse_imports(srcpath, srctype, module_ident, imports, status)
+ * --------------------------------------------------------------------------
+ * Scans only the module header and import lists of the Modula-2 source file
+ * represented by srcpath and returns status.  Passes back the type of the
+ * compilation unit in srctype, its module identifier in module_ident and a
+ * newly allocated queue holding the identifier of each imported module in
+ * imports, in order of appearance without duplicates.  The scan stops at
+ * the first symbol following the import lists, no AST is built and the
+ * parser reports no errors.  The caller is responsible for releasing
+ * imports.
+ * ----------------------------------------------------------------------- */
+ 
+ void m2t_parse_imports
+   (const char *srcpath,            /* in */
+    m2t_sourcetype_t *srctype,      /* out */
+    m2t_string_t *module_ident,     /* out */
+    m2t_fifo_t *imports,            /* out */
+    m2t_parser_status_t *status);   /* out */
+
 #endif /* M2T_PARSER_H */
 
 /* END OF FILE */
\ No newline at end of file
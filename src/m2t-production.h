@@ -0,0 +1,227 @@
+/* M2T -- Sorce to Source Modula-2 Translator
+ *
+ * Copyright (c) 2016-2023 Benjamin Kowarsch
+ *
+ * Author & Maintainer: Benjamin Kowarsch <org.m2sf>
+ *
+ * @synopsis
+ *
+ * M2T is a multi-dialect Modula-2 source-to-source translator. It translates
+ * source files  written in the  classic dialects  to semantically equivalent
+ * source files in  Modula-2 Revision 2010 (M2R10).  It supports  the classic
+ * Modula-2 dialects  described in  the 2nd, 3rd and 4th editions  of Niklaus
+ * Wirth's book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * For more details please visit: https://github.com/trijezdci/m2t/wiki
+ *
+ * @repository
+ *
+ * https://github.com/trijezdci/m2t
+ *
+ * @file
+ *
+ * m2t-production.h
+ *
+ * Public interface for M2T production lookup.
+ *
+ * @license
+ *
+ * M2T is free software:  You can redistribute and modify it  under the terms
+ * of the  GNU Lesser General Public License (LGPL) either version 2.1  or at
+ * your choice version 3, both as published by the Free Software Foundation.
+ *
+ * M2T is distributed  in the hope  that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even  the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received  a copy of the  GNU Lesser General Public License
+ * along with M2T.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#ifndef M2T_PRODUCTION_H
+#define M2T_PRODUCTION_H
+
+#include "m2t-common.h"
+#include "m2t-tokenset.h"
+
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * type m2t_production_t
+ * --------------------------------------------------------------------------
+ * Enumerated production values representing Modula-2 non-terminal symbols.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  /* Productions with unique FIRST and FOLLOW sets */
+
+  DEFINITION_MODULE,        /* definitionModule */
+  IMPORT,                   /* import */
+  QUALIFIED_IMPORT,         /* qualifiedImport */
+  UNQUALIFIED_IMPORT,       /* unqualifiedImport */
+  IDENT_LIST,               /* identList */
+  DEFINITION,               /* definition */
+  CONST_DEFINITION,         /* constDefinition */
+  TYPE_DEFINITION,          /* typeDefinition */
+  TYPE,                     /* type */
+  DERIVED_OR_SUBRANGE_TYPE, /* derivedOrSubrangeType */
+  QUALIDENT,                /* qualident */
+  RANGE,                    /* range */
+  ENUM_TYPE,                /* enumType */
+  SET_TYPE,                 /* setType */
+  COUNTABLE_TYPE,           /* countableType */
+  ARRAY_TYPE,               /* arrayType */
+  EXTENSIBLE_RECORD_TYPE,   /* extensibleRecordType */
+  FIELD_LIST_SEQUENCE,      /* fieldListSequence */
+  VARIANT_RECORD_TYPE,      /* variantRecordType */
+  VARIANT_FIELD_LIST_SEQ,   /* variantFieldListSeq */
+  VARIANT_FIELD_LIST,       /* variantFieldList */
+  VARIANT_FIELDS,           /* variantFields */
+  VARIANT,                  /* variant */
+  CASE_LABEL_LIST,          /* caseLabelList */
+  CASE_LABELS,              /* caseLabels */
+  POINTER_TYPE,             /* pointerType */
+  PROCEDURE_TYPE,           /* procedureType */
+  SIMPLE_FORMAL_TYPE,       /* simpleFormalType */
+  PROCEDURE_HEADER,         /* procedureHeader */
+  PROCEDURE_SIGNATURE,      /* procedureSignature */
+  SIMPLE_FORMAL_PARAMS,     /* simpleFormalParams */
+  IMPLEMENTATION_MODULE,    /* implementationModule */
+  PROGRAM_MODULE,           /* programModule */
+  MODULE_PRIORITY,          /* modulePriority */
+  BLOCK,                    /* block */
+  DECLARATION,              /* declaration */
+  TYPE_DECLARATION,         /* typeDeclaration */
+  VAR_SIZE_RECORD_TYPE,     /* varSizeRecordType */
+  VARIABLE_DECLARATION,     /* variableDeclaration */
+  PROCEDURE_DECLARATION,    /* procedureDeclaration */
+  MODULE_DECLARATION,       /* moduleDeclaration */
+  EXPORT,                   /* export */
+  STATEMENT_SEQUENCE,       /* statementSequence */
+  STATEMENT,                /* statement */
+  ASSIGNMENT_OR_PROC_CALL,  /* assignmentOrProcCall */
+  ACTUAL_PARAMETERS,        /* actualParameters */
+  EXPRESSION_LIST,          /* expressionList */
+  RETURN_STATEMENT,         /* returnStatement */
+  WITH_STATEMENT,           /* withStatement */
+  IF_STATEMENT,             /* ifStatement */
+  CASE_STATEMENT,           /* caseStatement */
+  CASE,                     /* case */
+  LOOP_STATEMENT,           /* loopStatement */
+  WHILE_STATEMENT,          /* whileStatement */
+  REPEAT_STATEMENT,         /* repeatStatement */
+  FOR_STATEMENT,            /* forStatement */
+  DESIGNATOR,               /* designator */
+  SELECTOR,                 /* selector */
+  EXPRESSION,               /* expression */
+  SIMPLE_EXPRESSION,        /* simpleExpression */
+  TERM,                     /* term */
+  SIMPLE_TERM,              /* simpleTerm */
+  FACTOR,                   /* factor */
+  DESIGNATOR_OR_FUNC_CALL,  /* designatorOrFuncCall */
+  SET_VALUE,                /* setValue */
+  ELEMENT,                  /* element */
+  FORMAL_TYPE,              /* formalType */
+  ATTRIBUTED_FORMAL_TYPE,   /* attributedFormalType */
+  FORMAL_PARAM_LIST,        /* formalParamList */
+  FORMAL_PARAMS,            /* formalParams */
+  ATTRIB_FORMAL_PARAMS,     /* attribFormalParams */
+  
+  /* Productions with alternative FIRST sets */
+  
+  /* Dependent on option variant records */
+  TYPE_DECLARATION_TAIL,    /* typeDeclarationTail */
+  
+  /* Enumeration Terminator */
+  
+  PRODUCTION_END_MARK /* marks the end of this enumeration */
+} m2t_production_t;
+
+
+#define M2T_FIRST_OPTION_DEPENDENT TYPE_DECLARATION_TAIL
+#define M2T_LAST_OPTION_DEPENDENT TYPE_DECLARATION_TAIL
+
+
+/* --------------------------------------------------------------------------
+ * Constant M2T_PRODUCTION_COUNT -- number of productions
+ * ----------------------------------------------------------------------- */
+
+#define M2T_PRODUCTION_COUNT PRODUCTION_END_MARK
+
+
+/* --------------------------------------------------------------------------
+ * Constant M2T_ALTERNATE_SET_OFFSET -- offset of alternative sets
+ * --------------------------------------------------------------------------
+ * The alternative FIRST and FOLLOW sets of option dependent productions
+ * follow the sets of all productions in the FIRST and FOLLOW set tables.
+ * The alternative set of production p is at index p + offset.
+ * ----------------------------------------------------------------------- */
+
+#define M2T_ALTERNATE_SET_OFFSET \
+  (M2T_LAST_OPTION_DEPENDENT - M2T_FIRST_OPTION_DEPENDENT + 1)
+
+
+/* --------------------------------------------------------------------------
+ * Constant M2T_PRODUCTION_SET_COUNT -- number of FIRST or FOLLOW sets
+ * ----------------------------------------------------------------------- */
+
+#define M2T_PRODUCTION_SET_COUNT \
+  (M2T_PRODUCTION_COUNT + M2T_ALTERNATE_SET_OFFSET)
+
+
+/* --------------------------------------------------------------------------
+ * function macro M2T_IS_VALID_PRODUCTION(p)
+ * --------------------------------------------------------------------------
+ * Returns TRUE if p represents a non-terminal symbol, otherwise FALSE.
+ * ----------------------------------------------------------------------- */
+
+#define M2T_IS_VALID_PRODUCTION(_p) \
+  (((_p) >= 0) && ((_p) < PRODUCTION_END_MARK))
+
+
+/* --------------------------------------------------------------------------
+ * function macro M2T_IS_INVALID_PRODUCTION(p)
+ * --------------------------------------------------------------------------
+ * Returns TRUE if p does not represents a non-terminal symbol, else FALSE.
+ * ----------------------------------------------------------------------- */
+
+#define M2T_IS_INVALID_PRODUCTION(_p) \
+  (!M2T_IS_VALID_PRODUCTION(_p))
+
+
+/* --------------------------------------------------------------------------
+ * function FIRST(p)
+ * --------------------------------------------------------------------------
+ * Returns a tokenset with the FIRST set of production p.  The sets are
+ * generated at build time and stored in read-only data, the empty set is
+ * returned if p is invalid.
+ * ----------------------------------------------------------------------- */
+
+m2t_tokenset_t FIRST (m2t_production_t p);
+
+
+/* --------------------------------------------------------------------------
+ * function FOLLOW(p)
+ * --------------------------------------------------------------------------
+ * Returns a tokenset with the FOLLOW set of production p.  The sets are
+ * generated at build time and stored in read-only data, the empty set is
+ * returned if p is invalid.
+ * ----------------------------------------------------------------------- */
+
+m2t_tokenset_t FOLLOW (m2t_production_t p);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_name_for_production(p)
+ * --------------------------------------------------------------------------
+ * Returns an immutable pointer to a NUL terminated character string with
+ * a human readable name for p.  Returns NULL if p is not valid.
+ * ----------------------------------------------------------------------- */
+
+const char *m2t_name_for_production (m2t_production_t p);
+
+
+#endif /* M2T_PRODUCTION_H */
+
+/* END OF FILE */
\ No newline at end of file
@@ -0,0 +1,145 @@
+/* M2T -- Sorce to Source Modula-2 Translator
+ *
+ * Copyright (c) 2016-2023 Benjamin Kowarsch
+ *
+ * Author & Maintainer: Benjamin Kowarsch <org.m2sf>
+ *
+ * @synopsis
+ *
+ * M2T is a multi-dialect Modula-2 source-to-source translator. It translates
+ * source files  written in the  classic dialects  to semantically equivalent
+ * source files in  Modula-2 Revision 2010 (M2R10).  It supports  the classic
+ * Modula-2 dialects  described in  the 2nd, 3rd and 4th editions  of Niklaus
+ * Wirth's book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * For more details please visit: https://github.com/trijezdci/m2t/wiki
+ *
+ * @repository
+ *
+ * https://github.com/trijezdci/m2t
+ *
+ * @file
+ *
+ * m2t-profiler.h
+ *
+ * Public interface for M2T parser profiler.
+ *
+ * @license
+ *
+ * M2T is free software:  You can redistribute and modify it  under the terms
+ * of the  GNU Lesser General Public License (LGPL) either version 2.1  or at
+ * your choice version 3, both as published by the Free Software Foundation.
+ *
+ * M2T is distributed  in the hope  that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even  the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received  a copy of the  GNU Lesser General Public License
+ * along with M2T.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#ifndef M2T_PROFILER_H
+#define M2T_PROFILER_H
+
+#include "m2t-common.h"
+#include "m2t-token.h"
+#include "m2t-production.h"
+
+#include <stdint.h>
+
+
+/* --------------------------------------------------------------------------
+ * Profiler
+ * --------------------------------------------------------------------------
+ * The profiler counts how often each production is entered and measures
+ * its inclusive and exclusive time, and it counts the tokens consumed by
+ * the parser for each token value.  Inclusive time is the time between
+ * entry and exit, exclusive time excludes the time spent in productions
+ * called from within.  For recursive productions, only the outermost
+ * activation adds to inclusive time.  Time is measured with the processor's
+ * cycle counter where available, otherwise in nanoseconds of a monotonic
+ * clock.  Counters accumulate over all compilation units until reset.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * type m2t_profiler_status_t
+ * --------------------------------------------------------------------------
+ * Status codes for operations of the profiler.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2T_PROFILER_STATUS_SUCCESS,
+  M2T_PROFILER_STATUS_INVALID_REFERENCE,
+  M2T_PROFILER_STATUS_FOPEN_FAILED,
+  M2T_PROFILER_STATUS_WRITE_FAILED
+} m2t_profiler_status_t;
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_profiler_enter(p)
+ * --------------------------------------------------------------------------
+ * Records entry into production p.  Must be paired with a matching call
+ * to m2t_profiler_exit() when the production is exited.
+ * ----------------------------------------------------------------------- */
+
+void m2t_profiler_enter (m2t_production_t p);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_profiler_exit(p)
+ * --------------------------------------------------------------------------
+ * Records exit from production p, which must be the production of the
+ * most recent unmatched call to m2t_profiler_enter().
+ * ----------------------------------------------------------------------- */
+
+void m2t_profiler_exit (m2t_production_t p);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_profiler_count_token(token)
+ * --------------------------------------------------------------------------
+ * Increments the count of consumed tokens of value token.
+ * ----------------------------------------------------------------------- */
+
+void m2t_profiler_count_token (m2t_token_t token);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_profiler_write(path, status)
+ * --------------------------------------------------------------------------
+ * Writes all counters to the file at path, replacing any existing file.
+ * If path ends in ".csv" the output is in CSV format, otherwise in JSON
+ * format.  Productions and tokens with a count of zero are omitted.
+ *
+ * pre-conditions:
+ * o  path must not be NULL
+ *
+ * post-conditions:
+ * o  counters have been written to path
+ * o  M2T_PROFILER_STATUS_SUCCESS is passed back in status, unless NULL
+ *
+ * error-conditions:
+ * o  if path is NULL, no operation is carried out and status
+ *    M2T_PROFILER_STATUS_INVALID_REFERENCE is passed back, unless NULL
+ * o  if the file cannot be opened, status M2T_PROFILER_STATUS_FOPEN_FAILED
+ *    is passed back, unless NULL
+ * o  if the file cannot be written, status M2T_PROFILER_STATUS_WRITE_FAILED
+ *    is passed back, unless NULL
+ * ----------------------------------------------------------------------- */
+
+void m2t_profiler_write (const char *path, m2t_profiler_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_profiler_reset()
+ * --------------------------------------------------------------------------
+ * Clears all counters.  Must not be called while a production is active.
+ * ----------------------------------------------------------------------- */
+
+void m2t_profiler_reset (void);
+
+
+#endif /* M2T_PROFILER_H */
+
+/* END OF FILE */
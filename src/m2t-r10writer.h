@@ -0,0 +1,179 @@
+/* M2T -- Sorce to Source Modula-2 Translator
+ *
+ * Copyright (c) 2016-2023 Benjamin Kowarsch
+ *
+ * Author & Maintainer: Benjamin Kowarsch <org.m2sf>
+ *
+ * @synopsis
+ *
+ * M2T is a multi-dialect Modula-2 source-to-source translator. It translates
+ * source files  written in the  classic dialects  to semantically equivalent
+ * source files in  Modula-2 Revision 2010 (M2R10).  It supports  the classic
+ * Modula-2 dialects  described in  the 2nd, 3rd and 4th editions  of Niklaus
+ * Wirth's book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * For more details please visit: https://github.com/trijezdci/m2t/wiki
+ *
+ * @repository
+ *
+ * https://github.com/trijezdci/m2t
+ *
+ * @file
+ *
+ * m2t-r10writer.h
+ *
+ * Public interface for M2T M2R10 writer.
+ *
+ * @license
+ *
+ * M2T is free software:  You can redistribute and modify it  under the terms
+ * of the  GNU Lesser General Public License (LGPL) either version 2.1  or at
+ * your choice version 3, both as published by the Free Software Foundation.
+ *
+ * M2T is distributed  in the hope  that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even  the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received  a copy of the  GNU Lesser General Public License
+ * along with M2T.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+
+#ifndef M2T_R10WRITER_H
+#define M2T_R10WRITER_H
+
+#include "m2t-common.h"
+#include "m2t-spans.h"
+#include "m2t-comments.h"
+#include "ast/m2t-ast.h"
+#include "m2-ast-view.h"
+
+
+/* --------------------------------------------------------------------------
+ * M2R10 writer
+ * --------------------------------------------------------------------------
+ * The writer produces Modula-2 R10 source from a classic Modula-2 source
+ * and its AST.  Most classic source text is valid M2R10 unchanged and is
+ * copied through byte for byte from the memory mapped source file.  Only
+ * the constructs that M2R10 does not have or that it interprets differently
+ * are regenerated from the AST:
+ *
+ * o  records with variant parts are flattened into a plain record, the
+ *    tag field and all variant fields become ordinary fields and the case
+ *    structure is retained in comments
+ *
+ * o  export lists are turned into comments
+ *
+ * o  if option subtype-cardinals is set, type CARDINAL is a subtype of
+ *    type INTEGER and CARDINAL type denoters are replaced by an explicit
+ *    subrange of INTEGER, except in formal parameters, procedure types and
+ *    returned types, where M2R10 permits only type identifiers
+ *
+ * Regeneration requires source spans for the nodes concerned, as recorded
+ * by m2t_parse_file_w_spans().  A construct nested within a node that has
+ * no span of its own is regenerated as part of its nearest ancestor that
+ * has one.  Comments following a regenerated construct are preserved.
+ * Comments within it are preserved if they have been recorded by
+ * m2t_parse_file_w_comments() and are written after the regenerated text.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * type m2t_r10writer_status_t
+ * --------------------------------------------------------------------------
+ * Status codes for operations of the M2R10 writer.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2T_R10WRITER_STATUS_SUCCESS,
+  M2T_R10WRITER_STATUS_INVALID_REFERENCE,
+  M2T_R10WRITER_STATUS_SOURCE_UNAVAILABLE,
+  M2T_R10WRITER_STATUS_ALLOCATION_FAILED,
+  M2T_R10WRITER_STATUS_FOPEN_FAILED,
+  M2T_R10WRITER_STATUS_WRITE_FAILED
+} m2t_r10writer_status_t;
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_r10_write(path, srcpath, ast, spans, status)
+ * --------------------------------------------------------------------------
+ * Writes the M2R10 translation of the source file at srcpath to the file at
+ * path, replacing any existing file.  The AST of the source and its spans
+ * must have been obtained by m2t_parse_file_w_spans() from the unmodified
+ * source file.
+ *
+ * pre-conditions:
+ * o  path, srcpath, ast and spans must not be NULL
+ * o  path and srcpath must not be the same pathname
+ *
+ * post-conditions:
+ * o  the translation has been written to path
+ * o  M2T_R10WRITER_STATUS_SUCCESS is passed back in status, unless NULL
+ *
+ * error-conditions:
+ * o  if any pre-condition is not met, no operation is carried out and
+ *    status M2T_R10WRITER_STATUS_INVALID_REFERENCE is passed back
+ * o  if the source file cannot be read, status
+ *    M2T_R10WRITER_STATUS_SOURCE_UNAVAILABLE is passed back
+ * o  if memory could not be allocated, status
+ *    M2T_R10WRITER_STATUS_ALLOCATION_FAILED is passed back
+ * o  if the output file cannot be opened, status
+ *    M2T_R10WRITER_STATUS_FOPEN_FAILED is passed back
+ * o  if the output file cannot be written, status
+ *    M2T_R10WRITER_STATUS_WRITE_FAILED is passed back
+ * ----------------------------------------------------------------------- */
+
+void m2t_r10_write
+  (const char *path,                  /* in */
+   const char *srcpath,               /* in */
+   m2t_astnode_t ast,                 /* in */
+   m2t_span_table_t spans,            /* in */
+   m2t_r10writer_status_t *status);   /* out */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_r10_write_w_comments(path, srcpath, ast, spans, ...)
+ * --------------------------------------------------------------------------
+ * Writes the M2R10 translation of the source file at srcpath to the file at
+ * path like m2t_r10_write() but preserves the comments within regenerated
+ * constructs, as recorded in comments.  The AST, its spans and comments
+ * must have been obtained by m2t_parse_file_w_comments() from the
+ * unmodified source file.  Passing NULL for comments is equivalent to
+ * calling m2t_r10_write().
+ * ----------------------------------------------------------------------- */
+
+void m2t_r10_write_w_comments
+  (const char *path,                  /* in */
+   const char *srcpath,               /* in */
+   m2t_astnode_t ast,                 /* in */
+   m2t_span_table_t spans,            /* in */
+   m2t_comment_table_t comments,      /* in */
+   m2t_r10writer_status_t *status);   /* out */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_r10_write_view(path, srcpath, view, spans, comments, ...)
+ * --------------------------------------------------------------------------
+ * Writes the M2R10 translation of the source file at srcpath as presented
+ * by view to the file at path like m2t_r10_write_w_comments().  The view
+ * must be a view of an AST obtained together with spans and comments by
+ * m2t_parse_file_w_comments() from the unmodified source file.  Nodes the
+ * view has copied are regenerated from the spans and comments of the base
+ * nodes they were copied from, as returned by m2c_ast_view_origin().  As
+ * source text is copied through wherever no conversion applies, a rewrite
+ * of view shows in the output only within regenerated constructs.  The
+ * view must not be rewritten while it is being written.
+ * ----------------------------------------------------------------------- */
+
+void m2t_r10_write_view
+  (const char *path,                  /* in */
+   const char *srcpath,               /* in */
+   m2c_ast_view_t view,               /* in */
+   m2t_span_table_t spans,            /* in */
+   m2t_comment_table_t comments,      /* in */
+   m2t_r10writer_status_t *status);   /* out */
+
+
+#endif /* M2T_R10WRITER_H */
+
+/* END OF FILE */
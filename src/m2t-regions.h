@@ -0,0 +1,178 @@
+/* M2T -- Sorce to Source Modula-2 Translator
+ *
+ * Copyright (c) 2016-2023 Benjamin Kowarsch
+ *
+ * Author & Maintainer: Benjamin Kowarsch <org.m2sf>
+ *
+ * @synopsis
+ *
+ * M2T is a multi-dialect Modula-2 source-to-source translator. It translates
+ * source files  written in the  classic dialects  to semantically equivalent
+ * source files in  Modula-2 Revision 2010 (M2R10).  It supports  the classic
+ * Modula-2 dialects  described in  the 2nd, 3rd and 4th editions  of Niklaus
+ * Wirth's book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * For more details please visit: https://github.com/trijezdci/m2t/wiki
+ *
+ * @repository
+ *
+ * https://github.com/trijezdci/m2t
+ *
+ * @file
+ *
+ * m2t-regions.h
+ *
+ * Public interface for M2T declaration region tables.
+ *
+ * @license
+ *
+ * M2T is free software:  You can redistribute and modify it  under the terms
+ * of the  GNU Lesser General Public License (LGPL) either version 2.1  or at
+ * your choice version 3, both as published by the Free Software Foundation.
+ *
+ * M2T is distributed  in the hope  that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even  the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received  a copy of the  GNU Lesser General Public License
+ * along with M2T.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#ifndef M2T_REGIONS_H
+#define M2T_REGIONS_H
+
+#include "m2t-common.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/* --------------------------------------------------------------------------
+ * Declaration regions
+ * --------------------------------------------------------------------------
+ * A declaration region records where the text of a top-level definition of
+ * a definition module or a top-level declaration of a program or
+ * implementation module lies in its source, as byte offsets.  A region
+ * starts at the first symbol of its definition or declaration and ends
+ * where the symbol following it starts, it therefore includes any
+ * whitespace and comments that trail it.  The regions of a module are kept
+ * in source order, the n-th region belongs to the n-th entry of the
+ * definition or declaration list of the module.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * type m2t_region_t
+ * --------------------------------------------------------------------------
+ * record type representing a declaration region.  Field start holds the
+ * offset of its first byte, field end the offset following its last byte.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* start */ uint32_t start;
+  /* end */ uint32_t end;
+} m2t_region_t;
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2t_region_table_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing a table of declaration regions.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2t_region_table_s *m2t_region_table_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_new_region_table()
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated empty region table, or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2t_region_table_t m2t_new_region_table (void);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_region_table_append(table, region)
+ * --------------------------------------------------------------------------
+ * Appends region to table.  Regions must be appended in source order.
+ * Returns true on success, or false if table or region is NULL, if region
+ * starts before the end of the last region in table or if the table could
+ * not be grown.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_region_table_append
+  (m2t_region_table_t table, const m2t_region_t *region);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_region_table_count(table)
+ * --------------------------------------------------------------------------
+ * Returns the number of regions in table, or zero if table is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2t_region_table_count (m2t_region_table_t table);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_region_table_entry(table, index, region)
+ * --------------------------------------------------------------------------
+ * Passes the region at index in table back in region and returns true.
+ * Returns false and leaves region unmodified if table is NULL or if index
+ * is out of range.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_region_table_entry
+  (m2t_region_table_t table, uint_t index, m2t_region_t *region);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_region_table_find(table, offset, length, index)
+ * --------------------------------------------------------------------------
+ * Searches table for the region that contains the bytes from offset up to
+ * but not including offset + length.  If length is zero, the region that
+ * contains offset is searched for, an offset at the end of the last region
+ * belongs to the last region.  Passes the index of the region back in
+ * index and returns true if found.  Returns false and leaves index
+ * unmodified if table is NULL or if no single region contains the bytes.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_region_table_find
+  (m2t_region_table_t table, uint32_t offset, uint32_t length,
+   uint_t *index);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_region_table_resize(table, index, delta)
+ * --------------------------------------------------------------------------
+ * Adds delta to the end of the region at index in table and to the start
+ * and end of all regions following it, as after an edit within the region
+ * at index that has inserted delta bytes, or removed -delta bytes if delta
+ * is negative.  Does nothing if table is NULL or if index is out of range.
+ * ----------------------------------------------------------------------- */
+
+void m2t_region_table_resize
+  (m2t_region_table_t table, uint_t index, int32_t delta);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_region_table_clear(table)
+ * --------------------------------------------------------------------------
+ * Removes all regions from table.  Does nothing if table is NULL.
+ * ----------------------------------------------------------------------- */
+
+void m2t_region_table_clear (m2t_region_table_t table);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_release_region_table(table)
+ * --------------------------------------------------------------------------
+ * Releases the region table passed in table and passes back NULL in table.
+ * ----------------------------------------------------------------------- */
+
+void m2t_release_region_table (m2t_region_table_t *table);
+
+
+#endif /* M2T_REGIONS_H */
+
+/* END OF FILE */
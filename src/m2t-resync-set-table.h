@@ -0,0 +1,53 @@
+/* M2T -- Sorce to Source Modula-2 Translator
+ *
+ * @file
+ *
+ * m2t-resync-set-table.h
+ *
+ * Generated by m2t-gen-tokensets resync, do not edit.
+ * Change gen/m2t-gen-tokensets.c and regenerate instead.
+ */
+
+#ifndef M2T_RESYNC_SET_TABLE_H
+#define M2T_RESYNC_SET_TABLE_H
+
+static const m2t_tokenset_t m2t_resync_set[] = {
+  /* IMPORT_OR_DEFINITON_OR_END */
+  { { 0x10091040, 0x00000050, 0x00000400 } }, /* 8 */
+  /* IMPORT_OR_IDENT_OR_SEMICOLON */
+  { { 0x00080000, 0x00000200, 0x00000401 } }, /* 4 */
+  /* IDENT_OR_SEMICOLON */
+  { { 0x00000000, 0x00000200, 0x00000401 } }, /* 3 */
+  /* COMMA_OR_SEMICOLON */
+  { { 0x00000000, 0x20000000, 0x00000401 } }, /* 3 */
+  /* DEFINITION_OR_IDENT_OR_SEMICOLON */
+  { { 0x10000040, 0x00000250, 0x00000401 } }, /* 7 */
+  /* DEFINITION_OR_SEMICOLON */
+  { { 0x10000040, 0x00000050, 0x00000401 } }, /* 6 */
+  /* TYPE_OR_COMMA_OR_OF */
+  { { 0x5A000004, 0x20000202, 0x00000450 } }, /* 11 */
+  /* SEMICOLON_OR_END */
+  { { 0x00001000, 0x00000000, 0x00000401 } }, /* 3 */
+  /* ELSE_OR_END */
+  { { 0x00001400, 0x00000000, 0x00000400 } }, /* 3 */
+  /* COMMA_OR_RIGHT_PAREN */
+  { { 0x00000000, 0x20000000, 0x00000420 } }, /* 3 */
+  /* COLON_OR_SEMICOLON */
+  { { 0x00000000, 0x80000000, 0x00000401 } }, /* 3 */
+  /* IMPORT_OR_BLOCK */
+  { { 0x10891048, 0x00000050, 0x00000400 } }, /* 10 */
+  /* DECLARATION_OR_IDENT_OR_SEMICOLON */
+  { { 0x10800040, 0x00000250, 0x00000401 } }, /* 8 */
+  /* DECLARATION_OR_SEMICOLON */
+  { { 0x10800040, 0x00000050, 0x00000401 } }, /* 7 */
+  /* FIRST_OR_FOLLOW_OF_STATEMENT */
+  { { 0x8022BC20, 0x000003A1, 0x00000409 } }, /* 17 */
+  /* ELSIF_OR_ELSE_OR_END */
+  { { 0x00001C00, 0x00000000, 0x00000400 } }, /* 4 */
+  /* FOR_LOOP_BODY */
+  { { 0x00000200, 0x00000000, 0x00000400 } } /* 2 */
+}; /* end m2t_resync_set */
+
+#endif /* M2T_RESYNC_SET_TABLE_H */
+
+/* END OF FILE */
@@ -0,0 +1,122 @@
+/* M2T -- Sorce to Source Modula-2 Translator
+ *
+ * Copyright (c) 2016-2023 Benjamin Kowarsch
+ *
+ * Author & Maintainer: Benjamin Kowarsch <org.m2sf>
+ *
+ * @synopsis
+ *
+ * M2T is a multi-dialect Modula-2 source-to-source translator. It translates
+ * source files  written in the  classic dialects  to semantically equivalent
+ * source files in  Modula-2 Revision 2010 (M2R10).  It supports  the classic
+ * Modula-2 dialects  described in  the 2nd, 3rd and 4th editions  of Niklaus
+ * Wirth's book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * For more details please visit: https://github.com/trijezdci/m2t/wiki
+ *
+ * @repository
+ *
+ * https://github.com/trijezdci/m2t
+ *
+ * @file
+ *
+ * m2t-resync-sets.h
+ *
+ * Public interface for M2T resync set lookup.
+ *
+ * @license
+ *
+ * M2T is free software:  You can redistribute and modify it  under the terms
+ * of the  GNU Lesser General Public License (LGPL) either version 2.1  or at
+ * your choice version 3, both as published by the Free Software Foundation.
+ *
+ * M2T is distributed  in the hope  that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even  the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received  a copy of the  GNU Lesser General Public License
+ * along with M2T.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#ifndef M2T_RESYNC_SETS_H
+#define M2T_RESYNC_SETS_H
+
+#include "m2t-common.h"
+#include "m2t-tokenset.h"
+
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * type m2t_resync_enum_t
+ * --------------------------------------------------------------------------
+ * Enumerated values representing resynchronisation sets.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  /* Enumerated Resynchronisation Sets */
+
+  IMPORT_OR_DEFINITON_OR_END,
+  IMPORT_OR_IDENT_OR_SEMICOLON,
+  IDENT_OR_SEMICOLON,
+  COMMA_OR_SEMICOLON,
+  DEFINITION_OR_IDENT_OR_SEMICOLON,
+  DEFINITION_OR_SEMICOLON,
+  TYPE_OR_COMMA_OR_OF,
+  SEMICOLON_OR_END,
+  ELSE_OR_END,
+  COMMA_OR_RIGHT_PAREN,
+  COLON_OR_SEMICOLON,
+  IMPORT_OR_BLOCK,
+  DECLARATION_OR_IDENT_OR_SEMICOLON,
+  DECLARATION_OR_SEMICOLON,
+  FIRST_OR_FOLLOW_OF_STATEMENT,
+  ELSIF_OR_ELSE_OR_END,
+  FOR_LOOP_BODY,
+  
+  /* Enumeration Terminator */
+  
+  RESYNC_END_MARK /* marks the end of this enumeration */
+} m2t_resync_enum_t;
+
+
+/* --------------------------------------------------------------------------
+ * Constant M2T_RESYNC_SET_COUNT -- number of resync sets
+ * ----------------------------------------------------------------------- */
+
+#define M2T_RESYNC_SET_COUNT RESYNC_END_MARK
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_is_valid_resync_set(rs)
+ * --------------------------------------------------------------------------
+ * Returns TRUE if rs represents a resync set, otherwise FALSE.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_is_valid_resync_set (m2t_resync_enum_t rs);
+
+
+/* --------------------------------------------------------------------------
+ * function RESYNC(rs)
+ * --------------------------------------------------------------------------
+ * Returns a tokenset with resync set rs.  The sets are generated at build
+ * time and stored in read-only data, the empty set is returned if rs is
+ * invalid.
+ * ----------------------------------------------------------------------- */
+
+m2t_tokenset_t RESYNC (m2t_resync_enum_t rs);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_name_for_resync_set(rs)
+ * --------------------------------------------------------------------------
+ * Returns an immutable pointer to a NUL terminated character string with
+ * a human readable name for rescync set rs.  Returns NULL if rs is invalid.
+ * ----------------------------------------------------------------------- */
+
+const char *m2t_name_for_resync_set (m2t_resync_enum_t rs);
+
+
+#endif /* M2T_RESYNC_SETS_H */
+
+/* END OF FILE */
\ No newline at end of file
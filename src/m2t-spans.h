@@ -0,0 +1,137 @@
+/* M2T -- Sorce to Source Modula-2 Translator
+ *
+ * Copyright (c) 2016-2023 Benjamin Kowarsch
+ *
+ * Author & Maintainer: Benjamin Kowarsch <org.m2sf>
+ *
+ * @synopsis
+ *
+ * M2T is a multi-dialect Modula-2 source-to-source translator. It translates
+ * source files  written in the  classic dialects  to semantically equivalent
+ * source files in  Modula-2 Revision 2010 (M2R10).  It supports  the classic
+ * Modula-2 dialects  described in  the 2nd, 3rd and 4th editions  of Niklaus
+ * Wirth's book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * For more details please visit: https://github.com/trijezdci/m2t/wiki
+ *
+ * @repository
+ *
+ * https://github.com/trijezdci/m2t
+ *
+ * @file
+ *
+ * m2t-spans.h
+ *
+ * Public interface for M2T source span tables.
+ *
+ * @license
+ *
+ * M2T is free software:  You can redistribute and modify it  under the terms
+ * of the  GNU Lesser General Public License (LGPL) either version 2.1  or at
+ * your choice version 3, both as published by the Free Software Foundation.
+ *
+ * M2T is distributed  in the hope  that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even  the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received  a copy of the  GNU Lesser General Public License
+ * along with M2T.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#ifndef M2T_SPANS_H
+#define M2T_SPANS_H
+
+#include "m2t-common.h"
+#include "ast/m2t-ast.h"
+
+
+/* --------------------------------------------------------------------------
+ * Source spans
+ * --------------------------------------------------------------------------
+ * A source span records where the text of an AST node lies in its source
+ * file.  It starts at the first symbol of the node and ends where the
+ * symbol following the node starts, it therefore includes any whitespace
+ * and comments that trail the node.  Lines and columns are counted from 1.
+ * Spans are kept in a side table keyed by node so that nodes of parses
+ * that do not record spans carry no overhead.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * type m2t_source_span_t
+ * --------------------------------------------------------------------------
+ * record type representing the source span of an AST node.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* first_line */ uint_t first_line;
+  /* first_column */ uint_t first_column;
+  /* end_line */ uint_t end_line;
+  /* end_column */ uint_t end_column;
+} m2t_source_span_t;
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2t_span_table_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing a table of source spans keyed by node.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2t_span_table_s *m2t_span_table_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_new_span_table()
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated empty span table, or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2t_span_table_t m2t_new_span_table (void);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_span_table_add(table, node, span)
+ * --------------------------------------------------------------------------
+ * Records span as the source span of node in table, replacing any span
+ * previously recorded for node.  Returns true on success, or false if
+ * table, node or span is NULL or if the table could not be grown.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_span_table_add
+  (m2t_span_table_t table, m2t_astnode_t node, const m2t_source_span_t *span);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_span_table_lookup(table, node, span)
+ * --------------------------------------------------------------------------
+ * Passes the source span recorded for node in table back in span and
+ * returns true.  Returns false and leaves span unmodified if no span has
+ * been recorded for node or if table is NULL.
+ * ----------------------------------------------------------------------- */
+
+bool m2t_span_table_lookup
+  (m2t_span_table_t table, m2t_astnode_t node, m2t_source_span_t *span);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_span_table_count(table)
+ * --------------------------------------------------------------------------
+ * Returns the number of spans recorded in table, or zero if table is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2t_span_table_count (m2t_span_table_t table);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_release_span_table(table)
+ * --------------------------------------------------------------------------
+ * Releases the span table passed in table and passes back NULL in table.
+ * The nodes recorded in the table are not released.
+ * ----------------------------------------------------------------------- */
+
+void m2t_release_span_table (m2t_span_table_t *table);
+
+
+#endif /* M2T_SPANS_H */
+
+/* END OF FILE */
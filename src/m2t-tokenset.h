@@ -46,36 +46,99 @@
 #include "m2t-token.h"
 
 
+/* --------------------------------------------------------------------------
+ * constant M2T_TOKENSET_SEGMENT_COUNT
+ * --------------------------------------------------------------------------
+ * Number of 32 bit segments in a tokenset.
+ * ----------------------------------------------------------------------- */
+
+#define M2T_TOKENSET_SEGMENT_COUNT ((TOKEN_END_MARK / 32) + 1)
+
+
 /* --------------------------------------------------------------------------
  * type m2t_tokenset_t
  * --------------------------------------------------------------------------
- * Opaque pointer type representing a Modula-2 token-set object.
+ * Record type representing a Modula-2 token-set, implemented as an array of
+ * 32-bit segments.  Tokensets are fixed-size values, they are passed and
+ * returned by value and need neither allocation nor deallocation.  Bit n of
+ * segment s represents the token with ordinal value s * 32 + n.
  * --------------------------------------------------------------------------
  */
 
-typedef struct m2t_tokenset_opaque_t *m2t_tokenset_t;
+typedef struct {
+  /* segment */ uint32_t segment[M2T_TOKENSET_SEGMENT_COUNT];
+} m2t_tokenset_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_tokenset_popcount(bits)
+ * --------------------------------------------------------------------------
+ * Returns the number of set bits in the 32-bit value bits.  Uses the
+ * compiler's population count builtin where available, which maps to a
+ * single instruction on targets that provide one.
+ * ----------------------------------------------------------------------- */
+
+inline uint_t m2t_tokenset_popcount (uint32_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+  return (uint_t) __builtin_popcount(bits);
+#else
+  bits = bits - ((bits >> 1) & 0x55555555);
+  bits = (bits & 0x33333333) + ((bits >> 2) & 0x33333333);
+  bits = (bits + (bits >> 4)) & 0x0F0F0F0F;
+  return (uint_t) ((bits * 0x01010101) >> 24);
+#endif
+} /* end m2t_tokenset_popcount */
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_tokenset_from_list(token_list)
+ * --------------------------------------------------------------------------
+ * Returns a tokenset that includes the tokens passed as arguments of a
+ * non-empty variadic argument list.  The argument list must be explicitly
+ * terminated with 0.  Tokens outside of the token range are ignored.
+ * ----------------------------------------------------------------------- */
+
+m2t_tokenset_t m2t_tokenset_from_list (m2t_token_t first_token, ...);
 
 
 /* --------------------------------------------------------------------------
- * function m2t_new_tokenset_from_list(token_list)
+ * function m2t_tokenset_union(set1, set2)
  * --------------------------------------------------------------------------
- * Returns a newly allocated tokenset object that includes the tokens passed
- * as arguments of a non-empty variadic argument list.  The argument list
- * must be explicitly terminated with 0.
+ * Returns the set union of set1 and set2.
  * ----------------------------------------------------------------------- */
 
-m2t_tokenset_t m2t_new_tokenset_from_list (m2t_token_t first_token, ...);
+inline m2t_tokenset_t m2t_tokenset_union
+  (m2t_tokenset_t set1, m2t_tokenset_t set2) {
+  uint_t seg_index;
+  
+  seg_index = 0;
+  while (seg_index < M2T_TOKENSET_SEGMENT_COUNT) {
+    set1.segment[seg_index] |= set2.segment[seg_index];
+    seg_index++;
+  } /* end while */
+  
+  return set1;
+} /* end m2t_tokenset_union */
 
 
 /* --------------------------------------------------------------------------
- * function m2t_new_tokenset_from_union(set_list)
+ * function m2t_tokenset_intersection(set1, set2)
  * --------------------------------------------------------------------------
- * Returns a newly allocated tokenset object that represents the set union of
- * the tokensets passed as arguments of a non-empty variadic argument list.
- * The argument list must be explicitly terminated with NULL.
+ * Returns the set intersection of set1 and set2.
  * ----------------------------------------------------------------------- */
 
-m2t_tokenset_t m2t_new_tokenset_from_union (m2t_tokenset_t first_set, ...);
+inline m2t_tokenset_t m2t_tokenset_intersection
+  (m2t_tokenset_t set1, m2t_tokenset_t set2) {
+  uint_t seg_index;
+  
+  seg_index = 0;
+  while (seg_index < M2T_TOKENSET_SEGMENT_COUNT) {
+    set1.segment[seg_index] &= set2.segment[seg_index];
+    seg_index++;
+  } /* end while */
+  
+  return set1;
+} /* end m2t_tokenset_intersection */
 
 
 /* --------------------------------------------------------------------------
@@ -84,16 +147,33 @@ m2t_tokenset_t m2t_new_tokenset_from_union (m2t_tokenset_t first_set, ...);
  * Returns true if token is an element of set, otherwise false.
  * ----------------------------------------------------------------------- */
 
-bool m2t_tokenset_element (m2t_tokenset_t set, m2t_token_t token);
+inline bool m2t_tokenset_element (m2t_tokenset_t set, m2t_token_t token) {
+  if (token >= TOKEN_END_MARK) {
+    return false;
+  } /* end if */
+  
+  return ((set.segment[token / 32] & (UINT32_C(1) << (token % 32))) != 0);
+} /* end m2t_tokenset_element */
 
 
 /* --------------------------------------------------------------------------
- * procedure m2t_tokenset_element_count(set)
+ * function m2t_tokenset_element_count(set)
  * --------------------------------------------------------------------------
  * Returns the number of elements in set.
  * ----------------------------------------------------------------------- */
 
-uint_t m2t_tokenset_element_count (m2t_tokenset_t set);
+inline uint_t m2t_tokenset_element_count (m2t_tokenset_t set) {
+  uint_t seg_index, count;
+  
+  count = 0;
+  seg_index = 0;
+  while (seg_index < M2T_TOKENSET_SEGMENT_COUNT) {
+    count = count + m2t_tokenset_popcount(set.segment[seg_index]);
+    seg_index++;
+  } /* end while */
+  
+  return count;
+} /* end m2t_tokenset_element_count */
 
 
 /* --------------------------------------------------------------------------
@@ -102,7 +182,19 @@ uint_t m2t_tokenset_element_count (m2t_tokenset_t set);
  * Returns true if each element in subset is also in set, otherwise false.
  * ----------------------------------------------------------------------- */
 
-bool m2t_tokenset_subset (m2t_tokenset_t set, m2t_tokenset_t subset);
+inline bool m2t_tokenset_subset (m2t_tokenset_t set, m2t_tokenset_t subset) {
+  uint_t seg_index;
+  uint32_t excess;
+  
+  excess = 0;
+  seg_index = 0;
+  while (seg_index < M2T_TOKENSET_SEGMENT_COUNT) {
+    excess |= subset.segment[seg_index] & ~set.segment[seg_index];
+    seg_index++;
+  } /* end while */
+  
+  return (excess == 0);
+} /* end m2t_tokenset_subset */
 
 
 /* --------------------------------------------------------------------------
@@ -111,7 +203,19 @@ bool m2t_tokenset_subset (m2t_tokenset_t set, m2t_tokenset_t subset);
  * Returns true if set1 and set2 have no common elements, otherwise false.
  * ----------------------------------------------------------------------- */
 
-bool m2t_tokenset_disjunct (m2t_tokenset_t set1, m2t_tokenset_t set2);
+inline bool m2t_tokenset_disjunct (m2t_tokenset_t set1, m2t_tokenset_t set2) {
+  uint_t seg_index;
+  uint32_t common;
+  
+  common = 0;
+  seg_index = 0;
+  while (seg_index < M2T_TOKENSET_SEGMENT_COUNT) {
+    common |= set1.segment[seg_index] & set2.segment[seg_index];
+    seg_index++;
+  } /* end while */
+  
+  return (common == 0);
+} /* end m2t_tokenset_disjunct */
 
 
 /* --------------------------------------------------------------------------
@@ -134,35 +238,17 @@ void m2t_tokenset_print_set (const char *set_name, m2t_tokenset_t set);
 void m2t_tokenset_print_list (m2t_tokenset_t set);
 
 
-/* --------------------------------------------------------------------------
- * procedure m2t_tokenset_print_literal_struct(ident)
- * --------------------------------------------------------------------------
- * Prints a struct definition for tokenset literals.
- * Format: struct ident { uint_t s0, s1, s2, ..., n };
- * ----------------------------------------------------------------------- */
-
-void m2t_tokenset_print_literal_struct (const char *ident);
-
-
 /* --------------------------------------------------------------------------
  * procedure m2t_tokenset_print_literal(set)
  * --------------------------------------------------------------------------
- * Prints a sequence of hex values representing the bit pattern of set.
- * Format: { 0xHHHHHHHH, 0xHHHHHHHH, ..., count };
+ * Prints an initialiser for an m2t_tokenset_t object with the bit pattern
+ * of set, without any trailing punctuation or newline.
+ * Format: { { 0xHHHHHHHH, 0xHHHHHHHH, ... } }
  * ----------------------------------------------------------------------- */
 
 void m2t_tokenset_print_literal (m2t_tokenset_t set);
 
 
-/* --------------------------------------------------------------------------
- * procedure m2t_tokenset_release(set)
- * --------------------------------------------------------------------------
- * Deallocates tokenset set.
- * ----------------------------------------------------------------------- */
-
-void m2t_tokenset_release (m2t_tokenset_t set);
-
-
-#endif /* M2t_TOKENSET_H */
+#endif /* M2T_TOKENSET_H */
 
 /* END OF FILE */
\ No newline at end of file
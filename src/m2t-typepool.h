@@ -0,0 +1,130 @@
+/* M2T -- Sorce to Source Modula-2 Translator
+ *
+ * Copyright (c) 2016-2023 Benjamin Kowarsch
+ *
+ * Author & Maintainer: Benjamin Kowarsch <org.m2sf>
+ *
+ * @synopsis
+ *
+ * M2T is a multi-dialect Modula-2 source-to-source translator. It translates
+ * source files  written in the  classic dialects  to semantically equivalent
+ * source files in  Modula-2 Revision 2010 (M2R10).  It supports  the classic
+ * Modula-2 dialects  described in  the 2nd, 3rd and 4th editions  of Niklaus
+ * Wirth's book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * For more details please visit: https://github.com/trijezdci/m2t/wiki
+ *
+ * @repository
+ *
+ * https://github.com/trijezdci/m2t
+ *
+ * @file
+ *
+ * m2t-typepool.h
+ *
+ * Public interface for M2T type pools.
+ *
+ * @license
+ *
+ * M2T is free software:  You can redistribute and modify it  under the terms
+ * of the  GNU Lesser General Public License (LGPL) either version 2.1  or at
+ * your choice version 3, both as published by the Free Software Foundation.
+ *
+ * M2T is distributed  in the hope  that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even  the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received  a copy of the  GNU Lesser General Public License
+ * along with M2T.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#ifndef M2T_TYPEPOOL_H
+#define M2T_TYPEPOOL_H
+
+#include "m2t-common.h"
+#include "ast/m2t-ast.h"
+
+
+/* --------------------------------------------------------------------------
+ * Type pools
+ * --------------------------------------------------------------------------
+ * A type pool hash-conses the AST subtrees of type denoters.  Interning a
+ * subtree replaces each of its nodes by the structurally identical node
+ * already held in the pool, if any, so that all occurrences of a type such
+ * as ARRAY [0..255] OF CHAR share a single subtree.  Two interned subtrees
+ * are then structurally identical if and only if they are the same node.
+ *
+ * Record and enumeration types declare fields and constants of their own.
+ * Their nodes are never shared and their subtrees are left untouched.
+ *
+ * Shared subtrees cannot be released node by node.  Interning is only
+ * safe while AST nodes are allocated from an arena and the AST is released
+ * together with its arena.  Duplicate nodes are released as they are
+ * replaced, which returns them to the arena if they were allocated last.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2t_type_pool_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing a pool of interned type subtrees.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2t_type_pool_s *m2t_type_pool_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_new_type_pool()
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated empty type pool, or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2t_type_pool_t m2t_new_type_pool (void);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_type_pool_intern(pool, node)
+ * --------------------------------------------------------------------------
+ * Interns the subtree of node in pool and returns its shared node.  Nodes
+ * of the subtree for which pool holds a structurally identical node are
+ * replaced by that node and released, all other nodes are entered into
+ * pool.  Returns node unchanged if pool or node is NULL.  If the pool can
+ * not be grown, nodes are left unshared.
+ * ----------------------------------------------------------------------- */
+
+m2t_astnode_t m2t_type_pool_intern (m2t_type_pool_t pool, m2t_astnode_t node);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_type_pool_count(pool)
+ * --------------------------------------------------------------------------
+ * Returns the number of distinct nodes held in pool, or zero if pool is
+ * NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2t_type_pool_count (m2t_type_pool_t pool);
+
+
+/* --------------------------------------------------------------------------
+ * function m2t_type_pool_shared_count(pool)
+ * --------------------------------------------------------------------------
+ * Returns the number of nodes that have been replaced by a shared node of
+ * pool, or zero if pool is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2t_type_pool_shared_count (m2t_type_pool_t pool);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2t_release_type_pool(pool)
+ * --------------------------------------------------------------------------
+ * Releases the type pool passed in pool and passes back NULL in pool.
+ * The nodes held in the pool are not released.
+ * ----------------------------------------------------------------------- */
+
+void m2t_release_type_pool (m2t_type_pool_t *pool);
+
+
+#endif /* M2T_TYPEPOOL_H */
+
+/* END OF FILE */
@@ -32,8 +32,14 @@
  * You should have received a copy of the GNU Lesser General Public License
  * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
  */
-
 #include "m2-dotwriter.h"
+#include "m2-ast-walk.h"
+#include "m2-ast-parallel.h"
+#include "m2-outsink.h"
+#include "cstring.h"
+
+#include <stddef.h>
+#include <stdlib.h>
 
 
 /* --------------------------------------------------------------------------
@@ -48,48 +54,75 @@
 
 #define NODE_FONTSIZE 8
 
+#define STR(_value) #_value
+
+#define STRVAL(_value) STR(_value)
+
 
 /* --------------------------------------------------------------------------
  * output file context
+ * --------------------------------------------------------------------------
+ * Field root_id holds the node id of the root of the traversal, field split
+ * the list node whose items are drawn in parallel, if any.
  * ----------------------------------------------------------------------- */
 
 typedef struct dotfile_s *dotfile_t;
 
 struct dotfile_s {
-  FILE *fptr;
+  m2c_outsink_t sink;
+  uint_t root_id;
   uint_t next_free_id;
-  uint_t chars_written;
-  m2c_fileio_status_t status;
+  m2c_astnode_t split;
 };
 
 typedef struct dotfile_s dotfile_s;
 
 
+/* --------------------------------------------------------------------------
+ * parallel drawing context
+ * --------------------------------------------------------------------------
+ * Field first_item_id holds the node id of the first item of the split
+ * list, first_free_id[i] the first node id available to the subtree of
+ * item i.  Each subtree uses a disjoint range of node id's, the same range
+ * it would use if the items were drawn in sequence.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  uint_t first_item_id;
+  uint_t *first_free_id;
+} dot_split_s;
+
+
 /* --------------------------------------------------------------------------
  * forward declarations
  * ----------------------------------------------------------------------- */
 
 static m2c_fileio_status_t dot_draw_graph
-  (m2c_dotfile_t dotfile, const char *title, m2c_astnode_t node);
+  (dotfile_t dotfile, const char *title, m2c_astnode_t node);
 
-static m2c_fileio_status_t dot_draw_subtree
-  (m2c_dotfile_t dotfile, m2c_astnode_t node, uint_t node_id);
+static bool dot_draw_enter (m2c_ast_visit_t *visit, void *context);
 
-static m2c_fileio_status_t dot_draw_branches
-  (m2c_dotfile_t dotfile, m2c_astnode_t node, uint_t node_id);
+static bool dot_draw_split (dotfile_t dotfile, m2c_astnode_t list);
+
+static bool dot_draw_part
+  (m2c_outsink_t sink, m2c_astnode_t list, uint_t first, uint_t count,
+   void *context);
+
+static bool count_ids_enter (m2c_ast_visit_t *visit, void *context);
 
 static m2c_fileio_status_t dot_draw_leaves
-  (m2c_dotfile_t dotfile, m2c_astnode_t node, uint_t node_id);
+  (dotfile_t dotfile, m2c_astnode_t node, uint_t node_id);
 
 static m2c_fileio_status_t dot_draw_edges
-  (m2c_dotfile_t dotfile,
-   uint_t node_id, uint_t first_edge_id, uint_t edge_count);
+  (dotfile_t dotfile, uint_t node_id, uint_t first_edge_id, uint_t edge_count);
+
+static void dot_draw_leaf_w_quoted_value
+  (m2c_outsink_t sink, m2c_string_t value, uint_t id);
 
-static int dot_draw_leaf_w_quoted_value
-  (FILE *fptr, m2c_string_t value, uint_t id);
+static void dot_draw_leaf_w_unquoted_value
+  (m2c_outsink_t sink, m2c_string_t value, uint_t id);
 
-static int dot_draw_leaf_w_unquoted_value
-  (FILE *fptr, m2c_string_t value, uint_t id);
+static void dot_write_node_id (m2c_outsink_t sink, uint_t id);
 
 
 /* --------------------------------------------------------------------------
@@ -104,27 +137,31 @@ m2c_fileio_status_t m2c_dot_write
   (const char *path, m2c_astnode_t ast, uint_t *chars_written) {  
   
   dotfile_s dotfile;
-  m2c_fileio_status_t status;
+  m2c_fileio_status_t status, close_status;
+  uint_t count;
   
   if ((file_exists(path)) && (NOT(is_regular_file(path)))) {
     WRITE_OUTPARAM(chars_written, 0);
     return M2C_FILEIO_STATUS_INVALID_FILE;
   } /* end if */
   
-  dotfile.fptr = fopen(path, "w");
+  dotfile.sink = m2c_outsink_open(path, &status);
   
-  if (dotfile.fptr == NULL) {
+  if (dotfile.sink == NULL) {
     WRITE_OUTPARAM(chars_written, 0);
-    return M2C_FILEIO_STATUS_FOPEN_FAILED;
+    return status;
   } /* end if */
   
-  dotfile.chars_written = 0;
-  
   status = dot_draw_graph(&dotfile, DEFAULT_GRAPH_TITLE, ast);
   
-  fclose(dotfile.fptr);
+  count = m2c_outsink_chars_written(dotfile.sink);
+  close_status = m2c_outsink_close(&dotfile.sink);
   
-  WRITE_OUTPARAM(chars_written, dotfile.chars_written);
+  if (status == M2C_FILEIO_STATUS_SUCCESS) {
+    status = close_status;
+  } /* end if */
+  
+  WRITE_OUTPARAM(chars_written, count);
   
   return status;
 } /* end m2c_dot_write */
@@ -134,12 +171,10 @@ m2c_fileio_status_t m2c_dot_write
  * Private Functions                                                       *
  * *********************************************************************** */
 
-#define ADD_TO(_target,_source) { _target = _target + _source }
+#define ADD_TO(_target,_source) { _target = _target + _source; }
 
-#define UPDATE_WRITE_COUNT_OR_BAIL_ON_FAILURE(_dotfile,_write_count) \
-  if (_write_count >= 0) \
-    { ADD_TO(_dotfile->chars_written, _write_count); } \
-  else \
+#define BAIL_ON_WRITE_FAILURE(_dotfile) \
+  if (m2c_outsink_status(_dotfile->sink) != M2C_FILEIO_STATUS_SUCCESS) \
     { return M2C_FILEIO_STATUS_WRITE_FAILED; }
 
 
@@ -150,127 +185,218 @@ m2c_fileio_status_t m2c_dot_write
  * ----------------------------------------------------------------------- */
 
 static m2c_fileio_status_t dot_draw_graph
-  (m2c_dotfile_t dotfile, const char *title, m2c_astnode_t node) {
+  (dotfile_t dotfile, const char *title, m2c_astnode_t node) {
   
-  int write_count;
+  m2c_outsink_t sink;
   m2c_fileio_status_t status;
   
-  /* write graph title */
-  write_count = fprintf(dotfile->fptr, "digraph %s {\n", title);
+  sink = dotfile->sink;
   
-  UPDATE_WRITE_COUNT_OR_BAIL_ON_FAILURE(dotfile, write_count);
+  /* write graph title */
+  m2c_outsink_write_str(sink, "digraph ");
+  m2c_outsink_write_str(sink, title);
+  m2c_outsink_write_str(sink, " {\n");
   
   /* write graph defaults */
-  write_count =
-    fprintf(dotfile->fptr,
-      " graph [fontname=%s,fontsize=%u];\n", FONTNAME, GRAPH_FONTSIZE);
-  
-  UPDATE_WRITE_COUNT_OR_BAIL_ON_FAILURE(dotfile, write_count);
+  m2c_outsink_write_str(sink, " graph [fontname=" FONTNAME
+    ",fontsize=" STRVAL(GRAPH_FONTSIZE) "];\n");
   
   /* write node defaults */
-  write_count =
-    fprintf(dotfile->fptr,
-      " node [style=solid,shape=box,fontsize=%u];\n", NODE_FONTSIZE);
-  
-  UPDATE_WRITE_COUNT_OR_BAIL_ON_FAILURE(dotfile, write_count);
+  m2c_outsink_write_str(sink, " node [style=solid,shape=box,fontsize="
+    STRVAL(NODE_FONTSIZE) "];\n");
   
   /* write edge defaults */
-  write_count =
-    fprintf(dotfile->fptr, " edge [style=solid,arrowsize=0.75];\n\n");
-  
-  UPDATE_WRITE_COUNT_OR_BAIL_ON_FAILURE(dotfile, write_count);
+  m2c_outsink_write_str(sink, " edge [style=solid,arrowsize=0.75];\n\n");
   
   /* write graph label */
-  write_count =
-    fprintf(dotfile->fptr,
-      " labelloc=\"t\"; labeljust=\"l\";\n label=\"%s\n\";\n\n", title);
+  m2c_outsink_write_str(sink,
+    " labelloc=\"t\"; labeljust=\"l\";\n label=\"");
+  m2c_outsink_write_escaped(sink, title);
+  m2c_outsink_write_str(sink, "\n\";\n\n");
   
-  UPDATE_WRITE_COUNT_OR_BAIL_ON_FAILURE(dotfile, write_count);
+  BAIL_ON_WRITE_FAILURE(dotfile);
   
-  /* draw graph */
+  /* draw graph, the root node has node_id 0 */
+  dotfile->root_id = 0;
   dotfile->next_free_id = 1;
-  status = dot_write_subtree(dotfile, node, /* node_id = */ 0);
   
-  if (status != M2C_FILEIO_STATUS_SUCCESS) {
+  /* top-level items of large modules are drawn in parallel */
+  dotfile->split = m2c_ast_parallel_list(node);
+  
+  if (NOT(m2c_ast_walk(node, dot_draw_enter, NULL, dotfile))) {
+    status = m2c_outsink_status(sink);
+    
+    /* traversal stack could not be grown */
+    if (status == M2C_FILEIO_STATUS_SUCCESS) {
+      status = M2C_FILEIO_STATUS_ALLOCATION_FAILED;
+    } /* end if */
+    
     return status;
   } /* end if */
   
   /* write closing delimiter */
-  write_count = fprintf(dotfile->fptr, "} /* end %s */\n", title);
+  m2c_outsink_write_str(sink, "} /* end ");
+  m2c_outsink_write_str(sink, title);
+  m2c_outsink_write_str(sink, " */\n");
   
-  UPDATE_WRITE_COUNT_OR_BAIL_ON_FAILURE(dotfile, write_count);
+  BAIL_ON_WRITE_FAILURE(dotfile);
   
   return M2C_FILEIO_STATUS_SUCCESS;
 } /* end dot_draw_graph */
 
 
 /* --------------------------------------------------------------------------
- * private function dot_draw_subtree(dotfile, node, node_id)
+ * private function dot_draw_enter(visit, context)
+ * --------------------------------------------------------------------------
+ * Enter visitor, draws the visited node, its edges and any leaves to the
+ * dotfile passed in context.  The node id's of the subnodes of a node are
+ * reserved when its edges are drawn, the first is kept in the tag of the
+ * visit.  The items of the split list are drawn in parallel and skipped by
+ * the traversal.  Returns false on failure.
  * ----------------------------------------------------------------------- */
 
-static m2c_fileio_status_t dot_draw_subtree
-  (m2c_dotfile_t dotfile, m2c_astnode_t node, uint_t node_id) {
+static bool dot_draw_enter (m2c_ast_visit_t *visit, void *context) {
   
-  int write_count;
-  const char *node_name;
+  dotfile_t dotfile = (dotfile_t) context;
+  m2c_ast_nodetype_t node_type;
   m2c_fileio_status_t status;
-  m2c_astnode_type_t node_type;
+  uint_t node_id;
   
-  node_type = m2c_ast_nodetype(node);
-  node_name = m2c_name_for_nodetype(node_type);
+  if (visit->depth == 0) {
+    node_id = dotfile->root_id;
+  }
+  else {
+    node_id = visit->parent_tag + visit->index;
+  } /* end if */
   
-  /* draw root node */
-  write_count =
-    fprintf(fptr," node%u [label=\"%s\"];\n", node_id, node_name);
+  node_type = m2c_ast_nodetype(visit->node);
   
-  UPDATE_WRITE_COUNT_OR_BAIL_ON_FAILURE(dotfile, write_count);
+  /* draw root node */
+  m2c_outsink_write_char(dotfile->sink, ' ');
+  dot_write_node_id(dotfile->sink, node_id);
+  m2c_outsink_write_str(dotfile->sink, " [label=\"");
+  m2c_outsink_write_str(dotfile->sink, m2c_name_for_nodetype(node_type));
+  m2c_outsink_write_str(dotfile->sink, "\"];\n");
+  
+  /* draw edges, branches are visited by the traversal */
+  if (m2c_ast_is_nonterminal_nodetype(node_type)) {
+    visit->tag = dotfile->next_free_id;
+    status = dot_draw_edges(dotfile,
+      node_id, visit->tag, m2c_ast_subnode_count(visit->node));
     
-  /* draw all branches and leaves */
-  if (m2c_ast_is_nonterminal(node_type)) {
-    status = dot_draw_branches(dotfile, node, node_id);
+    if ((status == M2C_FILEIO_STATUS_SUCCESS) &&
+        (visit->node == dotfile->split)) {
+      visit->skip = true;
+      
+      if (NOT(dot_draw_split(dotfile, visit->node))) {
+        return false;
+      } /* end if */
+    } /* end if */
   }
   else {
-    status = dot_draw_leaves(dotfile, node, node_id);
+    status = dot_draw_leaves(dotfile, visit->node, node_id);
   } /* end if */
   
-  return status;
-} /* end dot_draw_subtree */
+  return (status == M2C_FILEIO_STATUS_SUCCESS);
+} /* end dot_draw_enter */
 
 
 /* --------------------------------------------------------------------------
- * private function dot_draw_branches(dotfile, node, node_id)
+ * private function dot_draw_split(dotfile, list)
+ * --------------------------------------------------------------------------
+ * Draws the items of list in parallel, list itself and its edges have been
+ * drawn and the node id's of its items have been reserved.  Allocates the
+ * node id range of each item subtree in advance, then reserves all node
+ * id's used by the subtrees.  Returns false on failure.
  * ----------------------------------------------------------------------- */
 
-static m2c_fileio_status_t dot_draw_branches
-  (m2c_dotfile_t dotfile, m2c_astnode_t node, uint_t node_id) {
+static bool dot_draw_split (dotfile_t dotfile, m2c_astnode_t list) {
   
-  int write_count;
-  uint_t index, first_branch_id, branch_count, this_branch_id;
-  m2c_astnode_t this_branch;
-  m2c_fileio_status_t status;
+  uint_t index, item_count, id_count;
+  dot_split_s split;
+  bool completed;
   
-  first_branch_id = dotfile->next_free_id;
-  branch_count = m2c_ast_subnode_count(node);
+  item_count = m2c_ast_subnode_count(list);
+  split.first_free_id = malloc(item_count * sizeof(uint_t));
   
-  /* draw edges, reserve node id's */
-  status = dot_draw_edges(dotfile, node_id, first_branch_id, branch_count);
-  if (status != M2C_FILEIO_STATUS_SUCCESS) {
-    return status;
+  if (split.first_free_id == NULL) {
+    return false;
   } /* end if */
   
-  /* draw subtrees for all branch nodes */
-  for (index = 0; index < branch_count; index++) {
-    this_branch_id = first_branch_id + index;
-    this_branch = m2c_ast_subnode_for_index(node, index);
+  /* the items were reserved last, they precede their subtrees */
+  split.first_item_id = dotfile->next_free_id - item_count;
+  
+  /* each subtree uses one node id per edge and leaf */
+  for (index = 0; index < item_count; index++) {
+    split.first_free_id[index] = dotfile->next_free_id;
     
-    status = dot_draw_subtree(dotfile, this_branch, this_branch_id);
-    if (status != M2C_FILEIO_STATUS_SUCCESS) {
-      break;
+    id_count = 0;
+    if (NOT(m2c_ast_walk(m2c_ast_subnode_for_index(list, index),
+        count_ids_enter, NULL, &id_count))) {
+      free(split.first_free_id);
+      return false;
     } /* end if */
+    
+    ADD_TO(dotfile->next_free_id, id_count);
   } /* end for */
   
-  return status;
-} /* end dot_draw_branches */
+  completed =
+    m2c_ast_parallel_write(dotfile->sink, list, dot_draw_part, &split);
+  
+  free(split.first_free_id);
+  
+  return completed;
+} /* end dot_draw_split */
+
+
+/* --------------------------------------------------------------------------
+ * private function dot_draw_part(sink, list, first, count, context)
+ * --------------------------------------------------------------------------
+ * Part writer, draws count items of list starting at index first to sink,
+ * using the node id ranges of the parallel drawing context passed in
+ * context.  Returns false on failure.
+ * ----------------------------------------------------------------------- */
+
+static bool dot_draw_part
+  (m2c_outsink_t sink, m2c_astnode_t list, uint_t first, uint_t count,
+   void *context) {
+  
+  dot_split_s *split = (dot_split_s *) context;
+  dotfile_s dotfile;
+  uint_t index;
+  
+  dotfile.sink = sink;
+  dotfile.split = NULL;
+  
+  for (index = first; index < first + count; index++) {
+    dotfile.root_id = split->first_item_id + index;
+    dotfile.next_free_id = split->first_free_id[index];
+    
+    if (NOT(m2c_ast_walk(m2c_ast_subnode_for_index(list, index),
+        dot_draw_enter, NULL, &dotfile))) {
+      return false;
+    } /* end if */
+  } /* end for */
+  
+  return true;
+} /* end dot_draw_part */
+
+
+/* --------------------------------------------------------------------------
+ * private function count_ids_enter(visit, context)
+ * --------------------------------------------------------------------------
+ * Enter visitor, adds the number of node id's reserved when drawing the
+ * visited node to the counter passed in context.
+ * ----------------------------------------------------------------------- */
+
+static bool count_ids_enter (m2c_ast_visit_t *visit, void *context) {
+  
+  uint_t *id_count = (uint_t *) context;
+  
+  ADD_TO(*id_count, m2c_ast_subnode_count(visit->node));
+  
+  return true;
+} /* end count_ids_enter */
 
 
 /* --------------------------------------------------------------------------
@@ -278,13 +404,11 @@ static m2c_fileio_status_t dot_draw_branches
  * ----------------------------------------------------------------------- */
 
 #define HAS_QUOTABLE_LEAF_VALUES(_nodetype) \
-  ((_nodetype == AST_QUOTEDVAL) || \
-   (_nodetype == AST_FILENAME) || (_nodetype == AST_OPTIONS))
+  (m2c_ast_print_class_for_nodetype(_nodetype) == M2C_AST_PRINT_QUOTED)
 
 static m2c_fileio_status_t dot_draw_leaves
-  (m2c_dotfile_t dotfile, m2c_astnode_t node, uint_t node_id) {
+  (dotfile_t dotfile, m2c_astnode_t node, uint_t node_id) {
   
-  int write_count;
   uint_t index, first_leaf_id, leaf_count, this_leaf_id;
   bool is_quotable_value;
   m2c_ast_nodetype_t node_type;
@@ -311,20 +435,16 @@ static m2c_fileio_status_t dot_draw_leaves
     
     /* draw leaf, adjust quoting style */
     if (is_quotable_value) {
-      write_count =
-        draw_leaf_w_quoted_value(dotfile->fptr, value, this_leaf_id);
+      dot_draw_leaf_w_quoted_value(dotfile->sink, this_value, this_leaf_id);
     }
     else {
-      write_count =
-        draw_leaf_w_unquoted_value(dotfile->fptr, value, this_leaf_id);
+      dot_draw_leaf_w_unquoted_value(dotfile->sink, this_value, this_leaf_id);
     } /* end if */
-    
-    UPDATE_WRITE_COUNT_OR_BAIL_ON_FAILURE(dotfile, write_count);
   } /* end for */
     
-  write_count = fprintf(fptr, "\n");
+  m2c_outsink_write_char(dotfile->sink, '\n');
   
-  UPDATE_WRITE_COUNT_OR_BAIL_ON_FAILURE(dotfile, write_count);
+  BAIL_ON_WRITE_FAILURE(dotfile);
   
   return M2C_FILEIO_STATUS_SUCCESS;
 } /* end dot_draw_leaves */
@@ -335,30 +455,25 @@ static m2c_fileio_status_t dot_draw_leaves
  * ----------------------------------------------------------------------- */
 
 static m2c_fileio_status_t dot_draw_edges
-  (m2c_dotfile_t dotfile,
-   uint_t node_id, uint_t first_edge_id, uint_t edge_count) {
+  (dotfile_t dotfile, uint_t node_id, uint_t first_edge_id, uint_t edge_count) {
+  
+  uint_t index;
   
-  int write_count;
-  uint_t index, this_edge_id;
-
   /* write header with originating node */
-  write_count = fprintf(dotfile->fptr, " node%u -> {", node_id);
+  m2c_outsink_write_char(dotfile->sink, ' ');
+  dot_write_node_id(dotfile->sink, node_id);
+  m2c_outsink_write_str(dotfile->sink, " -> {");
   
-  UPDATE_WRITE_COUNT_OR_BAIL_ON_FAILURE(dotfile, write_count);
-    
   /* write body with list of connected nodes */
   for (index = 0; index < edge_count; index++) {
-    this_edge_id = first_edge_id + index;
-    
-    write_count = fprintf(fptr, " node%u", this_edge_id);
-    
-    UPDATE_WRITE_COUNT_OR_BAIL_ON_FAILURE(dotfile, write_count);
+    m2c_outsink_write_char(dotfile->sink, ' ');
+    dot_write_node_id(dotfile->sink, first_edge_id + index);
   } /* end for */
     
   /* write list's closing delimiter */
-  write_count = fprintf(fptr, " };\n\n");
+  m2c_outsink_write_str(dotfile->sink, " };\n\n");
     
-  UPDATE_WRITE_COUNT_OR_BAIL_ON_FAILURE(dotfile, write_count);
+  BAIL_ON_WRITE_FAILURE(dotfile);
   
   /* reserve the node id's of the connected nodes */
   ADD_TO(dotfile->next_free_id, edge_count);
@@ -368,48 +483,68 @@ static m2c_fileio_status_t dot_draw_edges
 
 
 /* --------------------------------------------------------------------------
- * private function dot_draw_leaf_w_quoted_value(fptr, value, id)
+ * private function dot_draw_leaf_w_quoted_value(sink, value, id)
+ * --------------------------------------------------------------------------
+ * Label contents are escaped, quotes and backslashes within the value
+ * would otherwise terminate or corrupt the DOT string.
  * ----------------------------------------------------------------------- */
 
-static int dot_draw_leaf_w_quoted_value
-  (FILE *fptr, m2c_string_t value, uint_t id) {
+static void dot_draw_leaf_w_quoted_value
+  (m2c_outsink_t sink, m2c_string_t value, uint_t id) {
   
-  int write_count;
   const char *lexstr;
   
   lexstr = m2c_string_char_ptr(value);
-    
-  if (cstr_contains_char(lexstr, '"')) {
-    write_count = /* DOT output: nodeN [label="'...'",style=filled]; */
-      fprintf(fptr, " node%u [label=\"'%s'\",style=filled];\n", id, lexstr);
+  
+  m2c_outsink_write_char(sink, ' ');
+  dot_write_node_id(sink, id);
+  
+  if (cstr_view_contains_char
+       (cstr_view_w_len(lexstr, m2c_string_length(value)), '"')) {
+    /* DOT output: nodeN [label="'...'",style=filled]; */
+    m2c_outsink_write_str(sink, " [label=\"'");
+    m2c_outsink_write_escaped(sink, lexstr);
+    m2c_outsink_write_str(sink, "'\",style=filled];\n");
   }
   else {
-    write_count = /* DOT output: nodeN [label="\"...\"",style=filled]; */
-      fprintf(fptr,
-        " node%u [label=\"\\\"%s\\\"\",style=filled];\n", id, lexstr);
+    /* DOT output: nodeN [label="\"...\"",style=filled]; */
+    m2c_outsink_write_str(sink, " [label=\"\\\"");
+    m2c_outsink_write_escaped(sink, lexstr);
+    m2c_outsink_write_str(sink, "\\\"\",style=filled];\n");
   } /* end if */
   
-  return write_count;
 } /* end dot_draw_leaf_w_quoted_value */
 
 
 /* --------------------------------------------------------------------------
- * private function dot_draw_leaf_w_unquoted_value(fptr, value, id)
+ * private function dot_draw_leaf_w_unquoted_value(sink, value, id)
  * ----------------------------------------------------------------------- */
 
-static int dot_draw_leaf_w_unquoted_value
-  (FILE *fptr, m2c_string_t value, uint_t id) {
+static void dot_draw_leaf_w_unquoted_value
+  (m2c_outsink_t sink, m2c_string_t value, uint_t id) {
   
-  int write_count;
-  const char *lexstr;
+  /* DOT output: nodeN [label="...",style=filled]; */
+  m2c_outsink_write_char(sink, ' ');
+  dot_write_node_id(sink, id);
+  m2c_outsink_write_str(sink, " [label=\"");
+  m2c_outsink_write_escaped(sink, m2c_string_char_ptr(value));
+  m2c_outsink_write_str(sink, "\",style=filled];\n");
   
-  lexstr = m2c_string_char_ptr(value);
+} /* end dot_draw_leaf_w_unquoted_value */
+
+
+/* --------------------------------------------------------------------------
+ * private function dot_write_node_id(sink, id)
+ * --------------------------------------------------------------------------
+ * Writes the DOT name of the node with the given id, nodeN.
+ * ----------------------------------------------------------------------- */
+
+static void dot_write_node_id (m2c_outsink_t sink, uint_t id) {
   
-  write_count = /* DOT output: nodeN [label="...",style=filled]; */
-    fprintf(fptr, " node%u [label=\"%s\",style=filled];\n", id, lexstr);
+  m2c_outsink_write_chars(sink, "node", 4);
+  m2c_outsink_write_uint(sink, id);
   
-  return write_count;
-} /* end dot_draw_leaf_w_unquoted_value */
+} /* end dot_write_node_id */
 
 
-/* END OF FILE */
\ No newline at end of file
+/* END OF FILE */
@@ -84,6 +84,7 @@ typedef enum {
   M2C_SEMICOLON_AFTER_FORMAL_PARAM_LIST,
   M2C_SEMICOLON_AFTER_STMT_SEQ,
   M2C_EMPTY_STMT_SEQ,
+  M2C_ERROR_DUPLICATE_CASE_LABEL,
   ERROR_Y,              /* Y */
   
   /* Semantic Errors */
@@ -96,6 +97,24 @@ typedef enum {
 } m2c_error_t;
 
 
+/* --------------------------------------------------------------------------
+ * type m2c_diagnostic_format_t
+ * --------------------------------------------------------------------------
+ * Enumerated values representing output formats for diagnostics.  In the
+ * machine readable format each diagnostic is emitted as a single line
+ *
+ *   line:column:kind:code:message
+ *
+ * where kind is one of error, warning or note, and code is the numeric
+ * value of the error code.  Line and column are zero if unknown.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_DIAGNOSTIC_FORMAT_TEXT,
+  M2C_DIAGNOSTIC_FORMAT_MACHINE
+} m2c_diagnostic_format_t;
+
+
 /* --------------------------------------------------------------------------
  * first and last option error codes
  * ----------------------------------------------------------------------- */
@@ -117,7 +136,7 @@ typedef enum {
  * ----------------------------------------------------------------------- */
 
 #define FIRST_SYNTAX_ERROR_CODE M2C_ERROR_UNEXPECTED_TOKEN
-#define LAST_SYNTAX_ERROR_CODE M2C_EMPTY_STMT_SEQ
+#define LAST_SYNTAX_ERROR_CODE M2C_ERROR_DUPLICATE_CASE_LABEL
 
 
 /* --------------------------------------------------------------------------
@@ -183,6 +202,68 @@ bool m2c_is_semantic_error (m2c_error_t error);
 const char *m2c_error_text (m2c_error_t error);
 
 
+/* --------------------------------------------------------------------------
+ * procedure m2c_set_error_limit(limit)
+ * --------------------------------------------------------------------------
+ * Sets the maximum number of errors to be emitted to limit.  Once limit
+ * has been reached, further errors are counted but not emitted and the
+ * parser abandons the source it is parsing.  The count covers the errors
+ * of all sources.  A limit of zero, the default, means no limit.
+ * ----------------------------------------------------------------------- */
+
+void m2c_set_error_limit (uint_t limit);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_error_count()
+ * --------------------------------------------------------------------------
+ * Returns the number of errors emitted or suppressed so far.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_error_count (void);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_reset_error_count()
+ * --------------------------------------------------------------------------
+ * Resets the number of errors emitted or suppressed so far to zero, so that
+ * the error limit applies afresh.  Must not race with any emitting call.
+ * ----------------------------------------------------------------------- */
+
+void m2c_reset_error_count (void);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_error_limit_reached()
+ * --------------------------------------------------------------------------
+ * Returns true if an error limit has been set and reached, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_error_limit_reached (void);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_set_diagnostic_format(format)
+ * --------------------------------------------------------------------------
+ * Sets the output format of diagnostics.  The default is text format.
+ * ----------------------------------------------------------------------- */
+
+void m2c_set_diagnostic_format (m2c_diagnostic_format_t format);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_flush_diagnostics()
+ * --------------------------------------------------------------------------
+ * Writes any buffered diagnostics to the console.  Diagnostics with source
+ * positions are collected in memory and written in batches.  They are
+ * written when the buffer is full, when this procedure is called and when
+ * the program exits.  Diagnostics without source positions are written
+ * immediately.
+ * ----------------------------------------------------------------------- */
+
+void m2c_flush_diagnostics (void);
+
+
 /* --------------------------------------------------------------------------
  * procedure m2c_emit_error(error)
  * --------------------------------------------------------------------------
@@ -37,6 +37,7 @@
 
 
 #include "m2-mutable-strlist.h"
+#include "m2-alloc-stats.h"
 
 #include <stdlib.h>
 #include <stddef.h>
@@ -46,43 +47,28 @@
 
 
 /* --------------------------------------------------------------------------
- * hidden type m2c_strlist_table_t
+ * Inline table size
  * --------------------------------------------------------------------------
- * Implementation of mutable string list segment table.
+ * Number of entries stored within the list object itself.  Most lists are
+ * short identifier lists and never need a separately allocated table.
  * ----------------------------------------------------------------------- */
 
-#define M2C_MUTABLE_STRLIST_SEGMENT_SIZE 16
-
-typedef m2c_string_t m2c_strlist_table_t[M2C_MUTABLE_STRLIST_SEGMENT_SIZE];
-
-
-/* --------------------------------------------------------------------------
- * hidden type m2c_strlist_segment_t
- * --------------------------------------------------------------------------
- * Implementation of mutable string list segment.
- * ----------------------------------------------------------------------- */
-
-typedef struct m2c_strlist_segment_s *m2c_strlist_segment_t;
-
-struct m2c_strlist_segment_s {
-  /* next */ m2c_strlist_segment_t next;
-  /* table */ m2c_strlist_table_t table;
-};
-
-typedef struct m2c_strlist_segment_s m2c_strlist_segment_s;
+#define M2C_MUTABLE_STRLIST_INLINE_SIZE 4
 
 
 /* --------------------------------------------------------------------------
  * hidden type m2c_mutable_strlist_s
  * --------------------------------------------------------------------------
- * Implementation of mutable string list object type.
+ * Implementation of mutable string list object type.  Field entry points
+ * to a contiguous table of capacity entries.  Initially this is the inline
+ * table.  When it is full, a table of twice the capacity is allocated.
  * ----------------------------------------------------------------------- */
 
 struct m2c_mutable_strlist_struct_t {
   /* entry_count */ uint_t entry_count;
-  /* table */ m2c_strlist_table_t table;
-  /* next */ m2c_strlist_segment_t next;
-  /* last */ m2c_strlist_segment_t last;
+  /* capacity */ uint_t capacity;
+  /* entry */ m2c_string_t *entry;
+  /* inline_table */ m2c_string_t inline_table[M2C_MUTABLE_STRLIST_INLINE_SIZE];
 };
 
 typedef struct m2c_mutable_strlist_struct_t m2c_mutable_strlist_struct_t;
@@ -98,34 +84,26 @@ m2c_mutable_strlist_t m2c_new_mutable_strlist
   (m2c_string_t first_entry, m2c_strlist_status_t *status) {
   
   m2c_mutable_strlist_t new_list;
-  uint_t index;
   
   if (first_entry == NULL) {
     SET_STATUS(status, M2C_STRLIST_STATUS_INVALID_REFERENCE);
     return NULL;
   } /* end if */
     
-  new_list = malloc(sizeof(m2c_mutable_strlist_struct_t));
+  new_list =
+    m2c_alloc(M2C_ALLOC_STRLISTS, sizeof(m2c_mutable_strlist_struct_t));
   
   if (new_list == NULL) {
     SET_STATUS(status, M2C_STRLIST_STATUS_ALLOCATION_FAILED);
     return NULL;
   } /* end if */
   
-  new_list->entry_count = 0;
-  
-  for (index = 0; index < M2C_MUTABLE_STRLIST_SEGMENT_SIZE; index++) {
-    new_list->table[index] = NULL;
-  } /* end for */
-  
-  if (first_entry != NULL) {
-    new_list->table[0] = first_entry;
-    m2c_string_retain(first_entry);
-    new_list->entry_count++;
-  } /* end if */
+  new_list->capacity = M2C_MUTABLE_STRLIST_INLINE_SIZE;
+  new_list->entry = new_list->inline_table;
   
-  new_list->next = NULL;
-  new_list->last = NULL;
+  new_list->entry[0] = first_entry;
+  m2c_string_retain(first_entry);
+  new_list->entry_count = 1;
   
   SET_STATUS(status, M2C_STRLIST_STATUS_SUCCESS);
   return new_list;
@@ -135,12 +113,10 @@ m2c_mutable_strlist_t m2c_new_mutable_strlist
 void m2c_print_strlist (m2c_mutable_strlist_t list) {
   uint_t index;
   
-  for (index = 0; index < M2C_MUTABLE_STRLIST_SEGMENT_SIZE; index++) {
-    printf(" list->table[%u] : '%s' (%p)\n",
-      index, m2c_string_char_ptr(list->table[index]),list->table[index]);
-    if (list->table[index] == NULL) {
-      break;
-    } /* end for */
+  for (index = 0; index < list->entry_count; index++) {
+    printf(" list->entry[%u] : '%s' (%p)\n",
+      index, m2c_string_char_ptr(list->entry[index]),
+      (void *) list->entry[index]);
   } /* end for */
   
   return;
@@ -157,7 +133,7 @@ void m2c_print_strlist (m2c_mutable_strlist_t list) {
 m2c_strlist_status_t m2c_mutable_strlist_append
   (m2c_mutable_strlist_t list, m2c_string_t new_entry) {
   
-  m2c_strlist_segment_t segment, new_segment;
+  m2c_string_t *new_table;
   uint_t index;
   
   if ((list == NULL) || (new_entry == NULL)) {
@@ -165,60 +141,39 @@ m2c_strlist_status_t m2c_mutable_strlist_append
   } /* end if */
   
   printf("appending '%s' (%p) to list\n",
-    m2c_string_char_ptr(new_entry), new_entry);
+    m2c_string_char_ptr(new_entry), (void *) new_entry);
   
-  /* check for duplicate in base table */
-  for (index = 0; index < M2C_MUTABLE_STRLIST_SEGMENT_SIZE; index++) {
-    if (list->table[index] == new_entry) {
-      return M2C_STRLIST_STATUS_DUPLICATE_ENTRY;
-    }
-    else if (list->table[index] == NULL) {
-      list->table[index] = new_entry;
-      m2c_string_retain(new_entry);
-      list->entry_count++;
-      return M2C_STRLIST_STATUS_SUCCESS;
-    } /* end if */
-  } /* end for */
+  /* check for duplicate */
+  if (m2c_mutable_strlist_entry_exists(list, new_entry)) {
+    return M2C_STRLIST_STATUS_DUPLICATE_ENTRY;
+  } /* end if */
   
-  /* check for duplicate in segment tables */
-  segment = list->next;
-  while (segment != NULL) {
-    for (index = 0; index < M2C_MUTABLE_STRLIST_SEGMENT_SIZE; index++) {
-      if (segment->table[index] == new_entry) {
-        return M2C_STRLIST_STATUS_DUPLICATE_ENTRY;
-      }
-      else if (segment->table[index] == NULL) {
-        segment->table[index] = new_entry;
-        m2c_string_retain(new_entry);
-        list->entry_count++;
-        return M2C_STRLIST_STATUS_SUCCESS;
-      } /* end if */
+  /* grow table geometrically when full */
+  if (list->entry_count == list->capacity) {
+    new_table = m2c_alloc(M2C_ALLOC_STRLISTS,
+      2 * list->capacity * sizeof(m2c_string_t));
+    
+    if (new_table == NULL) {
+      return M2C_STRLIST_STATUS_ALLOCATION_FAILED;
+    } /* end if */
+    
+    for (index = 0; index < list->entry_count; index++) {
+      new_table[index] = list->entry[index];
     } /* end for */
-    segment = segment->next;
-  } /* end while */
-  
-  /* allocate new segment */
-  new_segment = malloc(sizeof(m2c_strlist_segment_s));
-  
-  if (new_segment == NULL) {
-    return M2C_STRLIST_STATUS_ALLOCATION_FAILED;
+    
+    if (list->entry != list->inline_table) {
+      m2c_dealloc(M2C_ALLOC_STRLISTS, list->entry,
+        list->capacity * sizeof(m2c_string_t));
+    } /* end if */
+    
+    list->entry = new_table;
+    list->capacity = 2 * list->capacity;
   } /* end if */
   
-  /* initialise new segment */
-  new_segment->next = NULL;
-  
-  new_segment->table[0] = new_entry;
+  list->entry[list->entry_count] = new_entry;
   m2c_string_retain(new_entry);
   list->entry_count++;
   
-  for (index = 1; index < M2C_MUTABLE_STRLIST_SEGMENT_SIZE; index++) {
-    new_segment->table[index] = NULL;
-  } /* end if */
-  
-  /* link to end of list */
-  list->last->next = new_segment;
-  list->last = list->last->next;
-  
   return M2C_STRLIST_STATUS_SUCCESS;
 } /* end m2c_mutable_strlist_append */
 
@@ -233,29 +188,11 @@ m2c_strlist_status_t m2c_mutable_strlist_append
 m2c_string_t m2c_mutable_strlist_entry_at_index
   (m2c_mutable_strlist_t list, uint_t index) {
   
-  m2c_strlist_segment_t segment;
-  uint_t running_seg_index, target_seg_index;
-  
   if ((list == NULL) || (index >= list->entry_count)) {
     return NULL;
   } /* end if */
   
-  if (index < M2C_MUTABLE_STRLIST_SEGMENT_SIZE) {
-    return list->table[index];
-  }
-  else {
-    segment = list->next;
-    running_seg_index = 1;
-    target_seg_index = index / M2C_MUTABLE_STRLIST_SEGMENT_SIZE;
-    
-    while ((segment != NULL) && (running_seg_index != target_seg_index)) {
-      segment = segment->next;
-      running_seg_index++;
-    } /* end while */
-    
-    return segment->table[index % M2C_MUTABLE_STRLIST_SEGMENT_SIZE];
-  } /* end if */
-  
+  return list->entry[index];
 } /* end m2c_mutable_strlist_entry_at_index */
 
 
@@ -268,35 +205,19 @@ m2c_string_t m2c_mutable_strlist_entry_at_index
 bool m2c_mutable_strlist_entry_exists
   (m2c_mutable_strlist_t list, m2c_string_t string) {
   
-  m2c_strlist_segment_t segment;
   uint_t index;
   
   if ((list == NULL) || (string == NULL)) {
     return false;
   } /* end if */
   
-  for (index = 0; index < M2C_MUTABLE_STRLIST_SEGMENT_SIZE; index++) {
-    if (list->table[index] == string) {
+  /* strings are interned, entries are compared by reference */
+  for (index = 0; index < list->entry_count; index++) {
+    if (list->entry[index] == string) {
       return true;
-    }
-    else if (list->table[index] == NULL) {
-      return false;
     } /* end if */
   } /* end for */
   
-  segment = list->next;
-  while (segment != NULL) {
-    for (index = 0; index < M2C_MUTABLE_STRLIST_SEGMENT_SIZE; index++) {
-      if (segment->table[index] == string) {
-        return true;
-      }
-      else if (segment->table[index] == NULL) {
-        return false;
-      } /* end if */
-    } /* end for */
-    segment = segment->next;
-  } /* end while */
-  
   return false;
 } /* end m2c_mutable_strlist_entry_exists */
 
@@ -325,20 +246,16 @@ uint_t m2c_mutable_strlist_entry_count (m2c_mutable_strlist_t list) {
 
 void m2c_mutable_strlist_release (m2c_mutable_strlist_t list) {
   
-  m2c_strlist_segment_t segment, prev_segment;
-  
   if (list == NULL) {
     return;
   } /* end if */
   
-  segment = list->next;
-  while (segment != NULL) {
-    prev_segment = segment;
-    segment = segment->next;
-    free(prev_segment);
-  } /* end while */
+  if (list->entry != list->inline_table) {
+    m2c_dealloc(M2C_ALLOC_STRLISTS, list->entry,
+      list->capacity * sizeof(m2c_string_t));
+  } /* end if */
   
-  free(list);
+  m2c_dealloc(M2C_ALLOC_STRLISTS, list, sizeof(m2c_mutable_strlist_struct_t));
   return;
 } /* end m2c_mutable_strlist_release */
 
@@ -45,7 +45,7 @@
  * RESYNC set data structures
  * ----------------------------------------------------------------------- */
 
-m2c_tokenset_literal_t
+static const m2c_tokenset_literal_t
   rs_import_or_definition_or_end =
     INIT_SKIP_TO_IMPORT_OR_DEFINITON_OR_END,
   rs_import_or_ident_or_semicolon =
@@ -88,7 +88,7 @@ m2c_tokenset_literal_t
  * Table of pointers to RESYNC set data structures
  * ----------------------------------------------------------------------- */
 
-m2c_tokenset_literal_t *m2c_resync_set[] = {
+static const m2c_tokenset_literal_t *m2c_resync_set[] = {
   &rs_import_or_definition_or_end,
   &rs_import_or_ident_or_semicolon,
   &rs_ident_or_semicolon,
@@ -115,7 +115,7 @@ m2c_tokenset_literal_t *m2c_resync_set[] = {
  * Table of pointers to human readable resync set names
  * ----------------------------------------------------------------------- */
 
-const char *m2c_resync_set_name_table[] = {
+static const char *m2c_resync_set_name_table[] = {
   "IMPORT_OR_DEFINITON_OR_END\0",
   "IMPORT_OR_IDENT_OR_SEMICOLON\0",
   "IDENT_OR_SEMICOLON\0",
@@ -37,9 +37,8 @@
 #define M2C_SYMTAB_H
 
 #include "m2-common.h"
-
-//#include "m2-ast.h"
-typedef void *m2c_astnode_t;
+#include "m2-unique-string.h"
+#include "m2-ast.h"
 
 
 /* --------------------------------------------------------------------------
@@ -85,16 +84,16 @@ typedef enum {
  * Record type representing the attributes returned by a symbol lookup.
  *
  * Its fields are:
- * - scope, the name of the scope where the symbol was found
+ * - scope, the identifier of the scope where the symbol was found
  * - kind, the classification of the matched symbol
  * - type_id, the identifier of the type of the matched symbol
  * - definition, the AST node with the definition of the matched symbol 
  * ----------------------------------------------------------------------- */
 
 typedef struct {
-  /* scope */ const char *scope;
+  /* scope */ m2c_string_t scope;
   /* kind */ m2c_symtype_t kind;
-  /* type_id */ const char *type_id;
+  /* type_id */ m2c_string_t type_id;
   /* definition */ m2c_astnode_t definition;
 } m2c_sym_attr_t;
 
@@ -102,19 +101,53 @@ typedef struct {
 /* --------------------------------------------------------------------------
  * opaque type m2c_symtab_t
  * --------------------------------------------------------------------------
- * Opaque pointer type representing a symbol table object.
+ * Opaque pointer type representing a symbol table object.  Identifiers
+ * are interned strings, they are compared and hashed by address.  The
+ * symbol table does not retain the strings passed to it, they must remain
+ * valid for the lifetime of the symbol table.
  * ----------------------------------------------------------------------- */
 
 typedef struct m2c_symtab_struct_t *m2c_symtab_t;
 
 
+/* --------------------------------------------------------------------------
+ * opaque type m2c_symtab_snapshot_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing an immutable snapshot of the symbols
+ * visible in a symbol table at the time the snapshot was taken.  Since a
+ * snapshot is never modified, it may be queried by any number of threads
+ * at once without locking.  Symbol tables based on a snapshot let worker
+ * threads push private scopes on top of a shared module scope.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_symtab_snapshot_struct_t *m2c_symtab_snapshot_t;
+
+
 /* --------------------------------------------------------------------------
  * function m2c_new_symtab(scope_id)
  * --------------------------------------------------------------------------
  * Allocates and initialises a new symbol table.
  * ----------------------------------------------------------------------- */
 
-m2c_symtab_t m2c_new_symtab (const char *top_level_scope_id);
+m2c_symtab_t m2c_new_symtab (m2c_string_t top_level_scope_id);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_new_symtab_w_snapshot(snapshot, scope_id)
+ * --------------------------------------------------------------------------
+ * Allocates and initialises a new symbol table based on snapshot.  Its
+ * first scope is opened with scope_id and nested within the scopes of the
+ * snapshot.  Lookups consult the snapshot for any identifier that has no
+ * visible symbol in the scopes of the new table.  Symbols inserted into
+ * the new table may hide symbols of the snapshot.  The snapshot is not
+ * modified, any number of symbol tables may be based on the same snapshot
+ * and used by different threads at once.  The snapshot must not be
+ * released before all symbol tables based on it.  Returns NULL if
+ * snapshot or scope_id is NULL or if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+m2c_symtab_t m2c_new_symtab_w_snapshot
+  (m2c_symtab_snapshot_t snapshot, m2c_string_t scope_id);
 
 
 /* --------------------------------------------------------------------------
@@ -124,7 +157,7 @@ m2c_symtab_t m2c_new_symtab (const char *top_level_scope_id);
  * ----------------------------------------------------------------------- */
 
 m2c_symtab_status_t m2c_symtab_open_scope
-  (m2c_symtab_t symtab, const char *scope_id);
+  (m2c_symtab_t symtab, m2c_string_t scope_id);
 
 
 /* --------------------------------------------------------------------------
@@ -135,9 +168,9 @@ m2c_symtab_status_t m2c_symtab_open_scope
 
 m2c_symtab_status_t m2c_symtab_insert
   (m2c_symtab_t symtab,
-   const char *ident,
+   m2c_string_t ident,
    m2c_symtype_t kind,
-   const char *type_id,
+   m2c_string_t type_id,
    m2c_astnode_t definition);
 
 
@@ -148,35 +181,37 @@ m2c_symtab_status_t m2c_symtab_insert
  * ----------------------------------------------------------------------- */
 
 m2c_symtab_status_t m2c_symtab_lookup
-  (m2c_symtab_t symtab, const char *ident, m2c_sym_attr_t *attributes);
+  (m2c_symtab_t symtab, m2c_string_t ident, m2c_sym_attr_t *attributes);
 
 
 /* --------------------------------------------------------------------------
  * function m2c_symtab_symbol_count(symtab)
  * --------------------------------------------------------------------------
  * Returns the number of symbols currently stored in symbol table symtab.
+ * Symbols of a snapshot symtab is based on are not counted.
  * ----------------------------------------------------------------------- */
 
-uint_t m2c_symtab_entry_count (m2c_symtab_t symtab);
+uint_t m2c_symtab_symbol_count (m2c_symtab_t symtab);
 
 
 /* --------------------------------------------------------------------------
  * function m2c_symtab_scope_count(symtab)
  * --------------------------------------------------------------------------
  * Returns the number of scopes currently open in symbol table symtab.
+ * Scopes of a snapshot symtab is based on are not counted.
  * ----------------------------------------------------------------------- */
 
 uint_t m2c_symtab_scope_count (m2c_symtab_t symtab);
 
 
 /* --------------------------------------------------------------------------
- * function m2c_symtab_open_scope(symtab, scope_id)
+ * function m2c_symtab_close_scope(symtab, scope_id)
  * --------------------------------------------------------------------------
  * Closes a given scope in a symbol table.
  * ----------------------------------------------------------------------- */
 
 m2c_symtab_status_t m2c_symtab_close_scope
-  (m2c_symtab_t symtab, const char *scope_id);
+  (m2c_symtab_t symtab, m2c_string_t scope_id);
 
 
 /* --------------------------------------------------------------------------
@@ -188,6 +223,52 @@ m2c_symtab_status_t m2c_symtab_close_scope
 m2c_symtab_status_t m2c_release_symtab (m2c_symtab_t symtab);
 
 
+/* --------------------------------------------------------------------------
+ * function m2c_new_symtab_snapshot(symtab)
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated immutable snapshot of the symbols visible in
+ * symtab, including those visible through a snapshot symtab is based on.
+ * The snapshot does not change when symtab is changed or released, but
+ * the strings and AST nodes it refers to must remain valid for as long as
+ * it is used.  A snapshot may be queried by any number of threads at once
+ * without locking.  Returns NULL if symtab is NULL or allocation failed.
+ * ----------------------------------------------------------------------- */
+
+m2c_symtab_snapshot_t m2c_new_symtab_snapshot (m2c_symtab_t symtab);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symtab_snapshot_lookup(snapshot, ident, attributes)
+ * --------------------------------------------------------------------------
+ * Looks up the symbol for ident in snapshot and if found, passes back its
+ * attributes.  May be called by any number of threads at once.
+ * ----------------------------------------------------------------------- */
+
+m2c_symtab_status_t m2c_symtab_snapshot_lookup
+  (m2c_symtab_snapshot_t snapshot,
+   m2c_string_t ident,
+   m2c_sym_attr_t *attributes);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symtab_snapshot_symbol_count(snapshot)
+ * --------------------------------------------------------------------------
+ * Returns the number of symbols in snapshot, or zero if snapshot is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_symtab_snapshot_symbol_count (m2c_symtab_snapshot_t snapshot);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_release_symtab_snapshot(snapshot)
+ * --------------------------------------------------------------------------
+ * Deallocates a given snapshot.  No symbol table may be based on it.
+ * ----------------------------------------------------------------------- */
+
+m2c_symtab_status_t m2c_release_symtab_snapshot
+  (m2c_symtab_snapshot_t snapshot);
+
+
 #endif /* M2C_SYMTAB_H */
 
 /* END OF FILE */
\ No newline at end of file
@@ -0,0 +1,437 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * m2-unique-strlist.c
+ *
+ * Implementation of M2C unique string list module.
+ *
+ * The module provides a list ADT for unique strings.
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation;  either version 2 of the License (GPL2),
+ * or (at your option) any later version.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with m2c.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "m2-unique-strlist.h"
+#include "m2-alloc-stats.h"
+
+#include <stdlib.h>
+#include <stdint.h>
+
+
+/* --------------------------------------------------------------------------
+ * Initial capacities and load factor
+ * --------------------------------------------------------------------------
+ * Entries are stored in an array in order of insertion, the array doubles
+ * in size when it is full.  For duplicate detection, entries are also
+ * stored in a set, an open addressed table with linear probing whose
+ * capacity is a power of two.  The set doubles in size when its load would
+ * exceed M2C_STRLIST_MAX_LOAD_PERCENT.
+ * ----------------------------------------------------------------------- */
+
+#define M2C_STRLIST_INITIAL_ENTRY_CAPACITY 16
+
+#define M2C_STRLIST_INITIAL_SET_CAPACITY 32
+
+#define M2C_STRLIST_MAX_LOAD_PERCENT 75
+
+
+/* --------------------------------------------------------------------------
+ * Hash constant
+ * ----------------------------------------------------------------------- */
+
+#define HASH_MULTIPLIER 0x9E3779B97F4A7C15ULL
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_strlist_struct_t
+ * --------------------------------------------------------------------------
+ * record type representing a unique string list object.
+ * ----------------------------------------------------------------------- */
+
+struct m2c_strlist_struct_t {
+  /* entry_count */ uint_t entry_count;
+  /* entry_capacity */ uint_t entry_capacity;
+  /* entry */ m2c_string_t *entry;
+  /* set_capacity */ uint_t set_capacity;
+  /* set */ m2c_string_t *set;
+  /* last_status */ m2c_strlist_status_t last_status;
+};
+
+typedef struct m2c_strlist_struct_t m2c_strlist_struct_t;
+
+
+/* --------------------------------------------------------------------------
+ * Forward declarations
+ * ----------------------------------------------------------------------- */
+
+static inline uint_t slot_for_entry (m2c_string_t entry, uint_t mask);
+
+static uint_t probe_for_entry
+  (m2c_string_t *set, uint_t capacity, m2c_string_t entry);
+
+static bool grow_entries (m2c_strlist_t list);
+
+static bool grow_set (m2c_strlist_t list);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_new_strlist(first_entry, status)
+ * --------------------------------------------------------------------------
+ * Returns a new unique string list with first_entry as its first entry.
+ * ----------------------------------------------------------------------- */
+
+m2c_strlist_t m2c_new_strlist
+  (m2c_string_t first_entry, m2c_strlist_status_t *status) {
+  
+  m2c_strlist_t new_list;
+  
+  if (first_entry == NULL) {
+    SET_STATUS(status, M2C_STRLIST_STATUS_INVALID_REFERENCE);
+    return NULL;
+  } /* end if */
+  
+  new_list = m2c_alloc(M2C_ALLOC_STRLISTS, sizeof(m2c_strlist_struct_t));
+  
+  if (new_list == NULL) {
+    SET_STATUS(status, M2C_STRLIST_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  new_list->entry = m2c_alloc(M2C_ALLOC_STRLISTS,
+    M2C_STRLIST_INITIAL_ENTRY_CAPACITY * sizeof(m2c_string_t));
+  new_list->set = m2c_alloc_zeroed(M2C_ALLOC_STRLISTS,
+    M2C_STRLIST_INITIAL_SET_CAPACITY, sizeof(m2c_string_t));
+  
+  if ((new_list->entry == NULL) || (new_list->set == NULL)) {
+    m2c_dealloc(M2C_ALLOC_STRLISTS, new_list->entry,
+      M2C_STRLIST_INITIAL_ENTRY_CAPACITY * sizeof(m2c_string_t));
+    m2c_dealloc(M2C_ALLOC_STRLISTS, new_list->set,
+      M2C_STRLIST_INITIAL_SET_CAPACITY * sizeof(m2c_string_t));
+    m2c_dealloc(M2C_ALLOC_STRLISTS, new_list, sizeof(m2c_strlist_struct_t));
+    SET_STATUS(status, M2C_STRLIST_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  new_list->entry_capacity = M2C_STRLIST_INITIAL_ENTRY_CAPACITY;
+  new_list->set_capacity = M2C_STRLIST_INITIAL_SET_CAPACITY;
+  
+  /* store first entry */
+  new_list->entry[0] = first_entry;
+  new_list->set[slot_for_entry(first_entry,
+    M2C_STRLIST_INITIAL_SET_CAPACITY - 1)] = first_entry;
+  m2c_string_retain(first_entry);
+  
+  new_list->entry_count = 1;
+  new_list->last_status = M2C_STRLIST_STATUS_SUCCESS;
+  
+  SET_STATUS(status, M2C_STRLIST_STATUS_SUCCESS);
+  return new_list;
+} /* end m2c_new_strlist */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_strlist_add_unique_entry(list, entry)
+ * --------------------------------------------------------------------------
+ * Appends entry to list and returns true unless entry is already present
+ * in list.  The status of the operation is recorded in list.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_strlist_add_unique_entry (m2c_strlist_t list, m2c_string_t entry) {
+  
+  uint_t index;
+  
+  if (list == NULL) {
+    return false;
+  } /* end if */
+  
+  if (entry == NULL) {
+    list->last_status = M2C_STRLIST_STATUS_INVALID_REFERENCE;
+    return false;
+  } /* end if */
+  
+  index = probe_for_entry(list->set, list->set_capacity, entry);
+  
+  /* bail out if entry is a duplicate */
+  if (list->set[index] != NULL) {
+    list->last_status = M2C_STRLIST_STATUS_DUPLICATE_STRING;
+    return false;
+  } /* end if */
+  
+  /* make room in the entry array */
+  if ((list->entry_count == list->entry_capacity) &&
+      (grow_entries(list) == false)) {
+    list->last_status = M2C_STRLIST_STATUS_ALLOCATION_FAILED;
+    return false;
+  } /* end if */
+  
+  /* grow the set if its load would exceed the limit */
+  if (((list->entry_count + 1) * 100) >
+      (list->set_capacity * M2C_STRLIST_MAX_LOAD_PERCENT)) {
+    
+    if (grow_set(list) == false) {
+      list->last_status = M2C_STRLIST_STATUS_ALLOCATION_FAILED;
+      return false;
+    } /* end if */
+    
+    index = probe_for_entry(list->set, list->set_capacity, entry);
+  } /* end if */
+  
+  list->set[index] = entry;
+  list->entry[list->entry_count] = entry;
+  list->entry_count++;
+  m2c_string_retain(entry);
+  
+  list->last_status = M2C_STRLIST_STATUS_SUCCESS;
+  return true;
+} /* end m2c_strlist_add_unique_entry */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_strlist_entry_exists(list, entry)
+ * --------------------------------------------------------------------------
+ * Returns true if entry is present in list, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_strlist_entry_exists (m2c_strlist_t list, m2c_string_t entry) {
+  
+  uint_t index;
+  
+  if ((list == NULL) || (entry == NULL)) {
+    return false;
+  } /* end if */
+  
+  index = probe_for_entry(list->set, list->set_capacity, entry);
+  
+  return (list->set[index] != NULL);
+} /* end m2c_strlist_entry_exists */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_strlist_entry_at_index(list, index)
+ * --------------------------------------------------------------------------
+ * Returns the entry at the given index in list, or NULL if list is NULL or
+ * if index is out of range.
+ * ----------------------------------------------------------------------- */
+
+m2c_string_t m2c_strlist_entry_at_index (m2c_strlist_t list, uint_t index) {
+  
+  if (list == NULL) {
+    return NULL;
+  } /* end if */
+  
+  if (index >= list->entry_count) {
+    list->last_status = M2C_STRLIST_STATUS_INVALID_INDEX;
+    return NULL;
+  } /* end if */
+  
+  list->last_status = M2C_STRLIST_STATUS_SUCCESS;
+  return list->entry[index];
+} /* end m2c_strlist_entry_at_index */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_strlist_entry_count(list)
+ * --------------------------------------------------------------------------
+ * Returns the number of entries in list, or zero if list is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_strlist_entry_count (m2c_strlist_t list) {
+  
+  if (list == NULL) {
+    return 0;
+  } /* end if */
+  
+  return list->entry_count;
+} /* end m2c_strlist_entry_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_strlist_last_status(list)
+ * --------------------------------------------------------------------------
+ * Returns the status of the last operation on list.
+ * ----------------------------------------------------------------------- */
+
+m2c_strlist_status_t m2c_strlist_last_status (m2c_strlist_t list) {
+  
+  if (list == NULL) {
+    return M2C_STRLIST_STATUS_INVALID_REFERENCE;
+  } /* end if */
+  
+  return list->last_status;
+} /* end m2c_strlist_last_status */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_strlist_release(list)
+ * --------------------------------------------------------------------------
+ * Releases all entries of list and deallocates list.
+ * ----------------------------------------------------------------------- */
+
+void m2c_strlist_release (m2c_strlist_t list) {
+  
+  uint_t index;
+  
+  if (list == NULL) {
+    return;
+  } /* end if */
+  
+  index = 0;
+  while (index < list->entry_count) {
+    m2c_string_release(list->entry[index]);
+    index++;
+  } /* end while */
+  
+  m2c_dealloc(M2C_ALLOC_STRLISTS, list->entry,
+    list->entry_capacity * sizeof(m2c_string_t));
+  m2c_dealloc(M2C_ALLOC_STRLISTS, list->set,
+    list->set_capacity * sizeof(m2c_string_t));
+  m2c_dealloc(M2C_ALLOC_STRLISTS, list, sizeof(m2c_strlist_struct_t));
+  
+  return;
+} /* end m2c_strlist_release */
+
+
+/* *********************************************************************** *
+ * Private Functions
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private function slot_for_entry(entry, mask)
+ * --------------------------------------------------------------------------
+ * Returns the home slot of entry in a set with capacity mask + 1.  Since
+ * unique strings are interned, the address of entry serves as its key.
+ * The low bits of an address are always zero, the top bits of the product
+ * are therefore used, folded into the range of mask.
+ * ----------------------------------------------------------------------- */
+
+static inline uint_t slot_for_entry (m2c_string_t entry, uint_t mask) {
+  
+  uint64_t key;
+  
+  key = ((uint64_t) (uintptr_t) entry) * HASH_MULTIPLIER;
+  
+  return ((uint_t) (key >> 32)) & mask;
+} /* end slot_for_entry */
+
+
+/* --------------------------------------------------------------------------
+ * private function probe_for_entry(set, capacity, entry)
+ * --------------------------------------------------------------------------
+ * Probes set from the home slot of entry and returns the index of the slot
+ * holding entry, or of the first empty slot if entry is not in set.
+ *
+ * pre-conditions:
+ * o  capacity must be a power of two (NOT GUARDED)
+ * o  set must have at least one empty slot (NOT GUARDED)
+ * ----------------------------------------------------------------------- */
+
+static uint_t probe_for_entry
+  (m2c_string_t *set, uint_t capacity, m2c_string_t entry) {
+  
+  uint_t index, mask;
+  
+  mask = capacity - 1;
+  index = slot_for_entry(entry, mask);
+  
+  while ((set[index] != NULL) && (set[index] != entry)) {
+    index = (index + 1) & mask;
+  } /* end while */
+  
+  return index;
+} /* end probe_for_entry */
+
+
+/* --------------------------------------------------------------------------
+ * private function grow_entries(list)
+ * --------------------------------------------------------------------------
+ * Doubles the capacity of the entry array of list.  Returns true on
+ * success.  Returns false and leaves list unchanged if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static bool grow_entries (m2c_strlist_t list) {
+  
+  m2c_string_t *new_entry;
+  uint_t new_capacity;
+  
+  new_capacity = 2 * list->entry_capacity;
+  new_entry = m2c_realloc(M2C_ALLOC_STRLISTS, list->entry,
+    list->entry_capacity * sizeof(m2c_string_t),
+    new_capacity * sizeof(m2c_string_t));
+  
+  if (new_entry == NULL) {
+    return false;
+  } /* end if */
+  
+  list->entry = new_entry;
+  list->entry_capacity = new_capacity;
+  
+  return true;
+} /* end grow_entries */
+
+
+/* --------------------------------------------------------------------------
+ * private function grow_set(list)
+ * --------------------------------------------------------------------------
+ * Rehashes all entries of list into a set of twice the capacity.  Returns
+ * true on success.  Returns false and leaves list unchanged if allocation
+ * failed.  The entry array is used as the source, it holds every entry.
+ * ----------------------------------------------------------------------- */
+
+static bool grow_set (m2c_strlist_t list) {
+  
+  m2c_string_t *new_set;
+  uint_t index, new_capacity;
+  m2c_string_t this_entry;
+  
+  new_capacity = 2 * list->set_capacity;
+  new_set =
+    m2c_alloc_zeroed(M2C_ALLOC_STRLISTS, new_capacity, sizeof(m2c_string_t));
+  
+  if (new_set == NULL) {
+    return false;
+  } /* end if */
+  
+  index = 0;
+  while (index < list->entry_count) {
+    this_entry = list->entry[index];
+    new_set[probe_for_entry(new_set, new_capacity, this_entry)] =
+      this_entry;
+    index++;
+  } /* end while */
+  
+  m2c_dealloc(M2C_ALLOC_STRLISTS, list->set,
+    list->set_capacity * sizeof(m2c_string_t));
+  list->set = new_set;
+  list->set_capacity = new_capacity;
+  
+  return true;
+} /* end grow_set */
+
+
+/* END OF FILE */
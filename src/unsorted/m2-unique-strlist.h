@@ -41,12 +41,17 @@
 #define M2C_UNIQUE_STRLIST_H
 
 #include "m2-common.h"
+#include "m2-unique-string.h"
+
+#include <stdbool.h>
 
 
 /* --------------------------------------------------------------------------
  * opaque type m2c_strlist_t
  * --------------------------------------------------------------------------
- * Opaque pointer type representing a list of unique strings.
+ * Opaque pointer type representing a list of unique strings.  Entries are
+ * kept in order of insertion.  Since unique strings are interned, entries
+ * are identified by address and duplicates are detected in constant time.
  * ----------------------------------------------------------------------- */
 
 typedef struct m2c_strlist_struct_t *m2c_strlist_t;
@@ -63,286 +68,111 @@ typedef enum {
   M2C_STRLIST_STATUS_INVALID_REFERENCE,
   M2C_STRLIST_STATUS_DUPLICATE_STRING,
   M2C_STRLIST_STATUS_INVALID_INDEX,
-  M2C_STRLIST_STATUS_ALLOCATION_FAILED,
+  M2C_STRLIST_STATUS_ALLOCATION_FAILED
 } m2c_strlist_status_t;
 
 
-m2c_strlist_t m2c_new_strlist
-  (m2c_string_t first_entry, m2c_strlist_status_t *status);
-
-bool m2c_strlist_add_unique_entry (m2c_strlist_t list, m2c_string_t entry);
-
-m2c_string_t m2c_strlist_entry_at_index (m2c_strlist_t list, uint_t index);
-
-uint_t m2c_strlist_entry_count (m2c_strlist_t list);
-
-m2c_strlist_status_t m2c_strlist_last_status (m2c_strlist_t list);
-
-void m2c_strlist_release (m2c_strlist_t list);
-
-
-typedef struct m2c_strlist_node_struct_t *m2c_strlist_node_t;
-
-typedef struct m2c_strlist_node_struct_t {
-  m2c_string_t str;
-  m2c_strlist_node_t next;
-}; /* end m2c_strlist_node_struct_t */
-
-typedef struct m2c_strlist_node_struct_t m2c_strlist_node_struct_t;
-
-
-typedef struct m2c_strlist_struct_t {
-  m2c_strlist_node_t first;
-  m2c_strlist_node_t next;
-  m2c_strlist_node_t last;
-  uint_t next_index;
-  uint_t entry_count;
-}; /* end m2c_strlist_struct_t */
-
-typdef struct m2c_strlist_struct_t m2c_strlist_struct_t;
-
-
-m2c_mutable_strlist_t m2c_new_mutable_strlist
-  (m2c_string_t first_entry, m2c_strlist_status_t *status);
-
-uint_t m2c_mutable_strlist_entry_count (m2c_mutable_strlist_t list);
-
-m2c_string_t m2c_mutable_strlist_entry_at_index
-  (m2c_mutable_strlist_t list, uint_t index);
-
-void m2c_mutable_strlist_release (m2c_strlist_t list);
-
-
-new_str_list(list)
-
-
 /* --------------------------------------------------------------------------
- * procedure m2c_init_string_repository(size, status)
+ * function m2c_new_strlist(first_entry, status)
  * --------------------------------------------------------------------------
- * Allocates and initialises global string repository.  Parameter size
- * determines the number of buckets of the repository's internal hash table.
- * If size is zero, value M2C_STRING_REPO_DEFAULT_BUCKET_COUNT is used.
+ * Returns a new unique string list with first_entry as its first entry.
  *
  * pre-conditions:
- * o  global repository must be uninitialised upon entry
- * o  parameter size may be zero upon entry
+ * o  parameter first_entry must not be NULL upon entry
  * o  parameter status may be NULL upon entry
  *
  * post-conditions:
- * o  global string repository is allocated and intialised.
- * o  M2C_STRING_STATUS_SUCCESS is passed back in status, unless NULL
+ * o  a new list with first_entry is returned, first_entry is retained
+ * o  M2C_STRLIST_STATUS_SUCCESS is passed back in status, unless NULL
  *
  * error-conditions:
- * o  if repository has already been initialised upon entry,
- *    no operation is carried out and M2C_STRING_STATUS_ALREADY_INITIALIZED
- *    is passed back in status unless status is NULL
- * o  if repository allocation failed, M2C_STRING_STATUS_ALLOCATION_FAILED
- *    is passed back in status unless status is NULL
- * --------------------------------------------------------------------------
- */
-
-void m2c_init_string_repository
-  (uint_t size, m2c_string_status_t *status);
-
-
-/* --------------------------------------------------------------------------
- * function m2c_get_string(str, status)
- * --------------------------------------------------------------------------
- * Returns a unique string object for str which must be a pointer to a NUL
- * terminated character string.  
- *
- * pre-conditions:
- * o  parameter str must not be NULL upon entry
- *
- * post-conditions:
- * o  if a string object for str is present in the internal repository,
- *    that string object is retrieved, retained and returned.
- * o  if no string object for str is present in the repository,
- *    a new string object with a copy of str is created, stored and returned.
- * o  M2C_STRING_STATUS_SUCCESS is passed back in status, unless NULL
- *
- * error-conditions:
- * o  if str is NULL upon entry, no operation is carried out,
- *    NULL is returned and M2C_STRING_STATUS_INVALID_REFERENCE is
- *    passed back in status unless status is NULL
- * o  if string object allocation failed, no operation is carried out,
- *    NULL is returned and M2C_STRING_STATUS_ALLOCATION_FAILED is
- *    passed back in status unless status is NULL
- * --------------------------------------------------------------------------
- */
-
-m2c_string_t m2c_get_string (char *str, m2c_string_status_t *status);
-
-
-/* --------------------------------------------------------------------------
- * function m2c_get_string_for_slice(str, offset, length, status)
- * --------------------------------------------------------------------------
- * Returns a unique string object for a given slice of str.  Parameter str
- * must be a pointer to a NUL terminated character string.  The position of
- * the first character of the slice is given by parameter offset and the
- * length of the slice is given by parameter length.
- *
- * pre-conditions:
- * o  parameter str must not be NULL upon entry
- * o  slice must be within range of str (NOT GUARDED),
- * o  slice must not contain any characters with code points < 32 or > 126 
- * 
- *
- * post-conditions:
- * o  if a string object for the slice is present in the internal repository,
- *    that string object is retrieved, retained and returned.
- * o  if no string object for the slice is present in the repository, a new
- *    string object with a copy of the slice is created, stored and returned.
- * o  M2C_STRING_STATUS_SUCCESS is passed back in status, unless NULL
- *
- * error-conditions:
- * o  if precondition #1 is not met, no operation is carried out,
- *    NULL is returned and M2C_STRING_STATUS_INVALID_REFERENCE is
- *    passed back in status, unless status is NULL
- * o  if precondition #3 is not met, no operation is carried out,
- *    NULL is returned and M2C_STRING_STATUS_INVALID_INDICES is
- *    passed back in status, unless status is NULL
- * o  if string object allocation failed, no operation is carried out,
- *    NULL is returned and M2C_STRING_STATUS_ALLOCATION_FAILED is
- *    passed back in status unless status is NULL
- * --------------------------------------------------------------------------
- */
+ * o  if first_entry is NULL upon entry, NULL is returned and
+ *    M2C_STRLIST_STATUS_INVALID_REFERENCE is passed back in status,
+ *    unless NULL
+ * o  if allocation fails, NULL is returned and
+ *    M2C_STRLIST_STATUS_ALLOCATION_FAILED is passed back in status,
+ *    unless NULL
+ * ----------------------------------------------------------------------- */
 
-m2c_string_t m2c_get_string_for_slice
-  (char *str, uint_t offset, uint_t length, m2c_string_status_t *status);
+m2c_strlist_t m2c_new_strlist
+  (m2c_string_t first_entry, m2c_strlist_status_t *status);
 
 
 /* --------------------------------------------------------------------------
- * function m2c_get_string_for_concatenation(str, append_str, status)
+ * function m2c_strlist_add_unique_entry(list, entry)
  * --------------------------------------------------------------------------
- * Returns a unique string object for the character string resulting from
- * concatenation of str and append_str.  Parameters str and append_str must
- * be pointers to NUL terminated character strings.
+ * Appends entry to list and returns true unless entry is already present
+ * in list.  The status of the operation is recorded in list and may be
+ * obtained by calling m2c_strlist_last_status().
  *
  * pre-conditions:
- * o  parameter str must not be NULL upon entry
- * o  parameter append_str must not be NULL upon entry
+ * o  parameters list and entry must not be NULL upon entry
  *
  * post-conditions:
- * o  if a string object for the resulting concatenation string is present in
- *    the internal repository, that string object is retrieved, retained and
- *    returned.
- * o  if no string object for the resulting concatenation is present in the
- *    repository, a new string object with a copy of the concatenation is
- *    created, stored and returned.
- * o  M2C_STRING_STATUS_SUCCESS is passed back in status, unless NULL
+ * o  entry is appended to list and retained, true is returned
+ * o  M2C_STRLIST_STATUS_SUCCESS is recorded in list
  *
  * error-conditions:
- * o  if any of str or append_str is NULL upon entry, no operation is
- *    carried out, NULL is returned and M2C_STRING_STATUS_INVALID_REFERENCE
- *    is passed back in status, unless NULL
- * o  if no dynamic string object could be allocated, NULL is returned,
- *    and M2C_STRING_STATUS_ALLOCATION_FAILED is passed back in status,
- *    unless NULL
- * --------------------------------------------------------------------------
- */
+ * o  if entry is already present in list, false is returned and
+ *    M2C_STRLIST_STATUS_DUPLICATE_STRING is recorded in list
+ * o  if entry is NULL upon entry, false is returned and
+ *    M2C_STRLIST_STATUS_INVALID_REFERENCE is recorded in list
+ * o  if allocation fails, false is returned and
+ *    M2C_STRLIST_STATUS_ALLOCATION_FAILED is recorded in list
+ * o  if list is NULL upon entry, false is returned
+ * ----------------------------------------------------------------------- */
 
-m2c_string_t m2c_get_string_for_concatenation
-  (char *str, char *append_str, m2c_string_status_t *status);
+bool m2c_strlist_add_unique_entry (m2c_strlist_t list, m2c_string_t entry);
 
 
 /* --------------------------------------------------------------------------
- * function m2c_string_length(str)
+ * function m2c_strlist_entry_exists(list, entry)
  * --------------------------------------------------------------------------
- * Returns the length of the character string of str.
- *
- * pre-conditions:
- * o  parameter str must not be NULL upon entry
- *
- * post-conditions:
- * o  the length of str's character string is returned
- *
- * error-conditions:
- * o  if str is NULL upon entry, zero is returned
- * --------------------------------------------------------------------------
- */
+ * Returns true if entry is present in list, otherwise false.
+ * ----------------------------------------------------------------------- */
 
-inline uint_t m2c_string_length (m2c_string_t str);
+bool m2c_strlist_entry_exists (m2c_strlist_t list, m2c_string_t entry);
 
 
 /* --------------------------------------------------------------------------
- * function m2c_string_char_ptr(str)
- * --------------------------------------------------------------------------
- * Returns an immutable pointer to the character string of str.
- *
- * pre-conditions:
- * o  parameter str must not be NULL upon entry
- *
- * post-conditions:
- * o  an immutable pointer to str's character string is returned
- *
- * error-conditions:
- * o  if str is NULL upon entry, NULL is returned
+ * function m2c_strlist_entry_at_index(list, index)
  * --------------------------------------------------------------------------
- */
+ * Returns the entry at the given index in list, where the first entry has
+ * index zero.  Returns NULL if list is NULL or if index is out of range,
+ * in which case M2C_STRLIST_STATUS_INVALID_INDEX is recorded in list.
+ * ----------------------------------------------------------------------- */
 
-inline const char *m2c_string_char_ptr (m2c_string_t str);
+m2c_string_t m2c_strlist_entry_at_index (m2c_strlist_t list, uint_t index);
 
 
 /* --------------------------------------------------------------------------
- * function m2c_unique_string_count()
- * --------------------------------------------------------------------------
- * Returns the number of unique strings stored in the string repository.
- *
- * pre-conditions:
- * o  none
- *
- * post-conditions:
- * o  none
- *
- * error-conditions:
- * o  none
+ * function m2c_strlist_entry_count(list)
  * --------------------------------------------------------------------------
- */
+ * Returns the number of entries in list, or zero if list is NULL.
+ * ----------------------------------------------------------------------- */
 
-inline uint_t m2c_unique_string_count (void);
+uint_t m2c_strlist_entry_count (m2c_strlist_t list);
 
 
 /* --------------------------------------------------------------------------
- * function m2c_string_retain(str)
+ * function m2c_strlist_last_status(list)
  * --------------------------------------------------------------------------
- * Prevents str from deallocation.
- *
- * pre-conditions:
- * o  parameter str must not be NULL upon entry
- *
- * post-conditions:
- * o  str's reference count is incremented.
- *
- * error-conditions:
- * o  if str is not NULL upon entry, no operation is carried out
- * --------------------------------------------------------------------------
- */
+ * Returns the status of the last operation on list.  Returns status
+ * M2C_STRLIST_STATUS_INVALID_REFERENCE if list is NULL.
+ * ----------------------------------------------------------------------- */
 
-inline void m2c_string_retain (m2c_string_t str);
+m2c_strlist_status_t m2c_strlist_last_status (m2c_strlist_t list);
 
 
 /* --------------------------------------------------------------------------
- * function m2c_string_release(str)
- * --------------------------------------------------------------------------
- * Cancels an outstanding retain, or deallocates str if there are no
- * outstanding retains.
- *
- * pre-conditions:
- * o  parameter str must not be NULL upon entry
- *
- * post-conditions:
- * o  if str's reference count is zero upon entry, str is deallocated
- * o  if str's reference count is not zero upon entry, it is decremented
- *
- * error-conditions:
- * o  if str is not NULL upon entry, no operation is carried out
+ * procedure m2c_strlist_release(list)
  * --------------------------------------------------------------------------
- */
+ * Releases all entries of list and deallocates list.
+ * ----------------------------------------------------------------------- */
 
-void m2c_string_release (m2c_string_t str);
+void m2c_strlist_release (m2c_strlist_t list);
 
 
 #endif /* M2C_UNIQUE_STRLIST_H */
 
-/* END OF FILE */
\ No newline at end of file
+/* END OF FILE */